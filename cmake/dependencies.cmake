@@ -42,7 +42,12 @@ target_include_directories(gtest_main INTERFACE ${CMAKE_HOME_DIRECTORY}/googlete
 ###############################################################################
 # Google Benchmark
 ###############################################################################
-#add_subdirectory(${CMAKE_SOURCE_DIR}/benchmark-v1.2.0)
+find_package(benchmark QUIET)
+if (benchmark_FOUND)
+  message("-- Found Google Benchmark ${benchmark_VERSION}; perf targets will be built")
+else ()
+  message("-- Google Benchmark was not found; perf targets will not be built")
+endif ()
 
 ###############################################################################
 # cmcstl2, and experimental implementation of P0896R4 "The One Ranges Proposal"
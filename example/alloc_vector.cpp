@@ -0,0 +1,35 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/stl_interfaces/alloc_vector.hpp>
+
+#include <cassert>
+#if defined(__cpp_lib_memory_resource)
+#include <memory_resource>
+#endif
+
+
+using boost::stl_interfaces::alloc_vector;
+
+
+int main()
+{
+    alloc_vector<int> v;
+    v.push_back(1);
+    assert(v.get_allocator() == std::allocator<int>());
+
+#if defined(__cpp_lib_memory_resource)
+    //[ alloc_vector_usage
+    // All the containers used to handle one request come from one arena, and
+    // are freed together when the arena goes away.
+    std::pmr::monotonic_buffer_resource arena;
+    using alloc_type = std::pmr::polymorphic_allocator<int>;
+    alloc_vector<int, alloc_type> ids{{1, 2, 3}, alloc_type(&arena)};
+    ids.push_back(4);
+    assert(ids.get_allocator().resource() == &arena);
+    //]
+#endif
+}
@@ -0,0 +1,44 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/stl_interfaces/bit_vector.hpp>
+
+#include <cassert>
+
+
+using boost::stl_interfaces::bit_span;
+using boost::stl_interfaces::bit_vector;
+using boost::stl_interfaces::bit_word;
+
+
+int main()
+{
+    //[ bit_vector_usage
+    // One flag per subscriber, in an eighth of the space of a bool each.
+    bit_vector subscribed(1000);
+    for (int i = 0; i < 1000; i += 3) {
+        subscribed[i] = true;
+    }
+
+    // These find the word-at-a-time overloads through ADL.
+    assert(count(subscribed.begin(), subscribed.end(), true) == 334);
+    auto const it = find(subscribed.begin() + 1, subscribed.end(), true);
+    assert(it - subscribed.begin() == 3);
+
+    fill(subscribed.begin() + 100, subscribed.begin() + 900, false);
+    assert(count(subscribed.begin(), subscribed.end(), true) == 68);
+
+    // A bit_span is a view of some of the bits.
+    bit_span<bit_word> const first_hundred(
+        subscribed.begin(), subscribed.begin() + 100);
+    assert(first_hundred.size() == 100);
+    assert(first_hundred[99]);
+
+    subscribed.erase(subscribed.begin(), subscribed.begin() + 1);
+    assert(!subscribed.front());
+    assert(subscribed[2]);
+    //]
+}
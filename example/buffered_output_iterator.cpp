@@ -0,0 +1,41 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/stl_interfaces/buffered_output_iterator.hpp>
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+#include <cassert>
+
+
+using boost::stl_interfaces::buffered_output_iterator;
+using boost::stl_interfaces::container_output_buffer;
+
+
+int main()
+{
+    //[ buffered_output_iterator_usage
+    std::vector<int> ints(10000);
+    std::iota(ints.begin(), ints.end(), 0);
+
+    std::vector<int> evens;
+    {
+        // The elements go into evens 256 at a time.
+        container_output_buffer<std::vector<int>, 256> buffer(evens);
+        std::copy_if(
+            ints.begin(), ints.end(), buffer.out(), [](int x) {
+                return x % 2 == 0;
+            });
+        assert(evens.size() == 4864u);
+        assert(buffer.size() == 136u);
+        // The rest go in at the end of the scope, or with flush().
+    }
+    assert(evens.size() == 5000u);
+    assert(evens.back() == 9998);
+    //]
+}
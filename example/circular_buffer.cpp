@@ -0,0 +1,51 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/stl_interfaces/circular_buffer.hpp>
+
+#include <numeric>
+
+
+using boost::stl_interfaces::circular_buffer;
+
+
+int main()
+{
+    //[ circular_buffer_usage
+    // A fixed-capacity buffer never allocates.
+    circular_buffer<int, 8> buf = {1, 2, 3, 4, 5, 6};
+    buf.pop_front();
+    buf.pop_front();
+    buf.push_back(7);
+    buf.push_back(8);
+    buf.push_back(9);
+    buf.push_back(10);
+    assert(buf.full());
+    assert(buf.front() == 3 && buf.back() == 10);
+
+    // The elements now wrap around the end of the slots, so they are in two
+    // spans.
+    assert(buf.array_one().second + buf.array_two().second == buf.size());
+    assert(buf.array_two().second == 2u);
+
+    // Bulk reads and writes copy at most two spans each.
+    int out[4];
+    assert(buf.read(out, 4) == 4u);
+    assert(std::accumulate(out, out + 4, 0) == 3 + 4 + 5 + 6);
+    int const in[] = {10, 11, 12, 13, 14};
+    assert(buf.write(in, 5) == 4u); // Only 4 fit.
+    assert(buf.full());
+
+    // A growing buffer doubles its capacity when it is full.
+    circular_buffer<int> queue;
+    for (int i = 0; i < 9; ++i) {
+        queue.push_back(i);
+    }
+    assert(queue.capacity() == 16u);
+    queue.push_front(-1);
+    assert(queue[0] == -1 && queue[9] == 8);
+    //]
+}
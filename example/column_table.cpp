@@ -0,0 +1,51 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/stl_interfaces/column_table.hpp>
+
+#include <numeric>
+#include <string>
+
+
+using boost::stl_interfaces::column_table;
+
+
+int main()
+{
+    //[ column_table_usage
+    // id, name, price, quantity.
+    using orders_t = column_table<std::tuple<int, std::string, double, int>>;
+    orders_t orders;
+    orders.emplace_back(1, "widget", 2.50, 4);
+    orders.emplace_back(2, "gadget", 10.00, 1);
+    orders.emplace_back(3, "doohickey", 0.25, 40);
+
+    // A whole column, contiguous.
+    auto const quantities = orders.column<3>();
+    assert(std::accumulate(quantities.begin(), quantities.end(), 0) == 45);
+    assert(quantities.data() == orders.data<3>());
+
+    // Rows of just the price and quantity columns; the names are never
+    // read.
+    double total = 0.0;
+    for (auto row : orders.select<2, 3>()) {
+        total += std::get<0>(row) * std::get<1>(row);
+    }
+    assert(total == 30.0);
+
+    // Writing through a projection writes the table.
+    for (auto row : orders.select<2>()) {
+        std::get<0>(row) *= 2.0;
+    }
+    assert(std::get<2>(orders[1]) == 20.00);
+
+    // The rows are still a soa_vector's rows.
+    std::sort(orders.begin(), orders.end(), [](auto a, auto b) {
+        return std::get<2>(a) < std::get<2>(b);
+    });
+    assert(std::get<1>(orders.front()) == "doohickey");
+    //]
+}
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0. (See
 // accompanying file LICENSE_1_0.txt or copy at
 // http://www.boost.org/LICENSE_1_0.txt)
-#include <boost/stl_interfaces/view_interface.hpp>
+#include <boost/stl_interfaces/cached_view_interface.hpp>
 
 #include <algorithm>
 #include <vector>
@@ -52,9 +52,17 @@ using all_view = decltype(all(std::declval<Range>()));
 // itself, which may be a std::vector.  So, we want to make a view out of
 // whatever Range we're given so that this copy of an owning range does not
 // happen.
+//
+// Finding the first element of a drop_while_view means scanning past all the
+// elements that satisfy pred, and view_interface members like empty() and
+// front() each call begin().  To avoid repeating that scan, we derive from
+// cached_begin_view_interface, which computes begin() once, by calling our
+// uncached_begin(), and then returns a cached iterator.
 template<typename Range, typename Pred>
 struct drop_while_view
-    : boost::stl_interfaces::view_interface<drop_while_view<Range, Pred>>
+    : boost::stl_interfaces::cached_begin_view_interface<
+          drop_while_view<Range, Pred>,
+          decltype(std::declval<all_view<Range> &>().begin())>
 {
     using base_type = all_view<Range>;
 
@@ -68,10 +76,12 @@ struct drop_while_view
     constexpr base_type base() const { return base_; }
     constexpr Pred const & pred() const noexcept { return pred_; }
 
-    // A more robust implementation should probably cache the value computed
-    // by this function, so that subsequent calls can just return the cached
-    // iterator.
-    constexpr auto begin()
+    constexpr auto end() { return base_.end(); }
+
+private:
+    friend boost::stl_interfaces::access;
+
+    constexpr auto uncached_begin()
     {
         // We're forced to write this out as a raw loop, since no
         // std::-namespace algorithms accept a sentinel.
@@ -84,9 +94,6 @@ struct drop_while_view
         return first;
     }
 
-    constexpr auto end() { return base_.end(); }
-
-private:
     base_type base_;
     Pred pred_;
 };
@@ -0,0 +1,59 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/stl_interfaces/encoded_column.hpp>
+
+#include <numeric>
+#include <string>
+
+#include <cassert>
+
+
+using boost::stl_interfaces::dict_encoded_column;
+using boost::stl_interfaces::rle_column;
+
+
+int main()
+{
+    //[ encoded_column_usage
+    std::vector<std::string> const cities = {
+        "Oslo", "Lima", "Oslo", "Oslo", "Kyiv", "Lima", "Oslo"};
+
+    // Each string is stored once; the column is 16-bit codes.
+    dict_encoded_column<std::string> const dict(cities.begin(), cities.end());
+    auto const dv = dict.view();
+    assert(std::size_t(dv.size()) == cities.size());
+    assert(dv.dictionary_size() == 3u);
+    assert(std::equal(dv.begin(), dv.end(), cities.begin()));
+    assert(dv[4] == "Kyiv");
+    assert(dv.count("Oslo") == 4);
+
+    // copy() decodes a block at a time, through read_n().
+    std::vector<std::string> decoded(dv.size());
+    boost::stl_interfaces::copy(dv.begin(), dv.end(), decoded.data());
+    assert(decoded == cities);
+
+    std::vector<int> const readings = {7, 7, 7, 7, 3, 3, 9, 9, 9, 9, 9};
+
+    // Eleven readings in three runs.
+    rle_column<int> const rle(readings.begin(), readings.end());
+    auto const rv = rle.view();
+    assert(std::size_t(rv.size()) == readings.size());
+    assert(rv.run_count() == 3);
+    assert(rv[5] == 3);
+    assert(*(rv.end() - 1) == 9);
+
+    // The segmented algorithms go a run at a time.
+    assert(
+        boost::stl_interfaces::segmented_accumulate(
+            rv.begin(), rv.end(), 0) ==
+        std::accumulate(readings.begin(), readings.end(), 0));
+    assert(
+        boost::stl_interfaces::segmented_find(rv.begin(), rv.end(), 9) -
+            rv.begin() ==
+        6);
+    //]
+}
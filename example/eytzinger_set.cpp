@@ -0,0 +1,36 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/stl_interfaces/eytzinger_set.hpp>
+
+#include <vector>
+
+#include <cassert>
+
+
+using boost::stl_interfaces::eytzinger_set;
+
+
+int main()
+{
+    //[ eytzinger_set_usage
+    eytzinger_set<int> const set = {60, 20, 40, 10, 50, 30, 70, 20};
+
+    // The elements are stored in breadth-first order ...
+    assert(set.elements() == (std::vector<int>{40, 20, 60, 10, 30, 50, 70}));
+    // ... but iteration is in order.
+    assert(
+        std::vector<int>(set.begin(), set.end()) ==
+        (std::vector<int>{10, 20, 30, 40, 50, 60, 70}));
+    assert(*set.rbegin() == 70);
+
+    assert(set.contains(30));
+    assert(!set.contains(35));
+    assert(*set.lower_bound(35) == 40);
+    assert(*set.upper_bound(40) == 50);
+    assert(set.lower_bound(71) == set.end());
+    //]
+}
@@ -0,0 +1,66 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/stl_interfaces/fd_input_iterator.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <numeric>
+
+#include <cassert>
+
+#include <fcntl.h>
+
+
+using boost::stl_interfaces::fd_input_iterator;
+using boost::stl_interfaces::fd_reader;
+
+
+int main()
+{
+    char const * path = "fd_input_iterator_example.bin";
+    {
+        std::ofstream ofs(path, std::ios::binary);
+        for (std::uint32_t i = 0; i < 100000; ++i) {
+            ofs.write(reinterpret_cast<char const *>(&i), sizeof(i));
+        }
+    }
+
+    //[ fd_input_iterator_usage
+    int const fd = ::open(path, O_RDONLY);
+    assert(0 <= fd);
+
+    {
+        // Standard algorithms, over the elements as they are read, in blocks
+        // of 64KB; the file is never all in memory at once.
+        fd_reader<std::uint32_t> reader(fd, 1 << 16);
+        auto elements = reader.elements();
+        auto const it = std::find_if(
+            elements.begin(), elements.end(), [](std::uint32_t x) {
+                return 50000 < x;
+            });
+        assert(*it == 50001u);
+    }
+
+    {
+        // Whole blocks at a time, with no per-element test for the end of a
+        // block.
+        ::lseek(fd, 0, SEEK_SET);
+        fd_reader<std::uint32_t> reader(fd, 1 << 16);
+        std::uint64_t sum = 0;
+        for (auto block : reader.blocks()) {
+            sum = std::accumulate(block.begin(), block.end(), sum);
+        }
+        assert(sum == 99999ull * 100000 / 2);
+        assert(reader.trailing_bytes() == 0u);
+    }
+
+    ::close(fd);
+    //]
+
+    std::remove(path);
+}
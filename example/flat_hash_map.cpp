@@ -0,0 +1,49 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/stl_interfaces/flat_hash_map.hpp>
+
+#include <string>
+
+#include <cassert>
+
+
+using boost::stl_interfaces::flat_hash_map;
+
+
+int main()
+{
+    //[ flat_hash_map_usage
+    flat_hash_map<std::string, int> counts;
+    for (char const * word : {"to", "be", "or", "not", "to", "be"}) {
+        ++counts[word];
+    }
+    assert(counts.size() == 4u);
+    assert(counts.at("to") == 2 && counts.at("or") == 1);
+    assert(!counts.insert({"be", 5}).second);
+    assert(counts.find("question") == counts.end());
+
+    // Erase most of a large table; iteration skips the empty slots a
+    // group of 16 at a time.
+    flat_hash_map<int, int> squares;
+    for (int i = 0; i < 1000; ++i) {
+        squares[i] = i * i;
+    }
+    for (int i = 0; i < 1000; ++i) {
+        if (i % 100)
+            squares.erase(i);
+    }
+    int sum = 0;
+    for (auto const & x : squares) {
+        sum += x.first;
+    }
+    assert(squares.size() == 10u && sum == 4500);
+
+    // Equal maps, whatever the order of their elements.
+    flat_hash_map<int, int> copy(squares.begin(), squares.end());
+    assert(copy == squares);
+    //]
+}
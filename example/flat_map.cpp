@@ -0,0 +1,52 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/stl_interfaces/flat_map.hpp>
+
+#include <string>
+#include <vector>
+
+#include <cassert>
+
+
+using boost::stl_interfaces::flat_map;
+using boost::stl_interfaces::flat_set;
+using boost::stl_interfaces::sorted_unique;
+
+
+int main()
+{
+    //[ flat_map_usage
+    flat_map<int, std::string> map = {{3, "three"}, {1, "one"}, {2, "two"}};
+    assert(map.size() == 3u);
+    assert(map.keys() == (std::vector<int>{1, 2, 3}));
+
+    // The references are pairs of references, into the two arrays.
+    auto const it = map.find(2);
+    assert((*it).first == 2 && it->second == "two");
+    it->second = "deux";
+    assert(map[2] == "deux");
+
+    map[0] = "zero";
+    assert(map.begin()->first == 0);
+    assert(!map.insert({1, "un"}).second);
+    assert(map.at(1) == "one");
+
+    // A sorted, unique range is merged with the elements in one pass.
+    std::vector<std::pair<int, std::string>> const more = {
+        {4, "four"}, {5, "five"}, {6, "six"}};
+    map.insert(sorted_unique, more.begin(), more.end());
+    assert(map.size() == 7u);
+    assert(map.rbegin()->second == "six");
+
+    assert(map.erase(3) == 1u);
+    assert(!map.contains(3));
+
+    flat_set<int> set = {5, 3, 1, 3};
+    assert(set.keys() == (std::vector<int>{1, 3, 5}));
+    assert(*set.lower_bound(2) == 3);
+    //]
+}
@@ -0,0 +1,45 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/stl_interfaces/gap_buffer.hpp>
+
+#include <string>
+
+#include <cassert>
+
+
+using boost::stl_interfaces::gap_buffer;
+
+
+int main()
+{
+    //[ gap_buffer_usage
+    std::string const text = "The fox jumps over the dog.";
+    gap_buffer<char> doc(text.begin(), text.end());
+    assert(doc.gap_position() == doc.size());
+
+    // Put the cursor after "The ", and type there.  Only the first edit
+    // moves anything; the rest go into the gap.
+    doc.move_gap(doc.begin() + 4);
+    for (char c : std::string("quikc")) {
+        doc.insert(doc.begin() + doc.gap_position(), c);
+    }
+    // Backspacing erases just before the gap, which moves nothing either.
+    doc.erase(doc.begin() + doc.gap_position() - 2, doc.begin() + 9);
+    std::string const ck = "ck brown ";
+    doc.insert(doc.begin() + 7, ck.begin(), ck.end());
+    assert(
+        std::string(doc.begin(), doc.end()) ==
+        "The quick brown fox jumps over the dog.");
+
+    // Iterators are random access, and the segmented algorithms run over
+    // the parts before and after the gap with pointers.
+    auto const it =
+        boost::stl_interfaces::segmented_find(doc.begin(), doc.end(), 'j');
+    assert(it - doc.begin() == 20);
+    assert(doc[21] == 'u');
+    //]
+}
@@ -0,0 +1,56 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/stl_interfaces/hive.hpp>
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+#include <cassert>
+
+
+using boost::stl_interfaces::hive;
+
+
+int main()
+{
+    //[ hive_usage
+    struct entity
+    {
+        int id;
+        int hit_points;
+    };
+
+    hive<entity> entities;
+    std::vector<entity *> handles;
+    for (int i = 0; i < 1000; ++i) {
+        handles.push_back(&*entities.insert(entity{i, 100}));
+    }
+
+    // Erase nine in ten; the survivors do not move.
+    for (auto it = entities.begin(); it != entities.end();) {
+        if (it->id % 10)
+            it = entities.erase(it);
+        else
+            ++it;
+    }
+    assert(entities.size() == 100u);
+    assert(handles[990]->id == 990);
+
+    // Iteration jumps over each run of erased slots in one step.
+    int const total = std::accumulate(
+        entities.begin(), entities.end(), 0, [](int n, entity const & e) {
+            return n + e.hit_points;
+        });
+    assert(total == 100 * 100);
+
+    // New elements fill the holes, rather than growing the hive.
+    entity * const e = &*entities.insert(entity{1000, 50});
+    auto const index = std::find(handles.begin(), handles.end(), e);
+    assert(index != handles.end() && (index - handles.begin()) % 10);
+    //]
+}
@@ -0,0 +1,71 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/stl_interfaces/intrusive_list.hpp>
+
+#include <numeric>
+#include <vector>
+
+#include <cassert>
+
+
+using boost::stl_interfaces::intrusive_list;
+using boost::stl_interfaces::list_hook;
+
+
+int main()
+{
+    //[ intrusive_list_usage
+    // An order is in the list of orders at its price level, and in the list
+    // of its owner's orders, at the same time.
+    struct order
+    {
+        int id;
+        int quantity;
+        list_hook by_level;
+        list_hook by_owner;
+    };
+    using level_list = intrusive_list<order, &order::by_level>;
+    using owner_list = intrusive_list<order, &order::by_owner>;
+
+    std::vector<order> orders(6);
+    level_list levels[2];
+    owner_list owners[3];
+    for (int i = 0; i < 6; ++i) {
+        orders[i].id = i;
+        orders[i].quantity = 10 * (i + 1);
+        levels[i % 2].push_back(orders[i]);
+        owners[i % 3].push_back(orders[i]);
+    }
+    assert(levels[0].size() == 3u && owners[0].size() == 2u);
+
+    // Cancelling all of owner 1's orders takes each one out of its price
+    // level, found through the order alone.
+    for (auto & o : owners[1]) {
+        levels[o.id % 2].erase(level_list::iterator_to(o));
+    }
+    owners[1].clear();
+    assert(levels[0].size() == 2u && levels[1].size() == 2u);
+
+    // Price level 1 is merged into level 0, by relinking; nothing is
+    // allocated or copied.
+    levels[0].splice(levels[0].end(), levels[1]);
+    assert(levels[1].empty());
+    int const total = std::accumulate(
+        levels[0].begin(), levels[0].end(), 0, [](int n, order const & o) {
+            return n + o.quantity;
+        });
+    assert(total == 10 + 30 + 40 + 60);
+
+    // Each order must be unlinked before it is destroyed.
+    for (auto & list : levels) {
+        list.clear();
+    }
+    for (auto & list : owners) {
+        list.clear();
+    }
+    //]
+}
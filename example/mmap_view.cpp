@@ -0,0 +1,61 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/stl_interfaces/mmap_view.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <numeric>
+
+#include <cassert>
+
+
+using boost::stl_interfaces::mmap_view;
+using boost::stl_interfaces::mmap_sequential;
+using boost::stl_interfaces::mmap_willneed;
+
+
+int main()
+{
+    //[ mmap_view_usage
+    struct trade
+    {
+        std::uint64_t timestamp;
+        std::uint32_t price;
+        std::uint32_t quantity;
+    };
+
+    char const * path = "mmap_view_example.bin";
+    {
+        std::ofstream ofs(path, std::ios::binary);
+        for (std::uint32_t i = 0; i < 1000; ++i) {
+            trade const t = {1000u + i, 100u + i % 7, i};
+            ofs.write(reinterpret_cast<char const *>(&t), sizeof(t));
+        }
+    }
+
+    {
+        // No copy of the file is made; the records are read in as they are
+        // touched.
+        mmap_view<trade> trades(path, mmap_sequential | mmap_willneed);
+        assert(trades.size() == 1000u);
+        assert(trades.front().timestamp == 1000u);
+        assert(trades.back().quantity == 999u);
+        assert(trades[500].price == 100u + 500 % 7);
+        assert(trades.data() == &trades.front());
+
+        auto const volume = std::accumulate(
+            trades.begin(),
+            trades.end(),
+            std::uint64_t(0),
+            [](std::uint64_t n, trade const & t) { return n + t.quantity; });
+        assert(volume == 999u * 1000u / 2);
+    }
+    //]
+
+    std::remove(path);
+}
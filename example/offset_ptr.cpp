@@ -0,0 +1,81 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/stl_interfaces/offset_ptr.hpp>
+
+#include <numeric>
+#include <new>
+
+#include <cassert>
+#include <cstdio>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+
+using boost::stl_interfaces::offset_iterator;
+using boost::stl_interfaces::offset_ptr;
+using boost::stl_interfaces::offset_vector;
+
+
+int main()
+{
+    //[ offset_ptr_usage
+    // The layout of a shared segment: a book of price levels, a reader's
+    // cursor into it, and the buffer the levels live in.
+    struct level
+    {
+        long price;
+        long quantity;
+    };
+    struct segment
+    {
+        segment() : levels(buffer, 64) {}
+
+        offset_vector<level> levels;
+        offset_iterator<level> cursor;
+        level buffer[64];
+    };
+
+    // One file, mapped twice, at two different addresses -- as two
+    // processes would map it.
+    std::FILE * file = std::tmpfile();
+    int const fd = fileno(file);
+    if (ftruncate(fd, sizeof(segment)) != 0)
+        return 1;
+    void * const a = mmap(
+        nullptr, sizeof(segment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    void * const b = mmap(
+        nullptr, sizeof(segment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    assert(a != MAP_FAILED && b != MAP_FAILED && a != b);
+
+    // The writer builds the segment in place, through its mapping.
+    segment & writer = *::new (a) segment;
+    for (long i = 0; i < 10; ++i) {
+        writer.levels.push_back(level{100 + i, 10 * i});
+    }
+    writer.cursor = writer.levels.begin() + 3;
+
+    // The reader sees the same vector and cursor through its own mapping,
+    // with no copy, fix-up, or decoding.
+    segment & reader = *static_cast<segment *>(b);
+    assert(reader.levels.size() == 10u);
+    assert(reader.levels.data() == reader.buffer);
+    assert(reader.levels[4].price == 104);
+    assert(reader.cursor->price == 103);
+    long const remaining = std::accumulate(
+        reader.cursor.get(),
+        reader.levels.end(),
+        0L,
+        [](long n, level const & l) { return n + l.quantity; });
+    assert(remaining == 10 * (3 + 4 + 5 + 6 + 7 + 8 + 9));
+    //]
+
+    writer.~segment();
+    munmap(a, sizeof(segment));
+    munmap(b, sizeof(segment));
+    std::fclose(file);
+}
@@ -0,0 +1,43 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/stl_interfaces/packed_int_vector.hpp>
+
+#include <vector>
+
+#include <cassert>
+
+
+using boost::stl_interfaces::packed_int_vector;
+
+
+int main()
+{
+    //[ packed_int_vector_usage
+    // 1000 12-bit values take 188 words, instead of 500 for std::uint32_t.
+    packed_int_vector<12> v;
+    for (std::uint32_t i = 0; i < 1000; ++i) {
+        v.push_back(i * 4);
+    }
+    assert(v[999] == 3996);
+    assert(v.back() == 3996);
+
+    v[10] = packed_int_vector<12>::max_value;
+    assert(v[10] == 4095);
+    assert(v[11] == 44);
+
+    // The bulk unpack goes 64 elements at a time.
+    std::vector<std::uint32_t> decoded(v.size());
+    copy(v.cbegin(), v.cend(), decoded.data());
+    assert(decoded[10] == 4095);
+    assert(decoded[500] == 2000);
+
+    // So does the bulk pack, back into the elements.
+    decoded[500] = 7;
+    copy(decoded.data(), decoded.data() + decoded.size(), v.begin());
+    assert(v[500] == 7);
+    //]
+}
@@ -0,0 +1,35 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/stl_interfaces/pool_forward_list.hpp>
+
+#include <numeric>
+
+
+using boost::stl_interfaces::pool_forward_list;
+
+
+int main()
+{
+    //[ pool_forward_list_usage
+    pool_forward_list<int> events = {3, 4};
+    events.push_front(2);
+    events.push_back(5);
+    assert(events.size() == 4u);
+    assert(std::accumulate(events.begin(), events.end(), 0) == 14);
+
+    pool_forward_list<int> more = {0, 1};
+    // Takes more's nodes and their slabs; nothing is copied or allocated.
+    events.splice_after(events.before_begin(), more);
+    assert(more.empty());
+    assert(events == (pool_forward_list<int>{0, 1, 2, 3, 4, 5}));
+
+    // Keeps the slabs for the next round of insertions.
+    events.clear();
+    events.push_front(42);
+    assert(events.front() == 42);
+    //]
+}
@@ -0,0 +1,59 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/stl_interfaces/record_view.hpp>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <cassert>
+
+
+using boost::stl_interfaces::record_span;
+using boost::stl_interfaces::record_view;
+
+
+// Appends a record to buffer.
+void append_record(std::vector<unsigned char> & buffer, std::string const & s)
+{
+    std::uint32_t const length = std::uint32_t(s.size());
+    auto const p = reinterpret_cast<unsigned char const *>(&length);
+    buffer.insert(buffer.end(), p, p + sizeof(length));
+    buffer.insert(buffer.end(), s.begin(), s.end());
+}
+
+int main()
+{
+    //[ record_view_usage
+    std::vector<unsigned char> buffer;
+    append_record(buffer, "GET /index.html");
+    append_record(buffer, "");
+    append_record(buffer, "GET /favicon.ico");
+    // The first 6 bytes of a record that has not all arrived yet.
+    append_record(buffer, "POST /form");
+    buffer.resize(buffer.size() - 8);
+
+    record_view<> records(buffer.data(), buffer.size());
+    assert(std::distance(records.begin(), records.end()) == 3);
+    // Each record is a view of its bytes in the buffer.
+    assert(records.front().str() == "GET /index.html");
+    assert(records.front().data() == buffer.data() + 4);
+    assert(std::count_if(
+               records.begin(), records.end(), [](record_span r) {
+                   return r.empty();
+               }) == 1);
+
+    // The partial record is left over, to be completed by the next read.
+    assert(records.remainder().size() == 6u);
+
+    // Random access, through a table of offsets built on first use.
+    auto indexed = records.indexed();
+    assert(indexed.size() == 3);
+    assert(indexed[2].str() == "GET /favicon.ico");
+    assert(indexed.back().size() == 16u);
+    //]
+}
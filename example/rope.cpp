@@ -0,0 +1,41 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/stl_interfaces/rope.hpp>
+
+#include <string>
+
+#include <cassert>
+
+
+using boost::stl_interfaces::rope;
+
+
+int main()
+{
+    //[ rope_usage
+    std::string const text = "The quick fox jumps over the dog.";
+    rope<char, 8> doc(text.begin(), text.end());
+    assert(doc.leaf_count() == 5u);
+
+    // Edits in the middle move at most a leaf's worth of characters.
+    std::string const brown = "brown ";
+    doc.insert(doc.begin() + 10, brown.begin(), brown.end());
+    std::string const lazy = "lazy ";
+    doc.insert(doc.begin() + 35, lazy.begin(), lazy.end());
+    doc.erase(doc.begin() + 4, doc.begin() + 10);
+    assert(
+        std::string(doc.begin(), doc.end()) ==
+        "The brown fox jumps over the lazy dog.");
+
+    // Iterators are random access, and the segmented algorithms go a leaf
+    // at a time.
+    auto const it =
+        boost::stl_interfaces::segmented_find(doc.begin(), doc.end(), 'j');
+    assert(it - doc.begin() == 14);
+    assert(doc[it - doc.begin() + 1] == 'u');
+    //]
+}
@@ -0,0 +1,45 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/stl_interfaces/segmented_vector.hpp>
+
+#include <string>
+
+#include <cassert>
+
+
+using boost::stl_interfaces::segmented_vector;
+
+
+int main()
+{
+    //[ segmented_vector_usage
+    segmented_vector<std::string, 4> log;
+    log.push_back("start");
+    std::string const & first = log.front();
+
+    // Growing never moves the elements, so references stay valid.
+    for (int i = 0; i < 100; ++i) {
+        log.push_back(std::to_string(i));
+    }
+    assert(&first == &log.front());
+    assert(log.chunk_count() == 26u);
+    assert(log[1] == "0");
+    assert(log.back() == "99");
+
+    // The segmented algorithms go a chunk at a time, with pointers.
+    auto const it = boost::stl_interfaces::segmented_find(
+        log.begin(), log.end(), std::string("42"));
+    assert(it - log.begin() == 43);
+    std::size_t const total_length =
+        boost::stl_interfaces::segmented_accumulate(
+            log.begin(),
+            log.end(),
+            std::size_t(0),
+            [](std::size_t n, std::string const & s) { return n + s.size(); });
+    assert(total_length == 5 + 10 + 90 * 2);
+    //]
+}
@@ -0,0 +1,37 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/stl_interfaces/small_vector.hpp>
+
+#include <numeric>
+
+
+using boost::stl_interfaces::small_vector;
+
+
+int main()
+{
+    //[ small_vector_usage
+    small_vector<int, 4> v = {1, 2, 3};
+    assert(v.is_inline());
+
+    v.push_back(4);
+    assert(v.is_inline());
+    assert(v.capacity() == 4u);
+
+    // The fifth element does not fit inline, so the elements spill to the
+    // heap, in storage twice as big.
+    v.push_back(5);
+    assert(!v.is_inline());
+    assert(v.capacity() == 8u);
+    assert(std::accumulate(v.begin(), v.end(), 0) == 15);
+
+    v.erase(v.begin() + 3, v.end());
+    v.shrink_to_fit();
+    assert(v.is_inline());
+    assert(v == (small_vector<int, 4>{1, 2, 3}));
+    //]
+}
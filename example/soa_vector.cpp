@@ -0,0 +1,37 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/stl_interfaces/soa_vector.hpp>
+
+#include <numeric>
+#include <string>
+
+
+using boost::stl_interfaces::soa_vector;
+
+
+int main()
+{
+    //[ soa_vector_usage
+    soa_vector<int, std::string> vec;
+    vec.emplace_back(42, "forty-two");
+    vec.push_back(std::make_tuple(13, std::string("thirteen")));
+    assert(vec.size() == 2u);
+    assert(std::get<0>(vec[0]) == 42);
+    assert(std::get<1>(vec[1]) == "thirteen");
+
+    // Each field is its own array.
+    int const * ints = vec.data<0>();
+    assert(std::accumulate(ints, ints + vec.size(), 0) == 55);
+
+    // The proxy references work with the standard algorithms.
+    std::sort(vec.begin(), vec.end());
+    assert(std::get<1>(vec.front()) == "thirteen");
+
+    vec.erase(vec.begin());
+    assert(vec == (soa_vector<int, std::string>({{42, "forty-two"}})));
+    //]
+}
@@ -0,0 +1,54 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/stl_interfaces/split_vector.hpp>
+
+#include <string>
+
+
+using boost::stl_interfaces::split_vector;
+
+
+//[ split_vector_usage
+// The members a scan over the orders reads...
+struct order_hot
+{
+    double price;
+    int quantity;
+};
+// ...and the ones it does not.
+struct order_cold
+{
+    std::string account;
+    std::string venue;
+};
+
+int main()
+{
+    split_vector<order_hot, order_cold> orders;
+    orders.emplace_back(order_hot{101.5, 10}, order_cold{"acct-1", "XNYS"});
+    orders.emplace_back(order_hot{99.0, 5}, order_cold{"acct-2", "XNAS"});
+    assert(orders.size() == 2u);
+    assert(orders[1].cold.venue == "XNAS");
+
+    // A scan through hot_data() never touches the cold halves.
+    order_hot const * hot = orders.hot_data();
+    int shares = 0;
+    for (std::size_t i = 0; i < orders.size(); ++i) {
+        shares += hot[i].quantity;
+    }
+    assert(shares == 15);
+
+    // The proxy references work with the standard algorithms.
+    std::sort(orders.begin(), orders.end(), [](auto lhs, auto rhs) {
+        return lhs.hot.price < rhs.hot.price;
+    });
+    assert(orders.front().cold.account == "acct-2");
+
+    orders.erase(orders.begin());
+    assert(orders.size() == 1u && orders[0].hot.quantity == 10);
+}
+//]
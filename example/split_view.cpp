@@ -0,0 +1,50 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/stl_interfaces/split_view.hpp>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <cassert>
+
+
+using boost::stl_interfaces::char_span;
+using boost::stl_interfaces::lines;
+using boost::stl_interfaces::split_view;
+
+
+int main()
+{
+    //[ split_view_usage
+    std::string const log =
+        "12:00:01 INFO start\n"
+        "12:00:02 WARN disk 91%\n"
+        "12:00:03 INFO ok\n";
+
+    // Each line is a char_span into log; nothing is copied.
+    auto const log_lines = lines(log);
+    assert(std::distance(log_lines.begin(), log_lines.end()) == 3);
+    assert(log_lines.front().str() == "12:00:01 INFO start");
+    assert(log_lines.front().data() == log.data());
+
+    std::vector<std::string> levels;
+    for (auto line : log_lines) {
+        // The second field of each line.
+        auto fields = split_view(line, ' ');
+        levels.push_back(std::next(fields.begin())->str());
+    }
+    assert((levels == std::vector<std::string>{"INFO", "WARN", "INFO"}));
+
+    // Splitting keeps the empty pieces, as std::views::split() does.
+    std::string const csv = "a,,b,";
+    split_view fields(csv.data(), csv.data() + csv.size(), ',');
+    assert(std::count_if(fields.begin(), fields.end(), [](char_span f) {
+               return f.empty();
+           }) == 2);
+    //]
+}
@@ -0,0 +1,53 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/stl_interfaces/spsc_queue.hpp>
+
+#include <numeric>
+#include <thread>
+
+
+using boost::stl_interfaces::spsc_queue;
+
+
+int main()
+{
+    //[ spsc_queue_usage
+    spsc_queue<int, 1024> queue;
+    int const count = 100000;
+
+    // The producer fills as many free slots as it can get, and publishes
+    // each batch with one atomic store.
+    std::thread producer([&] {
+        int i = 0;
+        while (i < count) {
+            auto const slots = queue.write_span();
+            auto const n = (std::min)(int(slots.size()), count - i);
+            std::iota(slots.begin(), slots.begin() + n, i);
+            queue.commit_write(n);
+            i += n;
+        }
+    });
+
+    // The consumer does the same with the ready slots.
+    long long sum = 0;
+    int next = 0;
+    bool in_order = true;
+    while (next < count) {
+        auto const ready = queue.read_span();
+        for (int x : ready) {
+            in_order = in_order && x == next++;
+            sum += x;
+        }
+        queue.commit_read(ready.size());
+    }
+    producer.join();
+
+    assert(in_order);
+    assert(sum == (long long)count * (count - 1) / 2);
+    assert(queue.empty());
+    //]
+}
@@ -4,6 +4,8 @@
 // accompanying file LICENSE_1_0.txt or copy at
 // http://www.boost.org/LICENSE_1_0.txt)
 #include <boost/stl_interfaces/container_interface.hpp>
+#include <boost/stl_interfaces/trivially_relocatable.hpp>
+#include <boost/stl_interfaces/detail/relocate.hpp>
 
 #include <algorithm>
 #include <iterator>
@@ -90,14 +92,12 @@ struct static_vector : container_interface<
         this->assign(other.begin(), other.end());
     }
     static_vector(static_vector && other) noexcept(
+        relocatable ||
         noexcept(std::declval<static_vector>().emplace_back(
             std::move(*other.begin())))) :
         size_(0)
     {
-        for (auto & element : other) {
-            emplace_back(std::move(element));
-        }
-        other.clear();
+        steal(other);
     }
     static_vector & operator=(static_vector const & other)
     {
@@ -105,14 +105,13 @@ struct static_vector : container_interface<
         this->assign(other.begin(), other.end());
         return *this;
     }
-    static_vector & operator=(static_vector && other) noexcept(noexcept(
-        std::declval<static_vector>().emplace_back(std::move(*other.begin()))))
+    static_vector & operator=(static_vector && other) noexcept(
+        relocatable ||
+        noexcept(std::declval<static_vector>().emplace_back(
+            std::move(*other.begin()))))
     {
         this->clear();
-        for (auto & element : other) {
-            emplace_back(std::move(element));
-        }
-        other.clear();
+        steal(other);
         return *this;
     }
 
@@ -131,7 +130,8 @@ struct static_vector : container_interface<
     //
     // Most of these are not even part of the general requirements, because
     // some are specific to std::vector and related types.  However, we do get
-    // empty, size, and the unary overload of resize from container_interface.
+    // empty, size, and the unary overload of resize from container_interface,
+    // plus resize_for_overwrite.
     size_type max_size() const noexcept { return N; }
     size_type capacity() const noexcept { return N; }
     void resize(size_type sz, T const & x) noexcept
@@ -143,6 +143,19 @@ struct static_vector : container_interface<
             std::uninitialized_fill(end(), begin() + sz, x);
         size_ = sz;
     }
+    // This overload is like the one above, except that the new elements are
+    // default-initialized -- left uninitialized, for types like int.  Because
+    // we provide it, container_interface provides resize_for_overwrite(n).
+    void resize(size_type sz, boost::stl_interfaces::default_init_t) noexcept
+    {
+        assert(sz <= capacity());
+        if (sz < this->size())
+            erase(begin() + sz, end());
+        for (auto it = end(), last = begin() + sz; it < last; ++it) {
+            new (it) T;
+        }
+        size_ = sz;
+    }
     void reserve(size_type n) noexcept { assert(n < capacity()); }
     void shrink_to_fit() noexcept {}
 
@@ -169,13 +182,40 @@ struct static_vector : container_interface<
     template<typename... Args>
     reference emplace_back(Args &&... args)
     {
-        return *emplace(end(), std::forward<Args>(args)...);
+        assert(this->size() < capacity());
+        return unchecked_emplace_back(std::forward<Args>(args)...);
+    }
+    // unchecked_emplace_back is emplace_back without the capacity check, for
+    // callers that have already made sure there is room.  container_interface
+    // provides unchecked_push_back in terms of it.  (If we did not provide
+    // it, container_interface would provide one that just calls
+    // emplace_back.)
+    template<typename... Args>
+    reference unchecked_emplace_back(Args &&... args)
+    {
+        auto const position = end();
+        new (position) T(std::forward<Args>(args)...);
+        ++size_;
+        return *position;
     }
     template<typename... Args>
     iterator emplace(const_iterator pos, Args &&... args)
     {
         auto position = const_cast<T *>(pos);
         bool const insert_before_end = position < end();
+        if (relocatable && insert_before_end) {
+            // The new element is constructed off to the side first, since
+            // args may refer to an element that is about to be relocated.
+            alignas(T) unsigned char tmp_buf[sizeof(T)];
+            auto const tmp = ::new (static_cast<void *>(tmp_buf))
+                T(std::forward<Args>(args)...);
+            boost::stl_interfaces::uninitialized_relocate_backward(
+                position, end(), end() + 1);
+            boost::stl_interfaces::uninitialized_relocate(
+                tmp, tmp + 1, position);
+            ++size_;
+            return position;
+        }
         if (insert_before_end) {
             auto last = end();
             emplace_back(std::move(this->back()));
@@ -198,26 +238,57 @@ struct static_vector : container_interface<
     {
         auto position = const_cast<T *>(pos);
         auto const insertions = std::distance(first, last);
-        assert(this->size() + insertions < capacity());
-        std::uninitialized_fill_n(end(), insertions, T());
-        std::move_backward(position, end(), end() + insertions);
-        std::copy(first, last, position);
+        assert(this->size() + insertions <= capacity());
+        // gap_insert() opens a gap of size insertions at position and
+        // copy-constructs (or copy-assigns) the new elements into it, in a
+        // single pass.  It relocates the tail with memmove() when T is
+        // trivially relocatable.
+        boost::stl_interfaces::detail::gap_insert(
+            position, end(), first, last, insertions);
         size_ += insertions;
         return position;
     }
     iterator erase(const_iterator f, const_iterator last)
     {
         auto first = const_cast<T *>(f);
-        auto end_ = this->cend();
-        auto it = std::move(last, end_, first);
+        if (relocatable) {
+            for (auto it = first; it != last; ++it) {
+                it->~T();
+            }
+            boost::stl_interfaces::uninitialized_relocate(
+                const_cast<T *>(last), end(), first);
+            size_ -= last - first;
+            return first;
+        }
+        auto end_ = this->end();
+        auto it = std::move(const_cast<T *>(last), end_, first);
         for (; it != end_; ++it) {
             it->~T();
         }
         size_ -= last - first;
         return first;
     }
+    // destroy_all ends the lifetimes of all the elements, and empties the
+    // vector.  container_interface's clear() uses it, when it is provided,
+    // instead of erase(begin(), end()); for a trivially destructible T, the
+    // loop compiles away, leaving just the store to size_.
+    void destroy_all() noexcept
+    {
+        for (auto it = begin(), last = end(); it != last; ++it) {
+            it->~T();
+        }
+        size_ = 0;
+    }
     void swap(static_vector & other)
     {
+        if (relocatable) {
+            // When T is trivially relocatable, so is static_vector<T, N> (see
+            // the specialization of is_trivially_relocatable below), and
+            // relocating_swap() swaps the two vectors' sizes and the bytes of
+            // their first max(size()) elements.
+            boost::stl_interfaces::relocating_swap(*this, other);
+            return;
+        }
         size_type short_size, long_size;
         std::tie(short_size, long_size) =
             std::minmax(this->size(), other.size());
@@ -239,7 +310,7 @@ struct static_vector : container_interface<
             shorter->emplace_back(std::move(*it));
         }
 
-        longer->resize(short_size);
+        longer->erase(longer->begin() + short_size, longer->end());
         shorter->size_ = long_size;
     }
 
@@ -259,7 +330,42 @@ struct static_vector : container_interface<
     // comparisons (skipped 6)
 
 private:
+    // When T is trivially relocatable, moving elements around within or
+    // between static_vectors is done with memmove() instead of T's move
+    // constructor and destructor.
+    static constexpr bool relocatable =
+        boost::stl_interfaces::is_trivially_relocatable<T>::value;
+
+    void steal(static_vector & other) noexcept(
+        relocatable || noexcept(std::declval<static_vector>().emplace_back(
+                           std::move(*other.begin()))))
+    {
+        if (relocatable) {
+            boost::stl_interfaces::uninitialized_relocate(
+                other.begin(), other.end(), begin());
+            size_ = other.size_;
+            other.size_ = 0;
+            return;
+        }
+        // One pass constructs all the elements, and the size is set once.
+        std::uninitialized_copy(
+            std::make_move_iterator(other.begin()),
+            std::make_move_iterator(other.end()),
+            begin());
+        size_ = other.size_;
+        other.clear();
+    }
+
     alignas(T) unsigned char buf_[N * sizeof(T)];
     size_type size_;
 };
+
+// A static_vector is trivially relocatable if its elements are.  This makes
+// the free swap() that container_interface provides use relocating_swap().
+namespace boost { namespace stl_interfaces {
+    template<typename T, std::size_t N>
+    struct is_trivially_relocatable<static_vector<T, N>>
+        : is_trivially_relocatable<T>
+    {};
+}}
 //]
@@ -0,0 +1,44 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/stl_interfaces/algorithm.hpp>
+#include <boost/stl_interfaces/varint_sequence.hpp>
+
+#include <cassert>
+
+
+using boost::stl_interfaces::varint_sequence;
+
+
+int main()
+{
+    //[ varint_sequence_usage
+    // A posting list: the sorted IDs of the documents that have some word.
+    std::vector<std::uint32_t> const ids = {
+        3, 7, 8, 20, 300, 301, 70000, 70001, 70005};
+
+    varint_sequence const postings(ids.begin(), ids.end());
+    assert(postings.size() == ids.size());
+    // Seven differences take a byte each, one takes two, and one three;
+    // with three control bytes, that is 15 bytes rather than 36.
+    assert(postings.encoded_size() == 15u);
+
+    // Decoding one element at a time, as the iterator advances.
+    assert(std::equal(postings.begin(), postings.end(), ids.begin()));
+    assert(*std::find(postings.begin(), postings.end(), 301u) == 301u);
+
+    // Decoding a block at a time, with SIMD where it is available.
+    std::vector<std::uint32_t> decoded(postings.size());
+    postings.view().decode(decoded.data());
+    assert(decoded == ids);
+
+    // copy() from algorithm.hpp decodes through read_n(), too.
+    auto it = std::next(postings.begin(), 2);
+    std::vector<std::uint32_t> tail(postings.size() - 2);
+    boost::stl_interfaces::copy(it, postings.end(), tail.data());
+    assert(tail.front() == 8u && tail.back() == 70005u);
+    //]
+}
@@ -0,0 +1,401 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_FUZZ_DIFFERENTIAL_HPP
+#define BOOST_STL_INTERFACES_FUZZ_DIFFERENTIAL_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iterator>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+// Differential fuzzing of the library's sequence containers.  The fuzzer's
+// input is read as a sequence of operations -- push_back(), insert(),
+// erase(), resize(), assign(), swap() and the rest -- each of which is
+// applied to a container under test and to a std::vector.  After each one,
+// the two must hold the same elements, and the iterators the operation
+// returned must be at the same offsets; if not, the fuzzer aborts, and
+// libFuzzer saves the input that did it.
+//
+// Each operation on the container under test is also timed.  When the
+// fuzzer exits, it prints, for each kind of operation, how many were run,
+// their mean time, and the slowest one, with the container's size at the
+// time, so that a slow path -- an erase that is quadratic in the size, say
+// -- shows up along with any wrong results.  With the environment variable
+// FUZZ_OP_TIME_LIMIT_NS set, an operation that takes longer than that many
+// nanoseconds aborts, and its input is saved as a reproducer.  Time is
+// noisy, so the limit should be far above the times in the table.
+//
+// A fuzzer for a new container is a call to fuzz::differential<C>() from
+// LLVMFuzzerTestOneInput().  C must have the members of a sequence
+// container that the operations use, except resize(), which not every
+// sequence has; the resize ops are skipped for a C without it, and ops that
+// would grow it past max_size() are skipped.
+
+namespace fuzz {
+
+    // The fuzzer's input, read from the front; past its end, it reads as
+    // zeros.
+    struct input
+    {
+        input(std::uint8_t const * data, std::size_t size) noexcept :
+            p_(data),
+            last_(data + size)
+        {}
+
+        bool empty() const noexcept { return p_ == last_; }
+        std::uint8_t byte() noexcept { return p_ == last_ ? 0 : *p_++; }
+        // A number in [0, bound], or 0 if bound is 0.
+        std::size_t up_to(std::size_t bound) noexcept
+        {
+            return byte() % (bound + 1);
+        }
+
+    private:
+        std::uint8_t const * p_;
+        std::uint8_t const * last_;
+    };
+
+    inline void make_value(input & in, int & x) noexcept { x = in.byte(); }
+    // Some strings are too long for the small-string buffer, so that
+    // copies and moves allocate.
+    inline void make_value(input & in, std::string & s)
+    {
+        auto const b = in.byte();
+        s.assign(b % 32u, char('a' + b % 26u));
+    }
+
+    enum op {
+        push_back,
+        pop_back,
+        insert_one,
+        insert_n,
+        insert_range,
+        erase_one,
+        erase_range,
+        resize,
+        resize_value,
+        assign_n,
+        assign_range,
+        clear,
+        swap,
+        op_count
+    };
+
+    char const * const op_names[op_count] = {
+        "push_back",
+        "pop_back",
+        "insert_one",
+        "insert_n",
+        "insert_range",
+        "erase_one",
+        "erase_range",
+        "resize",
+        "resize_value",
+        "assign_n",
+        "assign_range",
+        "clear",
+        "swap"};
+
+    // The timings of each kind of op on one container type, printed at
+    // exit.
+    struct op_timings
+    {
+        explicit op_timings(char const * container) : container_(container)
+        {
+            if (char const * limit = std::getenv("FUZZ_OP_TIME_LIMIT_NS"))
+                limit_ns_ = std::strtoll(limit, nullptr, 10);
+        }
+        op_timings(op_timings const &) = delete;
+        op_timings & operator=(op_timings const &) = delete;
+        ~op_timings()
+        {
+            std::fprintf(stderr, "%s: op timings (ns)\n", container_);
+            std::fprintf(
+                stderr,
+                "  %-14s %10s %10s %10s %8s\n",
+                "op",
+                "count",
+                "mean",
+                "max",
+                "at size");
+            for (int i = 0; i < op_count; ++i) {
+                auto const & t = timings_[i];
+                if (!t.count)
+                    continue;
+                std::fprintf(
+                    stderr,
+                    "  %-14s %10lld %10lld %10lld %8zu\n",
+                    op_names[i],
+                    t.count,
+                    t.total_ns / t.count,
+                    t.max_ns,
+                    t.max_size);
+            }
+        }
+
+        void record(op o, long long ns, std::size_t size)
+        {
+            auto & t = timings_[o];
+            ++t.count;
+            t.total_ns += ns;
+            if (t.max_ns < ns) {
+                t.max_ns = ns;
+                t.max_size = size;
+            }
+            if (limit_ns_ && limit_ns_ < ns) {
+                std::fprintf(
+                    stderr,
+                    "%s: %s took %lldns at size %zu, over "
+                    "FUZZ_OP_TIME_LIMIT_NS\n",
+                    container_,
+                    op_names[o],
+                    ns,
+                    size);
+                std::abort();
+            }
+        }
+
+    private:
+        struct timing
+        {
+            long long count = 0;
+            long long total_ns = 0;
+            long long max_ns = 0;
+            std::size_t max_size = 0;
+        };
+
+        char const * container_;
+        long long limit_ns_ = 0;
+        timing timings_[op_count];
+    };
+
+    template<typename F>
+    long long time_ns(F f)
+    {
+        auto const start = std::chrono::steady_clock::now();
+        f();
+        auto const stop = std::chrono::steady_clock::now();
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   stop - start)
+            .count();
+    }
+
+    // The offset of it in c, taken after the call that returned it, which
+    // may have reallocated c.
+    template<typename C, typename Iter>
+    std::ptrdiff_t offset(C & c, Iter it)
+    {
+        return it - c.begin();
+    }
+
+    template<typename C, typename = void>
+    struct has_resize : std::false_type
+    {};
+    template<typename C>
+    struct has_resize<
+        C,
+        decltype((void)std::declval<C &>().resize(
+            std::size_t(0), std::declval<typename C::value_type const &>()))>
+        : std::true_type
+    {};
+
+    // c.resize(n), or c.resize(n, *x) if x is not null, if C has resize().
+    template<typename C, typename T>
+    void resize_to(C & c, std::size_t n, T const * x, std::true_type)
+    {
+        if (x)
+            c.resize(n, *x);
+        else
+            c.resize(n);
+    }
+    template<typename C, typename T>
+    void resize_to(C &, std::size_t, T const *, std::false_type)
+    {}
+
+    template<typename C, typename T>
+    void check(
+        C const & c,
+        std::vector<T> const & v,
+        op o,
+        std::ptrdiff_t c_offset = 0,
+        std::ptrdiff_t v_offset = 0)
+    {
+        if (c_offset == v_offset && std::size_t(c.size()) == v.size() &&
+            std::equal(v.begin(), v.end(), c.begin())) {
+            return;
+        }
+        std::fprintf(
+            stderr,
+            "after %s: the container has %zu elements, and std::vector %zu; "
+            "returned offsets %td and %td\n",
+            op_names[o],
+            std::size_t(c.size()),
+            v.size(),
+            c_offset,
+            v_offset);
+        std::abort();
+    }
+
+    // Applies the ops read from [data, data + size) to a C and to a
+    // std::vector, and aborts if they ever differ.  name labels C's
+    // timings.
+    template<typename C>
+    void differential(
+        std::uint8_t const * data, std::size_t size, char const * name)
+    {
+        using T = typename C::value_type;
+        static op_timings timings(name);
+
+        input in(data, size);
+        C c;
+        C c_other;
+        std::vector<T> v;
+        std::vector<T> v_other;
+        std::size_t const max_size = c.max_size();
+        T x{};
+
+        while (!in.empty()) {
+            auto const o = op(in.byte() % op_count);
+            std::size_t const n = v.size();
+            std::ptrdiff_t c_offset = 0;
+            std::ptrdiff_t v_offset = 0;
+            long long ns = 0;
+            switch (o) {
+            case push_back:
+                if (n == max_size)
+                    continue;
+                make_value(in, x);
+                ns = time_ns([&] { c.push_back(x); });
+                v.push_back(x);
+                break;
+            case pop_back:
+                if (!n)
+                    continue;
+                ns = time_ns([&] { c.pop_back(); });
+                v.pop_back();
+                break;
+            case insert_one: {
+                if (n == max_size)
+                    continue;
+                auto const i = in.up_to(n);
+                make_value(in, x);
+                ns = time_ns([&] {
+                    c_offset = fuzz::offset(c, c.insert(c.begin() + i, x));
+                });
+                v_offset = fuzz::offset(v, v.insert(v.begin() + i, x));
+                break;
+            }
+            case insert_n: {
+                auto const i = in.up_to(n);
+                auto const count = in.up_to((std::min)(max_size - n, n + 64));
+                make_value(in, x);
+                ns = time_ns([&] {
+                    c_offset =
+                        fuzz::offset(c, c.insert(c.begin() + i, count, x));
+                });
+                v_offset = fuzz::offset(v, v.insert(v.begin() + i, count, x));
+                break;
+            }
+            case insert_range: {
+                auto const i = in.up_to(n);
+                std::vector<T> src(in.up_to((std::min)(max_size - n, n + 64)));
+                for (auto & y : src) {
+                    make_value(in, y);
+                }
+                ns = time_ns([&] {
+                    c_offset = fuzz::offset(
+                        c, c.insert(c.begin() + i, src.begin(), src.end()));
+                });
+                v_offset = fuzz::offset(
+                    v, v.insert(v.begin() + i, src.begin(), src.end()));
+                break;
+            }
+            case erase_one: {
+                if (!n)
+                    continue;
+                auto const i = in.up_to(n - 1);
+                ns = time_ns([&] {
+                    c_offset = fuzz::offset(c, c.erase(c.begin() + i));
+                });
+                v_offset = fuzz::offset(v, v.erase(v.begin() + i));
+                break;
+            }
+            case erase_range: {
+                auto const i = in.up_to(n);
+                auto const j = i + in.up_to(n - i);
+                ns = time_ns([&] {
+                    c_offset = fuzz::offset(
+                        c, c.erase(c.begin() + i, c.begin() + j));
+                });
+                v_offset =
+                    fuzz::offset(v, v.erase(v.begin() + i, v.begin() + j));
+                break;
+            }
+            case resize: {
+                if (!has_resize<C>::value)
+                    continue;
+                auto const count = in.up_to((std::min)(max_size, n + 64));
+                ns = time_ns([&] {
+                    fuzz::resize_to(
+                        c, count, (T const *)nullptr, has_resize<C>{});
+                });
+                v.resize(count);
+                break;
+            }
+            case resize_value: {
+                if (!has_resize<C>::value)
+                    continue;
+                auto const count = in.up_to((std::min)(max_size, n + 64));
+                make_value(in, x);
+                ns = time_ns(
+                    [&] { fuzz::resize_to(c, count, &x, has_resize<C>{}); });
+                v.resize(count, x);
+                break;
+            }
+            case assign_n: {
+                auto const count = in.up_to((std::min)(max_size, n + 64));
+                make_value(in, x);
+                ns = time_ns([&] { c.assign(count, x); });
+                v.assign(count, x);
+                break;
+            }
+            case assign_range: {
+                std::vector<T> src(in.up_to((std::min)(max_size, n + 64)));
+                for (auto & y : src) {
+                    make_value(in, y);
+                }
+                ns = time_ns([&] { c.assign(src.begin(), src.end()); });
+                v.assign(src.begin(), src.end());
+                break;
+            }
+            case clear:
+                ns = time_ns([&] { c.clear(); });
+                v.clear();
+                break;
+            case swap:
+                ns = time_ns([&] { c.swap(c_other); });
+                v.swap(v_other);
+                break;
+            default: break;
+            }
+            timings.record(o, ns, n);
+            fuzz::check(c, v, o, c_offset, v_offset);
+            if (o == swap)
+                fuzz::check(c_other, v_other, o);
+        }
+    }
+
+}
+
+#endif
@@ -0,0 +1,26 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/gap_buffer.hpp>
+
+#include "differential.hpp"
+
+#include <string>
+
+
+using boost::stl_interfaces::gap_buffer;
+
+
+// Each input is run against a gap_buffer of ints, which are relocated with
+// memmove(), and one of strings, which are not.  Its edits move the gap
+// about, and fill the buffer, so that the gap is empty, before it grows.
+extern "C" int
+LLVMFuzzerTestOneInput(std::uint8_t const * data, std::size_t size)
+{
+    fuzz::differential<gap_buffer<int>>(data, size, "gap_buffer<int>");
+    fuzz::differential<gap_buffer<std::string>>(
+        data, size, "gap_buffer<std::string>");
+    return 0;
+}
@@ -0,0 +1,64 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+
+// The main() of the fuzzers when they are built without libFuzzer, which
+// only Clang has.  It runs LLVMFuzzerTestOneInput() on the contents of each
+// file named on the command line -- a crash input that libFuzzer saved, say
+// -- or, if none is, on -runs=N random inputs of up to 4K bytes, from
+// -seed=S.  Other flags are ignored, so that the fuzzers take the same
+// command lines with or without libFuzzer.
+
+extern "C" int
+LLVMFuzzerTestOneInput(std::uint8_t const * data, std::size_t size);
+
+int main(int argc, char * argv[])
+{
+    long runs = 1000;
+    std::uint64_t seed = 1;
+    std::vector<char const *> files;
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strncmp(argv[i], "-runs=", 6))
+            runs = std::atol(argv[i] + 6);
+        else if (!std::strncmp(argv[i], "-seed=", 6))
+            seed = std::strtoull(argv[i] + 6, nullptr, 10);
+        else if (argv[i][0] != '-')
+            files.push_back(argv[i]);
+    }
+
+    std::vector<std::uint8_t> data;
+    for (auto file : files) {
+        std::ifstream ifs(file, std::ios::binary);
+        data.assign(
+            std::istreambuf_iterator<char>(ifs),
+            std::istreambuf_iterator<char>());
+        LLVMFuzzerTestOneInput(data.data(), data.size());
+    }
+    if (!files.empty())
+        return 0;
+
+    // SplitMix64.
+    auto next = [&seed] {
+        std::uint64_t z = (seed += 0x9e3779b97f4a7c15ull);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        return z ^ (z >> 31);
+    };
+    for (long run = 0; run < runs; ++run) {
+        data.resize(next() % 4097);
+        for (auto & b : data) {
+            b = std::uint8_t(next());
+        }
+        LLVMFuzzerTestOneInput(data.data(), data.size());
+    }
+    return 0;
+}
@@ -0,0 +1,27 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/small_vector.hpp>
+
+#include "differential.hpp"
+
+#include <string>
+
+
+using boost::stl_interfaces::small_vector;
+
+
+// Each input is run against a small_vector of ints, which are relocated
+// with memmove(), and one of strings, which are not; both spill out of
+// their inline buffers and back in as the inputs grow and shrink them.
+extern "C" int
+LLVMFuzzerTestOneInput(std::uint8_t const * data, std::size_t size)
+{
+    fuzz::differential<small_vector<int, 8>>(
+        data, size, "small_vector<int, 8>");
+    fuzz::differential<small_vector<std::string, 4>>(
+        data, size, "small_vector<std::string, 4>");
+    return 0;
+}
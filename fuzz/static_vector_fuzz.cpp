@@ -0,0 +1,22 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/static_vector.hpp>
+#include "differential.hpp"
+
+#include <string>
+
+
+// Each input is run against a static_vector of ints, whose elements are
+// copied with memmove(), and one of strings, whose are not.
+extern "C" int
+LLVMFuzzerTestOneInput(std::uint8_t const * data, std::size_t size)
+{
+    fuzz::differential<boost::stl_interfaces::static_vector<int, 64>>(
+        data, size, "static_vector<int, 64>");
+    fuzz::differential<boost::stl_interfaces::static_vector<std::string, 64>>(
+        data, size, "static_vector<std::string, 64>");
+    return 0;
+}
@@ -0,0 +1,701 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_ALGORITHM_HPP
+#define BOOST_STL_INTERFACES_ALGORITHM_HPP
+
+#include <boost/stl_interfaces/container_interface.hpp>
+#include <boost/stl_interfaces/detail/simd.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    namespace v1_dtl {
+        template<typename Iter>
+        using algo_value_t = std::remove_cv_t<
+            typename std::iterator_traits<Iter>::value_type>;
+
+        template<typename T>
+        using simd_lane_t = detail::simd_lane_t<T>;
+
+        // True when [first, last) is an array that to_address(first)
+        // points into.  to_address() is only looked at for contiguous
+        // iterators; for others (reverse_iterator, say) the attempt may not
+        // be SFINAE-friendly.
+        template<
+            typename Iter,
+            bool Contiguous = is_contiguous_iterator<Iter>::value>
+        struct pointer_range : std::false_type
+        {};
+        template<typename Iter>
+        struct pointer_range<Iter, true>
+            : std::integral_constant<
+                  bool,
+                  detail::detector<void, to_address_t, Iter>::value>
+        {};
+
+        // True when [first, last) is an array of arithmetic values that the
+        // kernels in detail/simd.hpp can search.
+        template<typename Iter>
+        using simd_range = std::integral_constant<
+            bool,
+            pointer_range<Iter>::value &&
+                detail::detector<void, simd_lane_t, algo_value_t<Iter>>::
+                    value>;
+
+        // If Iter is a reverse_iterator (this one or std::reverse_iterator),
+        // the iterator it reverses; otherwise Iter.
+        template<typename Iter>
+        struct reversed : std::false_type
+        {
+            using type = Iter;
+        };
+        template<typename Iter>
+        struct reversed<stl_interfaces::reverse_iterator<Iter>>
+            : std::true_type
+        {
+            using type = Iter;
+        };
+        template<typename Iter>
+        struct reversed<std::reverse_iterator<Iter>> : std::true_type
+        {
+            using type = Iter;
+        };
+        template<typename Iter>
+        using reversed_t = typename reversed<Iter>::type;
+
+        // [first, last), for reverse iterators first and last, is the array
+        // [to_address(last.base()), to_address(first.base())) backward.
+        template<typename Iter>
+        using reversed_pointer_range = std::integral_constant<
+            bool,
+            reversed<Iter>::value && pointer_range<reversed_t<Iter>>::value>;
+
+        // A value of type T can be searched for among Iter's values by
+        // searching for it converted to their type: it is the same type,
+        // or both are integers.  (An integer can compare equal to a
+        // floating-point value it does not convert to exactly.)
+        template<typename Iter, typename T>
+        using simd_searchable = std::integral_constant<
+            bool,
+            simd_range<Iter>::value &&
+                (std::is_same<algo_value_t<Iter>, T>::value ||
+                 (std::is_integral<algo_value_t<Iter>>::value &&
+                  std::is_integral<T>::value &&
+                  !std::is_same<T, bool>::value))>;
+
+        // Converts value to Iter's value type, and returns false if no
+        // value of that type compares equal to it.  A value that survives
+        // the round trip is equal to exactly the values equal to its
+        // conversion; one that does not is equal to none of them.
+        template<typename V, typename T>
+        bool simd_needle(T const & value, V & v) noexcept
+        {
+            v = static_cast<V>(value);
+            return static_cast<T>(v) == value;
+        }
+
+        template<typename Iter, typename T>
+        using simd_searchable_reversed = std::integral_constant<
+            bool,
+            reversed<Iter>::value &&
+                simd_searchable<reversed_t<Iter>, T>::value>;
+
+        template<typename Iter, typename T>
+        Iter
+        rfind_impl(Iter first, Iter last, T const & value, std::false_type)
+        {
+            return std::find(first, last, value);
+        }
+        // The first match going backward is the last one in the array, at
+        // index i - 1; Iter(base + i) refers to it, and is last if i is 0.
+        template<typename Iter, typename T>
+        Iter
+        rfind_impl(Iter first, Iter last, T const & value, std::true_type)
+        {
+            algo_value_t<Iter> v;
+            if (first == last || !v1_dtl::simd_needle(value, v))
+                return last;
+            auto const base = last.base();
+            auto const n = std::size_t(first.base() - base);
+            return Iter(
+                base + detail::simd_find_last<simd_lane_t<decltype(v)>>(
+                           stl_interfaces::to_address(base), n, v));
+        }
+
+        template<typename Iter, typename T>
+        Iter find_impl(Iter first, Iter last, T const & value, std::false_type)
+        {
+            return v1_dtl::rfind_impl(
+                first,
+                last,
+                value,
+                simd_searchable_reversed<Iter, T>{});
+        }
+        template<typename Iter, typename T>
+        Iter find_impl(Iter first, Iter last, T const & value, std::true_type)
+        {
+            algo_value_t<Iter> v;
+            if (first == last || !v1_dtl::simd_needle(value, v))
+                return last;
+            auto const n = std::size_t(last - first);
+            return first + detail::simd_find<simd_lane_t<decltype(v)>>(
+                               stl_interfaces::to_address(first), n, v);
+        }
+
+        template<typename Iter, typename T>
+        iter_difference_t<Iter>
+        rcount_impl(Iter first, Iter last, T const & value, std::false_type)
+        {
+            return std::count(first, last, value);
+        }
+        // The matches going backward are those in the array.
+        template<typename Iter, typename T>
+        iter_difference_t<Iter>
+        rcount_impl(Iter first, Iter last, T const & value, std::true_type)
+        {
+            algo_value_t<Iter> v;
+            if (first == last || !v1_dtl::simd_needle(value, v))
+                return 0;
+            auto const base = last.base();
+            auto const n = std::size_t(first.base() - base);
+            return iter_difference_t<Iter>(
+                detail::simd_count<simd_lane_t<decltype(v)>>(
+                    stl_interfaces::to_address(base), n, v));
+        }
+
+        template<typename Iter, typename T>
+        iter_difference_t<Iter>
+        count_impl(Iter first, Iter last, T const & value, std::false_type)
+        {
+            return v1_dtl::rcount_impl(
+                first,
+                last,
+                value,
+                simd_searchable_reversed<Iter, T>{});
+        }
+        template<typename Iter, typename T>
+        iter_difference_t<Iter>
+        count_impl(Iter first, Iter last, T const & value, std::true_type)
+        {
+            algo_value_t<Iter> v;
+            if (first == last || !v1_dtl::simd_needle(value, v))
+                return 0;
+            auto const n = std::size_t(last - first);
+            return iter_difference_t<Iter>(
+                detail::simd_count<simd_lane_t<decltype(v)>>(
+                    stl_interfaces::to_address(first), n, v));
+        }
+
+        template<typename Iter1, typename Iter2>
+        using simd_mismatchable = std::integral_constant<
+            bool,
+            simd_range<Iter1>::value && simd_range<Iter2>::value &&
+                std::is_same<algo_value_t<Iter1>, algo_value_t<Iter2>>::
+                    value>;
+
+        template<typename Iter1, typename Iter2>
+        std::pair<Iter1, Iter2> mismatch_impl(
+            Iter1 first1,
+            Iter1 last1,
+            Iter2 first2,
+            Iter2 last2,
+            std::false_type)
+        {
+            return std::mismatch(first1, last1, first2, last2);
+        }
+        template<typename Iter1, typename Iter2>
+        std::pair<Iter1, Iter2> mismatch_impl(
+            Iter1 first1,
+            Iter1 last1,
+            Iter2 first2,
+            Iter2 last2,
+            std::true_type)
+        {
+            auto const n = (std::min)(
+                std::size_t(last1 - first1), std::size_t(last2 - first2));
+            if (!n)
+                return {first1, first2};
+            auto const i = detail::simd_mismatch<
+                simd_lane_t<algo_value_t<Iter1>>>(
+                stl_interfaces::to_address(first1),
+                stl_interfaces::to_address(first2),
+                n);
+            return {first1 + i, first2 + i};
+        }
+
+        // Two reverse ranges are equal if the arrays they run backward over
+        // are, and those are compared forward.
+        template<typename Iter1, typename Iter2>
+        using simd_mismatchable_reversed = std::integral_constant<
+            bool,
+            reversed<Iter1>::value && reversed<Iter2>::value &&
+                simd_mismatchable<reversed_t<Iter1>, reversed_t<Iter2>>::
+                    value>;
+
+        template<typename Iter1, typename Iter2>
+        bool equal_impl(
+            Iter1 first1,
+            Iter1 last1,
+            Iter2 first2,
+            Iter2 last2,
+            std::false_type)
+        {
+            return std::equal(first1, last1, first2, last2);
+        }
+        template<typename Iter1, typename Iter2>
+        bool equal_impl(
+            Iter1 first1,
+            Iter1 last1,
+            Iter2 first2,
+            Iter2 last2,
+            std::true_type)
+        {
+            return last1 - first1 == last2 - first2 &&
+                   v1_dtl::mismatch_impl(
+                       first1, last1, first2, last2, std::true_type{})
+                           .first == last1;
+        }
+
+        template<typename Iter1, typename Iter2>
+        bool requal_impl(
+            Iter1 first1,
+            Iter1 last1,
+            Iter2 first2,
+            Iter2 last2,
+            std::false_type)
+        {
+            return v1_dtl::equal_impl(
+                first1,
+                last1,
+                first2,
+                last2,
+                simd_mismatchable<Iter1, Iter2>{});
+        }
+        template<typename Iter1, typename Iter2>
+        bool requal_impl(
+            Iter1 first1,
+            Iter1 last1,
+            Iter2 first2,
+            Iter2 last2,
+            std::true_type)
+        {
+            return v1_dtl::equal_impl(
+                last1.base(),
+                first1.base(),
+                last2.base(),
+                first2.base(),
+                std::true_type{});
+        }
+
+        // True when the values of [first, last) can be copied to out, or
+        // the values of the array that [first, last) runs backward over can
+        // be, by copying bytes: both are arrays, or reverse_iterators over
+        // arrays, of the same trivially copyable type.
+        template<typename InIter, typename OutIter>
+        using reversible_copy = std::integral_constant<
+            bool,
+            pointer_range<reversed_t<InIter>>::value &&
+                pointer_range<reversed_t<OutIter>>::value &&
+                std::is_same<
+                    algo_value_t<InIter>,
+                    typename std::iterator_traits<OutIter>::value_type>::
+                    value &&
+                std::is_trivially_copyable<algo_value_t<InIter>>::value>;
+
+        // Backward into a forward array.
+        template<typename InIter, typename OutIter>
+        OutIter rcopy_impl(
+            InIter first,
+            InIter last,
+            OutIter out,
+            std::true_type,
+            std::false_type)
+        {
+            auto const n = first.base() - last.base();
+            v1_dtl::reverse_copy_n(
+                stl_interfaces::to_address(last.base()),
+                n,
+                stl_interfaces::to_address(out),
+                detail::detector<void, simd_lane_t, algo_value_t<InIter>>{});
+            return out + n;
+        }
+        // Forward into an array backward: the mirror image of the above.
+        template<typename InIter, typename OutIter>
+        OutIter rcopy_impl(
+            InIter first,
+            InIter last,
+            OutIter out,
+            std::false_type,
+            std::true_type)
+        {
+            auto const n = last - first;
+            v1_dtl::reverse_copy_n(
+                stl_interfaces::to_address(first),
+                n,
+                stl_interfaces::to_address(out.base()) - n,
+                detail::detector<void, simd_lane_t, algo_value_t<InIter>>{});
+            return OutIter(out.base() - n);
+        }
+        // Backward into an array backward: the arrays are copied back to
+        // front, as std::copy_backward() does, which is a memmove().
+        template<typename InIter, typename OutIter>
+        OutIter rcopy_impl(
+            InIter first,
+            InIter last,
+            OutIter out,
+            std::true_type,
+            std::true_type)
+        {
+            auto const n = first.base() - last.base();
+            std::copy_backward(
+                stl_interfaces::to_address(last.base()),
+                stl_interfaces::to_address(first.base()),
+                stl_interfaces::to_address(out.base()));
+            return OutIter(out.base() - n);
+        }
+
+        // Filling a range backward leaves the same values as filling it
+        // forward, unless the assignments themselves can be observed.
+        template<typename Iter>
+        using reversible_fill = std::integral_constant<
+            bool,
+            reversed_pointer_range<Iter>::value &&
+                std::is_trivially_copyable<algo_value_t<Iter>>::value>;
+
+        template<typename Iter, typename T>
+        void fill_impl(Iter first, Iter last, T const & value, std::false_type)
+        {
+            std::fill(first, last, value);
+        }
+        template<typename Iter, typename T>
+        void fill_impl(Iter first, Iter last, T const & value, std::true_type)
+        {
+            std::fill(
+                stl_interfaces::to_address(last.base()),
+                stl_interfaces::to_address(first.base()),
+                value);
+        }
+
+        template<typename Iter>
+        using simd_orderable = std::integral_constant<
+            bool,
+            simd_range<Iter>::value &&
+                std::is_integral<algo_value_t<Iter>>::value>;
+
+        template<bool Max, typename Iter>
+        Iter extremum_impl(Iter first, Iter last, std::false_type)
+        {
+            return Max ? std::max_element(first, last)
+                       : std::min_element(first, last);
+        }
+        template<bool Max, typename Iter>
+        Iter extremum_impl(Iter first, Iter last, std::true_type)
+        {
+            if (first == last)
+                return last;
+            using lane_t = simd_lane_t<algo_value_t<Iter>>;
+            auto const p = stl_interfaces::to_address(first);
+            auto const n = std::size_t(last - first);
+            auto const x = detail::simd_extremum<lane_t, Max>(p, n);
+            return first + detail::simd_find<lane_t>(p, n, x);
+        }
+
+        // The number of elements transform() reads or writes with one
+        // read_n() or write_n() call, through a buffer on the stack.
+        constexpr std::ptrdiff_t batch_size = 256;
+    }
+
+#endif
+
+    /** Returns the first iterator `it` in `[first, last)` for which `*it ==
+        value`, or `last`.
+
+        If `Iter` is contiguous (see `is_contiguous_iterator`) and its
+        values are integers, `float`, or `double`, and `T` is the same type
+        or also an integer, the search is vectorized.  So is a search with a
+        `reverse_iterator` (this one or `std::reverse_iterator`) over such
+        an iterator, such as the `rbegin()` and `rend()` of a contiguous
+        container derived from `container_interface`; it searches the array
+        from its end.  Otherwise, this is `std::find(first, last, value)`. */
+    template<typename Iter, typename T>
+    Iter find(Iter first, Iter last, T const & value)
+    {
+        return v1_dtl::find_impl(
+            first, last, value, v1_dtl::simd_searchable<Iter, T>{});
+    }
+
+    /** Returns the number of iterators `it` in `[first, last)` for which
+        `*it == value`.  It is vectorized under the same conditions as
+        `find()`, including for reverse iterators. */
+    template<typename Iter, typename T>
+    typename std::iterator_traits<Iter>::difference_type
+    count(Iter first, Iter last, T const & value)
+    {
+        return v1_dtl::count_impl(
+            first, last, value, v1_dtl::simd_searchable<Iter, T>{});
+    }
+
+    /** Returns the first pair of iterators `(first1 + i, first2 + i)` at
+        which `first1[i] != first2[i]`, or `(last1, first2 + (last1 -
+        first1))`.
+
+        If `Iter1` and `Iter2` are contiguous, and their value types are
+        the same integer type, `float`, or `double`, the comparison is
+        vectorized.  Otherwise, this is `std::mismatch(first1, last1,
+        first2)`. */
+    template<typename Iter1, typename Iter2>
+    std::pair<Iter1, Iter2> mismatch(Iter1 first1, Iter1 last1, Iter2 first2)
+    {
+        using simd = v1_dtl::simd_mismatchable<Iter1, Iter2>;
+        if (!simd::value)
+            return std::mismatch(first1, last1, first2);
+        return v1_dtl::mismatch_impl(
+            first1, last1, first2, std::next(first2, last1 - first1), simd{});
+    }
+
+    /** Returns the first pair of iterators `(first1 + i, first2 + i)` at
+        which `first1[i] != first2[i]`, or the pair at which the shorter of
+        the two ranges ends.  It is vectorized under the same conditions as
+        the three-argument overload. */
+    template<typename Iter1, typename Iter2>
+    std::pair<Iter1, Iter2>
+    mismatch(Iter1 first1, Iter1 last1, Iter2 first2, Iter2 last2)
+    {
+        return v1_dtl::mismatch_impl(
+            first1,
+            last1,
+            first2,
+            last2,
+            v1_dtl::simd_mismatchable<Iter1, Iter2>{});
+    }
+
+    /** Returns true if `[first1, last1)` and `[first2, last2)` have the
+        same length and equal elements.
+
+        It is vectorized when `mismatch()` is, and also when both ranges are
+        `reverse_iterator`s (this one or `std::reverse_iterator`) over
+        iterators for which `mismatch()` is; those compare the arrays they
+        run backward over, forward.  Otherwise, this is
+        `std::equal(first1, last1, first2, last2)`. */
+    template<typename Iter1, typename Iter2>
+    bool equal(Iter1 first1, Iter1 last1, Iter2 first2, Iter2 last2)
+    {
+        return v1_dtl::requal_impl(
+            first1,
+            last1,
+            first2,
+            last2,
+            v1_dtl::simd_mismatchable_reversed<Iter1, Iter2>{});
+    }
+
+    /** Returns true if `[first1, last1)` and the range of the same length
+        at `first2` have equal elements.  It is vectorized under the same
+        conditions as the four-argument overload. */
+    template<typename Iter1, typename Iter2>
+    bool equal(Iter1 first1, Iter1 last1, Iter2 first2)
+    {
+        using simd = std::integral_constant<
+            bool,
+            v1_dtl::simd_mismatchable<Iter1, Iter2>::value ||
+                v1_dtl::simd_mismatchable_reversed<Iter1, Iter2>::value>;
+        if (!simd::value)
+            return std::equal(first1, last1, first2);
+        return stl_interfaces::equal(
+            first1,
+            last1,
+            first2,
+            std::next(first2, std::distance(first1, last1)));
+    }
+
+    /** Copies `[first, last)`, a reverse range, to `out`, like
+        `std::copy()`, and returns the end of the output.
+
+        This overload only takes part in overload resolution when `Iter` is
+        contiguous, `OutIter` is contiguous or a `reverse_iterator` over a
+        contiguous iterator, and their value types are the same trivially
+        copyable type.  A copy into a forward array reads the array that
+        `[first, last)` runs backward over a vector at a time, and reverses
+        the lanes of each, if its values are integers, `float`, or
+        `double`; a copy into a reverse range is a `std::copy_backward()`
+        of the arrays, which is a `std::memmove()`.  Call it unqualified in
+        code that also has `using std::copy;`, and overload resolution
+        picks this `copy()` for `reverse_iterator`s.
+
+        \pre A forward output does not overlap `[first, last)`; a reverse
+        `out` is not in `[first, last)`. */
+    template<
+        typename Iter,
+        typename OutIter,
+        typename Enable = std::enable_if_t<
+            v1_dtl::reversible_copy<reverse_iterator<Iter>, OutIter>::value>>
+    OutIter
+    copy(reverse_iterator<Iter> first, reverse_iterator<Iter> last, OutIter out)
+    {
+        return v1_dtl::rcopy_impl(
+            first,
+            last,
+            out,
+            std::true_type{},
+            v1_dtl::reversed<OutIter>{});
+    }
+
+    /** Copies `[first, last)` to the reverse range at `out`, like
+        `std::copy()`, and returns the end of the output.  This is the
+        mirror image of the other `copy()` overload, under the same
+        conditions; it does not take part in overload resolution when
+        `Iter` is itself a `reverse_iterator`.
+
+        \pre The output does not overlap `[first, last)`. */
+    template<
+        typename Iter,
+        typename OutIter,
+        typename Enable = std::enable_if_t<
+            !v1_dtl::reversed<Iter>::value &&
+            v1_dtl::reversible_copy<Iter, reverse_iterator<OutIter>>::value>>
+    reverse_iterator<OutIter>
+    copy(Iter first, Iter last, reverse_iterator<OutIter> out)
+    {
+        return v1_dtl::rcopy_impl(
+            first, last, out, std::false_type{}, std::true_type{});
+    }
+
+    /** Assigns `value` to each element of `[first, last)`, a reverse range,
+        like `std::fill()`.  When `Iter` is contiguous and its values are
+        trivially copyable, this fills the array that `[first, last)` runs
+        backward over, forward, which is a `std::memset()` for bytes.  Call
+        it unqualified in code that also has `using std::fill;`, and
+        overload resolution picks this `fill()` for `reverse_iterator`s. */
+    template<typename Iter, typename T>
+    void fill(
+        reverse_iterator<Iter> first,
+        reverse_iterator<Iter> last,
+        T const & value)
+    {
+        v1_dtl::fill_impl(
+            first,
+            last,
+            value,
+            v1_dtl::reversible_fill<reverse_iterator<Iter>>{});
+    }
+
+    /** Copies `[first, last)` to the array at `out`, like `std::copy()`,
+        and returns the end of the output.
+
+        This overload only takes part in overload resolution when `Iter`
+        has a `read_n()` member that can write to `out` (see `read_n`); it
+        is one `read_n()` call for the whole range.  That lets a proxy
+        iterator decode a block of elements at a time in code that calls
+        `copy()` unqualified, and has `using std::copy;`. */
+    template<
+        typename Iter,
+        typename T,
+        typename Enable =
+            std::enable_if_t<v1_dtl::has_read_n<Iter, T>::value>>
+    T * copy(Iter first, Iter last, T * out)
+    {
+        return stl_interfaces::read_n(
+            first, stl_interfaces::distance(first, last), out);
+    }
+
+    /** Copies the array `[first, last)` to `out`, like `std::copy()`, and
+        returns the end of the output.  This is the inverse of the other
+        overload: it only takes part in overload resolution when `Iter` has
+        a `write_n()` member that can read from `first` (see `write_n`), and
+        it is one `write_n()` call. */
+    template<
+        typename T,
+        typename Iter,
+        typename Enable =
+            std::enable_if_t<v1_dtl::has_write_n<Iter, T>::value>>
+    Iter copy(T const * first, T const * last, Iter out)
+    {
+        return stl_interfaces::write_n(first, last - first, out);
+    }
+
+    /** Writes `f(x)` for each element `x` of `[first, last)` to the array at
+        `out`, like `std::transform()`, and returns the end of the output.
+
+        This overload only takes part in overload resolution when `Iter`
+        has a `read_n()` member that can write to an array of its value
+        type.  It reads the elements into a buffer on the stack with
+        `read_n()`, a few hundred at a time, and calls `f` on each element
+        of the buffer. */
+    template<
+        typename Iter,
+        typename T,
+        typename F,
+        typename Enable = std::enable_if_t<
+            v1_dtl::has_read_n<Iter, v1_dtl::algo_value_t<Iter>>::value>>
+    T * transform(Iter first, Iter last, T * out, F f)
+    {
+        v1_dtl::algo_value_t<Iter> buf[v1_dtl::batch_size];
+        for (auto n = stl_interfaces::distance(first, last); 0 < n;) {
+            auto const m = (std::min)(n, decltype(n)(v1_dtl::batch_size));
+            stl_interfaces::read_n(first, m, buf);
+            out = std::transform(buf, buf + m, out, f);
+            stl_interfaces::advance(first, m);
+            n -= m;
+        }
+        return out;
+    }
+
+    /** Writes `f(x)` for each element `x` of the array `[first, last)` to
+        `out`, like `std::transform()`, and returns the end of the output.
+        This is the inverse of the other overload: it only takes part in
+        overload resolution when `Iter` has a `write_n()` member that can
+        read from an array of its value type, and it calls `f` on a few
+        hundred elements at a time into a buffer on the stack, and writes
+        the buffer with `write_n()`. */
+    template<
+        typename T,
+        typename Iter,
+        typename F,
+        typename Enable = std::enable_if_t<
+            v1_dtl::has_write_n<Iter, v1_dtl::algo_value_t<Iter>>::value>>
+    Iter transform(T const * first, T const * last, Iter out, F f)
+    {
+        v1_dtl::algo_value_t<Iter> buf[v1_dtl::batch_size];
+        while (first != last) {
+            auto const m = (std::min)(last - first, v1_dtl::batch_size);
+            std::transform(first, first + m, buf, f);
+            out = stl_interfaces::write_n(buf, m, out);
+            first += m;
+        }
+        return out;
+    }
+
+    /** Returns the first iterator to the least value in `[first, last)`,
+        or `last` if the range is empty.
+
+        If `Iter` is contiguous and its values are integers, the least value
+        is found with vector minimums, and then found with `find()`.
+        Otherwise, this is `std::min_element(first, last)`. */
+    template<typename Iter>
+    Iter min_element(Iter first, Iter last)
+    {
+        return v1_dtl::extremum_impl<false>(
+            first, last, v1_dtl::simd_orderable<Iter>{});
+    }
+
+    /** Returns the first iterator to the greatest value in `[first,
+        last)`, or `last` if the range is empty.  It is vectorized under the
+        same conditions as `min_element()`. */
+    template<typename Iter>
+    Iter max_element(Iter first, Iter last)
+    {
+        return v1_dtl::extremum_impl<true>(
+            first, last, v1_dtl::simd_orderable<Iter>{});
+    }
+
+}}}
+
+#endif
@@ -0,0 +1,196 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_ALLOC_VECTOR_HPP
+#define BOOST_STL_INTERFACES_ALLOC_VECTOR_HPP
+
+#include <boost/stl_interfaces/allocator_aware_interface.hpp>
+
+#include <algorithm>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <utility>
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+    //[ alloc_vector_defn
+    // A minimal std::vector-like container that gets its memory from an
+    // Allocator.  allocator_aware_interface provides allocator_type,
+    // get_allocator(), and the allocator propagation rules; the special members
+    // below only have to decide what to do with the elements.
+    template<typename T, typename Allocator = std::allocator<T>>
+    struct alloc_vector : allocator_aware_interface<
+                              alloc_vector<T, Allocator>,
+                              Allocator,
+                              contiguous>
+    {
+        using base_type = allocator_aware_interface<
+            alloc_vector<T, Allocator>,
+            Allocator,
+            contiguous>;
+
+        using value_type = T;
+        using pointer = T *;
+        using const_pointer = T const *;
+        using reference = value_type &;
+        using const_reference = value_type const &;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using iterator = T *;
+        using const_iterator = T const *;
+
+        alloc_vector() noexcept : data_(nullptr), size_(0), capacity_(0) {}
+        explicit alloc_vector(Allocator const & a) noexcept :
+            base_type(a),
+            data_(nullptr),
+            size_(0),
+            capacity_(0)
+        {}
+        alloc_vector(std::initializer_list<T> il, Allocator const & a) :
+            alloc_vector(a)
+        {
+            append(il.begin(), il.end());
+        }
+        alloc_vector(alloc_vector const & other) :
+            base_type(other),
+            data_(nullptr),
+            size_(0),
+            capacity_(0)
+        {
+            append(other.begin(), other.end());
+        }
+        alloc_vector(alloc_vector && other) noexcept :
+            base_type(std::move(other)),
+            data_(other.data_),
+            size_(other.size_),
+            capacity_(other.capacity_)
+        {
+            other.data_ = nullptr;
+            other.size_ = 0;
+            other.capacity_ = 0;
+        }
+        alloc_vector & operator=(alloc_vector const & other)
+        {
+            if (this != &other) {
+                release();
+                base_type::operator=(other);
+                append(other.begin(), other.end());
+            }
+            return *this;
+        }
+        alloc_vector & operator=(alloc_vector && other)
+        {
+            if (this == &other)
+                return *this;
+            if (base_type::allocator_traits::
+                    propagate_on_container_move_assignment::value ||
+                this->equal_allocator(other)) {
+                release();
+                base_type::operator=(std::move(other));
+                std::swap(data_, other.data_);
+                std::swap(size_, other.size_);
+                std::swap(capacity_, other.capacity_);
+            } else {
+                this->clear();
+                append(
+                    std::make_move_iterator(other.begin()),
+                    std::make_move_iterator(other.end()));
+            }
+            return *this;
+        }
+        ~alloc_vector()
+        {
+            release();
+        }
+
+        iterator begin() noexcept { return data_; }
+        iterator end() noexcept { return data_ + size_; }
+
+        size_type capacity() const noexcept { return capacity_; }
+        void reserve(size_type n)
+        {
+            if (n <= capacity_)
+                return;
+            T * const new_data = this->allocate(n);
+            for (size_type i = 0; i < size_; ++i) {
+                this->construct(new_data + i, std::move(data_[i]));
+                this->destroy(data_ + i);
+            }
+            if (data_)
+                this->deallocate(data_, capacity_);
+            data_ = new_data;
+            capacity_ = n;
+        }
+
+        // container_interface provides emplace_back() in terms of this: when
+        // the vector is full, it grows it through reserve(), by
+        // container_growth_policy, and then calls construct_at_end().
+        template<typename... Args>
+        reference construct_at_end(Args &&... args)
+        {
+            this->construct(data_ + size_, std::forward<Args>(args)...);
+            return data_[size_++];
+        }
+        iterator erase(const_iterator first, const_iterator last) noexcept
+        {
+            auto const f = data_ + (first - data_);
+            auto const l = data_ + (last - data_);
+            auto const new_end = std::move(l, end(), f);
+            for (auto it = new_end; it != end(); ++it) {
+                this->destroy(it);
+            }
+            size_ -= l - f;
+            return f;
+        }
+
+        void clear() noexcept
+        {
+            for (size_type i = 0; i < size_; ++i) {
+                this->destroy(data_ + i);
+            }
+            size_ = 0;
+        }
+
+        void swap(alloc_vector & other) noexcept
+        {
+            this->swap_allocator(other);
+            std::swap(data_, other.data_);
+            std::swap(size_, other.size_);
+            std::swap(capacity_, other.capacity_);
+        }
+
+        using base_type::begin;
+        using base_type::end;
+        using base_type::erase;
+
+    private:
+        template<typename Iter>
+        void append(Iter first, Iter last)
+        {
+            for (; first != last; ++first) {
+                this->emplace_back(*first);
+            }
+        }
+
+        void release() noexcept
+        {
+            this->clear();
+            if (data_)
+                this->deallocate(data_, capacity_);
+            data_ = nullptr;
+            capacity_ = 0;
+        }
+
+        T * data_;
+        size_type size_;
+        size_type capacity_;
+    };
+    //]
+
+}}}
+
+#endif
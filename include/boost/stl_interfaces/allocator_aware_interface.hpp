@@ -0,0 +1,242 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_ALLOCATOR_AWARE_INTERFACE_HPP
+#define BOOST_STL_INTERFACES_ALLOCATOR_AWARE_INTERFACE_HPP
+
+#include <boost/stl_interfaces/container_interface.hpp>
+
+#include <boost/assert.hpp>
+
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    namespace v1_dtl {
+        // Holds the allocator, taking no space when it is empty (as
+        // std::allocator is).
+        template<
+            typename Allocator,
+            bool Empty = std::is_empty<Allocator>::value &&
+                         !std::is_final<Allocator>::value>
+        struct allocator_storage
+        {
+            constexpr allocator_storage() = default;
+            constexpr explicit allocator_storage(Allocator const & a) noexcept :
+                a_(a)
+            {}
+
+            constexpr Allocator & alloc() noexcept { return a_; }
+            constexpr Allocator const & alloc() const noexcept { return a_; }
+
+        private:
+            Allocator a_;
+        };
+        template<typename Allocator>
+        struct allocator_storage<Allocator, true> : Allocator
+        {
+            constexpr allocator_storage() = default;
+            constexpr explicit allocator_storage(Allocator const & a) noexcept :
+                Allocator(a)
+            {}
+
+            constexpr Allocator & alloc() noexcept { return *this; }
+            constexpr Allocator const & alloc() const noexcept { return *this; }
+        };
+
+        template<typename Allocator>
+        constexpr void
+        swap_allocators(Allocator & lhs, Allocator & rhs, std::true_type)
+        {
+            using std::swap;
+            swap(lhs, rhs);
+        }
+        template<typename Allocator>
+        constexpr void
+        swap_allocators(Allocator & lhs, Allocator & rhs, std::false_type)
+        {
+            BOOST_ASSERT(lhs == rhs);
+        }
+    }
+
+#endif
+
+    /** A CRTP template that one may derive from instead of
+        `container_interface`, for containers that get their memory from an
+        `Allocator`.  It derives from `container_interface<Derived,
+        Contiguous>`, so `Derived` gets all the same members from it, and it
+        also provides the parts of the allocator-aware container
+        requirements that are the same in every container: `allocator_type`,
+        `get_allocator()`, the storage of the allocator (which takes no space
+        when the allocator is empty), and the allocator propagation rules of
+        `std::allocator_traits`.
+
+        The special members follow the rules for containers.  The copy
+        constructor uses `select_on_container_copy_construction()`; the move
+        constructor moves the allocator; and the copy and move assignment
+        operators and `swap_allocator()` replace the allocator only if
+        `propagate_on_container_copy_assignment`,
+        `propagate_on_container_move_assignment`, and
+        `propagate_on_container_swap` are respectively true.  `Derived`'s
+        assignment operators must therefore free any memory they hold before
+        assigning to this base, since the memory may have come from an
+        allocator that is about to be replaced; and when the allocator does
+        not propagate, and `!equal_allocator(other)`, a move assignment must
+        move the elements one at a time.
+
+        `Allocator` may be `std::pmr::polymorphic_allocator<T>`, in which
+        case a container built from a `std::pmr::monotonic_buffer_resource`
+        or `std::pmr::unsynchronized_pool_resource` gets all its memory from
+        that resource.  Since `polymorphic_allocator` does not propagate,
+        copies of such a container use the default memory resource, and
+        elements moved or swapped between containers using different
+        resources are moved one at a time. */
+    template<
+        typename Derived,
+        typename Allocator,
+        bool Contiguous = discontiguous>
+    struct allocator_aware_interface
+        : container_interface<Derived, Contiguous>
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+        ,
+          private v1_dtl::allocator_storage<Allocator>
+#endif
+    {
+        using allocator_type = Allocator;
+
+        /** Returns a copy of the allocator. */
+        constexpr allocator_type get_allocator() const noexcept
+        {
+            return storage_type::alloc();
+        }
+
+    protected:
+        using allocator_traits = std::allocator_traits<Allocator>;
+
+        constexpr allocator_aware_interface() = default;
+        constexpr explicit allocator_aware_interface(
+            Allocator const & a) noexcept :
+            storage_type(a)
+        {}
+        constexpr allocator_aware_interface(
+            allocator_aware_interface const & other) noexcept :
+            storage_type(
+                allocator_traits::select_on_container_copy_construction(
+                    other.allocator()))
+        {}
+        constexpr allocator_aware_interface(
+            allocator_aware_interface && other) noexcept :
+            storage_type(std::move(other.allocator()))
+        {}
+
+        constexpr allocator_aware_interface &
+        operator=(allocator_aware_interface const & other) noexcept
+        {
+            assign_allocator(
+                other.allocator(),
+                typename allocator_traits::
+                    propagate_on_container_copy_assignment{});
+            return *this;
+        }
+        constexpr allocator_aware_interface &
+        operator=(allocator_aware_interface && other) noexcept
+        {
+            assign_allocator(
+                std::move(other.allocator()),
+                typename allocator_traits::
+                    propagate_on_container_move_assignment{});
+            return *this;
+        }
+
+        ~allocator_aware_interface() = default;
+
+        /** Returns a reference to the allocator. */
+        constexpr Allocator & allocator() noexcept
+        {
+            return storage_type::alloc();
+        }
+        /** Returns a reference to the allocator. */
+        constexpr Allocator const & allocator() const noexcept
+        {
+            return storage_type::alloc();
+        }
+
+        /** Returns true if memory allocated by the allocator of `other` can
+            be freed by the allocator of `*this`, and vice versa. */
+        constexpr bool
+        equal_allocator(allocator_aware_interface const & other) const
+            noexcept
+        {
+            return allocator() == other.allocator();
+        }
+
+        /** Swaps the allocators of `*this` and `other` if
+            `propagate_on_container_swap` is true.
+
+            \pre `propagate_on_container_swap` is true, or
+            `equal_allocator(other)` */
+        constexpr void
+        swap_allocator(allocator_aware_interface & other) noexcept
+        {
+            v1_dtl::swap_allocators(
+                allocator(),
+                other.allocator(),
+                typename allocator_traits::propagate_on_container_swap{});
+        }
+
+        /** Allocates storage for `n` objects of type `value_type`. */
+        constexpr typename allocator_traits::pointer
+        allocate(typename allocator_traits::size_type n)
+        {
+            return allocator_traits::allocate(allocator(), n);
+        }
+        /** Frees storage for `n` objects returned by `allocate(n)`. */
+        constexpr void deallocate(
+            typename allocator_traits::pointer p,
+            typename allocator_traits::size_type n) noexcept
+        {
+            allocator_traits::deallocate(allocator(), p, n);
+        }
+        /** Constructs an object at `p` from `args`, with the allocator's
+            `construct()` if it has one, and placement new otherwise.  This
+            is what passes a `polymorphic_allocator`'s memory resource on to
+            elements that use allocators themselves. */
+        template<typename T, typename... Args>
+        constexpr void construct(T * p, Args &&... args)
+        {
+            allocator_traits::construct(
+                allocator(), p, std::forward<Args>(args)...);
+        }
+        /** Destroys the object at `p`, with the allocator's `destroy()` if it
+            has one. */
+        template<typename T>
+        constexpr void destroy(T * p) noexcept
+        {
+            allocator_traits::destroy(allocator(), p);
+        }
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+    private:
+        using storage_type = v1_dtl::allocator_storage<Allocator>;
+
+        template<typename A>
+        constexpr void assign_allocator(A && a, std::true_type) noexcept
+        {
+            allocator() = std::forward<A>(a);
+        }
+        template<typename A>
+        constexpr void assign_allocator(A &&, std::false_type) noexcept
+        {}
+#endif
+    };
+
+}}}
+
+#endif
@@ -0,0 +1,467 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_ANY_ITERATOR_HPP
+#define BOOST_STL_INTERFACES_ANY_ITERATOR_HPP
+
+#include <boost/stl_interfaces/iterator_interface.hpp>
+#include <boost/stl_interfaces/view_interface.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <new>
+#include <utility>
+
+#include <cassert>
+#include <cstddef>
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+    template<
+        typename T,
+        typename Category = std::forward_iterator_tag,
+        typename Reference = T &>
+    struct any_iterator;
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    namespace v1_dtl {
+        constexpr std::size_t any_iterator_buffer_size = 32;
+
+        template<typename Value, typename Reference>
+        struct any_iterator_vtable
+        {
+            void (*copy)(void * dst, void const * src);
+            void (*move)(void * dst, void * src);
+            void (*destroy)(void * self);
+            Reference (*deref)(void const * self);
+            void (*increment)(void * self);
+            void (*decrement)(void * self);
+            void (*advance)(void * self, std::ptrdiff_t n);
+            std::ptrdiff_t (*distance)(void const * lhs, void const * rhs);
+            bool (*equal)(void const * lhs, void const * rhs);
+            std::ptrdiff_t (*next_n)(
+                void * self, void const * last, Value * out, std::ptrdiff_t n);
+        };
+
+        // An Iter is stored in the buffer itself if it fits, and if moving
+        // it cannot throw; otherwise the buffer holds a pointer to it.
+        template<typename Iter>
+        using any_iterator_inline = std::integral_constant<
+            bool,
+            sizeof(Iter) <= any_iterator_buffer_size &&
+                alignof(Iter) <= alignof(void *) &&
+                std::is_nothrow_move_constructible<Iter>::value>;
+
+        template<typename Iter, bool Inline = any_iterator_inline<Iter>::value>
+        struct any_iterator_storage
+        {
+            static Iter & get(void * p) noexcept
+            {
+                return *static_cast<Iter *>(p);
+            }
+            static Iter const & get(void const * p) noexcept
+            {
+                return *static_cast<Iter const *>(p);
+            }
+            static void construct(void * p, Iter it)
+            {
+                ::new (p) Iter(std::move(it));
+            }
+            static void copy(void * dst, void const * src)
+            {
+                ::new (dst) Iter(get(src));
+            }
+            static void move(void * dst, void * src)
+            {
+                ::new (dst) Iter(std::move(get(src)));
+            }
+            static void destroy(void * p) { get(p).~Iter(); }
+        };
+
+        template<typename Iter>
+        struct any_iterator_storage<Iter, false>
+        {
+            static Iter & get(void * p) noexcept
+            {
+                return **static_cast<Iter **>(p);
+            }
+            static Iter const & get(void const * p) noexcept
+            {
+                return **static_cast<Iter * const *>(p);
+            }
+            static void construct(void * p, Iter it)
+            {
+                *static_cast<Iter **>(p) = new Iter(std::move(it));
+            }
+            static void copy(void * dst, void const * src)
+            {
+                *static_cast<Iter **>(dst) = new Iter(get(src));
+            }
+            static void move(void * dst, void * src)
+            {
+                *static_cast<Iter **>(dst) =
+                    std::exchange(*static_cast<Iter **>(src), nullptr);
+            }
+            static void destroy(void * p) { delete *static_cast<Iter **>(p); }
+        };
+
+        template<typename Iter, typename Value, typename Reference>
+        struct any_iterator_model : any_iterator_storage<Iter>
+        {
+            using storage = any_iterator_storage<Iter>;
+
+            static Reference deref(void const * self)
+            {
+                return *storage::get(self);
+            }
+            static void increment(void * self) { ++storage::get(self); }
+            static bool equal(void const * lhs, void const * rhs)
+            {
+                return storage::get(lhs) == storage::get(rhs);
+            }
+            static std::ptrdiff_t next_n(
+                void * self, void const * last, Value * out, std::ptrdiff_t n)
+            {
+                return next_n_impl(
+                    storage::get(self),
+                    last,
+                    out,
+                    n,
+                    std::is_convertible<
+                        typename std::iterator_traits<Iter>::iterator_category,
+                        std::random_access_iterator_tag>{});
+            }
+            // A random access iterator is copied with std::copy_n(), which
+            // becomes a memmove or a vectorized loop for contiguous ones.
+            static std::ptrdiff_t next_n_impl(
+                Iter & it,
+                void const * last,
+                Value * out,
+                std::ptrdiff_t n,
+                std::true_type)
+            {
+                if (last)
+                    n = (std::min)(n, std::ptrdiff_t(storage::get(last) - it));
+                std::copy_n(it, n, out);
+                it += n;
+                return n;
+            }
+            static std::ptrdiff_t next_n_impl(
+                Iter & it,
+                void const * last,
+                Value * out,
+                std::ptrdiff_t n,
+                std::false_type)
+            {
+                std::ptrdiff_t i = 0;
+                if (last) {
+                    Iter const & end = storage::get(last);
+                    for (; i < n && it != end; ++i, ++it) {
+                        out[i] = *it;
+                    }
+                } else {
+                    for (; i < n; ++i, ++it) {
+                        out[i] = *it;
+                    }
+                }
+                return i;
+            }
+
+            template<typename I = Iter>
+            static auto decrement_fn(int)
+                -> decltype(--std::declval<I &>(), (void (*)(void *))nullptr)
+            {
+                return [](void * self) { --storage::get(self); };
+            }
+            static void (*decrement_fn(long))(void *) { return nullptr; }
+
+            template<typename I = Iter>
+            static auto advance_fn(int) -> decltype(
+                std::declval<I &>() += std::ptrdiff_t(),
+                (void (*)(void *, std::ptrdiff_t))nullptr)
+            {
+                return [](void * self, std::ptrdiff_t n) {
+                    storage::get(self) += n;
+                };
+            }
+            static void (*advance_fn(long))(void *, std::ptrdiff_t)
+            {
+                return nullptr;
+            }
+
+            template<typename I = Iter>
+            static auto distance_fn(int) -> decltype(
+                std::declval<I const &>() - std::declval<I const &>(),
+                (std::ptrdiff_t(*)(void const *, void const *)) nullptr)
+            {
+                return [](void const * lhs, void const * rhs) {
+                    return std::ptrdiff_t(
+                        storage::get(lhs) - storage::get(rhs));
+                };
+            }
+            static std::ptrdiff_t (*distance_fn(long))(
+                void const *, void const *)
+            {
+                return nullptr;
+            }
+
+            static any_iterator_vtable<Value, Reference> const vtable;
+        };
+
+        template<typename Iter, typename Value, typename Reference>
+        any_iterator_vtable<Value, Reference> const
+            any_iterator_model<Iter, Value, Reference>::vtable = {
+                &storage::copy,
+                &storage::move,
+                &storage::destroy,
+                &deref,
+                &increment,
+                decrement_fn(0),
+                advance_fn(0),
+                distance_fn(0),
+                &equal,
+                &next_n};
+
+        template<typename T, typename Category, typename Reference>
+        using any_iterator_interface_t = iterator_interface<
+            any_iterator<T, Category, Reference>,
+            Category,
+            std::remove_cv_t<T>,
+            Reference,
+            std::conditional_t<
+                std::is_reference<Reference>::value,
+                std::remove_reference_t<Reference> *,
+                proxy_arrow_result<Reference>>,
+            std::ptrdiff_t>;
+
+        template<typename Category>
+        using ra_category = std::is_convertible<
+            Category,
+            std::random_access_iterator_tag>;
+    }
+
+#endif
+
+    /** An iterator of category `Category` -- input, forward,
+        bidirectional, or random access -- over elements of type `T`, that
+        can hold any iterator of at least that category whose reference
+        type converts to `Reference`.  Which iterator it holds is a run-time
+        property, so an `any_iterator` can cross an ABI boundary, like the
+        interface of a plugin, that a template cannot.
+
+        Each operation is an indirect call through a table of functions for
+        the held iterator's type.  An iterator of up to 32 bytes, whose
+        move constructor does not throw, is stored inside the
+        `any_iterator`; a larger one is allocated.  Two `any_iterator`s
+        compare equal only if they hold iterators of the same type that
+        compare equal, or if both are empty.
+
+        A loop that makes an indirect call for each element runs several
+        times slower than one that does not.  `next_n()` copies a block of
+        elements in one call, in a loop over the held iterator's own type,
+        so reading through a buffer of a few dozen elements makes the cost
+        of the indirect calls negligible.
+
+        If `Reference` is a reference type, so must the held iterator's
+        reference type be, since `*it` would otherwise refer to a
+        temporary. */
+    template<typename T, typename Category, typename Reference>
+    struct any_iterator
+        : v1_dtl::any_iterator_interface_t<T, Category, Reference>
+    {
+        using base_type =
+            v1_dtl::any_iterator_interface_t<T, Category, Reference>;
+        using value_type = std::remove_cv_t<T>;
+        using reference = Reference;
+        using difference_type = std::ptrdiff_t;
+
+        any_iterator() noexcept = default;
+
+        /** Holds `it`. */
+        template<
+            typename Iter,
+            typename Enable = std::enable_if_t<
+                !std::is_same<std::decay_t<Iter>, any_iterator>::value>,
+            typename IterCategory =
+                typename std::iterator_traits<Iter>::iterator_category>
+        any_iterator(Iter it) : vtable_(&model<Iter>::vtable)
+        {
+            static_assert(
+                std::is_convertible<IterCategory, Category>::value,
+                "any_iterator<T, Category> can only hold an iterator of at "
+                "least category Category.");
+            static_assert(
+                std::is_convertible<
+                    typename std::iterator_traits<Iter>::reference,
+                    Reference>::value &&
+                    (!std::is_reference<Reference>::value ||
+                     std::is_reference<typename std::iterator_traits<
+                         Iter>::reference>::value),
+                "The reference type of an iterator held by an any_iterator "
+                "must convert to Reference, and must be a reference if "
+                "Reference is.");
+            model<Iter>::construct(buffer_, std::move(it));
+        }
+
+        any_iterator(any_iterator const & other) : vtable_(other.vtable_)
+        {
+            if (vtable_)
+                vtable_->copy(buffer_, other.buffer_);
+        }
+        any_iterator(any_iterator && other) noexcept : vtable_(other.vtable_)
+        {
+            if (vtable_) {
+                vtable_->move(buffer_, other.buffer_);
+                other.reset();
+            }
+        }
+        any_iterator & operator=(any_iterator const & other)
+        {
+            if (this != &other)
+                *this = any_iterator(other);
+            return *this;
+        }
+        any_iterator & operator=(any_iterator && other) noexcept
+        {
+            if (this != &other) {
+                reset();
+                if (other.vtable_) {
+                    other.vtable_->move(buffer_, other.buffer_);
+                    vtable_ = other.vtable_;
+                    other.reset();
+                }
+            }
+            return *this;
+        }
+        ~any_iterator() { reset(); }
+
+        reference operator*() const { return vtable_->deref(buffer_); }
+        any_iterator & operator++()
+        {
+            vtable_->increment(buffer_);
+            return *this;
+        }
+        any_iterator & operator--()
+        {
+            vtable_->decrement(buffer_);
+            return *this;
+        }
+        template<typename C = Category>
+        auto operator+=(difference_type n)
+            -> std::enable_if_t<v1_dtl::ra_category<C>::value, any_iterator &>
+        {
+            vtable_->advance(buffer_, n);
+            return *this;
+        }
+        template<typename C = Category>
+        friend auto
+        operator-(any_iterator const & lhs, any_iterator const & rhs)
+            -> std::enable_if_t<
+                v1_dtl::ra_category<C>::value,
+                difference_type>
+        {
+            assert(lhs.vtable_ == rhs.vtable_);
+            return lhs.vtable_ ? lhs.vtable_->distance(lhs.buffer_, rhs.buffer_)
+                               : 0;
+        }
+        friend bool
+        operator==(any_iterator const & lhs, any_iterator const & rhs)
+        {
+            if (lhs.vtable_ != rhs.vtable_)
+                return false;
+            return !lhs.vtable_ || lhs.vtable_->equal(lhs.buffer_, rhs.buffer_);
+        }
+        friend bool
+        operator!=(any_iterator const & lhs, any_iterator const & rhs)
+        {
+            return !(lhs == rhs);
+        }
+
+        /** Copies the `n` elements starting at `*this` to `out`, and moves
+            `*this` past them, with one indirect call.  Returns `n`.  There
+            must be at least `n` elements left. */
+        difference_type next_n(value_type * out, difference_type n)
+        {
+            return vtable_->next_n(buffer_, nullptr, out, n);
+        }
+        /** Copies up to `n` elements starting at `*this` to `out`, stopping
+            at `last`, and moves `*this` past them, with one indirect call.
+            Returns the number of elements copied, which is less than `n`
+            only if `*this` has reached `last`.  `last` must hold an iterator
+            of the same type.  */
+        difference_type
+        next_n(value_type * out, difference_type n, any_iterator const & last)
+        {
+            assert(vtable_ == last.vtable_);
+            if (!vtable_)
+                return 0;
+            return vtable_->next_n(buffer_, last.buffer_, out, n);
+        }
+
+        /** Returns `true` if `*this` holds no iterator.  */
+        bool empty() const noexcept { return !vtable_; }
+
+        using base_type::operator++;
+        using base_type::operator--;
+
+    private:
+        template<typename Iter>
+        using model = v1_dtl::any_iterator_model<Iter, value_type, Reference>;
+
+        void reset() noexcept
+        {
+            if (vtable_) {
+                vtable_->destroy(buffer_);
+                vtable_ = nullptr;
+            }
+        }
+
+        v1_dtl::any_iterator_vtable<value_type, Reference> const *
+            vtable_ = nullptr;
+        alignas(void *) unsigned char
+            buffer_[v1_dtl::any_iterator_buffer_size];
+    };
+
+    /** A view whose iterators are `any_iterator<T, Category, Reference>`s,
+        so that it can hold the iterators of any range of at least category
+        `Category`, including a range of another view type, whose elements
+        convert to `Reference`. */
+    template<
+        typename T,
+        typename Category = std::forward_iterator_tag,
+        typename Reference = T &>
+    struct any_view : view_interface<any_view<T, Category, Reference>>
+    {
+        using iterator = any_iterator<T, Category, Reference>;
+
+        any_view() = default;
+        /** Holds the iterators `first` and `last`. */
+        template<typename Iter>
+        any_view(Iter first, Iter last) :
+            first_(std::move(first)), last_(std::move(last))
+        {}
+        /** Holds the iterators of `r`, which must be a common range, and
+            must outlive `*this`. */
+        template<
+            typename Range,
+            typename Enable = std::enable_if_t<!std::is_same<
+                std::remove_cv_t<std::remove_reference_t<Range>>,
+                any_view>::value>>
+        explicit any_view(Range && r) : any_view(std::begin(r), std::end(r))
+        {}
+
+        iterator begin() const { return first_; }
+        iterator end() const { return last_; }
+
+    private:
+        iterator first_;
+        iterator last_;
+    };
+
+}}}
+
+#endif
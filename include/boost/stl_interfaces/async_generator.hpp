@@ -0,0 +1,255 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_ASYNC_GENERATOR_HPP
+#define BOOST_STL_INTERFACES_ASYNC_GENERATOR_HPP
+
+#include <boost/stl_interfaces/generator.hpp>
+
+#if 201703L < __cplusplus && defined(__cpp_lib_concepts) &&                    \
+        defined(__cpp_impl_coroutine) &&                                       \
+        !defined(BOOST_STL_INTERFACES_DISABLE_V2) ||                           \
+    BOOST_STL_INTERFACES_DOXYGEN
+
+namespace boost { namespace stl_interfaces { namespace v2 {
+
+    /** A coroutine that yields a sequence of `T`s, and that may `co_await`
+        between yields -- for a read from a socket, say -- without blocking
+        the coroutine that consumes the sequence.
+
+        An `async_generator` is not a range, since getting each element
+        may suspend.  Instead, `begin()` and an iterator's `operator++()`
+        return awaitables, and a coroutine iterates with:
+
+        \code
+        for (auto it = co_await g.begin(); it != g.end(); co_await ++it) {
+            // use *it
+        }
+        \endcode
+
+        Awaiting either one resumes the generator; the awaiting coroutine
+        stays suspended while the generator is suspended on its own
+        `co_await`s, and is resumed by symmetric transfer as soon as the
+        generator yields its next element, or finishes.  No thread waits
+        on the generator's I/O, so an event loop may run other work --
+        including the consumer of another connection -- in the meantime.
+        To overlap a generator's I/O with the processing of the element it
+        just yielded, the generator starts its next read before yielding.
+
+        Other than that, the iterator is like that of `generator`: it
+        compares equal to `std::default_sentinel` once the generator has
+        finished; each element is a `T &` to the yielded object if `T` is
+        not a reference; and an exception that escapes the generator is
+        thrown from the `co_await` on `begin()` or `operator++()`.  Frames
+        come from the same per-thread pool as those of `generator`. */
+    template<typename T>
+    struct async_generator
+    {
+        using value_type = std::remove_cvref_t<T>;
+        using reference =
+            std::conditional_t<std::is_reference_v<T>, T, T &>;
+        using pointer = std::add_pointer_t<reference>;
+
+        struct promise_type;
+        struct iterator;
+
+    private:
+        using handle_type = std::coroutine_handle<promise_type>;
+
+        // Resumes the generator until its next yield, on behalf of the
+        // awaiting coroutine.
+        struct advance_awaiter
+        {
+            bool await_ready() noexcept { return !coro_ || coro_.done(); }
+            std::coroutine_handle<>
+            await_suspend(std::coroutine_handle<> consumer) noexcept
+            {
+                coro_.promise().consumer_ = consumer;
+                return coro_;
+            }
+            void await_resume()
+            {
+                if (coro_ && coro_.promise().exception_) {
+                    std::rethrow_exception(
+                        std::exchange(coro_.promise().exception_, nullptr));
+                }
+            }
+
+            handle_type coro_;
+        };
+
+    public:
+        async_generator() = default;
+        async_generator(async_generator && other) noexcept :
+            coro_(std::exchange(other.coro_, nullptr))
+        {}
+        async_generator & operator=(async_generator && other) noexcept
+        {
+            std::swap(coro_, other.coro_);
+            return *this;
+        }
+        ~async_generator()
+        {
+            if (coro_)
+                coro_.destroy();
+        }
+
+        /** Returns an awaitable whose result is an iterator to the first
+            element.  May be awaited only once. */
+        auto begin()
+        {
+            struct awaiter : advance_awaiter
+            {
+                iterator await_resume()
+                {
+                    advance_awaiter::await_resume();
+                    return iterator(this->coro_);
+                }
+            };
+            return awaiter{{coro_}};
+        }
+        std::default_sentinel_t end() const noexcept { return {}; }
+
+    private:
+        explicit async_generator(handle_type coro) noexcept : coro_(coro) {}
+
+        // Suspends the generator, and resumes the coroutine that awaits
+        // its next element.
+        struct yield_awaiter
+        {
+            bool await_ready() noexcept { return false; }
+            std::coroutine_handle<>
+            await_suspend(handle_type coro) noexcept
+            {
+                return coro.promise().consumer_;
+            }
+            void await_resume() noexcept {}
+        };
+
+        // Keeps a copy of a yielded const lvalue, which cannot bind to
+        // reference, for as long as the generator is suspended.
+        struct copy_awaiter : yield_awaiter
+        {
+            std::coroutine_handle<>
+            await_suspend(handle_type coro) noexcept
+            {
+                coro.promise().value_ = std::addressof(value_);
+                return yield_awaiter::await_suspend(coro);
+            }
+
+            value_type value_;
+        };
+
+        handle_type coro_ = nullptr;
+    };
+
+    template<typename T>
+    struct async_generator<T>::promise_type
+    {
+        async_generator get_return_object() noexcept
+        {
+            return async_generator(handle_type::from_promise(*this));
+        }
+
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        yield_awaiter final_suspend() noexcept { return {}; }
+
+        yield_awaiter
+        yield_value(std::remove_reference_t<reference> & x) noexcept
+        {
+            value_ = std::addressof(x);
+            return {};
+        }
+        yield_awaiter
+        yield_value(std::remove_reference_t<reference> && x) noexcept
+        {
+            value_ = std::addressof(x);
+            return {};
+        }
+        copy_awaiter yield_value(value_type const & x) requires(
+            !std::is_const_v<std::remove_reference_t<reference>> &&
+            std::is_copy_constructible_v<value_type>)
+        {
+            return copy_awaiter{{}, x};
+        }
+
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept
+        {
+            exception_ = std::current_exception();
+        }
+
+        static void * operator new(std::size_t n)
+        {
+            return v2_dtl::frame_pool::allocate(n);
+        }
+        static void operator delete(void * p, std::size_t n) noexcept
+        {
+            v2_dtl::frame_pool::deallocate(p, n);
+        }
+
+    private:
+        friend async_generator;
+
+        pointer value_ = nullptr;
+        std::coroutine_handle<> consumer_ = std::noop_coroutine();
+        std::exception_ptr exception_;
+    };
+
+    template<typename T>
+    struct async_generator<T>::iterator
+    {
+        using iterator_concept = std::input_iterator_tag;
+        using value_type = async_generator::value_type;
+        using reference = async_generator::reference;
+        using pointer = async_generator::pointer;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+
+        reference operator*() const noexcept
+        {
+            return static_cast<reference>(*coro_.promise().value_);
+        }
+        pointer operator->() const noexcept
+        {
+            return coro_.promise().value_;
+        }
+
+        /** Returns an awaitable whose result is `*this`, after it has
+            moved to the next element. */
+        auto operator++() noexcept
+        {
+            struct awaiter : advance_awaiter
+            {
+                iterator & await_resume()
+                {
+                    advance_awaiter::await_resume();
+                    return *it_;
+                }
+                iterator * it_;
+            };
+            return awaiter{{coro_}, this};
+        }
+
+        friend bool
+        operator==(iterator const & it, std::default_sentinel_t) noexcept
+        {
+            return !it.coro_ || it.coro_.done();
+        }
+
+    private:
+        friend async_generator;
+
+        explicit iterator(handle_type coro) noexcept : coro_(coro) {}
+
+        handle_type coro_ = nullptr;
+    };
+
+}}}
+
+#endif
+
+#endif
@@ -0,0 +1,194 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_AUTO_ITERATOR_INTERFACE_HPP
+#define BOOST_STL_INTERFACES_AUTO_ITERATOR_INTERFACE_HPP
+
+#include <boost/stl_interfaces/iterator_interface.hpp>
+
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    namespace v1_dtl {
+        template<typename Core>
+        using core_decrement_t = decltype(--std::declval<Core &>());
+        template<typename Core>
+        using core_eq_t = decltype(
+            std::declval<Core const &>() == std::declval<Core const &>());
+        template<typename Core>
+        using core_base_t =
+            decltype(access::base(std::declval<Core const &>()));
+
+        template<typename Core, typename DifferenceType, typename = void>
+        struct core_minus : std::false_type
+        {
+        };
+        template<typename Core, typename DifferenceType>
+        struct core_minus<
+            Core,
+            DifferenceType,
+            void_t<decltype(
+                std::declval<Core const &>() - std::declval<Core const &>())>>
+            : std::is_convertible<
+                  decltype(
+                      std::declval<Core const &>() -
+                      std::declval<Core const &>()),
+                  DifferenceType>
+        {
+        };
+
+        template<typename Core, typename DifferenceType>
+        using core_random_access = std::integral_constant<
+            bool,
+            plus_eq<Core, DifferenceType>::value &&
+                core_minus<Core, DifferenceType>::value &&
+                detail::detector<void, core_decrement_t, Core>::value>;
+
+        // A core is contiguous if it is, by is_contiguous_iterator, or if it
+        // is random access and its access::base() is a pointer, as the
+        // base_reference() of an iterator over an array usually is.
+        template<typename Core, bool = detail::detector<
+                                    void,
+                                    core_base_t,
+                                    Core>::value>
+        struct core_base_is_pointer : std::false_type
+        {
+        };
+        template<typename Core>
+        struct core_base_is_pointer<Core, true>
+            : std::is_pointer<std::decay_t<core_base_t<Core>>>
+        {
+        };
+
+        // 4: contiguous, 3: random access, 2: bidirectional, 1: forward,
+        // 0: input.
+        template<typename Core, typename DifferenceType>
+        using core_strength = std::integral_constant<
+            int,
+            core_random_access<Core, DifferenceType>::value
+                ? (is_contiguous_iterator<Core>::value ||
+                           core_base_is_pointer<Core>::value
+                       ? 4
+                       : 3)
+                : detail::detector<void, core_decrement_t, Core>::value
+                      ? 2
+                      : detail::detector<void, core_eq_t, Core>::value &&
+                                std::is_default_constructible<Core>::value
+                            ? 1
+                            : 0>;
+
+        template<int Strength>
+        struct core_concept
+        {
+            using type = std::input_iterator_tag;
+        };
+        template<>
+        struct core_concept<1>
+        {
+            using type = std::forward_iterator_tag;
+        };
+        template<>
+        struct core_concept<2>
+        {
+            using type = std::bidirectional_iterator_tag;
+        };
+        template<>
+        struct core_concept<3>
+        {
+            using type = std::random_access_iterator_tag;
+        };
+        template<>
+        struct core_concept<4>
+        {
+            using type = contiguous_iterator_tag;
+        };
+    }
+
+#endif
+
+    /** The strongest iterator concept that an iterator can have whose
+        operations are those of `Core`: `contiguous_iterator_tag` if `Core`
+        has `+=`, `-` (with a result that converts to `DifferenceType`) and
+        `--`, and it is a pointer, or an iterator that
+        `is_contiguous_iterator` says is contiguous, or a class whose
+        `access::base()` -- its `base_reference()` -- is a pointer;
+        `std::random_access_iterator_tag` if it has those three operations
+        otherwise; `std::bidirectional_iterator_tag` if it has `--`;
+        `std::forward_iterator_tag` if it has `==` and is default
+        constructible; and `std::input_iterator_tag` otherwise. */
+    template<typename Core, typename DifferenceType = std::ptrdiff_t>
+    using deduced_iterator_concept_t = typename v1_dtl::core_concept<
+        v1_dtl::core_strength<Core, DifferenceType>::value>::type;
+
+    /** A CRTP template like `iterator_interface`, for an iterator that
+        stores a `Core` and does everything through it -- a pointer, any
+        other iterator, or a class of one's own that has only the
+        operations that it can do directly -- and whose iterator concept is
+        deduced from the operations `Core` has, by
+        `deduced_iterator_concept_t`, rather than stated.  An iterator that
+        states its concept often states a weaker one than it could; a
+        forward iterator that could have been random access makes
+        `std::distance()` and `std::lower_bound()` count their steps one at
+        a time, and one that could have been contiguous misses the
+        vectorized algorithms of `algorithm.hpp`.
+
+        The concept has to be deduced from `Core`, and not from `Derived`,
+        because `Derived` is incomplete where it names its base, which is
+        where the base's `iterator_concept` is fixed.  `Core` needs `*` and
+        `++`; `==`, `--`, `+=` and `-` make it stronger.  `Derived` gets
+        the rest of the operations from `iterator_interface`, which
+        implements each through `Core`'s, and needs only constructors,
+        usually `using auto_iterator_interface::auto_iterator_interface;`.
+        `core()` returns the `Core`. */
+    template<
+        typename Derived,
+        typename Core,
+        typename ValueType,
+        typename Reference = ValueType &,
+        typename Pointer = ValueType *,
+        typename DifferenceType = std::ptrdiff_t>
+    struct auto_iterator_interface : iterator_interface<
+                                         Derived,
+                                         deduced_iterator_concept_t<
+                                             Core,
+                                             DifferenceType>,
+                                         ValueType,
+                                         Reference,
+                                         Pointer,
+                                         DifferenceType>
+    {
+        using core_type = Core;
+
+        constexpr auto_iterator_interface() = default;
+        constexpr explicit auto_iterator_interface(Core core) noexcept(
+            std::is_nothrow_move_constructible<Core>::value) :
+            core_(std::move(core))
+        {}
+
+        /** Returns the stored `Core`. */
+        constexpr Core const & core() const noexcept { return core_; }
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+    private:
+        friend access;
+        constexpr Core & base_reference() noexcept { return core_; }
+        constexpr Core const & base_reference() const noexcept
+        {
+            return core_;
+        }
+
+        Core core_{};
+#endif
+    };
+
+}}}
+
+#endif
@@ -0,0 +1,207 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_BACK_INSERT_ITERATOR_HPP
+#define BOOST_STL_INTERFACES_BACK_INSERT_ITERATOR_HPP
+
+#include <boost/stl_interfaces/iterator_interface.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+    /** An output iterator that calls `push_back()` on a container when it is
+        written to, just like `std::back_insert_iterator`.
+
+        Written to one element at a time, as `std::copy()` does, it grows
+        the container one element at a time too, reallocating about
+        `log2(n)` times for `n` elements.  Pass it to
+        `boost::stl_interfaces::copy()` or `boost::stl_interfaces::transform()`
+        instead; those know the number of elements up front when the source
+        iterators are random access, and make room for all of them at once.
+        \see `back_inserter()` */
+    template<typename Container>
+    struct back_insert_iterator : iterator_interface<
+                                      back_insert_iterator<Container>,
+                                      std::output_iterator_tag,
+                                      typename Container::value_type,
+                                      back_insert_iterator<Container> &>
+    {
+        using container_type = Container;
+
+        constexpr back_insert_iterator() noexcept : c_(nullptr) {}
+        constexpr explicit back_insert_iterator(Container & c) noexcept :
+            c_(std::addressof(c))
+        {}
+
+        back_insert_iterator &
+        operator=(typename Container::value_type const & x)
+        {
+            c_->push_back(x);
+            return *this;
+        }
+        back_insert_iterator &
+        operator=(typename Container::value_type && x)
+        {
+            c_->push_back(std::move(x));
+            return *this;
+        }
+
+        constexpr back_insert_iterator & operator*() noexcept { return *this; }
+        constexpr back_insert_iterator & operator++() noexcept
+        {
+            return *this;
+        }
+
+        /** Returns the container written to. */
+        constexpr Container & container() const noexcept { return *c_; }
+
+        using base_type = iterator_interface<
+            back_insert_iterator<Container>,
+            std::output_iterator_tag,
+            typename Container::value_type,
+            back_insert_iterator<Container> &>;
+        using base_type::operator++;
+
+    private:
+        Container * c_;
+    };
+
+    /** Returns a `back_insert_iterator` that appends to `c`. */
+    template<typename Container>
+    constexpr back_insert_iterator<Container>
+    back_inserter(Container & c) noexcept
+    {
+        return back_insert_iterator<Container>(c);
+    }
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    namespace v1_dtl {
+        template<typename Container>
+        using reserve_t = decltype(
+            std::declval<Container &>().reserve(
+                std::declval<Container &>().capacity()),
+            std::declval<Container &>().size());
+
+        template<typename Iter>
+        using sized_source = std::is_convertible<
+            typename std::iterator_traits<Iter>::iterator_category,
+            std::random_access_iterator_tag>;
+
+        // Makes room in c for [first, last) at the end.  A container grown
+        // by many small copies must still grow geometrically, or each copy
+        // would reallocate; so the new capacity is at least twice the old
+        // one.
+        template<typename Container, typename Iter>
+        void back_insert_reserve(
+            Container & c, Iter first, Iter last, std::true_type)
+        {
+            using size_type = decltype(c.size());
+            auto const size = size_type(c.size() + size_type(last - first));
+            auto const capacity = size_type(c.capacity());
+            if (capacity < size)
+                c.reserve((std::max)(size, size_type(2 * capacity)));
+        }
+        template<typename Container, typename Iter>
+        void back_insert_reserve(Container &, Iter, Iter, std::false_type)
+        {}
+
+        template<typename Container, typename Iter>
+        void back_insert_reserve(Container & c, Iter first, Iter last)
+        {
+            v1_dtl::back_insert_reserve(
+                c,
+                first,
+                last,
+                std::integral_constant<
+                    bool,
+                    sized_source<Iter>::value &&
+                        detail::detector<void, reserve_t, Container>::
+                            value>{});
+        }
+
+        template<typename Iter>
+        struct back_insert_range
+        {
+            Iter begin() const { return first_; }
+            Iter end() const { return last_; }
+
+            Iter first_;
+            Iter last_;
+        };
+
+        template<typename Container, typename Iter>
+        using append_range_t = decltype(std::declval<Container &>().append_range(
+            std::declval<back_insert_range<Iter> &>()));
+
+        template<typename Container, typename Iter>
+        void back_insert_append(
+            Container & c, Iter first, Iter last, std::true_type)
+        {
+            back_insert_range<Iter> r{first, last};
+            c.append_range(r);
+        }
+        template<typename Container, typename Iter>
+        void back_insert_append(
+            Container & c, Iter first, Iter last, std::false_type)
+        {
+            for (; first != last; ++first) {
+                c.push_back(*first);
+            }
+        }
+    }
+
+#endif
+
+    /** Appends `[first, last)` to the container of `out`, like
+        `std::copy(first, last, out)`, and returns `out`.
+
+        When `Iter` is random access and the container has `reserve()` and
+        `capacity()`, as `std::vector` and `std::string` do, the container
+        reserves room for all the elements before any is appended.  The
+        elements are then appended with the container's `append_range()` if
+        it has one, as C++23 standard containers and containers derived from
+        `container_interface` do, and with `push_back()` otherwise.  Call it
+        unqualified in code that also has `using std::copy;`, and overload
+        resolution picks this `copy()` for `back_insert_iterator`s. */
+    template<typename Iter, typename Container>
+    back_insert_iterator<Container>
+    copy(Iter first, Iter last, back_insert_iterator<Container> out)
+    {
+        auto & c = out.container();
+        v1_dtl::back_insert_reserve(c, first, last);
+        v1_dtl::back_insert_append(
+            c,
+            first,
+            last,
+            std::integral_constant<
+                bool,
+                detail::detector<void, v1_dtl::append_range_t, Container, Iter>::
+                    value>{});
+        return out;
+    }
+
+    /** Appends `f(x)` for each `x` in `[first, last)` to the container of
+        `out`, like `std::transform(first, last, out, f)`, and returns `out`.
+        The container reserves room first, as in `copy()`. */
+    template<typename Iter, typename Container, typename F>
+    back_insert_iterator<Container>
+    transform(Iter first, Iter last, back_insert_iterator<Container> out, F f)
+    {
+        auto & c = out.container();
+        v1_dtl::back_insert_reserve(c, first, last);
+        for (; first != last; ++first) {
+            c.push_back(f(*first));
+        }
+        return out;
+    }
+
+}}}
+
+#endif
@@ -0,0 +1,504 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_BIT_VECTOR_HPP
+#define BOOST_STL_INTERFACES_BIT_VECTOR_HPP
+
+#include <boost/stl_interfaces/container_interface.hpp>
+#include <boost/stl_interfaces/reverse_iterator.hpp>
+#include <boost/stl_interfaces/view_interface.hpp>
+
+#include <algorithm>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <cassert>
+#include <cstdint>
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+    // The bits are kept in 64-bit words, least significant bit first.
+    using bit_word = std::uint64_t;
+    constexpr int bits_per_word = 64;
+
+    namespace bit_detail {
+        inline int popcount(bit_word w) noexcept
+        {
+#if defined(__GNUC__)
+            return __builtin_popcountll(w);
+#else
+            int retval = 0;
+            for (; w; w &= w - 1) {
+                ++retval;
+            }
+            return retval;
+#endif
+        }
+        // The index of the lowest set bit.  w must not be 0.
+        inline int lowest_bit(bit_word w) noexcept
+        {
+#if defined(__GNUC__)
+            return __builtin_ctzll(w);
+#else
+            int retval = 0;
+            for (; !(w & 1); w >>= 1) {
+                ++retval;
+            }
+            return retval;
+#endif
+        }
+        // The bits [first, last) of a word.
+        inline bit_word mask(int first, int last) noexcept
+        {
+            return (last == bits_per_word ? ~bit_word(0)
+                                          : (bit_word(1) << last) - 1) &
+                   (~bit_word(0) << first);
+        }
+    }
+
+    //[ bit_reference
+    // The reference type of a mutable bit_iterator, since there is no bool
+    // object anywhere for a real reference to refer to.  Like
+    // std::vector<bool>::reference, it converts to bool, and assigns through to
+    // its bit.  The reference type of a const bit_iterator is just bool.
+    struct bit_reference
+    {
+        bit_reference(bit_word * word, int bit) noexcept :
+            word_(word),
+            mask_(bit_word(1) << bit)
+        {}
+        bit_reference(bit_reference const &) = default;
+
+        operator bool() const noexcept { return *word_ & mask_; }
+        bool operator~() const noexcept { return !*this; }
+
+        bit_reference & operator=(bool x) noexcept
+        {
+            if (x)
+                *word_ |= mask_;
+            else
+                *word_ &= ~mask_;
+            return *this;
+        }
+        bit_reference & operator=(bit_reference const & other) noexcept
+        {
+            return *this = bool(other);
+        }
+        void flip() noexcept { *word_ ^= mask_; }
+
+        friend void swap(bit_reference lhs, bit_reference rhs) noexcept
+        {
+            bool const x = lhs;
+            lhs = bool(rhs);
+            rhs = x;
+        }
+
+    private:
+        bit_word * word_;
+        bit_word mask_;
+    };
+    //]
+
+    //[ bit_iterator
+    // An iterator over the bits of an array of words; W is bit_word, or
+    // bit_word const for a const_iterator.  The arrow operator comes from
+    // proxy_iterator_interface.
+    template<typename W>
+    struct bit_iterator
+        : proxy_iterator_interface<
+              bit_iterator<W>,
+              std::random_access_iterator_tag,
+              bool,
+              std::conditional_t<std::is_const<W>::value, bool, bit_reference>>
+    {
+        using reference =
+            std::conditional_t<std::is_const<W>::value, bool, bit_reference>;
+
+        bit_iterator() noexcept : word_(nullptr), bit_(0) {}
+        bit_iterator(W * word, int bit) noexcept : word_(word), bit_(bit) {}
+        template<
+            typename W2,
+            typename E = std::enable_if_t<
+                std::is_same<W, W2 const>::value &&
+                !std::is_same<W, W2>::value>>
+        bit_iterator(bit_iterator<W2> other) noexcept :
+            word_(other.word()),
+            bit_(other.bit())
+        {}
+
+        reference operator*() const noexcept { return deref(word_); }
+        bit_iterator & operator++() noexcept
+        {
+            if (++bit_ == bits_per_word) {
+                ++word_;
+                bit_ = 0;
+            }
+            return *this;
+        }
+        bit_iterator & operator--() noexcept
+        {
+            if (!bit_--) {
+                --word_;
+                bit_ = bits_per_word - 1;
+            }
+            return *this;
+        }
+        bit_iterator & operator+=(std::ptrdiff_t n) noexcept
+        {
+            n += bit_;
+            auto const words =
+                n < 0 ? -((-n + bits_per_word - 1) / bits_per_word)
+                      : n / bits_per_word;
+            word_ += words;
+            bit_ = int(n - words * bits_per_word);
+            return *this;
+        }
+        friend std::ptrdiff_t
+        operator-(bit_iterator lhs, bit_iterator rhs) noexcept
+        {
+            return (lhs.word_ - rhs.word_) * bits_per_word + lhs.bit_ -
+                   rhs.bit_;
+        }
+        friend bool operator==(bit_iterator lhs, bit_iterator rhs) noexcept
+        {
+            return lhs.word_ == rhs.word_ && lhs.bit_ == rhs.bit_;
+        }
+
+        // The word this iterator is in, and its bit within that word.  These
+        // are what the algorithm overloads below use to go a word at a time.
+        W * word() const noexcept { return word_; }
+        int bit() const noexcept { return bit_; }
+
+        using base_type = proxy_iterator_interface<
+            bit_iterator<W>,
+            std::random_access_iterator_tag,
+            bool,
+            reference>;
+        using base_type::operator++;
+        using base_type::operator--;
+
+    private:
+        bool deref(bit_word const * w) const noexcept
+        {
+            return *w & (bit_word(1) << bit_);
+        }
+        bit_reference deref(bit_word * w) const noexcept
+        {
+            return bit_reference(w, bit_);
+        }
+
+        W * word_;
+        int bit_;
+    };
+    //]
+
+    //[ bit_algorithms
+    // Overloads of std::count(), std::find(), std::fill(), and std::copy() for
+    // bit_iterators, found by ADL.  Each goes a word at a time, rather than a
+    // bit at a time, handling the partial words at either end with masks.
+
+    // Counts the bits in [first, last) that equal value.
+    template<typename W>
+    std::ptrdiff_t count(
+        bit_iterator<W> first, bit_iterator<W> last, bool value)
+    {
+        std::ptrdiff_t ones = 0;
+        auto w = first.word();
+        auto bit = first.bit();
+        for (; w != last.word(); ++w, bit = 0) {
+            ones += bit_detail::popcount(*w >> bit);
+        }
+        if (last.bit())
+            ones += bit_detail::popcount(
+                *w & bit_detail::mask(bit, last.bit()));
+        return value ? ones : (last - first) - ones;
+    }
+
+    // Returns the first bit in [first, last) that equals value, or last.
+    template<typename W>
+    bit_iterator<W> find(
+        bit_iterator<W> first, bit_iterator<W> last, bool value)
+    {
+        auto w = first.word();
+        auto bit = first.bit();
+        for (; w != last.word(); ++w, bit = 0) {
+            auto const bits =
+                (value ? *w : ~*w) & bit_detail::mask(bit, bits_per_word);
+            if (bits)
+                return bit_iterator<W>(w, bit_detail::lowest_bit(bits));
+        }
+        if (last.bit()) {
+            auto const bits =
+                (value ? *w : ~*w) & bit_detail::mask(bit, last.bit());
+            if (bits)
+                return bit_iterator<W>(w, bit_detail::lowest_bit(bits));
+        }
+        return last;
+    }
+
+    // Sets the bits in [first, last) to value.
+    inline void
+    fill(bit_iterator<bit_word> first, bit_iterator<bit_word> last, bool value)
+    {
+        auto w = first.word();
+        auto bit = first.bit();
+        auto const set = [value](bit_word & word, bit_word mask) {
+            word = value ? word | mask : word & ~mask;
+        };
+        for (; w != last.word(); ++w, bit = 0) {
+            set(*w, bit_detail::mask(bit, bits_per_word));
+        }
+        if (last.bit())
+            set(*w, bit_detail::mask(bit, last.bit()));
+    }
+
+    // Copies the bits in [first, last) to out, and returns the end of the
+    // output.  The output may overlap the input, if it starts before it.
+    //
+    // Once the output is at the start of a word, each output word is put
+    // together from the two input words it straddles.
+    template<typename W>
+    bit_iterator<bit_word> copy(
+        bit_iterator<W> first,
+        bit_iterator<W> last,
+        bit_iterator<bit_word> out)
+    {
+        auto n = last - first;
+        for (; n && out.bit(); --n) {
+            *out++ = bool(*first++);
+        }
+        auto src = first.word();
+        auto const bit = first.bit();
+        auto dst = out.word();
+        for (; bits_per_word <= n; n -= bits_per_word, ++src, ++dst) {
+            *dst = bit ? (src[0] >> bit) | (src[1] << (bits_per_word - bit))
+                       : src[0];
+        }
+        first = bit_iterator<W>(src, bit);
+        out = bit_iterator<bit_word>(dst, out.bit());
+        for (; n; --n) {
+            *out++ = bool(*first++);
+        }
+        return out;
+    }
+    //]
+
+    //[ bit_span
+    // A view of some bits of an array of words.  view_interface provides
+    // empty(), size(), operator[](), front(), and back().
+    template<typename W>
+    struct bit_span : view_interface<bit_span<W>>
+    {
+        using iterator = bit_iterator<W>;
+
+        bit_span() noexcept {}
+        bit_span(iterator first, iterator last) noexcept :
+            first_(first),
+            last_(last)
+        {}
+        // The first n bits of the words starting at words.
+        bit_span(W * words, std::size_t n) noexcept :
+            first_(words, 0),
+            last_(iterator(words, 0) + n)
+        {}
+
+        iterator begin() const noexcept { return first_; }
+        iterator end() const noexcept { return last_; }
+
+    private:
+        iterator first_;
+        iterator last_;
+    };
+    //]
+
+    struct bit_vector;
+
+    // The words are in a std::vector, which destroys them; see flat_map.hpp.
+    template<>
+    struct trivially_destructible_container<bit_vector> : std::true_type
+    {};
+
+    //[ bit_vector_defn
+    // A std::vector<bool>-like sequence of bits, packed 64 to a word.  The bits
+    // past size() in the last word are unspecified; everything here ignores
+    // them.
+    //
+    // insert() and erase() in the middle move the following bits with the
+    // word-at-a-time copy() above.
+    struct bit_vector : container_interface<bit_vector>
+    {
+        // types
+        using value_type = bool;
+        using reference = bit_reference;
+        using const_reference = bool;
+        using iterator = bit_iterator<bit_word>;
+        using const_iterator = bit_iterator<bit_word const>;
+        using reverse_iterator = stl_interfaces::reverse_iterator<iterator>;
+        using const_reverse_iterator =
+            stl_interfaces::reverse_iterator<const_iterator>;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+
+        // construct/copy/destroy (9 members, skipped 2)
+        bit_vector() noexcept : size_(0) {}
+        explicit bit_vector(size_type n, bool x = false) :
+            words_(words_for(n), x ? ~bit_word(0) : bit_word(0)),
+            size_(n)
+        {}
+        template<
+            typename InputIterator,
+            typename Enable = std::enable_if_t<std::is_convertible<
+                typename std::iterator_traits<InputIterator>::iterator_category,
+                std::input_iterator_tag>::value>>
+        bit_vector(InputIterator first, InputIterator last) : size_(0)
+        {
+            for (; first != last; ++first) {
+                push_back(*first);
+            }
+        }
+        bit_vector(std::initializer_list<bool> il) :
+            bit_vector(il.begin(), il.end())
+        {}
+        bit_vector(bit_vector const & other) = default;
+        bit_vector(bit_vector && other) noexcept :
+            words_(std::move(other.words_)),
+            size_(std::exchange(other.size_, 0))
+        {
+            other.words_.clear();
+        }
+        bit_vector & operator=(bit_vector const & other) = default;
+        bit_vector & operator=(bit_vector && other) noexcept
+        {
+            bit_vector temp(std::move(other));
+            swap(temp);
+            return *this;
+        }
+        ~bit_vector() = default;
+
+        // iterators (2 members, skipped 10)
+        iterator begin() noexcept { return iterator(words_.data(), 0); }
+        iterator end() noexcept { return begin() + size_; }
+
+        // capacity (6 members, skipped 2)
+        size_type size() const noexcept { return size_; }
+        size_type max_size() const noexcept
+        {
+            return std::numeric_limits<difference_type>::max();
+        }
+        void resize(size_type n, bool x = false)
+        {
+            auto const old_size = size_;
+            words_.resize(words_for(n));
+            size_ = n;
+            if (old_size < n)
+                fill(begin() + old_size, end(), x);
+        }
+        size_type capacity() const noexcept
+        {
+            return words_.capacity() * bits_per_word;
+        }
+        void reserve(size_type n) { words_.reserve(words_for(n)); }
+        void shrink_to_fit() { words_.shrink_to_fit(); }
+
+        // modifiers (6 members, skipped 9)
+        reference emplace_back(bool x)
+        {
+            if (size_ == words_.size() * bits_per_word)
+                words_.push_back(0);
+            auto retval = *end();
+            ++size_;
+            return retval = x;
+        }
+        void pop_back() noexcept
+        {
+            assert(size_);
+            --size_;
+        }
+        iterator emplace(const_iterator pos, bool x)
+        {
+            return insert(pos, 1, x);
+        }
+        iterator insert(const_iterator pos, size_type n, bool x)
+        {
+            auto const i = pos - cbegin();
+            open_gap(i, n);
+            fill(begin() + i, begin() + i + n, x);
+            return begin() + i;
+        }
+        template<
+            typename InputIterator,
+            typename Enable = std::enable_if_t<std::is_convertible<
+                typename std::iterator_traits<InputIterator>::iterator_category,
+                std::input_iterator_tag>::value>>
+        iterator insert(
+            const_iterator pos, InputIterator first, InputIterator last)
+        {
+            bit_vector const bits(first, last);
+            auto const i = pos - cbegin();
+            open_gap(i, bits.size());
+            copy(bits.begin(), bits.end(), begin() + i);
+            return begin() + i;
+        }
+        iterator erase(const_iterator first, const_iterator last) noexcept
+        {
+            auto const i = first - cbegin();
+            auto const n = last - first;
+            copy(last, cend(), begin() + i);
+            size_ -= n;
+            return begin() + i;
+        }
+        void swap(bit_vector & other) noexcept
+        {
+            words_.swap(other.words_);
+            std::swap(size_, other.size_);
+        }
+        friend void swap(bit_vector & lhs, bit_vector & rhs) noexcept
+        {
+            lhs.swap(rhs);
+        }
+
+        // Flips every bit.
+        void flip() noexcept
+        {
+            for (auto & w : words_) {
+                w = ~w;
+            }
+        }
+
+        using base_type = container_interface<bit_vector>;
+        using base_type::begin;
+        using base_type::end;
+        using base_type::insert;
+        using base_type::erase;
+
+    private:
+        static size_type words_for(size_type n) noexcept
+        {
+            return (n + bits_per_word - 1) / bits_per_word;
+        }
+
+        // Makes room for n bits at index i, by copying the bits after them to
+        // a temporary, and back n bits later.
+        void open_gap(size_type i, size_type n)
+        {
+            bit_vector tail(size_ - i);
+            copy(cbegin() + i, cend(), tail.begin());
+            resize(size_ + n);
+            copy(tail.begin(), tail.end(), begin() + i + n);
+        }
+
+        std::vector<bit_word> words_;
+        size_type size_;
+    };
+    //]
+
+}}}
+
+#endif
@@ -0,0 +1,230 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_BLOOM_FILTER_HPP
+#define BOOST_STL_INTERFACES_BLOOM_FILTER_HPP
+
+#include <boost/stl_interfaces/detail/batch_probe.hpp>
+#include <boost/stl_interfaces/detail/functor_box.hpp>
+#include <boost/stl_interfaces/hash.hpp>
+#include <boost/stl_interfaces/prefetch_view.hpp>
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    namespace v1_dtl {
+        // Mixes a std::hash value, which is often the identity for
+        // integers, into 64 well-distributed bits.
+        inline std::uint64_t filter_hash(std::uint64_t h) noexcept
+        {
+            return v1_dtl::hash_mix(h ^ hash_p0, hash_p1);
+        }
+
+        // Maps h to [0, n), by the high half of h * n.
+        inline std::size_t
+        filter_reduce(std::uint64_t h, std::size_t n) noexcept
+        {
+            std::uint64_t hi = n;
+            v1_dtl::hash_mum(h, hi);
+            return std::size_t(hi);
+        }
+    }
+
+#endif
+
+    /** A blocked Bloom filter of keys of type `T`: a set that may report a
+        key that was never inserted as present, with a false positive rate
+        chosen at construction, but never reports an inserted key as
+        absent, in about 10 bits per key for a rate of 1%.
+
+        Each key's hash picks one 64-byte block, one cache line, of the
+        filter, and sets or tests `hash_count()` bits within it, so a query
+        misses the cache at most once.  The batch `contains(first, last,
+        out)` hashes 32 keys at a time and prefetches their blocks before
+        testing any of them, so that their misses overlap; for a filter
+        much larger than the cache, that is the difference between one
+        miss per key and a few per batch.
+
+        `Hash` is a `std::hash`-like function object; its result is mixed
+        further, so an identity hash of integers is fine.  Keys cannot be
+        erased; see `cuckoo_filter` for a filter that can erase them. */
+    template<typename T, typename Hash = std::hash<T>>
+    struct bloom_filter : private detail::functor_box<Hash>
+    {
+        using key_type = T;
+        using hasher = Hash;
+        using size_type = std::size_t;
+
+        /** The number of bits in each block, and of bits that each key may
+            set. */
+        static constexpr size_type block_bits = 512;
+
+        /** Constructs a filter sized for `capacity` keys, with a false
+            positive rate of about `false_positive_rate` once it holds that
+            many.  Blocking raises the rate slightly above that of a
+            classic Bloom filter of the same size.
+
+            \pre `0 < false_positive_rate && false_positive_rate < 1` */
+        explicit bloom_filter(
+            size_type capacity,
+            double false_positive_rate = 0.01,
+            Hash const & hash = Hash()) :
+            detail::functor_box<Hash>(hash)
+        {
+            BOOST_ASSERT(
+                0 < false_positive_rate && false_positive_rate < 1);
+            double const ln2 = std::log(2.0);
+            double const bits_per_key =
+                -std::log(false_positive_rate) / (ln2 * ln2);
+            double const bits = std::ceil(
+                bits_per_key * double((std::max)(capacity, size_type(1))));
+            blocks_ = (std::max)(
+                size_type(1), size_type(std::ceil(bits / block_bits)));
+            hash_count_ = (std::min)(
+                16, (std::max)(1, int(std::lround(bits_per_key * ln2))));
+            // Room to align the first block to a cache line.
+            words_.assign((blocks_ + 1) * words_per_block, 0);
+        }
+
+        /** Returns the number of `insert()` calls since construction or
+            `clear()`, counting repeated keys each time. */
+        size_type size() const noexcept { return size_; }
+        bool empty() const noexcept { return !size_; }
+        /** Returns the number of bits in the filter. */
+        size_type bit_count() const noexcept { return blocks_ * block_bits; }
+        /** Returns the number of bits that each key sets. */
+        int hash_count() const noexcept { return hash_count_; }
+        hasher hash_function() const { return hash(); }
+
+        /** Inserts `x`. */
+        void insert(T const & x)
+        {
+            probe const p = make_probe(x);
+            std::uint64_t * const block = block_at(p.block);
+            auto bit = p.bit;
+            for (int i = 0; i < hash_count_; ++i, bit += p.step) {
+                block[(bit % block_bits) / 64] |= std::uint64_t(1)
+                                                  << (bit % 64);
+            }
+            ++size_;
+        }
+        /** Inserts the keys of `[first, last)`. */
+        template<typename InputIterator, typename Sentinel>
+        void insert(InputIterator first, Sentinel last)
+        {
+            for (; first != last; ++first) {
+                insert(*first);
+            }
+        }
+
+        /** Returns `true` if `x` may have been inserted, and `false` if it
+            was not. */
+        bool contains(T const & x) const
+        {
+            return test(make_probe(x));
+        }
+        /** Writes `contains(x)`, as a `bool`, to `out` for each key `x` of
+            `[first, last)`, in order, and returns the end of the output.
+            `out` may be any output iterator that accepts a `bool`: a
+            `bool *`, a `std::vector<bool>::iterator`, or a
+            `std::back_insert_iterator`.  The keys' blocks are prefetched a
+            batch at a time, before any of them is tested. */
+        template<
+            typename InputIterator,
+            typename Sentinel,
+            typename OutputIterator>
+        OutputIterator
+        contains(InputIterator first, Sentinel last, OutputIterator out) const
+        {
+            return detail::batch_probe::contains(*this, first, last, out);
+        }
+
+        void clear() noexcept
+        {
+            std::fill(words_.begin(), words_.end(), 0);
+            size_ = 0;
+        }
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+    private:
+        friend detail::batch_probe;
+
+        static constexpr size_type words_per_block = block_bits / 64;
+
+        // A key's block, and the first of its bits in the block and the
+        // odd stride between them.
+        struct probe
+        {
+            size_type block;
+            std::uint32_t bit;
+            std::uint32_t step;
+        };
+
+        Hash const & hash() const noexcept
+        {
+            return detail::functor_box<Hash>::get();
+        }
+
+        // words_ is a vector, whose elements need not be aligned to a
+        // cache line; the blocks start at its first element that is.
+        std::uint64_t * block_at(size_type b) noexcept
+        {
+            std::uint64_t * const first = words_.data();
+            auto const skip =
+                (0 - reinterpret_cast<std::uintptr_t>(first)) % 64 / 8;
+            return first + skip + b * words_per_block;
+        }
+        std::uint64_t const * block_at(size_type b) const noexcept
+        {
+            return const_cast<bloom_filter &>(*this).block_at(b);
+        }
+
+        probe make_probe(T const & x) const
+        {
+            std::uint64_t const h =
+                v1_dtl::filter_hash(std::uint64_t(hash()(x)));
+            std::uint64_t const h2 = v1_dtl::hash_mix(h ^ v1_dtl::hash_p2,
+                                                      v1_dtl::hash_p3);
+            return {
+                v1_dtl::filter_reduce(h, blocks_),
+                std::uint32_t(h2),
+                std::uint32_t(h2 >> 32) | 1u};
+        }
+        void prefetch(probe p) const noexcept
+        {
+            v1_dtl::prefetch(block_at(p.block));
+        }
+        bool test(probe p) const noexcept
+        {
+            std::uint64_t const * const block = block_at(p.block);
+            auto bit = p.bit;
+            std::uint64_t miss = 0;
+            for (int i = 0; i < hash_count_; ++i, bit += p.step) {
+                miss |= ~block[(bit % block_bits) / 64] >> (bit % 64) & 1u;
+            }
+            return !miss;
+        }
+
+        std::vector<std::uint64_t> words_;
+        size_type blocks_ = 0;
+        size_type size_ = 0;
+        int hash_count_ = 0;
+#endif
+    };
+
+}}}
+
+#endif
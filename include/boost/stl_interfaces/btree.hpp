@@ -0,0 +1,1328 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_BTREE_HPP
+#define BOOST_STL_INTERFACES_BTREE_HPP
+
+#include <boost/stl_interfaces/container_interface.hpp>
+#include <boost/stl_interfaces/segmented_iterator.hpp>
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+    template<typename Key, typename T, typename Compare>
+    struct btree_map;
+    template<typename Key, typename Compare>
+    struct btree_set;
+
+    /** `btree_map` destroys its elements itself, so `container_interface`
+        does not need to call `clear()`. */
+    template<typename Key, typename T, typename Compare>
+    struct trivially_destructible_container<btree_map<Key, T, Compare>>
+        : std::true_type
+    {
+    };
+
+    /** `btree_set` destroys its elements itself, so `container_interface`
+        does not need to call `clear()`. */
+    template<typename Key, typename Compare>
+    struct trivially_destructible_container<btree_set<Key, Compare>>
+        : std::true_type
+    {
+    };
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    namespace v1_dtl {
+        // Nodes are sized to fit in four cache lines, or to hold four
+        // elements, whichever is larger.
+        constexpr std::size_t btree_node_bytes = 256;
+        constexpr std::size_t btree_cache_line = 64;
+
+        constexpr std::size_t
+        btree_capacity(std::size_t header, std::size_t element) noexcept
+        {
+            return btree_node_bytes < header + 4 * element
+                       ? 4
+                       : (btree_node_bytes - header) / element;
+        }
+
+        template<typename Key, typename Slot>
+        struct btree_internal;
+
+        template<typename Key, typename Slot>
+        struct btree_node
+        {
+            explicit btree_node(bool l) noexcept : leaf(l) {}
+
+            btree_internal<Key, Slot> * parent = nullptr;
+            // The index of this node in parent->children.
+            unsigned short position = 0;
+            // The number of elements of a leaf, or of keys of an internal
+            // node, which has count + 1 children.
+            unsigned short count = 0;
+            bool leaf;
+        };
+
+        // A leaf holds its elements sorted and contiguous, and is linked to
+        // the leaves on either side of it.
+        template<typename Key, typename Slot>
+        struct btree_leaf : btree_node<Key, Slot>
+        {
+            static constexpr std::size_t capacity = v1_dtl::btree_capacity(
+                sizeof(btree_node<Key, Slot>) + 2 * sizeof(void *),
+                sizeof(Slot));
+
+            btree_leaf() noexcept : btree_node<Key, Slot>(true) {}
+
+            Slot * values() noexcept
+            {
+                return reinterpret_cast<Slot *>(storage);
+            }
+
+            btree_leaf * prev = nullptr;
+            btree_leaf * next = nullptr;
+            alignas(Slot) unsigned char storage[capacity * sizeof(Slot)];
+        };
+
+        // An internal node holds count keys, each a copy of a key in the
+        // tree, and count + 1 children; every key in children[i] is less
+        // than keys[i], and every key in children[i + 1] is not.
+        template<typename Key, typename Slot>
+        struct btree_internal : btree_node<Key, Slot>
+        {
+            static constexpr std::size_t capacity = v1_dtl::btree_capacity(
+                sizeof(btree_node<Key, Slot>) + sizeof(void *),
+                sizeof(Key) + sizeof(void *));
+
+            btree_internal() noexcept : btree_node<Key, Slot>(false) {}
+
+            Key * keys() noexcept { return reinterpret_cast<Key *>(storage); }
+
+            btree_node<Key, Slot> * children[capacity + 1];
+            alignas(Key) unsigned char storage[capacity * sizeof(Key)];
+        };
+
+        template<typename Node>
+        Node * btree_new_node()
+        {
+#if defined(__cpp_aligned_new)
+            void * const p = ::operator new(
+                sizeof(Node), std::align_val_t(btree_cache_line));
+#else
+            void * const p = ::operator new(sizeof(Node));
+#endif
+            return ::new (p) Node;
+        }
+        template<typename Node>
+        void btree_delete_node(Node * n) noexcept
+        {
+            n->~Node();
+#if defined(__cpp_aligned_new)
+            ::operator delete(n, std::align_val_t(btree_cache_line));
+#else
+            ::operator delete(n);
+#endif
+        }
+
+        template<typename T>
+        void btree_relocate(T * to, T * from) noexcept
+        {
+            ::new (to) T(std::move(*from));
+            from->~T();
+        }
+        template<typename T>
+        void btree_relocate_n(T * to, T * from, std::size_t n) noexcept
+        {
+            for (std::size_t i = 0; i < n; ++i) {
+                v1_dtl::btree_relocate(to + i, from + i);
+            }
+        }
+        // Moves [first, last) to [first + 1, last + 1).
+        template<typename T>
+        void btree_open_gap(T * first, T * last) noexcept
+        {
+            for (; last != first; --last) {
+                v1_dtl::btree_relocate(last, last - 1);
+            }
+        }
+        // Moves [first + 1, last) to [first, last - 1); *first must be
+        // destroyed.
+        template<typename T>
+        void btree_close_gap(T * first, T * last) noexcept
+        {
+            for (; first + 1 < last; ++first) {
+                v1_dtl::btree_relocate(first, first + 1);
+            }
+        }
+
+        // The leaves of a B-tree, as the segments of its iterator.
+        template<typename Leaf>
+        struct btree_segment
+        {
+            btree_segment & operator++() noexcept
+            {
+                leaf = leaf->next;
+                return *this;
+            }
+            friend bool
+            operator==(btree_segment lhs, btree_segment rhs) noexcept
+            {
+                return lhs.leaf == rhs.leaf;
+            }
+            friend bool
+            operator!=(btree_segment lhs, btree_segment rhs) noexcept
+            {
+                return lhs.leaf != rhs.leaf;
+            }
+
+            Leaf * leaf;
+        };
+
+        // A B+-tree of Slots, each with the key KeyOfSlot()(slot), unique
+        // under Compare.  Positions in it are (leaf, index) pairs; the only
+        // position at the end of a leaf is the end of the last one.
+        template<
+            typename Key,
+            typename Slot,
+            typename KeyOfSlot,
+            typename Compare>
+        struct btree
+        {
+            static_assert(
+                std::is_nothrow_move_constructible<Slot>::value &&
+                    std::is_nothrow_move_constructible<Key>::value &&
+                    std::is_nothrow_move_assignable<Key>::value,
+                "A B-tree moves its elements and keys between nodes, which "
+                "must not throw.");
+
+            using node = btree_node<Key, Slot>;
+            using leaf = btree_leaf<Key, Slot>;
+            using internal = btree_internal<Key, Slot>;
+
+            static constexpr std::size_t min_leaf = leaf::capacity / 2;
+            static constexpr std::size_t min_internal =
+                internal::capacity / 2;
+
+            struct position
+            {
+                leaf * l;
+                std::size_t i;
+            };
+
+            btree() = default;
+            explicit btree(Compare const & comp) : comp_(comp) {}
+            btree(btree const & other) : comp_(other.comp_)
+            {
+                for (leaf * l = other.first_; l; l = l->next) {
+                    for (std::size_t i = 0; i < l->count; ++i) {
+                        append(l->values()[i]);
+                    }
+                }
+            }
+            btree(btree && other) noexcept :
+                root_(std::exchange(other.root_, nullptr)),
+                first_(std::exchange(other.first_, nullptr)),
+                last_(std::exchange(other.last_, nullptr)),
+                size_(std::exchange(other.size_, 0)),
+                comp_(other.comp_)
+            {}
+            btree & operator=(btree const & other)
+            {
+                btree temp(other);
+                swap(temp);
+                return *this;
+            }
+            btree & operator=(btree && other) noexcept
+            {
+                btree temp(std::move(other));
+                swap(temp);
+                return *this;
+            }
+            ~btree() { clear(); }
+
+            void swap(btree & other) noexcept
+            {
+                std::swap(root_, other.root_);
+                std::swap(first_, other.first_);
+                std::swap(last_, other.last_);
+                std::swap(size_, other.size_);
+                std::swap(comp_, other.comp_);
+            }
+
+            static Key const & key(Slot const & s) noexcept
+            {
+                return KeyOfSlot()(s);
+            }
+
+            position begin() const noexcept { return {first_, 0}; }
+            position end() const noexcept
+            {
+                return {last_, last_ ? last_->count : 0u};
+            }
+
+            position lower_bound(Key const & k) const
+            {
+                if (!root_)
+                    return end();
+                leaf * const l = find_leaf(k);
+                return normalize(l, lower_index(l, k));
+            }
+            position upper_bound(Key const & k) const
+            {
+                if (!root_)
+                    return end();
+                leaf * const l = find_leaf(k);
+                Slot * const values = l->values();
+                std::size_t const i =
+                    std::upper_bound(
+                        values,
+                        values + l->count,
+                        k,
+                        [this](Key const & k, Slot const & s) {
+                            return comp_(k, key(s));
+                        }) -
+                    values;
+                return normalize(l, i);
+            }
+            position find(Key const & k) const
+            {
+                if (!root_)
+                    return end();
+                leaf * const l = find_leaf(k);
+                std::size_t const i = lower_index(l, k);
+                if (i == l->count || comp_(k, key(l->values()[i])))
+                    return end();
+                return {l, i};
+            }
+
+            // Inserts a Slot constructed from args, whose key is k, unless
+            // there is an element with key k.
+            template<typename... Args>
+            std::pair<position, bool>
+            emplace_key(Key const & k, Args &&... args)
+            {
+                if (!root_)
+                    return {insert_at(nullptr, 0, k, (Args &&) args...), true};
+                leaf * const l = find_leaf(k);
+                std::size_t const i = lower_index(l, k);
+                if (i < l->count && !comp_(k, key(l->values()[i])))
+                    return {position{l, i}, false};
+                return {insert_at(l, i, k, (Args &&) args...), true};
+            }
+            // As emplace_key(), but appends directly if k is greater than
+            // every key, as it is when copying a sorted sequence.
+            template<typename... Args>
+            std::pair<position, bool>
+            emplace_key_hint_end(Key const & k, Args &&... args)
+            {
+                if (last_ &&
+                    comp_(key(last_->values()[last_->count - 1]), k)) {
+                    return {
+                        insert_at(last_, last_->count, k, (Args &&) args...),
+                        true};
+                }
+                return emplace_key(k, (Args &&) args...);
+            }
+            template<typename S>
+            void append(S && s)
+            {
+                insert_at(last_, last_ ? last_->count : 0, key(s), (S &&) s);
+            }
+
+            position erase(position pos) noexcept
+            {
+                leaf * const l = pos.l;
+                Slot * const values = l->values();
+                values[pos.i].~Slot();
+                v1_dtl::btree_close_gap(values + pos.i, values + l->count);
+                --l->count;
+                --size_;
+                if (l == root_) {
+                    if (!l->count) {
+                        v1_dtl::btree_delete_node(l);
+                        root_ = first_ = last_ = nullptr;
+                        return end();
+                    }
+                    return normalize(l, pos.i);
+                }
+                if (l->count < min_leaf)
+                    return rebalance_leaf(l, pos.i);
+                return normalize(l, pos.i);
+            }
+
+            void clear() noexcept
+            {
+                if (root_)
+                    destroy(root_);
+                root_ = first_ = last_ = nullptr;
+                size_ = 0;
+            }
+
+            std::size_t size() const noexcept { return size_; }
+            Compare const & comp() const noexcept { return comp_; }
+
+        private:
+            position normalize(leaf * l, std::size_t i) const noexcept
+            {
+                if (i == l->count && l->next)
+                    return {l->next, 0};
+                return {l, i};
+            }
+
+            leaf * find_leaf(Key const & k) const
+            {
+                node * n = root_;
+                while (!n->leaf) {
+                    auto const in = static_cast<internal *>(n);
+                    Key * const keys = in->keys();
+                    n = in->children[std::size_t(
+                        std::upper_bound(keys, keys + in->count, k, comp_) -
+                        keys)];
+                }
+                return static_cast<leaf *>(n);
+            }
+            std::size_t lower_index(leaf * l, Key const & k) const
+            {
+                Slot * const values = l->values();
+                return std::lower_bound(
+                           values,
+                           values + l->count,
+                           k,
+                           [this](Slot const & s, Key const & k) {
+                               return comp_(key(s), k);
+                           }) -
+                       values;
+            }
+
+            static void
+            set_child(internal * p, std::size_t j, node * c) noexcept
+            {
+                p->children[j] = c;
+                c->parent = p;
+                c->position = (unsigned short)j;
+            }
+
+            // Inserts c into p as children[j], with sep as keys[j - 1]; p
+            // must have room.
+            static void
+            insert_child(internal * p, std::size_t j, Key && sep, node * c)
+                noexcept
+            {
+                Key * const keys = p->keys();
+                v1_dtl::btree_open_gap(keys + j - 1, keys + p->count);
+                ::new (keys + j - 1) Key(std::move(sep));
+                for (std::size_t m = p->count + 1; j < m; --m) {
+                    set_child(p, m, p->children[m - 1]);
+                }
+                set_child(p, j, c);
+                ++p->count;
+            }
+
+            // Makes room in n's parent for one more child, splitting it,
+            // and its ancestors, as needed, or gives n a parent if it is
+            // the root.  Every node is allocated before any is changed, so
+            // if an allocation throws, the tree is unchanged.  If append is
+            // true, the new child will be the last in the tree, and a split
+            // leaves the left node full.
+            void make_room_above(node * n, bool append)
+            {
+                internal * const p = n->parent;
+                if (!p) {
+                    auto const root = v1_dtl::btree_new_node<internal>();
+                    set_child(root, 0, n);
+                    root_ = root;
+                    return;
+                }
+                if (p->count < internal::capacity)
+                    return;
+                auto const q = v1_dtl::btree_new_node<internal>();
+                try {
+                    make_room_above(p, append);
+                } catch (...) {
+                    v1_dtl::btree_delete_node(q);
+                    throw;
+                }
+                std::size_t const mid =
+                    append ? p->count - 1u : p->count / 2u;
+                std::size_t const moved = p->count - mid - 1;
+                Key * const keys = p->keys();
+                v1_dtl::btree_relocate_n(q->keys(), keys + mid + 1, moved);
+                for (std::size_t j = 0; j <= moved; ++j) {
+                    set_child(q, j, p->children[mid + 1 + j]);
+                }
+                q->count = (unsigned short)moved;
+                Key up(std::move(keys[mid]));
+                keys[mid].~Key();
+                p->count = (unsigned short)mid;
+                insert_child(p->parent, p->position + 1u, std::move(up), q);
+            }
+
+            // Inserts a Slot constructed from args, whose key is k, at
+            // position i of l, or as the first element if l is null.
+            template<typename... Args>
+            position
+            insert_at(leaf * l, std::size_t i, Key const & k, Args &&... args)
+            {
+                if (!l) {
+                    l = v1_dtl::btree_new_node<leaf>();
+                    try {
+                        ::new (l->values()) Slot((Args &&) args...);
+                    } catch (...) {
+                        v1_dtl::btree_delete_node(l);
+                        throw;
+                    }
+                    l->count = 1;
+                    root_ = first_ = last_ = l;
+                    size_ = 1;
+                    return {l, 0};
+                }
+                if (l->count < leaf::capacity) {
+                    Slot * const values = l->values();
+                    v1_dtl::btree_open_gap(values + i, values + l->count);
+                    try {
+                        ::new (values + i) Slot((Args &&) args...);
+                    } catch (...) {
+                        v1_dtl::btree_close_gap(
+                            values + i, values + l->count + 1);
+                        throw;
+                    }
+                    ++l->count;
+                    ++size_;
+                    return {l, i};
+                }
+                return split_insert(l, i, k, (Args &&) args...);
+            }
+
+            // Inserts a Slot constructed from args at position i of the full
+            // leaf l, splitting it.  Everything that can throw is done
+            // before the tree is changed.
+            template<typename... Args>
+            position split_insert(
+                leaf * l, std::size_t i, Key const & k, Args &&... args)
+            {
+                bool const append = l == last_ && i == l->count;
+                std::size_t const mid = append ? l->count : l->count / 2u;
+                Slot * const values = l->values();
+                auto const r = v1_dtl::btree_new_node<leaf>();
+                try {
+                    // The first key of r, once the new element is in.
+                    Key sep(i == mid ? k : key(values[mid]));
+                    Slot s((Args &&) args...);
+                    make_room_above(l, append);
+
+                    v1_dtl::btree_relocate_n(
+                        r->values(), values + mid, l->count - mid);
+                    r->count = (unsigned short)(l->count - mid);
+                    l->count = (unsigned short)mid;
+                    r->prev = l;
+                    r->next = l->next;
+                    if (l->next)
+                        l->next->prev = r;
+                    else
+                        last_ = r;
+                    l->next = r;
+                    insert_child(
+                        l->parent, l->position + 1u, std::move(sep), r);
+
+                    leaf * const target = mid <= i ? r : l;
+                    std::size_t const j = mid <= i ? i - mid : i;
+                    Slot * const target_values = target->values();
+                    v1_dtl::btree_open_gap(
+                        target_values + j, target_values + target->count);
+                    ::new (target_values + j) Slot(std::move(s));
+                    ++target->count;
+                    ++size_;
+                    return {target, j};
+                } catch (...) {
+                    v1_dtl::btree_delete_node(r);
+                    throw;
+                }
+            }
+
+            // Refills l, which has too few elements, from a sibling, or
+            // merges it with one.  Returns the new position of the element
+            // that was at position i of l.
+            position rebalance_leaf(leaf * l, std::size_t i) noexcept
+            {
+                internal * const p = l->parent;
+                std::size_t const pos = l->position;
+                leaf * const left =
+                    pos ? static_cast<leaf *>(p->children[pos - 1]) : nullptr;
+                leaf * const right =
+                    pos < p->count ? static_cast<leaf *>(p->children[pos + 1])
+                                   : nullptr;
+                try {
+                    if (left && min_leaf < left->count) {
+                        Slot * const from = left->values() + left->count - 1;
+                        Key sep(key(*from));
+                        Slot * const values = l->values();
+                        v1_dtl::btree_open_gap(values, values + l->count);
+                        v1_dtl::btree_relocate(values, from);
+                        --left->count;
+                        ++l->count;
+                        p->keys()[pos - 1] = std::move(sep);
+                        return normalize(l, i + 1);
+                    }
+                    if (right && min_leaf < right->count) {
+                        Slot * const values = right->values();
+                        Key sep(key(values[1]));
+                        v1_dtl::btree_relocate(l->values() + l->count, values);
+                        v1_dtl::btree_close_gap(values, values + right->count);
+                        --right->count;
+                        ++l->count;
+                        p->keys()[pos] = std::move(sep);
+                        return normalize(l, i);
+                    }
+                } catch (...) {
+                    // Copying the separator threw.  A leaf with too few
+                    // elements is still a valid leaf; an empty one is
+                    // merged below, which copies nothing.
+                    if (l->count)
+                        return normalize(l, i);
+                }
+                if (left) {
+                    std::size_t const n = left->count;
+                    v1_dtl::btree_relocate_n(
+                        left->values() + n, l->values(), l->count);
+                    left->count += l->count;
+                    remove_leaf(l);
+                    return normalize(left, n + i);
+                }
+                v1_dtl::btree_relocate_n(
+                    l->values() + l->count, right->values(), right->count);
+                l->count += right->count;
+                remove_leaf(right);
+                return normalize(l, i);
+            }
+
+            void remove_leaf(leaf * l) noexcept
+            {
+                if (l->prev)
+                    l->prev->next = l->next;
+                else
+                    first_ = l->next;
+                if (l->next)
+                    l->next->prev = l->prev;
+                else
+                    last_ = l->prev;
+                internal * const p = l->parent;
+                std::size_t const pos = l->position;
+                v1_dtl::btree_delete_node(l);
+                remove_child(p, pos);
+            }
+
+            // Removes children[j], and keys[j - 1], from p.
+            void remove_child(internal * p, std::size_t j) noexcept
+            {
+                Key * const keys = p->keys();
+                keys[j - 1].~Key();
+                v1_dtl::btree_close_gap(keys + j - 1, keys + p->count);
+                for (std::size_t m = j; m < p->count; ++m) {
+                    set_child(p, m, p->children[m + 1]);
+                }
+                --p->count;
+                if (p == root_) {
+                    if (!p->count) {
+                        root_ = p->children[0];
+                        root_->parent = nullptr;
+                        root_->position = 0;
+                        v1_dtl::btree_delete_node(p);
+                    }
+                    return;
+                }
+                if (p->count < min_internal)
+                    rebalance_internal(p);
+            }
+
+            void rebalance_internal(internal * p) noexcept
+            {
+                internal * const g = p->parent;
+                std::size_t const pos = p->position;
+                internal * const left =
+                    pos ? static_cast<internal *>(g->children[pos - 1])
+                        : nullptr;
+                internal * const right =
+                    pos < g->count
+                        ? static_cast<internal *>(g->children[pos + 1])
+                        : nullptr;
+                Key * const keys = p->keys();
+                if (left && min_internal < left->count) {
+                    // g's separator comes down to p, and left's last key
+                    // goes up in its place.
+                    v1_dtl::btree_open_gap(keys, keys + p->count);
+                    v1_dtl::btree_relocate(keys, g->keys() + pos - 1);
+                    v1_dtl::btree_relocate(
+                        g->keys() + pos - 1, left->keys() + left->count - 1);
+                    for (std::size_t m = p->count + 1u; m; --m) {
+                        set_child(p, m, p->children[m - 1]);
+                    }
+                    set_child(p, 0, left->children[left->count]);
+                    --left->count;
+                    ++p->count;
+                    return;
+                }
+                if (right && min_internal < right->count) {
+                    v1_dtl::btree_relocate(keys + p->count, g->keys() + pos);
+                    v1_dtl::btree_relocate(g->keys() + pos, right->keys());
+                    v1_dtl::btree_close_gap(
+                        right->keys(), right->keys() + right->count);
+                    set_child(p, p->count + 1u, right->children[0]);
+                    for (std::size_t m = 0; m < right->count; ++m) {
+                        set_child(right, m, right->children[m + 1]);
+                    }
+                    --right->count;
+                    ++p->count;
+                    return;
+                }
+                if (left)
+                    merge_internal(left, p);
+                else
+                    merge_internal(p, right);
+            }
+
+            // Appends g's separator between a and b, and b's keys and
+            // children, to a, and removes b.
+            void merge_internal(internal * a, internal * b) noexcept
+            {
+                internal * const g = a->parent;
+                std::size_t const j = b->position;
+                Key * const keys = a->keys();
+                ::new (keys + a->count) Key(std::move(g->keys()[j - 1]));
+                v1_dtl::btree_relocate_n(
+                    keys + a->count + 1, b->keys(), b->count);
+                for (std::size_t m = 0; m <= b->count; ++m) {
+                    set_child(a, a->count + 1u + m, b->children[m]);
+                }
+                a->count += b->count + 1;
+                b->count = 0;
+                v1_dtl::btree_delete_node(b);
+                remove_child(g, j);
+            }
+
+            void destroy(node * n) noexcept
+            {
+                if (n->leaf) {
+                    auto const l = static_cast<leaf *>(n);
+                    for (std::size_t i = 0; i < l->count; ++i) {
+                        l->values()[i].~Slot();
+                    }
+                    v1_dtl::btree_delete_node(l);
+                    return;
+                }
+                auto const in = static_cast<internal *>(n);
+                for (std::size_t i = 0; i <= in->count; ++i) {
+                    destroy(in->children[i]);
+                }
+                for (std::size_t i = 0; i < in->count; ++i) {
+                    in->keys()[i].~Key();
+                }
+                v1_dtl::btree_delete_node(in);
+            }
+
+            node * root_ = nullptr;
+            leaf * first_ = nullptr;
+            leaf * last_ = nullptr;
+            std::size_t size_ = 0;
+            Compare comp_;
+        };
+
+        template<typename Key, typename T>
+        struct btree_map_key
+        {
+            Key const & operator()(std::pair<Key, T> const & s) const noexcept
+            {
+                return s.first;
+            }
+        };
+        struct btree_set_key
+        {
+            template<typename Key>
+            Key const & operator()(Key const & k) const noexcept
+            {
+                return k;
+            }
+        };
+    }
+
+#endif
+
+    /** The bidirectional iterator of `btree_map` and `btree_set`: a leaf
+        and an index into it.  Incrementing it within a leaf increments the
+        index, and moving off of a leaf follows the link to the next or
+        previous one, without touching the rest of the tree.
+
+        It models the segmented iterator protocol, with the leaves as the
+        segments and pointers as the local iterators, so the `segmented_*()`
+        algorithms run over each leaf's elements with pointers. */
+    template<typename Leaf, typename T>
+    struct btree_iterator : iterator_interface<
+                                btree_iterator<Leaf, T>,
+                                std::bidirectional_iterator_tag,
+                                std::remove_const_t<T>,
+                                T &,
+                                T *>
+    {
+        btree_iterator() noexcept = default;
+        btree_iterator(Leaf * leaf, std::size_t i) noexcept :
+            leaf_(leaf), i_(i)
+        {}
+        template<
+            typename U,
+            typename E = std::enable_if_t<
+                std::is_same<T, U const>::value &&
+                !std::is_same<T, U>::value>>
+        btree_iterator(btree_iterator<Leaf, U> other) noexcept :
+            leaf_(other.leaf_), i_(other.i_)
+        {}
+
+        T & operator*() const noexcept
+        {
+            return *slot_to_value(leaf_->values() + i_);
+        }
+        btree_iterator & operator++() noexcept
+        {
+            if (++i_ == leaf_->count && leaf_->next) {
+                leaf_ = leaf_->next;
+                i_ = 0;
+            }
+            return *this;
+        }
+        btree_iterator & operator--() noexcept
+        {
+            if (!i_) {
+                leaf_ = leaf_->prev;
+                i_ = leaf_->count;
+            }
+            --i_;
+            return *this;
+        }
+        friend bool
+        operator==(btree_iterator lhs, btree_iterator rhs) noexcept
+        {
+            return lhs.leaf_ == rhs.leaf_ && lhs.i_ == rhs.i_;
+        }
+
+        using base_type = iterator_interface<
+            btree_iterator<Leaf, T>,
+            std::bidirectional_iterator_tag,
+            std::remove_const_t<T>,
+            T &,
+            T *>;
+        using base_type::operator++;
+        using base_type::operator--;
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+    private:
+        template<typename Leaf2, typename U>
+        friend struct btree_iterator;
+        template<typename Key, typename U, typename Compare>
+        friend struct btree_map;
+        template<typename Key, typename Compare>
+        friend struct btree_set;
+        friend access;
+
+        using segment_iterator = v1_dtl::btree_segment<Leaf>;
+
+        // The slots of a btree_map are pair<Key, T>s, which are presented
+        // as the value_type pair<Key const, T>, so that the tree can move
+        // them; as in several standard library implementations of
+        // std::map, the two are layout-compatible.
+        static T * slot_to_value(
+            decltype(std::declval<Leaf &>().values()) slot) noexcept
+        {
+            return reinterpret_cast<T *>(slot);
+        }
+
+        T * local() const noexcept
+        {
+            return leaf_ ? slot_to_value(leaf_->values() + i_) : nullptr;
+        }
+        segment_iterator segment() const noexcept
+        {
+            return segment_iterator{leaf_};
+        }
+        T * local_begin(segment_iterator seg) const noexcept
+        {
+            return seg.leaf ? slot_to_value(seg.leaf->values()) : nullptr;
+        }
+        T * local_end(segment_iterator seg) const noexcept
+        {
+            return seg.leaf ? local_begin(seg) + seg.leaf->count : nullptr;
+        }
+        btree_iterator compose(segment_iterator seg, T * it) const noexcept
+        {
+            std::size_t const i = std::size_t(it - local_begin(seg));
+            if (i == seg.leaf->count && seg.leaf->next)
+                return btree_iterator(seg.leaf->next, 0);
+            return btree_iterator(seg.leaf, i);
+        }
+
+        Leaf * leaf_ = nullptr;
+        std::size_t i_ = 0;
+#endif
+    };
+
+    /** An ordered map with unique keys, like `std::map`, stored in a
+        B+-tree: the elements are held sorted and contiguous in leaves of
+        256 bytes -- four cache lines -- or of four elements, if they are
+        larger; the leaves are linked, and indexed by a tree of internal
+        nodes of the same size, each with copies of up to several dozen
+        keys.  A lookup reads one node per level of a shallow tree, and
+        searches each with a binary search, instead of following a
+        pointer per comparison down a red-black tree; and the elements
+        take little more memory than in a vector, instead of a node of
+        their own each, with three pointers and a color.  Inserting keys in
+        increasing order -- as sequence numbers and order ids are -- fills
+        each leaf completely.  Where the standard library supports aligned
+        `operator new`, nodes are aligned to cache lines.
+
+        Unlike `std::map`, inserting or erasing an element moves other
+        elements of its leaf, and possibly of a neighboring one, so it
+        invalidates all iterators, pointers and references into the map.
+        `key_type` and `mapped_type` must be nothrow move constructible,
+        and `key_type` nothrow move assignable; the internal nodes hold
+        copies of keys.  If an insertion throws, the map is unchanged.
+
+        The members that `std::map` has in terms of iterators -- `front()`,
+        `back()`, reverse iteration, comparisons -- come from
+        `container_interface`.
+
+        \see `btree_set`, `btree_iterator` */
+    template<typename Key, typename T, typename Compare = std::less<Key>>
+    struct btree_map
+        : container_interface<btree_map<Key, T, Compare>, discontiguous>
+    {
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+    private:
+        using slot_type = std::pair<Key, T>;
+        using tree_type = v1_dtl::
+            btree<Key, slot_type, v1_dtl::btree_map_key<Key, T>, Compare>;
+        using leaf = typename tree_type::leaf;
+#endif
+
+    public:
+        using key_type = Key;
+        using mapped_type = T;
+        using value_type = std::pair<Key const, T>;
+        using key_compare = Compare;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using reference = value_type &;
+        using const_reference = value_type const &;
+        using pointer = value_type *;
+        using const_pointer = value_type const *;
+        using iterator = btree_iterator<leaf, value_type>;
+        using const_iterator = btree_iterator<leaf, value_type const>;
+        using reverse_iterator = stl_interfaces::reverse_iterator<iterator>;
+        using const_reverse_iterator =
+            stl_interfaces::reverse_iterator<const_iterator>;
+
+        btree_map() = default;
+        explicit btree_map(Compare const & comp) : tree_(comp) {}
+        template<
+            typename InputIterator,
+            typename Enable = std::enable_if_t<std::is_convertible<
+                typename std::iterator_traits<
+                    InputIterator>::iterator_category,
+                std::input_iterator_tag>::value>>
+        btree_map(
+            InputIterator first,
+            InputIterator last,
+            Compare const & comp = Compare()) :
+            tree_(comp)
+        {
+            insert(first, last);
+        }
+        btree_map(
+            std::initializer_list<value_type> il,
+            Compare const & comp = Compare()) :
+            btree_map(il.begin(), il.end(), comp)
+        {}
+
+        iterator begin() noexcept { return make_iter(tree_.begin()); }
+        iterator end() noexcept { return make_iter(tree_.end()); }
+        const_iterator begin() const noexcept
+        {
+            return make_iter(tree_.begin());
+        }
+        const_iterator end() const noexcept { return make_iter(tree_.end()); }
+
+        size_type size() const noexcept { return tree_.size(); }
+        bool empty() const noexcept { return !tree_.size(); }
+        size_type max_size() const noexcept
+        {
+            return size_type((std::numeric_limits<difference_type>::max)()) /
+                   sizeof(slot_type);
+        }
+        key_compare key_comp() const { return tree_.comp(); }
+
+        iterator find(Key const & k) { return make_iter(tree_.find(k)); }
+        const_iterator find(Key const & k) const
+        {
+            return make_iter(tree_.find(k));
+        }
+        size_type count(Key const & k) const { return contains(k); }
+        bool contains(Key const & k) const
+        {
+            return find(k) != end();
+        }
+        iterator lower_bound(Key const & k)
+        {
+            return make_iter(tree_.lower_bound(k));
+        }
+        const_iterator lower_bound(Key const & k) const
+        {
+            return make_iter(tree_.lower_bound(k));
+        }
+        iterator upper_bound(Key const & k)
+        {
+            return make_iter(tree_.upper_bound(k));
+        }
+        const_iterator upper_bound(Key const & k) const
+        {
+            return make_iter(tree_.upper_bound(k));
+        }
+        std::pair<iterator, iterator> equal_range(Key const & k)
+        {
+            return {lower_bound(k), upper_bound(k)};
+        }
+        std::pair<const_iterator, const_iterator>
+        equal_range(Key const & k) const
+        {
+            return {lower_bound(k), upper_bound(k)};
+        }
+
+        T & at(Key const & k)
+        {
+            auto const it = find(k);
+            if (it == end())
+                throw std::out_of_range("btree_map::at");
+            return it->second;
+        }
+        T const & at(Key const & k) const
+        {
+            auto const it = find(k);
+            if (it == end())
+                throw std::out_of_range("btree_map::at");
+            return it->second;
+        }
+        T & operator[](Key const & k) { return try_emplace(k).first->second; }
+        T & operator[](Key && k)
+        {
+            return try_emplace(std::move(k)).first->second;
+        }
+
+        std::pair<iterator, bool> insert(value_type const & x)
+        {
+            return wrap(tree_.emplace_key(x.first, x.first, x.second));
+        }
+        std::pair<iterator, bool> insert(value_type && x)
+        {
+            return wrap(
+                tree_.emplace_key(x.first, x.first, std::move(x.second)));
+        }
+        /** Inserts `x`.  If `hint` is `end()`, and `x`'s key is greater than
+            every key in the map, `x` is appended without a search. */
+        iterator insert(const_iterator hint, value_type const & x)
+        {
+            if (hint == end()) {
+                return wrap(tree_.emplace_key_hint_end(
+                                x.first, x.first, x.second))
+                    .first;
+            }
+            return insert(x).first;
+        }
+        template<
+            typename InputIterator,
+            typename Enable = std::enable_if_t<std::is_convertible<
+                typename std::iterator_traits<
+                    InputIterator>::iterator_category,
+                std::input_iterator_tag>::value>>
+        void insert(InputIterator first, InputIterator last)
+        {
+            for (; first != last; ++first) {
+                value_type const & x = *first;
+                tree_.emplace_key_hint_end(x.first, x.first, x.second);
+            }
+        }
+        void insert(std::initializer_list<value_type> il)
+        {
+            insert(il.begin(), il.end());
+        }
+        template<typename... Args>
+        std::pair<iterator, bool> emplace(Args &&... args)
+        {
+            slot_type s((Args &&) args...);
+            return wrap(tree_.emplace_key(s.first, std::move(s)));
+        }
+        template<typename... Args>
+        std::pair<iterator, bool> try_emplace(Key const & k, Args &&... args)
+        {
+            return wrap(tree_.emplace_key(
+                k,
+                std::piecewise_construct,
+                std::forward_as_tuple(k),
+                std::forward_as_tuple((Args &&) args...)));
+        }
+        template<typename... Args>
+        std::pair<iterator, bool> try_emplace(Key && k, Args &&... args)
+        {
+            return wrap(tree_.emplace_key(
+                k,
+                std::piecewise_construct,
+                std::forward_as_tuple(std::move(k)),
+                std::forward_as_tuple((Args &&) args...)));
+        }
+        template<typename M>
+        std::pair<iterator, bool> insert_or_assign(Key const & k, M && obj)
+        {
+            auto retval = try_emplace(k, (M &&) obj);
+            if (!retval.second)
+                retval.first->second = (M &&) obj;
+            return retval;
+        }
+
+        /** Erases the element at `pos`, and returns an iterator to the
+            element after it.  Invalidates all other iterators. */
+        iterator erase(const_iterator pos) noexcept
+        {
+            return make_iter(tree_.erase({pos.leaf_, pos.i_}));
+        }
+        iterator erase(const_iterator first, const_iterator last) noexcept
+        {
+            auto n = std::distance(first, last);
+            auto it = make_iter({first.leaf_, first.i_});
+            for (; n; --n) {
+                it = erase(it);
+            }
+            return it;
+        }
+        size_type erase(Key const & k)
+        {
+            auto const it = find(k);
+            if (it == end())
+                return 0;
+            erase(it);
+            return 1;
+        }
+        void clear() noexcept { tree_.clear(); }
+
+        void swap(btree_map & other) noexcept { tree_.swap(other.tree_); }
+
+        /** Swaps `lhs` and `rhs`. */
+        friend void swap(btree_map & lhs, btree_map & rhs) noexcept
+        {
+            lhs.swap(rhs);
+        }
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+    private:
+        using position = typename tree_type::position;
+
+        static iterator make_iter(position pos) noexcept
+        {
+            return iterator(pos.l, pos.i);
+        }
+        std::pair<iterator, bool> wrap(std::pair<position, bool> p) noexcept
+        {
+            return {make_iter(p.first), p.second};
+        }
+
+        tree_type tree_;
+#endif
+    };
+
+    /** An ordered set with unique keys, like `std::set`, stored in a
+        B+-tree, as `btree_map` is.  Its iterators, like `std::set`'s,
+        give `const` access to the elements.  `Key` must be nothrow move
+        constructible and nothrow move assignable.
+
+        \see `btree_map` */
+    template<typename Key, typename Compare = std::less<Key>>
+    struct btree_set
+        : container_interface<btree_set<Key, Compare>, discontiguous>
+    {
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+    private:
+        using tree_type =
+            v1_dtl::btree<Key, Key, v1_dtl::btree_set_key, Compare>;
+        using leaf = typename tree_type::leaf;
+#endif
+
+    public:
+        using key_type = Key;
+        using value_type = Key;
+        using key_compare = Compare;
+        using value_compare = Compare;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using reference = value_type &;
+        using const_reference = value_type const &;
+        using pointer = value_type *;
+        using const_pointer = value_type const *;
+        using iterator = btree_iterator<leaf, Key const>;
+        using const_iterator = iterator;
+        using reverse_iterator = stl_interfaces::reverse_iterator<iterator>;
+        using const_reverse_iterator = reverse_iterator;
+
+        btree_set() = default;
+        explicit btree_set(Compare const & comp) : tree_(comp) {}
+        template<
+            typename InputIterator,
+            typename Enable = std::enable_if_t<std::is_convertible<
+                typename std::iterator_traits<
+                    InputIterator>::iterator_category,
+                std::input_iterator_tag>::value>>
+        btree_set(
+            InputIterator first,
+            InputIterator last,
+            Compare const & comp = Compare()) :
+            tree_(comp)
+        {
+            insert(first, last);
+        }
+        btree_set(
+            std::initializer_list<Key> il, Compare const & comp = Compare()) :
+            btree_set(il.begin(), il.end(), comp)
+        {}
+
+        iterator begin() const noexcept { return make_iter(tree_.begin()); }
+        iterator end() const noexcept { return make_iter(tree_.end()); }
+
+        size_type size() const noexcept { return tree_.size(); }
+        bool empty() const noexcept { return !tree_.size(); }
+        size_type max_size() const noexcept
+        {
+            return size_type((std::numeric_limits<difference_type>::max)()) /
+                   sizeof(Key);
+        }
+        key_compare key_comp() const { return tree_.comp(); }
+        value_compare value_comp() const { return tree_.comp(); }
+
+        iterator find(Key const & k) const
+        {
+            return make_iter(tree_.find(k));
+        }
+        size_type count(Key const & k) const { return contains(k); }
+        bool contains(Key const & k) const { return find(k) != end(); }
+        iterator lower_bound(Key const & k) const
+        {
+            return make_iter(tree_.lower_bound(k));
+        }
+        iterator upper_bound(Key const & k) const
+        {
+            return make_iter(tree_.upper_bound(k));
+        }
+        std::pair<iterator, iterator> equal_range(Key const & k) const
+        {
+            return {lower_bound(k), upper_bound(k)};
+        }
+
+        std::pair<iterator, bool> insert(Key const & x)
+        {
+            return wrap(tree_.emplace_key(x, x));
+        }
+        std::pair<iterator, bool> insert(Key && x)
+        {
+            return wrap(tree_.emplace_key(x, std::move(x)));
+        }
+        /** Inserts `x`.  If `hint` is `end()`, and `x` is greater than every
+            element of the set, `x` is appended without a search. */
+        iterator insert(const_iterator hint, Key const & x)
+        {
+            if (hint == end())
+                return wrap(tree_.emplace_key_hint_end(x, x)).first;
+            return insert(x).first;
+        }
+        template<
+            typename InputIterator,
+            typename Enable = std::enable_if_t<std::is_convertible<
+                typename std::iterator_traits<
+                    InputIterator>::iterator_category,
+                std::input_iterator_tag>::value>>
+        void insert(InputIterator first, InputIterator last)
+        {
+            for (; first != last; ++first) {
+                Key const & x = *first;
+                tree_.emplace_key_hint_end(x, x);
+            }
+        }
+        void insert(std::initializer_list<Key> il)
+        {
+            insert(il.begin(), il.end());
+        }
+        template<typename... Args>
+        std::pair<iterator, bool> emplace(Args &&... args)
+        {
+            Key k((Args &&) args...);
+            return wrap(tree_.emplace_key(k, std::move(k)));
+        }
+
+        /** Erases the element at `pos`, and returns an iterator to the
+            element after it.  Invalidates all other iterators. */
+        iterator erase(const_iterator pos) noexcept
+        {
+            return make_iter(tree_.erase({pos.leaf_, pos.i_}));
+        }
+        iterator erase(const_iterator first, const_iterator last) noexcept
+        {
+            auto n = std::distance(first, last);
+            for (; n; --n) {
+                first = erase(first);
+            }
+            return first;
+        }
+        size_type erase(Key const & k)
+        {
+            auto const it = find(k);
+            if (it == end())
+                return 0;
+            erase(it);
+            return 1;
+        }
+        void clear() noexcept { tree_.clear(); }
+
+        void swap(btree_set & other) noexcept { tree_.swap(other.tree_); }
+
+        /** Swaps `lhs` and `rhs`. */
+        friend void swap(btree_set & lhs, btree_set & rhs) noexcept
+        {
+            lhs.swap(rhs);
+        }
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+    private:
+        using position = typename tree_type::position;
+
+        static iterator make_iter(position pos) noexcept
+        {
+            return iterator(pos.l, pos.i);
+        }
+        std::pair<iterator, bool> wrap(std::pair<position, bool> p) noexcept
+        {
+            return {make_iter(p.first), p.second};
+        }
+
+        tree_type tree_;
+#endif
+    };
+
+}}}
+
+#endif
@@ -0,0 +1,309 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_BUFFER_RING_HPP
+#define BOOST_STL_INTERFACES_BUFFER_RING_HPP
+
+#include <boost/stl_interfaces/byte_view.hpp>
+#include <boost/stl_interfaces/iterator_interface.hpp>
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+    template<typename Sink>
+    struct buffer_ring;
+
+    /** An output iterator that writes bytes into the buffers of a
+        `buffer_ring`.  Writing a `char` or `unsigned char` to it appends
+        the byte to the ring's current buffer.  \see `buffer_ring` */
+    template<typename Sink>
+    struct buffer_ring_iterator : iterator_interface<
+                                      buffer_ring_iterator<Sink>,
+                                      std::output_iterator_tag,
+                                      unsigned char,
+                                      buffer_ring_iterator<Sink> &>
+    {
+        constexpr buffer_ring_iterator() noexcept : ring_(nullptr) {}
+        constexpr explicit buffer_ring_iterator(
+            buffer_ring<Sink> & ring) noexcept :
+            ring_(std::addressof(ring))
+        {}
+
+        buffer_ring_iterator & operator=(unsigned char b)
+        {
+            ring_->put(b);
+            return *this;
+        }
+
+        constexpr buffer_ring_iterator & operator*() noexcept { return *this; }
+        constexpr buffer_ring_iterator & operator++() noexcept { return *this; }
+
+        /** Returns the ring written to. */
+        constexpr buffer_ring<Sink> & ring() const noexcept { return *ring_; }
+
+        using base_type = iterator_interface<
+            buffer_ring_iterator<Sink>,
+            std::output_iterator_tag,
+            unsigned char,
+            buffer_ring_iterator<Sink> &>;
+        using base_type::operator++;
+
+    private:
+        buffer_ring<Sink> * ring_;
+    };
+
+    /** A fixed set of equal-size byte buffers that are filled in turn and
+        handed to `Sink` to write, as the registered buffers of an io_uring
+        are, so that serialized data can go from an output iterator to the
+        I/O layer with no allocation along the way.
+
+        `begin()` returns a `buffer_ring_iterator`, which `std::copy()`,
+        `std::transform()` and the like can write bytes to.  When the
+        current buffer is full, it is submitted to the sink, and writing
+        goes on in a free buffer.  Submissions are committed to the sink
+        `batch` at a time, so that a batch costs one system call.  At most
+        `buffer_count()` buffers are in flight; when all of them are, the
+        next write waits for the sink to finish one -- the ring's back
+        pressure.
+
+        `Sink` does the I/O, and may be asynchronous.  For a `Sink` `s`, a
+        buffer index `i`, and `bytes`, a `pointer_view<unsigned char
+        const>` of the filled part of buffer `i`:
+
+        - `s.submit(i, bytes)` prepares a write of `bytes` (an io_uring
+          `io_uring_prep_write_fixed()` with buffer index `i`, say);
+        - `s.commit()` starts the writes prepared since the last commit
+          (`io_uring_submit()`); and
+        - `s.wait()` blocks until a committed write is done, and returns
+          the index of its buffer, which is then free to fill again.
+
+        `data()` is the memory of all the buffers, one after another, each
+        aligned to `alignment`, to be registered with the I/O layer, if it
+        has a notion of registered buffers.  The destructor calls
+        `drain()`, since the sink may still be reading the buffers. */
+    template<typename Sink>
+    struct buffer_ring
+    {
+        using size_type = std::size_t;
+        using iterator = buffer_ring_iterator<Sink>;
+
+        /** The alignment of each buffer, the page size of most systems, as
+            `O_DIRECT` writes require. */
+        static constexpr size_type alignment = 4096;
+
+        /** Makes a ring of `buffers` buffers of `buffer_size` bytes each,
+            written by `sink`, which must outlive the ring.
+
+            \pre `0 < buffers && 0 < buffer_size && 0 < batch` */
+        buffer_ring(
+            Sink & sink,
+            size_type buffers,
+            size_type buffer_size,
+            size_type batch = 1) :
+            sink_(sink),
+            count_(buffers),
+            buffer_size_(buffer_size),
+            stride_(
+                (buffer_size + alignment - 1) / alignment * alignment),
+            batch_(batch)
+        {
+            BOOST_ASSERT(0 < buffers && 0 < buffer_size && 0 < batch);
+            storage_.reset(new unsigned char[stride_ * count_ + alignment]);
+            auto const address = reinterpret_cast<std::uintptr_t>(
+                storage_.get());
+            data_ = storage_.get() +
+                    (alignment - address % alignment) % alignment;
+            free_.reserve(count_);
+            for (size_type i = count_; i--;) {
+                free_.push_back(i);
+            }
+        }
+        buffer_ring(buffer_ring const &) = delete;
+        buffer_ring & operator=(buffer_ring const &) = delete;
+        ~buffer_ring() { drain(); }
+
+        /** Returns an output iterator that appends to the ring. */
+        iterator begin() noexcept { return iterator(*this); }
+
+        /** Appends `b`. */
+        void put(unsigned char b)
+        {
+            if (cur_ == end_)
+                next_buffer();
+            *cur_++ = b;
+        }
+
+        /** Appends the `n` bytes at `p`. */
+        void write(void const * p, size_type n)
+        {
+            auto bytes = static_cast<unsigned char const *>(p);
+            while (n) {
+                if (cur_ == end_)
+                    next_buffer();
+                auto const chunk = (std::min)(n, size_type(end_ - cur_));
+                std::memcpy(cur_, bytes, chunk);
+                cur_ += chunk;
+                bytes += chunk;
+                n -= chunk;
+            }
+        }
+
+        /** Submits the current buffer, if anything has been written to it,
+            and commits all the submissions not yet committed. */
+        void flush()
+        {
+            if (current_ != npos && cur_ != buffer(current_))
+                submit_current();
+            if (uncommitted_)
+                commit();
+        }
+
+        /** Flushes, then waits until the sink is done with every buffer. */
+        void drain()
+        {
+            flush();
+            while (in_flight_) {
+                reclaim();
+            }
+        }
+
+        /** Returns the number of buffers submitted and not yet done. */
+        size_type in_flight() const noexcept { return in_flight_; }
+        /** Returns the number of buffers. */
+        size_type buffer_count() const noexcept { return count_; }
+        /** Returns the size of each buffer. */
+        size_type buffer_size() const noexcept { return buffer_size_; }
+        /** Returns the number of bytes from the start of one buffer to the
+            start of the next, `buffer_size()` rounded up to `alignment`. */
+        size_type buffer_stride() const noexcept { return stride_; }
+        /** Returns the memory of the buffers, `buffer_count() *
+            buffer_stride()` bytes. */
+        unsigned char * data() noexcept { return data_; }
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+    private:
+        static constexpr size_type npos = size_type(-1);
+
+        unsigned char * buffer(size_type i) noexcept
+        {
+            return data_ + i * stride_;
+        }
+
+        void next_buffer()
+        {
+            if (current_ != npos)
+                submit_current();
+            if (free_.empty()) {
+                // The sink only finishes what has been committed.
+                if (uncommitted_)
+                    commit();
+                reclaim();
+            }
+            current_ = free_.back();
+            free_.pop_back();
+            cur_ = buffer(current_);
+            end_ = cur_ + buffer_size_;
+        }
+
+        void submit_current()
+        {
+            unsigned char const * const first = buffer(current_);
+            sink_.submit(
+                current_, pointer_view<unsigned char const>(first, cur_));
+            ++in_flight_;
+            current_ = npos;
+            cur_ = end_ = nullptr;
+            if (++uncommitted_ == batch_)
+                commit();
+        }
+
+        void commit()
+        {
+            sink_.commit();
+            uncommitted_ = 0;
+        }
+
+        void reclaim()
+        {
+            BOOST_ASSERT(in_flight_ && !uncommitted_);
+            size_type const i = sink_.wait();
+            BOOST_ASSERT(i < count_);
+            free_.push_back(i);
+            --in_flight_;
+        }
+
+        Sink & sink_;
+        size_type count_;
+        size_type buffer_size_;
+        size_type stride_;
+        size_type batch_;
+        std::unique_ptr<unsigned char[]> storage_;
+        unsigned char * data_ = nullptr;
+        std::vector<size_type> free_;
+        size_type current_ = npos;
+        unsigned char * cur_ = nullptr;
+        unsigned char * end_ = nullptr;
+        size_type in_flight_ = 0;
+        size_type uncommitted_ = 0;
+#endif
+    };
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    namespace v1_dtl {
+        template<typename Iter, typename Sink>
+        void buffer_ring_copy(
+            Iter first, Iter last, buffer_ring<Sink> & ring, std::true_type)
+        {
+            if (first != last)
+                ring.write(stl_interfaces::to_address(first), last - first);
+        }
+        template<typename Iter, typename Sink>
+        void buffer_ring_copy(
+            Iter first, Iter last, buffer_ring<Sink> & ring, std::false_type)
+        {
+            for (; first != last; ++first) {
+                ring.put(*first);
+            }
+        }
+    }
+
+#endif
+
+    /** Writes the bytes `[first, last)` to the ring of `out`, like
+        `std::copy(first, last, out)`, and returns `out`.  If `Iter` is
+        contiguous, the bytes are copied a buffer's worth at a time, rather
+        than one at a time.  Call it unqualified in code that also has
+        `using std::copy;`, and overload resolution picks this `copy()` for
+        `buffer_ring_iterator`s. */
+    template<typename Iter, typename Sink>
+    buffer_ring_iterator<Sink>
+    copy(Iter first, Iter last, buffer_ring_iterator<Sink> out)
+    {
+        v1_dtl::buffer_ring_copy(
+            first,
+            last,
+            out.ring(),
+            std::integral_constant<
+                bool,
+                is_contiguous_iterator<Iter>::value &&
+                    sizeof(typename std::iterator_traits<Iter>::value_type) ==
+                        1>{});
+        return out;
+    }
+
+}}}
+
+#endif
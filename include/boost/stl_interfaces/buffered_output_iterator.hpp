@@ -0,0 +1,215 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_BUFFERED_OUTPUT_ITERATOR_HPP
+#define BOOST_STL_INTERFACES_BUFFERED_OUTPUT_ITERATOR_HPP
+
+#include <boost/stl_interfaces/iterator_interface.hpp>
+
+#include <memory>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <cerrno>
+#include <cstddef>
+
+#include <unistd.h>
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+    template<typename Buffer>
+    struct buffered_output_iterator;
+
+    //[ output_buffer_defn
+    // A buffer of up to N Ts, in the buffer object itself, that passes its
+    // contents to sink(first, last) all at once when it is full, when flush()
+    // is called, and when it is destroyed.  Writing an element through one of
+    // its iterators is a store and a compare; only one write in N calls the
+    // sink.
+    //
+    // The iterators refer to the buffer, rather than holding a copy of it,
+    // since algorithms pass output iterators by value, and return copies of
+    // them; so the buffer can be neither copied nor moved.  Destroying the
+    // buffer flushes it, but ignores any exception from the sink, like a
+    // std::ofstream does.  Call flush() first to see the errors.  The elements
+    // passed to a sink that throws are dropped from the buffer either way.
+    template<typename T, typename Sink, std::size_t N = 1024>
+    struct output_buffer
+    {
+        static_assert(0 < N, "");
+
+        using value_type = T;
+        using iterator = buffered_output_iterator<output_buffer>;
+
+        explicit output_buffer(Sink sink) : sink_(std::move(sink)), size_(0) {}
+        output_buffer(output_buffer const &) = delete;
+        output_buffer & operator=(output_buffer const &) = delete;
+        ~output_buffer()
+        {
+            try {
+                flush();
+            } catch (...) {
+            }
+        }
+
+        void push(T const & x)
+        {
+            elements_[size_] = x;
+            if (++size_ == N)
+                flush();
+        }
+        void push(T && x)
+        {
+            elements_[size_] = std::move(x);
+            if (++size_ == N)
+                flush();
+        }
+        void flush()
+        {
+            if (!size_)
+                return;
+            auto const n = std::exchange(size_, 0);
+            sink_(elements_, elements_ + n);
+        }
+
+        iterator out() noexcept { return iterator(*this); }
+        // The number of elements waiting for the next flush().
+        std::size_t size() const noexcept { return size_; }
+        Sink & sink() noexcept { return sink_; }
+
+    private:
+        Sink sink_;
+        T elements_[N];
+        std::size_t size_;
+    };
+    //]
+
+    //[ buffered_output_iterator
+    // The back_insert_iterator example, writing into an output_buffer instead
+    // of a container.
+    template<typename Buffer>
+    struct buffered_output_iterator : iterator_interface<
+                                          buffered_output_iterator<Buffer>,
+                                          std::output_iterator_tag,
+                                          typename Buffer::value_type,
+                                          buffered_output_iterator<Buffer> &>
+    {
+        using value_type = typename Buffer::value_type;
+
+        buffered_output_iterator() noexcept : buffer_(nullptr) {}
+        explicit buffered_output_iterator(Buffer & buffer) noexcept :
+            buffer_(std::addressof(buffer))
+        {}
+
+        buffered_output_iterator & operator=(value_type const & x)
+        {
+            buffer_->push(x);
+            return *this;
+        }
+        buffered_output_iterator & operator=(value_type && x)
+        {
+            buffer_->push(std::move(x));
+            return *this;
+        }
+
+        buffered_output_iterator & operator*() noexcept { return *this; }
+        buffered_output_iterator & operator++() noexcept { return *this; }
+
+        using base_type = iterator_interface<
+            buffered_output_iterator<Buffer>,
+            std::output_iterator_tag,
+            typename Buffer::value_type,
+            buffered_output_iterator<Buffer> &>;
+        using base_type::operator++;
+
+    private:
+        Buffer * buffer_;
+    };
+    //]
+
+    //[ output_buffer_sinks
+    // A sink that appends to a container, with c.append_range() if it has one
+    // (as do the containers derived from container_interface), and otherwise
+    // with c.insert(c.end(), first, last).
+    template<typename Container>
+    struct container_sink
+    {
+        container_sink(Container & c) noexcept : c_(std::addressof(c)) {}
+
+        template<typename T>
+        void operator()(T * first, T * last)
+        {
+            append(*c_, first, last, 0);
+        }
+
+    private:
+        template<typename T>
+        struct range
+        {
+            T * begin() const noexcept { return first_; }
+            T * end() const noexcept { return last_; }
+            T * first_;
+            T * last_;
+        };
+
+        template<typename C, typename T>
+        static auto append(C & c, T * first, T * last, int)
+            -> decltype(c.append_range(std::declval<range<T> &>()), void())
+        {
+            range<T> r{first, last};
+            c.append_range(r);
+        }
+        template<typename C, typename T>
+        static void append(C & c, T * first, T * last, long)
+        {
+            c.insert(c.end(), first, last);
+        }
+
+        Container * c_;
+    };
+
+    // A sink that writes the bytes of the elements to a file descriptor, with
+    // as few write() calls as the descriptor allows.  Errors are thrown as
+    // std::system_error.
+    struct fd_sink
+    {
+        fd_sink(int fd) noexcept : fd_(fd) {}
+
+        template<typename T>
+        void operator()(T const * first, T const * last)
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "");
+            auto p = reinterpret_cast<char const *>(first);
+            auto const end = reinterpret_cast<char const *>(last);
+            while (p != end) {
+                auto const n = ::write(fd_, p, std::size_t(end - p));
+                if (n < 0) {
+                    if (errno == EINTR)
+                        continue;
+                    throw std::system_error(
+                        errno, std::generic_category(), "write");
+                }
+                p += n;
+            }
+        }
+
+    private:
+        int fd_;
+    };
+
+    template<typename Container, std::size_t N = 1024>
+    using container_output_buffer = output_buffer<
+        typename Container::value_type,
+        container_sink<Container>,
+        N>;
+    template<typename T, std::size_t N = 1024>
+    using fd_output_buffer = output_buffer<T, fd_sink, N>;
+    //]
+
+}}}
+
+#endif
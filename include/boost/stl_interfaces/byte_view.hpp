@@ -0,0 +1,133 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_BYTE_VIEW_HPP
+#define BOOST_STL_INTERFACES_BYTE_VIEW_HPP
+
+#include <boost/stl_interfaces/view_interface.hpp>
+
+#include <boost/assert.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+    /** A contiguous view of the `T`s in `[first, last)`.  `as_bytes()`,
+        `as_writable_bytes()` and `view_as()` return them. */
+    template<typename T>
+    using pointer_view = subrange<T *, T *, contiguous>;
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    namespace v1_dtl {
+        template<typename Range>
+        using range_data_ptr_t = decltype(std::declval<Range &>().data());
+
+        template<typename Range>
+        using range_element_t =
+            std::remove_pointer_t<range_data_ptr_t<Range>>;
+
+        template<typename T>
+        using is_byte = std::integral_constant<
+            bool,
+            std::is_same<std::remove_cv_t<T>, unsigned char>::value ||
+                std::is_same<std::remove_cv_t<T>, char>::value ||
+                std::is_same<std::remove_cv_t<T>, signed char>::value>;
+
+        template<typename T, typename Byte>
+        using copy_const_t = std::
+            conditional_t<std::is_const<Byte>::value, T const, T>;
+
+        template<typename Range>
+        std::size_t byte_size(Range const & r)
+        {
+            return std::size_t(r.size()) * sizeof(range_element_t<Range>);
+        }
+    }
+
+#endif
+
+    /** Returns a view of the bytes of the contiguous range `r` -- anything
+        with `data()` and `size()`, such as a `std::vector`, a `std::array`,
+        or a view derived from `view_interface<D, contiguous>`.  The view
+        refers to the memory of `r`, and copies nothing. */
+    template<
+        typename Range,
+        typename Enable = std::enable_if_t<
+            std::is_pointer<v1_dtl::range_data_ptr_t<Range>>::value>>
+    pointer_view<unsigned char const> as_bytes(Range const & r)
+    {
+        auto const first =
+            reinterpret_cast<unsigned char const *>(r.data());
+        return pointer_view<unsigned char const>(
+            first, first + v1_dtl::byte_size(r));
+    }
+
+    /** Returns a view of the bytes of the contiguous range `r`, through
+        which they may be written, as `as_bytes()` does.  `r.data()` must
+        not point to `const`. */
+    template<
+        typename Range,
+        typename Enable = std::enable_if_t<
+            std::is_pointer<v1_dtl::range_data_ptr_t<Range>>::value &&
+            !std::is_const<v1_dtl::range_element_t<Range>>::value>>
+    pointer_view<unsigned char> as_writable_bytes(Range & r)
+    {
+        auto const first = reinterpret_cast<unsigned char *>(r.data());
+        return pointer_view<unsigned char>(
+            first, first + v1_dtl::byte_size(r));
+    }
+
+    /** Returns `true` if `view_as<T>(bytes)` may be called: if the bytes of
+        the contiguous range `bytes` are aligned for `T`, and are a whole
+        number of `T`s.  Check this before calling `view_as()` on bytes from
+        outside the program, whose alignment and length are not known. */
+    template<
+        typename T,
+        typename Range,
+        typename Enable = std::enable_if_t<
+            v1_dtl::is_byte<v1_dtl::range_element_t<Range const>>::value>>
+    bool can_view_as(Range const & bytes) noexcept
+    {
+        auto const address = reinterpret_cast<std::uintptr_t>(bytes.data());
+        return address % alignof(T) == 0 &&
+               std::size_t(bytes.size()) % sizeof(T) == 0;
+    }
+
+    /** Returns a view of the bytes of the contiguous range `bytes` as an
+        array of `T`, without copying them, as one might view a received
+        network buffer as an array of wire structs.  The view's elements
+        are `const` if the bytes are.
+
+        `T` must be trivially copyable.  As with any such cast, the bytes
+        must hold the object representations of `T`s; the compilers that
+        this library supports do not assume otherwise for trivially
+        copyable types, and C++20 makes this well-defined (see
+        [intro.object] in the C++ standard).
+
+        \pre `can_view_as<T>(bytes)` */
+    template<
+        typename T,
+        typename Range,
+        typename Byte = v1_dtl::range_element_t<Range>,
+        typename Enable = std::enable_if_t<v1_dtl::is_byte<Byte>::value>>
+    pointer_view<v1_dtl::copy_const_t<T, Byte>> view_as(Range && bytes)
+    {
+        static_assert(
+            std::is_trivially_copyable<T>::value,
+            "view_as<T>() requires that T be trivially copyable.");
+        BOOST_ASSERT(stl_interfaces::can_view_as<T>(bytes));
+        using pointer = v1_dtl::copy_const_t<T, Byte> *;
+        auto const first = reinterpret_cast<pointer>(bytes.data());
+        return pointer_view<v1_dtl::copy_const_t<T, Byte>>(
+            first, first + std::size_t(bytes.size()) / sizeof(T));
+    }
+
+}}}
+
+#endif
@@ -0,0 +1,263 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_CACHED_TRANSFORM_VIEW_HPP
+#define BOOST_STL_INTERFACES_CACHED_TRANSFORM_VIEW_HPP
+
+#include <boost/stl_interfaces/transform_view.hpp>
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+#include <cstdint>
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+    template<typename Iter, typename F>
+    struct cached_transform_view;
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    namespace v1_dtl {
+        template<typename Iter, typename F>
+        using cached_transform_value_t =
+            std::decay_t<transform_reference_t<Iter, F>>;
+    }
+
+#endif
+
+    /** The random access iterator of `cached_transform_view`.  Its
+        reference type is a reference to the cached result, which stays
+        valid as long as the view does, and its cache is not reset. */
+    template<typename Iter, typename F>
+    struct cached_transform_iterator
+        : iterator_interface<
+              cached_transform_iterator<Iter, F>,
+              std::random_access_iterator_tag,
+              v1_dtl::cached_transform_value_t<Iter, F>,
+              v1_dtl::cached_transform_value_t<Iter, F> const &,
+              v1_dtl::cached_transform_value_t<Iter, F> const *,
+              v1_dtl::iter_difference_t<Iter>>
+    {
+        using difference_type = v1_dtl::iter_difference_t<Iter>;
+        using reference = v1_dtl::cached_transform_value_t<Iter, F> const &;
+
+        constexpr cached_transform_iterator() noexcept : view_(nullptr), i_(0)
+        {}
+        constexpr cached_transform_iterator(
+            cached_transform_view<Iter, F> const * view,
+            difference_type i) noexcept :
+            view_(view), i_(i)
+        {}
+
+        reference operator*() const { return view_->result(i_); }
+        constexpr cached_transform_iterator &
+        operator+=(difference_type n) noexcept
+        {
+            i_ += n;
+            return *this;
+        }
+        friend constexpr difference_type operator-(
+            cached_transform_iterator lhs,
+            cached_transform_iterator rhs) noexcept
+        {
+            return lhs.i_ - rhs.i_;
+        }
+
+    private:
+        cached_transform_view<Iter, F> const * view_;
+        difference_type i_;
+    };
+
+    /** A view of `f(x)` for the elements `x` of the random access range
+        `[first, last)`, like `transform_view`, that calls `f` at most once
+        per element, however many times the element is read.  The results
+        are kept in an array of `last - first` uninitialized slots, which is
+        allocated when the view is constructed, and a bitmap records which
+        slots hold a result; reading an element tests one bit, and calls `f`
+        only the first time.  This pays for itself when `f` is expensive --
+        parsing, decompression -- and elements are read more than once, as
+        a comparison sort reads them about 2 log2(n) times each.  A
+        `transform_view` is better when each element is read once.
+
+        The elements are `std::decay_t` of the result of `f`, and are
+        accessed through `const` references into the slots.  `[]` and the
+        iterators are usable on a `const` view, and fill in the cache as
+        they go; so, like a lazily-initialized `static`, a view must not be
+        read by two threads at once.
+
+        The cache belongs to the view.  A copy of the view starts with an
+        empty cache of its own; a move takes the cache along, and leaves
+        the moved-from view empty.  If the underlying elements change, call
+        `reset_cache()`. */
+    template<typename Iter, typename F>
+    struct cached_transform_view
+        : view_interface<cached_transform_view<Iter, F>>,
+          private detail::functor_box<F>
+    {
+        static_assert(
+            std::is_convertible<
+                typename std::iterator_traits<Iter>::iterator_category,
+                std::random_access_iterator_tag>::value,
+            "cached_transform_view requires a random access range.");
+
+        using value_type = v1_dtl::cached_transform_value_t<Iter, F>;
+        using difference_type = v1_dtl::iter_difference_t<Iter>;
+        using iterator = cached_transform_iterator<Iter, F>;
+
+        cached_transform_view() : first_(), size_(0) {}
+        cached_transform_view(Iter first, Iter last, F f) :
+            detail::functor_box<F>(std::move(f)),
+            first_(first),
+            size_(last - first)
+        {
+            allocate();
+        }
+        cached_transform_view(cached_transform_view const & other) :
+            detail::functor_box<F>(other),
+            first_(other.first_),
+            size_(other.size_)
+        {
+            allocate();
+        }
+        cached_transform_view(cached_transform_view && other) noexcept(
+            std::is_nothrow_copy_constructible<F>::value) :
+            detail::functor_box<F>(other),
+            first_(other.first_),
+            size_(other.size_),
+            results_(std::move(other.results_)),
+            computed_(std::move(other.computed_))
+        {
+            other.size_ = 0;
+        }
+        cached_transform_view & operator=(cached_transform_view other)
+        {
+            reset_cache();
+            detail::functor_box<F>::operator=(other);
+            first_ = other.first_;
+            size_ = other.size_;
+            results_ = std::move(other.results_);
+            computed_ = std::move(other.computed_);
+            other.size_ = 0;
+            return *this;
+        }
+        ~cached_transform_view() { reset_cache(); }
+
+        iterator begin() const noexcept { return iterator(this, 0); }
+        iterator end() const noexcept { return iterator(this, size_); }
+
+        /** Returns `f(*(first + n))`, calling `f` only if it has not been
+            called for element `n` before. */
+        value_type const & operator[](difference_type n) const
+        {
+            return result(n);
+        }
+
+        /** Returns true if element `n` has been computed. */
+        bool cached(difference_type n) const noexcept
+        {
+            BOOST_ASSERT(0 <= n && n < size_);
+            return computed_[word(n)] & bit(n);
+        }
+
+        /** Destroys the cached results, so that every element is computed
+            again the next time it is read. */
+        void reset_cache() noexcept
+        {
+            if (!computed_)
+                return;
+            reset_cache(std::is_trivially_destructible<value_type>{});
+            std::fill(
+                computed_.get(), computed_.get() + words(size_), word_t(0));
+        }
+
+        /** Returns the beginning of the underlying range. */
+        Iter base_begin() const { return first_; }
+        /** Returns the end of the underlying range. */
+        Iter base_end() const { return first_ + size_; }
+        /** Returns the function applied to each element. */
+        F const & functor() const noexcept { return this->get(); }
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+    private:
+        friend struct cached_transform_iterator<Iter, F>;
+
+        using word_t = std::uint64_t;
+        using slot_t =
+            std::aligned_storage_t<sizeof(value_type), alignof(value_type)>;
+
+        static std::size_t words(difference_type n) noexcept
+        {
+            return (std::size_t(n) + 63) / 64;
+        }
+        static std::size_t word(difference_type n) noexcept
+        {
+            return std::size_t(n) / 64;
+        }
+        static word_t bit(difference_type n) noexcept
+        {
+            return word_t(1) << (std::size_t(n) % 64);
+        }
+
+        void allocate()
+        {
+            results_.reset(new slot_t[std::size_t(size_)]);
+            computed_.reset(new word_t[words(size_)]());
+        }
+
+        value_type const & result(difference_type n) const
+        {
+            BOOST_ASSERT(0 <= n && n < size_);
+            auto const slot = reinterpret_cast<value_type const *>(
+                results_.get() + n);
+            if (computed_[word(n)] & bit(n))
+                return *slot;
+            return compute(n);
+        }
+
+        value_type const & compute(difference_type n) const
+        {
+            auto const slot = ::new (static_cast<void *>(results_.get() + n))
+                value_type(this->get()(first_[n]));
+            computed_[word(n)] |= bit(n);
+            return *slot;
+        }
+
+        void reset_cache(std::true_type) noexcept {}
+        void reset_cache(std::false_type) noexcept
+        {
+            for (difference_type n = 0; n < size_; ++n) {
+                if (computed_[word(n)] & bit(n)) {
+                    reinterpret_cast<value_type *>(results_.get() + n)
+                        ->~value_type();
+                }
+            }
+        }
+
+        Iter first_;
+        difference_type size_;
+        std::unique_ptr<slot_t[]> results_;
+        std::unique_ptr<word_t[]> computed_;
+#endif
+    };
+
+    /** Returns a `cached_transform_view` of `f(x)` for the elements `x` of
+        the random access range `r`. */
+    template<typename Range, typename F>
+    auto make_cached_transform_view(Range && r, F f)
+    {
+        using iter = decltype(std::begin(r));
+        return cached_transform_view<iter, F>(
+            std::begin(r), std::end(r), std::move(f));
+    }
+
+}}}
+
+#endif
@@ -0,0 +1,193 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_CACHED_VIEW_INTERFACE_HPP
+#define BOOST_STL_INTERFACES_CACHED_VIEW_INTERFACE_HPP
+
+#include <boost/stl_interfaces/iterator_interface.hpp>
+#include <boost/stl_interfaces/view_interface.hpp>
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+    /** A CRTP template that one may derive from instead of `view_interface`,
+        for views whose `begin()` is expensive to compute, like
+        `std::ranges::drop_while_view` or `std::ranges::filter_view`.
+
+        `Derived` must provide `uncached_begin()` (which may be private if
+        `Derived` befriends `access`) and `end()`.  `cached_begin_view_interface`
+        provides a non-`const` `begin()` that calls `uncached_begin()` the
+        first time it is called, and returns a cached copy of the result
+        after that, for amortized constant-time `begin()`.  All the members
+        of `view_interface` are provided as well; they all use the cached
+        `begin()`.
+
+        `Iterator` is the type returned by `uncached_begin()`; it must be
+        default-constructible.  It must be given explicitly, since `Derived`
+        is incomplete when `cached_begin_view_interface<Derived, Iterator>`
+        is instantiated.
+
+        The cache is not copied or moved along with the view, since a copy of
+        the view may refer to different elements (if the view owns them, for
+        instance); a copied or moved-to view computes its own `begin()` on
+        first use.  If the underlying elements change in a way that could
+        alter the result of `uncached_begin()`, call `reset_begin_cache()`. */
+    template<
+        typename Derived,
+        typename Iterator,
+        bool Contiguous = discontiguous>
+    struct cached_begin_view_interface : view_interface<Derived, Contiguous>
+    {
+        constexpr cached_begin_view_interface() noexcept(
+            std::is_nothrow_default_constructible<Iterator>::value) :
+            first_(),
+            cached_(false)
+        {}
+        constexpr cached_begin_view_interface(
+            cached_begin_view_interface const &) noexcept(
+            std::is_nothrow_default_constructible<Iterator>::value) :
+            first_(),
+            cached_(false)
+        {}
+        constexpr cached_begin_view_interface &
+        operator=(cached_begin_view_interface const &) noexcept
+        {
+            cached_ = false;
+            return *this;
+        }
+
+        constexpr Iterator begin() noexcept(
+            noexcept(access::uncached_begin(std::declval<Derived &>())) &&
+            std::is_nothrow_copy_constructible<Iterator>::value)
+        {
+            if (!cached_) {
+                first_ = access::uncached_begin(derived());
+                cached_ = true;
+            }
+            return first_;
+        }
+
+        /** Discards the cached `begin()`, so that the next call to `begin()`
+            calls `uncached_begin()` again. */
+        constexpr void reset_begin_cache() noexcept { cached_ = false; }
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+    private:
+        constexpr Derived & derived() noexcept
+        {
+            return static_cast<Derived &>(*this);
+        }
+
+        Iterator first_;
+        bool cached_;
+#endif
+    };
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    namespace v1_dtl {
+        // Iterators that can count the elements between them in one step,
+        // with distance_to(), do so; everything else is counted one element
+        // at a time.
+        template<typename Iter>
+        constexpr std::ptrdiff_t cached_count(Iter first, Iter last)
+        {
+            return stl_interfaces::distance(first, last);
+        }
+        template<typename Iter, typename Sentinel>
+        constexpr std::ptrdiff_t cached_count(Iter first, Sentinel last)
+        {
+            std::ptrdiff_t n = 0;
+            for (; first != last; ++first) {
+                ++n;
+            }
+            return n;
+        }
+    }
+
+#endif
+
+    /** A CRTP template that one may derive from instead of `view_interface`,
+        for views that are not sized -- whose iterators are not random access,
+        like those of a filtered view -- but whose size is needed more than
+        once.
+
+        `cached_size_view_interface` provides `size()`, which counts the
+        elements of `[begin(), end())` the first time it is called, and
+        returns a cached count after that.  It also provides an `empty()`
+        that uses the cached count when there is one, instead of calling
+        `begin()`.
+
+        `Base` is the template that `cached_size_view_interface` derives
+        from; it is `view_interface<Derived>` by default.  It may instead be
+        another specialization that derives from `view_interface<Derived>`,
+        such as `cached_begin_view_interface<Derived, Iterator>`, to cache
+        both `begin()` and `size()`.
+
+        As with `cached_begin_view_interface`, the cache is not copied or
+        moved along with the view.  If the number of underlying elements
+        changes, call `reset_size_cache()`. */
+    template<typename Derived, typename Base = view_interface<Derived>>
+    struct cached_size_view_interface : Base
+    {
+        constexpr cached_size_view_interface() noexcept :
+            size_(0),
+            cached_(false)
+        {}
+        constexpr cached_size_view_interface(
+            cached_size_view_interface const & other) noexcept(
+            std::is_nothrow_copy_constructible<Base>::value) :
+            Base(other),
+            size_(0),
+            cached_(false)
+        {}
+        constexpr cached_size_view_interface &
+        operator=(cached_size_view_interface const & other) noexcept(
+            std::is_nothrow_copy_assignable<Base>::value)
+        {
+            Base::operator=(other);
+            cached_ = false;
+            return *this;
+        }
+
+        template<typename D = Derived>
+        constexpr auto size() -> v1_dtl::range_difference_t<D>
+        {
+            if (!cached_) {
+                size_ = v1_dtl::cached_count(
+                    derived().begin(), derived().end());
+                cached_ = true;
+            }
+            return v1_dtl::range_difference_t<D>(size_);
+        }
+
+        template<typename D = Derived>
+        constexpr auto empty() -> decltype(
+            std::declval<D &>().begin() == std::declval<D &>().end())
+        {
+            if (cached_)
+                return size_ == 0;
+            return derived().begin() == derived().end();
+        }
+
+        /** Discards the cached `size()`, so that the next call to `size()`
+            counts the elements again. */
+        constexpr void reset_size_cache() noexcept { cached_ = false; }
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+    private:
+        constexpr Derived & derived() noexcept
+        {
+            return static_cast<Derived &>(*this);
+        }
+
+        std::ptrdiff_t size_;
+        bool cached_;
+#endif
+    };
+
+}}}
+
+#endif
@@ -0,0 +1,321 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_CARTESIAN_PRODUCT_VIEW_HPP
+#define BOOST_STL_INTERFACES_CARTESIAN_PRODUCT_VIEW_HPP
+
+#include <boost/stl_interfaces/iterator_interface.hpp>
+#include <boost/stl_interfaces/view_interface.hpp>
+
+#include <boost/assert.hpp>
+
+#include <iterator>
+#include <tuple>
+#include <utility>
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    template<typename... Iters>
+    struct cartesian_product_iterator;
+
+    namespace v1_dtl {
+        template<typename Iter>
+        using cp_category_of =
+            typename std::iterator_traits<Iter>::iterator_category;
+
+        // As for zip_iterator, the common type of the tags is the weakest
+        // of them, and the product is never better than random access.
+        template<typename... Iters>
+        using cp_common_category = std::common_type_t<cp_category_of<Iters>...>;
+        template<typename... Iters>
+        using cp_ra = std::is_convertible<
+            cp_common_category<Iters...>,
+            std::random_access_iterator_tag>;
+        template<typename... Iters>
+        using cp_bidi = std::is_convertible<
+            cp_common_category<Iters...>,
+            std::bidirectional_iterator_tag>;
+        template<typename... Iters>
+        using cp_category = std::conditional_t<
+            cp_ra<Iters...>::value,
+            std::random_access_iterator_tag,
+            cp_common_category<Iters...>>;
+
+        template<typename... Iters>
+        using cp_iter_base = proxy_iterator_interface<
+            cartesian_product_iterator<Iters...>,
+            cp_category<Iters...>,
+            std::tuple<typename std::iterator_traits<Iters>::value_type...>,
+            std::tuple<typename std::iterator_traits<Iters>::reference...>,
+            std::common_type_t<iter_difference_t<Iters>...>>;
+
+        template<std::size_t I>
+        using cp_index = std::integral_constant<std::size_t, I>;
+    }
+
+#endif
+
+    /** An iterator over the Cartesian product of several sequences: every
+        tuple of references to one element of each, in the order of nested
+        loops, with the first sequence the outermost loop and the last the
+        innermost.  It is the loop nest flattened into one loop, which the
+        algorithms -- and `parallel_for_each()` -- can run and split like
+        any other.
+
+        The iterator keeps the first, current and last iterator of each
+        sequence.  Incrementing it increments the innermost current
+        iterator, and when that reaches its last, resets it to its first
+        and carries into the next one out, like an odometer; the outermost
+        one never wraps, and reaching its last is the end of the product.
+        If all of `Iters...` are random access, so is the product, and its
+        position is a mixed-radix number whose digits are the positions in
+        each sequence: `+=` converts it to an integer, adds, and converts it
+        back with a division per sequence, and `-` subtracts the integers.
+        Otherwise it is the weakest of their categories, which must be at
+        least forward, since the inner sequences are traversed many times.
+
+        \see `cartesian_product_view` */
+    template<typename... Iters>
+    struct cartesian_product_iterator : v1_dtl::cp_iter_base<Iters...>
+    {
+        static_assert(
+            0 < sizeof...(Iters),
+            "cartesian_product_iterator needs at least one iterator.");
+        static_assert(
+            std::is_convertible<
+                v1_dtl::cp_common_category<Iters...>,
+                std::forward_iterator_tag>::value,
+            "The sequences of a Cartesian product must be forward ranges.");
+
+        using base_type = v1_dtl::cp_iter_base<Iters...>;
+        using difference_type = typename base_type::difference_type;
+        using reference = typename base_type::reference;
+
+        constexpr cartesian_product_iterator() : firsts_(), its_(), lasts_()
+        {}
+        /** Constructs the iterator to the first element of the product of
+            the sequences `[get<I>(firsts), get<I>(lasts))`, or to the end
+            of the product if `end` is true, or if any of the sequences is
+            empty. */
+        constexpr cartesian_product_iterator(
+            std::tuple<Iters...> firsts,
+            std::tuple<Iters...> lasts,
+            bool end = false) :
+            firsts_(firsts), its_(firsts), lasts_(lasts)
+        {
+            if (end || any_empty(indices{}))
+                std::get<0>(its_) = std::get<0>(lasts_);
+        }
+
+        /** Returns the current positions in each sequence. */
+        constexpr std::tuple<Iters...> const & base() const noexcept
+        {
+            return its_;
+        }
+
+        constexpr reference operator*() const { return deref(indices{}); }
+        constexpr cartesian_product_iterator & operator++()
+        {
+            next(v1_dtl::cp_index<sizeof...(Iters) - 1>{});
+            return *this;
+        }
+        template<
+            typename C = cartesian_product_iterator,
+            typename Enable = std::enable_if_t<
+                std::is_same<C, cartesian_product_iterator>::value &&
+                v1_dtl::cp_bidi<Iters...>::value>>
+        constexpr cartesian_product_iterator & operator--()
+        {
+            prev(v1_dtl::cp_index<sizeof...(Iters) - 1>{});
+            return *this;
+        }
+        template<
+            typename C = cartesian_product_iterator,
+            typename Enable = std::enable_if_t<
+                std::is_same<C, cartesian_product_iterator>::value &&
+                v1_dtl::cp_ra<Iters...>::value>>
+        constexpr cartesian_product_iterator & operator+=(difference_type n)
+        {
+            // A product with an empty sequence has no other positions to
+            // move to, and would divide by its size of zero.
+            if (n) {
+                auto const pos = position(v1_dtl::cp_index<last_index>{}) + n;
+                BOOST_ASSERT(0 <= pos);
+                set_position(pos, v1_dtl::cp_index<last_index>{});
+            }
+            return *this;
+        }
+        template<
+            typename C = cartesian_product_iterator,
+            typename Enable = std::enable_if_t<
+                std::is_same<C, cartesian_product_iterator>::value &&
+                v1_dtl::cp_ra<Iters...>::value>>
+        friend constexpr difference_type
+        operator-(C lhs, cartesian_product_iterator rhs)
+        {
+            return lhs.position(v1_dtl::cp_index<last_index>{}) -
+                   rhs.position(v1_dtl::cp_index<last_index>{});
+        }
+        friend constexpr bool operator==(
+            cartesian_product_iterator const & lhs,
+            cartesian_product_iterator const & rhs)
+        {
+            return lhs.its_ == rhs.its_;
+        }
+
+        using base_type::operator++;
+        using base_type::operator--;
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+    private:
+        using indices = std::index_sequence_for<Iters...>;
+        static constexpr std::size_t last_index = sizeof...(Iters) - 1;
+
+        template<std::size_t... Is>
+        constexpr bool any_empty(std::index_sequence<Is...>) const
+        {
+            bool retval = false;
+            using swallow = int[];
+            (void)swallow{
+                0,
+                (retval = retval ||
+                          std::get<Is>(firsts_) == std::get<Is>(lasts_),
+                 0)...};
+            return retval;
+        }
+
+        template<std::size_t... Is>
+        constexpr reference deref(std::index_sequence<Is...>) const
+        {
+            return reference(*std::get<Is>(its_)...);
+        }
+
+        // The outermost sequence never wraps.
+        constexpr void next(v1_dtl::cp_index<0>) { ++std::get<0>(its_); }
+        template<std::size_t I>
+        constexpr void next(v1_dtl::cp_index<I>)
+        {
+            auto & it = std::get<I>(its_);
+            if (++it == std::get<I>(lasts_)) {
+                it = std::get<I>(firsts_);
+                next(v1_dtl::cp_index<I - 1>{});
+            }
+        }
+
+        constexpr void prev(v1_dtl::cp_index<0>) { --std::get<0>(its_); }
+        template<std::size_t I>
+        constexpr void prev(v1_dtl::cp_index<I>)
+        {
+            auto & it = std::get<I>(its_);
+            if (it == std::get<I>(firsts_)) {
+                it = std::get<I>(lasts_);
+                prev(v1_dtl::cp_index<I - 1>{});
+            }
+            --it;
+        }
+
+        template<std::size_t I>
+        constexpr difference_type size(v1_dtl::cp_index<I>) const
+        {
+            return difference_type(std::get<I>(lasts_) - std::get<I>(firsts_));
+        }
+        template<std::size_t I>
+        constexpr difference_type offset(v1_dtl::cp_index<I>) const
+        {
+            return difference_type(std::get<I>(its_) - std::get<I>(firsts_));
+        }
+
+        // The mixed-radix digits of the position, read most significant
+        // (outermost) first.
+        constexpr difference_type position(v1_dtl::cp_index<0>) const
+        {
+            return offset(v1_dtl::cp_index<0>{});
+        }
+        template<std::size_t I>
+        constexpr difference_type position(v1_dtl::cp_index<I>) const
+        {
+            return position(v1_dtl::cp_index<I - 1>{}) *
+                       size(v1_dtl::cp_index<I>{}) +
+                   offset(v1_dtl::cp_index<I>{});
+        }
+
+        // And written least significant (innermost) first.  Whatever is
+        // left over goes to the outermost sequence, which does not wrap,
+        // so that the end is its last.
+        constexpr void
+        set_position(difference_type pos, v1_dtl::cp_index<0>)
+        {
+            std::get<0>(its_) = std::get<0>(firsts_) + pos;
+        }
+        template<std::size_t I>
+        constexpr void set_position(difference_type pos, v1_dtl::cp_index<I>)
+        {
+            auto const s = size(v1_dtl::cp_index<I>{});
+            std::get<I>(its_) = std::get<I>(firsts_) + pos % s;
+            set_position(pos / s, v1_dtl::cp_index<I - 1>{});
+        }
+
+        std::tuple<Iters...> firsts_;
+        std::tuple<Iters...> its_;
+        std::tuple<Iters...> lasts_;
+#endif
+    };
+
+    /** A view of the Cartesian product of several sequences; its iterator
+        is `cartesian_product_iterator<Iters...>`.
+        \see `make_cartesian_product_view()` */
+    template<typename... Iters>
+    struct cartesian_product_view
+        : view_interface<cartesian_product_view<Iters...>>
+    {
+        using iterator = cartesian_product_iterator<Iters...>;
+
+        constexpr cartesian_product_view() = default;
+        constexpr cartesian_product_view(iterator first, iterator last) :
+            first_(first),
+            last_(last)
+        {}
+
+        constexpr iterator begin() const { return first_; }
+        constexpr iterator end() const { return last_; }
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+    private:
+        iterator first_;
+        iterator last_;
+#endif
+    };
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    namespace v1_dtl {
+        template<typename Range>
+        using cp_range_iter = decltype(std::begin(std::declval<Range &>()));
+    }
+
+#endif
+
+    /** Returns a `cartesian_product_view` of `rs...`, which must all be
+        common forward ranges (ranges whose `begin()` and `end()` have the
+        same type), and must outlive the view.  The view is empty if any of
+        them is. */
+    template<typename... Ranges>
+    constexpr auto make_cartesian_product_view(Ranges &&... rs)
+    {
+        using iterator =
+            cartesian_product_iterator<v1_dtl::cp_range_iter<Ranges>...>;
+        using tuple = std::tuple<v1_dtl::cp_range_iter<Ranges>...>;
+        tuple const firsts(std::begin(rs)...);
+        tuple const lasts(std::end(rs)...);
+        return cartesian_product_view<v1_dtl::cp_range_iter<Ranges>...>(
+            iterator(firsts, lasts), iterator(firsts, lasts, true));
+    }
+
+}}}
+
+#endif
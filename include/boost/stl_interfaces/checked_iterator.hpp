@@ -0,0 +1,251 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_CHECKED_ITERATOR_HPP
+#define BOOST_STL_INTERFACES_CHECKED_ITERATOR_HPP
+
+#include <boost/stl_interfaces/iterator_interface.hpp>
+
+#include <boost/config.hpp>
+
+#include <iterator>
+#include <memory>
+#include <type_traits>
+
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+
+
+#ifndef BOOST_STL_INTERFACES_CHECKED_ITERATOR_FAILURE
+/** Called with a string literal describing the misuse when a
+    `checked_iterator` check fails.  By default, it writes the message to
+    `stderr` and calls `std::abort()`; define it before including any
+    header of this library to report failures some other way.  It must not
+    return. */
+#define BOOST_STL_INTERFACES_CHECKED_ITERATOR_FAILURE(msg)                     \
+    ::boost::stl_interfaces::v1_dtl::checked_iterator_failure(msg)
+#endif
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+    /** The count of iterator-invalidating operations on a container whose
+        iterators are `checked_iterator`s.  The container calls
+        `invalidate()` in each of its operations that invalidates iterators;
+        iterators made before the call are then invalid.
+
+        A copy starts at zero, and assigning to a generation counts as an
+        invalidation, rather than copying the other count, since assigning to
+        a container invalidates the iterators into it. */
+    struct iterator_generation
+    {
+        constexpr iterator_generation() noexcept : value_(0) {}
+        constexpr iterator_generation(iterator_generation const &) noexcept :
+            value_(0)
+        {}
+        constexpr iterator_generation &
+        operator=(iterator_generation const &) noexcept
+        {
+            invalidate();
+            return *this;
+        }
+
+        constexpr void invalidate() noexcept { ++value_; }
+        constexpr std::size_t value() const noexcept { return value_; }
+
+    private:
+        std::size_t value_;
+    };
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    namespace v1_dtl {
+        [[noreturn]] inline void
+        checked_iterator_failure(char const * msg) noexcept
+        {
+            std::fputs("boost::stl_interfaces::checked_iterator: ", stderr);
+            std::fputs(msg, stderr);
+            std::fputc('\n', stderr);
+            std::abort();
+        }
+
+        template<typename Iter>
+        using checked_iterator_concept_t = std::conditional_t<
+            std::is_pointer<Iter>::value,
+            contiguous_iterator_tag,
+            std::random_access_iterator_tag>;
+
+        // What a default-constructed checked_iterator refers to: an empty
+        // container that is never invalidated.
+        template<typename T = void>
+        struct singular_checked_container
+        {
+            static constexpr std::size_t size = 0;
+            static constexpr iterator_generation generation{};
+        };
+        template<typename T>
+        constexpr std::size_t singular_checked_container<T>::size;
+        template<typename T>
+        constexpr iterator_generation
+            singular_checked_container<T>::generation;
+    }
+
+#endif
+
+    /** A random access iterator that checks each use of itself against the
+        container it came from.  It holds the underlying iterator, the first
+        position in the container, and pointers to the container's size and
+        `iterator_generation`; the container's current size bounds it, and
+        its generation must not have changed since the iterator was made.
+
+        Dereferencing an iterator that is not within `[first, first + size)`,
+        moving one outside `[first, first + size]`, or using an iterator that
+        has been invalidated, or subtracting or comparing two that are not
+        into the same container, calls
+        `BOOST_STL_INTERFACES_CHECKED_ITERATOR_FAILURE()`.  Each check is a
+        compare and a branch that is never taken in a correct program, and
+        nothing is allocated, so this is cheap enough to leave on in a
+        canary build.
+
+        The bounds are read from the container, so an iterator stays usable
+        when elements are appended; an iterator to an element that is erased
+        from the end is caught by the bounds check, without an invalidation.
+        A default-constructed `checked_iterator` acts like one into an empty
+        container that all default-constructed ones share. */
+    template<typename Iter>
+    struct checked_iterator
+        : iterator_interface<
+              checked_iterator<Iter>,
+              v1_dtl::checked_iterator_concept_t<Iter>,
+              typename std::iterator_traits<Iter>::value_type,
+              typename std::iterator_traits<Iter>::reference,
+              typename std::iterator_traits<Iter>::pointer,
+              typename std::iterator_traits<Iter>::difference_type>
+    {
+        static_assert(
+            std::is_convertible<
+                typename std::iterator_traits<Iter>::iterator_category,
+                std::random_access_iterator_tag>::value,
+            "checked_iterator requires a random access Iter.");
+
+        using reference = typename std::iterator_traits<Iter>::reference;
+        using difference_type =
+            typename std::iterator_traits<Iter>::difference_type;
+
+        constexpr checked_iterator() noexcept :
+            it_(),
+            first_(),
+            size_(&v1_dtl::singular_checked_container<>::size),
+            generation_(&v1_dtl::singular_checked_container<>::generation),
+            value_(0)
+        {}
+        /** Constructs an iterator at `it` in the container whose elements
+            begin at `first`, whose size is `size`, and whose generation is
+            `generation`. */
+        constexpr checked_iterator(
+            Iter it,
+            Iter first,
+            std::size_t const & size,
+            iterator_generation const & generation) noexcept :
+            it_(it),
+            first_(first),
+            size_(&size),
+            generation_(&generation),
+            value_(generation.value())
+        {}
+        template<
+            typename Iter2,
+            typename Enable = std::enable_if_t<
+                std::is_convertible<Iter2, Iter>::value &&
+                !std::is_same<Iter2, Iter>::value>>
+        constexpr checked_iterator(
+            checked_iterator<Iter2> const & other) noexcept :
+            it_(other.it_),
+            first_(other.first_),
+            size_(other.size_),
+            generation_(other.generation_),
+            value_(other.value_)
+        {}
+
+        constexpr reference operator*() const noexcept
+        {
+            check(
+                current() && 0 <= index() && index() < size(),
+                "dereferenced an iterator that is invalid or out of range");
+            return *it_;
+        }
+        constexpr checked_iterator & operator+=(difference_type n) noexcept
+        {
+            check(
+                current() && 0 <= index() + n && index() + n <= size(),
+                "moved an iterator that is invalid, or out of range");
+            it_ += n;
+            return *this;
+        }
+        constexpr difference_type operator-(checked_iterator other) const
+            noexcept
+        {
+            check(
+                generation_ == other.generation_ && current() &&
+                    other.current(),
+                "compared iterators that are invalid, or into different "
+                "containers");
+            return it_ - other.it_;
+        }
+
+        /** Returns the underlying iterator, without a check. */
+        constexpr Iter base() const noexcept { return it_; }
+
+    private:
+        template<typename Iter2>
+        friend struct checked_iterator;
+
+        static constexpr void check(bool ok, char const * msg) noexcept
+        {
+            if (BOOST_UNLIKELY(!ok))
+                BOOST_STL_INTERFACES_CHECKED_ITERATOR_FAILURE(msg);
+        }
+        constexpr bool current() const noexcept
+        {
+            return generation_->value() == value_;
+        }
+        constexpr difference_type index() const noexcept
+        {
+            return it_ - first_;
+        }
+        constexpr difference_type size() const noexcept
+        {
+            return difference_type(*size_);
+        }
+
+        Iter it_;
+        Iter first_;
+        std::size_t const * size_;
+        iterator_generation const * generation_;
+        std::size_t value_;
+    };
+
+}}}
+
+namespace std {
+    /** Lets `to_address()` get the address of a `checked_iterator<T *>`
+        without dereferencing it, as a container's `data()` does even when
+        it is empty. */
+    template<typename T>
+    struct pointer_traits<boost::stl_interfaces::checked_iterator<T *>>
+    {
+        using pointer = boost::stl_interfaces::checked_iterator<T *>;
+        using element_type = T;
+        using difference_type = std::ptrdiff_t;
+
+        static constexpr T * to_address(pointer p) noexcept
+        {
+            return p.base();
+        }
+    };
+}
+
+#endif
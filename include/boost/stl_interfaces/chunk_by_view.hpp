@@ -0,0 +1,176 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_CHUNK_BY_VIEW_HPP
+#define BOOST_STL_INTERFACES_CHUNK_BY_VIEW_HPP
+
+#include <boost/stl_interfaces/algorithm.hpp>
+#include <boost/stl_interfaces/chunk_view.hpp>
+
+#include <functional>
+#include <memory>
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+    template<typename Iter, typename Pred>
+    struct chunk_by_view;
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    namespace v1_dtl {
+        template<typename Pred, typename T>
+        struct is_equal_to : std::false_type
+        {
+        };
+        template<typename T>
+        struct is_equal_to<std::equal_to<>, T> : std::true_type
+        {
+        };
+        template<typename T>
+        struct is_equal_to<std::equal_to<T>, T> : std::true_type
+        {
+        };
+
+        // The runs of an equality are found with the vectorized
+        // mismatch() of the range and itself shifted by one.
+        template<typename Iter, typename Pred>
+        using chunk_by_simd = std::integral_constant<
+            bool,
+            is_equal_to<Pred, algo_value_t<Iter>>::value &&
+                simd_mismatchable<Iter, Iter>::value>;
+    }
+
+#endif
+
+    /** An iterator over the maximal runs of the range `[first, last)` in
+        which `pred(a, b)` is `true` for each pair of adjacent elements `a`
+        and `b`, like the iterator of `std::ranges::chunk_by_view`.  Each
+        run is the same `chunk_range` that a `chunk_iterator` over `Iter`
+        produces -- a span of pointers if `Iter` is contiguous -- so no run
+        is copied.
+
+        The iterator holds the ends of its run and a pointer to the view,
+        which holds the end of the range and the predicate.  If `pred` is
+        `std::equal_to<>` or `std::equal_to<T>`, and `Iter` is contiguous
+        over values of an integer type `T`, `float` or `double`, the end of
+        each run is found with the vectorized `mismatch()` from
+        `algorithm.hpp`.  It is a forward iterator.
+
+        \see `chunk_by_view` */
+    template<typename Iter, typename Pred>
+    struct chunk_by_iterator : proxy_iterator_interface<
+                                   chunk_by_iterator<Iter, Pred>,
+                                   std::forward_iterator_tag,
+                                   typename v1_dtl::chunk_of<Iter>::type>
+    {
+        using chunk_type = typename v1_dtl::chunk_of<Iter>::type;
+        using view_type = chunk_by_view<Iter, Pred>;
+
+        constexpr chunk_by_iterator() = default;
+        /** Constructs an iterator to the run that starts at `it`. */
+        constexpr chunk_by_iterator(view_type const & view, Iter it) :
+            view_(std::addressof(view)),
+            it_(it),
+            next_(it)
+        {
+            find_next(v1_dtl::chunk_by_simd<Iter, Pred>{});
+        }
+
+        constexpr chunk_type operator*() const
+        {
+            return v1_dtl::chunk_of<Iter>::make(it_, next_);
+        }
+        constexpr chunk_by_iterator & operator++()
+        {
+            it_ = next_;
+            find_next(v1_dtl::chunk_by_simd<Iter, Pred>{});
+            return *this;
+        }
+        friend constexpr bool operator==(
+            chunk_by_iterator const & lhs, chunk_by_iterator const & rhs)
+        {
+            return lhs.it_ == rhs.it_;
+        }
+
+        using base_type = proxy_iterator_interface<
+            chunk_by_iterator<Iter, Pred>,
+            std::forward_iterator_tag,
+            chunk_type>;
+        using base_type::operator++;
+
+    private:
+        constexpr void find_next(std::false_type)
+        {
+            auto const last = view_->last_;
+            if (next_ == last)
+                return;
+            auto prev = next_;
+            for (++next_; next_ != last && view_->pred_(*prev, *next_);
+                 ++next_) {
+                prev = next_;
+            }
+        }
+        void find_next(std::true_type)
+        {
+            auto const last = view_->last_;
+            if (next_ == last)
+                return;
+            next_ = stl_interfaces::mismatch(std::next(next_), last, next_)
+                        .first;
+        }
+
+        view_type const * view_ = nullptr;
+        Iter it_ = Iter();
+        Iter next_ = Iter();
+    };
+
+    /** A view of the maximal runs of the range `[first, last)` in which
+        `pred(a, b)` is `true` for each pair of adjacent elements `a` and
+        `b`; with `std::equal_to<>`, the runs of equal elements, as in a
+        run-length encoding or a group-by over sorted keys.  Its iterators
+        refer to the view, which must outlive them.
+
+        `begin()` finds the end of the first run each time it is called.
+        \see `chunk_by_iterator` */
+    template<typename Iter, typename Pred>
+    struct chunk_by_view : view_interface<chunk_by_view<Iter, Pred>>
+    {
+        using iterator = chunk_by_iterator<Iter, Pred>;
+
+        constexpr chunk_by_view() = default;
+        constexpr chunk_by_view(Iter first, Iter last, Pred pred) :
+            first_(first),
+            last_(last),
+            pred_(std::move(pred))
+        {}
+
+        constexpr iterator begin() const { return iterator(*this, first_); }
+        constexpr iterator end() const { return iterator(*this, last_); }
+
+        /** Returns the predicate. */
+        constexpr Pred const & pred() const noexcept { return pred_; }
+
+    private:
+        friend iterator;
+
+        Iter first_;
+        Iter last_;
+        Pred pred_;
+    };
+
+    /** Returns a `chunk_by_view` of the runs of `r` in which `pred` holds
+        for adjacent elements. */
+    template<typename Range, typename Pred = std::equal_to<>>
+    constexpr auto make_chunk_by_view(Range && r, Pred pred = Pred())
+    {
+        using iter = decltype(std::begin(r));
+        return chunk_by_view<iter, Pred>(
+            std::begin(r), std::end(r), std::move(pred));
+    }
+
+}}}
+
+#endif
@@ -0,0 +1,267 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_CHUNK_VIEW_HPP
+#define BOOST_STL_INTERFACES_CHUNK_VIEW_HPP
+
+#include <boost/stl_interfaces/iterator_interface.hpp>
+#include <boost/stl_interfaces/view_interface.hpp>
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+    /** The view of a single chunk produced by a `chunk_iterator`: a pair of
+        iterators, with the view operations provided by `view_interface`. */
+    template<typename Iter, bool Contiguous = discontiguous>
+    struct chunk_range
+        : view_interface<chunk_range<Iter, Contiguous>, Contiguous>
+    {
+        constexpr chunk_range() = default;
+        constexpr chunk_range(Iter first, Iter last) noexcept(
+            std::is_nothrow_copy_constructible<Iter>::value) :
+            first_(first),
+            last_(last)
+        {}
+
+        constexpr Iter begin() const noexcept(
+            std::is_nothrow_copy_constructible<Iter>::value)
+        {
+            return first_;
+        }
+        constexpr Iter end() const noexcept(
+            std::is_nothrow_copy_constructible<Iter>::value)
+        {
+            return last_;
+        }
+
+    private:
+        Iter first_;
+        Iter last_;
+    };
+
+    namespace v1_dtl {
+        template<typename Iter>
+        using chunk_ra = std::is_convertible<
+            typename std::iterator_traits<Iter>::iterator_category,
+            std::random_access_iterator_tag>;
+
+        // If Iter is contiguous, each chunk is a pair of pointers -- a span --
+        // so that code that iterates over a chunk gets raw pointer loops.
+        template<
+            typename Iter,
+            bool Contiguous = is_contiguous_iterator<Iter>::value>
+        struct chunk_of
+        {
+            using type = chunk_range<Iter>;
+            static constexpr type make(Iter first, Iter last)
+            {
+                return type(first, last);
+            }
+        };
+        template<typename Iter>
+        struct chunk_of<Iter, true>
+        {
+            using pointer = decltype(stl_interfaces::to_address(
+                std::declval<Iter const &>()));
+            using type = chunk_range<pointer, contiguous>;
+            static constexpr type make(Iter first, Iter last) noexcept
+            {
+                auto const p = stl_interfaces::to_address(first);
+                return type(p, p + (last - first));
+            }
+        };
+    }
+
+    /** An iterator over the fixed-size chunks of the range `[first, last)`:
+        each element is a view of the next `n` elements of the range, with
+        the last chunk holding the remaining `1` to `n` elements.  The value
+        type is `chunk_range<Iter>`; if `Iter` is contiguous (see
+        `is_contiguous_iterator`), it is instead a `chunk_range` of
+        pointers.
+
+        The end of each chunk is found when the iterator arrives at it, so
+        code that loops over the elements of one chunk does not also check
+        for the end of the whole range.  A `chunk_iterator` over random
+        access iterators is itself random access; otherwise, it is a forward
+        iterator.
+
+        \see `chunk_view` */
+    template<typename Iter, typename Enable = void>
+    struct chunk_iterator : proxy_iterator_interface<
+                                chunk_iterator<Iter, Enable>,
+                                std::forward_iterator_tag,
+                                typename v1_dtl::chunk_of<Iter>::type>
+    {
+        using chunk_type = typename v1_dtl::chunk_of<Iter>::type;
+
+        constexpr chunk_iterator() = default;
+        constexpr chunk_iterator(
+            Iter first, Iter last, v1_dtl::iter_difference_t<Iter> n) :
+            it_(first),
+            next_(first),
+            last_(last),
+            n_(n)
+        {
+            BOOST_ASSERT(0 < n);
+            find_next();
+        }
+
+        constexpr chunk_type operator*() const
+        {
+            return v1_dtl::chunk_of<Iter>::make(it_, next_);
+        }
+        constexpr chunk_iterator & operator++()
+        {
+            it_ = next_;
+            find_next();
+            return *this;
+        }
+        friend constexpr bool
+        operator==(chunk_iterator const & lhs, chunk_iterator const & rhs)
+        {
+            return lhs.it_ == rhs.it_;
+        }
+
+        using base_type = proxy_iterator_interface<
+            chunk_iterator<Iter, Enable>,
+            std::forward_iterator_tag,
+            chunk_type>;
+        using base_type::operator++;
+
+    private:
+        constexpr void find_next()
+        {
+            for (auto i = n_; i && next_ != last_; --i) {
+                ++next_;
+            }
+        }
+
+        Iter it_;
+        Iter next_;
+        Iter last_;
+        v1_dtl::iter_difference_t<Iter> n_;
+    };
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    template<typename Iter>
+    struct chunk_iterator<Iter, std::enable_if_t<v1_dtl::chunk_ra<Iter>::value>>
+        : proxy_iterator_interface<
+              chunk_iterator<Iter>,
+              std::random_access_iterator_tag,
+              typename v1_dtl::chunk_of<Iter>::type>
+    {
+        using chunk_type = typename v1_dtl::chunk_of<Iter>::type;
+        using difference_type = v1_dtl::iter_difference_t<Iter>;
+
+        constexpr chunk_iterator() = default;
+        constexpr chunk_iterator(Iter first, Iter last, difference_type n) :
+            chunk_iterator(first, first, last, n)
+        {}
+        constexpr chunk_iterator(
+            Iter first, Iter it, Iter last, difference_type n) :
+            first_(first),
+            it_(it),
+            last_(last),
+            n_(n)
+        {
+            BOOST_ASSERT(0 < n);
+        }
+
+        constexpr chunk_type operator*() const
+        {
+            return v1_dtl::chunk_of<Iter>::make(
+                it_, it_ + (std::min)(n_, difference_type(last_ - it_)));
+        }
+        constexpr chunk_iterator & operator+=(difference_type i)
+        {
+            // Only the last chunk may be short, so the chunk index of it_ is
+            // its offset divided by n_, rounded up.
+            auto const offset = it_ - first_;
+            auto const index = (offset + n_ - 1) / n_ + i;
+            it_ = first_ +
+                  (std::min)(index * n_, difference_type(last_ - first_));
+            return *this;
+        }
+        friend constexpr difference_type
+        operator-(chunk_iterator const & lhs, chunk_iterator const & rhs)
+        {
+            auto const n = lhs.n_;
+            return (lhs.it_ - lhs.first_ + n - 1) / n -
+                   (rhs.it_ - rhs.first_ + n - 1) / n;
+        }
+
+    private:
+        Iter first_;
+        Iter it_;
+        Iter last_;
+        difference_type n_;
+    };
+
+#endif
+
+    /** A view of consecutive fixed-size chunks of the range `[first, last)`.
+        \see `chunk_iterator` */
+    template<typename Iter>
+    struct chunk_view : view_interface<chunk_view<Iter>>
+    {
+        using iterator = chunk_iterator<Iter>;
+
+        constexpr chunk_view() = default;
+        constexpr chunk_view(
+            Iter first, Iter last, v1_dtl::iter_difference_t<Iter> n) :
+            first_(first),
+            last_(last),
+            n_(n)
+        {
+            BOOST_ASSERT(0 < n);
+        }
+
+        constexpr iterator begin() const
+        {
+            return iterator(first_, last_, n_);
+        }
+        constexpr iterator end() const
+        {
+            return end(v1_dtl::chunk_ra<Iter>{});
+        }
+
+        /** Returns the number of elements in each chunk but the last. */
+        constexpr v1_dtl::iter_difference_t<Iter> chunk_size() const noexcept
+        {
+            return n_;
+        }
+
+    private:
+        constexpr iterator end(std::true_type) const
+        {
+            return iterator(first_, last_, last_, n_);
+        }
+        constexpr iterator end(std::false_type) const
+        {
+            return iterator(last_, last_, n_);
+        }
+
+        Iter first_;
+        Iter last_;
+        v1_dtl::iter_difference_t<Iter> n_;
+    };
+
+    /** Returns a `chunk_view` of the elements of `r`, in chunks of `n`. */
+    template<typename Range>
+    constexpr auto make_chunk_view(
+        Range && r, v1_dtl::iter_difference_t<decltype(std::begin(r))> n)
+    {
+        using iter = decltype(std::begin(r));
+        return chunk_view<iter>(std::begin(r), std::end(r), n);
+    }
+
+}}}
+
+#endif
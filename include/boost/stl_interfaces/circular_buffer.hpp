@@ -0,0 +1,608 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_CIRCULAR_BUFFER_HPP
+#define BOOST_STL_INTERFACES_CIRCULAR_BUFFER_HPP
+
+#include <boost/stl_interfaces/container_interface.hpp>
+#include <boost/stl_interfaces/trivially_relocatable.hpp>
+#include <boost/stl_interfaces/detail/relocate.hpp>
+
+#include <algorithm>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include <cassert>
+#include <cstddef>
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+    //[ ring_iterator
+    // A random access iterator over a ring of slots, whose number is a power of
+    // two.  It wraps around the ring the way repeated_chars_iterator wraps
+    // around its string, except that since the size of the ring is a power of
+    // two, n_ % size_ becomes index_ & mask_.
+    //
+    // index_ itself never wraps around the ring -- it only wraps around
+    // std::size_t, which is harmless, since the ring's size divides SIZE_MAX +
+    // 1 -- so iterators can be compared and subtracted without knowing where
+    // the ring starts.
+    template<typename T>
+    struct ring_iterator : iterator_interface<
+                               ring_iterator<T>,
+                               std::random_access_iterator_tag,
+                               T>
+    {
+        constexpr ring_iterator() noexcept :
+            slots_(nullptr), mask_(0), index_(0)
+        {}
+        constexpr ring_iterator(
+            T * slots, std::size_t mask, std::size_t index) noexcept :
+            slots_(slots),
+            mask_(mask),
+            index_(index)
+        {}
+        template<
+            typename U,
+            typename E = std::enable_if_t<
+                std::is_same<T, U const>::value && !std::is_same<T, U>::value>>
+        constexpr ring_iterator(ring_iterator<U> other) noexcept :
+            slots_(other.slots_),
+            mask_(other.mask_),
+            index_(other.index_)
+        {}
+
+        constexpr T & operator*() const noexcept
+        {
+            return slots_[index_ & mask_];
+        }
+        constexpr ring_iterator & operator+=(std::ptrdiff_t n) noexcept
+        {
+            index_ += std::size_t(n);
+            return *this;
+        }
+        constexpr std::ptrdiff_t operator-(ring_iterator other) const noexcept
+        {
+            return std::ptrdiff_t(index_ - other.index_);
+        }
+
+    private:
+        template<typename U>
+        friend struct ring_iterator;
+        template<typename U, std::size_t N>
+        friend struct circular_buffer;
+
+        T * slots_;
+        std::size_t mask_;
+        std::size_t index_;
+    };
+    //]
+
+    //[ circular_buffer_defn
+    // The slots of a circular_buffer<T, N>: N of them inside the object, for a
+    // fixed-capacity buffer, or a growing number on the heap, if N is 0.
+    template<typename T, std::size_t N>
+    struct ring_storage
+    {
+        static_assert((N & (N - 1)) == 0, "N must be a power of two.");
+
+        ring_storage() noexcept {}
+
+        T * slots() noexcept { return reinterpret_cast<T *>(buf_); }
+        std::size_t capacity() const noexcept { return N; }
+
+        alignas(T) unsigned char buf_[N * sizeof(T)];
+    };
+    template<typename T>
+    struct ring_storage<T, 0>
+    {
+        ring_storage() noexcept : slots_(nullptr), capacity_(0) {}
+
+        T * slots() noexcept { return slots_; }
+        std::size_t capacity() const noexcept { return capacity_; }
+
+        T * slots_;
+        std::size_t capacity_;
+    };
+
+    // A double-ended queue in a ring of slots, for producer/consumer buffers.
+    // circular_buffer<T, N> holds at most N elements, in storage inside the
+    // object, and never allocates; pushing onto a full one is a precondition
+    // violation.  circular_buffer<T> (N == 0) instead grows on the heap,
+    // doubling its capacity like std::vector, and, unlike std::deque, reuses
+    // the same storage as elements come and go.  Capacities are always powers
+    // of two.
+    //
+    // The elements occupy slots head_ & mask() through (head_ + size_ - 1) &
+    // mask(), which are at most two contiguous spans of the slots;
+    // array_one() and array_two() return them.  The bulk operations write()
+    // and read() copy a whole run of elements into or out of the buffer, as at
+    // most two contiguous copies (two memcpy()s, for trivially copyable T).
+    template<typename T, std::size_t N = 0>
+    struct circular_buffer : container_interface<circular_buffer<T, N>>
+    {
+        // types
+        using value_type = T;
+        using pointer = T *;
+        using const_pointer = T const *;
+        using reference = value_type &;
+        using const_reference = value_type const &;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using iterator = ring_iterator<T>;
+        using const_iterator = ring_iterator<T const>;
+        using reverse_iterator = stl_interfaces::reverse_iterator<iterator>;
+        using const_reverse_iterator =
+            stl_interfaces::reverse_iterator<const_iterator>;
+
+        // A contiguous span of elements: a pointer to the first, and a count.
+        using array_range = std::pair<pointer, size_type>;
+        using const_array_range = std::pair<const_pointer, size_type>;
+
+        // construct/copy/destroy
+        circular_buffer() noexcept : head_(0), size_(0) {}
+        explicit circular_buffer(size_type n) : circular_buffer()
+        {
+            reserve(n);
+            for (; n; --n) {
+                emplace_back();
+            }
+        }
+        circular_buffer(size_type n, T const & x) : circular_buffer()
+        {
+            reserve(n);
+            for (; n; --n) {
+                emplace_back(x);
+            }
+        }
+        template<
+            typename InputIterator,
+            typename Enable = std::enable_if_t<std::is_convertible<
+                typename std::iterator_traits<InputIterator>::iterator_category,
+                std::input_iterator_tag>::value>>
+        circular_buffer(InputIterator first, InputIterator last) :
+            circular_buffer()
+        {
+            for (; first != last; ++first) {
+                emplace_back(*first);
+            }
+        }
+        circular_buffer(std::initializer_list<T> il) :
+            circular_buffer(il.begin(), il.end())
+        {}
+        circular_buffer(circular_buffer const & other) : circular_buffer()
+        {
+            copy_from(other);
+        }
+        circular_buffer(circular_buffer && other) noexcept(nothrow_steal) :
+            circular_buffer()
+        {
+            steal(other);
+        }
+        circular_buffer & operator=(circular_buffer const & other)
+        {
+            if (this != &other) {
+                clear();
+                copy_from(other);
+            }
+            return *this;
+        }
+        circular_buffer & operator=(circular_buffer && other) noexcept(
+            nothrow_steal)
+        {
+            if (this != &other) {
+                clear();
+                free_slots();
+                steal(other);
+            }
+            return *this;
+        }
+        ~circular_buffer()
+        {
+            clear();
+            free_slots();
+        }
+
+        // iterators (2 members, skipped 10)
+        iterator begin() noexcept
+        {
+            return iterator(storage_.slots(), mask(), head_);
+        }
+        iterator end() noexcept
+        {
+            return iterator(storage_.slots(), mask(), head_ + size_);
+        }
+
+        // capacity
+        size_type size() const noexcept { return size_; }
+        size_type max_size() const noexcept
+        {
+            return N ? N
+                     : (std::numeric_limits<difference_type>::max)() /
+                           sizeof(T);
+        }
+        size_type capacity() const noexcept { return storage_.capacity(); }
+        bool full() const noexcept { return size_ == capacity(); }
+        // Rounds n up to a power of two.  For a fixed-capacity buffer, only
+        // checks that n <= N.
+        void reserve(size_type n)
+        {
+            assert(n <= max_size());
+            if (capacity() < n)
+                reallocate(rounded_capacity(n));
+        }
+        void resize(size_type sz, T const & x)
+        {
+            if (sz < size_) {
+                erase(begin() + sz, end());
+                return;
+            }
+            reserve(sz);
+            while (size_ < sz) {
+                emplace_back(x);
+            }
+        }
+
+        // The elements, as at most two contiguous spans of the slots: the one
+        // starting at front(), and the one ending at back(), which is empty if
+        // the elements do not wrap around the end of the slots.
+        array_range array_one() noexcept
+        {
+            if (!size_)
+                return array_range(storage_.slots(), 0);
+            auto const first = head_ & mask();
+            return array_range(
+                storage_.slots() + first,
+                (std::min)(size_, capacity() - first));
+        }
+        array_range array_two() noexcept
+        {
+            return array_range(storage_.slots(), size_ - array_one().second);
+        }
+        const_array_range array_one() const noexcept
+        {
+            return const_cast<circular_buffer &>(*this).array_one();
+        }
+        const_array_range array_two() const noexcept
+        {
+            return const_cast<circular_buffer &>(*this).array_two();
+        }
+
+        // modifiers
+        template<typename... Args>
+        reference emplace_back(Args &&... args)
+        {
+            if (full()) {
+                // args may refer to an element, so the new element is built
+                // before the elements move.
+                T x(std::forward<Args>(args)...);
+                grow(1);
+                return unchecked_emplace_back(std::move(x));
+            }
+            return unchecked_emplace_back(std::forward<Args>(args)...);
+        }
+        template<typename... Args>
+        reference emplace_front(Args &&... args)
+        {
+            if (full()) {
+                T x(std::forward<Args>(args)...);
+                grow(1);
+                return unchecked_emplace_front(std::move(x));
+            }
+            return unchecked_emplace_front(std::forward<Args>(args)...);
+        }
+        void pop_back() noexcept
+        {
+            assert(size_);
+            --size_;
+            slot(head_ + size_)->~T();
+        }
+        void pop_front() noexcept
+        {
+            assert(size_);
+            slot(head_)->~T();
+            ++head_;
+            --size_;
+        }
+
+        // Elements are inserted at whichever end of the buffer is nearer pos,
+        // and then rotated into place.
+        template<typename... Args>
+        iterator emplace(const_iterator pos, Args &&... args)
+        {
+            auto const i = size_type(pos - this->cbegin());
+            if (i < size_ / 2) {
+                emplace_front(std::forward<Args>(args)...);
+                std::rotate(begin(), begin() + 1, begin() + i + 1);
+            } else {
+                emplace_back(std::forward<Args>(args)...);
+                std::rotate(begin() + i, end() - 1, end());
+            }
+            return begin() + i;
+        }
+        template<
+            typename InputIterator,
+            typename Enable = std::enable_if_t<std::is_convertible<
+                typename std::iterator_traits<InputIterator>::iterator_category,
+                std::input_iterator_tag>::value>>
+        iterator insert(
+            const_iterator pos, InputIterator first, InputIterator last)
+        {
+            auto const i = size_type(pos - this->cbegin());
+            auto const old_size = size_;
+            for (; first != last; ++first) {
+                emplace_back(*first);
+            }
+            std::rotate(begin() + i, begin() + old_size, end());
+            return begin() + i;
+        }
+        // The elements on the shorter side of the erased ones are moved into
+        // the gap.
+        iterator erase(const_iterator f, const_iterator l) noexcept(
+            std::is_nothrow_move_assignable<T>::value)
+        {
+            auto const i = size_type(f - this->cbegin());
+            auto const n = size_type(l - f);
+            auto const first = begin() + i;
+            auto const last = first + n;
+            if (i < size_ - i - n) {
+                std::move_backward(begin(), first, last);
+                destroy_front(n);
+            } else {
+                std::move(last, end(), first);
+                destroy_back(n);
+            }
+            return begin() + i;
+        }
+        void clear() noexcept
+        {
+            destroy_front(size_);
+            head_ = 0;
+        }
+
+        // Copies [first, first + n) onto the back, and returns the number of
+        // elements copied.  A fixed-capacity buffer copies only as many as fit.
+        size_type write(T const * first, size_type n)
+        {
+            if (N)
+                n = (std::min)(n, capacity() - size_);
+            else
+                reserve(size_ + n);
+            auto const tail = (head_ + size_) & mask();
+            auto const n1 = (std::min)(n, capacity() - tail);
+            std::uninitialized_copy(first, first + n1, storage_.slots() + tail);
+            size_ += n1;
+            std::uninitialized_copy(first + n1, first + n, storage_.slots());
+            size_ += n - n1;
+            return n;
+        }
+        // Moves up to n elements off the front, to out, and returns the number
+        // of elements moved.
+        size_type read(T * out, size_type n)
+        {
+            n = (std::min)(n, size_);
+            auto const one = array_one();
+            auto const n1 = (std::min)(n, one.second);
+            out = std::move(one.first, one.first + n1, out);
+            std::move(storage_.slots(), storage_.slots() + (n - n1), out);
+            destroy_front(n);
+            return n;
+        }
+
+        void swap(circular_buffer & other) noexcept(nothrow_steal)
+        {
+            if (!N) {
+                std::swap(storage_, other.storage_);
+                std::swap(head_, other.head_);
+                std::swap(size_, other.size_);
+                return;
+            }
+            circular_buffer temp(std::move(other));
+            other = std::move(*this);
+            *this = std::move(temp);
+        }
+        friend void swap(circular_buffer & lhs, circular_buffer & rhs) noexcept(
+            noexcept(lhs.swap(rhs)))
+        {
+            lhs.swap(rhs);
+        }
+
+        using base_type = container_interface<circular_buffer<T, N>>;
+        using base_type::begin;
+        using base_type::end;
+        using base_type::insert;
+        using base_type::erase;
+        using base_type::resize;
+
+    private:
+        static constexpr bool nothrow_relocatable =
+            is_trivially_relocatable<T>::value ||
+            std::is_nothrow_move_constructible<T>::value;
+        // A growing buffer moves by taking the other's slots; a fixed one moves
+        // the elements.
+        static constexpr bool nothrow_steal = !N || nothrow_relocatable;
+
+        size_type mask() const noexcept { return capacity() - 1; }
+        T * slot(size_type index) noexcept
+        {
+            return storage_.slots() + (index & mask());
+        }
+
+        template<typename... Args>
+        reference unchecked_emplace_back(Args &&... args)
+        {
+            T * const p = slot(head_ + size_);
+            ::new (static_cast<void *>(p)) T(std::forward<Args>(args)...);
+            ++size_;
+            return *p;
+        }
+        template<typename... Args>
+        reference unchecked_emplace_front(Args &&... args)
+        {
+            T * const p = slot(head_ - 1);
+            ::new (static_cast<void *>(p)) T(std::forward<Args>(args)...);
+            --head_;
+            ++size_;
+            return *p;
+        }
+
+        // Destroys the first or last n elements, a span at a time.
+        void destroy_front(size_type n) noexcept
+        {
+            auto const first = head_ & mask();
+            auto const n1 = (std::min)(n, capacity() - first);
+            detail::destroy(
+                storage_.slots() + first, storage_.slots() + first + n1);
+            detail::destroy(
+                storage_.slots(), storage_.slots() + (n - n1));
+            head_ += n;
+            size_ -= n;
+        }
+        void destroy_back(size_type n) noexcept
+        {
+            auto const last = (head_ + size_) & mask();
+            auto const n2 = (std::min)(n, last);
+            detail::destroy(
+                storage_.slots() + last - n2, storage_.slots() + last);
+            detail::destroy(
+                storage_.slots() + capacity() - (n - n2),
+                storage_.slots() + capacity());
+            size_ -= n;
+        }
+
+        size_type rounded_capacity(size_type n) const noexcept
+        {
+            size_type retval = capacity() ? capacity() : 8;
+            while (retval < n) {
+                retval *= 2;
+            }
+            return retval;
+        }
+        void grow(size_type insertions)
+        {
+            assert(!N && "A fixed-capacity circular_buffer is full.");
+            reallocate(rounded_capacity(size_ + insertions));
+        }
+
+        // Moves the elements to new slots for new_capacity elements, starting
+        // at the first slot.  Elements that may throw when moved are copied
+        // instead, so that if anything throws, *this is unchanged.
+        void reallocate(size_type new_capacity)
+        {
+            assert(!N);
+            T * const new_slots = std::allocator<T>().allocate(new_capacity);
+            transfer(
+                new_slots,
+                new_capacity,
+                std::integral_constant<
+                    bool,
+                    nothrow_relocatable ||
+                        !std::is_copy_constructible<T>::value>{});
+            free_slots();
+            set_slots(new_slots, new_capacity);
+            head_ = 0;
+        }
+        void transfer(T * new_slots, size_type, std::true_type) noexcept(
+            nothrow_relocatable)
+        {
+            auto const one = array_one();
+            auto const two = array_two();
+            stl_interfaces::uninitialized_relocate(
+                one.first, one.first + one.second, new_slots);
+            stl_interfaces::uninitialized_relocate(
+                two.first, two.first + two.second, new_slots + one.second);
+        }
+        void transfer(T * new_slots, size_type new_capacity, std::false_type)
+        {
+            auto const one = array_one();
+            auto const two = array_two();
+            T * one_end = new_slots;
+            try {
+                one_end = std::uninitialized_copy(
+                    one.first, one.first + one.second, new_slots);
+                std::uninitialized_copy(
+                    two.first, two.first + two.second, one_end);
+            } catch (...) {
+                detail::destroy(new_slots, one_end);
+                std::allocator<T>().deallocate(new_slots, new_capacity);
+                throw;
+            }
+            detail::destroy(
+                one.first, one.first + one.second);
+            detail::destroy(
+                two.first, two.first + two.second);
+        }
+
+        // Only growing buffers have slots to set or free.
+        void set_slots(T * slots, size_type capacity) noexcept
+        {
+            set_slots(slots, capacity, storage_);
+        }
+        static void set_slots(
+            T * slots, size_type capacity, ring_storage<T, 0> & s) noexcept
+        {
+            s.slots_ = slots;
+            s.capacity_ = capacity;
+        }
+        template<typename Storage>
+        static void set_slots(T *, size_type, Storage &) noexcept
+        {}
+        void free_slots() noexcept
+        {
+            if (!N && storage_.slots())
+                std::allocator<T>().deallocate(storage_.slots(), capacity());
+            set_slots(nullptr, 0);
+        }
+
+        // Expects *this to be empty.
+        void copy_from(circular_buffer const & other)
+        {
+            reserve(other.size_);
+            auto const one = other.array_one();
+            auto const two = other.array_two();
+            write(one.first, one.second);
+            write(two.first, two.second);
+        }
+        // Takes the elements of other, which is left empty.  A growing buffer
+        // takes other's slots; a fixed one moves the elements one span at a
+        // time.  Expects *this to be empty, and free of slots.
+        void steal(circular_buffer & other) noexcept(nothrow_steal)
+        {
+            if (!N) {
+                std::swap(storage_, other.storage_);
+                head_ = other.head_;
+                size_ = other.size_;
+                other.head_ = 0;
+                other.size_ = 0;
+                return;
+            }
+            head_ = 0;
+            auto const one = other.array_one();
+            auto const two = other.array_two();
+            stl_interfaces::uninitialized_relocate(
+                one.first, one.first + one.second, storage_.slots());
+            stl_interfaces::uninitialized_relocate(
+                two.first,
+                two.first + two.second,
+                storage_.slots() + one.second);
+            size_ = other.size_;
+            other.head_ = 0;
+            other.size_ = 0;
+        }
+
+        ring_storage<T, N> storage_;
+        size_type head_; // Unmasked; the first element is in slot(head_).
+        size_type size_;
+    };
+    //]
+
+}}}
+
+#endif
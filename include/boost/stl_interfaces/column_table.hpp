@@ -0,0 +1,139 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_COLUMN_TABLE_HPP
+#define BOOST_STL_INTERFACES_COLUMN_TABLE_HPP
+
+#include <boost/stl_interfaces/soa_vector.hpp>
+
+#include <boost/stl_interfaces/view_interface.hpp>
+
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <cstddef>
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+    //[ column_table_views
+    // One column of a column_table: a contiguous range of the column's values.
+    // view_interface provides data(), size(), operator[], and the rest, just as
+    // for a subrange of a std::vector.
+    template<typename T>
+    struct column_view : view_interface<
+                             column_view<T>,
+                             element_layout::contiguous>
+    {
+        column_view() noexcept : first_(nullptr), last_(nullptr) {}
+        column_view(T * first, std::size_t size) noexcept :
+            first_(first),
+            last_(first + size)
+        {}
+
+        T * begin() const noexcept { return first_; }
+        T * end() const noexcept { return last_; }
+
+    private:
+        T * first_;
+        T * last_;
+    };
+
+    // Some of the columns of a column_table, as rows.  Its iterator is
+    // soa_vector's soa_iterator, over the arrays of only the chosen columns, so
+    // iterating reads only their memory.
+    template<typename... Ts>
+    struct projection_view : view_interface<projection_view<Ts...>>
+    {
+        using iterator = soa_iterator<Ts...>;
+
+        projection_view() noexcept : columns_(), size_(0) {}
+        projection_view(
+            std::tuple<Ts *...> columns, std::size_t size) noexcept :
+            columns_(columns),
+            size_(size)
+        {}
+
+        iterator begin() const noexcept { return iterator(columns_, 0); }
+        iterator end() const noexcept
+        {
+            return iterator(columns_, std::ptrdiff_t(size_));
+        }
+
+    private:
+        std::tuple<Ts *...> columns_;
+        std::size_t size_;
+    };
+    //]
+
+    //[ column_table_defn
+    // column_table<std::tuple<Ts...>> is a table whose rows are
+    // std::tuple<Ts...>s, stored column by column.  It is a soa_vector<Ts...>
+    // -- rows are added, erased, sorted, and compared through soa_vector's
+    // container API and its proxy row iterator -- with two more ways to look at
+    // the data: column<I>() is the I-th column, as a contiguous view; and
+    // select<I, J, ...>() is a view of rows made of only columns I, J, ....  A
+    // query that uses two columns of a twenty-column table reads only those two
+    // columns' memory, where a scan over a std::vector of twenty-field structs
+    // pulls every field of every row through the cache.
+    template<typename Schema>
+    struct column_table;
+
+    template<typename... Ts>
+    struct column_table<std::tuple<Ts...>> : soa_vector<Ts...>
+    {
+        using schema = std::tuple<Ts...>;
+        using base_type = soa_vector<Ts...>;
+
+        template<std::size_t I>
+        using column_type = std::tuple_element_t<I, schema>;
+
+        using base_type::base_type;
+        column_table() = default;
+
+        static constexpr std::size_t columns() noexcept
+        {
+            return sizeof...(Ts);
+        }
+
+        template<std::size_t I>
+        column_view<column_type<I>> column() noexcept
+        {
+            return column_view<column_type<I>>(
+                this->template data<I>(), this->size());
+        }
+        template<std::size_t I>
+        column_view<column_type<I> const> column() const noexcept
+        {
+            return column_view<column_type<I> const>(
+                this->template data<I>(), this->size());
+        }
+
+        template<std::size_t... Is>
+        projection_view<column_type<Is>...> select() noexcept
+        {
+            static_assert(0 < sizeof...(Is), "Select at least one column.");
+            return projection_view<column_type<Is>...>(
+                std::make_tuple(this->template data<Is>()...), this->size());
+        }
+        template<std::size_t... Is>
+        projection_view<column_type<Is> const...> select() const noexcept
+        {
+            static_assert(0 < sizeof...(Is), "Select at least one column.");
+            return projection_view<column_type<Is> const...>(
+                std::make_tuple(this->template data<Is>()...), this->size());
+        }
+    };
+
+    // Like soa_vector, a column_table is a few pointers and sizes.
+    template<typename Schema>
+    struct is_trivially_relocatable<column_table<Schema>> : std::true_type
+    {};
+    //]
+
+}}}
+
+#endif
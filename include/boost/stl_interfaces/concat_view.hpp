@@ -0,0 +1,219 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_CONCAT_VIEW_HPP
+#define BOOST_STL_INTERFACES_CONCAT_VIEW_HPP
+
+#include <boost/stl_interfaces/iterator_interface.hpp>
+#include <boost/stl_interfaces/segmented_iterator.hpp>
+#include <boost/stl_interfaces/view_interface.hpp>
+
+#include <array>
+#include <iterator>
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+    /** One of the ranges that a `concat_view` joins. */
+    template<typename Iter>
+    struct concat_segment
+    {
+        Iter first;
+        Iter last;
+    };
+
+    template<typename Iter>
+    struct concat_iterator;
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    namespace v1_dtl {
+        template<typename Iter>
+        using concat_category_t = std::conditional_t<
+            std::is_convertible<
+                typename std::iterator_traits<Iter>::iterator_category,
+                std::bidirectional_iterator_tag>::value,
+            std::bidirectional_iterator_tag,
+            std::forward_iterator_tag>;
+
+        template<typename Iter>
+        using concat_iterator_interface_t = iterator_interface<
+            concat_iterator<Iter>,
+            concat_category_t<Iter>,
+            typename std::iterator_traits<Iter>::value_type,
+            typename std::iterator_traits<Iter>::reference,
+            typename std::iterator_traits<Iter>::pointer,
+            iter_difference_t<Iter>>;
+    }
+
+#endif
+
+    /** An iterator over the elements of a sequence of ranges of the same
+        iterator type `Iter`, one after another, like the iterator of
+        `std::views::concat`.  It is bidirectional if `Iter` is, and forward
+        otherwise; empty ranges are skipped.
+
+        It models the segmented iterator protocol, with the ranges as the
+        segments and `Iter` as the local iterator, so `segmented_copy()`,
+        `segmented_find()`, `segmented_accumulate()`, and the rest run a
+        loop over `Iter` on each range, rather than one loop that checks
+        for the end of a range at each step.
+
+        The segments are a `concat_segment<Iter>` array that the iterator
+        refers to, and that must outlive it; `concat_view` keeps it.
+
+        \see `concat_view`, `segmented_iterator_traits` */
+    template<typename Iter>
+    struct concat_iterator : v1_dtl::concat_iterator_interface_t<Iter>
+    {
+        using segment_type = concat_segment<Iter>;
+
+        constexpr concat_iterator() = default;
+        /** Constructs an iterator at `it` in the segment `seg`, in the
+            array of segments that ends with `last_seg`.  If `it` is the end
+            of `seg`, the iterator moves on to the next nonempty segment, or
+            to the end of `last_seg`. */
+        constexpr concat_iterator(
+            segment_type const * seg,
+            segment_type const * last_seg,
+            Iter it) :
+            seg_(seg), last_seg_(last_seg), it_(it)
+        {
+            skip_empty();
+        }
+
+        constexpr concat_iterator & operator++()
+        {
+            ++it_;
+            skip_empty();
+            return *this;
+        }
+        template<typename I = Iter>
+        constexpr auto operator--() -> decltype(
+            --std::declval<I &>(), std::declval<concat_iterator &>())
+        {
+            while (it_ == seg_->first) {
+                --seg_;
+                it_ = seg_->last;
+            }
+            --it_;
+            return *this;
+        }
+
+        friend constexpr bool
+        operator==(concat_iterator lhs, concat_iterator rhs)
+        {
+            return lhs.seg_ == rhs.seg_ && lhs.it_ == rhs.it_;
+        }
+
+        using base_type = v1_dtl::concat_iterator_interface_t<Iter>;
+        using base_type::operator++;
+        using base_type::operator--;
+
+    private:
+        friend access;
+
+        constexpr Iter & base_reference() noexcept { return it_; }
+        constexpr Iter const & base_reference() const noexcept { return it_; }
+
+        constexpr segment_type const * segment() const noexcept
+        {
+            return seg_;
+        }
+        constexpr Iter local() const { return it_; }
+        constexpr Iter local_begin(segment_type const * seg) const
+        {
+            return seg->first;
+        }
+        constexpr Iter local_end(segment_type const * seg) const
+        {
+            return seg->last;
+        }
+        constexpr concat_iterator
+        compose(segment_type const * seg, Iter it) const
+        {
+            return concat_iterator(seg, last_seg_, it);
+        }
+
+        // Keeps it_ off the end of any segment but the last.
+        constexpr void skip_empty()
+        {
+            while (it_ == seg_->last && seg_ != last_seg_) {
+                ++seg_;
+                it_ = seg_->first;
+            }
+        }
+
+        segment_type const * seg_ = nullptr;
+        segment_type const * last_seg_ = nullptr;
+        Iter it_ = Iter();
+    };
+
+    /** A view of the elements of `N` ranges of the same iterator type
+        `Iter`, one after another.  Its iterators are
+        `concat_iterator<Iter>`s, which refer to the view, so the view must
+        outlive them.  Only the ranges' iterators are kept, so the ranges
+        must outlive the view.
+
+        Algorithms that use the segmented iterator protocol -- the
+        `segmented_*()` ones -- run over each range with `Iter`, so a query
+        over a live buffer and a few spilled ones is as fast as over a
+        single buffer, without first copying them into one.
+
+        \see `make_concat_view()` */
+    template<typename Iter, std::size_t N>
+    struct concat_view : view_interface<concat_view<Iter, N>>
+    {
+        static_assert(0 < N, "A concat_view must join at least one range.");
+
+        using iterator = concat_iterator<Iter>;
+        using segment_type = concat_segment<Iter>;
+
+        constexpr concat_view() = default;
+        constexpr concat_view(std::array<segment_type, N> const & segments) :
+            segments_(segments)
+        {}
+
+        constexpr iterator begin() const
+        {
+            return iterator(
+                segments_.data(),
+                segments_.data() + N - 1,
+                segments_.front().first);
+        }
+        constexpr iterator end() const
+        {
+            return iterator(
+                segments_.data() + N - 1,
+                segments_.data() + N - 1,
+                segments_.back().last);
+        }
+
+        /** Returns the ranges that `*this` joins. */
+        constexpr std::array<segment_type, N> const & segments() const noexcept
+        {
+            return segments_;
+        }
+
+    private:
+        std::array<segment_type, N> segments_;
+    };
+
+    /** Returns a `concat_view` of `rs...`, which must be common ranges with
+        the same iterator type. */
+    template<typename Range, typename... Ranges>
+    constexpr auto make_concat_view(Range && r, Ranges &&... rs)
+    {
+        using iterator = decltype(std::begin(r));
+        using segment_type = concat_segment<iterator>;
+        return concat_view<iterator, 1 + sizeof...(Ranges)>(
+            std::array<segment_type, 1 + sizeof...(Ranges)>{
+                {segment_type{std::begin(r), std::end(r)},
+                 segment_type{std::begin(rs), std::end(rs)}...}});
+    }
+
+}}}
+
+#endif
@@ -0,0 +1,444 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_CONCURRENT_APPEND_VECTOR_HPP
+#define BOOST_STL_INTERFACES_CONCURRENT_APPEND_VECTOR_HPP
+
+#include <boost/stl_interfaces/container_interface.hpp>
+#include <boost/stl_interfaces/reverse_iterator.hpp>
+#include <boost/stl_interfaces/segmented_iterator.hpp>
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    namespace v1_dtl {
+        // The index of the highest set bit of x, which must not be 0.
+        inline int cav_high_bit(std::uint64_t x) noexcept
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            return 63 - __builtin_clzll(x);
+#elif defined(_MSC_VER) && defined(_M_X64)
+            unsigned long i;
+            _BitScanReverse64(&i, x);
+            return int(i);
+#else
+            int i = 0;
+            while (x >>= 1)
+                ++i;
+            return i;
+#endif
+        }
+
+        // The index of the lowest set bit of x, which must not be 0.
+        inline int cav_low_bit(std::uint64_t x) noexcept
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            return __builtin_ctzll(x);
+#elif defined(_MSC_VER) && defined(_M_X64)
+            unsigned long i;
+            _BitScanForward64(&i, x);
+            return int(i);
+#else
+            int i = 0;
+            for (; !(x & 1u); x >>= 1) {
+                ++i;
+            }
+            return i;
+#endif
+        }
+
+        // Bucket b holds cav_first << b elements, so that element i is
+        // element (i + cav_first) - 2^h of bucket h - cav_first_bits, where
+        // h is the highest set bit of i + cav_first.  With 64 elements in
+        // the first, every bucket's ready bits fill whole words.
+        constexpr int cav_first_bits = 6;
+        constexpr std::uint64_t cav_first = std::uint64_t(1)
+                                            << cav_first_bits;
+        constexpr int cav_buckets = 64 - cav_first_bits;
+
+        struct cav_position
+        {
+            std::size_t bucket;
+            std::size_t offset;
+        };
+
+        inline cav_position cav_locate(std::size_t i) noexcept
+        {
+            std::uint64_t const j = std::uint64_t(i) + cav_first;
+            int const h = v1_dtl::cav_high_bit(j);
+            return cav_position{
+                std::size_t(h - cav_first_bits),
+                std::size_t(j ^ (std::uint64_t(1) << h))};
+        }
+
+        inline std::size_t cav_bucket_size(std::size_t b) noexcept
+        {
+            return std::size_t(cav_first << b);
+        }
+
+        // The index of the first element of bucket b.
+        inline std::size_t cav_bucket_first(std::size_t b) noexcept
+        {
+            return std::size_t((cav_first << b) - cav_first);
+        }
+    }
+
+#endif
+
+    template<typename T>
+    struct concurrent_append_vector;
+
+    /** `concurrent_append_vector` destroys its elements itself, so
+        `container_interface` does not need to call `clear()`. */
+    template<typename T>
+    struct trivially_destructible_container<concurrent_append_vector<T>>
+        : std::true_type
+    {
+    };
+
+    /** The iterator of a `concurrent_append_vector`: a pointer to its table
+        of buckets, and an index.  Dereferencing it finds the bucket and the
+        offset in it from the index's highest set bit, with one `clz`
+        instruction where there is one.
+
+        It models the segmented iterator protocol, with the buckets as the
+        segments and pointers as the local iterators, so the `segmented_*()`
+        algorithms run over each bucket with pointers.  As with
+        `partitioned_vector_iterator`, an index at the start of a bucket is
+        treated as the end of the bucket before it, since the bucket it
+        starts may not have been allocated. */
+    template<typename T>
+    struct concurrent_append_vector_iterator
+        : iterator_interface<
+              concurrent_append_vector_iterator<T>,
+              std::random_access_iterator_tag,
+              std::remove_const_t<T>>
+    {
+        using bucket_pointer = std::atomic<std::remove_const_t<T> *> const *;
+
+        concurrent_append_vector_iterator() noexcept = default;
+        concurrent_append_vector_iterator(
+            bucket_pointer buckets, std::ptrdiff_t i) noexcept :
+            buckets_(buckets), i_(i)
+        {}
+        template<
+            typename U,
+            typename E = std::enable_if_t<
+                std::is_same<T, U const>::value &&
+                !std::is_same<T, U>::value>>
+        concurrent_append_vector_iterator(
+            concurrent_append_vector_iterator<U> other) noexcept :
+            buckets_(other.buckets_), i_(other.i_)
+        {}
+
+        T & operator*() const noexcept
+        {
+            auto const pos = v1_dtl::cav_locate(std::size_t(i_));
+            return buckets_[pos.bucket].load(std::memory_order_relaxed)
+                [pos.offset];
+        }
+        concurrent_append_vector_iterator &
+        operator+=(std::ptrdiff_t n) noexcept
+        {
+            i_ += n;
+            return *this;
+        }
+        friend std::ptrdiff_t operator-(
+            concurrent_append_vector_iterator lhs,
+            concurrent_append_vector_iterator rhs) noexcept
+        {
+            return lhs.i_ - rhs.i_;
+        }
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+    private:
+        template<typename U>
+        friend struct concurrent_append_vector_iterator;
+        friend access;
+
+        std::size_t segment() const noexcept
+        {
+            return i_ ? v1_dtl::cav_locate(std::size_t(i_ - 1)).bucket : 0;
+        }
+        T * local() const noexcept
+        {
+            auto const seg = segment();
+            return local_begin(seg) +
+                   (std::size_t(i_) - v1_dtl::cav_bucket_first(seg));
+        }
+        T * local_begin(std::size_t seg) const noexcept
+        {
+            return buckets_[seg].load(std::memory_order_relaxed);
+        }
+        T * local_end(std::size_t seg) const noexcept
+        {
+            return local_begin(seg) + v1_dtl::cav_bucket_size(seg);
+        }
+        concurrent_append_vector_iterator
+        compose(std::size_t seg, T * it) const noexcept
+        {
+            return concurrent_append_vector_iterator(
+                buckets_,
+                std::ptrdiff_t(
+                    v1_dtl::cav_bucket_first(seg) +
+                    std::size_t(it - local_begin(seg))));
+        }
+
+        bucket_pointer buckets_ = nullptr;
+        std::ptrdiff_t i_ = 0;
+#endif
+    };
+
+    /** A sequence that any number of threads may append to at once, while
+        others read it.  Its elements are in buckets of 64, 128, 256, ...
+        elements, which are never moved, so references and iterators to
+        them stay valid as the sequence grows.
+
+        `emplace_back()` and `push_back()` take a slot with one `fetch_add`
+        on a counter, and construct the element in it.  A thread whose slot
+        is in a bucket that is not allocated yet allocates it, and installs
+        it with a compare-exchange, which only one of several such threads
+        wins; no appending thread ever waits for another.  `size()` is the
+        length of the prefix of the slots whose elements are all
+        constructed, so a reader may iterate over `[begin(), begin() +
+        size())`, or take `begin()` and `end()` once, while appends go on.
+        An appender whose slot is at `size()` advances it past the slot,
+        and past any later slots that are done; one whose slot is beyond it
+        sets a ready bit for the slot, and leaves the advance to the
+        appender of an earlier slot, which is not done yet.
+
+        `T` must be nothrow move constructible: the element is constructed
+        in a temporary first, and moved into its slot once it has one, so
+        that a slot is never taken and left empty.  If allocating a bucket
+        throws, `std::terminate()` is called, since the slot has been taken
+        by then; `reserve()` allocates them in advance.
+
+        There is no `erase()`, `clear()` or `pop_back()`.  The vector can be
+        neither copied nor moved, since other threads may refer to it.
+
+        \see `container_interface` */
+    template<typename T>
+    struct concurrent_append_vector
+        : container_interface<concurrent_append_vector<T>>
+    {
+        static_assert(
+            std::is_nothrow_move_constructible<T>::value,
+            "concurrent_append_vector<T> requires that T be nothrow move "
+            "constructible.");
+
+        using value_type = T;
+        using reference = T &;
+        using const_reference = T const &;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using iterator = concurrent_append_vector_iterator<T>;
+        using const_iterator = concurrent_append_vector_iterator<T const>;
+        using reverse_iterator = stl_interfaces::reverse_iterator<iterator>;
+        using const_reverse_iterator =
+            stl_interfaces::reverse_iterator<const_iterator>;
+
+        concurrent_append_vector() noexcept
+        {
+            for (auto & b : buckets_) {
+                b.store(nullptr, std::memory_order_relaxed);
+            }
+            for (auto & r : ready_) {
+                r.store(nullptr, std::memory_order_relaxed);
+            }
+        }
+        concurrent_append_vector(concurrent_append_vector const &) = delete;
+        concurrent_append_vector &
+        operator=(concurrent_append_vector const &) = delete;
+        ~concurrent_append_vector()
+        {
+            size_type const n = taken_.load(std::memory_order_relaxed);
+            for (size_type b = 0; b < size_type(v1_dtl::cav_buckets); ++b) {
+                T * const data = buckets_[b].load(std::memory_order_relaxed);
+                if (data) {
+                    size_type const first = v1_dtl::cav_bucket_first(b);
+                    size_type const last =
+                        (std::min)(n, first + v1_dtl::cav_bucket_size(b));
+                    for (size_type i = first; i < last; ++i) {
+                        data[i - first].~T();
+                    }
+                    std::allocator<T>().deallocate(
+                        data, v1_dtl::cav_bucket_size(b));
+                }
+                delete[] ready_[b].load(std::memory_order_relaxed);
+            }
+        }
+
+        /** Constructs an element from `args` at the end, and returns a
+            reference to it.  Safe to call from any number of threads at
+            once, and alongside readers. */
+        template<typename... Args>
+        reference emplace_back(Args &&... args)
+        {
+            T x(std::forward<Args>(args)...);
+            return append(std::move(x));
+        }
+
+        /** Allocates the buckets for the first `n` elements, if they have
+            not been.  Safe to call alongside appends and readers. */
+        void reserve(size_type n)
+        {
+            for (size_type b = 0;
+                 b < size_type(v1_dtl::cav_buckets) &&
+                 v1_dtl::cav_bucket_first(b) < n;
+                 ++b) {
+                bucket(b);
+            }
+        }
+
+        iterator begin() noexcept { return iterator(buckets_, 0); }
+        iterator end() noexcept
+        {
+            return iterator(buckets_, difference_type(size()));
+        }
+
+        /** Returns the number of elements whose appends have finished, and
+            all of whose predecessors' have. */
+        size_type size() const noexcept
+        {
+            return size_.load(std::memory_order_acquire);
+        }
+        size_type max_size() const noexcept
+        {
+            return size_type(std::numeric_limits<difference_type>::max());
+        }
+        /** Returns the number of elements that the allocated buckets can
+            hold. */
+        size_type capacity() const noexcept
+        {
+            size_type b = 0;
+            while (b < size_type(v1_dtl::cav_buckets) &&
+                   buckets_[b].load(std::memory_order_acquire)) {
+                ++b;
+            }
+            return v1_dtl::cav_bucket_first(b);
+        }
+
+        using base_type = container_interface<concurrent_append_vector<T>>;
+        using base_type::begin;
+        using base_type::end;
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+    private:
+        using ready_word = std::atomic<std::uint64_t>;
+
+        reference append(T && x) noexcept
+        {
+            size_type const i = taken_.fetch_add(1, std::memory_order_relaxed);
+            BOOST_ASSERT(i < max_size());
+            auto const pos = v1_dtl::cav_locate(i);
+            T * const data = bucket(pos.bucket);
+            T * const retval = ::new (data + pos.offset) T(std::move(x));
+            publish(i, pos);
+            return *retval;
+        }
+
+        // Advances size_ past slot i, whose element is constructed, and
+        // past the ready slots after it, if size_ is at i.  If size_ is
+        // short of i, this sets i's ready bit, and leaves the advance to the
+        // appender of the slot that size_ is at, unless size_ has reached i
+        // in the meantime.  The ready bits and size_ are seq_cst, so that
+        // the appender that advances size_ to i sees i's bit, or the
+        // appender of i sees size_ at i.  When size_ is at i already, as it
+        // is when there is no contention, the bit is not needed.
+        void publish(size_type i, v1_dtl::cav_position pos) noexcept
+        {
+            size_type n = i;
+            if (!size_.compare_exchange_strong(n, i + 1)) {
+                BOOST_ASSERT(n < i);
+                ready_[pos.bucket]
+                    .load(std::memory_order_relaxed)[pos.offset / 64]
+                    .fetch_or(std::uint64_t(1) << (pos.offset % 64));
+                n = i;
+                if (!size_.compare_exchange_strong(n, i + 1))
+                    return;
+            }
+            // A slot that was not ready when scanned, but was by the time
+            // size_ reached it, is seen by the next scan.
+            for (++i;;) {
+                size_type const last = first_unready(i);
+                if (last == i)
+                    return;
+                n = i;
+                if (!size_.compare_exchange_strong(n, last))
+                    return;
+                i = last;
+            }
+        }
+
+        // Returns the first slot at or after i whose ready bit is clear.
+        size_type first_unready(size_type i) const noexcept
+        {
+            for (;;) {
+                auto const pos = v1_dtl::cav_locate(i);
+                ready_word * const words = ready_[pos.bucket].load();
+                if (!words)
+                    return i;
+                std::uint64_t const unready =
+                    ~words[pos.offset / 64].load() >> (pos.offset % 64);
+                if (unready)
+                    return i + size_type(v1_dtl::cav_low_bit(unready));
+                i += 64 - pos.offset % 64;
+            }
+        }
+
+        // Returns bucket b, allocating it if no thread has yet.  Its ready
+        // bits are published before its elements, so that a thread that
+        // sees the bucket also sees them.
+        T * bucket(size_type b)
+        {
+            T * data = buckets_[b].load(std::memory_order_acquire);
+            if (data)
+                return data;
+            size_type const n = v1_dtl::cav_bucket_size(b);
+            std::unique_ptr<ready_word[]> words(new ready_word[n / 64]);
+            for (size_type w = 0; w < n / 64; ++w) {
+                words[w].store(0, std::memory_order_relaxed);
+            }
+            ready_word * expected_words = nullptr;
+            if (ready_[b].compare_exchange_strong(expected_words, words.get()))
+                words.release();
+            std::allocator<T> alloc;
+            T * const fresh = alloc.allocate(n);
+            if (!buckets_[b].compare_exchange_strong(
+                    data, fresh, std::memory_order_acq_rel)) {
+                alloc.deallocate(fresh, n);
+                return data;
+            }
+            return fresh;
+        }
+
+        std::atomic<T *> buckets_[v1_dtl::cav_buckets];
+        std::atomic<ready_word *> ready_[v1_dtl::cav_buckets];
+        alignas(64) std::atomic<size_type> taken_{0};
+        alignas(64) std::atomic<size_type> size_{0};
+#endif
+    };
+
+}}}
+
+#endif
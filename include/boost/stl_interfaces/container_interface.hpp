@@ -7,13 +7,19 @@
 #define BOOST_STL_INTERFACES_CONTAINER_INTERFACE_HPP
 
 #include <boost/stl_interfaces/reverse_iterator.hpp>
+#include <boost/stl_interfaces/trivially_relocatable.hpp>
+#include <boost/stl_interfaces/detail/simd.hpp>
 
 #include <boost/assert.hpp>
 #include <boost/config.hpp>
 
 #include <algorithm>
+#include <functional>
+#include <ratio>
 #include <stdexcept>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
 
 
 namespace boost { namespace stl_interfaces { namespace detail {
@@ -60,24 +66,233 @@ namespace boost { namespace stl_interfaces { namespace detail {
         return n_iter<T, SizeType>(x, n);
     }
 
-    template<typename Container>
-    std::size_t fake_capacity(Container const & c)
+    template<typename T, typename SizeType, typename OutIter>
+    constexpr OutIter n_iter_copy_impl(
+        n_iter<T, SizeType> first,
+        n_iter<T, SizeType> last,
+        OutIter out,
+        std::true_type)
     {
-        return SIZE_MAX;
+        T const value = *first;
+        return std::fill_n(out, last - first, value);
     }
-    template<
-        typename Container,
-        typename Enable = decltype(
-            std::size_t() = std::declval<Container const &>().capacity())>
-    std::size_t fake_capacity(Container const & c)
+    template<typename T, typename SizeType, typename OutIter>
+    constexpr OutIter n_iter_copy_impl(
+        n_iter<T, SizeType> first,
+        n_iter<T, SizeType> last,
+        OutIter out,
+        std::false_type)
     {
-        return c.capacity();
+        for (; first != last; ++first, ++out) {
+            *out = *first;
+        }
+        return out;
     }
 
+    // Copies [first, last) to out, as std::copy() does.  For trivially
+    // copyable T, this is a std::fill_n() of a local copy of the value,
+    // which is a memset() for bytes, and a loop that holds the value in a
+    // register otherwise; through the reference in n_iter, the value has to
+    // be reloaded after every store.
+    template<typename T, typename SizeType, typename OutIter>
+    constexpr OutIter n_iter_copy(
+        n_iter<T, SizeType> first, n_iter<T, SizeType> last, OutIter out)
+    {
+        return detail::n_iter_copy_impl(
+            first, last, out, std::is_trivially_copyable<T>{});
+    }
+
+    template<typename Container>
+    using capacity_member_t = decltype(
+        std::declval<std::size_t &>() =
+            std::declval<Container const &>().capacity());
+    template<typename Container>
+    using max_size_member_t = decltype(
+        std::declval<std::size_t &>() =
+            std::declval<Container const &>().max_size());
+    template<typename Container>
+    using reserve_member_t = decltype(std::declval<Container &>().reserve(
+        std::declval<typename Container::size_type>()));
+
 }}}
 
 namespace boost { namespace stl_interfaces { inline namespace v1 {
 
+    /** A type trait that may be specialized to be `std::true_type` for a
+        container type `D` derived from `container_interface`, if `D` does
+        not need its elements destroyed by `clear()` -- because they are
+        trivially destructible, or because a member of `D` destroys them.
+        `container_interface<D>`'s destructor then does not call `clear()`,
+        and is trivial; this lets `D` be trivially copyable, and a literal
+        type, when its members are.
+
+        It is `std::false_type` by default.  The specialization must be
+        visible wherever `container_interface<D>` is instantiated -- that is,
+        before the definition of `D`. */
+    template<typename D>
+    struct trivially_destructible_container : std::false_type
+    {
+    };
+
+    /** A base for specializations of `container_op_hooks`, with a hook that
+        does nothing for each operation that a specialization does not
+        observe. */
+    struct container_op_hooks_base
+    {
+        static constexpr bool enabled = true;
+
+        /** Called when the `capacity()` of `d` grew from `old_capacity` to
+            `new_capacity`. */
+        template<typename D>
+        static void grow(
+            D const & d, std::size_t old_capacity, std::size_t new_capacity)
+        {}
+        /** Called when `n` elements were added to `d`. */
+        template<typename D>
+        static void insert(D const & d, std::size_t n)
+        {}
+        /** Called when `n` elements were removed from `d`. */
+        template<typename D>
+        static void erase(D const & d, std::size_t n)
+        {}
+        /** Called when `n` elements already in `d` were assigned over, or
+            shifted to make room for new ones. */
+        template<typename D>
+        static void moves(D const & d, std::size_t n)
+        {}
+    };
+
+    /** A policy that may be specialized for a container type `D` derived
+        from `container_interface`, to observe the operations performed by
+        the members that `container_interface<D>` defines for it:
+        `assign()`, the bulk `insert()`s, `insert_range()`,
+        `append_range()`, `resize()`, `resize_for_overwrite()`, and
+        `clear()`.  A specialization derives from `container_op_hooks_base`,
+        and hides those of its static member functions that it needs; each
+        is called after the operation, with the container as it is then.
+        Histograms of the sizes passed to `insert()`, say, are what it takes
+        to choose a good inline capacity for a small vector.
+
+        Only the members of `container_interface` report their operations;
+        the members defined by `D` itself do not.  The specialization must be
+        visible wherever one of those members is first called.  By default,
+        and for every `D` when `BOOST_STL_INTERFACES_DISABLE_CONTAINER_HOOKS`
+        is defined, nothing is observed, and the members do no extra
+        work. */
+    template<typename D>
+    struct container_op_hooks : container_op_hooks_base
+    {
+        static constexpr bool enabled = false;
+    };
+
+    /** The growth policy that `container_growth_policy<D>` uses by default.
+        It uses `D`'s `capacity()`, `max_size()` and `reserve()` members,
+        when `D` has them, and grows the capacity by `GrowthFactor`, a
+        `std::ratio` greater than 1. */
+    template<typename D, typename GrowthFactor = std::ratio<2>>
+    struct default_container_growth_policy
+    {
+        static_assert(
+            GrowthFactor::den < GrowthFactor::num,
+            "GrowthFactor must be greater than 1.");
+
+        using growth_factor = GrowthFactor;
+
+        /** True if `D` has `reserve()`. */
+        static constexpr bool reservable =
+            detail::detector<void, detail::reserve_member_t, D>::value;
+
+        /** Returns `d.capacity()`, or `SIZE_MAX` -- room for any number of
+            elements -- if `D` has no `capacity()`. */
+        static constexpr std::size_t capacity(D const & d)
+        {
+            return capacity_impl(
+                d,
+                std::integral_constant<
+                    bool,
+                    detail::detector<void, detail::capacity_member_t, D>::
+                        value>{});
+        }
+
+        /** Returns `d.max_size()`, or `SIZE_MAX` if `D` has no
+            `max_size()`. */
+        static constexpr std::size_t max_size(D const & d)
+        {
+            return max_size_impl(
+                d,
+                std::integral_constant<
+                    bool,
+                    detail::detector<void, detail::max_size_member_t, D>::
+                        value>{});
+        }
+
+        /** Calls `d.reserve(n)`, or does nothing if `D` has no
+            `reserve()`. */
+        static constexpr void reserve(D & d, std::size_t n)
+        {
+            reserve_impl(d, n, std::integral_constant<bool, reservable>{});
+        }
+
+        /** Returns the capacity that `d` should grow to, to hold `n`
+            elements: its capacity times the growth factor, or `n` if that
+            is more, but no more than `max_size(d)` unless `n` is.  This is
+            `capacity(d)` if `n` elements already fit. */
+        static constexpr std::size_t grown_capacity(D const & d, std::size_t n)
+        {
+            auto const old_capacity = capacity(d);
+            if (n <= old_capacity)
+                return old_capacity;
+            auto const limit = (std::max)(max_size(d), n);
+            auto const num = std::size_t(growth_factor::num);
+            auto const den = std::size_t(growth_factor::den);
+            auto const grown = old_capacity <= limit / num
+                                   ? old_capacity * num / den
+                                   : limit;
+            return (std::max)(n, grown);
+        }
+
+    private:
+        static constexpr std::size_t capacity_impl(D const & d, std::true_type)
+        {
+            return d.capacity();
+        }
+        static constexpr std::size_t capacity_impl(D const &, std::false_type)
+        {
+            return SIZE_MAX;
+        }
+        static constexpr std::size_t max_size_impl(D const & d, std::true_type)
+        {
+            return d.max_size();
+        }
+        static constexpr std::size_t max_size_impl(D const &, std::false_type)
+        {
+            return SIZE_MAX;
+        }
+        static constexpr void reserve_impl(D & d, std::size_t n, std::true_type)
+        {
+            d.reserve(typename D::size_type(n));
+        }
+        static constexpr void reserve_impl(D &, std::size_t, std::false_type) {}
+    };
+
+    /** The policy by which the members that `container_interface<D>`
+        defines grow a container of type `D`.  Before they append the
+        elements of a sized range -- by `append_range()`, or by `insert()`
+        or `insert_range()` at `end()` -- they reserve the room for all of
+        them at once, as given by `grown_capacity()`; and when an `assign()`
+        needs more than `capacity()`, they erase the elements and reserve
+        exactly the room needed, so that none of the old elements is moved.
+
+        It may be specialized, e.g. to use another growth factor, by
+        deriving the specialization from
+        `default_container_growth_policy<D, GrowthFactor>`.  The
+        specialization must be visible wherever one of those members is
+        first called. */
+    template<typename D>
+    struct container_growth_policy : default_container_growth_policy<D>
+    {
+    };
+
     /** A CRTP template that one may derive from to make it easier to define
         container types.
 
@@ -94,7 +309,38 @@ namespace boost { namespace stl_interfaces { inline namespace v1 {
         For an object `d` of type `D`, a call to `std::ranges::begin(d)` sxhall
         not mutate any data members of `d`, and `d`'s destructor shall end the
         lifetimes of the objects in `[std::ranges::begin(d),
-        std::ranges::end(d))`. */
+        std::ranges::end(d))`.
+
+        `clear()` is `d.erase(d.begin(), d.end())`, unless `D` has a
+        `destroy_all()` member, which ends the lifetimes of all the elements
+        and empties `d`; then `clear()` is `d.destroy_all()`.  A container
+        can thereby destroy its elements in one pass, or not at all when
+        they are trivially destructible, and reset its size once, where
+        `erase()` would also move the (empty) tail of the sequence.
+
+        `erase_if(pred)` erases the elements that `pred` matches, and
+        `erase_indices(indices)` the ones at the ascending positions in the
+        range `indices`, each with one pass that moves every remaining
+        element at most once, followed by a single `erase()` of the tail.
+        Both return the number of elements erased.
+
+        `insert_sorted(first, last, comp)` inserts the elements of
+        `[first, last)`, which must be sorted by `comp`, into `d`, whose
+        elements must also be, so that `d` remains sorted: they are appended,
+        and the two sorted runs are merged with `std::inplace_merge()`.  It
+        is linear in the final size when there is memory for
+        `std::inplace_merge()`'s buffer.  `comp` defaults to `std::less`.
+
+        For a `D` with bidirectional iterators, `find_last(x)` returns an
+        iterator to the last element equal to `x`, `rfind_if(pred)` one to
+        the last element that `pred` matches, or `end()` if there is none;
+        `copy_reversed_to(out)` copies the elements to `out` back to front,
+        and returns the end of the output.  These scan the elements
+        backward without going through `reverse_iterator`.  If `D` is
+        `contiguous`, `rfind_if()` scans through a pointer; `find_last()`
+        searches for integers, `float`s and `double`s, and
+        `copy_reversed_to()` copies them to a contiguous output, a vector
+        at a time (except in constant evaluation). */
     template<
         typename Derived,
         bool Contiguous = discontiguous
@@ -124,8 +370,716 @@ namespace boost { namespace stl_interfaces { inline namespace v1 {
             static constexpr void call(D & d) noexcept { d.clear(); }
         };
 
+        // std::next() and std::prev() are not constexpr before C++17.
+        template<typename Iter>
+        constexpr Iter next_iter(Iter it)
+        {
+            return ++it;
+        }
+        template<typename Iter>
+        constexpr Iter prev_iter(Iter it)
+        {
+            return --it;
+        }
+
         template<typename D, bool Contiguous>
         void derived_container(container_interface<D, Contiguous> const &);
+
+        // The destructor of container_interface lives in this base, so that
+        // it can be trivial when trivially_destructible_container<D> is
+        // true.
+        template<
+            typename D,
+            bool Trivial = trivially_destructible_container<D>::value>
+        struct container_dtor
+        {
+            ~container_dtor()
+            {
+                clear_impl<D>::call(static_cast<D &>(*this));
+            }
+        };
+        template<typename D>
+        struct container_dtor<D, true>
+        {
+        };
+
+        // The results of calling begin() and end() on a D & (where D may be
+        // const-qualified), computed once per D.  The observers in
+        // container_interface are all written in terms of these, rather than
+        // each repeating the overload resolution of D's begin() and end() in
+        // its return type and noexcept specification.
+        template<typename D>
+        struct container_caps
+        {
+            using iterator = decltype(std::declval<D &>().begin());
+            using sentinel = decltype(std::declval<D &>().end());
+            static constexpr bool nothrow_begin =
+                noexcept(std::declval<D &>().begin());
+            static constexpr bool nothrow_end =
+                noexcept(std::declval<D &>().end());
+            static constexpr bool nothrow_begin_end =
+                nothrow_begin && nothrow_end;
+        };
+
+        template<typename D>
+        using caps_iter_t = typename container_caps<D>::iterator;
+        template<typename D>
+        using caps_sent_t = typename container_caps<D>::sentinel;
+
+        // size() uses the iterators' distance_to() when they are not random
+        // access, but can count the elements between them in one step.
+        template<typename D>
+        using caps_diff_t = decltype(
+            std::declval<caps_sent_t<D> &>() -
+            std::declval<caps_iter_t<D> &>());
+        template<typename D>
+        using distance_size = std::integral_constant<
+            bool,
+            !detail::detector<void, caps_diff_t, D>::value &&
+                std::is_same<caps_iter_t<D>, caps_sent_t<D>>::value &&
+                has_distance_to<caps_iter_t<D>>::value>;
+
+        template<typename Iter>
+        using to_address_t = decltype(
+            stl_interfaces::to_address(std::declval<Iter const &>()));
+
+        // Uses to_address() when it is available, so that data() does not
+        // dereference begin() of an empty container.
+        template<typename Iter>
+        BOOST_STL_INTERFACES_INLINE
+        constexpr auto
+        data_address(Iter const & it, std::true_type) noexcept
+        {
+            return stl_interfaces::to_address(it);
+        }
+        template<typename Iter>
+        BOOST_STL_INTERFACES_INLINE
+        constexpr auto data_address(Iter const & it, std::false_type)
+        {
+            return std::addressof(*it);
+        }
+        template<typename Iter>
+        BOOST_STL_INTERFACES_INLINE
+        constexpr auto data_address(Iter const & it)
+        {
+            return v1_dtl::data_address(
+                it,
+                std::integral_constant<
+                    bool,
+                    detail::detector<void, to_address_t, Iter>::value>{});
+        }
+
+        // True when the elements of [first, last) can be copied into the
+        // storage of a D with memmove().
+        template<typename D, typename Iter, bool Contiguous>
+        using bulk_copyable = std::integral_constant<
+            bool,
+            Contiguous && is_contiguous_iterator<Iter>::value &&
+                std::is_trivially_copyable<typename D::value_type>::value &&
+                std::is_same<
+                    std::remove_cv_t<
+                        typename std::iterator_traits<Iter>::value_type>,
+                    typename D::value_type>::value>;
+
+        template<typename D>
+        using size_member_t = decltype(std::declval<D const &>().size());
+
+        template<typename D>
+        constexpr std::size_t element_count(D const & d, std::true_type)
+        {
+            return d.size();
+        }
+        template<typename D>
+        constexpr std::size_t element_count(D const & d, std::false_type)
+        {
+            return std::distance(d.begin(), d.end());
+        }
+        template<typename D>
+        constexpr std::size_t element_count(D const & d)
+        {
+            return v1_dtl::element_count(
+                d,
+                std::integral_constant<
+                    bool,
+                    detail::detector<void, size_member_t, D>::value>{});
+        }
+
+        // Reports an operation on a D to container_op_hooks<D>: the
+        // constructor takes a snapshot of the size and capacity of d, and
+        // done() reports how they changed since.  When the hooks are
+        // disabled, it does nothing at all.
+        template<
+            typename D,
+            bool Enabled = container_op_hooks<D>::enabled
+#ifdef BOOST_STL_INTERFACES_DISABLE_CONTAINER_HOOKS
+                && false
+#endif
+            >
+        struct op_trace
+        {
+            constexpr explicit op_trace(D const &) noexcept {}
+
+            template<typename Iter>
+            constexpr std::size_t tail(D const &, Iter) const noexcept
+            {
+                return 0;
+            }
+            constexpr void done(D const &, std::size_t = 0) const noexcept {}
+        };
+        template<typename D>
+        struct op_trace<D, true>
+        {
+            using hooks = container_op_hooks<D>;
+
+            explicit op_trace(D const & d) :
+                size_(v1_dtl::element_count(d)),
+                capacity_(container_growth_policy<D>::capacity(d))
+            {}
+
+            // The number of elements that an insertion at pos shifts.
+            template<typename Iter>
+            std::size_t tail(D const & d, Iter pos) const
+            {
+                return std::distance(pos, Iter(d.end()));
+            }
+
+            void done(D const & d, std::size_t moves = 0) const
+            {
+                auto const size = v1_dtl::element_count(d);
+                auto const capacity =
+                    container_growth_policy<D>::capacity(d);
+                if (capacity_ < capacity)
+                    hooks::grow(d, capacity_, capacity);
+                if (size_ < size)
+                    hooks::insert(d, size - size_);
+                else if (size < size_)
+                    hooks::erase(d, size_ - size);
+                if (moves)
+                    hooks::moves(d, moves);
+            }
+
+        private:
+            std::size_t size_;
+            std::size_t capacity_;
+        };
+
+        // A container with checked iterators (see checked_iterator.hpp)
+        // counts the operations that invalidate them; the ones implemented
+        // here in terms of the container's own members, which do not all
+        // invalidate every iterator by themselves, report themselves.
+        template<typename D>
+        using invalidate_iterators_t =
+            decltype(access::invalidate_iterators(std::declval<D &>()));
+        template<typename D>
+        constexpr void invalidate_iterators(D & d, std::true_type) noexcept
+        {
+            access::invalidate_iterators(d);
+        }
+        template<typename D>
+        constexpr void invalidate_iterators(D &, std::false_type) noexcept
+        {}
+        template<typename D>
+        constexpr void invalidate_iterators(D & d) noexcept
+        {
+            v1_dtl::invalidate_iterators(
+                d,
+                std::integral_constant<
+                    bool,
+                    detail::detector<void, invalidate_iterators_t, D>::
+                        value>{});
+        }
+
+        // Moves the elements of [first, last) that are not at one of the
+        // ascending indices in [i, i_last) down over the ones that are,
+        // keeping their order, and returns the new end.  Each run of kept
+        // elements between two indices is moved with one std::move(), which
+        // is a memmove() when Iter is a pointer to trivially copyable
+        // elements.
+        template<typename Iter, typename IndexIter>
+        constexpr Iter
+        remove_indices(Iter first, Iter last, IndexIter i, IndexIter i_last)
+        {
+            if (i == i_last)
+                return last;
+            std::ptrdiff_t prev = *i;
+            BOOST_ASSERT(0 <= prev && prev < last - first);
+            auto out = first + prev;
+            for (++i; i != i_last; ++i) {
+                std::ptrdiff_t const index = *i;
+                BOOST_ASSERT(prev < index && index < last - first);
+                out = std::move(first + prev + 1, first + index, out);
+                prev = index;
+            }
+            return std::move(first + prev + 1, last, out);
+        }
+
+        // Calls remove(first, last) on the elements of d, through pointers
+        // if they are contiguous, and returns the new end as an iterator of
+        // d.
+        template<typename D, typename Remove>
+        constexpr auto compact(D & d, Remove remove, std::true_type)
+        {
+            auto const first = d.begin();
+            auto const p = v1_dtl::data_address(first);
+            auto const new_end = remove(p, p + (d.end() - first));
+            return first + (new_end - p);
+        }
+        template<typename D, typename Remove>
+        constexpr auto compact(D & d, Remove remove, std::false_type)
+        {
+            return remove(d.begin(), d.end());
+        }
+
+        // Each assign_impl() returns the number of elements it assigned
+        // over.
+        template<typename D, typename Iter>
+        constexpr std::size_t
+        assign_impl(D & d, Iter first, Iter last, std::false_type)
+        {
+            std::size_t overwrites = 0;
+            auto out = d.begin();
+            auto const out_last = d.end();
+            for (; out != out_last && first != last; ++first, ++out) {
+                *out = *first;
+                ++overwrites;
+            }
+            if (out != out_last)
+                d.erase(out, out_last);
+            if (first != last)
+                d.insert(d.end(), first, last);
+            return overwrites;
+        }
+        template<typename D, typename Iter>
+        constexpr std::size_t
+        assign_impl(D & d, Iter first, Iter last, std::true_type)
+        {
+            using size_type = typename D::size_type;
+            auto const n = size_type(last - first);
+            auto const size = size_type(d.size());
+            auto const overwrites = (std::min)(n, size);
+            if (overwrites) {
+                std::memmove(
+                    d.data(),
+                    stl_interfaces::to_address(first),
+                    overwrites * sizeof(typename D::value_type));
+            }
+            if (overwrites < size)
+                d.erase(d.begin() + overwrites, d.end());
+            else if (overwrites < n)
+                d.insert(d.end(), first + overwrites, last);
+            return overwrites;
+        }
+
+        template<typename D>
+        using reservable = std::integral_constant<
+            bool,
+            container_growth_policy<D>::reservable>;
+
+        template<typename D>
+        using fill_insert_t = decltype(std::declval<D &>().fill_insert(
+            std::declval<typename D::const_iterator>(),
+            std::declval<typename D::size_type>(),
+            std::declval<typename D::value_type const &>()));
+
+        // Inserts n copies of x before pos, with D's fill_insert() if it has
+        // one, and otherwise with its range insert.
+        template<typename D>
+        constexpr auto insert_n(
+            D & d,
+            typename D::const_iterator pos,
+            typename D::size_type n,
+            typename D::value_type const & x,
+            std::true_type)
+        {
+            return d.fill_insert(pos, n, x);
+        }
+        template<typename D>
+        constexpr auto insert_n(
+            D & d,
+            typename D::const_iterator pos,
+            typename D::size_type n,
+            typename D::value_type const & x,
+            std::false_type)
+        {
+            return d.insert(
+                pos, detail::make_n_iter(x, n), detail::make_n_iter_end(x, n));
+        }
+        template<typename D>
+        constexpr auto insert_n(
+            D & d,
+            typename D::const_iterator pos,
+            typename D::size_type n,
+            typename D::value_type const & x)
+        {
+            return v1_dtl::insert_n(
+                d,
+                pos,
+                n,
+                x,
+                std::integral_constant<
+                    bool,
+                    detail::detector<void, fill_insert_t, D>::value>{});
+        }
+
+        // Replaces the elements of d with n copies of x, when n is more than
+        // d's capacity.  With reserve(), d grows in place after its elements
+        // are erased, so that none of them is moved to the new storage, and
+        // there is never more than one buffer.  Otherwise, if copying x may
+        // throw, a D(n, x) is swapped in, so that d is unchanged if it does;
+        // if it cannot, d's insert grows d in place, with no temporary.
+        template<typename D>
+        constexpr void assign_in_place(
+            D & d, typename D::size_type n, typename D::value_type const & x)
+        {
+            // x may be one of the elements erased below.
+            typename D::value_type const copy(x);
+            d.erase(d.begin(), d.end());
+            container_growth_policy<D>::reserve(d, n);
+            v1_dtl::insert_n(d, d.end(), n, copy);
+        }
+        template<typename D>
+        constexpr void assign_swapped(
+            D & d,
+            typename D::size_type n,
+            typename D::value_type const & x,
+            std::true_type)
+        {
+            v1_dtl::assign_in_place(d, n, x);
+        }
+        template<typename D>
+        constexpr void assign_swapped(
+            D & d,
+            typename D::size_type n,
+            typename D::value_type const & x,
+            std::false_type)
+        {
+            D temp(n, x);
+            d.swap(temp);
+        }
+        template<typename D>
+        constexpr void assign_grown(
+            D & d,
+            typename D::size_type n,
+            typename D::value_type const & x,
+            std::true_type)
+        {
+            v1_dtl::assign_in_place(d, n, x);
+        }
+        template<typename D>
+        constexpr void assign_grown(
+            D & d,
+            typename D::size_type n,
+            typename D::value_type const & x,
+            std::false_type)
+        {
+            v1_dtl::assign_swapped(
+                d,
+                n,
+                x,
+                is_nothrow_insertable<typename D::value_type>{});
+        }
+
+        // Replaces the elements of d with those of [first, last) and returns
+        // true, if there are more of them than d's capacity, in the same way
+        // as assign_grown().
+        template<typename D, typename Iter>
+        constexpr bool
+        assign_range_grown(D & d, Iter first, Iter last, std::true_type)
+        {
+            using policy = container_growth_policy<D>;
+            auto const n = std::size_t(last - first);
+            if (n <= policy::capacity(d))
+                return false;
+            d.erase(d.begin(), d.end());
+            policy::reserve(d, n);
+            d.insert(d.end(), first, last);
+            return true;
+        }
+        template<typename D, typename Iter>
+        constexpr bool assign_range_grown(D &, Iter, Iter, std::false_type)
+        {
+            return false;
+        }
+        template<typename D, typename Iter>
+        using range_growable = std::integral_constant<
+            bool,
+            reservable<D>::value &&
+                std::is_convertible<
+                    typename std::iterator_traits<Iter>::iterator_category,
+                    std::random_access_iterator_tag>::value>;
+
+        template<typename D, typename R>
+        using range_insert_t = decltype(std::declval<D &>().insert(
+            std::declval<D &>().end(),
+            std::begin(std::declval<R &>()),
+            std::end(std::declval<R &>())));
+
+        template<typename R>
+        using range_iter_t = decltype(std::begin(std::declval<R &>()));
+
+        // Returns the number of elements of r, or 0 if r is only an input
+        // range, and so cannot be counted before it is read.  (Even calling
+        // begin() twice on an input range may read from it.)
+        template<typename R>
+        constexpr std::size_t sized_distance(R & r, std::true_type)
+        {
+            return std::size_t(std::distance(std::begin(r), std::end(r)));
+        }
+        template<typename R>
+        constexpr std::size_t sized_distance(R &, std::false_type)
+        {
+            return 0;
+        }
+        template<typename R>
+        constexpr std::size_t sized_distance(R & r)
+        {
+            return v1_dtl::sized_distance(
+                r,
+                std::is_convertible<
+                    typename std::iterator_traits<
+                        range_iter_t<R>>::iterator_category,
+                    std::forward_iterator_tag>{});
+        }
+
+        // Makes room in d for n more elements at once, by d's growth policy,
+        // if they will be appended at pos, and do not fit.  Returns pos, or
+        // end() if pos was end() and d grew.  Growing before an insertion
+        // in the middle is left to D, since that would move the elements
+        // after pos twice.
+        template<typename D, typename Iter>
+        constexpr Iter reserve_for_append(D & d, Iter pos, std::size_t n)
+        {
+            using policy = container_growth_policy<D>;
+            if (!policy::reservable || !n || pos != Iter(d.end()))
+                return pos;
+            auto const size = v1_dtl::element_count(d);
+            if (n <= policy::capacity(d) - size)
+                return pos;
+            policy::reserve(d, policy::grown_capacity(d, size + n));
+            return Iter(d.end());
+        }
+
+        // Appends all of r at once, with D's range insert, when D has one
+        // that accepts r's iterators; otherwise, appends one element at a
+        // time.
+        template<typename D, typename R>
+        constexpr void append_range_impl(D & d, R & r, std::true_type)
+        {
+            d.insert(d.end(), std::begin(r), std::end(r));
+        }
+        template<typename D, typename R>
+        constexpr void append_range_impl(D & d, R & r, std::false_type)
+        {
+            auto first = std::begin(r);
+            auto const last = std::end(r);
+            for (; first != last; ++first) {
+                d.emplace_back(*first);
+            }
+        }
+
+        // Removes all the elements of d with D's destroy_all(), if it has
+        // one; otherwise, with erase(begin(), end()).
+        template<typename D>
+        constexpr auto clear_elements(D & d, int) noexcept
+            -> decltype((void)d.destroy_all())
+        {
+            d.destroy_all();
+        }
+        template<typename D>
+        constexpr auto clear_elements(D & d, long) noexcept
+            -> decltype((void)d.erase(d.begin(), d.end()))
+        {
+            d.erase(d.begin(), d.end());
+        }
+
+        // The slow path of the emplace_back() that container_interface
+        // provides in terms of D's construct_at_end(): the new element is
+        // constructed off to the side first, since args may refer to an
+        // element that the growth is about to move.  A D that cannot grow
+        // is full.
+        template<typename D, typename... Args>
+        decltype(auto)
+        grow_and_construct_at_end(D & d, std::size_t size, Args &&... args)
+        {
+            using policy = container_growth_policy<D>;
+            typename D::value_type x(std::forward<Args>(args)...);
+            policy::reserve(d, policy::grown_capacity(d, size + 1));
+            if (policy::capacity(d) <= size) {
+                throw std::length_error(
+                    "emplace_back() on a full container_interface container");
+            }
+            return d.construct_at_end(std::move(x));
+        }
+
+        // Appends an element without a capacity check, with D's
+        // construct_at_end(), if it has one; otherwise, with emplace_back().
+        template<typename D, typename... Args>
+        constexpr auto append_unchecked(D & d, int, Args &&... args) noexcept(
+            noexcept(d.construct_at_end(std::forward<Args>(args)...)))
+            -> decltype(d.construct_at_end(std::forward<Args>(args)...))
+        {
+            return d.construct_at_end(std::forward<Args>(args)...);
+        }
+        template<typename D, typename... Args>
+        constexpr auto append_unchecked(D & d, long, Args &&... args) noexcept(
+            noexcept(d.emplace_back(std::forward<Args>(args)...)))
+            -> decltype(d.emplace_back(std::forward<Args>(args)...))
+        {
+            return d.emplace_back(std::forward<Args>(args)...);
+        }
+
+        // D's iterator type, if D can be scanned backward: it is a common
+        // range of bidirectional iterators.
+        template<typename D>
+        using backward_iter_t = std::enable_if_t<
+            common_range<D>::value,
+            std::remove_reference_t<decltype(
+                --std::declval<caps_iter_t<D> &>())>>;
+
+        // True when the kernels in detail/simd.hpp can search an array of Vs
+        // for a T: it is the same arithmetic type, or both are integers.
+        // (An integer can compare equal to a floating-point value it does
+        // not convert to exactly.)
+        template<typename V, typename T>
+        using simd_searchable_elements = std::integral_constant<
+            bool,
+            detail::detector<void, detail::simd_lane_t, V>::value &&
+                (std::is_same<V, T>::value ||
+                 (std::is_integral<V>::value && std::is_integral<T>::value &&
+                  !std::is_same<T, bool>::value))>;
+
+        template<typename Iter, typename T>
+        constexpr Iter
+        find_last_impl(Iter first, Iter last, T const & x, std::false_type)
+        {
+            for (auto it = last; it != first;) {
+                if (*--it == x)
+                    return it;
+            }
+            return last;
+        }
+        // detail::simd_find_last() returns one past the index of the match,
+        // or 0 if there is none.
+        template<typename Iter, typename T>
+        constexpr Iter
+        find_last_impl(Iter first, Iter last, T const & x, std::true_type)
+        {
+#ifdef BOOST_STL_INTERFACES_CONSTANT_EVALUATED
+            if (!BOOST_STL_INTERFACES_CONSTANT_EVALUATED()) {
+                using value_type = std::remove_cv_t<
+                    std::remove_reference_t<decltype(*first)>>;
+                auto const v = static_cast<value_type>(x);
+                if (first == last || !(static_cast<T>(v) == x))
+                    return last;
+                auto const i =
+                    detail::simd_find_last<detail::simd_lane_t<value_type>>(
+                        v1_dtl::data_address(first),
+                        std::size_t(last - first),
+                        v);
+                return i ? first + (i - 1) : last;
+            }
+#endif
+            return v1_dtl::find_last_impl(first, last, x, std::false_type{});
+        }
+
+        template<typename Iter, typename Pred>
+        constexpr Iter
+        rfind_if_impl(Iter first, Iter last, Pred & pred, std::false_type)
+        {
+            for (auto it = last; it != first;) {
+                if (pred(*--it))
+                    return it;
+            }
+            return last;
+        }
+        // Contiguous elements are scanned through std::reverse_iterators
+        // over pointers, which leaves iterators that check their bounds out
+        // of the loop, and lets std::find_if() unroll it.
+        template<typename Iter, typename Pred>
+        constexpr Iter
+        rfind_if_impl(Iter first, Iter last, Pred & pred, std::true_type)
+        {
+#ifdef BOOST_STL_INTERFACES_CONSTANT_EVALUATED
+            if (!BOOST_STL_INTERFACES_CONSTANT_EVALUATED()) {
+                if (first == last)
+                    return last;
+                auto const p = v1_dtl::data_address(first);
+                using rev_ptr =
+                    std::reverse_iterator<std::remove_const_t<decltype(p)>>;
+                auto const it = std::find_if(
+                    rev_ptr(p + (last - first)), rev_ptr(p), std::ref(pred));
+                return it.base() == p ? last : first + (it.base() - p - 1);
+            }
+#endif
+            return v1_dtl::rfind_if_impl(first, last, pred, std::false_type{});
+        }
+
+        // True when the elements of a contiguous container can be copied
+        // to out by copying bytes: out is contiguous, with the same
+        // trivially copyable value type.
+        template<typename Iter, typename OutIter>
+        using reversed_copyable = std::integral_constant<
+            bool,
+            is_contiguous_iterator<OutIter>::value &&
+                detail::detector<void, to_address_t, OutIter>::value &&
+                std::is_same<
+                    std::remove_cv_t<
+                        typename std::iterator_traits<Iter>::value_type>,
+                    typename std::iterator_traits<OutIter>::value_type>::
+                    value &&
+                std::is_trivially_copyable<
+                    typename std::iterator_traits<OutIter>::value_type>::
+                    value>;
+
+        // out[i] = p[n - 1 - i], a vector at a time with the lanes of each
+        // reversed, for the arithmetic types the kernels handle.
+        template<typename T>
+        void
+        reverse_copy_n(T const * p, std::ptrdiff_t n, T * out, std::true_type)
+        {
+            detail::simd_reverse_copy<detail::simd_lane_t<T>>(
+                p, std::size_t(n), out);
+        }
+        template<typename T>
+        void reverse_copy_n(
+            T const * p, std::ptrdiff_t n, T * out, std::false_type)
+        {
+            for (std::ptrdiff_t i = 0; i < n; ++i) {
+                out[i] = p[n - 1 - i];
+            }
+        }
+
+        template<typename Iter, typename OutIter>
+        constexpr OutIter
+        copy_reversed_impl(Iter first, Iter last, OutIter out, std::false_type)
+        {
+            for (auto it = last; it != first; ++out) {
+                *out = *--it;
+            }
+            return out;
+        }
+        template<typename Iter, typename OutIter>
+        constexpr OutIter
+        copy_reversed_impl(Iter first, Iter last, OutIter out, std::true_type)
+        {
+#ifdef BOOST_STL_INTERFACES_CONSTANT_EVALUATED
+            if (!BOOST_STL_INTERFACES_CONSTANT_EVALUATED()) {
+                using value_type =
+                    typename std::iterator_traits<OutIter>::value_type;
+                if (first == last)
+                    return out;
+                auto const n = last - first;
+                v1_dtl::reverse_copy_n(
+                    v1_dtl::data_address(first),
+                    n,
+                    stl_interfaces::to_address(out),
+                    detail::detector<void, detail::simd_lane_t, value_type>{});
+                return out + n;
+            }
+#endif
+            return v1_dtl::copy_reversed_impl(
+                first, last, out, std::false_type{});
+        }
     }
 
     template<
@@ -137,17 +1091,23 @@ namespace boost { namespace stl_interfaces { inline namespace v1 {
 #endif
         >
     struct container_interface
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+        : v1_dtl::container_dtor<Derived>
+#endif
     {
 #ifndef BOOST_STL_INTERFACES_DOXYGEN
     private:
+        BOOST_STL_INTERFACES_INLINE
         constexpr Derived & derived() noexcept
         {
             return static_cast<Derived &>(*this);
         }
+        BOOST_STL_INTERFACES_INLINE
         constexpr const Derived & derived() const noexcept
         {
             return static_cast<Derived const &>(*this);
         }
+        BOOST_STL_INTERFACES_INLINE
         constexpr Derived & mutable_derived() const noexcept
         {
             return const_cast<Derived &>(static_cast<Derived const &>(*this));
@@ -155,23 +1115,29 @@ namespace boost { namespace stl_interfaces { inline namespace v1 {
 #endif
 
     public:
-        ~container_interface() { v1_dtl::clear_impl<Derived>::call(derived()); }
-
         template<typename D = Derived>
+        BOOST_STL_INTERFACES_INLINE
         constexpr auto empty() noexcept(
-            noexcept(std::declval<D &>().begin() == std::declval<D &>().end()))
+            v1_dtl::container_caps<D>::nothrow_begin_end &&
+            noexcept(
+                std::declval<v1_dtl::caps_iter_t<D> &>() ==
+                std::declval<v1_dtl::caps_sent_t<D> &>()))
             -> decltype(
-                std::declval<D &>().begin() == std::declval<D &>().end())
+                std::declval<v1_dtl::caps_iter_t<D> &>() ==
+                std::declval<v1_dtl::caps_sent_t<D> &>())
         {
             return derived().begin() == derived().end();
         }
         template<typename D = Derived>
-        constexpr auto empty() const noexcept(noexcept(
-            std::declval<D const &>().begin() ==
-            std::declval<D const &>().end()))
+        BOOST_STL_INTERFACES_INLINE
+        constexpr auto empty() const noexcept(
+            v1_dtl::container_caps<D const>::nothrow_begin_end &&
+            noexcept(
+                std::declval<v1_dtl::caps_iter_t<D const> &>() ==
+                std::declval<v1_dtl::caps_sent_t<D const> &>()))
             -> decltype(
-                std::declval<D const &>().begin() ==
-                std::declval<D const &>().end())
+                std::declval<v1_dtl::caps_iter_t<D const> &>() ==
+                std::declval<v1_dtl::caps_sent_t<D const> &>())
         {
             return derived().begin() == derived().end();
         }
@@ -180,62 +1146,99 @@ namespace boost { namespace stl_interfaces { inline namespace v1 {
             typename D = Derived,
             bool C = Contiguous,
             typename Enable = std::enable_if_t<C>>
-        constexpr auto data() noexcept(noexcept(std::declval<D &>().begin()))
-            -> decltype(std::addressof(*std::declval<D &>().begin()))
+        BOOST_STL_INTERFACES_INLINE
+        constexpr auto data() noexcept(v1_dtl::container_caps<D>::nothrow_begin)
+            -> decltype(
+                std::addressof(*std::declval<v1_dtl::caps_iter_t<D> &>()))
         {
-            return std::addressof(*derived().begin());
+            return v1_dtl::data_address(derived().begin());
         }
         template<
             typename D = Derived,
             bool C = Contiguous,
             typename Enable = std::enable_if_t<C>>
+        BOOST_STL_INTERFACES_INLINE
         constexpr auto data() const
-            noexcept(noexcept(std::declval<D const &>().begin()))
-                -> decltype(std::addressof(*std::declval<D const &>().begin()))
+            noexcept(v1_dtl::container_caps<D const>::nothrow_begin)
+                -> decltype(std::addressof(
+                    *std::declval<v1_dtl::caps_iter_t<D const> &>()))
         {
-            return std::addressof(*derived().begin());
+            return v1_dtl::data_address(derived().begin());
         }
 
         template<typename D = Derived>
-        constexpr auto size()
-#if !BOOST_CLANG
-            noexcept(noexcept(
-                std::declval<D &>().end() - std::declval<D &>().begin()))
-#endif
+        BOOST_STL_INTERFACES_INLINE
+        constexpr auto size() noexcept(
+            v1_dtl::container_caps<D>::nothrow_begin_end &&
+            noexcept(
+                std::declval<v1_dtl::caps_sent_t<D> &>() -
+                std::declval<v1_dtl::caps_iter_t<D> &>()))
             -> decltype(typename D::size_type(
-                std::declval<D &>().end() - std::declval<D &>().begin()))
+                std::declval<v1_dtl::caps_sent_t<D> &>() -
+                std::declval<v1_dtl::caps_iter_t<D> &>()))
         {
             return derived().end() - derived().begin();
         }
         template<typename D = Derived>
-        constexpr auto size() const noexcept(noexcept(
-            std::declval<D const &>().end() -
-            std::declval<D const &>().begin()))
+        BOOST_STL_INTERFACES_INLINE
+        constexpr auto size() const noexcept(
+            v1_dtl::container_caps<D const>::nothrow_begin_end &&
+            noexcept(
+                std::declval<v1_dtl::caps_sent_t<D const> &>() -
+                std::declval<v1_dtl::caps_iter_t<D const> &>()))
             -> decltype(typename D::size_type(
-#if !BOOST_CLANG
-                std::declval<D const &>().end() -
-                std::declval<D const &>().begin()
-#endif
-                ))
+                std::declval<v1_dtl::caps_sent_t<D const> &>() -
+                std::declval<v1_dtl::caps_iter_t<D const> &>()))
         {
             return derived().end() - derived().begin();
         }
+        template<
+            typename D = Derived,
+            typename Enable = std::enable_if_t<v1_dtl::distance_size<D>::value>>
+        BOOST_STL_INTERFACES_INLINE
+        constexpr typename D::size_type size() noexcept(
+            v1_dtl::container_caps<D>::nothrow_begin_end &&
+            noexcept(access::distance_to(
+                std::declval<v1_dtl::caps_iter_t<D> const &>(),
+                std::declval<v1_dtl::caps_iter_t<D> const &>())))
+        {
+            return access::distance_to(derived().begin(), derived().end());
+        }
+        template<
+            typename D = Derived,
+            typename Enable =
+                std::enable_if_t<v1_dtl::distance_size<D const>::value>>
+        BOOST_STL_INTERFACES_INLINE
+        constexpr typename D::size_type size() const noexcept(
+            v1_dtl::container_caps<D const>::nothrow_begin_end &&
+            noexcept(access::distance_to(
+                std::declval<v1_dtl::caps_iter_t<D const> const &>(),
+                std::declval<v1_dtl::caps_iter_t<D const> const &>())))
+        {
+            return access::distance_to(derived().begin(), derived().end());
+        }
 
         template<typename D = Derived>
-        constexpr auto front() noexcept(noexcept(*std::declval<D &>().begin()))
-            -> decltype(*std::declval<D &>().begin())
+        BOOST_STL_INTERFACES_INLINE
+        constexpr auto front() noexcept(
+            v1_dtl::container_caps<D>::nothrow_begin &&
+            noexcept(*std::declval<v1_dtl::caps_iter_t<D> &>()))
+            -> decltype(*std::declval<v1_dtl::caps_iter_t<D> &>())
         {
             return *derived().begin();
         }
         template<typename D = Derived>
-        constexpr auto front() const
-            noexcept(noexcept(*std::declval<D const &>().begin()))
-                -> decltype(*std::declval<D const &>().begin())
+        BOOST_STL_INTERFACES_INLINE
+        constexpr auto front() const noexcept(
+            v1_dtl::container_caps<D const>::nothrow_begin &&
+            noexcept(*std::declval<v1_dtl::caps_iter_t<D const> &>()))
+            -> decltype(*std::declval<v1_dtl::caps_iter_t<D const> &>())
         {
             return *derived().begin();
         }
 
         template<typename D = Derived>
+        BOOST_STL_INTERFACES_INLINE
         constexpr auto push_front(typename D::value_type const & x) noexcept(
             noexcept(std::declval<D &>().emplace_front(x)))
             -> decltype((void)std::declval<D &>().emplace_front(x))
@@ -244,6 +1247,7 @@ namespace boost { namespace stl_interfaces { inline namespace v1 {
         }
 
         template<typename D = Derived>
+        BOOST_STL_INTERFACES_INLINE
         constexpr auto push_front(typename D::value_type && x) noexcept(
             noexcept(std::declval<D &>().emplace_front(std::move(x))))
             -> decltype((void)std::declval<D &>().emplace_front(std::move(x)))
@@ -252,6 +1256,7 @@ namespace boost { namespace stl_interfaces { inline namespace v1 {
         }
 
         template<typename D = Derived>
+        BOOST_STL_INTERFACES_INLINE
         constexpr auto pop_front() noexcept -> decltype(
             std::declval<D &>().emplace_front(
                 std::declval<typename D::value_type &>()),
@@ -262,28 +1267,49 @@ namespace boost { namespace stl_interfaces { inline namespace v1 {
 
         template<
             typename D = Derived,
-            typename Enable = std::enable_if_t<
-                v1_dtl::decrementable_sentinel<D>::value &&
-                v1_dtl::common_range<D>::value>>
-        constexpr auto
-        back() noexcept(noexcept(*std::prev(std::declval<D &>().end())))
-            -> decltype(*std::prev(std::declval<D &>().end()))
+            typename Enable = std::enable_if_t<std::is_same<
+                v1_dtl::caps_iter_t<D>,
+                v1_dtl::caps_sent_t<D>>::value>>
+        BOOST_STL_INTERFACES_INLINE
+        constexpr auto back() noexcept(
+            v1_dtl::container_caps<D>::nothrow_end &&
+            noexcept(*std::prev(std::declval<v1_dtl::caps_sent_t<D> &>())))
+            -> decltype(*--std::declval<v1_dtl::caps_sent_t<D> &>())
         {
-            return *std::prev(derived().end());
+            return *v1_dtl::prev_iter(derived().end());
         }
         template<
             typename D = Derived,
-            typename Enable = std::enable_if_t<
-                v1_dtl::decrementable_sentinel<D>::value &&
-                v1_dtl::common_range<D>::value>>
-        constexpr auto back() const
-            noexcept(noexcept(*std::prev(std::declval<D const &>().end())))
-                -> decltype(*std::prev(std::declval<D const &>().end()))
+            typename Enable = std::enable_if_t<std::is_same<
+                v1_dtl::caps_iter_t<D const>,
+                v1_dtl::caps_sent_t<D const>>::value>>
+        BOOST_STL_INTERFACES_INLINE
+        constexpr auto back() const noexcept(
+            v1_dtl::container_caps<D const>::nothrow_end &&
+            noexcept(
+                *std::prev(std::declval<v1_dtl::caps_sent_t<D const> &>())))
+            -> decltype(*--std::declval<v1_dtl::caps_sent_t<D const> &>())
         {
-            return *std::prev(derived().end());
+            return *v1_dtl::prev_iter(derived().end());
+        }
+
+        template<typename D = Derived, typename... Args>
+        BOOST_STL_INTERFACES_INLINE
+        constexpr auto emplace_back(Args &&... args)
+            -> decltype(std::declval<D &>().construct_at_end(
+                std::forward<Args>(args)...))
+        {
+            auto & d = derived();
+            auto const size = v1_dtl::element_count(d);
+            if (size == container_growth_policy<D>::capacity(d)) {
+                return v1_dtl::grow_and_construct_at_end(
+                    d, size, std::forward<Args>(args)...);
+            }
+            return d.construct_at_end(std::forward<Args>(args)...);
         }
 
         template<typename D = Derived>
+        BOOST_STL_INTERFACES_INLINE
         constexpr auto push_back(typename D::value_type const & x) noexcept(
             noexcept(std::declval<D &>().emplace_back(x)))
             -> decltype((void)std::declval<D &>().emplace_back(x))
@@ -292,6 +1318,7 @@ namespace boost { namespace stl_interfaces { inline namespace v1 {
         }
 
         template<typename D = Derived>
+        BOOST_STL_INTERFACES_INLINE
         constexpr auto push_back(typename D::value_type && x) noexcept(
             noexcept(std::declval<D &>().emplace_back(std::move(x))))
             -> decltype((void)std::declval<D &>().emplace_back(std::move(x)))
@@ -299,27 +1326,64 @@ namespace boost { namespace stl_interfaces { inline namespace v1 {
             derived().emplace_back(std::move(x));
         }
 
+        template<typename D = Derived, typename... Args>
+        BOOST_STL_INTERFACES_INLINE
+        constexpr auto unchecked_emplace_back(Args &&... args) noexcept(
+            noexcept(v1_dtl::append_unchecked(
+                std::declval<D &>(), 0, std::forward<Args>(args)...)))
+            -> decltype(v1_dtl::append_unchecked(
+                std::declval<D &>(), 0, std::forward<Args>(args)...))
+        {
+            return v1_dtl::append_unchecked(
+                derived(), 0, std::forward<Args>(args)...);
+        }
+
+        template<typename D = Derived>
+        BOOST_STL_INTERFACES_INLINE
+        constexpr auto
+        unchecked_push_back(typename D::value_type const & x) noexcept(
+            noexcept(std::declval<D &>().unchecked_emplace_back(x)))
+            -> decltype((void)std::declval<D &>().unchecked_emplace_back(x))
+        {
+            derived().unchecked_emplace_back(x);
+        }
+
+        template<typename D = Derived>
+        BOOST_STL_INTERFACES_INLINE
+        constexpr auto unchecked_push_back(typename D::value_type && x) noexcept(
+            noexcept(std::declval<D &>().unchecked_emplace_back(std::move(x))))
+            -> decltype((void)std::declval<D &>().unchecked_emplace_back(
+                std::move(x)))
+        {
+            derived().unchecked_emplace_back(std::move(x));
+        }
+
         template<typename D = Derived>
+        BOOST_STL_INTERFACES_INLINE
         constexpr auto pop_back() noexcept -> decltype(
             std::declval<D &>().emplace_back(
                 std::declval<typename D::value_type &>()),
             (void)std::declval<D &>().erase(
                 std::prev(std::declval<D &>().end())))
         {
-            derived().erase(std::prev(derived().end()));
+            derived().erase(v1_dtl::prev_iter(derived().end()));
         }
 
         template<typename D = Derived>
+        BOOST_STL_INTERFACES_INLINE
         constexpr auto operator[](typename D::size_type n) noexcept(
-            noexcept(std::declval<D &>().begin()[n]))
-            -> decltype(std::declval<D &>().begin()[n])
+            v1_dtl::container_caps<D>::nothrow_begin &&
+            noexcept(std::declval<v1_dtl::caps_iter_t<D> &>()[n]))
+            -> decltype(std::declval<v1_dtl::caps_iter_t<D> &>()[n])
         {
             return derived().begin()[n];
         }
         template<typename D = Derived>
-        constexpr auto operator[](typename D::size_type n) const
-            noexcept(noexcept(std::declval<D const &>().begin()[n]))
-                -> decltype(std::declval<D const &>().begin()[n])
+        BOOST_STL_INTERFACES_INLINE
+        constexpr auto operator[](typename D::size_type n) const noexcept(
+            v1_dtl::container_caps<D const>::nothrow_begin &&
+            noexcept(std::declval<v1_dtl::caps_iter_t<D const> &>()[n]))
+            -> decltype(std::declval<v1_dtl::caps_iter_t<D const> &>()[n])
         {
             return derived().begin()[n];
         }
@@ -347,38 +1411,55 @@ namespace boost { namespace stl_interfaces { inline namespace v1 {
         }
 
         template<typename D = Derived>
+        BOOST_STL_INTERFACES_INLINE
         constexpr auto resize(typename D::size_type n) noexcept(
             noexcept(std::declval<D &>().resize(
                 n, std::declval<typename D::value_type const &>())))
-            -> decltype(std::declval<D &>().resize(
+            -> decltype((void)std::declval<D &>().resize(
                 n, std::declval<typename D::value_type const &>()))
         {
-            return derived().resize(n, typename D::value_type());
+            v1_dtl::op_trace<D> const trace(derived());
+            derived().resize(n, typename D::value_type());
+            trace.done(derived());
+        }
+
+        template<typename D = Derived>
+        BOOST_STL_INTERFACES_INLINE
+        constexpr auto resize_for_overwrite(typename D::size_type n) noexcept(
+            noexcept(std::declval<D &>().resize(n, default_init)))
+            -> decltype((void)std::declval<D &>().resize(n, default_init))
+        {
+            v1_dtl::op_trace<D> const trace(derived());
+            derived().resize(n, default_init);
+            trace.done(derived());
         }
 
         template<typename D = Derived, typename Iter = typename D::const_iterator>
+        BOOST_STL_INTERFACES_INLINE
         constexpr Iter begin() const
-            noexcept(noexcept(std::declval<D &>().begin()))
+            noexcept(v1_dtl::container_caps<D>::nothrow_begin)
         {
             return Iter(mutable_derived().begin());
         }
         template<typename D = Derived, typename Iter = typename D::const_iterator>
-        constexpr Iter end() const noexcept(noexcept(std::declval<D &>().end()))
+        BOOST_STL_INTERFACES_INLINE
+        constexpr Iter end() const
+            noexcept(v1_dtl::container_caps<D>::nothrow_end)
         {
             return Iter(mutable_derived().end());
         }
 
         template<typename D = Derived>
-        constexpr auto cbegin() const
-            noexcept(noexcept(std::declval<D const &>().begin()))
-                -> decltype(std::declval<D const &>().begin())
+        BOOST_STL_INTERFACES_INLINE
+        constexpr v1_dtl::caps_iter_t<D const>
+        cbegin() const noexcept(v1_dtl::container_caps<D const>::nothrow_begin)
         {
             return derived().begin();
         }
         template<typename D = Derived>
-        constexpr auto cend() const
-            noexcept(noexcept(std::declval<D const &>().end()))
-                -> decltype(std::declval<D const &>().end())
+        BOOST_STL_INTERFACES_INLINE
+        constexpr v1_dtl::caps_sent_t<D const>
+        cend() const noexcept(v1_dtl::container_caps<D const>::nothrow_end)
         {
             return derived().end();
         }
@@ -386,6 +1467,7 @@ namespace boost { namespace stl_interfaces { inline namespace v1 {
         template<
             typename D = Derived,
             typename Enable = std::enable_if_t<v1_dtl::common_range<D>::value>>
+        BOOST_STL_INTERFACES_INLINE
         constexpr auto rbegin() noexcept(noexcept(
             stl_interfaces::make_reverse_iterator(std::declval<D &>().end())))
         {
@@ -394,6 +1476,7 @@ namespace boost { namespace stl_interfaces { inline namespace v1 {
         template<
             typename D = Derived,
             typename Enable = std::enable_if_t<v1_dtl::common_range<D>::value>>
+        BOOST_STL_INTERFACES_INLINE
         constexpr auto rend() noexcept(noexcept(
             stl_interfaces::make_reverse_iterator(std::declval<D &>().begin())))
         {
@@ -401,6 +1484,7 @@ namespace boost { namespace stl_interfaces { inline namespace v1 {
         }
 
         template<typename D = Derived>
+        BOOST_STL_INTERFACES_INLINE
         constexpr auto rbegin() const
             noexcept(noexcept(std::declval<D &>().rbegin()))
         {
@@ -408,6 +1492,7 @@ namespace boost { namespace stl_interfaces { inline namespace v1 {
                 typename D::const_reverse_iterator(mutable_derived().rbegin());
         }
         template<typename D = Derived>
+        BOOST_STL_INTERFACES_INLINE
         constexpr auto rend() const
             noexcept(noexcept(std::declval<D &>().rend()))
         {
@@ -415,6 +1500,7 @@ namespace boost { namespace stl_interfaces { inline namespace v1 {
         }
 
         template<typename D = Derived>
+        BOOST_STL_INTERFACES_INLINE
         constexpr auto crbegin() const
             noexcept(noexcept(std::declval<D const &>().rbegin()))
                 -> decltype(std::declval<D const &>().rbegin())
@@ -422,6 +1508,7 @@ namespace boost { namespace stl_interfaces { inline namespace v1 {
             return derived().rbegin();
         }
         template<typename D = Derived>
+        BOOST_STL_INTERFACES_INLINE
         constexpr auto crend() const
             noexcept(noexcept(std::declval<D const &>().rend()))
                 -> decltype(std::declval<D const &>().rend())
@@ -429,6 +1516,80 @@ namespace boost { namespace stl_interfaces { inline namespace v1 {
             return derived().rend();
         }
 
+        template<
+            typename T,
+            typename D = Derived,
+            typename Iter = v1_dtl::backward_iter_t<D>>
+        constexpr Iter find_last(T const & x)
+        {
+            return v1_dtl::find_last_impl(
+                derived().begin(),
+                derived().end(),
+                x,
+                std::integral_constant<
+                    bool,
+                    Contiguous && v1_dtl::simd_searchable_elements<
+                                      typename D::value_type,
+                                      T>::value>{});
+        }
+        template<
+            typename T,
+            typename D = Derived,
+            typename Iter = v1_dtl::backward_iter_t<D const>>
+        constexpr Iter find_last(T const & x) const
+        {
+            return v1_dtl::find_last_impl(
+                derived().begin(),
+                derived().end(),
+                x,
+                std::integral_constant<
+                    bool,
+                    Contiguous && v1_dtl::simd_searchable_elements<
+                                      typename D::value_type,
+                                      T>::value>{});
+        }
+
+        template<
+            typename Pred,
+            typename D = Derived,
+            typename Iter = v1_dtl::backward_iter_t<D>>
+        constexpr Iter rfind_if(Pred pred)
+        {
+            return v1_dtl::rfind_if_impl(
+                derived().begin(),
+                derived().end(),
+                pred,
+                std::integral_constant<bool, Contiguous>{});
+        }
+        template<
+            typename Pred,
+            typename D = Derived,
+            typename Iter = v1_dtl::backward_iter_t<D const>>
+        constexpr Iter rfind_if(Pred pred) const
+        {
+            return v1_dtl::rfind_if_impl(
+                derived().begin(),
+                derived().end(),
+                pred,
+                std::integral_constant<bool, Contiguous>{});
+        }
+
+        template<
+            typename OutIter,
+            typename D = Derived,
+            typename Iter = v1_dtl::backward_iter_t<D const>>
+        constexpr OutIter copy_reversed_to(OutIter out) const
+        {
+            return v1_dtl::copy_reversed_impl(
+                derived().begin(),
+                derived().end(),
+                out,
+                std::integral_constant<
+                    bool,
+                    Contiguous &&
+                        v1_dtl::reversed_copyable<Iter, OutIter>::value>{});
+        }
+
         template<typename D = Derived>
         constexpr auto insert(
             typename D::const_iterator pos,
@@ -473,8 +1634,12 @@ namespace boost { namespace stl_interfaces { inline namespace v1 {
                 pos, detail::make_n_iter(x, n), detail::make_n_iter_end(x, n)))
 #endif
         {
-            return derived().insert(
-                pos, detail::make_n_iter(x, n), detail::make_n_iter_end(x, n));
+            v1_dtl::op_trace<D> const trace(derived());
+            auto const moves = Contiguous ? trace.tail(derived(), pos) : 0;
+            pos = v1_dtl::reserve_for_append(derived(), pos, n);
+            auto const retval = v1_dtl::insert_n(derived(), pos, n, x);
+            trace.done(derived(), moves);
+            return retval;
         }
 
         template<typename D = Derived>
@@ -485,14 +1650,155 @@ namespace boost { namespace stl_interfaces { inline namespace v1 {
                                           .insert(pos, il.begin(), il.end())))
             -> decltype(std::declval<D &>().insert(pos, il.begin(), il.end()))
         {
-            return derived().insert(pos, il.begin(), il.end());
+            v1_dtl::op_trace<D> const trace(derived());
+            auto const moves = Contiguous ? trace.tail(derived(), pos) : 0;
+            pos = v1_dtl::reserve_for_append(derived(), pos, il.size());
+            auto const retval = derived().insert(pos, il.begin(), il.end());
+            trace.done(derived(), moves);
+            return retval;
+        }
+
+        template<typename R, typename D = Derived>
+        constexpr auto insert_range(typename D::const_iterator pos, R && r)
+            -> decltype(std::declval<D &>().insert(
+                pos, std::begin(r), std::end(r)))
+        {
+            v1_dtl::op_trace<D> const trace(derived());
+            auto const moves = Contiguous ? trace.tail(derived(), pos) : 0;
+            pos = v1_dtl::reserve_for_append(
+                derived(), pos, v1_dtl::sized_distance(r));
+            auto const retval =
+                derived().insert(pos, std::begin(r), std::end(r));
+            trace.done(derived(), moves);
+            return retval;
+        }
+
+        template<
+            typename ForwardIterator,
+            typename Compare,
+            typename D = Derived,
+            typename Enable = std::enable_if_t<
+                std::is_convertible<
+                    typename std::iterator_traits<
+                        ForwardIterator>::iterator_category,
+                    std::forward_iterator_tag>::value &&
+                std::is_convertible<
+                    typename std::iterator_traits<
+                        typename D::iterator>::iterator_category,
+                    std::bidirectional_iterator_tag>::value>>
+        constexpr auto insert_sorted(
+            ForwardIterator first, ForwardIterator last, Compare comp)
+            -> decltype((void)std::declval<D &>().insert(
+                std::declval<D &>().end(), first, last))
+        {
+            v1_dtl::op_trace<D> const trace(derived());
+            v1_dtl::invalidate_iterators(derived());
+            auto const n = v1_dtl::element_count(derived());
+            v1_dtl::reserve_for_append(
+                derived(),
+                derived().end(),
+                std::size_t(std::distance(first, last)));
+            derived().insert(derived().end(), first, last);
+            auto const d_first = derived().begin();
+            std::inplace_merge(
+                d_first,
+                std::next(d_first, n),
+                derived().end(),
+                std::move(comp));
+            trace.done(derived(), n);
+        }
+
+        template<
+            typename ForwardIterator,
+            typename D = Derived,
+            typename Enable = std::enable_if_t<std::is_convertible<
+                typename std::iterator_traits<
+                    ForwardIterator>::iterator_category,
+                std::forward_iterator_tag>::value>>
+        constexpr auto
+        insert_sorted(ForwardIterator first, ForwardIterator last)
+            -> decltype(std::declval<D &>().insert_sorted(
+                first, last, std::less<typename D::value_type>()))
+        {
+            derived().insert_sorted(
+                first, last, std::less<typename D::value_type>());
+        }
+
+        template<typename R, typename D = Derived>
+        constexpr auto append_range(R && r) -> decltype(
+            std::declval<D &>().emplace_back(
+                *std::declval<v1_dtl::range_iter_t<R> &>()),
+            void())
+        {
+            v1_dtl::op_trace<D> const trace(derived());
+            v1_dtl::reserve_for_append(
+                derived(), derived().end(), v1_dtl::sized_distance(r));
+            v1_dtl::append_range_impl(
+                derived(),
+                r,
+                std::integral_constant<
+                    bool,
+                    detail::detector<void, v1_dtl::range_insert_t, D, R>::
+                        value>{});
+            trace.done(derived());
         }
 
         template<typename D = Derived>
         constexpr auto erase(typename D::const_iterator pos) noexcept
             -> decltype(std::declval<D &>().erase(pos, std::next(pos)))
         {
-            return derived().erase(pos, std::next(pos));
+            return derived().erase(pos, v1_dtl::next_iter(pos));
+        }
+
+        template<typename Pred, typename D = Derived>
+        constexpr auto erase_if(Pred pred) -> decltype(
+            (void)std::declval<D &>().erase(
+                std::declval<D &>().begin(), std::declval<D &>().end()),
+            typename D::size_type())
+        {
+            v1_dtl::op_trace<D> const trace(derived());
+            v1_dtl::invalidate_iterators(derived());
+            auto const new_end = v1_dtl::compact(
+                derived(),
+                [&pred](auto first, auto last) {
+                    return std::remove_if(first, last, pred);
+                },
+                std::integral_constant<bool, Contiguous>{});
+            auto const last = derived().end();
+            auto const n =
+                typename D::size_type(std::distance(new_end, last));
+            derived().erase(new_end, last);
+            trace.done(derived());
+            return n;
+        }
+
+        template<
+            typename R,
+            typename D = Derived,
+            typename Enable = std::enable_if_t<std::is_convertible<
+                typename std::iterator_traits<
+                    typename D::iterator>::iterator_category,
+                std::random_access_iterator_tag>::value>>
+        constexpr auto erase_indices(R const & indices) -> decltype(
+            (void)std::declval<D &>().erase(
+                std::declval<D &>().begin(), std::declval<D &>().end()),
+            (void)std::ptrdiff_t(*std::begin(indices)),
+            typename D::size_type())
+        {
+            v1_dtl::op_trace<D> const trace(derived());
+            v1_dtl::invalidate_iterators(derived());
+            auto const new_end = v1_dtl::compact(
+                derived(),
+                [&indices](auto first, auto last) {
+                    return v1_dtl::remove_indices(
+                        first, last, std::begin(indices), std::end(indices));
+                },
+                std::integral_constant<bool, Contiguous>{});
+            auto const last = derived().end();
+            auto const n = typename D::size_type(last - new_end);
+            derived().erase(new_end, last);
+            trace.done(derived());
+            return n;
         }
 
         template<
@@ -509,15 +1815,22 @@ namespace boost { namespace stl_interfaces { inline namespace v1 {
                 (void)std::declval<D &>().insert(
                     std::declval<D &>().begin(), first, last))
         {
-            auto out = derived().begin();
-            auto const out_last = derived().end();
-            for (; out != out_last && first != last; ++first, ++out) {
-                *out = *first;
+            v1_dtl::op_trace<D> const trace(derived());
+            v1_dtl::invalidate_iterators(derived());
+            if (v1_dtl::assign_range_grown(
+                    derived(),
+                    first,
+                    last,
+                    v1_dtl::range_growable<D, InputIterator>{})) {
+                trace.done(derived());
+                return;
             }
-            if (out != out_last)
-                derived().erase(out, out_last);
-            if (first != last)
-                derived().insert(derived().end(), first, last);
+            auto const overwrites = v1_dtl::assign_impl(
+                derived(),
+                first,
+                last,
+                v1_dtl::bulk_copyable<D, InputIterator, Contiguous>{});
+            trace.done(derived(), overwrites);
         }
 
         template<typename D = Derived>
@@ -538,24 +1851,26 @@ namespace boost { namespace stl_interfaces { inline namespace v1 {
                     detail::make_n_iter(x, n),
                     detail::make_n_iter_end(x, n)))
         {
-            if (detail::fake_capacity(derived()) < n) {
-                Derived temp(n, x);
-                derived().swap(temp);
+            v1_dtl::op_trace<D> const trace(derived());
+            v1_dtl::invalidate_iterators(derived());
+            std::size_t overwrites = 0;
+            if (container_growth_policy<D>::capacity(derived()) < n) {
+                v1_dtl::assign_grown(
+                    derived(), n, x, v1_dtl::reservable<D>{});
             } else {
                 auto const min_size =
                     std::min<std::ptrdiff_t>(n, derived().size());
                 auto const fill_end =
                     std::fill_n(derived().begin(), min_size, x);
+                overwrites = min_size;
                 if (min_size < (std::ptrdiff_t)derived().size()) {
                     derived().erase(fill_end, derived().end());
                 } else {
-                    n -= min_size;
-                    derived().insert(
-                        derived().begin(),
-                        detail::make_n_iter(x, n),
-                        detail::make_n_iter_end(x, n));
+                    v1_dtl::insert_n(
+                        derived(), derived().end(), n - min_size, x);
                 }
             }
+            trace.done(derived(), overwrites);
         }
 
         template<typename D = Derived>
@@ -581,26 +1896,296 @@ namespace boost { namespace stl_interfaces { inline namespace v1 {
 
         template<typename D = Derived>
         constexpr auto clear() noexcept
-            -> decltype((void)std::declval<D &>().erase(
-                std::declval<D &>().begin(), std::declval<D &>().end()))
+            -> decltype(v1_dtl::clear_elements(std::declval<D &>(), 0))
         {
-            derived().erase(derived().begin(), derived().end());
+            v1_dtl::op_trace<D> const trace(derived());
+            v1_dtl::invalidate_iterators(derived());
+            v1_dtl::clear_elements(derived(), 0);
+            trace.done(derived());
         }
     };
 
+    /** Swaps `lhs` and `rhs` by swapping their bytes.  `D` must be trivially
+        relocatable; that is, `is_trivially_relocatable<D>` must be true.
+
+        If `D` has `data()`, `size()`, and `capacity()` members, and the
+        elements of `lhs` are stored inside `lhs` itself (as in a
+        fixed-capacity vector), only the bytes of `D` outside the element
+        storage and the bytes of the first `max(lhs.size(), rhs.size())`
+        elements are swapped.  Otherwise, all the bytes of `lhs` and `rhs`
+        are swapped. */
+    template<typename D>
+    void relocating_swap(D & lhs, D & rhs) noexcept;
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    namespace v1_dtl {
+        // Swaps n bytes, a word at a time.  The fixed-size memcpy() calls
+        // compile to single loads and stores, and the loop vectorizes; this
+        // is faster than swapping through a temporary buffer with
+        // variable-size memcpy() calls, especially for small n.
+        inline void
+        swap_bytes(unsigned char * a, unsigned char * b, std::size_t n) noexcept
+        {
+            std::size_t i = 0;
+            for (; i + sizeof(std::uint64_t) <= n; i += sizeof(std::uint64_t)) {
+                std::uint64_t x;
+                std::uint64_t y;
+                std::memcpy(&x, a + i, sizeof(x));
+                std::memcpy(&y, b + i, sizeof(y));
+                std::memcpy(a + i, &y, sizeof(y));
+                std::memcpy(b + i, &x, sizeof(x));
+            }
+            for (; i < n; ++i) {
+                std::swap(a[i], b[i]);
+            }
+        }
+
+        template<typename D>
+        using inline_storage_t = decltype(
+            std::declval<D &>().data(),
+            std::declval<D &>().size(),
+            std::declval<D &>().capacity());
+
+        template<typename D>
+        void relocating_swap_impl(D & lhs, D & rhs, std::false_type) noexcept
+        {
+            v1_dtl::swap_bytes(
+                reinterpret_cast<unsigned char *>(std::addressof(lhs)),
+                reinterpret_cast<unsigned char *>(std::addressof(rhs)),
+                sizeof(D));
+        }
+        template<typename D>
+        void relocating_swap_impl(D & lhs, D & rhs, std::true_type) noexcept
+        {
+            using value_type = typename D::value_type;
+            auto const lhs_bytes =
+                reinterpret_cast<unsigned char *>(std::addressof(lhs));
+            auto const rhs_bytes =
+                reinterpret_cast<unsigned char *>(std::addressof(rhs));
+            auto const object_addr =
+                reinterpret_cast<std::uintptr_t>(lhs_bytes);
+            auto const data_addr =
+                reinterpret_cast<std::uintptr_t>(lhs.data());
+            std::size_t const storage_size =
+                lhs.capacity() * sizeof(value_type);
+            bool const inline_storage =
+                object_addr <= data_addr &&
+                data_addr - object_addr <= sizeof(D) &&
+                storage_size <= sizeof(D) - (data_addr - object_addr);
+            if (!inline_storage) {
+                v1_dtl::relocating_swap_impl(lhs, rhs, std::false_type{});
+                return;
+            }
+            std::size_t const storage_first = data_addr - object_addr;
+            std::size_t const storage_last = storage_first + storage_size;
+            std::size_t const used =
+                (std::max)(std::size_t(lhs.size()), std::size_t(rhs.size())) *
+                sizeof(value_type);
+            v1_dtl::swap_bytes(lhs_bytes, rhs_bytes, storage_first);
+            v1_dtl::swap_bytes(
+                lhs_bytes + storage_first, rhs_bytes + storage_first, used);
+            v1_dtl::swap_bytes(
+                lhs_bytes + storage_last,
+                rhs_bytes + storage_last,
+                sizeof(D) - storage_last);
+        }
+
+        template<typename D>
+        using relocating_swappable = is_trivially_relocatable<D>;
+
+        template<typename D>
+        void swap_impl(D & lhs, D & rhs, std::true_type) noexcept
+        {
+            stl_interfaces::relocating_swap(lhs, rhs);
+        }
+        template<typename D>
+        void swap_impl(D & lhs, D & rhs, std::false_type) noexcept(
+            noexcept(lhs.swap(rhs)))
+        {
+            lhs.swap(rhs);
+        }
+    }
+
+    template<typename D>
+    void relocating_swap(D & lhs, D & rhs) noexcept
+    {
+        v1_dtl::relocating_swap_impl(
+            lhs,
+            rhs,
+            std::integral_constant<
+                bool,
+                detail::detector<void, v1_dtl::inline_storage_t, D>::value>{});
+    }
+
+#endif
+
     /** Implementation of free function `swap()` for all containers derived
-        from `container_interface`.  */
+        from `container_interface`.  If `is_trivially_relocatable<D>` is
+        true, this is `relocating_swap(lhs, rhs)`; otherwise, it is
+        `lhs.swap(rhs)`. */
     template<typename ContainerInterface>
     constexpr auto swap(
         ContainerInterface & lhs,
-        ContainerInterface & rhs) noexcept(noexcept(lhs.swap(rhs)))
-        -> decltype(v1_dtl::derived_container(lhs), lhs.swap(rhs))
+        ContainerInterface & rhs) noexcept(noexcept(lhs.swap(rhs)) ||
+                                           v1_dtl::relocating_swappable<
+                                               ContainerInterface>::value)
+        -> decltype(v1_dtl::derived_container(lhs), (void)lhs.swap(rhs))
     {
-        return lhs.swap(rhs);
+        v1_dtl::swap_impl(
+            lhs,
+            rhs,
+            v1_dtl::relocating_swappable<ContainerInterface>{});
+    }
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    namespace v1_dtl {
+        template<typename D>
+        using cmp_value_t =
+            std::remove_cv_t<typename std::iterator_traits<
+                decltype(std::declval<D const &>().begin())>::value_type>;
+
+        // True when the elements of D are contiguous, and equal exactly
+        // when their bytes are, as integers are.  (Enums are not included;
+        // they may have their own operator==() and operator<().)  Their
+        // comparisons can then be done with memcmp(), except during
+        // constant evaluation, and so only where that can be detected.
+        template<typename D>
+        using bytewise_comparable = std::integral_constant<
+            bool,
+#ifdef BOOST_STL_INTERFACES_CONSTANT_EVALUATED
+            is_contiguous_iterator<
+                decltype(std::declval<D const &>().begin())>::value &&
+                std::is_integral<cmp_value_t<D>>::value
+#else
+            false
+#endif
+            >;
+
+        // chars are ordered as unsigned, as std::char_traits<char> orders
+        // them, by every comparison of containers here, so that a container
+        // of chars has the same order as a std::string or std::string_view
+        // with the same elements, however it is compared.
+        template<typename T>
+        constexpr bool element_less(T const & a, T const & b)
+        {
+            return a < b;
+        }
+        constexpr bool element_less(char a, char b)
+        {
+            return (unsigned char)a < (unsigned char)b;
+        }
+
+        // Unsigned bytes and chars are ordered as memcmp() orders them.
+        template<typename T>
+        using memcmp_ordered = std::integral_constant<
+            bool,
+            sizeof(T) == 1 && std::is_integral<T>::value &&
+                (std::is_same<T, char>::value || !std::is_signed<T>::value)>;
+
+        template<typename D>
+        using bytewise_ordered = std::integral_constant<
+            bool,
+            bytewise_comparable<D>::value &&
+                memcmp_ordered<cmp_value_t<D>>::value>;
+
+        // Returns the index of the first element at which [a, a + n) and
+        // [b, b + n) differ, or n.  A cache line at a time is compared with
+        // memcmp(), which is vectorized, and only the cache line holding
+        // the difference is searched an element at a time.
+        template<typename T>
+        std::size_t
+        bytewise_mismatch(T const * a, T const * b, std::size_t n) noexcept
+        {
+            constexpr std::size_t block = 64 / sizeof(T) ? 64 / sizeof(T) : 1;
+            std::size_t i = 0;
+            for (; i + block <= n; i += block) {
+                if (std::memcmp(a + i, b + i, block * sizeof(T)))
+                    break;
+            }
+            for (; i < n && a[i] == b[i]; ++i) {
+            }
+            return i;
+        }
+
+        // A loop rather than std::equal(), which is not constexpr before
+        // C++20.
+        template<typename D>
+        constexpr bool
+        container_equal(D const & lhs, D const & rhs, std::false_type)
+        {
+            auto it2 = rhs.begin();
+            for (auto it1 = lhs.begin(), last1 = lhs.end(); it1 != last1;
+                 ++it1, ++it2) {
+                if (!(*it1 == *it2))
+                    return false;
+            }
+            return true;
+        }
+        template<typename D>
+        constexpr bool
+        container_equal(D const & lhs, D const & rhs, std::true_type)
+        {
+#ifdef BOOST_STL_INTERFACES_CONSTANT_EVALUATED
+            if (!BOOST_STL_INTERFACES_CONSTANT_EVALUATED()) {
+                auto const size = std::size_t(lhs.end() - lhs.begin());
+                return !size || !std::memcmp(
+                                    v1_dtl::data_address(lhs.begin()),
+                                    v1_dtl::data_address(rhs.begin()),
+                                    size * sizeof(cmp_value_t<D>));
+            }
+#endif
+            return v1_dtl::container_equal(lhs, rhs, std::false_type{});
+        }
+
+        template<typename D>
+        constexpr bool
+        container_less(D const & lhs, D const & rhs, std::false_type)
+        {
+            auto it1 = lhs.begin();
+            auto const last1 = lhs.end();
+            auto it2 = rhs.begin();
+            auto const last2 = rhs.end();
+            for (; it1 != last1 && it2 != last2; ++it1, ++it2) {
+                if (v1_dtl::element_less(*it1, *it2))
+                    return true;
+                if (v1_dtl::element_less(*it2, *it1))
+                    return false;
+            }
+            return it1 == last1 && it2 != last2;
+        }
+        template<typename D>
+        constexpr bool
+        container_less(D const & lhs, D const & rhs, std::true_type)
+        {
+#ifdef BOOST_STL_INTERFACES_CONSTANT_EVALUATED
+            if (!BOOST_STL_INTERFACES_CONSTANT_EVALUATED()) {
+                auto const size1 = std::size_t(lhs.end() - lhs.begin());
+                auto const size2 = std::size_t(rhs.end() - rhs.begin());
+                auto const n = (std::min)(size1, size2);
+                if (!n)
+                    return size1 < size2;
+                auto const p1 = v1_dtl::data_address(lhs.begin());
+                auto const p2 = v1_dtl::data_address(rhs.begin());
+                if (bytewise_ordered<D>::value) {
+                    int const cmp = std::memcmp(p1, p2, n);
+                    return cmp ? cmp < 0 : size1 < size2;
+                }
+                auto const i = v1_dtl::bytewise_mismatch(p1, p2, n);
+                return i < n ? v1_dtl::element_less(p1[i], p2[i])
+                             : size1 < size2;
+            }
+#endif
+            return v1_dtl::container_less(lhs, rhs, std::false_type{});
+        }
     }
 
+#endif
+
     /** Implementation of `operator==()` for all containers derived from
-        `container_interface`.  */
+        `container_interface`.  If the elements are contiguous integers, this
+        is a `std::memcmp()` (except in constant evaluation). */
     template<typename ContainerInterface>
     constexpr auto
     operator==(ContainerInterface const & lhs, ContainerInterface const & rhs) noexcept(
@@ -613,7 +2198,10 @@ namespace boost { namespace stl_interfaces { inline namespace v1 {
             true)
     {
         return lhs.size() == rhs.size() &&
-               std::equal(lhs.begin(), lhs.end(), rhs.begin());
+               v1_dtl::container_equal(
+                   lhs,
+                   rhs,
+                   v1_dtl::bytewise_comparable<ContainerInterface>{});
     }
 
     /** Implementation of `operator!=()` for all containers derived from
@@ -628,7 +2216,10 @@ namespace boost { namespace stl_interfaces { inline namespace v1 {
     }
 
     /** Implementation of `operator<()` for all containers derived from
-        `container_interface`.  */
+        `container_interface`.  If the elements are contiguous integers, the
+        first difference is found with `std::memcmp()` (except in constant
+        evaluation); for unsigned bytes, the `std::memcmp()` is the whole
+        comparison. */
     template<typename ContainerInterface>
     constexpr auto operator<(
         ContainerInterface const & lhs,
@@ -637,17 +2228,8 @@ namespace boost { namespace stl_interfaces { inline namespace v1 {
         -> decltype(
             v1_dtl::derived_container(lhs), *lhs.begin() < *rhs.begin(), true)
     {
-        auto it1 = lhs.begin();
-        auto const last1 = lhs.end();
-        auto it2 = rhs.begin();
-        auto const last2 = rhs.end();
-        for (; it1 != last1 && it2 != last2; ++it1, ++it2) {
-            if (*it1 < *it2)
-                return true;
-            if (*it2 < *it1)
-                return false;
-        }
-        return it1 == last1 && it2 != last2;
+        return v1_dtl::container_less(
+            lhs, rhs, v1_dtl::bytewise_comparable<ContainerInterface>{});
     }
 
     /** Implementation of `operator<=()` for all containers derived from
@@ -683,18 +2265,377 @@ namespace boost { namespace stl_interfaces { inline namespace v1 {
         return !(lhs < rhs);
     }
 
-}}}
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    namespace v1_dtl {
+        template<typename T>
+        using span_data_t = decltype(std::declval<T const &>().data());
+        template<typename T>
+        using span_size_t = decltype(std::declval<T const &>().size());
+
+        // The element type of a T whose data() is a pointer and that has
+        // size(), as contiguous containers and views do; void otherwise.
+        template<typename T, typename = void>
+        struct span_element
+        {
+            using type = void;
+        };
+        template<typename T>
+        struct span_element<
+            T,
+            void_t<
+                span_size_t<T>,
+                std::enable_if_t<std::is_pointer<span_data_t<T>>::value>>>
+        {
+            using type =
+                std::remove_cv_t<std::remove_pointer_t<span_data_t<T>>>;
+        };
+
+        template<typename T>
+        using derived_container_t =
+            decltype(v1_dtl::derived_container(std::declval<T const &>()));
+
+        // bool, if L and R are different types of contiguous range with the
+        // same element type, at least one of which is derived from
+        // container_interface.
+        template<typename L, typename R>
+        using hetero_cmp_t = std::enable_if_t<
+            !std::is_same<L, R>::value &&
+                !std::is_void<typename span_element<L>::type>::value &&
+                std::is_same<
+                    typename span_element<L>::type,
+                    typename span_element<R>::type>::value &&
+                (detail::detector<void, derived_container_t, L>::value ||
+                 detail::detector<void, derived_container_t, R>::value),
+            bool>;
+
+        // As bytewise_comparable, for an element type T.
+        template<typename T>
+        using bytewise_element = std::integral_constant<
+            bool,
+#ifdef BOOST_STL_INTERFACES_CONSTANT_EVALUATED
+            std::is_integral<T>::value
+#else
+            false
+#endif
+            >;
+
+        template<typename T>
+        using span_memcmp_ordered = std::integral_constant<
+            bool,
+            bytewise_element<T>::value && memcmp_ordered<T>::value>;
+
+        template<typename T>
+        constexpr bool span_equal(
+            T const * p1, T const * p2, std::size_t n, std::false_type)
+        {
+            for (std::size_t i = 0; i < n; ++i) {
+                if (!(p1[i] == p2[i]))
+                    return false;
+            }
+            return true;
+        }
+        template<typename T>
+        constexpr bool
+        span_equal(T const * p1, T const * p2, std::size_t n, std::true_type)
+        {
+#ifdef BOOST_STL_INTERFACES_CONSTANT_EVALUATED
+            if (!BOOST_STL_INTERFACES_CONSTANT_EVALUATED())
+                return !n || !std::memcmp(p1, p2, n * sizeof(T));
+#endif
+            return v1_dtl::span_equal(p1, p2, n, std::false_type{});
+        }
+
+        template<typename T>
+        constexpr bool span_less(
+            T const * p1,
+            std::size_t n1,
+            T const * p2,
+            std::size_t n2,
+            std::false_type)
+        {
+            auto const n = (std::min)(n1, n2);
+            for (std::size_t i = 0; i < n; ++i) {
+                if (v1_dtl::element_less(p1[i], p2[i]))
+                    return true;
+                if (v1_dtl::element_less(p2[i], p1[i]))
+                    return false;
+            }
+            return n1 < n2;
+        }
+        template<typename T>
+        constexpr bool span_less(
+            T const * p1,
+            std::size_t n1,
+            T const * p2,
+            std::size_t n2,
+            std::true_type)
+        {
+#ifdef BOOST_STL_INTERFACES_CONSTANT_EVALUATED
+            if (!BOOST_STL_INTERFACES_CONSTANT_EVALUATED()) {
+                auto const n = (std::min)(n1, n2);
+                if (!n)
+                    return n1 < n2;
+                if (span_memcmp_ordered<T>::value) {
+                    int const cmp = std::memcmp(p1, p2, n);
+                    return cmp ? cmp < 0 : n1 < n2;
+                }
+                auto const i = v1_dtl::bytewise_mismatch(p1, p2, n);
+                return i < n ? v1_dtl::element_less(p1[i], p2[i]) : n1 < n2;
+            }
+#endif
+            return v1_dtl::span_less(p1, n1, p2, n2, std::false_type{});
+        }
+    }
+
+#endif
+
+    /** Implementation of `operator==()` between two different types of
+        contiguous range with the same element type -- anything with a
+        `data()` pointer and a `size()`, such as `static_vector`s of
+        different capacities, a `static_string` and a `std::string`, or a
+        `static_vector<char, N>` and a `std::string_view` -- at least one of
+        which is derived from `container_interface`.  Neither is copied into
+        a temporary of the other's type.  If the elements are integers, this
+        is a `std::memcmp()` (except in constant evaluation). */
+    template<typename L, typename R>
+    constexpr auto operator==(L const & lhs, R const & rhs) noexcept(
+        noexcept(*lhs.data() == *rhs.data()))
+        -> decltype(
+            v1_dtl::hetero_cmp_t<L, R>(), bool(*lhs.data() == *rhs.data()))
+    {
+        using value_type = typename v1_dtl::span_element<L>::type;
+        return std::size_t(lhs.size()) == std::size_t(rhs.size()) &&
+               v1_dtl::span_equal(
+                   lhs.data(),
+                   rhs.data(),
+                   std::size_t(lhs.size()),
+                   v1_dtl::bytewise_element<value_type>{});
+    }
+
+    /** Implementation of `operator!=()` between two different types of
+        contiguous range; see the heterogeneous `operator==()`. */
+    template<typename L, typename R>
+    constexpr auto operator!=(L const & lhs, R const & rhs) noexcept(
+        noexcept(*lhs.data() == *rhs.data()))
+        -> decltype(
+            v1_dtl::hetero_cmp_t<L, R>(), bool(*lhs.data() == *rhs.data()))
+    {
+        return !(lhs == rhs);
+    }
+
+    /** Implementation of `operator<()` between two different types of
+        contiguous range; see the heterogeneous `operator==()`.  The
+        comparison is lexicographical, with the elements' `operator<()`,
+        except that `char`s are ordered as unsigned, as
+        `std::char_traits<char>` orders them, so that the result agrees
+        with that of a `std::string` or `std::string_view` operand.  For
+        unsigned bytes and `char`s, the comparison is one `std::memcmp()`
+        (except in constant evaluation). */
+    template<typename L, typename R>
+    constexpr auto operator<(L const & lhs, R const & rhs) noexcept(
+        noexcept(*lhs.data() < *rhs.data()))
+        -> decltype(
+            v1_dtl::hetero_cmp_t<L, R>(), bool(*lhs.data() < *rhs.data()))
+    {
+        using value_type = typename v1_dtl::span_element<L>::type;
+        return v1_dtl::span_less(
+            lhs.data(),
+            std::size_t(lhs.size()),
+            rhs.data(),
+            std::size_t(rhs.size()),
+            v1_dtl::bytewise_element<value_type>{});
+    }
+
+    /** Implementation of `operator<=()` between two different types of
+        contiguous range; see the heterogeneous `operator<()`. */
+    template<typename L, typename R>
+    constexpr auto operator<=(L const & lhs, R const & rhs) noexcept(
+        noexcept(*lhs.data() < *rhs.data()))
+        -> decltype(
+            v1_dtl::hetero_cmp_t<L, R>(), bool(*lhs.data() < *rhs.data()))
+    {
+        return !(rhs < lhs);
+    }
+
+    /** Implementation of `operator>()` between two different types of
+        contiguous range; see the heterogeneous `operator<()`. */
+    template<typename L, typename R>
+    constexpr auto operator>(L const & lhs, R const & rhs) noexcept(
+        noexcept(*lhs.data() < *rhs.data()))
+        -> decltype(
+            v1_dtl::hetero_cmp_t<L, R>(), bool(*lhs.data() < *rhs.data()))
+    {
+        return rhs < lhs;
+    }
+
+    /** Implementation of `operator>=()` between two different types of
+        contiguous range; see the heterogeneous `operator<()`. */
+    template<typename L, typename R>
+    constexpr auto operator>=(L const & lhs, R const & rhs) noexcept(
+        noexcept(*lhs.data() < *rhs.data()))
+        -> decltype(
+            v1_dtl::hetero_cmp_t<L, R>(), bool(*lhs.data() < *rhs.data()))
+    {
+        return !(lhs < rhs);
+    }
+
+}}}
+
+
+namespace boost { namespace stl_interfaces { namespace v2 {
+
+    // This is only here to satisfy clang-format.
+    namespace v2_dtl {
+    }
+
+#if 201711L <= __cpp_lib_three_way_comparison
+    namespace v2_dtl {
+        // The element comparison of operator<=>(), which orders chars as
+        // unsigned, as v1_dtl::element_less() does.
+        struct element_three_way
+        {
+            template<typename T, typename U>
+            constexpr auto operator()(T const & a, U const & b) const
+            {
+                return a <=> b;
+            }
+            constexpr std::strong_ordering operator()(char a, char b) const
+            {
+                return (unsigned char)a <=> (unsigned char)b;
+            }
+        };
+
+        // operator<=>() for [p1, p1 + n1) and [p2, p2 + n2), whose elements
+        // are v1_dtl::bytewise_element.
+        template<typename T>
+        std::strong_ordering bytewise_three_way(
+            T const * p1, std::size_t n1, T const * p2, std::size_t n2)
+        {
+            auto const n = (std::min)(n1, n2);
+            if (!n)
+                return n1 <=> n2;
+            auto const i = v1_dtl::bytewise_mismatch(p1, p2, n);
+            return i < n ? element_three_way{}(p1[i], p2[i]) : n1 <=> n2;
+        }
+
+        // operator<=>() for containers whose elements are
+        // v1_dtl::bytewise_comparable.
+        template<typename D>
+        std::strong_ordering bytewise_three_way(D const & lhs, D const & rhs)
+        {
+            auto const size1 = std::size_t(lhs.end() - lhs.begin());
+            auto const size2 = std::size_t(rhs.end() - rhs.begin());
+            if (!size1 || !size2)
+                return size1 <=> size2;
+            return v2_dtl::bytewise_three_way(
+                v1_dtl::data_address(lhs.begin()),
+                size1,
+                v1_dtl::data_address(rhs.begin()),
+                size2);
+        }
+    }
+#endif
+
+    // clang-format off
 
+#if 201703L < __cplusplus && defined(__cpp_lib_concepts) &&                    \
+        !defined(BOOST_STL_INTERFACES_DISABLE_V2) ||                           \
+    BOOST_STL_INTERFACES_DOXYGEN
 
-namespace boost { namespace stl_interfaces { namespace v2 {
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
 
-    // This is only here to satisfy clang-format.
     namespace v2_dtl {
-    }
+        // What the members of container_interface<D> need to know about D.
+        // Each member's constraint names one of these constants, rather than
+        // spelling out its own concept checks, so each check is done once
+        // per D, when container_traits<D> is first used, instead of once
+        // for each member whose overload resolution it takes part in.
+        template<typename D>
+        struct container_traits
+        {
+          using iterator = std::ranges::iterator_t<D>;
+          using const_iterator = std::ranges::iterator_t<const D>;
+          using value_type = std::ranges::range_value_t<D>;
+          using size_type = typename D::size_type;
+
+          static constexpr bool contiguous =
+            std::contiguous_iterator<iterator>;
+          static constexpr bool const_contiguous =
+            std::contiguous_iterator<const_iterator>;
+          static constexpr bool sized =
+            std::sized_sentinel_for<std::ranges::sentinel_t<const D>,
+                                    const_iterator>;
+          static constexpr bool reversible =
+            std::ranges::bidirectional_range<D> &&
+            std::ranges::common_range<D>;
+          static constexpr bool const_reversible =
+            std::ranges::bidirectional_range<const D> &&
+            std::ranges::common_range<const D>;
+          static constexpr bool random_access =
+            std::ranges::random_access_range<D>;
+          static constexpr bool const_random_access =
+            std::ranges::random_access_range<const D>;
+
+          static constexpr bool erase =
+            requires (D & d, const_iterator pos) { d.erase(pos, pos); };
+          static constexpr bool copy_emplace_front =
+            requires (D & d, const value_type & x) { d.emplace_front(x); };
+          static constexpr bool move_emplace_front =
+            requires (D & d, value_type && x) {
+              d.emplace_front(std::move(x));
+            };
+          static constexpr bool copy_emplace_back = reversible &&
+            requires (D & d, const value_type & x) { d.emplace_back(x); };
+          static constexpr bool move_emplace_back = reversible &&
+            requires (D & d, value_type && x) {
+              d.emplace_back(std::move(x));
+            };
+          static constexpr bool copy_emplace =
+            requires (D & d, const_iterator pos, const value_type & x) {
+              d.emplace(pos, x);
+            };
+          static constexpr bool move_emplace =
+            requires (D & d, const_iterator pos, value_type && x) {
+              d.emplace(pos, std::move(x));
+            };
+          static constexpr bool insert_n =
+            requires (D & d,
+                      const_iterator pos,
+                      detail::n_iter<value_type, size_type> it) {
+              d.insert(pos, it, it);
+            };
+          static constexpr bool insert_il =
+            requires (D & d, const_iterator pos, const value_type * it) {
+              d.insert(pos, it, it);
+            };
+          static constexpr bool resize_n_x =
+            std::default_initializable<value_type> &&
+            requires (D & d, size_type n, const value_type & x) {
+              d.resize(n, x);
+            };
+          static constexpr bool resize_for_overwrite =
+            requires (D & d, size_type n) { d.resize(n, v1::default_init); };
+          static constexpr bool swap = requires (D & d) { d.swap(d); };
+
+          static constexpr bool equality_comparable =
+            std::ranges::sized_range<const D> &&
+            std::equality_comparable<std::iter_reference_t<const_iterator>>;
+          static constexpr bool three_way_comparable =
+            std::three_way_comparable<std::iter_reference_t<const_iterator>>;
+          static constexpr bool less_than_comparable =
+            std::totally_ordered<std::iter_reference_t<const_iterator>>;
+        };
 
-    // clang-format off
+        template<typename D, typename Iter>
+        BOOST_STL_INTERFACES_CONCEPT erase_insert =
+          container_traits<D>::erase && std::input_iterator<Iter> &&
+            requires (D & d, std::ranges::iterator_t<const D> pos, Iter it) {
+              d.insert(pos, it, it);
+            };
+    }
 
-#if 201703L < __cplusplus && defined(__cpp_lib_concepts) || BOOST_STL_INTERFACES_DOXYGEN
+#endif
 
     /** A CRTP template that one may derive from to make it easier to define
         container types.
@@ -712,11 +2653,21 @@ namespace boost { namespace stl_interfaces { namespace v2 {
         For an object `d` of type `D`, a call to `std::ranges::begin(d)` shall
         not mutate any data members of `d`, and `d`'s destructor shall end the
         lifetimes of the objects in `[std::ranges::begin(d),
-        std::ranges::end(d))`. */
+        std::ranges::end(d))`.
+
+        Each member is constrained on a property of `D` that is checked once
+        per `D`, however many members depend on it.
+
+        The members that `v1::container_interface` adds to the standard
+        container interface, from `append_range()` to `copy_reversed_to()`,
+        are provided here too, with the same semantics, except that they do
+        not report to `container_op_hooks`. */
     template<typename D>
       requires std::is_class_v<D> && std::same_as<D, std::remove_cv_t<D>>
     struct container_interface {
     private:
+      using traits = v2_dtl::container_traits<D>;
+
       constexpr D& derived() noexcept {
         return static_cast<D&>(*this);
       }
@@ -726,10 +2677,13 @@ namespace boost { namespace stl_interfaces { namespace v2 {
       constexpr D & mutable_derived() const noexcept {
         return const_cast<D&>(static_cast<const D&>(*this));
       }
-      static constexpr void clear_impl(D& d) noexcept {}
-      static constexpr void clear_impl(D& d) noexcept
-        requires requires { d.clear()); }
-      { d.clear(); }
+      template<typename C>
+      static constexpr void clear_impl(C& d) noexcept {}
+      template<typename C>
+      static constexpr void clear_impl(C& d) noexcept
+        requires v2_dtl::container_traits<C>::erase {
+          d.clear();
+        }
 
     public:
       ~container_interface() { clear_impl(derived()); }
@@ -738,19 +2692,22 @@ namespace boost { namespace stl_interfaces { namespace v2 {
         return std::ranges::begin(derived()) == std::ranges::end(derived());
       }
 
-      constexpr auto data() requires std::contiguous_iterator<std::ranges::iterator_t<D>> {
-        return std::to_address(std::ranges::begin(derived()));
-      }
-      constexpr auto data() const requires std::contiguous_iterator<std::ranges::iterator_t<const D>> {
-          return std::to_address(std::ranges::begin(derived()));
+      template<typename C = D>
+        constexpr auto data() requires v2_dtl::container_traits<C>::contiguous {
+          return v1_dtl::data_address(std::ranges::begin(derived()));
         }
+      template<typename C = D>
+        constexpr auto data() const
+          requires v2_dtl::container_traits<C>::const_contiguous {
+            return v1_dtl::data_address(std::ranges::begin(derived()));
+          }
 
-      constexpr auto size() const
-        requires std::sized_sentinel_for<std::sentinel_t<const D>, std::ranges::iterator_t<const D>>
-        -> v2_dtl::container_size_t<D> {
-          return v2_dtl::container_size_t<D>(
-            std::ranges::end(derived()) - std::ranges::begin(derived()));
-        }
+      template<typename C = D>
+        constexpr auto size() const
+          requires v2_dtl::container_traits<C>::sized {
+            return typename C::size_type(
+              std::ranges::end(derived()) - std::ranges::begin(derived()));
+          }
 
       constexpr decltype(auto) front() {
         BOOST_ASSERT(!empty());
@@ -763,191 +2720,355 @@ namespace boost { namespace stl_interfaces { namespace v2 {
 
       template<typename C = D>
         constexpr void push_front(const std::ranges::range_value_t<C>& x)
-          requires requires { derived().emplace_front(x); } {
+          requires v2_dtl::container_traits<C>::copy_emplace_front {
             derived().emplace_front(x);
           }
-      template<typenaem C = D>
+      template<typename C = D>
         constexpr void push_front(std::ranges::range_value_t<C>&& x)
-          requires requires { derived().emplace_front(std::move(x)); } {
+          requires v2_dtl::container_traits<C>::move_emplace_front {
             derived().emplace_front(std::move(x));
           }
-      constexpr void pop_front() noexcept
-        requires requires (const std::ranges::range_value_t<D>& x, std::ranges::iterator_t<D> position) {
-          derived().emplace_front(x);
-          derived().erase(position);
-        } {
-          return derived().erase(std::ranges::begin(derived()));
-        }
+      template<typename C = D>
+        constexpr void pop_front() noexcept
+          requires v2_dtl::container_traits<C>::copy_emplace_front &&
+            v2_dtl::container_traits<C>::erase {
+              derived().erase(std::ranges::begin(derived()));
+            }
 
-      constexpr decltype(auto) back()
-        requires std::ranges::bidirectional_range<D> && std::ranges::common_range<D> {
-          BOOST_ASSERT(!empty());
-          return *std::ranges::prev(std::ranges::begin(derived()));
-        }
-      constexpr decltype(auto) back() const
-        requires std::ranges::bidirectional_range<const D> && std::ranges::common_range<const D> {
-          BOOST_ASSERT(!empty());
-          return *std::ranges::prev(std::ranges::begin(derived()));
-        }
+      template<typename C = D>
+        constexpr decltype(auto) back()
+          requires v2_dtl::container_traits<C>::reversible {
+            BOOST_ASSERT(!empty());
+            return *std::ranges::prev(std::ranges::end(derived()));
+          }
+      template<typename C = D>
+        constexpr decltype(auto) back() const
+          requires v2_dtl::container_traits<C>::const_reversible {
+            BOOST_ASSERT(!empty());
+            return *std::ranges::prev(std::ranges::end(derived()));
+          }
 
-      template<std::ranges::bidirectional_range C = D>
+      template<typename C = D>
         constexpr void push_back(const std::ranges::range_value_t<C>& x)
-          requires std::ranges::common_range<C> && requires { derived().emplace_back(x); } {
+          requires v2_dtl::container_traits<C>::copy_emplace_back {
             derived().emplace_back(x);
           }
-      template<std::ranges::bidirectional_range C = D>
+      template<typename C = D>
         constexpr void push_back(std::ranges::range_value_t<C>&& x)
-          requires std::ranges::common_range<C> && requires { derived().emplace_back(std::move(x)); } {
+          requires v2_dtl::container_traits<C>::move_emplace_back {
             derived().emplace_back(std::move(x));
           }
-      constexpr void pop_back() noexcept
-        requires std::ranges::bidirectional_range<D> && std::ranges::common_range<D> &&
-          requires (const std::ranges::range_value_t<D>& x, std::ranges::iterator_t<D> position) {
-            derived().emplace_back(x);
-            derived().erase(position);
+
+      template<typename C = D, typename... Args>
+        constexpr decltype(auto) unchecked_emplace_back(Args&&... args)
+          requires requires (C & d, Args&&... as) {
+            v1_dtl::append_unchecked(d, 0, std::forward<Args>(as)...);
+          } {
+            return v1_dtl::append_unchecked(
+              derived(), 0, std::forward<Args>(args)...);
+          }
+      template<typename C = D>
+        constexpr void
+        unchecked_push_back(const std::ranges::range_value_t<C>& x)
+          requires requires (C & d, const std::ranges::range_value_t<C>& x) {
+            d.unchecked_emplace_back(x);
+          } {
+            derived().unchecked_emplace_back(x);
+          }
+      template<typename C = D>
+        constexpr void unchecked_push_back(std::ranges::range_value_t<C>&& x)
+          requires requires (C & d, std::ranges::range_value_t<C>&& x) {
+            d.unchecked_emplace_back(std::move(x));
           } {
-            return derived().erase(std::ranges::prev(std::ranges::end(derived())));
+            derived().unchecked_emplace_back(std::move(x));
           }
+      template<typename C = D>
+        constexpr void pop_back() noexcept
+          requires v2_dtl::container_traits<C>::copy_emplace_back &&
+            v2_dtl::container_traits<C>::erase {
+              derived().erase(std::ranges::prev(std::ranges::end(derived())));
+            }
 
-      template<std::ranges::random_access_range C = D>
-        constexpr decltype(auto) operator[](v2_dtl::container_size_t<C> n) {
-          return std::ranges::begin(derived())[n];
-        }
-      template<std::ranges::random_access_range C = const D>
-        constexpr decltype(auto) operator[](v2_dtl::container_size_t<C> n) const {
-          return std::ranges::begin(derived())[n];
-        }
+      template<typename C = D>
+        constexpr decltype(auto) operator[](typename C::size_type n)
+          requires v2_dtl::container_traits<C>::random_access {
+            return std::ranges::begin(derived())[n];
+          }
+      template<typename C = D>
+        constexpr decltype(auto) operator[](typename C::size_type n) const
+          requires v2_dtl::container_traits<C>::const_random_access {
+            return std::ranges::begin(derived())[n];
+          }
 
-      template<std::ranges::random_access_range C = D>
-        constexpr decltype(auto) at(v2_dtl::container_size_t<C> n) {
-          if (derived().size() < n)
-            throw std::out_of_range("Bounds check failed in container_interface::at()");
-          return std::ranges::begin(derived())[n];
-        }
-      template<std::ranges::random_access_range C = const D>
-        constexpr decltype(auto) at(v2_dtl::container_size_t<C> n) const {
-          if (derived().size() < n)
-            throw std::out_of_range("Bounds check failed in container_interface::at()");
-          return std::ranges::begin(derived())[n];
-        }
+      template<typename C = D>
+        constexpr decltype(auto) at(typename C::size_type n)
+          requires v2_dtl::container_traits<C>::random_access {
+            if (derived().size() <= n)
+              throw std::out_of_range("Bounds check failed in container_interface::at()");
+            return std::ranges::begin(derived())[n];
+          }
+      template<typename C = D>
+        constexpr decltype(auto) at(typename C::size_type n) const
+          requires v2_dtl::container_traits<C>::const_random_access {
+            if (derived().size() <= n)
+              throw std::out_of_range("Bounds check failed in container_interface::at()");
+            return std::ranges::begin(derived())[n];
+          }
 
       template<typename C = D>
-        constexpr void resize(v2_dtl::container_size_t<C> n)
-          requires requires {
-            std::ranges::range_value_t<D>();
-            derived().resize(n, std::ranges::range_value_t<D>());
-          } {
-            derived().resize(n, std::ranges::range_value_t<D>());
+        constexpr void resize(typename C::size_type n)
+          requires v2_dtl::container_traits<C>::resize_n_x {
+            derived().resize(n, std::ranges::range_value_t<C>());
+          }
+      template<typename C = D>
+        constexpr void resize_for_overwrite(typename C::size_type n)
+          requires v2_dtl::container_traits<C>::resize_for_overwrite {
+            derived().resize(n, v1::default_init);
           }
 
-      constexpr auto begin() {
-        return typename D::const_iterator(std::ranges::begin(mutable_derived()));
-      }
-      constexpr auto end() const {
-        return typename D::const_iterator(std::ranges::end(mutable_derived()));
-      }
+      template<typename C = D>
+        constexpr auto begin() const {
+          return typename C::const_iterator(
+            std::ranges::begin(mutable_derived()));
+        }
+      template<typename C = D>
+        constexpr auto end() const {
+          return typename C::const_iterator(std::ranges::end(mutable_derived()));
+        }
 
       constexpr auto cbegin() const { return std::ranges::begin(derived()); }
       constexpr auto cend() const { return std::ranges::end(derived()); }
 
-      constexpr auto rbegin()
-        requires std::ranges::bidirectional_range<D> && std::cranges::ommon_range<D> {
-          return std::reverse_iterator(std::ranges::end(derived()));
-        }
-      constexpr auto rend()
-        requires std::ranges::bidirectional_range<D> && std::ranges::common_range<D> {
-          return std::reverse_iterator(std::ranges::begin(derived()));
-        }
+      template<typename C = D>
+        constexpr auto rbegin()
+          requires v2_dtl::container_traits<C>::reversible {
+            return stl_interfaces::reverse_iterator(std::ranges::end(derived()));
+          }
+      template<typename C = D>
+        constexpr auto rend()
+          requires v2_dtl::container_traits<C>::reversible {
+            return stl_interfaces::reverse_iterator(std::ranges::begin(derived()));
+          }
 
-      constexpr auto rbegin() const
-        requires std::ranges::bidirectional_range<const D> &&
-          std::ranges::common_range<const D> {
-            return std::reverse_iterator(std::ranges::iterator_t<const D>(
-              std::ranges::end(mutable_derived())));
+      template<typename C = D>
+        constexpr auto rbegin() const
+          requires v2_dtl::container_traits<C>::const_reversible {
+            return stl_interfaces::reverse_iterator(std::ranges::end(derived()));
           }
-      constexpr auto rend() const
-        requires std::ranges::bidirectional_range<const D> &&
-          std::ranges::common_range<const D> {
-            return std::reverse_iterator(std::ranges::iterator_t<const D>(
-              std::ranges::begin(mutable_derived())));
+      template<typename C = D>
+        constexpr auto rend() const
+          requires v2_dtl::container_traits<C>::const_reversible {
+            return stl_interfaces::reverse_iterator(std::ranges::begin(derived()));
           }
 
-      constexpr auto crbegin() const
-        requires std::ranges::bidirectional_range<const D> &&
-          std::ranges::common_range<const D> {
-            return stl_interfaces::reverse_iterator(ranges::iterator_t<const D>(
-              ranges::end(mutable_derived())));
-            }
-      constexpr auto crend() const
-        requires std::ranges::bidirectional_range<const D> &&
-          std::ranges::common_range<const D> {
-            return std::reverse_iterator(std::ranges::iterator_t<const D>(
-              std::ranges::begin(mutable_derived())));
-            }
+      template<typename C = D>
+        constexpr auto crbegin() const
+          requires v2_dtl::container_traits<C>::const_reversible {
+            return stl_interfaces::reverse_iterator(std::ranges::end(derived()));
+          }
+      template<typename C = D>
+        constexpr auto crend() const
+          requires v2_dtl::container_traits<C>::const_reversible {
+            return stl_interfaces::reverse_iterator(std::ranges::begin(derived()));
+          }
+
+      template<typename T, typename C = D>
+        constexpr auto find_last(const T& x)
+          requires v2_dtl::container_traits<C>::reversible {
+            return v1_dtl::find_last_impl(
+              std::ranges::begin(derived()), std::ranges::end(derived()), x,
+              std::bool_constant<
+                v2_dtl::container_traits<C>::contiguous &&
+                v1_dtl::simd_searchable_elements<
+                  std::ranges::range_value_t<C>, T>::value>{});
+          }
+      template<typename T, typename C = D>
+        constexpr auto find_last(const T& x) const
+          requires v2_dtl::container_traits<C>::const_reversible {
+            return v1_dtl::find_last_impl(
+              std::ranges::begin(derived()), std::ranges::end(derived()), x,
+              std::bool_constant<
+                v2_dtl::container_traits<C>::const_contiguous &&
+                v1_dtl::simd_searchable_elements<
+                  std::ranges::range_value_t<C>, T>::value>{});
+          }
+
+      template<typename Pred, typename C = D>
+        constexpr auto rfind_if(Pred pred)
+          requires v2_dtl::container_traits<C>::reversible {
+            return v1_dtl::rfind_if_impl(
+              std::ranges::begin(derived()), std::ranges::end(derived()), pred,
+              std::bool_constant<v2_dtl::container_traits<C>::contiguous>{});
+          }
+      template<typename Pred, typename C = D>
+        constexpr auto rfind_if(Pred pred) const
+          requires v2_dtl::container_traits<C>::const_reversible {
+            return v1_dtl::rfind_if_impl(
+              std::ranges::begin(derived()), std::ranges::end(derived()), pred,
+              std::bool_constant<
+                v2_dtl::container_traits<C>::const_contiguous>{});
+          }
+
+      template<std::weakly_incrementable OutIter, typename C = D>
+        constexpr OutIter copy_reversed_to(OutIter out) const
+          requires v2_dtl::container_traits<C>::const_reversible {
+            using iterator = std::ranges::iterator_t<const C>;
+            return v1_dtl::copy_reversed_impl(
+              std::ranges::begin(derived()), std::ranges::end(derived()), out,
+              std::bool_constant<
+                v2_dtl::container_traits<C>::const_contiguous &&
+                v1_dtl::reversed_copyable<iterator, OutIter>::value>{});
+          }
 
       template<typename C = D>
         constexpr auto insert(std::ranges::iterator_t<const C> position,
                               const std::ranges::range_value_t<C>& x)
-          requires requires { derived().emplace(position, x); } {
-            derived().emplace(position, x);
+          requires v2_dtl::container_traits<C>::copy_emplace {
+            return derived().emplace(position, x);
           }
       template<typename C = D>
         constexpr auto insert(std::ranges::iterator_t<const C> position,
                               std::ranges::range_value_t<C>&& x)
-          requires requires { derived().emplace(position, std::move(x)); } {
-            derived().emplace(position, std::move(x));
+          requires v2_dtl::container_traits<C>::move_emplace {
+            return derived().emplace(position, std::move(x));
           }
       template<typename C = D>
         constexpr auto insert(std::ranges::iterator_t<const C> position,
-                              v2_dtl::container_size_t<C> n,
+                              typename C::size_type n,
                               const std::ranges::range_value_t<C>& x)
-          requires requires {
-            derived().insert(position, detail::make_n_iter(x, n), detail::make_n_iter_end(x, n)); } {
-              derived().insert(position,  detail::make_n_iter(x, n), detail::make_n_iter_end(x, n));
-            }
+          // Unconstrained, since insert_n is itself a check of D::insert(),
+          // whose overloads include this one.
+          {
+            return derived().insert(position, detail::make_n_iter(x, n),
+                                    detail::make_n_iter_end(x, n));
+          }
       template<typename C = D>
         constexpr auto insert(std::ranges::iterator_t<const C> position,
                               std::initializer_list<std::ranges::range_value_t<C>> il)
-          requires requires { derived().insert(position, il.begin(), il.end()); } {
-            derived().insert(position, il.begin(), il.end());
+          requires v2_dtl::container_traits<C>::insert_il {
+            return derived().insert(position, il.begin(), il.end());
+          }
+
+      template<std::ranges::input_range R, typename C = D>
+        constexpr auto insert_range(std::ranges::iterator_t<const C> position,
+                                    R&& r)
+          requires std::ranges::common_range<R> &&
+            requires (C & d, std::ranges::iterator_t<const C> pos,
+                      std::ranges::iterator_t<R> it) {
+              d.insert(pos, it, it);
+            } {
+              position = v1_dtl::reserve_for_append(
+                derived(), position, v1_dtl::sized_distance(r));
+              return derived().insert(
+                position, std::ranges::begin(r), std::ranges::end(r));
+            }
+
+      template<std::forward_iterator Iter, typename Compare, typename C = D>
+        constexpr void insert_sorted(Iter first, Iter last, Compare comp)
+          requires v2_dtl::container_traits<C>::reversible &&
+            requires (C & d, Iter it) { d.insert(d.end(), it, it); } {
+              v1_dtl::invalidate_iterators(derived());
+              auto const n = v1_dtl::element_count(derived());
+              v1_dtl::reserve_for_append(
+                derived(), derived().end(),
+                std::size_t(std::ranges::distance(first, last)));
+              derived().insert(derived().end(), first, last);
+              auto const d_first = std::ranges::begin(derived());
+              std::inplace_merge(
+                d_first, std::ranges::next(d_first, n),
+                std::ranges::end(derived()), std::move(comp));
+            }
+      template<std::forward_iterator Iter, typename C = D>
+        constexpr void insert_sorted(Iter first, Iter last)
+          requires requires (C & d, Iter it) {
+            d.insert_sorted(it, it, std::ranges::less{});
+          } {
+            derived().insert_sorted(first, last, std::ranges::less{});
+          }
+
+      template<std::ranges::input_range R, typename C = D>
+        constexpr void append_range(R&& r)
+          requires requires (C & d, std::ranges::iterator_t<R> it) {
+            d.emplace_back(*it);
+          } {
+            v1_dtl::reserve_for_append(
+              derived(), derived().end(), v1_dtl::sized_distance(r));
+            v1_dtl::append_range_impl(
+              derived(), r,
+              std::bool_constant<
+                detail::detector<void, v1_dtl::range_insert_t, C, R>::value>{});
           }
 
       template<typename C = D>
-        constexpr void erase(D::const_iterator position)
-          requires requires { derived().erase(position, std::ranges::next(position)); } {
-            derived().erase(position, std::ranges::next(position));
+        constexpr auto erase(std::ranges::iterator_t<const C> position)
+          requires v2_dtl::container_traits<C>::erase {
+            return derived().erase(position, std::ranges::next(position));
+          }
+
+      template<typename Pred, typename C = D>
+        constexpr auto erase_if(Pred pred)
+          requires v2_dtl::container_traits<C>::erase {
+            v1_dtl::invalidate_iterators(derived());
+            auto const new_end = v1_dtl::compact(
+              derived(),
+              [&pred](auto first, auto last) {
+                return std::remove_if(first, last, pred);
+              },
+              std::bool_constant<v2_dtl::container_traits<C>::contiguous>{});
+            auto const last = std::ranges::end(derived());
+            auto const n =
+              typename C::size_type(std::ranges::distance(new_end, last));
+            derived().erase(new_end, last);
+            return n;
           }
 
-      template<std::ranges::input_iterator Iter, typename C = D>
+      template<std::ranges::input_range R, typename C = D>
+        constexpr auto erase_indices(const R& indices)
+          requires v2_dtl::container_traits<C>::erase &&
+            v2_dtl::container_traits<C>::random_access &&
+            std::convertible_to<std::ranges::range_reference_t<const R>,
+                                std::ptrdiff_t> {
+              v1_dtl::invalidate_iterators(derived());
+              auto const new_end = v1_dtl::compact(
+                derived(),
+                [&indices](auto first, auto last) {
+                  return v1_dtl::remove_indices(
+                    first, last, std::ranges::begin(indices),
+                    std::ranges::end(indices));
+                },
+                std::bool_constant<v2_dtl::container_traits<C>::contiguous>{});
+              auto const last = std::ranges::end(derived());
+              auto const n = typename C::size_type(last - new_end);
+              derived().erase(new_end, last);
+              return n;
+            }
+
+      template<std::input_iterator Iter, typename C = D>
         constexpr void assign(Iter first, Iter last)
-          requires requires {
-            derived().erase(std::ranges::begin(derived()), std::ranges::end(derived()));
-            derived().insert(std::ranges::begin(derived()), first, last); } {
-              auto out = derived().begin();
-              auto const out_last = derived().end();
-              for (; out != out_last && first != last; ++first, ++out) {
-                *out = *first;
-              }
-              if (out != out_last)
-                derived().erase(out, out_last);
-              if (first != last)
-                derived().insert(derived().end(), first, last);
+          requires v2_dtl::erase_insert<C, Iter> {
+            auto out = derived().begin();
+            auto const out_last = derived().end();
+            for (; out != out_last && first != last; ++first, ++out) {
+              *out = *first;
             }
+            if (out != out_last)
+              derived().erase(out, out_last);
+            if (first != last)
+              derived().insert(derived().end(), first, last);
+          }
       template<typename C = D>
-        constexpr void assign(v2_dtl::container_size_t<C> n,
+        constexpr void assign(typename C::size_type n,
                               const std::ranges::range_value_t<C>& x)
-          requires requires {
-            { derived().size() } -> std::convertible_to<std::size_t>;
-            derived().erase(std::ranges::begin(derived()), std::ranges::end(derived()));
-            derived().insert(std::ranges::begin(derived()),
-                             detail::make_n_iter(x, n),
-                             detail::make_n_iter_end(x, n)); } {
-              if (detail::fake_capacity(derived()) < n) {
+          requires v2_dtl::container_traits<C>::erase &&
+            v2_dtl::container_traits<C>::insert_n {
+              if (v1::container_growth_policy<C>::capacity(derived()) < n) {
                 C temp(n, x);
                 derived().swap(temp);
               } else {
-                auto const min_size = std::min<std::ptrdiff_t>(n, derived().size());
-                auto const fill_end = std::fill_n(derived().begin(), min_size, x);
+                auto const min_size =
+                  std::min<std::ptrdiff_t>(n, derived().size());
+                auto const fill_end =
+                  std::fill_n(derived().begin(), min_size, x);
                 if (min_size < (std::ptrdiff_t)derived().size()) {
                   derived().erase(fill_end, derived().end());
                 } else {
@@ -961,41 +3082,182 @@ namespace boost { namespace stl_interfaces { namespace v2 {
             }
       template<typename C = D>
         constexpr void assign(std::initializer_list<std::ranges::range_value_t<C>> il)
-          requires requires { derived().assign(il.begin(), il.end()); } {
-            derived().assign(il.begin(), il.end());
-          }
+          requires v2_dtl::container_traits<C>::erase &&
+            v2_dtl::container_traits<C>::insert_il {
+              derived().assign(il.begin(), il.end());
+            }
 
-      constexpr void clear() noexcept
-        requires requires {
-          derived().erase(std::ranges::begin(derived()), std::ranges::end(derived())); } {
-            derived().erase(std::ranges::begin(derived()), std::ranges::end(derived()));
+      template<typename C = D>
+        constexpr void clear() noexcept
+          requires v2_dtl::container_traits<C>::erase {
+            derived().erase(std::ranges::begin(derived()),
+                            std::ranges::end(derived()));
           }
 
       template<typename C = D>
         constexpr decltype(auto) operator=(
-            std::initializer_list<std::ranges::range_value_t<C>> il)
-          requires requires { derived().assign(il.begin(), il.end()); } {
-            derived().assign(il.begin(), il.end());
-          }
+          std::initializer_list<std::ranges::range_value_t<C>> il)
+            requires v2_dtl::container_traits<C>::erase &&
+              v2_dtl::container_traits<C>::insert_il {
+                derived().assign(il.begin(), il.end());
+                return derived();
+              }
 
-      friend constexpr void swap(D& lhs, D& rhs) requires requires { lhs.swap(rhs); } {
-        return lhs.swap(rhs);
-      }
+      friend constexpr void swap(D& lhs, D& rhs)
+        requires traits::swap {
+          return lhs.swap(rhs);
+        }
 
       friend constexpr bool operator==(const D& lhs, const D& rhs)
-        requires std::ranges::sized_range<const D> &&
-          std::indirect_relation<std::ranges::equal_to, std::ranges::iterator_t<const D>> {
-            return lhs.size() == rhs.size() && std::ranges::equal(lhs, rhs);
+        requires traits::equality_comparable {
+          return lhs.size() == rhs.size() &&
+                 v1_dtl::container_equal(
+                     lhs, rhs, v1_dtl::bytewise_comparable<D>{});
+        }
+#if 201711L <= __cpp_lib_three_way_comparison
+      // The result is the ordering of the elements: strong for integers,
+      // partial for floating-point values.  D is incomplete here, so it is
+      // named in the body, not the return type.
+      friend constexpr auto operator<=>(const D& lhs, const D& rhs)
+        requires traits::three_way_comparable {
+          using result = std::compare_three_way_result_t<
+            std::ranges::range_reference_t<const D>>;
+          if constexpr (v1_dtl::bytewise_comparable<D>::value) {
+            if (!std::is_constant_evaluated())
+              return result(v2_dtl::bytewise_three_way(lhs, rhs));
           }
-      friend constexpr std::strong_ordering operator<=>(const D& lhs, const D& rhs)
-        requires std::indirect_relation<v2_dtl::three_way, std::ranges::iterator_t<const D>> {
-          return std::lexicographical_compare_three_way(lhs.begin(), lhs.end(),
-                                                        rhs.begin(), rhs.end());
+          return result(std::lexicographical_compare_three_way(
+            lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
+            v2_dtl::element_three_way{}));
+        }
+#else
+      friend constexpr bool operator<(const D& lhs, const D& rhs)
+        requires traits::less_than_comparable {
+          return v1_dtl::container_less(
+              lhs, rhs, v1_dtl::bytewise_comparable<D>{});
+        }
+      friend constexpr bool operator<=(const D& lhs, const D& rhs)
+        requires traits::less_than_comparable {
+          return !(rhs < lhs);
+        }
+      friend constexpr bool operator>(const D& lhs, const D& rhs)
+        requires traits::less_than_comparable {
+          return rhs < lhs;
+        }
+      friend constexpr bool operator>=(const D& lhs, const D& rhs)
+        requires traits::less_than_comparable {
+          return !(lhs < rhs);
         }
+#endif
     };
 
-#elif 201703L <= __cplusplus && __has_include(<stl2/ranges.hpp>) && \
-    !defined(BOOST_STL_INTERFACES_DISABLE_CMCSTL2)
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    namespace v2_dtl {
+        template<typename D>
+        void derived_container(container_interface<D> const &);
+
+        template<typename T>
+        using span_element_t = typename v1_dtl::span_element<T>::type;
+
+        // L and R are different types of contiguous range with the same
+        // element type, at least one of which is derived from
+        // container_interface; see v1_dtl::hetero_cmp_t.
+        template<typename L, typename R>
+        concept hetero_comparable =
+          !std::same_as<L, R> && !std::is_void_v<span_element_t<L>> &&
+          std::same_as<span_element_t<L>, span_element_t<R>> &&
+          (requires (const L& l) { v2_dtl::derived_container(l); } ||
+           requires (const R& r) { v2_dtl::derived_container(r); });
+    }
+
+#endif
+
+    /** Implementation of `operator==()` between two different types of
+        contiguous range with the same element type, at least one of which
+        is derived from `container_interface`, as for `v1`.  `operator!=()`
+        is synthesized from it. */
+    template<typename L, typename R>
+      requires v2_dtl::hetero_comparable<L, R> &&
+               std::equality_comparable<v2_dtl::span_element_t<L>>
+    constexpr bool operator==(const L& lhs, const R& rhs) {
+      return std::size_t(lhs.size()) == std::size_t(rhs.size()) &&
+             v1_dtl::span_equal(
+                 lhs.data(),
+                 rhs.data(),
+                 std::size_t(lhs.size()),
+                 v1_dtl::bytewise_element<v2_dtl::span_element_t<L>>{});
+    }
+
+#if 201711L <= __cpp_lib_three_way_comparison
+    /** Implementation of `operator<=>()` between two different types of
+        contiguous range; see the heterogeneous `operator==()`.  It returns
+        the comparison category of the elements, so floating-point elements
+        are partially ordered.  `char`s are ordered as unsigned, as
+        `std::char_traits<char>` orders them.  `operator<()`, `operator<=()`,
+        `operator>()` and `operator>=()` are synthesized from it. */
+    template<typename L, typename R>
+      requires v2_dtl::hetero_comparable<L, R> &&
+               std::three_way_comparable<v2_dtl::span_element_t<L>>
+    constexpr std::compare_three_way_result_t<v2_dtl::span_element_t<L>>
+    operator<=>(const L& lhs, const R& rhs) {
+      using result =
+        std::compare_three_way_result_t<v2_dtl::span_element_t<L>>;
+      auto const p1 = lhs.data();
+      auto const p2 = rhs.data();
+      auto const n1 = std::size_t(lhs.size());
+      auto const n2 = std::size_t(rhs.size());
+      if constexpr (v1_dtl::bytewise_element<
+                        v2_dtl::span_element_t<L>>::value) {
+        if (!std::is_constant_evaluated())
+          return result(v2_dtl::bytewise_three_way(p1, n1, p2, n2));
+      }
+      return result(std::lexicographical_compare_three_way(
+        p1, p1 + n1, p2, p2 + n2, v2_dtl::element_three_way{}));
+    }
+#else
+    /** Implementation of `operator<()` between two different types of
+        contiguous range; see the heterogeneous `operator==()`.  `char`s are
+        ordered as unsigned, as `std::char_traits<char>` orders them. */
+    template<typename L, typename R>
+      requires v2_dtl::hetero_comparable<L, R> &&
+               std::totally_ordered<v2_dtl::span_element_t<L>>
+    constexpr bool operator<(const L& lhs, const R& rhs) {
+      return v1_dtl::span_less(
+          lhs.data(),
+          std::size_t(lhs.size()),
+          rhs.data(),
+          std::size_t(rhs.size()),
+          v1_dtl::bytewise_element<v2_dtl::span_element_t<L>>{});
+    }
+    /** Implementation of `operator<=()` between two different types of
+        contiguous range; see the heterogeneous `operator<()`. */
+    template<typename L, typename R>
+      requires v2_dtl::hetero_comparable<L, R> &&
+               std::totally_ordered<v2_dtl::span_element_t<L>>
+    constexpr bool operator<=(const L& lhs, const R& rhs) {
+      return !(rhs < lhs);
+    }
+    /** Implementation of `operator>()` between two different types of
+        contiguous range; see the heterogeneous `operator<()`. */
+    template<typename L, typename R>
+      requires v2_dtl::hetero_comparable<L, R> &&
+               std::totally_ordered<v2_dtl::span_element_t<L>>
+    constexpr bool operator>(const L& lhs, const R& rhs) {
+      return rhs < lhs;
+    }
+    /** Implementation of `operator>=()` between two different types of
+        contiguous range; see the heterogeneous `operator<()`. */
+    template<typename L, typename R>
+      requires v2_dtl::hetero_comparable<L, R> &&
+               std::totally_ordered<v2_dtl::span_element_t<L>>
+    constexpr bool operator>=(const L& lhs, const R& rhs) {
+      return !(lhs < rhs);
+    }
+#endif
+
+#elif defined(BOOST_STL_INTERFACES_USE_CONCEPTS_TS) &&                         \
+    !defined(BOOST_STL_INTERFACES_DISABLE_V2)
 
     namespace v2_dtl {
         // These named concepts are used to work around
@@ -1338,7 +3600,7 @@ namespace boost { namespace stl_interfaces { namespace v2 {
         constexpr void assign(v2_dtl::container_size_t<C> n,
                               const ranges::ext::range_value_t<C>& x)
           requires v2_dtl::erase_insert<C, v2_dtl::n_iter_t<C>> {
-            if (detail::fake_capacity(derived()) < n) {
+            if (v1::container_growth_policy<C>::capacity(derived()) < n) {
               C temp(n, x);
               derived().swap(temp);
             } else {
@@ -1383,20 +3645,30 @@ namespace boost { namespace stl_interfaces { namespace v2 {
       friend constexpr bool operator==(const D& lhs, const D& rhs)
         requires ranges::sized_range<const D> &&
           ranges::indirect_relation<ranges::equal_to, ranges::iterator_t<const D>> {
+            if constexpr (v1_dtl::bytewise_comparable<D>::value) {
+              return lhs.size() == rhs.size() &&
+                     v1_dtl::container_equal(lhs, rhs, std::true_type{});
+            }
             return lhs.size() == rhs.size() && ranges::equal(lhs, rhs);
           }
       friend constexpr std::strong_ordering operator<=>(const D& lhs,
                                                         const D& rhs)
         requires ranges::indirect_relation<v2_dtl::three_way, ranges::iterator_t<const D>> {
-          return std::lexicographical_compare_three_way(lhs.begin(), lhs.end(),
-                                                        rhs.begin(), rhs.end());
+          if constexpr (v1_dtl::bytewise_comparable<D>::value) {
+            if (!BOOST_STL_INTERFACES_CONSTANT_EVALUATED())
+              return v2_dtl::bytewise_three_way(lhs, rhs);
+          }
+          return std::lexicographical_compare_three_way(
+            lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
+            v2_dtl::element_three_way{});
         }
 #else
       friend constexpr bool operator==(const D& lhs, const D& rhs)
         requires ranges::sized_range<const D> &&
           ranges::indirect_relation<ranges::equal_to, ranges::iterator_t<const D>> {
             return lhs.size() == rhs.size() &&
-                   std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+                   v1_dtl::container_equal(
+                       lhs, rhs, v1_dtl::bytewise_comparable<D>{});
           }
       friend constexpr bool operator!=(const D& lhs, const D& rhs)
         requires ranges::sized_range<const D> &&
@@ -1405,17 +3677,8 @@ namespace boost { namespace stl_interfaces { namespace v2 {
           }
       friend constexpr bool operator<(const D& lhs, const D& rhs)
         requires ranges::indirect_relation<ranges::less, ranges::iterator_t<const D>> {
-          auto it1 = lhs.begin();
-          auto const last1 = lhs.end();
-          auto it2 = rhs.begin();
-          auto const last2 = rhs.end();
-          for (; it1 != last1 && it2 != last2; ++it1, ++it2) {
-            if (*it1 < *it2)
-              return true;
-            if (*it2 < *it1)
-              return false;
-          }
-          return it1 == last1 && it2 != last2;
+          return v1_dtl::container_less(
+              lhs, rhs, v1_dtl::bytewise_comparable<D>{});
         }
       friend constexpr bool operator<=(const D& lhs, const D& rhs)
         requires ranges::indirect_relation<ranges::less, ranges::iterator_t<const D>> {
@@ -1432,6 +3695,98 @@ namespace boost { namespace stl_interfaces { namespace v2 {
 #endif
     };
 
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    namespace v2_dtl {
+        template<typename D>
+        void derived_container(container_interface<D> const &);
+
+        template<typename T>
+        using span_element_t = typename v1_dtl::span_element<T>::type;
+
+        template<typename L, typename R>
+        BOOST_STL_INTERFACES_CONCEPT hetero_comparable =
+          !ranges::same_as<L, R> && !std::is_void<span_element_t<L>>::value &&
+          ranges::same_as<span_element_t<L>, span_element_t<R>> &&
+          (requires (const L& l) { v2_dtl::derived_container(l); } ||
+           requires (const R& r) { v2_dtl::derived_container(r); });
+
+        template<typename T>
+        using span_pointer_t = const span_element_t<T>*;
+    }
+
+#endif
+
+    template<typename L, typename R>
+      requires v2_dtl::hetero_comparable<L, R> &&
+        ranges::indirect_relation<ranges::equal_to, v2_dtl::span_pointer_t<L>>
+    constexpr bool operator==(const L& lhs, const R& rhs) {
+      return std::size_t(lhs.size()) == std::size_t(rhs.size()) &&
+             v1_dtl::span_equal(
+                 lhs.data(),
+                 rhs.data(),
+                 std::size_t(lhs.size()),
+                 v1_dtl::bytewise_element<v2_dtl::span_element_t<L>>{});
+    }
+
+#if 201711L <= __cpp_lib_three_way_comparison
+    template<typename L, typename R>
+      requires v2_dtl::hetero_comparable<L, R> &&
+        ranges::indirect_relation<v2_dtl::three_way, v2_dtl::span_pointer_t<L>>
+    constexpr std::compare_three_way_result_t<v2_dtl::span_element_t<L>>
+    operator<=>(const L& lhs, const R& rhs) {
+      using result =
+        std::compare_three_way_result_t<v2_dtl::span_element_t<L>>;
+      auto const p1 = lhs.data();
+      auto const p2 = rhs.data();
+      auto const n1 = std::size_t(lhs.size());
+      auto const n2 = std::size_t(rhs.size());
+      if constexpr (v1_dtl::bytewise_element<
+                        v2_dtl::span_element_t<L>>::value) {
+        if (!BOOST_STL_INTERFACES_CONSTANT_EVALUATED())
+          return result(v2_dtl::bytewise_three_way(p1, n1, p2, n2));
+      }
+      return result(std::lexicographical_compare_three_way(
+        p1, p1 + n1, p2, p2 + n2, v2_dtl::element_three_way{}));
+    }
+#else
+    template<typename L, typename R>
+      requires v2_dtl::hetero_comparable<L, R> &&
+        ranges::indirect_relation<ranges::equal_to, v2_dtl::span_pointer_t<L>>
+    constexpr bool operator!=(const L& lhs, const R& rhs) {
+      return !(lhs == rhs);
+    }
+    template<typename L, typename R>
+      requires v2_dtl::hetero_comparable<L, R> &&
+        ranges::indirect_relation<ranges::less, v2_dtl::span_pointer_t<L>>
+    constexpr bool operator<(const L& lhs, const R& rhs) {
+      return v1_dtl::span_less(
+          lhs.data(),
+          std::size_t(lhs.size()),
+          rhs.data(),
+          std::size_t(rhs.size()),
+          v1_dtl::bytewise_element<v2_dtl::span_element_t<L>>{});
+    }
+    template<typename L, typename R>
+      requires v2_dtl::hetero_comparable<L, R> &&
+        ranges::indirect_relation<ranges::less, v2_dtl::span_pointer_t<L>>
+    constexpr bool operator<=(const L& lhs, const R& rhs) {
+      return !(rhs < lhs);
+    }
+    template<typename L, typename R>
+      requires v2_dtl::hetero_comparable<L, R> &&
+        ranges::indirect_relation<ranges::less, v2_dtl::span_pointer_t<L>>
+    constexpr bool operator>(const L& lhs, const R& rhs) {
+      return rhs < lhs;
+    }
+    template<typename L, typename R>
+      requires v2_dtl::hetero_comparable<L, R> &&
+        ranges::indirect_relation<ranges::less, v2_dtl::span_pointer_t<L>>
+    constexpr bool operator>=(const L& lhs, const R& rhs) {
+      return !(lhs < rhs);
+    }
+#endif
+
 #endif
 
     // clang-format on
@@ -0,0 +1,341 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_CONTAINER_TELEMETRY_HPP
+#define BOOST_STL_INTERFACES_CONTAINER_TELEMETRY_HPP
+
+#include <boost/stl_interfaces/container_interface.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <typeinfo>
+#include <vector>
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+    /** The statistics that `container_telemetry_hooks` has gathered for one
+        container type, over all its objects, on all threads. */
+    struct container_stats
+    {
+        /** The name of the type, from the hooks' `name()`. */
+        char const * name;
+        /** The number of times an object's capacity grew. */
+        std::uint64_t grows;
+        /** The number of times an object's capacity grew from the capacity
+            of a default-constructed object -- for a small vector, the
+            number of times one spilled out of its inline buffer. */
+        std::uint64_t spills;
+        /** The number of times an object's capacity grew past the hooks'
+            `expected_size`. */
+        std::uint64_t oversized;
+        /** The number of elements inserted. */
+        std::uint64_t inserted;
+        /** The number of elements erased. */
+        std::uint64_t erased;
+        /** The bytes of the elements that were assigned over, or shifted to
+            make room for new ones. */
+        std::uint64_t bytes_moved;
+        /** The largest size any object reached. */
+        std::uint64_t peak_size;
+        /** The largest capacity any object grew to. */
+        std::uint64_t peak_capacity;
+    };
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    namespace v1_dtl {
+        enum telemetry_counter {
+            stat_grows,
+            stat_spills,
+            stat_oversized,
+            stat_inserted,
+            stat_erased,
+            stat_bytes_moved,
+            stat_peak_size,
+            stat_peak_capacity,
+            stat_count
+        };
+
+        inline bool telemetry_is_peak(int i) noexcept
+        {
+            return stat_peak_size <= i;
+        }
+
+        // The counters one thread keeps for one container type.  Only the
+        // thread writes them, so an update is a load and a store, not a
+        // read-modify-write; a snapshot may read them at any time.
+        struct telemetry_shard
+        {
+            void add(int i, std::uint64_t n) noexcept
+            {
+                counts[i].store(
+                    counts[i].load(std::memory_order_relaxed) + n,
+                    std::memory_order_relaxed);
+            }
+            void peak(int i, std::uint64_t n) noexcept
+            {
+                if (counts[i].load(std::memory_order_relaxed) < n)
+                    counts[i].store(n, std::memory_order_relaxed);
+            }
+
+            std::atomic<std::uint64_t> counts[stat_count] = {};
+        };
+
+        inline void telemetry_merge(
+            std::uint64_t (&totals)[stat_count],
+            int i,
+            std::uint64_t n) noexcept
+        {
+            if (telemetry_is_peak(i))
+                totals[i] = (std::max)(totals[i], n);
+            else
+                totals[i] += n;
+        }
+
+        // The shards of one container type, and the totals of the threads
+        // that have exited.  Like every registry, it is never destroyed, so
+        // that threads that exit after main() returns can still retire
+        // their shards into it.
+        struct telemetry_registry
+        {
+            explicit telemetry_registry(char const * n) : name(n) {}
+
+            void add(telemetry_shard * shard)
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                shards.push_back(shard);
+            }
+            void retire(telemetry_shard * shard) noexcept
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                for (int i = 0; i < stat_count; ++i) {
+                    v1_dtl::telemetry_merge(
+                        retired,
+                        i,
+                        shard->counts[i].load(std::memory_order_relaxed));
+                }
+                shards.erase(std::find(shards.begin(), shards.end(), shard));
+            }
+
+            container_stats snapshot()
+            {
+                std::uint64_t totals[stat_count];
+                std::lock_guard<std::mutex> lock(mutex);
+                std::copy(retired, retired + stat_count, totals);
+                for (telemetry_shard const * shard : shards) {
+                    for (int i = 0; i < stat_count; ++i) {
+                        v1_dtl::telemetry_merge(
+                            totals,
+                            i,
+                            shard->counts[i].load(std::memory_order_relaxed));
+                    }
+                }
+                return container_stats{name,
+                                       totals[stat_grows],
+                                       totals[stat_spills],
+                                       totals[stat_oversized],
+                                       totals[stat_inserted],
+                                       totals[stat_erased],
+                                       totals[stat_bytes_moved],
+                                       totals[stat_peak_size],
+                                       totals[stat_peak_capacity]};
+            }
+
+            char const * name;
+            std::mutex mutex;
+            std::vector<telemetry_shard *> shards;
+            std::uint64_t retired[stat_count] = {};
+        };
+
+        // Every container type that has reported anything.
+        struct telemetry_registries
+        {
+            static telemetry_registries & instance()
+            {
+                static telemetry_registries * const retval =
+                    new telemetry_registries;
+                return *retval;
+            }
+
+            std::mutex mutex;
+            std::vector<telemetry_registry *> registries;
+        };
+
+        template<typename Hooks>
+        telemetry_registry & telemetry_registry_of()
+        {
+            static telemetry_registry * const retval = [] {
+                auto * const registry = new telemetry_registry(Hooks::name());
+                auto & all = telemetry_registries::instance();
+                std::lock_guard<std::mutex> lock(all.mutex);
+                all.registries.push_back(registry);
+                return registry;
+            }();
+            return *retval;
+        }
+
+        // This thread's shard for Hooks' container type, which joins the
+        // registry on the thread's first report, and leaves it when the
+        // thread exits.
+        template<typename Hooks>
+        struct telemetry_local_shard : telemetry_shard
+        {
+            telemetry_local_shard() :
+                registry_(v1_dtl::telemetry_registry_of<Hooks>())
+            {
+                registry_.add(this);
+            }
+            ~telemetry_local_shard() { registry_.retire(this); }
+
+        private:
+            telemetry_registry & registry_;
+        };
+
+        template<typename Hooks>
+        telemetry_shard & telemetry_this_shard()
+        {
+            thread_local telemetry_local_shard<Hooks> shard;
+            return shard;
+        }
+    }
+
+#endif
+
+    /** A ready-made specialization of `container_op_hooks` for a container
+        type `D`, which counts how the objects of type `D` grow: how often
+        their capacity grows, how often it grows out of the capacity that a
+        default-constructed `D` has, how many elements are inserted, erased
+        and moved, and the largest size and capacity any of them reaches.
+        Use it by deriving the specialization from it:
+
+        \code
+        template<>
+        struct container_op_hooks<my_vector>
+            : container_telemetry_hooks<my_vector>
+        {
+            static char const * name() { return "my_vector"; }
+            static constexpr std::size_t expected_size = 64;
+        };
+        \endcode
+
+        The specialization may hide `name()`, the name the statistics are
+        exported under, which is otherwise `typeid(D).name()`;
+        `expected_size`, past which a growth counts as oversized, which is
+        otherwise `SIZE_MAX`; and `oversized(d, capacity)`, which is called
+        with each object that grows past `expected_size`, so that it can be
+        logged.  `D` must be default-constructible.
+
+        Each thread counts into a shard of its own, without any
+        synchronization with the others; `container_telemetry()` merges the
+        shards.  As with any `container_op_hooks`, only the operations of
+        the members that `container_interface` defines are observed.
+
+        \see `container_telemetry()`, `write_container_telemetry()` */
+    template<typename D, typename Hooks = container_op_hooks<D>>
+    struct container_telemetry_hooks : container_op_hooks_base
+    {
+        static char const * name() { return typeid(D).name(); }
+
+        static constexpr std::size_t expected_size = SIZE_MAX;
+
+        static void oversized(D const &, std::size_t) {}
+
+        static void grow(
+            D const & d, std::size_t old_capacity, std::size_t new_capacity)
+        {
+            static std::size_t const initial_capacity =
+                container_growth_policy<D>::capacity(D());
+            auto & shard = v1_dtl::telemetry_this_shard<Hooks>();
+            shard.add(v1_dtl::stat_grows, 1);
+            if (old_capacity == initial_capacity)
+                shard.add(v1_dtl::stat_spills, 1);
+            shard.peak(v1_dtl::stat_peak_capacity, new_capacity);
+            if (Hooks::expected_size < new_capacity) {
+                shard.add(v1_dtl::stat_oversized, 1);
+                Hooks::oversized(d, new_capacity);
+            }
+        }
+        static void insert(D const & d, std::size_t n)
+        {
+            auto & shard = v1_dtl::telemetry_this_shard<Hooks>();
+            shard.add(v1_dtl::stat_inserted, n);
+            shard.peak(v1_dtl::stat_peak_size, v1_dtl::element_count(d));
+        }
+        static void erase(D const &, std::size_t n)
+        {
+            v1_dtl::telemetry_this_shard<Hooks>().add(v1_dtl::stat_erased, n);
+        }
+        static void moves(D const &, std::size_t n)
+        {
+            v1_dtl::telemetry_this_shard<Hooks>().add(
+                v1_dtl::stat_bytes_moved, n * sizeof(typename D::value_type));
+        }
+    };
+
+    /** Returns the statistics of each container type that has reported
+        through `container_telemetry_hooks`, merged over all threads, in
+        the order the types first reported.  It may be called at any time,
+        from any thread; counts made concurrently may or may not be
+        included. */
+    inline std::vector<container_stats> container_telemetry()
+    {
+        auto & all = v1_dtl::telemetry_registries::instance();
+        std::lock_guard<std::mutex> lock(all.mutex);
+        std::vector<container_stats> retval;
+        retval.reserve(all.registries.size());
+        for (auto * registry : all.registries) {
+            retval.push_back(registry->snapshot());
+        }
+        return retval;
+    }
+
+    /** Writes `container_telemetry()` to `os` in the Prometheus text
+        exposition format, as the metrics `<prefix>_grows_total`,
+        `<prefix>_spills_total`, `<prefix>_oversized_total`,
+        `<prefix>_inserted_total`, `<prefix>_erased_total`,
+        `<prefix>_moved_bytes_total`, `<prefix>_peak_size` and
+        `<prefix>_peak_capacity`, each labeled with
+        `container="<name>"`. */
+    inline void write_container_telemetry(
+        std::ostream & os, char const * prefix = "stl_interfaces_container")
+    {
+        struct metric
+        {
+            char const * suffix;
+            char const * type;
+            std::uint64_t container_stats::*value;
+        };
+        static metric const metrics[] = {
+            {"_grows_total", "counter", &container_stats::grows},
+            {"_spills_total", "counter", &container_stats::spills},
+            {"_oversized_total", "counter", &container_stats::oversized},
+            {"_inserted_total", "counter", &container_stats::inserted},
+            {"_erased_total", "counter", &container_stats::erased},
+            {"_moved_bytes_total", "counter", &container_stats::bytes_moved},
+            {"_peak_size", "gauge", &container_stats::peak_size},
+            {"_peak_capacity", "gauge", &container_stats::peak_capacity}};
+
+        auto const stats = stl_interfaces::container_telemetry();
+        for (auto const & m : metrics) {
+            os << "# TYPE " << prefix << m.suffix << ' ' << m.type << '\n';
+            for (auto const & s : stats) {
+                os << prefix << m.suffix << "{container=\"";
+                for (char const * c = s.name; *c; ++c) {
+                    if (*c == '"' || *c == '\\')
+                        os << '\\';
+                    os << *c;
+                }
+                os << "\"} " << s.*m.value << '\n';
+            }
+        }
+    }
+
+}}}
+
+#endif
@@ -0,0 +1,171 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_COUNTED_ITERATOR_HPP
+#define BOOST_STL_INTERFACES_COUNTED_ITERATOR_HPP
+
+#include <boost/stl_interfaces/iterator_interface.hpp>
+#include <boost/stl_interfaces/sentinel_interface.hpp>
+#include <boost/stl_interfaces/view_interface.hpp>
+
+#include <boost/assert.hpp>
+
+#include <iterator>
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+    template<typename Iter>
+    struct counted_iterator;
+
+    /** The sentinel of a range whose iterators know when they are at the
+        end, such as `counted_iterator`.  This is a pre-C++20 version of
+        `std::default_sentinel_t` (see [default.sentinel] in the C++
+        standard). */
+    struct default_sentinel_t : sentinel_interface<default_sentinel_t>
+    {
+        template<typename Iter>
+        friend constexpr bool
+        operator==(counted_iterator<Iter> const & it, default_sentinel_t)
+        {
+            return it.count() == 0;
+        }
+        template<typename Iter>
+        friend constexpr v1_dtl::iter_difference_t<Iter>
+        operator-(default_sentinel_t, counted_iterator<Iter> const & it)
+        {
+            return it.count();
+        }
+    };
+
+    /** A `default_sentinel_t` object. */
+    constexpr default_sentinel_t default_sentinel{};
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    namespace v1_dtl {
+        template<typename Iter>
+        using counted_category_t = std::conditional_t<
+            std::is_convertible<
+                typename std::iterator_traits<Iter>::iterator_category,
+                std::random_access_iterator_tag>::value,
+            std::random_access_iterator_tag,
+            typename std::iterator_traits<Iter>::iterator_category>;
+
+        template<typename Iter>
+        using counted_iterator_interface_t = iterator_interface<
+            counted_iterator<Iter>,
+            counted_category_t<Iter>,
+            typename std::iterator_traits<Iter>::value_type,
+            typename std::iterator_traits<Iter>::reference,
+            typename std::iterator_traits<Iter>::pointer,
+            iter_difference_t<Iter>>;
+    }
+
+#endif
+
+    /** An iterator that counts down the elements left before its end, like
+        `std::counted_iterator`.  It is at the end when its `count()` is 0,
+        so a loop from a `counted_iterator` to `default_sentinel` compares a
+        count with 0, and not one iterator with another; and the end of
+        `n` elements need not be found before they are visited, which takes
+        `n` steps for an iterator that is not random access.  Two
+        `counted_iterator`s into the same range compare by their counts.
+
+        It has the category of `Iter`, except that a contiguous iterator is
+        counted as a random access one.
+        \see `counted_view` */
+    template<typename Iter>
+    struct counted_iterator : v1_dtl::counted_iterator_interface_t<Iter>
+    {
+        using reference = typename std::iterator_traits<Iter>::reference;
+        using difference_type = v1_dtl::iter_difference_t<Iter>;
+
+        constexpr counted_iterator() = default;
+        constexpr counted_iterator(Iter it, difference_type n) :
+            it_(it),
+            n_(n)
+        {
+            BOOST_ASSERT(0 <= n);
+        }
+
+        constexpr reference operator*() const { return *it_; }
+        constexpr counted_iterator & operator++()
+        {
+            ++it_;
+            --n_;
+            return *this;
+        }
+        constexpr counted_iterator & operator--()
+        {
+            --it_;
+            ++n_;
+            return *this;
+        }
+        template<typename I = Iter>
+        constexpr auto operator+=(difference_type n) -> decltype(
+            std::declval<I &>() += n, std::declval<counted_iterator &>())
+        {
+            it_ += n;
+            n_ -= n;
+            return *this;
+        }
+        friend constexpr bool
+        operator==(counted_iterator const & lhs, counted_iterator const & rhs)
+        {
+            return lhs.n_ == rhs.n_;
+        }
+        friend constexpr difference_type
+        operator-(counted_iterator const & lhs, counted_iterator const & rhs)
+        {
+            return rhs.n_ - lhs.n_;
+        }
+
+        /** Returns the underlying iterator. */
+        constexpr Iter base() const { return it_; }
+        /** Returns the number of elements left before the end. */
+        constexpr difference_type count() const noexcept { return n_; }
+
+        using base_type = v1_dtl::counted_iterator_interface_t<Iter>;
+        using base_type::operator++;
+        using base_type::operator--;
+
+    private:
+        Iter it_ = Iter();
+        difference_type n_ = 0;
+    };
+
+    /** A view of the `n` elements starting at `first`, whose iterators are
+        `counted_iterator`s, and whose end is `default_sentinel`.  There must
+        be at least `n` elements.  Like the `std::views::counted` of an
+        iterator that is not random access. */
+    template<typename Iter>
+    struct counted_view : view_interface<counted_view<Iter>>
+    {
+        using iterator = counted_iterator<Iter>;
+
+        constexpr counted_view() = default;
+        constexpr counted_view(Iter first, v1_dtl::iter_difference_t<Iter> n) :
+            first_(first, n)
+        {}
+
+        constexpr iterator begin() const { return first_; }
+        constexpr default_sentinel_t end() const { return default_sentinel; }
+
+    private:
+        iterator first_;
+    };
+
+    /** Returns a `counted_view` of the `n` elements starting at `first`. */
+    template<typename Iter>
+    constexpr counted_view<Iter>
+    make_counted_view(Iter first, v1_dtl::iter_difference_t<Iter> n)
+    {
+        return counted_view<Iter>(first, n);
+    }
+
+}}}
+
+#endif
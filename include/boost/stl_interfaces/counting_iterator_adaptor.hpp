@@ -0,0 +1,222 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_COUNTING_ITERATOR_ADAPTOR_HPP
+#define BOOST_STL_INTERFACES_COUNTING_ITERATOR_ADAPTOR_HPP
+
+#include <boost/stl_interfaces/iterator_interface.hpp>
+
+#include <cstdint>
+#include <iterator>
+#include <ostream>
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+    /** Counts of the operations performed on `counting_iterator_adaptor`s.
+        Ordering comparisons (`<`, etc.) of random access iterators are made
+        with `operator-()`, and so are counted as differences. */
+    struct iterator_op_counts
+    {
+        std::uint64_t dereferences = 0;
+        std::uint64_t increments = 0;
+        std::uint64_t decrements = 0;
+        std::uint64_t advances = 0;
+        std::uint64_t comparisons = 0;
+        std::uint64_t differences = 0;
+
+        /** Returns the counts in `*this` since the snapshot `earlier`. */
+        iterator_op_counts since(iterator_op_counts const & earlier) const
+            noexcept
+        {
+            iterator_op_counts retval;
+            retval.dereferences = dereferences - earlier.dereferences;
+            retval.increments = increments - earlier.increments;
+            retval.decrements = decrements - earlier.decrements;
+            retval.advances = advances - earlier.advances;
+            retval.comparisons = comparisons - earlier.comparisons;
+            retval.differences = differences - earlier.differences;
+            return retval;
+        }
+
+        /** Writes one line, with each count that is not 0. */
+        friend std::ostream &
+        operator<<(std::ostream & os, iterator_op_counts const & counts)
+        {
+            char const * sep = "";
+            auto const field = [&](char const * name, std::uint64_t n) {
+                if (n) {
+                    os << sep << name << ": " << n;
+                    sep = ", ";
+                }
+            };
+            field("dereferences", counts.dereferences);
+            field("increments", counts.increments);
+            field("decrements", counts.decrements);
+            field("advances", counts.advances);
+            field("comparisons", counts.comparisons);
+            field("differences", counts.differences);
+            if (!*sep)
+                os << "no iterator operations";
+            return os;
+        }
+    };
+
+    /** Returns the calling thread's counts of the operations performed on
+        `counting_iterator_adaptor`s.  Each thread has its own counts, so
+        counting never synchronizes.  They may be assigned, e.g. to reset
+        them.  When `BOOST_STL_INTERFACES_DISABLE_ITERATOR_COUNTING` is
+        defined, they stay 0. */
+    inline iterator_op_counts & this_thread_iterator_op_counts() noexcept
+    {
+        thread_local iterator_op_counts counts;
+        return counts;
+    }
+
+    /** Records the calling thread's iterator operation counts when it is
+        constructed, so that `counts()` returns the operations performed
+        since.
+        \code
+        counted_op_scope scope;
+        std::distance(first, last);
+        std::cout << scope.counts() << "\n";
+        \endcode */
+    struct counted_op_scope
+    {
+        counted_op_scope() noexcept : start_(this_thread_iterator_op_counts())
+        {}
+
+        /** Returns the operations performed on this thread since `*this`
+            was constructed. */
+        iterator_op_counts counts() const noexcept
+        {
+            return this_thread_iterator_op_counts().since(start_);
+        }
+
+    private:
+        iterator_op_counts start_;
+    };
+
+    template<typename Iter>
+    struct counting_iterator_adaptor;
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    namespace v1_dtl {
+        template<typename Iter>
+        using counting_category_t = std::conditional_t<
+            std::is_convertible<
+                typename std::iterator_traits<Iter>::iterator_category,
+                std::random_access_iterator_tag>::value,
+            std::random_access_iterator_tag,
+            typename std::iterator_traits<Iter>::iterator_category>;
+
+        template<typename Iter>
+        using counting_iterator_interface_t = iterator_interface<
+            counting_iterator_adaptor<Iter>,
+            counting_category_t<Iter>,
+            typename std::iterator_traits<Iter>::value_type,
+            typename std::iterator_traits<Iter>::reference,
+            typename std::iterator_traits<Iter>::pointer,
+            iter_difference_t<Iter>>;
+    }
+
+#endif
+
+#ifdef BOOST_STL_INTERFACES_DISABLE_ITERATOR_COUNTING
+#define BOOST_STL_INTERFACES_COUNT_ITERATOR_OP(op)
+#else
+#define BOOST_STL_INTERFACES_COUNT_ITERATOR_OP(op)                             \
+    ++stl_interfaces::this_thread_iterator_op_counts().op
+#endif
+
+    /** An iterator that does what `Iter` does, and counts each operation
+        it performs in `this_thread_iterator_op_counts()`.  Wrapping the
+        iterators given to an algorithm shows how it uses them: a
+        `std::distance()` that increments through a forward range, or the
+        same element dereferenced many times through a proxy, are easy to
+        see in the counts, and invisible to a sampling profiler.
+
+        It has the category of `Iter`, except that a contiguous iterator is
+        counted as a random access one, so that algorithms cannot bypass
+        it through a pointer.  With
+        `BOOST_STL_INTERFACES_DISABLE_ITERATOR_COUNTING` defined, nothing
+        is counted, and the adaptor compiles to the same code as `Iter`. */
+    template<typename Iter>
+    struct counting_iterator_adaptor
+        : v1_dtl::counting_iterator_interface_t<Iter>
+    {
+        using reference = typename std::iterator_traits<Iter>::reference;
+        using difference_type = v1_dtl::iter_difference_t<Iter>;
+
+        constexpr counting_iterator_adaptor() = default;
+        constexpr explicit counting_iterator_adaptor(Iter it) : it_(it) {}
+
+        reference operator*() const
+        {
+            BOOST_STL_INTERFACES_COUNT_ITERATOR_OP(dereferences);
+            return *it_;
+        }
+        counting_iterator_adaptor & operator++()
+        {
+            BOOST_STL_INTERFACES_COUNT_ITERATOR_OP(increments);
+            ++it_;
+            return *this;
+        }
+        counting_iterator_adaptor & operator--()
+        {
+            BOOST_STL_INTERFACES_COUNT_ITERATOR_OP(decrements);
+            --it_;
+            return *this;
+        }
+        template<typename I = Iter>
+        auto operator+=(difference_type n) -> decltype(
+            std::declval<I &>() += n,
+            std::declval<counting_iterator_adaptor &>())
+        {
+            BOOST_STL_INTERFACES_COUNT_ITERATOR_OP(advances);
+            it_ += n;
+            return *this;
+        }
+        friend bool operator==(
+            counting_iterator_adaptor const & lhs,
+            counting_iterator_adaptor const & rhs)
+        {
+            BOOST_STL_INTERFACES_COUNT_ITERATOR_OP(comparisons);
+            return lhs.it_ == rhs.it_;
+        }
+        template<typename I = Iter>
+        friend auto operator-(
+            counting_iterator_adaptor const & lhs,
+            counting_iterator_adaptor const & rhs)
+            -> decltype(std::declval<I const &>() - std::declval<I const &>())
+        {
+            BOOST_STL_INTERFACES_COUNT_ITERATOR_OP(differences);
+            return lhs.it_ - rhs.it_;
+        }
+
+        /** Returns the underlying iterator. */
+        constexpr Iter base() const { return it_; }
+
+        using base_type = v1_dtl::counting_iterator_interface_t<Iter>;
+        using base_type::operator++;
+        using base_type::operator--;
+
+    private:
+        Iter it_ = Iter();
+    };
+
+#undef BOOST_STL_INTERFACES_COUNT_ITERATOR_OP
+
+    /** Returns a `counting_iterator_adaptor` of `it`. */
+    template<typename Iter>
+    counting_iterator_adaptor<Iter> make_counting_iterator(Iter it)
+    {
+        return counting_iterator_adaptor<Iter>(it);
+    }
+
+}}}
+
+#endif
@@ -0,0 +1,554 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_COW_VECTOR_HPP
+#define BOOST_STL_INTERFACES_COW_VECTOR_HPP
+
+#include <boost/stl_interfaces/container_interface.hpp>
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+    template<typename T>
+    struct cow_vector;
+
+    /** `cow_vector`'s own members destroy its elements, so
+        `container_interface` does not need to call `clear()`. */
+    template<typename T>
+    struct trivially_destructible_container<cow_vector<T>> : std::true_type
+    {
+    };
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    namespace v1_dtl {
+        // The header of a cow_vector's buffer, which its elements follow.
+        struct alignas(std::max_align_t) cow_header
+        {
+            std::atomic<std::size_t> refs;
+            std::size_t size;
+            std::size_t capacity;
+        };
+    }
+
+#endif
+
+    /** A vector whose copies share one reference-counted buffer, until one
+        of them is changed.  Copying a `cow_vector` increments the count;
+        the first access that can change the elements -- the non-const
+        `begin()`, `end()`, `operator[]()`, `data()`, `front()` or `back()`,
+        or any insertion or erasure -- of a vector whose buffer is shared
+        copies the elements into a buffer of its own first, and later ones
+        find it unshared.  The const members never copy, so a vector that
+        is only read should be read through a `const &`, or with
+        `cbegin()` and `cend()`.
+
+        The count is atomic, so copies of one vector may be used, copied
+        and destroyed on different threads, as when a message is copied
+        into several queues.  A single `cow_vector` object is no more
+        thread-safe than a `std::vector`.
+
+        Since a non-const access may copy the elements, it may throw, and
+        it invalidates the iterators and references into the vector
+        obtained before it from its const members.
+
+        \see `container_interface` */
+    template<typename T>
+    struct cow_vector : container_interface<cow_vector<T>, contiguous>
+    {
+        static_assert(
+            alignof(T) <= alignof(std::max_align_t),
+            "cow_vector<T> does not support over-aligned T.");
+
+        using value_type = T;
+        using pointer = T *;
+        using const_pointer = T const *;
+        using reference = value_type &;
+        using const_reference = value_type const &;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using iterator = T *;
+        using const_iterator = T const *;
+        using reverse_iterator = stl_interfaces::reverse_iterator<iterator>;
+        using const_reverse_iterator =
+            stl_interfaces::reverse_iterator<const_iterator>;
+
+        cow_vector() noexcept = default;
+        explicit cow_vector(size_type n) { resize(n); }
+        cow_vector(size_type n, T const & x) { resize(n, x); }
+        template<
+            typename InputIterator,
+            typename Enable = std::enable_if_t<std::is_convertible<
+                typename std::iterator_traits<
+                    InputIterator>::iterator_category,
+                std::input_iterator_tag>::value>>
+        cow_vector(InputIterator first, InputIterator last)
+        {
+            insert(shared_data(), first, last);
+        }
+        cow_vector(std::initializer_list<T> il) :
+            cow_vector(il.begin(), il.end())
+        {}
+        /** Shares `other`'s buffer. */
+        cow_vector(cow_vector const & other) noexcept : buf_(other.buf_)
+        {
+            if (buf_)
+                buf_->refs.fetch_add(1, std::memory_order_relaxed);
+        }
+        cow_vector(cow_vector && other) noexcept :
+            buf_(std::exchange(other.buf_, nullptr))
+        {}
+        cow_vector & operator=(cow_vector const & other) noexcept
+        {
+            cow_vector temp(other);
+            swap(temp);
+            return *this;
+        }
+        cow_vector & operator=(cow_vector && other) noexcept
+        {
+            cow_vector temp(std::move(other));
+            swap(temp);
+            return *this;
+        }
+        cow_vector & operator=(std::initializer_list<T> il)
+        {
+            cow_vector temp(il);
+            swap(temp);
+            return *this;
+        }
+        ~cow_vector() { release(); }
+
+        /** Returns the start of the elements, after copying them into a
+            buffer of this vector's own if it shares its buffer. */
+        iterator begin() { return unshared_data(); }
+        iterator end() { return begin() + size(); }
+        const_iterator begin() const noexcept { return shared_data(); }
+        const_iterator end() const noexcept
+        {
+            return shared_data() + size();
+        }
+
+        size_type size() const noexcept { return buf_ ? buf_->size : 0; }
+        bool empty() const noexcept { return !size(); }
+        size_type max_size() const noexcept
+        {
+            return (std::numeric_limits<difference_type>::max)() /
+                   sizeof(T);
+        }
+        size_type capacity() const noexcept
+        {
+            return buf_ ? buf_->capacity : 0;
+        }
+        /** Returns the number of vectors that share this one's buffer,
+            including this one; or 0 if it has none. */
+        size_type use_count() const noexcept
+        {
+            return buf_ ? buf_->refs.load(std::memory_order_relaxed) : 0;
+        }
+
+        /** Makes the capacity at least `n`, and the buffer unshared. */
+        void reserve(size_type n)
+        {
+            if (n <= capacity() && unique())
+                return;
+            reallocate((std::max)(n, size()), size(), 0, [](T *) {});
+        }
+
+        template<typename... Args>
+        reference emplace_back(Args &&... args)
+        {
+            size_type const n = size();
+            if (n < capacity() && unique()) {
+                T * const retval =
+                    ::new (elements(buf_) + n) T(std::forward<Args>(args)...);
+                ++buf_->size;
+                return *retval;
+            }
+            // Reallocates with the element constructed first, in case args
+            // refer to elements of this vector.
+            reallocate(grown_capacity(n + 1), n, 1, [&](T * p) {
+                ::new (p) T(std::forward<Args>(args)...);
+            });
+            return elements(buf_)[n];
+        }
+
+        template<typename... Args>
+        iterator emplace(const_iterator pos, Args &&... args)
+        {
+            size_type const i = size_type(pos - shared_data());
+            size_type const n = size();
+            BOOST_ASSERT(i <= n);
+            if (i == n) {
+                emplace_back(std::forward<Args>(args)...);
+                return begin() + i;
+            }
+            if (n == capacity() || !unique()) {
+                reallocate(grown_capacity(n + 1), i, 1, [&](T * p) {
+                    ::new (p) T(std::forward<Args>(args)...);
+                });
+                return elements(buf_) + i;
+            }
+            T x(std::forward<Args>(args)...);
+            T * const first = elements(buf_);
+            ::new (first + n) T(std::move(first[n - 1]));
+            ++buf_->size;
+            std::move_backward(first + i, first + n - 1, first + n);
+            first[i] = std::move(x);
+            return first + i;
+        }
+
+        template<
+            typename InputIterator,
+            typename Enable = std::enable_if_t<std::is_convertible<
+                typename std::iterator_traits<
+                    InputIterator>::iterator_category,
+                std::input_iterator_tag>::value>>
+        iterator
+        insert(const_iterator pos, InputIterator first, InputIterator last)
+        {
+            size_type const i = size_type(pos - shared_data());
+            BOOST_ASSERT(i <= size());
+            insert_impl(
+                i,
+                first,
+                last,
+                typename std::iterator_traits<
+                    InputIterator>::iterator_category{});
+            return begin() + i;
+        }
+
+        iterator erase(const_iterator f, const_iterator l)
+        {
+            size_type const i = size_type(f - shared_data());
+            size_type const j = size_type(l - shared_data());
+            BOOST_ASSERT(i <= j && j <= size());
+            if (i == j)
+                return begin() + i;
+            if (!unique()) {
+                // Copies only the elements that remain.
+                release_range_into_new_buffer(i, j);
+                return elements(buf_) + i;
+            }
+            T * const first = elements(buf_);
+            T * const new_end =
+                std::move(first + j, first + buf_->size, first + i);
+            destroy_tail(new_end);
+            return first + i;
+        }
+
+        void pop_back()
+        {
+            BOOST_ASSERT(!empty());
+            erase(end() - 1, end());
+        }
+
+        void resize(size_type n, T const & x)
+        {
+            resize_impl(n, [&](T * p, size_type count) {
+                std::uninitialized_fill_n(p, count, x);
+            });
+        }
+        void resize(size_type n)
+        {
+            resize_impl(n, [](T * p, size_type count) {
+                T * const first = p;
+                try {
+                    for (; count; --count, ++p) {
+                        ::new (p) T();
+                    }
+                } catch (...) {
+                    for (; first != p; --p) {
+                        (p - 1)->~T();
+                    }
+                    throw;
+                }
+            });
+        }
+
+        /** Empties the vector.  A shared buffer is not copied, only
+            released. */
+        void clear() noexcept
+        {
+            if (!buf_)
+                return;
+            if (unique())
+                destroy_tail(elements(buf_));
+            else
+                release();
+        }
+
+        void swap(cow_vector & other) noexcept
+        {
+            std::swap(buf_, other.buf_);
+        }
+
+        /** Swaps `lhs` and `rhs`. */
+        friend void swap(cow_vector & lhs, cow_vector & rhs) noexcept
+        {
+            lhs.swap(rhs);
+        }
+
+        using base_type = container_interface<cow_vector<T>, contiguous>;
+        using base_type::erase;
+        using base_type::insert;
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+    private:
+        using header = v1_dtl::cow_header;
+
+        static T * elements(header * h) noexcept
+        {
+            return reinterpret_cast<T *>(h + 1);
+        }
+
+        T const * shared_data() const noexcept
+        {
+            return buf_ ? elements(buf_) : nullptr;
+        }
+        T * unshared_data()
+        {
+            if (!buf_)
+                return nullptr;
+            if (!unique())
+                reallocate(buf_->capacity, buf_->size, 0, [](T *) {});
+            return elements(buf_);
+        }
+
+        // True if this vector has no buffer, or the only reference to it.
+        bool unique() const noexcept
+        {
+            return !buf_ || buf_->refs.load(std::memory_order_acquire) == 1;
+        }
+
+        size_type grown_capacity(size_type n) const noexcept
+        {
+            return (std::max)(n, 2 * capacity());
+        }
+
+        static header * allocate(size_type capacity)
+        {
+            header * const retval = static_cast<header *>(
+                ::operator new(sizeof(header) + capacity * sizeof(T)));
+            ::new (retval) header;
+            retval->refs.store(1, std::memory_order_relaxed);
+            retval->size = 0;
+            retval->capacity = capacity;
+            return retval;
+        }
+
+        // Drops this vector's reference to its buffer, and destroys the
+        // buffer if it was the last one.
+        void release() noexcept
+        {
+            header * const h = std::exchange(buf_, nullptr);
+            if (!h || h->refs.fetch_sub(1, std::memory_order_acq_rel) != 1)
+                return;
+            T * const first = elements(h);
+            for (T * it = first, * last = first + h->size; it != last;
+                 ++it) {
+                it->~T();
+            }
+            h->~header();
+            ::operator delete(h);
+        }
+
+        void destroy_tail(T * new_end) noexcept
+        {
+            T * const first = elements(buf_);
+            for (T * it = new_end, * last = first + buf_->size; it != last;
+                 ++it) {
+                it->~T();
+            }
+            buf_->size = size_type(new_end - first);
+        }
+
+        // Replaces the buffer with a new one of the given capacity, which
+        // holds the elements [0, gap), then gap_size elements constructed
+        // by fill(p), then the elements [gap, size()).  The old elements
+        // are copied if the old buffer is shared, and moved otherwise.  The
+        // old buffer is released last, so fill() may read from it.
+        template<typename F>
+        void reallocate(
+            size_type capacity, size_type gap, size_type gap_size, F fill)
+        {
+            size_type const n = size();
+            header * const h = allocate(capacity);
+            T * const out = elements(h);
+            size_type constructed = 0;
+            bool filled = false;
+            try {
+                fill(out + gap);
+                filled = true;
+                if (buf_) {
+                    T * const in = elements(buf_);
+                    if (unique()) {
+                        transfer(in, gap, out, constructed, std::true_type{});
+                        transfer(
+                            in + gap,
+                            n - gap,
+                            out + gap + gap_size,
+                            constructed,
+                            std::true_type{});
+                    } else {
+                        transfer(
+                            in, gap, out, constructed, std::false_type{});
+                        transfer(
+                            in + gap,
+                            n - gap,
+                            out + gap + gap_size,
+                            constructed,
+                            std::false_type{});
+                    }
+                }
+            } catch (...) {
+                for (size_type i = 0; i < constructed; ++i) {
+                    (out + (i < gap ? i : i + gap_size))->~T();
+                }
+                if (filled) {
+                    for (size_type i = 0; i < gap_size; ++i) {
+                        out[gap + i].~T();
+                    }
+                }
+                h->~header();
+                ::operator delete(h);
+                throw;
+            }
+            h->size = n + gap_size;
+            release();
+            buf_ = h;
+        }
+
+        // Constructs count elements at out from those at in, counting them
+        // in constructed; moves them if Move and moving does not throw.
+        static void transfer(
+            T * in,
+            size_type count,
+            T * out,
+            size_type & constructed,
+            std::true_type)
+        {
+            for (size_type i = 0; i < count; ++i, ++constructed) {
+                ::new (out + i) T(std::move_if_noexcept(in[i]));
+            }
+        }
+        static void transfer(
+            T * in,
+            size_type count,
+            T * out,
+            size_type & constructed,
+            std::false_type)
+        {
+            for (size_type i = 0; i < count; ++i, ++constructed) {
+                ::new (out + i) T(static_cast<T const &>(in[i]));
+            }
+        }
+
+        // Replaces a shared buffer with an unshared one that holds all but
+        // the elements [i, j).
+        void release_range_into_new_buffer(size_type i, size_type j)
+        {
+            size_type const n = size();
+            header * const h = allocate(capacity());
+            T * const in = elements(buf_);
+            T * const out = elements(h);
+            size_type constructed = 0;
+            try {
+                transfer(in, i, out, constructed, std::false_type{});
+                transfer(
+                    in + j, n - j, out + i, constructed, std::false_type{});
+            } catch (...) {
+                for (size_type k = 0; k < constructed; ++k) {
+                    out[k].~T();
+                }
+                h->~header();
+                ::operator delete(h);
+                throw;
+            }
+            h->size = n - (j - i);
+            release();
+            buf_ = h;
+        }
+
+        template<typename InputIterator>
+        void insert_impl(
+            size_type i,
+            InputIterator first,
+            InputIterator last,
+            std::input_iterator_tag)
+        {
+            size_type const n = size();
+            for (; first != last; ++first) {
+                emplace_back(*first);
+            }
+            if (size() == n)
+                return;
+            T * const data = elements(buf_);
+            std::rotate(data + i, data + n, data + size());
+        }
+        template<typename ForwardIterator>
+        void insert_impl(
+            size_type i,
+            ForwardIterator first,
+            ForwardIterator last,
+            std::forward_iterator_tag)
+        {
+            size_type const count = size_type(std::distance(first, last));
+            if (!count)
+                return;
+            size_type const n = size();
+            if (capacity() < n + count || !unique()) {
+                reallocate(grown_capacity(n + count), i, count, [&](T * p) {
+                    std::uninitialized_copy(first, last, p);
+                });
+                return;
+            }
+            // The range may be part of this vector, which does not move, so
+            // it is appended, and then rotated into place.
+            T * const data = elements(buf_);
+            std::uninitialized_copy(first, last, data + n);
+            buf_->size = n + count;
+            std::rotate(data + i, data + n, data + n + count);
+        }
+
+        template<typename Fill>
+        void resize_impl(size_type n, Fill fill)
+        {
+            size_type const old_n = size();
+            if (n <= old_n) {
+                if (n < old_n)
+                    erase(shared_data() + n, shared_data() + old_n);
+                return;
+            }
+            size_type const count = n - old_n;
+            if (capacity() < n || !unique()) {
+                reallocate(grown_capacity(n), old_n, count, [&](T * p) {
+                    fill(p, count);
+                });
+                return;
+            }
+            fill(elements(buf_) + old_n, count);
+            buf_->size = n;
+        }
+
+        header * buf_ = nullptr;
+#endif
+    };
+
+}}}
+
+#endif
@@ -0,0 +1,259 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_CUCKOO_FILTER_HPP
+#define BOOST_STL_INTERFACES_CUCKOO_FILTER_HPP
+
+#include <boost/stl_interfaces/bloom_filter.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+    /** A cuckoo filter of keys of type `T`: like a `bloom_filter`, a set
+        that may report a key that was never inserted as present, but
+        never reports an inserted key as absent; unlike one, it can erase
+        the keys inserted into it.
+
+        Each key is stored as a 16-bit fingerprint, in one of two buckets
+        of four fingerprints that its hash picks; each bucket is one 64-bit
+        word, and a query tests all four of a bucket's fingerprints at
+        once.  The false positive rate is about 8 / 2^16, or 0.012%, in
+        about 17 bits per key at the filter's 95% load.  The batch
+        `contains(first, last, out)` hashes 32 keys at a time and
+        prefetches both buckets of each before testing any of them.
+
+        Inserting a key whose buckets are both full evicts a fingerprint to
+        its other bucket, and so on, up to `max_kicks` times; if that does
+        not find a free slot, the last one evicted is held aside, and the
+        filter is full: `insert()` returns `false` until an `erase()` makes
+        room.  Erasing a key that was not inserted may erase a key that
+        shares its fingerprint and bucket.
+
+        `Hash` is a `std::hash`-like function object; its result is mixed
+        further, so an identity hash of integers is fine. */
+    template<typename T, typename Hash = std::hash<T>>
+    struct cuckoo_filter : private detail::functor_box<Hash>
+    {
+        using key_type = T;
+        using hasher = Hash;
+        using size_type = std::size_t;
+
+        /** The number of fingerprints in each bucket. */
+        static constexpr size_type bucket_size = 4;
+        /** The most fingerprints that an insertion moves. */
+        static constexpr int max_kicks = 500;
+
+        /** Constructs a filter with room for at least `capacity` keys, at a
+            load of 95%; the number of buckets is a power of 2. */
+        explicit cuckoo_filter(
+            size_type capacity, Hash const & hash = Hash()) :
+            detail::functor_box<Hash>(hash)
+        {
+            size_type buckets = 1;
+            while (buckets * bucket_size * 19 < capacity * 20) {
+                buckets *= 2;
+            }
+            buckets_.assign(buckets, 0);
+        }
+
+        /** Returns the number of keys in the filter. */
+        size_type size() const noexcept { return size_; }
+        bool empty() const noexcept { return !size_; }
+        /** Returns the number of keys that the filter has slots for. */
+        size_type slot_count() const noexcept
+        {
+            return buckets_.size() * bucket_size;
+        }
+        hasher hash_function() const { return hash(); }
+
+        /** Inserts `x`, and returns `true`, or returns `false` if the
+            filter is full. */
+        bool insert(T const & x)
+        {
+            if (has_victim_)
+                return false;
+            probe const p = make_probe(x);
+            if (place(p.i1, p.fp) || place(p.i2, p.fp)) {
+                ++size_;
+                return true;
+            }
+            std::uint64_t fp = p.fp;
+            size_type i = (next_random() & 1) ? p.i2 : p.i1;
+            for (int kick = 0; kick < max_kicks; ++kick) {
+                int const shift = int(next_random() % bucket_size) * 16;
+                std::uint64_t const evicted = buckets_[i] >> shift & 0xffff;
+                buckets_[i] ^= (evicted ^ fp) << shift;
+                fp = evicted;
+                i = alternate(i, fp);
+                if (place(i, fp)) {
+                    ++size_;
+                    return true;
+                }
+            }
+            victim_ = {i, alternate(i, fp), fp};
+            has_victim_ = true;
+            ++size_;
+            return true;
+        }
+
+        /** Erases one copy of `x`, and returns `true`, or returns `false`
+            if there is none. */
+        bool erase(T const & x)
+        {
+            probe const p = make_probe(x);
+            if (has_victim_ && victim_matches(p)) {
+                has_victim_ = false;
+                --size_;
+                return true;
+            }
+            if (!remove(p.i1, p.fp) && !remove(p.i2, p.fp))
+                return false;
+            --size_;
+            // The victim may fit now.
+            if (has_victim_ && (place(victim_.i1, victim_.fp) ||
+                                place(victim_.i2, victim_.fp))) {
+                has_victim_ = false;
+            }
+            return true;
+        }
+
+        /** Returns `true` if `x` may have been inserted, and `false` if it
+            was not. */
+        bool contains(T const & x) const
+        {
+            return test(make_probe(x));
+        }
+        /** Writes `contains(x)`, as a `bool`, to `out` for each key `x` of
+            `[first, last)`, in order, and returns the end of the output.
+            `out` may be any output iterator that accepts a `bool`.  Both
+            buckets of each key are prefetched a batch at a time, before any
+            of them is tested. */
+        template<
+            typename InputIterator,
+            typename Sentinel,
+            typename OutputIterator>
+        OutputIterator
+        contains(InputIterator first, Sentinel last, OutputIterator out) const
+        {
+            return detail::batch_probe::contains(*this, first, last, out);
+        }
+
+        void clear() noexcept
+        {
+            std::fill(buckets_.begin(), buckets_.end(), 0);
+            size_ = 0;
+            has_victim_ = false;
+        }
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+    private:
+        friend detail::batch_probe;
+
+        // A key's two buckets, and its fingerprint, which is never 0, the
+        // value of an empty slot.
+        struct probe
+        {
+            size_type i1;
+            size_type i2;
+            std::uint64_t fp;
+        };
+
+        static constexpr std::uint64_t lanes = 0x0001000100010001ull;
+
+        Hash const & hash() const noexcept
+        {
+            return detail::functor_box<Hash>::get();
+        }
+
+        // The other bucket of fingerprint fp in bucket i; the mapping is
+        // its own inverse, so it needs neither the key nor to know which
+        // bucket i is.
+        size_type alternate(size_type i, std::uint64_t fp) const noexcept
+        {
+            return (i ^ size_type(v1_dtl::filter_hash(fp))) &
+                   (buckets_.size() - 1);
+        }
+
+        probe make_probe(T const & x) const
+        {
+            std::uint64_t const h =
+                v1_dtl::filter_hash(std::uint64_t(hash()(x)));
+            std::uint64_t fp = h >> 48;
+            if (!fp)
+                fp = 1;
+            size_type const i1 = size_type(h) & (buckets_.size() - 1);
+            return {i1, alternate(i1, fp), fp};
+        }
+        void prefetch(probe const & p) const noexcept
+        {
+            v1_dtl::prefetch(&buckets_[p.i1]);
+            v1_dtl::prefetch(&buckets_[p.i2]);
+        }
+
+        // True if one of the four 16-bit lanes of bucket is fp.
+        static bool has(std::uint64_t bucket, std::uint64_t fp) noexcept
+        {
+            std::uint64_t const x = bucket ^ fp * lanes;
+            return ((x - lanes) & ~x & (lanes << 15)) != 0;
+        }
+        bool victim_matches(probe const & p) const noexcept
+        {
+            return victim_.fp == p.fp &&
+                   (victim_.i1 == p.i1 || victim_.i1 == p.i2);
+        }
+        bool test(probe const & p) const noexcept
+        {
+            return has(buckets_[p.i1], p.fp) || has(buckets_[p.i2], p.fp) ||
+                   (has_victim_ && victim_matches(p));
+        }
+
+        // Puts fp in the first empty slot of bucket i, if it has one.
+        bool place(size_type i, std::uint64_t fp) noexcept
+        {
+            for (int shift = 0; shift < 64; shift += 16) {
+                if (!(buckets_[i] >> shift & 0xffff)) {
+                    buckets_[i] |= fp << shift;
+                    return true;
+                }
+            }
+            return false;
+        }
+        bool remove(size_type i, std::uint64_t fp) noexcept
+        {
+            for (int shift = 0; shift < 64; shift += 16) {
+                if ((buckets_[i] >> shift & 0xffff) == fp) {
+                    buckets_[i] &= ~(std::uint64_t(0xffff) << shift);
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // xorshift64, to choose which fingerprint to evict.
+        std::uint64_t next_random() noexcept
+        {
+            random_ ^= random_ << 13;
+            random_ ^= random_ >> 7;
+            random_ ^= random_ << 17;
+            return random_;
+        }
+
+        std::vector<std::uint64_t> buckets_;
+        size_type size_ = 0;
+        probe victim_ = {0, 0, 0};
+        bool has_victim_ = false;
+        std::uint64_t random_ = 0x9e3779b97f4a7c15ull;
+#endif
+    };
+
+}}}
+
+#endif
@@ -0,0 +1,233 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_CYCLE_VIEW_HPP
+#define BOOST_STL_INTERFACES_CYCLE_VIEW_HPP
+
+#include <boost/stl_interfaces/iterator_interface.hpp>
+#include <boost/stl_interfaces/view_interface.hpp>
+
+#include <boost/assert.hpp>
+
+#include <iterator>
+
+#include <cstddef>
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    namespace v1_dtl {
+        // The period of a cyclic_iterator, when it is known at compile time.
+        // The wrap is then a remainder by a constant, which the compiler
+        // turns into a mask for a power of two, and into a multiplication
+        // otherwise.
+        template<std::size_t Period>
+        struct cycle_period
+        {
+            constexpr cycle_period() = default;
+            constexpr explicit cycle_period(std::ptrdiff_t n) noexcept
+            {
+                BOOST_ASSERT(n == std::ptrdiff_t(Period));
+                (void)n;
+            }
+
+            constexpr std::ptrdiff_t size() const noexcept { return Period; }
+            constexpr std::ptrdiff_t wrap(std::ptrdiff_t n) const noexcept
+            {
+                return std::size_t(n) % Period;
+            }
+        };
+
+        // The period, when it is known only at run time.  A power-of-two
+        // period wraps with a mask instead of a division.
+        template<>
+        struct cycle_period<0>
+        {
+            constexpr cycle_period() noexcept : size_(1), mask_(0) {}
+            constexpr explicit cycle_period(std::ptrdiff_t n) noexcept :
+                size_(n),
+                mask_((n & (n - 1)) == 0 ? n - 1 : 0)
+            {}
+
+            constexpr std::ptrdiff_t size() const noexcept { return size_; }
+            constexpr std::ptrdiff_t wrap(std::ptrdiff_t n) const noexcept
+            {
+                return mask_ ? n & mask_ : n % size_;
+            }
+
+        private:
+            std::ptrdiff_t size_;
+            std::ptrdiff_t mask_;
+        };
+    }
+
+#endif
+
+    /** A random access iterator that repeats the `size` elements starting at
+        `first` endlessly: the element at position `n` is `first[n %
+        size]`.
+
+        Unlike the `repeated_chars_iterator` in the iterator tutorial, it
+        does not compute `n % size` on each dereference.  It keeps the
+        position within the period alongside `n`, and `operator++()` and
+        `operator--()` wrap it with a comparison.  Only `operator+=()`
+        computes a remainder, and that is a mask if `size` is a power of
+        two.  If the period is known at compile time, pass it as `Period`;
+        then the iterator does not store it at all.
+
+        \pre `Iter` is a random access iterator, and `0 <= n` for every
+        position `n` that the iterator takes on.
+        \see `cycle_view` */
+    template<typename Iter, std::size_t Period = 0>
+    struct cyclic_iterator
+        : iterator_interface<
+              cyclic_iterator<Iter, Period>,
+              std::random_access_iterator_tag,
+              typename std::iterator_traits<Iter>::value_type,
+              typename std::iterator_traits<Iter>::reference,
+              typename std::iterator_traits<Iter>::pointer,
+              v1_dtl::iter_difference_t<Iter>>
+    {
+        static_assert(
+            std::is_convertible<
+                typename std::iterator_traits<Iter>::iterator_category,
+                std::random_access_iterator_tag>::value,
+            "cyclic_iterator requires random access iterators.");
+
+        using difference_type = v1_dtl::iter_difference_t<Iter>;
+        using reference = typename std::iterator_traits<Iter>::reference;
+
+        constexpr cyclic_iterator() = default;
+        constexpr cyclic_iterator(
+            Iter first, difference_type size, difference_type n) :
+            first_(first),
+            period_(size),
+            n_(n),
+            pos_(period_.wrap(n))
+        {
+            BOOST_ASSERT(0 < size);
+            BOOST_ASSERT(0 <= n);
+        }
+
+        constexpr reference operator*() const { return first_[pos_]; }
+        constexpr cyclic_iterator & operator++()
+        {
+            ++n_;
+            if (++pos_ == period_.size())
+                pos_ = 0;
+            return *this;
+        }
+        constexpr cyclic_iterator & operator--()
+        {
+            --n_;
+            if (!pos_)
+                pos_ = period_.size();
+            --pos_;
+            return *this;
+        }
+        constexpr cyclic_iterator & operator+=(difference_type i)
+        {
+            n_ += i;
+            pos_ = period_.wrap(n_);
+            return *this;
+        }
+        constexpr difference_type
+        operator-(cyclic_iterator const & other) const
+        {
+            return n_ - other.n_;
+        }
+        friend constexpr bool
+        operator==(cyclic_iterator const & lhs, cyclic_iterator const & rhs)
+        {
+            return lhs.n_ == rhs.n_;
+        }
+
+        /** Returns the number of elements repeated. */
+        constexpr difference_type period() const noexcept
+        {
+            return period_.size();
+        }
+
+        using base_type = iterator_interface<
+            cyclic_iterator<Iter, Period>,
+            std::random_access_iterator_tag,
+            typename std::iterator_traits<Iter>::value_type,
+            reference,
+            typename std::iterator_traits<Iter>::pointer,
+            difference_type>;
+        using base_type::operator++;
+        using base_type::operator--;
+
+    private:
+        Iter first_ = Iter();
+        v1_dtl::cycle_period<Period> period_;
+        difference_type n_ = 0;
+        difference_type pos_ = 0; // == period_.wrap(n_)
+    };
+
+    /** A view of the first `n` elements of the endless repetition of the
+        range `[first, last)`.  `Period`, if nonzero, is `last - first`, known
+        at compile time.
+        \see `cyclic_iterator` */
+    template<typename Iter, std::size_t Period = 0>
+    struct cycle_view : view_interface<cycle_view<Iter, Period>>
+    {
+        using iterator = cyclic_iterator<Iter, Period>;
+        using difference_type = v1_dtl::iter_difference_t<Iter>;
+
+        constexpr cycle_view() = default;
+        constexpr cycle_view(Iter first, Iter last, difference_type n) :
+            first_(first),
+            period_(last - first),
+            n_(n)
+        {
+            BOOST_ASSERT(first != last);
+            BOOST_ASSERT(0 <= n);
+        }
+
+        constexpr iterator begin() const
+        {
+            return iterator(first_, period_, 0);
+        }
+        constexpr iterator end() const
+        {
+            return iterator(first_, period_, n_);
+        }
+
+        constexpr difference_type size() const noexcept { return n_; }
+        /** Returns the number of elements repeated. */
+        constexpr difference_type period() const noexcept { return period_; }
+
+    private:
+        Iter first_ = Iter();
+        difference_type period_ = 1;
+        difference_type n_ = 0;
+    };
+
+    /** Returns a `cycle_view` of the first `n` elements of the endless
+        repetition of `r`. */
+    template<typename Range>
+    constexpr auto make_cycle_view(
+        Range && r, v1_dtl::iter_difference_t<decltype(std::begin(r))> n)
+    {
+        using iter = decltype(std::begin(r));
+        return cycle_view<iter>(std::begin(r), std::end(r), n);
+    }
+
+    /** Returns a `cycle_view` of the first `n` elements of the endless
+        repetition of `r`, which has `Period` elements. */
+    template<std::size_t Period, typename Range>
+    constexpr auto make_cycle_view(
+        Range && r, v1_dtl::iter_difference_t<decltype(std::begin(r))> n)
+    {
+        using iter = decltype(std::begin(r));
+        return cycle_view<iter, Period>(std::begin(r), std::end(r), n);
+    }
+
+}}}
+
+#endif
@@ -0,0 +1,331 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_D_ARY_HEAP_HPP
+#define BOOST_STL_INTERFACES_D_ARY_HEAP_HPP
+
+#include <boost/stl_interfaces/container_interface.hpp>
+#include <boost/stl_interfaces/detail/functor_box.hpp>
+
+#include <boost/assert.hpp>
+
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+    template<typename T, std::size_t D, typename Compare>
+    struct d_ary_heap;
+
+    /** `d_ary_heap` keeps its elements in a `std::vector`, which destroys
+        them itself, so `container_interface` does not need to call
+        `clear()`. */
+    template<typename T, std::size_t D, typename Compare>
+    struct trivially_destructible_container<d_ary_heap<T, D, Compare>>
+        : std::true_type
+    {
+    };
+
+    /** A priority queue, like `std::priority_queue`, kept as an implicit
+        heap in which each node has `D` children instead of two.  A 4-ary
+        heap is half as deep as a binary one, and the children of a node
+        are adjacent, so that they often share a cache line; `pop()` does
+        more comparisons per level, but touches about half as many cache
+        lines, and `push()` does half as many moves.
+
+        As with `std::priority_queue`, `top()` is the greatest element
+        according to `Compare`; use `std::greater<T>` to get the least
+        first, as a timer queue does.  The elements are contiguous, and
+        iterating over them visits them in heap order, which is no order in
+        particular; the iterators are random access, but are iterators to
+        `T const`, since changing an element in place may break the heap.
+        `push_range()` appends many elements at once, and builds the heap
+        bottom-up (Floyd's method) when that is cheaper than sifting each
+        element up in turn.
+
+        Two heaps with the same elements may keep them in different orders,
+        so there is no `operator==()` or `operator<()`.
+
+        \see `container_interface` */
+    template<typename T, std::size_t D = 4, typename Compare = std::less<T>>
+    struct d_ary_heap
+        : container_interface<d_ary_heap<T, D, Compare>, contiguous>
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+        ,
+          private detail::functor_box<Compare>
+#endif
+    {
+        static_assert(2 <= D, "");
+
+        using value_type = T;
+        using value_compare = Compare;
+        using reference = T const &;
+        using const_reference = T const &;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using iterator = T const *;
+        using const_iterator = T const *;
+        using reverse_iterator = stl_interfaces::reverse_iterator<iterator>;
+        using const_reverse_iterator = reverse_iterator;
+
+        d_ary_heap() = default;
+        explicit d_ary_heap(Compare const & compare) :
+            detail::functor_box<Compare>(compare)
+        {}
+        template<
+            typename InputIterator,
+            typename Enable = std::enable_if_t<std::is_convertible<
+                typename std::iterator_traits<
+                    InputIterator>::iterator_category,
+                std::input_iterator_tag>::value>>
+        d_ary_heap(
+            InputIterator first,
+            InputIterator last,
+            Compare const & compare = Compare()) :
+            detail::functor_box<Compare>(compare)
+        {
+            push_range(first, last);
+        }
+        d_ary_heap(
+            std::initializer_list<T> il, Compare const & compare = Compare()) :
+            d_ary_heap(il.begin(), il.end(), compare)
+        {}
+
+        iterator begin() noexcept { return elements_.data(); }
+        iterator end() noexcept
+        {
+            return elements_.data() + elements_.size();
+        }
+
+        /** Returns a pointer to the elements, in heap order, which may be
+            null if the heap is empty. */
+        T const * data() const noexcept { return elements_.data(); }
+
+        size_type size() const noexcept { return elements_.size(); }
+        size_type max_size() const noexcept { return elements_.max_size(); }
+        size_type capacity() const noexcept { return elements_.capacity(); }
+        void reserve(size_type n) { elements_.reserve(n); }
+        void shrink_to_fit() { elements_.shrink_to_fit(); }
+
+        value_compare value_comp() const { return compare(); }
+
+        /** Returns the greatest element.
+            \pre `!empty()` */
+        T const & top() const noexcept
+        {
+            BOOST_ASSERT(!elements_.empty());
+            return elements_.front();
+        }
+
+        void push(T const & x)
+        {
+            elements_.push_back(x);
+            sift_up(elements_.size() - 1);
+        }
+        void push(T && x)
+        {
+            elements_.push_back(std::move(x));
+            sift_up(elements_.size() - 1);
+        }
+        template<
+            typename... Args,
+            typename Enable =
+                std::enable_if_t<std::is_constructible<T, Args &&...>::value>>
+        void emplace(Args &&... args)
+        {
+            elements_.emplace_back(std::forward<Args>(args)...);
+            sift_up(elements_.size() - 1);
+        }
+
+        /** Inserts the elements of `[first, last)`.  When they are at least
+            as many as the elements already in the heap, this rebuilds the
+            whole heap bottom-up, in O(size()) time; otherwise it sifts each
+            one up, in O(log(size())) time each. */
+        template<
+            typename InputIterator,
+            typename Enable = std::enable_if_t<std::is_convertible<
+                typename std::iterator_traits<
+                    InputIterator>::iterator_category,
+                std::input_iterator_tag>::value>>
+        void push_range(InputIterator first, InputIterator last)
+        {
+            auto const old_size = elements_.size();
+            elements_.insert(elements_.end(), first, last);
+            auto const n = elements_.size();
+            if (old_size <= n - old_size) {
+                make_heap();
+            } else {
+                for (auto i = old_size; i < n; ++i) {
+                    sift_up(i);
+                }
+            }
+        }
+        void push_range(std::initializer_list<T> il)
+        {
+            push_range(il.begin(), il.end());
+        }
+
+        /** Removes the greatest element.
+            \pre `!empty()` */
+        void pop()
+        {
+            BOOST_ASSERT(!elements_.empty());
+            if (1 < elements_.size())
+                elements_.front() = std::move(elements_.back());
+            elements_.pop_back();
+            if (!elements_.empty())
+                sift_down(0);
+        }
+        /** Removes the greatest element and inserts `x`, with one sift
+            instead of two, as when rescheduling a periodic timer.
+            \pre `!empty()` */
+        void replace_top(T x)
+        {
+            BOOST_ASSERT(!elements_.empty());
+            elements_.front() = std::move(x);
+            sift_down(0);
+        }
+
+        /** Removes the element at `pos`, as when cancelling a timer.  The
+            other elements may be reordered. */
+        void erase(const_iterator pos)
+        {
+            auto const i = size_type(pos - data());
+            if (i + 1 != elements_.size())
+                elements_[i] = std::move(elements_.back());
+            elements_.pop_back();
+            if (i == elements_.size())
+                return;
+            if (0 < i && compare()(elements_[(i - 1) / D], elements_[i]))
+                sift_up(i);
+            else
+                sift_down(i);
+        }
+        void clear() noexcept { elements_.clear(); }
+        void swap(d_ary_heap & other)
+        {
+            using std::swap;
+            swap(compare(), other.compare());
+            elements_.swap(other.elements_);
+        }
+
+        /** Swaps `lhs` and `rhs`. */
+        friend void swap(d_ary_heap & lhs, d_ary_heap & rhs)
+        {
+            lhs.swap(rhs);
+        }
+
+        friend bool
+        operator==(d_ary_heap const &, d_ary_heap const &) = delete;
+        friend bool
+        operator<(d_ary_heap const &, d_ary_heap const &) = delete;
+
+        using base_type =
+            container_interface<d_ary_heap<T, D, Compare>, contiguous>;
+        using base_type::begin;
+        using base_type::end;
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+    private:
+        Compare const & compare() const noexcept
+        {
+            return detail::functor_box<Compare>::get();
+        }
+        Compare & compare() noexcept
+        {
+            return detail::functor_box<Compare>::get();
+        }
+
+        // Moves the element at i up toward root, which is one of its
+        // ancestors, to where it belongs.
+        void sift_up(size_type i, size_type root = 0)
+        {
+            T x = std::move(elements_[i]);
+            while (root < i) {
+                auto const parent = (i - 1) / D;
+                if (!compare()(elements_[parent], x))
+                    break;
+                elements_[i] = std::move(elements_[parent]);
+                i = parent;
+            }
+            elements_[i] = std::move(x);
+        }
+
+        // Moves the element at i down to where it belongs.  This moves the
+        // hole at i all the way down to a leaf, always to its greatest
+        // child, and then sifts the element up from there (Floyd's
+        // bottom-up variant, as libstdc++'s std::pop_heap() does).  An
+        // element sifted down usually belongs near the bottom, since most of
+        // the elements are there, so this saves a comparison with it at
+        // every level, and the branch on that comparison.
+        void sift_down(size_type i)
+        {
+            auto const root = i;
+            auto const n = elements_.size();
+            T x = std::move(elements_[i]);
+            for (;;) {
+                auto const first_child = D * i + 1;
+                if (n <= first_child)
+                    break;
+                auto best = first_child;
+                if (D <= n - first_child) {
+                    best = best_child(
+                        first_child, std::integral_constant<size_type, D>{});
+                } else {
+                    for (auto c = first_child + 1; c < n; ++c) {
+                        if (compare()(elements_[best], elements_[c]))
+                            best = c;
+                    }
+                }
+                elements_[i] = std::move(elements_[best]);
+                i = best;
+            }
+            elements_[i] = std::move(x);
+            sift_up(i, root);
+        }
+
+        // Returns the greatest of the N elements starting at first, by a
+        // tournament: the two halves are independent, so their comparisons
+        // overlap, and the selects compile without branches to mispredict.
+        template<size_type N>
+        size_type
+        best_child(size_type first, std::integral_constant<size_type, N>)
+        {
+            auto const a =
+                best_child(first, std::integral_constant<size_type, N / 2>{});
+            auto const b = best_child(
+                first + N / 2, std::integral_constant<size_type, N - N / 2>{});
+            return compare()(elements_[a], elements_[b]) ? b : a;
+        }
+        size_type
+        best_child(size_type first, std::integral_constant<size_type, 1>)
+        {
+            return first;
+        }
+
+        // Floyd's method: sift down each node that has children, from the
+        // last one to the root.
+        void make_heap()
+        {
+            auto const n = elements_.size();
+            if (n < 2)
+                return;
+            for (auto i = (n - 2) / D + 1; i-- != 0;) {
+                sift_down(i);
+            }
+        }
+
+        std::vector<T> elements_;
+#endif
+    };
+
+}}}
+
+#endif
@@ -0,0 +1,400 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_DELTA_SORTED_VECTOR_HPP
+#define BOOST_STL_INTERFACES_DELTA_SORTED_VECTOR_HPP
+
+#include <boost/stl_interfaces/container_interface.hpp>
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+    template<typename T, typename Compare>
+    struct delta_sorted_vector;
+
+    /** `delta_sorted_vector`'s vectors destroy its elements, so
+        `container_interface` does not need to call `clear()`. */
+    template<typename T, typename Compare>
+    struct trivially_destructible_container<delta_sorted_vector<T, Compare>>
+        : std::true_type
+    {
+    };
+
+    /** The bidirectional iterator of `delta_sorted_vector`: a pointer into
+        each of its two sorted arrays, which together point to the next
+        element of their merge.  Dereferencing it compares the two
+        elements, and takes the lesser; an element of the base array comes
+        before an equal one of the delta. */
+    template<typename T, typename Compare>
+    struct delta_sorted_vector_iterator
+        : iterator_interface<
+              delta_sorted_vector_iterator<T, Compare>,
+              std::bidirectional_iterator_tag,
+              T,
+              T const &,
+              T const *>
+    {
+        delta_sorted_vector_iterator() noexcept = default;
+
+        T const & operator*() const noexcept
+        {
+            return in_base() ? *b_ : *d_;
+        }
+        delta_sorted_vector_iterator & operator++() noexcept
+        {
+            if (in_base())
+                ++b_;
+            else
+                ++d_;
+            return *this;
+        }
+        delta_sorted_vector_iterator & operator--() noexcept
+        {
+            if (d_ != v_->delta_.data() &&
+                (b_ == v_->base_.data() || !v_->comp_(d_[-1], b_[-1]))) {
+                --d_;
+            } else {
+                --b_;
+            }
+            return *this;
+        }
+        friend bool operator==(
+            delta_sorted_vector_iterator lhs,
+            delta_sorted_vector_iterator rhs) noexcept
+        {
+            return lhs.b_ == rhs.b_ && lhs.d_ == rhs.d_;
+        }
+
+        using base_type = iterator_interface<
+            delta_sorted_vector_iterator<T, Compare>,
+            std::bidirectional_iterator_tag,
+            T,
+            T const &,
+            T const *>;
+        using base_type::operator++;
+        using base_type::operator--;
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+    private:
+        friend struct delta_sorted_vector<T, Compare>;
+
+        delta_sorted_vector_iterator(
+            delta_sorted_vector<T, Compare> const * v,
+            T const * b,
+            T const * d) noexcept :
+            v_(v), b_(b), d_(d)
+        {}
+
+        bool in_base() const noexcept
+        {
+            T const * const base_end = v_->base_.data() + v_->base_.size();
+            T const * const delta_end = v_->delta_.data() + v_->delta_.size();
+            return d_ == delta_end ||
+                   (b_ != base_end && !v_->comp_(*d_, *b_));
+        }
+
+        delta_sorted_vector<T, Compare> const * v_ = nullptr;
+        T const * b_ = nullptr;
+        T const * d_ = nullptr;
+#endif
+    };
+
+    /** A sorted vector of `T`, with duplicates, held as a large sorted
+        base array and a small sorted delta array of recent insertions.
+        Inserting an element inserts it into the delta, which moves only
+        the delta's elements after it, rather than the base's; when the
+        delta outgrows the square root of the base's size (or 64 elements,
+        whichever is more), the two are merged into the base.  An
+        insertion costs amortized O(sqrt(n)) moves, instead of O(n).
+
+        Lookups binary search both arrays, and iteration walks both with a
+        merging iterator, so reads stay sequential and cache-friendly.
+        Erasing an element of the base still moves the base's elements
+        after it; `compact()` merges the delta into the base on demand, as
+        after a batch of insertions into a read-mostly index.
+
+        Every insertion, erasure or compaction invalidates all iterators
+        and references.
+
+        \see `container_interface` */
+    template<typename T, typename Compare = std::less<T>>
+    struct delta_sorted_vector
+        : container_interface<delta_sorted_vector<T, Compare>, discontiguous>
+    {
+        using key_type = T;
+        using value_type = T;
+        using key_compare = Compare;
+        using value_compare = Compare;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using reference = value_type &;
+        using const_reference = value_type const &;
+        using pointer = value_type *;
+        using const_pointer = value_type const *;
+        using iterator = delta_sorted_vector_iterator<T, Compare>;
+        using const_iterator = iterator;
+        using reverse_iterator = stl_interfaces::reverse_iterator<iterator>;
+        using const_reverse_iterator = reverse_iterator;
+
+        /** The least number of elements that the delta may hold before it
+            is merged into the base. */
+        static constexpr size_type min_delta_size = 64;
+
+        delta_sorted_vector() = default;
+        explicit delta_sorted_vector(Compare const & comp) : comp_(comp) {}
+        /** Sorts the elements of `[first, last)`, stably, into the base. */
+        template<
+            typename InputIterator,
+            typename Enable = std::enable_if_t<std::is_convertible<
+                typename std::iterator_traits<
+                    InputIterator>::iterator_category,
+                std::input_iterator_tag>::value>>
+        delta_sorted_vector(
+            InputIterator first,
+            InputIterator last,
+            Compare const & comp = Compare()) :
+            base_(first, last), comp_(comp)
+        {
+            std::stable_sort(base_.begin(), base_.end(), comp_);
+            delta_limit_ = delta_limit(base_.size());
+        }
+        delta_sorted_vector(
+            std::initializer_list<T> il, Compare const & comp = Compare()) :
+            delta_sorted_vector(il.begin(), il.end(), comp)
+        {}
+
+        iterator begin() const noexcept
+        {
+            return iterator(this, base_.data(), delta_.data());
+        }
+        iterator end() const noexcept
+        {
+            return iterator(
+                this,
+                base_.data() + base_.size(),
+                delta_.data() + delta_.size());
+        }
+
+        size_type size() const noexcept
+        {
+            return base_.size() + delta_.size();
+        }
+        bool empty() const noexcept
+        {
+            return base_.empty() && delta_.empty();
+        }
+        size_type max_size() const noexcept { return base_.max_size(); }
+        key_compare key_comp() const { return comp_; }
+        value_compare value_comp() const { return comp_; }
+
+        /** Returns the number of elements in the delta, not yet merged into
+            the base. */
+        size_type delta_size() const noexcept { return delta_.size(); }
+
+        iterator lower_bound(T const & x) const
+        {
+            return iterator(
+                this,
+                bound(base_, x, std::false_type{}),
+                bound(delta_, x, std::false_type{}));
+        }
+        iterator upper_bound(T const & x) const
+        {
+            return iterator(
+                this,
+                bound(base_, x, std::true_type{}),
+                bound(delta_, x, std::true_type{}));
+        }
+        std::pair<iterator, iterator> equal_range(T const & x) const
+        {
+            return {lower_bound(x), upper_bound(x)};
+        }
+        /** Returns an iterator to the first element equal to `x`, or
+            `end()`. */
+        iterator find(T const & x) const
+        {
+            auto const it = lower_bound(x);
+            if (it != end() && !comp_(x, *it))
+                return it;
+            return end();
+        }
+        size_type count(T const & x) const
+        {
+            auto const first = lower_bound(x);
+            auto const last = upper_bound(x);
+            return size_type((last.b_ - first.b_) + (last.d_ - first.d_));
+        }
+        bool contains(T const & x) const { return find(x) != end(); }
+
+        /** Inserts `x` after the elements equal to it, and returns an
+            iterator to it. */
+        iterator insert(T const & x) { return insert_impl(x); }
+        iterator insert(T && x) { return insert_impl(std::move(x)); }
+        /** Inserts the elements of `[first, last)`, each after the elements
+            equal to it: they are appended to the delta, sorted, and merged
+            with it. */
+        template<
+            typename InputIterator,
+            typename Enable = std::enable_if_t<std::is_convertible<
+                typename std::iterator_traits<
+                    InputIterator>::iterator_category,
+                std::input_iterator_tag>::value>>
+        void insert(InputIterator first, InputIterator last)
+        {
+            auto const n = delta_.size();
+            delta_.insert(delta_.end(), first, last);
+            auto const mid = delta_.begin() + difference_type(n);
+            std::stable_sort(mid, delta_.end(), comp_);
+            std::inplace_merge(delta_.begin(), mid, delta_.end(), comp_);
+            if (delta_limit_ < delta_.size())
+                compact();
+        }
+        void insert(std::initializer_list<T> il)
+        {
+            insert(il.begin(), il.end());
+        }
+        template<typename... Args>
+        iterator emplace(Args &&... args)
+        {
+            return insert_impl(T((Args &&) args...));
+        }
+
+        /** Erases the element at `pos`, and returns an iterator to the
+            element after it. */
+        iterator erase(const_iterator pos)
+        {
+            BOOST_ASSERT(pos != end());
+            auto const b = pos.b_ - base_.data();
+            auto const d = pos.d_ - delta_.data();
+            if (pos.in_base())
+                base_.erase(base_.begin() + b);
+            else
+                delta_.erase(delta_.begin() + d);
+            return iterator(this, base_.data() + b, delta_.data() + d);
+        }
+        /** Erases the elements of `[first, last)`: those of the base, and
+            those of the delta, each in one move. */
+        iterator erase(const_iterator first, const_iterator last)
+        {
+            auto const b = first.b_ - base_.data();
+            auto const d = first.d_ - delta_.data();
+            base_.erase(
+                base_.begin() + b, base_.begin() + (last.b_ - base_.data()));
+            delta_.erase(
+                delta_.begin() + d,
+                delta_.begin() + (last.d_ - delta_.data()));
+            return iterator(this, base_.data() + b, delta_.data() + d);
+        }
+        /** Erases the elements equal to `x`, and returns how many there
+            were. */
+        size_type erase(T const & x)
+        {
+            auto const first = lower_bound(x);
+            auto const last = upper_bound(x);
+            auto const retval =
+                size_type((last.b_ - first.b_) + (last.d_ - first.d_));
+            erase(first, last);
+            return retval;
+        }
+        void clear() noexcept
+        {
+            base_.clear();
+            delta_.clear();
+            delta_limit_ = min_delta_size;
+        }
+
+        /** Merges the delta into the base. */
+        void compact()
+        {
+            auto const n = difference_type(base_.size());
+            base_.insert(
+                base_.end(),
+                std::make_move_iterator(delta_.begin()),
+                std::make_move_iterator(delta_.end()));
+            delta_.clear();
+            std::inplace_merge(
+                base_.begin(), base_.begin() + n, base_.end(), comp_);
+            delta_limit_ = delta_limit(base_.size());
+        }
+
+        void swap(delta_sorted_vector & other)
+        {
+            using std::swap;
+            base_.swap(other.base_);
+            delta_.swap(other.delta_);
+            swap(comp_, other.comp_);
+            swap(delta_limit_, other.delta_limit_);
+        }
+
+        /** Swaps `lhs` and `rhs`. */
+        friend void swap(delta_sorted_vector & lhs, delta_sorted_vector & rhs)
+        {
+            lhs.swap(rhs);
+        }
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+    private:
+        friend iterator;
+
+        static size_type delta_limit(size_type base_size) noexcept
+        {
+            return (std::max)(
+                size_type(min_delta_size),
+                size_type(std::sqrt(double(base_size))));
+        }
+
+        template<bool Upper>
+        T const * bound(
+            std::vector<T> const & v,
+            T const & x,
+            std::integral_constant<bool, Upper>) const
+        {
+            T const * const first = v.data();
+            T const * const last = first + v.size();
+            if (Upper)
+                return std::upper_bound(first, last, x, comp_);
+            return std::lower_bound(first, last, x, comp_);
+        }
+
+        template<typename U>
+        iterator insert_impl(U && x)
+        {
+            // x follows the elements of the base not greater than it, and
+            // the ones of the delta before where it is inserted.
+            auto const b = bound(base_, x, std::true_type{}) - base_.data();
+            auto const it = delta_.insert(
+                std::upper_bound(delta_.begin(), delta_.end(), x, comp_),
+                (U &&) x);
+            auto const d = it - delta_.begin();
+            if (delta_.size() <= delta_limit_)
+                return iterator(this, base_.data() + b, delta_.data() + d);
+            compact();
+            return iterator(
+                this, base_.data() + b + d, delta_.data() + delta_.size());
+        }
+
+        std::vector<T> base_;
+        std::vector<T> delta_;
+        Compare comp_;
+        size_type delta_limit_ = min_delta_size;
+#endif
+    };
+
+}}}
+
+#endif
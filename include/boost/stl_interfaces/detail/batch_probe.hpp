@@ -0,0 +1,49 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_DETAIL_BATCH_PROBE_HPP
+#define BOOST_STL_INTERFACES_DETAIL_BATCH_PROBE_HPP
+
+
+namespace boost { namespace stl_interfaces { namespace detail {
+
+    // Answers contains() for each of a range of keys, a batch at a time: it
+    // hashes each key of a batch to a Filter::probe, and has the filter
+    // prefetch the memory that the probe will test, and only then tests the
+    // probes, so that the cache misses of a whole batch are outstanding at
+    // once, instead of one after another.
+    struct batch_probe
+    {
+        static constexpr int batch_size = 32;
+
+        template<
+            typename Filter,
+            typename InputIterator,
+            typename Sentinel,
+            typename OutputIterator>
+        static OutputIterator contains(
+            Filter const & f,
+            InputIterator first,
+            Sentinel last,
+            OutputIterator out)
+        {
+            typename Filter::probe probes[batch_size];
+            while (first != last) {
+                int n = 0;
+                for (; n < batch_size && first != last; ++n, ++first) {
+                    probes[n] = f.make_probe(*first);
+                    f.prefetch(probes[n]);
+                }
+                for (int i = 0; i < n; ++i, ++out) {
+                    *out = f.test(probes[i]);
+                }
+            }
+            return out;
+        }
+    };
+
+}}}
+
+#endif
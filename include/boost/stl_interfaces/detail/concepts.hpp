@@ -0,0 +1,263 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_DETAIL_CONCEPTS_HPP
+#define BOOST_STL_INTERFACES_DETAIL_CONCEPTS_HPP
+
+#include <boost/stl_interfaces/fwd.hpp>
+
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+#include <cstddef>
+
+
+// The few ranges concepts and utilities that the C++17 v2 interfaces use,
+// for compilers that implement the Concepts TS but have neither a C++20
+// standard library nor cmcstl2.  They are approximations -- mostly syntactic
+// checks, plus the iterator category or concept -- of their C++20
+// counterparts, and they are only as thorough as the v2 interfaces (and the
+// STATIC_ASSERT_CONCEPT checks of iterators built with them) need.  Parsing
+// this header takes a small fraction of the time that parsing cmcstl2 does.
+
+// clang-format off
+
+namespace boost { namespace stl_interfaces { namespace v2 {
+
+    namespace v2_dtl {
+        template<typename I, typename = void>
+        struct iter_concept
+        {
+            using type = typename std::iterator_traits<I>::iterator_category;
+        };
+        template<typename I>
+        struct iter_concept<I, v1::v1_dtl::void_t<typename I::iterator_concept>>
+        {
+            using type = typename I::iterator_concept;
+        };
+        template<typename T>
+        struct iter_concept<T *, void>
+        {
+            using type = v1::contiguous_iterator_tag;
+        };
+        template<typename I>
+        using iter_concept_t = typename iter_concept<I>::type;
+    }
+
+    namespace ranges {
+        template<typename T, typename U>
+        BOOST_STL_INTERFACES_CONCEPT same_as =
+            std::is_same<T, U>::value && std::is_same<U, T>::value;
+
+        template<typename Derived, typename Base>
+        BOOST_STL_INTERFACES_CONCEPT derived_from =
+            std::is_base_of<Base, Derived>::value &&
+            std::is_convertible<Derived const volatile *,
+                                Base const volatile *>::value;
+
+        template<typename I>
+        using iter_value_t = typename std::iterator_traits<I>::value_type;
+        template<typename I>
+        using iter_reference_t = decltype(*std::declval<I &>());
+        template<typename I>
+        using iter_difference_t =
+            typename std::iterator_traits<I>::difference_type;
+
+        template<typename I>
+        BOOST_STL_INTERFACES_CONCEPT input_or_output_iterator =
+          requires (I i) {
+            *i;
+            i++;
+            requires same_as<decltype(++i), I &>;
+          };
+
+        template<typename S, typename I>
+        BOOST_STL_INTERFACES_CONCEPT sized_sentinel_for =
+          requires (S const & s, I const & i) {
+            s - i;
+            i - s;
+          };
+
+        template<typename I>
+        BOOST_STL_INTERFACES_CONCEPT input_iterator =
+          input_or_output_iterator<I> &&
+          requires { typename iter_value_t<I>; } &&
+          derived_from<v2_dtl::iter_concept_t<I>, std::input_iterator_tag>;
+
+        template<typename I, typename T>
+        BOOST_STL_INTERFACES_CONCEPT output_iterator =
+          input_or_output_iterator<I> &&
+          requires (I i, T && t) {
+            *i = (T &&)t;
+            *i++ = (T &&)t;
+          };
+
+        template<typename I>
+        BOOST_STL_INTERFACES_CONCEPT forward_iterator =
+          input_iterator<I> &&
+          derived_from<v2_dtl::iter_concept_t<I>, std::forward_iterator_tag> &&
+          std::is_default_constructible<I>::value &&
+          std::is_copy_constructible<I>::value &&
+          requires (I i) {
+            i == i;
+            i != i;
+          };
+
+        template<typename I>
+        BOOST_STL_INTERFACES_CONCEPT bidirectional_iterator =
+          forward_iterator<I> &&
+          derived_from<v2_dtl::iter_concept_t<I>,
+                       std::bidirectional_iterator_tag> &&
+          requires (I i) {
+            --i;
+            i--;
+          };
+
+        template<typename I>
+        BOOST_STL_INTERFACES_CONCEPT random_access_iterator =
+          bidirectional_iterator<I> &&
+          derived_from<v2_dtl::iter_concept_t<I>,
+                       std::random_access_iterator_tag> &&
+          sized_sentinel_for<I, I> &&
+          requires (I i, iter_difference_t<I> n) {
+            i += n;
+            i + n;
+            n + i;
+            i -= n;
+            i - n;
+            i[n];
+            i < i;
+            i <= i;
+            i > i;
+            i >= i;
+          };
+
+        template<typename I>
+        BOOST_STL_INTERFACES_CONCEPT contiguous_iterator =
+          random_access_iterator<I> &&
+          derived_from<v2_dtl::iter_concept_t<I>,
+                       v1::contiguous_iterator_tag> &&
+          std::is_lvalue_reference<iter_reference_t<I>>::value;
+
+        struct begin_fn
+        {
+            template<typename R>
+            constexpr auto operator()(R & r) const -> decltype(r.begin())
+            {
+                return r.begin();
+            }
+            template<typename T, std::size_t N>
+            constexpr T * operator()(T (&a)[N]) const noexcept
+            {
+                return a;
+            }
+        };
+        struct end_fn
+        {
+            template<typename R>
+            constexpr auto operator()(R & r) const -> decltype(r.end())
+            {
+                return r.end();
+            }
+            template<typename T, std::size_t N>
+            constexpr T * operator()(T (&a)[N]) const noexcept
+            {
+                return a + N;
+            }
+        };
+        inline constexpr begin_fn begin{};
+        inline constexpr end_fn end{};
+
+        template<typename I>
+        constexpr I next(I i)
+        {
+            return ++i;
+        }
+        template<typename I>
+        constexpr I prev(I i)
+        {
+            return --i;
+        }
+
+        template<typename R>
+        using iterator_t = decltype(ranges::begin(std::declval<R &>()));
+        template<typename R>
+        using sentinel_t = decltype(ranges::end(std::declval<R &>()));
+        template<typename R>
+        using range_value_t = iter_value_t<iterator_t<R>>;
+
+        // Where cmcstl2 puts range_value_t.
+        namespace ext {
+            using ranges::range_value_t;
+        }
+
+        template<typename R>
+        BOOST_STL_INTERFACES_CONCEPT range =
+          requires (R & r) {
+            ranges::begin(r);
+            ranges::end(r);
+          };
+
+        template<typename R>
+        BOOST_STL_INTERFACES_CONCEPT sized_range =
+          range<R> &&
+          (requires (R & r) { r.size(); } ||
+           sized_sentinel_for<sentinel_t<R>, iterator_t<R>>);
+
+        template<typename R>
+        BOOST_STL_INTERFACES_CONCEPT common_range =
+          range<R> && same_as<iterator_t<R>, sentinel_t<R>>;
+
+        template<typename R>
+        BOOST_STL_INTERFACES_CONCEPT input_range =
+          range<R> && input_iterator<iterator_t<R>>;
+
+        template<typename R>
+        BOOST_STL_INTERFACES_CONCEPT forward_range =
+          range<R> && forward_iterator<iterator_t<R>>;
+
+        template<typename R>
+        BOOST_STL_INTERFACES_CONCEPT bidirectional_range =
+          range<R> && bidirectional_iterator<iterator_t<R>>;
+
+        template<typename R>
+        BOOST_STL_INTERFACES_CONCEPT random_access_range =
+          range<R> && random_access_iterator<iterator_t<R>>;
+
+        struct equal_to
+        {
+            template<typename T, typename U>
+            constexpr auto operator()(T && t, U && u) const
+                -> decltype(bool((T &&)t == (U &&)u))
+            {
+                return (T &&)t == (U &&)u;
+            }
+            using is_transparent = void;
+        };
+        struct less
+        {
+            template<typename T, typename U>
+            constexpr auto operator()(T && t, U && u) const
+                -> decltype(bool((T &&)t < (U &&)u))
+            {
+                return (T &&)t < (U &&)u;
+            }
+            using is_transparent = void;
+        };
+
+        template<typename F, typename I>
+        BOOST_STL_INTERFACES_CONCEPT indirect_relation =
+          requires (F & f, I i) {
+            f(*i, *i);
+            requires std::is_convertible<decltype(f(*i, *i)), bool>::value;
+          };
+    }
+
+}}}
+
+// clang-format on
+
+#endif
@@ -0,0 +1,80 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_DETAIL_FUNCTOR_BOX_HPP
+#define BOOST_STL_INTERFACES_DETAIL_FUNCTOR_BOX_HPP
+
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+
+namespace boost { namespace stl_interfaces { namespace detail {
+
+    // Holds an F for an iterator or a view, like the copyable-box of
+    // std::ranges.  Lambdas cannot be assigned, but iterators must be; so a
+    // box of an F that cannot be assigned is assigned by destroying its F
+    // and copy-constructing a new one in its place (calling
+    // std::terminate() if the copy throws, since the box would otherwise be
+    // left without an F).  An empty F that can be derived from is a base
+    // instead of a member, so that it takes up no space, and is never
+    // assigned at all.
+    template<
+        typename F,
+        bool Empty = std::is_empty<F>::value && !std::is_final<F>::value,
+        bool Assignable = std::is_copy_assignable<F>::value>
+    struct functor_box
+    {
+        constexpr functor_box() = default;
+        constexpr explicit functor_box(F f) : f_(std::move(f)) {}
+
+        constexpr F const & get() const noexcept { return f_; }
+        constexpr F & get() noexcept { return f_; }
+
+    private:
+        F f_;
+    };
+
+    template<typename F, bool Assignable>
+    struct functor_box<F, true, Assignable> : private F
+    {
+        constexpr functor_box() = default;
+        constexpr explicit functor_box(F f) : F(std::move(f)) {}
+        constexpr functor_box(functor_box const &) = default;
+        constexpr functor_box & operator=(functor_box const &) noexcept
+        {
+            return *this;
+        }
+
+        constexpr F const & get() const noexcept { return *this; }
+        constexpr F & get() noexcept { return *this; }
+    };
+
+    template<typename F>
+    struct functor_box<F, false, false>
+    {
+        constexpr functor_box() = default;
+        constexpr explicit functor_box(F f) : f_(std::move(f)) {}
+        constexpr functor_box(functor_box const &) = default;
+        functor_box & operator=(functor_box const & other) noexcept
+        {
+            if (this != &other) {
+                f_.~F();
+                ::new (static_cast<void *>(std::addressof(f_))) F(other.f_);
+            }
+            return *this;
+        }
+
+        constexpr F const & get() const noexcept { return f_; }
+        constexpr F & get() noexcept { return f_; }
+
+    private:
+        F f_;
+    };
+
+}}}
+
+#endif
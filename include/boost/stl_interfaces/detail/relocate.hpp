@@ -0,0 +1,153 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_DETAIL_RELOCATE_HPP
+#define BOOST_STL_INTERFACES_DETAIL_RELOCATE_HPP
+
+#include <boost/stl_interfaces/trivially_relocatable.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+
+
+namespace boost { namespace stl_interfaces { namespace detail {
+
+    template<typename T>
+    void destroy(T * first, T * last) noexcept
+    {
+        for (; first != last; ++first) {
+            first->~T();
+        }
+    }
+
+    // Calls f(), and if it throws, calls undo() and rethrows.  When Nothrow
+    // is true, f() cannot throw, and there is nothing to undo.
+    template<bool Nothrow>
+    struct undo_on_throw
+    {
+        template<typename F, typename Undo>
+        static void call(F f, Undo undo)
+        {
+            try {
+                f();
+            } catch (...) {
+                undo();
+                throw;
+            }
+        }
+    };
+    template<>
+    struct undo_on_throw<true>
+    {
+        template<typename F, typename Undo>
+        static void call(F f, Undo)
+        {
+            f();
+        }
+    };
+
+    template<bool Nothrow, typename T, typename ForwardIter>
+    void gap_insert_impl(
+        T * pos,
+        T * end,
+        ForwardIter first,
+        ForwardIter last,
+        std::ptrdiff_t n,
+        std::true_type)
+    {
+        // Relocating the tail is a memmove() that cannot throw, and it can be
+        // undone by relocating it back.
+        stl_interfaces::uninitialized_relocate_backward(pos, end, end + n);
+        undo_on_throw<Nothrow>::call(
+            [&] { std::uninitialized_copy(first, last, pos); },
+            [&] {
+                stl_interfaces::uninitialized_relocate(pos + n, end + n, pos);
+            });
+    }
+
+    template<bool Nothrow, typename T, typename ForwardIter>
+    void gap_insert_impl(
+        T * pos,
+        T * end,
+        ForwardIter first,
+        ForwardIter last,
+        std::ptrdiff_t n,
+        std::false_type)
+    {
+        auto const elements_after = end - pos;
+        if (n < elements_after) {
+            // The last n elements of the tail move into uninitialized
+            // storage past end, the rest of the tail move-assigns into
+            // elements that already exist, and so do the new elements.
+            T * const new_end = std::uninitialized_copy(
+                std::make_move_iterator(end - n),
+                std::make_move_iterator(end),
+                end);
+            undo_on_throw<Nothrow>::call(
+                [&] {
+                    std::move_backward(pos, end - n, end);
+                    std::copy(first, last, pos);
+                },
+                [&] { detail::destroy(end, new_end); });
+        } else {
+            // The new elements that land past end are constructed there
+            // directly, the whole tail moves into uninitialized storage after
+            // them, and the rest of the new elements are assigned over the
+            // old tail.
+            auto mid = first;
+            std::advance(mid, elements_after);
+            T * const tail_first = std::uninitialized_copy(mid, last, end);
+            T * new_end = tail_first;
+            undo_on_throw<Nothrow>::call(
+                [&] {
+                    new_end = std::uninitialized_copy(
+                        std::make_move_iterator(pos),
+                        std::make_move_iterator(end),
+                        tail_first);
+                    std::copy(first, mid, pos);
+                },
+                [&] { detail::destroy(end, new_end); });
+        }
+    }
+
+    // Inserts copies of the `n` elements of `[first, last)` before `pos`,
+    // where `[pos, end)` is the tail of an array with uninitialized storage
+    // for at least `n` more elements after `end`.  This is done in a single
+    // pass: each element of the tail is moved once, directly into its final
+    // position, and each new element is copy-constructed or copy-assigned
+    // once, directly into its final position.  No element is
+    // default-constructed.
+    //
+    // When `is_trivially_relocatable<T>` is true, the tail is relocated
+    // with `std::memmove()` instead.
+    // When `is_nothrow_insertable<T, reference>` is true, none of this can
+    // throw, and nothing is set up to undo it.
+    //
+    // Returns `pos`.  If an exception is thrown, no elements remain
+    // constructed past `end`.  If `T` is trivially relocatable, the
+    // insertion then has no effect; otherwise, the elements in `[pos, end)`
+    // are in a valid but unspecified state.
+    template<typename T, typename ForwardIter>
+    T * gap_insert(
+        T * pos,
+        T * end,
+        ForwardIter first,
+        ForwardIter last,
+        std::ptrdiff_t n)
+    {
+        if (n) {
+            detail::gap_insert_impl<is_nothrow_insertable<
+                T,
+                typename std::iterator_traits<ForwardIter>::reference>::
+                                        value>(
+                pos, end, first, last, n, is_trivially_relocatable<T>{});
+        }
+        return pos;
+    }
+
+}}}
+
+#endif
@@ -0,0 +1,405 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_DETAIL_SIMD_HPP
+#define BOOST_STL_INTERFACES_DETAIL_SIMD_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+
+// The kernels below are written with the GCC/Clang vector extensions, so
+// that one source compiles to SSE2 on x86-64, NEON on AArch64, and so on.
+// Elsewhere, or with BOOST_STL_INTERFACES_DISABLE_SIMD defined, they are
+// plain loops.
+#if defined(__GNUC__) && !defined(BOOST_STL_INTERFACES_DISABLE_SIMD)
+#define BOOST_STL_INTERFACES_SIMD_VECTORS
+#endif
+
+// On x86, each kernel is also compiled for AVX2 and AVX-512, and the widest
+// that the host supports is chosen at run time, so that one binary makes
+// full use of any x86-64 CPU.  BOOST_STL_INTERFACES_DISABLE_SIMD_DISPATCH
+// limits the kernels to the instruction set the build targets.
+#if defined(BOOST_STL_INTERFACES_SIMD_VECTORS) &&                             \
+    (defined(__x86_64__) || defined(__i386__)) &&                              \
+    !defined(BOOST_STL_INTERFACES_DISABLE_SIMD_DISPATCH)
+#define BOOST_STL_INTERFACES_SIMD_DISPATCH
+#endif
+
+
+namespace boost { namespace stl_interfaces { namespace detail {
+
+    template<std::size_t Size, bool Signed>
+    struct simd_int_lane;
+    template<>
+    struct simd_int_lane<1, true>
+    {
+        using type = std::int8_t;
+    };
+    template<>
+    struct simd_int_lane<1, false>
+    {
+        using type = std::uint8_t;
+    };
+    template<>
+    struct simd_int_lane<2, true>
+    {
+        using type = std::int16_t;
+    };
+    template<>
+    struct simd_int_lane<2, false>
+    {
+        using type = std::uint16_t;
+    };
+    template<>
+    struct simd_int_lane<4, true>
+    {
+        using type = std::int32_t;
+    };
+    template<>
+    struct simd_int_lane<4, false>
+    {
+        using type = std::uint32_t;
+    };
+    template<>
+    struct simd_int_lane<8, true>
+    {
+        using type = std::int64_t;
+    };
+    template<>
+    struct simd_int_lane<8, false>
+    {
+        using type = std::uint64_t;
+    };
+
+    template<typename T, bool Integral = std::is_integral<T>::value>
+    struct simd_lane
+    {
+    };
+    template<typename T>
+    struct simd_lane<T, true>
+        : simd_int_lane<sizeof(T), std::is_signed<T>::value>
+    {
+    };
+    template<>
+    struct simd_lane<bool, true>
+    {
+    };
+    template<>
+    struct simd_lane<float, false>
+    {
+        using type = float;
+    };
+    template<>
+    struct simd_lane<double, false>
+    {
+        using type = double;
+    };
+
+    // The fixed-width type that the kernels use for T's lanes.  Integers
+    // map to the std::intN_t or std::uintN_t of their size, so that char,
+    // long, etc. share kernels with their fixed-width twins.
+    template<typename T>
+    using simd_lane_t = typename simd_lane<T>::type;
+
+#ifdef BOOST_STL_INTERFACES_SIMD_VECTORS
+
+    template<typename L, std::size_t W>
+    struct simd_vector
+    {
+        typedef L type __attribute__((vector_size(W)));
+    };
+
+    template<typename L, std::size_t W>
+    using simd_vector_t = typename simd_vector<L, W>::type;
+    template<typename L, std::size_t W>
+    using simd_counter_t =
+        simd_vector_t<typename simd_int_lane<sizeof(L), false>::type, W>;
+
+}}}
+
+// The kernels, once for the instruction set the build targets, in
+// detail::simd_base, and on x86 again for AVX2 and AVX-512, in
+// detail::simd_avx2 and detail::simd_avx512.
+#define BOOST_STL_INTERFACES_SIMD_NS simd_base
+#define BOOST_STL_INTERFACES_SIMD_WIDTH 16
+#include <boost/stl_interfaces/detail/simd_kernels.hpp>
+#undef BOOST_STL_INTERFACES_SIMD_NS
+#undef BOOST_STL_INTERFACES_SIMD_WIDTH
+
+#ifdef BOOST_STL_INTERFACES_SIMD_DISPATCH
+
+#if defined(__clang__)
+#pragma clang attribute push(                                                  \
+    __attribute__((target("avx2"))), apply_to = function)
+#else
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+#define BOOST_STL_INTERFACES_SIMD_NS simd_avx2
+#define BOOST_STL_INTERFACES_SIMD_WIDTH 32
+#include <boost/stl_interfaces/detail/simd_kernels.hpp>
+#undef BOOST_STL_INTERFACES_SIMD_NS
+#undef BOOST_STL_INTERFACES_SIMD_WIDTH
+#if defined(__clang__)
+#pragma clang attribute pop
+#else
+#pragma GCC pop_options
+#endif
+
+#if defined(__clang__)
+#pragma clang attribute push(                                                  \
+    __attribute__((target("avx512f,avx512bw"))), apply_to = function)
+#else
+#pragma GCC push_options
+#pragma GCC target("avx512f,avx512bw")
+#endif
+#define BOOST_STL_INTERFACES_SIMD_NS simd_avx512
+#define BOOST_STL_INTERFACES_SIMD_WIDTH 64
+#include <boost/stl_interfaces/detail/simd_kernels.hpp>
+#undef BOOST_STL_INTERFACES_SIMD_NS
+#undef BOOST_STL_INTERFACES_SIMD_WIDTH
+#if defined(__clang__)
+#pragma clang attribute pop
+#else
+#pragma GCC pop_options
+#endif
+
+#endif
+
+namespace boost { namespace stl_interfaces { namespace detail {
+
+    // The instruction sets that the kernels are compiled for.
+    enum class simd_isa { base, avx2, avx512 };
+
+    // Returns the widest instruction set that both this build and the host
+    // CPU support.  The CPU is queried once, on first use.
+    inline simd_isa simd_host_isa() noexcept
+    {
+#ifdef BOOST_STL_INTERFACES_SIMD_DISPATCH
+        static simd_isa const isa = [] {
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx512bw"))
+                return simd_isa::avx512;
+            if (__builtin_cpu_supports("avx2"))
+                return simd_isa::avx2;
+            return simd_isa::base;
+        }();
+        return isa;
+#else
+        return simd_isa::base;
+#endif
+    }
+
+#ifdef BOOST_STL_INTERFACES_SIMD_DISPATCH
+
+    // Returns the one of base, avx2 and avx512 for the host's instruction
+    // set.  Each kernel below keeps its choice in a function-local static,
+    // so the host is only examined the first time a kernel is used, and
+    // every later call is one indirect call.
+    template<typename F>
+    F simd_select(F base, F avx2, F avx512) noexcept
+    {
+        switch (detail::simd_host_isa()) {
+        case simd_isa::avx512: return avx512;
+        case simd_isa::avx2: return avx2;
+        default: return base;
+        }
+    }
+
+    template<typename L, typename T>
+    std::size_t simd_find(T const * p, std::size_t n, T x) noexcept
+    {
+        static auto const impl = detail::simd_select(
+            &simd_base::find<L, T>,
+            &simd_avx2::find<L, T>,
+            &simd_avx512::find<L, T>);
+        return impl(p, n, x);
+    }
+
+    template<typename L, typename T>
+    std::size_t simd_find_last(T const * p, std::size_t n, T x) noexcept
+    {
+        static auto const impl = detail::simd_select(
+            &simd_base::find_last<L, T>,
+            &simd_avx2::find_last<L, T>,
+            &simd_avx512::find_last<L, T>);
+        return impl(p, n, x);
+    }
+
+    template<typename L, typename T>
+    std::size_t simd_count(T const * p, std::size_t n, T x) noexcept
+    {
+        static auto const impl = detail::simd_select(
+            &simd_base::count<L, T>,
+            &simd_avx2::count<L, T>,
+            &simd_avx512::count<L, T>);
+        return impl(p, n, x);
+    }
+
+    template<typename L, typename T>
+    std::size_t simd_mismatch(T const * a, T const * b, std::size_t n) noexcept
+    {
+        static auto const impl = detail::simd_select(
+            &simd_base::mismatch<L, T>,
+            &simd_avx2::mismatch<L, T>,
+            &simd_avx512::mismatch<L, T>);
+        return impl(a, b, n);
+    }
+
+    template<typename L, typename T>
+    void simd_reverse_copy(T const * p, std::size_t n, T * out) noexcept
+    {
+        static auto const impl = detail::simd_select(
+            &simd_base::reverse_copy<L, T>,
+            &simd_avx2::reverse_copy<L, T>,
+            &simd_avx512::reverse_copy<L, T>);
+        impl(p, n, out);
+    }
+
+    template<typename L, bool Max, typename T>
+    T simd_extremum(T const * p, std::size_t n) noexcept
+    {
+        static auto const impl = detail::simd_select(
+            &simd_base::extremum<L, Max, T>,
+            &simd_avx2::extremum<L, Max, T>,
+            &simd_avx512::extremum<L, Max, T>);
+        return impl(p, n);
+    }
+
+    template<typename L, bool Inclusive, typename T>
+    T simd_scan(T const * p, std::size_t n, T * out, T sum) noexcept
+    {
+        static auto const impl = detail::simd_select(
+            &simd_base::scan<L, Inclusive, T>,
+            &simd_avx2::scan<L, Inclusive, T>,
+            &simd_avx512::scan<L, Inclusive, T>);
+        return impl(p, n, out, sum);
+    }
+
+#else
+
+    template<typename L, typename T>
+    std::size_t simd_find(T const * p, std::size_t n, T x) noexcept
+    {
+        return simd_base::find<L>(p, n, x);
+    }
+
+    template<typename L, typename T>
+    std::size_t simd_find_last(T const * p, std::size_t n, T x) noexcept
+    {
+        return simd_base::find_last<L>(p, n, x);
+    }
+
+    template<typename L, typename T>
+    std::size_t simd_count(T const * p, std::size_t n, T x) noexcept
+    {
+        return simd_base::count<L>(p, n, x);
+    }
+
+    template<typename L, typename T>
+    std::size_t simd_mismatch(T const * a, T const * b, std::size_t n) noexcept
+    {
+        return simd_base::mismatch<L>(a, b, n);
+    }
+
+    template<typename L, typename T>
+    void simd_reverse_copy(T const * p, std::size_t n, T * out) noexcept
+    {
+        simd_base::reverse_copy<L>(p, n, out);
+    }
+
+    template<typename L, bool Max, typename T>
+    T simd_extremum(T const * p, std::size_t n) noexcept
+    {
+        return simd_base::extremum<L, Max>(p, n);
+    }
+
+    template<typename L, bool Inclusive, typename T>
+    T simd_scan(T const * p, std::size_t n, T * out, T sum) noexcept
+    {
+        return simd_base::scan<L, Inclusive>(p, n, out, sum);
+    }
+
+#endif
+
+#else
+
+    template<typename L, typename T>
+    std::size_t simd_find(T const * p, std::size_t n, T x) noexcept
+    {
+        std::size_t i = 0;
+        for (; i < n && !(p[i] == x); ++i) {
+        }
+        return i;
+    }
+
+    template<typename L, typename T>
+    std::size_t simd_find_last(T const * p, std::size_t n, T x) noexcept
+    {
+        std::size_t i = n;
+        for (; 0 < i && !(p[i - 1] == x); --i) {
+        }
+        return i;
+    }
+
+    template<typename L, typename T>
+    std::size_t simd_count(T const * p, std::size_t n, T x) noexcept
+    {
+        std::size_t retval = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            retval += p[i] == x;
+        }
+        return retval;
+    }
+
+    template<typename L, typename T>
+    std::size_t simd_mismatch(T const * a, T const * b, std::size_t n) noexcept
+    {
+        std::size_t i = 0;
+        for (; i < n && a[i] == b[i]; ++i) {
+        }
+        return i;
+    }
+
+    template<typename L, typename T>
+    void simd_reverse_copy(T const * p, std::size_t n, T * out) noexcept
+    {
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i] = p[n - 1 - i];
+        }
+    }
+
+    template<typename L, bool Max, typename T>
+    T simd_extremum(T const * p, std::size_t n) noexcept
+    {
+        T retval = p[0];
+        for (std::size_t i = 1; i < n; ++i) {
+            if (Max ? retval < p[i] : p[i] < retval)
+                retval = p[i];
+        }
+        return retval;
+    }
+
+    template<typename L, bool Inclusive, typename T>
+    T simd_scan(T const * p, std::size_t n, T * out, T sum) noexcept
+    {
+        L s = L(sum);
+        for (std::size_t i = 0; i < n; ++i) {
+            L const x = L(p[i]);
+            out[i] = T(Inclusive ? L(s + x) : s);
+            s += x;
+        }
+        return T(s);
+    }
+
+#endif
+
+}}}
+
+#endif
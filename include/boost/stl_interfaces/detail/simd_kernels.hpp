@@ -0,0 +1,363 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// No include guard: simd.hpp includes this file once per instruction set,
+// each time with BOOST_STL_INTERFACES_SIMD_NS naming the namespace for the
+// kernels, BOOST_STL_INTERFACES_SIMD_WIDTH giving their vector width in
+// bytes, and the matching target options in effect.
+
+namespace boost { namespace stl_interfaces { namespace detail {
+namespace BOOST_STL_INTERFACES_SIMD_NS {
+
+    constexpr std::size_t width = BOOST_STL_INTERFACES_SIMD_WIDTH;
+
+    // Vectors are passed by reference, since how a 32- or 64-byte vector
+    // is passed by value depends on the instruction set.
+    template<typename L, std::size_t W, typename T>
+    inline void load(simd_vector_t<L, W> & v, T const * p) noexcept
+    {
+        std::memcpy(&v, p, W);
+    }
+
+    // True if any lane of the comparison result m is set.
+    template<std::size_t W, typename Mask>
+    inline bool any(Mask const & m) noexcept
+    {
+        auto const words = (simd_vector_t<std::uint64_t, W>)m;
+        std::uint64_t retval = 0;
+        for (std::size_t i = 0; i < W / 8; ++i) {
+            retval |= words[i];
+        }
+        return retval != 0;
+    }
+
+    // Returns the index of the first W-byte block of [p, p + n) that
+    // holds x, or of the first element after the last whole block.  Four
+    // vectors are compared per test of the combined mask.
+    template<typename L, std::size_t W, typename T>
+    std::size_t find_blocks(T const * p, std::size_t n, T x) noexcept
+    {
+        constexpr std::size_t lanes = W / sizeof(T);
+        simd_vector_t<L, W> const xs = simd_vector_t<L, W>{} + L(x);
+        simd_vector_t<L, W> v0, v1, v2, v3;
+        std::size_t i = 0;
+        for (; i + 4 * lanes <= n; i += 4 * lanes) {
+            load<L, W>(v0, p + i);
+            load<L, W>(v1, p + i + lanes);
+            load<L, W>(v2, p + i + 2 * lanes);
+            load<L, W>(v3, p + i + 3 * lanes);
+            if (any<W>((v0 == xs) | (v1 == xs) | (v2 == xs) | (v3 == xs)))
+                break;
+        }
+        for (; i + lanes <= n; i += lanes) {
+            load<L, W>(v0, p + i);
+            if (any<W>(v0 == xs))
+                break;
+        }
+        return i;
+    }
+
+    // Returns the index of the first element of [p, p + n) equal to x, or
+    // n.
+    template<typename L, typename T>
+    std::size_t find(T const * p, std::size_t n, T x) noexcept
+    {
+        std::size_t i = find_blocks<L, width>(p, n, x);
+        if (16 < width)
+            i += find_blocks<L, 16>(p + i, n - i, x);
+        for (; i < n && !(p[i] == x); ++i) {
+        }
+        return i;
+    }
+
+    // Returns the index one past the last W-byte block at the end of
+    // [p, p + n) that holds x, working back from p + n, or the index at
+    // which fewer than a whole block remains.
+    template<typename L, std::size_t W, typename T>
+    std::size_t find_last_blocks(T const * p, std::size_t n, T x) noexcept
+    {
+        constexpr std::size_t lanes = W / sizeof(T);
+        simd_vector_t<L, W> const xs = simd_vector_t<L, W>{} + L(x);
+        simd_vector_t<L, W> v0, v1, v2, v3;
+        std::size_t i = n;
+        for (; 4 * lanes <= i; i -= 4 * lanes) {
+            load<L, W>(v0, p + i - 4 * lanes);
+            load<L, W>(v1, p + i - 3 * lanes);
+            load<L, W>(v2, p + i - 2 * lanes);
+            load<L, W>(v3, p + i - lanes);
+            if (any<W>((v0 == xs) | (v1 == xs) | (v2 == xs) | (v3 == xs)))
+                break;
+        }
+        for (; lanes <= i; i -= lanes) {
+            load<L, W>(v0, p + i - lanes);
+            if (any<W>(v0 == xs))
+                break;
+        }
+        return i;
+    }
+
+    // Returns the index one past the last element of [p, p + n) equal to
+    // x, or 0.
+    template<typename L, typename T>
+    std::size_t find_last(T const * p, std::size_t n, T x) noexcept
+    {
+        std::size_t i = find_last_blocks<L, width>(p, n, x);
+        if (16 < width)
+            i = find_last_blocks<L, 16>(p, i, x);
+        for (; 0 < i && !(p[i - 1] == x); --i) {
+        }
+        return i;
+    }
+
+    // Adds the number of elements equal to x in the whole W-byte blocks of
+    // [p, p + n) to count, and returns the number of elements in those
+    // blocks.  Matches are counted per lane, in lanes as wide as the
+    // elements, and flushed before those counters can wrap.
+    template<typename L, std::size_t W, typename T>
+    std::size_t count_blocks(
+        T const * p, std::size_t n, T x, std::size_t & count) noexcept
+    {
+        constexpr std::size_t lanes = W / sizeof(T);
+        constexpr std::size_t max_blocks =
+            sizeof(T) < 4 ? (std::size_t(1) << (8 * sizeof(T))) - 1
+                          : std::size_t(1) << 30;
+        using counter_t = simd_counter_t<L, W>;
+        simd_vector_t<L, W> const xs = simd_vector_t<L, W>{} + L(x);
+        simd_vector_t<L, W> v;
+        std::size_t i = 0;
+        while (i + lanes <= n) {
+            counter_t counts = {};
+            std::size_t blocks = (n - i) / lanes;
+            if (max_blocks < blocks)
+                blocks = max_blocks;
+            for (std::size_t b = 0; b < blocks; ++b, i += lanes) {
+                load<L, W>(v, p + i);
+                counts -= (counter_t)(v == xs);
+            }
+            for (std::size_t l = 0; l < lanes; ++l) {
+                count += std::size_t(counts[l]);
+            }
+        }
+        return i;
+    }
+
+    // Returns the number of elements of [p, p + n) equal to x.
+    template<typename L, typename T>
+    std::size_t count(T const * p, std::size_t n, T x) noexcept
+    {
+        std::size_t retval = 0;
+        std::size_t i = count_blocks<L, width>(p, n, x, retval);
+        if (16 < width)
+            i += count_blocks<L, 16>(p + i, n - i, x, retval);
+        for (; i < n; ++i) {
+            retval += p[i] == x;
+        }
+        return retval;
+    }
+
+    // Returns the index of the first W-byte block at which [a, a + n) and
+    // [b, b + n) differ, or of the first element after the last whole
+    // block.
+    template<typename L, std::size_t W, typename T>
+    std::size_t
+    mismatch_blocks(T const * a, T const * b, std::size_t n) noexcept
+    {
+        constexpr std::size_t lanes = W / sizeof(T);
+        simd_vector_t<L, W> a0, a1, b0, b1;
+        std::size_t i = 0;
+        for (; i + 2 * lanes <= n; i += 2 * lanes) {
+            load<L, W>(a0, a + i);
+            load<L, W>(b0, b + i);
+            load<L, W>(a1, a + i + lanes);
+            load<L, W>(b1, b + i + lanes);
+            if (any<W>((a0 != b0) | (a1 != b1)))
+                break;
+        }
+        for (; i + lanes <= n; i += lanes) {
+            load<L, W>(a0, a + i);
+            load<L, W>(b0, b + i);
+            if (any<W>(a0 != b0))
+                break;
+        }
+        return i;
+    }
+
+    // Returns the index of the first i at which a[i] != b[i], or n.
+    template<typename L, typename T>
+    std::size_t mismatch(T const * a, T const * b, std::size_t n) noexcept
+    {
+        std::size_t i = mismatch_blocks<L, width>(a, b, n);
+        if (16 < width)
+            i += mismatch_blocks<L, 16>(a + i, b + i, n - i);
+        for (; i < n && a[i] == b[i]; ++i) {
+        }
+        return i;
+    }
+
+    // Returns v with its lanes in reverse order.
+    template<typename L, std::size_t W, std::size_t... I>
+    inline simd_vector_t<L, W>
+    reversed(simd_vector_t<L, W> const & v, std::index_sequence<I...>) noexcept
+    {
+#if defined(__clang__)
+        return __builtin_shufflevector(v, v, (sizeof...(I) - 1 - I)...);
+#else
+        using index_t = typename simd_int_lane<sizeof(L), false>::type;
+        return __builtin_shuffle(
+            v, simd_counter_t<L, W>{index_t(sizeof...(I) - 1 - I)...});
+#endif
+    }
+
+    // Copies the whole W-byte blocks at the end of [p, p + n) to out, in
+    // reverse order, and returns the number of elements copied.
+    template<typename L, std::size_t W, typename T>
+    std::size_t
+    reverse_copy_blocks(T const * p, std::size_t n, T * out) noexcept
+    {
+        constexpr std::size_t lanes = W / sizeof(T);
+        simd_vector_t<L, W> v;
+        std::size_t i = 0;
+        for (; i + lanes <= n; i += lanes) {
+            load<L, W>(v, p + n - i - lanes);
+            v = reversed<L, W>(v, std::make_index_sequence<lanes>{});
+            std::memcpy(out + i, &v, W);
+        }
+        return i;
+    }
+
+    // Copies [p, p + n) to [out, out + n) in reverse order, so that
+    // out[i] = p[n - 1 - i].  The two must not overlap.
+    template<typename L, typename T>
+    void reverse_copy(T const * p, std::size_t n, T * out) noexcept
+    {
+        std::size_t i = reverse_copy_blocks<L, width>(p, n, out);
+        if (16 < width)
+            i += reverse_copy_blocks<L, 16>(p, n - i, out + i);
+        for (; i < n; ++i) {
+            out[i] = p[n - 1 - i];
+        }
+    }
+
+    // Folds the whole W-byte blocks of [p, p + n) into x, the least (if
+    // Max is false) or greatest value so far, and returns the number of
+    // elements in those blocks.
+    template<typename L, std::size_t W, bool Max, typename T>
+    std::size_t extremum_blocks(T const * p, std::size_t n, L & x) noexcept
+    {
+        constexpr std::size_t lanes = W / sizeof(T);
+        using vector_t = simd_vector_t<L, W>;
+        if (n < lanes)
+            return 0;
+        vector_t m, v;
+        load<L, W>(m, p);
+        std::size_t i = lanes;
+        for (; i + lanes <= n; i += lanes) {
+            load<L, W>(v, p + i);
+            // The lanes of v that are beyond those of m, and the rest of m.
+            vector_t const mask = (vector_t)(Max ? m < v : v < m);
+            m = (v & mask) | (m & ~mask);
+        }
+        for (std::size_t l = 0; l < lanes; ++l) {
+            if (Max ? x < m[l] : m[l] < x)
+                x = m[l];
+        }
+        return i;
+    }
+
+    // Returns the least (if Max is false) or greatest element of
+    // [p, p + n), for integral T and 0 < n.
+    template<typename L, bool Max, typename T>
+    T extremum(T const * p, std::size_t n) noexcept
+    {
+        L x = L(p[0]);
+        std::size_t i = extremum_blocks<L, width, Max>(p, n, x);
+        if (16 < width)
+            i += extremum_blocks<L, 16, Max>(p + i, n - i, x);
+        for (; i < n; ++i) {
+            if (Max ? x < L(p[i]) : L(p[i]) < x)
+                x = L(p[i]);
+        }
+        return T(x);
+    }
+
+    // Returns v with each lane moved K lanes up, and zeros in the lowest K
+    // lanes.
+    template<typename L, std::size_t W, std::size_t K, std::size_t... I>
+    inline simd_vector_t<L, W> shifted_up(
+        simd_vector_t<L, W> const & v, std::index_sequence<I...>) noexcept
+    {
+        constexpr std::size_t lanes = sizeof...(I);
+        simd_vector_t<L, W> const zero = {};
+#if defined(__clang__)
+        return __builtin_shufflevector(
+            v, zero, (I < K ? int(lanes) : int(I - K))...);
+#else
+        using index_t = typename simd_int_lane<sizeof(L), false>::type;
+        return __builtin_shuffle(
+            v, zero, simd_counter_t<L, W>{index_t(I < K ? lanes : I - K)...});
+#endif
+    }
+
+    // Returns the inclusive prefix sums of the lanes of v, in log2(lanes)
+    // shifts and adds.
+    template<typename L, std::size_t W, std::size_t K = 1>
+    inline simd_vector_t<L, W> lane_sums(simd_vector_t<L, W> v) noexcept
+    {
+        constexpr std::size_t lanes = W / sizeof(L);
+        v += shifted_up<L, W, K>(v, std::make_index_sequence<lanes>{});
+        return 2 * K < lanes ? lane_sums<L, W, (2 * K < lanes ? 2 * K : K)>(v)
+                             : v;
+    }
+
+    // Writes the running sums of the whole W-byte blocks of [p, p + n),
+    // starting from sum, to out -- each including its element if Inclusive
+    // is true, and excluding it otherwise -- and returns the number of
+    // elements in those blocks.  Lanes are unsigned integers, so that the
+    // sums wrap as the scalar ones would.
+    template<typename L, std::size_t W, bool Inclusive, typename T>
+    std::size_t
+    scan_blocks(T const * p, std::size_t n, T * out, L & sum) noexcept
+    {
+        constexpr std::size_t lanes = W / sizeof(T);
+        using vector_t = simd_vector_t<L, W>;
+        vector_t carry = vector_t{} + sum;
+        vector_t v;
+        std::size_t i = 0;
+        for (; i + lanes <= n; i += lanes) {
+            load<L, W>(v, p + i);
+            vector_t const sums = lane_sums<L, W>(v);
+            vector_t const result =
+                carry + (Inclusive ? sums
+                                   : shifted_up<L, W, 1>(
+                                         sums,
+                                         std::make_index_sequence<lanes>{}));
+            std::memcpy(out + i, &result, W);
+            carry += vector_t{} + sums[lanes - 1];
+        }
+        sum = carry[0];
+        return i;
+    }
+
+    // Writes the running sums of [p, p + n), starting from sum, to out,
+    // including each element if Inclusive is true, and returns the sum of
+    // all of them.  out may be p.
+    template<typename L, bool Inclusive, typename T>
+    T scan(T const * p, std::size_t n, T * out, T sum) noexcept
+    {
+        L s = L(sum);
+        std::size_t i = scan_blocks<L, width, Inclusive>(p, n, out, s);
+        if (16 < width)
+            i += scan_blocks<L, 16, Inclusive>(p + i, n - i, out + i, s);
+        for (; i < n; ++i) {
+            L const x = L(p[i]);
+            out[i] = T(Inclusive ? L(s + x) : s);
+            s += x;
+        }
+        return T(s);
+    }
+
+}
+}}}
@@ -0,0 +1,217 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_DOUBLE_BUFFER_HPP
+#define BOOST_STL_INTERFACES_DOUBLE_BUFFER_HPP
+
+#include <boost/stl_interfaces/view_interface.hpp>
+
+#include <boost/assert.hpp>
+
+#include <atomic>
+#include <thread>
+#include <utility>
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    namespace v1_dtl {
+        // The state of a double_buffer is one word: the index of the front
+        // buffer, and whether it holds a batch that the consumer has not
+        // read yet, and whether the consumer is reading it.
+        enum : unsigned int {
+            db_front = 1u,
+            db_ready = 2u,
+            db_reading = 4u
+        };
+
+        // Each buffer, and the state, get their own cache lines, so that
+        // the producer's writes to its buffer do not slow down the
+        // consumer's reads of the other.
+        template<typename C>
+        struct alignas(64) db_slot
+        {
+            C c;
+        };
+    }
+
+#endif
+
+    template<typename C>
+    struct double_buffer;
+
+    /** A view of the batch that the consumer of a `double_buffer` is
+        reading.  The producer cannot publish its next batch until the view
+        is destroyed, so a view should not be held longer than the
+        consumer's work on the batch.
+
+        The view can be moved, but not copied. */
+    template<typename C>
+    struct double_buffer_view : view_interface<double_buffer_view<C>>
+    {
+        using container_type = C;
+        using iterator = typename C::const_iterator;
+
+        double_buffer_view() noexcept = default;
+        double_buffer_view(double_buffer_view && other) noexcept :
+            batch_(std::exchange(other.batch_, nullptr)),
+            state_(std::exchange(other.state_, nullptr))
+        {}
+        double_buffer_view & operator=(double_buffer_view && other) noexcept
+        {
+            double_buffer_view temp(std::move(other));
+            std::swap(batch_, temp.batch_);
+            std::swap(state_, temp.state_);
+            return *this;
+        }
+        ~double_buffer_view()
+        {
+            if (state_) {
+                state_->fetch_and(
+                    ~v1_dtl::db_reading, std::memory_order_release);
+            }
+        }
+
+        iterator begin() const { return batch().begin(); }
+        iterator end() const { return batch().end(); }
+
+        /** Returns the batch.
+            \pre The view was not default constructed or moved from. */
+        C const & batch() const noexcept
+        {
+            BOOST_ASSERT(batch_);
+            return *batch_;
+        }
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+    private:
+        friend double_buffer<C>;
+
+        double_buffer_view(
+            C const * batch, std::atomic<unsigned int> * state) noexcept :
+            batch_(batch), state_(state)
+        {}
+
+        C const * batch_ = nullptr;
+        std::atomic<unsigned int> * state_ = nullptr;
+#endif
+    };
+
+    /** Two containers `C` -- `container_interface` containers, or any
+        others with `clear()` and `const_iterator`s -- that pass batches of
+        elements from one producer thread to one consumer thread without
+        copying them.  The producer fills the back buffer, and publishes
+        it; the consumer reads the published batch, in the front buffer,
+        through a `double_buffer_view`, while the producer fills the back
+        buffer with the next one.  Publishing swaps the buffers' roles with
+        one atomic compare-and-swap on a word that holds the index of the
+        front buffer and two flags; the elements stay where they are.
+
+        The producer may publish only when the consumer has read the last
+        batch and destroyed its view, so that the buffer that becomes the
+        back buffer is no longer being read; `publish()` waits for that,
+        and `read()` waits for a batch to be published.  Only one thread
+        may call the producer's members, `back_buffer()`, `can_publish()`
+        and `publish()`, and only one the consumer's, `ready()` and
+        `read()`. */
+    template<typename C>
+    struct double_buffer
+    {
+        using container_type = C;
+        using view_type = double_buffer_view<C>;
+
+        /** The back buffer is `back` and the front buffer, which is not
+            published, `front`, so that containers that allocate can be
+            given their capacity up front. */
+        explicit double_buffer(C back = C(), C front = C()) :
+            buffers_{{std::move(front)}, {std::move(back)}},
+            back_(1),
+            state_(0)
+        {}
+        double_buffer(double_buffer const &) = delete;
+        double_buffer & operator=(double_buffer const &) = delete;
+
+        /** Returns the back buffer, which the producer fills.  It is the
+            same buffer until the next `publish()`. */
+        C & back_buffer() noexcept { return buffers_[back_].c; }
+
+        /** Returns true if the consumer has read the last batch and
+            destroyed its view, so that `publish()` does not wait. */
+        bool can_publish() const noexcept
+        {
+            return !(
+                state_.load(std::memory_order_acquire) &
+                (v1_dtl::db_ready | v1_dtl::db_reading));
+        }
+
+        /** Publishes the back buffer for the consumer to read, and makes
+            the old front buffer, cleared, the back buffer.  Waits until the
+            consumer has read the last batch and destroyed its view. */
+        void publish()
+        {
+            unsigned int const idle = back_ ^ 1u;
+            unsigned int expected = idle;
+            while (!state_.compare_exchange_weak(
+                expected,
+                back_ | v1_dtl::db_ready,
+                std::memory_order_acq_rel,
+                std::memory_order_relaxed)) {
+                if (expected == idle)
+                    continue;
+                std::this_thread::yield();
+                expected = idle;
+            }
+            back_ = idle;
+            buffers_[back_].c.clear();
+        }
+
+        /** Returns true if a batch has been published that the consumer
+            has not read, so that `read()` does not wait. */
+        bool ready() const noexcept
+        {
+            return state_.load(std::memory_order_acquire) & v1_dtl::db_ready;
+        }
+
+        /** Returns a view of the published batch, which the producer
+            cannot publish over until the view is destroyed.  Waits for a
+            batch to be published, if none has been since the last
+            `read()`.
+            \pre The consumer has no other view of the `double_buffer`. */
+        view_type read() noexcept
+        {
+            unsigned int state = state_.load(std::memory_order_relaxed);
+            BOOST_ASSERT(!(state & v1_dtl::db_reading));
+            for (;;) {
+                if (state & v1_dtl::db_ready) {
+                    unsigned int const front = state & v1_dtl::db_front;
+                    if (state_.compare_exchange_weak(
+                            state,
+                            front | v1_dtl::db_reading,
+                            std::memory_order_acq_rel,
+                            std::memory_order_relaxed)) {
+                        return view_type(&buffers_[front].c, &state_);
+                    }
+                } else {
+                    std::this_thread::yield();
+                    state = state_.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+    private:
+        v1_dtl::db_slot<C> buffers_[2];
+        // Only the producer uses back_, and the front buffer is always the
+        // other one.
+        unsigned int back_;
+        alignas(64) std::atomic<unsigned int> state_;
+#endif
+    };
+
+}}}
+
+#endif
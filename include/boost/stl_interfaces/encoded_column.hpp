@@ -0,0 +1,396 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_ENCODED_COLUMN_HPP
+#define BOOST_STL_INTERFACES_ENCODED_COLUMN_HPP
+
+#include <boost/stl_interfaces/algorithm.hpp>
+#include <boost/stl_interfaces/iterator_interface.hpp>
+#include <boost/stl_interfaces/segmented_iterator.hpp>
+#include <boost/stl_interfaces/view_interface.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+    //[ dict_encoded_iterator
+    // An iterator over a dictionary-encoded column: an array of small integer
+    // codes, each the index of its value in an array of the distinct values.
+    // Dereferencing looks the value up, so it is a real T const &, into the
+    // dictionary; no decoded copy of the column exists.
+    template<typename T, typename Code>
+    struct dict_encoded_iterator : iterator_interface<
+                                       dict_encoded_iterator<T, Code>,
+                                       std::random_access_iterator_tag,
+                                       T,
+                                       T const &,
+                                       T const *>
+    {
+        dict_encoded_iterator() noexcept : dictionary_(nullptr), code_(nullptr)
+        {}
+        dict_encoded_iterator(
+            T const * dictionary, Code const * code) noexcept :
+            dictionary_(dictionary),
+            code_(code)
+        {}
+
+        T const & operator*() const noexcept { return dictionary_[*code_]; }
+        dict_encoded_iterator & operator+=(std::ptrdiff_t n) noexcept
+        {
+            code_ += n;
+            return *this;
+        }
+        friend std::ptrdiff_t
+        operator-(dict_encoded_iterator lhs, dict_encoded_iterator rhs) noexcept
+        {
+            return lhs.code_ - rhs.code_;
+        }
+
+        // The code this iterator refers to.
+        Code const * code() const noexcept { return code_; }
+
+    private:
+        friend access;
+
+        // The batch decode behind stl_interfaces::read_n(), which copy() and
+        // transform() from algorithm.hpp use: a gather loop over n codes,
+        // without an iterator in the way, that the compiler can unroll (or,
+        // for a T of four or eight bytes and a target with gathers, vectorize).
+        void read_n(std::ptrdiff_t n, T * out) const
+        {
+            for (std::ptrdiff_t i = 0; i < n; ++i) {
+                out[i] = dictionary_[code_[i]];
+            }
+        }
+
+        T const * dictionary_;
+        Code const * code_;
+    };
+    //]
+
+    //[ dict_encoded_view
+    // A view of a dictionary-encoded column.  It is a random access range of T,
+    // like the std::vector<T> it encodes, and takes sizeof(Code) bytes per
+    // element plus the dictionary.  codes() is contiguous, so a search for a
+    // value can find its code once and then search the codes, with the
+    // vectorized algorithms of algorithm.hpp.
+    template<typename T, typename Code>
+    struct dict_encoded_view : view_interface<dict_encoded_view<T, Code>>
+    {
+        using iterator = dict_encoded_iterator<T, Code>;
+
+        dict_encoded_view() noexcept :
+            dictionary_(nullptr), dictionary_size_(0), codes_(nullptr), size_(0)
+        {}
+        dict_encoded_view(
+            T const * dictionary,
+            std::size_t dictionary_size,
+            Code const * codes,
+            std::size_t size) noexcept :
+            dictionary_(dictionary),
+            dictionary_size_(dictionary_size),
+            codes_(codes),
+            size_(size)
+        {}
+
+        iterator begin() const noexcept
+        {
+            return iterator(dictionary_, codes_);
+        }
+        iterator end() const noexcept
+        {
+            return iterator(dictionary_, codes_ + size_);
+        }
+
+        // The distinct values, and the codes that index them.
+        T const * dictionary() const noexcept { return dictionary_; }
+        std::size_t dictionary_size() const noexcept
+        {
+            return dictionary_size_;
+        }
+        Code const * codes() const noexcept { return codes_; }
+
+        // Returns the code of x, or dictionary_size() if x is not in the
+        // column.  The dictionary is sorted.
+        std::size_t code_of(T const & x) const
+        {
+            auto const last = dictionary_ + dictionary_size_;
+            auto const it = std::lower_bound(dictionary_, last, x);
+            return it == last || x < *it ? dictionary_size_
+                                         : std::size_t(it - dictionary_);
+        }
+
+        // Returns the number of elements equal to x.  This is one dictionary
+        // lookup and a count over the codes.
+        std::ptrdiff_t count(T const & x) const
+        {
+            auto const code = code_of(x);
+            if (code == dictionary_size_)
+                return 0;
+            return stl_interfaces::count(
+                codes_, codes_ + size_, Code(code));
+        }
+
+    private:
+        T const * dictionary_;
+        std::size_t dictionary_size_;
+        Code const * codes_;
+        std::size_t size_;
+    };
+
+    // Owns the storage of a dictionary-encoded column.  The dictionary is the
+    // sorted distinct values, so a code order is the value order.
+    template<typename T, typename Code = std::uint16_t>
+    struct dict_encoded_column
+    {
+        static_assert(std::is_unsigned<Code>::value, "");
+
+        template<typename Iter>
+        dict_encoded_column(Iter first, Iter last)
+        {
+            std::map<T, std::size_t> codes;
+            for (auto it = first; it != last; ++it) {
+                codes.emplace(*it, 0);
+            }
+            if (std::size_t((std::numeric_limits<Code>::max)()) < codes.size())
+                throw std::length_error("Too many distinct values for Code.");
+            for (auto & code : codes) {
+                code.second = dictionary_.size();
+                dictionary_.push_back(code.first);
+            }
+            for (; first != last; ++first) {
+                codes_.push_back(Code(codes.find(*first)->second));
+            }
+        }
+
+        dict_encoded_view<T, Code> view() const noexcept
+        {
+            return dict_encoded_view<T, Code>(
+                dictionary_.data(),
+                dictionary_.size(),
+                codes_.data(),
+                codes_.size());
+        }
+
+    private:
+        std::vector<T> dictionary_;
+        std::vector<Code> codes_;
+    };
+    //]
+
+    //[ rle_iterator
+    // An iterator over the n copies of one value that make up a run of a
+    // run-length-encoded column.  This is rle_iterator's local iterator.
+    template<typename T>
+    struct run_iterator : iterator_interface<
+                              run_iterator<T>,
+                              std::random_access_iterator_tag,
+                              T,
+                              T const &,
+                              T const *>
+    {
+        run_iterator() noexcept : value_(nullptr), i_(0) {}
+        run_iterator(T const * value, std::ptrdiff_t i) noexcept :
+            value_(value),
+            i_(i)
+        {}
+
+        T const & operator*() const noexcept { return *value_; }
+        run_iterator & operator+=(std::ptrdiff_t n) noexcept
+        {
+            i_ += n;
+            return *this;
+        }
+        friend std::ptrdiff_t
+        operator-(run_iterator lhs, run_iterator rhs) noexcept
+        {
+            return lhs.i_ - rhs.i_;
+        }
+
+        // This iterator's position within its run.
+        std::ptrdiff_t index() const noexcept { return i_; }
+
+    private:
+        T const * value_;
+        std::ptrdiff_t i_;
+    };
+
+    // An iterator over a run-length-encoded column: an array of the runs'
+    // values, and an array of the positions at which the runs end.  It keeps
+    // its position and its run; moving within a run, or to the next one, is a
+    // comparison, and a longer jump is a binary search of the run ends.  Each
+    // run is a segment, in the sense of segmented_iterator.hpp, so the
+    // segmented algorithms work a run at a time, through run_iterators, without
+    // checking for run boundaries at every element.
+    template<typename T>
+    struct rle_iterator : iterator_interface<
+                              rle_iterator<T>,
+                              std::random_access_iterator_tag,
+                              T,
+                              T const &,
+                              T const *>
+    {
+        rle_iterator() noexcept :
+            values_(nullptr), ends_(nullptr), runs_(0), run_(0), i_(0)
+        {}
+        rle_iterator(
+            T const * values,
+            std::ptrdiff_t const * ends,
+            std::ptrdiff_t runs,
+            std::ptrdiff_t run,
+            std::ptrdiff_t i) noexcept :
+            values_(values), ends_(ends), runs_(runs), run_(run), i_(i)
+        {}
+
+        T const & operator*() const noexcept { return values_[run_]; }
+        rle_iterator & operator+=(std::ptrdiff_t n) noexcept
+        {
+            i_ += n;
+            if (run_ < runs_ && run_first(run_) <= i_ && i_ < ends_[run_])
+                return *this;
+            if (0 < n && run_ + 1 < runs_ && i_ < ends_[run_ + 1]) {
+                ++run_;
+                return *this;
+            }
+            run_ = std::upper_bound(ends_, ends_ + runs_, i_) - ends_;
+            return *this;
+        }
+        friend std::ptrdiff_t
+        operator-(rle_iterator lhs, rle_iterator rhs) noexcept
+        {
+            return lhs.i_ - rhs.i_;
+        }
+
+    private:
+        friend access;
+
+        std::ptrdiff_t run_first(std::ptrdiff_t run) const noexcept
+        {
+            return run ? ends_[run - 1] : 0;
+        }
+
+        std::ptrdiff_t segment() const noexcept { return run_; }
+        run_iterator<T> local() const noexcept
+        {
+            return run_iterator<T>(values_ + run_, i_ - run_first(run_));
+        }
+        run_iterator<T> local_begin(std::ptrdiff_t run) const noexcept
+        {
+            return run_iterator<T>(values_ + run, 0);
+        }
+        run_iterator<T> local_end(std::ptrdiff_t run) const noexcept
+        {
+            return run_iterator<T>(
+                values_ + run, run < runs_ ? ends_[run] - run_first(run) : 0);
+        }
+        rle_iterator compose(std::ptrdiff_t run, run_iterator<T> it) const
+            noexcept
+        {
+            return rle_iterator(
+                values_, ends_, runs_, run, run_first(run) + it.index());
+        }
+
+        // The batch decode behind stl_interfaces::read_n(): one std::fill_n()
+        // per run.
+        void read_n(std::ptrdiff_t n, T * out) const
+        {
+            for (auto run = run_, i = i_; 0 < n; ++run) {
+                auto const m = (std::min)(n, ends_[run] - i);
+                out = std::fill_n(out, m, values_[run]);
+                i += m;
+                n -= m;
+            }
+        }
+
+        T const * values_;
+        std::ptrdiff_t const * ends_;
+        std::ptrdiff_t runs_;
+        std::ptrdiff_t run_;
+        std::ptrdiff_t i_;
+    };
+    //]
+
+    //[ rle_view
+    // A view of a run-length-encoded column.  It is a random access range of
+    // T, and its runs are available directly, through run_count(),
+    // run_values(), and run_ends(), for algorithms that can take a run at a
+    // time, such as a sum.
+    template<typename T>
+    struct rle_view : view_interface<rle_view<T>>
+    {
+        using iterator = rle_iterator<T>;
+
+        rle_view() noexcept : values_(nullptr), ends_(nullptr), runs_(0) {}
+        rle_view(
+            T const * values,
+            std::ptrdiff_t const * ends,
+            std::ptrdiff_t runs) noexcept :
+            values_(values), ends_(ends), runs_(runs)
+        {}
+
+        iterator begin() const noexcept
+        {
+            return iterator(values_, ends_, runs_, 0, 0);
+        }
+        iterator end() const noexcept
+        {
+            return iterator(
+                values_, ends_, runs_, runs_, runs_ ? ends_[runs_ - 1] : 0);
+        }
+
+        std::ptrdiff_t run_count() const noexcept { return runs_; }
+        T const * run_values() const noexcept { return values_; }
+        std::ptrdiff_t const * run_ends() const noexcept { return ends_; }
+
+    private:
+        T const * values_;
+        std::ptrdiff_t const * ends_;
+        std::ptrdiff_t runs_;
+    };
+
+    // Owns the storage of a run-length-encoded column.
+    template<typename T>
+    struct rle_column
+    {
+        template<typename Iter>
+        rle_column(Iter first, Iter last)
+        {
+            std::ptrdiff_t i = 0;
+            for (; first != last; ++first, ++i) {
+                if (values_.empty() || !(values_.back() == *first)) {
+                    if (!values_.empty())
+                        ends_.push_back(i);
+                    values_.push_back(*first);
+                }
+            }
+            if (!values_.empty())
+                ends_.push_back(i);
+        }
+
+        rle_view<T> view() const noexcept
+        {
+            return rle_view<T>(
+                values_.data(), ends_.data(), std::ptrdiff_t(values_.size()));
+        }
+
+    private:
+        std::vector<T> values_;
+        std::vector<std::ptrdiff_t> ends_;
+    };
+    //]
+
+}}}
+
+#endif
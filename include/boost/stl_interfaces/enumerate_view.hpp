@@ -0,0 +1,210 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_ENUMERATE_VIEW_HPP
+#define BOOST_STL_INTERFACES_ENUMERATE_VIEW_HPP
+
+#include <boost/stl_interfaces/iterator_interface.hpp>
+#include <boost/stl_interfaces/view_interface.hpp>
+
+#include <utility>
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+    template<typename Iter, typename Enable = void>
+    struct enumerate_iterator;
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    namespace v1_dtl {
+        template<typename Iter>
+        using enumerate_ra = std::is_convertible<
+            typename std::iterator_traits<Iter>::iterator_category,
+            std::random_access_iterator_tag>;
+
+        template<typename Iter>
+        using enumerate_reference_t = std::pair<
+            iter_difference_t<Iter>,
+            typename std::iterator_traits<Iter>::reference>;
+
+        template<typename Iter>
+        using enumerate_value_t = std::pair<
+            iter_difference_t<Iter>,
+            typename std::iterator_traits<Iter>::value_type>;
+
+        // Without random access, the end's index is not known, so an
+        // enumerate_iterator can't go backward from it.
+        template<typename Iter>
+        using enumerate_category_t = std::conditional_t<
+            enumerate_ra<Iter>::value,
+            std::random_access_iterator_tag,
+            std::conditional_t<
+                std::is_convertible<
+                    typename std::iterator_traits<Iter>::iterator_category,
+                    std::forward_iterator_tag>::value,
+                std::forward_iterator_tag,
+                typename std::iterator_traits<Iter>::iterator_category>>;
+
+        template<typename Iter, typename Enable>
+        using enumerate_iterator_interface_t = proxy_iterator_interface<
+            enumerate_iterator<Iter, Enable>,
+            enumerate_category_t<Iter>,
+            enumerate_value_t<Iter>,
+            enumerate_reference_t<Iter>,
+            iter_difference_t<Iter>>;
+    }
+
+#endif
+
+    /** An iterator over the elements of a range together with their
+        indices, like the iterator of `std::views::enumerate`.  Its
+        reference is a `std::pair` of the index and the underlying
+        reference, so that `for (auto [i, x] : make_enumerate_view(r))`
+        visits each element `x` of `r` with its index `i`.
+
+        If `Iter` is random access, so is the iterator, and it holds the
+        start of the range and its position, and computes the index as the
+        difference of the two; incrementing it increments only the
+        underlying iterator, so a loop over it has one induction variable,
+        as a loop over `Iter` does, and vectorizes as well.  Otherwise, it
+        holds a count beside the underlying iterator, and is at most a
+        forward iterator.
+
+        \see `enumerate_view` */
+    template<typename Iter, typename Enable>
+    struct enumerate_iterator : v1_dtl::enumerate_iterator_interface_t<
+                                    Iter,
+                                    Enable>
+    {
+        using reference = v1_dtl::enumerate_reference_t<Iter>;
+        using difference_type = v1_dtl::iter_difference_t<Iter>;
+
+        constexpr enumerate_iterator() = default;
+        /** Constructs an iterator at `it`, whose index is `index`. */
+        constexpr enumerate_iterator(Iter it, difference_type index) :
+            it_(it),
+            index_(index)
+        {}
+
+        constexpr reference operator*() const
+        {
+            return reference(index_, *it_);
+        }
+        constexpr enumerate_iterator & operator++()
+        {
+            ++it_;
+            ++index_;
+            return *this;
+        }
+        friend constexpr bool operator==(
+            enumerate_iterator const & lhs, enumerate_iterator const & rhs)
+        {
+            return lhs.it_ == rhs.it_;
+        }
+
+        /** Returns the underlying iterator. */
+        constexpr Iter base() const { return it_; }
+        /** Returns the index of the current element. */
+        constexpr difference_type index() const noexcept { return index_; }
+
+        using base_type =
+            v1_dtl::enumerate_iterator_interface_t<Iter, Enable>;
+        using base_type::operator++;
+
+    private:
+        Iter it_ = Iter();
+        difference_type index_ = 0;
+    };
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    template<typename Iter>
+    struct enumerate_iterator<
+        Iter,
+        std::enable_if_t<v1_dtl::enumerate_ra<Iter>::value>>
+        : v1_dtl::enumerate_iterator_interface_t<
+              Iter,
+              std::enable_if_t<v1_dtl::enumerate_ra<Iter>::value>>
+    {
+        using reference = v1_dtl::enumerate_reference_t<Iter>;
+        using difference_type = v1_dtl::iter_difference_t<Iter>;
+
+        constexpr enumerate_iterator() = default;
+        constexpr enumerate_iterator(Iter it, difference_type index) :
+            first_(it - index),
+            it_(it)
+        {}
+
+        constexpr reference operator*() const
+        {
+            return reference(it_ - first_, *it_);
+        }
+        constexpr enumerate_iterator & operator+=(difference_type n)
+        {
+            it_ += n;
+            return *this;
+        }
+        friend constexpr difference_type operator-(
+            enumerate_iterator const & lhs, enumerate_iterator const & rhs)
+        {
+            return lhs.it_ - rhs.it_;
+        }
+
+        constexpr Iter base() const { return it_; }
+        constexpr difference_type index() const { return it_ - first_; }
+
+    private:
+        Iter first_ = Iter();
+        Iter it_ = Iter();
+    };
+
+#endif
+
+    /** A view of the elements of `[first, last)` together with their
+        indices, which start at `0`.  \see `enumerate_iterator` */
+    template<typename Iter>
+    struct enumerate_view : view_interface<enumerate_view<Iter>>
+    {
+        using iterator = enumerate_iterator<Iter>;
+
+        constexpr enumerate_view() = default;
+        constexpr enumerate_view(Iter first, Iter last) :
+            first_(first), last_(last)
+        {}
+
+        constexpr iterator begin() const { return iterator(first_, 0); }
+        constexpr iterator end() const
+        {
+            return end(v1_dtl::enumerate_ra<Iter>{});
+        }
+
+    private:
+        constexpr iterator end(std::true_type) const
+        {
+            return iterator(last_, last_ - first_);
+        }
+        // The end's index is never read, since the iterator is at most
+        // forward, and equality looks only at the underlying iterator.
+        constexpr iterator end(std::false_type) const
+        {
+            return iterator(last_, 0);
+        }
+
+        Iter first_;
+        Iter last_;
+    };
+
+    /** Returns an `enumerate_view` of the elements of `r`. */
+    template<typename Range>
+    constexpr auto make_enumerate_view(Range && r)
+    {
+        using iter = decltype(std::begin(r));
+        return enumerate_view<iter>(std::begin(r), std::end(r));
+    }
+
+}}}
+
+#endif
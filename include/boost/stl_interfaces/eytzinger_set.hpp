@@ -0,0 +1,339 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_EYTZINGER_SET_HPP
+#define BOOST_STL_INTERFACES_EYTZINGER_SET_HPP
+
+#include <boost/stl_interfaces/container_interface.hpp>
+#include <boost/stl_interfaces/iterator_interface.hpp>
+#include <boost/stl_interfaces/reverse_iterator.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <vector>
+
+#include <cstddef>
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+    // The elements of an eytzinger_set form an implicit, complete binary search
+    // tree, numbered from 1 in breadth-first order: the children of node k are
+    // nodes 2k and 2k + 1, and the parent of node k is node k / 2.  Node k is
+    // element k - 1 of the storage.  Node 0 does not exist, and stands for the
+    // end.
+    namespace eytzinger {
+        // The first node in order in the subtree rooted at k, in a tree of n
+        // nodes.
+        inline std::size_t leftmost(std::size_t k, std::size_t n) noexcept
+        {
+            while (2 * k <= n) {
+                k = 2 * k;
+            }
+            return k;
+        }
+        inline std::size_t rightmost(std::size_t k, std::size_t n) noexcept
+        {
+            while (2 * k + 1 <= n) {
+                k = 2 * k + 1;
+            }
+            return k;
+        }
+
+        // The node after k in order, or 0.
+        inline std::size_t next(std::size_t k, std::size_t n) noexcept
+        {
+            if (2 * k + 1 <= n)
+                return leftmost(2 * k + 1, n);
+            // Go up past every ancestor of which k is in the right subtree.
+            while (k & 1) {
+                k >>= 1;
+            }
+            return k >> 1;
+        }
+        // The node before k in order; the node before 0 is the last one.
+        inline std::size_t prev(std::size_t k, std::size_t n) noexcept
+        {
+            if (!k)
+                return rightmost(1, n);
+            if (2 * k <= n)
+                return rightmost(2 * k, n);
+            while (!(k & 1)) {
+                k >>= 1;
+            }
+            return k >> 1;
+        }
+
+        // A search descends from the root, going right (2k + 1) past every node
+        // that is before the key, and left (2k) otherwise, until it falls off
+        // the bottom.  The last node it went left from is the answer; it is
+        // found by undoing the trailing right turns (the trailing 1 bits of k),
+        // and then the one left turn.
+        inline std::size_t undo_right_turns(std::size_t k) noexcept
+        {
+#if defined(__GNUC__)
+            return k >> (__builtin_ctzll(~(unsigned long long)k) + 1);
+#else
+            while (k & 1) {
+                k >>= 1;
+            }
+            return k >> 1;
+#endif
+        }
+    }
+
+    //[ eytzinger_iterator
+    // Walks the implicit tree in order.  iterator_interface provides the
+    // postfix operators and operator!=().
+    template<typename T>
+    struct eytzinger_iterator : iterator_interface<
+                                    eytzinger_iterator<T>,
+                                    std::bidirectional_iterator_tag,
+                                    T,
+                                    T const &,
+                                    T const *>
+    {
+        eytzinger_iterator() noexcept : elements_(nullptr), size_(0), node_(0)
+        {}
+        eytzinger_iterator(
+            T const * elements, std::size_t size, std::size_t node) noexcept :
+            elements_(elements),
+            size_(size),
+            node_(node)
+        {}
+
+        T const & operator*() const noexcept { return elements_[node_ - 1]; }
+        eytzinger_iterator & operator++() noexcept
+        {
+            node_ = eytzinger::next(node_, size_);
+            return *this;
+        }
+        eytzinger_iterator & operator--() noexcept
+        {
+            node_ = eytzinger::prev(node_, size_);
+            return *this;
+        }
+        friend bool
+        operator==(eytzinger_iterator lhs, eytzinger_iterator rhs) noexcept
+        {
+            return lhs.node_ == rhs.node_;
+        }
+
+        // The node's index in breadth-first order, counting from 1; 0 for the
+        // end.
+        std::size_t node() const noexcept { return node_; }
+
+        using base_type = iterator_interface<
+            eytzinger_iterator<T>,
+            std::bidirectional_iterator_tag,
+            T,
+            T const &,
+            T const *>;
+        using base_type::operator++;
+        using base_type::operator--;
+
+    private:
+        T const * elements_;
+        std::size_t size_;
+        std::size_t node_;
+    };
+    //]
+
+    template<typename T, typename Compare>
+    struct eytzinger_set;
+
+    // The elements are in a std::vector, which destroys them; see flat_map.hpp.
+    template<typename T, typename Compare>
+    struct trivially_destructible_container<eytzinger_set<T, Compare>>
+        : std::true_type
+    {};
+
+    //[ eytzinger_set_defn
+    // A read-mostly sorted set, whose elements are stored in breadth-first
+    // order of the implicit search tree above, rather than in sorted order.
+    //
+    // A binary search over a sorted array touches elements far apart from each
+    // other until its last few steps, so each step is a likely cache miss.  In
+    // breadth-first order, the first few levels of the tree -- the elements
+    // every search touches -- share a few cache lines, and the 2^i candidates
+    // for the i-th step of a search are adjacent.  The search loop below has no
+    // branch on the comparison, so that it does not mispredict half the time;
+    // and since the next 16 descendants of node k are nodes 16k to 16k + 15,
+    // it can prefetch those four levels ahead.
+    //
+    // The set is built once from a range, in linear time once the range is
+    // sorted.  There is no element-wise insert() or erase(), since each would
+    // rebuild the whole layout.
+    template<typename T, typename Compare = std::less<T>>
+    struct eytzinger_set : container_interface<eytzinger_set<T, Compare>>
+    {
+        // types
+        using key_type = T;
+        using value_type = T;
+        using key_compare = Compare;
+        using reference = T const &;
+        using const_reference = T const &;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using iterator = eytzinger_iterator<T>;
+        using const_iterator = iterator;
+        using reverse_iterator = stl_interfaces::reverse_iterator<iterator>;
+        using const_reverse_iterator = reverse_iterator;
+
+        // construct/copy/destroy
+        eytzinger_set() : comp_() {}
+        explicit eytzinger_set(Compare const & comp) : comp_(comp) {}
+        template<
+            typename InputIterator,
+            typename Enable = std::enable_if_t<std::is_convertible<
+                typename std::iterator_traits<InputIterator>::iterator_category,
+                std::input_iterator_tag>::value>>
+        eytzinger_set(
+            InputIterator first,
+            InputIterator last,
+            Compare const & comp = Compare()) :
+            comp_(comp)
+        {
+            assign(first, last);
+        }
+        eytzinger_set(
+            std::initializer_list<T> il, Compare const & comp = Compare()) :
+            eytzinger_set(il.begin(), il.end(), comp)
+        {}
+
+        // Replaces the elements with the unique elements of [first, last).
+        template<
+            typename InputIterator,
+            typename Enable = std::enable_if_t<std::is_convertible<
+                typename std::iterator_traits<InputIterator>::iterator_category,
+                std::input_iterator_tag>::value>>
+        void assign(InputIterator first, InputIterator last)
+        {
+            std::vector<T> sorted(first, last);
+            std::sort(sorted.begin(), sorted.end(), comp_);
+            sorted.erase(
+                std::unique(
+                    sorted.begin(),
+                    sorted.end(),
+                    [this](T const & lhs, T const & rhs) {
+                        return !comp_(lhs, rhs);
+                    }),
+                sorted.end());
+            build(sorted);
+        }
+        void assign(std::initializer_list<T> il)
+        {
+            assign(il.begin(), il.end());
+        }
+
+        // iterators (2 members, skipped 10)
+        iterator begin() const noexcept
+        {
+            return make_iter(size() ? eytzinger::leftmost(1, size()) : 0);
+        }
+        iterator end() const noexcept { return make_iter(0); }
+
+        // capacity
+        size_type size() const noexcept { return elements_.size(); }
+        size_type max_size() const noexcept { return elements_.max_size(); }
+
+        // modifiers
+        void swap(eytzinger_set & other) noexcept
+        {
+            using std::swap;
+            elements_.swap(other.elements_);
+            swap(comp_, other.comp_);
+        }
+        friend void swap(eytzinger_set & lhs, eytzinger_set & rhs) noexcept
+        {
+            lhs.swap(rhs);
+        }
+        void clear() noexcept { elements_.clear(); }
+
+        // observers
+        key_compare key_comp() const { return comp_; }
+        // The elements, in breadth-first order.
+        std::vector<T> const & elements() const noexcept { return elements_; }
+
+        // set operations
+        iterator find(T const & x) const noexcept
+        {
+            auto const it = lower_bound(x);
+            return it == end() || comp_(x, *it) ? end() : it;
+        }
+        size_type count(T const & x) const noexcept { return contains(x); }
+        bool contains(T const & x) const noexcept { return find(x) != end(); }
+        iterator lower_bound(T const & x) const noexcept
+        {
+            return make_iter(search(x, [this](T const & e, T const & key) {
+                return comp_(e, key);
+            }));
+        }
+        iterator upper_bound(T const & x) const noexcept
+        {
+            return make_iter(search(x, [this](T const & e, T const & key) {
+                return !comp_(key, e);
+            }));
+        }
+        std::pair<iterator, iterator> equal_range(T const & x) const noexcept
+        {
+            auto const first = lower_bound(x);
+            auto last = first;
+            if (first != end() && !comp_(x, *first))
+                ++last;
+            return std::pair<iterator, iterator>(first, last);
+        }
+
+    private:
+        iterator make_iter(size_type node) const noexcept
+        {
+            return iterator(elements_.data(), size(), node);
+        }
+
+        // Returns the first node in order for which go_right() is false, or 0.
+        template<typename GoRight>
+        size_type search(T const & x, GoRight go_right) const noexcept
+        {
+            T const * const elements = elements_.data();
+            size_type const n = size();
+            size_type k = 1;
+            while (k <= n) {
+#if defined(__GNUC__)
+                __builtin_prefetch(elements + (16 * k - 1));
+#endif
+                k = 2 * k + size_type(go_right(elements[k - 1], x));
+            }
+            return eytzinger::undo_right_turns(k);
+        }
+
+        // Lays out the sorted elements, by numbering the nodes in order, and
+        // then copying each node's element in breadth-first order.
+        void build(std::vector<T> & sorted)
+        {
+            auto const n = sorted.size();
+            std::vector<size_type> positions(n);
+            auto k = n ? eytzinger::leftmost(1, n) : 0;
+            for (size_type i = 0; i < n; ++i) {
+                positions[k - 1] = i;
+                k = eytzinger::next(k, n);
+            }
+            std::vector<T> elements;
+            elements.reserve(n);
+            for (auto i : positions) {
+                elements.push_back(std::move(sorted[i]));
+            }
+            elements_.swap(elements);
+        }
+
+        std::vector<T> elements_;
+        Compare comp_;
+    };
+    //]
+
+}}}
+
+#endif
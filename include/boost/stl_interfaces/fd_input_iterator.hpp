@@ -0,0 +1,270 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_FD_INPUT_ITERATOR_HPP
+#define BOOST_STL_INTERFACES_FD_INPUT_ITERATOR_HPP
+
+#include <boost/stl_interfaces/iterator_interface.hpp>
+#include <boost/stl_interfaces/view_interface.hpp>
+
+#include <new>
+#include <system_error>
+#include <type_traits>
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+
+#include <unistd.h>
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+    //[ fd_block_defn
+    // A block of elements read by an fd_reader: a view of the reader's buffer,
+    // valid until the next read.
+    template<typename T>
+    struct fd_block : view_interface<fd_block<T>, element_layout::contiguous>
+    {
+        fd_block() noexcept : first_(nullptr), last_(nullptr) {}
+        fd_block(T const * first, T const * last) noexcept :
+            first_(first),
+            last_(last)
+        {}
+
+        T const * begin() const noexcept { return first_; }
+        T const * end() const noexcept { return last_; }
+
+    private:
+        T const * first_;
+        T const * last_;
+    };
+    //]
+
+    template<typename T>
+    struct fd_reader;
+
+    //[ fd_input_iterator
+    // An input iterator over the elements read from a file descriptor by an
+    // fd_reader.  Most increments just advance a pointer within the current
+    // block; the last one in a block reads the next block.  A default
+    // constructed iterator is the end.
+    template<typename T>
+    struct fd_input_iterator : iterator_interface<
+                                   fd_input_iterator<T>,
+                                   std::input_iterator_tag,
+                                   T,
+                                   T const &,
+                                   T const *>
+    {
+        fd_input_iterator() noexcept : reader_(nullptr), p_(nullptr) {}
+        explicit fd_input_iterator(fd_reader<T> & reader) :
+            reader_(&reader),
+            p_(reader.block().begin())
+        {
+            if (p_ == reader.block().end())
+                next_block();
+        }
+
+        T const & operator*() const noexcept { return *p_; }
+        fd_input_iterator & operator++()
+        {
+            if (++p_ == reader_->block().end())
+                next_block();
+            return *this;
+        }
+        friend bool
+        operator==(fd_input_iterator lhs, fd_input_iterator rhs) noexcept
+        {
+            return lhs.p_ == rhs.p_;
+        }
+
+        using base_type = iterator_interface<
+            fd_input_iterator<T>,
+            std::input_iterator_tag,
+            T,
+            T const &,
+            T const *>;
+        using base_type::operator++;
+
+    private:
+        void next_block()
+        {
+            if (reader_->read_block()) {
+                p_ = reader_->block().begin();
+            } else {
+                reader_ = nullptr;
+                p_ = nullptr;
+            }
+        }
+
+        fd_reader<T> * reader_;
+        T const * p_;
+    };
+    //]
+
+    //[ fd_block_iterator
+    // An input iterator over the blocks read by an fd_reader, for loops that
+    // process a whole block at a time.
+    template<typename T>
+    struct fd_block_iterator : proxy_iterator_interface<
+                                   fd_block_iterator<T>,
+                                   std::input_iterator_tag,
+                                   fd_block<T>>
+    {
+        fd_block_iterator() noexcept : reader_(nullptr) {}
+        explicit fd_block_iterator(fd_reader<T> & reader) : reader_(&reader)
+        {
+            if (reader.block().empty() && !reader.read_block())
+                reader_ = nullptr;
+        }
+
+        fd_block<T> operator*() const noexcept { return reader_->block(); }
+        fd_block_iterator & operator++()
+        {
+            if (!reader_->read_block())
+                reader_ = nullptr;
+            return *this;
+        }
+        friend bool
+        operator==(fd_block_iterator lhs, fd_block_iterator rhs) noexcept
+        {
+            return lhs.reader_ == rhs.reader_;
+        }
+
+        using base_type = proxy_iterator_interface<
+            fd_block_iterator<T>,
+            std::input_iterator_tag,
+            fd_block<T>>;
+        using base_type::operator++;
+
+    private:
+        fd_reader<T> * reader_;
+    };
+    //]
+
+    // The elements or the blocks of an fd_reader, as an input range.  Like any
+    // input range, it can be iterated only once.
+    template<typename Iterator>
+    struct fd_range : view_interface<fd_range<Iterator>>
+    {
+        explicit fd_range(Iterator first) : first_(first) {}
+
+        Iterator begin() const { return first_; }
+        Iterator end() const { return Iterator(); }
+
+    private:
+        Iterator first_;
+    };
+
+    //[ fd_reader_defn
+    // Reads elements of type T from a file descriptor, in blocks of at least
+    // block_size bytes each, into one page-aligned buffer that it owns.  The
+    // file descriptor may be a file, a pipe, or a socket; it is not closed by
+    // the reader.
+    //
+    // The elements are the bytes read, taken sizeof(T) at a time, so T must be
+    // trivially copyable.  A read that ends partway through an element keeps
+    // the element's first bytes, and the next read completes it.  Bytes left
+    // over at the end of the input, too few for an element, are not part of
+    // the elements; trailing_bytes() says how many there were.  Read errors are
+    // thrown as std::system_error.
+    template<typename T>
+    struct fd_reader
+    {
+        static_assert(
+            std::is_trivially_copyable<T>::value,
+            "The elements read by an fd_reader are the bytes of Ts.");
+
+        static constexpr std::size_t alignment = 4096;
+
+        explicit fd_reader(int fd, std::size_t block_size = 1 << 20) :
+            fd_(fd),
+            capacity_(round_up(block_size)),
+            buffer_(allocate(capacity_)),
+            size_(0),
+            tail_(0),
+            eof_(false)
+        {}
+        fd_reader(fd_reader const &) = delete;
+        fd_reader & operator=(fd_reader const &) = delete;
+        ~fd_reader() { std::free(buffer_); }
+
+        // The elements of the current block.
+        fd_block<T> block() const noexcept
+        {
+            auto const first = reinterpret_cast<T const *>(buffer_);
+            return fd_block<T>(first, first + size_);
+        }
+
+        // Replaces the current block with the next one, holding at least one
+        // element.  Returns false, with an empty block, at the end of the
+        // input.
+        bool read_block()
+        {
+            // The start of a partial element goes to the front of the buffer.
+            auto const leftover = tail_;
+            std::memmove(buffer_, buffer_ + size_ * sizeof(T), leftover);
+            std::size_t bytes = leftover;
+            while (!eof_ && bytes < sizeof(T)) {
+                auto const n = ::read(fd_, buffer_ + bytes, capacity_ - bytes);
+                if (n < 0) {
+                    if (errno == EINTR)
+                        continue;
+                    throw std::system_error(
+                        errno, std::generic_category(), "read");
+                }
+                eof_ = n == 0;
+                bytes += std::size_t(n);
+            }
+            size_ = bytes / sizeof(T);
+            tail_ = bytes % sizeof(T);
+            return size_ != 0;
+        }
+
+        // The number of bytes at the end of the input that did not make a whole
+        // element.  Only meaningful once the input has been read to the end.
+        std::size_t trailing_bytes() const noexcept { return tail_; }
+
+        fd_range<fd_input_iterator<T>> elements()
+        {
+            return fd_range<fd_input_iterator<T>>(fd_input_iterator<T>(*this));
+        }
+        fd_range<fd_block_iterator<T>> blocks()
+        {
+            return fd_range<fd_block_iterator<T>>(fd_block_iterator<T>(*this));
+        }
+
+    private:
+        // Rounds up to a multiple of both alignment and sizeof(T).
+        static std::size_t round_up(std::size_t n) noexcept
+        {
+            auto const unit = sizeof(T) % alignment == 0 ? sizeof(T)
+                              : alignment % sizeof(T) == 0
+                                  ? alignment
+                                  : alignment * sizeof(T);
+            return (n < unit ? unit : n + unit - 1) / unit * unit;
+        }
+        static unsigned char * allocate(std::size_t n)
+        {
+            void * p = nullptr;
+            if (::posix_memalign(&p, alignment, n) != 0)
+                throw std::bad_alloc();
+            return static_cast<unsigned char *>(p);
+        }
+
+        int fd_;
+        std::size_t capacity_;
+        unsigned char * buffer_;
+        std::size_t size_; // The number of elements in the current block.
+        std::size_t tail_; // The bytes of a partial element after them.
+        bool eof_;
+    };
+    //]
+
+}}}
+
+#endif
@@ -0,0 +1,519 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_FILTER_VIEW_HPP
+#define BOOST_STL_INTERFACES_FILTER_VIEW_HPP
+
+#include <boost/stl_interfaces/cached_view_interface.hpp>
+#include <boost/stl_interfaces/transform_view.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+
+#include <cstdint>
+#include <cstring>
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+    /** `std::true_type` if a `filter_iterator` over a contiguous range of
+        arithmetic values may evaluate `Pred` over a block of up to 64
+        elements at once, rather than one element at a time.  Block
+        evaluation calls the predicate on elements beyond the next match,
+        and on some elements more than once (around calls to
+        `operator--()`); so this must be `std::false_type` for predicates
+        with side effects, or that are too expensive to call ahead of time.
+
+        It is `std::true_type` for predicates that are trivially copy
+        constructible and destructible, such as lambdas that capture
+        thresholds or pointers, and `std::false_type` for everything else,
+        such as `std::function`.  Specialize it to override this. */
+    template<typename Pred>
+    struct is_block_filter_predicate
+        : std::integral_constant<
+              bool,
+              std::is_trivially_copy_constructible<Pred>::value &&
+                  std::is_trivially_destructible<Pred>::value>
+    {
+    };
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    namespace v1_dtl {
+        template<typename Iter>
+        using filter_category_t = std::conditional_t<
+            std::is_convertible<
+                typename std::iterator_traits<Iter>::iterator_category,
+                std::bidirectional_iterator_tag>::value,
+            std::bidirectional_iterator_tag,
+            typename std::iterator_traits<Iter>::iterator_category>;
+
+        template<typename Iter, typename Pred>
+        struct filter_blockwise : std::false_type
+        {
+        };
+        template<typename T, typename Pred>
+        struct filter_blockwise<T *, Pred>
+            : std::integral_constant<
+                  bool,
+                  std::is_arithmetic<T>::value &&
+                      is_block_filter_predicate<Pred>::value>
+        {
+        };
+
+        // The index of the lowest set bit.  m must not be 0.
+        inline int filter_lowest_bit(std::uint64_t m) noexcept
+        {
+#if defined(__GNUC__)
+            return __builtin_ctzll(m);
+#else
+            int retval = 0;
+            for (; !(m & 1); m >>= 1) {
+                ++retval;
+            }
+            return retval;
+#endif
+        }
+
+        constexpr std::ptrdiff_t filter_block_size = 64;
+
+        // Returns eight bytes, each 0 or 1, as the low eight bits of the
+        // result.  Each byte is gathered into the top byte of a product,
+        // bit i of which comes from byte i alone.
+        inline std::uint64_t filter_pack(unsigned char const * bytes) noexcept
+        {
+            std::uint64_t x = 0;
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+            for (int i = 0; i < 8; ++i) {
+                x |= std::uint64_t(bytes[i]) << (8 * i);
+            }
+#else
+            std::memcpy(&x, bytes, sizeof(x));
+#endif
+            return (x * 0x0102040810204080ull) >> 56;
+        }
+
+        // Returns the bits pred(p[i]) for i in [0, n), least significant
+        // first.  The predicate is evaluated into a byte per element first,
+        // a loop the compiler vectorizes for simple predicates, and the
+        // bytes are then packed eight at a time.
+        template<typename T, typename Pred>
+        std::uint64_t filter_block(T * p, std::ptrdiff_t n, Pred & pred)
+        {
+            unsigned char matches[filter_block_size];
+            if (n == filter_block_size) {
+                for (std::ptrdiff_t i = 0; i < filter_block_size; ++i) {
+                    matches[i] = pred(p[i]) ? 1 : 0;
+                }
+            } else {
+                std::fill(std::begin(matches), std::end(matches), 0);
+                for (std::ptrdiff_t i = 0; i < n; ++i) {
+                    matches[i] = pred(p[i]) ? 1 : 0;
+                }
+            }
+            std::uint64_t retval = 0;
+            for (int i = 0; i < filter_block_size; i += 8) {
+                retval |= v1_dtl::filter_pack(matches + i) << i;
+            }
+            return retval;
+        }
+
+        // The position of a filter iterator, and the operations that move
+        // it, one element at a time.  The end of the range and the
+        // predicate are passed to each operation, so that they may be kept
+        // in the iterator or in its view.
+        template<typename Iter, bool Blockwise>
+        struct filter_cursor
+        {
+            template<typename Pred>
+            constexpr void find(Iter it, Iter last, Pred & pred)
+            {
+                it_ = std::find_if(it, last, pred);
+            }
+            template<typename Pred>
+            constexpr void next(Iter last, Pred & pred)
+            {
+                it_ = std::find_if(std::next(it_), last, pred);
+            }
+            template<typename Pred>
+            constexpr void prev(Pred & pred)
+            {
+                do {
+                    --it_;
+                } while (!pred(*it_));
+            }
+
+            Iter it_ = Iter();
+        };
+
+        // The blockwise cursor evaluates the predicate over up to 64
+        // elements past it_ at a time.  It keeps the results for the
+        // ahead_ elements after it_ in mask_, the bit for it_ + 1 + i
+        // being bit i; and the next match is the lowest set bit.
+        template<typename T>
+        struct filter_cursor<T *, true>
+        {
+            template<typename Pred>
+            void find(T * p, T * last, Pred & pred)
+            {
+                while (p != last) {
+                    auto const n =
+                        (std::min)(filter_block_size, std::ptrdiff_t(last - p));
+                    auto const m = v1_dtl::filter_block(p, n, pred);
+                    if (m) {
+                        auto const i = v1_dtl::filter_lowest_bit(m);
+                        it_ = p + i;
+                        ahead_ = n - i - 1;
+                        mask_ = (m >> i) >> 1;
+                        return;
+                    }
+                    p += n;
+                }
+                it_ = last;
+                mask_ = 0;
+                ahead_ = 0;
+            }
+            template<typename Pred>
+            void next(T * last, Pred & pred)
+            {
+                if (mask_) {
+                    auto const i = v1_dtl::filter_lowest_bit(mask_);
+                    it_ += i + 1;
+                    ahead_ -= i + 1;
+                    mask_ = (mask_ >> i) >> 1;
+                } else {
+                    find(it_ + 1 + ahead_, last, pred);
+                }
+            }
+            template<typename Pred>
+            void prev(Pred & pred)
+            {
+                do {
+                    --it_;
+                } while (!pred(*it_));
+                mask_ = 0;
+                ahead_ = 0;
+            }
+
+            T * it_ = nullptr;
+            std::uint64_t mask_ = 0;
+            std::ptrdiff_t ahead_ = 0;
+        };
+
+        template<typename Iter, typename Pred>
+        using filter_cursor_t =
+            filter_cursor<Iter, filter_blockwise<Iter, Pred>::value>;
+    }
+
+#endif
+
+    /** An iterator over the elements of `[first, last)` for which `pred`
+        returns `true`.  It is bidirectional if `Iter` is, and otherwise has
+        the category of `Iter`.
+
+        When `Iter` is a pointer to an arithmetic type, and
+        `is_block_filter_predicate<Pred>` is true, the predicate is evaluated
+        over blocks of up to 64 elements at a time, into a bitmask; each
+        increment then finds the next set bit.  For simple predicates, the
+        compiler vectorizes the evaluation of each block, so sparse and dense
+        matches alike cost much less than one predicate call and branch per
+        element.  `make_filter_view()` uses pointers for contiguous ranges,
+        to get this for `std::vector`s and the like.
+
+        Each `filter_iterator` holds its own copy of `last` and `pred`; an
+        empty `pred` takes up no space.  The iterators of a `filter_view`
+        hold a pointer to the view instead.
+
+        \see `filter_view` */
+    template<typename Iter, typename Pred>
+    struct filter_iterator : iterator_interface<
+                                 filter_iterator<Iter, Pred>,
+                                 v1_dtl::filter_category_t<Iter>,
+                                 typename std::iterator_traits<Iter>::value_type,
+                                 typename std::iterator_traits<Iter>::reference,
+                                 typename std::iterator_traits<Iter>::pointer,
+                                 v1_dtl::iter_difference_t<Iter>>,
+                             private detail::functor_box<Pred>
+    {
+        using reference = typename std::iterator_traits<Iter>::reference;
+
+        constexpr filter_iterator() = default;
+        constexpr filter_iterator(Iter it, Iter last, Pred pred) :
+            detail::functor_box<Pred>(std::move(pred)),
+            last_(last)
+        {
+            cursor_.find(it, last_, this->get());
+        }
+
+        constexpr reference operator*() const { return *cursor_.it_; }
+        constexpr filter_iterator & operator++()
+        {
+            cursor_.next(last_, this->get());
+            return *this;
+        }
+        constexpr filter_iterator & operator--()
+        {
+            cursor_.prev(this->get());
+            return *this;
+        }
+        friend constexpr bool
+        operator==(filter_iterator const & lhs, filter_iterator const & rhs)
+        {
+            return lhs.cursor_.it_ == rhs.cursor_.it_;
+        }
+
+        /** Returns the underlying iterator. */
+        constexpr Iter base() const { return cursor_.it_; }
+
+        using base_type = iterator_interface<
+            filter_iterator<Iter, Pred>,
+            v1_dtl::filter_category_t<Iter>,
+            typename std::iterator_traits<Iter>::value_type,
+            reference,
+            typename std::iterator_traits<Iter>::pointer,
+            v1_dtl::iter_difference_t<Iter>>;
+        using base_type::operator++;
+        using base_type::operator--;
+
+    private:
+        v1_dtl::filter_cursor_t<Iter, Pred> cursor_;
+        Iter last_ = Iter();
+    };
+
+    template<typename Iter, typename Pred, typename F = identity>
+    struct filter_view;
+    template<typename Iter, typename Pred, typename F = identity>
+    struct filter_view_iterator;
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    namespace v1_dtl {
+        // The element types of a filter_view that applies F to the elements
+        // it keeps.  Without an F, they are those of Iter, so that proxy
+        // iterators keep their value types.
+        template<typename Iter, typename F>
+        struct filter_types
+        {
+            using reference = transform_reference_t<Iter, F>;
+            using value_type =
+                std::remove_cv_t<std::remove_reference_t<reference>>;
+            using pointer = transform_pointer_t<reference>;
+        };
+        template<typename Iter>
+        struct filter_types<Iter, identity>
+        {
+            using reference = typename std::iterator_traits<Iter>::reference;
+            using value_type = typename std::iterator_traits<Iter>::value_type;
+            using pointer = typename std::iterator_traits<Iter>::pointer;
+        };
+
+        template<typename Iter, typename Pred, typename F>
+        using filter_view_iterator_interface_t = iterator_interface<
+            filter_view_iterator<Iter, Pred, F>,
+            filter_category_t<Iter>,
+            typename filter_types<Iter, F>::value_type,
+            typename filter_types<Iter, F>::reference,
+            typename filter_types<Iter, F>::pointer,
+            iter_difference_t<Iter>>;
+    }
+
+#endif
+
+    /** The iterator of a `filter_view`.  It holds its position and a pointer
+        to the view, which holds the end of the range and the predicate, as
+        the iterator of `std::ranges::filter_view` does.  So it is the size of
+        two pointers, however large the predicate -- or four, when the
+        predicate is evaluated blockwise (see `filter_iterator`), to keep the
+        bitmask of the block -- and copying it never copies the predicate.
+        It is invalidated when the view is moved or destroyed.
+
+        Its elements are `f(x)` for the elements `x` that it visits, where
+        `f` is the view's `functor()`. */
+    template<typename Iter, typename Pred, typename F>
+    struct filter_view_iterator
+        : v1_dtl::filter_view_iterator_interface_t<Iter, Pred, F>
+    {
+        using reference =
+            typename v1_dtl::filter_types<Iter, F>::reference;
+
+        constexpr filter_view_iterator() = default;
+        constexpr filter_view_iterator(
+            filter_view<Iter, Pred, F> const & view, Iter it) :
+            view_(std::addressof(view))
+        {
+            cursor_.find(it, view_->last_, view_->pred_);
+        }
+
+        constexpr reference operator*() const
+        {
+            return view_->functor()(*cursor_.it_);
+        }
+        constexpr filter_view_iterator & operator++()
+        {
+            cursor_.next(view_->last_, view_->pred_);
+            return *this;
+        }
+        constexpr filter_view_iterator & operator--()
+        {
+            cursor_.prev(view_->pred_);
+            return *this;
+        }
+        friend constexpr bool operator==(
+            filter_view_iterator const & lhs, filter_view_iterator const & rhs)
+        {
+            return lhs.cursor_.it_ == rhs.cursor_.it_;
+        }
+
+        /** Returns the underlying iterator. */
+        constexpr Iter base() const { return cursor_.it_; }
+        /** Returns the view the iterator points into. */
+        constexpr filter_view<Iter, Pred, F> const & view() const noexcept
+        {
+            return *view_;
+        }
+
+        using base_type =
+            v1_dtl::filter_view_iterator_interface_t<Iter, Pred, F>;
+        using base_type::operator++;
+        using base_type::operator--;
+
+    private:
+        filter_view<Iter, Pred, F> const * view_ = nullptr;
+        v1_dtl::filter_cursor_t<Iter, Pred> cursor_;
+    };
+
+    /** A view of the elements of `[first, last)` for which `pred` returns
+        `true`, like `std::ranges::filter_view`.  Finding the first such
+        element takes linear time, so `begin()` is computed once, and cached
+        (see `cached_begin_view_interface`).
+
+        The view holds the predicate, and its iterators point to it (see
+        `filter_view_iterator`), so the predicate is called as a `Pred
+        const`.
+
+        If `F` is given, the elements of the view are `f(x)` for each element
+        `x` that `pred` keeps, as if the view were adapted by a
+        `transform_view`, but with one iterator instead of two nested ones.
+        The `filter()` and `transform()` range adaptors build such views (see
+        `range_adaptor_closure`).
+        \see `filter_iterator` */
+    template<typename Iter, typename Pred, typename F>
+    struct filter_view : cached_begin_view_interface<
+                             filter_view<Iter, Pred, F>,
+                             filter_view_iterator<Iter, Pred, F>>,
+                         private detail::functor_box<F>
+    {
+        using iterator = filter_view_iterator<Iter, Pred, F>;
+
+        constexpr filter_view(Iter first, Iter last, Pred pred, F f = F()) :
+            detail::functor_box<F>(std::move(f)),
+            first_(first),
+            last_(last),
+            pred_(std::move(pred))
+        {}
+
+        constexpr iterator end() const { return iterator(*this, last_); }
+
+        /** Returns the beginning of the underlying range. */
+        constexpr Iter base_begin() const { return first_; }
+        /** Returns the end of the underlying range. */
+        constexpr Iter base_end() const { return last_; }
+        constexpr Pred const & pred() const noexcept { return pred_; }
+        /** Returns the function applied to each element kept. */
+        constexpr F const & functor() const noexcept { return this->get(); }
+
+    private:
+        friend access;
+        friend iterator;
+
+        constexpr iterator uncached_begin() const
+        {
+            return iterator(*this, first_);
+        }
+
+        Iter first_;
+        Iter last_;
+        Pred pred_;
+    };
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    namespace v1_dtl {
+        template<typename Range>
+        using filter_data_t = decltype(std::declval<Range &>().data() +
+                                       std::declval<Range &>().size());
+
+        // A range with data() and size() members, like std::vector, or with
+        // iterators known to be contiguous, is filtered through pointers.
+        template<
+            typename Range,
+            bool Contiguous =
+                detail::detector<void, filter_data_t, Range>::value ||
+                is_contiguous_iterator<
+                    decltype(std::begin(std::declval<Range &>()))>::value>
+        struct filter_range
+        {
+            using iterator = decltype(std::begin(std::declval<Range &>()));
+            static constexpr iterator first(Range & r) { return std::begin(r); }
+            static constexpr iterator last(Range & r) { return std::end(r); }
+        };
+        template<typename Range>
+        struct filter_range<Range, true>
+        {
+            template<
+                typename R,
+                bool Data = detail::detector<void, filter_data_t, R>::value>
+            struct impl
+            {
+                static constexpr auto first(R & r)
+                {
+                    return stl_interfaces::to_address(std::begin(r));
+                }
+                static constexpr auto last(R & r)
+                {
+                    return stl_interfaces::to_address(std::end(r));
+                }
+            };
+            template<typename R>
+            struct impl<R, true>
+            {
+                static constexpr auto first(R & r) { return r.data(); }
+                static constexpr auto last(R & r)
+                {
+                    return r.data() + r.size();
+                }
+            };
+
+            using iterator =
+                decltype(impl<Range>::first(std::declval<Range &>()));
+            static constexpr iterator first(Range & r)
+            {
+                return impl<Range>::first(r);
+            }
+            static constexpr iterator last(Range & r)
+            {
+                return impl<Range>::last(r);
+            }
+        };
+    }
+
+#endif
+
+    /** Returns a `filter_view` of the elements of `r` for which `pred`
+        returns `true`.  If `r` is contiguous -- if it has `data()` and
+        `size()` members, or its iterators are contiguous -- the view is over
+        pointers. */
+    template<typename Range, typename Pred>
+    constexpr auto make_filter_view(Range && r, Pred pred)
+    {
+        using range = v1_dtl::filter_range<std::remove_reference_t<Range>>;
+        return filter_view<typename range::iterator, Pred>(
+            range::first(r), range::last(r), std::move(pred));
+    }
+
+}}}
+
+#endif
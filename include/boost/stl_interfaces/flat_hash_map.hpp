@@ -0,0 +1,773 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_FLAT_HASH_MAP_HPP
+#define BOOST_STL_INTERFACES_FLAT_HASH_MAP_HPP
+
+#include <boost/stl_interfaces/container_interface.hpp>
+#include <boost/stl_interfaces/trivially_relocatable.hpp>
+#include <boost/stl_interfaces/detail/relocate.hpp>
+#include <boost/stl_interfaces/detail/simd.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(BOOST_STL_INTERFACES_SIMD_VECTORS) && defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+    //[ hash_group
+    // A flat_hash_map has a control byte per slot: empty, deleted, or, for a
+    // full slot, 7 bits of the hash of its key.  The slots are in groups of
+    // 16, and each of these functions examines all 16 control bytes of a group
+    // at once, returning a bitmask with bit i set if byte i matches.  With the
+    // GCC/Clang vector extensions the bytes are compared as one vector; on x86
+    // the mask is then a single movemask instruction, and elsewhere it is
+    // packed eight bytes at a time with a multiply.
+    namespace hash_group {
+        constexpr std::size_t size = 16;
+
+        constexpr std::int8_t empty = -128;
+        constexpr std::int8_t deleted = -2;
+        // Follows the last group, so that iteration stops there.
+        constexpr std::int8_t sentinel = -1;
+
+#ifdef BOOST_STL_INTERFACES_SIMD_VECTORS
+        using bytes =
+            detail::simd_vector_t<std::int8_t, 16>;
+
+        inline bytes load(std::int8_t const * ctrl) noexcept
+        {
+            bytes retval;
+            std::memcpy(&retval, ctrl, sizeof(retval));
+            return retval;
+        }
+
+        // Each byte of m is 0 or -1.
+        inline std::uint32_t to_mask(bytes m) noexcept
+        {
+#if defined(__SSE2__)
+            return std::uint32_t(_mm_movemask_epi8((__m128i)m));
+#else
+            auto const words =
+                (detail::simd_vector_t<std::uint64_t, 16>)m;
+            std::uint32_t retval = 0;
+            for (int i = 0; i < 2; ++i) {
+                std::uint64_t const ones = words[i] & 0x0101010101010101ull;
+                retval |= std::uint32_t((ones * 0x0102040810204080ull) >> 56)
+                          << (8 * i);
+            }
+            return retval;
+#endif
+        }
+
+        inline std::uint32_t
+        match(std::int8_t const * ctrl, std::int8_t h2) noexcept
+        {
+            return to_mask((bytes)(load(ctrl) == h2));
+        }
+        inline std::uint32_t match_empty(std::int8_t const * ctrl) noexcept
+        {
+            return to_mask((bytes)(load(ctrl) == empty));
+        }
+        inline std::uint32_t
+        match_empty_or_deleted(std::int8_t const * ctrl) noexcept
+        {
+            return to_mask((bytes)(load(ctrl) < sentinel));
+        }
+#else
+        template<typename Pred>
+        std::uint32_t match_if(std::int8_t const * ctrl, Pred pred) noexcept
+        {
+            std::uint32_t retval = 0;
+            for (std::size_t i = 0; i < size; ++i) {
+                retval |= std::uint32_t(pred(ctrl[i])) << i;
+            }
+            return retval;
+        }
+
+        inline std::uint32_t
+        match(std::int8_t const * ctrl, std::int8_t h2) noexcept
+        {
+            return match_if(ctrl, [h2](std::int8_t c) { return c == h2; });
+        }
+        inline std::uint32_t match_empty(std::int8_t const * ctrl) noexcept
+        {
+            return match_if(ctrl, [](std::int8_t c) { return c == empty; });
+        }
+        inline std::uint32_t
+        match_empty_or_deleted(std::int8_t const * ctrl) noexcept
+        {
+            return match_if(ctrl, [](std::int8_t c) { return c < sentinel; });
+        }
+#endif
+
+        // The index of the lowest set bit.  m must not be 0.
+        inline int lowest_bit(std::uint32_t m) noexcept
+        {
+#if defined(__GNUC__)
+            return __builtin_ctz(m);
+#else
+            int retval = 0;
+            for (; !(m & 1); m >>= 1) {
+                ++retval;
+            }
+            return retval;
+#endif
+        }
+    }
+    //]
+
+    //[ flat_hash_map_iterator
+    // An iterator over the elements of a flat_hash_map: a pointer to a control
+    // byte, and one to the slot that goes with it.  Incrementing past an empty
+    // or deleted slot skips to the next full one a group of 16 control bytes at
+    // a time, rather than testing each slot in turn, so iterating a sparse
+    // table does not branch once per slot.  The control bytes end with a
+    // sentinel, which the skip stops at; that is end().
+    template<typename T>
+    struct flat_hash_map_iterator : iterator_interface<
+                                        flat_hash_map_iterator<T>,
+                                        std::forward_iterator_tag,
+                                        std::remove_const_t<T>,
+                                        T &,
+                                        T *>
+    {
+        flat_hash_map_iterator() noexcept : ctrl_(nullptr), slot_(nullptr) {}
+        template<
+            typename U,
+            typename E = std::enable_if_t<
+                std::is_same<T, U const>::value && !std::is_same<T, U>::value>>
+        flat_hash_map_iterator(flat_hash_map_iterator<U> other) noexcept :
+            ctrl_(other.ctrl_), slot_(other.slot_)
+        {}
+
+        T & operator*() const noexcept { return *slot_; }
+        flat_hash_map_iterator & operator++() noexcept
+        {
+            ++ctrl_;
+            ++slot_;
+            skip_empty();
+            return *this;
+        }
+        friend bool
+        operator==(
+            flat_hash_map_iterator lhs, flat_hash_map_iterator rhs) noexcept
+        {
+            return lhs.ctrl_ == rhs.ctrl_;
+        }
+
+        using base_type = iterator_interface<
+            flat_hash_map_iterator<T>,
+            std::forward_iterator_tag,
+            std::remove_const_t<T>,
+            T &,
+            T *>;
+        using base_type::operator++;
+
+    private:
+        template<typename U>
+        friend struct flat_hash_map_iterator;
+        template<typename K, typename V, typename Hash, typename KeyEqual>
+        friend struct flat_hash_map;
+
+        flat_hash_map_iterator(std::int8_t const * ctrl, T * slot) noexcept :
+            ctrl_(ctrl), slot_(slot)
+        {}
+
+        // Moves to the first full slot or the sentinel at or after *this.  A
+        // full slot right here is the common case in a dense table, so it is
+        // checked first, on its own.
+        void skip_empty() noexcept
+        {
+            if (hash_group::sentinel <= *ctrl_)
+                return;
+            for (;;) {
+                std::uint32_t const m =
+                    ~hash_group::match_empty_or_deleted(ctrl_) & 0xffff;
+                if (m) {
+                    auto const n = hash_group::lowest_bit(m);
+                    ctrl_ += n;
+                    slot_ += n;
+                    return;
+                }
+                ctrl_ += hash_group::size;
+                slot_ += hash_group::size;
+            }
+        }
+
+        std::int8_t const * ctrl_;
+        T * slot_;
+    };
+    //]
+
+    template<typename K, typename V, typename Hash, typename KeyEqual>
+    struct flat_hash_map;
+
+    // flat_hash_map destroys its elements itself, before its slots go away; see
+    // flat_map.hpp.
+    template<typename K, typename V, typename Hash, typename KeyEqual>
+    struct trivially_destructible_container<flat_hash_map<K, V, Hash, KeyEqual>>
+        : std::true_type
+    {};
+
+    //[ flat_hash_map_defn
+    // A std::unordered_map-like associative container that keeps its elements
+    // in one array of slots, with open addressing, after the design of Google's
+    // Swiss tables.  A key's hash picks a group of 16 slots to look in first,
+    // and 7 more bits of it are kept in the control byte of the slot the key
+    // goes in; a lookup compares those bytes for a whole group at once, and
+    // only compares keys for the slots whose bytes match -- usually just the
+    // one.  A group with an empty slot ends the search.  Erasing leaves a
+    // deleted marker, unless the slot's group has an empty slot already.  The
+    // table is rehashed when it would be more than 7/8 full, counting deleted
+    // slots.
+    //
+    // As with flat_map, the members of container_interface that do not involve
+    // positions mean the same thing here, and those that do are hidden by the
+    // associative versions below.  operator==() compares the elements without
+    // regard to order, as std::unordered_map's does, and there is no operator<.
+    // Inserting and rehashing invalidate all iterators; erasing invalidates
+    // only iterators to the erased elements.
+    template<
+        typename K,
+        typename V,
+        typename Hash = std::hash<K>,
+        typename KeyEqual = std::equal_to<K>>
+    struct flat_hash_map : container_interface<
+                               flat_hash_map<K, V, Hash, KeyEqual>>
+    {
+        // types
+        using key_type = K;
+        using mapped_type = V;
+        using value_type = std::pair<K const, V>;
+        using hasher = Hash;
+        using key_equal = KeyEqual;
+        using reference = value_type &;
+        using const_reference = value_type const &;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using iterator = flat_hash_map_iterator<value_type>;
+        using const_iterator = flat_hash_map_iterator<value_type const>;
+
+        // construct/copy/destroy
+        flat_hash_map() noexcept : flat_hash_map(Hash(), KeyEqual()) {}
+        explicit flat_hash_map(
+            Hash const & hash, KeyEqual const & eq = KeyEqual()) noexcept :
+            ctrl_(empty_table()),
+            slots_(nullptr),
+            size_(0),
+            capacity_(0),
+            growth_left_(0),
+            hash_(hash),
+            eq_(eq)
+        {}
+        template<
+            typename InputIterator,
+            typename Enable = std::enable_if_t<std::is_convertible<
+                typename std::iterator_traits<InputIterator>::iterator_category,
+                std::input_iterator_tag>::value>>
+        flat_hash_map(InputIterator first, InputIterator last) : flat_hash_map()
+        {
+            insert(first, last);
+        }
+        flat_hash_map(std::initializer_list<value_type> il) :
+            flat_hash_map(il.begin(), il.end())
+        {}
+        flat_hash_map(flat_hash_map const & other) :
+            flat_hash_map(other.hash_, other.eq_)
+        {
+            reserve(other.size());
+            insert(other.begin(), other.end());
+        }
+        flat_hash_map(flat_hash_map && other) noexcept :
+            flat_hash_map(other.hash_, other.eq_)
+        {
+            swap(other);
+        }
+        flat_hash_map & operator=(flat_hash_map const & other)
+        {
+            if (this != &other) {
+                flat_hash_map temp(other);
+                swap(temp);
+            }
+            return *this;
+        }
+        flat_hash_map & operator=(flat_hash_map && other) noexcept
+        {
+            flat_hash_map temp(std::move(other));
+            swap(temp);
+            return *this;
+        }
+        ~flat_hash_map()
+        {
+            clear();
+            free_table();
+        }
+
+        // iterators (2 members, skipped 4)
+        iterator begin() noexcept
+        {
+            iterator retval(ctrl_, slots_);
+            retval.skip_empty();
+            return retval;
+        }
+        iterator end() noexcept
+        {
+            return iterator(ctrl_ + capacity_, slots_ + capacity_);
+        }
+
+        // capacity
+        size_type size() const noexcept { return size_; }
+        size_type max_size() const noexcept
+        {
+            return (std::numeric_limits<difference_type>::max)() /
+                   (sizeof(value_type) + 1);
+        }
+        // The number of slots, full or not.
+        size_type capacity() const noexcept { return capacity_; }
+        // Makes room for n elements without a rehash.
+        void reserve(size_type n)
+        {
+            if (n <= size_ + growth_left_)
+                return;
+            size_type capacity = hash_group::size;
+            while (max_load(capacity) < n) {
+                capacity *= 2;
+            }
+            rehash(capacity);
+        }
+
+        // element access
+        V & operator[](K const & k) { return try_emplace(k).first->second; }
+        V & operator[](K && k)
+        {
+            return try_emplace(std::move(k)).first->second;
+        }
+        V & at(K const & k)
+        {
+            auto const it = find(k);
+            if (it == end())
+                throw std::out_of_range("flat_hash_map::at");
+            return it->second;
+        }
+        V const & at(K const & k) const
+        {
+            return const_cast<flat_hash_map &>(*this).at(k);
+        }
+
+        // modifiers
+        template<typename... Args>
+        std::pair<iterator, bool> emplace(Args &&... args)
+        {
+            std::pair<K, V> x(std::forward<Args>(args)...);
+            return try_emplace(std::move(x.first), std::move(x.second));
+        }
+        std::pair<iterator, bool> insert(value_type const & x)
+        {
+            return try_emplace(x.first, x.second);
+        }
+        std::pair<iterator, bool> insert(value_type && x)
+        {
+            return try_emplace(std::move(x.first), std::move(x.second));
+        }
+        template<
+            typename InputIterator,
+            typename Enable = std::enable_if_t<std::is_convertible<
+                typename std::iterator_traits<InputIterator>::iterator_category,
+                std::input_iterator_tag>::value>>
+        void insert(InputIterator first, InputIterator last)
+        {
+            for (; first != last; ++first) {
+                insert(*first);
+            }
+        }
+        void insert(std::initializer_list<value_type> il)
+        {
+            insert(il.begin(), il.end());
+        }
+        template<typename... Args>
+        std::pair<iterator, bool> try_emplace(K const & k, Args &&... args)
+        {
+            return try_emplace_impl(k, std::forward<Args>(args)...);
+        }
+        template<typename... Args>
+        std::pair<iterator, bool> try_emplace(K && k, Args &&... args)
+        {
+            return try_emplace_impl(std::move(k), std::forward<Args>(args)...);
+        }
+        template<typename M>
+        std::pair<iterator, bool> insert_or_assign(K const & k, M && obj)
+        {
+            auto const result = try_emplace(k, std::forward<M>(obj));
+            if (!result.second)
+                result.first->second = std::forward<M>(obj);
+            return result;
+        }
+
+        iterator erase(const_iterator pos) noexcept
+        {
+            auto const i = size_type(pos.slot_ - slots_);
+            erase_slot(i);
+            iterator retval(ctrl_ + i, slots_ + i);
+            retval.skip_empty();
+            return retval;
+        }
+        iterator erase(const_iterator first, const_iterator last) noexcept
+        {
+            while (first != last) {
+                first = erase(first);
+            }
+            auto const i = last.ctrl_ - ctrl_;
+            return iterator(ctrl_ + i, slots_ + i);
+        }
+        size_type erase(K const & k) noexcept
+        {
+            auto const it = find(k);
+            if (it == end())
+                return 0;
+            erase(it);
+            return 1;
+        }
+        void swap(flat_hash_map & other) noexcept
+        {
+            using std::swap;
+            swap(ctrl_, other.ctrl_);
+            swap(slots_, other.slots_);
+            swap(size_, other.size_);
+            swap(capacity_, other.capacity_);
+            swap(growth_left_, other.growth_left_);
+            swap(hash_, other.hash_);
+            swap(eq_, other.eq_);
+        }
+        friend void swap(flat_hash_map & lhs, flat_hash_map & rhs) noexcept
+        {
+            lhs.swap(rhs);
+        }
+        // Destroys the elements, and keeps the slots.
+        void clear() noexcept
+        {
+            for (size_type i = 0; i < capacity_; ++i) {
+                if (0 <= ctrl_[i])
+                    slots_[i].~value_type();
+            }
+            if (capacity_)
+                std::fill(ctrl_, ctrl_ + capacity_, hash_group::empty);
+            size_ = 0;
+            growth_left_ = max_load(capacity_);
+        }
+
+        // observers
+        hasher hash_function() const { return hash_; }
+        key_equal key_eq() const { return eq_; }
+
+        // map operations
+        iterator find(K const & k)
+        {
+            auto const i = find_index(k, hash(k));
+            return i == npos ? end() : iterator(ctrl_ + i, slots_ + i);
+        }
+        const_iterator find(K const & k) const
+        {
+            return const_cast<flat_hash_map &>(*this).find(k);
+        }
+        size_type count(K const & k) const { return contains(k); }
+        bool contains(K const & k) const { return find(k) != this->end(); }
+
+        // When Hash and KeyEqual are both transparent, the lookups also take
+        // any key that they can hash and compare with a K -- a std::string_view
+        // for std::string keys, say -- without making a K of it.  Hash must
+        // give such a key the same hash as the equal K.
+        template<
+            typename Key,
+            typename H = Hash,
+            typename E = KeyEqual,
+            typename Enable1 = typename H::is_transparent,
+            typename Enable2 = typename E::is_transparent>
+        iterator find(Key const & k)
+        {
+            auto const i = find_index(k, hash(k));
+            return i == npos ? end() : iterator(ctrl_ + i, slots_ + i);
+        }
+        template<
+            typename Key,
+            typename H = Hash,
+            typename E = KeyEqual,
+            typename Enable1 = typename H::is_transparent,
+            typename Enable2 = typename E::is_transparent>
+        const_iterator find(Key const & k) const
+        {
+            return const_cast<flat_hash_map &>(*this).find(k);
+        }
+        template<
+            typename Key,
+            typename H = Hash,
+            typename E = KeyEqual,
+            typename Enable1 = typename H::is_transparent,
+            typename Enable2 = typename E::is_transparent>
+        size_type count(Key const & k) const
+        {
+            return contains(k);
+        }
+        template<
+            typename Key,
+            typename H = Hash,
+            typename E = KeyEqual,
+            typename Enable1 = typename H::is_transparent,
+            typename Enable2 = typename E::is_transparent>
+        bool contains(Key const & k) const
+        {
+            return find(k) != this->end();
+        }
+
+        // The elements of equal maps may be in different orders.
+        friend bool
+        operator==(flat_hash_map const & lhs, flat_hash_map const & rhs)
+        {
+            if (lhs.size() != rhs.size())
+                return false;
+            for (auto const & x : lhs) {
+                auto const it = rhs.find(x.first);
+                if (it == rhs.end() || !(it->second == x.second))
+                    return false;
+            }
+            return true;
+        }
+        friend bool
+        operator<(flat_hash_map const &, flat_hash_map const &) = delete;
+
+        using base_type = container_interface<
+            flat_hash_map<K, V, Hash, KeyEqual>>;
+        using base_type::begin;
+        using base_type::end;
+
+    private:
+        static constexpr size_type npos = size_type(-1);
+
+        // The control bytes of a table with no slots: just a group of
+        // sentinels, so that begin() == end().
+        static std::int8_t * empty_table() noexcept
+        {
+            static std::int8_t sentinels[hash_group::size] = {
+                -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1};
+            return sentinels;
+        }
+
+        static size_type max_load(size_type capacity) noexcept
+        {
+            return capacity - capacity / 8;
+        }
+
+        // The hash is mixed, so that a weak hash, like std::hash<int>, which is
+        // the identity, still spreads the keys over the groups and the 7 bits.
+        template<typename Key>
+        std::uint64_t hash(Key const & k) const
+        {
+            std::uint64_t h = std::uint64_t(hash_(k)) * 0x9e3779b97f4a7c15ull;
+            return h ^ (h >> 32);
+        }
+        static std::int8_t h2(std::uint64_t h) noexcept
+        {
+            return std::int8_t(h & 0x7f);
+        }
+
+        // The probe sequence of h visits the groups in triangular steps, 1, 2,
+        // 3, ... groups apart, which reaches every group of a power-of-two
+        // count of them.
+        size_type group_mask() const noexcept
+        {
+            return capacity_ / hash_group::size - 1;
+        }
+
+        template<typename Key>
+        size_type find_index(Key const & k, std::uint64_t h) const
+        {
+            if (!capacity_)
+                return npos;
+            size_type const mask = group_mask();
+            size_type g = size_type(h >> 7) & mask;
+            for (size_type step = 1;; ++step) {
+                size_type const first = g * hash_group::size;
+                std::int8_t const * const ctrl = ctrl_ + first;
+                for (auto m = hash_group::match(ctrl, h2(h)); m; m &= m - 1) {
+                    auto const i = first + hash_group::lowest_bit(m);
+                    if (eq_(slots_[i].first, k))
+                        return i;
+                }
+                if (hash_group::match_empty(ctrl))
+                    return npos;
+                g = (g + step) & mask;
+            }
+        }
+        size_type find_free(std::uint64_t h) const noexcept
+        {
+            size_type const mask = group_mask();
+            size_type g = size_type(h >> 7) & mask;
+            for (size_type step = 1;; ++step) {
+                size_type const first = g * hash_group::size;
+                auto const m = hash_group::match_empty_or_deleted(
+                    ctrl_ + first);
+                if (m)
+                    return first + hash_group::lowest_bit(m);
+                g = (g + step) & mask;
+            }
+        }
+
+        template<typename Key, typename... Args>
+        std::pair<iterator, bool> try_emplace_impl(Key && k, Args &&... args)
+        {
+            auto const h = hash(k);
+            auto i = find_index(k, h);
+            if (i != npos)
+                return std::pair<iterator, bool>(
+                    iterator(ctrl_ + i, slots_ + i), false);
+            if (!growth_left_)
+                grow();
+            i = find_free(h);
+            ::new (static_cast<void *>(slots_ + i)) value_type(
+                std::piecewise_construct,
+                std::forward_as_tuple(std::forward<Key>(k)),
+                std::forward_as_tuple(std::forward<Args>(args)...));
+            if (ctrl_[i] == hash_group::empty)
+                --growth_left_;
+            ctrl_[i] = h2(h);
+            ++size_;
+            return std::pair<iterator, bool>(
+                iterator(ctrl_ + i, slots_ + i), true);
+        }
+
+        void erase_slot(size_type i) noexcept
+        {
+            slots_[i].~value_type();
+            --size_;
+            // A probe sequence that reaches this group ends here if the group
+            // has an empty slot, so this one may be empty too.
+            auto const group = ctrl_ + i / hash_group::size * hash_group::size;
+            if (hash_group::match_empty(group)) {
+                ctrl_[i] = hash_group::empty;
+                ++growth_left_;
+            } else {
+                ctrl_[i] = hash_group::deleted;
+            }
+        }
+
+        // Doubles the capacity, unless at least half the slots not in use are
+        // deleted rather than empty, in which case a rehash at the same
+        // capacity frees them.
+        void grow()
+        {
+            if (capacity_ && size_ <= max_load(capacity_) / 2)
+                rehash(capacity_);
+            else
+                rehash(capacity_ ? 2 * capacity_ : hash_group::size);
+        }
+
+        // Moves the elements into new_capacity slots.  If an element throws
+        // while being copied, *this is unchanged.
+        void rehash(size_type new_capacity)
+        {
+            flat_hash_map temp(hash_, eq_);
+            temp.allocate_table(new_capacity);
+            if (size_) {
+                transfer(
+                    temp,
+                    std::integral_constant<
+                        bool,
+                        is_trivially_relocatable<
+                            value_type>::value>{});
+            }
+            swap(temp);
+        }
+        void transfer(flat_hash_map & to, std::true_type) noexcept
+        {
+            for (size_type i = 0; i < capacity_; ++i) {
+                if (ctrl_[i] < 0)
+                    continue;
+                auto const h = hash(slots_[i].first);
+                auto const j = to.find_free(h);
+                stl_interfaces::uninitialized_relocate(
+                    slots_ + i, slots_ + i + 1, to.slots_ + j);
+                to.ctrl_[j] = h2(h);
+                ctrl_[i] = hash_group::empty;
+            }
+            to.size_ = size_;
+            to.growth_left_ -= size_;
+            size_ = 0;
+            growth_left_ = max_load(capacity_);
+        }
+        void transfer(flat_hash_map & to, std::false_type)
+        {
+            for (size_type i = 0; i < capacity_; ++i) {
+                if (ctrl_[i] < 0)
+                    continue;
+                auto const h = hash(slots_[i].first);
+                auto const j = to.find_free(h);
+                ::new (static_cast<void *>(to.slots_ + j))
+                    value_type(std::move_if_noexcept(slots_[i]));
+                to.ctrl_[j] = h2(h);
+                ++to.size_;
+                --to.growth_left_;
+            }
+        }
+
+        // Allocates capacity slots, and their control bytes, all empty, plus a
+        // group that starts with the sentinel.  Expects *this to have no
+        // table.
+        void allocate_table(size_type capacity)
+        {
+            auto const ctrl = std::allocator<std::int8_t>().allocate(
+                capacity + hash_group::size);
+            try {
+                slots_ = std::allocator<value_type>().allocate(capacity);
+            } catch (...) {
+                std::allocator<std::int8_t>().deallocate(
+                    ctrl, capacity + hash_group::size);
+                throw;
+            }
+            std::fill(ctrl, ctrl + capacity, hash_group::empty);
+            std::fill(
+                ctrl + capacity,
+                ctrl + capacity + hash_group::size,
+                hash_group::sentinel);
+            ctrl_ = ctrl;
+            capacity_ = capacity;
+            growth_left_ = max_load(capacity);
+        }
+        void free_table() noexcept
+        {
+            if (!capacity_)
+                return;
+            std::allocator<std::int8_t>().deallocate(
+                ctrl_, capacity_ + hash_group::size);
+            std::allocator<value_type>().deallocate(slots_, capacity_);
+        }
+
+        std::int8_t * ctrl_;
+        value_type * slots_;
+        size_type size_;
+        size_type capacity_;
+        // The number of empty slots that may be filled before a rehash.
+        size_type growth_left_;
+        Hash hash_;
+        KeyEqual eq_;
+    };
+    //]
+
+}}}
+
+#endif
@@ -0,0 +1,841 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_FLAT_MAP_HPP
+#define BOOST_STL_INTERFACES_FLAT_MAP_HPP
+
+#include <boost/stl_interfaces/container_interface.hpp>
+#include <boost/stl_interfaces/reverse_iterator.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+    // A tag that says that a sequence of elements is sorted by key, with no two
+    // equal keys.
+    struct sorted_unique_t
+    {};
+    constexpr sorted_unique_t sorted_unique{};
+
+    template<typename K, typename Compare>
+    struct flat_set;
+    template<typename K, typename V, typename Compare>
+    struct flat_map;
+
+    // The flat containers keep their elements in std::vectors, which destroy
+    // them, so container_interface's destructor does not need to clear() --
+    // and must not, since the vectors are gone by then.
+    template<typename K, typename Compare>
+    struct trivially_destructible_container<flat_set<K, Compare>>
+        : std::true_type
+    {};
+    template<typename K, typename V, typename Compare>
+    struct trivially_destructible_container<flat_map<K, V, Compare>>
+        : std::true_type
+    {};
+
+    //[ flat_map_iterator
+    // The keys and values of a flat_map are in separate arrays, so there is no
+    // std::pair<K, V> anywhere for a real reference to refer to.  Like the
+    // zip_proxy_iterator example, this iterator's reference type is instead a
+    // pair of references, std::pair<K const &, V &>.  V is const-qualified for
+    // const_iterator.
+    template<typename K, typename V>
+    struct flat_map_iterator : proxy_iterator_interface<
+                                   flat_map_iterator<K, V>,
+                                   std::random_access_iterator_tag,
+                                   std::pair<K, std::remove_const_t<V>>,
+                                   std::pair<K const &, V &>>
+    {
+        constexpr flat_map_iterator() noexcept :
+            keys_(nullptr), values_(nullptr)
+        {}
+        constexpr flat_map_iterator(K const * keys, V * values) noexcept :
+            keys_(keys),
+            values_(values)
+        {}
+        template<
+            typename U,
+            typename E = std::enable_if_t<
+                std::is_same<V, U const>::value && !std::is_same<V, U>::value>>
+        constexpr flat_map_iterator(flat_map_iterator<K, U> other) noexcept :
+            keys_(other.keys_),
+            values_(other.values_)
+        {}
+
+        constexpr std::pair<K const &, V &> operator*() const noexcept
+        {
+            return std::pair<K const &, V &>(*keys_, *values_);
+        }
+        constexpr flat_map_iterator & operator+=(std::ptrdiff_t n) noexcept
+        {
+            keys_ += n;
+            values_ += n;
+            return *this;
+        }
+        friend constexpr std::ptrdiff_t
+        operator-(flat_map_iterator lhs, flat_map_iterator rhs) noexcept
+        {
+            return lhs.keys_ - rhs.keys_;
+        }
+
+    private:
+        template<typename K2, typename V2>
+        friend struct flat_map_iterator;
+        template<typename K2, typename V2, typename Compare>
+        friend struct flat_map;
+
+        K const * keys_;
+        V * values_;
+    };
+    //]
+
+    //[ flat_map_defn
+    // A std::map-like associative container, whose elements are kept sorted by
+    // key in two std::vectors: one of keys, and one of values.  Lookups are
+    // binary searches over the dense array of keys, and never touch a value
+    // until they find the right one.  Insertions and erasures in the middle are
+    // linear, as for std::vector; so insert() of a range builds the new arrays
+    // in one linear merge.
+    //
+    // container_interface supports only the sequence container requirements,
+    // but most of those that do not involve positions -- empty(), cbegin(),
+    // rbegin(), the comparisons, and so on -- mean the same thing for an
+    // associative container.  The ones that do involve positions are hidden by
+    // the associative versions below (operator[](), at(), insert(), and
+    // erase()).
+    template<typename K, typename V, typename Compare = std::less<K>>
+    struct flat_map : container_interface<flat_map<K, V, Compare>>
+    {
+        // types
+        using key_type = K;
+        using mapped_type = V;
+        using value_type = std::pair<K, V>;
+        using key_compare = Compare;
+        using reference = std::pair<K const &, V &>;
+        using const_reference = std::pair<K const &, V const &>;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using iterator = flat_map_iterator<K, V>;
+        using const_iterator = flat_map_iterator<K, V const>;
+        using reverse_iterator = stl_interfaces::reverse_iterator<iterator>;
+        using const_reverse_iterator =
+            stl_interfaces::reverse_iterator<const_iterator>;
+        using key_container_type = std::vector<K>;
+        using mapped_container_type = std::vector<V>;
+
+        // construct/copy/destroy
+        flat_map() : comp_() {}
+        explicit flat_map(Compare const & comp) : comp_(comp) {}
+        template<
+            typename InputIterator,
+            typename Enable = std::enable_if_t<std::is_convertible<
+                typename std::iterator_traits<InputIterator>::iterator_category,
+                std::input_iterator_tag>::value>>
+        flat_map(
+            InputIterator first,
+            InputIterator last,
+            Compare const & comp = Compare()) :
+            comp_(comp)
+        {
+            insert(first, last);
+        }
+        template<
+            typename InputIterator,
+            typename Enable = std::enable_if_t<std::is_convertible<
+                typename std::iterator_traits<InputIterator>::iterator_category,
+                std::input_iterator_tag>::value>>
+        flat_map(
+            sorted_unique_t,
+            InputIterator first,
+            InputIterator last,
+            Compare const & comp = Compare()) :
+            comp_(comp)
+        {
+            insert(sorted_unique, first, last);
+        }
+        flat_map(
+            std::initializer_list<value_type> il,
+            Compare const & comp = Compare()) :
+            flat_map(il.begin(), il.end(), comp)
+        {}
+
+        // iterators (2 members, skipped 10)
+        iterator begin() noexcept
+        {
+            return iterator(keys_.data(), values_.data());
+        }
+        iterator end() noexcept { return begin() + size(); }
+
+        // capacity
+        size_type size() const noexcept { return keys_.size(); }
+        size_type max_size() const noexcept
+        {
+            return (std::min)(keys_.max_size(), values_.max_size());
+        }
+        void reserve(size_type n)
+        {
+            keys_.reserve(n);
+            values_.reserve(n);
+        }
+
+        // element access
+        V & operator[](K const & k) { return (*try_emplace(k).first).second; }
+        V & operator[](K && k)
+        {
+            return (*try_emplace(std::move(k)).first).second;
+        }
+        V & at(K const & k)
+        {
+            auto const it = find(k);
+            if (it == end())
+                throw std::out_of_range("flat_map::at");
+            return (*it).second;
+        }
+        V const & at(K const & k) const
+        {
+            return const_cast<flat_map &>(*this).at(k);
+        }
+
+        // modifiers
+        template<typename... Args>
+        std::pair<iterator, bool> emplace(Args &&... args)
+        {
+            value_type x(std::forward<Args>(args)...);
+            return try_emplace(std::move(x.first), std::move(x.second));
+        }
+        std::pair<iterator, bool> insert(value_type const & x)
+        {
+            return try_emplace(x.first, x.second);
+        }
+        std::pair<iterator, bool> insert(value_type && x)
+        {
+            return try_emplace(std::move(x.first), std::move(x.second));
+        }
+        // Inserts the elements of [first, last) whose keys are not already in
+        // *this, and, for equal keys within [first, last), only the first.  The
+        // new elements are sorted on their own, and then merged with the
+        // existing ones in linear time.
+        template<
+            typename InputIterator,
+            typename Enable = std::enable_if_t<std::is_convertible<
+                typename std::iterator_traits<InputIterator>::iterator_category,
+                std::input_iterator_tag>::value>>
+        void insert(InputIterator first, InputIterator last)
+        {
+            std::vector<value_type> elements(first, last);
+            std::stable_sort(
+                elements.begin(),
+                elements.end(),
+                [this](value_type const & lhs, value_type const & rhs) {
+                    return comp_(lhs.first, rhs.first);
+                });
+            auto const unique_end = std::unique(
+                elements.begin(),
+                elements.end(),
+                [this](value_type const & lhs, value_type const & rhs) {
+                    return !comp_(lhs.first, rhs.first);
+                });
+            merge(
+                std::make_move_iterator(elements.begin()),
+                std::make_move_iterator(unique_end));
+        }
+        // Like insert(first, last), except that [first, last) must already be
+        // sorted, with no two equal keys, so it is merged directly.
+        template<
+            typename InputIterator,
+            typename Enable = std::enable_if_t<std::is_convertible<
+                typename std::iterator_traits<InputIterator>::iterator_category,
+                std::input_iterator_tag>::value>>
+        void insert(sorted_unique_t, InputIterator first, InputIterator last)
+        {
+            merge(first, last);
+        }
+        void insert(std::initializer_list<value_type> il)
+        {
+            insert(il.begin(), il.end());
+        }
+        template<typename... Args>
+        std::pair<iterator, bool> try_emplace(K const & k, Args &&... args)
+        {
+            return try_emplace_impl(k, std::forward<Args>(args)...);
+        }
+        template<typename... Args>
+        std::pair<iterator, bool> try_emplace(K && k, Args &&... args)
+        {
+            return try_emplace_impl(std::move(k), std::forward<Args>(args)...);
+        }
+        template<typename M>
+        std::pair<iterator, bool> insert_or_assign(K const & k, M && obj)
+        {
+            auto const result = try_emplace(k, std::forward<M>(obj));
+            if (!result.second)
+                (*result.first).second = std::forward<M>(obj);
+            return result;
+        }
+
+        iterator erase(const_iterator pos)
+        {
+            return erase(pos, std::next(pos));
+        }
+        iterator erase(const_iterator first, const_iterator last)
+        {
+            auto const i = index(first);
+            auto const j = index(last);
+            keys_.erase(keys_.begin() + i, keys_.begin() + j);
+            values_.erase(values_.begin() + i, values_.begin() + j);
+            return begin() + i;
+        }
+        size_type erase(K const & k)
+        {
+            auto const it = find(k);
+            if (it == end())
+                return 0;
+            erase(it);
+            return 1;
+        }
+        void swap(flat_map & other) noexcept
+        {
+            using std::swap;
+            keys_.swap(other.keys_);
+            values_.swap(other.values_);
+            swap(comp_, other.comp_);
+        }
+        friend void swap(flat_map & lhs, flat_map & rhs) noexcept
+        {
+            lhs.swap(rhs);
+        }
+        void clear() noexcept
+        {
+            keys_.clear();
+            values_.clear();
+        }
+
+        // observers
+        key_compare key_comp() const { return comp_; }
+        key_container_type const & keys() const noexcept { return keys_; }
+        mapped_container_type const & values() const noexcept
+        {
+            return values_;
+        }
+
+        // map operations
+        iterator find(K const & k) { return find_impl(k); }
+        const_iterator find(K const & k) const
+        {
+            return const_cast<flat_map &>(*this).find(k);
+        }
+        size_type count(K const & k) const { return contains(k); }
+        bool contains(K const & k) const { return find(k) != this->end(); }
+        iterator lower_bound(K const & k)
+        {
+            return begin() + lower_index(k);
+        }
+        const_iterator lower_bound(K const & k) const
+        {
+            return const_cast<flat_map &>(*this).lower_bound(k);
+        }
+        iterator upper_bound(K const & k)
+        {
+            return begin() + upper_index(k);
+        }
+        const_iterator upper_bound(K const & k) const
+        {
+            return const_cast<flat_map &>(*this).upper_bound(k);
+        }
+        std::pair<iterator, iterator> equal_range(K const & k)
+        {
+            auto const first = lower_bound(k);
+            auto const last =
+                first == end() || comp_(k, (*first).first) ? first : first + 1;
+            return std::pair<iterator, iterator>(first, last);
+        }
+        std::pair<const_iterator, const_iterator> equal_range(K const & k) const
+        {
+            auto const result = const_cast<flat_map &>(*this).equal_range(k);
+            return std::pair<const_iterator, const_iterator>(
+                result.first, result.second);
+        }
+
+        // When Compare is transparent, as std::less<> is, the lookups also take
+        // any key that Compare can compare with a K -- a std::string_view or a
+        // char const * for std::string keys, say -- without making a K of it.
+        template<
+            typename Key,
+            typename C = Compare,
+            typename Enable = typename C::is_transparent>
+        iterator find(Key const & k)
+        {
+            return find_impl(k);
+        }
+        template<
+            typename Key,
+            typename C = Compare,
+            typename Enable = typename C::is_transparent>
+        const_iterator find(Key const & k) const
+        {
+            return const_cast<flat_map &>(*this).find_impl(k);
+        }
+        template<
+            typename Key,
+            typename C = Compare,
+            typename Enable = typename C::is_transparent>
+        size_type count(Key const & k) const
+        {
+            return upper_index(k) - lower_index(k);
+        }
+        template<
+            typename Key,
+            typename C = Compare,
+            typename Enable = typename C::is_transparent>
+        bool contains(Key const & k) const
+        {
+            return find(k) != this->end();
+        }
+        template<
+            typename Key,
+            typename C = Compare,
+            typename Enable = typename C::is_transparent>
+        iterator lower_bound(Key const & k)
+        {
+            return begin() + lower_index(k);
+        }
+        template<
+            typename Key,
+            typename C = Compare,
+            typename Enable = typename C::is_transparent>
+        const_iterator lower_bound(Key const & k) const
+        {
+            return const_cast<flat_map &>(*this).begin() + lower_index(k);
+        }
+        template<
+            typename Key,
+            typename C = Compare,
+            typename Enable = typename C::is_transparent>
+        iterator upper_bound(Key const & k)
+        {
+            return begin() + upper_index(k);
+        }
+        template<
+            typename Key,
+            typename C = Compare,
+            typename Enable = typename C::is_transparent>
+        const_iterator upper_bound(Key const & k) const
+        {
+            return const_cast<flat_map &>(*this).begin() + upper_index(k);
+        }
+        // A key that is not a K may be equivalent to more than one K.
+        template<
+            typename Key,
+            typename C = Compare,
+            typename Enable = typename C::is_transparent>
+        std::pair<iterator, iterator> equal_range(Key const & k)
+        {
+            return std::pair<iterator, iterator>(
+                begin() + lower_index(k), begin() + upper_index(k));
+        }
+        template<
+            typename Key,
+            typename C = Compare,
+            typename Enable = typename C::is_transparent>
+        std::pair<const_iterator, const_iterator> equal_range(
+            Key const & k) const
+        {
+            auto const result = const_cast<flat_map &>(*this).equal_range(k);
+            return std::pair<const_iterator, const_iterator>(
+                result.first, result.second);
+        }
+
+        using base_type = container_interface<flat_map<K, V, Compare>>;
+        using base_type::begin;
+        using base_type::end;
+
+    private:
+        template<typename Key>
+        iterator find_impl(Key const & k)
+        {
+            auto const it = begin() + lower_index(k);
+            return it == end() || comp_(k, (*it).first) ? end() : it;
+        }
+        template<typename Key>
+        size_type lower_index(Key const & k) const
+        {
+            return std::lower_bound(keys_.begin(), keys_.end(), k, comp_) -
+                   keys_.begin();
+        }
+        template<typename Key>
+        size_type upper_index(Key const & k) const
+        {
+            return std::upper_bound(keys_.begin(), keys_.end(), k, comp_) -
+                   keys_.begin();
+        }
+        size_type index(const_iterator it) const noexcept
+        {
+            return it.keys_ - keys_.data();
+        }
+
+        template<typename Key, typename... Args>
+        std::pair<iterator, bool> try_emplace_impl(Key && k, Args &&... args)
+        {
+            auto const i = lower_index(k);
+            if (i != size() && !comp_(k, keys_[i]))
+                return std::pair<iterator, bool>(begin() + i, false);
+            keys_.insert(keys_.begin() + i, std::forward<Key>(k));
+            try {
+                values_.emplace(
+                    values_.begin() + i, std::forward<Args>(args)...);
+            } catch (...) {
+                keys_.erase(keys_.begin() + i);
+                throw;
+            }
+            return std::pair<iterator, bool>(begin() + i, true);
+        }
+
+        // The number of elements in [first, last), if it can be known before
+        // they are read, and otherwise 0.
+        template<typename Iter>
+        static size_type added(Iter first, Iter last)
+        {
+            return added(
+                first,
+                last,
+                typename std::iterator_traits<Iter>::iterator_category{});
+        }
+        template<typename Iter>
+        static size_type added(Iter first, Iter last, std::forward_iterator_tag)
+        {
+            return size_type(std::distance(first, last));
+        }
+        template<typename Iter>
+        static size_type added(Iter, Iter, std::input_iterator_tag)
+        {
+            return 0;
+        }
+
+        // Merges the sorted, unique elements of [first, last) with the
+        // elements of *this, into new arrays, each allocated once.  (The keys
+        // and values are in separate arrays, and std::inplace_merge() cannot
+        // move them together, as flat_set's merge() does with its keys.)
+        // Elements of [first, last) whose keys are already in *this are
+        // skipped.  If an exception is thrown, *this is left empty.
+        template<typename InputIterator>
+        void merge(InputIterator first, InputIterator last)
+        {
+            key_container_type keys;
+            mapped_container_type values;
+            try {
+                auto const capacity = size() + added(first, last);
+                keys.reserve(capacity);
+                values.reserve(capacity);
+                size_type i = 0;
+                size_type const n = size();
+                for (; first != last; ++first) {
+                    auto && x = *first;
+                    for (; i < n && comp_(keys_[i], x.first); ++i) {
+                        keys.push_back(std::move(keys_[i]));
+                        values.push_back(std::move(values_[i]));
+                    }
+                    if (i < n && !comp_(x.first, keys_[i]))
+                        continue;
+                    keys.push_back(std::forward<decltype(x)>(x).first);
+                    values.push_back(std::forward<decltype(x)>(x).second);
+                }
+                for (; i < n; ++i) {
+                    keys.push_back(std::move(keys_[i]));
+                    values.push_back(std::move(values_[i]));
+                }
+            } catch (...) {
+                clear();
+                throw;
+            }
+            keys_.swap(keys);
+            values_.swap(values);
+        }
+
+        key_container_type keys_;
+        mapped_container_type values_;
+        Compare comp_;
+    };
+    //]
+
+    //[ flat_set_defn
+    // The set counterpart of flat_map: the keys, sorted, in one std::vector.
+    // Since the keys are contiguous, the iterators are just pointers to const.
+    template<typename K, typename Compare = std::less<K>>
+    struct flat_set : container_interface<flat_set<K, Compare>, contiguous>
+    {
+        // types
+        using key_type = K;
+        using value_type = K;
+        using key_compare = Compare;
+        using value_compare = Compare;
+        using reference = K const &;
+        using const_reference = K const &;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using iterator = K const *;
+        using const_iterator = K const *;
+        using reverse_iterator = stl_interfaces::reverse_iterator<iterator>;
+        using const_reverse_iterator = reverse_iterator;
+        using container_type = std::vector<K>;
+
+        // construct/copy/destroy
+        flat_set() : comp_() {}
+        explicit flat_set(Compare const & comp) : comp_(comp) {}
+        template<
+            typename InputIterator,
+            typename Enable = std::enable_if_t<std::is_convertible<
+                typename std::iterator_traits<InputIterator>::iterator_category,
+                std::input_iterator_tag>::value>>
+        flat_set(
+            InputIterator first,
+            InputIterator last,
+            Compare const & comp = Compare()) :
+            comp_(comp)
+        {
+            insert(first, last);
+        }
+        template<
+            typename InputIterator,
+            typename Enable = std::enable_if_t<std::is_convertible<
+                typename std::iterator_traits<InputIterator>::iterator_category,
+                std::input_iterator_tag>::value>>
+        flat_set(
+            sorted_unique_t,
+            InputIterator first,
+            InputIterator last,
+            Compare const & comp = Compare()) :
+            comp_(comp)
+        {
+            insert(sorted_unique, first, last);
+        }
+        flat_set(
+            std::initializer_list<K> il, Compare const & comp = Compare()) :
+            flat_set(il.begin(), il.end(), comp)
+        {}
+
+        // iterators (2 members, skipped 10)
+        iterator begin() noexcept { return keys_.data(); }
+        iterator end() noexcept { return keys_.data() + keys_.size(); }
+
+        // capacity
+        size_type size() const noexcept { return keys_.size(); }
+        size_type max_size() const noexcept { return keys_.max_size(); }
+        void reserve(size_type n) { keys_.reserve(n); }
+
+        // modifiers
+        template<typename... Args>
+        std::pair<iterator, bool> emplace(Args &&... args)
+        {
+            return insert(K(std::forward<Args>(args)...));
+        }
+        std::pair<iterator, bool> insert(K const & k) { return insert_impl(k); }
+        std::pair<iterator, bool> insert(K && k)
+        {
+            return insert_impl(std::move(k));
+        }
+        // As with flat_map, the new keys are sorted on their own, and then
+        // merged with the existing ones in linear time.
+        template<
+            typename InputIterator,
+            typename Enable = std::enable_if_t<std::is_convertible<
+                typename std::iterator_traits<InputIterator>::iterator_category,
+                std::input_iterator_tag>::value>>
+        void insert(InputIterator first, InputIterator last)
+        {
+            container_type keys(first, last);
+            std::stable_sort(keys.begin(), keys.end(), comp_);
+            auto const unique_end = std::unique(
+                keys.begin(), keys.end(), [this](K const & lhs, K const & rhs) {
+                    return !comp_(lhs, rhs);
+                });
+            merge(
+                std::make_move_iterator(keys.begin()),
+                std::make_move_iterator(unique_end));
+        }
+        template<
+            typename InputIterator,
+            typename Enable = std::enable_if_t<std::is_convertible<
+                typename std::iterator_traits<InputIterator>::iterator_category,
+                std::input_iterator_tag>::value>>
+        void insert(sorted_unique_t, InputIterator first, InputIterator last)
+        {
+            merge(first, last);
+        }
+        void insert(std::initializer_list<K> il)
+        {
+            insert(il.begin(), il.end());
+        }
+
+        iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+        iterator erase(const_iterator first, const_iterator last)
+        {
+            auto const i = first - keys_.data();
+            keys_.erase(
+                keys_.begin() + i, keys_.begin() + (last - keys_.data()));
+            return keys_.data() + i;
+        }
+        size_type erase(K const & k)
+        {
+            auto const it = find(k);
+            if (it == end())
+                return 0;
+            erase(it);
+            return 1;
+        }
+        void swap(flat_set & other) noexcept
+        {
+            using std::swap;
+            keys_.swap(other.keys_);
+            swap(comp_, other.comp_);
+        }
+        friend void swap(flat_set & lhs, flat_set & rhs) noexcept
+        {
+            lhs.swap(rhs);
+        }
+        void clear() noexcept { keys_.clear(); }
+
+        // observers
+        key_compare key_comp() const { return comp_; }
+        value_compare value_comp() const { return comp_; }
+        container_type const & keys() const noexcept { return keys_; }
+
+        // set operations
+        iterator find(K const & k) const
+        {
+            auto const it = lower_bound(k);
+            return it == this->cend() || comp_(k, *it) ? this->cend() : it;
+        }
+        size_type count(K const & k) const { return contains(k); }
+        bool contains(K const & k) const { return find(k) != this->cend(); }
+        iterator lower_bound(K const & k) const
+        {
+            return std::lower_bound(this->cbegin(), this->cend(), k, comp_);
+        }
+        iterator upper_bound(K const & k) const
+        {
+            return std::upper_bound(this->cbegin(), this->cend(), k, comp_);
+        }
+        std::pair<iterator, iterator> equal_range(K const & k) const
+        {
+            auto const first = lower_bound(k);
+            auto const last = first == this->cend() || comp_(k, *first)
+                                  ? first
+                                  : first + 1;
+            return std::pair<iterator, iterator>(first, last);
+        }
+
+        // The transparent lookups; see flat_map.
+        template<
+            typename Key,
+            typename C = Compare,
+            typename Enable = typename C::is_transparent>
+        iterator find(Key const & k) const
+        {
+            auto const it = lower_bound(k);
+            return it == this->cend() || comp_(k, *it) ? this->cend() : it;
+        }
+        template<
+            typename Key,
+            typename C = Compare,
+            typename Enable = typename C::is_transparent>
+        size_type count(Key const & k) const
+        {
+            return upper_bound(k) - lower_bound(k);
+        }
+        template<
+            typename Key,
+            typename C = Compare,
+            typename Enable = typename C::is_transparent>
+        bool contains(Key const & k) const
+        {
+            return find(k) != this->cend();
+        }
+        template<
+            typename Key,
+            typename C = Compare,
+            typename Enable = typename C::is_transparent>
+        iterator lower_bound(Key const & k) const
+        {
+            return std::lower_bound(this->cbegin(), this->cend(), k, comp_);
+        }
+        template<
+            typename Key,
+            typename C = Compare,
+            typename Enable = typename C::is_transparent>
+        iterator upper_bound(Key const & k) const
+        {
+            return std::upper_bound(this->cbegin(), this->cend(), k, comp_);
+        }
+        template<
+            typename Key,
+            typename C = Compare,
+            typename Enable = typename C::is_transparent>
+        std::pair<iterator, iterator> equal_range(Key const & k) const
+        {
+            return std::pair<iterator, iterator>(
+                lower_bound(k), upper_bound(k));
+        }
+
+        using base_type = container_interface<flat_set<K, Compare>, contiguous>;
+        using base_type::begin;
+        using base_type::end;
+
+    private:
+        template<typename Key>
+        std::pair<iterator, bool> insert_impl(Key && k)
+        {
+            auto const it = std::lower_bound(
+                keys_.begin(), keys_.end(), k, comp_);
+            if (it != keys_.end() && !comp_(k, *it))
+                return std::pair<iterator, bool>(&*it, false);
+            auto const result = keys_.insert(it, std::forward<Key>(k));
+            return std::pair<iterator, bool>(&*result, true);
+        }
+
+        // Merges the sorted, unique keys of [first, last) with the keys of
+        // *this, in place: they are appended, the two sorted runs are merged
+        // with std::inplace_merge(), and the second of each pair of equal keys
+        // -- the new one, since the merge is stable -- is erased.  There is no
+        // second array, and when the new keys fit in the capacity, there is no
+        // allocation apart from std::inplace_merge()'s buffer.  If an exception
+        // is thrown, *this is left empty.
+        template<typename InputIterator>
+        void merge(InputIterator first, InputIterator last)
+        {
+            try {
+                auto const n = keys_.size();
+                keys_.insert(keys_.end(), first, last);
+                std::inplace_merge(
+                    keys_.begin(), keys_.begin() + n, keys_.end(), comp_);
+                keys_.erase(
+                    std::unique(
+                        keys_.begin(),
+                        keys_.end(),
+                        [this](K const & lhs, K const & rhs) {
+                            return !comp_(lhs, rhs);
+                        }),
+                    keys_.end());
+            } catch (...) {
+                clear();
+                throw;
+            }
+        }
+
+        container_type keys_;
+        Compare comp_;
+    };
+    //]
+
+}}}
+
+#endif
@@ -11,23 +11,67 @@
 #if 201703L <= __cplusplus && __has_include(<stl2/ranges.hpp>) && \
     !defined(BOOST_STL_INTERFACES_DISABLE_CMCSTL2)
 #include <stl2/ranges.hpp>
+#define BOOST_STL_INTERFACES_USE_CMCSTL2
 #endif
 
 #ifndef BOOST_STL_INTERFACES_DOXYGEN
 
-#if defined(_MSC_VER) || defined(__GNUC__) && __GNUC__ < 8
+// Before C++20, the v2 interfaces are written against the Concepts TS (GCC's
+// -fconcepts), and the ranges concepts come from cmcstl2 if it is available,
+// or else from the minimal emulation in detail/concepts.hpp.
+#if !(201703L < __cplusplus && defined(__cpp_lib_concepts)) &&                 \
+    201703L <= __cplusplus &&                                                  \
+    (defined(BOOST_STL_INTERFACES_USE_CMCSTL2) || defined(__cpp_concepts))
+#define BOOST_STL_INTERFACES_USE_CONCEPTS_TS
+#endif
+
+// Hidden friends cannot be constexpr on these compilers; the operators that
+// would be hidden friends are namespace-scope templates there instead,
+// constrained to iterators derived from iterator_interface.  Defining this
+// macro selects that formulation everywhere.
+#if !defined(BOOST_STL_INTERFACES_NO_HIDDEN_FRIEND_CONSTEXPR) &&               \
+    (defined(_MSC_VER) || defined(__GNUC__) && __GNUC__ < 8)
 #define BOOST_STL_INTERFACES_NO_HIDDEN_FRIEND_CONSTEXPR
+#endif
+#ifdef BOOST_STL_INTERFACES_NO_HIDDEN_FRIEND_CONSTEXPR
 #define BOOST_STL_INTERFACES_HIDDEN_FRIEND_CONSTEXPR
 #else
 #define BOOST_STL_INTERFACES_HIDDEN_FRIEND_CONSTEXPR constexpr
 #endif
 
+// Defining BOOST_STL_INTERFACES_FORCE_INLINE makes the compiler inline the
+// operations that iterator_interface, view_interface, and container_interface
+// forward to the derived type, even in unoptimized builds, where each would
+// otherwise be a call or two of its own.  With GCC and Clang, they are also
+// marked artificial, so that debuggers step through them.
+#if defined(BOOST_STL_INTERFACES_FORCE_INLINE) && defined(_MSC_VER)
+#define BOOST_STL_INTERFACES_INLINE __forceinline
+#elif defined(BOOST_STL_INTERFACES_FORCE_INLINE) && defined(__GNUC__)
+#define BOOST_STL_INTERFACES_INLINE                                            \
+    __attribute__((__always_inline__, __artificial__)) inline
+#else
+#define BOOST_STL_INTERFACES_INLINE
+#endif
+
 #if defined(__GNUC__) && __GNUC__ < 9
 #define BOOST_STL_INTERFACES_CONCEPT concept bool
 #else
 #define BOOST_STL_INTERFACES_CONCEPT concept
 #endif
 
+// Defined only where it works; code that uses it keeps a constexpr-friendly
+// fallback for the compilers that lack it.
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_is_constant_evaluated)
+#define BOOST_STL_INTERFACES_CONSTANT_EVALUATED()                              \
+    __builtin_is_constant_evaluated()
+#endif
+#elif defined(__GNUC__) && 9 <= __GNUC__ ||                                  \
+    defined(_MSC_VER) && 1925 <= _MSC_VER
+#define BOOST_STL_INTERFACES_CONSTANT_EVALUATED()                              \
+    __builtin_is_constant_evaluated()
+#endif
+
 #endif
 
 
@@ -39,6 +83,32 @@ namespace boost { namespace stl_interfaces {
             `container_interface`. */
         enum element_layout : bool { discontiguous = false, contiguous = true };
 
+        /** A tag type used to request default-initialization of new
+            elements, rather than value-initialization.  A container derived
+            from `container_interface` that defines `resize(n,
+            default_init_t)` gets a `resize_for_overwrite(n)` member. */
+        struct default_init_t
+        {
+            explicit default_init_t() = default;
+        };
+
+        /** The `default_init_t` value. */
+        constexpr default_init_t default_init{};
+
+#if 201703L < __cplusplus && defined(__cpp_lib_ranges) || BOOST_STL_INTERFACES_DOXYGEN
+        /** The iterator concept tag for contiguous iterators.  This is
+            `std::contiguous_iterator_tag` when the standard library provides
+            it; otherwise, it is a tag derived from
+            `std::random_access_iterator_tag`.  An `iterator_interface`
+            iterator with this concept has a `std::random_access_iterator_tag`
+            `iterator_category`, and is usable with `to_address()`. */
+        using contiguous_iterator_tag = std::contiguous_iterator_tag;
+#else
+        struct contiguous_iterator_tag : std::random_access_iterator_tag
+        {
+        };
+#endif
+
         namespace v1_dtl {
             template<typename... T>
             using void_t = void;
@@ -95,8 +165,7 @@ namespace boost { namespace stl_interfaces {
     namespace v2 {
 #if 201703L < __cplusplus && defined(__cpp_lib_concepts)
         namespace ranges = std::ranges;
-#elif 201703L <= __cplusplus && __has_include(<stl2/ranges.hpp>) && \
-    !defined(BOOST_STL_INTERFACES_DISABLE_CMCSTL2)
+#elif defined(BOOST_STL_INTERFACES_USE_CMCSTL2)
         namespace concepts = std::experimental;
         namespace ranges = std::experimental::ranges;
 #endif
@@ -104,4 +173,9 @@ namespace boost { namespace stl_interfaces {
 
 }}
 
+#if defined(BOOST_STL_INTERFACES_USE_CONCEPTS_TS) &&                           \
+    !defined(BOOST_STL_INTERFACES_USE_CMCSTL2)
+#include <boost/stl_interfaces/detail/concepts.hpp>
+#endif
+
 #endif
@@ -0,0 +1,407 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_GAP_BUFFER_HPP
+#define BOOST_STL_INTERFACES_GAP_BUFFER_HPP
+
+#include <boost/stl_interfaces/container_interface.hpp>
+#include <boost/stl_interfaces/reverse_iterator.hpp>
+#include <boost/stl_interfaces/segmented_iterator.hpp>
+#include <boost/stl_interfaces/trivially_relocatable.hpp>
+#include <boost/stl_interfaces/detail/relocate.hpp>
+
+#include <algorithm>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include <cstddef>
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+    //[ gap_buffer_iterator
+    // An iterator over the elements of a gap_buffer: the buffer's storage, the
+    // bounds of the gap in it, and an index.  Element i is in slot i before the
+    // gap, and in slot i + the gap's size after it; that is one compare and a
+    // conditional add, which compilers turn into a cmov rather than a branch.
+    //
+    // The iterator also models the segmented iterator protocol, with the parts
+    // before and after the gap as the two segments, 0 and 1.  An index at the
+    // start of the gap is in segment 1, so the end iterator is always at the
+    // end of segment 1, whether or not the gap is at the end.
+    template<typename T>
+    struct gap_buffer_iterator : iterator_interface<
+                                     gap_buffer_iterator<T>,
+                                     std::random_access_iterator_tag,
+                                     std::remove_const_t<T>>
+    {
+        gap_buffer_iterator() noexcept :
+            slots_(nullptr), gap_first_(0), gap_last_(0), capacity_(0), i_(0)
+        {}
+        gap_buffer_iterator(
+            T * slots,
+            std::ptrdiff_t gap_first,
+            std::ptrdiff_t gap_last,
+            std::ptrdiff_t capacity,
+            std::ptrdiff_t i) noexcept :
+            slots_(slots),
+            gap_first_(gap_first),
+            gap_last_(gap_last),
+            capacity_(capacity),
+            i_(i)
+        {}
+        template<
+            typename U,
+            typename E = std::enable_if_t<
+                std::is_same<T, U const>::value && !std::is_same<T, U>::value>>
+        gap_buffer_iterator(gap_buffer_iterator<U> other) noexcept :
+            slots_(other.slots_),
+            gap_first_(other.gap_first_),
+            gap_last_(other.gap_last_),
+            capacity_(other.capacity_),
+            i_(other.i_)
+        {}
+
+        T & operator*() const noexcept { return *slot(); }
+        gap_buffer_iterator & operator+=(std::ptrdiff_t n) noexcept
+        {
+            i_ += n;
+            return *this;
+        }
+        friend std::ptrdiff_t
+        operator-(gap_buffer_iterator lhs, gap_buffer_iterator rhs) noexcept
+        {
+            return lhs.i_ - rhs.i_;
+        }
+
+    private:
+        template<typename U>
+        friend struct gap_buffer_iterator;
+        friend access;
+
+        T * slot() const noexcept
+        {
+            return slots_ + i_ + (i_ < gap_first_ ? 0 : gap_last_ - gap_first_);
+        }
+
+        int segment() const noexcept { return i_ < gap_first_ ? 0 : 1; }
+        T * local() const noexcept { return slot(); }
+        T * local_begin(int seg) const noexcept
+        {
+            return slots_ + (seg ? gap_last_ : 0);
+        }
+        T * local_end(int seg) const noexcept
+        {
+            return slots_ + (seg ? capacity_ : gap_first_);
+        }
+        gap_buffer_iterator compose(int seg, T * it) const noexcept
+        {
+            auto const slot = it - slots_;
+            return gap_buffer_iterator(
+                slots_,
+                gap_first_,
+                gap_last_,
+                capacity_,
+                seg ? slot - (gap_last_ - gap_first_) : slot);
+        }
+
+        T * slots_;
+        std::ptrdiff_t gap_first_;
+        std::ptrdiff_t gap_last_;
+        std::ptrdiff_t capacity_;
+        std::ptrdiff_t i_;
+    };
+    //]
+
+    template<typename T>
+    struct gap_buffer;
+
+    // gap_buffer destroys its elements itself, before its slots go away; see
+    // flat_map.hpp.
+    template<typename T>
+    struct trivially_destructible_container<gap_buffer<T>> : std::true_type
+    {};
+
+    //[ gap_buffer_defn
+    // A sequence container for edits that stay near a cursor, like typing into
+    // a text editor's buffer.  The elements are in one array, with a gap of
+    // unused slots at the cursor.  Inserting or erasing at the gap moves
+    // nothing, so typing is amortized O(1) per element; moving the gap k
+    // elements relocates those k elements, with a single std::memmove() when T
+    // is trivially relocatable.  Unlike a rope, a gap buffer is as slow as a
+    // std::vector for edits that jump around the whole buffer, but it is one
+    // allocation, and indexing is O(1).
+    //
+    // insert() and erase() move the gap to the edit first; move_gap() moves it
+    // explicitly.  Erasing the elements just before the gap, as a backspace
+    // does, moves nothing either.  Inserting, erasing, and moving the gap
+    // invalidate all iterators.  [first, last) must not be part of *this in
+    // insert().
+    template<typename T>
+    struct gap_buffer : container_interface<gap_buffer<T>>
+    {
+        // Moving the gap must not fail half way through.
+        static_assert(
+            is_trivially_relocatable<T>::value ||
+                std::is_nothrow_move_constructible<T>::value,
+            "");
+
+        // types
+        using value_type = T;
+        using reference = T &;
+        using const_reference = T const &;
+        using iterator = gap_buffer_iterator<T>;
+        using const_iterator = gap_buffer_iterator<T const>;
+        using reverse_iterator = stl_interfaces::reverse_iterator<iterator>;
+        using const_reverse_iterator =
+            stl_interfaces::reverse_iterator<const_iterator>;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+
+        // construct/copy/destroy (9 members, skipped 2)
+        gap_buffer() noexcept :
+            slots_(nullptr), gap_first_(0), gap_last_(0), capacity_(0)
+        {}
+        explicit gap_buffer(size_type n) : gap_buffer()
+        {
+            reserve(n);
+            for (size_type i = 0; i < n; ++i) {
+                emplace_back();
+            }
+        }
+        template<
+            typename InputIterator,
+            typename Enable = std::enable_if_t<std::is_convertible<
+                typename std::iterator_traits<InputIterator>::iterator_category,
+                std::input_iterator_tag>::value>>
+        gap_buffer(InputIterator first, InputIterator last) : gap_buffer()
+        {
+            for (; first != last; ++first) {
+                emplace_back(*first);
+            }
+        }
+        gap_buffer(std::initializer_list<T> il) :
+            gap_buffer(il.begin(), il.end())
+        {}
+        gap_buffer(gap_buffer const & other) : gap_buffer()
+        {
+            reserve(other.size());
+            for (auto const & x : other) {
+                emplace_back(x);
+            }
+        }
+        gap_buffer(gap_buffer && other) noexcept : gap_buffer() { swap(other); }
+        gap_buffer & operator=(gap_buffer const & other)
+        {
+            if (this != &other) {
+                gap_buffer temp(other);
+                swap(temp);
+            }
+            return *this;
+        }
+        gap_buffer & operator=(gap_buffer && other) noexcept
+        {
+            gap_buffer temp(std::move(other));
+            swap(temp);
+            return *this;
+        }
+        ~gap_buffer()
+        {
+            clear();
+            if (slots_)
+                std::allocator<T>().deallocate(slots_, capacity_);
+        }
+
+        // iterators (2 members, skipped 10)
+        iterator begin() noexcept { return make_iterator(0); }
+        iterator end() noexcept { return make_iterator(size()); }
+
+        // capacity (5 members, skipped 3)
+        size_type size() const noexcept
+        {
+            return capacity_ - (gap_last_ - gap_first_);
+        }
+        size_type max_size() const noexcept
+        {
+            return (std::numeric_limits<difference_type>::max)() / sizeof(T);
+        }
+        size_type capacity() const noexcept { return capacity_; }
+        void reserve(size_type n)
+        {
+            if (capacity_ < n)
+                reallocate(n);
+        }
+        void shrink_to_fit()
+        {
+            if (size() < capacity_)
+                reallocate(size());
+        }
+
+        // The index of the gap; the next insertion there moves nothing.
+        size_type gap_position() const noexcept { return gap_first_; }
+        // Moves the gap to just before pos, by relocating the elements between
+        // the gap and pos across it.
+        void move_gap(const_iterator pos) noexcept
+        {
+            move_gap_to(size_type(pos - this->cbegin()));
+        }
+
+        // modifiers (5 members, skipped 10)
+        template<typename... Args>
+        reference emplace_back(Args &&... args)
+        {
+            return *emplace(this->cend(), std::forward<Args>(args)...);
+        }
+        template<typename... Args>
+        iterator emplace(const_iterator pos, Args &&... args)
+        {
+            auto const i = size_type(pos - this->cbegin());
+            // args may refer to an element that is about to move.
+            T x(std::forward<Args>(args)...);
+            if (gap_first_ == gap_last_)
+                grow(1);
+            move_gap_to(i);
+            ::new (static_cast<void *>(slots_ + gap_first_)) T(std::move(x));
+            ++gap_first_;
+            return make_iterator(i);
+        }
+        template<
+            typename ForwardIterator,
+            typename Enable = std::enable_if_t<std::is_convertible<
+                typename std::iterator_traits<
+                    ForwardIterator>::iterator_category,
+                std::forward_iterator_tag>::value>>
+        iterator
+        insert(const_iterator pos, ForwardIterator first, ForwardIterator last)
+        {
+            auto const i = size_type(pos - this->cbegin());
+            auto const n = size_type(std::distance(first, last));
+            if (gap_last_ - gap_first_ < n)
+                grow(n);
+            move_gap_to(i);
+            // The elements go at the front of the gap, one at a time, so that
+            // if one throws, those before it are inserted.
+            for (; first != last; ++first) {
+                ::new (static_cast<void *>(slots_ + gap_first_)) T(*first);
+                ++gap_first_;
+            }
+            return make_iterator(i);
+        }
+        iterator erase(const_iterator f, const_iterator l) noexcept
+        {
+            auto const i = size_type(f - this->cbegin());
+            auto const n = size_type(l - f);
+            if (i + n == gap_first_) {
+                gap_first_ -= n;
+                detail::destroy(
+                    slots_ + gap_first_, slots_ + gap_first_ + n);
+            } else {
+                move_gap_to(i);
+                detail::destroy(
+                    slots_ + gap_last_, slots_ + gap_last_ + n);
+                gap_last_ += n;
+            }
+            return make_iterator(i);
+        }
+        void clear() noexcept
+        {
+            detail::destroy(slots_, slots_ + gap_first_);
+            detail::destroy(
+                slots_ + gap_last_, slots_ + capacity_);
+            gap_first_ = 0;
+            gap_last_ = capacity_;
+        }
+        void swap(gap_buffer & other) noexcept
+        {
+            std::swap(slots_, other.slots_);
+            std::swap(gap_first_, other.gap_first_);
+            std::swap(gap_last_, other.gap_last_);
+            std::swap(capacity_, other.capacity_);
+        }
+        friend void swap(gap_buffer & lhs, gap_buffer & rhs) noexcept
+        {
+            lhs.swap(rhs);
+        }
+
+        using base_type = container_interface<gap_buffer<T>>;
+        using base_type::begin;
+        using base_type::end;
+        using base_type::erase;
+        using base_type::insert;
+
+    private:
+        iterator make_iterator(size_type i) const noexcept
+        {
+            return iterator(
+                slots_,
+                difference_type(gap_first_),
+                difference_type(gap_last_),
+                difference_type(capacity_),
+                difference_type(i));
+        }
+
+        void move_gap_to(size_type i) noexcept
+        {
+            // An empty gap is anywhere; relocating the elements between i and
+            // it would move each of them onto itself.
+            if (gap_first_ == gap_last_) {
+                gap_first_ = gap_last_ = i;
+            } else if (i < gap_first_) {
+                stl_interfaces::uninitialized_relocate_backward(
+                    slots_ + i, slots_ + gap_first_, slots_ + gap_last_);
+                gap_last_ -= gap_first_ - i;
+                gap_first_ = i;
+            } else if (gap_first_ < i) {
+                auto const n = i - gap_first_;
+                stl_interfaces::uninitialized_relocate(
+                    slots_ + gap_last_,
+                    slots_ + gap_last_ + n,
+                    slots_ + gap_first_);
+                gap_first_ = i;
+                gap_last_ += n;
+            }
+        }
+
+        // Makes room for at least insertions more elements, doubling the
+        // capacity at least, so that a run of insertions is amortized O(1).
+        void grow(size_type insertions)
+        {
+            reallocate((std::max)(
+                size() + insertions, (std::max)(2 * capacity_, size_type(16))));
+        }
+        // Moves the elements to new_capacity slots, keeping the gap where it
+        // is.
+        void reallocate(size_type new_capacity)
+        {
+            T * const new_slots = std::allocator<T>().allocate(new_capacity);
+            auto const new_gap_last = new_capacity - (capacity_ - gap_last_);
+            if (slots_) {
+                stl_interfaces::uninitialized_relocate(
+                    slots_, slots_ + gap_first_, new_slots);
+                stl_interfaces::uninitialized_relocate(
+                    slots_ + gap_last_,
+                    slots_ + capacity_,
+                    new_slots + new_gap_last);
+                std::allocator<T>().deallocate(slots_, capacity_);
+            }
+            slots_ = new_slots;
+            gap_last_ = new_gap_last;
+            capacity_ = new_capacity;
+        }
+
+        T * slots_;
+        size_type gap_first_;
+        size_type gap_last_;
+        size_type capacity_;
+    };
+    //]
+
+}}}
+
+#endif
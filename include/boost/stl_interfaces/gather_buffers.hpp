@@ -0,0 +1,227 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_GATHER_BUFFERS_HPP
+#define BOOST_STL_INTERFACES_GATHER_BUFFERS_HPP
+
+#include <boost/stl_interfaces/byte_view.hpp>
+#include <boost/stl_interfaces/segmented_iterator.hpp>
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+#if defined(__has_include)
+#if __has_include(<sys/uio.h>)
+#include <sys/uio.h>
+#define BOOST_STL_INTERFACES_HAS_IOVEC
+#endif
+#endif
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+    /** Makes the default buffer of `gather_buffers()`, a
+        `pointer_view<unsigned char const>` of `size` bytes at `p`. */
+    struct to_byte_view
+    {
+        pointer_view<unsigned char const>
+        operator()(void const * p, std::size_t size) const noexcept
+        {
+            auto const first = static_cast<unsigned char const *>(p);
+            return pointer_view<unsigned char const>(first, first + size);
+        }
+    };
+
+#if defined(BOOST_STL_INTERFACES_HAS_IOVEC) || BOOST_STL_INTERFACES_DOXYGEN
+    /** Makes a POSIX `iovec` of `size` bytes at `p`, for `writev()` and
+        `sendmsg()`, which do not write to the memory, though `iov_base` is
+        not a pointer to `const`.  Only defined where `<sys/uio.h>` is
+        available. */
+    struct to_iovec
+    {
+        ::iovec operator()(void const * p, std::size_t size) const noexcept
+        {
+            ::iovec retval;
+            retval.iov_base = const_cast<void *>(p);
+            retval.iov_len = size;
+            return retval;
+        }
+    };
+#endif
+
+    /** Writes to `out` a buffer for each contiguous run of the bytes of the
+        elements of `[first, last)`, in order, and returns the end of the
+        buffers written -- an `iovec` array, say, for one `writev()` of all
+        the elements of a segmented container, without flattening them
+        into one buffer first.  Each buffer is `make(p, size)`, for the run
+        of `size` bytes at `p`; `to_byte_view`, `to_iovec`, or a function
+        object that makes an `asio::const_buffer`, for instance.  Runs that
+        happen to be adjacent in memory are written as one buffer.
+
+        `Iter` must be contiguous, or segmented (see
+        `segmented_iterator_traits`), with local iterators that are
+        contiguous, or segmented in turn.  The element type must be
+        trivially copyable. */
+    template<
+        typename Iter,
+        typename OutputIter,
+        typename MakeBuffer = to_byte_view>
+    OutputIter gather_buffers(
+        Iter first, Iter last, OutputIter out, MakeBuffer make = MakeBuffer());
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    namespace v1_dtl {
+        // Collects the contiguous runs of bytes, joining each one to the
+        // one before it if it starts where that one ends, and writes each
+        // as make(p, size) to out.
+        template<typename OutputIter, typename MakeBuffer>
+        struct buffer_gatherer
+        {
+            void add(void const * p, std::size_t size)
+            {
+                if (!size)
+                    return;
+                auto const bytes = static_cast<unsigned char const *>(p);
+                if (first_ && first_ + size_ == bytes) {
+                    size_ += size;
+                    return;
+                }
+                flush();
+                first_ = bytes;
+                size_ = size;
+            }
+
+            OutputIter finish()
+            {
+                flush();
+                return out_;
+            }
+
+            OutputIter out_;
+            MakeBuffer & make_;
+            unsigned char const * first_;
+            std::size_t size_;
+
+        private:
+            void flush()
+            {
+                if (first_) {
+                    *out_ = make_(first_, size_);
+                    ++out_;
+                }
+            }
+        };
+
+        template<typename Iter, typename Gatherer>
+        void gather_runs(Iter first, Iter last, Gatherer & g, std::false_type)
+        {
+            static_assert(
+                is_contiguous_iterator<Iter>::value,
+                "gather_buffers() requires iterators that are contiguous, "
+                "or segmented iterators whose innermost local iterators "
+                "are contiguous.");
+            if (first == last)
+                return;
+            using value_type = typename std::iterator_traits<Iter>::value_type;
+            g.add(
+                stl_interfaces::to_address(first),
+                std::size_t(last - first) * sizeof(value_type));
+        }
+        template<typename Iter, typename Gatherer>
+        void gather_runs(Iter first, Iter last, Gatherer & g, std::true_type)
+        {
+            if (first == last)
+                return;
+            v1_dtl::for_each_segment(
+                first, last, [&](auto, auto local_first, auto local_last) {
+                    v1_dtl::gather_runs(
+                        local_first,
+                        local_last,
+                        g,
+                        is_segmented_iterator<decltype(local_first)>{});
+                    return true;
+                });
+        }
+
+        template<typename Range, typename = void>
+        struct has_data_pointer : std::false_type
+        {
+        };
+        template<typename Range>
+        struct has_data_pointer<Range, void_t<range_data_ptr_t<Range>>>
+            : std::is_pointer<range_data_ptr_t<Range>>
+        {
+        };
+
+        template<typename Range, typename OutputIter, typename MakeBuffer>
+        OutputIter gather_range(
+            Range const & r,
+            OutputIter out,
+            MakeBuffer & make,
+            std::true_type)
+        {
+            auto const bytes = stl_interfaces::as_bytes(r);
+            if (!bytes.empty()) {
+                *out = make(bytes.data(), std::size_t(bytes.size()));
+                ++out;
+            }
+            return out;
+        }
+        template<typename Range, typename OutputIter, typename MakeBuffer>
+        OutputIter gather_range(
+            Range const & r,
+            OutputIter out,
+            MakeBuffer & make,
+            std::false_type)
+        {
+            return stl_interfaces::gather_buffers(
+                std::begin(r), std::end(r), out, make);
+        }
+    }
+
+#endif
+
+    template<typename Iter, typename OutputIter, typename MakeBuffer>
+    OutputIter
+    gather_buffers(Iter first, Iter last, OutputIter out, MakeBuffer make)
+    {
+        static_assert(
+            std::is_trivially_copyable<
+                typename std::iterator_traits<Iter>::value_type>::value,
+            "gather_buffers() requires trivially copyable elements.");
+        v1_dtl::buffer_gatherer<OutputIter, MakeBuffer> g{
+            out, make, nullptr, 0};
+        v1_dtl::gather_runs(first, last, g, is_segmented_iterator<Iter>{});
+        return g.finish();
+    }
+
+    /** Writes to `out` a buffer for each contiguous run of the bytes of the
+        elements of `r`, as `gather_buffers(first, last, out, make)` does.
+        If `r` has `data()` and `size()`, as a `std::vector` does, it is one
+        run. */
+    template<
+        typename Range,
+        typename OutputIter,
+        typename MakeBuffer = to_byte_view
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+        ,
+        typename Enable = decltype(std::begin(std::declval<Range const &>()))
+#endif
+        >
+    OutputIter gather_buffers(
+        Range const & r, OutputIter out, MakeBuffer make = MakeBuffer())
+    {
+        return v1_dtl::gather_range(
+            r,
+            out,
+            make,
+            v1_dtl::has_data_pointer<Range const>{});
+    }
+
+}}}
+
+#endif
@@ -0,0 +1,388 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_GENERATOR_HPP
+#define BOOST_STL_INTERFACES_GENERATOR_HPP
+
+#include <boost/stl_interfaces/iterator_interface.hpp>
+#include <boost/stl_interfaces/view_interface.hpp>
+
+#if 201703L < __cplusplus && defined(__cpp_lib_concepts) &&                    \
+        defined(__cpp_impl_coroutine) &&                                       \
+        !defined(BOOST_STL_INTERFACES_DISABLE_V2) ||                           \
+    BOOST_STL_INTERFACES_DOXYGEN
+
+#include <coroutine>
+#include <exception>
+#include <memory>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+#include <cstddef>
+
+
+namespace boost { namespace stl_interfaces { namespace v2 {
+
+    /** Wraps a range `r`, so that `co_yield elements_of(r)` in the body of a
+        `generator` yields each element of `r` in turn.  When `r` is a
+        `generator` of the same type, its coroutine runs nested inside the
+        yielding one, without a copy of its elements and without a frame
+        of its own on the stack. */
+    template<typename R>
+    struct elements_of
+    {
+        R range;
+    };
+
+    template<typename R>
+    elements_of(R &&) -> elements_of<R &&>;
+
+    template<typename T>
+    struct generator;
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    namespace v2_dtl {
+        /** A per-thread free list of coroutine frames for each size up to
+            `max_size`, in steps of `granularity`.  A frame that a
+            generator frees is kept for the next generator of its size
+            class on the same thread, so that a loop that makes a
+            generator -- or a recursion that nests one -- on each
+            iteration allocates only until it has as many frames as it
+            has at once.  Each list keeps at most `max_blocks` frames. */
+        struct frame_pool
+        {
+            static constexpr std::size_t granularity = 64;
+            static constexpr std::size_t max_size = 1024;
+            static constexpr std::size_t classes = max_size / granularity;
+            static constexpr int max_blocks = 64;
+
+            ~frame_pool()
+            {
+                destroyed() = true;
+                for (auto & list : free_) {
+                    while (list.head_) {
+                        auto const next = list.head_->next_;
+                        ::operator delete(list.head_);
+                        list.head_ = next;
+                    }
+                }
+            }
+
+            static void * allocate(std::size_t n)
+            {
+                auto const c = size_class(n);
+                if (c < classes && !destroyed()) {
+                    auto & list = local().free_[c];
+                    if (list.head_) {
+                        auto const retval = list.head_;
+                        list.head_ = retval->next_;
+                        --list.size_;
+                        return retval;
+                    }
+                    return ::operator new((c + 1) * granularity);
+                }
+                return ::operator new(n);
+            }
+
+            static void deallocate(void * p, std::size_t n) noexcept
+            {
+                auto const c = size_class(n);
+                if (c < classes && !destroyed()) {
+                    auto & list = local().free_[c];
+                    if (list.size_ < max_blocks) {
+                        list.head_ = ::new (p) block{list.head_};
+                        ++list.size_;
+                        return;
+                    }
+                }
+                ::operator delete(p);
+            }
+
+        private:
+            struct block
+            {
+                block * next_;
+            };
+            struct free_list
+            {
+                block * head_ = nullptr;
+                int size_ = 0;
+            };
+
+            static std::size_t size_class(std::size_t n) noexcept
+            {
+                return (n - 1) / granularity;
+            }
+
+            // The pool of a thread that is exiting may be gone before the
+            // last generator on that thread; destroyed() is trivially
+            // destructible, so it can still be read then.
+            static bool & destroyed() noexcept
+            {
+                static thread_local bool retval = false;
+                return retval;
+            }
+            static frame_pool & local() noexcept
+            {
+                static thread_local frame_pool pool;
+                return pool;
+            }
+
+            free_list free_[classes];
+        };
+    }
+
+#endif
+
+    /** A coroutine that yields a lazy sequence of `T`s, as a move-only view
+        that is an input range.  `T` may be a reference type; otherwise,
+        each element is a `T &` that refers to the object the coroutine
+        yielded, which lives until the coroutine resumes, so an element may
+        be moved from.
+
+        `co_yield elements_of(r)` yields each element of the range `r`; if
+        `r` is a `generator<T>`, it runs nested inside this one, and
+        incrementing an iterator resumes the innermost nested generator
+        directly, however deep the nesting is.  When a nested generator
+        finishes, it transfers control straight back to the one that
+        yielded it, by symmetric transfer.  An exception that a nested
+        generator does not handle propagates out of the `co_yield` in its
+        parent, and from the outermost generator out of `begin()` or
+        `operator++()`.
+
+        Coroutine frames are allocated from a per-thread pool of recently
+        freed frames, so making a generator on each iteration of a loop
+        does not allocate in the steady state.
+
+        As for any input range, `begin()` may be called only once. */
+    template<typename T>
+    struct generator : view_interface<generator<T>>
+    {
+        using value_type = std::remove_cvref_t<T>;
+        using reference =
+            std::conditional_t<std::is_reference_v<T>, T, T &>;
+        using pointer = std::add_pointer_t<reference>;
+
+        struct promise_type;
+        struct iterator;
+
+        generator() = default;
+        generator(generator && other) noexcept :
+            coro_(std::exchange(other.coro_, nullptr))
+        {}
+        generator & operator=(generator && other) noexcept
+        {
+            std::swap(coro_, other.coro_);
+            return *this;
+        }
+        ~generator()
+        {
+            if (coro_)
+                coro_.destroy();
+        }
+
+        iterator begin()
+        {
+            if (coro_)
+                coro_.promise().resume();
+            return iterator(coro_);
+        }
+        std::default_sentinel_t end() const noexcept { return {}; }
+
+    private:
+        using handle_type = std::coroutine_handle<promise_type>;
+
+        explicit generator(handle_type coro) noexcept : coro_(coro) {}
+
+        struct final_awaiter
+        {
+            bool await_ready() noexcept { return false; }
+            std::coroutine_handle<>
+            await_suspend(handle_type coro) noexcept
+            {
+                auto & promise = coro.promise();
+                if (promise.parent_) {
+                    promise.root_->leaf_ = promise.parent_;
+                    return promise.parent_;
+                }
+                return std::noop_coroutine();
+            }
+            void await_resume() noexcept {}
+        };
+
+        struct nested_awaiter
+        {
+            bool await_ready() noexcept { return !child_.coro_; }
+            std::coroutine_handle<>
+            await_suspend(handle_type coro) noexcept
+            {
+                auto & parent = coro.promise();
+                auto & child = child_.coro_.promise();
+                child.root_ = parent.root_;
+                child.parent_ = coro;
+                parent.root_->leaf_ = child_.coro_;
+                return child_.coro_;
+            }
+            void await_resume()
+            {
+                if (child_.coro_ && child_.coro_.promise().exception_)
+                    std::rethrow_exception(child_.coro_.promise().exception_);
+            }
+
+            generator child_;
+        };
+
+        // Keeps a copy of a yielded const lvalue, which cannot bind to
+        // reference, for as long as the coroutine is suspended.
+        struct copy_awaiter
+        {
+            bool await_ready() noexcept { return false; }
+            void await_suspend(handle_type coro) noexcept
+            {
+                coro.promise().root_->value_ = std::addressof(value_);
+            }
+            void await_resume() noexcept {}
+
+            value_type value_;
+        };
+
+        template<typename R>
+        static generator flatten(R && r)
+        {
+            for (auto && x : r) {
+                co_yield static_cast<decltype(x) &&>(x);
+            }
+        }
+
+        handle_type coro_ = nullptr;
+    };
+
+    template<typename T>
+    struct generator<T>::promise_type
+    {
+        generator get_return_object() noexcept
+        {
+            return generator(handle_type::from_promise(*this));
+        }
+
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        final_awaiter final_suspend() noexcept { return {}; }
+
+        std::suspend_always
+        yield_value(std::remove_reference_t<reference> & x) noexcept
+        {
+            root_->value_ = std::addressof(x);
+            return {};
+        }
+        std::suspend_always
+        yield_value(std::remove_reference_t<reference> && x) noexcept
+        {
+            root_->value_ = std::addressof(x);
+            return {};
+        }
+        copy_awaiter yield_value(value_type const & x) requires(
+            !std::is_const_v<std::remove_reference_t<reference>> &&
+            std::is_copy_constructible_v<value_type>)
+        {
+            return copy_awaiter{x};
+        }
+        nested_awaiter yield_value(elements_of<generator &&> e) noexcept
+        {
+            return nested_awaiter{std::move(e.range)};
+        }
+        template<typename R>
+            requires std::ranges::input_range<R> &&
+            (!std::same_as<R, generator &&>)
+        nested_awaiter yield_value(elements_of<R> e)
+        {
+            return nested_awaiter{flatten(static_cast<R>(e.range))};
+        }
+
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept
+        {
+            exception_ = std::current_exception();
+        }
+
+        void await_transform() = delete;
+
+        static void * operator new(std::size_t n)
+        {
+            return v2_dtl::frame_pool::allocate(n);
+        }
+        static void operator delete(void * p, std::size_t n) noexcept
+        {
+            v2_dtl::frame_pool::deallocate(p, n);
+        }
+
+    private:
+        friend generator;
+
+        // Resumes the innermost nested generator.  Only called on the
+        // outermost one.
+        void resume()
+        {
+            leaf_.resume();
+            if (exception_)
+                std::rethrow_exception(std::exchange(exception_, nullptr));
+        }
+
+        // In the outermost generator, the element last yielded, and the
+        // generator that yielded it.
+        pointer value_ = nullptr;
+        handle_type leaf_ = handle_type::from_promise(*this);
+        promise_type * root_ = this;
+        handle_type parent_ = nullptr;
+        std::exception_ptr exception_;
+    };
+
+    template<typename T>
+    struct generator<T>::iterator : iterator_interface<
+                                        iterator,
+                                        std::input_iterator_tag,
+                                        value_type,
+                                        reference,
+                                        pointer>
+    {
+        iterator() = default;
+
+        reference operator*() const noexcept
+        {
+            return static_cast<reference>(*coro_.promise().value_);
+        }
+
+        iterator & operator++()
+        {
+            coro_.promise().resume();
+            return *this;
+        }
+        using iterator_interface<
+            iterator,
+            std::input_iterator_tag,
+            value_type,
+            reference,
+            pointer>::operator++;
+
+        friend bool
+        operator==(iterator const & it, std::default_sentinel_t) noexcept
+        {
+            return !it.coro_ || it.coro_.done();
+        }
+
+    private:
+        friend generator;
+
+        explicit iterator(handle_type coro) noexcept : coro_(coro) {}
+
+        handle_type coro_ = nullptr;
+    };
+
+}}}
+
+#endif
+
+#endif
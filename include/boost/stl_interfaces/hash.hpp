@@ -0,0 +1,211 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_HASH_HPP
+#define BOOST_STL_INTERFACES_HASH_HPP
+
+#include <boost/stl_interfaces/container_interface.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    namespace v1_dtl {
+        // Replaces a and b with the low and high halves of their 128-bit
+        // product.
+        inline void hash_mum(std::uint64_t & a, std::uint64_t & b) noexcept
+        {
+#if defined(__SIZEOF_INT128__)
+            __uint128_t const r = __uint128_t(a) * b;
+            a = std::uint64_t(r);
+            b = std::uint64_t(r >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+            a = _umul128(a, b, &b);
+#else
+            std::uint64_t const ha = a >> 32, hb = b >> 32;
+            std::uint64_t const la = std::uint32_t(a), lb = std::uint32_t(b);
+            std::uint64_t const rh = ha * hb, rm0 = ha * lb, rm1 = hb * la,
+                                rl = la * lb;
+            std::uint64_t const t = rl + (rm0 << 32);
+            std::uint64_t const lo = t + (rm1 << 32);
+            std::uint64_t const c = (t < rl) + (lo < t);
+            b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+            a = lo;
+#endif
+        }
+        // a * b's high half xor its low half.
+        inline std::uint64_t
+        hash_mix(std::uint64_t a, std::uint64_t b) noexcept
+        {
+            v1_dtl::hash_mum(a, b);
+            return a ^ b;
+        }
+
+        inline std::uint64_t hash_read8(unsigned char const * p) noexcept
+        {
+            std::uint64_t x;
+            std::memcpy(&x, p, 8);
+            return x;
+        }
+        inline std::uint64_t hash_read4(unsigned char const * p) noexcept
+        {
+            std::uint32_t x;
+            std::memcpy(&x, p, 4);
+            return x;
+        }
+
+        constexpr std::uint64_t hash_p0 = 0xa0761d6478bd642full;
+        constexpr std::uint64_t hash_p1 = 0xe7037ed1a0b428dbull;
+        constexpr std::uint64_t hash_p2 = 0x8ebc6af09c88c6e3ull;
+        constexpr std::uint64_t hash_p3 = 0x589965cc75374cc3ull;
+
+        // A wyhash-style hash of n bytes: 16 bytes per 64x64->128-bit
+        // multiply, with three independent lanes for long inputs, so that
+        // hashing runs at several bytes per cycle.
+        inline std::uint64_t
+        hash_bytes(void const * key, std::size_t n, std::uint64_t seed) noexcept
+        {
+            auto p = static_cast<unsigned char const *>(key);
+            seed ^= v1_dtl::hash_mix(seed ^ hash_p0, hash_p1);
+            std::uint64_t a = 0;
+            std::uint64_t b = 0;
+            if (n <= 16) {
+                if (4 <= n) {
+                    std::size_t const off = (n >> 3) << 2;
+                    a = (hash_read4(p) << 32) | hash_read4(p + off);
+                    b = (hash_read4(p + n - 4) << 32) |
+                        hash_read4(p + n - 4 - off);
+                } else if (0 < n) {
+                    a = (std::uint64_t(p[0]) << 16) |
+                        (std::uint64_t(p[n >> 1]) << 8) | p[n - 1];
+                }
+            } else {
+                std::size_t i = n;
+                if (48 < i) {
+                    std::uint64_t see1 = seed;
+                    std::uint64_t see2 = seed;
+                    do {
+                        seed = v1_dtl::hash_mix(
+                            hash_read8(p) ^ hash_p1, hash_read8(p + 8) ^ seed);
+                        see1 = v1_dtl::hash_mix(
+                            hash_read8(p + 16) ^ hash_p2,
+                            hash_read8(p + 24) ^ see1);
+                        see2 = v1_dtl::hash_mix(
+                            hash_read8(p + 32) ^ hash_p3,
+                            hash_read8(p + 40) ^ see2);
+                        p += 48;
+                        i -= 48;
+                    } while (48 < i);
+                    seed ^= see1 ^ see2;
+                }
+                while (16 < i) {
+                    seed = v1_dtl::hash_mix(
+                        hash_read8(p) ^ hash_p1, hash_read8(p + 8) ^ seed);
+                    i -= 16;
+                    p += 16;
+                }
+                a = hash_read8(p + i - 16);
+                b = hash_read8(p + i - 8);
+            }
+            a ^= hash_p1;
+            b ^= seed;
+            v1_dtl::hash_mum(a, b);
+            return v1_dtl::hash_mix(a ^ hash_p0 ^ n, b ^ hash_p1);
+        }
+
+        template<typename C>
+        using hash_value_t = std::remove_cv_t<typename std::iterator_traits<
+            decltype(std::declval<C const &>().begin())>::value_type>;
+
+        // True when equal elements of C have equal bytes, and the elements
+        // are contiguous, so that the whole sequence can be hashed as
+        // bytes.
+        template<typename C>
+        using bytewise_hashable = std::integral_constant<
+            bool,
+            is_contiguous_iterator<
+                decltype(std::declval<C const &>().begin())>::value &&
+                (std::is_integral<hash_value_t<C>>::value ||
+                 std::is_enum<hash_value_t<C>>::value ||
+                 std::is_pointer<hash_value_t<C>>::value)>;
+
+        template<typename C>
+        std::size_t container_hash_impl(C const & c, std::true_type)
+        {
+            auto const first = c.begin();
+            auto const n = std::size_t(c.end() - first);
+            if (!n)
+                return std::size_t(v1_dtl::hash_bytes(nullptr, 0, 0));
+            return std::size_t(v1_dtl::hash_bytes(
+                v1_dtl::data_address(first), n * sizeof(*first), 0));
+        }
+        template<typename C>
+        std::size_t container_hash_impl(C const & c, std::false_type)
+        {
+            std::hash<hash_value_t<C>> const hash;
+            std::uint64_t retval = hash_p0;
+            std::uint64_t n = 0;
+            for (auto const & x : c) {
+                retval = v1_dtl::hash_mix(
+                    retval ^ std::uint64_t(hash(x)), hash_p1);
+                ++n;
+            }
+            return std::size_t(v1_dtl::hash_mix(retval ^ n, hash_p2));
+        }
+    }
+
+#endif
+
+    /** Returns a hash of the elements of `c`, for all containers derived
+        from `container_interface`.  Found by ADL, this is also the hash of
+        `boost::hash<C>`.
+
+        If `C`'s iterators are contiguous and its elements are integers,
+        enums, or pointers, the elements' bytes are hashed in one call, by a
+        wyhash-style hash that consumes 16 bytes per multiply.  Otherwise,
+        the `std::hash` of each element is mixed into the result in turn. */
+    template<typename C>
+    auto hash_value(C const & c)
+        -> decltype(v1_dtl::derived_container(c), std::size_t(0))
+    {
+        return v1_dtl::container_hash_impl(
+            c, v1_dtl::bytewise_hashable<C>{});
+    }
+
+    /** A hash function object for containers derived from
+        `container_interface`, which calls `hash_value()`.  It may be given
+        to an unordered container directly, or used as the base of a
+        specialization of `std::hash`:
+
+        \code
+        namespace std {
+            template<>
+            struct hash<my_container>
+                : boost::stl_interfaces::container_hash
+            {};
+        }
+        \endcode */
+    struct container_hash
+    {
+        template<typename C>
+        auto operator()(C const & c) const
+            -> decltype(stl_interfaces::hash_value(c))
+        {
+            return stl_interfaces::hash_value(c);
+        }
+    };
+
+}}}
+
+#endif
@@ -0,0 +1,450 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_HIVE_HPP
+#define BOOST_STL_INTERFACES_HIVE_HPP
+
+#include <boost/stl_interfaces/container_interface.hpp>
+#include <boost/stl_interfaces/reverse_iterator.hpp>
+
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include <cassert>
+#include <cstdint>
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+    using hive_index = std::uint16_t;
+
+    // The part of a hive block that its iterators use.  The hive's end
+    // iterator refers to slot 0 of a hive_links with no slots, which closes
+    // the hive's circular list of blocks.
+    //
+    // skip is the block's jump-counting skip field.  Each run of erased slots
+    // has its length in skip[] at both its first slot and its last slot, and
+    // skip[] is 0 for every live slot.  So an iterator steps over any run in
+    // one jump forward, from the run's first slot, or backward, from its last.
+    // skip[end] is always 0, where end is the number of slots ever used.
+    template<typename T>
+    struct hive_links
+    {
+        hive_links * prev;
+        hive_links * next;
+        T * slots;
+        hive_index const * skip;
+        hive_index end;
+    };
+
+    template<typename T, std::size_t BlockSize>
+    struct hive_block : hive_links<T>
+    {
+        static constexpr hive_index none =
+            std::numeric_limits<hive_index>::max();
+
+        hive_block() noexcept : skip_(), size(0), free_head(none)
+        {
+            this->prev = this->next = nullptr;
+            this->slots = reinterpret_cast<T *>(storage_);
+            this->skip = skip_;
+            this->end = 0;
+            next_free_block = prev_free_block = nullptr;
+        }
+
+        // Erased runs are linked through their first slots, so that insertion
+        // can find one in O(1).
+        void link_run(hive_index first) noexcept
+        {
+            run_prev[first] = none;
+            run_next[first] = free_head;
+            if (free_head != none)
+                run_prev[free_head] = first;
+            free_head = first;
+        }
+        void unlink_run(hive_index first) noexcept
+        {
+            if (run_prev[first] == none)
+                free_head = run_next[first];
+            else
+                run_next[run_prev[first]] = run_next[first];
+            if (run_next[first] != none)
+                run_prev[run_next[first]] = run_prev[first];
+        }
+        void set_run(hive_index first, hive_index n) noexcept
+        {
+            skip_[first] = skip_[first + n - 1] = n;
+        }
+
+        hive_index skip_[BlockSize + 1];
+        hive_index run_prev[BlockSize];
+        hive_index run_next[BlockSize];
+        hive_index size;
+        hive_index free_head;
+        // The list of blocks with erased slots.
+        hive_block * next_free_block;
+        hive_block * prev_free_block;
+
+    private:
+        alignas(T) unsigned char storage_[BlockSize * sizeof(T)];
+    };
+
+    //[ hive_iterator
+    // A bidirectional iterator over the live elements of a hive, in block and
+    // slot order.  operator++() and operator--() take O(1) time however many
+    // erased slots they pass, since each run of erased slots is one jump.
+    template<typename T, typename Links>
+    struct hive_iterator : iterator_interface<
+                               hive_iterator<T, Links>,
+                               std::bidirectional_iterator_tag,
+                               std::remove_const_t<T>,
+                               T &,
+                               T *>
+    {
+        hive_iterator() noexcept : block_(nullptr), i_(0) {}
+        hive_iterator(Links * block, hive_index i) noexcept :
+            block_(block), i_(i)
+        {}
+        template<
+            typename U,
+            typename E = std::enable_if_t<
+                std::is_same<T, U const>::value && !std::is_same<T, U>::value>>
+        hive_iterator(hive_iterator<U, Links> other) noexcept :
+            block_(other.block_),
+            i_(other.i_)
+        {}
+
+        T & operator*() const noexcept { return block_->slots[i_]; }
+        hive_iterator & operator++() noexcept
+        {
+            ++i_;
+            i_ += block_->skip[i_];
+            if (i_ == block_->end) {
+                block_ = block_->next;
+                i_ = block_->skip[0];
+            }
+            return *this;
+        }
+        hive_iterator & operator--() noexcept
+        {
+            if (i_ == block_->skip[0]) {
+                block_ = block_->prev;
+                i_ = block_->end;
+            }
+            --i_;
+            i_ -= block_->skip[i_];
+            return *this;
+        }
+        friend bool operator==(hive_iterator lhs, hive_iterator rhs) noexcept
+        {
+            return lhs.block_ == rhs.block_ && lhs.i_ == rhs.i_;
+        }
+
+        using base_type = iterator_interface<
+            hive_iterator<T, Links>,
+            std::bidirectional_iterator_tag,
+            std::remove_const_t<T>,
+            T &,
+            T *>;
+        using base_type::operator++;
+        using base_type::operator--;
+
+    private:
+        template<typename U, typename L>
+        friend struct hive_iterator;
+        template<typename U, std::size_t N>
+        friend struct hive;
+
+        Links * block_;
+        hive_index i_;
+    };
+    //]
+
+    template<typename T, std::size_t BlockSize>
+    struct hive;
+
+    // hive destroys its elements and blocks itself; see flat_map.hpp.
+    template<typename T, std::size_t BlockSize>
+    struct trivially_destructible_container<hive<T, BlockSize>>
+        : std::true_type
+    {};
+
+    //[ hive_defn
+    // An unordered container of elements in blocks of BlockSize slots, like
+    // std::hive.  Insertion and erasure take O(1) time, and never move an
+    // element, so pointers and iterators to the other elements stay valid.
+    //
+    // Erasure leaves a hole, which the skip field of the slot's block records,
+    // merging it with any holes on either side.  Insertion fills the first slot
+    // of a hole if there is one, and otherwise appends to the last block, or to
+    // a new one.  A block is freed when its last element is erased.
+    template<typename T, std::size_t BlockSize = 256>
+    struct hive : container_interface<hive<T, BlockSize>>
+    {
+        static_assert(
+            0 < BlockSize &&
+                BlockSize < std::numeric_limits<hive_index>::max() - 1,
+            "BlockSize must fit in a hive_index, with room for the end.");
+
+    private:
+        using block = hive_block<T, BlockSize>;
+        using links = hive_links<T>;
+
+    public:
+        // types
+        using value_type = T;
+        using reference = T &;
+        using const_reference = T const &;
+        using iterator = hive_iterator<T, links>;
+        using const_iterator = hive_iterator<T const, links>;
+        using reverse_iterator = stl_interfaces::reverse_iterator<iterator>;
+        using const_reverse_iterator =
+            stl_interfaces::reverse_iterator<const_iterator>;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+
+        // construct/copy/destroy
+        hive() noexcept : size_(0), free_blocks_(nullptr) { reset(); }
+        template<
+            typename InputIterator,
+            typename Enable = std::enable_if_t<std::is_convertible<
+                typename std::iterator_traits<InputIterator>::iterator_category,
+                std::input_iterator_tag>::value>>
+        hive(InputIterator first, InputIterator last) : hive()
+        {
+            for (; first != last; ++first) {
+                emplace(*first);
+            }
+        }
+        hive(std::initializer_list<T> il) : hive(il.begin(), il.end()) {}
+        hive(hive const & other) : hive(other.begin(), other.end()) {}
+        hive(hive && other) noexcept : hive() { steal(other); }
+        hive & operator=(hive const & other)
+        {
+            if (this != &other) {
+                hive temp(other);
+                swap(temp);
+            }
+            return *this;
+        }
+        hive & operator=(hive && other) noexcept
+        {
+            if (this != &other) {
+                clear();
+                steal(other);
+            }
+            return *this;
+        }
+        ~hive() { clear(); }
+
+        // iterators (2 members, skipped 10)
+        iterator begin() noexcept
+        {
+            return iterator(end_.next, end_.next->skip[0]);
+        }
+        iterator end() noexcept { return iterator(&end_, 0); }
+
+        // capacity
+        size_type size() const noexcept { return size_; }
+        size_type max_size() const noexcept
+        {
+            return std::numeric_limits<difference_type>::max() / sizeof(T);
+        }
+
+        // modifiers
+        template<
+            typename... Args,
+            typename Enable =
+                std::enable_if_t<std::is_constructible<T, Args &&...>::value>>
+        iterator emplace(Args &&... args)
+        {
+            if (free_blocks_)
+                return emplace_in_hole(std::forward<Args>(args)...);
+            auto b = static_cast<block *>(end_.prev);
+            if (b != &end_ && b->end < BlockSize) {
+                ::new (static_cast<void *>(b->slots + b->end))
+                    T(std::forward<Args>(args)...);
+                ++size_;
+                ++b->size;
+                return iterator(b, b->end++);
+            }
+            b = new block;
+            try {
+                ::new (static_cast<void *>(b->slots))
+                    T(std::forward<Args>(args)...);
+            } catch (...) {
+                delete b;
+                throw;
+            }
+            link_block(b);
+            ++size_;
+            b->size = 1;
+            b->end = 1;
+            return iterator(b, 0);
+        }
+        iterator insert(T const & x) { return emplace(x); }
+        iterator insert(T && x) { return emplace(std::move(x)); }
+
+        iterator erase(const_iterator pos) noexcept
+        {
+            auto const b = static_cast<block *>(pos.block_);
+            auto const i = pos.i_;
+            auto next = std::next(pos);
+            b->slots[i].~T();
+            --size_;
+            if (!--b->size) {
+                free_block(b);
+                return iterator(next.block_, next.i_);
+            }
+
+            bool const had_holes = b->free_head != block::none;
+            bool const left = 0 < i && b->skip_[i - 1];
+            bool const right = i + 1 < b->end && b->skip_[i + 1];
+            hive_index first = i;
+            hive_index n = 1;
+            if (left) {
+                // The hole on the left grows; its first slot stays put.
+                n += b->skip_[i - 1];
+                first = i - b->skip_[i - 1];
+            }
+            if (right) {
+                n += b->skip_[i + 1];
+                b->unlink_run(i + 1);
+            }
+            if (!left)
+                b->link_run(i);
+            b->set_run(first, n);
+            if (!had_holes)
+                link_free_block(b);
+            return iterator(next.block_, next.i_);
+        }
+        iterator erase(const_iterator first, const_iterator last) noexcept
+        {
+            while (first != last) {
+                first = erase(first);
+            }
+            return iterator(last.block_, last.i_);
+        }
+        void swap(hive & other) noexcept
+        {
+            hive temp(std::move(other));
+            other = std::move(*this);
+            *this = std::move(temp);
+        }
+        friend void swap(hive & lhs, hive & rhs) noexcept { lhs.swap(rhs); }
+        void clear() noexcept
+        {
+            for (links * l = end_.next; l != &end_;) {
+                auto const b = static_cast<block *>(l);
+                l = l->next;
+                for (auto it = iterator(b, b->skip[0]); it.block_ == b; ++it) {
+                    (*it).~T();
+                }
+                delete b;
+            }
+            size_ = 0;
+            free_blocks_ = nullptr;
+            reset();
+        }
+
+        using base_type = container_interface<hive<T, BlockSize>>;
+        using base_type::begin;
+        using base_type::end;
+
+    private:
+        void reset() noexcept
+        {
+            end_.prev = end_.next = &end_;
+            end_.slots = nullptr;
+            end_.skip = &no_skip_;
+            end_.end = 0;
+            no_skip_ = 0;
+        }
+
+        void steal(hive & other) noexcept
+        {
+            if (!other.size_)
+                return;
+            end_.next = other.end_.next;
+            end_.prev = other.end_.prev;
+            end_.next->prev = end_.prev->next = &end_;
+            size_ = other.size_;
+            free_blocks_ = other.free_blocks_;
+            other.size_ = 0;
+            other.free_blocks_ = nullptr;
+            other.reset();
+        }
+
+        void link_block(block * b) noexcept
+        {
+            b->prev = end_.prev;
+            b->next = &end_;
+            end_.prev->next = b;
+            end_.prev = b;
+        }
+        void link_free_block(block * b) noexcept
+        {
+            b->prev_free_block = nullptr;
+            b->next_free_block = free_blocks_;
+            if (free_blocks_)
+                free_blocks_->prev_free_block = b;
+            free_blocks_ = b;
+        }
+        void unlink_free_block(block * b) noexcept
+        {
+            if (b->prev_free_block)
+                b->prev_free_block->next_free_block = b->next_free_block;
+            else
+                free_blocks_ = b->next_free_block;
+            if (b->next_free_block)
+                b->next_free_block->prev_free_block = b->prev_free_block;
+            b->next_free_block = b->prev_free_block = nullptr;
+        }
+        void free_block(block * b) noexcept
+        {
+            if (b->free_head != block::none)
+                unlink_free_block(b);
+            b->prev->next = b->next;
+            b->next->prev = b->prev;
+            delete b;
+        }
+
+        // Constructs the element in the first slot of a hole, and shrinks the
+        // hole from the front.
+        template<typename... Args>
+        iterator emplace_in_hole(Args &&... args)
+        {
+            auto const b = free_blocks_;
+            auto const i = b->free_head;
+            ::new (static_cast<void *>(b->slots + i))
+                T(std::forward<Args>(args)...);
+            auto const n = b->skip_[i];
+            b->unlink_run(i);
+            b->skip_[i] = 0;
+            if (1 < n) {
+                b->set_run(i + 1, n - 1);
+                b->link_run(i + 1);
+            }
+            if (b->free_head == block::none)
+                unlink_free_block(b);
+            ++size_;
+            ++b->size;
+            return iterator(b, i);
+        }
+
+        links end_;
+        hive_index no_skip_;
+        size_type size_;
+        block * free_blocks_;
+    };
+    //]
+
+}}}
+
+#endif
@@ -0,0 +1,156 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_INDEX_ITERATOR_HPP
+#define BOOST_STL_INTERFACES_INDEX_ITERATOR_HPP
+
+#include <boost/stl_interfaces/iterator_interface.hpp>
+
+#include <boost/assert.hpp>
+
+#include <iterator>
+#include <memory>
+#include <type_traits>
+
+#include <cstddef>
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    namespace v1_dtl {
+        template<typename Container>
+        using index_reference_t =
+            decltype(std::declval<Container &>()[std::size_t(0)]);
+
+        // Container::value_type if there is one, which it is for a
+        // container of proxies, and the type Reference refers to otherwise.
+        template<typename Container, typename Reference, typename = void>
+        struct index_value
+        {
+            using type = std::remove_cv_t<std::remove_reference_t<Reference>>;
+        };
+        template<typename Container, typename Reference>
+        struct index_value<
+            Container,
+            Reference,
+            void_t<typename Container::value_type>>
+        {
+            using type = typename Container::value_type;
+        };
+        template<typename Container, typename Reference>
+        using index_value_t =
+            typename index_value<std::remove_cv_t<Container>, Reference>::type;
+
+        template<typename Reference>
+        using index_pointer_t = std::conditional_t<
+            std::is_reference<Reference>::value,
+            std::remove_reference_t<Reference> *,
+            proxy_arrow_result<Reference>>;
+    }
+
+#endif
+
+    template<
+        typename Container,
+        typename Reference = v1_dtl::index_reference_t<Container>>
+    struct index_iterator;
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    namespace v1_dtl {
+        template<typename Container, typename Reference>
+        using index_iterator_interface_t = iterator_interface<
+            index_iterator<Container, Reference>,
+            std::random_access_iterator_tag,
+            index_value_t<Container, Reference>,
+            Reference,
+            index_pointer_t<Reference>,
+            std::ptrdiff_t>;
+    }
+
+#endif
+
+    /** A random access iterator over a container that is addressed by
+        integer position -- a ring buffer, a packed vector, a column of a
+        table -- rather than through pointers.  It is a pointer to the
+        container and an index, two words, and the element it refers to is
+        `container[index]`, converted to `Reference`.  So `Reference` may be
+        a proxy, if `operator[]()` returns one.
+
+        Advancing the iterator, and comparing or subtracting two of them,
+        touches only the indices; the two must be into the same container.
+        For a const iterator, use a `Container const`: an `index_iterator<C>`
+        converts to an `index_iterator<C const>`. */
+    template<typename Container, typename Reference>
+    struct index_iterator
+        : v1_dtl::index_iterator_interface_t<Container, Reference>
+    {
+        using reference = Reference;
+        using difference_type = std::ptrdiff_t;
+
+        constexpr index_iterator() noexcept : c_(nullptr), i_(0) {}
+        constexpr index_iterator(
+            Container & c, difference_type i = 0) noexcept :
+            c_(std::addressof(c)),
+            i_(i)
+        {}
+        template<
+            typename Container2,
+            typename Reference2,
+            typename Enable = std::enable_if_t<
+                !std::is_same<Container, Container2>::value &&
+                std::is_convertible<Container2 *, Container *>::value &&
+                std::is_convertible<Reference2, Reference>::value>>
+        constexpr index_iterator(
+            index_iterator<Container2, Reference2> other) noexcept :
+            c_(other.container()),
+            i_(other.index())
+        {}
+
+        constexpr reference operator*() const
+        {
+            return (*c_)[std::size_t(i_)];
+        }
+        constexpr index_iterator & operator+=(difference_type n) noexcept
+        {
+            i_ += n;
+            return *this;
+        }
+        friend constexpr bool
+        operator==(index_iterator lhs, index_iterator rhs) noexcept
+        {
+            BOOST_ASSERT(lhs.c_ == rhs.c_);
+            return lhs.i_ == rhs.i_;
+        }
+        friend constexpr difference_type
+        operator-(index_iterator lhs, index_iterator rhs) noexcept
+        {
+            BOOST_ASSERT(lhs.c_ == rhs.c_);
+            return lhs.i_ - rhs.i_;
+        }
+
+        /** Returns a pointer to the container. */
+        constexpr Container * container() const noexcept { return c_; }
+        /** Returns the position of the element in the container. */
+        constexpr difference_type index() const noexcept { return i_; }
+
+    private:
+        Container * c_;
+        difference_type i_;
+    };
+
+    /** Returns an `index_iterator` to element `i` of `c`. */
+    template<typename Container>
+    constexpr index_iterator<Container>
+    make_index_iterator(Container & c, std::ptrdiff_t i = 0) noexcept
+    {
+        return index_iterator<Container>(c, i);
+    }
+
+}}}
+
+#endif
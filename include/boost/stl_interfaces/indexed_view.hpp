@@ -0,0 +1,179 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_INDEXED_VIEW_HPP
+#define BOOST_STL_INTERFACES_INDEXED_VIEW_HPP
+
+#include <boost/stl_interfaces/view_interface.hpp>
+
+#include <boost/assert.hpp>
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+    /** A view of the forward range `[first, last)`, with indexed access:
+        `operator[](n)` and `advance(n)` find element `n` in O(`stride`)
+        increments, rather than the O(n) of `std::next(begin(), n)`.
+
+        The view keeps a sparse index of checkpoints, the iterators to
+        every `stride`-th element.  It is built lazily: a lookup past the
+        last checkpoint walks forward from it, recording a checkpoint each
+        `stride` elements, so that the whole range is walked at most once
+        over all lookups, and an index of the first elements only is built
+        if only they are looked up.  The index takes one `Iter` per
+        `stride` elements.
+
+        `begin()` and `end()` are the underlying iterators, so iterating
+        over the view costs nothing extra.  `size()` and `back()` complete
+        the index, and are O(`stride`) after that.
+
+        The index is a cache, and the lookups that extend it are `const`;
+        as with a `std::vector`, concurrent lookups in one view must be
+        synchronized.  A copy of the view shares nothing with the
+        original, but copies its index, which remains valid as long as the
+        underlying range's iterators do.  If the underlying range changes,
+        call `reset_index()`. */
+    template<typename Iter>
+    struct indexed_view : view_interface<indexed_view<Iter>>
+    {
+        static_assert(
+            std::is_convertible<
+                typename std::iterator_traits<Iter>::iterator_category,
+                std::forward_iterator_tag>::value,
+            "indexed_view requires a forward range.");
+
+        using iterator = Iter;
+        using difference_type = v1_dtl::iter_difference_t<Iter>;
+        using reference = typename std::iterator_traits<Iter>::reference;
+
+        /** The default distance between checkpoints. */
+        static constexpr difference_type default_stride = 64;
+
+        indexed_view() = default;
+        indexed_view(
+            Iter first, Iter last, difference_type stride = default_stride) :
+            first_(first), last_(last), stride_(stride)
+        {
+            BOOST_ASSERT(0 < stride);
+        }
+
+        Iter begin() const { return first_; }
+        Iter end() const { return last_; }
+
+        /** Returns an iterator to element `n`, where `n` may be `size()`.
+
+            \pre `0 <= n && n <= size()` */
+        Iter advance(difference_type n) const
+        {
+            BOOST_ASSERT(0 <= n);
+            difference_type const checkpoint = n / stride_;
+            extend(checkpoint);
+            BOOST_ASSERT(
+                checkpoint < difference_type(checkpoints_.size()) &&
+                (!complete_ || n <= size_));
+            Iter retval = checkpoints_[std::size_t(checkpoint)];
+            for (difference_type i = n % stride_; i; --i) {
+                ++retval;
+            }
+            return retval;
+        }
+
+        /** Returns element `n`.
+
+            \pre `0 <= n && n < size()` */
+        reference operator[](difference_type n) const
+        {
+            return *advance(n);
+        }
+
+        /** Returns the number of elements, which counts them the first
+            time it is called. */
+        difference_type size() const
+        {
+            extend(-1);
+            return size_;
+        }
+        /** Returns the last element.
+
+            \pre `!empty()` */
+        reference back() const
+        {
+            BOOST_ASSERT(0 < size());
+            return *advance(size() - 1);
+        }
+
+        /** Returns the distance between the checkpoints. */
+        difference_type stride() const noexcept { return stride_; }
+
+        /** Returns the number of checkpoints in the index so far. */
+        std::size_t checkpoints() const noexcept
+        {
+            return checkpoints_.size();
+        }
+
+        /** Discards the index, so that the next lookup builds it again. */
+        void reset_index() noexcept
+        {
+            checkpoints_.clear();
+            complete_ = false;
+            size_ = 0;
+        }
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+    private:
+        // Walks forward until there is a checkpoint at index checkpoint,
+        // or until the end of the range, when checkpoint is -1 or past
+        // it.
+        void extend(difference_type checkpoint) const
+        {
+            if (checkpoints_.empty())
+                checkpoints_.push_back(first_);
+            while (!complete_ &&
+                   (checkpoint < 0 ||
+                    difference_type(checkpoints_.size()) <= checkpoint)) {
+                Iter it = checkpoints_.back();
+                difference_type i = 0;
+                for (; i < stride_ && it != last_; ++i) {
+                    ++it;
+                }
+                if (i < stride_) {
+                    complete_ = true;
+                    size_ =
+                        difference_type(checkpoints_.size() - 1) * stride_ +
+                        i;
+                } else {
+                    checkpoints_.push_back(it);
+                }
+            }
+        }
+
+        Iter first_ = Iter();
+        Iter last_ = Iter();
+        difference_type stride_ = default_stride;
+        mutable std::vector<Iter> checkpoints_;
+        mutable difference_type size_ = 0;
+        mutable bool complete_ = false;
+#endif
+    };
+
+    /** Returns an `indexed_view` of the forward range `r`, with a
+        checkpoint every `stride` elements. */
+    template<typename Range>
+    auto make_indexed_view(
+        Range && r,
+        v1_dtl::iter_difference_t<decltype(std::begin(r))> stride = 64)
+    {
+        using iter = decltype(std::begin(r));
+        return indexed_view<iter>(std::begin(r), std::end(r), stride);
+    }
+
+}}}
+
+#endif
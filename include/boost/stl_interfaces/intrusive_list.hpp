@@ -0,0 +1,346 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_INTRUSIVE_LIST_HPP
+#define BOOST_STL_INTERFACES_INTRUSIVE_LIST_HPP
+
+#include <boost/stl_interfaces/container_interface.hpp>
+#include <boost/stl_interfaces/reverse_iterator.hpp>
+
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+#include <cassert>
+#include <cstddef>
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+    //[ list_hook_defn
+    // The links of an element in an intrusive_list.  An element has one hook
+    // for each list it can be in at the same time.  A hook that is not in a
+    // list has null links.
+    //
+    // Copying an element does not copy its hooks' links: the copy is in no
+    // list, and an element assigned to stays in the lists it was in.
+    struct list_hook
+    {
+        list_hook() noexcept : prev_(nullptr), next_(nullptr) {}
+        list_hook(list_hook const &) noexcept : list_hook() {}
+        list_hook & operator=(list_hook const &) noexcept { return *this; }
+        // An element must be taken out of its lists before it is destroyed.
+        ~list_hook() { assert(!is_linked()); }
+
+        bool is_linked() const noexcept { return next_ != nullptr; }
+
+        list_hook * prev_;
+        list_hook * next_;
+    };
+    //]
+
+    // Gets an element from the address of its hook.  The hook's offset in a T
+    // is found once, from the address of the hook member of a T-sized buffer
+    // that holds no T.
+    template<typename T, list_hook T::*Hook>
+    struct hook_traits
+    {
+        static T * to_element(list_hook * h) noexcept
+        {
+            return reinterpret_cast<T *>(
+                reinterpret_cast<char *>(h) - offset());
+        }
+
+    private:
+        static std::ptrdiff_t offset() noexcept
+        {
+            union storage
+            {
+                storage() noexcept {}
+                ~storage() {}
+                unsigned char bytes[sizeof(T)];
+                T x;
+            };
+            static storage const s;
+            return reinterpret_cast<unsigned char const *>(&(s.x.*Hook)) -
+                   s.bytes;
+        }
+    };
+
+    //[ intrusive_list_iterator
+    // Walks one of the lists an element is in, from hook to hook, and gets the
+    // element from the hook's address.  The list is circular, through a
+    // sentinel hook in the list object that is the end.
+    template<typename T, list_hook std::remove_const_t<T>::*Hook>
+    struct intrusive_list_iterator : iterator_interface<
+                                         intrusive_list_iterator<T, Hook>,
+                                         std::bidirectional_iterator_tag,
+                                         std::remove_const_t<T>,
+                                         T &,
+                                         T *>
+    {
+        using traits = hook_traits<std::remove_const_t<T>, Hook>;
+
+        intrusive_list_iterator() noexcept : hook_(nullptr) {}
+        explicit intrusive_list_iterator(list_hook * hook) noexcept :
+            hook_(hook)
+        {}
+        template<
+            typename U,
+            typename E = std::enable_if_t<
+                std::is_same<T, U const>::value && !std::is_same<T, U>::value>>
+        intrusive_list_iterator(
+            intrusive_list_iterator<U, Hook> other) noexcept :
+            hook_(other.hook_)
+        {}
+
+        T & operator*() const noexcept { return *traits::to_element(hook_); }
+        intrusive_list_iterator & operator++() noexcept
+        {
+            hook_ = hook_->next_;
+            return *this;
+        }
+        intrusive_list_iterator & operator--() noexcept
+        {
+            hook_ = hook_->prev_;
+            return *this;
+        }
+        friend bool operator==(
+            intrusive_list_iterator lhs, intrusive_list_iterator rhs) noexcept
+        {
+            return lhs.hook_ == rhs.hook_;
+        }
+
+        using base_type = iterator_interface<
+            intrusive_list_iterator<T, Hook>,
+            std::bidirectional_iterator_tag,
+            std::remove_const_t<T>,
+            T &,
+            T *>;
+        using base_type::operator++;
+        using base_type::operator--;
+
+    private:
+        template<typename U, list_hook std::remove_const_t<U>::*H>
+        friend struct intrusive_list_iterator;
+        template<typename U, list_hook U::*H>
+        friend struct intrusive_list;
+
+        list_hook * hook_;
+    };
+    //]
+
+    template<typename T, list_hook T::*Hook>
+    struct intrusive_list;
+
+    // intrusive_list unlinks its elements itself, before its sentinel goes
+    // away; see flat_map.hpp.
+    template<typename T, list_hook T::*Hook>
+    struct trivially_destructible_container<intrusive_list<T, Hook>>
+        : std::true_type
+    {};
+
+    //[ intrusive_list_defn
+    // A doubly linked list of elements that it does not own, linked through
+    // their Hook members.  The list never allocates, copies, or destroys an
+    // element; inserting one links its hook in, and erasing one unlinks it.
+    // The caller keeps each element alive for as long as it is in the list.
+    //
+    // An element can be in several lists at once, through different hooks, and
+    // can be erased from any of them in O(1) given just a reference to it, with
+    // erase(iterator_to(x)).  splice() moves elements between lists by
+    // relinking them.  Since the elements cannot be in two lists through the
+    // same hook, the list cannot be copied, only moved.
+    template<typename T, list_hook T::*Hook>
+    struct intrusive_list : container_interface<intrusive_list<T, Hook>>
+    {
+        // types
+        using value_type = T;
+        using reference = T &;
+        using const_reference = T const &;
+        using iterator = intrusive_list_iterator<T, Hook>;
+        using const_iterator = intrusive_list_iterator<T const, Hook>;
+        using reverse_iterator = stl_interfaces::reverse_iterator<iterator>;
+        using const_reverse_iterator =
+            stl_interfaces::reverse_iterator<const_iterator>;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+
+        // construct/copy/destroy
+        intrusive_list() noexcept : size_(0) { reset(); }
+        intrusive_list(intrusive_list const &) = delete;
+        intrusive_list(intrusive_list && other) noexcept : intrusive_list()
+        {
+            splice(end(), other);
+        }
+        intrusive_list & operator=(intrusive_list const &) = delete;
+        intrusive_list & operator=(intrusive_list && other) noexcept
+        {
+            if (this != &other) {
+                clear();
+                splice(end(), other);
+            }
+            return *this;
+        }
+        ~intrusive_list()
+        {
+            clear();
+            sentinel_.prev_ = sentinel_.next_ = nullptr;
+        }
+
+        // iterators (2 members, skipped 10)
+        iterator begin() noexcept { return iterator(sentinel_.next_); }
+        iterator end() noexcept { return iterator(&sentinel_); }
+
+        // The iterator to x, which must be in this list, or another list linked
+        // through the same hook.
+        static iterator iterator_to(T & x) noexcept
+        {
+            assert((x.*Hook).is_linked());
+            return iterator(&(x.*Hook));
+        }
+        static const_iterator iterator_to(T const & x) noexcept
+        {
+            return iterator_to(const_cast<T &>(x));
+        }
+
+        // capacity
+        size_type size() const noexcept { return size_; }
+
+        // modifiers
+        void push_front(T & x) noexcept { insert(begin(), x); }
+        void push_back(T & x) noexcept { insert(end(), x); }
+        void pop_front() noexcept
+        {
+            assert(!this->empty());
+            this->erase(begin());
+        }
+        void pop_back() noexcept
+        {
+            assert(!this->empty());
+            this->erase(std::prev(end()));
+        }
+        // Links x in before pos.  x must not be in a list through Hook.
+        iterator insert(const_iterator pos, T & x) noexcept
+        {
+            list_hook * const h = &(x.*Hook);
+            assert(!h->is_linked());
+            list_hook * const next = pos.hook_;
+            link(next->prev_, h, h, next);
+            ++size_;
+            return iterator(h);
+        }
+        // Unlinks the elements in [first, last), without destroying them.
+        iterator erase(const_iterator first, const_iterator last) noexcept
+        {
+            list_hook * h = first.hook_;
+            list_hook * const prev = h->prev_;
+            while (h != last.hook_) {
+                list_hook * const next = h->next_;
+                h->prev_ = h->next_ = nullptr;
+                h = next;
+                --size_;
+            }
+            prev->next_ = h;
+            h->prev_ = prev;
+            return iterator(h);
+        }
+        void clear() noexcept { erase(this->cbegin(), this->cend()); }
+        void swap(intrusive_list & other) noexcept
+        {
+            intrusive_list temp(std::move(other));
+            other.splice(other.end(), *this);
+            splice(end(), temp);
+        }
+        friend void swap(intrusive_list & lhs, intrusive_list & rhs) noexcept
+        {
+            lhs.swap(rhs);
+        }
+
+        // list operations
+        //
+        // Each splice() relinks the moved elements in O(1), without touching
+        // them.  Splicing a subrange of another list counts its elements, to
+        // keep both sizes right.
+        void splice(const_iterator pos, intrusive_list & other) noexcept
+        {
+            if (other.empty())
+                return;
+            auto const n = other.size_;
+            splice(pos, other, other.begin(), other.end(), n);
+        }
+        void splice(const_iterator pos, intrusive_list && other) noexcept
+        {
+            splice(pos, other);
+        }
+        void splice(
+            const_iterator pos,
+            intrusive_list & other,
+            const_iterator it) noexcept
+        {
+            splice(pos, other, it, std::next(it), 1);
+        }
+        void splice(
+            const_iterator pos,
+            intrusive_list & other,
+            const_iterator first,
+            const_iterator last) noexcept
+        {
+            if (first == last)
+                return;
+            auto const n = &other == this ? 0 : std::distance(first, last);
+            splice(pos, other, first, last, n);
+        }
+
+        using base_type = container_interface<intrusive_list<T, Hook>>;
+        using base_type::begin;
+        using base_type::end;
+        using base_type::erase;
+
+    private:
+        void reset() noexcept
+        {
+            sentinel_.prev_ = sentinel_.next_ = &sentinel_;
+        }
+
+        // Links the chain of hooks [first, last] in between prev and next.
+        static void link(
+            list_hook * prev,
+            list_hook * first,
+            list_hook * last,
+            list_hook * next) noexcept
+        {
+            prev->next_ = first;
+            first->prev_ = prev;
+            last->next_ = next;
+            next->prev_ = last;
+        }
+
+        void splice(
+            const_iterator pos,
+            intrusive_list & other,
+            const_iterator first_it,
+            const_iterator last_it,
+            difference_type n) noexcept
+        {
+            list_hook * const first = first_it.hook_;
+            list_hook * const last = last_it.hook_->prev_;
+            if (first == pos.hook_ || last_it == pos)
+                return;
+            first->prev_->next_ = last_it.hook_;
+            last_it.hook_->prev_ = first->prev_;
+            link(pos.hook_->prev_, first, last, pos.hook_);
+            other.size_ -= n;
+            size_ += n;
+        }
+
+        list_hook sentinel_;
+        size_type size_;
+    };
+    //]
+
+}}}
+
+#endif
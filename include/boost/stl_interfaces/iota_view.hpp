@@ -0,0 +1,258 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_IOTA_VIEW_HPP
+#define BOOST_STL_INTERFACES_IOTA_VIEW_HPP
+
+#include <boost/stl_interfaces/iterator_interface.hpp>
+#include <boost/stl_interfaces/view_interface.hpp>
+
+#include <boost/assert.hpp>
+
+#include <iterator>
+#include <type_traits>
+
+#include <cstddef>
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+    template<typename Int>
+    struct counting_iterator;
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    namespace v1_dtl {
+        struct iota_identity
+        {
+            template<typename Int>
+            constexpr Int operator()(Int x) const noexcept
+            {
+                return x;
+            }
+        };
+
+        // Writes f(x), f(x + step), ... to the n elements of out.  The
+        // values are kept in eight lanes, each of which steps by 8 * step,
+        // so that the loop is one vector add and store per eight elements
+        // (when f inlines to something vectorizable), even at the -O2 of
+        // compilers that only vectorize loops with no dependence between
+        // their iterations.  The arithmetic is unsigned, so that stepping
+        // past the last value cannot overflow.
+        template<typename Int, typename T, typename F>
+        void iota_generate_n(
+            Int first, std::ptrdiff_t step, std::ptrdiff_t n, T * out, F f)
+        {
+            using uint_type = std::make_unsigned_t<Int>;
+            uint_type x = uint_type(first);
+            uint_type const s = uint_type(step);
+            std::ptrdiff_t const whole = n - n % 8;
+            if (whole) {
+                uint_type lanes[8];
+                for (int j = 0; j < 8; ++j) {
+                    lanes[j] = uint_type(x + uint_type(j) * s);
+                }
+                uint_type const stride = uint_type(uint_type(8) * s);
+                for (std::ptrdiff_t i = 0; i < whole; i += 8) {
+                    for (int j = 0; j < 8; ++j) {
+                        out[i + j] = f(Int(lanes[j]));
+                        lanes[j] = uint_type(lanes[j] + stride);
+                    }
+                }
+                x = lanes[0];
+            }
+            for (int j = 0, tail = int(n - whole); j < tail; ++j) {
+                out[whole + j] = f(Int(x));
+                x = uint_type(x + s);
+            }
+        }
+
+        template<typename Int>
+        using counting_iterator_interface_t = iterator_interface<
+            counting_iterator<Int>,
+            std::random_access_iterator_tag,
+            Int,
+            Int,
+            proxy_arrow_result<Int>,
+            std::ptrdiff_t>;
+    }
+
+#endif
+
+    /** A random access iterator over the integers `first`, `first + step`,
+        `first + 2 * step`, ..., which it computes rather than reads: the
+        element at position `n` is `first + n * step`.
+
+        Like `strided_iterator`, the iterator is `first`, the step and its
+        position, and advancing it, or comparing two of them, touches only
+        the position; so the end of a range whose step does not divide its
+        length is just a position, and no value past the end is formed.
+        Two iterators compared or subtracted must have the same `first` and
+        step.
+
+        It has a `read_n()` member, so the `copy()` from `algorithm.hpp`
+        writes a range of them to an array with a loop that the compiler
+        vectorizes, instead of one iterator increment and dereference at a
+        time; `transform()` does the same for `f(i)`. */
+    template<typename Int>
+    struct counting_iterator : v1_dtl::counting_iterator_interface_t<Int>
+    {
+        static_assert(
+            std::is_integral<Int>::value,
+            "counting_iterator counts over an integral type.");
+
+        using reference = Int;
+        using difference_type = std::ptrdiff_t;
+
+        constexpr counting_iterator() noexcept : first_(0), step_(1), n_(0)
+        {}
+        constexpr explicit counting_iterator(
+            Int first,
+            difference_type step = 1,
+            difference_type n = 0) noexcept :
+            first_(first),
+            step_(step),
+            n_(n)
+        {
+            BOOST_ASSERT(step != 0);
+        }
+
+        constexpr reference operator*() const noexcept
+        {
+            return value(n_);
+        }
+        constexpr counting_iterator & operator+=(difference_type n) noexcept
+        {
+            n_ += n;
+            return *this;
+        }
+        friend constexpr bool
+        operator==(counting_iterator lhs, counting_iterator rhs) noexcept
+        {
+            BOOST_ASSERT(lhs.first_ == rhs.first_ && lhs.step_ == rhs.step_);
+            return lhs.n_ == rhs.n_;
+        }
+        friend constexpr difference_type
+        operator-(counting_iterator lhs, counting_iterator rhs) noexcept
+        {
+            BOOST_ASSERT(lhs.first_ == rhs.first_ && lhs.step_ == rhs.step_);
+            return lhs.n_ - rhs.n_;
+        }
+
+        /** Returns the difference between consecutive values. */
+        constexpr difference_type step() const noexcept { return step_; }
+        /** Returns the position of the iterator, counted in steps from
+            `first`. */
+        constexpr difference_type index() const noexcept { return n_; }
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+    private:
+        friend access;
+
+        // The batch operation behind stl_interfaces::read_n(), which the
+        // copy() overload in algorithm.hpp uses.
+        template<
+            typename T,
+            typename Enable =
+                std::enable_if_t<std::is_convertible<Int, T>::value>>
+        void read_n(difference_type n, T * out) const noexcept
+        {
+            v1_dtl::iota_generate_n(
+                **this, step_, n, out, v1_dtl::iota_identity{});
+        }
+
+        // The arithmetic is done in the difference type, and wraps into
+        // Int, so that an unsigned Int may count down.
+        constexpr Int value(difference_type n) const noexcept
+        {
+            using uint_type = std::make_unsigned_t<Int>;
+            return Int(uint_type(first_) + uint_type(n * step_));
+        }
+
+        Int first_;
+        difference_type step_;
+        difference_type n_;
+#endif
+    };
+
+    /** A view of the integers in `[first, last)`, `step` apart: `first`,
+        `first + step`, ..., up to but not including `last`, or, for a
+        negative `step`, down to but not including `last`.  The elements are
+        computed, not stored, so the view is four words however long it
+        is.  It is the index space of a loop: `parallel_for_each()` over the
+        iterators of an `iota_view` splits the indices among the workers
+        without an array of them.
+        \see `counting_iterator` */
+    template<typename Int>
+    struct iota_view : view_interface<iota_view<Int>>
+    {
+        using iterator = counting_iterator<Int>;
+
+        constexpr iota_view() noexcept : n_(0) {}
+        /** \pre `step != 0`, and `last` is not before `first` in the
+            direction of `step`. */
+        constexpr iota_view(
+            Int first, Int last, std::ptrdiff_t step = 1) noexcept :
+            first_(first, step),
+            n_(count(first, last, step))
+        {}
+
+        constexpr iterator begin() const noexcept { return first_; }
+        constexpr iterator end() const noexcept { return first_ + n_; }
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+    private:
+        // The number of steps of step from first that fall short of last,
+        // rounded up.  The distance is taken in the difference type, so
+        // that an unsigned range that counts down has a negative one.
+        static constexpr std::ptrdiff_t
+        count(Int first, Int last, std::ptrdiff_t step) noexcept
+        {
+            std::ptrdiff_t const d =
+                std::ptrdiff_t(last) - std::ptrdiff_t(first);
+            BOOST_ASSERT(step != 0);
+            BOOST_ASSERT(d == 0 || (0 < d) == (0 < step));
+            return 0 < step ? (d + step - 1) / step : (d + step + 1) / step;
+        }
+
+        iterator first_;
+        std::ptrdiff_t n_;
+#endif
+    };
+
+    /** Writes `f(i)` for each `i` in `[first, last)` to the array at `out`,
+        like `std::transform()`, and returns the end of the output.  The
+        loop computes each `i` rather than going through the iterators, so
+        that when `f` is simple enough, it vectorizes.  Call it unqualified
+        in code that also has `using std::transform;`, and overload
+        resolution picks this `transform()` for `counting_iterator`s.
+
+        \pre `[out, out + (last - first))` is writable. */
+    template<typename Int, typename T, typename F>
+    T * transform(
+        counting_iterator<Int> first,
+        counting_iterator<Int> last,
+        T * out,
+        F f)
+    {
+        auto const n = last - first;
+        if (n <= 0)
+            return out;
+        v1_dtl::iota_generate_n(*first, first.step(), n, out, f);
+        return out + n;
+    }
+
+    /** Returns an `iota_view` of `first`, `first + step`, ..., stopping
+        short of `last`. */
+    template<typename Int>
+    constexpr iota_view<Int>
+    make_iota_view(Int first, Int last, std::ptrdiff_t step = 1) noexcept
+    {
+        return iota_view<Int>(first, last, step);
+    }
+
+}}}
+
+#endif
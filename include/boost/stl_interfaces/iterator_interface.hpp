@@ -8,6 +8,8 @@
 
 #include <boost/stl_interfaces/fwd.hpp>
 
+#include <iterator>
+#include <memory>
 #include <utility>
 #include <type_traits>
 #if 201711L <= __cpp_lib_three_way_comparison
@@ -24,18 +26,129 @@ namespace boost { namespace stl_interfaces {
 #ifndef BOOST_STL_INTERFACES_DOXYGEN
 
         template<typename D>
+        BOOST_STL_INTERFACES_INLINE
         static constexpr auto base(D & d) noexcept
             -> decltype(d.base_reference())
         {
             return d.base_reference();
         }
         template<typename D>
+        BOOST_STL_INTERFACES_INLINE
         static constexpr auto base(D const & d) noexcept
             -> decltype(d.base_reference())
         {
             return d.base_reference();
         }
 
+        template<typename D>
+        BOOST_STL_INTERFACES_INLINE
+        static constexpr auto segment(D const & d) noexcept(
+            noexcept(d.segment())) -> decltype(d.segment())
+        {
+            return d.segment();
+        }
+        template<typename D>
+        BOOST_STL_INTERFACES_INLINE
+        static constexpr auto local(D const & d) noexcept(noexcept(d.local()))
+            -> decltype(d.local())
+        {
+            return d.local();
+        }
+        template<typename D, typename SegmentIter>
+        BOOST_STL_INTERFACES_INLINE
+        static constexpr auto
+        local_begin(D const & d, SegmentIter seg) noexcept(
+            noexcept(d.local_begin(seg))) -> decltype(d.local_begin(seg))
+        {
+            return d.local_begin(seg);
+        }
+        template<typename D, typename SegmentIter>
+        BOOST_STL_INTERFACES_INLINE
+        static constexpr auto local_end(D const & d, SegmentIter seg) noexcept(
+            noexcept(d.local_end(seg))) -> decltype(d.local_end(seg))
+        {
+            return d.local_end(seg);
+        }
+        template<typename D, typename SegmentIter, typename LocalIter>
+        BOOST_STL_INTERFACES_INLINE
+        static constexpr auto
+        compose(D const & d, SegmentIter seg, LocalIter it) noexcept(
+            noexcept(d.compose(seg, it))) -> decltype(d.compose(seg, it))
+        {
+            return d.compose(seg, it);
+        }
+
+        template<typename D, typename Difference>
+        BOOST_STL_INTERFACES_INLINE
+        static constexpr auto advance_n(D & d, Difference n) noexcept(
+            noexcept(d.advance_n(n))) -> decltype(d.advance_n(n))
+        {
+            return d.advance_n(n);
+        }
+        template<typename D>
+        BOOST_STL_INTERFACES_INLINE
+        static constexpr auto
+        distance_to(D const & d, D const & other) noexcept(
+            noexcept(d.distance_to(other))) -> decltype(d.distance_to(other))
+        {
+            return d.distance_to(other);
+        }
+        template<typename D, typename Difference, typename T>
+        BOOST_STL_INTERFACES_INLINE
+        static constexpr auto
+        read_n(D const & d, Difference n, T * out) noexcept(
+            noexcept(d.read_n(n, out))) -> decltype(d.read_n(n, out))
+        {
+            return d.read_n(n, out);
+        }
+        template<typename D, typename Difference, typename T>
+        BOOST_STL_INTERFACES_INLINE
+        static constexpr auto
+        write_n(D const & d, Difference n, T const * in) noexcept(
+            noexcept(d.write_n(n, in))) -> decltype(d.write_n(n, in))
+        {
+            return d.write_n(n, in);
+        }
+
+        template<typename D>
+        BOOST_STL_INTERFACES_INLINE
+        static constexpr auto uncached_begin(D & d) noexcept(
+            noexcept(d.uncached_begin())) -> decltype(d.uncached_begin())
+        {
+            return d.uncached_begin();
+        }
+
+        template<typename D>
+        BOOST_STL_INTERFACES_INLINE
+        static constexpr auto cheap_empty(D & d) noexcept(
+            noexcept(d.cheap_empty())) -> decltype(d.cheap_empty())
+        {
+            return d.cheap_empty();
+        }
+        template<typename D>
+        BOOST_STL_INTERFACES_INLINE
+        static constexpr auto cheap_size(D & d) noexcept(
+            noexcept(d.cheap_size())) -> decltype(d.cheap_size())
+        {
+            return d.cheap_size();
+        }
+
+        template<typename D>
+        BOOST_STL_INTERFACES_INLINE
+        static constexpr auto invalidate_iterators(D & d) noexcept
+            -> decltype(d.invalidate_iterators())
+        {
+            d.invalidate_iterators();
+        }
+
+        template<typename D>
+        BOOST_STL_INTERFACES_INLINE
+        static constexpr auto leaf_at(D const & d, std::size_t i) noexcept(
+            noexcept(d.leaf_at(i))) -> decltype(d.leaf_at(i))
+        {
+            return d.leaf_at(i);
+        }
+
 #endif
     };
 
@@ -44,20 +157,77 @@ namespace boost { namespace stl_interfaces {
         This template is used as the default `Pointer` template parameter in
         the `proxy_iterator_interface` template alias.  Note that the use of
         this template implies a copy or move of the underlying object of type
-        `T`. */
+        `T`.  \see `in_place_proxy_arrow_result` */
     template<typename T>
     struct proxy_arrow_result
     {
+        BOOST_STL_INTERFACES_INLINE
         constexpr proxy_arrow_result(T const & value) noexcept(
             noexcept(T(value))) :
             value_(value)
         {}
+        BOOST_STL_INTERFACES_INLINE
         constexpr proxy_arrow_result(T && value) noexcept(
             noexcept(T(std::move(value)))) :
             value_(std::move(value))
         {}
 
+        BOOST_STL_INTERFACES_INLINE
         constexpr T const * operator->() const noexcept { return &value_; }
+        BOOST_STL_INTERFACES_INLINE
+        constexpr T * operator->() noexcept { return &value_; }
+
+    private:
+        T value_;
+    };
+
+    /** The type of `proxy_arrow_deref`. */
+    struct proxy_arrow_deref_t
+    {
+        explicit proxy_arrow_deref_t() = default;
+    };
+
+    /** A tag used by `iterator_interface` to construct its `Pointer` type
+        directly from the iterator, rather than from the result of
+        dereferencing it.  \see `in_place_proxy_arrow_result` */
+    constexpr proxy_arrow_deref_t proxy_arrow_deref{};
+
+    /** An alternative to `proxy_arrow_result`, for use as the `Pointer`
+        template parameter of `iterator_interface`.
+
+        `proxy_arrow_result<T>` is constructed from the `T` that `*it`
+        returns, which it then copies or moves into itself.
+        `in_place_proxy_arrow_result<T>` is instead constructed from the
+        iterator, and initializes its `T` with `*it` directly, so the `T`
+        returned by `*it` is the one `operator->()` refers to; there is no
+        intermediate copy or move.  This matters when `T` is expensive to
+        move, such as a tuple of many references, or a proxy that owns
+        resources.
+
+        To use it, pass it to `iterator_interface` in place of the `Pointer`
+        that `proxy_iterator_interface` would use:
+
+        \code
+        struct my_iterator : iterator_interface<
+            my_iterator,
+            std::random_access_iterator_tag,
+            row,
+            row_reference,
+            in_place_proxy_arrow_result<row_reference>>
+        \endcode */
+    template<typename T>
+    struct in_place_proxy_arrow_result
+    {
+        template<typename Iter>
+        BOOST_STL_INTERFACES_INLINE
+        constexpr in_place_proxy_arrow_result(
+            proxy_arrow_deref_t, Iter const & it) noexcept(noexcept(T(*it))) :
+            value_(*it)
+        {}
+
+        BOOST_STL_INTERFACES_INLINE
+        constexpr T const * operator->() const noexcept { return &value_; }
+        BOOST_STL_INTERFACES_INLINE
         constexpr T * operator->() noexcept { return &value_; }
 
     private:
@@ -93,13 +263,19 @@ namespace boost { namespace stl_interfaces {
         {
             using type = std::random_access_iterator_tag;
         };
-#elif 201703L <= __cplusplus && __has_include(<stl2/ranges.hpp>) && \
-    !defined(BOOST_STL_INTERFACES_DISABLE_CMCSTL2)
+#else
+        template<>
+        struct concept_category<v1::contiguous_iterator_tag>
+        {
+            using type = std::random_access_iterator_tag;
+        };
+#ifdef BOOST_STL_INTERFACES_USE_CMCSTL2
         template<>
         struct concept_category<v2::ranges::contiguous_iterator_tag>
         {
             using type = std::random_access_iterator_tag;
         };
+#endif
 #endif
         template<typename IteratorConcept>
         using concept_category_t =
@@ -154,6 +330,7 @@ namespace boost { namespace stl_interfaces {
             bool UseBase = detector<void, use_base, T>::value>
         struct common_eq
         {
+            BOOST_STL_INTERFACES_INLINE
             static constexpr auto call(T lhs, U rhs)
             {
                 return static_cast<common_t<T, U>>(lhs).derived() ==
@@ -163,6 +340,7 @@ namespace boost { namespace stl_interfaces {
         template<typename T, typename U>
         struct common_eq<T, U, true>
         {
+            BOOST_STL_INTERFACES_INLINE
             static constexpr auto call(T lhs, U rhs)
             {
                 return access::base(lhs) == access::base(rhs);
@@ -170,6 +348,7 @@ namespace boost { namespace stl_interfaces {
         };
 
         template<typename T, typename U>
+        BOOST_STL_INTERFACES_INLINE
         constexpr auto common_diff(T lhs, U rhs) noexcept(noexcept(
             static_cast<common_t<T, U>>(lhs) -
             static_cast<common_t<T, U>>(rhs)))
@@ -180,6 +359,36 @@ namespace boost { namespace stl_interfaces {
             return static_cast<common_t<T, U>>(lhs) -
                    static_cast<common_t<T, U>>(rhs);
         }
+
+        template<typename Pointer, typename Iter>
+        using in_place_arrow_t =
+            decltype(Pointer(proxy_arrow_deref, std::declval<Iter const &>()));
+
+        // Pointer types like in_place_proxy_arrow_result are constructed
+        // from the iterator itself; all others from *it.
+        template<typename Pointer, typename Iter>
+        BOOST_STL_INTERFACES_INLINE
+        constexpr auto make_arrow(Iter const & it, std::true_type) noexcept(
+            noexcept(Pointer(proxy_arrow_deref, it)))
+        {
+            return Pointer(proxy_arrow_deref, it);
+        }
+        template<typename Pointer, typename Iter>
+        BOOST_STL_INTERFACES_INLINE
+        constexpr auto make_arrow(Iter const & it, std::false_type) noexcept(
+            noexcept(detail::make_pointer<Pointer>(*it)))
+        {
+            return detail::make_pointer<Pointer>(*it);
+        }
+        template<typename Pointer, typename Iter>
+        BOOST_STL_INTERFACES_INLINE
+        constexpr auto make_arrow(Iter const & it) noexcept(
+            noexcept(detail::make_arrow<Pointer>(
+                it, detector<void, in_place_arrow_t, Pointer, Iter>{})))
+        {
+            return detail::make_arrow<Pointer>(
+                it, detector<void, in_place_arrow_t, Pointer, Iter>{});
+        }
     }
 
 }}
@@ -193,7 +402,12 @@ namespace boost { namespace stl_interfaces { inline namespace v1 {
         incomplete type.  Before any member of the resulting specialization of
         `iterator_interface` other than special member functions is
         referenced, `D` shall be complete, and model
-        `std::derived_from<iterator_interface<D>>`. */
+        `std::derived_from<iterator_interface<D>>`.
+
+        `iterator_interface` is an empty base with no virtual functions, so
+        it adds no storage to `D`, and leaves it trivially copyable and
+        standard layout if its members are; such iterators are passed to
+        and returned from functions in registers. */
     template<
         typename Derived,
         typename IteratorConcept,
@@ -271,10 +485,12 @@ namespace boost { namespace stl_interfaces { inline namespace v1 {
     {
 #ifndef BOOST_STL_INTERFACES_DOXYGEN
     private:
+        BOOST_STL_INTERFACES_INLINE
         constexpr Derived & derived() noexcept
         {
             return static_cast<Derived &>(*this);
         }
+        BOOST_STL_INTERFACES_INLINE
         constexpr Derived const & derived() const noexcept
         {
             return static_cast<Derived const &>(*this);
@@ -293,6 +509,7 @@ namespace boost { namespace stl_interfaces { inline namespace v1 {
         using difference_type = DifferenceType;
 
         template<typename D = Derived>
+        BOOST_STL_INTERFACES_INLINE
         constexpr auto operator*() const
             noexcept(noexcept(*access::base(std::declval<D const &>())))
                 -> decltype(*access::base(std::declval<D const &>()))
@@ -301,13 +518,15 @@ namespace boost { namespace stl_interfaces { inline namespace v1 {
         }
 
         template<typename D = Derived>
+        BOOST_STL_INTERFACES_INLINE
         constexpr pointer operator->() const noexcept(
-            noexcept(detail::make_pointer<pointer>(*std::declval<D const &>())))
+            noexcept(detail::make_arrow<pointer>(std::declval<D const &>())))
         {
-            return detail::make_pointer<pointer>(*derived());
+            return detail::make_arrow<pointer>(derived());
         }
 
         template<typename D = Derived>
+        BOOST_STL_INTERFACES_INLINE
         constexpr auto operator[](difference_type i) const noexcept(noexcept(
             D(std::declval<D const &>()),
             std::declval<D &>() += i,
@@ -323,6 +542,7 @@ namespace boost { namespace stl_interfaces { inline namespace v1 {
             typename D = Derived,
             typename Enable =
                 std::enable_if_t<!v1_dtl::plus_eq<D, difference_type>::value>>
+        BOOST_STL_INTERFACES_INLINE
         constexpr auto
         operator++() noexcept(noexcept(++access::base(std::declval<D &>())))
             -> decltype(++access::base(std::declval<D &>()))
@@ -331,6 +551,7 @@ namespace boost { namespace stl_interfaces { inline namespace v1 {
         }
 
         template<typename D = Derived>
+        BOOST_STL_INTERFACES_INLINE
         constexpr auto operator++() noexcept(
             noexcept(std::declval<D &>() += difference_type(1)))
             -> decltype(
@@ -340,6 +561,7 @@ namespace boost { namespace stl_interfaces { inline namespace v1 {
             return derived();
         }
         template<typename D = Derived>
+        BOOST_STL_INTERFACES_INLINE
         constexpr auto operator++(int)noexcept(
             noexcept(D(std::declval<D &>()), ++std::declval<D &>()))
             -> std::remove_reference_t<decltype(
@@ -353,6 +575,7 @@ namespace boost { namespace stl_interfaces { inline namespace v1 {
         }
 
         template<typename D = Derived>
+        BOOST_STL_INTERFACES_INLINE
         constexpr auto operator+=(difference_type n) noexcept(
             noexcept(access::base(std::declval<D &>()) += n))
             -> decltype(access::base(std::declval<D &>()) += n)
@@ -361,6 +584,7 @@ namespace boost { namespace stl_interfaces { inline namespace v1 {
         }
 
         template<typename D = Derived>
+        BOOST_STL_INTERFACES_INLINE
         constexpr D operator+(difference_type i) const
             noexcept(noexcept(D(std::declval<D &>()), std::declval<D &>() += i))
         {
@@ -368,16 +592,20 @@ namespace boost { namespace stl_interfaces { inline namespace v1 {
             retval += i;
             return retval;
         }
-        friend BOOST_STL_INTERFACES_HIDDEN_FRIEND_CONSTEXPR Derived
+#ifndef BOOST_STL_INTERFACES_NO_HIDDEN_FRIEND_CONSTEXPR
+        BOOST_STL_INTERFACES_INLINE
+        friend constexpr Derived
         operator+(difference_type i, Derived it) noexcept(noexcept(it + i))
         {
             return it + i;
         }
+#endif
 
         template<
             typename D = Derived,
             typename Enable =
                 std::enable_if_t<!v1_dtl::plus_eq<D, difference_type>::value>>
+        BOOST_STL_INTERFACES_INLINE
         constexpr auto
         operator--() noexcept(noexcept(--access::base(std::declval<D &>())))
             -> decltype(--access::base(std::declval<D &>()))
@@ -386,6 +614,7 @@ namespace boost { namespace stl_interfaces { inline namespace v1 {
         }
 
         template<typename D = Derived>
+        BOOST_STL_INTERFACES_INLINE
         constexpr auto operator--() noexcept(noexcept(
             D(std::declval<D &>()), std::declval<D &>() += -difference_type(1)))
             -> decltype(
@@ -395,6 +624,7 @@ namespace boost { namespace stl_interfaces { inline namespace v1 {
             return derived();
         }
         template<typename D = Derived>
+        BOOST_STL_INTERFACES_INLINE
         constexpr auto operator--(int)noexcept(
             noexcept(D(std::declval<D &>()), --std::declval<D &>()))
             -> std::remove_reference_t<decltype(
@@ -408,6 +638,7 @@ namespace boost { namespace stl_interfaces { inline namespace v1 {
         }
 
         template<typename D = Derived>
+        BOOST_STL_INTERFACES_INLINE
         constexpr D & operator-=(difference_type i) noexcept(
             noexcept(std::declval<D &>() += -i))
         {
@@ -416,6 +647,7 @@ namespace boost { namespace stl_interfaces { inline namespace v1 {
         }
 
         template<typename D = Derived>
+        BOOST_STL_INTERFACES_INLINE
         constexpr auto operator-(D other) const noexcept(noexcept(
             access::base(std::declval<D const &>()) - access::base(other)))
             -> decltype(
@@ -424,7 +656,9 @@ namespace boost { namespace stl_interfaces { inline namespace v1 {
             return access::base(derived()) - access::base(other);
         }
 
-        friend BOOST_STL_INTERFACES_HIDDEN_FRIEND_CONSTEXPR Derived operator-(
+#ifndef BOOST_STL_INTERFACES_NO_HIDDEN_FRIEND_CONSTEXPR
+        BOOST_STL_INTERFACES_INLINE
+        friend constexpr Derived operator-(
             Derived it,
             difference_type i) noexcept(noexcept(Derived(it), it += -i))
         {
@@ -432,8 +666,37 @@ namespace boost { namespace stl_interfaces { inline namespace v1 {
             retval += -i;
             return retval;
         }
+#endif
     };
 
+#ifdef BOOST_STL_INTERFACES_NO_HIDDEN_FRIEND_CONSTEXPR
+    /** Implementation of `i + it`, for all iterators derived from
+        `iterator_interface` that have `it + i`.  It is a hidden friend of
+        `iterator_interface` on compilers on which a hidden friend can be
+        `constexpr`, and this template elsewhere. */
+    template<typename D>
+    BOOST_STL_INTERFACES_INLINE
+    constexpr auto operator+(
+        typename D::difference_type i, D it) noexcept(noexcept(it + i))
+        -> decltype(v1_dtl::derived_iterator(it), D(it + i))
+    {
+        return it + i;
+    }
+
+    /** Implementation of `it - i`, for all iterators derived from
+        `iterator_interface` that have `it += i`, like `operator+()`. */
+    template<typename D>
+    BOOST_STL_INTERFACES_INLINE
+    constexpr auto operator-(D it, typename D::difference_type i) noexcept(
+        noexcept(D(it), it += -i))
+        -> decltype(v1_dtl::derived_iterator(it), it += -i, D(it))
+    {
+        D retval = it;
+        retval += -i;
+        return retval;
+    }
+#endif
+
     /** Implementation of `operator==()`, implemented in terms of the iterator
         underlying IteratorInterface, for all iterators derived from
         `iterator_interface`, except those with an iterator category derived
@@ -443,6 +706,7 @@ namespace boost { namespace stl_interfaces { inline namespace v1 {
         typename IteratorInterface2,
         typename Enable =
             std::enable_if_t<!v1_dtl::ra_iter<IteratorInterface1>::value>>
+    BOOST_STL_INTERFACES_INLINE
     constexpr auto
     operator==(IteratorInterface1 lhs, IteratorInterface2 rhs) noexcept
         -> decltype(
@@ -460,6 +724,7 @@ namespace boost { namespace stl_interfaces { inline namespace v1 {
         typename IteratorInterface2,
         typename Enable =
             std::enable_if_t<v1_dtl::ra_iter<IteratorInterface1>::value>>
+    BOOST_STL_INTERFACES_INLINE
     constexpr auto
     operator==(IteratorInterface1 lhs, IteratorInterface2 rhs) noexcept(
         noexcept(detail::common_diff(lhs, rhs)))
@@ -472,6 +737,7 @@ namespace boost { namespace stl_interfaces { inline namespace v1 {
     /** Implementation of `operator!=()` for all iterators derived from
         `iterator_interface`.  */
     template<typename IteratorInterface1, typename IteratorInterface2>
+    BOOST_STL_INTERFACES_INLINE
     constexpr auto operator!=(
         IteratorInterface1 lhs,
         IteratorInterface2 rhs) noexcept(noexcept(!(lhs == rhs)))
@@ -484,6 +750,7 @@ namespace boost { namespace stl_interfaces { inline namespace v1 {
         `iterator_interface` that have an iterator category derived from
         `std::random_access_iterator_tag`.  */
     template<typename IteratorInterface1, typename IteratorInterface2>
+    BOOST_STL_INTERFACES_INLINE
     constexpr auto
     operator<(IteratorInterface1 lhs, IteratorInterface2 rhs) noexcept(
         noexcept(detail::common_diff(lhs, rhs)))
@@ -497,6 +764,7 @@ namespace boost { namespace stl_interfaces { inline namespace v1 {
         `iterator_interface` that have an iterator category derived from
         `std::random_access_iterator_tag`.  */
     template<typename IteratorInterface1, typename IteratorInterface2>
+    BOOST_STL_INTERFACES_INLINE
     constexpr auto
     operator<=(IteratorInterface1 lhs, IteratorInterface2 rhs) noexcept(
         noexcept(detail::common_diff(lhs, rhs)))
@@ -510,6 +778,7 @@ namespace boost { namespace stl_interfaces { inline namespace v1 {
         `iterator_interface` that have an iterator category derived from
         `std::random_access_iterator_tag`.  */
     template<typename IteratorInterface1, typename IteratorInterface2>
+    BOOST_STL_INTERFACES_INLINE
     constexpr auto
     operator>(IteratorInterface1 lhs, IteratorInterface2 rhs) noexcept(
         noexcept(detail::common_diff(lhs, rhs)))
@@ -523,6 +792,7 @@ namespace boost { namespace stl_interfaces { inline namespace v1 {
         `iterator_interface` that have an iterator category derived from
         `std::random_access_iterator_tag`.  */
     template<typename IteratorInterface1, typename IteratorInterface2>
+    BOOST_STL_INTERFACES_INLINE
     constexpr auto
     operator>=(IteratorInterface1 lhs, IteratorInterface2 rhs) noexcept(
         noexcept(detail::common_diff(lhs, rhs)))
@@ -533,6 +803,348 @@ namespace boost { namespace stl_interfaces { inline namespace v1 {
     }
 
 
+    namespace v1_dtl {
+        template<typename Iter>
+        using pointer_traits_to_address_t =
+            decltype(std::pointer_traits<Iter>::to_address(
+                std::declval<Iter const &>()));
+        template<typename Iter>
+        using base_t = decltype(access::base(std::declval<Iter const &>()));
+        template<typename Iter>
+        using arrow_t = decltype(std::declval<Iter const &>().operator->());
+
+        template<typename Iter, typename = void>
+        struct arrow_is_pointer : std::false_type
+        {
+        };
+        template<typename Iter>
+        struct arrow_is_pointer<Iter, void_t<arrow_t<Iter>>>
+            : std::is_pointer<arrow_t<Iter>>
+        {
+        };
+
+        // 1: pointer_traits<Iter>::to_address(), 2: access::base(),
+        // 3: operator->() (only when it yields a raw pointer), 0: none.
+        template<typename Iter>
+        using to_address_kind = std::integral_constant<
+            int,
+            detail::detector<void, pointer_traits_to_address_t, Iter>::value
+                ? 1
+                : detail::detector<void, base_t, Iter>::value
+                      ? 2
+                      : detail::detector<void, arrow_t, Iter>::value
+                            ? 3
+                            : 0>;
+
+        template<typename Iter, typename = void>
+        struct contiguous_iter : std::false_type
+        {
+        };
+        template<typename T>
+        struct contiguous_iter<T *> : std::true_type
+        {
+        };
+        template<typename Iter>
+        struct contiguous_iter<
+            Iter,
+            void_t<typename Iter::iterator_concept>>
+            : std::is_base_of<
+                  contiguous_iterator_tag,
+                  typename Iter::iterator_concept>
+        {
+        };
+    }
+
+    /** `std::true_type` if `Iter` is a pointer, or an iterator whose
+        `iterator_concept` is (or is derived from) `contiguous_iterator_tag`;
+        `std::false_type` otherwise. */
+    template<typename Iter>
+    using is_contiguous_iterator = v1_dtl::contiguous_iter<Iter>;
+
+    /** Returns `p`.  This is a pre-C++20 version of `std::to_address()` (see
+        [pointer.conversion] in the C++ standard). */
+    template<typename T>
+    constexpr T * to_address(T * p) noexcept
+    {
+        static_assert(!std::is_function<T>::value, "");
+        return p;
+    }
+
+    namespace v1_dtl {
+        template<typename Iter, int Kind = to_address_kind<Iter>::value>
+        struct to_address_impl
+        {
+        };
+        template<typename Iter>
+        struct to_address_impl<Iter, 1>
+        {
+            static constexpr auto call(Iter const & it) noexcept
+            {
+                return std::pointer_traits<Iter>::to_address(it);
+            }
+        };
+        // The address of an underlying iterator, which may itself be an
+        // iterator_interface iterator whose underlying iterator is a
+        // pointer.
+        template<typename T>
+        constexpr T * base_address(T * p) noexcept
+        {
+            return p;
+        }
+        template<typename Iter>
+        constexpr auto base_address(Iter const & it) noexcept
+        {
+            return to_address_impl<Iter>::call(it);
+        }
+
+        template<typename Iter>
+        struct to_address_impl<Iter, 2>
+        {
+            static constexpr auto call(Iter const & it) noexcept
+            {
+                return v1_dtl::base_address(access::base(it));
+            }
+        };
+        template<typename Iter>
+        struct to_address_impl<Iter, 3>
+        {
+            static constexpr auto call(Iter const & it) noexcept
+            {
+                return stl_interfaces::to_address(it.operator->());
+            }
+        };
+    }
+
+    /** Returns the address of the element `it` refers to, without
+        dereferencing `it`, so that it may be used on the end iterator of a
+        contiguous range.  This is a pre-C++20 version of `std::to_address()`
+        that also understands `iterator_interface` iterators: the address is
+        taken from `std::pointer_traits<Iter>::to_address()` if that exists,
+        otherwise from the underlying iterator of an `iterator_interface`
+        that uses `access::base()`, and otherwise from `it.operator->()`.
+
+        This function only participates in overload resolution when one of
+        those is available.  \see `is_contiguous_iterator` */
+    template<
+        typename Iter
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+        ,
+        typename Enable = std::enable_if_t<
+            !std::is_pointer<Iter>::value &&
+            (v1_dtl::to_address_kind<Iter>::value == 1 ||
+             v1_dtl::to_address_kind<Iter>::value == 2 ||
+             (v1_dtl::to_address_kind<Iter>::value == 3 &&
+              v1_dtl::arrow_is_pointer<Iter>::value))>
+#endif
+        >
+    constexpr auto to_address(Iter const & it) noexcept
+    {
+        return v1_dtl::to_address_impl<Iter>::call(it);
+    }
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    namespace v1_dtl {
+        template<typename Iter>
+        using advance_n_t = decltype(access::advance_n(
+            std::declval<Iter &>(), std::declval<iter_difference_t<Iter>>()));
+        template<typename Iter>
+        using distance_to_t = decltype(access::distance_to(
+            std::declval<Iter const &>(), std::declval<Iter const &>()));
+
+        template<typename Iter, typename T>
+        using read_n_t = decltype(access::read_n(
+            std::declval<Iter const &>(),
+            std::declval<iter_difference_t<Iter>>(),
+            std::declval<T *>()));
+        template<typename Iter, typename T>
+        using write_n_t = decltype(access::write_n(
+            std::declval<Iter const &>(),
+            std::declval<iter_difference_t<Iter>>(),
+            std::declval<T const *>()));
+
+        template<typename Iter>
+        using has_advance_n = detail::detector<void, advance_n_t, Iter>;
+        template<typename Iter>
+        using has_distance_to = detail::detector<void, distance_to_t, Iter>;
+        template<typename Iter, typename T>
+        using has_read_n = detail::detector<void, read_n_t, Iter, T>;
+        template<typename Iter, typename T>
+        using has_write_n = detail::detector<void, write_n_t, Iter, T>;
+
+        struct advance_fn
+        {
+            template<typename Iter>
+            constexpr void
+            operator()(Iter & it, iter_difference_t<Iter> n) const
+            {
+                impl(it, n, has_advance_n<Iter>{});
+            }
+
+        private:
+            template<typename Iter>
+            static constexpr void
+            impl(Iter & it, iter_difference_t<Iter> n, std::true_type)
+            {
+                access::advance_n(it, n);
+            }
+            template<typename Iter>
+            static constexpr void
+            impl(Iter & it, iter_difference_t<Iter> n, std::false_type)
+            {
+                std::advance(it, n);
+            }
+        };
+
+        struct next_fn
+        {
+            template<typename Iter>
+            constexpr Iter
+            operator()(Iter it, iter_difference_t<Iter> n = 1) const
+            {
+                advance_fn{}(it, n);
+                return it;
+            }
+        };
+
+        struct distance_fn
+        {
+            template<typename Iter>
+            constexpr iter_difference_t<Iter>
+            operator()(Iter first, Iter last) const
+            {
+                return impl(first, last, has_distance_to<Iter>{});
+            }
+
+        private:
+            template<typename Iter>
+            static constexpr iter_difference_t<Iter>
+            impl(Iter const & first, Iter const & last, std::true_type)
+            {
+                return access::distance_to(first, last);
+            }
+            template<typename Iter>
+            static constexpr iter_difference_t<Iter>
+            impl(Iter const & first, Iter const & last, std::false_type)
+            {
+                return std::distance(first, last);
+            }
+        };
+
+        struct read_n_fn
+        {
+            template<typename Iter, typename T>
+            constexpr T *
+            operator()(Iter it, iter_difference_t<Iter> n, T * out) const
+            {
+                return impl(it, n, out, has_read_n<Iter, T>{});
+            }
+
+        private:
+            template<typename Iter, typename T>
+            static constexpr T * impl(
+                Iter const & it,
+                iter_difference_t<Iter> n,
+                T * out,
+                std::true_type)
+            {
+                access::read_n(it, n, out);
+                return out + n;
+            }
+            template<typename Iter, typename T>
+            static constexpr T * impl(
+                Iter it, iter_difference_t<Iter> n, T * out, std::false_type)
+            {
+                for (; 0 < n; --n, ++it, ++out) {
+                    *out = *it;
+                }
+                return out;
+            }
+        };
+
+        struct write_n_fn
+        {
+            template<typename T, typename Iter>
+            constexpr Iter
+            operator()(T const * in, iter_difference_t<Iter> n, Iter out) const
+            {
+                return impl(in, n, out, has_write_n<Iter, T>{});
+            }
+
+        private:
+            template<typename T, typename Iter>
+            static constexpr Iter impl(
+                T const * in,
+                iter_difference_t<Iter> n,
+                Iter out,
+                std::true_type)
+            {
+                access::write_n(out, n, in);
+                return next_fn{}(out, n);
+            }
+            template<typename T, typename Iter>
+            static constexpr Iter impl(
+                T const * in,
+                iter_difference_t<Iter> n,
+                Iter out,
+                std::false_type)
+            {
+                for (; 0 < n; --n, ++in, ++out) {
+                    *out = *in;
+                }
+                return out;
+            }
+        };
+    }
+
+#endif
+
+    /** Advances `it` by `n`, like `std::advance()`.  If `it` has an
+        `advance_n(n)` member that advances it by `n` in one step, this calls
+        it, and otherwise calls `std::advance()`.
+
+        This lets an iterator that is not random access, but that can skip
+        ahead faster than one element at a time -- a rope or skip list
+        iterator, for instance -- tell generic code how to do so.
+        `advance_n()` may be private, if the iterator befriends `access`.
+
+        This is a function object rather than a function, so that it does not
+        take part in argument-dependent lookup, and unqualified calls to
+        `advance()` mean the same thing they did before.
+        \see `next`, `distance` */
+    constexpr v1_dtl::advance_fn advance{};
+
+    /** Returns a copy of `it` advanced by `n`, like `std::next()`, using
+        `advance`. */
+    constexpr v1_dtl::next_fn next{};
+
+    /** Returns the number of increments from `first` to `last`, like
+        `std::distance()`.  If `first` has a `distance_to(last)` member that
+        computes that number, this calls it, and otherwise calls
+        `std::distance()`.  `distance_to()` may be private, if the iterator
+        befriends `access`.  \see `advance` */
+    constexpr v1_dtl::distance_fn distance{};
+
+    /** Copies the `n` elements starting at `it` to the array at `out`, and
+        returns `out + n`.  If `it` has a `read_n(n, out)` member that does
+        this, this calls it, and otherwise copies one element at a time.
+
+        This lets a proxy iterator -- over bit-packed integers, say, or a
+        zip of several arrays -- decode a whole block of elements at once,
+        in code the compiler can vectorize, instead of building and
+        converting one proxy reference per element.  `read_n()` may be
+        private, if the iterator befriends `access`.  The `copy()` and
+        `transform()` overloads in `algorithm.hpp` use it.  \see
+        `write_n` */
+    constexpr v1_dtl::read_n_fn read_n{};
+
+    /** Copies the `n` elements of the array at `in` to the elements
+        starting at `out`, and returns `out` advanced by `n`.  If `out` has a
+        `write_n(n, in)` member that does this, this calls it, and otherwise
+        copies one element at a time.  This is the inverse of `read_n`, for
+        encoding a block of elements at once. */
+    constexpr v1_dtl::write_n_fn write_n{};
+
     /** A template alias useful for defining proxy iterators.  \see
         `iterator_interface`. */
     template<
@@ -560,7 +1172,9 @@ namespace boost { namespace stl_interfaces { namespace v2 {
 
     // clang-format off
 
-#if 201703L < __cplusplus && defined(__cpp_lib_concepts) || BOOST_STL_INTERFACES_DOXYGEN
+#if 201703L < __cplusplus && defined(__cpp_lib_concepts) &&                    \
+        !defined(BOOST_STL_INTERFACES_DISABLE_V2) ||                           \
+    BOOST_STL_INTERFACES_DOXYGEN
 
     /** A CRTP template that one may derive from to make defining iterators
         easier.
@@ -606,15 +1220,15 @@ namespace boost { namespace stl_interfaces { namespace v2 {
 
       constexpr auto operator->()
         requires requires { *derived(); } {
-          return detail::make_pointer<pointer>(*derived());
+          return detail::make_arrow<pointer>(derived());
         }
       constexpr auto operator->() const
         requires requires { *derived(); } {
-          return detail::make_pointer<pointer>(*derived());
+          return detail::make_arrow<pointer>(derived());
         }
 
       constexpr decltype(auto) operator[](difference_type n) const
-        requires requires { derived() += n; } {
+        requires requires (D it) { it += n; } {
         D retval = derived();
         retval += n;
         return *retval;
@@ -622,7 +1236,7 @@ namespace boost { namespace stl_interfaces { namespace v2 {
 
       constexpr decltype(auto) operator++()
         requires requires { ++access::base(derived()); } &&
-          !requires { derived() += difference_type(1); } {
+          (!requires { derived() += difference_type(1); }) {
             ++access::base(derived());
             return derived();
           }
@@ -646,12 +1260,12 @@ namespace boost { namespace stl_interfaces { namespace v2 {
         }
       friend constexpr auto operator+(difference_type n, D it)
         requires requires { it += n; } {
-          return it ++ n;
+          return it += n;
         }
 
       constexpr decltype(auto) operator--()
         requires requires { --access::base(derived()); } &&
-          !requires { derived() += difference_type(1); } {
+          (!requires { derived() += difference_type(1); }) {
           --access::base(derived());
           return derived();
         }
@@ -677,12 +1291,14 @@ namespace boost { namespace stl_interfaces { namespace v2 {
           return it += -n;
         }
 
-      friend constexpr std::strong_equality operator<=>(D lhs, D rhs)
-        requires requires { access::base(lhs) == access::base(rhs); } &&
-          !requires { access::base(lhs) <=> access::base(rhs); } &&
-          !requires { lhs - rhs; } {
-            return access::base(lhs) == access::base(rhs) ?
-                std::strong_equality::equal : std::strong_equality::unequal;
+      friend constexpr bool operator==(D lhs, D rhs)
+        requires requires { access::base(lhs) == access::base(rhs); } ||
+          requires { lhs - rhs; } {
+            if constexpr (requires { access::base(lhs) == access::base(rhs); }) {
+              return access::base(lhs) == access::base(rhs);
+            } else {
+              return (lhs - rhs) == difference_type(0);
+            }
           }
       friend constexpr std::strong_ordering operator<=>(D lhs, D rhs)
         requires requires { access::base(lhs) <=> access::base(rhs); } ||
@@ -700,8 +1316,8 @@ namespace boost { namespace stl_interfaces { namespace v2 {
           }
     };
 
-#elif 201703L <= __cplusplus && __has_include(<stl2/ranges.hpp>) && \
-    !defined(BOOST_STL_INTERFACES_DISABLE_CMCSTL2)
+#elif defined(BOOST_STL_INTERFACES_USE_CONCEPTS_TS) &&                         \
+    !defined(BOOST_STL_INTERFACES_DISABLE_V2)
 
     namespace v2_dtl {
         // These named concepts are used to work around
@@ -746,6 +1362,13 @@ namespace boost { namespace stl_interfaces { namespace v2 {
         template<typename D>
         BOOST_STL_INTERFACES_CONCEPT sub = requires (D & d) { d - d; };
 
+        // Unqualified lookup of operator==() from here would otherwise find
+        // v1's, through the inline namespace v1, and make d1 == d2
+        // ambiguous for an adapted iterator.  This hides it; the v2
+        // operator==() below is found by ADL.
+        struct hide_v1_eq {};
+        void operator==(hide_v1_eq, hide_v1_eq);
+
         template<typename D1, typename D2 = D1>
         BOOST_STL_INTERFACES_CONCEPT eq =
             requires (D1 & d1, D2 & d2) { d1 == d2; };
@@ -1001,8 +1624,7 @@ namespace boost { namespace stl_interfaces { namespace v2 {
     static_assert(concept_name<type>, "");
 
 #if 201703L < __cplusplus && defined(__cpp_lib_concepts) ||                    \
-    201703L <= __cplusplus && __has_include(<stl2/ranges.hpp>) &&              \
-    !defined(BOOST_STL_INTERFACES_DISABLE_CMCSTL2)
+    defined(BOOST_STL_INTERFACES_USE_CONCEPTS_TS)
 #define BOOST_STL_INTERFACES_STATIC_ASSERT_CONCEPT(iter, concept_name)         \
     BOOST_STL_INTERFACES_STATIC_ASSERT_ITERATOR_CONCEPT_IMPL(iter, concept_name)
 #else
@@ -0,0 +1,234 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_JOIN_VIEW_HPP
+#define BOOST_STL_INTERFACES_JOIN_VIEW_HPP
+
+#include <boost/stl_interfaces/iterator_interface.hpp>
+#include <boost/stl_interfaces/segmented_iterator.hpp>
+#include <boost/stl_interfaces/view_interface.hpp>
+
+#include <iterator>
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+    template<typename OuterIter>
+    struct join_iterator;
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    namespace v1_dtl {
+        template<typename OuterIter>
+        using join_inner_iter_t =
+            decltype(std::begin(*std::declval<OuterIter const &>()));
+
+        template<typename Iter, typename Tag>
+        using join_at_least =
+            std::is_convertible<
+                typename std::iterator_traits<Iter>::iterator_category,
+                Tag>;
+
+        template<typename OuterIter>
+        using join_category_t = std::conditional_t<
+            join_at_least<OuterIter, std::bidirectional_iterator_tag>::value &&
+                join_at_least<
+                    join_inner_iter_t<OuterIter>,
+                    std::bidirectional_iterator_tag>::value,
+            std::bidirectional_iterator_tag,
+            std::forward_iterator_tag>;
+
+        template<typename OuterIter>
+        using join_iterator_interface_t = iterator_interface<
+            join_iterator<OuterIter>,
+            join_category_t<OuterIter>,
+            typename std::iterator_traits<
+                join_inner_iter_t<OuterIter>>::value_type,
+            typename std::iterator_traits<
+                join_inner_iter_t<OuterIter>>::reference,
+            typename std::iterator_traits<
+                join_inner_iter_t<OuterIter>>::pointer,
+            iter_difference_t<join_inner_iter_t<OuterIter>>>;
+    }
+
+#endif
+
+    /** An iterator over the elements of the inner ranges of a range of
+        ranges, one inner range after another, like the iterator of
+        `std::ranges::join_view`.  `OuterIter` is the iterator of the outer
+        range, and must be a forward iterator whose reference is an lvalue
+        reference to a common range.  The iterator is bidirectional if both
+        `OuterIter` and the inner ranges' iterators are, and forward
+        otherwise; empty inner ranges are skipped.
+
+        It models the segmented iterator protocol, with the inner ranges as
+        the segments, `OuterIter` as the segment iterator, and the inner
+        ranges' iterators as the local iterators, so `segmented_copy()`,
+        `segmented_find()`, `segmented_accumulate()`, and the rest run a
+        loop over each inner range on its own.  If the inner ranges'
+        iterators are themselves segmented, those algorithms recurse into
+        their segments too.
+
+        \see `join_view` */
+    template<typename OuterIter>
+    struct join_iterator : v1_dtl::join_iterator_interface_t<OuterIter>
+    {
+        using inner_iterator = v1_dtl::join_inner_iter_t<OuterIter>;
+
+        constexpr join_iterator() = default;
+        /** Constructs an iterator at `it` in the inner range `*outer`, in
+            an outer range whose last element is `*last_outer`.  If `it` is
+            the end of `*outer`, the iterator moves on to the next nonempty
+            inner range, or to the end of `*last_outer`. */
+        constexpr join_iterator(
+            OuterIter outer, OuterIter last_outer, inner_iterator it) :
+            outer_(outer), last_outer_(last_outer), inner_(it)
+        {
+            skip_empty();
+        }
+
+        constexpr join_iterator & operator++()
+        {
+            ++inner_;
+            skip_empty();
+            return *this;
+        }
+        template<typename I = inner_iterator, typename O = OuterIter>
+        constexpr auto operator--() -> decltype(
+            --std::declval<I &>(),
+            --std::declval<O &>(),
+            std::declval<join_iterator &>())
+        {
+            while (inner_ == std::begin(*outer_)) {
+                --outer_;
+                inner_ = std::end(*outer_);
+            }
+            --inner_;
+            return *this;
+        }
+
+        friend constexpr bool
+        operator==(join_iterator const & lhs, join_iterator const & rhs)
+        {
+            return lhs.outer_ == rhs.outer_ && lhs.inner_ == rhs.inner_;
+        }
+
+        /** Returns the iterator to the current inner range. */
+        constexpr OuterIter outer() const { return outer_; }
+
+        using base_type = v1_dtl::join_iterator_interface_t<OuterIter>;
+        using base_type::operator++;
+        using base_type::operator--;
+
+    private:
+        friend access;
+
+        constexpr inner_iterator & base_reference() noexcept { return inner_; }
+        constexpr inner_iterator const & base_reference() const noexcept
+        {
+            return inner_;
+        }
+
+        constexpr OuterIter segment() const { return outer_; }
+        constexpr inner_iterator local() const { return inner_; }
+        constexpr inner_iterator local_begin(OuterIter seg) const
+        {
+            return std::begin(*seg);
+        }
+        constexpr inner_iterator local_end(OuterIter seg) const
+        {
+            return std::end(*seg);
+        }
+        constexpr join_iterator
+        compose(OuterIter seg, inner_iterator it) const
+        {
+            return join_iterator(seg, last_outer_, it);
+        }
+
+        // Keeps inner_ off the end of any inner range but the last.
+        constexpr void skip_empty()
+        {
+            while (outer_ != last_outer_ && inner_ == std::end(*outer_)) {
+                ++outer_;
+                inner_ = std::begin(*outer_);
+            }
+        }
+
+        OuterIter outer_ = OuterIter();
+        OuterIter last_outer_ = OuterIter();
+        inner_iterator inner_ = inner_iterator();
+    };
+
+    /** A view of the elements of the inner ranges of the outer range
+        `[first, last)`, one inner range after another; its iterators are
+        `join_iterator`s.  Only the outer range's iterators are kept, so the
+        outer range must outlive the view.
+
+        The end of the view is the end of the last inner range, so that the
+        segmented iterator protocol can describe it; the view finds the last
+        inner range when it is constructed, which takes a walk over the
+        outer range if `OuterIter` is not bidirectional.
+
+        \see `make_join_view()` */
+    template<typename OuterIter>
+    struct join_view : view_interface<join_view<OuterIter>>
+    {
+        using iterator = join_iterator<OuterIter>;
+
+        constexpr join_view() = default;
+        constexpr join_view(OuterIter first, OuterIter last) :
+            first_(first), last_outer_(first), empty_(first == last)
+        {
+            if (!empty_)
+                last_outer_ = last_element(first, last);
+        }
+
+        constexpr iterator begin() const
+        {
+            if (empty_)
+                return iterator();
+            return iterator(first_, last_outer_, std::begin(*first_));
+        }
+        constexpr iterator end() const
+        {
+            if (empty_)
+                return iterator();
+            return iterator(last_outer_, last_outer_, std::end(*last_outer_));
+        }
+
+    private:
+        template<typename O = OuterIter>
+        static constexpr auto last_element(O first, O last)
+            -> decltype(--last, O())
+        {
+            (void)first;
+            return --last;
+        }
+        template<typename... Ts>
+        static constexpr OuterIter
+        last_element(OuterIter first, OuterIter last, Ts...)
+        {
+            OuterIter retval = first;
+            for (; first != last; ++first) {
+                retval = first;
+            }
+            return retval;
+        }
+
+        OuterIter first_ = OuterIter();
+        OuterIter last_outer_ = OuterIter();
+        bool empty_ = true;
+    };
+
+    /** Returns a `join_view` of the range of ranges `r`. */
+    template<typename Range>
+    constexpr auto make_join_view(Range && r)
+    {
+        return join_view<decltype(std::begin(r))>(std::begin(r), std::end(r));
+    }
+
+}}}
+
+#endif
@@ -0,0 +1,299 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_KEYED_VIEW_HPP
+#define BOOST_STL_INTERFACES_KEYED_VIEW_HPP
+
+#include <boost/stl_interfaces/detail/functor_box.hpp>
+#include <boost/stl_interfaces/prefetch_view.hpp>
+#include <boost/stl_interfaces/radix_sort.hpp>
+#include <boost/stl_interfaces/transform_view.hpp>
+#include <boost/stl_interfaces/zip_view.hpp>
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    namespace v1_dtl {
+        template<typename Iter, typename Proj>
+        using keyed_key_t = std::decay_t<transform_reference_t<Iter, Proj>>;
+
+        template<typename Key>
+        struct keyed_slot
+        {
+            Key key;
+            std::size_t index;
+        };
+
+        // Integer keys in ascending order are radix sorted, which is stable
+        // by itself.
+        template<typename Key, typename Compare>
+        using keyed_radix = std::integral_constant<
+            bool,
+            radix_integral<Key>::value &&
+                (std::is_same<Compare, std::less<Key>>::value ||
+                 std::is_same<Compare, std::less<>>::value)>;
+
+        template<typename Key, typename Compare>
+        void keyed_sort_slots(
+            std::vector<keyed_slot<Key>> & slots, Compare, std::true_type)
+        {
+            stl_interfaces::radix_sort(
+                slots.begin(), slots.end(), [](keyed_slot<Key> const & s) {
+                    return s.key;
+                });
+        }
+        // Ties are broken by position, which makes the sort stable without
+        // std::stable_sort()'s buffer.
+        template<typename Key, typename Compare>
+        void keyed_sort_slots(
+            std::vector<keyed_slot<Key>> & slots,
+            Compare comp,
+            std::false_type)
+        {
+            using slot = keyed_slot<Key>;
+            std::sort(
+                slots.begin(),
+                slots.end(),
+                [&](slot const & a, slot const & b) {
+                    if (comp(a.key, b.key))
+                        return true;
+                    if (comp(b.key, a.key))
+                        return false;
+                    return a.index < b.index;
+                });
+        }
+    }
+
+#endif
+
+    /** A view of a random access range of (usually large) elements, along
+        with a key projected out of each one by `proj`, kept in an array of
+        its own in the same order.  The keys are extracted once, when the
+        view is constructed, so that sorting and searching by key touch only
+        the compact array of keys, instead of pulling each whole element
+        through the cache to read one member of it.
+
+        The iterators are `zip_iterator<Key *, Iter>`s, whose elements are a
+        key and the element it was projected from, so that any algorithm
+        that permutes them -- `std::sort()` with a comparison of
+        `std::get<0>()`, say -- keeps the keys aligned with the elements.
+        `sort()` does better: it sorts the keys along with each one's
+        original position, which is compact, and then moves each element
+        once, to its final position, instead of at every swap.
+        `lower_bound()`, `upper_bound()`, `equal_range()` and `find()`
+        binary-search the keys alone.
+
+        The view refers to the underlying range, which must outlive it.  It
+        owns its keys; if elements change other than through the view, call
+        `refresh()` to extract the keys again.  `Key` is `std::decay_t` of
+        the result of `proj`. */
+    template<typename Iter, typename Proj>
+    struct keyed_view : view_interface<keyed_view<Iter, Proj>>,
+                        private detail::functor_box<Proj>
+    {
+        static_assert(
+            std::is_convertible<
+                typename std::iterator_traits<Iter>::iterator_category,
+                std::random_access_iterator_tag>::value,
+            "keyed_view requires a random access range.");
+
+        using key_type = v1_dtl::keyed_key_t<Iter, Proj>;
+        using iterator = zip_iterator<key_type *, Iter>;
+        using difference_type = typename iterator::difference_type;
+        using size_type = std::size_t;
+
+        keyed_view() = default;
+        keyed_view(Iter first, Iter last, Proj proj) :
+            detail::functor_box<Proj>(std::move(proj)),
+            first_(first),
+            keys_(std::size_t(last - first))
+        {
+            refresh();
+        }
+
+        iterator begin() noexcept { return iterator(keys_.data(), first_); }
+        iterator end() noexcept { return begin() + difference_type(size()); }
+
+        size_type size() const noexcept { return keys_.size(); }
+
+        /** Returns the keys, in the order of the elements. */
+        key_type const * keys() const noexcept { return keys_.data(); }
+        /** Returns the key of element `n`. */
+        key_type const & key(size_type n) const noexcept
+        {
+            BOOST_ASSERT(n < size());
+            return keys_[n];
+        }
+
+        /** Returns the beginning of the underlying range. */
+        Iter base_begin() const { return first_; }
+        /** Returns the end of the underlying range. */
+        Iter base_end() const { return first_ + difference_type(size()); }
+        /** Returns the projection. */
+        Proj const & projection() const noexcept { return this->get(); }
+
+        /** Extracts the keys from the underlying elements again. */
+        void refresh()
+        {
+            for (std::size_t i = 0, n = keys_.size(); i < n; ++i) {
+                keys_[i] = this->get()(first_[difference_type(i)]);
+            }
+        }
+
+        /** Sorts the elements by their keys, stably, with `comp`.  The keys
+            are sorted along with their original positions -- with
+            `radix_sort()`, if they are integers and `comp` is `std::less` --
+            and then each element is moved once, along the cycles of the
+            permutation; an element that is already in place is not moved at
+            all. */
+        template<typename Compare = std::less<key_type>>
+        void sort(Compare comp = Compare())
+        {
+            using slot = v1_dtl::keyed_slot<key_type>;
+            std::vector<slot> slots;
+            slots.reserve(keys_.size());
+            for (std::size_t i = 0, n = keys_.size(); i < n; ++i) {
+                slots.push_back(slot{std::move(keys_[i]), i});
+            }
+            v1_dtl::keyed_sort_slots(
+                slots, comp, v1_dtl::keyed_radix<key_type, Compare>{});
+
+            std::vector<std::size_t> from(slots.size());
+            for (std::size_t i = 0, n = slots.size(); i < n; ++i) {
+                from[i] = slots[i].index;
+                keys_[i] = std::move(slots[i].key);
+            }
+            permute(from);
+        }
+
+        /** Returns the first position whose key is not less than `k`. */
+        template<typename K, typename Compare = std::less<>>
+        iterator lower_bound(K const & k, Compare comp = Compare())
+        {
+            return begin() +
+                   (std::lower_bound(keys_.begin(), keys_.end(), k, comp) -
+                    keys_.begin());
+        }
+        /** Returns the first position whose key is greater than `k`. */
+        template<typename K, typename Compare = std::less<>>
+        iterator upper_bound(K const & k, Compare comp = Compare())
+        {
+            return begin() +
+                   (std::upper_bound(keys_.begin(), keys_.end(), k, comp) -
+                    keys_.begin());
+        }
+        /** Returns the positions whose keys are equivalent to `k`. */
+        template<typename K, typename Compare = std::less<>>
+        std::pair<iterator, iterator>
+        equal_range(K const & k, Compare comp = Compare())
+        {
+            auto const r =
+                std::equal_range(keys_.begin(), keys_.end(), k, comp);
+            return std::pair<iterator, iterator>(
+                begin() + (r.first - keys_.begin()),
+                begin() + (r.second - keys_.begin()));
+        }
+        /** Returns the first position whose key is equivalent to `k`, or
+            `end()`. */
+        template<typename K, typename Compare = std::less<>>
+        iterator find(K const & k, Compare comp = Compare())
+        {
+            auto const it = lower_bound(k, comp);
+            if (it == end() || comp(k, std::get<0>(*it)))
+                return end();
+            return it;
+        }
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+    private:
+        // Moves the element at first_[from[i]] to first_[i], for each i,
+        // following each cycle of the permutation with one temporary.  The
+        // moves along a cycle are random accesses, so the elements a few
+        // steps further along it are prefetched.
+        void permute(std::vector<std::size_t> & from)
+        {
+            using value_type = typename std::iterator_traits<Iter>::value_type;
+            std::size_t const done = std::size_t(-1);
+            for (std::size_t i = 0, n = from.size(); i < n; ++i) {
+                if (from[i] == done)
+                    continue;
+                if (from[i] == i) {
+                    from[i] = done;
+                    continue;
+                }
+                value_type x = std::move(first_[difference_type(i)]);
+                std::size_t j = i;
+                std::size_t ahead = i;
+                for (int d = 0; d < prefetch_distance && from[ahead] != i;
+                     ++d) {
+                    ahead = from[ahead];
+                    prefetch(ahead);
+                }
+                while (from[j] != i) {
+                    if (from[ahead] != i) {
+                        ahead = from[ahead];
+                        prefetch(ahead);
+                    }
+                    std::size_t const k = from[j];
+                    first_[difference_type(j)] =
+                        std::move(first_[difference_type(k)]);
+                    from[j] = done;
+                    j = k;
+                }
+                first_[difference_type(j)] = std::move(x);
+                from[j] = done;
+            }
+        }
+
+        static constexpr int prefetch_distance = 8;
+
+        void prefetch(std::size_t n) const noexcept
+        {
+            prefetch(
+                n,
+                std::is_lvalue_reference<
+                    typename std::iterator_traits<Iter>::reference>{});
+        }
+        // Fetches every cache line of element n.
+        void prefetch(std::size_t n, std::true_type) const noexcept
+        {
+            using value_type = typename std::iterator_traits<Iter>::value_type;
+            auto const p = reinterpret_cast<char const *>(
+                std::addressof(first_[difference_type(n)]));
+            for (std::size_t b = 0; b < sizeof(value_type); b += 64) {
+                v1_dtl::prefetch(p + b);
+            }
+        }
+        void prefetch(std::size_t, std::false_type) const noexcept {}
+
+        Iter first_ = Iter();
+        std::vector<key_type> keys_;
+#endif
+    };
+
+    /** Returns a `keyed_view` of the random access range `r`, with the key
+        `proj(x)` for each element `x`. */
+    template<typename Range, typename Proj>
+    auto make_keyed_view(Range && r, Proj proj)
+    {
+        using iter = decltype(std::begin(r));
+        return keyed_view<iter, Proj>(
+            std::begin(r), std::end(r), std::move(proj));
+    }
+
+}}}
+
+#endif
@@ -0,0 +1,240 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_LEAF_CACHING_ITERATOR_HPP
+#define BOOST_STL_INTERFACES_LEAF_CACHING_ITERATOR_HPP
+
+#include <boost/stl_interfaces/segmented_iterator.hpp>
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+    /** A leaf of a tree-structured sequence: `size` contiguous elements
+        starting at `data`, which are elements `first` through `first + size
+        - 1` of the sequence. */
+    template<typename T>
+    struct tree_leaf
+    {
+        T * data;
+        std::size_t first;
+        std::size_t size;
+    };
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    namespace v1_dtl {
+        // tree.leaf_at(i), as a tree_leaf<T>; a Tree with leaves of U
+        // provides constant iterators' leaves of U const.
+        template<typename T, typename Tree>
+        tree_leaf<T> tree_leaf_at(Tree const & tree, std::size_t i) noexcept
+        {
+            auto const leaf = access::leaf_at(tree, i);
+            return tree_leaf<T>{leaf.data, leaf.first, leaf.size};
+        }
+    }
+
+#endif
+
+    /** A forward iterator over the leaves of a tree-structured sequence of
+        type `Tree`, in order, each a `tree_leaf<T>`.  It is the segment
+        iterator of `leaf_caching_iterator`.  \see `leaf_caching_iterator` */
+    template<typename Tree, typename T>
+    struct tree_leaf_iterator : iterator_interface<
+                                    tree_leaf_iterator<Tree, T>,
+                                    std::forward_iterator_tag,
+                                    tree_leaf<T>,
+                                    tree_leaf<T>>
+    {
+        tree_leaf_iterator() noexcept = default;
+        tree_leaf_iterator(Tree const * tree, tree_leaf<T> leaf) noexcept :
+            tree_(tree), leaf_(leaf)
+        {}
+
+        tree_leaf<T> operator*() const noexcept { return leaf_; }
+        tree_leaf_iterator & operator++() noexcept
+        {
+            std::size_t const next = leaf_.first + leaf_.size;
+            leaf_ = next < tree_->size()
+                        ? v1_dtl::tree_leaf_at<T>(*tree_, next)
+                        : tree_leaf<T>{nullptr, next, 0};
+            return *this;
+        }
+        friend bool operator==(
+            tree_leaf_iterator const & lhs,
+            tree_leaf_iterator const & rhs) noexcept
+        {
+            return lhs.leaf_.first == rhs.leaf_.first;
+        }
+
+        using base_type = iterator_interface<
+            tree_leaf_iterator<Tree, T>,
+            std::forward_iterator_tag,
+            tree_leaf<T>,
+            tree_leaf<T>>;
+        using base_type::operator++;
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+    private:
+        Tree const * tree_ = nullptr;
+        tree_leaf<T> leaf_ = {nullptr, 0, 0};
+#endif
+    };
+
+    /** A random access iterator over a tree-structured sequence of type
+        `Tree`, such as `persistent_vector`, whose elements, of type `T`,
+        are stored contiguously in leaves.  It caches the leaf that holds
+        the element it refers to, so dereferencing it and moving it within
+        that leaf does not touch the tree; only moving it off of the leaf
+        looks up another one.  A sequential traversal therefore walks the
+        tree once per leaf, not once per element.
+
+        Each leaf is looked up from the root, by index, so this is for
+        trees whose leaves are not linked to their neighbours -- as those of
+        a persistent tree cannot be, since each leaf is shared by many
+        versions.  A tree with linked leaves, such as the `rope` example's
+        and `btree_map`'s, is better served by an iterator that keeps its
+        leaf and follows the links.
+
+        It also models the segmented iterator protocol, with the leaves as
+        the segments and pointers as the local iterators, so the
+        `segmented_*()` algorithms run over each leaf with pointers, as fast
+        as over a vector, apart from one lookup per leaf.
+
+        `Tree` must have the const member functions `size()`, which returns
+        the number of elements, and `leaf_at(i)`, which returns the
+        `tree_leaf<T>` that holds element `i`, for `i < size()`; `leaf_at()`
+        may be private if `Tree` befriends `access`.  `T` is `const` for a
+        constant iterator; a `leaf_caching_iterator<Tree, T const>` can be
+        constructed from a `leaf_caching_iterator<Tree, T>`.  The iterator
+        holds a pointer to the `Tree`, and is invalidated by anything that
+        changes the tree's leaves. */
+    template<typename Tree, typename T>
+    struct leaf_caching_iterator : iterator_interface<
+                                       leaf_caching_iterator<Tree, T>,
+                                       std::random_access_iterator_tag,
+                                       std::remove_const_t<T>,
+                                       T &,
+                                       T *>
+    {
+        leaf_caching_iterator() noexcept = default;
+        leaf_caching_iterator(Tree const * tree, std::ptrdiff_t i) noexcept :
+            tree_(tree), i_(i)
+        {
+            load_leaf();
+        }
+        template<
+            typename U,
+            typename E = std::enable_if_t<
+                std::is_same<T, U const>::value &&
+                !std::is_same<T, U>::value>>
+        leaf_caching_iterator(leaf_caching_iterator<Tree, U> other) noexcept
+            :
+            tree_(other.tree_),
+            i_(other.i_),
+            leaf_{other.leaf_.data, other.leaf_.first, other.leaf_.size}
+        {}
+
+        T & operator*() const noexcept
+        {
+            return leaf_.data[std::size_t(i_) - leaf_.first];
+        }
+        leaf_caching_iterator & operator+=(std::ptrdiff_t n) noexcept
+        {
+            i_ += n;
+            if (leaf_.size <= std::size_t(i_) - leaf_.first)
+                load_leaf();
+            return *this;
+        }
+        friend std::ptrdiff_t operator-(
+            leaf_caching_iterator const & lhs,
+            leaf_caching_iterator const & rhs) noexcept
+        {
+            return lhs.i_ - rhs.i_;
+        }
+        friend bool operator==(
+            leaf_caching_iterator const & lhs,
+            leaf_caching_iterator const & rhs) noexcept
+        {
+            return lhs.i_ == rhs.i_;
+        }
+        friend bool operator!=(
+            leaf_caching_iterator const & lhs,
+            leaf_caching_iterator const & rhs) noexcept
+        {
+            return lhs.i_ != rhs.i_;
+        }
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+    private:
+        template<typename Tree2, typename U>
+        friend struct leaf_caching_iterator;
+        friend access;
+
+        using segment_iterator = tree_leaf_iterator<Tree, T>;
+
+        leaf_caching_iterator(
+            Tree const * tree, std::ptrdiff_t i, tree_leaf<T> leaf) noexcept :
+            tree_(tree), i_(i), leaf_(leaf)
+        {}
+
+        void load_leaf() noexcept
+        {
+            if (0 <= i_ && std::size_t(i_) < tree_->size()) {
+                leaf_ = v1_dtl::tree_leaf_at<T>(*tree_, std::size_t(i_));
+            } else {
+                // Out of range, as end() is; any move reloads.
+                leaf_ = tree_leaf<T>{nullptr, std::size_t(i_), 0};
+            }
+        }
+
+        // The segment is the cached leaf, except at end(), whose segment is
+        // the last leaf, so that it is one that local_begin() is valid for.
+        segment_iterator segment() const noexcept
+        {
+            if (leaf_.size)
+                return segment_iterator(tree_, leaf_);
+            std::size_t const size = tree_->size();
+            return segment_iterator(
+                tree_,
+                size ? v1_dtl::tree_leaf_at<T>(*tree_, size - 1)
+                     : tree_leaf<T>{nullptr, 0, 0});
+        }
+        T * local() const noexcept
+        {
+            tree_leaf<T> const leaf = *segment();
+            return leaf.data + (std::size_t(i_) - leaf.first);
+        }
+        T * local_begin(segment_iterator seg) const noexcept
+        {
+            return (*seg).data;
+        }
+        T * local_end(segment_iterator seg) const noexcept
+        {
+            tree_leaf<T> const leaf = *seg;
+            return leaf.data + leaf.size;
+        }
+        leaf_caching_iterator
+        compose(segment_iterator seg, T * it) const noexcept
+        {
+            tree_leaf<T> const leaf = *seg;
+            std::size_t const i = leaf.first + std::size_t(it - leaf.data);
+            if (i - leaf.first < leaf.size)
+                return leaf_caching_iterator(tree_, std::ptrdiff_t(i), leaf);
+            return leaf_caching_iterator(tree_, std::ptrdiff_t(i));
+        }
+
+        Tree const * tree_ = nullptr;
+        std::ptrdiff_t i_ = 0;
+        tree_leaf<T> leaf_ = {nullptr, 0, 0};
+#endif
+    };
+
+}}}
+
+#endif
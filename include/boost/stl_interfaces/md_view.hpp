@@ -0,0 +1,951 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_MD_VIEW_HPP
+#define BOOST_STL_INTERFACES_MD_VIEW_HPP
+
+#include <boost/stl_interfaces/iterator_interface.hpp>
+#include <boost/stl_interfaces/strided_view.hpp>
+#include <boost/stl_interfaces/view_interface.hpp>
+
+#include <boost/assert.hpp>
+
+#include <array>
+#include <utility>
+
+#include <cstddef>
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+    /** The value of an extent that is known only at run time. */
+    constexpr std::ptrdiff_t dynamic_extent = -1;
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    namespace v1_dtl {
+        // The number of dynamic extents among the first last of Es.
+        template<std::ptrdiff_t... Es>
+        constexpr std::size_t count_dynamic(std::size_t last) noexcept
+        {
+            std::ptrdiff_t const es[] = {Es..., 0};
+            std::size_t n = 0;
+            for (std::size_t r = 0; r < last; ++r) {
+                if (es[r] == dynamic_extent)
+                    ++n;
+            }
+            return n;
+        }
+
+        template<typename... Ts>
+        using all_integral = std::is_same<
+            std::integer_sequence<bool, true, std::is_integral<Ts>::value...>,
+            std::integer_sequence<bool, std::is_integral<Ts>::value..., true>>;
+
+        // The dynamic extents of an extents; it is empty if there are none.
+        template<std::size_t N>
+        struct dynamic_extents
+        {
+            constexpr dynamic_extents() noexcept : dynamic_() {}
+            template<typename... Ints>
+            constexpr explicit dynamic_extents(Ints... dynamic) noexcept :
+                dynamic_{std::ptrdiff_t(dynamic)...}
+            {}
+
+            constexpr std::ptrdiff_t dynamic(std::size_t i) const noexcept
+            {
+                return dynamic_[i];
+            }
+
+        private:
+            std::ptrdiff_t dynamic_[N];
+        };
+        template<>
+        struct dynamic_extents<0>
+        {
+            constexpr std::ptrdiff_t dynamic(std::size_t) const noexcept
+            {
+                return 0;
+            }
+        };
+    }
+
+#endif
+
+    /** The extents of a multidimensional array, each of which is either a
+        constant, or `dynamic_extent`, to be given at run time.  This is a
+        pre-C++23 version of `std::extents` (see [mdspan.extents] in the C++
+        standard), with `std::ptrdiff_t` indices.  Only the dynamic extents
+        are stored. */
+    template<std::ptrdiff_t... Es>
+    struct extents
+        : private v1_dtl::dynamic_extents<v1_dtl::count_dynamic<Es...>(
+              sizeof...(Es))>
+    {
+        static_assert(
+            0 < sizeof...(Es), "extents must have at least one dimension.");
+
+        static constexpr std::size_t rank() noexcept { return sizeof...(Es); }
+        static constexpr std::size_t rank_dynamic() noexcept
+        {
+            return v1_dtl::count_dynamic<Es...>(sizeof...(Es));
+        }
+        /** Returns extent `r`, or `dynamic_extent` if it is known only at
+            run time. */
+        static constexpr std::ptrdiff_t static_extent(std::size_t r) noexcept
+        {
+            std::ptrdiff_t const es[] = {Es...};
+            return es[r];
+        }
+
+        constexpr extents() noexcept {}
+        /** Constructs the extents from the dynamic extents, in order. */
+        template<
+            typename... Ints,
+            typename Enable = std::enable_if_t<
+                0 < sizeof...(Ints) &&
+                sizeof...(Ints) ==
+                    v1_dtl::count_dynamic<Es...>(sizeof...(Es)) &&
+                v1_dtl::all_integral<Ints...>::value>>
+        constexpr explicit extents(Ints... dynamic) noexcept :
+            v1_dtl::dynamic_extents<sizeof...(Ints)>(dynamic...)
+        {}
+
+        constexpr std::ptrdiff_t extent(std::size_t r) const noexcept
+        {
+            return static_extent(r) == dynamic_extent
+                       ? this->dynamic(v1_dtl::count_dynamic<Es...>(r))
+                       : static_extent(r);
+        }
+        /** Returns extent `R`.  Unlike `extent(R)`, this does no
+            computation at run time to find a dynamic extent. */
+        template<std::size_t R>
+        constexpr std::ptrdiff_t extent() const noexcept
+        {
+            return static_extent(R) == dynamic_extent
+                       ? this->dynamic(std::integral_constant<
+                                       std::size_t,
+                                       v1_dtl::count_dynamic<Es...>(R)>::value)
+                       : static_extent(R);
+        }
+
+        friend constexpr bool
+        operator==(extents const & lhs, extents const & rhs) noexcept
+        {
+            for (std::size_t r = 0; r < rank(); ++r) {
+                if (lhs.extent(r) != rhs.extent(r))
+                    return false;
+            }
+            return true;
+        }
+        friend constexpr bool
+        operator!=(extents const & lhs, extents const & rhs) noexcept
+        {
+            return !(lhs == rhs);
+        }
+    };
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    namespace v1_dtl {
+        // The offset of the element at idx, with the indices Rs in order
+        // from the slowest-varying to the fastest.  The extents are found
+        // at compile time, so this unrolls to a multiply-add per index.
+        template<typename Extents, std::size_t... Rs>
+        constexpr std::ptrdiff_t horner_offset(
+            Extents const & e,
+            std::ptrdiff_t const * idx,
+            std::index_sequence<Rs...>) noexcept
+        {
+            std::ptrdiff_t retval = 0;
+            std::ptrdiff_t const unused[] = {
+                (retval = retval * e.template extent<Rs>() + idx[Rs])...};
+            (void)unused;
+            return retval;
+        }
+
+        template<typename Is>
+        struct reversed_index_sequence_impl;
+        template<std::size_t... Is>
+        struct reversed_index_sequence_impl<std::index_sequence<Is...>>
+        {
+            using type = std::index_sequence<sizeof...(Is) - 1 - Is...>;
+        };
+        template<std::size_t N>
+        using reversed_index_sequence = typename reversed_index_sequence_impl<
+            std::make_index_sequence<N>>::type;
+    }
+
+#endif
+
+    /** The layout of a row-major array, like `std::layout_right`: the last
+        index varies fastest. */
+    struct layout_right
+    {
+        template<typename Extents>
+        struct mapping : private Extents
+        {
+            using extents_type = Extents;
+
+            constexpr mapping() = default;
+            constexpr explicit mapping(Extents e) noexcept : Extents(e) {}
+
+            constexpr Extents const & extents() const noexcept
+            {
+                return *this;
+            }
+            constexpr std::ptrdiff_t stride(std::size_t r) const noexcept
+            {
+                std::ptrdiff_t retval = 1;
+                for (std::size_t i = r + 1; i < Extents::rank(); ++i) {
+                    retval *= extents().extent(i);
+                }
+                return retval;
+            }
+            constexpr std::ptrdiff_t required_span_size() const noexcept
+            {
+                return stride(0) * extents().extent(0);
+            }
+            template<typename... Is>
+            constexpr std::ptrdiff_t operator()(Is... is) const noexcept
+            {
+                std::ptrdiff_t const idx[] = {std::ptrdiff_t(is)...};
+                return v1_dtl::horner_offset(
+                    extents(), idx, std::make_index_sequence<sizeof...(Is)>{});
+            }
+        };
+    };
+
+    /** The layout of a column-major array, like `std::layout_left`: the
+        first index varies fastest. */
+    struct layout_left
+    {
+        template<typename Extents>
+        struct mapping : private Extents
+        {
+            using extents_type = Extents;
+
+            constexpr mapping() = default;
+            constexpr explicit mapping(Extents e) noexcept : Extents(e) {}
+
+            constexpr Extents const & extents() const noexcept
+            {
+                return *this;
+            }
+            constexpr std::ptrdiff_t stride(std::size_t r) const noexcept
+            {
+                std::ptrdiff_t retval = 1;
+                for (std::size_t i = 0; i < r; ++i) {
+                    retval *= extents().extent(i);
+                }
+                return retval;
+            }
+            constexpr std::ptrdiff_t required_span_size() const noexcept
+            {
+                return stride(Extents::rank() - 1) *
+                       extents().extent(Extents::rank() - 1);
+            }
+            template<typename... Is>
+            constexpr std::ptrdiff_t operator()(Is... is) const noexcept
+            {
+                std::ptrdiff_t const idx[] = {std::ptrdiff_t(is)...};
+                return v1_dtl::horner_offset(
+                    extents(),
+                    idx,
+                    v1_dtl::reversed_index_sequence<sizeof...(Is)>{});
+            }
+        };
+    };
+
+    /** The layout of an array with a given stride for each index, like
+        `std::layout_stride`. */
+    struct layout_stride
+    {
+        template<typename Extents>
+        struct mapping : private Extents
+        {
+            using extents_type = Extents;
+            using strides_type = std::array<std::ptrdiff_t, Extents::rank()>;
+
+            constexpr mapping() : strides_() {}
+            constexpr mapping(
+                Extents e, strides_type const & strides) noexcept :
+                Extents(e),
+                strides_(strides)
+            {}
+
+            constexpr Extents const & extents() const noexcept
+            {
+                return *this;
+            }
+            constexpr std::ptrdiff_t stride(std::size_t r) const noexcept
+            {
+                return strides_[r];
+            }
+            constexpr std::ptrdiff_t required_span_size() const noexcept
+            {
+                std::ptrdiff_t retval = 1;
+                for (std::size_t r = 0; r < Extents::rank(); ++r) {
+                    if (extents().extent(r) == 0)
+                        return 0;
+                    retval += (extents().extent(r) - 1) * strides_[r];
+                }
+                return retval;
+            }
+            template<typename... Is>
+            constexpr std::ptrdiff_t operator()(Is... is) const noexcept
+            {
+                return offset(
+                    std::make_index_sequence<sizeof...(Is)>{}, is...);
+            }
+
+        private:
+            template<std::size_t... Rs, typename... Is>
+            constexpr std::ptrdiff_t
+            offset(std::index_sequence<Rs...>, Is... is) const noexcept
+            {
+                std::ptrdiff_t retval = 0;
+                std::ptrdiff_t const unused[] = {
+                    (retval += std::ptrdiff_t(is) * strides_[Rs])...};
+                (void)unused;
+                return retval;
+            }
+
+            strides_type strides_;
+        };
+    };
+
+    /** The layout of a row-major array whose rows may be padded, like
+        C++26's `std::layout_right_padded`: the last index varies fastest,
+        with a stride of 1, and the other indices have the given strides.
+        This is the layout of a block of a `layout_right` array, such as a
+        tile of a matrix, whose rows are contiguous, but not adjacent. */
+    struct layout_right_padded
+    {
+        template<typename Extents>
+        struct mapping : private Extents
+        {
+            using extents_type = Extents;
+            using strides_type = std::array<std::ptrdiff_t, Extents::rank()>;
+
+            constexpr mapping() : strides_() {}
+            /** Constructs the mapping from all the strides, the last of which
+                must be 1. */
+            constexpr mapping(
+                Extents e, strides_type const & strides) noexcept :
+                Extents(e),
+                strides_(strides)
+            {
+                BOOST_ASSERT(strides[Extents::rank() - 1] == 1);
+            }
+
+            constexpr Extents const & extents() const noexcept
+            {
+                return *this;
+            }
+            constexpr std::ptrdiff_t stride(std::size_t r) const noexcept
+            {
+                return r + 1 == Extents::rank() ? 1 : strides_[r];
+            }
+            constexpr std::ptrdiff_t required_span_size() const noexcept
+            {
+                std::ptrdiff_t retval = 1;
+                for (std::size_t r = 0; r < Extents::rank(); ++r) {
+                    if (extents().extent(r) == 0)
+                        return 0;
+                    retval += (extents().extent(r) - 1) * stride(r);
+                }
+                return retval;
+            }
+            template<typename... Is>
+            constexpr std::ptrdiff_t operator()(Is... is) const noexcept
+            {
+                return offset(
+                    std::make_index_sequence<sizeof...(Is)>{}, is...);
+            }
+
+        private:
+            template<std::size_t... Rs, typename... Is>
+            constexpr std::ptrdiff_t
+            offset(std::index_sequence<Rs...>, Is... is) const noexcept
+            {
+                std::ptrdiff_t retval = 0;
+                std::ptrdiff_t const unused[] = {(
+                    retval += std::ptrdiff_t(is) *
+                              (Rs + 1 == sizeof...(Rs) ? 1 : strides_[Rs]))...};
+                (void)unused;
+                return retval;
+            }
+
+            strides_type strides_;
+        };
+    };
+
+    template<typename T, typename Extents, typename Layout = layout_right>
+    struct md_view;
+
+    template<typename T, typename Extents, typename Layout>
+    struct md_row_iterator;
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    namespace v1_dtl {
+        // The iterator of an md_view.  The elements of a one-dimensional
+        // md_view are contiguous, except in layout_stride.
+        template<typename T, typename Extents, typename Layout>
+        struct md_iterator
+        {
+            using type = md_row_iterator<T, Extents, Layout>;
+        };
+        template<typename T, std::ptrdiff_t E>
+        struct md_iterator<T, extents<E>, layout_right>
+        {
+            using type = T *;
+        };
+        template<typename T, std::ptrdiff_t E>
+        struct md_iterator<T, extents<E>, layout_left>
+        {
+            using type = T *;
+        };
+        template<typename T, std::ptrdiff_t E>
+        struct md_iterator<T, extents<E>, layout_right_padded>
+        {
+            using type = T *;
+        };
+        template<typename T, std::ptrdiff_t E>
+        struct md_iterator<T, extents<E>, layout_stride>
+        {
+            using type = strided_iterator<T *>;
+        };
+
+        template<typename T>
+        constexpr T * md_begin(T * data, std::ptrdiff_t, T *) noexcept
+        {
+            return data;
+        }
+        template<typename T>
+        constexpr strided_iterator<T *> md_begin(
+            T * data, std::ptrdiff_t stride, strided_iterator<T *>) noexcept
+        {
+            return strided_iterator<T *>(data, stride);
+        }
+
+        // The pointer and the mapping of an md_view; the mapping takes no
+        // space if all the extents are static.
+        template<typename T, typename Mapping>
+        struct md_storage : Mapping
+        {
+            constexpr md_storage(T * data, Mapping const & m) noexcept :
+                Mapping(m),
+                data_(data)
+            {}
+
+            T * data_;
+        };
+    }
+
+#endif
+
+    /** A view of a multidimensional array of `T`, with the given extents
+        and layout, like `std::mdspan`.  It refers to the array; it does not
+        own it.  `v(i, j, ...)` is the element at indices `i, j, ...`.
+
+        As a range, an `md_view` is the sequence of its slices along the
+        first index -- for a two-dimensional view, its rows -- each of which
+        is an `md_view` of one less dimension (see `submd()`).  The
+        iterators of a one-dimensional `md_view` are pointers if its
+        elements are contiguous (`layout_right`, `layout_left` or
+        `layout_right_padded`), and `strided_iterator`s if not
+        (`layout_stride`).  So the rows of a
+        row-major matrix are ranges of pointers, and its columns are strided
+        ranges.
+
+        Extents given at compile time are not stored, and indexing with them
+        multiplies by constants, so that the compiler can unroll and
+        vectorize the loops over them. */
+    template<typename T, typename Extents, typename Layout>
+    struct md_view : view_interface<md_view<T, Extents, Layout>>
+    {
+        using element_type = T;
+        using extents_type = Extents;
+        using layout_type = Layout;
+        using mapping_type = typename Layout::template mapping<Extents>;
+        using iterator =
+            typename v1_dtl::md_iterator<T, Extents, Layout>::type;
+
+        constexpr md_view() noexcept : storage_(nullptr, mapping_type()) {}
+        constexpr md_view(T * data, mapping_type const & m) noexcept :
+            storage_(data, m)
+        {}
+        template<
+            typename M = mapping_type,
+            typename Enable =
+                std::enable_if_t<std::is_constructible<M, Extents>::value>>
+        constexpr md_view(T * data, Extents e) noexcept :
+            storage_(data, mapping_type(e))
+        {}
+        /** Constructs a view of `data` from the dynamic extents, in order.
+            With no dynamic extents, this is `md_view(data)`. */
+        template<
+            typename... Ints,
+            typename Enable = std::enable_if_t<
+                sizeof...(Ints) == Extents::rank_dynamic() &&
+                std::is_constructible<mapping_type, Extents>::value &&
+                v1_dtl::all_integral<Ints...>::value>>
+        constexpr explicit md_view(T * data, Ints... dynamic) noexcept :
+            storage_(data, mapping_type(Extents(dynamic...)))
+        {}
+
+        static constexpr std::size_t rank() noexcept
+        {
+            return Extents::rank();
+        }
+        constexpr Extents const & extents() const noexcept
+        {
+            return mapping().extents();
+        }
+        constexpr std::ptrdiff_t extent(std::size_t r) const noexcept
+        {
+            return mapping().extents().extent(r);
+        }
+        constexpr std::ptrdiff_t stride(std::size_t r) const noexcept
+        {
+            return mapping().stride(r);
+        }
+        constexpr mapping_type const & mapping() const noexcept
+        {
+            return storage_;
+        }
+        /** Returns a pointer to the element at indices `0, 0, ...`. */
+        constexpr T * data() const noexcept { return storage_.data_; }
+
+        template<typename... Is>
+        constexpr T & operator()(Is... is) const noexcept
+        {
+            static_assert(
+                sizeof...(Is) == Extents::rank(),
+                "An md_view is indexed with one index per dimension.");
+            return data()[mapping()(is...)];
+        }
+
+        constexpr iterator begin() const noexcept
+        {
+            return begin_impl(std::integral_constant<bool, rank() == 1>{});
+        }
+        constexpr iterator end() const noexcept
+        {
+            return begin() + extent(0);
+        }
+
+    private:
+        constexpr iterator begin_impl(std::true_type) const noexcept
+        {
+            return v1_dtl::md_begin(data(), stride(0), iterator());
+        }
+        constexpr iterator begin_impl(std::false_type) const noexcept
+        {
+            return iterator(*this, 0);
+        }
+
+        v1_dtl::md_storage<T, mapping_type> storage_;
+    };
+
+    /** The tag for a slice of all of one extent of an `md_view` (see
+        `submd()`). */
+    struct full_extent_t
+    {
+        explicit full_extent_t() = default;
+    };
+
+    /** The `full_extent_t` value. */
+    constexpr full_extent_t full_extent{};
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    namespace v1_dtl {
+        // The kinds of slice submd() takes for one dimension: an index,
+        // which drops the dimension; all of it; or a [first, last) pair.
+        enum slice_kind { slice_index, slice_full, slice_pair };
+
+        template<typename Slice, typename Enable = void>
+        struct slice_traits
+        {
+        };
+        template<typename Slice>
+        struct slice_traits<
+            Slice,
+            std::enable_if_t<std::is_integral<Slice>::value>>
+        {
+            static constexpr slice_kind kind = slice_index;
+            static constexpr std::ptrdiff_t first(Slice i) noexcept
+            {
+                return i;
+            }
+            static constexpr std::ptrdiff_t
+            extent(Slice, std::ptrdiff_t) noexcept
+            {
+                return 0;
+            }
+        };
+        template<>
+        struct slice_traits<full_extent_t>
+        {
+            static constexpr slice_kind kind = slice_full;
+            static constexpr std::ptrdiff_t first(full_extent_t) noexcept
+            {
+                return 0;
+            }
+            static constexpr std::ptrdiff_t
+            extent(full_extent_t, std::ptrdiff_t e) noexcept
+            {
+                return e;
+            }
+        };
+        template<typename I, typename J>
+        struct slice_traits<std::pair<I, J>>
+        {
+            static constexpr slice_kind kind = slice_pair;
+            static constexpr std::ptrdiff_t
+            first(std::pair<I, J> const & p) noexcept
+            {
+                return p.first;
+            }
+            static constexpr std::ptrdiff_t
+            extent(std::pair<I, J> const & p, std::ptrdiff_t) noexcept
+            {
+                return p.second - p.first;
+            }
+        };
+
+        template<typename Slice>
+        using slice_traits_t = slice_traits<std::decay_t<Slice>>;
+
+        // The extents of a slice: those of the dimensions not indexed; each
+        // is static for full_extent, and dynamic for a pair.
+        template<typename Result, typename Extents, typename... Slices>
+        struct sub_extents;
+        template<
+            std::ptrdiff_t... Rs,
+            std::ptrdiff_t E,
+            std::ptrdiff_t... Es,
+            typename Slice,
+            typename... Slices>
+        struct sub_extents<
+            std::integer_sequence<std::ptrdiff_t, Rs...>,
+            std::integer_sequence<std::ptrdiff_t, E, Es...>,
+            Slice,
+            Slices...>
+            : sub_extents<
+                  std::conditional_t<
+                      slice_traits_t<Slice>::kind == slice_index,
+                      std::integer_sequence<std::ptrdiff_t, Rs...>,
+                      std::integer_sequence<
+                          std::ptrdiff_t,
+                          Rs...,
+                          slice_traits_t<Slice>::kind == slice_full
+                              ? E
+                              : dynamic_extent>>,
+                  std::integer_sequence<std::ptrdiff_t, Es...>,
+                  Slices...>
+        {
+        };
+        template<std::ptrdiff_t... Rs>
+        struct sub_extents<
+            std::integer_sequence<std::ptrdiff_t, Rs...>,
+            std::integer_sequence<std::ptrdiff_t>>
+        {
+            using type = extents<Rs...>;
+        };
+
+        template<typename Extents>
+        struct extents_sequence;
+        template<std::ptrdiff_t... Es>
+        struct extents_sequence<extents<Es...>>
+        {
+            using type = std::integer_sequence<std::ptrdiff_t, Es...>;
+        };
+
+        // Whether a slice of a layout_right array is layout_right: some
+        // leading indices, then at most one pair, and then all of each of
+        // the remaining dimensions.
+        template<slice_kind... Ks>
+        constexpr bool right_preserving() noexcept
+        {
+            slice_kind const ks[] = {Ks...};
+            std::size_t r = 0;
+            while (r < sizeof...(Ks) && ks[r] == slice_index) {
+                ++r;
+            }
+            if (r < sizeof...(Ks))
+                ++r;
+            for (; r < sizeof...(Ks); ++r) {
+                if (ks[r] != slice_full)
+                    return false;
+            }
+            return true;
+        }
+        // The mirror image of right_preserving(), for layout_left.
+        template<slice_kind... Ks>
+        constexpr bool left_preserving() noexcept
+        {
+            slice_kind const ks[] = {Ks...};
+            std::size_t r = sizeof...(Ks);
+            while (r != 0 && ks[r - 1] == slice_index) {
+                --r;
+            }
+            if (r != 0)
+                --r;
+            while (r != 0) {
+                if (ks[--r] != slice_full)
+                    return false;
+            }
+            return true;
+        }
+
+        template<typename Layout, typename... Slices>
+        struct sub_layout
+        {
+            using type = layout_stride;
+        };
+        // Whether the last index of a slice is kept, so that its stride is
+        // still 1.
+        template<typename... Slices>
+        constexpr bool last_kept() noexcept
+        {
+            slice_kind const ks[] = {slice_traits_t<Slices>::kind...};
+            return ks[sizeof...(Slices) - 1] != slice_index;
+        }
+
+        template<typename... Slices>
+        struct sub_layout<layout_right, Slices...>
+        {
+            using type = std::conditional_t<
+                right_preserving<slice_traits_t<Slices>::kind...>(),
+                layout_right,
+                std::conditional_t<
+                    last_kept<Slices...>(),
+                    layout_right_padded,
+                    layout_stride>>;
+        };
+        template<typename... Slices>
+        struct sub_layout<layout_right_padded, Slices...>
+        {
+            using type = std::conditional_t<
+                last_kept<Slices...>(),
+                layout_right_padded,
+                layout_stride>;
+        };
+        template<typename... Slices>
+        struct sub_layout<layout_left, Slices...>
+        {
+            using type = std::conditional_t<
+                left_preserving<slice_traits_t<Slices>::kind...>(),
+                layout_left,
+                layout_stride>;
+        };
+
+        template<typename View, typename... Slices>
+        struct submd_result
+        {
+            using extents_type = typename sub_extents<
+                std::integer_sequence<std::ptrdiff_t>,
+                typename extents_sequence<typename View::extents_type>::type,
+                Slices...>::type;
+            using type = md_view<
+                typename View::element_type,
+                extents_type,
+                typename sub_layout<typename View::layout_type, Slices...>::
+                    type>;
+        };
+
+        // Constructs Extents from all of its extents, static or not.
+        template<typename Extents, std::size_t... Is>
+        constexpr Extents make_extents(
+            std::ptrdiff_t const * all, std::index_sequence<Is...>) noexcept
+        {
+            std::ptrdiff_t dynamic[Extents::rank_dynamic() + 1] = {};
+            std::size_t n = 0;
+            for (std::size_t r = 0; r < Extents::rank(); ++r) {
+                if (Extents::static_extent(r) == dynamic_extent)
+                    dynamic[n++] = all[r];
+            }
+            return Extents(dynamic[Is]...);
+        }
+
+        template<typename Mapping, typename Extents>
+        using strided_mapping = std::is_constructible<
+            Mapping,
+            Extents,
+            std::array<std::ptrdiff_t, Extents::rank()>>;
+
+        template<typename Mapping, typename Extents, std::size_t... Is>
+        constexpr auto make_mapping(
+            Extents e,
+            std::ptrdiff_t const *,
+            std::index_sequence<Is...>) noexcept
+            -> std::enable_if_t<
+                !strided_mapping<Mapping, Extents>::value,
+                Mapping>
+        {
+            return Mapping(e);
+        }
+        template<typename Mapping, typename Extents, std::size_t... Is>
+        constexpr auto make_mapping(
+            Extents e,
+            std::ptrdiff_t const * strides,
+            std::index_sequence<Is...>) noexcept
+            -> std::enable_if_t<
+                strided_mapping<Mapping, Extents>::value,
+                Mapping>
+        {
+            return Mapping(e, {{strides[Is]...}});
+        }
+    }
+
+#endif
+
+    /** Returns the slice of `v` given by `slices`, one for each dimension,
+        like `std::submdspan()`.  Each slice is one of:
+
+        - an index, which drops the dimension, as `submd(m, i, full_extent)`
+          is row `i` of a matrix `m`;
+
+        - `full_extent`, which keeps all of the dimension, with its static
+          extent, if any; or
+
+        - a `std::pair` `{first, last}`, which keeps the indices `[first,
+          last)`, with a dynamic extent.
+
+        The result has the layout of `v` if its elements are laid out the
+        same way, as are the rows of a `layout_right` matrix.  Otherwise, a
+        slice of a `layout_right` or `layout_right_padded` array that keeps
+        its last dimension is `layout_right_padded`, as is a block of a
+        matrix; and any other slice is `layout_stride`, as are the
+        columns. */
+    template<typename T, typename Extents, typename Layout, typename... Slices>
+    constexpr auto
+    submd(md_view<T, Extents, Layout> const & v, Slices const &... slices)
+        noexcept -> typename v1_dtl::
+            submd_result<md_view<T, Extents, Layout>, Slices...>::type
+    {
+        static_assert(
+            sizeof...(Slices) == Extents::rank(),
+            "submd() takes one slice per dimension.");
+        using result_type = typename v1_dtl::
+            submd_result<md_view<T, Extents, Layout>, Slices...>::type;
+        using result_extents = typename result_type::extents_type;
+        using result_mapping = typename result_type::mapping_type;
+
+        std::ptrdiff_t const firsts[] = {
+            v1_dtl::slice_traits_t<Slices>::first(slices)...};
+        v1_dtl::slice_kind const kinds[] = {
+            v1_dtl::slice_traits_t<Slices>::kind...};
+        std::size_t i = 0;
+        std::ptrdiff_t const sizes[] = {v1_dtl::slice_traits_t<Slices>::extent(
+            slices, v.extent(i++))...};
+
+        std::ptrdiff_t es[result_extents::rank()] = {};
+        std::ptrdiff_t strides[result_extents::rank()] = {};
+        std::ptrdiff_t offset = 0;
+        std::size_t n = 0;
+        for (std::size_t r = 0; r < Extents::rank(); ++r) {
+            BOOST_ASSERT(0 <= firsts[r] && firsts[r] <= v.extent(r));
+            offset += firsts[r] * v.stride(r);
+            if (kinds[r] != v1_dtl::slice_index) {
+                BOOST_ASSERT(firsts[r] + sizes[r] <= v.extent(r));
+                es[n] = sizes[r];
+                strides[n] = v.stride(r);
+                ++n;
+            }
+        }
+
+        return result_type(
+            v.data() + offset,
+            v1_dtl::make_mapping<result_mapping>(
+                v1_dtl::make_extents<result_extents>(
+                    es,
+                    std::make_index_sequence<
+                        result_extents::rank_dynamic()>{}),
+                strides,
+                std::make_index_sequence<result_extents::rank()>{}));
+    }
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    namespace v1_dtl {
+        template<std::size_t>
+        using full_extent_of = full_extent_t;
+
+        template<typename View, typename Is>
+        struct md_row;
+        template<typename View, std::size_t... Is>
+        struct md_row<View, std::index_sequence<Is...>>
+        {
+            using type = typename submd_result<
+                View,
+                std::ptrdiff_t,
+                full_extent_of<Is>...>::type;
+
+            static constexpr type call(View const & v, std::ptrdiff_t i)
+            {
+                return submd(v, i, full_extent_of<Is>{}...);
+            }
+        };
+
+        template<typename T, typename Extents, typename Layout>
+        using md_row_t = md_row<
+            md_view<T, Extents, Layout>,
+            std::make_index_sequence<Extents::rank() - 1>>;
+
+        template<typename T, typename Extents, typename Layout>
+        using md_row_iterator_interface_t = proxy_iterator_interface<
+            md_row_iterator<T, Extents, Layout>,
+            std::random_access_iterator_tag,
+            typename md_row_t<T, Extents, Layout>::type>;
+    }
+
+#endif
+
+    /** The iterator of an `md_view` of more than one dimension.  Its
+        elements are the slices of the view along its first index, such as
+        the rows of a matrix, each of which is an `md_view`.  It is random
+        access. */
+    template<typename T, typename Extents, typename Layout>
+    struct md_row_iterator
+        : v1_dtl::md_row_iterator_interface_t<T, Extents, Layout>
+    {
+        using view_type = md_view<T, Extents, Layout>;
+        using row_type = typename v1_dtl::md_row_t<T, Extents, Layout>::type;
+
+        constexpr md_row_iterator() noexcept : i_(0) {}
+        constexpr md_row_iterator(
+            view_type const & v, std::ptrdiff_t i) noexcept :
+            v_(v),
+            i_(i)
+        {}
+
+        constexpr row_type operator*() const noexcept
+        {
+            return v1_dtl::md_row_t<T, Extents, Layout>::call(v_, i_);
+        }
+        constexpr md_row_iterator & operator+=(std::ptrdiff_t n) noexcept
+        {
+            i_ += n;
+            return *this;
+        }
+        friend constexpr std::ptrdiff_t operator-(
+            md_row_iterator const & lhs, md_row_iterator const & rhs) noexcept
+        {
+            return lhs.i_ - rhs.i_;
+        }
+
+    private:
+        view_type v_;
+        std::ptrdiff_t i_;
+    };
+
+}}}
+
+#endif
@@ -0,0 +1,206 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_MMAP_VIEW_HPP
+#define BOOST_STL_INTERFACES_MMAP_VIEW_HPP
+
+#include <boost/stl_interfaces/view_interface.hpp>
+
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+    // How an mmap_view will be read, and how its mapping is placed.  These
+    // combine with |.
+    enum mmap_flags : unsigned {
+        // madvise(MADV_SEQUENTIAL): read ahead aggressively, and drop pages
+        // soon after they are read.
+        mmap_sequential = 1 << 0,
+        // madvise(MADV_RANDOM): do not read ahead.
+        mmap_random = 1 << 1,
+        // madvise(MADV_WILLNEED): start reading the whole file in now.
+        mmap_willneed = 1 << 2,
+        // Place the mapping at a huge page boundary, and ask for huge pages
+        // where the system supports them for file mappings.
+        mmap_huge_page_align = 1 << 3
+    };
+
+    //[ mmap_view_defn
+    // A read-only view of the records of type T in a file, mapped into memory
+    // with mmap(), rather than read into a buffer.  Pages are read in from the
+    // page cache as they are touched, so a view of a file of any size costs no
+    // memory of its own, and is ready as soon as the file is mapped.
+    //
+    // The file is records of sizeof(T) bytes each, written as the bytes of a T,
+    // so T must be trivially copyable.  A partial record at the end of the file
+    // is not part of the view.  The view owns the mapping, so it can be moved
+    // but not copied.  Failures to open or map the file are thrown as
+    // std::system_error.
+    template<typename T>
+    struct mmap_view : view_interface<mmap_view<T>, element_layout::contiguous>
+    {
+        static_assert(
+            std::is_trivially_copyable<T>::value,
+            "The records of an mmap_view are the bytes of Ts.");
+
+        // The granularity of mmap_huge_page_align.
+        static constexpr std::size_t huge_page_size = std::size_t(1) << 21;
+
+        mmap_view() noexcept : mapping_(nullptr), mapping_size_(0), size_(0) {}
+        explicit mmap_view(char const * path, unsigned flags = 0) : mmap_view()
+        {
+            int const fd = ::open(path, O_RDONLY | O_CLOEXEC);
+            if (fd < 0)
+                throw_errno("open");
+            struct stat st;
+            if (::fstat(fd, &st) != 0) {
+                int const error = errno;
+                ::close(fd);
+                throw_errno("fstat", error);
+            }
+            auto const bytes = std::size_t(st.st_size);
+            if (bytes < sizeof(T)) {
+                ::close(fd);
+                return;
+            }
+            void * const p = map(fd, bytes, flags);
+            int const error = errno;
+            ::close(fd);
+            if (p == MAP_FAILED)
+                throw_errno("mmap", error);
+            mapping_ = p;
+            mapping_size_ = bytes;
+            size_ = bytes / sizeof(T);
+            advise(flags);
+        }
+        mmap_view(mmap_view const &) = delete;
+        mmap_view(mmap_view && other) noexcept :
+            mapping_(std::exchange(other.mapping_, nullptr)),
+            mapping_size_(std::exchange(other.mapping_size_, 0)),
+            size_(std::exchange(other.size_, 0))
+        {}
+        mmap_view & operator=(mmap_view const &) = delete;
+        mmap_view & operator=(mmap_view && other) noexcept
+        {
+            mmap_view temp(std::move(other));
+            swap(temp);
+            return *this;
+        }
+        ~mmap_view()
+        {
+            if (mapping_)
+                ::munmap(mapping_, mapping_size_);
+        }
+
+        T const * begin() const noexcept
+        {
+            return static_cast<T const *>(mapping_);
+        }
+        T const * end() const noexcept { return begin() + size_; }
+
+        // The number of bytes mapped, which may include a partial record at the
+        // end.
+        std::size_t mapped_size() const noexcept { return mapping_size_; }
+
+        void swap(mmap_view & other) noexcept
+        {
+            std::swap(mapping_, other.mapping_);
+            std::swap(mapping_size_, other.mapping_size_);
+            std::swap(size_, other.size_);
+        }
+        friend void swap(mmap_view & lhs, mmap_view & rhs) noexcept
+        {
+            lhs.swap(rhs);
+        }
+
+    private:
+        [[noreturn]] static void throw_errno(
+            char const * what, int error = errno)
+        {
+            throw std::system_error(error, std::generic_category(), what);
+        }
+
+        // Maps bytes bytes of fd, at a huge page boundary if flags asks for it,
+        // by reserving enough address space to contain an aligned range,
+        // mapping the file over the aligned part of it, and unmapping the rest.
+        static void * map(int fd, std::size_t bytes, unsigned flags) noexcept
+        {
+            if (!(flags & mmap_huge_page_align))
+                return ::mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+
+            std::size_t const reserved = bytes + huge_page_size;
+            void * const reservation = ::mmap(
+                nullptr,
+                reserved,
+                PROT_NONE,
+                MAP_PRIVATE | MAP_ANONYMOUS,
+                -1,
+                0);
+            if (reservation == MAP_FAILED)
+                return MAP_FAILED;
+            auto const first = reinterpret_cast<std::uintptr_t>(reservation);
+            auto const aligned =
+                (first + huge_page_size - 1) & ~(huge_page_size - 1);
+            void * const p = ::mmap(
+                reinterpret_cast<void *>(aligned),
+                bytes,
+                PROT_READ,
+                MAP_PRIVATE | MAP_FIXED,
+                fd,
+                0);
+            if (p == MAP_FAILED) {
+                int const error = errno;
+                ::munmap(reservation, reserved);
+                errno = error;
+                return MAP_FAILED;
+            }
+            if (first != aligned)
+                ::munmap(reservation, aligned - first);
+            auto const page = std::size_t(::sysconf(_SC_PAGESIZE));
+            auto const mapped_end = (aligned + bytes + page - 1) & ~(page - 1);
+            if (mapped_end != first + reserved) {
+                ::munmap(
+                    reinterpret_cast<void *>(mapped_end),
+                    first + reserved - mapped_end);
+            }
+            return p;
+        }
+
+        // The hints are only hints, so a failure to apply one is not an error.
+        void advise(unsigned flags) noexcept
+        {
+            if (flags & mmap_sequential)
+                ::madvise(mapping_, mapping_size_, MADV_SEQUENTIAL);
+            if (flags & mmap_random)
+                ::madvise(mapping_, mapping_size_, MADV_RANDOM);
+            if (flags & mmap_willneed)
+                ::madvise(mapping_, mapping_size_, MADV_WILLNEED);
+#if defined(MADV_HUGEPAGE)
+            if (flags & mmap_huge_page_align)
+                ::madvise(mapping_, mapping_size_, MADV_HUGEPAGE);
+#endif
+        }
+
+        void * mapping_;
+        std::size_t mapping_size_;
+        std::size_t size_;
+    };
+    //]
+
+}}}
+
+#endif
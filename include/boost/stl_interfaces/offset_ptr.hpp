@@ -0,0 +1,285 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_OFFSET_PTR_HPP
+#define BOOST_STL_INTERFACES_OFFSET_PTR_HPP
+
+#include <boost/stl_interfaces/container_interface.hpp>
+#include <boost/stl_interfaces/iterator_interface.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+    //[ offset_ptr_defn
+    // A pointer that stores the distance from itself to the object it points
+    // to, instead of the object's address.  A structure that refers to other
+    // parts of the same block of memory only through offset_ptrs means the same
+    // thing wherever the block is: in a shared memory segment or a file that
+    // each process maps at a different address, or after a memcpy() of the
+    // whole block.  No pointer in it needs fixing up, and nothing needs to be
+    // serialized.
+    //
+    // Copying an offset_ptr copies the address it points to, not its offset,
+    // so a copy on the stack points to the same object as the original.  (A
+    // memcpy() of an offset_ptr alone does not; that only works as part of a
+    // copy of the whole block.)
+    //
+    // An offset of 1 means null; it would point into the offset_ptr itself.
+    template<typename T>
+    struct offset_ptr
+    {
+        using element_type = T;
+
+        offset_ptr() noexcept : offset_(null_offset) {}
+        offset_ptr(std::nullptr_t) noexcept : offset_(null_offset) {}
+        offset_ptr(T * p) noexcept : offset_(offset_to(p)) {}
+        offset_ptr(offset_ptr const & other) noexcept :
+            offset_(offset_to(other.get()))
+        {}
+        template<
+            typename U,
+            typename Enable =
+                std::enable_if_t<std::is_convertible<U *, T *>::value>>
+        offset_ptr(offset_ptr<U> const & other) noexcept :
+            offset_(offset_to(other.get()))
+        {}
+
+        offset_ptr & operator=(offset_ptr const & other) noexcept
+        {
+            offset_ = offset_to(other.get());
+            return *this;
+        }
+        offset_ptr & operator=(T * p) noexcept
+        {
+            offset_ = offset_to(p);
+            return *this;
+        }
+
+        // Like pointer arithmetic, this requires a non-null offset_ptr.  It
+        // just moves the offset, without going through an address.
+        offset_ptr & operator+=(std::ptrdiff_t n) noexcept
+        {
+            assert(offset_ != null_offset);
+            offset_ += n * std::ptrdiff_t(sizeof(T));
+            return *this;
+        }
+
+        T * get() const noexcept
+        {
+            if (offset_ == null_offset)
+                return nullptr;
+            return reinterpret_cast<T *>(
+                reinterpret_cast<std::uintptr_t>(this) + offset_);
+        }
+        T & operator*() const noexcept { return *get(); }
+        T * operator->() const noexcept { return get(); }
+        T & operator[](std::ptrdiff_t n) const noexcept { return get()[n]; }
+        explicit operator bool() const noexcept
+        {
+            return offset_ != null_offset;
+        }
+
+        friend bool operator==(offset_ptr const & lhs, offset_ptr const & rhs)
+        {
+            return lhs.get() == rhs.get();
+        }
+        friend bool operator!=(offset_ptr const & lhs, offset_ptr const & rhs)
+        {
+            return !(lhs == rhs);
+        }
+
+    private:
+        static constexpr std::ptrdiff_t null_offset = 1;
+
+        std::ptrdiff_t offset_to(T * p) const noexcept
+        {
+            if (!p)
+                return null_offset;
+            return std::ptrdiff_t(
+                reinterpret_cast<std::uintptr_t>(p) -
+                reinterpret_cast<std::uintptr_t>(this));
+        }
+
+        std::ptrdiff_t offset_;
+    };
+
+    template<typename T>
+    constexpr std::ptrdiff_t offset_ptr<T>::null_offset;
+    //]
+
+    //[ offset_iterator
+    // A random access iterator that is an offset_ptr, for positions that are
+    // themselves kept in a shared block -- a reader's cursor, or the end of
+    // the part of a log that has been processed.  An iterator on the stack can
+    // just as well be a T *; offset_vector's iterators are.  Each step of an
+    // offset_iterator goes through its own address, which keeps it in memory
+    // rather than in a register, so a long loop should start from get(), and
+    // iterate over T *s.
+    template<typename T>
+    struct offset_iterator : iterator_interface<
+                                 offset_iterator<T>,
+                                 std::random_access_iterator_tag,
+                                 std::remove_const_t<T>,
+                                 T &,
+                                 T *>
+    {
+        offset_iterator() noexcept : it_() {}
+        offset_iterator(T * it) noexcept : it_(it) {}
+        template<
+            typename U,
+            typename Enable =
+                std::enable_if_t<std::is_convertible<U *, T *>::value>>
+        offset_iterator(offset_iterator<U> other) noexcept : it_(other.get())
+        {}
+
+        T & operator*() const noexcept { return *it_; }
+        offset_iterator & operator+=(std::ptrdiff_t n) noexcept
+        {
+            it_ += n;
+            return *this;
+        }
+        friend std::ptrdiff_t
+        operator-(offset_iterator lhs, offset_iterator rhs) noexcept
+        {
+            return lhs.get() - rhs.get();
+        }
+
+        T * get() const noexcept { return it_.get(); }
+
+    private:
+        offset_ptr<T> it_;
+    };
+    //]
+
+    //[ offset_vector_defn
+    // A std::vector-like container whose elements live in a fixed-capacity
+    // buffer that the user provides, and which refers to that buffer only
+    // through an offset_ptr.  Put the offset_vector and its buffer in the same
+    // shared memory segment (or mapped file), and every process that maps it
+    // sees the same vector, wherever the segment lands in its address space.
+    // The elements must not hold ordinary pointers either, of course; an
+    // offset_vector of offset_vectors is fine, if their buffers are in the
+    // segment too.
+    //
+    // An offset_vector cannot be copied, since two of them cannot own the same
+    // buffer; moving one, or swap(), hands over its buffer.  Like
+    // static_vector, it never allocates, and inserting past capacity() throws
+    // std::length_error.
+    template<typename T>
+    struct offset_vector : container_interface<offset_vector<T>, contiguous>
+    {
+        using value_type = T;
+        using pointer = T *;
+        using const_pointer = T const *;
+        using reference = value_type &;
+        using const_reference = value_type const &;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using iterator = T *;
+        using const_iterator = T const *;
+
+        offset_vector() noexcept : elements_(), size_(0), capacity_(0) {}
+        // Uses the uninitialized storage at [buffer, buffer + capacity).
+        offset_vector(T * buffer, size_type capacity) noexcept :
+            elements_(buffer), size_(0), capacity_(capacity)
+        {}
+        offset_vector(offset_vector && other) noexcept : offset_vector()
+        {
+            swap(other);
+        }
+        offset_vector & operator=(offset_vector && other) noexcept
+        {
+            this->clear();
+            swap(other);
+            return *this;
+        }
+
+        iterator begin() noexcept { return elements_.get(); }
+        iterator end() noexcept { return elements_.get() + size_; }
+
+        size_type max_size() const noexcept { return capacity_; }
+        size_type capacity() const noexcept { return capacity_; }
+
+        template<
+            typename... Args,
+            typename Enable =
+                std::enable_if_t<std::is_constructible<T, Args &&...>::value>>
+        reference emplace_back(Args &&... args)
+        {
+            if (size_ == capacity_)
+                throw std::length_error("offset_vector is full.");
+            auto const p = end();
+            ::new (static_cast<void *>(p)) T(std::forward<Args>(args)...);
+            ++size_;
+            return *p;
+        }
+        template<
+            typename... Args,
+            typename Enable =
+                std::enable_if_t<std::is_constructible<T, Args &&...>::value>>
+        iterator emplace(const_iterator pos, Args &&... args)
+        {
+            auto position = const_cast<T *>(pos);
+            if (position == end()) {
+                emplace_back(std::forward<Args>(args)...);
+            } else {
+                // Constructed off to the side first, since args may refer to
+                // an element.
+                T x(std::forward<Args>(args)...);
+                emplace_back(std::move(this->back()));
+                std::move_backward(position, end() - 2, end() - 1);
+                *position = std::move(x);
+            }
+            return position;
+        }
+        iterator erase(const_iterator f, const_iterator l)
+        {
+            auto first = const_cast<T *>(f);
+            auto last = const_cast<T *>(l);
+            auto const new_end = std::move(last, end(), first);
+            std::for_each(new_end, end(), [](T & x) { x.~T(); });
+            size_ -= last - first;
+            return first;
+        }
+
+        void swap(offset_vector & other) noexcept
+        {
+            offset_ptr<T> const elements = elements_;
+            elements_ = other.elements_;
+            other.elements_ = elements;
+            std::swap(size_, other.size_);
+            std::swap(capacity_, other.capacity_);
+        }
+        friend void swap(offset_vector & lhs, offset_vector & rhs) noexcept
+        {
+            lhs.swap(rhs);
+        }
+
+        using base_type = container_interface<offset_vector<T>, contiguous>;
+        using base_type::begin;
+        using base_type::end;
+        using base_type::erase;
+
+    private:
+        offset_ptr<T> elements_;
+        size_type size_;
+        size_type capacity_;
+    };
+    //]
+
+}}}
+
+#endif
@@ -0,0 +1,454 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_PACKED_INT_VECTOR_HPP
+#define BOOST_STL_INTERFACES_PACKED_INT_VECTOR_HPP
+
+#include <boost/stl_interfaces/algorithm.hpp>
+#include <boost/stl_interfaces/container_interface.hpp>
+#include <boost/stl_interfaces/reverse_iterator.hpp>
+
+#include <algorithm>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <cassert>
+#include <cstdint>
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+    // Element i of a packed_int_vector<Bits> is the Bits bits starting at bit
+    // i * Bits of an array of 64-bit words, least significant bit first.  An
+    // element may straddle two words.  The array always has a word past the
+    // last element, so that reading an element can read the word after it
+    // unconditionally.
+    template<int Bits>
+    struct packed_fields
+    {
+        static_assert(0 < Bits && Bits <= 32, "Bits must be in [1, 32].");
+
+        using word = std::uint64_t;
+        static constexpr word mask = (word(1) << Bits) - 1;
+
+        static std::uint32_t get(word const * words, std::size_t i) noexcept
+        {
+            auto const bit = i * Bits;
+            auto const w = words + bit / 64;
+            auto const shift = int(bit % 64);
+            // The double shift is a shift by 64 - shift that is 0, rather than
+            // undefined, when shift is 0.
+            return std::uint32_t(
+                ((w[0] >> shift) | (w[1] << (63 - shift) << 1)) & mask);
+        }
+        // The same as get(words, J), for a J known at compile time, which makes
+        // the word index and the shifts constants.
+        template<std::size_t J>
+        static std::uint32_t get(word const * words) noexcept
+        {
+            constexpr auto k = J * Bits / 64;
+            constexpr auto shift = int(J * Bits % 64);
+            return std::uint32_t(
+                ((words[k] >> shift) | (words[k + 1] << (63 - shift) << 1)) &
+                mask);
+        }
+        // Unpacks the 64 elements in the Bits words starting at words.
+        template<std::size_t... Js>
+        static void unpack_block(
+            word const * words,
+            std::uint32_t * out,
+            std::index_sequence<Js...>) noexcept
+        {
+            using swallow = int[];
+            (void)swallow{0, (out[Js] = get<Js>(words), 0)...};
+        }
+        // Ors x into the zeroed bits of element J of the block starting at
+        // words, for a J known at compile time.
+        template<std::size_t J>
+        static void or_in(word * words, std::uint32_t x) noexcept
+        {
+            assert(x <= mask);
+            constexpr auto k = J * Bits / 64;
+            constexpr auto shift = int(J * Bits % 64);
+            words[k] |= word(x) << shift;
+            if (64 < shift + Bits)
+                words[k + 1] |= word(x) >> (63 - shift) >> 1;
+        }
+        // Packs 64 elements from in into the Bits words starting at words.
+        template<std::size_t... Js>
+        static void pack_block(
+            word * words,
+            std::uint32_t const * in,
+            std::index_sequence<Js...>) noexcept
+        {
+            std::fill(words, words + Bits, word(0));
+            using swallow = int[];
+            (void)swallow{0, (or_in<Js>(words, in[Js]), 0)...};
+        }
+        static void put(word * words, std::size_t i, std::uint32_t x) noexcept
+        {
+            assert(x <= mask);
+            auto const bit = i * Bits;
+            auto const w = words + bit / 64;
+            auto const shift = int(bit % 64);
+            w[0] = (w[0] & ~(mask << shift)) | (word(x) << shift);
+            if (64 < shift + Bits) {
+                auto const high_shift = 64 - shift;
+                w[1] = (w[1] & ~(mask >> high_shift)) | (word(x) >> high_shift);
+            }
+        }
+    };
+
+    //[ packed_int_blocks
+    // Unpacks the n elements starting at element i of words into out.
+    //
+    // Every 64 elements take exactly Bits words, so each aligned block of 64
+    // elements is unpacked by the same straight-line code: 64 expressions, each
+    // two shifts, an or, and a mask, whose word indices and shift amounts are
+    // all compile-time constants.  There is no per-element branch, division, or
+    // variable shift, and the compiler is free to vectorize the block.
+    template<int Bits>
+    void unpack_n(
+        std::uint64_t const * words,
+        std::size_t i,
+        std::size_t n,
+        std::uint32_t * out) noexcept
+    {
+        using fields = packed_fields<Bits>;
+        n += i;
+        for (; i < n && i % 64; ++i) {
+            *out++ = fields::get(words, i);
+        }
+        for (; i + 64 <= n; i += 64, out += 64) {
+            fields::unpack_block(
+                words + i / 64 * Bits, out, std::make_index_sequence<64>{});
+        }
+        for (; i < n; ++i) {
+            *out++ = fields::get(words, i);
+        }
+    }
+
+    // Packs the n elements of in into words, starting at element i; the
+    // inverse of unpack_n().  Each aligned block of 64 overwrites its Bits
+    // words whole, with no read-modify-write of the elements around it.
+    template<int Bits>
+    void pack_n(
+        std::uint64_t * words,
+        std::size_t i,
+        std::size_t n,
+        std::uint32_t const * in) noexcept
+    {
+        using fields = packed_fields<Bits>;
+        n += i;
+        for (; i < n && i % 64; ++i) {
+            fields::put(words, i, *in++);
+        }
+        for (; i + 64 <= n; i += 64, in += 64) {
+            fields::pack_block(
+                words + i / 64 * Bits, in, std::make_index_sequence<64>{});
+        }
+        for (; i < n; ++i) {
+            fields::put(words, i, *in++);
+        }
+    }
+    //]
+
+    //[ packed_int_reference
+    // The reference type of a mutable packed_int_iterator.  It converts to the
+    // element's value, and assigns through to the element's bits.  The
+    // reference type of a const packed_int_iterator is just std::uint32_t.
+    template<int Bits>
+    struct packed_int_reference
+    {
+        using word = std::uint64_t;
+
+        packed_int_reference(word * words, std::size_t i) noexcept :
+            words_(words),
+            i_(i)
+        {}
+        packed_int_reference(packed_int_reference const &) = default;
+
+        operator std::uint32_t() const noexcept
+        {
+            return packed_fields<Bits>::get(words_, i_);
+        }
+        packed_int_reference & operator=(std::uint32_t x) noexcept
+        {
+            packed_fields<Bits>::put(words_, i_, x);
+            return *this;
+        }
+        packed_int_reference &
+        operator=(packed_int_reference const & other) noexcept
+        {
+            return *this = std::uint32_t(other);
+        }
+
+        friend void
+        swap(packed_int_reference lhs, packed_int_reference rhs) noexcept
+        {
+            std::uint32_t const x = lhs;
+            lhs = std::uint32_t(rhs);
+            rhs = x;
+        }
+
+    private:
+        word * words_;
+        std::size_t i_;
+    };
+    //]
+
+    //[ packed_int_iterator
+    // W is std::uint64_t, or std::uint64_t const for a const_iterator.
+    template<int Bits, typename W>
+    struct packed_int_iterator : proxy_iterator_interface<
+                                     packed_int_iterator<Bits, W>,
+                                     std::random_access_iterator_tag,
+                                     std::uint32_t,
+                                     std::conditional_t<
+                                         std::is_const<W>::value,
+                                         std::uint32_t,
+                                         packed_int_reference<Bits>>>
+    {
+        using reference = std::conditional_t<
+            std::is_const<W>::value,
+            std::uint32_t,
+            packed_int_reference<Bits>>;
+
+        packed_int_iterator() noexcept : words_(nullptr), i_(0) {}
+        packed_int_iterator(W * words, std::ptrdiff_t i) noexcept :
+            words_(words),
+            i_(i)
+        {}
+        template<
+            typename W2,
+            typename E = std::enable_if_t<
+                std::is_same<W, W2 const>::value &&
+                !std::is_same<W, W2>::value>>
+        packed_int_iterator(packed_int_iterator<Bits, W2> other) noexcept :
+            words_(other.words()),
+            i_(other.index())
+        {}
+
+        reference operator*() const noexcept
+        {
+            return reference(deref(words_));
+        }
+        packed_int_iterator & operator+=(std::ptrdiff_t n) noexcept
+        {
+            i_ += n;
+            return *this;
+        }
+        friend std::ptrdiff_t
+        operator-(packed_int_iterator lhs, packed_int_iterator rhs) noexcept
+        {
+            return lhs.i_ - rhs.i_;
+        }
+
+        // The words the elements are in, and this iterator's element index
+        // within them.
+        W * words() const noexcept { return words_; }
+        std::ptrdiff_t index() const noexcept { return i_; }
+
+    private:
+        friend access;
+
+        // The batch operations behind stl_interfaces::read_n() and write_n(),
+        // which copy() and transform() from algorithm.hpp use to decode and
+        // encode 64 elements at a time.
+        void read_n(std::ptrdiff_t n, std::uint32_t * out) const noexcept
+        {
+            unpack_n<Bits>(words_, std::size_t(i_), std::size_t(n), out);
+        }
+        template<
+            typename W2 = W,
+            typename Enable = std::enable_if_t<!std::is_const<W2>::value>>
+        void write_n(std::ptrdiff_t n, std::uint32_t const * in) const noexcept
+        {
+            pack_n<Bits>(words_, std::size_t(i_), std::size_t(n), in);
+        }
+
+        std::uint32_t deref(std::uint64_t const * words) const noexcept
+        {
+            return packed_fields<Bits>::get(words, i_);
+        }
+        packed_int_reference<Bits> deref(std::uint64_t * words) const noexcept
+        {
+            return packed_int_reference<Bits>(words, i_);
+        }
+
+        W * words_;
+        std::ptrdiff_t i_;
+    };
+    //]
+
+
+    template<int Bits>
+    struct packed_int_vector;
+
+    // The words are in a std::vector, which destroys them; see flat_map.hpp.
+    template<int Bits>
+    struct trivially_destructible_container<packed_int_vector<Bits>>
+        : std::true_type
+    {};
+
+    //[ packed_int_vector_defn
+    // A sequence of unsigned integers of Bits bits each, packed into 64-bit
+    // words.  Assigning a value that does not fit in Bits bits is a
+    // precondition violation.
+    template<int Bits>
+    struct packed_int_vector : container_interface<packed_int_vector<Bits>>
+    {
+        // types
+        using value_type = std::uint32_t;
+        using reference = packed_int_reference<Bits>;
+        using const_reference = std::uint32_t;
+        using iterator = packed_int_iterator<Bits, std::uint64_t>;
+        using const_iterator = packed_int_iterator<Bits, std::uint64_t const>;
+        using reverse_iterator = stl_interfaces::reverse_iterator<iterator>;
+        using const_reverse_iterator =
+            stl_interfaces::reverse_iterator<const_iterator>;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+
+        static constexpr int bits = Bits;
+        // The largest element value.
+        static constexpr std::uint32_t max_value = packed_fields<Bits>::mask;
+
+        // construct/copy/destroy (9 members, skipped 2)
+        packed_int_vector() noexcept : size_(0) {}
+        explicit packed_int_vector(size_type n, std::uint32_t x = 0) : size_(0)
+        {
+            resize(n, x);
+        }
+        template<
+            typename InputIterator,
+            typename Enable = std::enable_if_t<std::is_convertible<
+                typename std::iterator_traits<InputIterator>::iterator_category,
+                std::input_iterator_tag>::value>>
+        packed_int_vector(InputIterator first, InputIterator last) : size_(0)
+        {
+            for (; first != last; ++first) {
+                this->push_back(*first);
+            }
+        }
+        packed_int_vector(std::initializer_list<std::uint32_t> il) :
+            packed_int_vector(il.begin(), il.end())
+        {}
+        packed_int_vector(packed_int_vector const & other) = default;
+        packed_int_vector(packed_int_vector && other) noexcept :
+            words_(std::move(other.words_)),
+            size_(std::exchange(other.size_, 0))
+        {
+            other.words_.clear();
+        }
+        packed_int_vector &
+        operator=(packed_int_vector const & other) = default;
+        packed_int_vector & operator=(packed_int_vector && other) noexcept
+        {
+            packed_int_vector temp(std::move(other));
+            swap(temp);
+            return *this;
+        }
+        ~packed_int_vector() = default;
+
+        // iterators (2 members, skipped 10)
+        iterator begin() noexcept { return iterator(words_.data(), 0); }
+        iterator end() noexcept { return iterator(words_.data(), size_); }
+
+        // capacity (6 members, skipped 2)
+        size_type size() const noexcept { return size_; }
+        size_type max_size() const noexcept
+        {
+            return std::numeric_limits<difference_type>::max() / 64;
+        }
+        void resize(size_type n, std::uint32_t x = 0)
+        {
+            words_.resize(words_for(n));
+            for (auto i = size_; i < n; ++i) {
+                packed_fields<Bits>::put(words_.data(), i, x);
+            }
+            size_ = n;
+        }
+        size_type capacity() const noexcept
+        {
+            return words_.capacity() ? (words_.capacity() - 1) * 64 / Bits : 0;
+        }
+        void reserve(size_type n) { words_.reserve(words_for(n)); }
+        void shrink_to_fit() { words_.shrink_to_fit(); }
+
+        // modifiers (5 members, skipped 10)
+        reference emplace_back(std::uint32_t x)
+        {
+            words_.resize(words_for(size_ + 1));
+            auto retval = reference(words_.data(), size_++);
+            return retval = x;
+        }
+        void pop_back() noexcept
+        {
+            assert(size_);
+            --size_;
+        }
+        // The elements after the insertion point are moved one at a time.
+        iterator emplace(const_iterator pos, std::uint32_t x)
+        {
+            auto const i = pos - this->cbegin();
+            push_back(0);
+            auto const first = begin();
+            for (auto j = difference_type(size_) - 1; i < j; --j) {
+                first[j] = first[j - 1];
+            }
+            first[i] = x;
+            return first + i;
+        }
+        iterator erase(const_iterator first, const_iterator last) noexcept
+        {
+            auto const i = first - this->cbegin();
+            auto const n = last - first;
+            auto const it = begin();
+            for (auto j = i; j + n < difference_type(size_); ++j) {
+                it[j] = it[j + n];
+            }
+            size_ -= n;
+            return begin() + i;
+        }
+        void swap(packed_int_vector & other) noexcept
+        {
+            words_.swap(other.words_);
+            std::swap(size_, other.size_);
+        }
+        friend void
+        swap(packed_int_vector & lhs, packed_int_vector & rhs) noexcept
+        {
+            lhs.swap(rhs);
+        }
+
+        // The words holding the elements.
+        std::uint64_t const * words() const noexcept { return words_.data(); }
+
+        using base_type = container_interface<packed_int_vector<Bits>>;
+        using base_type::begin;
+        using base_type::end;
+        using base_type::push_back;
+        using base_type::erase;
+
+    private:
+        // The words for n elements, plus the one past the last element.
+        static size_type words_for(size_type n) noexcept
+        {
+            return n ? (n * Bits + 63) / 64 + 1 : 0;
+        }
+
+        std::vector<std::uint64_t> words_;
+        size_type size_;
+    };
+    //]
+
+}}}
+
+#endif
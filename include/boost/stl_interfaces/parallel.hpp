@@ -0,0 +1,1117 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_PARALLEL_HPP
+#define BOOST_STL_INTERFACES_PARALLEL_HPP
+
+#include <boost/stl_interfaces/iterator_interface.hpp>
+#include <boost/stl_interfaces/scratch.hpp>
+#include <boost/stl_interfaces/to.hpp>
+#include <boost/stl_interfaces/view_interface.hpp>
+#include <boost/stl_interfaces/detail/simd.hpp>
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <thread>
+#include <utility>
+#include <vector>
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+    namespace v1_dtl {
+        template<typename View>
+        using split_iter_t = decltype(std::declval<View const &>().begin());
+
+        template<typename View, typename = void>
+        struct splittable_view : std::false_type
+        {
+        };
+        template<typename View>
+        struct splittable_view<
+            View,
+            void_t<
+                decltype(v1_dtl::derived_view(std::declval<View const &>())),
+                decltype(View(
+                    std::declval<split_iter_t<View>>(),
+                    std::declval<split_iter_t<View>>()))>>
+            : std::integral_constant<
+                  bool,
+                  std::is_same<
+                      split_iter_t<View>,
+                      decltype(std::declval<View const &>().end())>::value &&
+                      std::is_convertible<
+                          typename std::iterator_traits<
+                              split_iter_t<View>>::iterator_category,
+                          std::random_access_iterator_tag>::value>
+        {
+        };
+    }
+
+    /** `std::true_type` if `View` can be split into sub-views of the same
+        type, by `split_at()` and `split()`; `std::false_type` otherwise.
+
+        `View` must be derived from `view_interface`; must be a common range
+        -- `begin()` and `end()` return the same type -- whose iterators are
+        random access; and must be constructible from a pair of its
+        iterators, like a `subrange`. */
+    template<typename View>
+    using is_splittable_view = v1_dtl::splittable_view<View>;
+
+    /** Returns the views `[v.begin(), mid)` and `[mid, v.end())`, each of
+        type `View`.
+
+        \pre `mid` is in `[v.begin(), v.end()]`. */
+    template<
+        typename View,
+        typename Enable = std::enable_if_t<is_splittable_view<View>::value>>
+    std::pair<View, View>
+    split_at(View const & v, v1_dtl::split_iter_t<View> mid)
+    {
+        return std::pair<View, View>(View(v.begin(), mid), View(mid, v.end()));
+    }
+
+    /** Returns `v` split into `min(n, size)` contiguous sub-views of type
+        `View`, in order, where `size` is the number of elements in `v`.  The
+        sizes of the sub-views differ by at most one.  If `v` is empty, the
+        result is empty.
+
+        \pre `0 < n` */
+    template<
+        typename View,
+        typename Enable = std::enable_if_t<is_splittable_view<View>::value>>
+    std::vector<View> split(View const & v, std::ptrdiff_t n)
+    {
+        BOOST_ASSERT(0 < n);
+        std::vector<View> retval;
+        auto first = v.begin();
+        auto const size = std::ptrdiff_t(v.end() - first);
+        n = (std::min)(n, size);
+        retval.reserve(n);
+        auto const base_size = n ? size / n : 0;
+        auto const remainder = n ? size % n : 0;
+        for (std::ptrdiff_t i = 0; i < n; ++i) {
+            auto const last = first + (base_size + (i < remainder));
+            retval.push_back(View(first, last));
+            first = last;
+        }
+        return retval;
+    }
+
+    /** Applies `f` to each element of `v`, using up to `threads` threads, in
+        fork-join fashion: `v` is split in two with `split_at()`, one half is
+        handed to a new thread along with a share of the thread budget, and
+        the other half is processed on the calling thread, recursively.
+        Halves containing no more than `grain_size` elements are processed
+        sequentially.  The call returns when all elements have been
+        processed.
+
+        `f` is called concurrently from multiple threads, and must be safe to
+        call that way.  The order in which elements are visited is
+        unspecified.  If any call to `f` throws, one of the exceptions is
+        rethrown after all the threads have finished.
+
+        \pre `0 < grain_size` */
+    template<
+        typename View,
+        typename F,
+        typename Enable = std::enable_if_t<is_splittable_view<View>::value>>
+    void parallel_for_each(
+        View const & v,
+        F const & f,
+        std::ptrdiff_t grain_size = 1024,
+        unsigned int threads = std::thread::hardware_concurrency())
+    {
+        BOOST_ASSERT(0 < grain_size);
+        auto const size = std::ptrdiff_t(v.end() - v.begin());
+        if (threads <= 1 || size <= grain_size) {
+            std::for_each(v.begin(), v.end(), f);
+            return;
+        }
+
+        // The first half gets the calling thread and its share of the
+        // budget; the second half gets a new thread and the rest.
+        unsigned int const first_threads = threads / 2;
+        auto const mid = v.begin() + size * first_threads / threads;
+        auto const halves = stl_interfaces::split_at(v, mid);
+        auto second = std::async(std::launch::async, [&] {
+            stl_interfaces::parallel_for_each(
+                halves.second, f, grain_size, threads - first_threads);
+        });
+        try {
+            stl_interfaces::parallel_for_each(
+                halves.first, f, grain_size, first_threads);
+        } catch (...) {
+            second.wait();
+            throw;
+        }
+        second.get();
+    }
+
+    /** A fixed set of worker threads, which run the tasks submitted to
+        them in order.  The destructor runs the tasks still queued, and then
+        joins the threads.
+
+        `thread_pool` is the default pool of the iterator overloads of
+        `parallel_for_each()`, `parallel_transform()` and
+        `parallel_reduce()`, but any type with the same `size()` and
+        `submit()` members may be used in its place, such as an adaptor for
+        an application's own pool. */
+    struct thread_pool
+    {
+        /** Starts `threads` worker threads.  With 0 threads, the algorithms
+            run on the calling thread. */
+        explicit thread_pool(
+            unsigned int threads = std::thread::hardware_concurrency())
+        {
+            threads_.reserve(threads);
+            for (unsigned int i = 0; i < threads; ++i) {
+                threads_.emplace_back([this] { run(); });
+            }
+        }
+        ~thread_pool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                stop_ = true;
+            }
+            cv_.notify_all();
+            for (auto & thread : threads_) {
+                thread.join();
+            }
+        }
+        thread_pool(thread_pool const &) = delete;
+        thread_pool & operator=(thread_pool const &) = delete;
+
+        /** Returns the number of worker threads. */
+        unsigned int size() const noexcept
+        {
+            return (unsigned int)threads_.size();
+        }
+
+        /** Queues `task` to be run on one of the worker threads. */
+        void submit(std::function<void()> task)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                tasks_.push_back(std::move(task));
+            }
+            cv_.notify_one();
+        }
+
+    private:
+        void run()
+        {
+            for (;;) {
+                std::function<void()> task;
+                {
+                    std::unique_lock<std::mutex> lock(mutex_);
+                    cv_.wait(lock, [this] { return stop_ || !tasks_.empty(); });
+                    if (tasks_.empty())
+                        return;
+                    task = std::move(tasks_.front());
+                    tasks_.pop_front();
+                }
+                task();
+            }
+        }
+
+        std::mutex mutex_;
+        std::condition_variable cv_;
+        std::deque<std::function<void()>> tasks_;
+        bool stop_ = false;
+        std::vector<std::thread> threads_;
+    };
+
+    /** Returns the pool used by the parallel algorithms when none is given:
+        a `thread_pool` of `std::thread::hardware_concurrency() - 1`
+        workers, since the calling thread also does its share. */
+    inline thread_pool & default_thread_pool()
+    {
+        static thread_pool pool(
+            (std::max)(std::thread::hardware_concurrency(), 1u) - 1);
+        return pool;
+    }
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    namespace v1_dtl {
+        template<typename Pool>
+        using pool_submit_t = decltype(std::declval<Pool &>().submit(
+            std::declval<std::function<void()>>()));
+        template<typename Pool>
+        using pool_size_t = decltype(std::declval<Pool const &>().size());
+
+        template<typename Pool>
+        using is_pool = std::integral_constant<
+            bool,
+            detail::detector<void, pool_submit_t, Pool>::value &&
+                detail::detector<void, pool_size_t, Pool>::value>;
+
+        template<typename Iter>
+        using is_ra_iter = std::is_convertible<
+            typename std::iterator_traits<Iter>::iterator_category,
+            std::random_access_iterator_tag>;
+
+        template<typename Iter>
+        using to_address_result_t =
+            decltype(stl_interfaces::to_address(std::declval<Iter const &>()));
+
+        // Contiguous iterators are handed to the workers as pointers, so
+        // that each worker's loop is a plain pointer loop.  to_address() is
+        // only looked at for contiguous iterators; for an adaptor such as
+        // transform_iterator, whose base() is not contiguous, it does not
+        // compile.
+        template<
+            typename Iter,
+            bool Contiguous = is_contiguous_iterator<Iter>::value>
+        struct parallel_as_pointer
+            : detail::detector<void, to_address_result_t, Iter>
+        {
+        };
+        template<typename Iter>
+        struct parallel_as_pointer<Iter, false> : std::false_type
+        {
+        };
+
+        template<typename Iter>
+        constexpr auto parallel_iter(Iter it, std::true_type) noexcept
+        {
+            return stl_interfaces::to_address(it);
+        }
+        template<typename Iter>
+        constexpr Iter parallel_iter(Iter it, std::false_type) noexcept
+        {
+            return it;
+        }
+        template<typename Iter>
+        constexpr auto parallel_iter(Iter it) noexcept
+        {
+            return v1_dtl::parallel_iter(it, parallel_as_pointer<Iter>{});
+        }
+
+        // The number of chunks to split n elements into: enough that the
+        // workers can balance uneven chunks, but none smaller than
+        // grain_size elements.
+        template<typename Pool>
+        std::ptrdiff_t parallel_chunks(
+            Pool const & pool, std::ptrdiff_t n, std::ptrdiff_t grain_size)
+        {
+            BOOST_ASSERT(0 < grain_size);
+            std::ptrdiff_t const threads = std::ptrdiff_t(pool.size()) + 1;
+            return (std::min)((n + grain_size - 1) / grain_size, 4 * threads);
+        }
+
+        template<typename Body>
+        struct parallel_state
+        {
+            parallel_state(
+                Body const & body, std::ptrdiff_t n, std::ptrdiff_t chunks) :
+                body_(&body),
+                n_(n),
+                chunks_(chunks),
+                next_(0),
+                done_(0)
+            {}
+
+            // Runs chunks until none are left.  A task that starts after
+            // the algorithm has returned finds none, and does not touch
+            // body_.
+            void work()
+            {
+                for (;;) {
+                    std::ptrdiff_t const c = next_++;
+                    if (chunks_ <= c)
+                        return;
+                    try {
+                        (*body_)(c, c * n_ / chunks_, (c + 1) * n_ / chunks_);
+                    } catch (...) {
+                        std::lock_guard<std::mutex> lock(mutex_);
+                        if (!error_)
+                            error_ = std::current_exception();
+                    }
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    if (++done_ == chunks_)
+                        cv_.notify_all();
+                }
+            }
+
+            void wait()
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cv_.wait(lock, [this] { return done_ == chunks_; });
+                if (error_)
+                    std::rethrow_exception(error_);
+            }
+
+        private:
+            Body const * body_;
+            std::ptrdiff_t n_;
+            std::ptrdiff_t chunks_;
+            std::atomic<std::ptrdiff_t> next_;
+            std::ptrdiff_t done_;
+            std::mutex mutex_;
+            std::condition_variable cv_;
+            std::exception_ptr error_;
+        };
+
+        // Calls body(c, first, last) for each chunk c of [0, n), on the
+        // workers of pool and on the calling thread.  The calling thread
+        // takes chunks too, so the call finishes even if the pool's workers
+        // are all busy -- as they are when this is called from one of
+        // them.
+        template<typename Pool, typename Body>
+        void parallel_run(
+            Pool & pool,
+            std::ptrdiff_t n,
+            std::ptrdiff_t chunks,
+            Body const & body)
+        {
+            if (chunks <= 1 || pool.size() == 0) {
+                for (std::ptrdiff_t c = 0; c < chunks; ++c) {
+                    body(c, c * n / chunks, (c + 1) * n / chunks);
+                }
+                return;
+            }
+            auto const state =
+                std::make_shared<parallel_state<Body>>(body, n, chunks);
+            auto const helpers =
+                (std::min)(std::ptrdiff_t(pool.size()), chunks - 1);
+            for (std::ptrdiff_t i = 0; i < helpers; ++i) {
+                pool.submit([state] { state->work(); });
+            }
+            state->work();
+            state->wait();
+        }
+
+        // Sorting on one thread needs no runs to merge, so a pool without
+        // workers gets a single chunk.
+        template<typename Pool>
+        std::ptrdiff_t sort_chunks(
+            Pool const & pool, std::ptrdiff_t n, std::ptrdiff_t grain_size)
+        {
+            return pool.size() == 0
+                       ? std::ptrdiff_t(1)
+                       : v1_dtl::parallel_chunks(pool, n, grain_size);
+        }
+
+        template<typename Op, typename T>
+        using is_plus = std::integral_constant<
+            bool,
+            std::is_same<Op, std::plus<>>::value ||
+                std::is_same<Op, std::plus<T>>::value>;
+
+        // Scans of integers by std::plus over pointers use the SIMD
+        // kernel, whose lanes are unsigned, so that the sums wrap as
+        // unsigned scalar ones would.
+        template<typename InPtr, typename OutPtr, typename Op>
+        using simd_scannable = std::integral_constant<
+            bool,
+            std::is_pointer<InPtr>::value &&
+                std::is_same<
+                    std::remove_cv_t<std::remove_pointer_t<InPtr>>,
+                    std::remove_pointer_t<OutPtr>>::value &&
+                std::is_integral<std::remove_pointer_t<OutPtr>>::value &&
+                !std::is_same<std::remove_pointer_t<OutPtr>, bool>::value &&
+                is_plus<Op, std::remove_pointer_t<OutPtr>>::value>;
+
+        // Writes the running op-sums of [first, first + n) to out, starting
+        // from sum, including each element if Inclusive is true, and
+        // returns the sum of all of them.  out may be first.
+        template<
+            bool Inclusive,
+            typename In,
+            typename Out,
+            typename T,
+            typename Op>
+        T scan_chunk(
+            In first,
+            std::ptrdiff_t n,
+            Out out,
+            T sum,
+            Op const & op,
+            std::false_type)
+        {
+            for (std::ptrdiff_t i = 0; i < n; ++i) {
+                T x = first[i];
+                if (Inclusive) {
+                    sum = op(std::move(sum), std::move(x));
+                    out[i] = sum;
+                } else {
+                    out[i] = sum;
+                    sum = op(std::move(sum), std::move(x));
+                }
+            }
+            return sum;
+        }
+        template<
+            bool Inclusive,
+            typename In,
+            typename Out,
+            typename T,
+            typename Op>
+        T scan_chunk(
+            In first,
+            std::ptrdiff_t n,
+            Out out,
+            T sum,
+            Op const &,
+            std::true_type)
+        {
+            using lane_t =
+                typename detail::simd_int_lane<sizeof(T), false>::type;
+            return detail::simd_scan<lane_t, Inclusive>(
+                first, std::size_t(n), out, sum);
+        }
+
+        // The two-pass blocked scan: each chunk is reduced, the chunks'
+        // sums are scanned in order on the calling thread, and then each
+        // chunk is scanned from the sum of the chunks before it.  With one
+        // chunk, the range is scanned once.  Inclusive scans have no init,
+        // so the first element of a chunk starts its reduction.
+        template<
+            bool Inclusive,
+            typename Pool,
+            typename Iter,
+            typename OutIter,
+            typename T,
+            typename Op>
+        OutIter parallel_scan(
+            Pool & pool,
+            Iter first,
+            Iter last,
+            OutIter out,
+            T init,
+            bool has_init,
+            Op const & op,
+            std::ptrdiff_t grain_size)
+        {
+            auto const it = v1_dtl::parallel_iter(first);
+            auto const out_it = v1_dtl::parallel_iter(out);
+            using simd = simd_scannable<
+                std::remove_cv_t<decltype(it)>,
+                std::remove_cv_t<decltype(out_it)>,
+                Op>;
+            std::ptrdiff_t const n = last - first;
+            if (!n)
+                return out;
+            auto const chunks = v1_dtl::parallel_chunks(pool, n, grain_size);
+
+            if (chunks == 1 || pool.size() == 0) {
+                std::ptrdiff_t b = 0;
+                if (!has_init) {
+                    init = it[0];
+                    out_it[0] = init;
+                    b = 1;
+                }
+                v1_dtl::scan_chunk<Inclusive>(
+                    it + b, n - b, out_it + b, std::move(init), op, simd{});
+                return out + n;
+            }
+
+            // The last chunk's sum is not needed.
+            scratch_vector<T> sums(chunks - 1, init);
+            v1_dtl::parallel_run(
+                pool,
+                n,
+                chunks,
+                [&](std::ptrdiff_t c, std::ptrdiff_t b, std::ptrdiff_t e) {
+                    if (c == chunks - 1)
+                        return;
+                    sums[c] =
+                        std::accumulate(it + b + 1, it + e, T(it[b]), op);
+                });
+            scratch_vector<T> starts;
+            starts.reserve(chunks);
+            starts.push_back(init);
+            for (std::ptrdiff_t c = 1; c < chunks; ++c) {
+                starts.push_back(
+                    c == 1 && !has_init ? sums[0]
+                                        : op(starts.back(), sums[c - 1]));
+            }
+            v1_dtl::parallel_run(
+                pool,
+                n,
+                chunks,
+                [&](std::ptrdiff_t c, std::ptrdiff_t b, std::ptrdiff_t e) {
+                    T start = starts[c];
+                    if (c == 0 && !has_init) {
+                        start = it[0];
+                        out_it[0] = start;
+                        ++b;
+                    }
+                    v1_dtl::scan_chunk<Inclusive>(
+                        it + b,
+                        e - b,
+                        out_it + b,
+                        std::move(start),
+                        op,
+                        simd{});
+                });
+            return out + n;
+        }
+
+        // Compactions of small trivially copyable elements from pointer to
+        // pointer are branch-free.
+        template<typename InPtr, typename OutPtr>
+        using branch_free_compactable = std::integral_constant<
+            bool,
+            std::is_pointer<InPtr>::value && std::is_pointer<OutPtr>::value &&
+                std::is_same<
+                    std::remove_cv_t<std::remove_pointer_t<InPtr>>,
+                    std::remove_pointer_t<OutPtr>>::value &&
+                std::is_trivially_copyable<
+                    std::remove_pointer_t<OutPtr>>::value &&
+                sizeof(std::remove_pointer_t<OutPtr>) <= 16>;
+
+        template<typename In, typename Out, typename Pred>
+        Out copy_if_chunk(
+            In first, In last, Out out, Pred const & pred, std::false_type)
+        {
+            return std::copy_if(first, last, out, pred);
+        }
+        // Each element is written to a buffer, and the buffer's end is
+        // advanced by pred(x), so there is no branch on pred(x) to
+        // mispredict; a filter that keeps half its input at random would
+        // mispredict every other element.  Full buffers are copied to out.
+        template<typename In, typename T, typename Pred>
+        T * copy_if_chunk(
+            In first, In last, T * out, Pred const & pred, std::true_type)
+        {
+            std::ptrdiff_t const block = 256;
+            alignas(T) unsigned char buf[block * sizeof(T)];
+            while (first != last) {
+                auto const block_last =
+                    first + (std::min)(last - first, block);
+                std::ptrdiff_t k = 0;
+                for (; first != block_last; ++first) {
+                    std::memcpy(buf + k * sizeof(T), first, sizeof(T));
+                    k += pred(*first) ? 1 : 0;
+                }
+                std::memcpy(out, buf, std::size_t(k) * sizeof(T));
+                out += k;
+            }
+            return out;
+        }
+
+        template<typename Pool, typename Src, typename Dst>
+        void parallel_move(
+            Pool & pool,
+            Src src,
+            std::ptrdiff_t n,
+            Dst dst,
+            std::ptrdiff_t grain_size)
+        {
+            v1_dtl::parallel_run(
+                pool,
+                n,
+                v1_dtl::parallel_chunks(pool, n, grain_size),
+                [&](std::ptrdiff_t, std::ptrdiff_t b, std::ptrdiff_t e) {
+                    std::move(src + b, src + e, dst + b);
+                });
+        }
+    }
+
+#endif
+
+    /** Calls `f` on each element of the random access range `[first,
+        last)`, using the workers of `pool` and the calling thread.  The
+        range is split into chunks of at least `grain_size` elements, by
+        `operator-()` and `operator+()` on the iterators; the workers and
+        the calling thread each take chunks until none remain.  If `Iter`
+        is contiguous (see `is_contiguous_iterator`), each chunk is handed
+        to `f`'s loop as a range of pointers.
+
+        `f` is called concurrently from multiple threads, and must be safe
+        to call that way.  If any call to `f` throws, one of the exceptions
+        is rethrown after all the chunks have finished.
+
+        `Pool` must have the members `size()`, the number of its worker
+        threads, and `submit(task)`, which eventually runs the
+        `std::function<void()>` `task` on one of them; see `thread_pool`.
+
+        \pre `0 < grain_size` */
+    template<
+        typename Pool,
+        typename Iter,
+        typename F,
+        typename Enable = std::enable_if_t<
+            v1_dtl::is_pool<Pool>::value && v1_dtl::is_ra_iter<Iter>::value>>
+    void parallel_for_each(
+        Pool & pool,
+        Iter first,
+        Iter last,
+        F const & f,
+        std::ptrdiff_t grain_size = 1024)
+    {
+        auto const it = v1_dtl::parallel_iter(first);
+        std::ptrdiff_t const n = last - first;
+        v1_dtl::parallel_run(
+            pool,
+            n,
+            v1_dtl::parallel_chunks(pool, n, grain_size),
+            [&](std::ptrdiff_t, std::ptrdiff_t b, std::ptrdiff_t e) {
+                std::for_each(it + b, it + e, f);
+            });
+    }
+
+    /** Calls `f` on each element of `[first, last)`, using
+        `default_thread_pool()`. */
+    template<
+        typename Iter,
+        typename F,
+        typename Enable = std::enable_if_t<v1_dtl::is_ra_iter<Iter>::value>>
+    void parallel_for_each(
+        Iter first, Iter last, F const & f, std::ptrdiff_t grain_size = 1024)
+    {
+        stl_interfaces::parallel_for_each(
+            default_thread_pool(), first, last, f, grain_size);
+    }
+
+    /** Writes `f(x)` for each element `x` of the random access range
+        `[first, last)` to the random access range starting at `out`, in
+        parallel, like `std::transform()`, and returns the end of the
+        output.  The work is split as in `parallel_for_each()`; the input
+        and output are each handed to the workers as pointers if they are
+        contiguous.
+
+        \pre `0 < grain_size` */
+    template<
+        typename Pool,
+        typename Iter,
+        typename OutIter,
+        typename F,
+        typename Enable = std::enable_if_t<
+            v1_dtl::is_pool<Pool>::value && v1_dtl::is_ra_iter<Iter>::value &&
+            v1_dtl::is_ra_iter<OutIter>::value>>
+    OutIter parallel_transform(
+        Pool & pool,
+        Iter first,
+        Iter last,
+        OutIter out,
+        F const & f,
+        std::ptrdiff_t grain_size = 1024)
+    {
+        auto const it = v1_dtl::parallel_iter(first);
+        auto const out_it = v1_dtl::parallel_iter(out);
+        std::ptrdiff_t const n = last - first;
+        v1_dtl::parallel_run(
+            pool,
+            n,
+            v1_dtl::parallel_chunks(pool, n, grain_size),
+            [&](std::ptrdiff_t, std::ptrdiff_t b, std::ptrdiff_t e) {
+                std::transform(it + b, it + e, out_it + b, f);
+            });
+        return out + n;
+    }
+
+    /** Writes `f(x)` for each element `x` of `[first, last)` to `out`, using
+        `default_thread_pool()`. */
+    template<
+        typename Iter,
+        typename OutIter,
+        typename F,
+        typename Enable = std::enable_if_t<
+            v1_dtl::is_ra_iter<Iter>::value &&
+            v1_dtl::is_ra_iter<OutIter>::value>>
+    OutIter parallel_transform(
+        Iter first,
+        Iter last,
+        OutIter out,
+        F const & f,
+        std::ptrdiff_t grain_size = 1024)
+    {
+        return stl_interfaces::parallel_transform(
+            default_thread_pool(), first, last, out, f, grain_size);
+    }
+
+    /** Returns `init op x0 op x1 ...` for the elements `x0, x1, ...` of the
+        random access range `[first, last)`, in parallel.  The work is split
+        as in `parallel_for_each()`; each chunk is reduced on its own, in
+        order, and then `init` and the chunks' results are reduced, in
+        order.  So `op` must be associative, but need not be commutative.
+
+        \pre `0 < grain_size` */
+    template<
+        typename Pool,
+        typename Iter,
+        typename T,
+        typename Op,
+        typename Enable = std::enable_if_t<
+            v1_dtl::is_pool<Pool>::value && v1_dtl::is_ra_iter<Iter>::value>>
+    T parallel_reduce(
+        Pool & pool,
+        Iter first,
+        Iter last,
+        T init,
+        Op const & op,
+        std::ptrdiff_t grain_size = 1024)
+    {
+        auto const it = v1_dtl::parallel_iter(first);
+        std::ptrdiff_t const n = last - first;
+        auto const chunks = v1_dtl::parallel_chunks(pool, n, grain_size);
+        v1_dtl::scratch_vector<T> partials(chunks, init);
+        v1_dtl::parallel_run(
+            pool,
+            n,
+            chunks,
+            [&](std::ptrdiff_t c, std::ptrdiff_t b, std::ptrdiff_t e) {
+                partials[c] = std::accumulate(it + b + 1, it + e, T(it[b]), op);
+            });
+        for (auto & partial : partials) {
+            init = op(std::move(init), std::move(partial));
+        }
+        return init;
+    }
+
+    /** Returns `init op x0 op x1 ...` for the elements of `[first, last)`,
+        using `default_thread_pool()`. */
+    template<
+        typename Iter,
+        typename T,
+        typename Op,
+        typename Enable = std::enable_if_t<v1_dtl::is_ra_iter<Iter>::value>>
+    T parallel_reduce(
+        Iter first,
+        Iter last,
+        T init,
+        Op const & op,
+        std::ptrdiff_t grain_size = 1024)
+    {
+        return stl_interfaces::parallel_reduce(
+            default_thread_pool(),
+            first,
+            last,
+            std::move(init),
+            op,
+            grain_size);
+    }
+
+    /** Writes the inclusive prefix sums `x0`, `x0 op x1`, `x0 op x1 op
+        x2`, ... of the random access range `[first, last)` to the random
+        access range starting at `out`, in parallel, like
+        `std::inclusive_scan()`, and returns the end of the output.  `out`
+        may be `first`.
+
+        This is a two-pass blocked scan.  The range is split into chunks as
+        in `parallel_for_each()`, and each chunk is reduced; then the
+        chunks' sums are scanned, in order; then each chunk is scanned, from
+        the sum of the chunks before it.  So `op` must be associative, but
+        need not be commutative, and each element is read twice.  With a
+        pool of no workers, or a range of one chunk, it is one scan.  If
+        both ranges are contiguous, of the same integral type, and `op` is
+        `std::plus`, each chunk is scanned in SIMD registers, and the sums
+        wrap as unsigned ones would.
+
+        \pre `0 < grain_size` */
+    template<
+        typename Pool,
+        typename Iter,
+        typename OutIter,
+        typename Op = std::plus<>,
+        typename Enable = std::enable_if_t<
+            v1_dtl::is_pool<Pool>::value && v1_dtl::is_ra_iter<Iter>::value &&
+            v1_dtl::is_ra_iter<OutIter>::value>>
+    OutIter parallel_inclusive_scan(
+        Pool & pool,
+        Iter first,
+        Iter last,
+        OutIter out,
+        Op const & op = Op(),
+        std::ptrdiff_t grain_size = 1 << 16)
+    {
+        using value_type = typename std::iterator_traits<Iter>::value_type;
+        return v1_dtl::parallel_scan<true>(
+            pool, first, last, out, value_type(), false, op, grain_size);
+    }
+
+    /** Writes the inclusive prefix sums of `[first, last)` to `out`, using
+        `default_thread_pool()`. */
+    template<
+        typename Iter,
+        typename OutIter,
+        typename Op = std::plus<>,
+        typename Enable = std::enable_if_t<
+            v1_dtl::is_ra_iter<Iter>::value &&
+            v1_dtl::is_ra_iter<OutIter>::value>>
+    OutIter parallel_inclusive_scan(
+        Iter first,
+        Iter last,
+        OutIter out,
+        Op const & op = Op(),
+        std::ptrdiff_t grain_size = 1 << 16)
+    {
+        return stl_interfaces::parallel_inclusive_scan(
+            default_thread_pool(), first, last, out, op, grain_size);
+    }
+
+    /** Writes the exclusive prefix sums `init`, `init op x0`, `init op x0
+        op x1`, ... of the random access range `[first, last)` to the random
+        access range starting at `out`, in parallel, like
+        `std::exclusive_scan()`, and returns the end of the output -- the
+        offsets of variable-length records from their lengths, say.  The
+        work is split as in `parallel_inclusive_scan()`.  `out` may be
+        `first`.
+
+        \pre `0 < grain_size` */
+    template<
+        typename Pool,
+        typename Iter,
+        typename OutIter,
+        typename T,
+        typename Op = std::plus<>,
+        typename Enable = std::enable_if_t<
+            v1_dtl::is_pool<Pool>::value && v1_dtl::is_ra_iter<Iter>::value &&
+            v1_dtl::is_ra_iter<OutIter>::value>>
+    OutIter parallel_exclusive_scan(
+        Pool & pool,
+        Iter first,
+        Iter last,
+        OutIter out,
+        T init,
+        Op const & op = Op(),
+        std::ptrdiff_t grain_size = 1 << 16)
+    {
+        return v1_dtl::parallel_scan<false>(
+            pool, first, last, out, std::move(init), true, op, grain_size);
+    }
+
+    /** Writes the exclusive prefix sums of `[first, last)` to `out`, using
+        `default_thread_pool()`. */
+    template<
+        typename Iter,
+        typename OutIter,
+        typename T,
+        typename Op = std::plus<>,
+        typename Enable = std::enable_if_t<
+            v1_dtl::is_ra_iter<Iter>::value &&
+            v1_dtl::is_ra_iter<OutIter>::value>>
+    OutIter parallel_exclusive_scan(
+        Iter first,
+        Iter last,
+        OutIter out,
+        T init,
+        Op const & op = Op(),
+        std::ptrdiff_t grain_size = 1 << 16)
+    {
+        return stl_interfaces::parallel_exclusive_scan(
+            default_thread_pool(),
+            first,
+            last,
+            out,
+            std::move(init),
+            op,
+            grain_size);
+    }
+
+    /** Copies the elements `x` of the random access range `[first, last)`
+        for which `pred(x)` is `true` to the random access range starting at
+        `out`, in parallel, keeping their order, like `std::copy_if()`, and
+        returns the end of the output.  The output must have room for all
+        the elements copied, at most `last - first` of them.
+
+        This is a two-pass compaction.  The range is split into chunks as in
+        `parallel_for_each()`, and the elements of each chunk that satisfy
+        `pred` are counted; then the counts are summed, in order, to give
+        each chunk its offset in the output; then each chunk is copied to
+        its offset.  So `pred` is called twice on each element, and must
+        return the same result each time.  With a pool of no workers, or a
+        range of one chunk, it is one pass.  If both ranges are contiguous,
+        of the same trivially copyable type of at most 16 bytes, the
+        copying does not branch on the results of `pred`.
+
+        \pre `0 < grain_size` */
+    template<
+        typename Pool,
+        typename Iter,
+        typename OutIter,
+        typename Pred,
+        typename Enable = std::enable_if_t<
+            v1_dtl::is_pool<Pool>::value && v1_dtl::is_ra_iter<Iter>::value &&
+            v1_dtl::is_ra_iter<OutIter>::value>>
+    OutIter parallel_copy_if(
+        Pool & pool,
+        Iter first,
+        Iter last,
+        OutIter out,
+        Pred const & pred,
+        std::ptrdiff_t grain_size = 1 << 16)
+    {
+        auto const it = v1_dtl::parallel_iter(first);
+        auto const out_it = v1_dtl::parallel_iter(out);
+        using branch_free = v1_dtl::branch_free_compactable<
+            std::remove_cv_t<decltype(it)>,
+            std::remove_cv_t<decltype(out_it)>>;
+        std::ptrdiff_t const n = last - first;
+        auto const chunks = v1_dtl::parallel_chunks(pool, n, grain_size);
+
+        if (chunks <= 1 || pool.size() == 0) {
+            auto const out_last = v1_dtl::copy_if_chunk(
+                it, it + n, out_it, pred, branch_free{});
+            return out + (out_last - out_it);
+        }
+
+        v1_dtl::scratch_vector<std::ptrdiff_t> offsets(chunks + 1, 0);
+        v1_dtl::parallel_run(
+            pool,
+            n,
+            chunks,
+            [&](std::ptrdiff_t c, std::ptrdiff_t b, std::ptrdiff_t e) {
+                offsets[c + 1] = std::count_if(it + b, it + e, pred);
+            });
+        std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+        v1_dtl::parallel_run(
+            pool,
+            n,
+            chunks,
+            [&](std::ptrdiff_t c, std::ptrdiff_t b, std::ptrdiff_t e) {
+                v1_dtl::copy_if_chunk(
+                    it + b, it + e, out_it + offsets[c], pred, branch_free{});
+            });
+        return out + offsets.back();
+    }
+
+    /** Copies the elements `x` of `[first, last)` for which `pred(x)` is
+        `true` to `out`, using `default_thread_pool()`. */
+    template<
+        typename Iter,
+        typename OutIter,
+        typename Pred,
+        typename Enable = std::enable_if_t<
+            v1_dtl::is_ra_iter<Iter>::value &&
+            v1_dtl::is_ra_iter<OutIter>::value>>
+    OutIter parallel_copy_if(
+        Iter first,
+        Iter last,
+        OutIter out,
+        Pred const & pred,
+        std::ptrdiff_t grain_size = 1 << 16)
+    {
+        return stl_interfaces::parallel_copy_if(
+            default_thread_pool(), first, last, out, pred, grain_size);
+    }
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    namespace v1_dtl {
+        template<typename Container>
+        using resize_for_overwrite_t =
+            decltype(std::declval<Container &>().resize_for_overwrite(
+                std::declval<Container &>().size()));
+        template<typename Container>
+        using resize_t = decltype(std::declval<Container &>().resize(
+            std::declval<Container &>().size()));
+
+        template<typename Container, typename Size>
+        void parallel_to_resize(Container & c, Size n, std::true_type)
+        {
+            c.resize_for_overwrite(n);
+        }
+        template<typename Container, typename Size>
+        void parallel_to_resize(Container & c, Size n, std::false_type)
+        {
+            c.resize(n);
+        }
+
+        template<typename Container, typename Range>
+        using parallel_to_fillable = std::integral_constant<
+            bool,
+            to_common_ra_range<Range>::value &&
+                is_ra_iter<typename Container::iterator>::value &&
+                (detail::detector<void, resize_for_overwrite_t, Container>::
+                     value ||
+                 detail::detector<void, resize_t, Container>::value)>;
+
+        template<typename Container, typename Pool, typename Range>
+        Container parallel_to(
+            Pool & pool, Range & r, std::ptrdiff_t grain_size, std::true_type)
+        {
+            auto const first = std::begin(r);
+            std::ptrdiff_t const n = std::end(r) - first;
+            if (n <= grain_size)
+                return stl_interfaces::to<Container>(r);
+            Container retval;
+            using size_type = decltype(retval.size());
+            v1_dtl::parallel_to_resize(
+                retval,
+                size_type(n),
+                std::integral_constant<
+                    bool,
+                    detail::detector<void, resize_for_overwrite_t, Container>::
+                        value>{});
+            auto const it = v1_dtl::parallel_iter(first);
+            auto const out_it = v1_dtl::parallel_iter(retval.begin());
+            v1_dtl::parallel_run(
+                pool,
+                n,
+                v1_dtl::parallel_chunks(pool, n, grain_size),
+                [&](std::ptrdiff_t, std::ptrdiff_t b, std::ptrdiff_t e) {
+                    std::copy(it + b, it + e, out_it + b);
+                });
+            return retval;
+        }
+        template<typename Container, typename Pool, typename Range>
+        Container
+        parallel_to(Pool &, Range & r, std::ptrdiff_t, std::false_type)
+        {
+            return stl_interfaces::to<Container>(r);
+        }
+    }
+
+#endif
+
+    /** Returns a `Container` of the elements of `r`, like `to()`, but
+        copies the elements of a large random access range in parallel.
+
+        If `r` has random access iterators and more than `grain_size`
+        elements, and `Container` has random access iterators and
+        `resize_for_overwrite()` or `resize()`, the container is sized
+        once -- with `resize_for_overwrite()` if it has it, which leaves
+        trivial elements uninitialized, and with `resize()` otherwise -- and
+        the elements are copied into it as in `parallel_transform()`.  Any
+        other range is materialized on the calling thread by `to()`.
+
+        \pre `0 < grain_size` */
+    template<
+        typename Container,
+        typename Pool,
+        typename Range,
+        typename Enable = std::enable_if_t<v1_dtl::is_pool<Pool>::value>>
+    Container
+    parallel_to(Pool & pool, Range && r, std::ptrdiff_t grain_size = 1 << 16)
+    {
+        return v1_dtl::parallel_to<Container>(
+            pool,
+            r,
+            grain_size,
+            v1_dtl::parallel_to_fillable<Container, Range>{});
+    }
+
+    /** Returns a `Container` of the elements of `r`, like `to()`, using
+        `default_thread_pool()`. */
+    template<
+        typename Container,
+        typename Range,
+        typename Enable = std::enable_if_t<!v1_dtl::is_pool<Range>::value>>
+    Container parallel_to(Range && r, std::ptrdiff_t grain_size = 1 << 16)
+    {
+        return stl_interfaces::parallel_to<Container>(
+            default_thread_pool(), r, grain_size);
+    }
+
+}}}
+
+#endif
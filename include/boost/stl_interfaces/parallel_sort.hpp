@@ -0,0 +1,439 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_PARALLEL_SORT_HPP
+#define BOOST_STL_INTERFACES_PARALLEL_SORT_HPP
+
+#include <boost/stl_interfaces/radix_sort.hpp>
+#include <boost/stl_interfaces/zip_view.hpp>
+
+#include <iterator>
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    namespace v1_dtl {
+        // Returns the number of elements of [a, a + na) among the first d
+        // elements of the stable merge of [a, a + na) and [b, b + nb).
+        template<typename Iter, typename Compare>
+        std::ptrdiff_t merge_path(
+            Iter a,
+            std::ptrdiff_t na,
+            Iter b,
+            std::ptrdiff_t nb,
+            std::ptrdiff_t d,
+            Compare const & comp)
+        {
+            std::ptrdiff_t lo = (std::max)(std::ptrdiff_t(0), d - nb);
+            std::ptrdiff_t hi = (std::min)(d, na);
+            while (lo < hi) {
+                std::ptrdiff_t const mid = lo + (hi - lo) / 2;
+                if (comp(b[d - mid - 1], a[mid]))
+                    hi = mid;
+                else
+                    lo = mid + 1;
+            }
+            return lo;
+        }
+
+        // Merges the adjacent pairs of the sorted runs of src delimited by
+        // bounds into dst, and replaces bounds with the merged runs'.  Each
+        // merge is split among the workers along its merge path.
+        template<typename Pool, typename Src, typename Dst, typename Compare>
+        void merge_runs(
+            Pool & pool,
+            Src src,
+            Dst dst,
+            v1_dtl::scratch_vector<std::ptrdiff_t> & bounds,
+            Compare const & comp,
+            std::ptrdiff_t grain_size)
+        {
+            v1_dtl::scratch_vector<std::ptrdiff_t> merged(1, 0);
+            std::size_t const runs = bounds.size() - 1;
+            for (std::size_t r = 0; r < runs; r += 2) {
+                std::ptrdiff_t const first = bounds[r];
+                std::ptrdiff_t const mid = bounds[r + 1];
+                std::ptrdiff_t const last = r + 2 <= runs ? bounds[r + 2] : mid;
+                merged.push_back(last);
+                auto const a = src + first;
+                auto const b = src + mid;
+                auto const out = dst + first;
+                std::ptrdiff_t const na = mid - first;
+                std::ptrdiff_t const nb = last - mid;
+                std::ptrdiff_t const n = last - first;
+                v1_dtl::parallel_run(
+                    pool,
+                    n,
+                    v1_dtl::parallel_chunks(pool, n, grain_size),
+                    [&](std::ptrdiff_t, std::ptrdiff_t d0, std::ptrdiff_t d1) {
+                        auto const i0 =
+                            v1_dtl::merge_path(a, na, b, nb, d0, comp);
+                        auto const i1 =
+                            v1_dtl::merge_path(a, na, b, nb, d1, comp);
+                        std::merge(
+                            std::make_move_iterator(a + i0),
+                            std::make_move_iterator(a + i1),
+                            std::make_move_iterator(b + (d0 - i0)),
+                            std::make_move_iterator(b + (d1 - i1)),
+                            out + d0,
+                            comp);
+                    });
+            }
+            bounds.swap(merged);
+        }
+
+        // Sorts [first, first + n): each of the chunks is sorted on its
+        // own, and then the sorted runs are merged pairwise, back and forth
+        // between [first, first + n) and buf.
+        template<
+            typename Pool,
+            typename Iter,
+            typename BufIter,
+            typename Compare>
+        void parallel_merge_sort(
+            Pool & pool,
+            Iter first,
+            std::ptrdiff_t n,
+            BufIter buf,
+            std::ptrdiff_t chunks,
+            Compare const & comp,
+            std::ptrdiff_t grain_size)
+        {
+            v1_dtl::scratch_vector<std::ptrdiff_t> bounds(chunks + 1);
+            for (std::ptrdiff_t c = 0; c <= chunks; ++c) {
+                bounds[c] = c * n / chunks;
+            }
+            v1_dtl::parallel_run(
+                pool,
+                n,
+                chunks,
+                [&](std::ptrdiff_t, std::ptrdiff_t b, std::ptrdiff_t e) {
+                    std::sort(first + b, first + e, comp);
+                });
+            bool in_buf = false;
+            while (2u < bounds.size()) {
+                if (in_buf) {
+                    v1_dtl::merge_runs(
+                        pool, buf, first, bounds, comp, grain_size);
+                } else {
+                    v1_dtl::merge_runs(
+                        pool, first, buf, bounds, comp, grain_size);
+                }
+                in_buf = !in_buf;
+            }
+            if (in_buf)
+                v1_dtl::parallel_move(pool, buf, n, first, grain_size);
+        }
+
+        // Moves the perm(i)-th element of [first, first + n) to position i,
+        // for each i, by way of a buffer of value_types.
+        template<typename Pool, typename Iter, typename Perm>
+        void apply_permutation(
+            Pool & pool,
+            Iter first,
+            std::ptrdiff_t n,
+            Perm const & perm,
+            std::ptrdiff_t grain_size)
+        {
+            using value_type = typename std::iterator_traits<Iter>::value_type;
+            auto const it = v1_dtl::parallel_iter(first);
+            v1_dtl::scratch_vector<value_type> buf(n);
+            v1_dtl::parallel_run(
+                pool,
+                n,
+                v1_dtl::parallel_chunks(pool, n, grain_size),
+                [&](std::ptrdiff_t, std::ptrdiff_t b, std::ptrdiff_t e) {
+                    for (std::ptrdiff_t i = b; i < e; ++i) {
+                        buf[i] = std::move(it[perm(i)]);
+                    }
+                });
+            v1_dtl::parallel_move(pool, buf.data(), n, it, grain_size);
+        }
+
+        template<
+            typename Pool,
+            typename Iters,
+            typename Perm,
+            std::size_t... Is>
+        void apply_permutation_components(
+            Pool & pool,
+            Iters const & its,
+            std::ptrdiff_t n,
+            Perm const & perm,
+            std::ptrdiff_t grain_size,
+            std::index_sequence<Is...>)
+        {
+            using swallow = int[];
+            (void)swallow{
+                0,
+                (v1_dtl::apply_permutation(
+                     pool, std::get<Is>(its), n, perm, grain_size),
+                 0)...};
+        }
+
+        // The components of a zip_iterator are permuted one at a time, each
+        // in a pass over its own sequence.
+        template<typename Pool, typename... Iters, typename Perm>
+        void apply_permutation(
+            Pool & pool,
+            zip_iterator<Iters...> first,
+            std::ptrdiff_t n,
+            Perm const & perm,
+            std::ptrdiff_t grain_size)
+        {
+            v1_dtl::apply_permutation_components(
+                pool,
+                first.base(),
+                n,
+                perm,
+                grain_size,
+                std::index_sequence_for<Iters...>{});
+        }
+
+        template<typename Iter>
+        using is_proxy_iter = std::integral_constant<
+            bool,
+            !std::is_reference<
+                typename std::iterator_traits<Iter>::reference>::value>;
+
+        template<typename Pool, typename Iter, typename Compare>
+        void parallel_sort_impl(
+            Pool & pool,
+            Iter first,
+            std::ptrdiff_t n,
+            Compare const & comp,
+            std::ptrdiff_t grain_size,
+            std::false_type)
+        {
+            using value_type = typename std::iterator_traits<Iter>::value_type;
+            auto const it = v1_dtl::parallel_iter(first);
+            auto const chunks = v1_dtl::sort_chunks(pool, n, grain_size);
+            if (chunks <= 1) {
+                std::sort(it, it + n, comp);
+                return;
+            }
+            v1_dtl::scratch_vector<value_type> buf(n);
+            v1_dtl::parallel_merge_sort(
+                pool, it, n, buf.data(), chunks, comp, grain_size);
+        }
+
+        template<typename Pool, typename Iter, typename Compare>
+        void parallel_sort_impl(
+            Pool & pool,
+            Iter first,
+            std::ptrdiff_t n,
+            Compare const & comp,
+            std::ptrdiff_t grain_size,
+            std::true_type)
+        {
+            v1_dtl::scratch_vector<std::ptrdiff_t> perm(n);
+            std::iota(perm.begin(), perm.end(), std::ptrdiff_t(0));
+            auto const index_comp = [&](std::ptrdiff_t i, std::ptrdiff_t j) {
+                return comp(first[i], first[j]);
+            };
+            auto const chunks = v1_dtl::sort_chunks(pool, n, grain_size);
+            if (chunks <= 1) {
+                std::sort(perm.begin(), perm.end(), index_comp);
+            } else {
+                v1_dtl::scratch_vector<std::ptrdiff_t> buf(n);
+                v1_dtl::parallel_merge_sort(
+                    pool,
+                    perm.data(),
+                    n,
+                    buf.data(),
+                    chunks,
+                    index_comp,
+                    grain_size);
+            }
+            v1_dtl::apply_permutation(
+                pool,
+                first,
+                n,
+                [&](std::ptrdiff_t i) { return perm[i]; },
+                grain_size);
+        }
+
+        template<typename Key>
+        struct keyed_index
+        {
+            Key key;
+            std::ptrdiff_t index;
+
+            friend bool
+            operator<(keyed_index const & lhs, keyed_index const & rhs)
+            {
+                return lhs.key < rhs.key ||
+                       (!(rhs.key < lhs.key) && lhs.index < rhs.index);
+            }
+        };
+
+        template<typename Pool, typename Key>
+        void sort_keyed(
+            Pool & pool,
+            v1_dtl::scratch_vector<keyed_index<Key>> & keyed,
+            std::ptrdiff_t grain_size,
+            std::true_type)
+        {
+            v1_dtl::scratch_vector<keyed_index<Key>> buf(keyed.size());
+            v1_dtl::radix_sort_buffer(
+                pool,
+                keyed.data(),
+                keyed.data() + keyed.size(),
+                buf.data(),
+                [](keyed_index<Key> const & x) {
+                    return v1_dtl::radix_key(x.key);
+                },
+                grain_size);
+        }
+
+        template<typename Pool, typename Key>
+        void sort_keyed(
+            Pool & pool,
+            v1_dtl::scratch_vector<keyed_index<Key>> & keyed,
+            std::ptrdiff_t grain_size,
+            std::false_type)
+        {
+            v1_dtl::parallel_sort_impl(
+                pool,
+                keyed.data(),
+                std::ptrdiff_t(keyed.size()),
+                std::less<>{},
+                grain_size,
+                std::false_type{});
+        }
+    }
+
+#endif
+
+    /** Sorts the random access range `[first, last)` by `comp`, in
+        parallel, using the workers of `pool` and the calling thread.  Like
+        `std::sort()`, the sort is not stable.
+
+        If `Iter`'s reference type is a language reference, the range is
+        split into chunks as in `parallel_for_each()`, the chunks are sorted
+        concurrently, and the sorted runs are merged pairwise, each merge
+        split among the threads.  If the reference type is a proxy, as for
+        `zip_iterator`, no proxies are swapped: an array of the elements'
+        indices is sorted that way instead, comparing the elements they
+        refer to, and then the elements are permuted into place in one pass
+        -- for a `zip_iterator` of random access iterators, one pass over
+        each component sequence.  Either way, `Iter`'s `value_type` must be
+        default constructible and move assignable.
+
+        \pre `0 < grain_size` */
+    template<
+        typename Pool,
+        typename Iter,
+        typename Compare = std::less<>,
+        typename Enable = std::enable_if_t<
+            v1_dtl::is_pool<Pool>::value && v1_dtl::is_ra_iter<Iter>::value>>
+    void parallel_sort(
+        Pool & pool,
+        Iter first,
+        Iter last,
+        Compare const & comp = Compare(),
+        std::ptrdiff_t grain_size = 1024)
+    {
+        BOOST_ASSERT(0 < grain_size);
+        std::ptrdiff_t const n = last - first;
+        if (n <= 1)
+            return;
+        v1_dtl::parallel_sort_impl(
+            pool,
+            first,
+            n,
+            comp,
+            grain_size,
+            v1_dtl::is_proxy_iter<Iter>{});
+    }
+
+    /** Sorts `[first, last)` by `comp`, using `default_thread_pool()`. */
+    template<
+        typename Iter,
+        typename Compare = std::less<>,
+        typename Enable = std::enable_if_t<v1_dtl::is_ra_iter<Iter>::value>>
+    void parallel_sort(
+        Iter first,
+        Iter last,
+        Compare const & comp = Compare(),
+        std::ptrdiff_t grain_size = 1024)
+    {
+        stl_interfaces::parallel_sort(
+            default_thread_pool(), first, last, comp, grain_size);
+    }
+
+    /** Sorts the random access range `[first, last)` stably, in ascending
+        order of the keys `proj(x)` of its elements `x`, in parallel.
+
+        The keys are copied, with their elements' indices, into an array,
+        which is sorted, and then the elements are permuted into place as in
+        `parallel_sort()`.  If the keys are integers, the array is sorted
+        with a parallel LSD radix sort, one byte per pass, skipping the
+        passes in which all the keys have the same byte; otherwise, it is
+        merge-sorted by the keys' `operator<()`.  This is the fast way to
+        sort the rows of a structure-of-arrays table, zipped together with
+        `zip_iterator`, by one of its columns.
+
+        \pre `0 < grain_size` */
+    template<
+        typename Pool,
+        typename Iter,
+        typename Proj,
+        typename Enable = std::enable_if_t<
+            v1_dtl::is_pool<Pool>::value && v1_dtl::is_ra_iter<Iter>::value>>
+    void parallel_sort_by_key(
+        Pool & pool,
+        Iter first,
+        Iter last,
+        Proj const & proj,
+        std::ptrdiff_t grain_size = 1024)
+    {
+        BOOST_ASSERT(0 < grain_size);
+        using key_type = std::decay_t<decltype(proj(*first))>;
+        std::ptrdiff_t const n = last - first;
+        if (n <= 1)
+            return;
+        v1_dtl::scratch_vector<v1_dtl::keyed_index<key_type>> keyed(n);
+        v1_dtl::parallel_run(
+            pool,
+            n,
+            v1_dtl::parallel_chunks(pool, n, grain_size),
+            [&](std::ptrdiff_t, std::ptrdiff_t b, std::ptrdiff_t e) {
+                for (std::ptrdiff_t i = b; i < e; ++i) {
+                    keyed[i].key = proj(first[i]);
+                    keyed[i].index = i;
+                }
+            });
+        v1_dtl::sort_keyed(
+            pool, keyed, grain_size, v1_dtl::radix_integral<key_type>{});
+        v1_dtl::apply_permutation(
+            pool,
+            first,
+            n,
+            [&](std::ptrdiff_t i) { return keyed[i].index; },
+            grain_size);
+    }
+
+    /** Sorts `[first, last)` stably by `proj`, using
+        `default_thread_pool()`. */
+    template<
+        typename Iter,
+        typename Proj,
+        typename Enable = std::enable_if_t<v1_dtl::is_ra_iter<Iter>::value>>
+    void parallel_sort_by_key(
+        Iter first,
+        Iter last,
+        Proj const & proj,
+        std::ptrdiff_t grain_size = 1024)
+    {
+        stl_interfaces::parallel_sort_by_key(
+            default_thread_pool(), first, last, proj, grain_size);
+    }
+
+}}}
+
+#endif
@@ -0,0 +1,439 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_PARTITIONED_VECTOR_HPP
+#define BOOST_STL_INTERFACES_PARTITIONED_VECTOR_HPP
+
+#include <boost/stl_interfaces/container_interface.hpp>
+#include <boost/stl_interfaces/reverse_iterator.hpp>
+#include <boost/stl_interfaces/segmented_iterator.hpp>
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+    /** A fixed set of threads, each with a queue of its own, so that work
+        can be sent to a particular one.  Memory that a thread touches first
+        is placed, by the default policy of Linux and Windows, on that
+        thread's NUMA node; so if thread `i` allocates and initializes the
+        data it will later work on, and stays on one node, its accesses to
+        that data are node-local.
+
+        Keeping each thread on one node is up to the caller, since there is
+        no portable way to do it: `on_start(i)` is called on thread `i`
+        before it runs anything else, and may pin it, with
+        `numa_run_on_node()` from libnuma or `pthread_setaffinity_np()`, say.
+
+        \see `partitioned_vector` */
+    struct partition_threads
+    {
+        /** Starts `threads` threads, each of which first calls
+            `on_start(i)`, if it is not empty, with its index `i`.
+            \pre `0 < threads` */
+        explicit partition_threads(
+            unsigned int threads,
+            std::function<void(unsigned int)> on_start = nullptr)
+        {
+            BOOST_ASSERT(0 < threads);
+            workers_.reserve(threads);
+            for (unsigned int i = 0; i < threads; ++i) {
+                workers_.push_back(std::make_unique<worker>());
+            }
+            for (unsigned int i = 0; i < threads; ++i) {
+                worker & w = *workers_[i];
+                w.thread = std::thread([&w, i, on_start] {
+                    if (on_start)
+                        on_start(i);
+                    w.run();
+                });
+            }
+        }
+        ~partition_threads()
+        {
+            for (auto & w : workers_) {
+                {
+                    std::lock_guard<std::mutex> lock(w->mutex);
+                    w->stop = true;
+                }
+                w->cv.notify_one();
+            }
+            for (auto & w : workers_) {
+                w->thread.join();
+            }
+        }
+        partition_threads(partition_threads const &) = delete;
+        partition_threads & operator=(partition_threads const &) = delete;
+
+        /** Returns the number of threads. */
+        unsigned int size() const noexcept
+        {
+            return (unsigned int)workers_.size();
+        }
+
+        /** Queues `task` to be run on thread `i`. */
+        void submit(unsigned int i, std::function<void()> task)
+        {
+            BOOST_ASSERT(i < size());
+            worker & w = *workers_[i];
+            {
+                std::lock_guard<std::mutex> lock(w.mutex);
+                w.tasks.push_back(std::move(task));
+            }
+            w.cv.notify_one();
+        }
+
+        /** Calls `f(i)` on each thread `i`, and waits for all the calls to
+            finish.  If any of them throws, one of the exceptions is
+            rethrown after all of them have finished. */
+        template<typename F>
+        void run_each(F const & f)
+        {
+            std::mutex mutex;
+            std::condition_variable cv;
+            unsigned int remaining = size();
+            std::exception_ptr error;
+            for (unsigned int i = 0; i < size(); ++i) {
+                submit(i, [&, i] {
+                    std::exception_ptr e;
+                    try {
+                        f(i);
+                    } catch (...) {
+                        e = std::current_exception();
+                    }
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (e && !error)
+                        error = e;
+                    if (--remaining == 0)
+                        cv.notify_one();
+                });
+            }
+            std::unique_lock<std::mutex> lock(mutex);
+            cv.wait(lock, [&] { return remaining == 0; });
+            if (error)
+                std::rethrow_exception(error);
+        }
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+    private:
+        struct worker
+        {
+            void run()
+            {
+                for (;;) {
+                    std::function<void()> task;
+                    {
+                        std::unique_lock<std::mutex> lock(mutex);
+                        cv.wait(
+                            lock, [this] { return stop || !tasks.empty(); });
+                        if (tasks.empty())
+                            return;
+                        task = std::move(tasks.front());
+                        tasks.pop_front();
+                    }
+                    task();
+                }
+            }
+
+            std::mutex mutex;
+            std::condition_variable cv;
+            std::deque<std::function<void()>> tasks;
+            bool stop = false;
+            std::thread thread;
+        };
+
+        std::vector<std::unique_ptr<worker>> workers_;
+#endif
+    };
+
+    /** The elements of one partition of a `partitioned_vector`. */
+    template<typename T>
+    struct vector_partition
+    {
+        T * first;
+        T * last;
+    };
+
+    template<typename T>
+    struct partitioned_vector;
+
+    /** `partitioned_vector` destroys its elements itself, so
+        `container_interface` does not need to call `clear()`. */
+    template<typename T>
+    struct trivially_destructible_container<partitioned_vector<T>>
+        : std::true_type
+    {
+    };
+
+    /** The iterator of a `partitioned_vector`: a pointer to its table of
+        partitions, the capacity of each partition, and an index.  Element
+        `i` is element `i % capacity` of partition `i / capacity`.
+
+        It models the segmented iterator protocol, with the partitions as
+        the segments and pointers as the local iterators, so the
+        `segmented_*()` algorithms run over each partition with pointers,
+        with no division per element.  An index that is a multiple of the
+        capacity is treated as the end of the partition before it, so that
+        the end iterator is in a partition that exists. */
+    template<typename T>
+    struct partitioned_vector_iterator
+        : iterator_interface<
+              partitioned_vector_iterator<T>,
+              std::random_access_iterator_tag,
+              std::remove_const_t<T>>
+    {
+        using partition_pointer =
+            vector_partition<std::remove_const_t<T>> const *;
+
+        partitioned_vector_iterator() noexcept = default;
+        partitioned_vector_iterator(
+            partition_pointer partitions,
+            std::ptrdiff_t capacity,
+            std::ptrdiff_t i) noexcept :
+            partitions_(partitions), capacity_(capacity), i_(i)
+        {}
+        template<
+            typename U,
+            typename E = std::enable_if_t<
+                std::is_same<T, U const>::value &&
+                !std::is_same<T, U>::value>>
+        partitioned_vector_iterator(
+            partitioned_vector_iterator<U> other) noexcept :
+            partitions_(other.partitions_),
+            capacity_(other.capacity_),
+            i_(other.i_)
+        {}
+
+        T & operator*() const noexcept
+        {
+            return partitions_[i_ / capacity_].first[i_ % capacity_];
+        }
+        partitioned_vector_iterator & operator+=(std::ptrdiff_t n) noexcept
+        {
+            i_ += n;
+            return *this;
+        }
+        friend std::ptrdiff_t operator-(
+            partitioned_vector_iterator lhs,
+            partitioned_vector_iterator rhs) noexcept
+        {
+            return lhs.i_ - rhs.i_;
+        }
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+    private:
+        template<typename U>
+        friend struct partitioned_vector_iterator;
+        friend access;
+
+        partition_pointer segment() const noexcept
+        {
+            return partitions_ + (i_ ? (i_ - 1) / capacity_ : 0);
+        }
+        T * local() const noexcept
+        {
+            auto const seg = segment();
+            return seg->first + (i_ - (seg - partitions_) * capacity_);
+        }
+        T * local_begin(partition_pointer seg) const noexcept
+        {
+            return seg->first;
+        }
+        T * local_end(partition_pointer seg) const noexcept
+        {
+            return seg->last;
+        }
+        partitioned_vector_iterator
+        compose(partition_pointer seg, T * it) const noexcept
+        {
+            return partitioned_vector_iterator(
+                partitions_,
+                capacity_,
+                (seg - partitions_) * capacity_ + (it - seg->first));
+        }
+
+        partition_pointer partitions_ = nullptr;
+        std::ptrdiff_t capacity_ = 1;
+        std::ptrdiff_t i_ = 0;
+#endif
+    };
+
+    /** A fixed-size array of `T`s split into one contiguous partition per
+        thread of a `partition_threads`, each allocated and initialized by
+        its own thread.  When each thread stays on one NUMA node, each
+        partition is in that node's memory, and `parallel_for_each()` runs
+        each partition's share of the work on the thread that placed it;
+        a scan then reads node-local memory, instead of a single vector's
+        pages, which are all on the node of the thread that first wrote
+        them, or interleaved among the nodes.
+
+        The partitions are the same size, except that the last ones may be
+        shorter.  The iterators are random access, and model the segmented
+        iterator protocol, so `segmented_for_each()` and the like run a
+        pointer loop per partition.  The vector cannot be copied, since the
+        copy would be placed on the copying thread's node; it can be moved.
+
+        \see `partition_threads`, `container_interface` */
+    template<typename T>
+    struct partitioned_vector : container_interface<partitioned_vector<T>>
+    {
+        using value_type = T;
+        using reference = T &;
+        using const_reference = T const &;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using iterator = partitioned_vector_iterator<T>;
+        using const_iterator = partitioned_vector_iterator<T const>;
+        using reverse_iterator = stl_interfaces::reverse_iterator<iterator>;
+        using const_reverse_iterator =
+            stl_interfaces::reverse_iterator<const_iterator>;
+        using partition_type = vector_partition<T>;
+
+        partitioned_vector() noexcept = default;
+        /** Makes `n` copies of `x`, in one partition per thread of
+            `threads`; thread `i` allocates partition `i` and copies `x`
+            into it. */
+        partitioned_vector(
+            partition_threads & threads, size_type n, T const & x = T()) :
+            partitions_(threads.size(), partition_type{nullptr, nullptr}),
+            capacity_((std::max)(
+                size_type(1), (n + threads.size() - 1) / threads.size())),
+            size_(n)
+        {
+            try {
+                threads.run_each([&](unsigned int p) {
+                    size_type const first = (std::min)(p * capacity_, n);
+                    size_type const count =
+                        (std::min)(capacity_, n - first);
+                    if (!count)
+                        return;
+                    std::allocator<T> alloc;
+                    T * const data = alloc.allocate(count);
+                    try {
+                        std::uninitialized_fill_n(data, count, x);
+                    } catch (...) {
+                        alloc.deallocate(data, count);
+                        throw;
+                    }
+                    partitions_[p] = partition_type{data, data + count};
+                });
+            } catch (...) {
+                destroy();
+                throw;
+            }
+        }
+        partitioned_vector(partitioned_vector && other) noexcept
+        {
+            swap(other);
+        }
+        partitioned_vector & operator=(partitioned_vector && other) noexcept
+        {
+            partitioned_vector temp(std::move(other));
+            swap(temp);
+            return *this;
+        }
+        ~partitioned_vector() { destroy(); }
+
+        iterator begin() noexcept
+        {
+            return iterator(
+                partitions_.data(), difference_type(capacity_), 0);
+        }
+        iterator end() noexcept
+        {
+            return iterator(
+                partitions_.data(),
+                difference_type(capacity_),
+                difference_type(size_));
+        }
+
+        size_type size() const noexcept { return size_; }
+        size_type max_size() const noexcept
+        {
+            return size_type(std::numeric_limits<difference_type>::max());
+        }
+
+        /** Returns the number of partitions. */
+        size_type partitions() const noexcept { return partitions_.size(); }
+        /** Returns the elements of partition `p`; they are
+            `[first, last)`, which is empty if the partition is. */
+        partition_type const & partition(size_type p) const noexcept
+        {
+            BOOST_ASSERT(p < partitions());
+            return partitions_[p];
+        }
+
+        void swap(partitioned_vector & other) noexcept
+        {
+            partitions_.swap(other.partitions_);
+            std::swap(capacity_, other.capacity_);
+            std::swap(size_, other.size_);
+        }
+
+        /** Swaps `lhs` and `rhs`. */
+        friend void
+        swap(partitioned_vector & lhs, partitioned_vector & rhs) noexcept
+        {
+            lhs.swap(rhs);
+        }
+
+        using base_type = container_interface<partitioned_vector<T>>;
+        using base_type::begin;
+        using base_type::end;
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+    private:
+        void destroy() noexcept
+        {
+            std::allocator<T> alloc;
+            for (auto & p : partitions_) {
+                if (!p.first)
+                    continue;
+                std::for_each(p.first, p.last, [](T & x) { x.~T(); });
+                alloc.deallocate(p.first, size_type(p.last - p.first));
+                p = partition_type{nullptr, nullptr};
+            }
+        }
+
+        std::vector<partition_type> partitions_;
+        size_type capacity_ = 1;
+        size_type size_ = 0;
+#endif
+    };
+
+    /** Calls `f` on each element of `v`, with each partition's elements
+        visited on the thread of `threads` that has the same index, or the
+        index modulo `threads.size()` if there are more partitions than
+        threads.  Waits for all of them, and rethrows one of the exceptions
+        thrown by `f`, if any. */
+    template<typename T, typename F>
+    void parallel_for_each(
+        partition_threads & threads, partitioned_vector<T> & v, F const & f)
+    {
+        threads.run_each([&](unsigned int t) {
+            for (std::size_t p = t; p < v.partitions();
+                 p += threads.size()) {
+                auto const & part = v.partition(p);
+                std::for_each(part.first, part.last, f);
+            }
+        });
+    }
+
+}}}
+
+#endif
@@ -0,0 +1,515 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_PERSISTENT_VECTOR_HPP
+#define BOOST_STL_INTERFACES_PERSISTENT_VECTOR_HPP
+
+#include <boost/stl_interfaces/container_interface.hpp>
+#include <boost/stl_interfaces/leaf_caching_iterator.hpp>
+#include <boost/stl_interfaces/reverse_iterator.hpp>
+
+#include <boost/assert.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+    template<typename T>
+    struct persistent_vector;
+
+    /** `persistent_vector` releases its nodes itself, so
+        `container_interface` does not need to call `clear()`. */
+    template<typename T>
+    struct trivially_destructible_container<persistent_vector<T>>
+        : std::true_type
+    {
+    };
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    namespace v1_dtl {
+        constexpr int pv_bits = 5;
+        constexpr std::size_t pv_width = std::size_t(1) << pv_bits;
+        constexpr std::size_t pv_mask = pv_width - 1;
+
+        struct pv_node
+        {
+            std::atomic<std::size_t> refs{1};
+        };
+
+        struct pv_branch : pv_node
+        {
+            pv_node * children[pv_width] = {};
+        };
+
+        template<typename T>
+        struct pv_leaf : pv_node
+        {
+            T * data() noexcept { return reinterpret_cast<T *>(storage); }
+
+            std::size_t count = 0;
+            alignas(T) unsigned char storage[pv_width * sizeof(T)];
+        };
+    }
+
+#endif
+
+    /** The random access iterator of `persistent_vector`, which caches
+        the current leaf.  \see `leaf_caching_iterator` */
+    template<typename T>
+    using persistent_vector_iterator =
+        leaf_caching_iterator<persistent_vector<T>, T const>;
+
+    /** An immutable vector, whose "modifiers" -- `push_back()`, `set()`
+        and `pop_back()` -- leave it as it is, and return a new version that
+        shares all but O(log n) of its memory with it.  This makes keeping
+        every version, for an undo history or for snapshots, cheap.
+
+        It is the bit-partitioned trie of Clojure's `PersistentVector`: a
+        tree of nodes with 32 children, whose leaves hold 32 elements each,
+        and a separate leaf for the last 1 to 32 elements, the tail.  Element
+        `i` is found from its index's 5-bit digits, in O(log32 n) steps --
+        at most 4 for a billion elements.  `push_back()` copies the tail,
+        and every 32nd one also copies the path to the new leaf; `set()`
+        copies the path to one leaf.  A `push_back()` on an rvalue whose
+        tail no other version shares appends to it in place, so a loop like
+        `v = std::move(v).push_back(x);` copies nothing.
+
+        The nodes are reference counted, atomically, so versions may be
+        shared among threads.  The iterators are `leaf_caching_iterator`s,
+        with the leaves as segments, so the `segmented_*()` algorithms run
+        over each leaf with pointers; they refer to elements of the vector
+        they came from, and stay valid as long as it does.
+
+        \see `container_interface` */
+    template<typename T>
+    struct persistent_vector : container_interface<persistent_vector<T>>
+    {
+        using value_type = T;
+        using pointer = T const *;
+        using const_pointer = T const *;
+        using reference = T const &;
+        using const_reference = T const &;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using iterator = persistent_vector_iterator<T>;
+        using const_iterator = iterator;
+        using reverse_iterator = stl_interfaces::reverse_iterator<iterator>;
+        using const_reverse_iterator = reverse_iterator;
+
+        persistent_vector() noexcept = default;
+        template<
+            typename InputIterator,
+            typename Enable = std::enable_if_t<std::is_convertible<
+                typename std::iterator_traits<
+                    InputIterator>::iterator_category,
+                std::input_iterator_tag>::value>>
+        persistent_vector(InputIterator first, InputIterator last)
+        {
+            for (; first != last; ++first) {
+                *this = std::move(*this).push_back(*first);
+            }
+        }
+        persistent_vector(std::initializer_list<T> il) :
+            persistent_vector(il.begin(), il.end())
+        {}
+        /** Shares all of `other`'s nodes. */
+        persistent_vector(persistent_vector const & other) noexcept :
+            size_(other.size_),
+            shift_(other.shift_),
+            root_(other.root_),
+            tail_(other.tail_)
+        {
+            retain(root_);
+            retain(tail_);
+        }
+        persistent_vector(persistent_vector && other) noexcept :
+            size_(std::exchange(other.size_, 0)),
+            shift_(std::exchange(other.shift_, v1_dtl::pv_bits)),
+            root_(std::exchange(other.root_, nullptr)),
+            tail_(std::exchange(other.tail_, nullptr))
+        {}
+        persistent_vector & operator=(persistent_vector const & other) noexcept
+        {
+            persistent_vector temp(other);
+            swap(temp);
+            return *this;
+        }
+        persistent_vector & operator=(persistent_vector && other) noexcept
+        {
+            persistent_vector temp(std::move(other));
+            swap(temp);
+            return *this;
+        }
+        ~persistent_vector()
+        {
+            release(root_, shift_);
+            release(tail_, 0);
+        }
+
+        iterator begin() const noexcept { return iterator(this, 0); }
+        iterator end() const noexcept
+        {
+            return iterator(this, difference_type(size_));
+        }
+
+        size_type size() const noexcept { return size_; }
+        bool empty() const noexcept { return !size_; }
+        size_type max_size() const noexcept
+        {
+            return size_type((std::numeric_limits<difference_type>::max)());
+        }
+
+        /** Returns element `i`, without creating an iterator. */
+        const_reference operator[](size_type i) const noexcept
+        {
+            BOOST_ASSERT(i < size_);
+            return leaf_for(i)->data()[i & v1_dtl::pv_mask];
+        }
+
+        /** Returns a new version with `x` appended. */
+        persistent_vector push_back(T const & x) const &
+        {
+            persistent_vector retval(*this);
+            return std::move(retval).push_back(x);
+        }
+        /** Returns a new version with `x` appended, reusing the storage of
+            `*this` where no other version shares it. */
+        persistent_vector push_back(T const & x) &&
+        {
+            size_type const tail_count = size_ - tail_offset();
+            if (tail_ && tail_count < v1_dtl::pv_width &&
+                tail_->refs.load(std::memory_order_acquire) == 1) {
+                ::new (tail_->data() + tail_count) T(x);
+                ++tail_->count;
+                ++size_;
+                return std::move(*this);
+            }
+            persistent_vector retval;
+            if (!tail_ || tail_count < v1_dtl::pv_width) {
+                leaf * const new_tail =
+                    copy_leaf(tail_, tail_count, &x, tail_count);
+                retval.root_ = retain(root_);
+                retval.shift_ = shift_;
+                retval.tail_ = new_tail;
+            } else {
+                leaf * const new_tail = copy_leaf(nullptr, 0, &x, 0);
+                retval.tail_ = new_tail;
+                retval.shift_ = shift_;
+                // The full tail moves into the tree.
+                if ((size_ >> v1_dtl::pv_bits) >
+                    (size_type(1) << shift_)) {
+                    auto const new_root = new branch;
+                    new_root->children[0] = retain(root_);
+                    try {
+                        new_root->children[1] = new_path(shift_, tail_);
+                    } catch (...) {
+                        release(new_root, shift_ + v1_dtl::pv_bits);
+                        throw;
+                    }
+                    retval.root_ = new_root;
+                    retval.shift_ = shift_ + v1_dtl::pv_bits;
+                } else {
+                    retval.root_ = push_tail(shift_, root_, tail_);
+                }
+            }
+            retval.size_ = size_ + 1;
+            return retval;
+        }
+
+        /** Returns a new version with element `i` replaced by `x`.
+            \pre `i < size()` */
+        persistent_vector set(size_type i, T const & x) const
+        {
+            BOOST_ASSERT(i < size_);
+            persistent_vector retval(*this);
+            if (tail_offset() <= i) {
+                leaf * const new_tail = copy_leaf(
+                    tail_, size_ - tail_offset(), &x, i & v1_dtl::pv_mask);
+                release(retval.tail_, 0);
+                retval.tail_ = new_tail;
+            } else {
+                branch * const new_root = assign(shift_, root_, i, x);
+                release(retval.root_, shift_);
+                retval.root_ = new_root;
+            }
+            return retval;
+        }
+
+        /** Returns a new version without the last element.
+            \pre `!empty()` */
+        persistent_vector pop_back() const
+        {
+            BOOST_ASSERT(!empty());
+            persistent_vector retval;
+            if (size_ == 1)
+                return retval;
+            size_type const tail_count = size_ - tail_offset();
+            retval.size_ = size_ - 1;
+            if (1 < tail_count) {
+                retval.root_ = retain(root_);
+                retval.shift_ = shift_;
+                retval.tail_ =
+                    copy_leaf(tail_, tail_count - 1, nullptr, tail_count);
+                return retval;
+            }
+            // The last leaf of the tree becomes the tail.
+            retval.tail_ = retain(leaf_for(size_ - 2));
+            branch * new_root = pop_tail(shift_, root_);
+            size_type new_shift = shift_;
+            if (v1_dtl::pv_bits < new_shift && new_root &&
+                !new_root->children[1]) {
+                auto const child = static_cast<branch *>(
+                    retain(new_root->children[0]));
+                release(new_root, new_shift);
+                new_root = child;
+                new_shift -= v1_dtl::pv_bits;
+            }
+            retval.root_ = new_root;
+            retval.shift_ = new_shift;
+            return retval;
+        }
+
+        void swap(persistent_vector & other) noexcept
+        {
+            std::swap(size_, other.size_);
+            std::swap(shift_, other.shift_);
+            std::swap(root_, other.root_);
+            std::swap(tail_, other.tail_);
+        }
+
+        /** Swaps `lhs` and `rhs`. */
+        friend void
+        swap(persistent_vector & lhs, persistent_vector & rhs) noexcept
+        {
+            lhs.swap(rhs);
+        }
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+    private:
+        friend access;
+
+        using node = v1_dtl::pv_node;
+        using branch = v1_dtl::pv_branch;
+        using leaf = v1_dtl::pv_leaf<T>;
+
+        // The index of the first element of the tail.
+        size_type tail_offset() const noexcept
+        {
+            return size_ < v1_dtl::pv_width
+                       ? 0
+                       : (size_ - 1) & ~size_type(v1_dtl::pv_mask);
+        }
+
+        leaf * leaf_for(size_type i) const noexcept
+        {
+            if (tail_offset() <= i)
+                return tail_;
+            node * n = root_;
+            for (size_type level = shift_; level; level -= v1_dtl::pv_bits) {
+                n = static_cast<branch *>(n)
+                        ->children[(i >> level) & v1_dtl::pv_mask];
+            }
+            return static_cast<leaf *>(n);
+        }
+
+        tree_leaf<T const> leaf_at(size_type i) const noexcept
+        {
+            size_type const first = i & ~size_type(v1_dtl::pv_mask);
+            return {
+                leaf_for(i)->data(),
+                first,
+                first == tail_offset() ? size_ - first : v1_dtl::pv_width};
+        }
+
+        template<typename Node>
+        static Node * retain(Node * n) noexcept
+        {
+            if (n)
+                n->refs.fetch_add(1, std::memory_order_relaxed);
+            return n;
+        }
+        // Drops a reference to n, whose children, if it is a branch, are
+        // level - 5 levels above the leaves; a leaf is at level 0.
+        static void release(node * n, size_type level) noexcept
+        {
+            if (!n || n->refs.fetch_sub(1, std::memory_order_acq_rel) != 1)
+                return;
+            if (!level) {
+                auto const l = static_cast<leaf *>(n);
+                for (size_type i = 0; i < l->count; ++i) {
+                    l->data()[i].~T();
+                }
+                delete l;
+                return;
+            }
+            auto const b = static_cast<branch *>(n);
+            for (node * child : b->children) {
+                release(child, level - v1_dtl::pv_bits);
+            }
+            delete b;
+        }
+
+        // Returns a new leaf with copies of the first count elements of l,
+        // except that element at, if x is not null, is a copy of *x; at ==
+        // count appends it.
+        static leaf * copy_leaf(
+            leaf * l, size_type count, T const * x, size_type at)
+        {
+            auto const retval = new leaf;
+            try {
+                for (; retval->count < count; ++retval->count) {
+                    size_type const i = retval->count;
+                    ::new (retval->data() + i)
+                        T(x && i == at ? *x : l->data()[i]);
+                }
+                if (x && at == count) {
+                    ::new (retval->data() + retval->count) T(*x);
+                    ++retval->count;
+                }
+            } catch (...) {
+                release(retval, 0);
+                throw;
+            }
+            return retval;
+        }
+
+        static branch * copy_branch(branch * b)
+        {
+            auto const retval = new branch;
+            if (b) {
+                for (size_type i = 0; i < v1_dtl::pv_width; ++i) {
+                    retval->children[i] = retain(b->children[i]);
+                }
+            }
+            return retval;
+        }
+
+        // Returns l, under a chain of new branches whose first children
+        // lead down to it from level.
+        static node * new_path(size_type level, leaf * l)
+        {
+            node * retval = retain(l);
+            for (size_type i = v1_dtl::pv_bits; i <= level;
+                 i += v1_dtl::pv_bits) {
+                branch * b;
+                try {
+                    b = new branch;
+                } catch (...) {
+                    release(retval, i - v1_dtl::pv_bits);
+                    throw;
+                }
+                b->children[0] = retval;
+                retval = b;
+            }
+            return retval;
+        }
+
+        // Returns a copy of parent, at level, with the full leaf
+        // tail_leaf added after its last leaf.
+        branch * push_tail(size_type level, branch * parent, leaf * tail_leaf)
+            const
+        {
+            auto const retval = copy_branch(parent);
+            size_type const i = ((size_ - 1) >> level) & v1_dtl::pv_mask;
+            try {
+                if (level == v1_dtl::pv_bits) {
+                    retval->children[i] = retain(tail_leaf);
+                } else if (retval->children[i]) {
+                    auto const child =
+                        static_cast<branch *>(retval->children[i]);
+                    retval->children[i] =
+                        push_tail(level - v1_dtl::pv_bits, child, tail_leaf);
+                    release(child, level - v1_dtl::pv_bits);
+                } else {
+                    retval->children[i] =
+                        new_path(level - v1_dtl::pv_bits, tail_leaf);
+                }
+            } catch (...) {
+                release(retval, level);
+                throw;
+            }
+            return retval;
+        }
+
+        // Returns a copy of n, at level, with element i replaced by x.
+        static branch *
+        assign(size_type level, branch * n, size_type i, T const & x)
+        {
+            auto const retval = copy_branch(n);
+            size_type const j = (i >> level) & v1_dtl::pv_mask;
+            node * const child = n->children[j];
+            try {
+                node * new_child;
+                if (level == v1_dtl::pv_bits) {
+                    new_child = copy_leaf(
+                        static_cast<leaf *>(child),
+                        v1_dtl::pv_width,
+                        &x,
+                        i & v1_dtl::pv_mask);
+                } else {
+                    new_child = assign(
+                        level - v1_dtl::pv_bits,
+                        static_cast<branch *>(child),
+                        i,
+                        x);
+                }
+                release(child, level - v1_dtl::pv_bits);
+                retval->children[j] = new_child;
+            } catch (...) {
+                release(retval, level);
+                throw;
+            }
+            return retval;
+        }
+
+        // Returns a copy of n, at level, without its last leaf, or null if
+        // that leaves it empty.
+        branch * pop_tail(size_type level, branch * n) const
+        {
+            size_type const i = ((size_ - 2) >> level) & v1_dtl::pv_mask;
+            if (v1_dtl::pv_bits < level) {
+                branch * const new_child = pop_tail(
+                    level - v1_dtl::pv_bits,
+                    static_cast<branch *>(n->children[i]));
+                if (!new_child && !i)
+                    return nullptr;
+                branch * retval;
+                try {
+                    retval = copy_branch(n);
+                } catch (...) {
+                    release(new_child, level - v1_dtl::pv_bits);
+                    throw;
+                }
+                release(retval->children[i], level - v1_dtl::pv_bits);
+                retval->children[i] = new_child;
+                return retval;
+            }
+            if (!i)
+                return nullptr;
+            auto const retval = copy_branch(n);
+            release(retval->children[i], 0);
+            retval->children[i] = nullptr;
+            return retval;
+        }
+
+        size_type size_ = 0;
+        size_type shift_ = v1_dtl::pv_bits;
+        branch * root_ = nullptr;
+        leaf * tail_ = nullptr;
+#endif
+    };
+
+}}}
+
+#endif
@@ -0,0 +1,166 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_POINTER_ITERATOR_INTERFACE_HPP
+#define BOOST_STL_INTERFACES_POINTER_ITERATOR_INTERFACE_HPP
+
+#include <boost/stl_interfaces/iterator_interface.hpp>
+
+#include <iterator>
+#include <type_traits>
+
+#include <cstddef>
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+    /** A CRTP template for iterators that are a `T *` and nothing else --
+        a container's iterator, say, that is a type of its own only so that it
+        does not convert to or from other pointers.  It stores the pointer,
+        and implements every operation directly on it, rather than through
+        `access::base()` and the overloads that `iterator_interface` selects
+        among for each kind of iterator.  Optimized, the two produce the same
+        code; in an unoptimized build, each operation is one call instead of
+        several, and there is less for the compiler to instantiate.
+
+        The derived iterator needs only constructors, usually `using
+        pointer_iterator_interface::pointer_iterator_interface;`, and a
+        conversion to its const counterpart if it has one.  `IteratorConcept`
+        must be at least `std::forward_iterator_tag`; whatever it is, all of
+        the random access operations are provided. */
+    template<
+        typename Derived,
+        typename T,
+        typename IteratorConcept = contiguous_iterator_tag>
+    struct pointer_iterator_interface
+    {
+        static_assert(
+            std::is_base_of<std::forward_iterator_tag, IteratorConcept>::
+                value,
+            "pointer_iterator_interface requires a forward iterator (or "
+            "better) IteratorConcept.");
+
+        using iterator_concept = IteratorConcept;
+        using iterator_category = detail::concept_category_t<iterator_concept>;
+        using value_type = std::remove_cv_t<T>;
+        using reference = T &;
+        using pointer = T *;
+        using difference_type = std::ptrdiff_t;
+
+        constexpr pointer_iterator_interface() noexcept : ptr_(nullptr) {}
+        constexpr explicit pointer_iterator_interface(T * ptr) noexcept :
+            ptr_(ptr)
+        {}
+
+        /** Returns the stored pointer. */
+        constexpr T * base() const noexcept { return ptr_; }
+
+        constexpr reference operator*() const noexcept { return *ptr_; }
+        constexpr pointer operator->() const noexcept { return ptr_; }
+        constexpr reference operator[](difference_type n) const noexcept
+        {
+            return ptr_[n];
+        }
+
+        constexpr Derived & operator++() noexcept
+        {
+            ++ptr_;
+            return derived();
+        }
+        constexpr Derived operator++(int)noexcept
+        {
+            Derived retval = derived();
+            ++ptr_;
+            return retval;
+        }
+        constexpr Derived & operator--() noexcept
+        {
+            --ptr_;
+            return derived();
+        }
+        constexpr Derived operator--(int)noexcept
+        {
+            Derived retval = derived();
+            --ptr_;
+            return retval;
+        }
+        constexpr Derived & operator+=(difference_type n) noexcept
+        {
+            ptr_ += n;
+            return derived();
+        }
+        constexpr Derived & operator-=(difference_type n) noexcept
+        {
+            ptr_ -= n;
+            return derived();
+        }
+
+        friend BOOST_STL_INTERFACES_HIDDEN_FRIEND_CONSTEXPR Derived
+        operator+(Derived it, difference_type n) noexcept
+        {
+            it.ptr_ += n;
+            return it;
+        }
+        friend BOOST_STL_INTERFACES_HIDDEN_FRIEND_CONSTEXPR Derived
+        operator+(difference_type n, Derived it) noexcept
+        {
+            it.ptr_ += n;
+            return it;
+        }
+        friend BOOST_STL_INTERFACES_HIDDEN_FRIEND_CONSTEXPR Derived
+        operator-(Derived it, difference_type n) noexcept
+        {
+            it.ptr_ -= n;
+            return it;
+        }
+        friend BOOST_STL_INTERFACES_HIDDEN_FRIEND_CONSTEXPR difference_type
+        operator-(Derived lhs, Derived rhs) noexcept
+        {
+            return lhs.ptr_ - rhs.ptr_;
+        }
+
+        friend BOOST_STL_INTERFACES_HIDDEN_FRIEND_CONSTEXPR bool
+        operator==(Derived lhs, Derived rhs) noexcept
+        {
+            return lhs.ptr_ == rhs.ptr_;
+        }
+        friend BOOST_STL_INTERFACES_HIDDEN_FRIEND_CONSTEXPR bool
+        operator!=(Derived lhs, Derived rhs) noexcept
+        {
+            return lhs.ptr_ != rhs.ptr_;
+        }
+        friend BOOST_STL_INTERFACES_HIDDEN_FRIEND_CONSTEXPR bool
+        operator<(Derived lhs, Derived rhs) noexcept
+        {
+            return lhs.ptr_ < rhs.ptr_;
+        }
+        friend BOOST_STL_INTERFACES_HIDDEN_FRIEND_CONSTEXPR bool
+        operator<=(Derived lhs, Derived rhs) noexcept
+        {
+            return lhs.ptr_ <= rhs.ptr_;
+        }
+        friend BOOST_STL_INTERFACES_HIDDEN_FRIEND_CONSTEXPR bool
+        operator>(Derived lhs, Derived rhs) noexcept
+        {
+            return lhs.ptr_ > rhs.ptr_;
+        }
+        friend BOOST_STL_INTERFACES_HIDDEN_FRIEND_CONSTEXPR bool
+        operator>=(Derived lhs, Derived rhs) noexcept
+        {
+            return lhs.ptr_ >= rhs.ptr_;
+        }
+
+    private:
+        constexpr Derived & derived() noexcept
+        {
+            return static_cast<Derived &>(*this);
+        }
+
+        T * ptr_;
+    };
+
+}}}
+
+#endif
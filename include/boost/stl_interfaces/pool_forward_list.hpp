@@ -0,0 +1,458 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_POOL_FORWARD_LIST_HPP
+#define BOOST_STL_INTERFACES_POOL_FORWARD_LIST_HPP
+
+#include <boost/stl_interfaces/container_interface.hpp>
+
+#include <algorithm>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include <cassert>
+#include <cstddef>
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+    //[ pool_node_defn
+    // The same node as in the node_iterator example, except that value_ is a
+    // union member, so that a node can sit in a pool without holding a value.
+    template<typename T>
+    struct pool_node
+    {
+        pool_node() noexcept {}
+        ~pool_node() {}
+
+        union
+        {
+            T value_;
+        };
+        pool_node * next_; // == nullptr in the tail node
+    };
+    //]
+
+    //[ pool_node_iterator
+    // The forward iterator from the node_iterator example, with a conversion
+    // from pool_node_iterator<T> to pool_node_iterator<T const>.
+    template<typename T>
+    struct pool_node_iterator : iterator_interface<
+                                    pool_node_iterator<T>,
+                                    std::forward_iterator_tag,
+                                    T>
+    {
+        using node_type = pool_node<std::remove_const_t<T>>;
+
+        constexpr pool_node_iterator() noexcept : it_(nullptr) {}
+        constexpr explicit pool_node_iterator(node_type * it) noexcept :
+            it_(it)
+        {}
+        template<
+            typename U,
+            typename E = std::enable_if_t<
+                std::is_same<T, U const>::value && !std::is_same<T, U>::value>>
+        constexpr pool_node_iterator(pool_node_iterator<U> other) noexcept :
+            it_(other.it_)
+        {}
+
+        constexpr T & operator*() const noexcept { return it_->value_; }
+        constexpr pool_node_iterator & operator++() noexcept
+        {
+            it_ = it_->next_;
+            return *this;
+        }
+        friend constexpr bool
+        operator==(pool_node_iterator lhs, pool_node_iterator rhs) noexcept
+        {
+            return lhs.it_ == rhs.it_;
+        }
+
+        using base_type = iterator_interface<
+            pool_node_iterator<T>,
+            std::forward_iterator_tag,
+            T>;
+        using base_type::operator++;
+
+    private:
+        template<typename U>
+        friend struct pool_node_iterator;
+        template<typename U, std::size_t SlabSize>
+        friend struct pool_forward_list;
+
+        node_type * it_;
+    };
+    //]
+
+    //[ pool_forward_list_defn
+    // A singly linked list in the style of std::forward_list, whose nodes come
+    // from a pool owned by the list, instead of from one allocation per node.
+    //
+    // The pool is a chain of slabs of SlabSize nodes each.  New nodes come from
+    // a free list of erased nodes if it is not empty, and otherwise from the
+    // next unused node of the current slab.  Erasing a node puts it on the free
+    // list.  clear() does not touch the free list or the slabs at all; it just
+    // starts over at the first slab, so the slabs are reused by the next
+    // insertions.  The slabs are freed only when the list is destroyed.
+    //
+    // splice_after(pos, other) moves all of other's elements into *this without
+    // copying or reallocating them, by taking ownership of other's slabs,
+    // whole.  Any unused nodes in those slabs are not reused until the next
+    // clear().
+    template<typename T, std::size_t SlabSize = 64>
+    struct pool_forward_list
+        : container_interface<
+              pool_forward_list<T, SlabSize>>
+    {
+        static_assert(0 < SlabSize, "");
+
+        // types
+        using value_type = T;
+        using pointer = T *;
+        using const_pointer = T const *;
+        using reference = value_type &;
+        using const_reference = value_type const &;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using iterator = pool_node_iterator<T>;
+        using const_iterator = pool_node_iterator<T const>;
+
+        // construct/copy/destroy
+        pool_forward_list() noexcept :
+            tail_(nullptr),
+            size_(0),
+            slabs_(nullptr),
+            current_(nullptr),
+            bump_(0),
+            free_(nullptr)
+        {
+            header_.next_ = nullptr;
+        }
+        explicit pool_forward_list(size_type n) : pool_forward_list()
+        {
+            for (; n; --n) {
+                emplace_back();
+            }
+        }
+        pool_forward_list(size_type n, T const & x) : pool_forward_list()
+        {
+            for (; n; --n) {
+                emplace_back(x);
+            }
+        }
+        template<
+            typename InputIterator,
+            typename Enable = std::enable_if_t<std::is_convertible<
+                typename std::iterator_traits<InputIterator>::iterator_category,
+                std::input_iterator_tag>::value>>
+        pool_forward_list(InputIterator first, InputIterator last) :
+            pool_forward_list()
+        {
+            append(first, last);
+        }
+        pool_forward_list(std::initializer_list<T> il) :
+            pool_forward_list(il.begin(), il.end())
+        {}
+        pool_forward_list(pool_forward_list const & other) :
+            pool_forward_list(other.begin(), other.end())
+        {}
+        pool_forward_list(pool_forward_list && other) noexcept :
+            pool_forward_list()
+        {
+            swap(other);
+        }
+        pool_forward_list & operator=(pool_forward_list const & other)
+        {
+            // This reuses the slabs of *this, rather than allocating new ones.
+            if (this != &other) {
+                clear();
+                append(other.begin(), other.end());
+            }
+            return *this;
+        }
+        pool_forward_list & operator=(pool_forward_list && other) noexcept
+        {
+            pool_forward_list temp(std::move(other));
+            swap(temp);
+            return *this;
+        }
+        ~pool_forward_list()
+        {
+            destroy_values();
+            while (slabs_) {
+                auto const next = slabs_->next_;
+                delete slabs_;
+                slabs_ = next;
+            }
+            // container_interface's destructor calls clear(), which must find
+            // nothing left to do.
+            header_.next_ = nullptr;
+            tail_ = nullptr;
+            size_ = 0;
+            current_ = nullptr;
+            free_ = nullptr;
+        }
+
+        // iterators (5 members, skipped 4)
+        iterator before_begin() noexcept { return iterator(&header_); }
+        const_iterator before_begin() const noexcept
+        {
+            return const_iterator(const_cast<node_type *>(&header_));
+        }
+        iterator begin() noexcept { return iterator(header_.next_); }
+        iterator end() noexcept { return iterator(); }
+        const_iterator cbefore_begin() const noexcept { return before_begin(); }
+
+        // capacity
+        size_type size() const noexcept { return size_; }
+
+        // modifiers
+        template<typename... Args>
+        reference emplace_front(Args &&... args)
+        {
+            return *emplace_after(before_begin(), std::forward<Args>(args)...);
+        }
+        template<typename... Args>
+        reference emplace_back(Args &&... args)
+        {
+            auto const pos = tail_ ? const_iterator(tail_) : cbefore_begin();
+            return *emplace_after(pos, std::forward<Args>(args)...);
+        }
+        void pop_front() noexcept
+        {
+            assert(!this->empty());
+            erase_after(before_begin());
+        }
+
+        template<typename... Args>
+        iterator emplace_after(const_iterator pos, Args &&... args)
+        {
+            node_type * const n = allocate_node();
+            try {
+                ::new (std::addressof(n->value_))
+                    T(std::forward<Args>(args)...);
+            } catch (...) {
+                deallocate_node(n);
+                throw;
+            }
+            node_type * const prev = pos.it_;
+            n->next_ = prev->next_;
+            prev->next_ = n;
+            if (!n->next_)
+                tail_ = n;
+            ++size_;
+            return iterator(n);
+        }
+        iterator insert_after(const_iterator pos, T const & x)
+        {
+            return emplace_after(pos, x);
+        }
+        iterator insert_after(const_iterator pos, T && x)
+        {
+            return emplace_after(pos, std::move(x));
+        }
+        template<
+            typename InputIterator,
+            typename Enable = std::enable_if_t<std::is_convertible<
+                typename std::iterator_traits<InputIterator>::iterator_category,
+                std::input_iterator_tag>::value>>
+        iterator insert_after(
+            const_iterator pos, InputIterator first, InputIterator last)
+        {
+            iterator retval(pos.it_);
+            for (; first != last; ++first) {
+                retval = emplace_after(retval, *first);
+            }
+            return retval;
+        }
+
+        iterator erase_after(const_iterator pos) noexcept
+        {
+            node_type * const prev = pos.it_;
+            node_type * const n = prev->next_;
+            assert(n);
+            prev->next_ = n->next_;
+            if (n == tail_)
+                tail_ = prev == &header_ ? nullptr : prev;
+            n->value_.~T();
+            deallocate_node(n);
+            --size_;
+            return iterator(prev->next_);
+        }
+        iterator erase_after(const_iterator first, const_iterator last) noexcept
+        {
+            while (std::next(first) != last) {
+                erase_after(first);
+            }
+            return iterator(last.it_);
+        }
+
+        // Destroys the elements, and makes all the nodes of all the slabs
+        // available for reuse, without freeing any of them.
+        void clear() noexcept
+        {
+            destroy_values();
+            header_.next_ = nullptr;
+            tail_ = nullptr;
+            size_ = 0;
+            current_ = nullptr;
+            bump_ = 0;
+            free_ = nullptr;
+        }
+
+        // Moves all the elements of other to just after pos, along with the
+        // slabs that hold them.  No elements are copied or moved, and no memory
+        // is allocated.
+        void splice_after(
+            const_iterator pos, pool_forward_list & other) noexcept
+        {
+            if (&other == this || other.empty())
+                return;
+
+            node_type * const prev = pos.it_;
+            other.tail_->next_ = prev->next_;
+            prev->next_ = other.header_.next_;
+            if (!other.tail_->next_)
+                tail_ = other.tail_;
+            size_ += other.size_;
+
+            // The slabs before current_ are all in use, so other's slabs go on
+            // the front of the chain.
+            slab_type * other_last = other.slabs_;
+            while (other_last->next_) {
+                other_last = other_last->next_;
+            }
+            other_last->next_ = slabs_;
+            slabs_ = other.slabs_;
+            if (!current_) {
+                current_ = other_last;
+                bump_ = SlabSize;
+            }
+
+            if (other.free_) {
+                node_type * free_last = other.free_;
+                while (free_last->next_) {
+                    free_last = free_last->next_;
+                }
+                free_last->next_ = free_;
+                free_ = other.free_;
+            }
+
+            other.header_.next_ = nullptr;
+            other.tail_ = nullptr;
+            other.size_ = 0;
+            other.slabs_ = nullptr;
+            other.current_ = nullptr;
+            other.bump_ = 0;
+            other.free_ = nullptr;
+        }
+        void splice_after(
+            const_iterator pos, pool_forward_list && other) noexcept
+        {
+            splice_after(pos, other);
+        }
+
+        void swap(pool_forward_list & other) noexcept
+        {
+            using std::swap;
+            swap(header_.next_, other.header_.next_);
+            swap(tail_, other.tail_);
+            swap(size_, other.size_);
+            swap(slabs_, other.slabs_);
+            swap(current_, other.current_);
+            swap(bump_, other.bump_);
+            swap(free_, other.free_);
+        }
+        friend void swap(
+            pool_forward_list & lhs, pool_forward_list & rhs) noexcept
+        {
+            lhs.swap(rhs);
+        }
+
+        // Returns the number of slabs held by the pool.
+        size_type slab_count() const noexcept
+        {
+            size_type retval = 0;
+            for (auto s = slabs_; s; s = s->next_) {
+                ++retval;
+            }
+            return retval;
+        }
+
+        using base_type = container_interface<pool_forward_list<T, SlabSize>>;
+        using base_type::begin;
+        using base_type::end;
+
+    private:
+        using node_type = pool_node<T>;
+
+        struct slab_type
+        {
+            node_type nodes_[SlabSize];
+            slab_type * next_;
+        };
+
+        template<typename InputIterator>
+        void append(InputIterator first, InputIterator last)
+        {
+            for (; first != last; ++first) {
+                emplace_back(*first);
+            }
+        }
+
+        void destroy_values() noexcept
+        {
+            if (std::is_trivially_destructible<T>::value)
+                return;
+            for (auto n = header_.next_; n; n = n->next_) {
+                n->value_.~T();
+            }
+        }
+
+        node_type * allocate_node()
+        {
+            if (free_) {
+                node_type * const retval = free_;
+                free_ = free_->next_;
+                return retval;
+            }
+            if (!current_ || bump_ == SlabSize) {
+                slab_type * next = current_ ? current_->next_ : slabs_;
+                if (!next) {
+                    next = new slab_type;
+                    next->next_ = nullptr;
+                    if (current_)
+                        current_->next_ = next;
+                    else
+                        slabs_ = next;
+                }
+                current_ = next;
+                bump_ = 0;
+            }
+            return &current_->nodes_[bump_++];
+        }
+
+        void deallocate_node(node_type * n) noexcept
+        {
+            n->next_ = free_;
+            free_ = n;
+        }
+
+        node_type header_; // header_.next_ is the first node
+        node_type * tail_; // == nullptr when the list is empty
+        size_type size_;
+        slab_type * slabs_;   // The slabs in use come first.
+        slab_type * current_; // The slab nodes are bumped out of, or nullptr.
+        size_type bump_;      // The index of the next unused node in current_.
+        node_type * free_;    // The erased nodes, linked through next_.
+    };
+    //]
+
+}}}
+
+#endif
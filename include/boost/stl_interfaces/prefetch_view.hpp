@@ -0,0 +1,255 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_PREFETCH_VIEW_HPP
+#define BOOST_STL_INTERFACES_PREFETCH_VIEW_HPP
+
+#include <boost/stl_interfaces/iterator_interface.hpp>
+#include <boost/stl_interfaces/detail/functor_box.hpp>
+#include <boost/stl_interfaces/view_interface.hpp>
+
+#include <iterator>
+#include <memory>
+#include <utility>
+
+#include <cstddef>
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+    /** The default `Peek` of a `prefetching_iterator`: the address of the
+        element an iterator refers to, which must be an lvalue.  For a
+        node-based iterator, that is the address of a member of the node,
+        so the node itself is prefetched, including its link to the next
+        one. */
+    struct prefetch_element
+    {
+        template<typename Iter>
+        constexpr void const * operator()(Iter const & it) const noexcept
+        {
+            return std::addressof(*it);
+        }
+    };
+
+    template<
+        typename Iter,
+        std::ptrdiff_t Distance = 8,
+        typename Peek = prefetch_element>
+    struct prefetching_iterator;
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    namespace v1_dtl {
+        inline void prefetch(void const * p) noexcept
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            __builtin_prefetch(p);
+#else
+            (void)p;
+#endif
+        }
+
+        template<typename Iter>
+        using prefetch_concept_t = std::conditional_t<
+            std::is_convertible<
+                typename std::iterator_traits<Iter>::iterator_category,
+                std::random_access_iterator_tag>::value,
+            std::random_access_iterator_tag,
+            typename std::iterator_traits<Iter>::iterator_category>;
+
+        template<typename Iter, std::ptrdiff_t Distance, typename Peek>
+        using prefetching_iterator_interface_t = iterator_interface<
+            prefetching_iterator<Iter, Distance, Peek>,
+            prefetch_concept_t<Iter>,
+            typename std::iterator_traits<Iter>::value_type,
+            typename std::iterator_traits<Iter>::reference,
+            typename std::iterator_traits<Iter>::pointer,
+            iter_difference_t<Iter>>;
+    }
+
+#endif
+
+    /** An iterator over the same elements as an underlying iterator, that
+        prefetches the element `Distance` positions ahead as it goes, so
+        that a loop that stalls on each element's cache miss -- a walk over
+        a linked list whose nodes are scattered in memory, say -- has the
+        next few misses in flight at once.
+
+        The iterator keeps a second underlying iterator, up to `Distance`
+        positions ahead of the first and never past the end of the range,
+        and calls `__builtin_prefetch()` on `peek(ahead)` whenever that one
+        moves.  `Peek` returns the address to prefetch; by default, it is
+        the address of the element (see `prefetch_element`), which for a
+        node-based iterator is computed without touching the node.  A
+        `Peek` that reads the node itself -- to find the payload it points
+        to, say -- waits for that read, so it only pays when the node is
+        likely to be in cache already.  The lookahead iterator still chases
+        the links one at a time, so this helps most when each element takes
+        work, or loads, of its own.
+
+        The iterator has the category of the underlying iterator, except
+        that it is at least forward and at most random access; it compares
+        and dereferences like the underlying iterator, and `base()` returns
+        it.  On compilers without `__builtin_prefetch()`, nothing is
+        prefetched.
+
+        \see `prefetch_view` */
+    template<typename Iter, std::ptrdiff_t Distance, typename Peek>
+    struct prefetching_iterator
+        : v1_dtl::prefetching_iterator_interface_t<Iter, Distance, Peek>,
+          private detail::functor_box<Peek>
+    {
+        static_assert(
+            std::is_convertible<
+                typename std::iterator_traits<Iter>::iterator_category,
+                std::forward_iterator_tag>::value,
+            "The lookahead of a prefetching_iterator is a copy of the "
+            "underlying iterator, so that must be a forward iterator.");
+        static_assert(0 < Distance, "The prefetch distance must be positive.");
+
+        using difference_type = v1_dtl::iter_difference_t<Iter>;
+
+        constexpr prefetching_iterator() = default;
+        /** Constructs an iterator at `it`, in the range ending at `last`,
+            and prefetches the first `Distance` elements from `it`. */
+        prefetching_iterator(Iter it, Iter last, Peek peek = Peek()) :
+            detail::functor_box<Peek>(std::move(peek)),
+            it_(it),
+            ahead_(it),
+            last_(last),
+            lead_(0)
+        {
+            catch_up();
+        }
+
+        prefetching_iterator & operator++()
+        {
+            ++it_;
+            if (ahead_ == last_) {
+                --lead_;
+            } else {
+                ++ahead_;
+                prefetch();
+            }
+            return *this;
+        }
+        template<typename I = Iter>
+        auto operator--() -> decltype(
+            --std::declval<I &>(), std::declval<prefetching_iterator &>())
+        {
+            --it_;
+            if (lead_ == Distance)
+                --ahead_;
+            else
+                ++lead_;
+            return *this;
+        }
+        template<typename I = Iter>
+        auto operator+=(difference_type n) -> decltype(
+            std::declval<I &>() += n, std::declval<prefetching_iterator &>())
+        {
+            it_ += n;
+            ahead_ = it_;
+            lead_ = 0;
+            catch_up();
+            return *this;
+        }
+
+        /** Returns the underlying iterator. */
+        constexpr Iter base() const { return it_; }
+        /** Returns the function that gives the address to prefetch. */
+        constexpr Peek const & peek() const noexcept { return this->get(); }
+
+        using base_type =
+            v1_dtl::prefetching_iterator_interface_t<Iter, Distance, Peek>;
+        using base_type::operator++;
+        using base_type::operator--;
+
+    private:
+        friend access;
+
+        constexpr Iter & base_reference() noexcept { return it_; }
+        constexpr Iter const & base_reference() const noexcept { return it_; }
+
+        void prefetch() const
+        {
+            if (ahead_ != last_)
+                v1_dtl::prefetch(this->get()(ahead_));
+        }
+        // Moves ahead_ up to Distance positions past it_, prefetching each
+        // element on the way.
+        void catch_up()
+        {
+            for (; lead_ < Distance && ahead_ != last_; ++lead_) {
+                prefetch();
+                ++ahead_;
+            }
+            prefetch();
+        }
+
+        Iter it_ = Iter();
+        Iter ahead_ = Iter();
+        Iter last_ = Iter();
+        std::ptrdiff_t lead_ = 0;
+    };
+
+    /** A view of the elements of `[first, last)`, whose iterators are
+        `prefetching_iterator`s.  Iterating over it prefetches `Distance`
+        elements ahead.
+        \see `prefetching_iterator` */
+    template<
+        typename Iter,
+        std::ptrdiff_t Distance = 8,
+        typename Peek = prefetch_element>
+    struct prefetch_view : view_interface<prefetch_view<Iter, Distance, Peek>>,
+                           private detail::functor_box<Peek>
+    {
+        using iterator = prefetching_iterator<Iter, Distance, Peek>;
+
+        constexpr prefetch_view() = default;
+        constexpr prefetch_view(Iter first, Iter last, Peek peek = Peek()) :
+            detail::functor_box<Peek>(std::move(peek)),
+            first_(first),
+            last_(last)
+        {}
+
+        iterator begin() const
+        {
+            return iterator(first_, last_, this->get());
+        }
+        iterator end() const { return iterator(last_, last_, this->get()); }
+
+        /** Returns the beginning of the underlying range. */
+        constexpr Iter base_begin() const { return first_; }
+        /** Returns the end of the underlying range. */
+        constexpr Iter base_end() const { return last_; }
+
+    private:
+        Iter first_ = Iter();
+        Iter last_ = Iter();
+    };
+
+    /** Returns a `prefetch_view` of `r` that prefetches the elements
+        `Distance` ahead. */
+    template<std::ptrdiff_t Distance = 8, typename Range>
+    constexpr auto make_prefetch_view(Range && r)
+    {
+        using iter = decltype(std::begin(r));
+        return prefetch_view<iter, Distance>(std::begin(r), std::end(r));
+    }
+
+    /** Returns a `prefetch_view` of `r` that prefetches `peek(it)` for the
+        iterators `it` `Distance` ahead. */
+    template<std::ptrdiff_t Distance = 8, typename Range, typename Peek>
+    constexpr auto make_prefetch_view(Range && r, Peek peek)
+    {
+        using iter = decltype(std::begin(r));
+        return prefetch_view<iter, Distance, Peek>(
+            std::begin(r), std::end(r), std::move(peek));
+    }
+
+}}}
+
+#endif
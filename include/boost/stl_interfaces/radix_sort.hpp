@@ -0,0 +1,384 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_RADIX_SORT_HPP
+#define BOOST_STL_INTERFACES_RADIX_SORT_HPP
+
+#include <boost/stl_interfaces/parallel.hpp>
+#include <boost/stl_interfaces/transform_view.hpp>
+
+#include <climits>
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    namespace v1_dtl {
+        template<typename T>
+        using radix_integral = std::integral_constant<
+            bool,
+            std::is_integral<T>::value && !std::is_same<T, bool>::value>;
+
+        // Maps an integer to an unsigned one of the same size, preserving
+        // order: the sign bit of a signed integer is flipped.
+        template<typename T>
+        constexpr std::make_unsigned_t<T> radix_key(T x) noexcept
+        {
+            using U = std::make_unsigned_t<T>;
+            return std::is_signed<T>::value
+                       ? U(U(x) ^ (U(1) << (sizeof(U) * CHAR_BIT - 1)))
+                       : U(x);
+        }
+
+        // Sorts [first, last) by the unsigned integer key(x) of each element
+        // x, stably, one byte of the key per pass -- least significant
+        // first -- back and forth between [first, last) and buf.  Each chunk
+        // counts its digits, and then scatters its elements to the offsets
+        // its counts give it, in parallel.  A pass in which every element
+        // has the same digit is skipped, so small keys in wide integers
+        // take few passes.  On one thread, the counts for all the passes
+        // are taken in a single sweep, since the number of each digit does
+        // not depend on the order of the elements.
+        template<typename Pool, typename T, typename Key>
+        void radix_sort_buffer(
+            Pool & pool,
+            T * first,
+            T * last,
+            T * buf,
+            Key const & key,
+            std::ptrdiff_t grain_size)
+        {
+            constexpr std::ptrdiff_t radix = 256;
+            using key_type = std::decay_t<decltype(key(*first))>;
+            constexpr std::size_t passes = sizeof(key_type);
+            std::ptrdiff_t const n = last - first;
+            std::ptrdiff_t const chunks =
+                v1_dtl::sort_chunks(pool, n, grain_size);
+            bool const one_sweep = chunks == 1;
+            v1_dtl::scratch_vector<std::ptrdiff_t> counts(
+                chunks * radix * (one_sweep ? passes : 1));
+            if (one_sweep) {
+                for (T * it = first; it != last; ++it) {
+                    key_type const k = key(*it);
+                    for (std::size_t pass = 0; pass < passes; ++pass) {
+                        ++counts
+                            [pass * radix +
+                             ((k >> (pass * CHAR_BIT)) & (radix - 1))];
+                    }
+                }
+            }
+
+            T * src = first;
+            T * dst = buf;
+            for (std::size_t pass = 0; pass < passes; ++pass) {
+                int const shift = int(pass * CHAR_BIT);
+                auto const digit = [&](T const & x) {
+                    return std::ptrdiff_t((key(x) >> shift) & (radix - 1));
+                };
+                std::ptrdiff_t * const pass_counts =
+                    counts.data() + (one_sweep ? pass * radix : 0);
+                if (!one_sweep) {
+                    v1_dtl::parallel_run(
+                        pool,
+                        n,
+                        chunks,
+                        [&](std::ptrdiff_t c,
+                            std::ptrdiff_t b,
+                            std::ptrdiff_t e) {
+                            std::ptrdiff_t * const count =
+                                pass_counts + c * radix;
+                            std::fill(count, count + radix, 0);
+                            for (std::ptrdiff_t i = b; i < e; ++i) {
+                                ++count[digit(src[i])];
+                            }
+                        });
+                }
+                bool trivial = false;
+                std::ptrdiff_t offset = 0;
+                for (std::ptrdiff_t d = 0; d < radix; ++d) {
+                    std::ptrdiff_t const start = offset;
+                    for (std::ptrdiff_t c = 0; c < chunks; ++c) {
+                        std::ptrdiff_t const count = pass_counts[c * radix + d];
+                        pass_counts[c * radix + d] = offset;
+                        offset += count;
+                    }
+                    if (offset - start == n)
+                        trivial = true;
+                }
+                if (trivial)
+                    continue;
+                v1_dtl::parallel_run(
+                    pool,
+                    n,
+                    chunks,
+                    [&](std::ptrdiff_t c, std::ptrdiff_t b, std::ptrdiff_t e) {
+                        std::ptrdiff_t * const offsets =
+                            pass_counts + c * radix;
+                        for (std::ptrdiff_t i = b; i < e; ++i) {
+                            dst[offsets[digit(src[i])]++] = std::move(src[i]);
+                        }
+                    });
+                std::swap(src, dst);
+            }
+            if (src != first)
+                v1_dtl::parallel_move(pool, src, n, first, grain_size);
+        }
+
+        // A pool without workers, for the sequential algorithms.
+        struct inline_pool
+        {
+            unsigned int size() const noexcept { return 0; }
+            void submit(std::function<void()> task) { task(); }
+        };
+
+        template<typename T, typename Proj>
+        struct radix_projection
+        {
+            auto operator()(T const & x) const
+            {
+                return v1_dtl::radix_key((*proj_)(x));
+            }
+            Proj const * proj_;
+        };
+
+        template<typename Pool, typename T, typename Proj>
+        void radix_sort_contiguous(
+            Pool & pool,
+            T * first,
+            std::ptrdiff_t n,
+            Proj const & proj,
+            std::ptrdiff_t grain_size)
+        {
+            v1_dtl::scratch_vector<T> buf(n);
+            v1_dtl::radix_sort_buffer(
+                pool,
+                first,
+                first + n,
+                buf.data(),
+                radix_projection<T, Proj>{&proj},
+                grain_size);
+        }
+
+        template<typename Pool, typename Iter, typename Proj>
+        void radix_sort_impl(
+            Pool & pool,
+            Iter first,
+            std::ptrdiff_t n,
+            Proj const & proj,
+            std::ptrdiff_t grain_size,
+            std::true_type)
+        {
+            v1_dtl::radix_sort_contiguous(
+                pool, stl_interfaces::to_address(first), n, proj, grain_size);
+        }
+
+        // Other iterators' elements are copied into an array, sorted there,
+        // and copied back.
+        template<typename Pool, typename Iter, typename Proj>
+        void radix_sort_impl(
+            Pool & pool,
+            Iter first,
+            std::ptrdiff_t n,
+            Proj const & proj,
+            std::ptrdiff_t grain_size,
+            std::false_type)
+        {
+            using value_type = typename std::iterator_traits<Iter>::value_type;
+            v1_dtl::scratch_vector<value_type> values(n);
+            v1_dtl::parallel_move(pool, first, n, values.data(), grain_size);
+            v1_dtl::radix_sort_contiguous(
+                pool, values.data(), n, proj, grain_size);
+            v1_dtl::parallel_move(pool, values.data(), n, first, grain_size);
+        }
+
+        template<typename Iter, typename Proj>
+        using radix_key_t = std::decay_t<decltype(std::declval<Proj const &>()(
+            std::declval<
+                typename std::iterator_traits<Iter>::value_type const &>()))>;
+
+        // When the elements are their own keys, counting them is enough:
+        // the sorted sequence is rewritten from the counts.
+        template<typename Iter>
+        void counting_sort_impl(
+            Iter first,
+            std::ptrdiff_t n,
+            v1_dtl::scratch_vector<std::ptrdiff_t> & counts,
+            identity const &,
+            std::true_type)
+        {
+            using value_type = typename std::iterator_traits<Iter>::value_type;
+            auto it = v1_dtl::parallel_iter(first);
+            auto const last = it + n;
+            for (auto i = it; i != last; ++i) {
+                ++counts[std::ptrdiff_t(*i)];
+            }
+            std::ptrdiff_t const key_count = std::ptrdiff_t(counts.size());
+            for (std::ptrdiff_t k = 0; k < key_count; ++k) {
+                it = std::fill_n(it, counts[k], value_type(k));
+            }
+        }
+
+        template<typename Iter, typename Proj, typename Identity>
+        void counting_sort_impl(
+            Iter first,
+            std::ptrdiff_t n,
+            v1_dtl::scratch_vector<std::ptrdiff_t> & counts,
+            Proj const & proj,
+            Identity)
+        {
+            using value_type = typename std::iterator_traits<Iter>::value_type;
+            auto const it = v1_dtl::parallel_iter(first);
+            for (std::ptrdiff_t i = 0; i < n; ++i) {
+                ++counts[std::ptrdiff_t(proj(it[i]))];
+            }
+            std::ptrdiff_t offset = 0;
+            for (auto & count : counts) {
+                std::ptrdiff_t const c = count;
+                count = offset;
+                offset += c;
+            }
+            v1_dtl::scratch_vector<value_type> buf(n);
+            for (std::ptrdiff_t i = 0; i < n; ++i) {
+                value_type x = it[i];
+                buf[counts[std::ptrdiff_t(proj(x))]++] = std::move(x);
+            }
+            std::move(buf.begin(), buf.end(), it);
+        }
+    }
+
+#endif
+
+    /** Sorts the random access range `[first, last)` stably, in ascending
+        order of the integer keys `proj(x)` of its elements `x`, with an LSD
+        radix sort.  The keys are taken a byte at a time, least significant
+        first; each byte costs a counting pass and a scattering pass over
+        the elements, and a byte that is the same in every key is skipped.
+        That is O(N) work, and for integer keys it is usually several times
+        faster than `std::sort()`.
+
+        If `Iter` is contiguous (see `is_contiguous_iterator`), the sort is
+        done through pointers, with a buffer of `N` elements.  Otherwise --
+        for instance, for the proxy iterators of a packed container -- the
+        elements are copied into an array, sorted there, and copied back.
+        Either way, `Iter`'s `value_type` must be default constructible and
+        move assignable. */
+    template<
+        typename Iter,
+        typename Proj = identity,
+        typename Enable = std::enable_if_t<v1_dtl::is_ra_iter<Iter>::value>>
+    void radix_sort(Iter first, Iter last, Proj const & proj = Proj())
+    {
+        static_assert(
+            v1_dtl::radix_integral<v1_dtl::radix_key_t<Iter, Proj>>::value,
+            "radix_sort() requires integer keys.");
+        std::ptrdiff_t const n = last - first;
+        if (n <= 1)
+            return;
+        v1_dtl::inline_pool pool;
+        v1_dtl::radix_sort_impl(
+            pool,
+            first,
+            n,
+            proj,
+            std::ptrdiff_t(1),
+            v1_dtl::parallel_as_pointer<Iter>{});
+    }
+
+    /** Sorts `[first, last)` as `radix_sort()` does, using the workers of
+        `pool` and the calling thread.  For each byte of the keys, the range
+        is split into chunks as in `parallel_for_each()`; the chunks count
+        their digits concurrently, and then each scatters its elements to
+        the offsets its counts give it, concurrently.
+
+        \pre `0 < grain_size` */
+    template<
+        typename Pool,
+        typename Iter,
+        typename Proj = identity,
+        typename Enable = std::enable_if_t<
+            v1_dtl::is_pool<Pool>::value && v1_dtl::is_ra_iter<Iter>::value>>
+    void parallel_radix_sort(
+        Pool & pool,
+        Iter first,
+        Iter last,
+        Proj const & proj = Proj(),
+        std::ptrdiff_t grain_size = 1024)
+    {
+        static_assert(
+            v1_dtl::radix_integral<v1_dtl::radix_key_t<Iter, Proj>>::value,
+            "parallel_radix_sort() requires integer keys.");
+        BOOST_ASSERT(0 < grain_size);
+        std::ptrdiff_t const n = last - first;
+        if (n <= 1)
+            return;
+        v1_dtl::radix_sort_impl(
+            pool,
+            first,
+            n,
+            proj,
+            grain_size,
+            v1_dtl::parallel_as_pointer<Iter>{});
+    }
+
+    /** Sorts `[first, last)` as `radix_sort()` does, using
+        `default_thread_pool()`. */
+    template<
+        typename Iter,
+        typename Proj = identity,
+        typename Enable = std::enable_if_t<v1_dtl::is_ra_iter<Iter>::value>>
+    void parallel_radix_sort(
+        Iter first,
+        Iter last,
+        Proj const & proj = Proj(),
+        std::ptrdiff_t grain_size = 1024)
+    {
+        stl_interfaces::parallel_radix_sort(
+            default_thread_pool(), first, last, proj, grain_size);
+    }
+
+    /** Sorts the random access range `[first, last)` stably, in ascending
+        order of the keys `proj(x)` of its elements `x`, which are integers
+        in `[0, key_count)`, by counting them.  This takes one pass to count
+        the keys and one to scatter the elements, and beats `radix_sort()`
+        when `key_count` is small.
+
+        If `proj` is `identity` and the elements are integers, no elements
+        are moved: the range is rewritten from the counts.  Otherwise the
+        elements are scattered into a buffer and moved back, so `Iter`'s
+        `value_type` must be default constructible and move assignable.
+
+        \pre `0 < key_count`, and `0 <= proj(x) < key_count` for each
+        element `x` */
+    template<
+        typename Iter,
+        typename Proj = identity,
+        typename Enable = std::enable_if_t<v1_dtl::is_ra_iter<Iter>::value>>
+    void counting_sort(
+        Iter first,
+        Iter last,
+        std::ptrdiff_t key_count,
+        Proj const & proj = Proj())
+    {
+        using value_type = typename std::iterator_traits<Iter>::value_type;
+        BOOST_ASSERT(0 < key_count);
+        std::ptrdiff_t const n = last - first;
+        if (n <= 1)
+            return;
+        v1_dtl::scratch_vector<std::ptrdiff_t> counts(key_count);
+        v1_dtl::counting_sort_impl(
+            first,
+            n,
+            counts,
+            proj,
+            std::integral_constant<
+                bool,
+                std::is_same<Proj, identity>::value &&
+                    v1_dtl::radix_integral<value_type>::value>{});
+    }
+
+}}}
+
+#endif
@@ -0,0 +1,1098 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_RANGE_ADAPTOR_CLOSURE_HPP
+#define BOOST_STL_INTERFACES_RANGE_ADAPTOR_CLOSURE_HPP
+
+#include <boost/stl_interfaces/cached_view_interface.hpp>
+#include <boost/stl_interfaces/filter_view.hpp>
+#include <boost/stl_interfaces/transform_view.hpp>
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <iterator>
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+    template<typename Derived>
+    struct range_adaptor_closure;
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    namespace v1_dtl {
+        template<typename Range>
+        using range_begin_end_t = decltype(
+            std::begin(std::declval<Range &>()),
+            std::end(std::declval<Range &>()));
+
+        template<typename T>
+        using is_closure = std::is_base_of<
+            range_adaptor_closure<std::remove_cv_t<std::remove_reference_t<T>>>,
+            std::remove_cv_t<std::remove_reference_t<T>>>;
+
+        template<typename T>
+        using is_pipeable_range = std::integral_constant<
+            bool,
+            detail::detector<void, range_begin_end_t, T>::value &&
+                !is_closure<T>::value>;
+
+        // The closure c2(c1(r)).
+        template<typename C1, typename C2>
+        struct closure_pipeline
+            : range_adaptor_closure<closure_pipeline<C1, C2>>
+        {
+            constexpr closure_pipeline(C1 c1, C2 c2) :
+                c1_(std::move(c1)),
+                c2_(std::move(c2))
+            {}
+
+            template<typename Range>
+            constexpr auto operator()(Range && r) const
+                -> decltype(std::declval<C2 const &>()(
+                    std::declval<C1 const &>()(std::forward<Range>(r))))
+            {
+                return c2_(c1_(std::forward<Range>(r)));
+            }
+
+        private:
+            C1 c1_;
+            C2 c2_;
+        };
+    }
+
+#endif
+
+    /** A CRTP template that one may derive from to make a range adaptor
+        closure: a function object `c` that adapts a range `r` into a view
+        `c(r)`, and that can be written `r | c`.  Closures compose, too: `c1
+        | c2` is a closure such that `r | (c1 | c2)` is `r | c1 | c2`.  This is
+        a pre-C++23 version of `std::ranges::range_adaptor_closure` (see
+        [range.adaptor.object] in the C++ standard).
+
+        `filter()`, `transform()`, `take()`, `drop()`, `take_while()` and
+        `drop_while()` return closures. */
+    template<typename Derived>
+    struct range_adaptor_closure
+    {
+        template<
+            typename Range,
+            typename Enable = std::enable_if_t<
+                v1_dtl::is_pipeable_range<Range>::value>>
+        friend constexpr auto operator|(Range && r, Derived const & c)
+            -> decltype(c(std::forward<Range>(r)))
+        {
+            return c(std::forward<Range>(r));
+        }
+
+        template<
+            typename Closure,
+            typename Enable =
+                std::enable_if_t<v1_dtl::is_closure<Closure>::value>>
+        friend constexpr auto operator|(Derived const & c1, Closure const & c2)
+        {
+            return v1_dtl::closure_pipeline<Derived, Closure>(c1, c2);
+        }
+    };
+
+    template<typename Iter>
+    struct take_iterator;
+
+    template<typename View>
+    struct take_view;
+
+    template<typename View>
+    struct drop_view;
+
+    template<typename Iter, typename Pred>
+    struct take_while_iterator;
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    namespace v1_dtl {
+        // q(f(x)).
+        template<typename Q, typename F>
+        struct compose
+        {
+            template<typename T>
+            constexpr decltype(auto) operator()(T && x) const
+            {
+                return q_(f_(std::forward<T>(x)));
+            }
+
+            Q q_;
+            F f_;
+        };
+
+        template<typename Q, typename F>
+        constexpr compose<Q, F> compose_with(Q q, F f)
+        {
+            return compose<Q, F>{std::move(q), std::move(f)};
+        }
+        template<typename Q>
+        constexpr Q compose_with(Q q, identity)
+        {
+            return q;
+        }
+
+        // p(x) && q(x).
+        template<typename P, typename Q>
+        struct both
+        {
+            template<typename T>
+            constexpr bool operator()(T && x) const
+            {
+                return p_(x) && q_(x);
+            }
+
+            P p_;
+            Q q_;
+        };
+
+        template<typename T>
+        using derived_view_t =
+            decltype(v1_dtl::derived_view(std::declval<T const &>()));
+
+        // Views whose stages filter() and transform() fuse into their own.
+        template<typename T>
+        struct fusable : std::false_type
+        {
+        };
+        template<typename Iter, typename P, typename F>
+        struct fusable<filter_view<Iter, P, F>> : std::true_type
+        {
+        };
+        template<typename Iter, typename F>
+        struct fusable<transform_view<Iter, F>> : std::true_type
+        {
+        };
+
+        template<typename Range>
+        using enable_unfused_t = std::enable_if_t<
+            !fusable<std::remove_cv_t<std::remove_reference_t<Range>>>::value>;
+
+        template<typename Range>
+        constexpr void check_adaptable()
+        {
+            static_assert(
+                std::is_lvalue_reference<Range>::value,
+                "A temporary range can only be adapted if it is a filter_view "
+                "or a transform_view, whose stages are fused into the new "
+                "view.  Store the range in a variable first.");
+        }
+
+        template<typename Pred>
+        struct filter_closure : range_adaptor_closure<filter_closure<Pred>>
+        {
+            constexpr explicit filter_closure(Pred pred) :
+                pred_(std::move(pred))
+            {}
+
+            template<typename Iter, typename P, typename F>
+            constexpr auto operator()(filter_view<Iter, P, F> const & v) const
+            {
+                using pred_t =
+                    both<P, decltype(compose_with(pred_, v.functor()))>;
+                return filter_view<Iter, pred_t, F>(
+                    v.base_begin(),
+                    v.base_end(),
+                    pred_t{v.pred(), compose_with(pred_, v.functor())},
+                    v.functor());
+            }
+            template<typename Iter, typename F>
+            constexpr auto operator()(transform_view<Iter, F> const & v) const
+            {
+                using pred_t = decltype(compose_with(pred_, v.functor()));
+                return filter_view<Iter, pred_t, F>(
+                    v.base_begin(),
+                    v.base_end(),
+                    compose_with(pred_, v.functor()),
+                    v.functor());
+            }
+            template<
+                typename Range,
+                typename Enable = v1_dtl::enable_unfused_t<Range>>
+            constexpr auto operator()(Range && r) const
+            {
+                v1_dtl::check_adaptable<Range>();
+                return stl_interfaces::make_filter_view(r, pred_);
+            }
+
+        private:
+            Pred pred_;
+        };
+
+        template<typename F>
+        struct transform_closure : range_adaptor_closure<transform_closure<F>>
+        {
+            constexpr explicit transform_closure(F f) : f_(std::move(f)) {}
+
+            template<typename Iter, typename P, typename G>
+            constexpr auto operator()(filter_view<Iter, P, G> const & v) const
+            {
+                using f_t = decltype(compose_with(f_, v.functor()));
+                return filter_view<Iter, P, f_t>(
+                    v.base_begin(),
+                    v.base_end(),
+                    v.pred(),
+                    compose_with(f_, v.functor()));
+            }
+            template<typename Iter, typename G>
+            constexpr auto operator()(transform_view<Iter, G> const & v) const
+            {
+                using f_t = decltype(compose_with(f_, v.functor()));
+                return transform_view<Iter, f_t>(
+                    v.base_begin(),
+                    v.base_end(),
+                    compose_with(f_, v.functor()));
+            }
+            template<
+                typename Range,
+                typename Enable = v1_dtl::enable_unfused_t<Range>>
+            constexpr auto operator()(Range && r) const
+            {
+                v1_dtl::check_adaptable<Range>();
+                return stl_interfaces::make_transform_view(r, f_);
+            }
+
+        private:
+            F f_;
+        };
+
+        template<typename Iter>
+        using take_ra = std::is_convertible<
+            typename std::iterator_traits<Iter>::iterator_category,
+            std::random_access_iterator_tag>;
+
+        // The size of r in constant time: r.size() if it has one, and
+        // otherwise the distance between its random access iterators.
+        template<typename Range>
+        constexpr auto range_size_impl(Range & r, int) -> decltype(r.size())
+        {
+            return r.size();
+        }
+        template<
+            typename Range,
+            typename Iter = decltype(std::begin(std::declval<Range &>())),
+            typename Enable = std::enable_if_t<take_ra<Iter>::value>>
+        constexpr auto range_size_impl(Range & r, long)
+            -> decltype(std::end(r) - std::begin(r))
+        {
+            return std::end(r) - std::begin(r);
+        }
+        template<typename Range>
+        constexpr auto range_size(Range & r)
+            -> decltype(v1_dtl::range_size_impl(r, 0))
+        {
+            return v1_dtl::range_size_impl(r, 0);
+        }
+
+        template<typename Range>
+        using range_data_t = decltype(std::declval<Range &>().data());
+
+        // True if the elements of Range are contiguous: if its iterators
+        // are known to be, or if they are random access and it has a data()
+        // that points to its elements, as do std::vector and std::string,
+        // whose iterators are class types that is_contiguous_iterator cannot
+        // recognize before C++20.
+        template<typename Range, typename Iter, typename Enable = void>
+        struct contiguous_range : is_contiguous_iterator<Iter>
+        {
+        };
+        template<typename Range, typename Iter>
+        struct contiguous_range<
+            Range,
+            Iter,
+            detail::void_t<range_data_t<Range>>>
+            : std::integral_constant<
+                  bool,
+                  is_contiguous_iterator<Iter>::value ||
+                      (take_ra<Iter>::value &&
+                       std::is_pointer<range_data_t<Range>>::value &&
+                       std::is_same<
+                           std::remove_cv_t<std::remove_pointer_t<
+                               range_data_t<Range>>>,
+                           typename std::iterator_traits<
+                               Iter>::value_type>::value)>
+        {
+        };
+
+        // A view of an lvalue range, for a take_view to hold.  It forwards
+        // the range's data() and size(), so that the views that hold it
+        // keep them.
+        template<typename Range>
+        struct ref_view : view_interface<ref_view<Range>>
+        {
+            constexpr explicit ref_view(Range & r) noexcept :
+                r_(std::addressof(r))
+            {}
+
+            constexpr auto begin() const { return std::begin(*r_); }
+            constexpr auto end() const { return std::end(*r_); }
+
+            template<typename R = Range>
+            constexpr auto data() const -> range_data_t<R>
+            {
+                return r_->data();
+            }
+            template<typename R = Range>
+            constexpr auto size() const
+                -> decltype(v1_dtl::range_size(std::declval<R &>()))
+            {
+                return v1_dtl::range_size(*r_);
+            }
+
+        private:
+            Range * r_;
+        };
+
+        template<typename Range>
+        struct all
+        {
+            using type = std::remove_cv_t<std::remove_reference_t<Range>>;
+            static constexpr type make(Range && r)
+            {
+                return type(std::forward<Range>(r));
+            }
+        };
+        template<typename Range>
+        struct all<Range &>
+        {
+            using type = ref_view<Range>;
+            static constexpr type make(Range & r) { return type(r); }
+        };
+
+        template<typename View>
+        using view_iterator_t = decltype(std::declval<View &>().begin());
+
+        template<typename Range>
+        constexpr void check_view_or_lvalue()
+        {
+            static_assert(
+                std::is_lvalue_reference<Range>::value ||
+                    detail::detector<
+                        void,
+                        v1_dtl::derived_view_t,
+                        std::remove_reference_t<Range>>::value,
+                "take(), drop(), take_while() and drop_while() can only adapt "
+                "a temporary range if it is a view, derived from "
+                "view_interface.");
+        }
+
+        // Views that take() shortens in place, rather than adapting them.
+        template<typename T>
+        struct take_fusable : std::false_type
+        {
+        };
+        template<typename View>
+        struct take_fusable<take_view<View>> : std::true_type
+        {
+        };
+        template<typename Iter, typename F>
+        struct take_fusable<transform_view<Iter, F>> : take_ra<Iter>
+        {
+        };
+
+        struct take_closure : range_adaptor_closure<take_closure>
+        {
+            constexpr explicit take_closure(std::ptrdiff_t n) : n_(n) {}
+
+            template<typename View>
+            constexpr auto operator()(take_view<View> const & v) const
+            {
+                return take_view<View>(v.base(), (std::min)(n_, v.count()));
+            }
+            template<
+                typename Iter,
+                typename F,
+                typename Enable = std::enable_if_t<take_ra<Iter>::value>>
+            constexpr auto operator()(transform_view<Iter, F> const & v) const
+            {
+                auto const first = v.base_begin();
+                auto const n =
+                    (std::min)(n_, std::ptrdiff_t(v.base_end() - first));
+                return transform_view<Iter, F>(first, first + n, v.functor());
+            }
+            template<
+                typename Range,
+                typename Enable = std::enable_if_t<!take_fusable<
+                    std::remove_cv_t<std::remove_reference_t<Range>>>::value>>
+            constexpr auto operator()(Range && r) const
+            {
+                check_view_or_lvalue<Range>();
+                using all_t = all<Range>;
+                return take_view<typename all_t::type>(
+                    all_t::make(std::forward<Range>(r)), n_);
+            }
+
+        private:
+            std::ptrdiff_t n_;
+        };
+
+        template<typename Iter>
+        using take_category_t = std::conditional_t<
+            std::is_convertible<
+                typename std::iterator_traits<Iter>::iterator_category,
+                std::forward_iterator_tag>::value,
+            std::forward_iterator_tag,
+            typename std::iterator_traits<Iter>::iterator_category>;
+
+        template<typename Iter>
+        using take_iterator_interface_t = iterator_interface<
+            take_iterator<Iter>,
+            take_category_t<Iter>,
+            typename std::iterator_traits<Iter>::value_type,
+            typename std::iterator_traits<Iter>::reference,
+            typename std::iterator_traits<Iter>::pointer,
+            iter_difference_t<Iter>>;
+
+        template<typename Iter, typename Pred>
+        using take_while_iterator_interface_t = iterator_interface<
+            take_while_iterator<Iter, Pred>,
+            take_category_t<Iter>,
+            typename std::iterator_traits<Iter>::value_type,
+            typename std::iterator_traits<Iter>::reference,
+            typename std::iterator_traits<Iter>::pointer,
+            iter_difference_t<Iter>>;
+
+        template<typename View>
+        using view_contiguous =
+            contiguous_range<View, view_iterator_t<View>>;
+
+        // A view_interface whose begin() is Derived's uncached_begin(), for
+        // views that cache their begin() only when it is expensive.
+        template<typename Derived, bool Contiguous>
+        struct uncached_begin_view_interface
+            : view_interface<Derived, Contiguous>
+        {
+            constexpr auto begin()
+            {
+                return access::uncached_begin(static_cast<Derived &>(*this));
+            }
+        };
+
+        // A drop_view finds its begin() in constant time if its iterators
+        // are random access, and caches it otherwise.
+        template<typename View>
+        using drop_view_interface_t = std::conditional_t<
+            take_ra<view_iterator_t<View>>::value,
+            uncached_begin_view_interface<
+                drop_view<View>,
+                view_contiguous<View>::value>,
+            cached_begin_view_interface<
+                drop_view<View>,
+                view_iterator_t<View>>>;
+    }
+
+#endif
+
+    /** An iterator over the first `n` elements of a range that is not random
+        access.  It holds its position and the number of elements left, and
+        is equal to the end when either one is at the end.  It is at most a
+        forward iterator.
+        \see `take_view` */
+    template<typename Iter>
+    struct take_iterator : v1_dtl::take_iterator_interface_t<Iter>
+    {
+        using reference = typename std::iterator_traits<Iter>::reference;
+        using difference_type = v1_dtl::iter_difference_t<Iter>;
+
+        constexpr take_iterator() = default;
+        constexpr take_iterator(Iter it, difference_type n) : it_(it), n_(n) {}
+
+        constexpr reference operator*() const { return *it_; }
+        constexpr take_iterator & operator++()
+        {
+            ++it_;
+            --n_;
+            return *this;
+        }
+        friend constexpr bool
+        operator==(take_iterator const & lhs, take_iterator const & rhs)
+        {
+            return lhs.n_ == rhs.n_ || lhs.it_ == rhs.it_;
+        }
+
+        /** Returns the underlying iterator. */
+        constexpr Iter base() const { return it_; }
+        /** Returns the number of elements left. */
+        constexpr difference_type count() const noexcept { return n_; }
+
+        using base_type = v1_dtl::take_iterator_interface_t<Iter>;
+        using base_type::operator++;
+
+    private:
+        Iter it_ = Iter();
+        difference_type n_ = 0;
+    };
+
+    /** A view of the first `n` elements of `View`, or all of them if there
+        are fewer than `n`, like `std::ranges::take_view`.  If the iterators
+        of `View` are random access, they are the iterators of the
+        `take_view` too, and the end is found once, in `end()`; otherwise,
+        the iterators are `take_iterator`s.
+
+        The `take_view` holds `View`.  It is made by the `take()` range
+        adaptor, from a view, or from a reference to any other range.  It is
+        sized if `View` is, and if the elements of `View` are contiguous --
+        if its iterators are contiguous, or are random access and `View` has
+        a `data()`, as a reference to a `std::vector` does -- it is
+        contiguous too, and has `data()`. */
+    template<typename View>
+    struct take_view
+        : view_interface<take_view<View>, v1_dtl::view_contiguous<View>::value>
+    {
+        using base_iterator = v1_dtl::view_iterator_t<View>;
+        using iterator = std::conditional_t<
+            v1_dtl::take_ra<base_iterator>::value,
+            base_iterator,
+            take_iterator<base_iterator>>;
+        using difference_type = v1_dtl::iter_difference_t<base_iterator>;
+
+        constexpr take_view(View base, difference_type n) :
+            base_(std::move(base)),
+            n_(n)
+        {
+            BOOST_ASSERT(0 <= n);
+        }
+
+        constexpr iterator begin()
+        {
+            return begin_impl(v1_dtl::take_ra<base_iterator>{});
+        }
+        constexpr iterator end()
+        {
+            return end_impl(v1_dtl::take_ra<base_iterator>{});
+        }
+
+        /** Returns the view adapted. */
+        constexpr View & base() noexcept { return base_; }
+        /** Returns the view adapted. */
+        constexpr View const & base() const noexcept { return base_; }
+        /** Returns the number of elements taken, if there are that many. */
+        constexpr difference_type count() const noexcept { return n_; }
+
+        /** Returns the number of elements, in constant time, if `View` is
+            sized, even if its iterators are not random access. */
+        template<typename V = View>
+        constexpr auto size() -> decltype(
+            difference_type(v1_dtl::range_size(std::declval<V &>())))
+        {
+            return (std::min)(n_, difference_type(v1_dtl::range_size(base_)));
+        }
+        /** Returns the number of elements, in constant time, if `View` is
+            sized, even if its iterators are not random access. */
+        template<typename V = View>
+        constexpr auto size() const -> decltype(
+            difference_type(v1_dtl::range_size(std::declval<V const &>())))
+        {
+            return (std::min)(n_, difference_type(v1_dtl::range_size(base_)));
+        }
+
+    private:
+        constexpr iterator begin_impl(std::true_type) { return base_.begin(); }
+        constexpr iterator begin_impl(std::false_type)
+        {
+            return iterator(base_.begin(), n_);
+        }
+        constexpr iterator end_impl(std::true_type)
+        {
+            auto const first = base_.begin();
+            return first + (std::min)(n_, difference_type(base_.end() - first));
+        }
+        constexpr iterator end_impl(std::false_type)
+        {
+            return iterator(base_.end(), 0);
+        }
+
+        View base_;
+        difference_type n_;
+    };
+
+    /** A view of the elements of `View` after the first `n`, or of none of
+        them if there are fewer than `n`, like `std::ranges::drop_view`.  Its
+        iterators are those of `View`.
+
+        If they are random access, `begin()` is found in constant time, and
+        if the elements of `View` are contiguous, as for `take_view`, the
+        view is contiguous too, and has `data()`.  Otherwise, `begin()`
+        walks past the first `n` elements the first time it is called, and
+        is cached after that, as with `cached_begin_view_interface`.  The
+        view is sized if `View` is.
+
+        The `drop_view` holds `View`.  It is made by the `drop()` range
+        adaptor, from a view, or from a reference to any other range. */
+    template<typename View>
+    struct drop_view : v1_dtl::drop_view_interface_t<View>
+    {
+        using iterator = v1_dtl::view_iterator_t<View>;
+        using difference_type = v1_dtl::iter_difference_t<iterator>;
+
+        constexpr drop_view(View base, difference_type n) :
+            base_(std::move(base)),
+            n_(n)
+        {
+            BOOST_ASSERT(0 <= n);
+        }
+
+        constexpr iterator end() { return base_.end(); }
+
+        /** Returns the view adapted. */
+        constexpr View & base() noexcept { return base_; }
+        /** Returns the view adapted. */
+        constexpr View const & base() const noexcept { return base_; }
+        /** Returns the number of elements dropped, if there are that many. */
+        constexpr difference_type count() const noexcept { return n_; }
+
+        /** Returns the number of elements, in constant time, if `View` is
+            sized, even if its iterators are not random access. */
+        template<typename V = View>
+        constexpr auto size() -> decltype(
+            difference_type(v1_dtl::range_size(std::declval<V &>())))
+        {
+            auto const n = difference_type(v1_dtl::range_size(base_));
+            return n_ < n ? n - n_ : 0;
+        }
+        /** Returns the number of elements, in constant time, if `View` is
+            sized, even if its iterators are not random access. */
+        template<typename V = View>
+        constexpr auto size() const -> decltype(
+            difference_type(v1_dtl::range_size(std::declval<V const &>())))
+        {
+            auto const n = difference_type(v1_dtl::range_size(base_));
+            return n_ < n ? n - n_ : 0;
+        }
+
+    private:
+        friend access;
+
+        constexpr iterator uncached_begin()
+        {
+            return uncached_begin_impl(v1_dtl::take_ra<iterator>{});
+        }
+        constexpr iterator uncached_begin_impl(std::true_type)
+        {
+            auto const first = base_.begin();
+            return first + (std::min)(n_, difference_type(base_.end() - first));
+        }
+        constexpr iterator uncached_begin_impl(std::false_type)
+        {
+            auto first = base_.begin();
+            auto const last = base_.end();
+            for (auto n = n_; n && first != last; --n) {
+                ++first;
+            }
+            return first;
+        }
+
+        View base_;
+        difference_type n_;
+    };
+
+    /** An iterator over the elements of a range up to the first one for
+        which a predicate returns `false`.  It holds its position, the end of
+        the range, and a pointer to the predicate, and moves to the end as
+        soon as the predicate returns `false`, so that the predicate is
+        called once for each element, and two iterators are compared with
+        one comparison.  It is at most a forward iterator.
+        \see `take_while_view` */
+    template<typename Iter, typename Pred>
+    struct take_while_iterator
+        : v1_dtl::take_while_iterator_interface_t<Iter, Pred>
+    {
+        using reference = typename std::iterator_traits<Iter>::reference;
+
+        constexpr take_while_iterator() = default;
+        constexpr take_while_iterator(Iter it, Iter last, Pred const * pred) :
+            it_(it),
+            last_(last),
+            pred_(pred)
+        {
+            skip_to_end();
+        }
+
+        constexpr reference operator*() const { return *it_; }
+        constexpr take_while_iterator & operator++()
+        {
+            ++it_;
+            skip_to_end();
+            return *this;
+        }
+        friend constexpr bool operator==(
+            take_while_iterator const & lhs, take_while_iterator const & rhs)
+        {
+            return lhs.it_ == rhs.it_;
+        }
+
+        /** Returns the underlying iterator. */
+        constexpr Iter base() const { return it_; }
+
+        using base_type = v1_dtl::take_while_iterator_interface_t<Iter, Pred>;
+        using base_type::operator++;
+
+    private:
+        constexpr void skip_to_end()
+        {
+            if (it_ != last_ && !(*pred_)(*it_))
+                it_ = last_;
+        }
+
+        Iter it_ = Iter();
+        Iter last_ = Iter();
+        Pred const * pred_ = nullptr;
+    };
+
+    /** A view of the elements of `View` up to the first one for which
+        `pred` returns `false`, like `std::ranges::take_while_view`.  Its
+        iterators are `take_while_iterator`s, which refer to the view's
+        predicate, so the view must outlive them.
+
+        The `take_while_view` holds `View`.  It is made by the `take_while()`
+        range adaptor, from a view, or from a reference to any other
+        range. */
+    template<typename View, typename Pred>
+    struct take_while_view : view_interface<take_while_view<View, Pred>>
+    {
+        using base_iterator = v1_dtl::view_iterator_t<View>;
+        using iterator = take_while_iterator<base_iterator, Pred>;
+
+        constexpr take_while_view(View base, Pred pred) :
+            base_(std::move(base)),
+            pred_(std::move(pred))
+        {}
+
+        constexpr iterator begin()
+        {
+            return iterator(base_.begin(), base_.end(), &pred_);
+        }
+        constexpr iterator end()
+        {
+            return iterator(base_.end(), base_.end(), &pred_);
+        }
+
+        /** Returns the view adapted. */
+        constexpr View & base() noexcept { return base_; }
+        /** Returns the view adapted. */
+        constexpr View const & base() const noexcept { return base_; }
+        /** Returns the predicate. */
+        constexpr Pred const & pred() const noexcept { return pred_; }
+
+    private:
+        View base_;
+        Pred pred_;
+    };
+
+    /** A view of the elements of `View` from the first one for which `pred`
+        returns `false`, like `std::ranges::drop_while_view`.  Its iterators
+        are those of `View`.  `begin()` calls `pred` on the leading elements
+        the first time it is called, and is cached after that, as with
+        `cached_begin_view_interface`.  If the iterators of `View` are random
+        access, the view is sized, and if they are contiguous, it is
+        contiguous too, and has `data()`.
+
+        The `drop_while_view` holds `View`.  It is made by the `drop_while()`
+        range adaptor, from a view, or from a reference to any other
+        range. */
+    template<typename View, typename Pred>
+    struct drop_while_view : cached_begin_view_interface<
+                                 drop_while_view<View, Pred>,
+                                 v1_dtl::view_iterator_t<View>,
+                                 v1_dtl::view_contiguous<View>::value>
+    {
+        using iterator = v1_dtl::view_iterator_t<View>;
+
+        constexpr drop_while_view(View base, Pred pred) :
+            base_(std::move(base)),
+            pred_(std::move(pred))
+        {}
+
+        constexpr iterator end() { return base_.end(); }
+
+        /** Returns the view adapted. */
+        constexpr View & base() noexcept { return base_; }
+        /** Returns the view adapted. */
+        constexpr View const & base() const noexcept { return base_; }
+        /** Returns the predicate. */
+        constexpr Pred const & pred() const noexcept { return pred_; }
+
+    private:
+        friend access;
+
+        constexpr iterator uncached_begin()
+        {
+            auto first = base_.begin();
+            auto const last = base_.end();
+            for (; first != last; ++first) {
+                if (!pred_(*first))
+                    break;
+            }
+            return first;
+        }
+
+        View base_;
+        Pred pred_;
+    };
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    namespace v1_dtl {
+        template<typename T>
+        struct is_drop_view : std::false_type
+        {
+        };
+        template<typename View>
+        struct is_drop_view<drop_view<View>> : std::true_type
+        {
+        };
+
+        struct drop_closure : range_adaptor_closure<drop_closure>
+        {
+            constexpr explicit drop_closure(std::ptrdiff_t n) : n_(n) {}
+
+            template<typename View>
+            constexpr auto operator()(drop_view<View> const & v) const
+            {
+                return drop_view<View>(v.base(), v.count() + n_);
+            }
+            template<
+                typename Range,
+                typename Enable = std::enable_if_t<!is_drop_view<
+                    std::remove_cv_t<std::remove_reference_t<Range>>>::value>>
+            constexpr auto operator()(Range && r) const
+            {
+                check_view_or_lvalue<Range>();
+                using all_t = all<Range>;
+                return drop_view<typename all_t::type>(
+                    all_t::make(std::forward<Range>(r)), n_);
+            }
+
+        private:
+            std::ptrdiff_t n_;
+        };
+
+        template<typename Pred>
+        struct take_while_closure
+            : range_adaptor_closure<take_while_closure<Pred>>
+        {
+            constexpr explicit take_while_closure(Pred pred) :
+                pred_(std::move(pred))
+            {}
+
+            template<typename Range>
+            constexpr auto operator()(Range && r) const
+            {
+                check_view_or_lvalue<Range>();
+                using all_t = all<Range>;
+                return take_while_view<typename all_t::type, Pred>(
+                    all_t::make(std::forward<Range>(r)), pred_);
+            }
+
+        private:
+            Pred pred_;
+        };
+
+        template<typename Pred>
+        struct drop_while_closure
+            : range_adaptor_closure<drop_while_closure<Pred>>
+        {
+            constexpr explicit drop_while_closure(Pred pred) :
+                pred_(std::move(pred))
+            {}
+
+            template<typename Range>
+            constexpr auto operator()(Range && r) const
+            {
+                check_view_or_lvalue<Range>();
+                using all_t = all<Range>;
+                return drop_while_view<typename all_t::type, Pred>(
+                    all_t::make(std::forward<Range>(r)), pred_);
+            }
+
+        private:
+            Pred pred_;
+        };
+    }
+
+#endif
+
+    /** Returns a range adaptor closure that adapts a range `r` into a view
+        of the elements of `r` for which `pred` returns `true`.  The view is
+        a `filter_view`.
+
+        If `r` is itself a `filter_view` or a `transform_view`, the new view
+        is a single `filter_view` of the underlying range, with the predicate
+        and the transformation of `r` folded into its own; so `r | filter(p1)
+        | transform(f) | filter(p2)` iterates with one iterator, not three
+        nested ones.  Any other range must be an lvalue, since the view
+        refers to its elements. */
+    template<typename Pred>
+    constexpr v1_dtl::filter_closure<Pred> filter(Pred pred)
+    {
+        return v1_dtl::filter_closure<Pred>(std::move(pred));
+    }
+
+    /** Returns a range adaptor closure that adapts a range `r` into a view
+        of `f(x)` for the elements `x` of `r`.  The view is a `transform_view`
+        -- or a `filter_view`, if `r` is one.
+
+        As with `filter()`, adjacent `filter()` and `transform()` stages are
+        fused into one view; in particular, two `transform()`s in a row
+        become one `transform_view` of their composition. */
+    template<typename F>
+    constexpr v1_dtl::transform_closure<F> transform(F f)
+    {
+        return v1_dtl::transform_closure<F>(std::move(f));
+    }
+
+    /** Returns a range adaptor closure that adapts a range `r` into a
+        `take_view` of its first `n` elements.  If `r` is a `take_view`, the
+        result is a `take_view` of the same view; and if `r` is a
+        `transform_view` of random access iterators, the result is a shorter
+        `transform_view`. */
+    constexpr v1_dtl::take_closure take(std::ptrdiff_t n)
+    {
+        return v1_dtl::take_closure(n);
+    }
+
+    /** Returns a range adaptor closure that adapts a range `r` into a
+        `drop_view` of its elements after the first `n`.  If `r` is a
+        `drop_view`, the result is a `drop_view` of the same view. */
+    constexpr v1_dtl::drop_closure drop(std::ptrdiff_t n)
+    {
+        return v1_dtl::drop_closure(n);
+    }
+
+    /** Returns a range adaptor closure that adapts a range `r` into a
+        `take_while_view` of its elements up to the first one for which
+        `pred` returns `false`. */
+    template<typename Pred>
+    constexpr v1_dtl::take_while_closure<Pred> take_while(Pred pred)
+    {
+        return v1_dtl::take_while_closure<Pred>(std::move(pred));
+    }
+
+    /** Returns a range adaptor closure that adapts a range `r` into a
+        `drop_while_view` of its elements from the first one for which
+        `pred` returns `false`. */
+    template<typename Pred>
+    constexpr v1_dtl::drop_while_closure<Pred> drop_while(Pred pred)
+    {
+        return v1_dtl::drop_while_closure<Pred>(std::move(pred));
+    }
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    namespace v1_dtl {
+        template<typename View, typename F>
+        constexpr auto then_transform(View const & v, F const & f)
+        {
+            return transform_closure<F>(f)(v);
+        }
+        template<typename View>
+        constexpr View then_transform(View const & v, identity)
+        {
+            return v;
+        }
+
+        // Rebuilds a view of views as the view that the range adaptors
+        // would have made, one stage at a time from the innermost view out.
+        // The stages are static members, so that each can call those
+        // declared after it.
+        struct fuser
+        {
+            template<typename View>
+            static constexpr View fuse(View const & v)
+            {
+                return v;
+            }
+
+            template<
+                typename Iter,
+                typename P,
+                typename G,
+                typename Q,
+                typename F>
+            static constexpr auto
+            fuse(filter_view<filter_view_iterator<Iter, P, G>, Q, F> const & v)
+            {
+                auto const & inner = v.base_begin().view();
+                return then_transform(
+                    filter_closure<Q>(v.pred())(fuse(filter_view<Iter, P, G>(
+                        v.base_begin().base(),
+                        v.base_end().base(),
+                        inner.pred(),
+                        inner.functor()))),
+                    v.functor());
+            }
+            template<typename Iter, typename G, typename Q, typename F>
+            static constexpr auto
+            fuse(filter_view<transform_iterator<Iter, G>, Q, F> const & v)
+            {
+                return then_transform(
+                    filter_closure<Q>(v.pred())(fuse(transform_view<Iter, G>(
+                        v.base_begin().base(),
+                        v.base_end().base(),
+                        v.base_begin().functor()))),
+                    v.functor());
+            }
+            template<typename Iter, typename P, typename G, typename F>
+            static constexpr auto
+            fuse(transform_view<filter_view_iterator<Iter, P, G>, F> const & v)
+            {
+                auto const & inner = v.base_begin().view();
+                return transform_closure<F>(v.functor())(
+                    fuse(filter_view<Iter, P, G>(
+                        v.base_begin().base(),
+                        v.base_end().base(),
+                        inner.pred(),
+                        inner.functor())));
+            }
+            template<typename Iter, typename G, typename F>
+            static constexpr auto
+            fuse(transform_view<transform_iterator<Iter, G>, F> const & v)
+            {
+                return transform_closure<F>(v.functor())(
+                    fuse(transform_view<Iter, G>(
+                        v.base_begin().base(),
+                        v.base_end().base(),
+                        v.base_begin().functor())));
+            }
+            template<typename View>
+            static constexpr auto fuse(take_view<View> const & v)
+            {
+                return take_closure(v.count())(fuse(v.base()));
+            }
+            template<typename View>
+            static constexpr auto fuse(drop_view<View> const & v)
+            {
+                return drop_closure(v.count())(fuse(v.base()));
+            }
+        };
+    }
+
+#endif
+
+    /** Returns a view of the same elements as `v`, in which views of
+        `filter_view`s, `transform_view`s, `take_view`s and `drop_view`s
+        nested in one another are fused, as the range adaptors fuse them; so
+        that, for instance, a `filter_view` of a `transform_view` of a
+        `filter_view` of some range becomes a single `filter_view` of that
+        range.  Iterating
+        over the result then goes through one iterator per element, with one
+        loop, rather than through each of the nested iterators in turn.
+
+        The result refers to the underlying range, and to none of the views
+        nested in `v`, which may then be destroyed.  Any view that cannot be
+        fused is kept as it is. */
+    template<typename View>
+    constexpr auto fuse(View const & v)
+    {
+        return v1_dtl::fuser::fuse(v);
+    }
+
+}}}
+
+#endif
@@ -0,0 +1,197 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_RCU_CONTAINER_HPP
+#define BOOST_STL_INTERFACES_RCU_CONTAINER_HPP
+
+#include <boost/stl_interfaces/view_interface.hpp>
+
+#include <boost/assert.hpp>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    namespace v1_dtl {
+        // The readers of an rcu_container count themselves in one of
+        // rcu_stripes stripes, chosen by thread, so that readers on
+        // different cores seldom write the same cache line.
+        constexpr unsigned int rcu_stripes = 16;
+
+        struct alignas(64) rcu_stripe
+        {
+            std::atomic<long> readers[2] = {{0}, {0}};
+        };
+
+        inline unsigned int rcu_this_stripe() noexcept
+        {
+            thread_local unsigned int const stripe = (unsigned int)(
+                std::hash<std::thread::id>()(std::this_thread::get_id()) %
+                rcu_stripes);
+            return stripe;
+        }
+    }
+
+#endif
+
+    template<typename C>
+    struct rcu_container;
+
+    /** A view of the elements of one snapshot of an `rcu_container`.  The
+        snapshot is pinned while the view exists: an update of the
+        container that replaces it waits, before destroying it, for the
+        view to be destroyed.  So a view should be short-lived, like a lock;
+        holding one across an update on the same thread deadlocks.
+
+        The view can be moved, but not copied. */
+    template<typename C>
+    struct rcu_view : view_interface<rcu_view<C>>
+    {
+        using container_type = C;
+        using iterator = typename C::const_iterator;
+
+        rcu_view() noexcept = default;
+        rcu_view(rcu_view && other) noexcept :
+            snapshot_(std::exchange(other.snapshot_, nullptr)),
+            readers_(std::exchange(other.readers_, nullptr))
+        {}
+        rcu_view & operator=(rcu_view && other) noexcept
+        {
+            rcu_view temp(std::move(other));
+            std::swap(snapshot_, temp.snapshot_);
+            std::swap(readers_, temp.readers_);
+            return *this;
+        }
+        ~rcu_view()
+        {
+            if (readers_)
+                readers_->fetch_sub(1, std::memory_order_release);
+        }
+
+        iterator begin() const { return snapshot().begin(); }
+        iterator end() const { return snapshot().end(); }
+
+        /** Returns the snapshot.
+            \pre The view was not default constructed or moved from. */
+        C const & snapshot() const noexcept
+        {
+            BOOST_ASSERT(snapshot_);
+            return *snapshot_;
+        }
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+    private:
+        friend rcu_container<C>;
+
+        rcu_view(C const * snapshot, std::atomic<long> * readers) noexcept :
+            snapshot_(snapshot), readers_(readers)
+        {}
+
+        C const * snapshot_ = nullptr;
+        std::atomic<long> * readers_ = nullptr;
+#endif
+    };
+
+    /** A container `C` -- a `container_interface` container, or any other
+        with copy construction and `const_iterator`s -- that is read by
+        many threads and seldom updated, read-copy-update style.  Readers
+        call `read()`, and get an `rcu_view` of the current snapshot, which
+        does not change; no reader takes a lock or waits, and it writes
+        only a counter that it shares with few other threads.  A writer
+        copies the current snapshot, changes the copy, publishes it for
+        new readers, and then waits for the readers of the old one to
+        finish before destroying it.  Writers are serialized with a mutex.
+
+        A reader counts itself, in its thread's stripe of counters, under
+        the current epoch, which is 0 or 1, and then loads the snapshot.
+        After it publishes a snapshot, the writer flips the epoch and waits
+        for the old epoch's counts to fall to 0, twice, so that it waits
+        for both epochs' readers; the flips keep new readers out of the
+        counts it waits for, so the waits end even under a steady stream
+        of reads.  A reader that was counted after a wait loads the new
+        snapshot. */
+    template<typename C>
+    struct rcu_container
+    {
+        using container_type = C;
+        using view_type = rcu_view<C>;
+
+        /** Publishes `c` as the first snapshot. */
+        explicit rcu_container(C c = C()) :
+            current_(new C(std::move(c))), epoch_(0)
+        {}
+        rcu_container(rcu_container const &) = delete;
+        rcu_container & operator=(rcu_container const &) = delete;
+        /** \pre There are no views of the container. */
+        ~rcu_container() { delete current_.load(std::memory_order_relaxed); }
+
+        /** Returns a view of the current snapshot, which pins it until the
+            view is destroyed. */
+        view_type read() const noexcept
+        {
+            auto & stripe = stripes_[v1_dtl::rcu_this_stripe()];
+            std::atomic<long> * const readers =
+                &stripe.readers[epoch_.load()];
+            readers->fetch_add(1);
+            return view_type(current_.load(), readers);
+        }
+
+        /** Copies the current snapshot, calls `f` on the copy, publishes
+            it, and waits until no reader has a view of the old snapshot to
+            destroy it.  If `f` throws, nothing is published. */
+        template<typename F>
+        void update(F f)
+        {
+            std::lock_guard<std::mutex> lock(writer_mutex_);
+            std::unique_ptr<C> next(
+                new C(*current_.load(std::memory_order_relaxed)));
+            f(*next);
+            publish(std::move(next));
+        }
+
+        /** Publishes `c` as the new snapshot, and waits until no reader
+            has a view of the old snapshot to destroy it. */
+        void store(C c)
+        {
+            std::unique_ptr<C> next(new C(std::move(c)));
+            std::lock_guard<std::mutex> lock(writer_mutex_);
+            publish(std::move(next));
+        }
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+    private:
+        void publish(std::unique_ptr<C> next) noexcept
+        {
+            std::unique_ptr<C const> const old(
+                current_.exchange(next.release()));
+            for (int i = 0; i < 2; ++i) {
+                unsigned int const epoch = epoch_.load();
+                epoch_.store(epoch ^ 1u);
+                for (auto & stripe : stripes_) {
+                    while (stripe.readers[epoch].load() != 0) {
+                        std::this_thread::yield();
+                    }
+                }
+            }
+        }
+
+        std::atomic<C const *> current_;
+        std::atomic<unsigned int> epoch_;
+        mutable v1_dtl::rcu_stripe stripes_[v1_dtl::rcu_stripes];
+        std::mutex writer_mutex_;
+#endif
+    };
+
+}}}
+
+#endif
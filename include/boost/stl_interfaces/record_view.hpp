@@ -0,0 +1,272 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_RECORD_VIEW_HPP
+#define BOOST_STL_INTERFACES_RECORD_VIEW_HPP
+
+#include <boost/stl_interfaces/iterator_interface.hpp>
+#include <boost/stl_interfaces/view_interface.hpp>
+
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+    //[ record_span_defn
+    // The bytes of one record, in the buffer the record was parsed from.
+    struct record_span : view_interface<record_span, element_layout::contiguous>
+    {
+        record_span() noexcept : first_(nullptr), last_(nullptr) {}
+        record_span(unsigned char const * first, std::size_t size) noexcept :
+            first_(first),
+            last_(first + size)
+        {}
+
+        unsigned char const * begin() const noexcept { return first_; }
+        unsigned char const * end() const noexcept { return last_; }
+
+        // A copy of the bytes, for when one is needed after all.
+        std::string str() const
+        {
+            return std::string(reinterpret_cast<char const *>(first_), size());
+        }
+        std::size_t size() const noexcept
+        {
+            return std::size_t(last_ - first_);
+        }
+
+    private:
+        unsigned char const * first_;
+        unsigned char const * last_;
+    };
+    //]
+
+    // A buffer of records is a sequence of (length, bytes) pairs: a Length in
+    // native byte order, at any alignment, and then that many bytes.  A record
+    // that runs off the end of the buffer is not part of the sequence.
+    template<typename Length>
+    struct record_format
+    {
+        static_assert(
+            std::is_unsigned<Length>::value,
+            "Length must be an unsigned type.");
+
+        static constexpr std::size_t prefix_size = sizeof(Length);
+
+        static std::size_t length(unsigned char const * p) noexcept
+        {
+            Length retval;
+            std::memcpy(&retval, p, sizeof(Length));
+            return retval;
+        }
+        // Returns p if a whole record starts at p, and last otherwise.
+        static unsigned char const *
+        settle(unsigned char const * p, unsigned char const * last) noexcept
+        {
+            auto const left = std::size_t(last - p);
+            return left < prefix_size || left - prefix_size < length(p) ? last
+                                                                        : p;
+        }
+        static unsigned char const *
+        next(unsigned char const * p, unsigned char const * last) noexcept
+        {
+            return settle(p + prefix_size + length(p), last);
+        }
+        static record_span get(unsigned char const * p) noexcept
+        {
+            return record_span(p + prefix_size, length(p));
+        }
+    };
+
+    //[ record_iterator
+    // A forward iterator over the records in a buffer, each a record_span of
+    // its bytes.  Nothing is copied; incrementing the iterator reads the length
+    // of the current record, and skips over it.
+    template<typename Length>
+    struct record_iterator : proxy_iterator_interface<
+                                 record_iterator<Length>,
+                                 std::forward_iterator_tag,
+                                 record_span>
+    {
+        using format = record_format<Length>;
+
+        record_iterator() noexcept : p_(nullptr), last_(nullptr) {}
+        record_iterator(
+            unsigned char const * p, unsigned char const * last) noexcept :
+            p_(format::settle(p, last)),
+            last_(last)
+        {}
+
+        record_span operator*() const noexcept { return format::get(p_); }
+        record_iterator & operator++() noexcept
+        {
+            p_ = format::next(p_, last_);
+            return *this;
+        }
+        friend bool
+        operator==(record_iterator lhs, record_iterator rhs) noexcept
+        {
+            return lhs.p_ == rhs.p_;
+        }
+
+        // The start of the current record's length prefix.
+        unsigned char const * position() const noexcept { return p_; }
+
+        using base_type = proxy_iterator_interface<
+            record_iterator<Length>,
+            std::forward_iterator_tag,
+            record_span>;
+        using base_type::operator++;
+
+    private:
+        unsigned char const * p_;
+        unsigned char const * last_;
+    };
+    //]
+
+    //[ indexed_record_iterator
+    // A random access iterator over the records in a buffer, through a table of
+    // the offsets of the records' length prefixes.
+    template<typename Length>
+    struct indexed_record_iterator
+        : proxy_iterator_interface<
+              indexed_record_iterator<Length>,
+              std::random_access_iterator_tag,
+              record_span>
+    {
+        indexed_record_iterator() noexcept : buffer_(nullptr), offset_(nullptr)
+        {}
+        indexed_record_iterator(
+            unsigned char const * buffer, std::size_t const * offset) noexcept :
+            buffer_(buffer),
+            offset_(offset)
+        {}
+
+        record_span operator*() const noexcept
+        {
+            return record_format<Length>::get(buffer_ + *offset_);
+        }
+        indexed_record_iterator & operator+=(std::ptrdiff_t n) noexcept
+        {
+            offset_ += n;
+            return *this;
+        }
+        friend std::ptrdiff_t operator-(
+            indexed_record_iterator lhs, indexed_record_iterator rhs) noexcept
+        {
+            return lhs.offset_ - rhs.offset_;
+        }
+
+    private:
+        unsigned char const * buffer_;
+        std::size_t const * offset_;
+    };
+    //]
+
+    template<typename Length>
+    struct indexed_record_view;
+
+    //[ record_view_defn
+    // The records in a buffer of length-prefixed records, which the view does
+    // not own.  The view is a forward range; indexed() makes a random access
+    // view of the same records.
+    template<typename Length = std::uint32_t>
+    struct record_view : view_interface<record_view<Length>>
+    {
+        using iterator = record_iterator<Length>;
+
+        record_view() noexcept : first_(nullptr), last_(nullptr) {}
+        record_view(void const * buffer, std::size_t size) noexcept :
+            first_(static_cast<unsigned char const *>(buffer)),
+            last_(first_ + size)
+        {}
+
+        iterator begin() const noexcept { return iterator(first_, last_); }
+        iterator end() const noexcept { return iterator(last_, last_); }
+
+        // The bytes after the last whole record: the start of a record that is
+        // not all in the buffer yet, when reading a stream.  This walks all the
+        // records.
+        record_span remainder() const noexcept
+        {
+            using format = record_format<Length>;
+            auto p = first_;
+            while (format::settle(p, last_) != last_) {
+                p += format::prefix_size + format::length(p);
+            }
+            return record_span(p, std::size_t(last_ - p));
+        }
+
+        indexed_record_view<Length> indexed() const
+        {
+            return indexed_record_view<Length>(*this);
+        }
+
+        // The start of the buffer.
+        unsigned char const * buffer() const noexcept { return first_; }
+
+    private:
+        unsigned char const * first_;
+        unsigned char const * last_;
+    };
+    //]
+
+    //[ indexed_record_view_defn
+    // The records of a record_view, as a random access range.  The table of the
+    // records' offsets is built by the first call to begin() or end(), with one
+    // pass over the records; until then, the view costs nothing.  Like the
+    // cached views in cached_view_interface.hpp, it has non-const begin() and
+    // end() for that reason.
+    template<typename Length>
+    struct indexed_record_view : view_interface<indexed_record_view<Length>>
+    {
+        using iterator = indexed_record_iterator<Length>;
+
+        indexed_record_view() : built_(false) {}
+        explicit indexed_record_view(record_view<Length> records) :
+            records_(records),
+            built_(false)
+        {}
+
+        iterator begin() { return iterator(buffer(), index().data()); }
+        iterator end()
+        {
+            auto const & offsets = index();
+            return iterator(buffer(), offsets.data() + offsets.size());
+        }
+
+        // The offsets of the records' length prefixes in the buffer.
+        std::vector<std::size_t> const & index()
+        {
+            if (!built_) {
+                for (auto it = records_.begin(); it != records_.end(); ++it) {
+                    offsets_.push_back(std::size_t(it.position() - buffer()));
+                }
+                built_ = true;
+            }
+            return offsets_;
+        }
+
+    private:
+        unsigned char const * buffer() const noexcept
+        {
+            return records_.buffer();
+        }
+
+        record_view<Length> records_;
+        std::vector<std::size_t> offsets_;
+        bool built_;
+    };
+    //]
+
+}}}
+
+#endif
@@ -58,13 +58,16 @@ namespace boost { namespace stl_interfaces { inline namespace v1 {
 
     /** This type is very similar to the C++20 version of
         `std::reverse_iterator`; it is `constexpr`-, `noexcept`-, and
-        proxy-friendly. */
+        proxy-friendly.  It holds only a `BidiIter`, and is trivially
+        copyable and standard layout whenever `BidiIter` is. */
     template<typename BidiIter>
     struct reverse_iterator
         : iterator_interface<
               reverse_iterator<BidiIter>,
 #if 201703L < __cplusplus && defined(__cpp_lib_ranges)
-              typename std::iterator_traits<BidiIter>::iterator_concept,
+              // Reversing a contiguous range does not produce one.
+              detail::concept_category_t<
+                  typename std::iterator_traits<BidiIter>::iterator_concept>,
 #else
               typename std::iterator_traits<BidiIter>::iterator_category,
 #endif
@@ -82,10 +85,14 @@ namespace boost { namespace stl_interfaces { inline namespace v1 {
             typename BidiIter2,
             typename E = std::enable_if_t<
                 std::is_convertible<BidiIter2, BidiIter>::value>>
-        reverse_iterator(reverse_iterator<BidiIter2> const & it) : it_(it.it_)
+        constexpr reverse_iterator(
+            reverse_iterator<BidiIter2> const & it) noexcept(noexcept(BidiIter(
+            std::declval<BidiIter2 const &>()))) :
+            it_(it.it_)
         {}
 
-        friend BOOST_STL_INTERFACES_HIDDEN_FRIEND_CONSTEXPR auto
+#ifndef BOOST_STL_INTERFACES_NO_HIDDEN_FRIEND_CONSTEXPR
+        friend constexpr auto
         operator-(reverse_iterator lhs, reverse_iterator rhs) noexcept(
             noexcept(v1_dtl::ce_dist(
                 lhs.it_,
@@ -97,6 +104,7 @@ namespace boost { namespace stl_interfaces { inline namespace v1 {
                 lhs.it_,
                 typename std::iterator_traits<BidiIter>::iterator_category{});
         }
+#endif
 
         constexpr typename std::iterator_traits<BidiIter>::reference
         operator*() const noexcept(
@@ -138,6 +146,22 @@ namespace boost { namespace stl_interfaces { inline namespace v1 {
         BidiIter it_;
     };
 
+#ifdef BOOST_STL_INTERFACES_NO_HIDDEN_FRIEND_CONSTEXPR
+    template<typename BidiIter>
+    constexpr auto operator-(
+        reverse_iterator<BidiIter> lhs,
+        reverse_iterator<BidiIter> rhs) noexcept(noexcept(v1_dtl::ce_dist(
+        lhs.base(),
+        rhs.base(),
+        typename std::iterator_traits<BidiIter>::iterator_category{})))
+    {
+        return -v1_dtl::ce_dist(
+            rhs.base(),
+            lhs.base(),
+            typename std::iterator_traits<BidiIter>::iterator_category{});
+    }
+#endif
+
     template<typename BidiIter>
     constexpr auto operator==(
         reverse_iterator<BidiIter> lhs,
@@ -166,10 +190,124 @@ namespace boost { namespace stl_interfaces { inline namespace v1 {
         return reverse_iterator<BidiIter>(it);
     }
 
+    /** A bidirectional reverse iterator, like `reverse_iterator`, that
+        keeps the iterator before its base once it has decremented to it.
+
+        `reverse_iterator` decrements a copy of its base on every
+        dereference, and its base again on every increment, so a loop that
+        dereferences each element once decrements twice per element.  When
+        decrementing is expensive -- as for a `filter_iterator`, which
+        re-tests its predicate backward until it finds a match -- that is
+        twice the work.  A `cached_reverse_iterator` decrements a copy on
+        its first dereference, keeps it, and moves its base there on the
+        next increment; a decrement moves its base forward, and keeps the
+        old base.  So each step decrements once, however often the element
+        is dereferenced.
+
+        Use `reverse_iterator` when decrementing is cheap, as for pointers
+        and random access iterators, or when the iterator is dereferenced
+        by more than one thread at a time: the cache is updated by
+        `operator*()`, which is `const`.  A `cached_reverse_iterator` is
+        also twice the size of its base, and is only bidirectional. */
+    template<typename BidiIter>
+    struct cached_reverse_iterator
+        : iterator_interface<
+              cached_reverse_iterator<BidiIter>,
+              std::bidirectional_iterator_tag,
+              typename std::iterator_traits<BidiIter>::value_type,
+              typename std::iterator_traits<BidiIter>::reference,
+              typename std::iterator_traits<BidiIter>::pointer,
+              typename std::iterator_traits<BidiIter>::difference_type>
+    {
+        using reference = typename std::iterator_traits<BidiIter>::reference;
+
+        constexpr cached_reverse_iterator() noexcept(
+            noexcept(BidiIter())) :
+            it_(), prev_(), cached_(false)
+        {}
+        constexpr cached_reverse_iterator(BidiIter it) noexcept(
+            noexcept(BidiIter(it))) :
+            it_(it), prev_(it), cached_(false)
+        {}
+        template<
+            typename BidiIter2,
+            typename E = std::enable_if_t<
+                std::is_convertible<BidiIter2, BidiIter>::value>>
+        cached_reverse_iterator(
+            cached_reverse_iterator<BidiIter2> const & it) :
+            it_(it.it_), prev_(it.prev_), cached_(it.cached_)
+        {}
+
+        constexpr reference operator*() const
+        {
+            if (!cached_) {
+                prev_ = v1_dtl::ce_prev(it_);
+                cached_ = true;
+            }
+            return *prev_;
+        }
+        constexpr cached_reverse_iterator & operator++()
+        {
+            if (cached_)
+                it_ = prev_;
+            else
+                --it_;
+            cached_ = false;
+            return *this;
+        }
+        constexpr cached_reverse_iterator & operator--()
+        {
+            prev_ = it_;
+            ++it_;
+            cached_ = true;
+            return *this;
+        }
+
+        constexpr BidiIter base() const noexcept { return it_; }
+
+        using base_type = iterator_interface<
+            cached_reverse_iterator<BidiIter>,
+            std::bidirectional_iterator_tag,
+            typename std::iterator_traits<BidiIter>::value_type,
+            reference,
+            typename std::iterator_traits<BidiIter>::pointer,
+            typename std::iterator_traits<BidiIter>::difference_type>;
+        using base_type::operator++;
+        using base_type::operator--;
+
+    private:
+        template<typename BidiIter2>
+        friend struct cached_reverse_iterator;
+
+        BidiIter it_;
+        mutable BidiIter prev_;
+        mutable bool cached_;
+    };
+
+    template<typename BidiIter1, typename BidiIter2>
+    constexpr auto operator==(
+        cached_reverse_iterator<BidiIter1> lhs,
+        cached_reverse_iterator<BidiIter2>
+            rhs) noexcept(noexcept(lhs.base() == rhs.base()))
+        -> decltype(rhs.base() == lhs.base())
+    {
+        return lhs.base() == rhs.base();
+    }
+
+    /** Makes a `cached_reverse_iterator<BidiIter>` from an iterator of type
+        `BidiIter`. */
+    template<typename BidiIter>
+    auto make_cached_reverse_iterator(BidiIter it)
+    {
+        return cached_reverse_iterator<BidiIter>(it);
+    }
+
 }}}
 
 
-#if 201703L < __cplusplus && defined(__cpp_lib_concepts) || BOOST_STL_INTERFACES_DOXYGEN
+#if 201703L < __cplusplus && defined(__cpp_lib_concepts) &&                    \
+        !defined(BOOST_STL_INTERFACES_DISABLE_V2) ||                           \
+    BOOST_STL_INTERFACES_DOXYGEN
 
 namespace boost { namespace stl_interfaces { namespace v2 {
 
@@ -0,0 +1,706 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_ROPE_HPP
+#define BOOST_STL_INTERFACES_ROPE_HPP
+
+#include <boost/stl_interfaces/container_interface.hpp>
+#include <boost/stl_interfaces/reverse_iterator.hpp>
+#include <boost/stl_interfaces/segmented_iterator.hpp>
+#include <boost/stl_interfaces/detail/relocate.hpp>
+
+#include <algorithm>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#include <cstddef>
+#include <cstdint>
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+    //[ rope_node
+    // A leaf of a rope: up to LeafSize elements, in order.  The leaves are the
+    // nodes of a treap -- a binary tree that is in order by position, and a
+    // heap by a random priority, which keeps it balanced with high probability
+    // -- and each one records how many elements its subtree holds, so that the
+    // leaf holding element i is found by one descent from the root.  The leaves
+    // are also linked in order, for iteration.
+    template<typename T, std::size_t LeafSize>
+    struct rope_node
+    {
+        rope_node * left = nullptr;
+        rope_node * right = nullptr;
+        rope_node * parent = nullptr;
+        rope_node * prev = nullptr;
+        rope_node * next = nullptr;
+        std::uint64_t priority = 0;
+        std::size_t total = 0; // The elements in this subtree.
+        std::size_t size = 0;  // The elements in this leaf.
+        alignas(T) unsigned char buf[LeafSize * sizeof(T)];
+
+        T * elements() noexcept { return reinterpret_cast<T *>(buf); }
+    };
+
+    template<typename Node>
+    std::size_t rope_total(Node const * t) noexcept
+    {
+        return t ? t->total : 0;
+    }
+
+    // Returns the leaf that holds element i of the subtree t, and makes i the
+    // index within that leaf.  Expects i < t->total.
+    template<typename Node>
+    Node * rope_locate(Node * t, std::size_t & i) noexcept
+    {
+        for (;;) {
+            auto const left_total = rope_total(t->left);
+            if (i < left_total) {
+                t = t->left;
+                continue;
+            }
+            i -= left_total;
+            if (i < t->size)
+                return t;
+            i -= t->size;
+            t = t->right;
+        }
+    }
+
+    // Returns the index of the first element of the leaf n.
+    template<typename Node>
+    std::size_t rope_start(Node const * n) noexcept
+    {
+        std::size_t retval = rope_total(n->left);
+        for (; n->parent; n = n->parent) {
+            if (n == n->parent->right)
+                retval += rope_total(n->parent->left) + n->parent->size;
+        }
+        return retval;
+    }
+    //]
+
+    //[ rope_iterator
+    // An iterator over the leaves of a rope, in order.  These are the segments
+    // of a rope_iterator.
+    template<typename Node>
+    struct rope_leaf_iterator : iterator_interface<
+                                    rope_leaf_iterator<Node>,
+                                    std::forward_iterator_tag,
+                                    Node>
+    {
+        rope_leaf_iterator() noexcept : leaf_(nullptr) {}
+        explicit rope_leaf_iterator(Node * leaf) noexcept : leaf_(leaf) {}
+
+        Node & operator*() const noexcept { return *leaf_; }
+        rope_leaf_iterator & operator++() noexcept
+        {
+            leaf_ = leaf_->next;
+            return *this;
+        }
+        friend bool
+        operator==(rope_leaf_iterator lhs, rope_leaf_iterator rhs) noexcept
+        {
+            return lhs.leaf_ == rhs.leaf_;
+        }
+
+        using base_type = iterator_interface<
+            rope_leaf_iterator<Node>,
+            std::forward_iterator_tag,
+            Node>;
+        using base_type::operator++;
+
+    private:
+        Node * leaf_;
+    };
+
+    // An iterator over the elements of a rope: the root of the tree, the leaf
+    // and the position within it, and the index in the whole rope.  Steps that
+    // stay within a leaf, or go on to the leaf before or after, follow the
+    // links between leaves; any other jump descends from the root again, so
+    // operator+=() takes O(log n) time.  The end iterator is one past the last
+    // element of the last leaf.
+    //
+    // It also models the segmented iterator protocol, with the leaves as the
+    // segments and pointers as the local iterators.
+    template<typename T, std::size_t LeafSize>
+    struct rope_iterator : iterator_interface<
+                               rope_iterator<T, LeafSize>,
+                               std::random_access_iterator_tag,
+                               std::remove_const_t<T>>
+    {
+        using node = rope_node<std::remove_const_t<T>, LeafSize>;
+
+        rope_iterator() noexcept :
+            root_(nullptr), leaf_(nullptr), local_(0), index_(0)
+        {}
+        rope_iterator(
+            node * root,
+            node * leaf,
+            std::ptrdiff_t local,
+            std::ptrdiff_t index) noexcept :
+            root_(root), leaf_(leaf), local_(local), index_(index)
+        {}
+        template<
+            typename U,
+            typename E = std::enable_if_t<
+                std::is_same<T, U const>::value && !std::is_same<T, U>::value>>
+        rope_iterator(rope_iterator<U, LeafSize> other) noexcept :
+            root_(other.root_),
+            leaf_(other.leaf_),
+            local_(other.local_),
+            index_(other.index_)
+        {}
+
+        T & operator*() const noexcept { return leaf_->elements()[local_]; }
+        rope_iterator & operator+=(std::ptrdiff_t n) noexcept
+        {
+            if (!n)
+                return *this;
+            index_ += n;
+            auto const size = std::ptrdiff_t(leaf_->size);
+            auto const i = local_ + n;
+            if (0 <= i && (i < size || (i == size && !leaf_->next))) {
+                local_ = i;
+            } else if (
+                size <= i && leaf_->next &&
+                i - size < std::ptrdiff_t(leaf_->next->size)) {
+                leaf_ = leaf_->next;
+                local_ = i - size;
+            } else if (
+                i < 0 && leaf_->prev &&
+                0 <= i + std::ptrdiff_t(leaf_->prev->size)) {
+                leaf_ = leaf_->prev;
+                local_ = i + std::ptrdiff_t(leaf_->size);
+            } else {
+                seek();
+            }
+            return *this;
+        }
+        friend std::ptrdiff_t
+        operator-(rope_iterator lhs, rope_iterator rhs) noexcept
+        {
+            return lhs.index_ - rhs.index_;
+        }
+
+    private:
+        template<typename U, std::size_t N>
+        friend struct rope_iterator;
+        friend access;
+
+        using local_iterator = T *;
+
+        void seek() noexcept
+        {
+            if (index_ == std::ptrdiff_t(root_->total)) {
+                leaf_ = root_;
+                while (leaf_->right) {
+                    leaf_ = leaf_->right;
+                }
+                local_ = leaf_->size;
+                return;
+            }
+            auto i = std::size_t(index_);
+            leaf_ = rope_locate(root_, i);
+            local_ = i;
+        }
+
+        rope_leaf_iterator<node> segment() const noexcept
+        {
+            return rope_leaf_iterator<node>(leaf_);
+        }
+        local_iterator local() const noexcept
+        {
+            return leaf_ ? leaf_->elements() + local_ : nullptr;
+        }
+        local_iterator local_begin(rope_leaf_iterator<node> seg) const noexcept
+        {
+            return (*seg).elements();
+        }
+        local_iterator local_end(rope_leaf_iterator<node> seg) const noexcept
+        {
+            return (*seg).elements() + (*seg).size;
+        }
+        rope_iterator
+        compose(rope_leaf_iterator<node> seg, local_iterator it) const noexcept
+        {
+            node & leaf = *seg;
+            auto const local = it - leaf.elements();
+            return rope_iterator(
+                root_, &leaf, local, std::ptrdiff_t(rope_start(&leaf)) + local);
+        }
+
+        node * root_;
+        node * leaf_;
+        std::ptrdiff_t local_;
+        std::ptrdiff_t index_;
+    };
+    //]
+
+    template<typename T, std::size_t LeafSize>
+    struct rope;
+
+    // rope destroys its elements itself, as it frees its leaves.
+    template<typename T, std::size_t LeafSize>
+    struct trivially_destructible_container<rope<T, LeafSize>>
+        : std::true_type
+    {};
+
+    //[ rope_defn
+    // A sequence container for long sequences that are edited in the middle,
+    // like the text of a document.  Its elements are in leaves of up to
+    // LeafSize elements each, which are kept in a balanced tree.  Inserting or
+    // erasing k elements anywhere moves at most a leaf's worth of the existing
+    // elements, and takes O(k + log n) time, where std::vector would move
+    // everything after the insertion point; the price is that indexing takes
+    // O(log n) time too, instead of O(1).  Iteration is as fast as over a
+    // std::deque, and the segmented_*() algorithms go a leaf at a time, with
+    // pointers.
+    //
+    // Inserting and erasing invalidate all iterators; appending invalidates
+    // only end().  [first, last) must not be part of *this in insert().
+    template<typename T, std::size_t LeafSize = 512>
+    struct rope : container_interface<rope<T, LeafSize>>
+    {
+        static_assert(0 < LeafSize, "");
+
+        // types
+        using value_type = T;
+        using reference = T &;
+        using const_reference = T const &;
+        using iterator = rope_iterator<T, LeafSize>;
+        using const_iterator = rope_iterator<T const, LeafSize>;
+        using reverse_iterator = stl_interfaces::reverse_iterator<iterator>;
+        using const_reverse_iterator =
+            stl_interfaces::reverse_iterator<const_iterator>;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+
+        static constexpr size_type leaf_size = LeafSize;
+
+        // construct/copy/destroy (9 members, skipped 2)
+        rope() noexcept :
+            root_(nullptr),
+            first_(nullptr),
+            last_(nullptr),
+            seed_(0x9e3779b97f4a7c15ull)
+        {}
+        explicit rope(size_type n) : rope()
+        {
+            for (size_type i = 0; i < n; ++i) {
+                emplace_back();
+            }
+        }
+        template<
+            typename InputIterator,
+            typename Enable = std::enable_if_t<std::is_convertible<
+                typename std::iterator_traits<InputIterator>::iterator_category,
+                std::input_iterator_tag>::value>>
+        rope(InputIterator first, InputIterator last) : rope()
+        {
+            for (; first != last; ++first) {
+                emplace_back(*first);
+            }
+        }
+        rope(std::initializer_list<T> il) : rope(il.begin(), il.end()) {}
+        rope(rope const & other) : rope()
+        {
+            insert_n(0, other.begin(), other.end(), other.size());
+        }
+        rope(rope && other) noexcept : rope() { swap(other); }
+        rope & operator=(rope const & other)
+        {
+            if (this != &other) {
+                rope temp(other);
+                swap(temp);
+            }
+            return *this;
+        }
+        rope & operator=(rope && other) noexcept
+        {
+            rope temp(std::move(other));
+            swap(temp);
+            return *this;
+        }
+        ~rope() { clear(); }
+
+        // iterators (2 members, skipped 10)
+        iterator begin() noexcept { return iterator(root_, first_, 0, 0); }
+        iterator end() noexcept
+        {
+            return iterator(
+                root_, last_, last_ ? last_->size : 0, difference_type(size()));
+        }
+
+        // capacity (3 members, skipped 5)
+        size_type size() const noexcept { return rope_total(root_); }
+        size_type max_size() const noexcept
+        {
+            return (std::numeric_limits<difference_type>::max)() / sizeof(T);
+        }
+
+        // modifiers (5 members, skipped 10)
+        template<typename... Args>
+        reference emplace_back(Args &&... args)
+        {
+            node * leaf = last_;
+            if (!leaf || leaf->size == LeafSize) {
+                leaf = new node;
+                leaf->priority = next_priority();
+                link_after(last_, leaf);
+                root_ = insert_node(root_, leaf, size());
+                root_->parent = nullptr;
+            }
+            T * const p = leaf->elements() + leaf->size;
+            try {
+                ::new (static_cast<void *>(p)) T(std::forward<Args>(args)...);
+            } catch (...) {
+                if (!leaf->size)
+                    remove_leaf(leaf);
+                throw;
+            }
+            ++leaf->size;
+            add_total(leaf, 1);
+            return *p;
+        }
+        template<typename... Args>
+        iterator emplace(const_iterator pos, Args &&... args)
+        {
+            auto const i = size_type(pos - this->cbegin());
+            // args may refer to an element that is about to move.
+            T x(std::forward<Args>(args)...);
+            auto const first = std::make_move_iterator(&x);
+            insert_n(i, first, first + 1, 1);
+            return begin() + i;
+        }
+        template<
+            typename ForwardIterator,
+            typename Enable = std::enable_if_t<std::is_convertible<
+                typename std::iterator_traits<
+                    ForwardIterator>::iterator_category,
+                std::forward_iterator_tag>::value>>
+        iterator
+        insert(const_iterator pos, ForwardIterator first, ForwardIterator last)
+        {
+            auto const i = size_type(pos - this->cbegin());
+            insert_n(i, first, last, size_type(std::distance(first, last)));
+            return begin() + i;
+        }
+        iterator erase(const_iterator f, const_iterator l) noexcept
+        {
+            auto const i = size_type(f - this->cbegin());
+            auto n = size_type(l - f);
+            while (n) {
+                auto k = i;
+                node * const leaf = rope_locate(root_, k);
+                auto const m = (std::min)(n, leaf->size - k);
+                n -= m;
+                T * const elements = leaf->elements();
+                detail::destroy(
+                    elements + k, elements + k + m);
+                if (m == leaf->size) {
+                    leaf->size = 0;
+                    remove_leaf(leaf, m);
+                    continue;
+                }
+                stl_interfaces::uninitialized_relocate(
+                    elements + k + m, elements + leaf->size, elements + k);
+                leaf->size -= m;
+                add_total(leaf, -difference_type(m));
+                merge_small(leaf);
+            }
+            return begin() + i;
+        }
+        void clear() noexcept
+        {
+            for (node * leaf = first_; leaf;) {
+                node * const next = leaf->next;
+                detail::destroy(
+                    leaf->elements(), leaf->elements() + leaf->size);
+                delete leaf;
+                leaf = next;
+            }
+            root_ = first_ = last_ = nullptr;
+        }
+        void swap(rope & other) noexcept
+        {
+            std::swap(root_, other.root_);
+            std::swap(first_, other.first_);
+            std::swap(last_, other.last_);
+            std::swap(seed_, other.seed_);
+        }
+        friend void swap(rope & lhs, rope & rhs) noexcept { lhs.swap(rhs); }
+
+        // The number of leaves.
+        size_type leaf_count() const noexcept
+        {
+            size_type retval = 0;
+            for (node * leaf = first_; leaf; leaf = leaf->next) {
+                ++retval;
+            }
+            return retval;
+        }
+        // The height of the tree of leaves; O(log n) with high probability.
+        size_type height() const noexcept { return height(root_); }
+
+        using base_type = container_interface<rope<T, LeafSize>>;
+        using base_type::begin;
+        using base_type::end;
+        using base_type::erase;
+        using base_type::insert;
+
+    private:
+        using node = rope_node<T, LeafSize>;
+
+        std::uint64_t next_priority() noexcept
+        {
+            // xorshift64*.
+            seed_ ^= seed_ >> 12;
+            seed_ ^= seed_ << 25;
+            seed_ ^= seed_ >> 27;
+            return seed_ * 0x2545f4914f6cdd1dull;
+        }
+
+        static void update(node * t) noexcept
+        {
+            t->total = rope_total(t->left) + t->size + rope_total(t->right);
+            if (t->left)
+                t->left->parent = t;
+            if (t->right)
+                t->right->parent = t;
+        }
+        static void add_total(node * n, difference_type delta) noexcept
+        {
+            for (; n; n = n->parent) {
+                n->total += delta;
+            }
+        }
+
+        // Splits t into the leaves before element pos and those after it; pos
+        // must be the first element of a leaf, or size().
+        static void split(
+            node * t, size_type pos, node *& l, node *& r) noexcept
+        {
+            if (!t) {
+                l = r = nullptr;
+                return;
+            }
+            auto const left_total = rope_total(t->left);
+            if (pos <= left_total) {
+                split(t->left, pos, l, t->left);
+                update(t);
+                r = t;
+            } else {
+                split(t->right, pos - left_total - t->size, t->right, r);
+                update(t);
+                l = t;
+            }
+        }
+        static node * merge(node * l, node * r) noexcept
+        {
+            if (!l)
+                return r;
+            if (!r)
+                return l;
+            if (r->priority < l->priority) {
+                l->right = merge(l->right, r);
+                update(l);
+                return l;
+            }
+            r->left = merge(l, r->left);
+            update(r);
+            return r;
+        }
+        // Inserts the leaf n so that pos elements precede it.
+        static node * insert_node(node * t, node * n, size_type pos) noexcept
+        {
+            if (!t) {
+                n->left = n->right = nullptr;
+                update(n);
+                return n;
+            }
+            if (t->priority < n->priority) {
+                split(t, pos, n->left, n->right);
+                update(n);
+                return n;
+            }
+            auto const left_total = rope_total(t->left);
+            if (pos <= left_total)
+                t->left = insert_node(t->left, n, pos);
+            else
+                t->right = insert_node(t->right, n, pos - left_total - t->size);
+            update(t);
+            return t;
+        }
+
+        // Links the leaf n into the list after prev, or first if prev is null.
+        void link_after(node * prev, node * n) noexcept
+        {
+            n->prev = prev;
+            n->next = prev ? prev->next : first_;
+            (n->next ? n->next->prev : last_) = n;
+            (prev ? prev->next : first_) = n;
+        }
+        // Takes the empty leaf n out of the tree and the list, and frees it;
+        // its subtree's totals still count the removed elements it held.
+        void remove_leaf(node * n, size_type removed = 0) noexcept
+        {
+            node * const children = merge(n->left, n->right);
+            node * const parent = n->parent;
+            if (children)
+                children->parent = parent;
+            if (!parent)
+                root_ = children;
+            else if (parent->left == n)
+                parent->left = children;
+            else
+                parent->right = children;
+            add_total(parent, -difference_type(removed));
+            (n->prev ? n->prev->next : first_) = n->next;
+            (n->next ? n->next->prev : last_) = n->prev;
+            delete n;
+        }
+
+        // Keeps leaves from getting too small to be worth a node: a leaf under
+        // a quarter full takes on the elements of a neighbor they both fit in.
+        void merge_small(node * leaf) noexcept
+        {
+            if (LeafSize / 4 <= leaf->size)
+                return;
+            node * a = leaf->prev;
+            node * b = leaf;
+            if (!a || LeafSize < a->size + b->size) {
+                a = leaf;
+                b = leaf->next;
+                if (!b || LeafSize < a->size + b->size)
+                    return;
+            }
+            auto const moved = b->size;
+            stl_interfaces::uninitialized_relocate(
+                b->elements(), b->elements() + moved, a->elements() + a->size);
+            b->size = 0;
+            add_total(b, -difference_type(moved));
+            remove_leaf(b);
+            a->size += moved;
+            add_total(a, moved);
+        }
+
+        // Inserts the n elements of [first, last) before element i.  If they
+        // fit in the leaf they go into, that is all; otherwise the elements of
+        // the leaf after i move to a new leaf, the new elements fill the rest
+        // of the leaf and as many new leaves as they need, and the moved
+        // elements follow them.
+        template<typename ForwardIterator>
+        void insert_n(
+            size_type i,
+            ForwardIterator first,
+            ForwardIterator last,
+            size_type n)
+        {
+            if (!n)
+                return;
+            node * leaf = last_;
+            size_type k = leaf ? leaf->size : 0;
+            if (i < size()) {
+                k = i;
+                leaf = rope_locate(root_, k);
+            }
+            if (leaf && leaf->size + n <= LeafSize) {
+                T * const elements = leaf->elements();
+                detail::gap_insert(
+                    elements + k,
+                    elements + leaf->size,
+                    first,
+                    last,
+                    difference_type(n));
+                leaf->size += n;
+                add_total(leaf, n);
+                return;
+            }
+            // Inserting at the start of a leaf appends to the one before.
+            if (leaf && !k) {
+                leaf = leaf->prev;
+                k = leaf ? leaf->size : 0;
+            }
+            if (leaf && k < leaf->size) {
+                node * const tail = new node;
+                tail->priority = next_priority();
+                tail->size = leaf->size - k;
+                stl_interfaces::uninitialized_relocate(
+                    leaf->elements() + k,
+                    leaf->elements() + leaf->size,
+                    tail->elements());
+                leaf->size = k;
+                add_total(leaf, -difference_type(tail->size));
+                link_after(leaf, tail);
+                root_ = insert_node(root_, tail, i);
+                root_->parent = nullptr;
+            }
+            if (leaf) {
+                auto const m = (std::min)(n, LeafSize - leaf->size);
+                first = fill(leaf, first, m);
+                i += m;
+                n -= m;
+            }
+            while (n) {
+                node * const next = new node;
+                next->priority = next_priority();
+                auto const m = (std::min)(n, LeafSize);
+                try {
+                    first = fill(next, first, m);
+                } catch (...) {
+                    detail::destroy(
+                        next->elements(), next->elements() + next->size);
+                    delete next;
+                    throw;
+                }
+                link_after(leaf, next);
+                root_ = insert_node(root_, next, i);
+                root_->parent = nullptr;
+                leaf = next;
+                i += m;
+                n -= m;
+            }
+        }
+        // Appends m elements from first to the leaf, and returns the iterator
+        // after the last one.  The totals count the elements appended, even if
+        // one of them throws.
+        template<typename ForwardIterator>
+        static ForwardIterator
+        fill(node * leaf, ForwardIterator first, size_type m)
+        {
+            auto const old_size = leaf->size;
+            try {
+                for (; leaf->size < old_size + m; ++first) {
+                    ::new (static_cast<void *>(leaf->elements() + leaf->size))
+                        T(*first);
+                    ++leaf->size;
+                }
+            } catch (...) {
+                add_total(leaf, leaf->size - old_size);
+                throw;
+            }
+            add_total(leaf, m);
+            return first;
+        }
+
+        static size_type height(node const * t) noexcept
+        {
+            return t ? 1 + (std::max)(height(t->left), height(t->right)) : 0;
+        }
+
+        node * root_;
+        node * first_;
+        node * last_;
+        std::uint64_t seed_;
+    };
+    //]
+
+}}}
+
+#endif
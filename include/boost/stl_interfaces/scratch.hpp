@@ -0,0 +1,168 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_SCRATCH_HPP
+#define BOOST_STL_INTERFACES_SCRATCH_HPP
+
+#include <boost/assert.hpp>
+
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <new>
+#include <vector>
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    namespace v1_dtl {
+        // A type-erased reference to a memory resource: anything with the
+        // allocate() and deallocate() members of std::pmr::memory_resource.
+        struct scratch_source
+        {
+            void * resource;
+            void * (*allocate)(void *, std::size_t, std::size_t);
+            void (*deallocate)(void *, void *, std::size_t, std::size_t);
+        };
+
+        inline scratch_source const *& current_scratch() noexcept
+        {
+            thread_local scratch_source const * source = nullptr;
+            return source;
+        }
+
+        template<typename Resource>
+        void * scratch_allocate(
+            void * resource, std::size_t bytes, std::size_t alignment)
+        {
+            return static_cast<Resource *>(resource)->allocate(
+                bytes, alignment);
+        }
+        template<typename Resource>
+        void scratch_deallocate(
+            void * resource,
+            void * p,
+            std::size_t bytes,
+            std::size_t alignment)
+        {
+            static_cast<Resource *>(resource)->deallocate(p, bytes, alignment);
+        }
+    }
+
+#endif
+
+    /** Makes `resource` the source of the scratch memory of the library's
+        algorithms -- the buffers of `parallel_sort()`,
+        `parallel_sort_by_key()` and the radix sorts, the chunk sums of the
+        parallel scans and reductions, and so on -- that are called on this
+        thread, until the `scratch_scope` is destroyed.  Scopes nest; the
+        innermost one wins, and destroying it restores the one outside it.
+        Without a scope, the scratch memory comes from `operator new`.
+
+        `Resource` may be any type with the `allocate(bytes, alignment)` and
+        `deallocate(p, bytes, alignment)` members of
+        `std::pmr::memory_resource` -- including `std::pmr::memory_resource`
+        itself, so that a `std::pmr::monotonic_buffer_resource` serving a
+        request also serves the algorithms the request runs.  The resource
+        is only used by the thread that made the scope: the algorithms
+        allocate their buffers before handing work to the pool, and free
+        them before they return.  `resource` must outlive the scope, and
+        the scope must be destroyed on the thread that made it, innermost
+        first. */
+    struct scratch_scope
+    {
+        template<typename Resource>
+        explicit scratch_scope(Resource & resource) noexcept :
+            source_{std::addressof(resource),
+                    &v1_dtl::scratch_allocate<Resource>,
+                    &v1_dtl::scratch_deallocate<Resource>},
+            prev_(v1_dtl::current_scratch())
+        {
+            v1_dtl::current_scratch() = &source_;
+        }
+        ~scratch_scope()
+        {
+            BOOST_ASSERT(v1_dtl::current_scratch() == &source_);
+            v1_dtl::current_scratch() = prev_;
+        }
+        scratch_scope(scratch_scope const &) = delete;
+        scratch_scope & operator=(scratch_scope const &) = delete;
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+    private:
+        v1_dtl::scratch_source source_;
+        v1_dtl::scratch_source const * prev_;
+#endif
+    };
+
+    /** An allocator that takes its memory from the resource of the
+        innermost `scratch_scope` on the thread that constructed it, or
+        from `operator new` if there was none.  Copies, and rebound copies,
+        use the same resource, wherever they are used; so an allocator, and
+        anything it allocated, must not outlive the scope. */
+    template<typename T>
+    struct scratch_allocator
+    {
+        using value_type = T;
+
+        scratch_allocator() noexcept : source_(v1_dtl::current_scratch()) {}
+        template<typename U>
+        scratch_allocator(scratch_allocator<U> const & other) noexcept :
+            source_(other.source_)
+        {}
+
+        T * allocate(std::size_t n)
+        {
+            if (!source_)
+                return std::allocator<T>().allocate(n);
+            if ((std::numeric_limits<std::size_t>::max)() / sizeof(T) < n)
+                throw std::bad_alloc();
+            return static_cast<T *>(source_->allocate(
+                source_->resource, n * sizeof(T), alignof(T)));
+        }
+        void deallocate(T * p, std::size_t n) noexcept
+        {
+            if (!source_) {
+                std::allocator<T>().deallocate(p, n);
+                return;
+            }
+            source_->deallocate(
+                source_->resource, p, n * sizeof(T), alignof(T));
+        }
+
+        friend bool
+        operator==(scratch_allocator lhs, scratch_allocator rhs) noexcept
+        {
+            return lhs.source_ == rhs.source_;
+        }
+        friend bool
+        operator!=(scratch_allocator lhs, scratch_allocator rhs) noexcept
+        {
+            return lhs.source_ != rhs.source_;
+        }
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+    private:
+        template<typename U>
+        friend struct scratch_allocator;
+
+        v1_dtl::scratch_source const * source_;
+#endif
+    };
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    namespace v1_dtl {
+        template<typename T>
+        using scratch_vector = std::vector<T, scratch_allocator<T>>;
+    }
+
+#endif
+
+}}}
+
+#endif
@@ -0,0 +1,340 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_SEGMENTED_ITERATOR_HPP
+#define BOOST_STL_INTERFACES_SEGMENTED_ITERATOR_HPP
+
+#include <boost/stl_interfaces/iterator_interface.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <numeric>
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+    namespace v1_dtl {
+        template<typename Iter>
+        using segment_iter_t =
+            decltype(access::segment(std::declval<Iter const &>()));
+        template<typename Iter>
+        using local_iter_t =
+            decltype(access::local(std::declval<Iter const &>()));
+    }
+
+    /** Describes how an iterator over a segmented data structure (a deque,
+        a list of chunks, etc.) decomposes into an iterator over the segments
+        -- a `segment_iterator` -- and an iterator within a single segment --
+        a `local_iterator`.  This is Austern's segmented iterator protocol.
+
+        For an iterator type `Iter` that does not opt in, the only member is
+        `is_segmented_iterator`, which is `std::false_type`.  `Iter` opts in
+        by providing the const member functions below, which may be private
+        if `Iter` befriends `access`:
+
+        - `segment()`, which returns the `segment_iterator` for the segment
+          `*this` refers to;
+        - `local()`, which returns the `local_iterator` for `*this` within
+          that segment;
+        - `local_begin(seg)` and `local_end(seg)`, which return the local
+          range of the segment `seg`; and
+        - `compose(seg, it)`, which returns the `Iter` that refers to the same
+          element as the local iterator `it` in segment `seg`.
+
+        For a range `[first, last)`, `last.segment()` must be a segment for
+        which `local_begin()` is valid; an end iterator that points to the
+        end of the last segment meets this requirement.
+
+        Users may also specialize this template directly, for iterators that
+        they do not control.
+
+        \see `segmented_copy()`, `segmented_fill()`, `segmented_for_each()`,
+        `segmented_find()`, `segmented_accumulate()` */
+    template<typename Iter, typename Enable = void>
+    struct segmented_iterator_traits
+    {
+        using is_segmented_iterator = std::false_type;
+    };
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    template<typename Iter>
+    struct segmented_iterator_traits<
+        Iter,
+        v1_dtl::void_t<
+            v1_dtl::segment_iter_t<Iter>,
+            v1_dtl::local_iter_t<Iter>,
+            decltype(access::local_begin(
+                std::declval<Iter const &>(),
+                std::declval<v1_dtl::segment_iter_t<Iter>>())),
+            decltype(access::local_end(
+                std::declval<Iter const &>(),
+                std::declval<v1_dtl::segment_iter_t<Iter>>())),
+            decltype(access::compose(
+                std::declval<Iter const &>(),
+                std::declval<v1_dtl::segment_iter_t<Iter>>(),
+                std::declval<v1_dtl::local_iter_t<Iter>>()))>>
+    {
+        using is_segmented_iterator = std::true_type;
+        using iterator = Iter;
+        using segment_iterator = v1_dtl::segment_iter_t<Iter>;
+        using local_iterator = v1_dtl::local_iter_t<Iter>;
+
+        static constexpr segment_iterator segment(Iter const & it)
+        {
+            return access::segment(it);
+        }
+        static constexpr local_iterator local(Iter const & it)
+        {
+            return access::local(it);
+        }
+        static constexpr local_iterator
+        begin(Iter const & it, segment_iterator seg)
+        {
+            return access::local_begin(it, seg);
+        }
+        static constexpr local_iterator
+        end(Iter const & it, segment_iterator seg)
+        {
+            return access::local_end(it, seg);
+        }
+        static constexpr Iter
+        compose(Iter const & it, segment_iterator seg, local_iterator local)
+        {
+            return access::compose(it, seg, local);
+        }
+    };
+
+#endif
+
+    /** `std::true_type` if `Iter` models the segmented iterator protocol;
+        `std::false_type` otherwise.  \see `segmented_iterator_traits` */
+    template<typename Iter>
+    using is_segmented_iterator =
+        typename segmented_iterator_traits<Iter>::is_segmented_iterator;
+
+    namespace v1_dtl {
+        // Calls f(segment, local_first, local_last) on each segment's part of
+        // [first, last), in order, until f() returns false.
+        template<typename Iter, typename F>
+        void for_each_segment(Iter first, Iter last, F && f)
+        {
+            using traits = segmented_iterator_traits<Iter>;
+            auto seg = traits::segment(first);
+            auto const last_seg = traits::segment(last);
+            if (seg == last_seg) {
+                f(seg, traits::local(first), traits::local(last));
+                return;
+            }
+            if (!f(seg, traits::local(first), traits::end(first, seg)))
+                return;
+            for (++seg; seg != last_seg; ++seg) {
+                if (!f(seg, traits::begin(first, seg), traits::end(first, seg)))
+                    return;
+            }
+            f(last_seg, traits::begin(first, last_seg), traits::local(last));
+        }
+    }
+
+    /** Equivalent to `std::copy(first, last, out)`.  If `InputIter` is a
+        segmented iterator, each segment is copied separately, using its
+        local iterators. */
+    template<typename InputIter, typename OutputIter>
+    OutputIter segmented_copy(InputIter first, InputIter last, OutputIter out);
+
+    /** Equivalent to `std::fill(first, last, x)`.  If `ForwardIter` is a
+        segmented iterator, each segment is filled separately, using its
+        local iterators. */
+    template<typename ForwardIter, typename T>
+    void segmented_fill(ForwardIter first, ForwardIter last, T const & x);
+
+    /** Equivalent to `std::for_each(first, last, f)`.  If `InputIter` is a
+        segmented iterator, `f` is applied to each segment separately, using
+        its local iterators. */
+    template<typename InputIter, typename F>
+    F segmented_for_each(InputIter first, InputIter last, F f);
+
+    /** Equivalent to `std::find(first, last, x)`.  If `InputIter` is a
+        segmented iterator, each segment is searched separately, using its
+        local iterators. */
+    template<typename InputIter, typename T>
+    InputIter segmented_find(InputIter first, InputIter last, T const & x);
+
+    /** Equivalent to `std::accumulate(first, last, init, op)`.  If
+        `InputIter` is a segmented iterator, each segment is accumulated
+        separately, using its local iterators. */
+    template<typename InputIter, typename T, typename BinaryOp>
+    T segmented_accumulate(
+        InputIter first, InputIter last, T init, BinaryOp op);
+
+    /** Equivalent to `std::accumulate(first, last, init)`.  \see
+        `segmented_accumulate(first, last, init, op)` */
+    template<typename InputIter, typename T>
+    T segmented_accumulate(InputIter first, InputIter last, T init);
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    namespace v1_dtl {
+        template<typename InputIter, typename OutputIter>
+        OutputIter segmented_copy_impl(
+            InputIter first, InputIter last, OutputIter out, std::false_type)
+        {
+            return std::copy(first, last, out);
+        }
+        template<typename InputIter, typename OutputIter>
+        OutputIter segmented_copy_impl(
+            InputIter first, InputIter last, OutputIter out, std::true_type)
+        {
+            v1_dtl::for_each_segment(
+                first, last, [&](auto, auto local_first, auto local_last) {
+                    out = stl_interfaces::segmented_copy(
+                        local_first, local_last, out);
+                    return true;
+                });
+            return out;
+        }
+
+        template<typename ForwardIter, typename T>
+        void segmented_fill_impl(
+            ForwardIter first, ForwardIter last, T const & x, std::false_type)
+        {
+            std::fill(first, last, x);
+        }
+        template<typename ForwardIter, typename T>
+        void segmented_fill_impl(
+            ForwardIter first, ForwardIter last, T const & x, std::true_type)
+        {
+            v1_dtl::for_each_segment(
+                first, last, [&](auto, auto local_first, auto local_last) {
+                    stl_interfaces::segmented_fill(local_first, local_last, x);
+                    return true;
+                });
+        }
+
+        template<typename InputIter, typename F>
+        void segmented_for_each_impl(
+            InputIter first, InputIter last, F & f, std::false_type)
+        {
+            std::for_each(first, last, std::ref(f));
+        }
+        template<typename InputIter, typename F>
+        void segmented_for_each_impl(
+            InputIter first, InputIter last, F & f, std::true_type)
+        {
+            v1_dtl::for_each_segment(
+                first, last, [&](auto, auto local_first, auto local_last) {
+                    v1_dtl::segmented_for_each_impl(
+                        local_first,
+                        local_last,
+                        f,
+                        is_segmented_iterator<decltype(local_first)>{});
+                    return true;
+                });
+        }
+
+        template<typename InputIter, typename T>
+        InputIter segmented_find_impl(
+            InputIter first, InputIter last, T const & x, std::false_type)
+        {
+            return std::find(first, last, x);
+        }
+        template<typename InputIter, typename T>
+        InputIter segmented_find_impl(
+            InputIter first, InputIter last, T const & x, std::true_type)
+        {
+            using traits = segmented_iterator_traits<InputIter>;
+            InputIter retval = last;
+            v1_dtl::for_each_segment(
+                first, last, [&](auto seg, auto local_first, auto local_last) {
+                    auto const it = stl_interfaces::segmented_find(
+                        local_first, local_last, x);
+                    if (it == local_last)
+                        return true;
+                    retval = traits::compose(first, seg, it);
+                    return false;
+                });
+            return retval;
+        }
+
+        template<typename InputIter, typename T, typename BinaryOp>
+        T segmented_accumulate_impl(
+            InputIter first,
+            InputIter last,
+            T init,
+            BinaryOp op,
+            std::false_type)
+        {
+            return std::accumulate(first, last, std::move(init), op);
+        }
+        template<typename InputIter, typename T, typename BinaryOp>
+        T segmented_accumulate_impl(
+            InputIter first,
+            InputIter last,
+            T init,
+            BinaryOp op,
+            std::true_type)
+        {
+            v1_dtl::for_each_segment(
+                first, last, [&](auto, auto local_first, auto local_last) {
+                    init = stl_interfaces::segmented_accumulate(
+                        local_first, local_last, std::move(init), op);
+                    return true;
+                });
+            return init;
+        }
+    }
+
+    template<typename InputIter, typename OutputIter>
+    OutputIter segmented_copy(InputIter first, InputIter last, OutputIter out)
+    {
+        return v1_dtl::segmented_copy_impl(
+            first, last, out, is_segmented_iterator<InputIter>{});
+    }
+
+    template<typename ForwardIter, typename T>
+    void segmented_fill(ForwardIter first, ForwardIter last, T const & x)
+    {
+        v1_dtl::segmented_fill_impl(
+            first, last, x, is_segmented_iterator<ForwardIter>{});
+    }
+
+    template<typename InputIter, typename F>
+    F segmented_for_each(InputIter first, InputIter last, F f)
+    {
+        v1_dtl::segmented_for_each_impl(
+            first, last, f, is_segmented_iterator<InputIter>{});
+        return f;
+    }
+
+    template<typename InputIter, typename T>
+    InputIter segmented_find(InputIter first, InputIter last, T const & x)
+    {
+        return v1_dtl::segmented_find_impl(
+            first, last, x, is_segmented_iterator<InputIter>{});
+    }
+
+    template<typename InputIter, typename T, typename BinaryOp>
+    T segmented_accumulate(InputIter first, InputIter last, T init, BinaryOp op)
+    {
+        return v1_dtl::segmented_accumulate_impl(
+            first,
+            last,
+            std::move(init),
+            op,
+            is_segmented_iterator<InputIter>{});
+    }
+
+    template<typename InputIter, typename T>
+    T segmented_accumulate(InputIter first, InputIter last, T init)
+    {
+        return stl_interfaces::segmented_accumulate(
+            first, last, std::move(init), std::plus<>{});
+    }
+
+#endif
+
+}}}
+
+#endif
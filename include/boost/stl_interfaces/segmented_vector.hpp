@@ -0,0 +1,315 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_SEGMENTED_VECTOR_HPP
+#define BOOST_STL_INTERFACES_SEGMENTED_VECTOR_HPP
+
+#include <boost/stl_interfaces/container_interface.hpp>
+#include <boost/stl_interfaces/reverse_iterator.hpp>
+#include <boost/stl_interfaces/segmented_iterator.hpp>
+
+#include <algorithm>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <cassert>
+#include <cstddef>
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+    //[ segmented_vector_iterator
+    // An iterator over the elements of a segmented_vector: a pointer into its
+    // table of chunks, and an index.  Element i is element i % ChunkSize of
+    // chunk i / ChunkSize; ChunkSize is a power of two, so those are a mask and
+    // a shift.
+    //
+    // The iterator also models the segmented iterator protocol, with the
+    // chunks as the segments and pointers as the local iterators, so the
+    // segmented_*() algorithms run over whole chunks with pointers.  An index
+    // that is a multiple of ChunkSize is treated as the end of the chunk before
+    // it, rather than the start of the chunk after it; that way the end
+    // iterator of a vector whose last chunk is full is in a chunk that exists.
+    template<typename T, std::size_t ChunkSize>
+    struct segmented_vector_iterator
+        : iterator_interface<
+              segmented_vector_iterator<T, ChunkSize>,
+              std::random_access_iterator_tag,
+              std::remove_const_t<T>>
+    {
+        using chunk_pointer = std::remove_const_t<T> * const *;
+
+        segmented_vector_iterator() noexcept : chunks_(nullptr), i_(0) {}
+        segmented_vector_iterator(
+            chunk_pointer chunks, std::ptrdiff_t i) noexcept :
+            chunks_(chunks),
+            i_(i)
+        {}
+        template<
+            typename U,
+            typename E = std::enable_if_t<
+                std::is_same<T, U const>::value && !std::is_same<T, U>::value>>
+        segmented_vector_iterator(
+            segmented_vector_iterator<U, ChunkSize> other) noexcept :
+            chunks_(other.chunks_),
+            i_(other.i_)
+        {}
+
+        T & operator*() const noexcept
+        {
+            return chunks_[i_ / ChunkSize][i_ % ChunkSize];
+        }
+        segmented_vector_iterator & operator+=(std::ptrdiff_t n) noexcept
+        {
+            i_ += n;
+            return *this;
+        }
+        friend std::ptrdiff_t operator-(
+            segmented_vector_iterator lhs,
+            segmented_vector_iterator rhs) noexcept
+        {
+            return lhs.i_ - rhs.i_;
+        }
+
+    private:
+        template<typename U, std::size_t N>
+        friend struct segmented_vector_iterator;
+        friend access;
+
+        chunk_pointer segment() const noexcept
+        {
+            return chunks_ + (i_ ? (i_ - 1) / std::ptrdiff_t(ChunkSize) : 0);
+        }
+        T * local() const noexcept
+        {
+            auto const seg = segment();
+            return *seg + (i_ - (seg - chunks_) * std::ptrdiff_t(ChunkSize));
+        }
+        T * local_begin(chunk_pointer seg) const noexcept { return *seg; }
+        T * local_end(chunk_pointer seg) const noexcept
+        {
+            return *seg + ChunkSize;
+        }
+        segmented_vector_iterator
+        compose(chunk_pointer seg, T * it) const noexcept
+        {
+            auto const chunk = seg - chunks_;
+            return segmented_vector_iterator(
+                chunks_, chunk * std::ptrdiff_t(ChunkSize) + (it - *seg));
+        }
+
+        chunk_pointer chunks_;
+        std::ptrdiff_t i_;
+    };
+    //]
+
+    template<typename T, std::size_t ChunkSize>
+    struct segmented_vector;
+
+    // segmented_vector destroys its elements itself, before its table of chunks
+    // goes away; see flat_map.hpp.
+    template<typename T, std::size_t ChunkSize>
+    struct trivially_destructible_container<segmented_vector<T, ChunkSize>>
+        : std::true_type
+    {};
+
+    //[ segmented_vector_defn
+    // A sequence container of fixed-size chunks of ChunkSize elements, like
+    // std::deque, but growing only at the back.  push_back() allocates a new
+    // chunk when the last one is full, and never moves or copies the existing
+    // elements, so it takes the same time however large the vector is -- except
+    // for the occasional growth of the table of chunk pointers, which is
+    // ChunkSize times smaller than the elements.  References to the elements
+    // stay valid until the elements are erased; like std::deque's, iterators
+    // are invalidated by push_back().
+    template<typename T, std::size_t ChunkSize = 256>
+    struct segmented_vector : container_interface<
+                                  segmented_vector<T, ChunkSize>>
+    {
+        static_assert(
+            0 < ChunkSize && (ChunkSize & (ChunkSize - 1)) == 0,
+            "ChunkSize must be a power of two.");
+
+        // types
+        using value_type = T;
+        using reference = T &;
+        using const_reference = T const &;
+        using iterator = segmented_vector_iterator<T, ChunkSize>;
+        using const_iterator = segmented_vector_iterator<T const, ChunkSize>;
+        using reverse_iterator = stl_interfaces::reverse_iterator<iterator>;
+        using const_reverse_iterator =
+            stl_interfaces::reverse_iterator<const_iterator>;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+
+        static constexpr size_type chunk_size = ChunkSize;
+
+        // construct/copy/destroy (9 members, skipped 2)
+        segmented_vector() noexcept : size_(0), no_chunks_(nullptr) {}
+        explicit segmented_vector(size_type n) : segmented_vector()
+        {
+            for (size_type i = 0; i < n; ++i) {
+                emplace_back();
+            }
+        }
+        template<
+            typename InputIterator,
+            typename Enable = std::enable_if_t<std::is_convertible<
+                typename std::iterator_traits<InputIterator>::iterator_category,
+                std::input_iterator_tag>::value>>
+        segmented_vector(InputIterator first, InputIterator last) :
+            segmented_vector()
+        {
+            for (; first != last; ++first) {
+                emplace_back(*first);
+            }
+        }
+        segmented_vector(std::initializer_list<T> il) :
+            segmented_vector(il.begin(), il.end())
+        {}
+        segmented_vector(segmented_vector const & other) :
+            segmented_vector(other.begin(), other.end())
+        {}
+        segmented_vector(segmented_vector && other) noexcept :
+            chunks_(std::move(other.chunks_)),
+            size_(std::exchange(other.size_, 0)),
+            no_chunks_(nullptr)
+        {
+            other.chunks_.clear();
+        }
+        segmented_vector & operator=(segmented_vector const & other)
+        {
+            if (this != &other) {
+                segmented_vector temp(other);
+                swap(temp);
+            }
+            return *this;
+        }
+        segmented_vector & operator=(segmented_vector && other) noexcept
+        {
+            segmented_vector temp(std::move(other));
+            swap(temp);
+            return *this;
+        }
+        ~segmented_vector()
+        {
+            clear();
+            for (auto chunk : chunks_) {
+                std::allocator<T>().deallocate(chunk, ChunkSize);
+            }
+        }
+
+        // iterators (2 members, skipped 10)
+        iterator begin() noexcept { return iterator(table(), 0); }
+        iterator end() noexcept { return iterator(table(), size_); }
+
+        // capacity (6 members, skipped 2)
+        size_type size() const noexcept { return size_; }
+        size_type max_size() const noexcept { return chunks_.max_size(); }
+        size_type capacity() const noexcept
+        {
+            return chunks_.size() * ChunkSize;
+        }
+        // Allocates the chunks for n elements.
+        void reserve(size_type n)
+        {
+            while (capacity() < n) {
+                add_chunk();
+            }
+        }
+        // Frees the chunks past the last element.
+        void shrink_to_fit() noexcept
+        {
+            auto const used = (size_ + ChunkSize - 1) / ChunkSize;
+            for (auto i = used; i < chunks_.size(); ++i) {
+                std::allocator<T>().deallocate(chunks_[i], ChunkSize);
+            }
+            chunks_.resize(used);
+        }
+
+        // modifiers (5 members, skipped 10)
+        template<typename... Args>
+        reference emplace_back(Args &&... args)
+        {
+            if (size_ == capacity())
+                add_chunk();
+            auto const p = chunks_[size_ / ChunkSize] + size_ % ChunkSize;
+            ::new (static_cast<void *>(p)) T(std::forward<Args>(args)...);
+            ++size_;
+            return *p;
+        }
+        void pop_back() noexcept
+        {
+            assert(size_);
+            --size_;
+            (*this)[size_].~T();
+        }
+        // Erases the elements [first, end()).  Erasing elsewhere is not
+        // supported; that would have to move every later element.
+        iterator erase(const_iterator first, const_iterator last) noexcept
+        {
+            assert(last == this->cend());
+            (void)last;
+            auto const n = first - this->cbegin();
+            while (difference_type(size_) != n) {
+                pop_back();
+            }
+            return end();
+        }
+        void clear() noexcept
+        {
+            while (size_) {
+                pop_back();
+            }
+        }
+        void swap(segmented_vector & other) noexcept
+        {
+            chunks_.swap(other.chunks_);
+            std::swap(size_, other.size_);
+        }
+        friend void swap(
+            segmented_vector & lhs, segmented_vector & rhs) noexcept
+        {
+            lhs.swap(rhs);
+        }
+
+        // The number of chunks allocated.
+        size_type chunk_count() const noexcept { return chunks_.size(); }
+
+        using base_type = container_interface<segmented_vector<T, ChunkSize>>;
+        using base_type::begin;
+        using base_type::end;
+
+    private:
+        // The iterators need a chunk to point to even if there are none.
+        T * const * table() const noexcept
+        {
+            return chunks_.empty() ? &no_chunks_ : chunks_.data();
+        }
+
+        void add_chunk()
+        {
+            auto const chunk = std::allocator<T>().allocate(ChunkSize);
+            try {
+                chunks_.push_back(chunk);
+            } catch (...) {
+                std::allocator<T>().deallocate(chunk, ChunkSize);
+                throw;
+            }
+        }
+
+        std::vector<T *> chunks_;
+        size_type size_;
+        T * no_chunks_;
+    };
+    //]
+
+}}}
+
+#endif
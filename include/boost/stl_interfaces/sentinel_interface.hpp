@@ -0,0 +1,122 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_SENTINEL_INTERFACE_HPP
+#define BOOST_STL_INTERFACES_SENTINEL_INTERFACE_HPP
+
+#include <boost/stl_interfaces/iterator_interface.hpp>
+
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+    template<typename Derived>
+    struct sentinel_interface;
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    namespace v1_dtl {
+        template<typename D>
+        void derived_sentinel(sentinel_interface<D> const &);
+
+        template<typename T>
+        using derived_sentinel_t =
+            decltype(v1_dtl::derived_sentinel(std::declval<T const &>()));
+
+        // Iter may be compared to a sentinel; it must not itself be one, or
+        // the operators below would look for themselves to find out whether
+        // they are well-formed.
+        template<typename Iter>
+        using sentinel_enable_t = std::enable_if_t<
+            !detail::detector<void, derived_sentinel_t, Iter>::value>;
+    }
+
+#endif
+
+    /** A CRTP template that one may derive from to make defining a sentinel
+        easier: the end of a range that is not an iterator, and that an
+        iterator is compared to to find out whether it is at the end, such
+        as the null terminator of a string.
+
+        The derived sentinel type must define `operator==(Iter, Derived)`,
+        and may define `operator-(Derived, Iter)`, returning the number of
+        elements from an iterator to the end, for each iterator type `Iter`
+        it is the end of.  `sentinel_interface` defines `operator==(Derived,
+        Iter)`, `operator!=()` in both orders, and `operator-(Iter, Derived)`
+        in terms of them, as C++20 would rewrite them.  A range whose `end()`
+        returns a sentinel then works with `view_interface`: `empty()`,
+        `front()` and `operator bool` compare with the sentinel, and `size()`
+        is the sentinel minus `begin()` if `operator-()` is defined.
+
+        An iterator that needs to know where its range ends only in order
+        to compare with its end -- one that keeps a `last_` or a count just
+        so that a default-constructed iterator can be its end -- can drop
+        that state, and the comparison with it, in favor of a sentinel. */
+    template<typename Derived>
+    struct sentinel_interface
+    {
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+        template<
+            typename Iter,
+            typename Enable = v1_dtl::sentinel_enable_t<Iter>>
+        friend constexpr auto
+        operator==(Derived const & s, Iter const & it) noexcept(
+            noexcept(it == s)) -> decltype(it == s)
+        {
+            return it == s;
+        }
+        template<
+            typename Iter,
+            typename Enable = v1_dtl::sentinel_enable_t<Iter>>
+        friend constexpr auto
+        operator!=(Iter const & it, Derived const & s) noexcept(
+            noexcept(it == s)) -> decltype(!(it == s))
+        {
+            return !(it == s);
+        }
+        template<
+            typename Iter,
+            typename Enable = v1_dtl::sentinel_enable_t<Iter>>
+        friend constexpr auto
+        operator!=(Derived const & s, Iter const & it) noexcept(
+            noexcept(it == s)) -> decltype(!(it == s))
+        {
+            return !(it == s);
+        }
+        template<
+            typename Iter,
+            typename Enable = v1_dtl::sentinel_enable_t<Iter>>
+        friend constexpr auto
+        operator-(Iter const & it, Derived const & s) noexcept(
+            noexcept(s - it)) -> decltype(-(s - it))
+        {
+            return -(s - it);
+        }
+#endif
+    };
+
+    /** The sentinel of a range that ends at its first value-initialized
+        element, such as the null terminator of a C string. */
+    struct null_sentinel_t : sentinel_interface<null_sentinel_t>
+    {
+        template<
+            typename Iter,
+            typename T = typename std::iterator_traits<Iter>::value_type>
+        friend constexpr auto operator==(Iter const & it, null_sentinel_t)
+            -> decltype(*it == T())
+        {
+            return *it == T();
+        }
+    };
+
+    /** A `null_sentinel_t` object. */
+    constexpr null_sentinel_t null_sentinel{};
+
+}}}
+
+#endif
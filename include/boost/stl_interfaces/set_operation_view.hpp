@@ -0,0 +1,433 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_SET_OPERATION_VIEW_HPP
+#define BOOST_STL_INTERFACES_SET_OPERATION_VIEW_HPP
+
+#include <boost/stl_interfaces/iterator_interface.hpp>
+#include <boost/stl_interfaces/view_interface.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+    /** The operations that a `set_operation_view` can perform on its two
+        sorted ranges.  Each one produces the elements that the standard
+        algorithm of the same name does, in the same order. */
+    enum class set_operation {
+        merge,
+        set_union,
+        set_intersection,
+        set_difference
+    };
+
+    template<
+        typename Iter1,
+        typename Iter2,
+        typename Compare,
+        set_operation Op>
+    struct set_operation_view;
+
+    template<
+        typename Iter1,
+        typename Iter2,
+        typename Compare,
+        set_operation Op>
+    struct set_operation_iterator;
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    namespace v1_dtl {
+        template<typename Iter>
+        using set_op_ra = std::is_convertible<
+            typename std::iterator_traits<Iter>::iterator_category,
+            std::random_access_iterator_tag>;
+
+        // The elements of both ranges are produced by a merge or a union,
+        // so their iterators share a reference type if the two ranges
+        // agree on one, and produce values if not.
+        template<typename Iter1, typename Iter2>
+        using set_op_reference_t = std::conditional_t<
+            std::is_same<
+                typename std::iterator_traits<Iter1>::reference,
+                typename std::iterator_traits<Iter2>::reference>::value,
+            typename std::iterator_traits<Iter1>::reference,
+            typename std::iterator_traits<Iter1>::value_type>;
+
+        template<typename Reference>
+        using set_op_pointer_t = std::conditional_t<
+            std::is_reference<Reference>::value,
+            std::remove_reference_t<Reference> *,
+            proxy_arrow_result<Reference>>;
+
+        template<
+            typename Iter1,
+            typename Iter2,
+            typename Compare,
+            set_operation Op>
+        using set_operation_iterator_interface_t = iterator_interface<
+            set_operation_iterator<Iter1, Iter2, Compare, Op>,
+            std::forward_iterator_tag,
+            typename std::iterator_traits<Iter1>::value_type,
+            set_op_reference_t<Iter1, Iter2>,
+            set_op_pointer_t<set_op_reference_t<Iter1, Iter2>>,
+            iter_difference_t<Iter1>>;
+
+        // The first element of [first, last) not less than value, given
+        // that *first is less than value.  Random access iterators gallop:
+        // they probe at distances of 1, 2, 4, ..., then binary search the
+        // last step, so that skipping n elements takes O(log n)
+        // comparisons, not n.
+        template<typename Iter, typename T, typename Compare>
+        constexpr Iter gallop_lower_bound(
+            Iter first,
+            Iter last,
+            T const & value,
+            Compare const & comp,
+            std::true_type)
+        {
+            auto const n = last - first;
+            decltype(last - first) lo = 0;
+            decltype(last - first) step = 1;
+            while (step < n && comp(first[step], value)) {
+                lo = step;
+                step *= 2;
+            }
+            return std::lower_bound(
+                first + lo + 1, first + (std::min)(step, n), value, comp);
+        }
+        template<typename Iter, typename T, typename Compare>
+        constexpr Iter gallop_lower_bound(
+            Iter first,
+            Iter last,
+            T const & value,
+            Compare const & comp,
+            std::false_type)
+        {
+            for (++first; first != last && comp(*first, value); ++first) {
+            }
+            return first;
+        }
+        template<typename Iter, typename T, typename Compare>
+        constexpr Iter gallop_lower_bound(
+            Iter first, Iter last, T const & value, Compare const & comp)
+        {
+            return v1_dtl::gallop_lower_bound(
+                first, last, value, comp, set_op_ra<Iter>{});
+        }
+
+        template<set_operation Op>
+        using set_op_constant = std::integral_constant<set_operation, Op>;
+    }
+
+#endif
+
+    /** The iterator of a `set_operation_view`.  It holds its position in
+        each of the two ranges, and a pointer to the view, which holds the
+        ends of the ranges and the comparison, as the iterator of a
+        `filter_view` does.  It is a forward iterator.
+
+        Intersections and differences skip the elements of one range that
+        cannot be in the result; when that range's iterators are random
+        access, they gallop over them, taking `O(log n)` comparisons to skip
+        `n` elements.  So intersecting a short range with a long one takes
+        time proportional to the length of the short one times the log of
+        the long one, rather than to their total length. */
+    template<
+        typename Iter1,
+        typename Iter2,
+        typename Compare,
+        set_operation Op>
+    struct set_operation_iterator
+        : v1_dtl::set_operation_iterator_interface_t<Iter1, Iter2, Compare, Op>
+    {
+        using reference = v1_dtl::set_op_reference_t<Iter1, Iter2>;
+        using view_type = set_operation_view<Iter1, Iter2, Compare, Op>;
+
+        constexpr set_operation_iterator() = default;
+        /** Constructs an iterator at the first element of the result at or
+            after `it1` in the first range and `it2` in the second. */
+        constexpr set_operation_iterator(
+            view_type const & view, Iter1 it1, Iter2 it2) :
+            view_(std::addressof(view)),
+            it1_(it1),
+            it2_(it2)
+        {
+            settle(v1_dtl::set_op_constant<Op>{});
+        }
+
+        constexpr reference operator*() const
+        {
+            if (from2_)
+                return *it2_;
+            return *it1_;
+        }
+        constexpr set_operation_iterator & operator++()
+        {
+            if (from2_ || both_)
+                ++it2_;
+            if (!from2_)
+                ++it1_;
+            settle(v1_dtl::set_op_constant<Op>{});
+            return *this;
+        }
+        friend constexpr bool operator==(
+            set_operation_iterator const & lhs,
+            set_operation_iterator const & rhs)
+        {
+            return lhs.it1_ == rhs.it1_ && lhs.it2_ == rhs.it2_;
+        }
+
+        /** Returns the position in the first range. */
+        constexpr Iter1 base1() const { return it1_; }
+        /** Returns the position in the second range. */
+        constexpr Iter2 base2() const { return it2_; }
+
+        using base_type = v1_dtl::
+            set_operation_iterator_interface_t<Iter1, Iter2, Compare, Op>;
+        using base_type::operator++;
+
+    private:
+        constexpr bool at_end1() const { return it1_ == view_->last1_; }
+        constexpr bool at_end2() const { return it2_ == view_->last2_; }
+
+        // Each settle() leaves the iterator at the next element of the
+        // result, with from2_ and both_ saying which positions the next
+        // increment advances; or at the ends of both ranges.
+        constexpr void settle(v1_dtl::set_op_constant<set_operation::merge>)
+        {
+            from2_ =
+                at_end1() || (!at_end2() && view_->comp_(*it2_, *it1_));
+        }
+        constexpr void
+        settle(v1_dtl::set_op_constant<set_operation::set_union>)
+        {
+            both_ = false;
+            if (at_end1()) {
+                from2_ = true;
+            } else if (at_end2()) {
+                from2_ = false;
+            } else if (view_->comp_(*it1_, *it2_)) {
+                from2_ = false;
+            } else {
+                from2_ = view_->comp_(*it2_, *it1_);
+                both_ = !from2_;
+            }
+        }
+        constexpr void
+        settle(v1_dtl::set_op_constant<set_operation::set_intersection>)
+        {
+            auto const & comp = view_->comp_;
+            both_ = true;
+            while (!at_end1() && !at_end2()) {
+                if (comp(*it1_, *it2_)) {
+                    it1_ = v1_dtl::gallop_lower_bound(
+                        it1_, view_->last1_, *it2_, comp);
+                } else if (comp(*it2_, *it1_)) {
+                    it2_ = v1_dtl::gallop_lower_bound(
+                        it2_, view_->last2_, *it1_, comp);
+                } else {
+                    return;
+                }
+            }
+            it1_ = view_->last1_;
+            it2_ = view_->last2_;
+        }
+        constexpr void
+        settle(v1_dtl::set_op_constant<set_operation::set_difference>)
+        {
+            auto const & comp = view_->comp_;
+            both_ = false;
+            while (!at_end1() && !at_end2()) {
+                if (comp(*it1_, *it2_)) {
+                    return;
+                } else if (comp(*it2_, *it1_)) {
+                    it2_ = v1_dtl::gallop_lower_bound(
+                        it2_, view_->last2_, *it1_, comp);
+                } else {
+                    ++it1_;
+                    ++it2_;
+                }
+            }
+            if (at_end1())
+                it2_ = view_->last2_;
+        }
+
+        view_type const * view_ = nullptr;
+        Iter1 it1_ = Iter1();
+        Iter2 it2_ = Iter2();
+        bool from2_ = false;
+        bool both_ = false;
+    };
+
+    /** A lazy view of the result of a set operation on the sorted ranges
+        `[first1, last1)` and `[first2, last2)`: a merge of the two, their
+        union, their intersection, or the difference of the first and the
+        second.  The ranges must be sorted by `comp`, and the view produces
+        the elements that `std::merge()`, `std::set_union()`,
+        `std::set_intersection()` or `std::set_difference()` would, without
+        storing them.  Its iterators refer to the view, which must outlive
+        them.
+
+        `begin()` finds the first element of the result each time it is
+        called; for an intersection or a difference, that may skip a run of
+        elements.  \see `set_operation_iterator` */
+    template<
+        typename Iter1,
+        typename Iter2,
+        typename Compare,
+        set_operation Op>
+    struct set_operation_view
+        : view_interface<set_operation_view<Iter1, Iter2, Compare, Op>>
+    {
+        using iterator = set_operation_iterator<Iter1, Iter2, Compare, Op>;
+
+        constexpr set_operation_view() = default;
+        constexpr set_operation_view(
+            Iter1 first1,
+            Iter1 last1,
+            Iter2 first2,
+            Iter2 last2,
+            Compare comp = Compare()) :
+            first1_(first1),
+            last1_(last1),
+            first2_(first2),
+            last2_(last2),
+            comp_(std::move(comp))
+        {}
+
+        constexpr iterator begin() const
+        {
+            return iterator(*this, first1_, first2_);
+        }
+        constexpr iterator end() const
+        {
+            return iterator(*this, last1_, last2_);
+        }
+
+        /** Returns the comparison. */
+        constexpr Compare const & comp() const noexcept { return comp_; }
+
+    private:
+        friend iterator;
+
+        Iter1 first1_;
+        Iter1 last1_;
+        Iter2 first2_;
+        Iter2 last2_;
+        Compare comp_;
+    };
+
+    /** A view of the merge of two sorted ranges.  \see `set_operation_view` */
+    template<typename Iter1, typename Iter2, typename Compare = std::less<>>
+    using merge_view =
+        set_operation_view<Iter1, Iter2, Compare, set_operation::merge>;
+
+    /** A view of the union of two sorted ranges.
+        \see `set_operation_view` */
+    template<typename Iter1, typename Iter2, typename Compare = std::less<>>
+    using set_union_view =
+        set_operation_view<Iter1, Iter2, Compare, set_operation::set_union>;
+
+    /** A view of the intersection of two sorted ranges.
+        \see `set_operation_view` */
+    template<typename Iter1, typename Iter2, typename Compare = std::less<>>
+    using set_intersection_view = set_operation_view<
+        Iter1,
+        Iter2,
+        Compare,
+        set_operation::set_intersection>;
+
+    /** A view of the elements of one sorted range that are not in another.
+        \see `set_operation_view` */
+    template<typename Iter1, typename Iter2, typename Compare = std::less<>>
+    using set_difference_view = set_operation_view<
+        Iter1,
+        Iter2,
+        Compare,
+        set_operation::set_difference>;
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    namespace v1_dtl {
+        template<
+            set_operation Op,
+            typename Range1,
+            typename Range2,
+            typename Compare>
+        constexpr auto
+        make_set_operation_view(Range1 && r1, Range2 && r2, Compare comp)
+        {
+            return set_operation_view<
+                decltype(std::begin(r1)),
+                decltype(std::begin(r2)),
+                Compare,
+                Op>(
+                std::begin(r1),
+                std::end(r1),
+                std::begin(r2),
+                std::end(r2),
+                std::move(comp));
+        }
+    }
+
+#endif
+
+    /** Returns a `merge_view` of the sorted ranges `r1` and `r2`. */
+    template<
+        typename Range1,
+        typename Range2,
+        typename Compare = std::less<>>
+    constexpr auto
+    make_merge_view(Range1 && r1, Range2 && r2, Compare comp = Compare())
+    {
+        return v1_dtl::make_set_operation_view<set_operation::merge>(
+            r1, r2, std::move(comp));
+    }
+
+    /** Returns a `set_union_view` of the sorted ranges `r1` and `r2`. */
+    template<
+        typename Range1,
+        typename Range2,
+        typename Compare = std::less<>>
+    constexpr auto
+    make_set_union_view(Range1 && r1, Range2 && r2, Compare comp = Compare())
+    {
+        return v1_dtl::make_set_operation_view<set_operation::set_union>(
+            r1, r2, std::move(comp));
+    }
+
+    /** Returns a `set_intersection_view` of the sorted ranges `r1` and
+        `r2`. */
+    template<
+        typename Range1,
+        typename Range2,
+        typename Compare = std::less<>>
+    constexpr auto make_set_intersection_view(
+        Range1 && r1, Range2 && r2, Compare comp = Compare())
+    {
+        return v1_dtl::make_set_operation_view<
+            set_operation::set_intersection>(r1, r2, std::move(comp));
+    }
+
+    /** Returns a `set_difference_view` of the elements of the sorted range
+        `r1` that are not in the sorted range `r2`. */
+    template<
+        typename Range1,
+        typename Range2,
+        typename Compare = std::less<>>
+    constexpr auto make_set_difference_view(
+        Range1 && r1, Range2 && r2, Compare comp = Compare())
+    {
+        return v1_dtl::make_set_operation_view<set_operation::set_difference>(
+            r1, r2, std::move(comp));
+    }
+
+}}}
+
+#endif
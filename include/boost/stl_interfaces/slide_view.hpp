@@ -0,0 +1,337 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_SLIDE_VIEW_HPP
+#define BOOST_STL_INTERFACES_SLIDE_VIEW_HPP
+
+#include <boost/stl_interfaces/chunk_view.hpp>
+
+#include <boost/assert.hpp>
+
+#include <array>
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+    /** An iterator over the overlapping windows of `n` consecutive elements
+        of the range `[first, last)`, like the iterator of
+        `std::ranges::slide_view`: the first window holds elements `0`
+        through `n - 1`, the next `1` through `n`, and so on.  A range of
+        fewer than `n` elements has no windows.
+
+        Each window is the same `chunk_range` that a `chunk_iterator` over
+        `Iter` produces -- a span of pointers if `Iter` is contiguous -- so
+        nothing is copied.  The iterator keeps both ends of the current
+        window, so moving to the next window increments two iterators,
+        rather than walking `n` elements.  A `slide_iterator` over random
+        access iterators is itself random access; otherwise, it is a forward
+        iterator.
+
+        \see `slide_view` */
+    template<typename Iter, typename Enable = void>
+    struct slide_iterator : proxy_iterator_interface<
+                                slide_iterator<Iter, Enable>,
+                                std::forward_iterator_tag,
+                                typename v1_dtl::chunk_of<Iter>::type>
+    {
+        using window_type = typename v1_dtl::chunk_of<Iter>::type;
+
+        constexpr slide_iterator() = default;
+        /** Constructs an iterator to the first window of `[first, last)`,
+            or to the end if that range has fewer than `n` elements. */
+        constexpr slide_iterator(
+            Iter first, Iter last, v1_dtl::iter_difference_t<Iter> n) :
+            it_(first),
+            back_(first)
+        {
+            BOOST_ASSERT(0 < n);
+            for (auto i = n - 1; i && back_ != last; --i) {
+                ++back_;
+            }
+        }
+
+        constexpr window_type operator*() const
+        {
+            return v1_dtl::chunk_of<Iter>::make(it_, std::next(back_));
+        }
+        constexpr slide_iterator & operator++()
+        {
+            ++it_;
+            ++back_;
+            return *this;
+        }
+        friend constexpr bool
+        operator==(slide_iterator const & lhs, slide_iterator const & rhs)
+        {
+            return lhs.back_ == rhs.back_;
+        }
+
+        using base_type = proxy_iterator_interface<
+            slide_iterator<Iter, Enable>,
+            std::forward_iterator_tag,
+            window_type>;
+        using base_type::operator++;
+
+    private:
+        // back_ is the last element of the window, not one past it, so that
+        // the end iterator needs no element past the end of the range.
+        Iter it_;
+        Iter back_;
+    };
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    template<typename Iter>
+    struct slide_iterator<Iter, std::enable_if_t<v1_dtl::chunk_ra<Iter>::value>>
+        : proxy_iterator_interface<
+              slide_iterator<Iter>,
+              std::random_access_iterator_tag,
+              typename v1_dtl::chunk_of<Iter>::type>
+    {
+        using window_type = typename v1_dtl::chunk_of<Iter>::type;
+        using difference_type = v1_dtl::iter_difference_t<Iter>;
+
+        constexpr slide_iterator() = default;
+        constexpr slide_iterator(Iter first, Iter last, difference_type n) :
+            slide_iterator(last - first < n ? last : first, n)
+        {}
+        constexpr slide_iterator(Iter it, difference_type n) : it_(it), n_(n)
+        {
+            BOOST_ASSERT(0 < n);
+        }
+
+        constexpr window_type operator*() const
+        {
+            return v1_dtl::chunk_of<Iter>::make(it_, it_ + n_);
+        }
+        constexpr slide_iterator & operator+=(difference_type i)
+        {
+            it_ += i;
+            return *this;
+        }
+        friend constexpr difference_type
+        operator-(slide_iterator const & lhs, slide_iterator const & rhs)
+        {
+            return lhs.it_ - rhs.it_;
+        }
+
+    private:
+        Iter it_;
+        difference_type n_;
+    };
+
+#endif
+
+    /** A view of the overlapping windows of `n` consecutive elements of the
+        range `[first, last)`.  \see `slide_iterator` */
+    template<typename Iter>
+    struct slide_view : view_interface<slide_view<Iter>>
+    {
+        using iterator = slide_iterator<Iter>;
+
+        constexpr slide_view() = default;
+        constexpr slide_view(
+            Iter first, Iter last, v1_dtl::iter_difference_t<Iter> n) :
+            first_(first),
+            last_(last),
+            n_(n)
+        {
+            BOOST_ASSERT(0 < n);
+        }
+
+        constexpr iterator begin() const
+        {
+            return iterator(first_, last_, n_);
+        }
+        constexpr iterator end() const
+        {
+            return end(v1_dtl::chunk_ra<Iter>{});
+        }
+
+        /** Returns the number of elements in each window. */
+        constexpr v1_dtl::iter_difference_t<Iter> window_size() const noexcept
+        {
+            return n_;
+        }
+
+    private:
+        constexpr iterator end(std::true_type) const
+        {
+            return iterator(
+                last_ - first_ < n_ ? last_ : last_ - (n_ - 1), n_);
+        }
+        constexpr iterator end(std::false_type) const
+        {
+            return iterator(last_, last_, n_);
+        }
+
+        Iter first_;
+        Iter last_;
+        v1_dtl::iter_difference_t<Iter> n_;
+    };
+
+    /** Returns a `slide_view` of the windows of `n` consecutive elements of
+        `r`. */
+    template<typename Range>
+    constexpr auto make_slide_view(
+        Range && r, v1_dtl::iter_difference_t<decltype(std::begin(r))> n)
+    {
+        using iter = decltype(std::begin(r));
+        return slide_view<iter>(std::begin(r), std::end(r), n);
+    }
+
+    /** An iterator over the overlapping windows of `N` consecutive elements
+        of the range `[first, last)`, like the iterator of
+        `std::ranges::adjacent_view`, with the window size fixed at compile
+        time.
+
+        If `Iter` is contiguous (see `is_contiguous_iterator`), each window
+        is a `chunk_range` of `N` pointers, and the iterator is random
+        access.  Otherwise, each window is a `std::array<Iter, N>` of
+        iterators to its elements.  The iterator keeps that array, and moving
+        to the next window shifts it down and increments only its last
+        element, so a window costs one increment of `Iter`, however large
+        `N` is; such an iterator is a forward iterator.
+
+        \see `adjacent_view` */
+    template<typename Iter, std::size_t N, typename Enable = void>
+    struct adjacent_iterator : proxy_iterator_interface<
+                                   adjacent_iterator<Iter, N, Enable>,
+                                   std::forward_iterator_tag,
+                                   std::array<Iter, N>>
+    {
+        static_assert(0 < N, "An adjacent_iterator's windows can't be empty.");
+
+        using window_type = std::array<Iter, N>;
+
+        constexpr adjacent_iterator() = default;
+        /** Constructs an iterator to the first window of `[first, last)`,
+            or to the end if that range has fewer than `N` elements. */
+        constexpr adjacent_iterator(Iter first, Iter last) : window_()
+        {
+            window_[0] = first;
+            for (std::size_t i = 1; i < N; ++i) {
+                window_[i] = window_[i - 1];
+                if (window_[i] != last)
+                    ++window_[i];
+            }
+        }
+
+        constexpr window_type operator*() const { return window_; }
+        constexpr adjacent_iterator & operator++()
+        {
+            for (std::size_t i = 1; i < N; ++i) {
+                window_[i - 1] = window_[i];
+            }
+            ++window_[N - 1];
+            return *this;
+        }
+        friend constexpr bool operator==(
+            adjacent_iterator const & lhs, adjacent_iterator const & rhs)
+        {
+            return lhs.window_[N - 1] == rhs.window_[N - 1];
+        }
+
+        using base_type = proxy_iterator_interface<
+            adjacent_iterator<Iter, N, Enable>,
+            std::forward_iterator_tag,
+            window_type>;
+        using base_type::operator++;
+
+    private:
+        window_type window_;
+    };
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    template<typename Iter, std::size_t N>
+    struct adjacent_iterator<
+        Iter,
+        N,
+        std::enable_if_t<is_contiguous_iterator<Iter>::value>>
+        : proxy_iterator_interface<
+              adjacent_iterator<Iter, N>,
+              std::random_access_iterator_tag,
+              typename v1_dtl::chunk_of<Iter>::type>
+    {
+        static_assert(0 < N, "An adjacent_iterator's windows can't be empty.");
+
+        using window_type = typename v1_dtl::chunk_of<Iter>::type;
+        using difference_type = v1_dtl::iter_difference_t<Iter>;
+
+        constexpr adjacent_iterator() = default;
+        constexpr adjacent_iterator(Iter first, Iter last) :
+            adjacent_iterator(last - first < difference_type(N) ? last : first)
+        {}
+        constexpr explicit adjacent_iterator(Iter it) : it_(it) {}
+
+        constexpr window_type operator*() const
+        {
+            return v1_dtl::chunk_of<Iter>::make(it_, it_ + N);
+        }
+        constexpr adjacent_iterator & operator+=(difference_type i)
+        {
+            it_ += i;
+            return *this;
+        }
+        friend constexpr difference_type
+        operator-(adjacent_iterator const & lhs, adjacent_iterator const & rhs)
+        {
+            return lhs.it_ - rhs.it_;
+        }
+
+    private:
+        Iter it_;
+    };
+
+#endif
+
+    /** A view of the overlapping windows of `N` consecutive elements of the
+        range `[first, last)`.  \see `adjacent_iterator` */
+    template<typename Iter, std::size_t N>
+    struct adjacent_view : view_interface<adjacent_view<Iter, N>>
+    {
+        using iterator = adjacent_iterator<Iter, N>;
+
+        constexpr adjacent_view() = default;
+        constexpr adjacent_view(Iter first, Iter last) :
+            first_(first), last_(last)
+        {}
+
+        constexpr iterator begin() const { return iterator(first_, last_); }
+        constexpr iterator end() const
+        {
+            return end(is_contiguous_iterator<Iter>{});
+        }
+
+    private:
+        constexpr iterator end(std::true_type) const
+        {
+            using difference_type = v1_dtl::iter_difference_t<Iter>;
+            return iterator(
+                last_ - first_ < difference_type(N) ? last_
+                                                    : last_ - (N - 1));
+        }
+        constexpr iterator end(std::false_type) const
+        {
+            return iterator(last_, last_);
+        }
+
+        Iter first_;
+        Iter last_;
+    };
+
+    /** Returns an `adjacent_view` of the windows of `N` consecutive
+        elements of `r`. */
+    template<std::size_t N, typename Range>
+    constexpr auto make_adjacent_view(Range && r)
+    {
+        using iter = decltype(std::begin(r));
+        return adjacent_view<iter, N>(std::begin(r), std::end(r));
+    }
+
+}}}
+
+#endif
@@ -0,0 +1,418 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_SMALL_STRING_HPP
+#define BOOST_STL_INTERFACES_SMALL_STRING_HPP
+
+#include <boost/stl_interfaces/static_string.hpp>
+
+#include <limits>
+#include <memory>
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+    template<std::size_t N>
+    struct small_string;
+
+    /** `small_string`'s destructor frees its heap storage itself, so
+        `container_interface` does not need to call `clear()`. */
+    template<std::size_t N>
+    struct trivially_destructible_container<small_string<N>>
+        : std::true_type
+    {
+    };
+
+    /** A `std::string`-like sequence of `char`s that stores up to `N` of
+        them, and a terminating null, within the object itself, and only
+        goes to the heap when it needs more than that.  Once it has
+        spilled, it grows geometrically, like `std::string`.  Unlike
+        `std::string`, whose inline capacity is fixed by the standard
+        library (15 characters for libstdc++ and MSVC, 22 for libc++), `N`
+        can be sized to the strings a program actually holds.
+
+        `find()`, `compare()`, and the other string operations are those of
+        `static_string`.  As with `small_vector` in the examples, the
+        pointer to the characters always points to them -- in the object,
+        or on the heap -- so that access does not have to check where they
+        are; it is also why `small_string` is not trivially relocatable.
+
+        \see `static_string` */
+    template<std::size_t N>
+    struct small_string : container_interface<small_string<N>, contiguous>
+    {
+        using value_type = char;
+        using traits_type = std::char_traits<char>;
+        using pointer = char *;
+        using const_pointer = char const *;
+        using reference = char &;
+        using const_reference = char const &;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using iterator = char *;
+        using const_iterator = char const *;
+        using reverse_iterator = stl_interfaces::reverse_iterator<iterator>;
+        using const_reverse_iterator =
+            stl_interfaces::reverse_iterator<const_iterator>;
+
+        static constexpr size_type npos = v1_dtl::string_npos;
+
+        small_string() noexcept : data_(buf_), size_(0), capacity_(N)
+        {
+            buf_[0] = '\0';
+        }
+        small_string(size_type n, char c) : small_string() { resize(n, c); }
+        template<
+            typename InputIterator,
+            typename Enable = std::enable_if_t<std::is_convertible<
+                typename std::iterator_traits<
+                    InputIterator>::iterator_category,
+                std::input_iterator_tag>::value>>
+        small_string(InputIterator first, InputIterator last) : small_string()
+        {
+            for (; first != last; ++first) {
+                emplace_back(*first);
+            }
+        }
+        small_string(char const * s, size_type n) : small_string()
+        {
+            append(s, n);
+        }
+        small_string(char const * s) :
+            small_string(s, traits_type::length(s))
+        {}
+        small_string(std::initializer_list<char> il) :
+            small_string(il.begin(), il.end())
+        {}
+        small_string(small_string const & other) : small_string()
+        {
+            append(other.data_, other.size_);
+        }
+        small_string(small_string && other) noexcept : small_string()
+        {
+            steal(other);
+        }
+        small_string & operator=(small_string const & other)
+        {
+            if (this != &other) {
+                clear();
+                append(other.data_, other.size_);
+            }
+            return *this;
+        }
+        small_string & operator=(small_string && other) noexcept
+        {
+            if (this != &other) {
+                free_heap();
+                steal(other);
+            }
+            return *this;
+        }
+        ~small_string() { free_heap(); }
+
+        iterator begin() noexcept { return data_; }
+        iterator end() noexcept { return data_ + size_; }
+
+        /** Returns a pointer to the characters, followed by a null. */
+        char const * c_str() const noexcept { return data_; }
+        size_type length() const noexcept { return size_; }
+
+#if 201703L <= __cplusplus && defined(__cpp_lib_string_view)
+        operator std::string_view() const noexcept
+        {
+            return std::string_view(data_, size_);
+        }
+#endif
+
+        size_type max_size() const noexcept
+        {
+            return (std::numeric_limits<difference_type>::max)() - 1;
+        }
+        size_type capacity() const noexcept { return capacity_; }
+        void resize(size_type sz, char c)
+        {
+            reserve(sz);
+            if (size_ < sz)
+                std::memset(data_ + size_, c, sz - size_);
+            set_size(sz);
+        }
+        void reserve(size_type n)
+        {
+            if (capacity_ < n)
+                reallocate(n);
+        }
+        /** Moves the characters back into the object if they fit there. */
+        void shrink_to_fit()
+        {
+            if (!on_heap() || size_ == capacity_)
+                return;
+            if (size_ <= N) {
+                char * const heap = data_;
+                size_type const heap_capacity = capacity_;
+                std::memcpy(buf_, heap, size_ + 1);
+                data_ = buf_;
+                capacity_ = N;
+                deallocate(heap, heap_capacity);
+            } else {
+                reallocate(size_);
+            }
+        }
+
+        /** Returns true if the characters are stored within the object. */
+        bool is_inline() const noexcept { return !on_heap(); }
+
+        reference emplace_back(char c)
+        {
+            if (size_ == capacity_)
+                reallocate(grown_capacity(1));
+            data_[size_] = c;
+            set_size(size_ + 1);
+            return data_[size_ - 1];
+        }
+        iterator emplace(const_iterator pos, char c)
+        {
+            auto const i = size_type(pos - data_);
+            if (size_ == capacity_)
+                reallocate(grown_capacity(1));
+            char * const position = data_ + i;
+            std::memmove(position + 1, position, size_ - i);
+            *position = c;
+            set_size(size_ + 1);
+            return position;
+        }
+        /** Inserts `[first, last)` before `pos`; `[first, last)` may be
+            part of `*this`. */
+        template<
+            typename ForwardIterator,
+            typename Enable = std::enable_if_t<std::is_convertible<
+                typename std::iterator_traits<
+                    ForwardIterator>::iterator_category,
+                std::forward_iterator_tag>::value>>
+        iterator insert(
+            const_iterator pos, ForwardIterator first, ForwardIterator last)
+        {
+            auto const i = size_type(pos - data_);
+            auto const n = v1_dtl::string_distance(first, last);
+            if (capacity_ < size_ + n) {
+                // [first, last) may be characters of *this, so they are
+                // copied before the old storage is freed.
+                size_type const new_capacity = grown_capacity(n);
+                char * const new_data = allocate(new_capacity);
+                std::memcpy(new_data, data_, i);
+                std::copy(first, last, new_data + i);
+                std::memcpy(new_data + i + n, data_ + i, size_ - i);
+                replace_storage(new_data, new_capacity);
+            } else {
+                // As in static_string, appending first reads [first, last)
+                // before anything moves.
+                char * const old_end = end();
+                std::copy(first, last, old_end);
+                std::rotate(data_ + i, old_end, old_end + n);
+            }
+            set_size(size_ + n);
+            return data_ + i;
+        }
+        iterator erase(const_iterator f, const_iterator l) noexcept
+        {
+            char * const first = data_ + (f - data_);
+            std::memmove(first, l, end() - l);
+            set_size(size_ - (l - f));
+            return first;
+        }
+        void clear() noexcept { set_size(0); }
+
+        small_string & append(char const * s, size_type n)
+        {
+            if (capacity_ < size_ + n) {
+                // s may point into *this.
+                size_type const new_capacity = grown_capacity(n);
+                char * const new_data = allocate(new_capacity);
+                std::memcpy(new_data, data_, size_);
+                std::memcpy(new_data + size_, s, n);
+                replace_storage(new_data, new_capacity);
+            } else {
+                std::memmove(end(), s, n);
+            }
+            set_size(size_ + n);
+            return *this;
+        }
+        small_string & append(char const * s)
+        {
+            return append(s, traits_type::length(s));
+        }
+        small_string & operator+=(char c)
+        {
+            emplace_back(c);
+            return *this;
+        }
+        small_string & operator+=(char const * s) { return append(s); }
+
+        /** Returns the index of the first `c` at or after `pos`, or
+            `npos`. */
+        size_type find(char c, size_type pos = 0) const noexcept
+        {
+            return v1_dtl::string_find(data_, size_, c, pos);
+        }
+        /** Returns the index of the first occurrence of `[s, s + n)` at or
+            after `pos`, or `npos`. */
+        size_type find(char const * s, size_type pos, size_type n) const
+            noexcept
+        {
+            return v1_dtl::string_find(data_, size_, s, n, pos);
+        }
+        size_type find(char const * s, size_type pos = 0) const noexcept
+        {
+            return find(s, pos, traits_type::length(s));
+        }
+        size_type find(small_string const & s, size_type pos = 0) const
+            noexcept
+        {
+            return find(s.data_, pos, s.size_);
+        }
+
+        /** Returns a negative value, `0`, or a positive value, as `*this`
+            is ordered before, equal to, or after `[s, s + n)`. */
+        int compare(char const * s, size_type n) const noexcept
+        {
+            return v1_dtl::string_compare(data_, size_, s, n);
+        }
+        int compare(char const * s) const noexcept
+        {
+            return compare(s, traits_type::length(s));
+        }
+        int compare(small_string const & s) const noexcept
+        {
+            return compare(s.data_, s.size_);
+        }
+
+        void swap(small_string & other) noexcept
+        {
+            small_string temp(std::move(other));
+            other = std::move(*this);
+            *this = std::move(temp);
+        }
+
+        /** Swaps `lhs` and `rhs`. */
+        friend void swap(small_string & lhs, small_string & rhs) noexcept
+        {
+            lhs.swap(rhs);
+        }
+
+        friend bool operator==(small_string const & lhs, char const * rhs)
+        {
+            return !lhs.compare(rhs);
+        }
+        friend bool operator==(char const * lhs, small_string const & rhs)
+        {
+            return !rhs.compare(lhs);
+        }
+        friend bool operator!=(small_string const & lhs, char const * rhs)
+        {
+            return !!lhs.compare(rhs);
+        }
+        friend bool operator!=(char const * lhs, small_string const & rhs)
+        {
+            return !!rhs.compare(lhs);
+        }
+        /** Orders characters as unsigned, as `std::string` does. */
+        friend bool
+        operator<(small_string const & lhs, small_string const & rhs)
+        {
+            return lhs.compare(rhs) < 0;
+        }
+
+        using base_type = container_interface<small_string<N>, contiguous>;
+        using base_type::begin;
+        using base_type::end;
+        using base_type::erase;
+        using base_type::insert;
+        using base_type::resize;
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+    private:
+        bool on_heap() const noexcept { return data_ != buf_; }
+
+        // One more than the capacity, for the null.
+        static char * allocate(size_type capacity)
+        {
+            return std::allocator<char>().allocate(capacity + 1);
+        }
+        static void deallocate(char * p, size_type capacity) noexcept
+        {
+            std::allocator<char>().deallocate(p, capacity + 1);
+        }
+        void free_heap() noexcept
+        {
+            if (on_heap())
+                deallocate(data_, capacity_);
+            data_ = buf_;
+            capacity_ = N;
+        }
+        void replace_storage(char * new_data, size_type new_capacity) noexcept
+        {
+            if (on_heap())
+                deallocate(data_, capacity_);
+            data_ = new_data;
+            capacity_ = new_capacity;
+        }
+
+        size_type grown_capacity(size_type insertions) const noexcept
+        {
+            return (std::max)(size_ + insertions, 2 * capacity_);
+        }
+        void reallocate(size_type new_capacity)
+        {
+            char * const new_data = allocate(new_capacity);
+            std::memcpy(new_data, data_, size_ + 1);
+            replace_storage(new_data, new_capacity);
+        }
+
+        // Takes the characters of other, which is left empty.  Expects
+        // *this not to be on the heap.
+        void steal(small_string & other) noexcept
+        {
+            if (other.on_heap()) {
+                data_ = other.data_;
+                capacity_ = other.capacity_;
+                other.data_ = other.buf_;
+                other.capacity_ = N;
+            } else {
+                std::memcpy(buf_, other.buf_, other.size_ + 1);
+            }
+            size_ = other.size_;
+            other.set_size(0);
+        }
+
+        void set_size(size_type n) noexcept
+        {
+            size_ = n;
+            data_[n] = '\0';
+        }
+
+        char * data_;
+        size_type size_;
+        size_type capacity_;
+        char buf_[N + 1];
+#endif
+    };
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+    // Before C++17, npos needs a definition outside the class.
+    template<std::size_t N>
+    constexpr typename small_string<N>::size_type small_string<N>::npos;
+#endif
+
+}}}
+
+namespace std {
+    /** `small_string`'s hash is `boost::stl_interfaces::hash_value()`. */
+    template<std::size_t N>
+    struct hash<boost::stl_interfaces::small_string<N>>
+        : boost::stl_interfaces::container_hash
+    {
+    };
+}
+
+#endif
@@ -0,0 +1,474 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_SMALL_VECTOR_HPP
+#define BOOST_STL_INTERFACES_SMALL_VECTOR_HPP
+
+#include <boost/stl_interfaces/container_interface.hpp>
+#include <boost/stl_interfaces/static_vector.hpp>
+#include <boost/stl_interfaces/trivially_relocatable.hpp>
+#include <boost/stl_interfaces/detail/relocate.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <memory>
+
+#include <cassert>
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+    //[ small_vector_defn
+    // A std::vector-like container that stores up to N elements in an inline
+    // buffer, and only goes to the heap when it needs more than that.  Once it
+    // has spilled, it grows geometrically, like std::vector.  The member
+    // sections are commented as in static_vector.
+    //
+    // data_ always points to the elements -- at buf_, or at the heap -- so that
+    // element access does not have to check where the elements are.  That
+    // pointer into the object itself is also why small_vector is never
+    // trivially relocatable, even when T is.
+    template<typename T, std::size_t N>
+    struct small_vector : container_interface<small_vector<T, N>, contiguous>
+    {
+        static_assert(0 < N, "");
+
+        using value_type = T;
+        using pointer = T *;
+        using const_pointer = T const *;
+        using reference = value_type &;
+        using const_reference = value_type const &;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using iterator = T *;
+        using const_iterator = T const *;
+        using reverse_iterator = stl_interfaces::reverse_iterator<iterator>;
+        using const_reverse_iterator =
+            stl_interfaces::reverse_iterator<const_iterator>;
+
+        // construct/copy/destroy (9 members, skipped 2)
+        small_vector() noexcept :
+            data_(inline_data()), size_(0), capacity_(N)
+        {}
+        explicit small_vector(size_type n) : small_vector()
+        {
+            reserve(n);
+            for (; size_ < n; ++size_) {
+                ::new (static_cast<void *>(data_ + size_)) T();
+            }
+        }
+        explicit small_vector(size_type n, T const & x) : small_vector()
+        {
+            reserve(n);
+            std::uninitialized_fill_n(data_, n, x);
+            size_ = n;
+        }
+        template<
+            typename InputIterator,
+            typename Enable = std::enable_if_t<std::is_convertible<
+                typename std::iterator_traits<InputIterator>::iterator_category,
+                std::input_iterator_tag>::value>>
+        small_vector(InputIterator first, InputIterator last) : small_vector()
+        {
+            this->assign(first, last);
+        }
+        small_vector(std::initializer_list<T> il) :
+            small_vector(il.begin(), il.end())
+        {}
+        small_vector(small_vector const & other) : small_vector()
+        {
+            reserve(other.size());
+            std::uninitialized_copy(other.begin(), other.end(), data_);
+            size_ = other.size_;
+        }
+        small_vector(small_vector && other) noexcept(nothrow_relocatable) :
+            small_vector()
+        {
+            steal(other);
+        }
+        // Takes the elements of a static_vector, which is left empty.  They
+        // are relocated rather than copied: one memcpy() when T is trivially
+        // relocatable.
+        template<std::size_t M, std::size_t Align>
+        explicit small_vector(
+            stl_interfaces::static_vector<T, M, Align> && other) :
+            small_vector()
+        {
+            reserve(other.size());
+            size_ = size_type(other.relocate_to(data_) - data_);
+        }
+        small_vector & operator=(small_vector const & other)
+        {
+            if (this != &other) {
+                clear();
+                reserve(other.size());
+                std::uninitialized_copy(other.begin(), other.end(), data_);
+                size_ = other.size_;
+            }
+            return *this;
+        }
+        small_vector & operator=(small_vector && other) noexcept(
+            nothrow_relocatable)
+        {
+            if (this != &other) {
+                clear();
+                if (other.on_heap())
+                    free_heap();
+                steal(other);
+            }
+            return *this;
+        }
+        ~small_vector()
+        {
+            clear();
+            free_heap();
+        }
+
+        // iterators (2 members, skipped 10)
+        iterator begin() noexcept { return data_; }
+        iterator end() noexcept { return data_ + size_; }
+
+        // capacity (6 members, skipped 2)
+        size_type max_size() const noexcept
+        {
+            return (std::numeric_limits<difference_type>::max)() / sizeof(T);
+        }
+        size_type capacity() const noexcept { return capacity_; }
+        void resize(size_type sz, T const & x)
+        {
+            if (sz < size_) {
+                erase(begin() + sz, end());
+                return;
+            }
+            reserve(sz);
+            std::uninitialized_fill(end(), begin() + sz, x);
+            size_ = sz;
+        }
+        void resize(size_type sz, default_init_t)
+        {
+            if (sz < size_) {
+                erase(begin() + sz, end());
+                return;
+            }
+            reserve(sz);
+            for (auto it = end(), last = begin() + sz; it < last; ++it) {
+                ::new (static_cast<void *>(it)) T;
+            }
+            size_ = sz;
+        }
+        void reserve(size_type n)
+        {
+            if (capacity_ < n)
+                reallocate(n, size_, 0, [](T *) {});
+        }
+        // Moves the elements back into the inline buffer if they fit there.
+        void shrink_to_fit()
+        {
+            if (!on_heap() || size_ == capacity_)
+                return;
+            if (size_ <= N) {
+                T * const heap = data_;
+                size_type const heap_capacity = capacity_;
+                move_elements(heap, heap + size_, inline_data());
+                data_ = inline_data();
+                capacity_ = N;
+                deallocate(heap, heap_capacity);
+            } else {
+                reallocate(size_, size_, 0, [](T *) {});
+            }
+        }
+
+        // Returns true if the elements are in the inline buffer.
+        bool is_inline() const noexcept { return !on_heap(); }
+
+        // modifiers (6 members, skipped 9)
+        template<typename... Args>
+        reference emplace_back(Args &&... args)
+        {
+            if (size_ == capacity_) {
+                // The new element is constructed in the new storage before the
+                // old elements are moved, since args may refer to one of them.
+                reallocate(grown_capacity(1), size_, 1, [&](T * p) {
+                    ::new (static_cast<void *>(p))
+                        T(std::forward<Args>(args)...);
+                });
+                ++size_;
+                return this->back();
+            }
+            return unchecked_emplace_back(std::forward<Args>(args)...);
+        }
+        template<typename... Args>
+        reference unchecked_emplace_back(Args &&... args)
+        {
+            assert(size_ < capacity_);
+            auto const position = end();
+            ::new (static_cast<void *>(position))
+                T(std::forward<Args>(args)...);
+            ++size_;
+            return *position;
+        }
+        template<typename... Args>
+        iterator emplace(const_iterator pos, Args &&... args)
+        {
+            auto const i = size_type(pos - data_);
+            if (size_ == capacity_) {
+                reallocate(grown_capacity(1), i, 1, [&](T * p) {
+                    ::new (static_cast<void *>(p))
+                        T(std::forward<Args>(args)...);
+                });
+                ++size_;
+                return data_ + i;
+            }
+            auto const position = data_ + i;
+            if (position == end())
+                return &unchecked_emplace_back(std::forward<Args>(args)...);
+            if (relocatable) {
+                // As in static_vector, the new element is constructed off to
+                // the side first, since args may refer to an element that is
+                // about to be relocated.
+                alignas(T) unsigned char tmp_buf[sizeof(T)];
+                auto const tmp = ::new (static_cast<void *>(tmp_buf))
+                    T(std::forward<Args>(args)...);
+                stl_interfaces::uninitialized_relocate_backward(
+                    position, end(), end() + 1);
+                stl_interfaces::uninitialized_relocate(
+                    tmp, tmp + 1, position);
+                ++size_;
+                return position;
+            }
+            T tmp(std::forward<Args>(args)...);
+            auto const last = end();
+            unchecked_emplace_back(std::move(this->back()));
+            std::move_backward(position, last - 1, last);
+            *position = std::move(tmp);
+            return position;
+        }
+        template<
+            typename ForwardIterator,
+            typename Enable = std::enable_if_t<std::is_convertible<
+                typename std::iterator_traits<
+                    ForwardIterator>::iterator_category,
+                std::forward_iterator_tag>::value>>
+        iterator
+        insert(const_iterator pos, ForwardIterator first, ForwardIterator last)
+        {
+            auto const i = size_type(pos - data_);
+            auto const insertions = size_type(std::distance(first, last));
+            if (capacity_ < size_ + insertions) {
+                // [first, last) may be elements of *this, so they are copied
+                // before the old elements are moved.
+                reallocate(
+                    grown_capacity(insertions), i, insertions, [&](T * p) {
+                        std::uninitialized_copy(first, last, p);
+                    });
+            } else {
+                detail::gap_insert(
+                    data_ + i, end(), first, last, insertions);
+            }
+            size_ += insertions;
+            return data_ + i;
+        }
+        iterator erase(const_iterator f, const_iterator last) noexcept
+        {
+            auto first = const_cast<T *>(f);
+            // Moving the elements after an empty range would assign each of
+            // them to itself.
+            if (first == last)
+                return first;
+            if (relocatable) {
+                for (auto it = first; it != last; ++it) {
+                    it->~T();
+                }
+                stl_interfaces::uninitialized_relocate(
+                    const_cast<T *>(last), end(), first);
+                size_ -= last - first;
+                return first;
+            }
+            auto end_ = this->end();
+            auto it = std::move(const_cast<T *>(last), end_, first);
+            for (; it != end_; ++it) {
+                it->~T();
+            }
+            size_ -= last - first;
+            return first;
+        }
+        void clear() noexcept
+        {
+            detail::destroy(data_, data_ + size_);
+            size_ = 0;
+        }
+        // Relocates the elements to the uninitialized storage at out, and
+        // leaves *this empty, with its capacity.  This is what a
+        // static_vector, or another container, uses to take the elements
+        // without copying them.
+        template<
+            typename U = T,
+            typename Enable = std::enable_if_t<
+                is_trivially_relocatable<U>::value ||
+                std::is_nothrow_move_constructible<U>::value>>
+        T * relocate_to(T * out) noexcept
+        {
+            T * const retval = stl_interfaces::uninitialized_relocate(
+                data_, data_ + size_, out);
+            size_ = 0;
+            return retval;
+        }
+        void swap(small_vector & other) noexcept(nothrow_relocatable)
+        {
+            if (on_heap() && other.on_heap()) {
+                std::swap(data_, other.data_);
+                std::swap(size_, other.size_);
+                std::swap(capacity_, other.capacity_);
+                return;
+            }
+            small_vector temp(std::move(other));
+            other = std::move(*this);
+            *this = std::move(temp);
+        }
+
+        using base_type = container_interface<small_vector<T, N>, contiguous>;
+        using base_type::begin;
+        using base_type::end;
+        using base_type::resize;
+        using base_type::insert;
+        using base_type::erase;
+
+    private:
+        // When T is trivially relocatable, moving the elements to new
+        // storage -- when spilling to the heap, growing, or moving one
+        // small_vector into another -- is a memmove() instead of a move
+        // constructor and destructor call per element.
+        static constexpr bool relocatable =
+            is_trivially_relocatable<T>::value;
+        static constexpr bool nothrow_relocatable =
+            relocatable || std::is_nothrow_move_constructible<T>::value;
+
+        T * inline_data() noexcept { return reinterpret_cast<T *>(buf_); }
+        bool on_heap() const noexcept
+        {
+            return data_ != reinterpret_cast<T const *>(buf_);
+        }
+
+        static T * allocate(size_type n)
+        {
+            return std::allocator<T>().allocate(n);
+        }
+        static void deallocate(T * p, size_type n) noexcept
+        {
+            std::allocator<T>().deallocate(p, n);
+        }
+        void free_heap() noexcept
+        {
+            if (on_heap())
+                deallocate(data_, capacity_);
+            data_ = inline_data();
+            capacity_ = N;
+        }
+
+        size_type grown_capacity(size_type insertions) const noexcept
+        {
+            return (std::max)(size_ + insertions, 2 * capacity_);
+        }
+
+        // Moves [first, last) to the uninitialized storage at out, leaving
+        // [first, last) uninitialized.
+        static void move_elements(T * first, T * last, T * out) noexcept(
+            nothrow_relocatable)
+        {
+            stl_interfaces::uninitialized_relocate(first, last, out);
+        }
+
+        // Moves the elements to new heap storage for `new_capacity` elements,
+        // leaving a gap of `n` elements at index `i`.  `fill(p)` constructs the
+        // elements of the gap at `p`; it is called first, so that it may still
+        // refer to the old elements.  Elements that may throw when moved are
+        // copied instead, so that if anything throws, *this is unchanged.
+        template<typename F>
+        void reallocate(
+            size_type new_capacity, size_type i, size_type n, F fill)
+        {
+            T * const new_data = allocate(new_capacity);
+            try {
+                fill(new_data + i);
+            } catch (...) {
+                deallocate(new_data, new_capacity);
+                throw;
+            }
+            transfer(
+                new_data,
+                new_capacity,
+                i,
+                n,
+                std::integral_constant<
+                    bool,
+                    nothrow_relocatable ||
+                        !std::is_copy_constructible<T>::value>{});
+            if (on_heap())
+                deallocate(data_, capacity_);
+            data_ = new_data;
+            capacity_ = new_capacity;
+        }
+        void transfer(
+            T * new_data,
+            size_type new_capacity,
+            size_type i,
+            size_type n,
+            std::true_type) noexcept(nothrow_relocatable)
+        {
+            move_elements(data_, data_ + i, new_data);
+            move_elements(data_ + i, data_ + size_, new_data + i + n);
+        }
+        void transfer(
+            T * new_data,
+            size_type new_capacity,
+            size_type i,
+            size_type n,
+            std::false_type)
+        {
+            T * prefix_end = new_data;
+            try {
+                prefix_end = std::uninitialized_copy(
+                    data_, data_ + i, new_data);
+                std::uninitialized_copy(
+                    data_ + i, data_ + size_, new_data + i + n);
+            } catch (...) {
+                detail::destroy(new_data, prefix_end);
+                detail::destroy(
+                    new_data + i, new_data + i + n);
+                deallocate(new_data, new_capacity);
+                throw;
+            }
+            detail::destroy(data_, data_ + size_);
+        }
+
+        // Takes the elements of other, which is left empty.  Heap storage is
+        // taken as a whole; inline elements are moved one by one (or all at
+        // once, if relocatable).  Expects *this to be empty, and not on the
+        // heap if other is.
+        void steal(small_vector & other) noexcept(nothrow_relocatable)
+        {
+            if (other.on_heap()) {
+                data_ = other.data_;
+                capacity_ = other.capacity_;
+                other.data_ = other.inline_data();
+                other.capacity_ = N;
+            } else {
+                move_elements(other.begin(), other.end(), data_);
+            }
+            size_ = other.size_;
+            other.size_ = 0;
+        }
+
+        T * data_;
+        size_type size_;
+        size_type capacity_;
+        alignas(T) unsigned char buf_[N * sizeof(T)];
+    };
+    //]
+
+}}}
+
+#endif
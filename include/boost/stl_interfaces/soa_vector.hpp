@@ -0,0 +1,664 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_SOA_VECTOR_HPP
+#define BOOST_STL_INTERFACES_SOA_VECTOR_HPP
+
+#include <boost/stl_interfaces/container_interface.hpp>
+#include <boost/stl_interfaces/reverse_iterator.hpp>
+#include <boost/stl_interfaces/trivially_relocatable.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <tuple>
+#include <utility>
+
+#include <cassert>
+#include <cstdint>
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+    //[ soa_vector_reference
+    // This is the reference type of soa_vector: a tuple of references to the
+    // fields of one element.  Since the fields of an element are stored in
+    // separate arrays, there is no std::tuple<Ts...> object anywhere for a real
+    // reference to refer to.
+    //
+    // Like std::tuple<Ts &...>, soa_reference assigns through its references,
+    // so *it = x writes to the fields of the element it refers to.  Unlike
+    // std::tuple<Ts &...>, it has an associated swap() that swaps the
+    // referred-to fields.  That is what std::sort() and friends need, since
+    // *it is an rvalue, and std::swap() does not take rvalues.  The
+    // zip_proxy_iterator example has to put such a swap() in namespace std;
+    // here, ADL finds it.
+    template<typename... Ts>
+    struct soa_reference : std::tuple<Ts &...>
+    {
+        using base_type = std::tuple<Ts &...>;
+
+        constexpr soa_reference(Ts &... fields) noexcept :
+            base_type(fields...)
+        {}
+        soa_reference(soa_reference const &) = default;
+
+        soa_reference & operator=(soa_reference const & other)
+        {
+            base_type::operator=(other);
+            return *this;
+        }
+        template<typename... Us>
+        soa_reference & operator=(std::tuple<Us...> const & x)
+        {
+            base_type::operator=(x);
+            return *this;
+        }
+        template<typename... Us>
+        soa_reference & operator=(std::tuple<Us...> && x)
+        {
+            base_type::operator=(std::move(x));
+            return *this;
+        }
+
+        friend void swap(soa_reference lhs, soa_reference rhs)
+        {
+            lhs.swap_fields(rhs, std::index_sequence_for<Ts...>{});
+        }
+
+    private:
+        template<std::size_t... Is>
+        void swap_fields(soa_reference & other, std::index_sequence<Is...>)
+        {
+            using std::swap;
+            using swallow = int[];
+            (void)swallow{
+                0, (swap(std::get<Is>(*this), std::get<Is>(other)), 0)...};
+        }
+    };
+    //]
+
+}}}
+
+// These make structured bindings work with soa_reference, as they do with
+// std::tuple.
+namespace std {
+    template<typename... Ts>
+    struct tuple_size<boost::stl_interfaces::soa_reference<Ts...>>
+        : integral_constant<size_t, sizeof...(Ts)>
+    {};
+    template<size_t I, typename... Ts>
+    struct tuple_element<I, boost::stl_interfaces::soa_reference<Ts...>>
+        : tuple_element<I, tuple<Ts &...>>
+    {};
+}
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+    //[ soa_vector_iterator
+    // The iterator holds a pointer to the first element of each field's array,
+    // and an index.  Advancing it touches only the index.  Ts are
+    // const-qualified for const_iterator.
+    template<typename... Ts>
+    struct soa_iterator : proxy_iterator_interface<
+                              soa_iterator<Ts...>,
+                              std::random_access_iterator_tag,
+                              std::tuple<std::remove_const_t<Ts>...>,
+                              soa_reference<Ts...>>
+    {
+        constexpr soa_iterator() noexcept : fields_(), i_(0) {}
+        constexpr soa_iterator(
+            std::tuple<Ts *...> fields, std::ptrdiff_t i) noexcept :
+            fields_(fields),
+            i_(i)
+        {}
+
+        // This is the iterator -> const_iterator conversion.
+        template<
+            typename... Us,
+            typename Enable = std::enable_if_t<std::is_convertible<
+                std::tuple<Us *...>,
+                std::tuple<Ts *...>>::value>>
+        constexpr soa_iterator(soa_iterator<Us...> other) noexcept :
+            fields_(other.fields_),
+            i_(other.i_)
+        {}
+
+        constexpr soa_reference<Ts...> operator*() const noexcept
+        {
+            return deref(std::index_sequence_for<Ts...>{});
+        }
+        constexpr soa_iterator & operator+=(std::ptrdiff_t n) noexcept
+        {
+            i_ += n;
+            return *this;
+        }
+        friend constexpr std::ptrdiff_t
+        operator-(soa_iterator lhs, soa_iterator rhs) noexcept
+        {
+            return lhs.i_ - rhs.i_;
+        }
+
+    private:
+        template<typename... Us>
+        friend struct soa_iterator;
+
+        template<std::size_t... Is>
+        constexpr soa_reference<Ts...> deref(std::index_sequence<Is...>) const
+            noexcept
+        {
+            return soa_reference<Ts...>(std::get<Is>(fields_)[i_]...);
+        }
+
+        std::tuple<Ts *...> fields_;
+        std::ptrdiff_t i_;
+    };
+    //]
+
+    //[ soa_vector_defn
+    // soa_vector<Ts...> is a std::vector-like sequence of std::tuple<Ts...>,
+    // stored as a structure of arrays: each field has its own contiguous array.
+    // Code that scans one field, through data<I>(), touches only the memory
+    // that field occupies; for a few small fields, that is a large fraction of
+    // the memory a std::vector<std::tuple<Ts...>> scan would read.
+    //
+    // The elements are reached through soa_iterator, whose reference type is
+    // the proxy soa_reference.  Because of that, element access returns
+    // soa_reference by value; code that writes auto & x = v[0] will not
+    // compile, and code that needs an element by value should say
+    // std::tuple<Ts...> x = v[0].
+    //
+    // As with static_vector, the comments in each section below count the
+    // members in that section of the std::vector synopsis, and the number
+    // provided by container_interface.
+    template<typename... Ts>
+    struct soa_vector : container_interface<soa_vector<Ts...>>
+    {
+        static_assert(
+            0 < sizeof...(Ts), "soa_vector needs at least one field.");
+
+        using value_type = std::tuple<Ts...>;
+        using reference = soa_reference<Ts...>;
+        using const_reference = soa_reference<Ts const...>;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using iterator = soa_iterator<Ts...>;
+        using const_iterator = soa_iterator<Ts const...>;
+        using reverse_iterator = stl_interfaces::reverse_iterator<iterator>;
+        using const_reverse_iterator =
+            stl_interfaces::reverse_iterator<const_iterator>;
+
+        // The type of the I-th field.
+        template<std::size_t I>
+        using field_type = std::tuple_element_t<I, value_type>;
+
+        // construct/copy/destroy (9 members, skipped 1)
+        //
+        // The destructor must be user-provided, since it frees the field
+        // arrays.
+        soa_vector() noexcept : fields_(), size_(0), capacity_(0) {}
+        explicit soa_vector(size_type n) : soa_vector() { this->resize(n); }
+        explicit soa_vector(size_type n, value_type const & x) : soa_vector()
+        {
+            // container_interface's assign(n, x) constructs a temporary
+            // soa_vector(n, x) when capacity() < n, so we must reserve first.
+            reserve(n);
+            this->assign(n, x);
+        }
+        template<
+            typename ForwardIterator,
+            typename Enable = std::enable_if_t<std::is_convertible<
+                typename std::iterator_traits<
+                    ForwardIterator>::iterator_category,
+                std::forward_iterator_tag>::value>>
+        soa_vector(ForwardIterator first, ForwardIterator last) : soa_vector()
+        {
+            this->assign(first, last);
+        }
+        soa_vector(std::initializer_list<value_type> il) :
+            soa_vector(il.begin(), il.end())
+        {}
+        soa_vector(soa_vector const & other) : soa_vector()
+        {
+            reserve(other.size());
+            this->assign(other.begin(), other.end());
+        }
+        soa_vector(soa_vector && other) noexcept :
+            fields_(other.fields_),
+            size_(other.size_),
+            capacity_(other.capacity_)
+        {
+            other.fields_ = fields();
+            other.size_ = 0;
+            other.capacity_ = 0;
+        }
+        soa_vector & operator=(soa_vector const & other)
+        {
+            soa_vector temp(other);
+            swap(temp);
+            return *this;
+        }
+        soa_vector & operator=(soa_vector && other) noexcept
+        {
+            soa_vector temp(std::move(other));
+            swap(temp);
+            return *this;
+        }
+        ~soa_vector()
+        {
+            free_fields(fields_, size_, capacity_);
+            // container_interface's destructor calls clear(), which must find
+            // nothing left to do.
+            fields_ = fields();
+            size_ = 0;
+            capacity_ = 0;
+        }
+
+        // iterators (2 members, skipped 10)
+        iterator begin() noexcept { return iterator(fields_, 0); }
+        iterator end() noexcept { return iterator(fields_, size_); }
+
+        // capacity (6 members, skipped 3)
+        size_type max_size() const noexcept
+        {
+            return PTRDIFF_MAX / (std::max)({sizeof(Ts)...});
+        }
+        size_type capacity() const noexcept { return capacity_; }
+        void resize(size_type sz, value_type const & x)
+        {
+            if (sz < this->size()) {
+                erase(begin() + sz, end());
+                return;
+            }
+            reserve(sz);
+            while (this->size() < sz) {
+                emplace_back(x);
+            }
+        }
+        // New elements are default-initialized -- left uninitialized, for
+        // fundamental types.  Because we provide this, container_interface
+        // provides resize_for_overwrite(n), which lets a caller fill in a
+        // column at a time.
+        void resize(size_type sz, default_init_t)
+        {
+            if (sz < this->size()) {
+                erase(begin() + sz, end());
+                return;
+            }
+            reserve(sz);
+            default_init(fields_, size_, sz, index<0>{});
+            size_ = sz;
+        }
+        void reserve(size_type n)
+        {
+            if (capacity_ < n)
+                reallocate(n);
+        }
+        void shrink_to_fit()
+        {
+            if (size_ < capacity_)
+                reallocate(size_);
+        }
+
+        // element access (skipped 8)
+        //
+        // container_interface provides operator[], at, front and back.
+
+        // data access (2 members, skipped 0)
+        //
+        // soa_vector is not contiguous -- an element is spread across several
+        // arrays -- so there is no data().  Instead, data<I>() is the array of
+        // the I-th field, which has size() elements.
+        template<std::size_t I>
+        field_type<I> * data() noexcept
+        {
+            return std::get<I>(fields_);
+        }
+        template<std::size_t I>
+        field_type<I> const * data() const noexcept
+        {
+            return std::get<I>(fields_);
+        }
+
+        // modifiers (6 members, skipped 9)
+        //
+        // emplace_back takes one argument per field, or none.  The overloads
+        // that take a std::tuple (including soa_reference, which is derived
+        // from one) are used by push_back, insert, and assign.
+        template<
+            typename... Args,
+            typename Enable = std::enable_if_t<
+                sizeof...(Args) == sizeof...(Ts) &&
+                std::is_same<
+                    std::integer_sequence<
+                        bool,
+                        true,
+                        std::is_constructible<Ts, Args &&>::value...>,
+                    std::integer_sequence<
+                        bool,
+                        std::is_constructible<Ts, Args &&>::value...,
+                        true>>::value>>
+        reference emplace_back(Args &&... args)
+        {
+            return emplace_back_tuple(
+                std::forward_as_tuple(std::forward<Args>(args)...));
+        }
+        reference emplace_back()
+        {
+            return emplace_back_tuple(std::tuple<Ts...>());
+        }
+        template<typename... Us>
+        reference emplace_back(std::tuple<Us...> const & x)
+        {
+            return emplace_back_tuple(x);
+        }
+        template<typename... Us>
+        reference emplace_back(std::tuple<Us...> && x)
+        {
+            return emplace_back_tuple(std::move(x));
+        }
+        template<typename... Args>
+        iterator emplace(const_iterator pos, Args &&... args)
+        {
+            auto const offset = pos - const_iterator(begin());
+            // The new element is constructed at the end first, since args may
+            // refer to an element that is about to move.
+            emplace_back(std::forward<Args>(args)...);
+            rotate(offset, size_ - 1, size_, indices{});
+            return begin() + offset;
+        }
+        template<
+            typename ForwardIterator,
+            typename Enable = std::enable_if_t<std::is_convertible<
+                typename std::iterator_traits<
+                    ForwardIterator>::iterator_category,
+                std::forward_iterator_tag>::value>>
+        iterator
+        insert(const_iterator pos, ForwardIterator first, ForwardIterator last)
+        {
+            auto const offset = pos - const_iterator(begin());
+            auto const old_size = size_;
+            auto const insertions = size_type(std::distance(first, last));
+            if (capacity_ < size_ + insertions)
+                reallocate((std::max)(size_ + insertions, 2 * capacity_));
+            // Append the new elements, and then rotate them into place, one
+            // field at a time.
+            try {
+                for (; first != last; ++first) {
+                    emplace_back(*first);
+                }
+            } catch (...) {
+                erase(begin() + old_size, end());
+                throw;
+            }
+            rotate(offset, old_size, size_, indices{});
+            return begin() + offset;
+        }
+        iterator erase(const_iterator f, const_iterator l)
+        {
+            auto const first = f - const_iterator(begin());
+            auto const last = l - const_iterator(begin());
+            erase_fields(first, last, indices{});
+            size_ -= last - first;
+            return begin() + first;
+        }
+        void swap(soa_vector & other) noexcept
+        {
+            std::swap(fields_, other.fields_);
+            std::swap(size_, other.size_);
+            std::swap(capacity_, other.capacity_);
+        }
+        // This is needed only because std::swap() is also found by ADL whenever
+        // one of Ts is from namespace std, and it and container_interface's
+        // swap() are equally good matches.
+        friend void swap(soa_vector & lhs, soa_vector & rhs) noexcept
+        {
+            lhs.swap(rhs);
+        }
+
+        using base_type = container_interface<soa_vector<Ts...>>;
+        using base_type::begin;
+        using base_type::end;
+        using base_type::resize;
+        using base_type::insert;
+        using base_type::erase;
+
+        // comparisons (skipped 6)
+
+    private:
+        using fields = std::tuple<Ts *...>;
+        using indices = std::index_sequence_for<Ts...>;
+        template<std::size_t I>
+        using index = std::integral_constant<std::size_t, I>;
+        using end_index = index<sizeof...(Ts)>;
+
+        // Each of the helpers below that takes an index<I> operates on fields I
+        // and up, recursively.  If the operation throws for field J, the fields
+        // in [I, J) are put back the way they were.
+
+        template<std::size_t I>
+        static void allocate(fields & f, size_type n, index<I>)
+        {
+            std::allocator<field_type<I>> a;
+            std::get<I>(f) = a.allocate(n);
+            try {
+                allocate(f, n, index<I + 1>{});
+            } catch (...) {
+                a.deallocate(std::get<I>(f), n);
+                throw;
+            }
+        }
+        static void allocate(fields &, size_type, end_index) noexcept {}
+
+        // Constructs the i-th element of each field from the corresponding
+        // element of the tuple x.
+        template<typename Tuple, std::size_t I>
+        static void construct(
+            fields const & f, size_type i, Tuple && x, index<I>)
+        {
+            auto const p = std::get<I>(f) + i;
+            ::new (static_cast<void *>(p))
+                field_type<I>(std::get<I>(std::forward<Tuple>(x)));
+            try {
+                construct(f, i, std::forward<Tuple>(x), index<I + 1>{});
+            } catch (...) {
+                p->~field_type<I>();
+                throw;
+            }
+        }
+        template<typename Tuple>
+        static void construct(fields const &, size_type, Tuple &&, end_index)
+        {}
+
+        template<std::size_t I>
+        static void default_init(
+            fields const & f, size_type first, size_type last, index<I>)
+        {
+            auto const p = std::get<I>(f);
+            auto i = first;
+            try {
+                for (; i < last; ++i) {
+                    ::new (static_cast<void *>(p + i)) field_type<I>;
+                }
+                default_init(f, first, last, index<I + 1>{});
+            } catch (...) {
+                destroy(p + first, p + i);
+                throw;
+            }
+        }
+        static void
+        default_init(fields const &, size_type, size_type, end_index) noexcept
+        {}
+
+        // Moves (or, if moving may throw, copies) the first n elements of each
+        // field of from to the uninitialized arrays of to.
+        template<std::size_t I>
+        static void uninitialized_move(
+            fields const & from, size_type n, fields const & to, index<I>)
+        {
+            using T = field_type<I>;
+            using iter = std::conditional_t<
+                !std::is_nothrow_move_constructible<T>::value &&
+                    std::is_copy_constructible<T>::value,
+                T const *,
+                std::move_iterator<T *>>;
+            auto const first = std::get<I>(from);
+            auto const out = std::get<I>(to);
+            std::uninitialized_copy(iter(first), iter(first + n), out);
+            try {
+                uninitialized_move(from, n, to, index<I + 1>{});
+            } catch (...) {
+                destroy(out, out + n);
+                throw;
+            }
+        }
+        static void
+        uninitialized_move(fields const &, size_type, fields const &, end_index)
+        {}
+
+        template<typename T>
+        static void destroy(T * first, T * last) noexcept
+        {
+            for (; first != last; ++first) {
+                first->~T();
+            }
+        }
+        template<std::size_t... Is>
+        static void destroy_elements(
+            fields const & f,
+            size_type first,
+            size_type last,
+            std::index_sequence<Is...>) noexcept
+        {
+            using swallow = int[];
+            (void)swallow{
+                0,
+                (destroy(std::get<Is>(f) + first, std::get<Is>(f) + last),
+                 0)...};
+        }
+        template<std::size_t... Is>
+        static void deallocate(
+            fields const & f, size_type n, std::index_sequence<Is...>) noexcept
+        {
+            if (!n)
+                return;
+            using swallow = int[];
+            (void)swallow{
+                0,
+                (std::allocator<field_type<Is>>().deallocate(
+                     std::get<Is>(f), n),
+                 0)...};
+        }
+        static void free_fields(
+            fields const & f, size_type size, size_type capacity) noexcept
+        {
+            destroy_elements(f, 0, size, indices{});
+            deallocate(f, capacity, indices{});
+        }
+
+        // Allocates new arrays with room for n elements, and moves the elements
+        // into them.
+        fields allocate_and_move(size_type n) const
+        {
+            fields retval{};
+            if (n)
+                allocate(retval, n, index<0>{});
+            try {
+                uninitialized_move(fields_, size_, retval, index<0>{});
+            } catch (...) {
+                deallocate(retval, n, indices{});
+                throw;
+            }
+            return retval;
+        }
+        void reallocate(size_type n)
+        {
+            assert(size_ <= n);
+            auto const new_fields = n ? allocate_and_move(n) : fields();
+            free_fields(fields_, size_, capacity_);
+            fields_ = new_fields;
+            capacity_ = n;
+        }
+
+        template<typename Tuple>
+        reference emplace_back_tuple(Tuple && x)
+        {
+            if (size_ == capacity_) {
+                // As with std::vector, x may refer to an element of *this, so
+                // the new element is constructed before the old ones move.
+                auto const new_capacity =
+                    (std::max)(size_type(1), 2 * capacity_);
+                fields new_fields{};
+                allocate(new_fields, new_capacity, index<0>{});
+                try {
+                    construct(
+                        new_fields, size_, std::forward<Tuple>(x), index<0>{});
+                } catch (...) {
+                    deallocate(new_fields, new_capacity, indices{});
+                    throw;
+                }
+                try {
+                    uninitialized_move(fields_, size_, new_fields, index<0>{});
+                } catch (...) {
+                    destroy_elements(new_fields, size_, size_ + 1, indices{});
+                    deallocate(new_fields, new_capacity, indices{});
+                    throw;
+                }
+                free_fields(fields_, size_, capacity_);
+                fields_ = new_fields;
+                capacity_ = new_capacity;
+            } else {
+                construct(fields_, size_, std::forward<Tuple>(x), index<0>{});
+            }
+            ++size_;
+            return begin()[size_ - 1];
+        }
+
+        template<std::size_t... Is>
+        void rotate(
+            size_type first,
+            size_type middle,
+            size_type last,
+            std::index_sequence<Is...>)
+        {
+            using swallow = int[];
+            (void)swallow{
+                0,
+                (std::rotate(
+                     std::get<Is>(fields_) + first,
+                     std::get<Is>(fields_) + middle,
+                     std::get<Is>(fields_) + last),
+                 0)...};
+        }
+        template<std::size_t... Is>
+        void erase_fields(
+            size_type first, size_type last, std::index_sequence<Is...>)
+        {
+            using swallow = int[];
+            (void)swallow{
+                0,
+                (std::move(
+                     std::get<Is>(fields_) + last,
+                     std::get<Is>(fields_) + size_,
+                     std::get<Is>(fields_) + first),
+                 0)...};
+            destroy_elements(fields_, size_ - (last - first), size_, indices{});
+        }
+
+        fields fields_;
+        size_type size_;
+        size_type capacity_;
+    };
+
+    // A soa_vector is a few pointers and sizes, so it can always be relocated
+    // by copying its bytes.
+    template<typename... Ts>
+    struct is_trivially_relocatable<soa_vector<Ts...>> : std::true_type
+    {};
+    //]
+
+}}}
+
+#endif
@@ -0,0 +1,249 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_SPARSE_SET_HPP
+#define BOOST_STL_INTERFACES_SPARSE_SET_HPP
+
+#include <boost/stl_interfaces/container_interface.hpp>
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <initializer_list>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+    template<typename Index>
+    struct sparse_set;
+
+    /** `sparse_set` keeps its indices in `std::vector`s, which free
+        themselves, so `container_interface` does not need to call
+        `clear()`. */
+    template<typename Index>
+    struct trivially_destructible_container<sparse_set<Index>>
+        : std::true_type
+    {
+    };
+
+    /** A set of non-negative integers, kept in two arrays: a dense one,
+        which holds the indices in the set, contiguously and in no
+        particular order; and a sparse one, indexed by index, which holds
+        each index's position in the dense array.  Inserting, erasing, and
+        looking up an index are O(1), with no hashing, and iterating visits
+        only the dense array, so it is as fast as iterating a
+        `std::vector<Index>`.  `data()` points to the dense array, so the
+        algorithms of `algorithm.hpp` run on it directly.  This is the usual
+        index of the entities that have a given component in an
+        entity-component system.
+
+        The sparse array grows to one more than the largest index ever
+        inserted, and never shrinks.  Erasing an index moves the last
+        element of the dense array into its place; a parallel array of
+        per-index data kept at the same positions, such as the components
+        themselves, should do the same.  `position()` gives an index's
+        position.  Iterators are pointers into the dense array, and are
+        invalidated by insertions and erasures.
+
+        Sets with the same indices in different orders compare equal, and
+        there is no `operator<()`.
+
+        \see `container_interface` */
+    template<typename Index>
+    struct sparse_set
+        : container_interface<sparse_set<Index>, contiguous>
+    {
+        static_assert(std::is_integral<Index>::value, "");
+
+        using key_type = Index;
+        using value_type = Index;
+        using reference = Index const &;
+        using const_reference = Index const &;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using iterator = Index const *;
+        using const_iterator = Index const *;
+        using reverse_iterator = stl_interfaces::reverse_iterator<iterator>;
+        using const_reverse_iterator = reverse_iterator;
+
+        sparse_set() noexcept {}
+        /** Makes an empty set with room for the indices `[0, universe)`
+            without growing the sparse array. */
+        explicit sparse_set(size_type universe) { sparse_.resize(universe); }
+        template<
+            typename InputIterator,
+            typename Enable = std::enable_if_t<std::is_convertible<
+                typename std::iterator_traits<
+                    InputIterator>::iterator_category,
+                std::input_iterator_tag>::value>>
+        sparse_set(InputIterator first, InputIterator last)
+        {
+            insert(first, last);
+        }
+        sparse_set(std::initializer_list<Index> il) :
+            sparse_set(il.begin(), il.end())
+        {}
+
+        iterator begin() noexcept { return dense_.data(); }
+        iterator end() noexcept { return dense_.data() + dense_.size(); }
+
+        /** Returns a pointer to the dense array, which may be null if the
+            set is empty. */
+        Index const * data() const noexcept { return dense_.data(); }
+
+        size_type size() const noexcept { return dense_.size(); }
+        size_type max_size() const noexcept { return dense_.max_size(); }
+        /** Returns one more than the largest index that the set can hold
+            without growing its sparse array. */
+        size_type universe() const noexcept { return sparse_.size(); }
+        /** Makes room for the indices `[0, universe)` in the sparse array,
+            and for `universe` of them in the dense one. */
+        void reserve(size_type universe)
+        {
+            if (sparse_.size() < universe)
+                sparse_.resize(universe);
+            dense_.reserve(universe);
+        }
+
+        /** Inserts `i`, if it is not already in the set.  Returns the
+            position of `i`, and whether it was inserted.
+            \pre `0 <= i` */
+        std::pair<iterator, bool> insert(Index i)
+        {
+            auto const index = size_type(i);
+            if (contains(i)) {
+                return std::pair<iterator, bool>(
+                    begin() + sparse_[index], false);
+            }
+            if (sparse_.size() <= index)
+                sparse_.resize((std::max)(index + 1, 2 * sparse_.size()));
+            sparse_[index] = Index(dense_.size());
+            dense_.push_back(i);
+            return std::pair<iterator, bool>(end() - 1, true);
+        }
+        std::pair<iterator, bool> emplace(Index i) { return insert(i); }
+        template<
+            typename InputIterator,
+            typename Enable = std::enable_if_t<std::is_convertible<
+                typename std::iterator_traits<
+                    InputIterator>::iterator_category,
+                std::input_iterator_tag>::value>>
+        void insert(InputIterator first, InputIterator last)
+        {
+            for (; first != last; ++first) {
+                insert(*first);
+            }
+        }
+        void insert(std::initializer_list<Index> il)
+        {
+            insert(il.begin(), il.end());
+        }
+
+        /** Erases the element at `pos`, by moving the last element into its
+            place.  Returns `pos`, which then refers to the moved element, or
+            is `end()`. */
+        iterator erase(const_iterator pos) noexcept
+        {
+            auto const n = pos - begin();
+            Index const last = dense_.back();
+            dense_[n] = last;
+            sparse_[size_type(last)] = Index(n);
+            dense_.pop_back();
+            return begin() + n;
+        }
+        /** Erases the elements of `[first, last)`, from the back; the
+            elements after `last` move into the positions they leave. */
+        iterator erase(const_iterator first, const_iterator last) noexcept
+        {
+            auto const n = first - begin();
+            while (last != first) {
+                erase(--last);
+            }
+            return begin() + n;
+        }
+        /** Erases `i`, if it is in the set.  Returns the number of elements
+            erased.  This is a template so that `erase(0)` means the index,
+            and not a null `const_iterator`. */
+        template<
+            typename Integer,
+            typename Enable =
+                std::enable_if_t<std::is_integral<Integer>::value>>
+        size_type erase(Integer i) noexcept
+        {
+            if (!contains(Index(i)))
+                return 0;
+            erase(begin() + sparse_[size_type(i)]);
+            return 1;
+        }
+        /** Erases the elements, and keeps the sparse array; the set is
+            empty after an O(1) clear, since `contains()` checks that an
+            index's position is in the dense array. */
+        void clear() noexcept { dense_.clear(); }
+        void swap(sparse_set & other) noexcept
+        {
+            dense_.swap(other.dense_);
+            sparse_.swap(other.sparse_);
+        }
+
+        /** Swaps `lhs` and `rhs`. */
+        friend void swap(sparse_set & lhs, sparse_set & rhs) noexcept
+        {
+            lhs.swap(rhs);
+        }
+
+        bool contains(Index i) const noexcept
+        {
+            // A negative i is a very large index.
+            auto const index = size_type(i);
+            if (sparse_.size() <= index)
+                return false;
+            auto const n = size_type(sparse_[index]);
+            return n < dense_.size() && dense_[n] == i;
+        }
+        size_type count(Index i) const noexcept { return contains(i); }
+        const_iterator find(Index i) const noexcept
+        {
+            return contains(i) ? data() + sparse_[size_type(i)]
+                               : data() + size();
+        }
+        /** Returns the position of `i` in the dense array.
+            \pre `contains(i)` */
+        size_type position(Index i) const noexcept
+        {
+            BOOST_ASSERT(contains(i));
+            return size_type(sparse_[size_type(i)]);
+        }
+
+        /** Returns true if `lhs` and `rhs` hold the same indices, in any
+            order. */
+        friend bool
+        operator==(sparse_set const & lhs, sparse_set const & rhs) noexcept
+        {
+            return lhs.size() == rhs.size() &&
+                   std::all_of(lhs.begin(), lhs.end(), [&](Index i) {
+                       return rhs.contains(i);
+                   });
+        }
+        friend bool
+        operator<(sparse_set const &, sparse_set const &) = delete;
+
+        using base_type = container_interface<sparse_set<Index>, contiguous>;
+        using base_type::begin;
+        using base_type::end;
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+    private:
+        std::vector<Index> dense_;
+        std::vector<Index> sparse_;
+#endif
+    };
+
+}}}
+
+#endif
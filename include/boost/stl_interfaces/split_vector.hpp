@@ -0,0 +1,553 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_SPLIT_VECTOR_HPP
+#define BOOST_STL_INTERFACES_SPLIT_VECTOR_HPP
+
+#include <boost/stl_interfaces/container_interface.hpp>
+#include <boost/stl_interfaces/reverse_iterator.hpp>
+#include <boost/stl_interfaces/trivially_relocatable.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <utility>
+
+#include <cassert>
+#include <cstdint>
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+    //[ split_vector_reference
+    // The value type of split_vector: a record, split into the fields that are
+    // read often and the fields that are not.
+    template<typename Hot, typename Cold>
+    struct split_value
+    {
+        Hot hot;
+        Cold cold;
+
+        friend bool operator==(split_value const & lhs, split_value const & rhs)
+        {
+            return lhs.hot == rhs.hot && lhs.cold == rhs.cold;
+        }
+        friend bool operator!=(split_value const & lhs, split_value const & rhs)
+        {
+            return !(lhs == rhs);
+        }
+        friend bool operator<(split_value const & lhs, split_value const & rhs)
+        {
+            return lhs.hot < rhs.hot ||
+                   (!(rhs.hot < lhs.hot) && lhs.cold < rhs.cold);
+        }
+    };
+
+    // The reference type of split_vector.  The two halves of an element live in
+    // different arrays, so a reference to one is a pair of references, named
+    // like the members of split_value, so that r.hot.price reads the same
+    // through either.  As with soa_vector's soa_reference, assignment writes
+    // through the references, and the associated swap() swaps the referred-to
+    // halves, which is what std::sort() needs.
+    template<typename Hot, typename Cold>
+    struct split_reference
+    {
+        using value_type =
+            split_value<std::remove_const_t<Hot>, std::remove_const_t<Cold>>;
+
+        constexpr split_reference(Hot & h, Cold & c) noexcept :
+            hot(h), cold(c)
+        {}
+        split_reference(split_reference const &) = default;
+
+        split_reference & operator=(split_reference const & other)
+        {
+            hot = other.hot;
+            cold = other.cold;
+            return *this;
+        }
+        split_reference & operator=(value_type const & x)
+        {
+            hot = x.hot;
+            cold = x.cold;
+            return *this;
+        }
+        split_reference & operator=(value_type && x)
+        {
+            hot = std::move(x.hot);
+            cold = std::move(x.cold);
+            return *this;
+        }
+
+        operator value_type() const { return value_type{hot, cold}; }
+
+        friend void swap(split_reference lhs, split_reference rhs)
+        {
+            using std::swap;
+            swap(lhs.hot, rhs.hot);
+            swap(lhs.cold, rhs.cold);
+        }
+
+        friend bool operator==(split_reference lhs, split_reference rhs)
+        {
+            return lhs.hot == rhs.hot && lhs.cold == rhs.cold;
+        }
+        friend bool operator!=(split_reference lhs, split_reference rhs)
+        {
+            return !(lhs == rhs);
+        }
+        friend bool operator<(split_reference lhs, split_reference rhs)
+        {
+            return lhs.hot < rhs.hot ||
+                   (!(rhs.hot < lhs.hot) && lhs.cold < rhs.cold);
+        }
+
+        Hot & hot;
+        Cold & cold;
+    };
+    //]
+
+    //[ split_vector_iterator
+    // Like soa_iterator, the iterator is the two arrays' first elements and an
+    // index.  Hot and Cold are const-qualified for const_iterator.
+    template<typename Hot, typename Cold>
+    struct split_vector_iterator
+        : proxy_iterator_interface<
+              split_vector_iterator<Hot, Cold>,
+              std::random_access_iterator_tag,
+              split_value<std::remove_const_t<Hot>, std::remove_const_t<Cold>>,
+              split_reference<Hot, Cold>>
+    {
+        constexpr split_vector_iterator() noexcept : hot_(), cold_(), i_(0) {}
+        constexpr split_vector_iterator(
+            Hot * hot, Cold * cold, std::ptrdiff_t i) noexcept :
+            hot_(hot),
+            cold_(cold),
+            i_(i)
+        {}
+
+        // This is the iterator -> const_iterator conversion.
+        template<
+            typename H,
+            typename C,
+            typename Enable = std::enable_if_t<
+                std::is_convertible<H *, Hot *>::value &&
+                std::is_convertible<C *, Cold *>::value>>
+        constexpr split_vector_iterator(
+            split_vector_iterator<H, C> other) noexcept :
+            hot_(other.hot_),
+            cold_(other.cold_),
+            i_(other.i_)
+        {}
+
+        constexpr split_reference<Hot, Cold> operator*() const noexcept
+        {
+            return split_reference<Hot, Cold>(hot_[i_], cold_[i_]);
+        }
+        constexpr split_vector_iterator & operator+=(std::ptrdiff_t n) noexcept
+        {
+            i_ += n;
+            return *this;
+        }
+        friend constexpr std::ptrdiff_t
+        operator-(split_vector_iterator lhs, split_vector_iterator rhs) noexcept
+        {
+            return lhs.i_ - rhs.i_;
+        }
+
+    private:
+        template<typename H, typename C>
+        friend struct split_vector_iterator;
+
+        Hot * hot_;
+        Cold * cold_;
+        std::ptrdiff_t i_;
+    };
+    //]
+
+    //[ split_vector_defn
+    // split_vector<Hot, Cold> is a std::vector-like sequence of records, each
+    // stored in two halves: the Hot halves in one contiguous array, and the
+    // Cold halves in another.  It is soa_vector with exactly two fields, each
+    // of which is usually a struct of several members.  When most scans read a
+    // few small members of a large record -- a price and a quantity, out of an
+    // order's 200 bytes -- putting those members in Hot means a scan through
+    // hot_data() reads a few cache lines per hundred records instead of a few
+    // per record, while code that needs a whole record still gets one, through
+    // the proxy reference.
+    //
+    // As with soa_vector, element access returns split_reference by value; code
+    // that needs an element by value should say split_value<Hot, Cold> x =
+    // v[0].
+    template<typename Hot, typename Cold>
+    struct split_vector : container_interface<split_vector<Hot, Cold>>
+    {
+        using value_type = split_value<Hot, Cold>;
+        using reference = split_reference<Hot, Cold>;
+        using const_reference = split_reference<Hot const, Cold const>;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using iterator = split_vector_iterator<Hot, Cold>;
+        using const_iterator = split_vector_iterator<Hot const, Cold const>;
+        using reverse_iterator = stl_interfaces::reverse_iterator<iterator>;
+        using const_reverse_iterator =
+            stl_interfaces::reverse_iterator<const_iterator>;
+
+        // construct/copy/destroy (9 members, skipped 1)
+        //
+        // The destructor must be user-provided, since it frees the arrays.
+        split_vector() noexcept : hot_(), cold_(), size_(0), capacity_(0) {}
+        explicit split_vector(size_type n) : split_vector() { this->resize(n); }
+        explicit split_vector(size_type n, value_type const & x) :
+            split_vector()
+        {
+            // container_interface's assign(n, x) constructs a temporary
+            // split_vector(n, x) when capacity() < n, so we must reserve first.
+            reserve(n);
+            this->assign(n, x);
+        }
+        template<
+            typename ForwardIterator,
+            typename Enable = std::enable_if_t<std::is_convertible<
+                typename std::iterator_traits<
+                    ForwardIterator>::iterator_category,
+                std::forward_iterator_tag>::value>>
+        split_vector(ForwardIterator first, ForwardIterator last) :
+            split_vector()
+        {
+            this->assign(first, last);
+        }
+        split_vector(std::initializer_list<value_type> il) :
+            split_vector(il.begin(), il.end())
+        {}
+        split_vector(split_vector const & other) : split_vector()
+        {
+            reserve(other.size());
+            this->assign(other.begin(), other.end());
+        }
+        split_vector(split_vector && other) noexcept :
+            hot_(other.hot_),
+            cold_(other.cold_),
+            size_(other.size_),
+            capacity_(other.capacity_)
+        {
+            other.hot_ = nullptr;
+            other.cold_ = nullptr;
+            other.size_ = 0;
+            other.capacity_ = 0;
+        }
+        split_vector & operator=(split_vector const & other)
+        {
+            split_vector temp(other);
+            swap(temp);
+            return *this;
+        }
+        split_vector & operator=(split_vector && other) noexcept
+        {
+            split_vector temp(std::move(other));
+            swap(temp);
+            return *this;
+        }
+        ~split_vector()
+        {
+            free_arrays(hot_, cold_, size_, capacity_);
+            // container_interface's destructor calls clear(), which must find
+            // nothing left to do.
+            hot_ = nullptr;
+            cold_ = nullptr;
+            size_ = 0;
+            capacity_ = 0;
+        }
+
+        // iterators (2 members, skipped 10)
+        iterator begin() noexcept { return iterator(hot_, cold_, 0); }
+        iterator end() noexcept { return iterator(hot_, cold_, size_); }
+
+        // capacity (5 members, skipped 3)
+        size_type max_size() const noexcept
+        {
+            return PTRDIFF_MAX / (std::max)(sizeof(Hot), sizeof(Cold));
+        }
+        size_type capacity() const noexcept { return capacity_; }
+        void resize(size_type sz, value_type const & x)
+        {
+            if (sz < this->size()) {
+                erase(begin() + sz, end());
+                return;
+            }
+            reserve(sz);
+            while (this->size() < sz) {
+                emplace_back(x);
+            }
+        }
+        void reserve(size_type n)
+        {
+            if (capacity_ < n)
+                reallocate(n);
+        }
+        void shrink_to_fit()
+        {
+            if (size_ < capacity_)
+                reallocate(size_);
+        }
+
+        // element access (skipped 8)
+        //
+        // container_interface provides operator[], at, front and back.
+
+        // data access (4 members, skipped 0)
+        //
+        // An element is spread across two arrays, so there is no data().
+        // Instead, hot_data() and cold_data() are the arrays of each half,
+        // which have size() elements.
+        Hot * hot_data() noexcept { return hot_; }
+        Hot const * hot_data() const noexcept { return hot_; }
+        Cold * cold_data() noexcept { return cold_; }
+        Cold const * cold_data() const noexcept { return cold_; }
+
+        // modifiers (6 members, skipped 9)
+        //
+        // emplace_back takes the two halves, or none, or one split_value or
+        // split_reference, which is what push_back, insert, and assign use.
+        template<
+            typename H,
+            typename C,
+            typename Enable = std::enable_if_t<
+                std::is_constructible<Hot, H &&>::value &&
+                std::is_constructible<Cold, C &&>::value>>
+        reference emplace_back(H && h, C && c)
+        {
+            if (size_ == capacity_) {
+                // As with std::vector, h and c may refer to an element of
+                // *this, so the new element is constructed before the old ones
+                // move.
+                auto const new_capacity =
+                    (std::max)(size_type(1), 2 * capacity_);
+                Hot * new_hot = std::allocator<Hot>().allocate(new_capacity);
+                Cold * new_cold = nullptr;
+                try {
+                    new_cold = std::allocator<Cold>().allocate(new_capacity);
+                    construct(
+                        new_hot + size_,
+                        new_cold + size_,
+                        std::forward<H>(h),
+                        std::forward<C>(c));
+                } catch (...) {
+                    deallocate(new_hot, new_cold, new_capacity);
+                    throw;
+                }
+                try {
+                    move_arrays(new_hot, new_cold);
+                } catch (...) {
+                    destroy_elements(new_hot, new_cold, size_, size_ + 1);
+                    deallocate(new_hot, new_cold, new_capacity);
+                    throw;
+                }
+                free_arrays(hot_, cold_, size_, capacity_);
+                hot_ = new_hot;
+                cold_ = new_cold;
+                capacity_ = new_capacity;
+            } else {
+                construct(
+                    hot_ + size_,
+                    cold_ + size_,
+                    std::forward<H>(h),
+                    std::forward<C>(c));
+            }
+            ++size_;
+            return begin()[size_ - 1];
+        }
+        reference emplace_back() { return emplace_back(Hot(), Cold()); }
+        template<
+            typename X,
+            typename Enable = decltype(
+                std::declval<X>().hot, std::declval<X>().cold, (void)0)>
+        reference emplace_back(X && x)
+        {
+            // When x is an rvalue split_value, its members are rvalues, and are
+            // moved from; the members of a split_reference are always lvalues.
+            return emplace_back(
+                std::forward<X>(x).hot, std::forward<X>(x).cold);
+        }
+        template<typename... Args>
+        iterator emplace(const_iterator pos, Args &&... args)
+        {
+            auto const offset = pos - const_iterator(begin());
+            // The new element is constructed at the end first, since args may
+            // refer to an element that is about to move.
+            emplace_back(std::forward<Args>(args)...);
+            rotate(offset, size_ - 1, size_);
+            return begin() + offset;
+        }
+        template<
+            typename ForwardIterator,
+            typename Enable = std::enable_if_t<std::is_convertible<
+                typename std::iterator_traits<
+                    ForwardIterator>::iterator_category,
+                std::forward_iterator_tag>::value>>
+        iterator
+        insert(const_iterator pos, ForwardIterator first, ForwardIterator last)
+        {
+            auto const offset = pos - const_iterator(begin());
+            auto const old_size = size_;
+            auto const insertions = size_type(std::distance(first, last));
+            if (capacity_ < size_ + insertions)
+                reallocate((std::max)(size_ + insertions, 2 * capacity_));
+            // Append the new elements, and then rotate them into place, one
+            // array at a time.
+            try {
+                for (; first != last; ++first) {
+                    emplace_back(*first);
+                }
+            } catch (...) {
+                erase(begin() + old_size, end());
+                throw;
+            }
+            rotate(offset, old_size, size_);
+            return begin() + offset;
+        }
+        iterator erase(const_iterator f, const_iterator l)
+        {
+            auto const first = f - const_iterator(begin());
+            auto const last = l - const_iterator(begin());
+            std::move(hot_ + last, hot_ + size_, hot_ + first);
+            std::move(cold_ + last, cold_ + size_, cold_ + first);
+            destroy_elements(hot_, cold_, size_ - (last - first), size_);
+            size_ -= last - first;
+            return begin() + first;
+        }
+        void swap(split_vector & other) noexcept
+        {
+            std::swap(hot_, other.hot_);
+            std::swap(cold_, other.cold_);
+            std::swap(size_, other.size_);
+            std::swap(capacity_, other.capacity_);
+        }
+        // As with soa_vector, this keeps std::swap() from being an equally good
+        // match when Hot or Cold is from namespace std.
+        friend void swap(split_vector & lhs, split_vector & rhs) noexcept
+        {
+            lhs.swap(rhs);
+        }
+
+        using base_type = container_interface<split_vector<Hot, Cold>>;
+        using base_type::begin;
+        using base_type::end;
+        using base_type::resize;
+        using base_type::insert;
+        using base_type::erase;
+
+        // comparisons (skipped 6)
+
+    private:
+        template<typename H, typename C>
+        static void construct(Hot * hot, Cold * cold, H && h, C && c)
+        {
+            ::new (static_cast<void *>(hot)) Hot(std::forward<H>(h));
+            try {
+                ::new (static_cast<void *>(cold)) Cold(std::forward<C>(c));
+            } catch (...) {
+                hot->~Hot();
+                throw;
+            }
+        }
+
+        template<typename T>
+        static void destroy(T * first, T * last) noexcept
+        {
+            for (; first != last; ++first) {
+                first->~T();
+            }
+        }
+        static void destroy_elements(
+            Hot * hot, Cold * cold, size_type first, size_type last) noexcept
+        {
+            destroy(hot + first, hot + last);
+            destroy(cold + first, cold + last);
+        }
+        static void deallocate(Hot * hot, Cold * cold, size_type n) noexcept
+        {
+            if (hot)
+                std::allocator<Hot>().deallocate(hot, n);
+            if (cold)
+                std::allocator<Cold>().deallocate(cold, n);
+        }
+        static void free_arrays(
+            Hot * hot, Cold * cold, size_type size, size_type capacity) noexcept
+        {
+            destroy_elements(hot, cold, 0, size);
+            deallocate(hot, cold, capacity);
+        }
+
+        // Moves (or, if moving may throw, copies) the first n elements of from
+        // to the uninitialized array to.
+        template<typename T>
+        static void uninitialized_move(T * from, size_type n, T * to)
+        {
+            using iter = std::conditional_t<
+                !std::is_nothrow_move_constructible<T>::value &&
+                    std::is_copy_constructible<T>::value,
+                T const *,
+                std::move_iterator<T *>>;
+            std::uninitialized_copy(iter(from), iter(from + n), to);
+        }
+        // Moves the elements into the uninitialized arrays new_hot and
+        // new_cold.
+        void move_arrays(Hot * new_hot, Cold * new_cold) const
+        {
+            uninitialized_move(hot_, size_, new_hot);
+            try {
+                uninitialized_move(cold_, size_, new_cold);
+            } catch (...) {
+                destroy(new_hot, new_hot + size_);
+                throw;
+            }
+        }
+
+        // Allocates new arrays with room for n elements, and moves the elements
+        // into them.
+        void reallocate(size_type n)
+        {
+            assert(size_ <= n);
+            Hot * new_hot = nullptr;
+            Cold * new_cold = nullptr;
+            if (n) {
+                try {
+                    new_hot = std::allocator<Hot>().allocate(n);
+                    new_cold = std::allocator<Cold>().allocate(n);
+                    move_arrays(new_hot, new_cold);
+                } catch (...) {
+                    deallocate(new_hot, new_cold, n);
+                    throw;
+                }
+            }
+            free_arrays(hot_, cold_, size_, capacity_);
+            hot_ = new_hot;
+            cold_ = new_cold;
+            capacity_ = n;
+        }
+
+        void rotate(size_type first, size_type middle, size_type last)
+        {
+            std::rotate(hot_ + first, hot_ + middle, hot_ + last);
+            std::rotate(cold_ + first, cold_ + middle, cold_ + last);
+        }
+
+        Hot * hot_;
+        Cold * cold_;
+        size_type size_;
+        size_type capacity_;
+    };
+
+    // A split_vector is two pointers and two sizes, so it can always be
+    // relocated by copying its bytes.
+    template<typename Hot, typename Cold>
+    struct is_trivially_relocatable<split_vector<Hot, Cold>> : std::true_type
+    {};
+    //]
+
+}}}
+
+#endif
@@ -0,0 +1,221 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_SPLIT_VIEW_HPP
+#define BOOST_STL_INTERFACES_SPLIT_VIEW_HPP
+
+#include <boost/stl_interfaces/iterator_interface.hpp>
+#include <boost/stl_interfaces/view_interface.hpp>
+
+#include <string>
+
+#include <cstddef>
+#include <cstring>
+
+#if 201703L <= __cplusplus && __has_include(<string_view>)
+#include <string_view>
+#define BOOST_STL_INTERFACES_SPLIT_VIEW_HAS_STRING_VIEW 1
+#else
+#define BOOST_STL_INTERFACES_SPLIT_VIEW_HAS_STRING_VIEW 0
+#endif
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+    //[ char_span_defn
+    // A piece of the range being split, as a view of its chars.  In C++17 and
+    // later, it converts to std::string_view.
+    struct char_span : view_interface<char_span, element_layout::contiguous>
+    {
+        char_span() noexcept : first_(nullptr), last_(nullptr) {}
+        char_span(char const * first, char const * last) noexcept :
+            first_(first),
+            last_(last)
+        {}
+
+        char const * begin() const noexcept { return first_; }
+        char const * end() const noexcept { return last_; }
+        std::size_t size() const noexcept
+        {
+            return std::size_t(last_ - first_);
+        }
+
+        std::string str() const { return std::string(first_, last_); }
+#if BOOST_STL_INTERFACES_SPLIT_VIEW_HAS_STRING_VIEW
+        operator std::string_view() const noexcept
+        {
+            return std::string_view(first_, size());
+        }
+#endif
+
+        friend bool operator==(char_span lhs, char_span rhs) noexcept
+        {
+            return lhs.size() == rhs.size() &&
+                   (!lhs.size() ||
+                    !std::memcmp(lhs.first_, rhs.first_, lhs.size()));
+        }
+        friend bool operator!=(char_span lhs, char_span rhs) noexcept
+        {
+            return !(lhs == rhs);
+        }
+
+    private:
+        char const * first_;
+        char const * last_;
+    };
+    //]
+
+    // Whether a delimiter at the end of a range separates the last piece from
+    // an empty one after it, as with std::views::split(), or just ends the last
+    // piece, as with the lines of a text file.
+    enum class split_mode : unsigned char { separated, terminated };
+
+    //[ split_iterator
+    // A forward iterator over the pieces of a char range between delimiters.
+    // There is an empty piece between two adjacent delimiters.
+    //
+    // The iterator finds the end of each piece as it gets to it, with
+    // std::memchr(), which the standard library implements with the widest
+    // vector instructions the target has (SSE2, AVX2, NEON, ...), and which
+    // compilers treat as a builtin.  So a long piece is searched many bytes at
+    // a time, with no per-byte branch.
+    struct split_iterator : proxy_iterator_interface<
+                                split_iterator,
+                                std::forward_iterator_tag,
+                                char_span>
+    {
+        split_iterator() noexcept :
+            first_(nullptr),
+            next_(nullptr),
+            last_(nullptr),
+            delimiter_(0),
+            mode_(split_mode::separated),
+            trailing_empty_(false)
+        {}
+        split_iterator(
+            char const * first,
+            char const * last,
+            char delimiter,
+            split_mode mode) noexcept :
+            first_(first),
+            next_(find(first, last, delimiter)),
+            last_(last),
+            delimiter_(delimiter),
+            mode_(mode),
+            trailing_empty_(false)
+        {}
+
+        char_span operator*() const noexcept
+        {
+            return char_span(first_, next_);
+        }
+        split_iterator & operator++() noexcept
+        {
+            if (next_ == last_) {
+                first_ = last_;
+                trailing_empty_ = false;
+            } else {
+                first_ = next_ + 1;
+                next_ = find(first_, last_, delimiter_);
+                trailing_empty_ =
+                    first_ == last_ && mode_ == split_mode::separated;
+            }
+            return *this;
+        }
+        friend bool operator==(split_iterator lhs, split_iterator rhs) noexcept
+        {
+            return lhs.first_ == rhs.first_ &&
+                   lhs.trailing_empty_ == rhs.trailing_empty_;
+        }
+
+        using base_type = proxy_iterator_interface<
+            split_iterator,
+            std::forward_iterator_tag,
+            char_span>;
+        using base_type::operator++;
+
+    private:
+        static char const *
+        find(char const * first, char const * last, char delimiter) noexcept
+        {
+            if (first == last)
+                return last;
+            auto const p = static_cast<char const *>(
+                std::memchr(first, delimiter, std::size_t(last - first)));
+            return p ? p : last;
+        }
+
+        char const * first_; // The start of the current piece.
+        char const * next_;  // Its end: the next delimiter, or last_.
+        char const * last_;
+        char delimiter_;
+        split_mode mode_;
+        // True for the empty piece after a delimiter at the end.
+        bool trailing_empty_;
+    };
+    //]
+
+    //[ split_view_defn
+    // The pieces of a contiguous range of chars between delimiters, as
+    // char_spans into the range.  Nothing is copied.  An empty range has no
+    // pieces.
+    struct split_view : view_interface<split_view>
+    {
+        split_view() noexcept :
+            first_(nullptr),
+            last_(nullptr),
+            delimiter_(0),
+            mode_(split_mode::separated)
+        {}
+        split_view(
+            char const * first,
+            char const * last,
+            char delimiter,
+            split_mode mode = split_mode::separated) noexcept :
+            first_(first),
+            last_(last),
+            delimiter_(delimiter),
+            mode_(mode)
+        {}
+        split_view(
+            char_span chars,
+            char delimiter,
+            split_mode mode = split_mode::separated) noexcept :
+            split_view(chars.begin(), chars.end(), delimiter, mode)
+        {}
+
+        split_iterator begin() const noexcept
+        {
+            return first_ == last_
+                       ? end()
+                       : split_iterator(first_, last_, delimiter_, mode_);
+        }
+        split_iterator end() const noexcept
+        {
+            return split_iterator(last_, last_, delimiter_, mode_);
+        }
+
+    private:
+        char const * first_;
+        char const * last_;
+        char delimiter_;
+        split_mode mode_;
+    };
+
+    // The lines of text in [first, last), each ended by a '\n', except perhaps
+    // the last.
+    inline split_view lines(char const * first, char const * last) noexcept
+    {
+        return split_view(first, last, '\n', split_mode::terminated);
+    }
+    inline split_view lines(std::string const & s) noexcept
+    {
+        return lines(s.data(), s.data() + s.size());
+    }
+    //]
+
+}}}
+
+#endif
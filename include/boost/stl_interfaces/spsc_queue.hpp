@@ -0,0 +1,209 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_SPSC_QUEUE_HPP
+#define BOOST_STL_INTERFACES_SPSC_QUEUE_HPP
+
+#include <boost/stl_interfaces/view_interface.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <type_traits>
+#include <utility>
+
+#include <cassert>
+#include <cstddef>
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+    //[ slot_span
+    // A contiguous span of slots in an spsc_queue.  view_interface provides
+    // empty(), size(), data(), operator[](), front(), and back().
+    template<typename T>
+    struct slot_span : view_interface<slot_span<T>, contiguous>
+    {
+        slot_span() noexcept : first_(nullptr), last_(nullptr) {}
+        slot_span(T * first, T * last) noexcept : first_(first), last_(last) {}
+
+        T * begin() const noexcept { return first_; }
+        T * end() const noexcept { return last_; }
+
+    private:
+        T * first_;
+        T * last_;
+    };
+    //]
+
+    //[ spsc_queue_defn
+    // A lock-free, fixed-capacity queue for one producer thread and one
+    // consumer thread, in a ring of N slots, as in circular_buffer<T, N>.
+    //
+    // Instead of pushing and popping one element at a time, each with its own
+    // atomic operation, the producer can ask for write_span() -- a writable
+    // span of free slots -- fill any number of them, and publish them all with
+    // one atomic store in commit_write().  Likewise, the consumer can ask for
+    // read_span(), a span of ready slots, and release them with one store in
+    // commit_read().  Each span is contiguous, so it ends at the end of the
+    // slots; the rest of the free or ready slots start at the beginning, and
+    // the next call returns them.  The bulk write() and read() members copy up
+    // to two spans each, and commit them together.
+    //
+    // The slots always hold T objects: the producer assigns to them, and
+    // elements that the consumer leaves in place are only destroyed when they
+    // are overwritten, or when the queue is destroyed.  So T must be default
+    // constructible and assignable.
+    //
+    // The producer's index (tail_) and the consumer's index (head_) are on
+    // separate cache lines, so that each thread writes only to its own line.
+    // Each thread also keeps a copy of the other thread's index on its own
+    // line, so that it only reads the other thread's line when the copy says
+    // the queue is full (for the producer) or empty (for the consumer).
+    //
+    // The members in the "producer" section may only be used by one thread at
+    // a time, and the same goes for the "consumer" section.
+    template<typename T, std::size_t N>
+    struct spsc_queue
+    {
+        static_assert(0 < N && (N & (N - 1)) == 0, "N must be a power of two.");
+        static_assert(std::is_default_constructible<T>::value, "");
+
+        // The size of the cache lines kept apart.
+        static constexpr std::size_t cache_line = 64;
+
+        using value_type = T;
+        using size_type = std::size_t;
+        using span_type = slot_span<T>;
+
+        spsc_queue() noexcept(std::is_nothrow_default_constructible<T>::value) :
+            tail_(0),
+            head_cache_(0),
+            head_(0),
+            tail_cache_(0)
+        {}
+        spsc_queue(spsc_queue const &) = delete;
+        spsc_queue & operator=(spsc_queue const &) = delete;
+
+        static constexpr size_type capacity() noexcept { return N; }
+        // The number of ready elements.  This is only a snapshot if the other
+        // thread is running.
+        size_type size() const noexcept
+        {
+            auto const head = head_.load(std::memory_order_acquire);
+            return tail_.load(std::memory_order_acquire) - head;
+        }
+        bool empty() const noexcept { return !size(); }
+
+        // producer
+
+        // Returns the free slots that follow the last element, up to the end of
+        // the slots.  The other thread's index is only read if fewer than
+        // min_size slots are known to be free.
+        span_type write_span(size_type min_size = 1) noexcept
+        {
+            auto const tail = tail_.load(std::memory_order_relaxed);
+            if (N - (tail - head_cache_) < min_size)
+                head_cache_ = head_.load(std::memory_order_acquire);
+            return span(tail, N - (tail - head_cache_));
+        }
+        // Publishes the first n slots of the last write_span().
+        void commit_write(size_type n) noexcept
+        {
+            auto const tail = tail_.load(std::memory_order_relaxed);
+            assert(n <= N - (tail - head_cache_));
+            tail_.store(tail + n, std::memory_order_release);
+        }
+        template<typename U>
+        bool push(U && x)
+        {
+            auto const s = write_span();
+            if (s.empty())
+                return false;
+            s[0] = std::forward<U>(x);
+            commit_write(1);
+            return true;
+        }
+        // Copies as many of [first, first + n) as there are free slots, and
+        // publishes them together.  Returns the number copied.
+        size_type write(T const * first, size_type n)
+        {
+            auto const tail = tail_.load(std::memory_order_relaxed);
+            if (N - (tail - head_cache_) < n)
+                head_cache_ = head_.load(std::memory_order_acquire);
+            n = (std::min)(n, N - (tail - head_cache_));
+            auto const one = span(tail, n);
+            std::copy(first, first + one.size(), one.begin());
+            std::copy(first + one.size(), first + n, slots_);
+            tail_.store(tail + n, std::memory_order_release);
+            return n;
+        }
+
+        // consumer
+
+        // Returns the ready slots starting at the first element, up to the end
+        // of the slots.  The other thread's index is only read if fewer than
+        // min_size elements are known to be ready.
+        span_type read_span(size_type min_size = 1) noexcept
+        {
+            auto const head = head_.load(std::memory_order_relaxed);
+            if (tail_cache_ - head < min_size)
+                tail_cache_ = tail_.load(std::memory_order_acquire);
+            return span(head, tail_cache_ - head);
+        }
+        // Releases the first n slots of the last read_span() to the producer.
+        void commit_read(size_type n) noexcept
+        {
+            auto const head = head_.load(std::memory_order_relaxed);
+            assert(n <= tail_cache_ - head);
+            head_.store(head + n, std::memory_order_release);
+        }
+        bool pop(T & x)
+        {
+            auto const s = read_span();
+            if (s.empty())
+                return false;
+            x = std::move(s[0]);
+            commit_read(1);
+            return true;
+        }
+        // Moves up to n ready elements to out, and releases their slots
+        // together.  Returns the number moved.
+        size_type read(T * out, size_type n)
+        {
+            auto const head = head_.load(std::memory_order_relaxed);
+            if (tail_cache_ - head < n)
+                tail_cache_ = tail_.load(std::memory_order_acquire);
+            n = (std::min)(n, tail_cache_ - head);
+            auto const one = span(head, n);
+            out = std::move(one.begin(), one.end(), out);
+            std::move(slots_, slots_ + (n - one.size()), out);
+            head_.store(head + n, std::memory_order_release);
+            return n;
+        }
+
+    private:
+        // The first min(n, slots to the end) slots starting at index.
+        span_type span(size_type index, size_type n) noexcept
+        {
+            auto const first = index & (N - 1);
+            n = (std::min)(n, N - first);
+            return span_type(slots_ + first, slots_ + first + n);
+        }
+
+        // Written by the producer.
+        alignas(cache_line) std::atomic<size_type> tail_;
+        size_type head_cache_;
+
+        // Written by the consumer.
+        alignas(cache_line) std::atomic<size_type> head_;
+        size_type tail_cache_;
+
+        alignas(cache_line) T slots_[N];
+    };
+    //]
+
+}}}
+
+#endif
@@ -0,0 +1,495 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_STATIC_PERFECT_MAP_HPP
+#define BOOST_STL_INTERFACES_STATIC_PERFECT_MAP_HPP
+
+#include <boost/stl_interfaces/container_interface.hpp>
+#include <boost/stl_interfaces/iterator_interface.hpp>
+#include <boost/stl_interfaces/static_string.hpp>
+
+#include <cstdint>
+#include <initializer_list>
+#include <stdexcept>
+#include <type_traits>
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+    template<typename K, typename V, std::size_t N, typename Hash>
+    struct static_perfect_map;
+
+    /** `static_perfect_map` has no destructor of its own to run, so
+        `container_interface` does not need to call `clear()`. */
+    template<typename K, typename V, std::size_t N, typename Hash>
+    struct trivially_destructible_container<static_perfect_map<K, V, N, Hash>>
+        : std::true_type
+    {
+    };
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    namespace v1_dtl {
+        // The splitmix64 finalizer.
+        constexpr std::uint64_t perfect_mix(std::uint64_t x) noexcept
+        {
+            x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+            x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+            return x ^ (x >> 31);
+        }
+
+        // Little-endian, whatever the target; optimizers turn these into
+        // single loads where the target is little-endian.
+        constexpr std::uint64_t
+        perfect_read(char const * p, int bytes) noexcept
+        {
+            std::uint64_t x = 0;
+            for (int i = 0; i < bytes; ++i) {
+                x |= std::uint64_t(static_cast<unsigned char>(p[i]))
+                     << (8 * i);
+            }
+            return x;
+        }
+        constexpr std::uint64_t perfect_read8(char const * p) noexcept
+        {
+            return v1_dtl::perfect_read(p, 8);
+        }
+        constexpr std::uint64_t perfect_read4(char const * p) noexcept
+        {
+            return v1_dtl::perfect_read(p, 4);
+        }
+
+        // The last word overlaps the one before it, rather than being read
+        // a byte at a time; a short string is read as two overlapping
+        // halves.
+        constexpr std::uint64_t perfect_hash_chars(
+            char const * p, std::size_t n, std::uint64_t seed) noexcept
+        {
+            std::uint64_t h = seed ^ (n * 0x9e3779b97f4a7c15ull);
+            std::uint64_t last = 0;
+            if (8 <= n) {
+                char const * const end = p + n - 8;
+                for (; p < end; p += 8) {
+                    h = v1_dtl::perfect_mix(h ^ v1_dtl::perfect_read8(p));
+                }
+                last = v1_dtl::perfect_read8(end);
+            } else if (4 <= n) {
+                last = (v1_dtl::perfect_read4(p) << 32) |
+                       v1_dtl::perfect_read4(p + n - 4);
+            } else if (n) {
+                last = (std::uint64_t(static_cast<unsigned char>(p[0]))
+                        << 16) |
+                       (std::uint64_t(static_cast<unsigned char>(p[n / 2]))
+                        << 8) |
+                       static_cast<unsigned char>(p[n - 1]);
+            }
+            return v1_dtl::perfect_mix(h ^ last);
+        }
+
+        template<typename K>
+        using perfect_chars_t = decltype(
+            std::declval<char const *&>() = std::declval<K const &>().data(),
+            std::declval<std::size_t &>() = std::declval<K const &>().size());
+
+        template<typename K, typename L>
+        constexpr bool
+        perfect_key_equal_impl(K const & k, L const & l, std::false_type)
+        {
+            return k == l;
+        }
+        template<typename K, typename L>
+        constexpr bool
+        perfect_key_equal_impl(K const & k, L const & l, std::true_type)
+        {
+            return k.size() == l.size() &&
+                   !v1_dtl::string_compare_chars(k.data(), l.data(), k.size());
+        }
+        template<typename K, typename L>
+        constexpr bool perfect_key_equal(K const & k, L const & l)
+        {
+            return v1_dtl::perfect_key_equal_impl(
+                k,
+                l,
+                std::integral_constant<
+                    bool,
+                    detail::detector<void, perfect_chars_t, K>::value &&
+                        detail::detector<void, perfect_chars_t, L>::value>{});
+        }
+        constexpr bool
+        perfect_key_equal(char const * k, char const * l) noexcept
+        {
+            std::size_t const n = v1_dtl::string_length(k);
+            return n == v1_dtl::string_length(l) &&
+                   !v1_dtl::string_compare_chars(k, l, n);
+        }
+
+        // Maps the high half of h to a bucket in [0, buckets), by
+        // multiplying instead of dividing.
+        constexpr std::size_t
+        perfect_bucket(std::uint64_t h, std::size_t buckets) noexcept
+        {
+            return std::size_t(((h >> 32) * buckets) >> 32);
+        }
+        // Maps h, displaced by its bucket's pilot, to a slot in [0, n).
+        constexpr std::size_t perfect_slot(
+            std::uint64_t h, std::uint64_t pilot, std::size_t n) noexcept
+        {
+            std::uint64_t const x =
+                (h ^ (pilot * 0x9e3779b97f4a7c15ull)) * 0xff51afd7ed558ccdull;
+            return std::size_t(((x >> 32) * n) >> 32);
+        }
+    }
+
+#endif
+
+    /** The hash that `static_perfect_map` uses by default: a seeded 64-bit
+        hash that is usable in constant expressions.  It is defined for
+        integral and enumeration types, for `char const *` null-terminated
+        strings, and for any type with `data()` and `size()` members that
+        give a `char const *` and a length, such as `std::string_view` and
+        `static_string`.  Specialize it for other key types, with a
+        `constexpr std::uint64_t operator()(K const &, std::uint64_t seed)
+        const`, whose results for different seeds are independent. */
+    template<typename K, typename Enable = void>
+    struct perfect_hash;
+
+    template<typename K>
+    struct perfect_hash<
+        K,
+        std::enable_if_t<std::is_integral<K>::value || std::is_enum<K>::value>>
+    {
+        constexpr std::uint64_t
+        operator()(K k, std::uint64_t seed) const noexcept
+        {
+            return v1_dtl::perfect_mix(
+                (static_cast<std::uint64_t>(k) ^ seed) +
+                0x9e3779b97f4a7c15ull);
+        }
+    };
+
+    template<>
+    struct perfect_hash<char const *>
+    {
+        constexpr std::uint64_t
+        operator()(char const * k, std::uint64_t seed) const noexcept
+        {
+            return v1_dtl::perfect_hash_chars(
+                k, v1_dtl::string_length(k), seed);
+        }
+    };
+
+    template<typename K>
+    struct perfect_hash<
+        K,
+        std::enable_if_t<
+            detail::detector<void, v1_dtl::perfect_chars_t, K>::value>>
+    {
+        constexpr std::uint64_t
+        operator()(K const & k, std::uint64_t seed) const noexcept
+        {
+            return v1_dtl::perfect_hash_chars(k.data(), k.size(), seed);
+        }
+    };
+
+    /** The element type of `static_perfect_map`: an aggregate, like a
+        `std::pair` with no constructors, so that it can be assigned in a
+        constant expression in C++14.  Its members are value-initialized by
+        default, which a constant expression requires. */
+    template<typename K, typename V>
+    struct perfect_map_entry
+    {
+        K first{};
+        V second{};
+    };
+
+    /** The random access iterator of `static_perfect_map`, over its array
+        of entries. */
+    template<typename K, typename V>
+    struct perfect_map_iterator : iterator_interface<
+                                      perfect_map_iterator<K, V>,
+                                      std::random_access_iterator_tag,
+                                      perfect_map_entry<K, V> const>
+    {
+        constexpr perfect_map_iterator() noexcept : it_(nullptr) {}
+        constexpr explicit perfect_map_iterator(
+            perfect_map_entry<K, V> const * it) noexcept :
+            it_(it)
+        {}
+
+        constexpr perfect_map_entry<K, V> const & operator*() const noexcept
+        {
+            return *it_;
+        }
+        // iterator_interface's operator->() goes through std::addressof(),
+        // which is not constexpr before C++17.
+        constexpr perfect_map_entry<K, V> const * operator->() const noexcept
+        {
+            return it_;
+        }
+        constexpr perfect_map_iterator & operator+=(std::ptrdiff_t n) noexcept
+        {
+            it_ += n;
+            return *this;
+        }
+        friend constexpr std::ptrdiff_t
+        operator-(perfect_map_iterator lhs, perfect_map_iterator rhs) noexcept
+        {
+            return lhs.it_ - rhs.it_;
+        }
+
+    private:
+        perfect_map_entry<K, V> const * it_;
+    };
+
+    /** An immutable map of `N` keys, laid out by a minimal perfect hash
+        function that is found when the map is constructed -- at compile
+        time, for a `constexpr` map.  Looking up a key takes one hash of the
+        key, one load of its bucket's pilot value, and one comparison with
+        the only entry the key can be in, so a lookup never probes, and
+        costs the same whether or not the key is present.  A `constexpr
+        static_perfect_map` is built by the compiler, and placed in read-only
+        data, with no work at startup.
+
+        The hash function is found the way PTHash finds one: each key's
+        hash picks one of `N` buckets; the buckets are placed from the
+        largest to the smallest, each by searching for a pilot value that
+        displaces all its keys into free slots at once.  The entries are
+        stored in slot order, which is the iteration order, and there are no
+        empty slots.  Besides the entries, the map holds one 16-bit pilot
+        value per key (32-bit, past 4096 keys).
+
+        `K` must be hashable by `Hash` (see `perfect_hash`) and equality
+        comparable; `K` and `V` must be default constructible and copy
+        assignable, and literal types for a `constexpr` map.  Constructing
+        the map with duplicate keys throws `std::invalid_argument`, which
+        is a compile-time error for a `constexpr` map.  `N` is the number of
+        keys, and must be at least 1.
+
+        \see `container_interface` */
+    template<
+        typename K,
+        typename V,
+        std::size_t N,
+        typename Hash = perfect_hash<K>>
+    struct static_perfect_map
+        : container_interface<static_perfect_map<K, V, N, Hash>>
+    {
+        static_assert(0 < N, "A static_perfect_map must have keys.");
+        static_assert(
+            N <= 0xffffffffu,
+            "A static_perfect_map can have at most 2^32 - 1 keys.");
+
+        using key_type = K;
+        using mapped_type = V;
+        using value_type = perfect_map_entry<K, V>;
+        using hasher = Hash;
+        using reference = value_type const &;
+        using const_reference = value_type const &;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using iterator = perfect_map_iterator<K, V>;
+        using const_iterator = iterator;
+        using reverse_iterator = stl_interfaces::reverse_iterator<iterator>;
+        using const_reverse_iterator = reverse_iterator;
+        using pilot_type = std::
+            conditional_t<N <= 4096, std::uint16_t, std::uint32_t>;
+
+        /** Makes a map of the `N` entries in `entries`.
+            \throw std::invalid_argument if two of the keys are equal. */
+        constexpr static_perfect_map(value_type const (&entries)[N]) :
+            entries_(), pilots_(), seed_(0)
+        {
+            build(entries);
+        }
+        /** Makes a map of the entries in `il`.
+            \throw std::invalid_argument if `il.size() != N`, or if two of
+            the keys are equal. */
+        constexpr static_perfect_map(std::initializer_list<value_type> il) :
+            entries_(), pilots_(), seed_(0)
+        {
+            if (il.size() != N) {
+                throw std::invalid_argument(
+                    "static_perfect_map needs exactly N entries.");
+            }
+            build(il.begin());
+        }
+
+        constexpr iterator begin() const noexcept
+        {
+            return iterator(entries_);
+        }
+        constexpr iterator end() const noexcept
+        {
+            return iterator(entries_ + N);
+        }
+
+        constexpr size_type size() const noexcept { return N; }
+        constexpr size_type max_size() const noexcept { return N; }
+
+        /** Returns the entry for `k`, or `end()` if there is none. */
+        constexpr const_iterator find(K const & k) const
+        {
+            size_type const i = slot(Hash{}(k, seed_));
+            return v1_dtl::perfect_key_equal(entries_[i].first, k)
+                       ? begin() + i
+                       : end();
+        }
+        constexpr bool contains(K const & k) const
+        {
+            return v1_dtl::perfect_key_equal(
+                entries_[slot(Hash{}(k, seed_))].first, k);
+        }
+        constexpr size_type count(K const & k) const { return contains(k); }
+        /** Returns the value for `k`, or `default_value` if there is
+            none. */
+        constexpr V const & get(K const & k, V const & default_value) const
+        {
+            value_type const & e = entries_[slot(Hash{}(k, seed_))];
+            return v1_dtl::perfect_key_equal(e.first, k) ? e.second
+                                                         : default_value;
+        }
+
+        using base_type = container_interface<static_perfect_map>;
+        using base_type::begin;
+        using base_type::end;
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+    private:
+        static constexpr size_type bucket_count = N;
+        // Past this many seeds, the keys have a 64-bit hash collision that
+        // no seed avoids, which means Hash is broken.
+        static constexpr int max_seeds = 64;
+
+        constexpr size_type slot(std::uint64_t h) const noexcept
+        {
+            return v1_dtl::perfect_slot(
+                h,
+                pilots_[v1_dtl::perfect_bucket(h, bucket_count)],
+                N);
+        }
+
+        constexpr void build(value_type const * entries)
+        {
+            for (int i = 0; i < max_seeds; ++i) {
+                seed_ = v1_dtl::perfect_mix(std::uint64_t(i));
+                if (try_build(entries))
+                    return;
+            }
+            throw std::invalid_argument(
+                "static_perfect_map could not find a perfect hash; the "
+                "keys' hashes collide.");
+        }
+
+        constexpr bool try_build(value_type const * entries)
+        {
+            std::uint64_t hashes[N] = {};
+            size_type buckets[N] = {};
+            // keys[starts[b], starts[b + 1]) are the keys in bucket b.
+            size_type starts[bucket_count + 1] = {};
+            size_type keys[N] = {};
+            size_type slots[N] = {};
+            bool taken[N] = {};
+
+            for (size_type i = 0; i < N; ++i) {
+                hashes[i] = Hash{}(entries[i].first, seed_);
+                buckets[i] = v1_dtl::perfect_bucket(hashes[i], bucket_count);
+                ++starts[buckets[i] + 1];
+            }
+            size_type largest = 0;
+            for (size_type b = 0; b < bucket_count; ++b) {
+                if (largest < starts[b + 1])
+                    largest = starts[b + 1];
+                starts[b + 1] += starts[b];
+            }
+            {
+                size_type next[bucket_count] = {};
+                for (size_type i = 0; i < N; ++i) {
+                    size_type const b = buckets[i];
+                    keys[starts[b] + next[b]++] = i;
+                }
+            }
+
+            for (size_type n = largest; 0 < n; --n) {
+                for (size_type b = 0; b < bucket_count; ++b) {
+                    size_type const first = starts[b];
+                    size_type const last = starts[b + 1];
+                    if (last - first != n)
+                        continue;
+                    for (size_type i = first; i < last; ++i) {
+                        for (size_type j = first; j < i; ++j) {
+                            if (hashes[keys[i]] != hashes[keys[j]])
+                                continue;
+                            if (v1_dtl::perfect_key_equal(
+                                    entries[keys[i]].first,
+                                    entries[keys[j]].first)) {
+                                throw std::invalid_argument(
+                                    "static_perfect_map keys must be "
+                                    "unique.");
+                            }
+                            return false;
+                        }
+                    }
+                    if (!place(hashes, keys + first, n, slots, taken, b))
+                        return false;
+                }
+            }
+
+            for (size_type i = 0; i < N; ++i) {
+                entries_[slots[i]] = entries[i];
+            }
+            return true;
+        }
+
+        // Finds a pilot for bucket b that puts each of its n keys in a free
+        // slot, and takes the slots.
+        constexpr bool place(
+            std::uint64_t const * hashes,
+            size_type const * keys,
+            size_type n,
+            size_type * slots,
+            bool * taken,
+            size_type b)
+        {
+            pilot_type const last_pilot = pilot_type(-1);
+            for (pilot_type pilot = 0;; ++pilot) {
+                size_type placed = 0;
+                for (; placed < n; ++placed) {
+                    size_type const s =
+                        v1_dtl::perfect_slot(hashes[keys[placed]], pilot, N);
+                    if (taken[s])
+                        break;
+                    taken[s] = true;
+                    slots[keys[placed]] = s;
+                }
+                if (placed == n) {
+                    pilots_[b] = pilot;
+                    return true;
+                }
+                for (size_type i = 0; i < placed; ++i) {
+                    taken[slots[keys[i]]] = false;
+                }
+                if (pilot == last_pilot)
+                    return false;
+            }
+        }
+
+        value_type entries_[N];
+        pilot_type pilots_[bucket_count];
+        std::uint64_t seed_;
+#endif
+    };
+
+    /** Makes a `static_perfect_map` of the entries in `entries`, with `N`
+        deduced from their number. */
+    template<typename K, typename V, std::size_t N>
+    constexpr static_perfect_map<K, V, N>
+    make_static_perfect_map(perfect_map_entry<K, V> const (&entries)[N])
+    {
+        return static_perfect_map<K, V, N>(entries);
+    }
+
+}}}
+
+#endif
@@ -0,0 +1,566 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_STATIC_STRING_HPP
+#define BOOST_STL_INTERFACES_STATIC_STRING_HPP
+
+#include <boost/stl_interfaces/container_interface.hpp>
+#include <boost/stl_interfaces/hash.hpp>
+#include <boost/stl_interfaces/trivially_relocatable.hpp>
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <string>
+#if 201703L <= __cplusplus && defined(__cpp_lib_string_view)
+#include <string_view>
+#endif
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+    template<std::size_t N, std::size_t Align = 1>
+    struct static_string;
+
+    /** `static_string` has no destructor of its own to run, so
+        `container_interface` does not need to call `clear()`. */
+    template<std::size_t N, std::size_t Align>
+    struct trivially_destructible_container<static_string<N, Align>>
+        : std::true_type
+    {
+    };
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    namespace v1_dtl {
+        constexpr std::size_t string_npos = std::size_t(-1);
+
+        // The smallest unsigned type that can hold a size up to N.
+        template<std::size_t N>
+        using string_size_t = std::conditional_t<
+            N <= 0xff,
+            std::uint8_t,
+            std::conditional_t<
+                N <= 0xffff,
+                std::uint16_t,
+                std::conditional_t<
+                    N <= 0xffffffff,
+                    std::uint32_t,
+                    std::size_t>>>;
+
+        // The chars in a static_string's buffer: N and the null, or, for an
+        // Align above 1, enough to fill them out to a multiple of Align.
+        template<std::size_t N, std::size_t Align>
+        constexpr std::size_t string_slots() noexcept
+        {
+            return (N + 1 + Align - 1) / Align * Align;
+        }
+
+        // The helpers below use the C library where they can, and loops in
+        // constant evaluation, where it is not allowed.  Where constant
+        // evaluation cannot be detected, they always use the C library, and
+        // static_string is not usable in constant expressions.
+#ifdef BOOST_STL_INTERFACES_CONSTANT_EVALUATED
+#define BOOST_STL_INTERFACES_STRING_AT_RUNTIME()                               \
+    !BOOST_STL_INTERFACES_CONSTANT_EVALUATED()
+#else
+#define BOOST_STL_INTERFACES_STRING_AT_RUNTIME() true
+#endif
+
+        constexpr std::size_t string_length(char const * s) noexcept
+        {
+            if (BOOST_STL_INTERFACES_STRING_AT_RUNTIME())
+                return std::char_traits<char>::length(s);
+            std::size_t n = 0;
+            for (; s[n]; ++n) {
+            }
+            return n;
+        }
+
+        // Copies [s, s + n) to [d, d + n), front to back; d may be before s
+        // in the same array.
+        constexpr void
+        string_copy(char * d, char const * s, std::size_t n) noexcept
+        {
+            if (BOOST_STL_INTERFACES_STRING_AT_RUNTIME()) {
+                if (n)
+                    std::memmove(d, s, n);
+                return;
+            }
+            for (std::size_t i = 0; i < n; ++i) {
+                d[i] = s[i];
+            }
+        }
+
+        // Like string_copy(), back to front; d may be after s in the same
+        // array.
+        constexpr void
+        string_copy_backward(char * d, char const * s, std::size_t n) noexcept
+        {
+            if (BOOST_STL_INTERFACES_STRING_AT_RUNTIME()) {
+                if (n)
+                    std::memmove(d, s, n);
+                return;
+            }
+            for (std::size_t i = n; i--;) {
+                d[i] = s[i];
+            }
+        }
+
+        constexpr void string_fill(char * d, std::size_t n, char c) noexcept
+        {
+            if (BOOST_STL_INTERFACES_STRING_AT_RUNTIME()) {
+                if (n)
+                    std::memset(d, c, n);
+                return;
+            }
+            for (std::size_t i = 0; i < n; ++i) {
+                d[i] = c;
+            }
+        }
+
+        // Searches with memchr(), by way of char_traits.  For strings this
+        // short, the C library's vectorized memchr() beats the find() of
+        // algorithm.hpp, whose setup is not paid back over a few vectors.
+        constexpr std::size_t
+        string_find(char const * s, std::size_t n, char c, std::size_t pos)
+        {
+            if (n <= pos)
+                return string_npos;
+            if (BOOST_STL_INTERFACES_STRING_AT_RUNTIME()) {
+                auto const it =
+                    std::char_traits<char>::find(s + pos, n - pos, c);
+                return it ? std::size_t(it - s) : string_npos;
+            }
+            for (std::size_t i = pos; i < n; ++i) {
+                if (s[i] == c)
+                    return i;
+            }
+            return string_npos;
+        }
+
+        // Orders characters as unsigned, as std::string does.
+        constexpr int string_compare_chars(
+            char const * a, char const * b, std::size_t n) noexcept
+        {
+            if (BOOST_STL_INTERFACES_STRING_AT_RUNTIME())
+                return n ? std::char_traits<char>::compare(a, b, n) : 0;
+            for (std::size_t i = 0; i < n; ++i) {
+                auto const x = static_cast<unsigned char>(a[i]);
+                auto const y = static_cast<unsigned char>(b[i]);
+                if (x != y)
+                    return x < y ? -1 : 1;
+            }
+            return 0;
+        }
+
+        // Each candidate is found with a memchr() for the first character
+        // of the needle, and checked with memcmp().
+        constexpr std::size_t string_find(
+            char const * s,
+            std::size_t n,
+            char const * needle,
+            std::size_t m,
+            std::size_t pos)
+        {
+            if (n < pos || n - pos < m)
+                return string_npos;
+            if (!m)
+                return pos;
+            std::size_t const last = n - m + 1;
+            for (std::size_t i = pos;; ++i) {
+                i = v1_dtl::string_find(s, last, *needle, i);
+                if (i == string_npos)
+                    return string_npos;
+                if (!v1_dtl::string_compare_chars(
+                        s + i + 1, needle + 1, m - 1))
+                    return i;
+            }
+        }
+
+        constexpr int string_compare(
+            char const * a, std::size_t n, char const * b, std::size_t m)
+        {
+            int const cmp =
+                v1_dtl::string_compare_chars(a, b, n < m ? n : m);
+            if (cmp)
+                return cmp;
+            return n < m ? -1 : (m < n ? 1 : 0);
+        }
+
+        constexpr void string_reverse(char * first, char * last) noexcept
+        {
+            for (; first < last && first < --last; ++first) {
+                char const c = *first;
+                *first = *last;
+                *last = c;
+            }
+        }
+
+        // Rotates [first, last) so that middle comes first.
+        constexpr void
+        string_rotate(char * first, char * middle, char * last) noexcept
+        {
+            if (BOOST_STL_INTERFACES_STRING_AT_RUNTIME()) {
+                std::rotate(first, middle, last);
+                return;
+            }
+            v1_dtl::string_reverse(first, middle);
+            v1_dtl::string_reverse(middle, last);
+            v1_dtl::string_reverse(first, last);
+        }
+
+#undef BOOST_STL_INTERFACES_STRING_AT_RUNTIME
+
+        template<typename Iter>
+        constexpr std::size_t
+        string_distance(Iter first, Iter last, std::random_access_iterator_tag)
+        {
+            return std::size_t(last - first);
+        }
+        template<typename Iter>
+        constexpr std::size_t
+        string_distance(Iter first, Iter last, std::forward_iterator_tag)
+        {
+            std::size_t n = 0;
+            for (; first != last; ++first) {
+                ++n;
+            }
+            return n;
+        }
+        template<typename Iter>
+        constexpr std::size_t string_distance(Iter first, Iter last)
+        {
+            return v1_dtl::string_distance(
+                first,
+                last,
+                typename std::iterator_traits<Iter>::iterator_category{});
+        }
+    }
+
+#endif
+
+    /** A `std::string`-like sequence of `char`s with a fixed capacity of
+        `N`, stored within the object itself, along with its terminating
+        null.  Growing it past `N` characters is a precondition violation;
+        `small_string` is the same thing with a heap fallback.
+
+        The size is stored in the smallest unsigned type that can hold `N`,
+        so a `static_string<22>` is 24 bytes, and it is trivially copyable.
+        `find()` searches with `std::memchr()` and `std::memcmp()`, and
+        `compare()` is a `std::memcmp()`, so it orders characters as
+        `std::string` does; the C library vectorizes both.  `c_str()` is
+        always null-terminated.
+
+        It is usable in constant expressions, where the compiler can tell
+        constant evaluation apart (GCC 9 and later, Clang, MSVC 2019 16.5
+        and later): there, loops take the place of the C library calls, so
+        a `constexpr static_string` is built at compile time, and placed in
+        read-only data.
+
+        `Align` is the alignment of the characters, and so of `data()`; it
+        may be made 16, 32 or 64, so that `data()` can be used with aligned
+        SIMD loads.  The buffer is then also padded out to a multiple of
+        `Align` bytes; see `padded_capacity()`.  The size is stored after
+        the buffer, so the object takes another `Align` bytes for it.
+
+        \see `container_interface` */
+    template<std::size_t N, std::size_t Align>
+    struct static_string
+        : container_interface<static_string<N, Align>, contiguous>
+    {
+        static_assert(
+            (Align & (Align - 1)) == 0, "Align must be a power of two.");
+
+        using value_type = char;
+        using traits_type = std::char_traits<char>;
+        using pointer = char *;
+        using const_pointer = char const *;
+        using reference = char &;
+        using const_reference = char const &;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using iterator = char *;
+        using const_iterator = char const *;
+        using reverse_iterator = stl_interfaces::reverse_iterator<iterator>;
+        using const_reverse_iterator =
+            stl_interfaces::reverse_iterator<const_iterator>;
+
+        static constexpr size_type npos = v1_dtl::string_npos;
+
+        constexpr static_string() noexcept : buf_(), size_(0) {}
+        constexpr static_string(size_type n, char c) : static_string()
+        {
+            resize(n, c);
+        }
+        template<
+            typename InputIterator,
+            typename Enable = std::enable_if_t<std::is_convertible<
+                typename std::iterator_traits<
+                    InputIterator>::iterator_category,
+                std::input_iterator_tag>::value>>
+        constexpr static_string(InputIterator first, InputIterator last) :
+            static_string()
+        {
+            for (; first != last; ++first) {
+                emplace_back(*first);
+            }
+        }
+        constexpr static_string(char const * s, size_type n) : static_string()
+        {
+            append(s, n);
+        }
+        constexpr static_string(char const * s) :
+            static_string(s, v1_dtl::string_length(s))
+        {}
+        constexpr static_string(std::initializer_list<char> il) :
+            static_string(il.begin(), il.end())
+        {}
+
+        constexpr iterator begin() noexcept { return buf_; }
+        constexpr iterator end() noexcept { return buf_ + size_; }
+
+        /** Returns a pointer to the characters, followed by a null. */
+        constexpr char const * c_str() const noexcept { return buf_; }
+        constexpr size_type length() const noexcept { return size_; }
+
+#if 201703L <= __cplusplus && defined(__cpp_lib_string_view)
+        constexpr operator std::string_view() const noexcept
+        {
+            return std::string_view(buf_, size_);
+        }
+#endif
+
+        static constexpr size_type max_size() noexcept { return N; }
+        static constexpr size_type capacity() noexcept { return N; }
+        /** Returns the number of characters in the buffer that `data()`
+            points to, which is `N + 1`, for the characters and the null,
+            unless `Align` is above 1; then it is `N + 1` rounded up to a
+            multiple of `Align`.  The characters past `size()` have
+            unspecified values, and may be read, and those past the null
+            written, so a SIMD kernel may process whole vectors up to
+            `data() + padded_capacity()` with no scalar epilogue. */
+        static constexpr size_type padded_capacity() noexcept
+        {
+            return v1_dtl::string_slots<N, Align>();
+        }
+        constexpr void resize(size_type sz, char c) noexcept
+        {
+            BOOST_ASSERT(sz <= N);
+            if (size_ < sz)
+                v1_dtl::string_fill(buf_ + size_, sz - size_, c);
+            set_size(sz);
+        }
+        constexpr void reserve(size_type n) noexcept { BOOST_ASSERT(n <= N); }
+        constexpr void shrink_to_fit() noexcept {}
+
+        constexpr reference emplace_back(char c) noexcept
+        {
+            BOOST_ASSERT(size_ < N);
+            buf_[size_] = c;
+            set_size(size_ + 1);
+            return buf_[size_ - 1];
+        }
+        constexpr iterator emplace(const_iterator pos, char c) noexcept
+        {
+            BOOST_ASSERT(size_ < N);
+            char * const position = buf_ + (pos - buf_);
+            v1_dtl::string_copy_backward(
+                position + 1, position, end() - position);
+            *position = c;
+            set_size(size_ + 1);
+            return position;
+        }
+        /** Inserts `[first, last)` before `pos`; `[first, last)` may be
+            part of `*this`. */
+        template<
+            typename ForwardIterator,
+            typename Enable = std::enable_if_t<std::is_convertible<
+                typename std::iterator_traits<
+                    ForwardIterator>::iterator_category,
+                std::forward_iterator_tag>::value>>
+        constexpr iterator insert(
+            const_iterator pos, ForwardIterator first, ForwardIterator last)
+        {
+            char * const position = buf_ + (pos - buf_);
+            auto const n = v1_dtl::string_distance(first, last);
+            BOOST_ASSERT(size_ + n <= N);
+            // Appending first reads [first, last) before anything moves.
+            char * const old_end = end();
+            for (char * out = old_end; first != last; ++first, ++out) {
+                *out = *first;
+            }
+            v1_dtl::string_rotate(position, old_end, old_end + n);
+            set_size(size_ + n);
+            return position;
+        }
+        constexpr iterator erase(const_iterator f, const_iterator l) noexcept
+        {
+            char * const first = buf_ + (f - buf_);
+            v1_dtl::string_copy(first, l, end() - l);
+            set_size(size_ - (l - f));
+            return first;
+        }
+        constexpr void clear() noexcept { set_size(0); }
+
+        constexpr static_string & append(char const * s, size_type n) noexcept
+        {
+            BOOST_ASSERT(size_ + n <= N);
+            // Only the null at end() can be part of [s, s + n), and it is
+            // read before it is written.
+            v1_dtl::string_copy(end(), s, n);
+            set_size(size_ + n);
+            return *this;
+        }
+        constexpr static_string & append(char const * s) noexcept
+        {
+            return append(s, v1_dtl::string_length(s));
+        }
+        constexpr static_string & operator+=(char c) noexcept
+        {
+            emplace_back(c);
+            return *this;
+        }
+        constexpr static_string & operator+=(char const * s) noexcept
+        {
+            return append(s);
+        }
+
+        /** Returns the index of the first `c` at or after `pos`, or
+            `npos`. */
+        constexpr size_type find(char c, size_type pos = 0) const noexcept
+        {
+            return v1_dtl::string_find(buf_, size_, c, pos);
+        }
+        /** Returns the index of the first occurrence of `[s, s + n)` at or
+            after `pos`, or `npos`. */
+        constexpr size_type
+        find(char const * s, size_type pos, size_type n) const noexcept
+        {
+            return v1_dtl::string_find(buf_, size_, s, n, pos);
+        }
+        constexpr size_type find(char const * s, size_type pos = 0) const
+            noexcept
+        {
+            return find(s, pos, v1_dtl::string_length(s));
+        }
+        constexpr size_type
+        find(static_string const & s, size_type pos = 0) const noexcept
+        {
+            return find(s.buf_, pos, s.size_);
+        }
+
+        /** Returns a negative value, `0`, or a positive value, as `*this`
+            is ordered before, equal to, or after `[s, s + n)`. */
+        constexpr int compare(char const * s, size_type n) const noexcept
+        {
+            return v1_dtl::string_compare(buf_, size_, s, n);
+        }
+        constexpr int compare(char const * s) const noexcept
+        {
+            return compare(s, v1_dtl::string_length(s));
+        }
+        constexpr int compare(static_string const & s) const noexcept
+        {
+            return compare(s.buf_, s.size_);
+        }
+
+        constexpr void swap(static_string & other) noexcept
+        {
+            static_string const tmp = other;
+            other = *this;
+            *this = tmp;
+        }
+
+        /** Swaps `lhs` and `rhs`. */
+        friend constexpr void
+        swap(static_string & lhs, static_string & rhs) noexcept
+        {
+            lhs.swap(rhs);
+        }
+
+        friend constexpr bool
+        operator==(static_string const & lhs, char const * rhs)
+        {
+            return !lhs.compare(rhs);
+        }
+        friend constexpr bool
+        operator==(char const * lhs, static_string const & rhs)
+        {
+            return !rhs.compare(lhs);
+        }
+        friend constexpr bool
+        operator!=(static_string const & lhs, char const * rhs)
+        {
+            return !!lhs.compare(rhs);
+        }
+        friend constexpr bool
+        operator!=(char const * lhs, static_string const & rhs)
+        {
+            return !!rhs.compare(lhs);
+        }
+        /** Orders characters as unsigned, as `std::string` does; the other
+            relational operators from `container_interface` use this. */
+        friend constexpr bool
+        operator<(static_string const & lhs, static_string const & rhs)
+        {
+            return lhs.compare(rhs) < 0;
+        }
+
+        using base_type =
+            container_interface<static_string<N, Align>, contiguous>;
+        using base_type::begin;
+        using base_type::end;
+        using base_type::erase;
+        using base_type::insert;
+        using base_type::resize;
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+    private:
+        constexpr void set_size(size_type n) noexcept
+        {
+            size_ = v1_dtl::string_size_t<N>(n);
+            buf_[n] = '\0';
+        }
+
+        alignas(Align) char buf_[v1_dtl::string_slots<N, Align>()];
+        v1_dtl::string_size_t<N> size_;
+#endif
+    };
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+    // Before C++17, npos needs a definition outside the class.
+    template<std::size_t N, std::size_t Align>
+    constexpr typename static_string<N, Align>::size_type
+        static_string<N, Align>::npos;
+#endif
+
+}}}
+
+namespace std {
+    /** `static_string`'s hash is `boost::stl_interfaces::hash_value()`. */
+    template<std::size_t N, std::size_t Align>
+    struct hash<boost::stl_interfaces::static_string<N, Align>>
+        : boost::stl_interfaces::container_hash
+    {
+    };
+}
+
+namespace boost { namespace stl_interfaces {
+
+    /** A `static_string` holds no pointers into itself. */
+    template<std::size_t N, std::size_t Align>
+    struct is_trivially_relocatable<v1::static_string<N, Align>>
+        : std::true_type
+    {
+    };
+
+}}
+
+#endif
@@ -0,0 +1,1097 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_STATIC_VECTOR_HPP
+#define BOOST_STL_INTERFACES_STATIC_VECTOR_HPP
+
+#include <boost/stl_interfaces/container_interface.hpp>
+#include <boost/stl_interfaces/hash.hpp>
+#include <boost/stl_interfaces/trivially_relocatable.hpp>
+#include <boost/stl_interfaces/detail/relocate.hpp>
+#ifdef BOOST_STL_INTERFACES_CHECKED_ITERATORS
+#include <boost/stl_interfaces/checked_iterator.hpp>
+#endif
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <type_traits>
+
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+// static_vector of a non-trivial T is usable in constant expressions where
+// std::construct_at() and destructors are constexpr, as in C++20.
+#if defined(__cpp_lib_constexpr_dynamic_alloc) &&                             \
+    defined(__cpp_lib_is_constant_evaluated)
+#define BOOST_STL_INTERFACES_CONSTEXPR_STATIC_VECTOR 1
+#define BOOST_STL_INTERFACES_CONSTEXPR20 constexpr
+#else
+#define BOOST_STL_INTERFACES_CONSTEXPR_STATIC_VECTOR 0
+#define BOOST_STL_INTERFACES_CONSTEXPR20
+#endif
+#endif
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+    template<typename T, std::size_t N, std::size_t Align = alignof(T)>
+    struct static_vector;
+
+    /** `static_vector`'s own members destroy its elements, so
+        `container_interface` does not need to call `clear()`. */
+    template<typename T, std::size_t N, std::size_t Align>
+    struct trivially_destructible_container<static_vector<T, N, Align>>
+        : std::true_type
+    {
+    };
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    namespace v1_dtl {
+        template<typename T>
+        using static_vector_trivial = std::integral_constant<
+            bool,
+            std::is_trivially_copyable<T>::value &&
+                std::is_trivially_default_constructible<T>::value &&
+                std::is_copy_assignable<T>::value>;
+
+        // The smallest unsigned type that holds every size up to N.  The
+        // size is stored after the elements, where it packs into the
+        // padding the elements leave, if any.  Checked iterators point to
+        // the size, as a std::size_t.
+#ifdef BOOST_STL_INTERFACES_CHECKED_ITERATORS
+        template<std::size_t N>
+        using static_vector_size_t = std::size_t;
+#else
+        template<std::size_t N>
+        using static_vector_size_t = std::conditional_t<
+            N <= std::numeric_limits<unsigned char>::max(),
+            unsigned char,
+            std::conditional_t<
+                N <= std::numeric_limits<unsigned short>::max(),
+                unsigned short,
+                std::conditional_t<
+                    N <= std::numeric_limits<unsigned int>::max(),
+                    unsigned int,
+                    std::size_t>>>;
+#endif
+
+        // The number of element slots: N, or, for an Align stricter than
+        // T's, enough to fill N elements' bytes out to a multiple of Align.
+        template<typename T, std::size_t N, std::size_t Align>
+        constexpr std::size_t static_vector_slots() noexcept
+        {
+            return ((N * sizeof(T) + Align - 1) / Align * Align +
+                    sizeof(T) - 1) /
+                   sizeof(T);
+        }
+
+        // For trivial T, the elements are an array of T.  Every slot of the
+        // array holds a T at all times -- the ones past size_ are just not
+        // part of the sequence -- so elements are "constructed" by
+        // assignment.  That makes static_vector<T, N> trivially copyable,
+        // and usable in constant expressions.
+        template<
+            typename T,
+            std::size_t N,
+            std::size_t Align,
+            bool Trivial = static_vector_trivial<T>::value>
+        struct static_vector_storage
+        {
+            static constexpr std::size_t slots =
+                static_vector_slots<T, N, Align>();
+
+            constexpr static_vector_storage() noexcept : elements_(), size_(0)
+            {}
+
+            constexpr T * elements() noexcept { return elements_; }
+            constexpr T const * elements() const noexcept { return elements_; }
+
+            template<typename... Args>
+            constexpr void construct(T * p, Args &&... args)
+            {
+                *p = T(static_cast<Args &&>(args)...);
+            }
+            constexpr void destroy(T *, T *) noexcept {}
+
+            alignas(Align) T elements_[slots ? slots : 1];
+            static_vector_size_t<N> size_;
+        };
+
+        // Otherwise, the elements are the members of an array in a union,
+        // which begins no element's lifetime; the special members
+        // construct, move, and destroy them.  Unlike an array of bytes
+        // reinterpreted as Ts, the array has type T[N] to the compiler and
+        // in constant expressions, so in C++20 a static_vector of
+        // non-trivial T is usable at compile time.
+        template<typename T, std::size_t N, std::size_t Align>
+        struct static_vector_storage<T, N, Align, false>
+        {
+            static constexpr std::size_t slots =
+                static_vector_slots<T, N, Align>();
+            static constexpr bool relocatable =
+                is_trivially_relocatable<T>::value;
+
+            BOOST_STL_INTERFACES_CONSTEXPR20 static_vector_storage() noexcept :
+                size_(0)
+            {}
+            BOOST_STL_INTERFACES_CONSTEXPR20
+            static_vector_storage(static_vector_storage const & other) :
+                size_(0)
+            {
+                copy(other);
+            }
+            BOOST_STL_INTERFACES_CONSTEXPR20
+            static_vector_storage(static_vector_storage && other) noexcept(
+                relocatable || std::is_nothrow_move_constructible<T>::value) :
+                size_(0)
+            {
+                steal(other, std::integral_constant<bool, relocatable>{});
+            }
+            BOOST_STL_INTERFACES_CONSTEXPR20 static_vector_storage &
+            operator=(static_vector_storage const & other)
+            {
+                if (this != &other) {
+                    destroy(elements(), elements() + size_);
+                    size_ = 0;
+                    copy(other);
+                }
+                return *this;
+            }
+            BOOST_STL_INTERFACES_CONSTEXPR20 static_vector_storage &
+            operator=(static_vector_storage && other) noexcept(
+                relocatable || std::is_nothrow_move_constructible<T>::value)
+            {
+                if (this != &other) {
+                    destroy(elements(), elements() + size_);
+                    size_ = 0;
+                    steal(other, std::integral_constant<bool, relocatable>{});
+                }
+                return *this;
+            }
+            BOOST_STL_INTERFACES_CONSTEXPR20 ~static_vector_storage()
+            {
+                destroy(elements(), elements() + size_);
+            }
+
+            constexpr T * elements() noexcept { return elements_; }
+            constexpr T const * elements() const noexcept { return elements_; }
+
+            template<typename... Args>
+            BOOST_STL_INTERFACES_CONSTEXPR20 void
+            construct(T * p, Args &&... args)
+            {
+#if BOOST_STL_INTERFACES_CONSTEXPR_STATIC_VECTOR
+                std::construct_at(p, static_cast<Args &&>(args)...);
+#else
+                ::new (static_cast<void *>(p)) T(static_cast<Args &&>(args)...);
+#endif
+            }
+            BOOST_STL_INTERFACES_CONSTEXPR20 void
+            destroy(T * first, T * last) noexcept
+            {
+                for (; first != last; ++first) {
+                    first->~T();
+                }
+            }
+
+            union
+            {
+                alignas(Align) T elements_[slots ? slots : 1];
+            };
+            static_vector_size_t<N> size_;
+
+        private:
+            // If a copy throws, the ones already made are destroyed.
+            BOOST_STL_INTERFACES_CONSTEXPR20 void
+            copy(static_vector_storage const & other)
+            {
+                try {
+                    for (; size_ < other.size_; ++size_) {
+                        construct(elements() + size_, other.elements()[size_]);
+                    }
+                } catch (...) {
+                    destroy(elements(), elements() + size_);
+                    size_ = 0;
+                    throw;
+                }
+            }
+
+            BOOST_STL_INTERFACES_CONSTEXPR20 void
+            steal(static_vector_storage & other, std::true_type) noexcept
+            {
+#if BOOST_STL_INTERFACES_CONSTEXPR_STATIC_VECTOR
+                if (std::is_constant_evaluated()) {
+                    steal(other, std::false_type{});
+                    return;
+                }
+#endif
+                stl_interfaces::uninitialized_relocate(
+                    other.elements(),
+                    other.elements() + other.size_,
+                    elements());
+                size_ = other.size_;
+                other.size_ = 0;
+            }
+            // One pass move-constructs all the elements (destroying the
+            // new ones again if a move throws), and each size is set once.
+            BOOST_STL_INTERFACES_CONSTEXPR20 void
+            steal(static_vector_storage & other, std::false_type)
+            {
+                try {
+                    for (; size_ < other.size_; ++size_) {
+                        construct(
+                            elements() + size_,
+                            std::move(other.elements()[size_]));
+                    }
+                } catch (...) {
+                    destroy(elements(), elements() + size_);
+                    size_ = 0;
+                    throw;
+                }
+                destroy(other.elements(), other.elements() + other.size_);
+                other.size_ = 0;
+            }
+        };
+
+        template<typename Container, typename T>
+        using relocate_to_t = decltype(std::declval<Container &>().relocate_to(
+            std::declval<T *>()));
+
+        template<typename Container, typename T, typename Self>
+        using relocatable_from = std::integral_constant<
+            bool,
+            !std::is_lvalue_reference<Container>::value &&
+                !std::is_same<std::decay_t<Container>, Self>::value &&
+                detail::detector<void, relocate_to_t, Container, T>::value>;
+
+        template<typename Iter>
+        constexpr std::ptrdiff_t static_vector_distance(
+            Iter first, Iter last, std::random_access_iterator_tag)
+        {
+            return last - first;
+        }
+        template<typename Iter>
+        constexpr std::ptrdiff_t
+        static_vector_distance(Iter first, Iter last, std::input_iterator_tag)
+        {
+            std::ptrdiff_t n = 0;
+            for (; first != last; ++first) {
+                ++n;
+            }
+            return n;
+        }
+    }
+
+#endif
+
+    /** A `T` alone in a block of `Align` bytes, aligned to `Align`.  An
+        array of them puts each `T` on its own cache line (with the default
+        `Align`), so that threads that each write to their own element, as
+        to per-thread counters, do not contend for the same line. */
+    template<typename T, std::size_t Align = 64>
+    struct alignas(Align) cache_padded
+    {
+        static_assert(
+            alignof(T) <= Align && (Align & (Align - 1)) == 0,
+            "Align must be a power of two no less than alignof(T).");
+
+        T value;
+
+        constexpr T & operator*() noexcept { return value; }
+        constexpr T const & operator*() const noexcept { return value; }
+        constexpr T * operator->() noexcept { return &value; }
+        constexpr T const * operator->() const noexcept { return &value; }
+    };
+
+    /** A `std::vector`-like sequence container with a fixed capacity of `N`
+        elements, stored within the object itself.  Inserting more than `N`
+        elements is a precondition violation.  This is the `static_vector`
+        shown in the container tutorial, made into a supported type.
+
+        If `T` is trivially copyable and trivially default constructible,
+        the elements are stored as a `T[N]`, and `static_vector<T, N>` is
+        itself trivially copyable -- it may be copied with `std::memcpy()`,
+        as into shared memory -- and is a literal type whose members are
+        `constexpr`, so it can be built and used at compile time.  The cost
+        is that construction value-initializes all `N` elements.  For other
+        `T`, the elements are stored in raw storage, and constructed only as
+        they are inserted; moving such a `static_vector` uses
+        `uninitialized_relocate()` when `T` is trivially relocatable.
+
+        The size is stored in the smallest unsigned type that holds `N`,
+        after the elements, so `static_vector<char, 15>` takes 16 bytes;
+        `size_type` is `std::size_t` regardless.  (With checked iterators,
+        which refer to the size, it is stored as a `std::size_t`.)
+
+        `Align` is the alignment of the elements, and so of `data()`; it
+        may be made stricter than `alignof(T)`, say 32 or 64, so that
+        `data()` can be used with aligned SIMD loads.  The storage is then
+        also padded out to a multiple of `Align` bytes; see
+        `padded_capacity()`.  For per-thread counters that must not share a
+        cache line, use elements of type `cache_padded<T>` instead.
+
+        If `BOOST_STL_INTERFACES_CHECKED_ITERATORS` is defined, the iterators
+        are `checked_iterator`s, bounded by the current size.  Inserting or
+        erasing anywhere but at the end, `clear()`, `assign()`, and
+        assignment invalidate all iterators; appending and erasing from the
+        end invalidate none, since the bounds check catches the use of an
+        erased element.  The container is then not trivially copyable.
+
+        \see `container_interface` */
+    template<typename T, std::size_t N, std::size_t Align>
+    struct static_vector
+        : container_interface<static_vector<T, N, Align>, contiguous>
+    {
+        static_assert(
+            alignof(T) <= Align && (Align & (Align - 1)) == 0,
+            "Align must be a power of two no less than alignof(T).");
+
+        using value_type = T;
+        using pointer = T *;
+        using const_pointer = T const *;
+        using reference = value_type &;
+        using const_reference = value_type const &;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+#ifdef BOOST_STL_INTERFACES_CHECKED_ITERATORS
+        using iterator = checked_iterator<T *>;
+        using const_iterator = checked_iterator<T const *>;
+#else
+        using iterator = T *;
+        using const_iterator = T const *;
+#endif
+        using reverse_iterator = stl_interfaces::reverse_iterator<iterator>;
+        using const_reverse_iterator =
+            stl_interfaces::reverse_iterator<const_iterator>;
+
+        constexpr static_vector() = default;
+        constexpr explicit static_vector(size_type n)
+        {
+            BOOST_ASSERT(n <= N);
+            for (; n; --n) {
+                emplace_back();
+            }
+        }
+        constexpr static_vector(size_type n, T const & x)
+        {
+            BOOST_ASSERT(n <= N);
+            for (; n; --n) {
+                emplace_back(x);
+            }
+        }
+        template<
+            typename InputIterator,
+            typename Enable = std::enable_if_t<std::is_convertible<
+                typename std::iterator_traits<
+                    InputIterator>::iterator_category,
+                std::input_iterator_tag>::value>>
+        constexpr static_vector(InputIterator first, InputIterator last)
+        {
+            for (; first != last; ++first) {
+                emplace_back(*first);
+            }
+        }
+        constexpr static_vector(std::initializer_list<T> il) :
+            static_vector(il.begin(), il.end())
+        {}
+        /** Takes the elements of `other`, a container of `T`s with a
+            `relocate_to()` member -- a `static_vector` of another capacity
+            or alignment, say -- by relocating them into `*this` with one
+            `memcpy()` when `T` is trivially relocatable, and one move per
+            element otherwise.  `other` is left empty.
+
+            \pre `other.size() <= N` */
+        template<
+            typename Container,
+            typename Enable = std::enable_if_t<
+                v1_dtl::relocatable_from<Container, T, static_vector>::value>>
+        explicit static_vector(Container && other) noexcept
+        {
+            BOOST_ASSERT(other.size() <= N);
+            storage_.size_ = size_storage(
+                other.relocate_to(storage_.elements()) - storage_.elements());
+        }
+
+        constexpr iterator begin() noexcept
+        {
+            return make_iterator(storage_.elements());
+        }
+        constexpr iterator end() noexcept { return make_iterator(data_end()); }
+
+        static constexpr size_type max_size() noexcept { return N; }
+        static constexpr size_type capacity() noexcept { return N; }
+        /** Returns the number of elements that fit in the storage that
+            `data()` points to, which is `N` unless `Align` is stricter than
+            `alignof(T)`; then it is `N` rounded up to fill the last
+            `Align`-byte block.  For a trivial `T`, the slots past `size()`
+            hold `T`s with unspecified values, which may be read and
+            written, so a SIMD kernel may process whole vectors up to
+            `data() + padded_capacity()` with no scalar epilogue. */
+        static constexpr size_type padded_capacity() noexcept
+        {
+            return N ? v1_dtl::static_vector_slots<T, N, Align>() : 0;
+        }
+        constexpr void resize(size_type sz, T const & x)
+        {
+            BOOST_ASSERT(sz <= N);
+            if (sz < storage_.size_) {
+                erase(begin() + sz, end());
+                return;
+            }
+            while (storage_.size_ < sz) {
+                unchecked_emplace_back(x);
+            }
+        }
+        /** Like `resize(sz, x)`, except that new elements are
+            default-initialized.  For a trivial `T`, that leaves them as they
+            were. */
+        constexpr void resize(size_type sz, default_init_t)
+        {
+            BOOST_ASSERT(sz <= N);
+            if (sz < storage_.size_) {
+                erase(begin() + sz, end());
+                return;
+            }
+            resize_default(sz, v1_dtl::static_vector_trivial<T>{});
+        }
+        constexpr void reserve(size_type n) noexcept { BOOST_ASSERT(n <= N); }
+        constexpr void shrink_to_fit() noexcept {}
+
+        template<typename... Args>
+        constexpr reference emplace_back(Args &&... args)
+        {
+            BOOST_ASSERT(storage_.size_ < N);
+            return unchecked_emplace_back(static_cast<Args &&>(args)...);
+        }
+        template<typename... Args>
+        constexpr reference unchecked_emplace_back(Args &&... args)
+        {
+            T * const position = data_end();
+            storage_.construct(position, static_cast<Args &&>(args)...);
+            ++storage_.size_;
+            return *position;
+        }
+        template<typename... Args>
+        constexpr iterator emplace(const_iterator pos, Args &&... args)
+        {
+            BOOST_ASSERT(storage_.size_ < N);
+            T * const position = to_pointer(pos);
+            if (position != data_end())
+                invalidate_iterators();
+            emplace_impl(
+                position,
+                std::integral_constant<bool, gap_relocate>{},
+                static_cast<Args &&>(args)...);
+            return make_iterator(position);
+        }
+        template<
+            typename ForwardIterator,
+            typename Enable = std::enable_if_t<std::is_convertible<
+                typename std::iterator_traits<
+                    ForwardIterator>::iterator_category,
+                std::forward_iterator_tag>::value>>
+        constexpr iterator insert(
+            const_iterator pos, ForwardIterator first, ForwardIterator last)
+        {
+            T * const position = to_pointer(pos);
+            auto const n = v1_dtl::static_vector_distance(
+                first,
+                last,
+                typename std::iterator_traits<
+                    ForwardIterator>::iterator_category{});
+            BOOST_ASSERT(storage_.size_ + size_type(n) <= N);
+            if (n && position != data_end())
+                invalidate_iterators();
+            insert_impl(
+                position, first, last, n, v1_dtl::static_vector_trivial<T>{});
+            return make_iterator(position);
+        }
+        // container_interface's insert(pos, n, x) and assign(n, x) use this
+        // instead of the range insert.
+        constexpr iterator
+        fill_insert(const_iterator pos, size_type n, T const & x)
+        {
+            T * const position = to_pointer(pos);
+            BOOST_ASSERT(storage_.size_ + n <= N);
+            if (n && position != data_end())
+                invalidate_iterators();
+            fill_insert_impl(
+                position, n, x, v1_dtl::static_vector_trivial<T>{});
+            return make_iterator(position);
+        }
+        constexpr iterator
+        erase(const_iterator f, const_iterator l) noexcept(
+            v1_dtl::static_vector_trivial<T>::value ||
+            is_trivially_relocatable<T>::value ||
+            std::is_nothrow_move_assignable<T>::value)
+        {
+            T * const first = to_pointer(f);
+            T * const last = to_pointer(l);
+            // Moving the elements after an empty range would assign each
+            // of them to itself.
+            if (first == last)
+                return make_iterator(first);
+            if (last != data_end())
+                invalidate_iterators();
+            erase_impl(
+                first, last, std::integral_constant<bool, gap_relocate>{});
+            return make_iterator(first);
+        }
+        // std::next() and std::prev() are not constexpr before C++17, so
+        // these two are not left to container_interface.
+        constexpr void pop_back() noexcept
+        {
+            BOOST_ASSERT(storage_.size_);
+            erase(end() - 1, end());
+        }
+        constexpr iterator erase(const_iterator pos) noexcept(
+            noexcept(std::declval<static_vector &>().erase(pos, pos)))
+        {
+            return erase(pos, pos + 1);
+        }
+        /** Destroys all the elements in one pass -- none at all, for a
+            trivially destructible `T` -- and sets the size to zero.
+            `container_interface`'s `clear()` uses this. */
+        constexpr void destroy_all() noexcept
+        {
+            storage_.destroy(storage_.elements(), data_end());
+            storage_.size_ = 0;
+        }
+
+        /** Relocates the elements to the uninitialized storage at `out`,
+            as `uninitialized_relocate()` does, leaves `*this` empty, and
+            returns the end of the relocated elements.  This is how another
+            container takes the elements without copying them.  It is only
+            provided when relocating a `T` cannot throw. */
+        template<
+            typename U = T,
+            typename Enable = std::enable_if_t<
+                is_trivially_relocatable<U>::value ||
+                std::is_nothrow_move_constructible<U>::value>>
+        T * relocate_to(T * out) noexcept
+        {
+            T * const retval = stl_interfaces::uninitialized_relocate(
+                storage_.elements(), data_end(), out);
+            storage_.size_ = 0;
+            invalidate_iterators();
+            return retval;
+        }
+
+        constexpr void swap(static_vector & other)
+        {
+            swap_impl(other, v1_dtl::static_vector_trivial<T>{});
+        }
+        /** Swaps `lhs` and `rhs`. */
+        friend constexpr void swap(static_vector & lhs, static_vector & rhs)
+        {
+            lhs.swap(rhs);
+        }
+
+        using base_type =
+            container_interface<static_vector<T, N, Align>, contiguous>;
+        using base_type::begin;
+        using base_type::end;
+        using base_type::erase;
+        using base_type::insert;
+        using base_type::resize;
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+    private:
+        friend access;
+
+        constexpr T * data_end() noexcept
+        {
+            return storage_.elements() + storage_.size_;
+        }
+        constexpr T * to_pointer(const_iterator pos) noexcept
+        {
+            return storage_.elements() + (pos - const_iterator(begin()));
+        }
+#ifdef BOOST_STL_INTERFACES_CHECKED_ITERATORS
+        constexpr iterator make_iterator(T * p) noexcept
+        {
+            return iterator(
+                p, storage_.elements(), storage_.size_, generation_);
+        }
+        // container_interface calls this, through access, in its
+        // invalidating members.
+        constexpr void invalidate_iterators() noexcept
+        {
+            generation_.invalidate();
+        }
+#else
+        constexpr iterator make_iterator(T * p) noexcept { return p; }
+        constexpr void invalidate_iterators() noexcept {}
+#endif
+
+        using size_storage = v1_dtl::static_vector_size_t<N>;
+
+        // Non-trivial elements that are trivially relocatable are moved
+        // around with memmove(); trivial ones are assigned in loops, which
+        // optimize to the same thing, and also work at compile time.
+        static constexpr bool gap_relocate =
+            !v1_dtl::static_vector_trivial<T>::value &&
+            is_trivially_relocatable<T>::value;
+
+        constexpr void resize_default(size_type sz, std::true_type) noexcept
+        {
+            storage_.size_ = size_storage(sz);
+        }
+        BOOST_STL_INTERFACES_CONSTEXPR20 void
+        resize_default(size_type sz, std::false_type)
+        {
+            for (; storage_.size_ < sz; ++storage_.size_) {
+#if BOOST_STL_INTERFACES_CONSTEXPR_STATIC_VECTOR
+                if (std::is_constant_evaluated()) {
+                    storage_.construct(data_end());
+                    continue;
+                }
+#endif
+                ::new (static_cast<void *>(data_end())) T;
+            }
+        }
+
+        // Moves [position, end()) up by n.  The n elements starting at
+        // position are left as moved-from objects, except that any of them
+        // past the old end() are not constructed at all; that only happens
+        // for trivial T, whose slots always hold objects.
+        constexpr void open_gap(T * position, size_type n, std::false_type)
+        {
+            T * const old_end = data_end();
+            T * const new_end = old_end + n;
+            // The elements that land past the old end are constructed
+            // there; the others are assigned, back to front.
+            T * out = new_end;
+            T * in = old_end;
+            while (old_end < out && position < in) {
+                --out;
+                --in;
+                storage_.construct(out, std::move(*in));
+            }
+            while (position < in) {
+                --out;
+                --in;
+                *out = std::move(*in);
+            }
+            storage_.size_ += size_storage(n);
+        }
+
+        // The new element is constructed off to the side first, since args
+        // may refer to an element that is about to move.
+        template<typename... Args>
+        constexpr void
+        emplace_impl(T * position, std::false_type, Args &&... args)
+        {
+            T x(static_cast<Args &&>(args)...);
+            if (position == data_end()) {
+                unchecked_emplace_back(std::move(x));
+                return;
+            }
+            open_gap(position, 1, std::false_type{});
+            *position = std::move(x);
+        }
+        template<typename... Args>
+        BOOST_STL_INTERFACES_CONSTEXPR20 void
+        emplace_impl(T * position, std::true_type, Args &&... args)
+        {
+#if BOOST_STL_INTERFACES_CONSTEXPR_STATIC_VECTOR
+            if (std::is_constant_evaluated()) {
+                emplace_impl(
+                    position,
+                    std::false_type{},
+                    static_cast<Args &&>(args)...);
+                return;
+            }
+#endif
+            // Once the new element exists, nothing else can throw, so it and
+            // the tail are both just relocated into place.
+            alignas(T) unsigned char buf[sizeof(T)];
+            T * const x = ::new (static_cast<void *>(buf))
+                T(static_cast<Args &&>(args)...);
+            stl_interfaces::uninitialized_relocate_backward(
+                position, data_end(), data_end() + 1);
+            stl_interfaces::uninitialized_relocate(x, x + 1, position);
+            ++storage_.size_;
+        }
+
+        template<typename ForwardIterator>
+        constexpr void insert_impl(
+            T * position,
+            ForwardIterator first,
+            ForwardIterator last,
+            std::ptrdiff_t n,
+            std::true_type)
+        {
+            open_gap(position, n, std::false_type{});
+            for (; first != last; ++first, ++position) {
+                *position = *first;
+            }
+        }
+        template<typename ForwardIterator>
+        BOOST_STL_INTERFACES_CONSTEXPR20 void insert_impl(
+            T * position,
+            ForwardIterator first,
+            ForwardIterator last,
+            std::ptrdiff_t n,
+            std::false_type)
+        {
+#if BOOST_STL_INTERFACES_CONSTEXPR_STATIC_VECTOR
+            if (std::is_constant_evaluated()) {
+                constexpr_insert(position, first, last, n);
+                return;
+            }
+#endif
+            detail::gap_insert(position, data_end(), first, last, n);
+            storage_.size_ += size_storage(n);
+        }
+
+#if BOOST_STL_INTERFACES_CONSTEXPR_STATIC_VECTOR
+        // Inserts as the trivial insert_impl() does, except that the slots
+        // of the gap past the old end(), which open_gap() leaves
+        // unconstructed, are constructed rather than assigned.  This is
+        // for constant evaluation, which cannot relocate; so is the like
+        // loop in fill_insert_impl().
+        template<typename ForwardIterator>
+        constexpr void constexpr_insert(
+            T * position,
+            ForwardIterator first,
+            ForwardIterator last,
+            std::ptrdiff_t n)
+        {
+            T * const old_end = data_end();
+            open_gap(position, n, std::false_type{});
+            for (; first != last; ++first, ++position) {
+                if (position < old_end)
+                    *position = *first;
+                else
+                    storage_.construct(position, *first);
+            }
+        }
+#endif
+
+        // x is copied first, since it may be an element that is about to
+        // move.
+        constexpr void fill_insert_impl(
+            T * position, size_type n, T const & x, std::true_type)
+        {
+            T const value = x;
+            open_gap(position, n, std::false_type{});
+            detail::n_iter_copy(
+                detail::make_n_iter(value, n),
+                detail::make_n_iter_end(value, n),
+                position);
+        }
+        BOOST_STL_INTERFACES_CONSTEXPR20 void fill_insert_impl(
+            T * position, size_type n, T const & x, std::false_type)
+        {
+            T const value = x;
+#if BOOST_STL_INTERFACES_CONSTEXPR_STATIC_VECTOR
+            if (std::is_constant_evaluated()) {
+                T * const old_end = data_end();
+                open_gap(position, n, std::false_type{});
+                for (T * last = position + n; position != last; ++position) {
+                    if (position < old_end)
+                        *position = value;
+                    else
+                        storage_.construct(position, value);
+                }
+                return;
+            }
+#endif
+            detail::gap_insert(
+                position,
+                data_end(),
+                detail::make_n_iter(value, n),
+                detail::make_n_iter_end(value, n),
+                std::ptrdiff_t(n));
+            storage_.size_ += size_storage(n);
+        }
+
+        constexpr void erase_impl(T * first, T * last, std::false_type)
+        {
+            T * const old_end = data_end();
+            T * out = first;
+            for (T * in = last; in != old_end; ++in, ++out) {
+                *out = std::move(*in);
+            }
+            storage_.destroy(out, old_end);
+            storage_.size_ -= size_storage(last - first);
+        }
+        BOOST_STL_INTERFACES_CONSTEXPR20 void
+        erase_impl(T * first, T * last, std::true_type) noexcept
+        {
+#if BOOST_STL_INTERFACES_CONSTEXPR_STATIC_VECTOR
+            if (std::is_constant_evaluated()) {
+                erase_impl(first, last, std::false_type{});
+                return;
+            }
+#endif
+            detail::destroy(first, last);
+            stl_interfaces::uninitialized_relocate(last, data_end(), first);
+            storage_.size_ -= size_storage(last - first);
+        }
+
+        constexpr void swap_impl(static_vector & other, std::true_type) noexcept
+        {
+            size_type const n = storage_.size_ < other.storage_.size_
+                                    ? other.storage_.size_
+                                    : storage_.size_;
+            for (size_type i = 0; i < n; ++i) {
+                T tmp = storage_.elements()[i];
+                storage_.elements()[i] = other.storage_.elements()[i];
+                other.storage_.elements()[i] = tmp;
+            }
+            size_storage const tmp_size = storage_.size_;
+            storage_.size_ = other.storage_.size_;
+            other.storage_.size_ = tmp_size;
+        }
+        BOOST_STL_INTERFACES_CONSTEXPR20 void
+        swap_impl(static_vector & other, std::false_type)
+        {
+            static_vector * shorter = this;
+            static_vector * longer = &other;
+            if (longer->size() < shorter->size())
+                std::swap(shorter, longer);
+            auto const short_size = shorter->size();
+            for (size_type i = 0; i < short_size; ++i) {
+                using std::swap;
+                swap((*this)[i], other[i]);
+            }
+            for (auto it = longer->begin() + short_size,
+                      last = longer->end();
+                 it != last;
+                 ++it) {
+                shorter->unchecked_emplace_back(std::move(*it));
+            }
+            longer->erase(longer->begin() + short_size, longer->end());
+        }
+
+        v1_dtl::static_vector_storage<T, N, Align> storage_;
+#ifdef BOOST_STL_INTERFACES_CHECKED_ITERATORS
+        iterator_generation generation_;
+#endif
+#endif
+    };
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    namespace v1_dtl {
+        // The most elements that sort() sorts with a sorting network.
+        constexpr std::size_t max_network_size = 32;
+
+        // Calls v(i, j) for each comparator of Batcher's odd-even merge
+        // sort of n elements, in order.  The network is the one for the
+        // next power of two, without the comparators that touch the
+        // elements past n; those elements would be greater than all the
+        // others, so those comparators would never exchange anything.
+        template<typename Visitor>
+        constexpr void batcher_network(std::size_t n, Visitor & v)
+        {
+            std::size_t pow2 = 1;
+            while (pow2 < n) {
+                pow2 *= 2;
+            }
+            for (std::size_t p = 1; p < pow2; p *= 2) {
+                for (std::size_t k = p; 1 <= k; k /= 2) {
+                    for (std::size_t j = k % p; j + k < n; j += 2 * k) {
+                        for (std::size_t i = 0; i < k && i + j + k < n; ++i) {
+                            if ((i + j) / (2 * p) == (i + j + k) / (2 * p))
+                                v(i + j, i + j + k);
+                        }
+                    }
+                }
+            }
+        }
+
+        struct network_counter
+        {
+            constexpr void operator()(std::size_t, std::size_t) { ++count; }
+            std::size_t count;
+        };
+
+        constexpr std::size_t network_comparators(std::size_t max_n)
+        {
+            network_counter counter{0};
+            for (std::size_t n = 0; n <= max_n; ++n) {
+                v1_dtl::batcher_network(n, counter);
+            }
+            return counter.count;
+        }
+
+        // The sorting networks for 0 through MaxN elements.  The network
+        // for n elements is the comparators [first[n], first[n + 1]).
+        template<std::size_t MaxN>
+        struct sorting_networks
+        {
+            constexpr sorting_networks() : first(), lo(), hi()
+            {
+                filler f{*this, 0};
+                for (std::size_t n = 0; n <= MaxN; ++n) {
+                    first[n] = (unsigned short)f.count;
+                    v1_dtl::batcher_network(n, f);
+                }
+                first[MaxN + 1] = (unsigned short)f.count;
+            }
+
+            static constexpr std::size_t comparators =
+                v1_dtl::network_comparators(MaxN);
+
+            unsigned short first[MaxN + 2];
+            unsigned char lo[comparators ? comparators : 1];
+            unsigned char hi[comparators ? comparators : 1];
+
+        private:
+            struct filler
+            {
+                constexpr void operator()(std::size_t i, std::size_t j)
+                {
+                    networks.lo[count] = (unsigned char)i;
+                    networks.hi[count] = (unsigned char)j;
+                    ++count;
+                }
+                sorting_networks & networks;
+                std::size_t count;
+            };
+        };
+
+        template<std::size_t MaxN>
+        struct sorting_networks_table
+        {
+            static constexpr sorting_networks<MaxN> value{};
+        };
+        template<std::size_t MaxN>
+        constexpr sorting_networks<MaxN> sorting_networks_table<MaxN>::value;
+
+        // A compare-exchange with no branch, for the compiler to make
+        // min/max instructions or conditional moves of.
+        template<typename T>
+        constexpr void compare_exchange(T & a, T & b) noexcept
+        {
+            T const x = a;
+            T const y = b;
+            bool const swapped = y < x;
+            a = swapped ? y : x;
+            b = swapped ? x : y;
+        }
+
+        template<typename T, std::size_t N>
+        constexpr void network_sort(T * first, std::size_t n) noexcept
+        {
+            constexpr std::size_t max_n =
+                N < max_network_size ? N : max_network_size;
+            auto const & networks = sorting_networks_table<max_n>::value;
+            for (std::size_t c = networks.first[n],
+                             last = networks.first[n + 1];
+                 c != last;
+                 ++c) {
+                v1_dtl::compare_exchange(
+                    first[networks.lo[c]], first[networks.hi[c]]);
+            }
+        }
+
+        template<typename T, std::size_t N, std::size_t Align>
+        constexpr void static_vector_sort(
+            static_vector<T, N, Align> & v, std::true_type) noexcept
+        {
+            if (v.size() <= max_network_size) {
+                v1_dtl::network_sort<T, N>(v.data(), v.size());
+                return;
+            }
+            std::sort(v.data(), v.data() + v.size());
+        }
+        template<typename T, std::size_t N, std::size_t Align>
+        void
+        static_vector_sort(static_vector<T, N, Align> & v, std::false_type)
+        {
+            std::sort(v.begin(), v.end());
+        }
+
+        // The position of the lower bound of x in [first, first + n).
+        // Each step halves the range with a conditional move, so the
+        // number of steps depends only on n.
+        template<typename T>
+        constexpr std::size_t
+        branchless_lower_bound(T const * first, std::size_t n, T const & x)
+        {
+            if (!n)
+                return 0;
+            T const * base = first;
+            while (1 < n) {
+                std::size_t const half = n / 2;
+                base = base[half] < x ? base + half : base;
+                n -= half;
+            }
+            return std::size_t(base - first) + (*base < x);
+        }
+    }
+
+#endif
+
+    /** Sorts the elements of `v` in ascending order, like
+        `std::sort(v.begin(), v.end())`.  For arithmetic `T`, up to 32
+        elements are sorted with a sorting network -- Batcher's odd-even
+        merge sort, generated at compile time for each size up to `N` --
+        whose compare-exchanges have no branches, rather than with
+        introsort, whose branches a random input mispredicts about half the
+        time.  More elements, and other `T`, are sorted with `std::sort()`.
+
+        \pre For floating-point `T`, no element is NaN. */
+    template<typename T, std::size_t N, std::size_t Align>
+    constexpr void sort(static_vector<T, N, Align> & v)
+    {
+        v1_dtl::static_vector_sort(v, std::is_arithmetic<T>{});
+    }
+
+    /** Returns the first element of the sorted `v` that is not less than
+        `x`, like `std::lower_bound(v.begin(), v.end(), x)`.  The search
+        halves the range with conditional moves rather than branches, so it
+        takes the same steps for every `x`, and a key that is hard to
+        predict costs no mispredicted branches. */
+    template<typename T, std::size_t N, std::size_t Align>
+    constexpr typename static_vector<T, N, Align>::iterator
+    lower_bound(static_vector<T, N, Align> & v, T const & x)
+    {
+        return v.begin() +
+               v1_dtl::branchless_lower_bound(v.data(), v.size(), x);
+    }
+
+    /** Returns the first element of the sorted `v` that is not less than
+        `x`, as the overload above does. */
+    template<typename T, std::size_t N, std::size_t Align>
+    constexpr typename static_vector<T, N, Align>::const_iterator
+    lower_bound(static_vector<T, N, Align> const & v, T const & x)
+    {
+        return v.begin() +
+               v1_dtl::branchless_lower_bound(v.data(), v.size(), x);
+    }
+
+}}}
+
+namespace std {
+    /** `static_vector`'s hash is `boost::stl_interfaces::hash_value()`. */
+    template<typename T, std::size_t N, std::size_t Align>
+    struct hash<boost::stl_interfaces::static_vector<T, N, Align>>
+        : boost::stl_interfaces::container_hash
+    {
+    };
+}
+
+namespace boost { namespace stl_interfaces {
+
+    /** A `static_vector` is trivially relocatable if its elements are. */
+    template<typename T, std::size_t N, std::size_t Align>
+    struct is_trivially_relocatable<v1::static_vector<T, N, Align>>
+        : is_trivially_relocatable<T>
+    {
+    };
+
+}}
+
+#endif
@@ -0,0 +1,247 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_STRIDED_VIEW_HPP
+#define BOOST_STL_INTERFACES_STRIDED_VIEW_HPP
+
+#include <boost/stl_interfaces/iterator_interface.hpp>
+#include <boost/stl_interfaces/view_interface.hpp>
+
+#include <boost/assert.hpp>
+
+#include <iterator>
+
+#include <cstddef>
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    namespace v1_dtl {
+        // The stride of a strided_iterator, when it is known at compile
+        // time.  Indexing then multiplies by a constant, which the compiler
+        // can fold into an addressing mode, or into the lanes of a
+        // vectorized gather.
+        template<std::ptrdiff_t Stride>
+        struct stride_holder
+        {
+            constexpr stride_holder() = default;
+            constexpr explicit stride_holder(std::ptrdiff_t stride) noexcept
+            {
+                BOOST_ASSERT(stride == Stride);
+                (void)stride;
+            }
+
+            constexpr std::ptrdiff_t stride() const noexcept { return Stride; }
+        };
+
+        // The stride, when it is known only at run time.
+        template<>
+        struct stride_holder<0>
+        {
+            constexpr stride_holder() noexcept : stride_(1) {}
+            constexpr explicit stride_holder(std::ptrdiff_t stride) noexcept :
+                stride_(stride)
+            {
+                BOOST_ASSERT(0 < stride);
+            }
+
+            constexpr std::ptrdiff_t stride() const noexcept { return stride_; }
+
+        private:
+            std::ptrdiff_t stride_;
+        };
+    }
+
+#endif
+
+    template<typename Ptr, std::ptrdiff_t Stride = 0>
+    struct strided_iterator;
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    namespace v1_dtl {
+        template<typename Ptr, std::ptrdiff_t Stride>
+        using strided_iterator_interface_t = iterator_interface<
+            strided_iterator<Ptr, Stride>,
+            std::random_access_iterator_tag,
+            std::remove_cv_t<std::remove_pointer_t<Ptr>>,
+            std::remove_pointer_t<Ptr> &,
+            Ptr>;
+    }
+
+#endif
+
+    /** A random access iterator over every `stride`-th element of an array,
+        starting at `first`: the element at position `n` is `first[n *
+        stride]`, as in a column of a row-major matrix, or one channel of
+        interleaved audio samples.
+
+        The iterator is `first` and its position `n`, so that the end of a
+        column is position `rows`, without forming a pointer past the end of
+        the array.  Advancing it, or comparing two of them, touches only the
+        position.  If the stride is known at compile time, pass it as
+        `Stride`; then the iterator does not store it, and the loops over it
+        multiply by a constant.  Copies from a `strided_iterator` into an
+        array are gathers, which the compiler can vectorize (see `copy()`).
+
+        \see `strided_view` */
+    template<typename Ptr, std::ptrdiff_t Stride>
+    struct strided_iterator
+        : v1_dtl::strided_iterator_interface_t<Ptr, Stride>,
+          private v1_dtl::stride_holder<Stride>
+    {
+        static_assert(
+            std::is_pointer<Ptr>::value,
+            "strided_iterator is an iterator over an array, through a "
+            "pointer.");
+        static_assert(0 <= Stride, "A stride must be positive.");
+
+        using reference = std::remove_pointer_t<Ptr> &;
+        using difference_type = std::ptrdiff_t;
+
+        constexpr strided_iterator() : first_(nullptr), n_(0) {}
+        constexpr strided_iterator(
+            Ptr first,
+            std::ptrdiff_t stride = Stride,
+            std::ptrdiff_t n = 0) noexcept :
+            v1_dtl::stride_holder<Stride>(stride),
+            first_(first),
+            n_(n)
+        {}
+
+        constexpr reference operator*() const noexcept
+        {
+            return first_[n_ * this->stride()];
+        }
+        constexpr strided_iterator & operator+=(std::ptrdiff_t n) noexcept
+        {
+            n_ += n;
+            return *this;
+        }
+        friend constexpr bool
+        operator==(strided_iterator lhs, strided_iterator rhs) noexcept
+        {
+            return lhs.n_ == rhs.n_;
+        }
+        friend constexpr std::ptrdiff_t
+        operator-(strided_iterator lhs, strided_iterator rhs) noexcept
+        {
+            return lhs.n_ - rhs.n_;
+        }
+
+        /** Returns a pointer to the current element.  The iterator must not
+            be at the end. */
+        constexpr Ptr base() const noexcept
+        {
+            return first_ + n_ * this->stride();
+        }
+        /** Returns the distance between consecutive elements, in elements
+            of the array. */
+        constexpr std::ptrdiff_t stride() const noexcept
+        {
+            return v1_dtl::stride_holder<Stride>::stride();
+        }
+
+    private:
+        Ptr first_;
+        std::ptrdiff_t n_;
+    };
+
+    /** A view of the `n` elements of an array `first[0]`, `first[stride]`,
+        ..., `first[(n - 1) * stride]`.
+        \see `strided_iterator` */
+    template<typename Ptr, std::ptrdiff_t Stride = 0>
+    struct strided_view : view_interface<strided_view<Ptr, Stride>>
+    {
+        using iterator = strided_iterator<Ptr, Stride>;
+
+        constexpr strided_view() : n_(0) {}
+        constexpr strided_view(
+            Ptr first, std::ptrdiff_t n, std::ptrdiff_t stride = Stride) :
+            first_(first, stride),
+            n_(n)
+        {}
+
+        constexpr iterator begin() const noexcept { return first_; }
+        constexpr iterator end() const noexcept { return first_ + n_; }
+
+    private:
+        iterator first_;
+        std::ptrdiff_t n_;
+    };
+
+    /** Returns a `strided_view` of the `n` elements `first[0]`,
+        `first[stride]`, ..., whose stride is known only at run time. */
+    template<typename T>
+    constexpr strided_view<T *>
+    make_strided_view(T * first, std::ptrdiff_t n, std::ptrdiff_t stride)
+    {
+        return strided_view<T *>(first, n, stride);
+    }
+
+    /** Returns a `strided_view` of the `n` elements `first[0]`,
+        `first[Stride]`, ..., whose stride is known at compile time. */
+    template<std::ptrdiff_t Stride, typename T>
+    constexpr strided_view<T *, Stride>
+    make_strided_view(T * first, std::ptrdiff_t n)
+    {
+        return strided_view<T *, Stride>(first, n);
+    }
+
+    /** Copies `[first, last)` to the array at `out`, like `std::copy()`, and
+        returns the end of the output.
+
+        The copy is a loop that indexes into the underlying array -- a gather
+        -- which the compiler can vectorize, especially for a stride known at
+        compile time.  Call it unqualified in code that also has `using
+        std::copy;`, and overload resolution picks this `copy()` for
+        `strided_iterator`s.
+
+        \pre `[out, out + (last - first))` does not overlap `[first,
+        last)`. */
+    template<typename Ptr, std::ptrdiff_t Stride, typename T>
+    T * copy(
+        strided_iterator<Ptr, Stride> first,
+        strided_iterator<Ptr, Stride> last,
+        T * out)
+    {
+        auto const n = last - first;
+        if (n <= 0)
+            return out;
+        auto const p = first.base();
+        auto const stride = first.stride();
+        for (std::ptrdiff_t i = 0; i < n; ++i) {
+            out[i] = p[i * stride];
+        }
+        return out + n;
+    }
+
+    /** Copies the array `[first, last)` to `out`, like `std::copy()`, and
+        returns the end of the output.  This is the inverse of the other
+        `copy()` overload: a scatter, which re-interleaves a channel, or
+        fills a column.
+
+        \pre `[out, out + (last - first))` does not overlap `[first,
+        last)`. */
+    template<typename T, typename Ptr, std::ptrdiff_t Stride>
+    strided_iterator<Ptr, Stride>
+    copy(T * first, T * last, strided_iterator<Ptr, Stride> out)
+    {
+        auto const n = last - first;
+        if (n <= 0)
+            return out;
+        auto const p = out.base();
+        auto const stride = out.stride();
+        for (std::ptrdiff_t i = 0; i < n; ++i) {
+            p[i * stride] = first[i];
+        }
+        return out + n;
+    }
+
+}}}
+
+#endif
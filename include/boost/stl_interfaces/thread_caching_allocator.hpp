@@ -0,0 +1,292 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_THREAD_CACHING_ALLOCATOR_HPP
+#define BOOST_STL_INTERFACES_THREAD_CACHING_ALLOCATOR_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    namespace v1_dtl {
+        struct tc_block
+        {
+            tc_block * next;
+        };
+
+        // The free blocks of one thread, for one block size.  It is trivial,
+        // so that it is usable for the whole life of its thread; a
+        // tc_flusher, registered on the thread's first use of it, returns
+        // its blocks to the pool when the thread exits.  head is a list of
+        // count blocks, and spare is a full batch or null.
+        struct tc_cache
+        {
+            tc_block * head;
+            std::size_t count;
+            tc_block * spare;
+            bool registered;
+            bool exited;
+        };
+
+        // The global pool of free blocks of size BlockSize, as a stack of
+        // batches, each a list of blocks.  It is never destroyed, so that
+        // threads that exit after main() returns can still return their
+        // blocks to it; the memory of the blocks is never freed.
+        template<std::size_t BlockSize>
+        struct tc_pool
+        {
+            static constexpr std::size_t batch_size =
+                (std::max)(std::size_t(16), std::size_t(4096 / BlockSize));
+
+            struct batch
+            {
+                tc_block * head;
+                std::size_t count;
+            };
+
+            static tc_pool & instance()
+            {
+                static tc_pool * const retval = new tc_pool;
+                return *retval;
+            }
+
+            void put(tc_block * head, std::size_t count) noexcept
+            {
+                if (!head)
+                    return;
+                std::lock_guard<std::mutex> lock(mutex_);
+                try {
+                    batches_.push_back(batch{head, count});
+                } catch (...) {
+                    // Out of memory; the blocks are lost.
+                }
+            }
+            batch take() noexcept
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (batches_.empty())
+                    return batch{nullptr, 0};
+                batch const retval = batches_.back();
+                batches_.pop_back();
+                return retval;
+            }
+
+        private:
+            std::mutex mutex_;
+            std::vector<batch> batches_;
+        };
+
+        template<std::size_t BlockSize>
+        tc_cache & tc_this_cache() noexcept
+        {
+            thread_local tc_cache cache;
+            return cache;
+        }
+
+        template<std::size_t BlockSize>
+        struct tc_flusher
+        {
+            ~tc_flusher()
+            {
+                tc_cache & cache = v1_dtl::tc_this_cache<BlockSize>();
+                auto & pool = tc_pool<BlockSize>::instance();
+                pool.put(cache.head, cache.count);
+                pool.put(cache.spare, tc_pool<BlockSize>::batch_size);
+                cache.head = cache.spare = nullptr;
+                cache.count = 0;
+                cache.exited = true;
+            }
+        };
+
+        template<std::size_t BlockSize>
+        void tc_register(tc_cache & cache)
+        {
+            thread_local tc_flusher<BlockSize> flusher;
+            (void)flusher;
+            cache.registered = true;
+        }
+
+        // Refills the empty list cache.head: from the spare batch, from the
+        // pool, or from a new chunk of blocks.  Blocks from the chunks, and
+        // from operator new, are never freed, only returned to the pool.
+        template<std::size_t BlockSize>
+        void tc_refill(tc_cache & cache)
+        {
+            using pool_type = tc_pool<BlockSize>;
+            if (!cache.registered)
+                v1_dtl::tc_register<BlockSize>(cache);
+            if (cache.spare) {
+                cache.head = cache.spare;
+                cache.count = pool_type::batch_size;
+                cache.spare = nullptr;
+                return;
+            }
+            auto const b = pool_type::instance().take();
+            if (b.head) {
+                cache.head = b.head;
+                cache.count = b.count;
+                return;
+            }
+            auto const chunk = static_cast<unsigned char *>(
+                ::operator new(pool_type::batch_size * BlockSize));
+            tc_block * head = nullptr;
+            for (std::size_t i = pool_type::batch_size; i-- > 0;) {
+                auto const block = ::new (chunk + i * BlockSize) tc_block;
+                block->next = head;
+                head = block;
+            }
+            cache.head = head;
+            cache.count = pool_type::batch_size;
+        }
+
+        template<std::size_t BlockSize>
+        void * tc_allocate()
+        {
+            tc_cache & cache = v1_dtl::tc_this_cache<BlockSize>();
+            if (!cache.head) {
+                // A block allocated in a destructor of a thread_local
+                // object, after the cache was flushed, is not cached.
+                if (cache.exited)
+                    return ::operator new(BlockSize);
+                v1_dtl::tc_refill<BlockSize>(cache);
+            }
+            tc_block * const retval = cache.head;
+            cache.head = retval->next;
+            --cache.count;
+            return retval;
+        }
+
+        template<std::size_t BlockSize>
+        void tc_deallocate(void * p) noexcept
+        {
+            using pool_type = tc_pool<BlockSize>;
+            tc_cache & cache = v1_dtl::tc_this_cache<BlockSize>();
+            tc_block * const block = ::new (p) tc_block;
+            if (cache.exited) {
+                block->next = nullptr;
+                pool_type::instance().put(block, 1);
+                return;
+            }
+            if (cache.count == pool_type::batch_size) {
+                pool_type::instance().put(cache.spare, pool_type::batch_size);
+                cache.spare = cache.head;
+                cache.head = nullptr;
+                cache.count = 0;
+            }
+            if (!cache.registered) {
+                try {
+                    v1_dtl::tc_register<BlockSize>(cache);
+                } catch (...) {
+                    // The flusher could not be registered; return the block
+                    // to the pool, so that it is not lost when the thread
+                    // exits.
+                    block->next = nullptr;
+                    pool_type::instance().put(block, 1);
+                    return;
+                }
+            }
+            block->next = cache.head;
+            cache.head = block;
+            ++cache.count;
+        }
+
+        template<typename T>
+        constexpr std::size_t tc_block_size() noexcept
+        {
+            return ((sizeof(T) < sizeof(tc_block) ? sizeof(tc_block)
+                                                  : sizeof(T)) +
+                    alignof(T) - 1) /
+                   alignof(T) * alignof(T);
+        }
+    }
+
+#endif
+
+    /** An allocator for node-based containers, whose single-object
+        allocations come from a cache of free blocks private to the
+        allocating thread, so that they take no lock.  A block freed on any
+        thread goes into that thread's cache; when a cache holds two
+        batches' worth of blocks, one batch goes back to a global pool, and
+        an empty cache takes a batch from the pool.  So the global pool's
+        lock is taken once per batch of blocks (4KB, or 16 blocks if that
+        is more), not once per node, even when the nodes are allocated on
+        one thread and freed on another, as they are when the stages of a
+        pipeline hand nodes on.  A thread's cached blocks go back to the
+        pool when it exits.
+
+        There is one pool for each block size, which is `sizeof(T)` rounded
+        up to a multiple of `alignof(T)`.  The pools' memory is never given
+        back to the system, since it holds the free blocks.  Allocations of
+        more than one object, and of types aligned more strictly than
+        `std::max_align_t`, are passed on to `std::allocator<T>`.
+
+        All `thread_caching_allocator`s are equal, so containers using it
+        can move and swap their nodes freely. */
+    template<typename T>
+    struct thread_caching_allocator
+    {
+        using value_type = T;
+        using propagate_on_container_move_assignment = std::true_type;
+        using is_always_equal = std::true_type;
+
+        template<typename U>
+        struct rebind
+        {
+            using other = thread_caching_allocator<U>;
+        };
+
+        thread_caching_allocator() noexcept = default;
+        template<typename U>
+        thread_caching_allocator(thread_caching_allocator<U> const &) noexcept
+        {}
+
+        T * allocate(std::size_t n)
+        {
+            if (n != 1 || !pooled)
+                return std::allocator<T>().allocate(n);
+            return static_cast<T *>(v1_dtl::tc_allocate<block_size>());
+        }
+        void deallocate(T * p, std::size_t n) noexcept
+        {
+            if (n != 1 || !pooled)
+                return std::allocator<T>().deallocate(p, n);
+            v1_dtl::tc_deallocate<block_size>(p);
+        }
+
+        template<typename U>
+        friend bool operator==(
+            thread_caching_allocator,
+            thread_caching_allocator<U>) noexcept
+        {
+            return true;
+        }
+        template<typename U>
+        friend bool operator!=(
+            thread_caching_allocator,
+            thread_caching_allocator<U>) noexcept
+        {
+            return false;
+        }
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+    private:
+        static constexpr bool pooled =
+            alignof(T) <= alignof(std::max_align_t);
+        static constexpr std::size_t block_size = v1_dtl::tc_block_size<T>();
+#endif
+    };
+
+}}}
+
+#endif
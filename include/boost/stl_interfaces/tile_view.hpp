@@ -0,0 +1,183 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_TILE_VIEW_HPP
+#define BOOST_STL_INTERFACES_TILE_VIEW_HPP
+
+#include <boost/stl_interfaces/md_view.hpp>
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+    template<typename View>
+    struct tile_iterator;
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    namespace v1_dtl {
+        template<typename View>
+        using tile_t = decltype(submd(
+            std::declval<View const &>(),
+            std::pair<std::ptrdiff_t, std::ptrdiff_t>(),
+            std::pair<std::ptrdiff_t, std::ptrdiff_t>()));
+
+        template<typename View>
+        using tile_iterator_interface_t = proxy_iterator_interface<
+            tile_iterator<View>,
+            std::random_access_iterator_tag,
+            tile_t<View>>;
+    }
+
+#endif
+
+    /** The iterator of a `tile_view`.  Its elements are the tiles of a
+        two-dimensional `md_view`, in row-major order, each of which is
+        itself an `md_view` (see `submd()`).  It is random access.
+
+        A tile of a `layout_right` matrix is `layout_right_padded`, so the
+        rows of a tile are ranges of pointers. */
+    template<typename View>
+    struct tile_iterator : v1_dtl::tile_iterator_interface_t<View>
+    {
+        static_assert(View::rank() == 2, "Only matrices are tiled.");
+
+        using tile_type = v1_dtl::tile_t<View>;
+
+        constexpr tile_iterator() noexcept :
+            tile_rows_(1),
+            tile_cols_(1),
+            across_(1),
+            n_(0)
+        {}
+        constexpr tile_iterator(
+            View const & v,
+            std::ptrdiff_t tile_rows,
+            std::ptrdiff_t tile_cols,
+            std::ptrdiff_t n) noexcept :
+            v_(v),
+            tile_rows_(tile_rows),
+            tile_cols_(tile_cols),
+            across_((v.extent(1) + tile_cols - 1) / tile_cols),
+            n_(n)
+        {
+            BOOST_ASSERT(0 < tile_rows && 0 < tile_cols);
+        }
+
+        constexpr tile_type operator*() const noexcept
+        {
+            auto const r = row();
+            auto const c = column();
+            return submd(
+                v_,
+                std::pair<std::ptrdiff_t, std::ptrdiff_t>(
+                    r, (std::min)(r + tile_rows_, v_.extent(0))),
+                std::pair<std::ptrdiff_t, std::ptrdiff_t>(
+                    c, (std::min)(c + tile_cols_, v_.extent(1))));
+        }
+        constexpr tile_iterator & operator+=(std::ptrdiff_t n) noexcept
+        {
+            n_ += n;
+            return *this;
+        }
+        friend constexpr std::ptrdiff_t operator-(
+            tile_iterator const & lhs, tile_iterator const & rhs) noexcept
+        {
+            return lhs.n_ - rhs.n_;
+        }
+
+        /** Returns the index of the first row of the current tile, in the
+            tiled view. */
+        constexpr std::ptrdiff_t row() const noexcept
+        {
+            return n_ / across_ * tile_rows_;
+        }
+        /** Returns the index of the first column of the current tile, in
+            the tiled view. */
+        constexpr std::ptrdiff_t column() const noexcept
+        {
+            return n_ % across_ * tile_cols_;
+        }
+
+    private:
+        View v_;
+        std::ptrdiff_t tile_rows_;
+        std::ptrdiff_t tile_cols_;
+        std::ptrdiff_t across_;
+        std::ptrdiff_t n_;
+    };
+
+    /** A view of the `tile_rows` by `tile_cols` tiles of a two-dimensional
+        `md_view`, from left to right and then top to bottom.  The tiles at
+        the right and bottom edges are smaller, if the extents of the view
+        are not multiples of the tile extents.  A loop over the tiles, and
+        then over the rows of each tile, visits the elements of a matrix in
+        cache-sized blocks, as in a blocked transpose or stencil.
+
+        \see `tile_iterator` */
+    template<typename View>
+    struct tile_view : view_interface<tile_view<View>>
+    {
+        using iterator = tile_iterator<View>;
+
+        constexpr tile_view() noexcept : tile_rows_(1), tile_cols_(1) {}
+        constexpr tile_view(
+            View v,
+            std::ptrdiff_t tile_rows,
+            std::ptrdiff_t tile_cols) noexcept :
+            v_(v),
+            tile_rows_(tile_rows),
+            tile_cols_(tile_cols)
+        {
+            BOOST_ASSERT(0 < tile_rows && 0 < tile_cols);
+        }
+
+        constexpr iterator begin() const noexcept
+        {
+            return iterator(v_, tile_rows_, tile_cols_, 0);
+        }
+        constexpr iterator end() const noexcept
+        {
+            return iterator(
+                v_, tile_rows_, tile_cols_, tiles_down() * tiles_across());
+        }
+
+        /** Returns the number of rows of tiles. */
+        constexpr std::ptrdiff_t tiles_down() const noexcept
+        {
+            return (v_.extent(0) + tile_rows_ - 1) / tile_rows_;
+        }
+        /** Returns the number of columns of tiles. */
+        constexpr std::ptrdiff_t tiles_across() const noexcept
+        {
+            return (v_.extent(1) + tile_cols_ - 1) / tile_cols_;
+        }
+
+        /** Returns the tiled view. */
+        constexpr View const & base() const noexcept { return v_; }
+
+    private:
+        View v_;
+        std::ptrdiff_t tile_rows_;
+        std::ptrdiff_t tile_cols_;
+    };
+
+    /** Returns a `tile_view` of `v`, in tiles of `tile_rows` by `tile_cols`
+        elements. */
+    template<typename T, typename Extents, typename Layout>
+    constexpr tile_view<md_view<T, Extents, Layout>> make_tile_view(
+        md_view<T, Extents, Layout> v,
+        std::ptrdiff_t tile_rows,
+        std::ptrdiff_t tile_cols) noexcept
+    {
+        return tile_view<md_view<T, Extents, Layout>>(v, tile_rows, tile_cols);
+    }
+
+}}}
+
+#endif
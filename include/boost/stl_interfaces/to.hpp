@@ -0,0 +1,228 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_TO_HPP
+#define BOOST_STL_INTERFACES_TO_HPP
+
+#include <boost/stl_interfaces/range_adaptor_closure.hpp>
+
+#include <iterator>
+#include <utility>
+
+#if 201703L < __cplusplus && defined(__cpp_lib_concepts)
+#include <ranges>
+#endif
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    namespace v1_dtl {
+        template<typename Range>
+        using to_begin_t = decltype(std::begin(std::declval<Range &>()));
+        template<typename Range>
+        using to_end_t = decltype(std::end(std::declval<Range &>()));
+        template<typename Range>
+        using to_member_size_t = decltype(std::declval<Range &>().size());
+
+        template<typename Range>
+        using to_common_ra_range = std::integral_constant<
+            bool,
+            std::is_same<to_begin_t<Range>, to_end_t<Range>>::value &&
+                std::is_convertible<
+                    typename std::iterator_traits<
+                        to_begin_t<Range>>::iterator_category,
+                    std::random_access_iterator_tag>::value>;
+
+        // 2 if the size of r is r.size(), 1 if it is end - begin, and 0 if
+        // it is not known without counting.
+        template<typename Range>
+        using to_size_kind = std::integral_constant<
+            int,
+            detail::detector<void, to_member_size_t, Range>::value
+                ? 2
+                : to_common_ra_range<Range>::value ? 1 : 0>;
+
+        template<typename Container>
+        using to_reserve_t = decltype(std::declval<Container &>().reserve(
+            std::declval<Container &>().size()));
+
+        template<typename Container, typename Range>
+        using to_append_range_t = decltype(
+            std::declval<Container &>().append_range(
+                std::declval<Range &>()));
+        template<typename Container, typename Range>
+        using to_insert_t = decltype(std::declval<Container &>().insert(
+            std::declval<Container &>().end(),
+            std::declval<to_begin_t<Range>>(),
+            std::declval<to_end_t<Range>>()));
+
+        // 2 to append with append_range(), 1 with insert() at the end, and 0
+        // one element at a time with push_back().
+        template<typename Container, typename Range>
+        using to_append_kind = std::integral_constant<
+            int,
+            detail::detector<void, to_append_range_t, Container, Range>::value
+                ? 2
+                : detail::detector<void, to_insert_t, Container, Range>::value
+                      ? 1
+                      : 0>;
+
+        template<int Kind>
+        using to_kind = std::integral_constant<int, Kind>;
+
+        template<typename Container, typename Range>
+        void to_reserve(Container & c, Range & r, to_kind<2>, std::true_type)
+        {
+            using size_type = decltype(c.size());
+            c.reserve(size_type(r.size()));
+        }
+        template<typename Container, typename Range>
+        void to_reserve(Container & c, Range & r, to_kind<1>, std::true_type)
+        {
+            using size_type = decltype(c.size());
+            c.reserve(size_type(std::end(r) - std::begin(r)));
+        }
+        template<typename Container, typename Range, int Kind>
+        void to_reserve(Container &, Range &, to_kind<Kind>, std::false_type)
+        {}
+        template<typename Container, typename Range>
+        void to_reserve(Container &, Range &, to_kind<0>, std::true_type)
+        {}
+
+        template<typename Container, typename Range>
+        void to_append(Container & c, Range & r, to_kind<2>)
+        {
+            c.append_range(r);
+        }
+        template<typename Container, typename Range>
+        void to_append(Container & c, Range & r, to_kind<1>)
+        {
+            c.insert(c.end(), std::begin(r), std::end(r));
+        }
+        template<typename Container, typename Range>
+        void to_append(Container & c, Range & r, to_kind<0>)
+        {
+            auto last = std::end(r);
+            for (auto first = std::begin(r); first != last; ++first) {
+                c.push_back(*first);
+            }
+        }
+
+        template<typename Container>
+        struct to_closure : range_adaptor_closure<to_closure<Container>>
+        {
+            template<typename Range>
+            Container operator()(Range && r) const;
+        };
+    }
+
+#endif
+
+    /** Returns a `Container` of the elements of `r`, like C++23's
+        `std::ranges::to<Container>(r)`.
+
+        When the size of `r` is known without counting its elements --
+        from `r.size()`, or from `end - begin` of random access iterators --
+        and `Container` has `reserve()`, the container reserves room for
+        all of them first.  The elements are then appended all at once,
+        with `append_range()` if `Container` has it, as C++23 standard
+        containers and containers derived from `container_interface` do,
+        and with `insert()` at the end otherwise, so that a `std::vector`
+        copies a contiguous range of trivially copyable elements with one
+        `memmove()`.  Only a container with neither, or a range whose `end()`
+        is a sentinel, is filled one `push_back()` at a time.
+        \see `parallel_to()` */
+    template<typename Container, typename Range>
+    Container to(Range && r)
+    {
+        Container retval;
+        v1_dtl::to_reserve(
+            retval,
+            r,
+            v1_dtl::to_size_kind<Range>{},
+            std::integral_constant<
+                bool,
+                detail::detector<void, v1_dtl::to_reserve_t, Container>::
+                    value>{});
+        v1_dtl::to_append(
+            retval, r, v1_dtl::to_append_kind<Container, Range>{});
+        return retval;
+    }
+
+    /** Returns a range adaptor closure `c` such that `r | c` is
+        `to<Container>(r)`. */
+    template<typename Container>
+    constexpr v1_dtl::to_closure<Container> to() noexcept
+    {
+        return {};
+    }
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    namespace v1_dtl {
+        template<typename Container>
+        template<typename Range>
+        Container to_closure<Container>::operator()(Range && r) const
+        {
+            return stl_interfaces::to<Container>(std::forward<Range>(r));
+        }
+    }
+
+#endif
+
+}}}
+
+#if 201703L < __cplusplus && defined(__cpp_lib_concepts) &&                    \
+        !defined(BOOST_STL_INTERFACES_DISABLE_V2) ||                           \
+    BOOST_STL_INTERFACES_DOXYGEN
+
+namespace boost { namespace stl_interfaces { namespace v2 {
+
+    // clang-format off
+
+    /** Returns a `Container` of the elements of `r`, like C++23's
+        `std::ranges::to<Container>(r)`.  It is `v1::to()`, constrained
+        with the standard range concepts: the container reserves room first
+        if `r` models `std::ranges::sized_range`, and the elements are
+        appended with `append_range()`, or with `insert()` at the end of a
+        `std::ranges::common_range`, or else one `push_back()` at a
+        time. */
+    template<typename Container, std::ranges::input_range R>
+    constexpr Container to(R && r)
+    {
+        Container retval;
+        if constexpr (
+            std::ranges::sized_range<R> &&
+            requires { retval.reserve(retval.size()); }) {
+            using size_type = decltype(retval.size());
+            retval.reserve(size_type(std::ranges::size(r)));
+        }
+        if constexpr (requires { retval.append_range(r); }) {
+            retval.append_range(r);
+        } else if constexpr (
+            std::ranges::common_range<R> &&
+            requires {
+                retval.insert(
+                    retval.end(), std::ranges::begin(r), std::ranges::end(r));
+            }) {
+            retval.insert(
+                retval.end(), std::ranges::begin(r), std::ranges::end(r));
+        } else {
+            for (auto && x : r) {
+                retval.push_back(static_cast<decltype(x)>(x));
+            }
+        }
+        return retval;
+    }
+
+    // clang-format on
+
+}}}
+
+#endif
+
+#endif
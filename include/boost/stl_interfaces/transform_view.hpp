@@ -0,0 +1,178 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_TRANSFORM_VIEW_HPP
+#define BOOST_STL_INTERFACES_TRANSFORM_VIEW_HPP
+
+#include <boost/stl_interfaces/iterator_interface.hpp>
+#include <boost/stl_interfaces/detail/functor_box.hpp>
+#include <boost/stl_interfaces/view_interface.hpp>
+
+#include <iterator>
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+    /** A function object that returns its argument unchanged.  This is a
+        pre-C++20 version of `std::identity` (see [func.identity] in the C++
+        standard). */
+    struct identity
+    {
+        template<typename T>
+        constexpr T && operator()(T && x) const noexcept
+        {
+            return std::forward<T>(x);
+        }
+    };
+
+    template<typename Iter, typename F>
+    struct transform_iterator;
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    namespace v1_dtl {
+        template<typename Iter, typename F>
+        using transform_reference_t = decltype(
+            std::declval<F const &>()(*std::declval<Iter const &>()));
+
+        // A contiguous iterator is transformed into a random access one,
+        // since the results of F are not in an array.
+        template<typename Iter>
+        using transform_concept_t = std::conditional_t<
+            std::is_convertible<
+                typename std::iterator_traits<Iter>::iterator_category,
+                std::random_access_iterator_tag>::value,
+            std::random_access_iterator_tag,
+            typename std::iterator_traits<Iter>::iterator_category>;
+
+        template<typename Reference>
+        using transform_pointer_t = std::conditional_t<
+            std::is_reference<Reference>::value,
+            std::remove_reference_t<Reference> *,
+            proxy_arrow_result<Reference>>;
+
+        template<typename Iter, typename F>
+        using transform_iterator_interface_t = iterator_interface<
+            transform_iterator<Iter, F>,
+            transform_concept_t<Iter>,
+            std::remove_cv_t<
+                std::remove_reference_t<transform_reference_t<Iter, F>>>,
+            transform_reference_t<Iter, F>,
+            transform_pointer_t<transform_reference_t<Iter, F>>,
+            iter_difference_t<Iter>>;
+    }
+
+#endif
+
+    /** An iterator whose elements are `f(x)` for the elements `x` of an
+        underlying iterator, like the iterator of
+        `std::ranges::transform_view`.  Its reference type is the result of
+        calling `f` -- so a proxy iterator, if `f` returns by value -- and it
+        has the category of the underlying iterator, except that a contiguous
+        iterator is transformed into a random access one.
+
+        An empty `F`, such as a lambda that captures nothing, takes no space,
+        so a `transform_iterator` is the size of its underlying iterator.
+        `F` is called as an `F const`.  `base()` returns the underlying
+        iterator, for code that needs the untransformed elements.
+
+        \see `transform_view` */
+    template<typename Iter, typename F>
+    struct transform_iterator
+        : v1_dtl::transform_iterator_interface_t<Iter, F>,
+          private detail::functor_box<F>
+    {
+        using reference = v1_dtl::transform_reference_t<Iter, F>;
+
+        constexpr transform_iterator() = default;
+        constexpr transform_iterator(Iter it, F f) :
+            detail::functor_box<F>(std::move(f)),
+            it_(it)
+        {}
+
+        constexpr reference operator*() const { return this->get()(*it_); }
+        constexpr transform_iterator & operator++()
+        {
+            ++it_;
+            return *this;
+        }
+        constexpr transform_iterator & operator--()
+        {
+            --it_;
+            return *this;
+        }
+        template<typename I = Iter>
+        constexpr auto operator+=(v1_dtl::iter_difference_t<I> n)
+            -> decltype(
+                std::declval<I &>() += n, std::declval<transform_iterator &>())
+        {
+            it_ += n;
+            return *this;
+        }
+
+        /** Returns the underlying iterator. */
+        constexpr Iter base() const { return it_; }
+        /** Returns the function applied to each element. */
+        constexpr F const & functor() const noexcept { return this->get(); }
+
+        using base_type = v1_dtl::transform_iterator_interface_t<Iter, F>;
+        using base_type::operator++;
+        using base_type::operator--;
+
+    private:
+        friend access;
+
+        constexpr Iter & base_reference() noexcept { return it_; }
+        constexpr Iter const & base_reference() const noexcept { return it_; }
+
+        Iter it_ = Iter();
+    };
+
+    /** A view of `f(x)` for the elements `x` of `[first, last)`, like
+        `std::ranges::transform_view`.
+        \see `transform_iterator` */
+    template<typename Iter, typename F>
+    struct transform_view : view_interface<transform_view<Iter, F>>,
+                            private detail::functor_box<F>
+    {
+        using iterator = transform_iterator<Iter, F>;
+
+        constexpr transform_view() = default;
+        constexpr transform_view(Iter first, Iter last, F f) :
+            detail::functor_box<F>(std::move(f)),
+            first_(first),
+            last_(last)
+        {}
+
+        constexpr iterator begin() const
+        {
+            return iterator(first_, this->get());
+        }
+        constexpr iterator end() const { return iterator(last_, this->get()); }
+
+        /** Returns the beginning of the underlying range. */
+        constexpr Iter base_begin() const { return first_; }
+        /** Returns the end of the underlying range. */
+        constexpr Iter base_end() const { return last_; }
+        /** Returns the function applied to each element. */
+        constexpr F const & functor() const noexcept { return this->get(); }
+
+    private:
+        Iter first_ = Iter();
+        Iter last_ = Iter();
+    };
+
+    /** Returns a `transform_view` of `f(x)` for the elements `x` of `r`. */
+    template<typename Range, typename F>
+    constexpr auto make_transform_view(Range && r, F f)
+    {
+        using iter = decltype(std::begin(r));
+        return transform_view<iter, F>(
+            std::begin(r), std::end(r), std::move(f));
+    }
+
+}}}
+
+#endif
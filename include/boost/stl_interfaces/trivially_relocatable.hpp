@@ -0,0 +1,161 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_TRIVIALLY_RELOCATABLE_HPP
+#define BOOST_STL_INTERFACES_TRIVIALLY_RELOCATABLE_HPP
+
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include <cstring>
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+    /** `std::true_type` if an object of type `T` can be relocated -- moved to
+        new storage, ending its lifetime in the old storage -- by copying its
+        bytes; `std::false_type` otherwise.
+
+        By default this is `std::is_trivially_copyable<T>`.  Users may
+        specialize this template for their own types, which are often
+        trivially relocatable even when they have non-trivial move
+        constructors or destructors (a type that owns a heap allocation
+        through a pointer, for instance).  A type that stores a pointer into
+        itself, like many implementations of `std::string`, is not trivially
+        relocatable.
+
+        `std::unique_ptr` with the default deleter is trivially relocatable
+        in all known standard library implementations, and so uses a
+        specialization that is `std::true_type`. */
+    template<typename T>
+    struct is_trivially_relocatable : std::is_trivially_copyable<T>
+    {
+    };
+
+    /** `std::true_type` if inserting objects of type `Ref` into a sequence of
+        `T`s cannot throw, apart from any allocation: constructing and
+        assigning a `T` from a `Ref`, and moving a `T`, are all `noexcept`.
+        `std::false_type` otherwise.
+
+        This selects the paths that this library's insertions take.  When it
+        is true, they do not prepare to undo a partial insertion -- there
+        are no rollback handlers around the copies into a gap, and
+        `container_interface`'s `assign(n, x)` replaces the elements in
+        place where it would otherwise build a new container and swap it
+        in.  When it is false, those paths keep the container valid, or
+        unchanged, when a copy throws.  Users may specialize it, to choose
+        the other paths for their own types. */
+    template<typename T, typename Ref = T const &>
+    struct is_nothrow_insertable
+        : std::integral_constant<
+              bool,
+              std::is_nothrow_constructible<T, Ref>::value &&
+                  std::is_nothrow_assignable<T &, Ref>::value &&
+                  std::is_nothrow_move_constructible<T>::value &&
+                  std::is_nothrow_move_assignable<T>::value>
+    {
+    };
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    template<typename T>
+    struct is_trivially_relocatable<std::unique_ptr<T, std::default_delete<T>>>
+        : std::true_type
+    {
+    };
+
+    namespace v1_dtl {
+        template<typename T>
+        T * relocate_bytes(T * first, T * last, T * out) noexcept
+        {
+            auto const n = last - first;
+            if (n) {
+                std::memmove(
+                    static_cast<void *>(out),
+                    static_cast<void const *>(first),
+                    n * sizeof(T));
+            }
+            return out + n;
+        }
+
+        template<typename T>
+        T * uninitialized_relocate_impl(
+            T * first, T * last, T * out, std::true_type) noexcept
+        {
+            return v1_dtl::relocate_bytes(first, last, out);
+        }
+        template<typename T>
+        T * uninitialized_relocate_impl(
+            T * first, T * last, T * out, std::false_type)
+        {
+            for (; first != last; ++first, ++out) {
+                ::new (static_cast<void *>(out)) T(std::move(*first));
+                first->~T();
+            }
+            return out;
+        }
+
+        template<typename T>
+        T * uninitialized_relocate_backward_impl(
+            T * first, T * last, T * d_last, std::true_type) noexcept
+        {
+            auto const n = last - first;
+            v1_dtl::relocate_bytes(first, last, d_last - n);
+            return d_last - n;
+        }
+        template<typename T>
+        T * uninitialized_relocate_backward_impl(
+            T * first, T * last, T * d_last, std::false_type)
+        {
+            while (first != last) {
+                --last;
+                --d_last;
+                ::new (static_cast<void *>(d_last)) T(std::move(*last));
+                last->~T();
+            }
+            return d_last;
+        }
+    }
+
+#endif
+
+    /** Relocates the objects in `[first, last)` to the uninitialized storage
+        starting at `out`, in order, and returns the end of the relocated
+        range.  After the call, the storage in `[first, last)` that is not
+        also in the result range is uninitialized.  The ranges may overlap
+        only if `out <= first`.
+
+        If `is_trivially_relocatable<T>` is true, this is a single
+        `std::memmove()`.  Otherwise each object is move-constructed into its
+        new storage and then destroyed; if a move constructor throws, the
+        objects already relocated remain at `out`, and those not yet
+        relocated remain in `[first, last)`. */
+    template<typename T>
+    T * uninitialized_relocate(T * first, T * last, T * out) noexcept(
+        is_trivially_relocatable<T>::value ||
+        std::is_nothrow_move_constructible<T>::value)
+    {
+        return v1_dtl::uninitialized_relocate_impl(
+            first, last, out, is_trivially_relocatable<T>{});
+    }
+
+    /** Relocates the objects in `[first, last)` to the uninitialized storage
+        ending at `d_last`, back to front, and returns the beginning of the
+        relocated range.  The ranges may overlap only if `last <= d_last`.
+        \see `uninitialized_relocate()` */
+    template<typename T>
+    T * uninitialized_relocate_backward(T * first, T * last, T * d_last) noexcept(
+        is_trivially_relocatable<T>::value ||
+        std::is_nothrow_move_constructible<T>::value)
+    {
+        return v1_dtl::uninitialized_relocate_backward_impl(
+            first, last, d_last, is_trivially_relocatable<T>{});
+    }
+
+}}}
+
+#endif
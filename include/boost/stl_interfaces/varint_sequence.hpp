@@ -0,0 +1,385 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_VARINT_SEQUENCE_HPP
+#define BOOST_STL_INTERFACES_VARINT_SEQUENCE_HPP
+
+#include <boost/stl_interfaces/iterator_interface.hpp>
+#include <boost/stl_interfaces/view_interface.hpp>
+#include <boost/stl_interfaces/detail/simd.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(BOOST_STL_INTERFACES_SIMD_VECTORS) &&                             \
+    (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define BOOST_STL_INTERFACES_VARINT_SSSE3
+#endif
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+    //[ stream_vbyte
+    // A varint_sequence stores a sequence of std::uint32_t as the differences
+    // between neighbors (the first element's difference is from 0), which are
+    // small for the sorted document IDs of a posting list or the timestamps of
+    // a time series, in the Stream VByte format: each difference takes 1 to 4
+    // bytes, little-endian, in a data array; and its length, less one, takes 2
+    // bits of a control array, four to a byte.  Keeping the lengths apart from
+    // the data, rather than in a continuation bit of each byte as LEB128 does,
+    // means that one control byte describes where four values are, so a group
+    // of four is decoded with one table lookup and one byte shuffle.
+    namespace stream_vbyte {
+        // The data array is followed by this many bytes, so that a group's 16
+        // bytes, or a value's 4, can be loaded without reading past the end.
+        constexpr std::size_t padding = 16;
+
+        inline unsigned length(
+            std::uint8_t const * ctrl, std::size_t i) noexcept
+        {
+            return ((ctrl[i / 4] >> (i % 4 * 2)) & 3u) + 1;
+        }
+
+        inline unsigned encoded_length(std::uint32_t x) noexcept
+        {
+            return 1 + (0xffu < x) + (0xffffu < x) + (0xffffffu < x);
+        }
+
+        inline std::uint32_t
+        read(std::uint8_t const * data, unsigned length) noexcept
+        {
+            // Compilers turn this into one load on little-endian targets.
+            std::uint32_t const x = std::uint32_t(data[0]) |
+                                    std::uint32_t(data[1]) << 8 |
+                                    std::uint32_t(data[2]) << 16 |
+                                    std::uint32_t(data[3]) << 24;
+            return x & (0xffffffffu >> (32 - 8 * length));
+        }
+
+        // Decodes the n values starting at index i, whose bytes start at data,
+        // where prev is the value at index i - 1 (or 0).  Returns the end of
+        // the values' bytes.
+        inline std::uint8_t const * decode_scalar(
+            std::uint8_t const * ctrl,
+            std::uint8_t const * data,
+            std::size_t i,
+            std::size_t n,
+            std::uint32_t prev,
+            std::uint32_t * out) noexcept
+        {
+            for (n += i; i < n; ++i) {
+                auto const len = length(ctrl, i);
+                prev += read(data, len);
+                *out++ = prev;
+                data += len;
+            }
+            return data;
+        }
+
+        // For each control byte, the number of data bytes its four values
+        // take, and the shuffle that moves those bytes into four 32-bit lanes,
+        // with zeros above each value's bytes.
+        struct tables
+        {
+            tables() noexcept
+            {
+                for (unsigned c = 0; c < 256; ++c) {
+                    unsigned byte = 0;
+                    for (unsigned v = 0; v < 4; ++v) {
+                        auto const len = ((c >> (2 * v)) & 3u) + 1;
+                        for (unsigned b = 0; b < 4; ++b) {
+                            shuffle[c][4 * v + b] =
+                                b < len ? std::uint8_t(byte + b) : 0x80;
+                        }
+                        byte += len;
+                    }
+                    lengths[c] = std::uint8_t(byte);
+                }
+            }
+
+            alignas(16) std::uint8_t shuffle[256][16];
+            std::uint8_t lengths[256];
+        };
+
+        inline tables const & get_tables() noexcept
+        {
+            static tables const retval;
+            return retval;
+        }
+
+        // Decodes the next groups groups of four values; ctrl is their first
+        // control byte.
+        inline std::uint8_t const * decode_groups_scalar(
+            std::uint8_t const * ctrl,
+            std::uint8_t const * data,
+            std::size_t groups,
+            std::uint32_t prev,
+            std::uint32_t * out) noexcept
+        {
+            return decode_scalar(ctrl, data, 0, 4 * groups, prev, out);
+        }
+
+#ifdef BOOST_STL_INTERFACES_VARINT_SSSE3
+        // The same, with one 16-byte load and one pshufb per group, and the
+        // deltas summed in the vector register.  SSSE3 is not part of the
+        // x86-64 baseline, so this is compiled for it alone, and chosen at run
+        // time.
+        __attribute__((target("ssse3"))) inline std::uint8_t const *
+        decode_groups_ssse3(
+            std::uint8_t const * ctrl,
+            std::uint8_t const * data,
+            std::size_t groups,
+            std::uint32_t prev,
+            std::uint32_t * out) noexcept
+        {
+            auto const & t = get_tables();
+            __m128i sum = _mm_set1_epi32(int(prev));
+            for (std::size_t g = 0; g < groups; ++g) {
+                auto const c = ctrl[g];
+                __m128i const bytes =
+                    _mm_loadu_si128(reinterpret_cast<__m128i const *>(data));
+                __m128i d = _mm_shuffle_epi8(
+                    bytes,
+                    _mm_load_si128(
+                        reinterpret_cast<__m128i const *>(t.shuffle[c])));
+                d = _mm_add_epi32(d, _mm_slli_si128(d, 4));
+                d = _mm_add_epi32(d, _mm_slli_si128(d, 8));
+                sum = _mm_add_epi32(d, sum);
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 4 * g), sum);
+                sum = _mm_shuffle_epi32(sum, 0xff);
+                data += t.lengths[c];
+            }
+            return data;
+        }
+#endif
+
+        using decode_groups_fn = std::uint8_t const * (*)(
+            std::uint8_t const *,
+            std::uint8_t const *,
+            std::size_t,
+            std::uint32_t,
+            std::uint32_t *);
+
+        inline decode_groups_fn decode_groups() noexcept
+        {
+#ifdef BOOST_STL_INTERFACES_VARINT_SSSE3
+            static decode_groups_fn const retval = [] {
+                __builtin_cpu_init();
+                return __builtin_cpu_supports("ssse3") ? &decode_groups_ssse3
+                                                       : &decode_groups_scalar;
+            }();
+            return retval;
+#else
+            return &decode_groups_scalar;
+#endif
+        }
+
+        // Decodes n values as decode_scalar() does, a group of four at a time
+        // once i is a multiple of four.
+        inline std::uint8_t const * decode(
+            std::uint8_t const * ctrl,
+            std::uint8_t const * data,
+            std::size_t i,
+            std::size_t n,
+            std::uint32_t prev,
+            std::uint32_t * out) noexcept
+        {
+            auto const head = (std::min)(n, (4 - i % 4) % 4);
+            data = decode_scalar(ctrl, data, i, head, prev, out);
+            if (head) {
+                prev = out[head - 1];
+                out += head;
+                i += head;
+                n -= head;
+            }
+            auto const groups = n / 4;
+            if (groups) {
+                data = decode_groups()(ctrl + i / 4, data, groups, prev, out);
+                prev = out[4 * groups - 1];
+                out += 4 * groups;
+                i += 4 * groups;
+                n -= 4 * groups;
+            }
+            return decode_scalar(ctrl, data, i, n, prev, out);
+        }
+    }
+    //]
+
+    //[ varint_iterator
+    // A forward iterator over a varint_sequence.  It holds the running sum, and
+    // operator++() reads one more difference into it; the value is returned
+    // by value, so this is a proxy iterator.  Its read_n() member is the bulk
+    // decode, which copy() and transform() from algorithm.hpp use.
+    struct varint_iterator : proxy_iterator_interface<
+                                 varint_iterator,
+                                 std::forward_iterator_tag,
+                                 std::uint32_t>
+    {
+        varint_iterator() noexcept :
+            ctrl_(nullptr), data_(nullptr), i_(0), size_(0), value_(0)
+        {}
+        varint_iterator(
+            std::uint8_t const * ctrl,
+            std::uint8_t const * data,
+            std::size_t size) noexcept :
+            ctrl_(ctrl), data_(data), i_(0), size_(size), value_(0)
+        {
+            if (size_) {
+                value_ =
+                    stream_vbyte::read(data_, stream_vbyte::length(ctrl_, 0));
+            }
+        }
+        // The end iterator.
+        explicit varint_iterator(std::size_t size) noexcept :
+            ctrl_(nullptr), data_(nullptr), i_(size), size_(size), value_(0)
+        {}
+
+        std::uint32_t operator*() const noexcept { return value_; }
+        varint_iterator & operator++() noexcept
+        {
+            data_ += stream_vbyte::length(ctrl_, i_);
+            if (++i_ < size_) {
+                value_ +=
+                    stream_vbyte::read(data_, stream_vbyte::length(ctrl_, i_));
+            }
+            return *this;
+        }
+        friend bool
+        operator==(varint_iterator lhs, varint_iterator rhs) noexcept
+        {
+            return lhs.i_ == rhs.i_;
+        }
+
+        using base_type = proxy_iterator_interface<
+            varint_iterator,
+            std::forward_iterator_tag,
+            std::uint32_t>;
+        using base_type::operator++;
+
+    private:
+        friend access;
+
+        void read_n(std::ptrdiff_t n, std::uint32_t * out) const noexcept
+        {
+            if (n <= 0)
+                return;
+            *out = value_;
+            stream_vbyte::decode(
+                ctrl_,
+                data_ + stream_vbyte::length(ctrl_, i_),
+                i_ + 1,
+                std::size_t(n - 1),
+                value_,
+                out + 1);
+        }
+
+        std::uint8_t const * ctrl_;
+        std::uint8_t const * data_;
+        std::size_t i_;
+        std::size_t size_;
+        std::uint32_t value_;
+    };
+    //]
+
+    //[ varint_sequence
+    // A view of a delta- and Stream VByte-encoded sequence.
+    struct varint_view : view_interface<varint_view>
+    {
+        varint_view() noexcept : ctrl_(nullptr), data_(nullptr), size_(0) {}
+        varint_view(
+            std::uint8_t const * ctrl,
+            std::uint8_t const * data,
+            std::size_t size) noexcept :
+            ctrl_(ctrl), data_(data), size_(size)
+        {}
+
+        varint_iterator begin() const noexcept
+        {
+            return varint_iterator(ctrl_, data_, size_);
+        }
+        varint_iterator end() const noexcept { return varint_iterator(size_); }
+
+        // Forward iterators cannot subtract, so view_interface cannot provide
+        // size().
+        std::size_t size() const noexcept { return size_; }
+
+        // The encoded bytes: the control bytes, and the data bytes.
+        std::uint8_t const * control_bytes() const noexcept { return ctrl_; }
+        std::uint8_t const * data_bytes() const noexcept { return data_; }
+
+        // Decodes all the values to out, which has room for size() of them.
+        void decode(std::uint32_t * out) const noexcept
+        {
+            stream_vbyte::decode(ctrl_, data_, 0, size_, 0, out);
+        }
+
+    private:
+        std::uint8_t const * ctrl_;
+        std::uint8_t const * data_;
+        std::size_t size_;
+    };
+
+    // Owns a delta- and Stream VByte-encoded sequence, which can grow at the
+    // end.
+    struct varint_sequence
+    {
+        varint_sequence() : data_(stream_vbyte::padding), size_(0), last_(0) {}
+        template<typename Iter>
+        varint_sequence(Iter first, Iter last) : varint_sequence()
+        {
+            for (; first != last; ++first) {
+                push_back(*first);
+            }
+        }
+
+        void push_back(std::uint32_t x)
+        {
+            std::uint32_t const delta = x - last_;
+            auto const len = stream_vbyte::encoded_length(delta);
+            if (size_ % 4 == 0)
+                ctrl_.push_back(0);
+            ctrl_.back() |= std::uint8_t((len - 1) << (size_ % 4 * 2));
+            // The new bytes go where the padding starts, and the padding moves
+            // up.
+            auto const where = data_.size() - stream_vbyte::padding;
+            data_.resize(data_.size() + len);
+            for (unsigned b = 0; b < len; ++b) {
+                data_[where + b] = std::uint8_t(delta >> (8 * b));
+            }
+            ++size_;
+            last_ = x;
+        }
+
+        varint_view view() const noexcept
+        {
+            return varint_view(ctrl_.data(), data_.data(), size_);
+        }
+        varint_iterator begin() const noexcept { return view().begin(); }
+        varint_iterator end() const noexcept { return view().end(); }
+
+        std::size_t size() const noexcept { return size_; }
+        bool empty() const noexcept { return !size_; }
+        // The bytes the encoded sequence takes, not counting the padding.
+        std::size_t encoded_size() const noexcept
+        {
+            return ctrl_.size() + data_.size() - stream_vbyte::padding;
+        }
+
+    private:
+        std::vector<std::uint8_t> ctrl_;
+        std::vector<std::uint8_t> data_;
+        std::size_t size_;
+        std::uint32_t last_;
+    };
+    //]
+
+}}}
+
+#endif
@@ -7,6 +7,9 @@
 #define BOOST_STL_INTERFACES_VIEW_INTERFACE_HPP
 
 #include <boost/stl_interfaces/fwd.hpp>
+#include <boost/stl_interfaces/iterator_interface.hpp>
+
+#include <boost/assert.hpp>
 
 
 namespace boost { namespace stl_interfaces { inline namespace v1 {
@@ -33,9 +36,93 @@ namespace boost { namespace stl_interfaces { inline namespace v1 {
         >
     struct view_interface;
 
+    template<
+        typename Iterator,
+        typename Sentinel = Iterator,
+        bool Contiguous = discontiguous>
+    struct subrange;
+
     namespace v1_dtl {
         template<typename D, bool Contiguous>
         void derived_view(view_interface<D, Contiguous> const &);
+
+        template<typename Range, bool Contiguous>
+        using subrange_t =
+            subrange<iterator_t<Range>, iterator_t<Range>, Contiguous>;
+
+        // A view whose begin() is expensive may say whether it is empty,
+        // or how many elements it has, more cheaply, with a cheap_empty()
+        // or cheap_size() member (which may be private if the view
+        // befriends access).  empty() uses the first of cheap_empty(),
+        // cheap_size() == 0 and begin() == end() that D has; size() uses
+        // cheap_size() before end() - begin().
+        template<typename D>
+        using cheap_empty_t =
+            decltype(access::cheap_empty(std::declval<D &>()));
+        template<typename D>
+        using cheap_size_t = decltype(access::cheap_size(std::declval<D &>()));
+
+        template<typename D>
+        using view_empty_kind = std::integral_constant<
+            int,
+            detail::detector<void, cheap_empty_t, D>::value
+                ? 0
+                : (detail::detector<void, cheap_size_t, D>::value ? 1 : 2)>;
+        template<typename D>
+        using view_size_kind = std::integral_constant<
+            int,
+            detail::detector<void, cheap_size_t, D>::value ? 1 : 2>;
+
+        template<int Kind>
+        using view_kind = std::integral_constant<int, Kind>;
+
+        template<typename D>
+        constexpr auto view_empty(D & d, view_kind<0>) noexcept(
+            noexcept(access::cheap_empty(d)))
+            -> decltype(bool(access::cheap_empty(d)))
+        {
+            return access::cheap_empty(d);
+        }
+        template<typename D>
+        constexpr auto view_empty(D & d, view_kind<1>) noexcept(
+            noexcept(access::cheap_size(d) == 0))
+            -> decltype(bool(access::cheap_size(d) == 0))
+        {
+            return access::cheap_size(d) == 0;
+        }
+        template<typename D>
+        constexpr auto view_empty(D & d, view_kind<2>) noexcept(
+            noexcept(d.begin() == d.end()))
+            -> decltype(bool(d.begin() == d.end()))
+        {
+            return d.begin() == d.end();
+        }
+
+        template<typename D>
+        constexpr auto view_size(D & d, view_kind<1>) noexcept(
+            noexcept(access::cheap_size(d))) -> decltype(access::cheap_size(d))
+        {
+            return access::cheap_size(d);
+        }
+        template<typename D>
+        constexpr auto view_size(D & d, view_kind<2>) noexcept(
+            noexcept(d.end() - d.begin())) -> decltype(d.end() - d.begin())
+        {
+            return d.end() - d.begin();
+        }
+
+        // front() and back() check that the view is not empty when that is
+        // cheap, and only then.
+        template<typename D, int Kind>
+        constexpr void assert_not_empty(D & d, view_kind<Kind> kind)
+        {
+            BOOST_ASSERT(!v1_dtl::view_empty(d, kind));
+            (void)d;
+            (void)kind;
+        }
+        template<typename D>
+        constexpr void assert_not_empty(D &, view_kind<2>) noexcept
+        {}
     }
 
     template<
@@ -50,10 +137,12 @@ namespace boost { namespace stl_interfaces { inline namespace v1 {
     {
 #ifndef BOOST_STL_INTERFACES_DOXYGEN
     private:
+        BOOST_STL_INTERFACES_INLINE
         constexpr Derived & derived() noexcept
         {
             return static_cast<Derived &>(*this);
         }
+        BOOST_STL_INTERFACES_INLINE
         constexpr const Derived & derived() const noexcept
         {
             return static_cast<Derived const &>(*this);
@@ -61,28 +150,38 @@ namespace boost { namespace stl_interfaces { inline namespace v1 {
 #endif
 
     public:
+        /** Returns `true` if the view has no elements.  This is
+            `derived.cheap_empty()`, if `Derived` has that member, or else
+            `derived.cheap_size() == 0`, if it has that one, or else
+            `begin() == end()`.  A view whose `begin()` takes more than
+            constant time, as a merge's or a filter's may, can provide one
+            of them (privately, if it befriends `access`), so that `empty()`
+            and `operator bool` do not call `begin()`. */
         template<typename D = Derived>
-        constexpr auto empty() noexcept(
-            noexcept(std::declval<D &>().begin() == std::declval<D &>().end()))
-            -> decltype(
-                std::declval<D &>().begin() == std::declval<D &>().end())
+        BOOST_STL_INTERFACES_INLINE
+        constexpr auto empty() noexcept(noexcept(v1_dtl::view_empty(
+            std::declval<D &>(), v1_dtl::view_empty_kind<D>{})))
+            -> decltype(v1_dtl::view_empty(
+                std::declval<D &>(), v1_dtl::view_empty_kind<D>{}))
         {
-            return derived().begin() == derived().end();
+            return v1_dtl::view_empty(
+                derived(), v1_dtl::view_empty_kind<D>{});
         }
         template<typename D = Derived>
-        constexpr auto empty() const noexcept(noexcept(
-            std::declval<D const &>().begin() ==
-            std::declval<D const &>().end()))
-            -> decltype(
-                std::declval<D const &>().begin() ==
-                std::declval<D const &>().end())
+        BOOST_STL_INTERFACES_INLINE
+        constexpr auto empty() const noexcept(noexcept(v1_dtl::view_empty(
+            std::declval<D const &>(), v1_dtl::view_empty_kind<D const>{})))
+            -> decltype(v1_dtl::view_empty(
+                std::declval<D const &>(), v1_dtl::view_empty_kind<D const>{}))
         {
-            return derived().begin() == derived().end();
+            return v1_dtl::view_empty(
+                derived(), v1_dtl::view_empty_kind<D const>{});
         }
 
         template<
             typename D = Derived,
             typename R = decltype(std::declval<D &>().empty())>
+        BOOST_STL_INTERFACES_INLINE
         constexpr explicit
         operator bool() noexcept(noexcept(std::declval<D &>().empty()))
         {
@@ -91,6 +190,7 @@ namespace boost { namespace stl_interfaces { inline namespace v1 {
         template<
             typename D = Derived,
             typename R = decltype(std::declval<D const &>().empty())>
+        BOOST_STL_INTERFACES_INLINE
         constexpr explicit operator bool() const
             noexcept(noexcept(std::declval<D const &>().empty()))
         {
@@ -101,6 +201,7 @@ namespace boost { namespace stl_interfaces { inline namespace v1 {
             typename D = Derived,
             bool C = Contiguous,
             typename Enable = std::enable_if_t<C>>
+        BOOST_STL_INTERFACES_INLINE
         constexpr auto data() noexcept(noexcept(std::declval<D &>().begin()))
             -> decltype(std::addressof(*std::declval<D &>().begin()))
         {
@@ -110,6 +211,7 @@ namespace boost { namespace stl_interfaces { inline namespace v1 {
             typename D = Derived,
             bool C = Contiguous,
             typename Enable = std::enable_if_t<C>>
+        BOOST_STL_INTERFACES_INLINE
         constexpr auto data() const
             noexcept(noexcept(std::declval<D const &>().begin()))
                 -> decltype(std::addressof(*std::declval<D const &>().begin()))
@@ -117,35 +219,45 @@ namespace boost { namespace stl_interfaces { inline namespace v1 {
             return std::addressof(*derived().begin());
         }
 
+        /** Returns the number of elements: `derived.cheap_size()`, if
+            `Derived` has that member, or else `end() - begin()`. */
         template<typename D = Derived>
-        constexpr auto size() noexcept(
-            noexcept(std::declval<D &>().end() - std::declval<D &>().begin()))
-            -> decltype(std::declval<D &>().end() - std::declval<D &>().begin())
+        BOOST_STL_INTERFACES_INLINE
+        constexpr auto size() noexcept(noexcept(v1_dtl::view_size(
+            std::declval<D &>(), v1_dtl::view_size_kind<D>{})))
+            -> decltype(v1_dtl::view_size(
+                std::declval<D &>(), v1_dtl::view_size_kind<D>{}))
         {
-            return derived().end() - derived().begin();
+            return v1_dtl::view_size(derived(), v1_dtl::view_size_kind<D>{});
         }
         template<typename D = Derived>
-        constexpr auto size() const noexcept(noexcept(
-            std::declval<D const &>().end() -
-            std::declval<D const &>().begin()))
-            -> decltype(
-                std::declval<D const &>().end() -
-                std::declval<D const &>().begin())
+        BOOST_STL_INTERFACES_INLINE
+        constexpr auto size() const noexcept(noexcept(v1_dtl::view_size(
+            std::declval<D const &>(), v1_dtl::view_size_kind<D const>{})))
+            -> decltype(v1_dtl::view_size(
+                std::declval<D const &>(), v1_dtl::view_size_kind<D const>{}))
         {
-            return derived().end() - derived().begin();
+            return v1_dtl::view_size(
+                derived(), v1_dtl::view_size_kind<D const>{});
         }
 
         template<typename D = Derived>
+        BOOST_STL_INTERFACES_INLINE
         constexpr auto front() noexcept(noexcept(*std::declval<D &>().begin()))
             -> decltype(*std::declval<D &>().begin())
         {
+            v1_dtl::assert_not_empty(
+                derived(), v1_dtl::view_empty_kind<D>{});
             return *derived().begin();
         }
         template<typename D = Derived>
+        BOOST_STL_INTERFACES_INLINE
         constexpr auto front() const
             noexcept(noexcept(*std::declval<D const &>().begin()))
                 -> decltype(*std::declval<D const &>().begin())
         {
+            v1_dtl::assert_not_empty(
+                derived(), v1_dtl::view_empty_kind<D const>{});
             return *derived().begin();
         }
 
@@ -154,10 +266,13 @@ namespace boost { namespace stl_interfaces { inline namespace v1 {
             typename Enable = std::enable_if_t<
                 v1_dtl::decrementable_sentinel<D>::value &&
                 v1_dtl::common_range<D>::value>>
+        BOOST_STL_INTERFACES_INLINE
         constexpr auto
         back() noexcept(noexcept(*std::prev(std::declval<D &>().end())))
             -> decltype(*std::prev(std::declval<D &>().end()))
         {
+            v1_dtl::assert_not_empty(
+                derived(), v1_dtl::view_empty_kind<D>{});
             return *std::prev(derived().end());
         }
         template<
@@ -165,14 +280,18 @@ namespace boost { namespace stl_interfaces { inline namespace v1 {
             typename Enable = std::enable_if_t<
                 v1_dtl::decrementable_sentinel<D>::value &&
                 v1_dtl::common_range<D>::value>>
+        BOOST_STL_INTERFACES_INLINE
         constexpr auto back() const
             noexcept(noexcept(*std::prev(std::declval<D const &>().end())))
                 -> decltype(*std::prev(std::declval<D const &>().end()))
         {
+            v1_dtl::assert_not_empty(
+                derived(), v1_dtl::view_empty_kind<D const>{});
             return *std::prev(derived().end());
         }
 
         template<typename D = Derived>
+        BOOST_STL_INTERFACES_INLINE
         constexpr auto operator[](v1_dtl::range_difference_t<D> n) noexcept(
             noexcept(std::declval<D &>().begin()[n]))
             -> decltype(std::declval<D &>().begin()[n])
@@ -180,17 +299,124 @@ namespace boost { namespace stl_interfaces { inline namespace v1 {
             return derived().begin()[n];
         }
         template<typename D = Derived>
+        BOOST_STL_INTERFACES_INLINE
         constexpr auto operator[](v1_dtl::range_difference_t<D> n) const
             noexcept(noexcept(std::declval<D const &>().begin()[n]))
                 -> decltype(std::declval<D const &>().begin()[n])
         {
             return derived().begin()[n];
         }
+
+        /** Returns a `subrange` of `[first, last)`, which must be iterators
+            into this view.  It is contiguous if this view is, and holds
+            only the two iterators, so it may outlive this view if they
+            remain valid. */
+        template<typename D = Derived>
+        constexpr v1_dtl::subrange_t<D, Contiguous>
+        slice(v1_dtl::iterator_t<D> first, v1_dtl::iterator_t<D> last)
+        {
+            return v1_dtl::subrange_t<D, Contiguous>(first, last);
+        }
+        /** Returns a `subrange` of `[first, last)`, which must be iterators
+            into this view.  It is contiguous if this view is, and holds
+            only the two iterators, so it may outlive this view if they
+            remain valid. */
+        template<typename D = Derived>
+        constexpr v1_dtl::subrange_t<D const, Contiguous> slice(
+            v1_dtl::iterator_t<D const> first,
+            v1_dtl::iterator_t<D const> last) const
+        {
+            return v1_dtl::subrange_t<D const, Contiguous>(first, last);
+        }
+
+        /** Returns a `subrange` of the `count` elements starting at element
+            `pos`, like `std::span::subspan(pos, count)`.  This takes
+            constant time if the iterators are random access.
+
+            \pre `0 <= pos && 0 <= count && pos + count <= size()` */
+        template<typename D = Derived>
+        constexpr v1_dtl::subrange_t<D, Contiguous> subview(
+            v1_dtl::range_difference_t<D> pos,
+            v1_dtl::range_difference_t<D> count)
+        {
+            auto const first = std::next(derived().begin(), pos);
+            return v1_dtl::subrange_t<D, Contiguous>(
+                first, std::next(first, count));
+        }
+        /** Returns a `subrange` of the `count` elements starting at element
+            `pos`, like `std::span::subspan(pos, count)`.  This takes
+            constant time if the iterators are random access.
+
+            \pre `0 <= pos && 0 <= count && pos + count <= size()` */
+        template<typename D = Derived>
+        constexpr v1_dtl::subrange_t<D const, Contiguous> subview(
+            v1_dtl::range_difference_t<D const> pos,
+            v1_dtl::range_difference_t<D const> count) const
+        {
+            auto const first = std::next(derived().begin(), pos);
+            return v1_dtl::subrange_t<D const, Contiguous>(
+                first, std::next(first, count));
+        }
+
+        /** Returns a `subrange` of the elements from element `pos` on, like
+            `std::span::subspan(pos)`.
+
+            \pre `0 <= pos && pos <= size()` */
+        template<
+            typename D = Derived,
+            typename Enable = std::enable_if_t<v1_dtl::common_range<D>::value>>
+        constexpr v1_dtl::subrange_t<D, Contiguous>
+        subview(v1_dtl::range_difference_t<D> pos)
+        {
+            return v1_dtl::subrange_t<D, Contiguous>(
+                std::next(derived().begin(), pos), derived().end());
+        }
+        /** Returns a `subrange` of the elements from element `pos` on, like
+            `std::span::subspan(pos)`.
+
+            \pre `0 <= pos && pos <= size()` */
+        template<
+            typename D = Derived,
+            typename Enable =
+                std::enable_if_t<v1_dtl::common_range<D const>::value>>
+        constexpr v1_dtl::subrange_t<D const, Contiguous>
+        subview(v1_dtl::range_difference_t<D const> pos) const
+        {
+            return v1_dtl::subrange_t<D const, Contiguous>(
+                std::next(derived().begin(), pos), derived().end());
+        }
+    };
+
+    /** A view of the elements in `[first, last)`, like
+        `std::ranges::subrange`; it is what `view_interface`'s `slice()` and
+        `subview()` return.  It holds only its iterator and sentinel, so it
+        does not refer to the range they came from, and slicing it again
+        costs no more than slicing the original did.  If `Contiguous` is
+        `true`, the elements must be contiguous in memory, and the view has
+        `data()`. */
+    template<typename Iterator, typename Sentinel, bool Contiguous>
+    struct subrange
+        : view_interface<subrange<Iterator, Sentinel, Contiguous>, Contiguous>
+    {
+        constexpr subrange() = default;
+        constexpr subrange(Iterator first, Sentinel last) :
+            first_(first), last_(last)
+        {}
+
+        constexpr Iterator begin() const { return first_; }
+        constexpr Sentinel end() const { return last_; }
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+    private:
+        Iterator first_ = Iterator();
+        Sentinel last_ = Sentinel();
+#endif
     };
 
     /** Implementation of `operator!=()` for all views derived from
         `view_interface`. */
     template<typename ViewInterface>
+    BOOST_STL_INTERFACES_INLINE
     constexpr auto operator!=(ViewInterface lhs, ViewInterface rhs) noexcept(
         noexcept(lhs == rhs))
         -> decltype(v1_dtl::derived_view(lhs), !(lhs == rhs))
@@ -201,15 +427,19 @@ namespace boost { namespace stl_interfaces { inline namespace v1 {
 }}}
 
 
-#if 201703L < __cplusplus && defined(__cpp_lib_concepts) || BOOST_STL_INTERFACES_DOXYGEN
+#if 201703L < __cplusplus && defined(__cpp_lib_concepts) &&                    \
+        !defined(BOOST_STL_INTERFACES_DISABLE_V2) ||                           \
+    BOOST_STL_INTERFACES_DOXYGEN
+
+#include <ranges>
 
 namespace boost { namespace stl_interfaces { namespace v2 {
 
-    /** A template alias for `std::view_interface`.  This only exists to make
-        migration from Boost.STLInterfaces to C++20 easier; switch to the one
-        in `std` as soon as you can. */
+    /** A template alias for `std::ranges::view_interface`.  This only
+        exists to make migration from Boost.STLInterfaces to C++20 easier;
+        switch to the one in `std` as soon as you can. */
     template<typename D, bool = v1::discontiguous>
-    using view_interface = std::view_interface<D>;
+    using view_interface = std::ranges::view_interface<D>;
 
 }}}
 
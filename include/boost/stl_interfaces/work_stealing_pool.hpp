@@ -0,0 +1,496 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_WORK_STEALING_POOL_HPP
+#define BOOST_STL_INTERFACES_WORK_STEALING_POOL_HPP
+
+#include <boost/stl_interfaces/parallel.hpp>
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    namespace v1_dtl {
+        struct ws_task
+        {
+            virtual void run() = 0;
+
+            void execute()
+            {
+                run();
+                done_.store(true, std::memory_order_release);
+            }
+            bool done() const noexcept
+            {
+                return done_.load(std::memory_order_acquire);
+            }
+
+        protected:
+            ~ws_task() = default;
+
+        private:
+            std::atomic<bool> done_{false};
+        };
+
+        // A Chase-Lev deque of tasks, as in "Correct and Efficient
+        // Work-Stealing for Weak Memory Models" (Le, Pop, Cohen and
+        // Zappa Nardelli, 2013).  Its owner pushes and pops at the bottom;
+        // other threads steal from the top.  A full array is replaced by
+        // one twice the size; the old arrays are kept until the deque is
+        // destroyed, since a thief may still be reading one.
+        struct ws_deque
+        {
+            ws_deque() : top_(0), bottom_(0)
+            {
+                arrays_.emplace_back(new ws_array(64));
+                array_.store(arrays_.back().get(), std::memory_order_relaxed);
+            }
+            ws_deque(ws_deque const &) = delete;
+            ws_deque & operator=(ws_deque const &) = delete;
+
+            void push(ws_task * task)
+            {
+                auto const b = bottom_.load(std::memory_order_relaxed);
+                auto const t = top_.load(std::memory_order_acquire);
+                auto a = array_.load(std::memory_order_relaxed);
+                if (a->size() - 1 < b - t)
+                    a = grow(a, b, t);
+                a->put(b, task);
+                // A release store, rather than the paper's release fence and
+                // relaxed store, which thread sanitizers do not understand.
+                bottom_.store(b + 1, std::memory_order_release);
+            }
+
+            ws_task * pop()
+            {
+                auto const b = bottom_.load(std::memory_order_relaxed) - 1;
+                auto const a = array_.load(std::memory_order_relaxed);
+                bottom_.store(b, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                auto t = top_.load(std::memory_order_relaxed);
+                if (b < t) {
+                    bottom_.store(b + 1, std::memory_order_relaxed);
+                    return nullptr;
+                }
+                ws_task * retval = a->get(b);
+                if (t == b) {
+                    // The last task; a thief may be taking it too.
+                    if (!top_.compare_exchange_strong(
+                            t,
+                            t + 1,
+                            std::memory_order_seq_cst,
+                            std::memory_order_relaxed)) {
+                        retval = nullptr;
+                    }
+                    bottom_.store(b + 1, std::memory_order_relaxed);
+                }
+                return retval;
+            }
+
+            ws_task * steal()
+            {
+                auto t = top_.load(std::memory_order_acquire);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                auto const b = bottom_.load(std::memory_order_acquire);
+                if (b <= t)
+                    return nullptr;
+                auto const a = array_.load(std::memory_order_acquire);
+                ws_task * const retval = a->get(t);
+                if (!top_.compare_exchange_strong(
+                        t,
+                        t + 1,
+                        std::memory_order_seq_cst,
+                        std::memory_order_relaxed)) {
+                    return nullptr;
+                }
+                return retval;
+            }
+
+        private:
+            struct ws_array
+            {
+                explicit ws_array(std::ptrdiff_t size) :
+                    size_(size),
+                    tasks_(new std::atomic<ws_task *>[size])
+                {}
+
+                std::ptrdiff_t size() const noexcept { return size_; }
+                ws_task * get(std::ptrdiff_t i) const noexcept
+                {
+                    return tasks_[i & (size_ - 1)].load(
+                        std::memory_order_relaxed);
+                }
+                void put(std::ptrdiff_t i, ws_task * task) noexcept
+                {
+                    tasks_[i & (size_ - 1)].store(
+                        task, std::memory_order_relaxed);
+                }
+
+            private:
+                std::ptrdiff_t size_;
+                std::unique_ptr<std::atomic<ws_task *>[]> tasks_;
+            };
+
+            ws_array * grow(ws_array * a, std::ptrdiff_t b, std::ptrdiff_t t)
+            {
+                arrays_.emplace_back(new ws_array(2 * a->size()));
+                auto const retval = arrays_.back().get();
+                for (auto i = t; i < b; ++i) {
+                    retval->put(i, a->get(i));
+                }
+                array_.store(retval, std::memory_order_release);
+                return retval;
+            }
+
+            std::atomic<std::ptrdiff_t> top_;
+            std::atomic<std::ptrdiff_t> bottom_;
+            std::atomic<ws_array *> array_;
+            std::vector<std::unique_ptr<ws_array>> arrays_;
+        };
+
+        // A task from submit(), which deletes itself once run.
+        struct ws_function_task final : ws_task
+        {
+            explicit ws_function_task(std::function<void()> f) :
+                f_(std::move(f))
+            {}
+
+            void run() override
+            {
+                f_();
+                delete this;
+            }
+
+        private:
+            std::function<void()> f_;
+        };
+
+        // The error state of one parallel_for_each(); the first exception
+        // thrown is kept, and the chunks not yet started are skipped.
+        struct ws_job
+        {
+            void fail()
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (!error_)
+                    error_ = std::current_exception();
+                failed_.store(true, std::memory_order_relaxed);
+            }
+            bool failed() const noexcept
+            {
+                return failed_.load(std::memory_order_relaxed);
+            }
+            void rethrow()
+            {
+                if (error_)
+                    std::rethrow_exception(error_);
+            }
+
+        private:
+            std::atomic<bool> failed_{false};
+            std::mutex mutex_;
+            std::exception_ptr error_;
+        };
+    }
+
+#endif
+
+    /** A pool of worker threads that balance their work by stealing, for
+        irregular fork-join workloads.  Each worker has a Chase-Lev deque of
+        tasks; it pushes and pops its own tasks at one end, and an idle
+        worker steals from the other end of another worker's deque.  So the
+        tasks stolen are the oldest, and with recursive splitting, the
+        largest.
+
+        `parallel_for_each(pool, v, f, grain_size)` splits the view `v` in
+        half, recursively, down to `grain_size` elements; a worker that runs
+        out of work steals a half that another has not yet started.  With
+        static partitioning, a chunk of expensive elements keeps one thread
+        busy while the others sit idle.
+
+        A `work_stealing_pool` also has `size()` and `submit()`, so the
+        iterator overloads of `parallel_for_each()`, `parallel_transform()`
+        and `parallel_reduce()` can run on it too. */
+    struct work_stealing_pool
+    {
+        /** Starts `threads` worker threads.  With 0 threads, the algorithms
+            run on the calling thread. */
+        explicit work_stealing_pool(
+            unsigned int threads = std::thread::hardware_concurrency()) :
+            deques_(threads),
+            active_(0),
+            stop_(false)
+        {
+            threads_.reserve(threads);
+            for (unsigned int i = 0; i < threads; ++i) {
+                threads_.emplace_back([this, i] { run(i); });
+            }
+        }
+        ~work_stealing_pool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                stop_ = true;
+            }
+            cv_.notify_all();
+            for (auto & thread : threads_) {
+                thread.join();
+            }
+        }
+        work_stealing_pool(work_stealing_pool const &) = delete;
+        work_stealing_pool & operator=(work_stealing_pool const &) = delete;
+
+        /** Returns the number of worker threads. */
+        unsigned int size() const noexcept
+        {
+            return (unsigned int)threads_.size();
+        }
+
+        /** Queues `task` to be run on one of the worker threads. */
+        void submit(std::function<void()> task)
+        {
+            inject(new v1_dtl::ws_function_task(std::move(task)));
+        }
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+        // The index of the calling thread's deque, if it is one of this
+        // pool's workers, or -1.
+        std::ptrdiff_t worker_index() const noexcept
+        {
+            auto const & w = current_worker();
+            return w.pool == this ? w.index : -1;
+        }
+
+        // Runs task, which the calling worker has pushed, or waits for the
+        // thief that took it; either way, it runs other tasks meanwhile.
+        void join(std::ptrdiff_t index, v1_dtl::ws_task & task)
+        {
+            while (!task.done()) {
+                if (auto const t = find_task(index))
+                    t->execute();
+                else
+                    std::this_thread::yield();
+            }
+        }
+
+        void push(std::ptrdiff_t index, v1_dtl::ws_task * task)
+        {
+            deques_[index].push(task);
+        }
+
+        // Runs task on a worker, and returns when it is done.
+        void run_and_wait(v1_dtl::ws_task & task)
+        {
+            struct root_task final : v1_dtl::ws_task
+            {
+                explicit root_task(v1_dtl::ws_task & task) : task_(task) {}
+                void run() override { task_.execute(); }
+                v1_dtl::ws_task & task_;
+            };
+            root_task root(task);
+            inject(&root);
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [&] { return task.done(); });
+        }
+
+#endif
+
+    private:
+        struct worker_id
+        {
+            work_stealing_pool const * pool;
+            std::ptrdiff_t index;
+        };
+        static worker_id & current_worker() noexcept
+        {
+            static thread_local worker_id w{nullptr, -1};
+            return w;
+        }
+
+        void inject(v1_dtl::ws_task * task)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                injected_.push_back(task);
+                ++active_;
+            }
+            cv_.notify_all();
+        }
+
+        v1_dtl::ws_task * find_task(std::ptrdiff_t index)
+        {
+            if (auto const t = deques_[index].pop())
+                return t;
+            auto const n = std::ptrdiff_t(deques_.size());
+            for (std::ptrdiff_t i = 1; i < n; ++i) {
+                if (auto const t = deques_[(index + i) % n].steal())
+                    return t;
+            }
+            return nullptr;
+        }
+
+        void run(std::ptrdiff_t index)
+        {
+            current_worker() = worker_id{this, index};
+            for (;;) {
+                if (auto const t = find_task(index)) {
+                    t->execute();
+                    continue;
+                }
+                v1_dtl::ws_task * injected = nullptr;
+                {
+                    std::unique_lock<std::mutex> lock(mutex_);
+                    if (injected_.empty() && active_ == 0) {
+                        cv_.wait(lock, [this] {
+                            return stop_ || !injected_.empty() || active_;
+                        });
+                        if (stop_ && injected_.empty() && active_ == 0)
+                            return;
+                    }
+                    if (!injected_.empty()) {
+                        injected = injected_.front();
+                        injected_.pop_front();
+                    }
+                }
+                if (!injected) {
+                    // Another worker is busy with an injected task, and may
+                    // yet push some of it for stealing.
+                    std::this_thread::yield();
+                    continue;
+                }
+                // An injected task is either from submit(), and deletes
+                // itself, or from run_and_wait(), which waits for the task
+                // it wraps; so it is run, and not executed.
+                injected->run();
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    --active_;
+                }
+                cv_.notify_all();
+            }
+        }
+
+        std::vector<v1_dtl::ws_deque> deques_;
+        std::mutex mutex_;
+        std::condition_variable cv_;
+        std::deque<v1_dtl::ws_task *> injected_;
+        std::ptrdiff_t active_;
+        bool stop_;
+        std::vector<std::thread> threads_;
+    };
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    namespace v1_dtl {
+        template<typename View, typename F>
+        struct ws_for_each_task : ws_task
+        {
+            ws_for_each_task(
+                work_stealing_pool & pool,
+                View const & v,
+                F const & f,
+                std::ptrdiff_t grain_size,
+                ws_job & job) :
+                pool_(pool),
+                v_(v),
+                f_(f),
+                grain_size_(grain_size),
+                job_(job)
+            {}
+
+            void run() override
+            {
+                process(pool_.worker_index(), v_);
+            }
+
+        private:
+            void process(std::ptrdiff_t index, View const & v)
+            {
+                auto const size = std::ptrdiff_t(v.end() - v.begin());
+                if (size <= grain_size_) {
+                    if (job_.failed())
+                        return;
+                    try {
+                        std::for_each(v.begin(), v.end(), f_);
+                    } catch (...) {
+                        job_.fail();
+                    }
+                    return;
+                }
+                auto const halves =
+                    stl_interfaces::split_at(v, v.begin() + size / 2);
+                ws_for_each_task second(
+                    pool_, halves.second, f_, grain_size_, job_);
+                pool_.push(index, &second);
+                process(index, halves.first);
+                pool_.join(index, second);
+            }
+
+            work_stealing_pool & pool_;
+            View v_;
+            F const & f_;
+            std::ptrdiff_t grain_size_;
+            ws_job & job_;
+        };
+    }
+
+#endif
+
+    /** Applies `f` to each element of `v`, on the workers of `pool`.  `v` is
+        split in half with `split_at()`, recursively, down to `grain_size`
+        elements; a worker keeps one half, and leaves the other half for
+        an idle worker to steal.  The call returns when all elements have
+        been processed.  It may be made from one of `pool`'s workers, as in
+        a nested loop.
+
+        `f` is called concurrently from multiple threads, and must be safe
+        to call that way.  If any call to `f` throws, one of the exceptions
+        is rethrown after all the workers have finished with `v`; the
+        chunks not yet started are skipped.
+
+        \pre `0 < grain_size` */
+    template<
+        typename View,
+        typename F,
+        typename Enable = std::enable_if_t<is_splittable_view<View>::value>>
+    void parallel_for_each(
+        work_stealing_pool & pool,
+        View const & v,
+        F const & f,
+        std::ptrdiff_t grain_size = 1024)
+    {
+        BOOST_ASSERT(0 < grain_size);
+        if (pool.size() == 0) {
+            std::for_each(v.begin(), v.end(), f);
+            return;
+        }
+        v1_dtl::ws_job job;
+        v1_dtl::ws_for_each_task<View, F> task(pool, v, f, grain_size, job);
+        if (pool.worker_index() < 0) {
+            pool.run_and_wait(task);
+        } else {
+            task.execute();
+        }
+        job.rethrow();
+    }
+
+}}}
+
+#endif
@@ -0,0 +1,445 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_ZIP_VIEW_HPP
+#define BOOST_STL_INTERFACES_ZIP_VIEW_HPP
+
+#include <boost/stl_interfaces/iterator_interface.hpp>
+#include <boost/stl_interfaces/view_interface.hpp>
+
+#include <algorithm>
+#include <tuple>
+#include <utility>
+
+
+namespace boost { namespace stl_interfaces { inline namespace v1 {
+
+    /** The reference type of `zip_iterator`: a `std::tuple` of the
+        references of the zipped iterators.
+
+        Like `std::tuple<Ts &...>`, assigning to a `zip_reference` assigns
+        through its elements.  Unlike `std::tuple`, it has an associated
+        `swap()` that takes rvalues, and swaps the referred-to objects; the
+        standard algorithms that swap elements, like `std::sort()`, need this,
+        since dereferencing a `zip_iterator` produces an rvalue. */
+    template<typename... Refs>
+    struct zip_reference : std::tuple<Refs...>
+    {
+        using base_type = std::tuple<Refs...>;
+
+        constexpr zip_reference(Refs... refs) :
+            base_type(std::forward<Refs>(refs)...)
+        {}
+        zip_reference(zip_reference const &) = default;
+
+        zip_reference & operator=(zip_reference const & other)
+        {
+            base_type::operator=(other);
+            return *this;
+        }
+        template<typename... Us>
+        zip_reference & operator=(std::tuple<Us...> const & x)
+        {
+            base_type::operator=(x);
+            return *this;
+        }
+        template<typename... Us>
+        zip_reference & operator=(std::tuple<Us...> && x)
+        {
+            base_type::operator=(std::move(x));
+            return *this;
+        }
+
+        friend void swap(zip_reference lhs, zip_reference rhs)
+        {
+            lhs.swap_elements(rhs, std::index_sequence_for<Refs...>{});
+        }
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+    private:
+        template<std::size_t... Is>
+        void swap_elements(zip_reference & other, std::index_sequence<Is...>)
+        {
+            using std::swap;
+            using swallow = int[];
+            (void)swallow{
+                0, (swap(std::get<Is>(*this), std::get<Is>(other)), 0)...};
+        }
+#endif
+    };
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    template<typename... Iters>
+    struct zip_iterator;
+
+    namespace v1_dtl {
+        template<typename Iter>
+        using zip_category_of =
+            typename std::iterator_traits<Iter>::iterator_category;
+
+        // The tags are related by inheritance, so their common type is the
+        // weakest of them.  A zip_iterator is never contiguous, since its
+        // elements are proxies.
+        template<typename... Iters>
+        using zip_common_category =
+            std::common_type_t<zip_category_of<Iters>...>;
+        template<typename... Iters>
+        using zip_ra = std::is_convertible<
+            zip_common_category<Iters...>,
+            std::random_access_iterator_tag>;
+        template<typename... Iters>
+        using zip_category = std::conditional_t<
+            zip_ra<Iters...>::value,
+            std::random_access_iterator_tag,
+            zip_common_category<Iters...>>;
+        template<typename... Iters>
+        using zip_bidi = std::is_convertible<
+            zip_common_category<Iters...>,
+            std::bidirectional_iterator_tag>;
+
+        template<typename... Iters>
+        using zip_iter_base = proxy_iterator_interface<
+            zip_iterator<Iters...>,
+            zip_category<Iters...>,
+            std::tuple<typename std::iterator_traits<Iters>::value_type...>,
+            zip_reference<typename std::iterator_traits<Iters>::reference...>,
+            std::common_type_t<iter_difference_t<Iters>...>>;
+    }
+
+#endif
+
+    /** An iterator over the elements of several sequences in lockstep.  The
+        `i`-th element of the zip is a `zip_reference` to the `i`-th elements
+        of the sequences.  Its category is the weakest of the categories of
+        `Iters...`, but never better than random access.
+
+        When all of `Iters...` are random access, a `zip_iterator` is
+        represented as the initial iterators plus a single shared offset, so
+        that advancing it, or comparing two of them, touches only the offset.
+        The distance between two such `zip_iterator`s is that between their
+        first components.  Otherwise, each step advances every component, and
+        two `zip_iterator`s are equal if any of their components are equal,
+        so that iteration stops at the end of the shortest sequence.
+
+        \see `zip_view`, `copy()` */
+    template<typename... Iters>
+    struct zip_iterator : v1_dtl::zip_iter_base<Iters...>
+    {
+        static_assert(
+            0 < sizeof...(Iters), "zip_iterator needs at least one iterator.");
+
+        using base_type = v1_dtl::zip_iter_base<Iters...>;
+        using difference_type = typename base_type::difference_type;
+        using reference = typename base_type::reference;
+
+        constexpr zip_iterator() : its_(), n_(0) {}
+        constexpr zip_iterator(Iters... its) : its_(its...), n_(0) {}
+
+        /** Returns the current positions of the zipped iterators. */
+        constexpr std::tuple<Iters...> base() const
+        {
+            return base_impl(indices{}, ra{});
+        }
+
+        constexpr reference operator*() const
+        {
+            return deref(indices{}, ra{});
+        }
+        constexpr zip_iterator & operator++()
+        {
+            next(indices{}, ra{});
+            return *this;
+        }
+        template<
+            typename Z = zip_iterator,
+            typename Enable = std::enable_if_t<
+                std::is_same<Z, zip_iterator>::value &&
+                v1_dtl::zip_bidi<Iters...>::value>>
+        constexpr zip_iterator & operator--()
+        {
+            prev(indices{}, ra{});
+            return *this;
+        }
+        template<
+            typename Z = zip_iterator,
+            typename Enable = std::enable_if_t<
+                std::is_same<Z, zip_iterator>::value &&
+                v1_dtl::zip_ra<Iters...>::value>>
+        constexpr zip_iterator & operator+=(difference_type n)
+        {
+            n_ += n;
+            return *this;
+        }
+        template<
+            typename Z = zip_iterator,
+            typename Enable = std::enable_if_t<
+                std::is_same<Z, zip_iterator>::value &&
+                v1_dtl::zip_ra<Iters...>::value>>
+        friend constexpr difference_type operator-(Z lhs, zip_iterator rhs)
+        {
+            return difference_type(
+                       std::get<0>(lhs.its_) - std::get<0>(rhs.its_)) +
+                   (lhs.n_ - rhs.n_);
+        }
+        template<
+            typename Z = zip_iterator,
+            typename Enable = std::enable_if_t<
+                std::is_same<Z, zip_iterator>::value &&
+                !v1_dtl::zip_ra<Iters...>::value>>
+        friend constexpr bool operator==(Z lhs, zip_iterator rhs)
+        {
+            return lhs.any_equal(rhs, indices{});
+        }
+
+        using base_type::operator++;
+        using base_type::operator--;
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+    private:
+        using indices = std::index_sequence_for<Iters...>;
+        using ra = v1_dtl::zip_ra<Iters...>;
+
+        template<std::size_t... Is>
+        constexpr std::tuple<Iters...>
+        base_impl(std::index_sequence<Is...>, std::true_type) const
+        {
+            return std::tuple<Iters...>(std::next(
+                std::get<Is>(its_), v1_dtl::iter_difference_t<Iters>(n_))...);
+        }
+        template<std::size_t... Is>
+        constexpr std::tuple<Iters...>
+        base_impl(std::index_sequence<Is...>, std::false_type) const
+        {
+            return its_;
+        }
+
+        template<std::size_t... Is>
+        constexpr reference
+        deref(std::index_sequence<Is...>, std::true_type) const
+        {
+            return reference(
+                std::get<Is>(its_)[v1_dtl::iter_difference_t<Iters>(n_)]...);
+        }
+        template<std::size_t... Is>
+        constexpr reference
+        deref(std::index_sequence<Is...>, std::false_type) const
+        {
+            return reference(*std::get<Is>(its_)...);
+        }
+
+        template<std::size_t... Is>
+        constexpr void next(std::index_sequence<Is...>, std::true_type)
+        {
+            ++n_;
+        }
+        template<std::size_t... Is>
+        constexpr void next(std::index_sequence<Is...>, std::false_type)
+        {
+            using swallow = int[];
+            (void)swallow{0, (++std::get<Is>(its_), 0)...};
+        }
+
+        template<std::size_t... Is>
+        constexpr void prev(std::index_sequence<Is...>, std::true_type)
+        {
+            --n_;
+        }
+        template<std::size_t... Is>
+        constexpr void prev(std::index_sequence<Is...>, std::false_type)
+        {
+            using swallow = int[];
+            (void)swallow{0, (--std::get<Is>(its_), 0)...};
+        }
+
+        template<std::size_t... Is>
+        constexpr bool
+        any_equal(zip_iterator const & other, std::index_sequence<Is...>) const
+        {
+            bool retval = false;
+            using swallow = int[];
+            (void)swallow{
+                0,
+                (retval = retval ||
+                          std::get<Is>(its_) == std::get<Is>(other.its_),
+                 0)...};
+            return retval;
+        }
+
+        // When Iters... are all random access, its_ stays put and n_ is the
+        // offset from it; otherwise, its_ moves and n_ is always 0.
+        std::tuple<Iters...> its_;
+        difference_type n_;
+#endif
+    };
+
+    /** A view of several sequences zipped together; its iterator is
+        `zip_iterator<Iters...>`.  \see `make_zip_view()` */
+    template<typename... Iters>
+    struct zip_view : view_interface<zip_view<Iters...>>
+    {
+        using iterator = zip_iterator<Iters...>;
+
+        constexpr zip_view() = default;
+        constexpr zip_view(iterator first, iterator last) :
+            first_(first),
+            last_(last)
+        {}
+
+        constexpr iterator begin() const { return first_; }
+        constexpr iterator end() const { return last_; }
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+    private:
+        iterator first_;
+        iterator last_;
+#endif
+    };
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    namespace v1_dtl {
+        template<typename Range>
+        using zip_range_iter = decltype(std::begin(std::declval<Range &>()));
+
+        template<typename Iter, typename... Ranges>
+        constexpr Iter zip_end(std::true_type, Ranges &... rs)
+        {
+            using difference_type = typename Iter::difference_type;
+            auto const n = (std::min)({difference_type(
+                std::distance(std::begin(rs), std::end(rs)))...});
+            return Iter(std::begin(rs)...) + n;
+        }
+        template<typename Iter, typename... Ranges>
+        constexpr Iter zip_end(std::false_type, Ranges &... rs)
+        {
+            return Iter(std::end(rs)...);
+        }
+    }
+
+#endif
+
+    /** Returns a `zip_view` of `rs...`, which must all be common ranges
+        (ranges whose `begin()` and `end()` have the same type).  If they are
+        all random access, the view has the length of the shortest of them;
+        otherwise, iteration stops when it reaches the end of the shortest of
+        them. */
+    template<typename... Ranges>
+    constexpr auto make_zip_view(Ranges &&... rs)
+    {
+        using iterator = zip_iterator<v1_dtl::zip_range_iter<Ranges>...>;
+        return zip_view<v1_dtl::zip_range_iter<Ranges>...>(
+            iterator(std::begin(rs)...),
+            v1_dtl::zip_end<iterator>(
+                v1_dtl::zip_ra<v1_dtl::zip_range_iter<Ranges>...>{}, rs...));
+    }
+
+#ifndef BOOST_STL_INTERFACES_DOXYGEN
+
+    namespace v1_dtl {
+        template<typename Iter, typename OutIter>
+        using zip_contiguous_copyable = std::integral_constant<
+            bool,
+            is_contiguous_iterator<Iter>::value &&
+                is_contiguous_iterator<OutIter>::value>;
+
+        template<typename Iter, typename OutIter, typename Difference>
+        void zip_copy_component(
+            Iter first, Difference n, OutIter out, std::true_type)
+        {
+            auto const p = stl_interfaces::to_address(first);
+            std::copy(p, p + n, stl_interfaces::to_address(out));
+        }
+        template<typename Iter, typename OutIter, typename Difference>
+        void zip_copy_component(
+            Iter first, Difference n, OutIter out, std::false_type)
+        {
+            std::copy_n(first, n, out);
+        }
+
+        template<
+            typename InTuple,
+            typename OutTuple,
+            typename Difference,
+            std::size_t... Is>
+        void zip_copy_components(
+            InTuple const & in,
+            Difference n,
+            OutTuple const & out,
+            std::index_sequence<Is...>)
+        {
+            using swallow = int[];
+            (void)swallow{
+                0,
+                (v1_dtl::zip_copy_component(
+                     std::get<Is>(in),
+                     n,
+                     std::get<Is>(out),
+                     zip_contiguous_copyable<
+                         std::tuple_element_t<Is, InTuple>,
+                         std::tuple_element_t<Is, OutTuple>>{}),
+                 0)...};
+        }
+
+        template<typename InIter, typename OutIter>
+        OutIter zip_copy(InIter first, InIter last, OutIter out, std::true_type)
+        {
+            auto const n = last - first;
+            v1_dtl::zip_copy_components(
+                first.base(),
+                n,
+                out.base(),
+                std::make_index_sequence<
+                    std::tuple_size<decltype(first.base())>::value>{});
+            return out + n;
+        }
+        template<typename InIter, typename OutIter>
+        OutIter
+        zip_copy(InIter first, InIter last, OutIter out, std::false_type)
+        {
+            for (; first != last; ++first, ++out) {
+                *out = *first;
+            }
+            return out;
+        }
+    }
+
+#endif
+
+    /** Copies `[first, last)` to `out`, like `std::copy()`, and returns the
+        end of the output.
+
+        When both `zip_iterator`s are random access, each component is copied
+        separately, with its own `std::copy()` -- which, for contiguous
+        components of trivially copyable types, is a `std::memmove()`.  This
+        is much faster than copying one tuple of elements at a time.  Call it
+        unqualified in code that also has `using std::copy;`, and overload
+        resolution picks this `copy()` for `zip_iterator`s.
+
+        \pre `[out, out + (last - first))` does not overlap `[first,
+        last)`. */
+    template<typename... Iters, typename... OutIters>
+    zip_iterator<OutIters...> copy(
+        zip_iterator<Iters...> first,
+        zip_iterator<Iters...> last,
+        zip_iterator<OutIters...> out)
+    {
+        static_assert(
+            sizeof...(Iters) == sizeof...(OutIters),
+            "copy() requires zip_iterators with the same number of "
+            "components.");
+        return v1_dtl::zip_copy(
+            first,
+            last,
+            out,
+            std::integral_constant<
+                bool,
+                v1_dtl::zip_ra<Iters...>::value &&
+                    v1_dtl::zip_ra<OutIters...>::value>{});
+    }
+
+}}}
+
+#endif
@@ -0,0 +1,106 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// The boost.stl_interfaces module.  It is built from the same headers that
+// are #included in non-module builds; the headers go in the global module
+// fragment, and the module exports their public names.  Macros are not
+// exported, so code that uses BOOST_STL_INTERFACES_STATIC_ASSERT_CONCEPT()
+// or BOOST_STL_INTERFACES_STATIC_ASSERT_ITERATOR_TRAITS() must still
+// #include iterator_interface.hpp.  Configuration macros, like
+// BOOST_STL_INTERFACES_DISABLE_CONTAINER_HOOKS, must be defined when the
+// module is built.
+
+module;
+
+#include <boost/stl_interfaces/container_interface.hpp>
+#include <boost/stl_interfaces/fwd.hpp>
+#include <boost/stl_interfaces/iterator_interface.hpp>
+#include <boost/stl_interfaces/reverse_iterator.hpp>
+#include <boost/stl_interfaces/trivially_relocatable.hpp>
+#include <boost/stl_interfaces/view_interface.hpp>
+
+export module boost.stl_interfaces;
+
+export namespace boost::stl_interfaces {
+
+    // iterator_interface.hpp
+    using boost::stl_interfaces::access;
+    using boost::stl_interfaces::in_place_proxy_arrow_result;
+    using boost::stl_interfaces::proxy_arrow_deref;
+    using boost::stl_interfaces::proxy_arrow_deref_t;
+    using boost::stl_interfaces::proxy_arrow_result;
+}
+
+export namespace boost::stl_interfaces::inline v1 {
+
+    // fwd.hpp
+    using boost::stl_interfaces::v1::contiguous;
+    using boost::stl_interfaces::v1::contiguous_iterator_tag;
+    using boost::stl_interfaces::v1::default_init;
+    using boost::stl_interfaces::v1::default_init_t;
+    using boost::stl_interfaces::v1::discontiguous;
+    using boost::stl_interfaces::v1::element_layout;
+
+    // iterator_interface.hpp
+    using boost::stl_interfaces::v1::advance;
+    using boost::stl_interfaces::v1::distance;
+    using boost::stl_interfaces::v1::is_contiguous_iterator;
+    using boost::stl_interfaces::v1::iterator_interface;
+    using boost::stl_interfaces::v1::next;
+    using boost::stl_interfaces::v1::proxy_iterator_interface;
+    using boost::stl_interfaces::v1::read_n;
+    using boost::stl_interfaces::v1::to_address;
+    using boost::stl_interfaces::v1::write_n;
+
+    // reverse_iterator.hpp
+    using boost::stl_interfaces::v1::cached_reverse_iterator;
+    using boost::stl_interfaces::v1::make_cached_reverse_iterator;
+    using boost::stl_interfaces::v1::make_reverse_iterator;
+    using boost::stl_interfaces::v1::reverse_iterator;
+
+    // view_interface.hpp
+    using boost::stl_interfaces::v1::view_interface;
+
+    // container_interface.hpp and trivially_relocatable.hpp
+    using boost::stl_interfaces::v1::container_growth_policy;
+    using boost::stl_interfaces::v1::container_interface;
+    using boost::stl_interfaces::v1::container_op_hooks;
+    using boost::stl_interfaces::v1::container_op_hooks_base;
+    using boost::stl_interfaces::v1::default_container_growth_policy;
+    using boost::stl_interfaces::v1::is_trivially_relocatable;
+    using boost::stl_interfaces::v1::relocating_swap;
+    using boost::stl_interfaces::v1::swap;
+    using boost::stl_interfaces::v1::trivially_destructible_container;
+    using boost::stl_interfaces::v1::uninitialized_relocate;
+    using boost::stl_interfaces::v1::uninitialized_relocate_backward;
+
+    // The namespace-scope operators of all of the above.  ADL finds them
+    // only if they are reachable from the module, so they are exported too.
+    using boost::stl_interfaces::v1::operator==;
+    using boost::stl_interfaces::v1::operator!=;
+    using boost::stl_interfaces::v1::operator<;
+    using boost::stl_interfaces::v1::operator<=;
+    using boost::stl_interfaces::v1::operator>;
+    using boost::stl_interfaces::v1::operator>=;
+#ifdef BOOST_STL_INTERFACES_NO_HIDDEN_FRIEND_CONSTEXPR
+    using boost::stl_interfaces::v1::operator+;
+    using boost::stl_interfaces::v1::operator-;
+#endif
+}
+
+#if defined(__cpp_lib_concepts) && !defined(BOOST_STL_INTERFACES_DISABLE_V2)
+
+export namespace boost::stl_interfaces::v2 {
+
+    using boost::stl_interfaces::v2::container_interface;
+    using boost::stl_interfaces::v2::iterator_interface;
+    using boost::stl_interfaces::v2::make_reverse_iterator;
+    using boost::stl_interfaces::v2::proxy_iterator_interface;
+    using boost::stl_interfaces::v2::reverse_iterator;
+    using boost::stl_interfaces::v2::view_interface;
+}
+
+#endif
@@ -0,0 +1,296 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/algorithm.hpp>
+#include <boost/stl_interfaces/static_vector.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+
+// These benchmarks run find(), count(), mismatch() and min_element() over
+// 64K bytes and 64K ints, with the std:: algorithms and with the
+// vectorized ones in algorithm.hpp.  find() and mismatch() stop at the
+// last element.
+
+namespace bsi = boost::stl_interfaces;
+
+constexpr std::size_t size = 1 << 16;
+
+template<typename T>
+std::vector<T> make_values()
+{
+    std::vector<T> retval(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        retval[i] = T(i % 97 + 1);
+    }
+    retval.back() = 0;
+    return retval;
+}
+
+std::vector<std::uint8_t> const bytes = make_values<std::uint8_t>();
+std::vector<int> const ints = make_values<int>();
+
+template<typename T>
+std::vector<T> const & values();
+template<>
+std::vector<std::uint8_t> const & values()
+{
+    return bytes;
+}
+template<>
+std::vector<int> const & values()
+{
+    return ints;
+}
+
+template<typename T, bool Simd>
+void BM_find(benchmark::State & state)
+{
+    auto const & v = values<T>();
+    for (auto _ : state) {
+        auto const it = Simd ? bsi::find(v.data(), v.data() + size, T(0))
+                             : std::find(v.data(), v.data() + size, T(0));
+        benchmark::DoNotOptimize(it);
+    }
+}
+
+template<typename T, bool Simd>
+void BM_count(benchmark::State & state)
+{
+    auto const & v = values<T>();
+    for (auto _ : state) {
+        auto const n = Simd ? bsi::count(v.data(), v.data() + size, T(5))
+                            : std::count(v.data(), v.data() + size, T(5));
+        benchmark::DoNotOptimize(n);
+    }
+}
+
+template<typename T, bool Simd>
+void BM_mismatch(benchmark::State & state)
+{
+    auto const & v = values<T>();
+    std::vector<T> w(v.begin(), v.end() - 1);
+    w.push_back(1);
+    for (auto _ : state) {
+        auto const it =
+            Simd ? bsi::mismatch(v.data(), v.data() + size, w.data())
+                 : std::mismatch(v.data(), v.data() + size, w.data());
+        benchmark::DoNotOptimize(it);
+    }
+}
+
+template<typename T, bool Simd>
+void BM_min_element(benchmark::State & state)
+{
+    auto const & v = values<T>();
+    for (auto _ : state) {
+        auto const it = Simd ? bsi::min_element(v.data(), v.data() + size)
+                             : std::min_element(v.data(), v.data() + size);
+        benchmark::DoNotOptimize(it);
+    }
+}
+
+// The reverse-range overloads, against the std:: algorithms over the same
+// stl_interfaces::reverse_iterators.  find() looks for a value that is not
+// there, so it scans the whole array, back to front.
+
+template<typename T>
+using rev_iter = bsi::reverse_iterator<T const *>;
+
+template<typename T, bool Simd>
+void BM_rfind(benchmark::State & state)
+{
+    auto const & v = values<T>();
+    rev_iter<T> const first(v.data() + size);
+    rev_iter<T> const last(v.data());
+    for (auto _ : state) {
+        auto const it = Simd ? bsi::find(first, last, T(98))
+                             : std::find(first, last, T(98));
+        benchmark::DoNotOptimize(it);
+    }
+}
+
+template<typename T, bool Simd>
+void BM_requal(benchmark::State & state)
+{
+    auto const & v = values<T>();
+    std::vector<T> const w = v;
+    rev_iter<T> const first1(v.data() + size);
+    rev_iter<T> const last1(v.data());
+    rev_iter<T> const first2(w.data() + size);
+    for (auto _ : state) {
+        bool const equal = Simd ? bsi::equal(first1, last1, first2)
+                                : std::equal(first1, last1, first2);
+        benchmark::DoNotOptimize(equal);
+    }
+}
+
+template<typename T, bool Simd>
+void BM_rcopy(benchmark::State & state)
+{
+    auto const & v = values<T>();
+    std::vector<T> w(size);
+    rev_iter<T> const first(v.data() + size);
+    rev_iter<T> const last(v.data());
+    for (auto _ : state) {
+        if (Simd)
+            bsi::copy(first, last, w.data());
+        else
+            std::copy(first, last, w.data());
+        benchmark::ClobberMemory();
+    }
+}
+
+// The backward-scan members of container_interface, on a static_vector of
+// the same values, against the std:: algorithms over its rbegin() and
+// rend().  find_last() and rfind_if() look for values that are not there.
+
+template<typename T>
+using static_vec = bsi::static_vector<T, size>;
+
+template<typename T>
+static_vec<T> const & static_values()
+{
+    static static_vec<T> const retval(values<T>().begin(), values<T>().end());
+    return retval;
+}
+
+template<typename T, bool Member>
+void BM_find_last(benchmark::State & state)
+{
+    auto const & v = static_values<T>();
+    for (auto _ : state) {
+        if (Member)
+            benchmark::DoNotOptimize(v.find_last(T(98)));
+        else
+            benchmark::DoNotOptimize(std::find(v.rbegin(), v.rend(), T(98)));
+    }
+}
+
+template<typename T, bool Member>
+void BM_rfind_if(benchmark::State & state)
+{
+    auto const & v = static_values<T>();
+    auto const pred = [](T x) { return T(97) < x; };
+    for (auto _ : state) {
+        if (Member)
+            benchmark::DoNotOptimize(v.rfind_if(pred));
+        else
+            benchmark::DoNotOptimize(std::find_if(v.rbegin(), v.rend(), pred));
+    }
+}
+
+template<typename T, bool Member>
+void BM_copy_reversed(benchmark::State & state)
+{
+    auto const & v = static_values<T>();
+    std::vector<T> w(size);
+    for (auto _ : state) {
+        if (Member)
+            v.copy_reversed_to(w.data());
+        else
+            std::reverse_copy(v.begin(), v.end(), w.data());
+        benchmark::ClobberMemory();
+    }
+}
+
+#ifdef BOOST_STL_INTERFACES_SIMD_DISPATCH
+
+// The kernels of each instruction set -- 0 for the build's own, 1 for AVX2,
+// and 2 for AVX-512 -- called directly.
+
+namespace d = bsi::detail;
+
+bool skip_isa(benchmark::State & state)
+{
+    if (d::simd_host_isa() < d::simd_isa(state.range(0))) {
+        state.SkipWithError("not supported on this CPU");
+        return true;
+    }
+    return false;
+}
+
+void BM_isa_find(benchmark::State & state)
+{
+    if (skip_isa(state))
+        return;
+    using fn_t =
+        std::size_t (*)(std::uint8_t const *, std::size_t, std::uint8_t);
+    fn_t const fns[] = {
+        &d::simd_base::find<std::uint8_t, std::uint8_t>,
+        &d::simd_avx2::find<std::uint8_t, std::uint8_t>,
+        &d::simd_avx512::find<std::uint8_t, std::uint8_t>};
+    auto const f = fns[state.range(0)];
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(f(bytes.data(), size, std::uint8_t(0)));
+    }
+}
+
+void BM_isa_min_element(benchmark::State & state)
+{
+    if (skip_isa(state))
+        return;
+    using fn_t = int (*)(int const *, std::size_t);
+    fn_t const fns[] = {
+        &d::simd_base::extremum<std::int32_t, false, int>,
+        &d::simd_avx2::extremum<std::int32_t, false, int>,
+        &d::simd_avx512::extremum<std::int32_t, false, int>};
+    auto const f = fns[state.range(0)];
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(f(ints.data(), size));
+    }
+}
+
+BENCHMARK(BM_isa_find)->Arg(0)->Arg(1)->Arg(2);
+BENCHMARK(BM_isa_min_element)->Arg(0)->Arg(1)->Arg(2);
+
+#endif
+
+BENCHMARK_TEMPLATE(BM_find, std::uint8_t, false);
+BENCHMARK_TEMPLATE(BM_find, std::uint8_t, true);
+BENCHMARK_TEMPLATE(BM_find, int, false);
+BENCHMARK_TEMPLATE(BM_find, int, true);
+BENCHMARK_TEMPLATE(BM_count, std::uint8_t, false);
+BENCHMARK_TEMPLATE(BM_count, std::uint8_t, true);
+BENCHMARK_TEMPLATE(BM_count, int, false);
+BENCHMARK_TEMPLATE(BM_count, int, true);
+BENCHMARK_TEMPLATE(BM_mismatch, std::uint8_t, false);
+BENCHMARK_TEMPLATE(BM_mismatch, std::uint8_t, true);
+BENCHMARK_TEMPLATE(BM_mismatch, int, false);
+BENCHMARK_TEMPLATE(BM_mismatch, int, true);
+BENCHMARK_TEMPLATE(BM_min_element, std::uint8_t, false);
+BENCHMARK_TEMPLATE(BM_min_element, std::uint8_t, true);
+BENCHMARK_TEMPLATE(BM_min_element, int, false);
+BENCHMARK_TEMPLATE(BM_min_element, int, true);
+BENCHMARK_TEMPLATE(BM_rfind, std::uint8_t, false);
+BENCHMARK_TEMPLATE(BM_rfind, std::uint8_t, true);
+BENCHMARK_TEMPLATE(BM_rfind, int, false);
+BENCHMARK_TEMPLATE(BM_rfind, int, true);
+BENCHMARK_TEMPLATE(BM_requal, std::uint8_t, false);
+BENCHMARK_TEMPLATE(BM_requal, std::uint8_t, true);
+BENCHMARK_TEMPLATE(BM_requal, int, false);
+BENCHMARK_TEMPLATE(BM_requal, int, true);
+BENCHMARK_TEMPLATE(BM_rcopy, std::uint8_t, false);
+BENCHMARK_TEMPLATE(BM_rcopy, std::uint8_t, true);
+BENCHMARK_TEMPLATE(BM_rcopy, int, false);
+BENCHMARK_TEMPLATE(BM_rcopy, int, true);
+BENCHMARK_TEMPLATE(BM_find_last, std::uint8_t, false);
+BENCHMARK_TEMPLATE(BM_find_last, std::uint8_t, true);
+BENCHMARK_TEMPLATE(BM_find_last, int, false);
+BENCHMARK_TEMPLATE(BM_find_last, int, true);
+BENCHMARK_TEMPLATE(BM_rfind_if, std::uint8_t, false);
+BENCHMARK_TEMPLATE(BM_rfind_if, std::uint8_t, true);
+BENCHMARK_TEMPLATE(BM_rfind_if, int, false);
+BENCHMARK_TEMPLATE(BM_rfind_if, int, true);
+BENCHMARK_TEMPLATE(BM_copy_reversed, std::uint8_t, false);
+BENCHMARK_TEMPLATE(BM_copy_reversed, std::uint8_t, true);
+BENCHMARK_TEMPLATE(BM_copy_reversed, int, false);
+BENCHMARK_TEMPLATE(BM_copy_reversed, int, true);
+
+BENCHMARK_MAIN();
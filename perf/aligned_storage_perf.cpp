@@ -0,0 +1,105 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/static_vector.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstring>
+
+
+// The sum benchmarks add up state.range(0) floats -- a count that is not a
+// multiple of the vector width -- with a 32-byte-vector kernel written with
+// the GCC vector extensions.  Over a static_vector<float, 1024>, the kernel
+// loads unaligned vectors and finishes with a scalar loop over the last few
+// elements.  Over a static_vector<float, 1024, 32>, it loads aligned vectors
+// through padded_capacity(), and the padding past size() is zeros, so there
+// is no scalar loop.
+//
+// The counter benchmarks have each of state.threads() threads increment its
+// own atomic counter, the counters packed into one static_vector<std::atomic
+// <long>, 64>, or each in its own cache line, as cache_padded elements.
+// Packed counters share cache lines, which bounce between the cores that
+// write them; with one core, there is nothing to bounce, and the two take
+// the same time.
+
+namespace bsi = boost::stl_interfaces;
+
+#if defined(__GNUC__)
+
+typedef float v8f __attribute__((vector_size(32)));
+
+float horizontal_sum(v8f const & v)
+{
+    float retval = 0;
+    for (int i = 0; i < 8; ++i) {
+        retval += v[i];
+    }
+    return retval;
+}
+
+void BM_sum_epilogue(benchmark::State & state)
+{
+    bsi::static_vector<float, 1024> v(state.range(0), 1.0f);
+    for (auto _ : state) {
+        v8f acc = {};
+        std::size_t i = 0;
+        for (; i + 8 <= v.size(); i += 8) {
+            v8f x;
+            std::memcpy(&x, v.data() + i, sizeof(x));
+            acc += x;
+        }
+        float sum = horizontal_sum(acc);
+        for (; i < v.size(); ++i) {
+            sum += v[i];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+void BM_sum_padded(benchmark::State & state)
+{
+    bsi::static_vector<float, 1024, 32> v(state.range(0), 1.0f);
+    std::fill(v.end(), v.data() + v.padded_capacity(), 0.0f);
+    for (auto _ : state) {
+        v8f acc = {};
+        v8f const * const vectors = reinterpret_cast<v8f const *>(v.data());
+        for (std::size_t i = 0, n = (v.size() + 7) / 8; i < n; ++i) {
+            acc += vectors[i];
+        }
+        benchmark::DoNotOptimize(horizontal_sum(acc));
+    }
+}
+
+BENCHMARK(BM_sum_epilogue)->Arg(13)->Arg(61)->Arg(1021);
+BENCHMARK(BM_sum_padded)->Arg(13)->Arg(61)->Arg(1021);
+
+#endif
+
+bsi::static_vector<std::atomic<long>, 64> packed_counters(64);
+bsi::static_vector<bsi::cache_padded<std::atomic<long>>, 64>
+    padded_counters(64);
+
+void BM_counters_packed(benchmark::State & state)
+{
+    auto & counter = packed_counters[state.thread_index()];
+    for (auto _ : state) {
+        counter.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void BM_counters_padded(benchmark::State & state)
+{
+    auto & counter = *padded_counters[state.thread_index()];
+    for (auto _ : state) {
+        counter.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+BENCHMARK(BM_counters_packed)->ThreadRange(1, 8);
+BENCHMARK(BM_counters_padded)->ThreadRange(1, 8);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,164 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/stl_interfaces/alloc_vector.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#if defined(__cpp_lib_memory_resource)
+#include <memory_resource>
+#endif
+
+
+using boost::stl_interfaces::alloc_vector;
+
+
+// These benchmarks handle a "request" by building state.range(0) small
+// alloc_vectors, which all die together at the end of the request.  With
+// std::allocator, each growth of each vector is a trip to the heap; with an
+// arena, it is a pointer bump, and the whole request's memory is released at
+// once.
+
+// A minimal monotonic arena, usable before C++17's
+// std::pmr::monotonic_buffer_resource.
+struct arena
+{
+    explicit arena(std::size_t size) : buf_(size), used_(0) {}
+
+    void * allocate(std::size_t n, std::size_t align)
+    {
+        used_ = (used_ + align - 1) / align * align;
+        void * const retval = buf_.data() + used_;
+        used_ += n;
+        return retval;
+    }
+    void release() noexcept { used_ = 0; }
+
+private:
+    std::vector<char> buf_;
+    std::size_t used_;
+};
+
+template<typename T>
+struct arena_allocator
+{
+    using value_type = T;
+
+    explicit arena_allocator(arena & a) noexcept : arena_(&a) {}
+    template<typename U>
+    arena_allocator(arena_allocator<U> other) noexcept : arena_(other.arena_)
+    {}
+
+    T * allocate(std::size_t n)
+    {
+        return static_cast<T *>(arena_->allocate(n * sizeof(T), alignof(T)));
+    }
+    void deallocate(T *, std::size_t) noexcept {}
+
+    friend bool operator==(arena_allocator lhs, arena_allocator rhs) noexcept
+    {
+        return lhs.arena_ == rhs.arena_;
+    }
+    friend bool operator!=(arena_allocator lhs, arena_allocator rhs) noexcept
+    {
+        return lhs.arena_ != rhs.arena_;
+    }
+
+    arena * arena_;
+};
+
+template<typename Vector, typename Allocator>
+void handle_request(int n, Allocator const & a)
+{
+    std::vector<Vector> vectors;
+    vectors.reserve(n);
+    for (int i = 0; i < n; ++i) {
+        vectors.emplace_back(a);
+        for (int j = 0; j < 32; ++j) {
+            vectors.back().push_back(j);
+        }
+    }
+    benchmark::DoNotOptimize(vectors.back().back());
+}
+
+void BM_request_std_allocator(benchmark::State & state)
+{
+    for (auto _ : state) {
+        handle_request<alloc_vector<int>>(
+            state.range(0), std::allocator<int>());
+    }
+}
+
+void BM_request_arena_allocator(benchmark::State & state)
+{
+    arena a(1 << 24);
+    for (auto _ : state) {
+        handle_request<alloc_vector<int, arena_allocator<int>>>(
+            state.range(0), arena_allocator<int>(a));
+        a.release();
+    }
+}
+
+BENCHMARK(BM_request_std_allocator)->RangeMultiplier(8)->Range(8, 1 << 12);
+BENCHMARK(BM_request_arena_allocator)->RangeMultiplier(8)->Range(8, 1 << 12);
+
+#if defined(__cpp_lib_memory_resource)
+void BM_request_pmr_monotonic(benchmark::State & state)
+{
+    using alloc_type = std::pmr::polymorphic_allocator<int>;
+    for (auto _ : state) {
+        std::pmr::monotonic_buffer_resource resource;
+        handle_request<alloc_vector<int, alloc_type>>(
+            state.range(0), alloc_type(&resource));
+    }
+}
+
+BENCHMARK(BM_request_pmr_monotonic)->RangeMultiplier(8)->Range(8, 1 << 12);
+#endif
+
+// These benchmarks append state.range(0) ints to an empty alloc_vector,
+// which has no range insert.  append_range() reserves the room for all of
+// them at once, by container_growth_policy; push_back() grows 1, 2, 4, ...
+
+std::vector<int> const ints(1 << 16, 1);
+
+struct int_span
+{
+    int const * begin() const { return first; }
+    int const * end() const { return last; }
+
+    int const * first;
+    int const * last;
+};
+
+void BM_append_push_back(benchmark::State & state)
+{
+    auto const n = std::size_t(state.range(0));
+    for (auto _ : state) {
+        alloc_vector<int> v;
+        for (std::size_t i = 0; i < n; ++i) {
+            v.push_back(ints[i]);
+        }
+        benchmark::DoNotOptimize(v.data());
+    }
+}
+
+void BM_append_range(benchmark::State & state)
+{
+    auto const n = std::size_t(state.range(0));
+    for (auto _ : state) {
+        alloc_vector<int> v;
+        v.append_range(int_span{ints.data(), ints.data() + n});
+        benchmark::DoNotOptimize(v.data());
+    }
+}
+
+BENCHMARK(BM_append_push_back)->RangeMultiplier(16)->Range(16, 1 << 16);
+BENCHMARK(BM_append_range)->RangeMultiplier(16)->Range(16, 1 << 16);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,70 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/any_iterator.hpp>
+#include "bench_data.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+
+// These benchmarks sum state.range(0) ints through a type-erased view, as
+// a plugin reads a range that the host provides: through its iterators,
+// with an indirect call per element, and in blocks of 64 with next_n(), with
+// one indirect call per block.  The direct loop is the baseline.
+
+namespace bsi = boost::stl_interfaces;
+
+using view_type = bsi::any_view<int const>;
+
+void BM_direct(benchmark::State & state)
+{
+    auto const ints = bench_data::random_ints(state.range(0), 1000);
+    for (auto _ : state) {
+        long sum = 0;
+        for (int x : ints) {
+            sum += x;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+void BM_any_iterator(benchmark::State & state)
+{
+    auto const ints = bench_data::random_ints(state.range(0), 1000);
+    view_type const view(ints);
+    for (auto _ : state) {
+        long sum = 0;
+        for (int x : view) {
+            sum += x;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+void BM_any_iterator_next_n(benchmark::State & state)
+{
+    auto const ints = bench_data::random_ints(state.range(0), 1000);
+    view_type const view(ints);
+    for (auto _ : state) {
+        long sum = 0;
+        int buf[64];
+        auto it = view.begin();
+        auto const last = view.end();
+        while (auto const n = it.next_n(buf, 64, last)) {
+            for (std::ptrdiff_t i = 0; i < n; ++i) {
+                sum += buf[i];
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+BENCHMARK(BM_direct)->Range(64, 1 << 16);
+BENCHMARK(BM_any_iterator)->Range(64, 1 << 16);
+BENCHMARK(BM_any_iterator_next_n)->Range(64, 1 << 16);
+
+BENCHMARK_MAIN();
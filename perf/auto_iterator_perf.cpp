@@ -0,0 +1,87 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/algorithm.hpp>
+#include <boost/stl_interfaces/auto_iterator_interface.hpp>
+#include "bench_data.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <vector>
+
+
+// These benchmarks run std::lower_bound() and
+// boost::stl_interfaces::find() over 64K sorted ints through two iterators
+// over an int *: one that derives from iterator_interface and states
+// std::forward_iterator_tag, as an iterator written to the forward iterator
+// requirements does, and one that derives from auto_iterator_interface,
+// whose concept is deduced to be contiguous.
+
+namespace bsi = boost::stl_interfaces;
+
+struct forward_iter
+    : bsi::iterator_interface<forward_iter, std::forward_iterator_tag, int>
+{
+    forward_iter() = default;
+    explicit forward_iter(int * p) : p_(p) {}
+
+private:
+    friend bsi::access;
+    int *& base_reference() noexcept { return p_; }
+    int * base_reference() const noexcept { return p_; }
+    int * p_ = nullptr;
+};
+
+struct auto_iter : bsi::auto_iterator_interface<auto_iter, int *, int>
+{
+    using auto_iterator_interface::auto_iterator_interface;
+};
+
+constexpr int size = 1 << 16;
+
+std::vector<int> const & sorted()
+{
+    static std::vector<int> const retval = [] {
+        auto v = bench_data::random_ints(size, 1 << 30);
+        std::sort(v.begin(), v.end());
+        return v;
+    }();
+    return retval;
+}
+
+template<typename Iter>
+void BM_lower_bound(benchmark::State & state)
+{
+    auto & v = const_cast<std::vector<int> &>(sorted());
+    auto const keys = bench_data::random_ints(1 << 10, 1 << 30, 2);
+    Iter const first(v.data());
+    Iter const last(v.data() + v.size());
+    for (auto _ : state) {
+        long sum = 0;
+        for (auto k : keys) {
+            sum += *std::lower_bound(first, last, k);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+template<typename Iter>
+void BM_find(benchmark::State & state)
+{
+    auto & v = const_cast<std::vector<int> &>(sorted());
+    Iter const first(v.data());
+    Iter const last(v.data() + v.size());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(bsi::find(first, last, -1));
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_lower_bound, forward_iter);
+BENCHMARK_TEMPLATE(BM_lower_bound, auto_iter);
+BENCHMARK_TEMPLATE(BM_find, forward_iter);
+BENCHMARK_TEMPLATE(BM_find, auto_iter);
+
+BENCHMARK_MAIN();
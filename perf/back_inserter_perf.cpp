@@ -0,0 +1,105 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/back_insert_iterator.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+#include <string>
+#include <vector>
+
+
+// These benchmarks append a batch of converted elements to an empty vector,
+// as a batch conversion does.
+
+int const batch_size = 1 << 16;
+
+std::vector<int> make_ints()
+{
+    std::vector<int> retval(batch_size);
+    std::iota(retval.begin(), retval.end(), 0);
+    return retval;
+}
+
+std::vector<int> const ints = make_ints();
+
+void BM_copy_std_back_inserter(benchmark::State & state)
+{
+    for (auto _ : state) {
+        std::vector<int> out;
+        std::copy(ints.begin(), ints.end(), std::back_inserter(out));
+        benchmark::DoNotOptimize(out.data());
+    }
+}
+void BM_copy_back_inserter(benchmark::State & state)
+{
+    for (auto _ : state) {
+        std::vector<int> out;
+        boost::stl_interfaces::copy(
+            ints.begin(), ints.end(), boost::stl_interfaces::back_inserter(out));
+        benchmark::DoNotOptimize(out.data());
+    }
+}
+
+void BM_transform_std_back_inserter(benchmark::State & state)
+{
+    for (auto _ : state) {
+        std::vector<double> out;
+        std::transform(
+            ints.begin(), ints.end(), std::back_inserter(out), [](int x) {
+                return x * 0.5;
+            });
+        benchmark::DoNotOptimize(out.data());
+    }
+}
+void BM_transform_back_inserter(benchmark::State & state)
+{
+    for (auto _ : state) {
+        std::vector<double> out;
+        boost::stl_interfaces::transform(
+            ints.begin(),
+            ints.end(),
+            boost::stl_interfaces::back_inserter(out),
+            [](int x) { return x * 0.5; });
+        benchmark::DoNotOptimize(out.data());
+    }
+}
+
+// Strings are expensive to relocate, so each reallocation costs more.
+void BM_transform_strings_std_back_inserter(benchmark::State & state)
+{
+    for (auto _ : state) {
+        std::vector<std::string> out;
+        std::transform(
+            ints.begin(), ints.end(), std::back_inserter(out), [](int x) {
+                return std::string(1, char('a' + x % 26));
+            });
+        benchmark::DoNotOptimize(out.data());
+    }
+}
+void BM_transform_strings_back_inserter(benchmark::State & state)
+{
+    for (auto _ : state) {
+        std::vector<std::string> out;
+        boost::stl_interfaces::transform(
+            ints.begin(),
+            ints.end(),
+            boost::stl_interfaces::back_inserter(out),
+            [](int x) { return std::string(1, char('a' + x % 26)); });
+        benchmark::DoNotOptimize(out.data());
+    }
+}
+
+BENCHMARK(BM_copy_std_back_inserter);
+BENCHMARK(BM_copy_back_inserter);
+BENCHMARK(BM_transform_std_back_inserter);
+BENCHMARK(BM_transform_back_inserter);
+BENCHMARK(BM_transform_strings_std_back_inserter);
+BENCHMARK(BM_transform_strings_back_inserter);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,176 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_PERF_BENCH_DATA_HPP
+#define BOOST_STL_INTERFACES_PERF_BENCH_DATA_HPP
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include <cstdint>
+
+
+// The datasets that the perf executables share.  Each is a function of its
+// arguments and seed alone -- the generator and the ways its numbers are
+// turned into values are written out here, rather than taken from <random>,
+// whose distributions differ between standard libraries -- so the same call
+// makes the same data on every platform and at every commit, and results
+// from different builds measure the code and not the data.  Changing what
+// any of these functions makes is a change to every benchmark that uses it;
+// bump version when doing so.  The bench target records the version in the
+// JSON results, with the commit that they came from.
+
+namespace bench_data {
+
+    constexpr int version = 1;
+
+    // SplitMix64.
+    struct rng
+    {
+        explicit rng(std::uint64_t seed) noexcept : state_(seed) {}
+
+        std::uint64_t operator()() noexcept
+        {
+            std::uint64_t z = (state_ += 0x9e3779b97f4a7c15ull);
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+            return z ^ (z >> 31);
+        }
+
+        // A number in [0, bound), by multiplying rather than by modulus.
+        std::uint64_t below(std::uint64_t bound) noexcept
+        {
+            return std::uint64_t(((*this)() >> 32) * (bound & 0xffffffff)) >>
+                   32;
+        }
+
+        // A number in [0, 1).
+        double unit() noexcept
+        {
+            return ((*this)() >> 11) * (1.0 / 9007199254740992.0);
+        }
+
+    private:
+        std::uint64_t state_;
+    };
+
+    // Fisher-Yates, since std::shuffle() may differ between implementations.
+    template<typename T>
+    void shuffle(std::vector<T> & v, rng & gen)
+    {
+        for (std::size_t i = v.size(); 1 < i; --i) {
+            using std::swap;
+            swap(v[i - 1], v[gen.below(i)]);
+        }
+    }
+
+    // n ints, uniform in [0, bound).  bound must fit in 32 bits.
+    inline std::vector<int>
+    random_ints(std::size_t n, int bound, std::uint64_t seed = 1)
+    {
+        rng gen(seed);
+        std::vector<int> retval(n);
+        for (auto & x : retval) {
+            x = int(gen.below(std::uint64_t(bound)));
+        }
+        return retval;
+    }
+
+    // n keys in [0, keys), Zipf-distributed with exponent 1: key 0 is the
+    // most common, and key k comes up 1 / (k + 1) times as often, as the
+    // keys of hash and map lookups often do.
+    inline std::vector<int>
+    skewed_keys(std::size_t n, int keys, std::uint64_t seed = 1)
+    {
+        std::vector<double> cdf(keys);
+        double sum = 0.0;
+        for (int k = 0; k < keys; ++k) {
+            sum += 1.0 / (k + 1);
+            cdf[k] = sum;
+        }
+        rng gen(seed);
+        std::vector<int> retval(n);
+        for (auto & x : retval) {
+            auto const it =
+                std::upper_bound(cdf.begin(), cdf.end(), gen.unit() * sum);
+            x = int(std::min(it - cdf.begin(), std::ptrdiff_t(keys - 1)));
+        }
+        return retval;
+    }
+
+    // n strings of lowercase letters, with lengths uniform in
+    // [min_size, max_size].
+    inline std::vector<std::string> random_strings(
+        std::size_t n,
+        std::size_t min_size = 1,
+        std::size_t max_size = 32,
+        std::uint64_t seed = 1)
+    {
+        rng gen(seed);
+        std::vector<std::string> retval(n);
+        for (auto & s : retval) {
+            s.resize(min_size + gen.below(max_size - min_size + 1));
+            for (auto & c : s) {
+                c = char('a' + gen.below(26));
+            }
+        }
+        return retval;
+    }
+
+    // The node of example/node_iterator.cpp.
+    template<typename T>
+    struct node
+    {
+        T value_;
+        node * next_; // == nullptr in the tail node
+    };
+
+    // n nodes, linked in a random order through the array that holds them,
+    // as the nodes of a long-lived list are scattered through memory.  The
+    // values are random_ints(n, bound, seed), in list order.
+    template<typename T>
+    struct linked_nodes
+    {
+        std::vector<node<T>> nodes;
+        node<T> * head;
+    };
+
+    inline linked_nodes<int>
+    random_linked_nodes(std::size_t n, int bound, std::uint64_t seed = 1)
+    {
+        linked_nodes<int> retval{std::vector<node<int>>(n), nullptr};
+        if (!n)
+            return retval;
+        std::vector<std::size_t> order(n);
+        std::iota(order.begin(), order.end(), std::size_t(0));
+        rng gen(seed);
+        shuffle(order, gen);
+        auto const values = random_ints(n, bound, seed);
+        for (std::size_t i = 0; i < n; ++i) {
+            auto & x = retval.nodes[order[i]];
+            x.value_ = values[i];
+            x.next_ = i + 1 < n ? &retval.nodes[order[i + 1]] : nullptr;
+        }
+        retval.head = &retval.nodes[order[0]];
+        return retval;
+    }
+
+    namespace detail {
+        inline bool add_context()
+        {
+            benchmark::AddCustomContext(
+                "bench_data_version", std::to_string(version));
+            return true;
+        }
+        static bool const context_added = add_context();
+    }
+
+}
+
+#endif
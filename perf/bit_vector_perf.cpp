@@ -0,0 +1,84 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/stl_interfaces/bit_vector.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <vector>
+
+
+using boost::stl_interfaces::bit_vector;
+
+
+// These benchmarks count and copy state.range(0) bits, a bit at a time with
+// the std algorithms, and a word at a time with the bit_iterator overloads.
+// The copies start at different offsets within a word.
+
+bit_vector every_third(int n)
+{
+    bit_vector retval(n);
+    for (int i = 0; i < n; i += 3) {
+        retval[i] = true;
+    }
+    return retval;
+}
+
+void BM_count_per_bit(benchmark::State & state)
+{
+    auto const bits = every_third(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::count(bits.begin(), bits.end(), true));
+    }
+}
+
+void BM_count_per_word(benchmark::State & state)
+{
+    auto const bits = every_third(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(count(bits.begin(), bits.end(), true));
+    }
+}
+
+void BM_copy_per_bit(benchmark::State & state)
+{
+    auto const bits = every_third(state.range(0));
+    bit_vector out(state.range(0) + 64);
+    for (auto _ : state) {
+        std::copy(bits.begin(), bits.end(), out.begin() + 5);
+        benchmark::DoNotOptimize(&out);
+    }
+}
+
+void BM_copy_per_word(benchmark::State & state)
+{
+    auto const bits = every_third(state.range(0));
+    bit_vector out(state.range(0) + 64);
+    for (auto _ : state) {
+        copy(bits.begin(), bits.end(), out.begin() + 5);
+        benchmark::DoNotOptimize(&out);
+    }
+}
+
+void BM_vector_bool_count(benchmark::State & state)
+{
+    std::vector<bool> bits(state.range(0));
+    for (int i = 0; i < state.range(0); i += 3) {
+        bits[i] = true;
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::count(bits.begin(), bits.end(), true));
+    }
+}
+
+BENCHMARK(BM_count_per_bit)->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK(BM_count_per_word)->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK(BM_copy_per_bit)->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK(BM_copy_per_word)->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK(BM_vector_bool_count)->Arg(1 << 10)->Arg(1 << 20);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,95 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/btree.hpp>
+#include "bench_data.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <map>
+#include <vector>
+
+
+// These benchmarks index 1M orders by 64-bit order id, as an order book
+// does, in a std::map and in a btree_map: inserting the ids in the
+// increasing order in which they are issued, looking up random ones, and
+// iterating over all of them.
+
+using order_id = std::uint64_t;
+constexpr int orders = 1 << 20;
+
+// Ids are issued in increasing order, with gaps.
+order_id id(int i) { return order_id(i) * 3 + 1000000; }
+
+std::vector<order_id> const & lookups()
+{
+    static auto const retval = [] {
+        std::vector<order_id> ids;
+        for (int x : bench_data::random_ints(1 << 16, orders, 1)) {
+            ids.push_back(id(x));
+        }
+        return ids;
+    }();
+    return retval;
+}
+
+template<typename Map>
+Map make_index()
+{
+    Map retval;
+    for (int i = 0; i < orders; ++i) {
+        retval.emplace(id(i), std::uint32_t(i));
+    }
+    return retval;
+}
+
+template<typename Map>
+void BM_insert(benchmark::State & state)
+{
+    for (auto _ : state) {
+        Map m;
+        for (int i = 0; i < orders; ++i) {
+            m.emplace(id(i), std::uint32_t(i));
+        }
+        benchmark::DoNotOptimize(m.size());
+    }
+}
+
+template<typename Map>
+void BM_lookup(benchmark::State & state)
+{
+    Map const m = make_index<Map>();
+    auto const & ids = lookups();
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(m.find(ids[i++ % ids.size()])->second);
+    }
+}
+
+template<typename Map>
+void BM_iterate(benchmark::State & state)
+{
+    Map const m = make_index<Map>();
+    for (auto _ : state) {
+        std::uint64_t sum = 0;
+        for (auto const & x : m) {
+            sum += x.second;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+using std_map = std::map<order_id, std::uint32_t>;
+using btree_map = boost::stl_interfaces::btree_map<order_id, std::uint32_t>;
+
+BENCHMARK_TEMPLATE(BM_insert, std_map)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_insert, btree_map)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_lookup, std_map);
+BENCHMARK_TEMPLATE(BM_lookup, btree_map);
+BENCHMARK_TEMPLATE(BM_iterate, std_map)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_iterate, btree_map)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
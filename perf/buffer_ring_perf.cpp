@@ -0,0 +1,117 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/buffer_ring.hpp>
+#include "bench_data.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <deque>
+#include <iterator>
+#include <vector>
+
+
+// These benchmarks serialize 256 messages of 1024 ints each, as 4K of
+// little-endian bytes per message, with std::transform() -- into a
+// std::vector made for each message and written with write(), or into a
+// buffer_ring of 8 4K buffers, committed 8 at a time with one writev().
+// The writes go to /dev/null, which reads none of the data.
+
+namespace bsi = boost::stl_interfaces;
+
+std::vector<int> const & ints()
+{
+    static auto const retval = bench_data::random_ints(1024, 1 << 30, 1);
+    return retval;
+}
+
+constexpr int messages = 256;
+
+// Serializes each int as 4 bytes, one byte at a time.
+template<typename OutputIter>
+OutputIter serialize(std::vector<int> const & v, OutputIter out)
+{
+    for (int x : v) {
+        auto const u = unsigned(x);
+        *out++ = (unsigned char)u;
+        *out++ = (unsigned char)(u >> 8);
+        *out++ = (unsigned char)(u >> 16);
+        *out++ = (unsigned char)(u >> 24);
+    }
+    return out;
+}
+
+void BM_vector_per_message(benchmark::State & state)
+{
+    int const fd = ::open("/dev/null", O_WRONLY);
+    for (auto _ : state) {
+        for (int i = 0; i < messages; ++i) {
+            std::vector<unsigned char> bytes;
+            serialize(ints(), std::back_inserter(bytes));
+            benchmark::DoNotOptimize(::write(fd, bytes.data(), bytes.size()));
+        }
+    }
+    ::close(fd);
+}
+
+// Writes each committed batch with one writev(), synchronously.
+struct writev_sink
+{
+    void submit(std::size_t i, bsi::pointer_view<unsigned char const> bytes)
+    {
+        ::iovec iov;
+        iov.iov_base = const_cast<unsigned char *>(bytes.data());
+        iov.iov_len = std::size_t(bytes.size());
+        prepared.push_back(iov);
+        indices.push_back(i);
+    }
+    void commit()
+    {
+        benchmark::DoNotOptimize(
+            ::writev(fd, prepared.data(), int(prepared.size())));
+        prepared.clear();
+        done.insert(done.end(), indices.begin(), indices.end());
+        indices.clear();
+    }
+    std::size_t wait()
+    {
+        auto const i = done.front();
+        done.pop_front();
+        return i;
+    }
+
+    int fd;
+    std::vector<::iovec> prepared;
+    std::vector<std::size_t> indices;
+    std::deque<std::size_t> done;
+};
+
+void BM_buffer_ring(benchmark::State & state)
+{
+    writev_sink sink;
+    sink.fd = ::open("/dev/null", O_WRONLY);
+    sink.prepared.reserve(8);
+    sink.indices.reserve(8);
+    {
+        bsi::buffer_ring<writev_sink> ring(sink, 8, 4096, 8);
+        for (auto _ : state) {
+            for (int i = 0; i < messages; ++i) {
+                serialize(ints(), ring.begin());
+            }
+            ring.flush();
+        }
+    }
+    ::close(sink.fd);
+}
+
+BENCHMARK(BM_vector_per_message)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_buffer_ring)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,83 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/stl_interfaces/buffered_output_iterator.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+#include <fcntl.h>
+
+
+using boost::stl_interfaces::buffered_output_iterator;
+using boost::stl_interfaces::container_output_buffer;
+using boost::stl_interfaces::fd_output_buffer;
+
+
+// These benchmarks write 1M ints through output iterators: to a std::vector,
+// with std::back_inserter() and through a container_output_buffer; and to
+// /dev/null, with one write() per element and through an fd_output_buffer.
+
+int const n = 1 << 20;
+
+std::vector<int> const ints = [] {
+    std::vector<int> retval(n);
+    std::iota(retval.begin(), retval.end(), 0);
+    return retval;
+}();
+
+void BM_back_inserter(benchmark::State & state)
+{
+    for (auto _ : state) {
+        std::vector<int> d;
+        std::copy(ints.begin(), ints.end(), std::back_inserter(d));
+        benchmark::DoNotOptimize(d.back());
+    }
+}
+
+void BM_container_output_buffer(benchmark::State & state)
+{
+    for (auto _ : state) {
+        std::vector<int> d;
+        {
+            container_output_buffer<std::vector<int>> buffer(d);
+            std::copy(ints.begin(), ints.end(), buffer.out());
+        }
+        benchmark::DoNotOptimize(d.back());
+    }
+}
+
+void BM_write_per_element(benchmark::State & state)
+{
+    int const fd = ::open("/dev/null", O_WRONLY);
+    for (auto _ : state) {
+        for (auto x : ints) {
+            benchmark::DoNotOptimize(::write(fd, &x, sizeof(x)));
+        }
+    }
+    ::close(fd);
+}
+
+void BM_fd_output_buffer(benchmark::State & state)
+{
+    int const fd = ::open("/dev/null", O_WRONLY);
+    for (auto _ : state) {
+        fd_output_buffer<int> buffer(fd);
+        std::copy(ints.begin(), ints.end(), buffer.out());
+        buffer.flush();
+    }
+    ::close(fd);
+}
+
+BENCHMARK(BM_back_inserter)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_container_output_buffer)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_write_per_element)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_fd_output_buffer)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
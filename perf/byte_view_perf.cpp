@@ -0,0 +1,70 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/byte_view.hpp>
+#include "bench_data.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+
+// These benchmarks total the lengths in a received buffer of 64K wire
+// records, each a 16-byte struct.  The records are copied out of the buffer
+// into a std::vector of records first, or viewed in place with view_as().
+
+struct wire_record
+{
+    std::uint32_t id;
+    std::uint32_t length;
+    std::uint64_t timestamp;
+};
+
+constexpr int records = 1 << 16;
+
+std::vector<std::uint64_t> const & recv_buffer()
+{
+    static auto const retval = [] {
+        std::vector<std::uint64_t> buffer(records * 2);
+        auto const ints = bench_data::random_ints(records * 4, 1 << 20, 1);
+        std::memcpy(buffer.data(), ints.data(), buffer.size() * 8);
+        return buffer;
+    }();
+    return retval;
+}
+
+void BM_memcpy_then_read(benchmark::State & state)
+{
+    auto const bytes = boost::stl_interfaces::as_bytes(recv_buffer());
+    for (auto _ : state) {
+        std::vector<wire_record> copy(bytes.size() / sizeof(wire_record));
+        std::memcpy(copy.data(), bytes.data(), bytes.size());
+        std::uint64_t sum = 0;
+        for (auto const & r : copy) {
+            sum += r.length;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+void BM_view_as(benchmark::State & state)
+{
+    auto const bytes = boost::stl_interfaces::as_bytes(recv_buffer());
+    for (auto _ : state) {
+        std::uint64_t sum = 0;
+        for (auto const & r :
+             boost::stl_interfaces::view_as<wire_record>(bytes)) {
+            sum += r.length;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+BENCHMARK(BM_memcpy_then_read)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_view_as)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,115 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/cached_transform_view.hpp>
+#include "bench_data.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include <cstdlib>
+
+
+// These benchmarks sort 64K text records by a timestamp parsed out of each
+// one, by sorting their indices: through a transform_view, which parses
+// both records at every comparison, about 2 log2(n) = 32 times each;
+// through a cached_transform_view, which parses each record once; and by
+// parsing them all into a vector first.
+
+namespace bsi = boost::stl_interfaces;
+
+std::vector<std::string> make_records()
+{
+    std::vector<std::string> retval;
+    for (int x : bench_data::random_ints(1 << 16, 1 << 30)) {
+        retval.push_back(
+            "ts=" + std::to_string(1500000000000LL + x) + ";sym=abc;px=1");
+    }
+    return retval;
+}
+std::vector<std::string> const records = make_records();
+
+struct timestamp
+{
+    long long operator()(std::string const & r) const
+    {
+        return std::strtoll(r.c_str() + 3, nullptr, 10);
+    }
+};
+
+std::vector<int> identity_order()
+{
+    std::vector<int> retval(records.size());
+    std::iota(retval.begin(), retval.end(), 0);
+    return retval;
+}
+
+void BM_sort_transform_view(benchmark::State & state)
+{
+    for (auto _ : state) {
+        auto const keys = bsi::make_transform_view(records, timestamp{});
+        auto order = identity_order();
+        std::sort(order.begin(), order.end(), [&](int a, int b) {
+            return keys[a] < keys[b];
+        });
+        benchmark::DoNotOptimize(order.data());
+    }
+}
+void BM_sort_cached_transform_view(benchmark::State & state)
+{
+    for (auto _ : state) {
+        auto const keys =
+            bsi::make_cached_transform_view(records, timestamp{});
+        auto order = identity_order();
+        std::sort(order.begin(), order.end(), [&](int a, int b) {
+            return keys[a] < keys[b];
+        });
+        benchmark::DoNotOptimize(order.data());
+    }
+}
+void BM_sort_precomputed(benchmark::State & state)
+{
+    for (auto _ : state) {
+        std::vector<long long> keys(records.size());
+        std::transform(
+            records.begin(), records.end(), keys.begin(), timestamp{});
+        auto order = identity_order();
+        std::sort(order.begin(), order.end(), [&](int a, int b) {
+            return keys[a] < keys[b];
+        });
+        benchmark::DoNotOptimize(order.data());
+    }
+}
+
+// Each element is read once, so caching is pure overhead.
+void BM_sum_transform_view(benchmark::State & state)
+{
+    auto const keys = bsi::make_transform_view(records, timestamp{});
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            std::accumulate(keys.begin(), keys.end(), 0LL));
+    }
+}
+void BM_sum_cached_transform_view(benchmark::State & state)
+{
+    for (auto _ : state) {
+        auto const keys =
+            bsi::make_cached_transform_view(records, timestamp{});
+        benchmark::DoNotOptimize(
+            std::accumulate(keys.begin(), keys.end(), 0LL));
+    }
+}
+
+BENCHMARK(BM_sort_transform_view)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_sort_cached_transform_view)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_sort_precomputed)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_sum_transform_view)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_sum_cached_transform_view)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
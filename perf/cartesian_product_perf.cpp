@@ -0,0 +1,87 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/cartesian_product_view.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <vector>
+
+
+// Each benchmark evaluates a function at every point of a 64x64x64 grid of
+// parameters: BM_nested_loops with three nested loops; BM_product_loop
+// with one loop over a cartesian_product_view; and BM_product_chunks with
+// the product split into 64 chunks by operator+(), as a parallel algorithm
+// would split it, and each chunk run in turn.
+
+int const n = 64;
+
+std::vector<double> grid_axis(double scale)
+{
+    std::vector<double> retval(n);
+    for (int i = 0; i < n; ++i) {
+        retval[i] = i * scale;
+    }
+    return retval;
+}
+
+std::vector<double> const as = grid_axis(0.5);
+std::vector<double> const bs = grid_axis(0.25);
+std::vector<double> const cs = grid_axis(0.125);
+
+inline double f(double a, double b, double c) { return a * b - c; }
+
+void BM_nested_loops(benchmark::State & state)
+{
+    for (auto _ : state) {
+        double sum = 0.0;
+        for (double a : as) {
+            for (double b : bs) {
+                for (double c : cs) {
+                    sum += f(a, b, c);
+                }
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+void BM_product_loop(benchmark::State & state)
+{
+    namespace bsi = boost::stl_interfaces;
+    auto const grid = bsi::make_cartesian_product_view(as, bs, cs);
+    for (auto _ : state) {
+        double sum = 0.0;
+        for (auto p : grid) {
+            sum += f(std::get<0>(p), std::get<1>(p), std::get<2>(p));
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+void BM_product_chunks(benchmark::State & state)
+{
+    namespace bsi = boost::stl_interfaces;
+    auto const grid = bsi::make_cartesian_product_view(as, bs, cs);
+    std::ptrdiff_t const chunk = grid.size() / 64;
+    for (auto _ : state) {
+        double sum = 0.0;
+        for (std::ptrdiff_t i = 0; i < grid.size(); i += chunk) {
+            auto const first = grid.begin() + i;
+            auto const last = first + chunk;
+            std::for_each(first, last, [&](auto p) {
+                sum += f(std::get<0>(p), std::get<1>(p), std::get<2>(p));
+            });
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+BENCHMARK(BM_nested_loops);
+BENCHMARK(BM_product_loop);
+BENCHMARK(BM_product_chunks);
+
+BENCHMARK_MAIN();
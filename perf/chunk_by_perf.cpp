@@ -0,0 +1,76 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/chunk_by_view.hpp>
+#include "bench_data.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <vector>
+
+
+// These benchmarks count the runs of equal keys in 1M sorted ints, and sum
+// the longest run -- a run-length aggregation by key -- by copying each run
+// into a bucket of its own, with a chunk_by_view whose predicate is a
+// lambda, and with one whose predicate is std::equal_to<>, which finds the
+// end of each run with the vectorized mismatch().
+
+std::vector<int> make_keys()
+{
+    auto retval = bench_data::random_ints(1 << 20, 1 << 12);
+    std::sort(retval.begin(), retval.end());
+    return retval;
+}
+
+std::vector<int> const keys = make_keys();
+
+void BM_copy_into_buckets(benchmark::State & state)
+{
+    std::vector<std::vector<int>> buckets;
+    for (auto _ : state) {
+        buckets.clear();
+        for (std::size_t i = 0; i < keys.size(); ++i) {
+            if (!i || keys[i] != keys[i - 1])
+                buckets.emplace_back();
+            buckets.back().push_back(keys[i]);
+        }
+        std::size_t longest = 0;
+        for (auto const & b : buckets) {
+            longest = (std::max)(longest, b.size());
+        }
+        benchmark::DoNotOptimize(longest);
+    }
+}
+
+template<typename Pred>
+void chunk_by(benchmark::State & state, Pred pred)
+{
+    auto const runs = boost::stl_interfaces::chunk_by_view<int const *, Pred>(
+        keys.data(), keys.data() + keys.size(), pred);
+    for (auto _ : state) {
+        std::ptrdiff_t longest = 0;
+        for (auto run : runs) {
+            longest = (std::max)(longest, run.size());
+        }
+        benchmark::DoNotOptimize(longest);
+    }
+}
+
+void BM_chunk_by_lambda(benchmark::State & state)
+{
+    chunk_by(state, [](int a, int b) { return a == b; });
+}
+
+void BM_chunk_by_equal_to(benchmark::State & state)
+{
+    chunk_by(state, std::equal_to<>{});
+}
+
+BENCHMARK(BM_copy_into_buckets);
+BENCHMARK(BM_chunk_by_lambda);
+BENCHMARK(BM_chunk_by_equal_to);
+
+BENCHMARK_MAIN();
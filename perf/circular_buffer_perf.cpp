@@ -0,0 +1,87 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/stl_interfaces/circular_buffer.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <deque>
+#include <vector>
+
+
+using boost::stl_interfaces::circular_buffer;
+
+
+// These benchmarks stream ints through a queue, in batches of
+// state.range(0), as a producer and consumer sharing a buffer do.
+
+template<typename Queue>
+void stream_elements(benchmark::State & state)
+{
+    Queue q;
+    int const batch = state.range(0);
+    for (auto _ : state) {
+        for (int i = 0; i < batch; ++i) {
+            q.push_back(i);
+        }
+        int sum = 0;
+        for (int i = 0; i < batch; ++i) {
+            sum += q.front();
+            q.pop_front();
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+void BM_stream_std_deque(benchmark::State & state)
+{
+    stream_elements<std::deque<int>>(state);
+}
+
+void BM_stream_circular_buffer(benchmark::State & state)
+{
+    stream_elements<circular_buffer<int>>(state);
+}
+
+void BM_stream_fixed_circular_buffer(benchmark::State & state)
+{
+    stream_elements<circular_buffer<int, 1024>>(state);
+}
+
+// The same, with the batches copied in and out in bulk.
+void BM_stream_bulk_std_deque(benchmark::State & state)
+{
+    std::deque<int> q;
+    std::vector<int> in(state.range(0), 1);
+    std::vector<int> out(state.range(0));
+    for (auto _ : state) {
+        q.insert(q.end(), in.begin(), in.end());
+        std::copy(q.begin(), q.begin() + in.size(), out.begin());
+        q.erase(q.begin(), q.begin() + in.size());
+        benchmark::DoNotOptimize(out.data());
+    }
+}
+
+void BM_stream_bulk_circular_buffer(benchmark::State & state)
+{
+    circular_buffer<int, 1024> q;
+    std::vector<int> in(state.range(0), 1);
+    std::vector<int> out(state.range(0));
+    for (auto _ : state) {
+        q.write(in.data(), in.size());
+        q.read(out.data(), out.size());
+        benchmark::DoNotOptimize(out.data());
+    }
+}
+
+BENCHMARK(BM_stream_std_deque)->Arg(16)->Arg(1000);
+BENCHMARK(BM_stream_circular_buffer)->Arg(16)->Arg(1000);
+BENCHMARK(BM_stream_fixed_circular_buffer)->Arg(16)->Arg(1000);
+BENCHMARK(BM_stream_bulk_std_deque)->Arg(16)->Arg(1000);
+BENCHMARK(BM_stream_bulk_circular_buffer)->Arg(16)->Arg(1000);
+
+BENCHMARK_MAIN();
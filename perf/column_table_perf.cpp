@@ -0,0 +1,104 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/column_table.hpp>
+
+#include "bench_data.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+
+using boost::stl_interfaces::column_table;
+
+
+// These benchmarks run a query that reads two of twenty columns -- the sum
+// of price * quantity -- over a column_table, and over a std::vector of
+// twenty-field structs (the row-oriented layout).
+
+struct row
+{
+    double f0, f1, f2, price, f4, f5, f6, quantity, f8, f9;
+    double f10, f11, f12, f13, f14, f15, f16, f17, f18, f19;
+};
+
+using table_t = column_table<std::tuple<
+    double, double, double, double, double,
+    double, double, double, double, double,
+    double, double, double, double, double,
+    double, double, double, double, double>>;
+
+std::vector<int> const prices = bench_data::random_ints(1 << 20, 1000);
+std::vector<int> const quantities = bench_data::random_ints(1 << 20, 100, 2);
+
+std::vector<row> make_rows(std::size_t n)
+{
+    std::vector<row> retval(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        retval[i].price = prices[i];
+        retval[i].quantity = quantities[i];
+    }
+    return retval;
+}
+
+table_t make_table(std::size_t n)
+{
+    table_t retval;
+    retval.resize(n);
+    auto const price = retval.column<3>();
+    auto const quantity = retval.column<7>();
+    for (std::size_t i = 0; i < n; ++i) {
+        price[i] = prices[i];
+        quantity[i] = quantities[i];
+    }
+    return retval;
+}
+
+void BM_two_columns_rows(benchmark::State & state)
+{
+    auto const rows = make_rows(state.range(0));
+    for (auto _ : state) {
+        double sum = 0.0;
+        for (auto const & r : rows) {
+            sum += r.price * r.quantity;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+// Through select<3, 7>(), whose iterator is a proxy iterator.
+void BM_two_columns_select(benchmark::State & state)
+{
+    auto const table = make_table(state.range(0));
+    for (auto _ : state) {
+        double sum = 0.0;
+        for (auto r : table.select<3, 7>()) {
+            sum += std::get<0>(r) * std::get<1>(r);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+// Through column<3>() and column<7>(), which are contiguous.
+void BM_two_columns_column(benchmark::State & state)
+{
+    auto const table = make_table(state.range(0));
+    for (auto _ : state) {
+        auto const price = table.column<3>();
+        auto const quantity = table.column<7>();
+        double sum = 0.0;
+        for (std::size_t i = 0, n = price.size(); i < n; ++i) {
+            sum += price[i] * quantity[i];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+BENCHMARK(BM_two_columns_rows)->Arg(1 << 12)->Arg(1 << 20);
+BENCHMARK(BM_two_columns_select)->Arg(1 << 12)->Arg(1 << 20);
+BENCHMARK(BM_two_columns_column)->Arg(1 << 12)->Arg(1 << 20);
+
+BENCHMARK_MAIN();
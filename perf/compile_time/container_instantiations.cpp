@@ -0,0 +1,168 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// Instantiates BOOST_STL_INTERFACES_CT_N distinct static_vector-like
+// container types, and exercises most of the members that container_interface
+// provides for each.  This file is only ever compiled by measure.cmake, to
+// measure compile time.
+
+#include <boost/stl_interfaces/container_interface.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <utility>
+
+
+#ifndef BOOST_STL_INTERFACES_CT_N
+#define BOOST_STL_INTERFACES_CT_N 100
+#endif
+
+#if defined(BOOST_STL_INTERFACES_CT_USE_V2)
+template<typename Derived, bool Contiguous>
+using container_interface =
+    boost::stl_interfaces::v2::container_interface<Derived>;
+#else
+template<typename Derived, bool Contiguous>
+using container_interface =
+    boost::stl_interfaces::v1::container_interface<Derived, Contiguous>;
+#endif
+
+template<int I>
+struct ct_vector
+    : container_interface<ct_vector<I>, boost::stl_interfaces::contiguous>
+{
+    using value_type = int;
+    using pointer = int *;
+    using const_pointer = int const *;
+    using reference = int &;
+    using const_reference = int const &;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using iterator = int *;
+    using const_iterator = int const *;
+    using reverse_iterator = boost::stl_interfaces::reverse_iterator<iterator>;
+    using const_reverse_iterator =
+        boost::stl_interfaces::reverse_iterator<const_iterator>;
+
+    ct_vector() noexcept : size_(0) {}
+    ct_vector(size_type n, int x) : size_(0) { this->assign(n, x); }
+    ct_vector(ct_vector const & other) : size_(0)
+    {
+        this->assign(other.begin(), other.end());
+    }
+    ct_vector & operator=(ct_vector const & other)
+    {
+        this->assign(other.begin(), other.end());
+        return *this;
+    }
+
+    iterator begin() noexcept { return buf_; }
+    iterator end() noexcept { return buf_ + size_; }
+
+    size_type max_size() const noexcept { return 16; }
+    size_type capacity() const noexcept { return 16; }
+
+    void resize(size_type sz, int x) noexcept
+    {
+        if (size_ < sz)
+            std::fill(end(), begin() + sz, x);
+        size_ = sz;
+    }
+
+    template<typename... Args>
+    reference emplace_back(Args &&... args)
+    {
+        return *emplace(end(), std::forward<Args>(args)...);
+    }
+    template<typename... Args>
+    iterator emplace(const_iterator pos, Args &&... args)
+    {
+        auto position = const_cast<int *>(pos);
+        std::move_backward(position, end(), end() + 1);
+        *position = int(std::forward<Args>(args)...);
+        ++size_;
+        return position;
+    }
+    template<
+        typename ForwardIterator,
+        typename Enable = std::enable_if_t<std::is_convertible<
+            typename std::iterator_traits<ForwardIterator>::iterator_category,
+            std::forward_iterator_tag>::value>>
+    iterator
+    insert(const_iterator pos, ForwardIterator first, ForwardIterator last)
+    {
+        auto position = const_cast<int *>(pos);
+        auto const insertions = std::distance(first, last);
+        std::move_backward(position, end(), end() + insertions);
+        std::copy(first, last, position);
+        size_ += insertions;
+        return position;
+    }
+    iterator erase(const_iterator f, const_iterator l)
+    {
+        auto first = const_cast<int *>(f);
+        auto last = const_cast<int *>(l);
+        std::move(last, end(), first);
+        size_ -= last - first;
+        return first;
+    }
+    void swap(ct_vector & other)
+    {
+        std::swap(buf_, other.buf_);
+        std::swap(size_, other.size_);
+    }
+
+    using base_type =
+        container_interface<ct_vector<I>, boost::stl_interfaces::contiguous>;
+    using base_type::begin;
+    using base_type::end;
+    using base_type::resize;
+    using base_type::insert;
+    using base_type::erase;
+
+private:
+    int buf_[16];
+    size_type size_;
+};
+
+template<int I>
+int exercise()
+{
+    ct_vector<I> v(2, I);
+    ct_vector<I> const & cv = v;
+    v.push_back(I);
+    v.insert(v.begin(), 2, I);
+    v.insert(v.begin(), {1, 2});
+    v.erase(v.begin());
+    v.assign(3, I);
+    v.assign({1, 2, 3});
+    v.resize(4);
+    v.pop_back();
+    int retval = v.front() + v.back() + v.at(0) + v[1] + *v.data() +
+                 cv.front() + cv.back() + cv.at(0) + cv[1] + *cv.data() +
+                 *v.rbegin() + *cv.crbegin() + *v.cbegin() + int(v.size()) +
+                 int(v.empty());
+    retval += (v == cv) + (v != cv) + (v < cv) + (v <= cv) + (v > cv) +
+              (v >= cv);
+    swap(v, v);
+    v.clear();
+    return retval;
+}
+
+template<std::size_t... Is>
+int exercise_all(std::index_sequence<Is...>)
+{
+    int retval = 0;
+    int dummy[] = {(retval += exercise<int(Is)>())...};
+    (void)dummy;
+    return retval;
+}
+
+int main()
+{
+    return exercise_all(std::make_index_sequence<BOOST_STL_INTERFACES_CT_N>{});
+}
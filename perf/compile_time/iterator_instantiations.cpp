@@ -0,0 +1,94 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// Instantiates BOOST_STL_INTERFACES_CT_N distinct proxy iterator types, and
+// exercises all the operations that iterator_interface provides for each.
+// This file is only ever compiled by measure.cmake, to measure compile time.
+
+#include <boost/stl_interfaces/iterator_interface.hpp>
+
+#include <tuple>
+#include <utility>
+
+
+#ifndef BOOST_STL_INTERFACES_CT_N
+#define BOOST_STL_INTERFACES_CT_N 100
+#endif
+
+#if defined(BOOST_STL_INTERFACES_CT_USE_V2)
+namespace iface = boost::stl_interfaces::v2;
+#else
+namespace iface = boost::stl_interfaces::v1;
+#endif
+
+template<int I>
+struct ct_zip_iter : iface::proxy_iterator_interface<
+                         ct_zip_iter<I>,
+                         std::random_access_iterator_tag,
+                         std::tuple<int, int>,
+                         std::tuple<int &, int &>>
+{
+    ct_zip_iter() noexcept : it1_(), it2_() {}
+    ct_zip_iter(int * it1, int * it2) noexcept : it1_(it1), it2_(it2) {}
+
+    std::tuple<int &, int &> operator*() const noexcept
+    {
+        return std::tuple<int &, int &>{*it1_, *it2_};
+    }
+    ct_zip_iter & operator+=(std::ptrdiff_t i) noexcept
+    {
+        it1_ += i;
+        it2_ += i;
+        return *this;
+    }
+    friend std::ptrdiff_t operator-(ct_zip_iter lhs, ct_zip_iter rhs) noexcept
+    {
+        return lhs.it1_ - rhs.it1_;
+    }
+
+private:
+    int * it1_;
+    int * it2_;
+};
+
+template<int I>
+int exercise(int * a, int * b)
+{
+    ct_zip_iter<I> first(a, b);
+    ct_zip_iter<I> last(a + 4, b + 4);
+    auto it = first;
+    ++it;
+    it++;
+    --it;
+    it--;
+    it += 2;
+    it -= 1;
+    it = it + 1;
+    it = 1 + it;
+    it = it - 1;
+    int retval = std::get<0>(*it) + std::get<0>(it[1]) +
+                 std::get<1>(*it.operator->().operator->()) + int(last - first);
+    retval += (first == last) + (first != last) + (first < last) +
+              (first <= last) + (first > last) + (first >= last);
+    return retval;
+}
+
+template<std::size_t... Is>
+int exercise_all(int * a, int * b, std::index_sequence<Is...>)
+{
+    int retval = 0;
+    int dummy[] = {(retval += exercise<int(Is)>(a, b))...};
+    (void)dummy;
+    return retval;
+}
+
+int main()
+{
+    int a[8] = {0};
+    int b[8] = {0};
+    return exercise_all(
+        a, b, std::make_index_sequence<BOOST_STL_INTERFACES_CT_N>{});
+}
@@ -0,0 +1,120 @@
+# Usage:
+#
+#     cmake -DCXX=<compiler> -DSOURCE_DIR=<dir> -DOUTPUT=<file.csv>
+#           -DLIB_INCLUDE=<dir> -DBOOST_INCLUDE=<dir>
+#           [-DCMCSTL2_INCLUDE=<dir>] [-DCOUNTS=<n>[,<n>...]]
+#           [-DVARIANTS=<variant>[,<variant>...]] -P measure.cmake
+#
+# Compiles each of the *_instantiations.cpp files in SOURCE_DIR with
+# -fsyntax-only -ftime-report, once for each variant and each type count in
+# COUNTS, and reports the front-end wall time and peak GC memory reported by
+# the compiler.  The results are printed, and written to OUTPUT as CSV.
+#
+# The variants are v1 (C++14), v1_pch (C++14, with the headers that the
+# USE_PCH option precompiles included from a precompiled header; GCC and Clang
+# only), v2 (C++20 concepts), concepts_ts (C++17 plus -fconcepts, using the
+# concept emulation in detail/concepts.hpp; GCC only), and cmcstl2 (C++17 plus
+# cmcstl2; only measured if CMCSTL2_INCLUDE is given).  A variant that does not compile is reported as
+# such, rather than stopping the measurement.  The time taken to build the
+# precompiled header is not included in the v1_pch times.
+
+foreach(var CXX SOURCE_DIR OUTPUT LIB_INCLUDE BOOST_INCLUDE)
+    if (NOT DEFINED ${var})
+        message(FATAL_ERROR "measure.cmake requires -D${var}=...")
+    endif ()
+endforeach()
+if (NOT DEFINED COUNTS)
+    set(COUNTS 50,100,200)
+endif ()
+if (NOT DEFINED VARIANTS)
+    set(VARIANTS v1,v1_pch,v2,concepts_ts,cmcstl2)
+endif ()
+string(REPLACE "," ";" COUNTS "${COUNTS}")
+string(REPLACE "," ";" VARIANTS "${VARIANTS}")
+
+file(GLOB sources ${SOURCE_DIR}/*_instantiations.cpp)
+
+# The headers precompiled by the USE_PCH option in the top-level
+# CMakeLists.txt.
+get_filename_component(output_dir ${OUTPUT} DIRECTORY)
+set(pch_header ${output_dir}/compile_time_pch/stl_interfaces_pch.hpp)
+set(pch_contents "")
+foreach(header fwd iterator_interface reverse_iterator view_interface
+        container_interface)
+    string(APPEND pch_contents
+        "#include <boost/stl_interfaces/${header}.hpp>\n")
+endforeach()
+file(WRITE ${pch_header} "${pch_contents}")
+set(pch_built false)
+
+set(csv "source,variant,count,status,wall_seconds,memory\n")
+foreach(source ${sources})
+    get_filename_component(source_name ${source} NAME_WE)
+    foreach(variant ${VARIANTS})
+        set(flags -I${LIB_INCLUDE} -I${BOOST_INCLUDE})
+        if (variant STREQUAL "v1")
+            list(APPEND flags -std=c++14)
+        elseif (variant STREQUAL "v1_pch")
+            list(APPEND flags -std=c++14)
+            if (NOT pch_built)
+                execute_process(
+                    COMMAND ${CXX} ${flags} -x c++-header ${pch_header}
+                        -o ${pch_header}.gch
+                    RESULT_VARIABLE result
+                )
+                if (NOT result EQUAL 0)
+                    message(FATAL_ERROR "Could not build ${pch_header}.gch.")
+                endif ()
+                set(pch_built true)
+            endif ()
+            list(APPEND flags -include ${pch_header} -Winvalid-pch)
+        elseif (variant STREQUAL "v2")
+            list(APPEND flags -std=c++20 -DBOOST_STL_INTERFACES_CT_USE_V2)
+        elseif (variant STREQUAL "concepts_ts")
+            list(APPEND flags -std=c++17 -fconcepts
+                -DBOOST_STL_INTERFACES_DISABLE_CMCSTL2
+                -DBOOST_STL_INTERFACES_CT_USE_V2)
+        elseif (variant STREQUAL "cmcstl2")
+            if (NOT DEFINED CMCSTL2_INCLUDE OR CMCSTL2_INCLUDE STREQUAL "")
+                message(STATUS "${source_name} ${variant}: skipped (no cmcstl2)")
+                continue()
+            endif ()
+            list(APPEND flags -std=c++17 -I${CMCSTL2_INCLUDE}
+                -DBOOST_STL_INTERFACES_CT_USE_V2)
+        else ()
+            message(FATAL_ERROR "Unknown variant ${variant}.")
+        endif ()
+
+        foreach(count ${COUNTS})
+            execute_process(
+                COMMAND ${CXX} ${flags} -fsyntax-only -ftime-report
+                    -DBOOST_STL_INTERFACES_CT_N=${count} ${source}
+                RESULT_VARIABLE result
+                OUTPUT_VARIABLE report
+                ERROR_VARIABLE report
+            )
+            set(status ok)
+            set(wall "")
+            set(memory "")
+            if (NOT result EQUAL 0)
+                set(status failed)
+            elseif (report MATCHES
+                    "TOTAL *: *[0-9.]+ +[0-9.]+ +([0-9.]+) +([0-9]+[kMG]?)")
+                # GCC: usr, sys, wall, and GC memory.
+                set(wall ${CMAKE_MATCH_1})
+                set(memory ${CMAKE_MATCH_2})
+            elseif (report MATCHES "Total[^\n]*\n[^\n]*\n +([0-9.]+)")
+                # Clang: the first column of the first Total line is wall.
+                set(wall ${CMAKE_MATCH_1})
+            endif ()
+            message(STATUS
+                "${source_name} ${variant} N=${count}: "
+                "${status} wall=${wall}s memory=${memory}")
+            string(APPEND csv
+                "${source_name},${variant},${count},${status},${wall},${memory}\n")
+        endforeach()
+    endforeach()
+endforeach()
+
+file(WRITE ${OUTPUT} "${csv}")
+message(STATUS "Results written to ${OUTPUT}")
@@ -0,0 +1,112 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/concat_view.hpp>
+#include "bench_data.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+
+// These benchmarks query a live buffer and three spilled ones, of 64K ints
+// in all: by copying them into one vector first, by walking a concat_view
+// with the std algorithms, and with the segmented_*() algorithms, which
+// run over each buffer with its own iterators.
+
+struct buffers
+{
+    buffers()
+    {
+        auto const ints = bench_data::random_ints(1 << 16, 1000);
+        auto it = ints.begin();
+        for (auto size : {1 << 12, 1 << 14, 1 << 15, 1 << 12}) {
+            pieces_.emplace_back(it, it + size);
+            it += size;
+        }
+        pieces_.back().back() = -1;
+    }
+
+    auto view() const
+    {
+        return boost::stl_interfaces::make_concat_view(
+            pieces_[0], pieces_[1], pieces_[2], pieces_[3]);
+    }
+
+    std::vector<std::vector<int>> pieces_;
+};
+
+buffers const bufs;
+
+void BM_copy_then_accumulate(benchmark::State & state)
+{
+    for (auto _ : state) {
+        std::vector<int> all;
+        for (auto const & piece : bufs.pieces_) {
+            all.insert(all.end(), piece.begin(), piece.end());
+        }
+        long const sum = std::accumulate(all.begin(), all.end(), 0l);
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+void BM_concat_accumulate(benchmark::State & state)
+{
+    auto const v = bufs.view();
+    for (auto _ : state) {
+        long const sum = std::accumulate(v.begin(), v.end(), 0l);
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+void BM_concat_segmented_accumulate(benchmark::State & state)
+{
+    auto const v = bufs.view();
+    for (auto _ : state) {
+        long const sum = boost::stl_interfaces::segmented_accumulate(
+            v.begin(), v.end(), 0l);
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+void BM_concat_find(benchmark::State & state)
+{
+    auto const v = bufs.view();
+    for (auto _ : state) {
+        auto const it = std::find(v.begin(), v.end(), -1);
+        benchmark::DoNotOptimize(it);
+    }
+}
+
+void BM_concat_segmented_find(benchmark::State & state)
+{
+    auto const v = bufs.view();
+    for (auto _ : state) {
+        auto const it =
+            boost::stl_interfaces::segmented_find(v.begin(), v.end(), -1);
+        benchmark::DoNotOptimize(it);
+    }
+}
+
+void BM_concat_segmented_copy(benchmark::State & state)
+{
+    auto const v = bufs.view();
+    std::vector<int> out(1 << 16);
+    for (auto _ : state) {
+        boost::stl_interfaces::segmented_copy(v.begin(), v.end(), out.begin());
+        benchmark::ClobberMemory();
+    }
+}
+
+BENCHMARK(BM_copy_then_accumulate);
+BENCHMARK(BM_concat_accumulate);
+BENCHMARK(BM_concat_segmented_accumulate);
+BENCHMARK(BM_concat_find);
+BENCHMARK(BM_concat_segmented_find);
+BENCHMARK(BM_concat_segmented_copy);
+
+BENCHMARK_MAIN();
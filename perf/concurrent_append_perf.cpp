@@ -0,0 +1,97 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/concurrent_append_vector.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <mutex>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+
+// These benchmarks have state.range(0) threads append 1M ints in all, as
+// logging threads do: to a std::vector behind a std::mutex, and to a
+// concurrent_append_vector.  They also sum the concurrent_append_vector's
+// elements on one thread, through its iterators, which find each element's
+// bucket with a clz, and with segmented_accumulate().
+
+constexpr int total = 1 << 20;
+
+template<typename Append>
+void append_on_threads(int threads, Append append)
+{
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([=] {
+            for (int i = t; i < total; i += threads) {
+                append(i);
+            }
+        });
+    }
+    for (auto & w : workers) {
+        w.join();
+    }
+}
+
+void BM_mutex_vector(benchmark::State & state)
+{
+    for (auto _ : state) {
+        std::vector<int> v;
+        std::mutex mutex;
+        append_on_threads(int(state.range(0)), [&](int i) {
+            std::lock_guard<std::mutex> lock(mutex);
+            v.push_back(i);
+        });
+        benchmark::DoNotOptimize(v.data());
+    }
+}
+void BM_concurrent_append_vector(benchmark::State & state)
+{
+    for (auto _ : state) {
+        boost::stl_interfaces::concurrent_append_vector<int> v;
+        append_on_threads(
+            int(state.range(0)), [&](int i) { v.push_back(i); });
+        benchmark::DoNotOptimize(v.size());
+    }
+}
+
+void BM_accumulate(benchmark::State & state)
+{
+    boost::stl_interfaces::concurrent_append_vector<int> v;
+    for (int i = 0; i < total; ++i) {
+        v.push_back(i);
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::accumulate(v.begin(), v.end(), 0L));
+    }
+}
+void BM_segmented_accumulate(benchmark::State & state)
+{
+    boost::stl_interfaces::concurrent_append_vector<int> v;
+    for (int i = 0; i < total; ++i) {
+        v.push_back(i);
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(boost::stl_interfaces::segmented_accumulate(
+            v.begin(), v.end(), 0L));
+    }
+}
+
+BENCHMARK(BM_mutex_vector)
+    ->Arg(1)
+    ->Arg(4)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK(BM_concurrent_append_vector)
+    ->Arg(1)
+    ->Arg(4)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK(BM_accumulate)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_segmented_accumulate)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
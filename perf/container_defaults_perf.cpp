@@ -0,0 +1,283 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/small_vector.hpp>
+
+#include "../example/static_vector.hpp"
+#include "bench_data.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+
+using boost::stl_interfaces::small_vector;
+
+
+// These benchmarks time the members that container_interface synthesizes
+// from a container's few primitives -- assign(), insert(pos, n, x),
+// insert(pos, il), erase(pos), clear(), resize(n), and the comparisons --
+// against std::vector's own implementations of them.  The containers are
+// the example static_vector, whose elements are inside it, and the example
+// small_vector with an inline capacity of 1, which is a heap vector for all
+// the sizes here.  Each vector holds state.range(0) ints.
+
+constexpr std::size_t capacity = 1 << 16;
+using static_vec = static_vector<int, capacity>;
+using heap_vec = small_vector<int, 1>;
+using std_vec = std::vector<int>;
+
+template<typename Vec>
+std::unique_ptr<Vec> make_vec(std::ptrdiff_t n)
+{
+    auto const ints = bench_data::random_ints(n, 1 << 20);
+    return std::make_unique<Vec>(ints.begin(), ints.end());
+}
+
+template<typename Vec>
+void BM_assign_range(benchmark::State & state)
+{
+    auto const ints = bench_data::random_ints(state.range(0), 1 << 20, 2);
+    auto v = make_vec<Vec>(state.range(0) / 2);
+    for (auto _ : state) {
+        v->assign(ints.data(), ints.data() + ints.size());
+        benchmark::ClobberMemory();
+    }
+}
+
+template<typename Vec>
+void BM_assign_fill(benchmark::State & state)
+{
+    auto v = make_vec<Vec>(state.range(0) / 2);
+    for (auto _ : state) {
+        v->assign(std::size_t(state.range(0)), 42);
+        benchmark::ClobberMemory();
+    }
+}
+
+// Inserts 8 copies of a value into the middle, and erases them again.
+template<typename Vec>
+void BM_insert_fill(benchmark::State & state)
+{
+    auto v = make_vec<Vec>(state.range(0));
+    for (auto _ : state) {
+        auto const pos = v->begin() + v->size() / 2;
+        v->insert(pos, 8, 42);
+        v->erase(v->begin() + v->size() / 2, v->begin() + v->size() / 2 + 8);
+        benchmark::ClobberMemory();
+    }
+}
+
+// Inserts an initializer_list of 4 values into the middle, and erases them
+// again.
+template<typename Vec>
+void BM_insert_il(benchmark::State & state)
+{
+    auto v = make_vec<Vec>(state.range(0));
+    for (auto _ : state) {
+        auto const pos = v->begin() + v->size() / 2;
+        v->insert(pos, {1, 2, 3, 4});
+        v->erase(v->begin() + v->size() / 2, v->begin() + v->size() / 2 + 4);
+        benchmark::ClobberMemory();
+    }
+}
+
+// Erases one element from the middle, and appends one to replace it.
+template<typename Vec>
+void BM_erase_pos(benchmark::State & state)
+{
+    auto v = make_vec<Vec>(state.range(0));
+    for (auto _ : state) {
+        v->erase(v->begin() + v->size() / 2);
+        v->push_back(42);
+        benchmark::ClobberMemory();
+    }
+}
+
+template<typename Vec>
+void BM_clear_resize(benchmark::State & state)
+{
+    auto v = make_vec<Vec>(state.range(0));
+    for (auto _ : state) {
+        v->clear();
+        v->resize(state.range(0));
+        benchmark::ClobberMemory();
+    }
+}
+
+// Grows by half with value-initialized elements, and shrinks back.
+template<typename Vec>
+void BM_resize(benchmark::State & state)
+{
+    auto v = make_vec<Vec>(state.range(0) / 2);
+    for (auto _ : state) {
+        v->resize(state.range(0));
+        v->resize(state.range(0) / 2);
+        benchmark::ClobberMemory();
+    }
+}
+
+// Compares two vectors that differ only in their last element.
+template<typename Vec, bool Less>
+void BM_compare(benchmark::State & state)
+{
+    auto const lhs = make_vec<Vec>(state.range(0));
+    auto const rhs = make_vec<Vec>(state.range(0));
+    rhs->back() += 1;
+    for (auto _ : state) {
+        bool const result = Less ? *lhs < *rhs : *lhs == *rhs;
+        benchmark::DoNotOptimize(result);
+    }
+}
+
+// Cancels the elements that are multiples of 16 -- about 1 in 16, at
+// random positions -- after refilling the vector; the refill is the same
+// for each.
+auto const cancelled = [](int x) { return x % 16 == 0; };
+
+template<typename Vec>
+void BM_cancel_erase_pos(benchmark::State & state)
+{
+    auto const ints = bench_data::random_ints(state.range(0), 1 << 20);
+    Vec v;
+    for (auto _ : state) {
+        v.assign(ints.begin(), ints.end());
+        for (auto it = v.begin(); it != v.end();) {
+            if (cancelled(*it))
+                it = v.erase(it);
+            else
+                ++it;
+        }
+        benchmark::ClobberMemory();
+    }
+}
+template<typename Vec>
+void BM_cancel_erase_if(benchmark::State & state)
+{
+    auto const ints = bench_data::random_ints(state.range(0), 1 << 20);
+    Vec v;
+    for (auto _ : state) {
+        v.assign(ints.begin(), ints.end());
+        v.erase_if(cancelled);
+        benchmark::ClobberMemory();
+    }
+}
+template<typename Vec>
+void BM_cancel_erase_indices(benchmark::State & state)
+{
+    auto const ints = bench_data::random_ints(state.range(0), 1 << 20);
+    std::vector<std::size_t> indices;
+    for (std::size_t i = 0; i < ints.size(); ++i) {
+        if (cancelled(ints[i]))
+            indices.push_back(i);
+    }
+    Vec v;
+    for (auto _ : state) {
+        v.assign(ints.begin(), ints.end());
+        v.erase_indices(indices);
+        benchmark::ClobberMemory();
+    }
+}
+void BM_cancel_std_remove_if(benchmark::State & state)
+{
+    auto const ints = bench_data::random_ints(state.range(0), 1 << 20);
+    std_vec v;
+    for (auto _ : state) {
+        v.assign(ints.begin(), ints.end());
+        v.erase(std::remove_if(v.begin(), v.end(), cancelled), v.end());
+        benchmark::ClobberMemory();
+    }
+}
+
+// Loads state.range(0) keys into a sorted vector, in sorted batches of 1K:
+// one binary search and insert() per key, or one insert_sorted() per
+// batch.
+std::vector<std::vector<int>> sorted_batches(std::ptrdiff_t n)
+{
+    auto const ints = bench_data::random_ints(n, 1 << 20);
+    std::vector<std::vector<int>> retval;
+    for (std::ptrdiff_t i = 0; i < n; i += 1024) {
+        retval.emplace_back(
+            ints.begin() + i, ints.begin() + std::min(n, i + 1024));
+        std::sort(retval.back().begin(), retval.back().end());
+    }
+    return retval;
+}
+void BM_sorted_load_one_by_one(benchmark::State & state)
+{
+    auto const batches = sorted_batches(state.range(0));
+    for (auto _ : state) {
+        heap_vec v;
+        for (auto const & batch : batches) {
+            for (int x : batch) {
+                v.insert(std::upper_bound(v.begin(), v.end(), x), x);
+            }
+        }
+        benchmark::DoNotOptimize(v.data());
+    }
+}
+void BM_sorted_load_insert_sorted(benchmark::State & state)
+{
+    auto const batches = sorted_batches(state.range(0));
+    for (auto _ : state) {
+        heap_vec v;
+        for (auto const & batch : batches) {
+            v.insert_sorted(batch.begin(), batch.end());
+        }
+        benchmark::DoNotOptimize(v.data());
+    }
+}
+
+#define BENCHMARK_VECS(bm)                                                     \
+    BENCHMARK_TEMPLATE(bm, static_vec)->RangeMultiplier(16)->Range(16, 4096); \
+    BENCHMARK_TEMPLATE(bm, heap_vec)->RangeMultiplier(16)->Range(16, 4096);   \
+    BENCHMARK_TEMPLATE(bm, std_vec)->RangeMultiplier(16)->Range(16, 4096)
+
+BENCHMARK_VECS(BM_assign_range);
+BENCHMARK_VECS(BM_assign_fill);
+BENCHMARK_VECS(BM_insert_fill);
+BENCHMARK_VECS(BM_insert_il);
+BENCHMARK_VECS(BM_erase_pos);
+BENCHMARK_VECS(BM_clear_resize);
+BENCHMARK_VECS(BM_resize);
+
+BENCHMARK_TEMPLATE(BM_cancel_erase_pos, heap_vec)
+    ->RangeMultiplier(16)
+    ->Range(256, 1 << 16);
+BENCHMARK_TEMPLATE(BM_cancel_erase_if, heap_vec)
+    ->RangeMultiplier(16)
+    ->Range(256, 1 << 16);
+BENCHMARK_TEMPLATE(BM_cancel_erase_indices, heap_vec)
+    ->RangeMultiplier(16)
+    ->Range(256, 1 << 16);
+BENCHMARK(BM_cancel_std_remove_if)->RangeMultiplier(16)->Range(256, 1 << 16);
+
+BENCHMARK(BM_sorted_load_one_by_one)->RangeMultiplier(16)->Range(4096, 1 << 16);
+BENCHMARK(BM_sorted_load_insert_sorted)
+    ->RangeMultiplier(16)
+    ->Range(4096, 1 << 16);
+
+BENCHMARK_TEMPLATE(BM_compare, static_vec, false)
+    ->RangeMultiplier(16)
+    ->Range(16, 4096);
+BENCHMARK_TEMPLATE(BM_compare, heap_vec, false)
+    ->RangeMultiplier(16)
+    ->Range(16, 4096);
+BENCHMARK_TEMPLATE(BM_compare, std_vec, false)
+    ->RangeMultiplier(16)
+    ->Range(16, 4096);
+BENCHMARK_TEMPLATE(BM_compare, static_vec, true)
+    ->RangeMultiplier(16)
+    ->Range(16, 4096);
+BENCHMARK_TEMPLATE(BM_compare, heap_vec, true)
+    ->RangeMultiplier(16)
+    ->Range(16, 4096);
+BENCHMARK_TEMPLATE(BM_compare, std_vec, true)
+    ->RangeMultiplier(16)
+    ->Range(16, 4096);
+
+BENCHMARK_MAIN();
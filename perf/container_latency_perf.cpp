@@ -0,0 +1,145 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/small_vector.hpp>
+
+#include "../example/static_vector.hpp"
+#include "bench_data.hpp"
+#include "latency_histogram.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <vector>
+
+
+using boost::stl_interfaces::small_vector;
+
+
+// These benchmarks report tail latency rather than throughput.  Each drives
+// a container of ints through a mix of operations drawn at random --
+// push_back() 30% of the time, pop_back() 20%, insert() and erase() at a
+// random position 10% each, a read of a random element 29%, and assign(n,
+// x) 1% -- keeping its size between 0 and twice state.range(0), and times
+// every operation on its own.  The p50, p99, p99.9 and maximum of each kind
+// of operation are reported as user counters, in nanoseconds, so that the
+// occasional expensive operation that a mean hides -- the regrowth of a heap
+// vector, the whole-container copy of assign() -- shows up.  Every 64 *
+// state.range(0) operations the container is replaced with an empty one, as
+// a container that lives for one session, or one order book, is; otherwise
+// the vectors would stop regrowing once they had reached their largest size.
+//
+// Each time includes two reads of the clock, which BM_timer_floor measures
+// alone; times near its p50 are mostly clock.
+
+constexpr std::size_t capacity = 1 << 14;
+using static_vec = static_vector<int, capacity>;
+using small_vec = small_vector<int, 64>;
+using std_vec = std::vector<int>;
+
+enum op {
+    op_push_back,
+    op_pop_back,
+    op_insert,
+    op_erase,
+    op_read,
+    op_assign,
+    op_count
+};
+
+char const * const op_names[op_count] = {
+    "push_back", "pop_back", "insert", "erase", "read", "assign"};
+
+// The op to do next, mostly as drawn, but growing an empty container and
+// shrinking a full one.
+op next_op(bench_data::rng & gen, std::size_t size, std::size_t max)
+{
+    auto const r = gen.below(1000);
+    op const o = r < 300 ? op_push_back
+                 : r < 500 ? op_pop_back
+                 : r < 600 ? op_insert
+                 : r < 700 ? op_erase
+                 : r < 990 ? op_read
+                           : op_assign;
+    if (!size && (o == op_pop_back || o == op_erase || o == op_read))
+        return op_push_back;
+    if (size == max && (o == op_push_back || o == op_insert))
+        return op_pop_back;
+    return o;
+}
+
+template<typename Vec>
+void BM_mixed_latency(benchmark::State & state)
+{
+    std::size_t const n = state.range(0);
+    std::size_t const lifetime = 64 * n;
+    bench_data::rng gen(1);
+    latency_histogram::histogram histograms[op_count];
+    auto v = std::make_unique<Vec>();
+    std::size_t ops = 0;
+    int sum = 0;
+    for (auto _ : state) {
+        if (++ops == lifetime) {
+            v = std::make_unique<Vec>();
+            ops = 0;
+        }
+        auto const size = v->size();
+        auto const o = next_op(gen, size, 2 * n);
+        int const x = int(gen.below(1 << 20));
+        std::uint64_t ns = 0;
+        switch (o) {
+        case op_push_back:
+            ns = latency_histogram::time_ns([&] { v->push_back(x); });
+            break;
+        case op_pop_back:
+            ns = latency_histogram::time_ns([&] { v->pop_back(); });
+            break;
+        case op_insert: {
+            auto const i = gen.below(size + 1);
+            ns = latency_histogram::time_ns(
+                [&] { v->insert(v->begin() + i, x); });
+            break;
+        }
+        case op_erase: {
+            auto const i = gen.below(size);
+            ns = latency_histogram::time_ns([&] { v->erase(v->begin() + i); });
+            break;
+        }
+        case op_read: {
+            auto const i = gen.below(size);
+            ns = latency_histogram::time_ns([&] {
+                sum += (*v)[i];
+                benchmark::DoNotOptimize(sum);
+            });
+            break;
+        }
+        case op_assign:
+            ns = latency_histogram::time_ns([&] { v->assign(n, x); });
+            break;
+        default: break;
+        }
+        histograms[o].record(ns);
+        benchmark::ClobberMemory();
+    }
+    for (int i = 0; i < op_count; ++i) {
+        latency_histogram::report(state, op_names[i], histograms[i]);
+    }
+}
+
+void BM_timer_floor(benchmark::State & state)
+{
+    latency_histogram::histogram h;
+    for (auto _ : state) {
+        h.record(latency_histogram::time_ns([] {}));
+    }
+    latency_histogram::report(state, "empty", h);
+}
+
+BENCHMARK(BM_timer_floor);
+BENCHMARK_TEMPLATE(BM_mixed_latency, std_vec)->Arg(32)->Arg(1024);
+BENCHMARK_TEMPLATE(BM_mixed_latency, small_vec)->Arg(32)->Arg(1024);
+BENCHMARK_TEMPLATE(BM_mixed_latency, static_vec)->Arg(32)->Arg(1024);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,325 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include "../example/static_vector.hpp"
+#include <boost/stl_interfaces/static_vector.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <vector>
+
+
+// These benchmarks time the members that container_interface provides for
+// static_vector, the example contiguous container.
+
+// A random access iterator over int * that is not contiguous, so that
+// container_interface cannot use its bulk paths with it.
+struct ra_iter : boost::stl_interfaces::iterator_interface<
+                     ra_iter,
+                     std::random_access_iterator_tag,
+                     int>
+{
+    ra_iter() noexcept : it_(nullptr) {}
+    ra_iter(int * it) noexcept : it_(it) {}
+
+private:
+    friend boost::stl_interfaces::access;
+    int *& base_reference() noexcept { return it_; }
+    int * base_reference() const noexcept { return it_; }
+
+    int * it_;
+};
+
+constexpr std::size_t capacity = 1 << 16;
+using vec_type = static_vector<int, capacity>;
+
+std::vector<int> iota_ints(std::ptrdiff_t n)
+{
+    std::vector<int> retval(n);
+    std::iota(retval.begin(), retval.end(), 0);
+    return retval;
+}
+
+// Overwrites the existing elements of a full vector.
+template<typename Iter>
+void BM_assign_overwrite(benchmark::State & state)
+{
+    std::vector<int> ints = iota_ints(state.range(0));
+    auto v = std::make_unique<vec_type>(std::size_t(state.range(0)), 0);
+    for (auto _ : state) {
+        v->assign(Iter(ints.data()), Iter(ints.data() + ints.size()));
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(
+        state.iterations() * state.range(0) * int64_t(sizeof(int)));
+}
+
+// Assigns into an empty vector, as a message buffer that is reused does.
+template<typename Iter>
+void BM_clear_assign(benchmark::State & state)
+{
+    std::vector<int> ints = iota_ints(state.range(0));
+    auto v = std::make_unique<vec_type>();
+    for (auto _ : state) {
+        v->clear();
+        v->assign(Iter(ints.data()), Iter(ints.data() + ints.size()));
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(
+        state.iterations() * state.range(0) * int64_t(sizeof(int)));
+}
+
+// An owning handle with a non-trivial move constructor and destructor.  Only
+// handle<true> is declared trivially relocatable.
+template<bool Relocatable>
+struct handle
+{
+    explicit handle(int x) : p_(new int(x)) {}
+    handle(handle && other) noexcept : p_(other.p_) { other.p_ = nullptr; }
+    handle & operator=(handle && other) noexcept
+    {
+        std::swap(p_, other.p_);
+        return *this;
+    }
+    ~handle() { delete p_; }
+
+private:
+    int * p_;
+};
+
+namespace boost { namespace stl_interfaces {
+    template<>
+    struct is_trivially_relocatable<handle<true>> : std::true_type
+    {};
+}}
+
+// Inserts at, and then erases from, the front of a vector of handles, so
+// that every operation shifts all the elements.
+template<bool Relocatable>
+void BM_front_insert_erase(benchmark::State & state)
+{
+    using handle_vec = static_vector<handle<Relocatable>, 1 << 13>;
+    auto v = std::make_unique<handle_vec>();
+    for (int i = 0; i < state.range(0); ++i) {
+        v->emplace_back(i);
+    }
+    for (auto _ : state) {
+        v->emplace(v->begin(), 42);
+        v->erase(v->begin());
+        benchmark::ClobberMemory();
+    }
+}
+
+// Move-assigns a vector of handles back and forth.
+template<bool Relocatable>
+void BM_move_assign(benchmark::State & state)
+{
+    using handle_vec = static_vector<handle<Relocatable>, 1 << 13>;
+    auto v = std::make_unique<handle_vec>();
+    auto v2 = std::make_unique<handle_vec>();
+    for (int i = 0; i < state.range(0); ++i) {
+        v->emplace_back(i);
+    }
+    for (auto _ : state) {
+        *v2 = std::move(*v);
+        std::swap(v, v2);
+        benchmark::ClobberMemory();
+    }
+}
+
+// Swaps two vectors of handles of different sizes.
+template<bool Relocatable>
+void BM_swap(benchmark::State & state)
+{
+    using handle_vec = static_vector<handle<Relocatable>, 1 << 13>;
+    auto v = std::make_unique<handle_vec>();
+    auto v2 = std::make_unique<handle_vec>();
+    for (int i = 0; i < state.range(0); ++i) {
+        v->emplace_back(i);
+        if (i % 2)
+            v2->emplace_back(i);
+    }
+    for (auto _ : state) {
+        swap(*v, *v2);
+        benchmark::ClobberMemory();
+    }
+}
+
+// Grows an empty vector, as a receive buffer that is about to be overwritten
+// does, with value-initialization or default-initialization.
+template<bool ForOverwrite>
+void BM_grow(benchmark::State & state)
+{
+    auto v = std::make_unique<vec_type>();
+    for (auto _ : state) {
+        v->clear();
+        if (ForOverwrite)
+            v->resize_for_overwrite(state.range(0));
+        else
+            v->resize(state.range(0));
+        benchmark::DoNotOptimize(v->data());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(
+        state.iterations() * state.range(0) * int64_t(sizeof(int)));
+}
+
+// Inserts a few strings into the middle of a vector of strings, and erases
+// them again.  std::string is not trivially relocatable, so this exercises
+// the element-wise range insert.
+void BM_insert_middle_strings(benchmark::State & state)
+{
+    using string_vec = static_vector<std::string, 4096>;
+    auto v = std::make_unique<string_vec>();
+    for (int i = 0; i < state.range(0); ++i) {
+        v->emplace_back(std::to_string(i));
+    }
+    std::vector<std::string> const more(8, "inserted");
+    for (auto _ : state) {
+        auto const pos = v->begin() + v->size() / 2;
+        v->insert(pos, more.begin(), more.end());
+        v->erase(pos, pos + more.size());
+        benchmark::ClobberMemory();
+    }
+}
+
+// Fills an empty vector one element at a time, or all at once.
+enum class append_kind { push_back, unchecked_push_back, append_range };
+
+template<append_kind Kind>
+void BM_append(benchmark::State & state)
+{
+    std::vector<int> ints = iota_ints(state.range(0));
+    auto v = std::make_unique<vec_type>();
+    for (auto _ : state) {
+        v->clear();
+        if (Kind == append_kind::append_range) {
+            v->append_range(ints);
+        } else {
+            for (int x : ints) {
+                if (Kind == append_kind::push_back)
+                    v->push_back(x);
+                else
+                    v->unchecked_push_back(x);
+            }
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(
+        state.iterations() * state.range(0) * int64_t(sizeof(int)));
+}
+
+// Pads a byte buffer with n zeros, as insert(pos, n, x) does, either through
+// the container's own fill_insert() or through the range insert it replaced.
+template<bool FillInsert>
+void BM_fill_insert(benchmark::State & state)
+{
+    using bytes_type =
+        boost::stl_interfaces::static_vector<unsigned char, capacity>;
+    namespace detail = boost::stl_interfaces::detail;
+    std::size_t const n = state.range(0);
+    auto v = std::make_unique<bytes_type>();
+    unsigned char const x = 0;
+    for (auto _ : state) {
+        v->clear();
+        if (FillInsert) {
+            v->insert(v->end(), n, x);
+        } else {
+            v->insert(
+                v->end(),
+                detail::make_n_iter(x, n),
+                detail::make_n_iter_end(x, n));
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * int64_t(n));
+}
+
+// Compares two keys that differ only in their last element, as a lookup
+// does when it compares a key to its nearest neighbor.
+template<typename T, bool Less>
+void BM_compare(benchmark::State & state)
+{
+    using key_type = static_vector<T, 1024>;
+    std::vector<T> elements(state.range(0), T(3));
+    key_type const lhs(elements.begin(), elements.end());
+    elements.back() = T(4);
+    key_type const rhs(elements.begin(), elements.end());
+    for (auto _ : state) {
+        bool const result = Less ? lhs < rhs : lhs == rhs;
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetBytesProcessed(
+        state.iterations() * state.range(0) * int64_t(sizeof(T)));
+}
+
+BENCHMARK_TEMPLATE(BM_assign_overwrite, int *)
+    ->RangeMultiplier(16)
+    ->Range(1 << 4, 1 << 16);
+BENCHMARK_TEMPLATE(BM_assign_overwrite, ra_iter)
+    ->RangeMultiplier(16)
+    ->Range(1 << 4, 1 << 16);
+BENCHMARK_TEMPLATE(BM_clear_assign, int *)
+    ->RangeMultiplier(16)
+    ->Range(1 << 4, 1 << 16);
+BENCHMARK_TEMPLATE(BM_clear_assign, ra_iter)
+    ->RangeMultiplier(16)
+    ->Range(1 << 4, 1 << 16);
+
+BENCHMARK_TEMPLATE(BM_front_insert_erase, true)
+    ->RangeMultiplier(8)
+    ->Range(1 << 3, 1 << 12);
+BENCHMARK_TEMPLATE(BM_front_insert_erase, false)
+    ->RangeMultiplier(8)
+    ->Range(1 << 3, 1 << 12);
+BENCHMARK_TEMPLATE(BM_move_assign, true)
+    ->RangeMultiplier(8)
+    ->Range(1 << 3, 1 << 12);
+BENCHMARK_TEMPLATE(BM_move_assign, false)
+    ->RangeMultiplier(8)
+    ->Range(1 << 3, 1 << 12);
+
+BENCHMARK_TEMPLATE(BM_append, append_kind::push_back)
+    ->RangeMultiplier(16)
+    ->Range(1 << 4, 1 << 16);
+BENCHMARK_TEMPLATE(BM_append, append_kind::unchecked_push_back)
+    ->RangeMultiplier(16)
+    ->Range(1 << 4, 1 << 16);
+BENCHMARK_TEMPLATE(BM_append, append_kind::append_range)
+    ->RangeMultiplier(16)
+    ->Range(1 << 4, 1 << 16);
+
+BENCHMARK_TEMPLATE(BM_grow, false)->RangeMultiplier(16)->Range(1 << 4, 1 << 16);
+BENCHMARK_TEMPLATE(BM_grow, true)->RangeMultiplier(16)->Range(1 << 4, 1 << 16);
+
+BENCHMARK_TEMPLATE(BM_swap, true)->RangeMultiplier(8)->Range(1 << 3, 1 << 12);
+BENCHMARK_TEMPLATE(BM_swap, false)->RangeMultiplier(8)->Range(1 << 3, 1 << 12);
+BENCHMARK(BM_insert_middle_strings)->RangeMultiplier(8)->Range(1 << 3, 1 << 11);
+
+BENCHMARK_TEMPLATE(BM_fill_insert, false)
+    ->RangeMultiplier(16)
+    ->Range(1 << 4, 1 << 16);
+BENCHMARK_TEMPLATE(BM_fill_insert, true)
+    ->RangeMultiplier(16)
+    ->Range(1 << 4, 1 << 16);
+
+BENCHMARK_TEMPLATE(BM_compare, std::uint8_t, false)
+    ->RangeMultiplier(16)
+    ->Range(1 << 4, 1 << 10);
+BENCHMARK_TEMPLATE(BM_compare, std::uint8_t, true)
+    ->RangeMultiplier(16)
+    ->Range(1 << 4, 1 << 10);
+BENCHMARK_TEMPLATE(BM_compare, int, false)
+    ->RangeMultiplier(16)
+    ->Range(1 << 4, 1 << 10);
+BENCHMARK_TEMPLATE(BM_compare, int, true)
+    ->RangeMultiplier(16)
+    ->Range(1 << 4, 1 << 10);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,56 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/container_telemetry.hpp>
+#include <boost/stl_interfaces/small_vector.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+
+using boost::stl_interfaces::small_vector;
+
+
+// Each benchmark builds 1000 small vectors of ints, by two append_range()s
+// of 4 and of state.range(0) elements and a resize() back down to 2: in
+// BM_untraced, with no container_op_hooks; in BM_telemetry, with
+// container_telemetry_hooks counting every operation.
+
+using untraced_vec = small_vector<int, 8>;
+using traced_vec = small_vector<unsigned int, 8>;
+
+namespace boost { namespace stl_interfaces {
+    template<>
+    struct container_op_hooks<traced_vec>
+        : container_telemetry_hooks<traced_vec>
+    {
+    };
+}}
+
+template<typename Vec>
+void bench(benchmark::State & state)
+{
+    using value_type = typename Vec::value_type;
+    std::vector<value_type> const head(4, 1);
+    std::vector<value_type> const tail(state.range(0), 2);
+    for (auto _ : state) {
+        for (int i = 0; i < 1000; ++i) {
+            Vec v;
+            v.append_range(head);
+            v.append_range(tail);
+            v.resize(2);
+            benchmark::DoNotOptimize(v.data());
+        }
+    }
+}
+
+void BM_untraced(benchmark::State & state) { bench<untraced_vec>(state); }
+void BM_telemetry(benchmark::State & state) { bench<traced_vec>(state); }
+
+BENCHMARK(BM_untraced)->Arg(2)->Arg(64);
+BENCHMARK(BM_telemetry)->Arg(2)->Arg(64);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,76 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/counted_iterator.hpp>
+#include <boost/stl_interfaces/range_adaptor_closure.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <forward_list>
+#include <iterator>
+
+
+// These benchmarks sum the first half of the elements of a large singly
+// linked list, as a take(n) over a forward-only source does.
+
+std::forward_list<int> make_list()
+{
+    std::forward_list<int> retval;
+    for (int i = 0; i < (1 << 20); ++i) {
+        retval.push_front(i % 1000);
+    }
+    return retval;
+}
+
+std::forward_list<int> const list = make_list();
+std::ptrdiff_t const count = 1 << 19;
+
+// The end of the first n elements found first, so that they are an iterator
+// pair.
+void BM_next_then_pair(benchmark::State & state)
+{
+    for (auto _ : state) {
+        auto const last = std::next(list.begin(), count);
+        long sum = 0;
+        for (auto it = list.begin(); it != last; ++it) {
+            sum += *it;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+// take(n), whose iterators compare both their counts and their positions.
+void BM_take_view(benchmark::State & state)
+{
+    namespace bsi = boost::stl_interfaces;
+    for (auto _ : state) {
+        auto v = list | bsi::take(count);
+        long sum = 0;
+        for (auto x : v) {
+            sum += x;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+// A counted_view, which counts down to default_sentinel.
+void BM_counted_view(benchmark::State & state)
+{
+    namespace bsi = boost::stl_interfaces;
+    for (auto _ : state) {
+        auto const v = bsi::make_counted_view(list.begin(), count);
+        long sum = 0;
+        for (auto it = v.begin(); it != v.end(); ++it) {
+            sum += *it;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+BENCHMARK(BM_next_then_pair);
+BENCHMARK(BM_take_view);
+BENCHMARK(BM_counted_view);
+
+BENCHMARK_MAIN();
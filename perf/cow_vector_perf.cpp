@@ -0,0 +1,91 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/cow_vector.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <numeric>
+#include <string>
+#include <vector>
+
+
+// These benchmarks copy a message -- 16 strings of 40 characters, or 256
+// ints -- into new entries of 4 downstream queues, and have each queue's
+// consumer read it, as a message bus does: with the message in a
+// std::vector, and in a cow_vector, whose copies share its buffer.  A last
+// benchmark has every consumer change its copy, which the cow_vector then
+// copies after all.
+
+constexpr int queues = 4;
+
+template<typename Vector>
+Vector make_message(std::string *)
+{
+    return Vector(16, std::string(40, 'x'));
+}
+template<typename Vector>
+Vector make_message(int *)
+{
+    Vector retval(256, 0);
+    std::iota(retval.begin(), retval.end(), 0);
+    return retval;
+}
+
+template<typename Vector>
+std::size_t consume(Vector const & message)
+{
+    return message.size() + (message.empty() ? 0 : sizeof(message[0]));
+}
+
+template<typename Vector>
+void BM_fan_out(benchmark::State & state)
+{
+    using value_type = typename Vector::value_type;
+    Vector const message = make_message<Vector>((value_type *)nullptr);
+    std::vector<Vector> queue;
+    queue.reserve(queues);
+    for (auto _ : state) {
+        queue.clear();
+        for (int q = 0; q < queues; ++q) {
+            queue.push_back(message);
+        }
+        std::size_t sum = 0;
+        for (auto const & q : queue) {
+            sum += consume(q);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+template<typename Vector>
+void BM_fan_out_and_modify(benchmark::State & state)
+{
+    using value_type = typename Vector::value_type;
+    Vector const message = make_message<Vector>((value_type *)nullptr);
+    std::vector<Vector> queue;
+    queue.reserve(queues);
+    for (auto _ : state) {
+        queue.clear();
+        for (int q = 0; q < queues; ++q) {
+            queue.push_back(message);
+        }
+        for (auto & q : queue) {
+            q[0] = q[1];
+        }
+        benchmark::DoNotOptimize(queue.data());
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_fan_out, std::vector<std::string>);
+BENCHMARK_TEMPLATE(
+    BM_fan_out, boost::stl_interfaces::cow_vector<std::string>);
+BENCHMARK_TEMPLATE(BM_fan_out, std::vector<int>);
+BENCHMARK_TEMPLATE(BM_fan_out, boost::stl_interfaces::cow_vector<int>);
+BENCHMARK_TEMPLATE(BM_fan_out_and_modify, std::vector<std::string>);
+BENCHMARK_TEMPLATE(
+    BM_fan_out_and_modify, boost::stl_interfaces::cow_vector<std::string>);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,108 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/cycle_view.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+
+// These benchmarks fill a large buffer with a repeating pattern, as when
+// generating padding or test patterns.
+
+// The repeated_chars_iterator from the iterator tutorial, which computes
+// n_ % size_ on every dereference.
+struct repeated_chars_iterator : boost::stl_interfaces::iterator_interface<
+                                     repeated_chars_iterator,
+                                     std::random_access_iterator_tag,
+                                     char,
+                                     char>
+{
+    repeated_chars_iterator() noexcept : first_(nullptr), size_(0), n_(0) {}
+    repeated_chars_iterator(
+        char const * first, difference_type size, difference_type n) noexcept :
+        first_(first),
+        size_(size),
+        n_(n)
+    {}
+
+    char operator*() const noexcept { return first_[n_ % size_]; }
+    repeated_chars_iterator & operator+=(std::ptrdiff_t i) noexcept
+    {
+        n_ += i;
+        return *this;
+    }
+    auto operator-(repeated_chars_iterator other) const noexcept
+    {
+        return n_ - other.n_;
+    }
+
+private:
+    char const * first_;
+    difference_type size_;
+    difference_type n_;
+};
+
+std::string const pattern_3 = "abc";
+std::string const pattern_16 = "0123456789abcdef";
+int const output_size = 1 << 20;
+
+void fill_modulo(benchmark::State & state, std::string const & pattern)
+{
+    std::vector<char> out(output_size);
+    auto const size = std::ptrdiff_t(pattern.size());
+    for (auto _ : state) {
+        repeated_chars_iterator first(pattern.data(), size, 0);
+        repeated_chars_iterator last(pattern.data(), size, output_size);
+        std::copy(first, last, out.begin());
+        benchmark::DoNotOptimize(out.data());
+    }
+}
+
+template<typename View>
+void fill_cycle(benchmark::State & state, View const & v)
+{
+    std::vector<char> out(output_size);
+    for (auto _ : state) {
+        std::copy(v.begin(), v.end(), out.begin());
+        benchmark::DoNotOptimize(out.data());
+    }
+}
+
+void BM_fill_modulo_3(benchmark::State & state)
+{
+    fill_modulo(state, pattern_3);
+}
+void BM_fill_cycle_3(benchmark::State & state)
+{
+    fill_cycle(
+        state, boost::stl_interfaces::make_cycle_view(pattern_3, output_size));
+}
+void BM_fill_modulo_16(benchmark::State & state)
+{
+    fill_modulo(state, pattern_16);
+}
+void BM_fill_cycle_16(benchmark::State & state)
+{
+    fill_cycle(
+        state, boost::stl_interfaces::make_cycle_view(pattern_16, output_size));
+}
+void BM_fill_cycle_16_compile_time(benchmark::State & state)
+{
+    fill_cycle(
+        state,
+        boost::stl_interfaces::make_cycle_view<16>(pattern_16, output_size));
+}
+
+BENCHMARK(BM_fill_modulo_3);
+BENCHMARK(BM_fill_cycle_3);
+BENCHMARK(BM_fill_modulo_16);
+BENCHMARK(BM_fill_cycle_16);
+BENCHMARK(BM_fill_cycle_16_compile_time);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,151 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/d_ary_heap.hpp>
+#include "bench_data.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <functional>
+#include <queue>
+#include <vector>
+
+
+// These benchmarks use the heaps as timer queues: least deadline first,
+// with deadlines that are random ints.  The hold benchmark is the classic
+// priority-queue workload, in which each expired timer is rescheduled a
+// random time later, so that the queue stays the same size.  The delays are
+// as long as the spread of the initial deadlines, so a rescheduled timer
+// sinks deep into the heap.
+
+namespace bsi = boost::stl_interfaces;
+
+using std_queue =
+    std::priority_queue<int, std::vector<int>, std::greater<int>>;
+template<std::size_t D>
+using heap = bsi::d_ary_heap<int, D, std::greater<int>>;
+
+std::vector<int> const deadlines = bench_data::random_ints(1 << 20, 1 << 20);
+std::vector<int> const delays = bench_data::random_ints(1 << 16, 1 << 20, 2);
+
+template<typename Queue>
+Queue make_queue(std::size_t n)
+{
+    return Queue(deadlines.begin(), deadlines.begin() + n);
+}
+
+template<typename Queue>
+void reschedule(Queue & q, int delay)
+{
+    int const t = q.top();
+    q.pop();
+    q.push(t + delay);
+}
+template<std::size_t D>
+void reschedule(heap<D> & q, int delay)
+{
+    q.replace_top(q.top() + delay);
+}
+
+// Expires and reschedules 64K timers, in a queue of state.range(0).
+template<typename Queue>
+void hold(benchmark::State & state)
+{
+    auto const n = std::size_t(state.range(0));
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto q = make_queue<Queue>(n);
+        state.ResumeTiming();
+        for (int delay : delays) {
+            reschedule(q, delay);
+        }
+        benchmark::DoNotOptimize(q.top());
+    }
+}
+
+// The same, with a pop and a push for each reschedule in every queue.
+template<typename Queue>
+void hold_pop_push(benchmark::State & state)
+{
+    auto const n = std::size_t(state.range(0));
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto q = make_queue<Queue>(n);
+        state.ResumeTiming();
+        for (int delay : delays) {
+            int const t = q.top();
+            q.pop();
+            q.push(t + delay);
+        }
+        benchmark::DoNotOptimize(q.top());
+    }
+}
+
+// Builds a queue of state.range(0) timers one push at a time.
+template<typename Queue>
+void push_each(benchmark::State & state)
+{
+    auto const n = std::size_t(state.range(0));
+    for (auto _ : state) {
+        Queue q;
+        for (std::size_t i = 0; i < n; ++i) {
+            q.push(deadlines[i]);
+        }
+        benchmark::DoNotOptimize(q.top());
+    }
+}
+
+// Builds the same queue from the whole range at once.
+template<typename Queue>
+void push_range(benchmark::State & state)
+{
+    auto const n = std::size_t(state.range(0));
+    for (auto _ : state) {
+        auto q = make_queue<Queue>(n);
+        benchmark::DoNotOptimize(q.top());
+    }
+}
+
+void BM_hold_priority_queue(benchmark::State & state)
+{
+    hold<std_queue>(state);
+}
+void BM_hold_heap_2(benchmark::State & state) { hold<heap<2>>(state); }
+void BM_hold_heap_4(benchmark::State & state) { hold<heap<4>>(state); }
+void BM_hold_heap_8(benchmark::State & state) { hold<heap<8>>(state); }
+
+void BM_hold_pop_push_heap_4(benchmark::State & state)
+{
+    hold_pop_push<heap<4>>(state);
+}
+
+void BM_push_each_priority_queue(benchmark::State & state)
+{
+    push_each<std_queue>(state);
+}
+void BM_push_each_heap_4(benchmark::State & state)
+{
+    push_each<heap<4>>(state);
+}
+void BM_push_range_priority_queue(benchmark::State & state)
+{
+    push_range<std_queue>(state);
+}
+void BM_push_range_heap_4(benchmark::State & state)
+{
+    push_range<heap<4>>(state);
+}
+
+BENCHMARK(BM_hold_priority_queue)->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK(BM_hold_heap_2)->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK(BM_hold_heap_4)->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK(BM_hold_heap_8)->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK(BM_hold_pop_push_heap_4)->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK(BM_push_each_priority_queue)->Arg(1 << 20);
+BENCHMARK(BM_push_each_heap_4)->Arg(1 << 20);
+BENCHMARK(BM_push_range_priority_queue)->Arg(1 << 20);
+BENCHMARK(BM_push_range_heap_4)->Arg(1 << 20);
+
+BENCHMARK_MAIN();
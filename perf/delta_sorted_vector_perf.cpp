@@ -0,0 +1,114 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/delta_sorted_vector.hpp>
+#include "bench_data.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+
+// These benchmarks build a sorted index of 32K random ints one insertion
+// at a time, in a sorted std::vector, which moves every element after
+// each new one, and in a delta_sorted_vector.  The others read an index
+// of 1M ints, half a delta of insertions behind its last compaction: a
+// random lookup, and a sum over all of it.
+
+constexpr int inserts = 1 << 15;
+constexpr int index_size = 1 << 20;
+
+using dsv = boost::stl_interfaces::delta_sorted_vector<int>;
+
+void BM_insert_sorted_vector(benchmark::State & state)
+{
+    auto const values = bench_data::random_ints(inserts, 1 << 30, 1);
+    for (auto _ : state) {
+        std::vector<int> v;
+        for (int x : values) {
+            v.insert(std::upper_bound(v.begin(), v.end(), x), x);
+        }
+        benchmark::DoNotOptimize(v.data());
+    }
+}
+
+void BM_insert_delta_sorted_vector(benchmark::State & state)
+{
+    auto const values = bench_data::random_ints(inserts, 1 << 30, 1);
+    for (auto _ : state) {
+        dsv v;
+        for (int x : values) {
+            v.insert(x);
+        }
+        benchmark::DoNotOptimize(v.size());
+    }
+}
+
+std::vector<int> sorted_index()
+{
+    auto retval = bench_data::random_ints(index_size, 1 << 30, 2);
+    std::sort(retval.begin(), retval.end());
+    return retval;
+}
+
+dsv delta_index()
+{
+    auto const values = bench_data::random_ints(index_size, 1 << 30, 2);
+    dsv retval(values.begin(), values.end() - 512);
+    for (auto it = values.end() - 512; it != values.end(); ++it) {
+        retval.insert(*it);
+    }
+    return retval;
+}
+
+void BM_lookup_sorted_vector(benchmark::State & state)
+{
+    auto const v = sorted_index();
+    auto const keys = bench_data::random_ints(1 << 16, 1 << 30, 3);
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(*std::lower_bound(
+            v.begin(), v.end(), keys[i++ % keys.size()]));
+    }
+}
+
+void BM_lookup_delta_sorted_vector(benchmark::State & state)
+{
+    auto const v = delta_index();
+    auto const keys = bench_data::random_ints(1 << 16, 1 << 30, 3);
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(v.lower_bound(keys[i++ % keys.size()]));
+    }
+}
+
+void BM_sum_sorted_vector(benchmark::State & state)
+{
+    auto const v = sorted_index();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            std::accumulate(v.begin(), v.end(), 0ll));
+    }
+}
+
+void BM_sum_delta_sorted_vector(benchmark::State & state)
+{
+    auto const v = delta_index();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            std::accumulate(v.begin(), v.end(), 0ll));
+    }
+}
+
+BENCHMARK(BM_insert_sorted_vector)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_insert_delta_sorted_vector)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_lookup_sorted_vector);
+BENCHMARK(BM_lookup_delta_sorted_vector);
+BENCHMARK(BM_sum_sorted_vector)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_sum_delta_sorted_vector)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,97 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/double_buffer.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <mutex>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+
+// These benchmarks pass 256 batches of state.range(0) ints from a producer
+// thread, which fills each batch, to the benchmark's thread, which sums
+// it: through a std::vector behind a std::mutex, into which the producer
+// copies each batch and out of which the consumer copies it, and through a
+// double_buffer, whose buffers change roles without a copy.
+
+constexpr int batches = 256;
+
+void fill(std::vector<int> & batch, int n, int i)
+{
+    for (int j = 0; j < n; ++j) {
+        batch.push_back(i + j);
+    }
+}
+
+void BM_mutex_copy(benchmark::State & state)
+{
+    int const n = int(state.range(0));
+    for (auto _ : state) {
+        std::mutex m;
+        std::vector<int> shared;
+        bool full = false;
+        std::thread producer([&] {
+            std::vector<int> batch;
+            for (int i = 0; i < batches; ++i) {
+                batch.clear();
+                fill(batch, n, i);
+                for (;;) {
+                    std::lock_guard<std::mutex> lock(m);
+                    if (!full) {
+                        shared = batch;
+                        full = true;
+                        break;
+                    }
+                    std::this_thread::yield();
+                }
+            }
+        });
+        long long sum = 0;
+        std::vector<int> batch;
+        for (int i = 0; i < batches; ++i) {
+            for (;;) {
+                std::lock_guard<std::mutex> lock(m);
+                if (full) {
+                    batch = shared;
+                    full = false;
+                    break;
+                }
+                std::this_thread::yield();
+            }
+            sum += std::accumulate(batch.begin(), batch.end(), 0ll);
+        }
+        producer.join();
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+void BM_double_buffer(benchmark::State & state)
+{
+    int const n = int(state.range(0));
+    for (auto _ : state) {
+        boost::stl_interfaces::double_buffer<std::vector<int>> db;
+        std::thread producer([&] {
+            for (int i = 0; i < batches; ++i) {
+                fill(db.back_buffer(), n, i);
+                db.publish();
+            }
+        });
+        long long sum = 0;
+        for (int i = 0; i < batches; ++i) {
+            auto const batch = db.read();
+            sum += std::accumulate(batch.begin(), batch.end(), 0ll);
+        }
+        producer.join();
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+BENCHMARK(BM_mutex_copy)->Range(1 << 10, 1 << 16)->UseRealTime();
+BENCHMARK(BM_double_buffer)->Range(1 << 10, 1 << 16)->UseRealTime();
+
+BENCHMARK_MAIN();
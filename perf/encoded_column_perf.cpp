@@ -0,0 +1,194 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/encoded_column.hpp>
+
+#include "bench_data.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <numeric>
+#include <string>
+#include <vector>
+
+
+// These benchmarks compare 1M-element columns stored plainly with the same
+// columns dictionary-encoded or run-length-encoded.  Each reports the bytes
+// its column takes as the "bytes" counter.  The dictionary columns have 200
+// distinct values; the run-length-encoded column has runs of 1 to 127
+// elements.
+
+namespace bsi = boost::stl_interfaces;
+using bsi::dict_encoded_column;
+using bsi::dict_encoded_view;
+using bsi::rle_column;
+
+std::size_t const n = 1 << 20;
+
+std::vector<std::string> make_strings()
+{
+    auto const dictionary = bench_data::random_strings(200, 8, 22);
+    std::vector<std::string> retval;
+    for (int i : bench_data::random_ints(n, 200)) {
+        retval.push_back(dictionary[i]);
+    }
+    return retval;
+}
+std::vector<double> make_doubles()
+{
+    std::vector<double> retval;
+    for (int i : bench_data::random_ints(n, 200)) {
+        retval.push_back(i * 0.25);
+    }
+    return retval;
+}
+std::vector<int> make_runs()
+{
+    std::vector<int> retval;
+    auto const lengths = bench_data::random_ints(n, 127, 2);
+    auto const values = bench_data::random_ints(n, 1000, 3);
+    for (std::size_t i = 0; retval.size() < n; ++i) {
+        retval.insert(retval.end(), lengths[i] + 1, values[i]);
+    }
+    retval.resize(n);
+    return retval;
+}
+
+std::vector<std::string> const strings = make_strings();
+std::vector<double> const doubles = make_doubles();
+std::vector<int> const runs = make_runs();
+
+std::size_t plain_bytes(std::vector<std::string> const & v)
+{
+    std::size_t retval = v.size() * sizeof(std::string);
+    for (auto const & s : v) {
+        if (15 < s.size())
+            retval += s.capacity() + 1;
+    }
+    return retval;
+}
+template<typename T, typename Code>
+std::size_t dict_bytes(dict_encoded_view<T, Code> v)
+{
+    return v.size() * sizeof(Code) + v.dictionary_size() * sizeof(T);
+}
+
+// Counts the elements equal to one value.
+void BM_count_strings_plain(benchmark::State & state)
+{
+    auto const x = strings[17];
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::count(strings.begin(), strings.end(), x));
+    }
+    state.counters["bytes"] = double(plain_bytes(strings));
+}
+void BM_count_strings_dict(benchmark::State & state)
+{
+    dict_encoded_column<std::string, std::uint8_t> const column(
+        strings.begin(), strings.end());
+    auto const view = column.view();
+    auto const x = strings[17];
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(view.count(x));
+    }
+    state.counters["bytes"] = double(dict_bytes(view));
+}
+
+// Sums a column of doubles.
+void BM_sum_doubles_plain(benchmark::State & state)
+{
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            std::accumulate(doubles.begin(), doubles.end(), 0.0));
+    }
+    state.counters["bytes"] = double(n * sizeof(double));
+}
+// Through the decoding iterator.
+void BM_sum_doubles_dict_iterator(benchmark::State & state)
+{
+    dict_encoded_column<double, std::uint8_t> const column(
+        doubles.begin(), doubles.end());
+    auto const view = column.view();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            std::accumulate(view.begin(), view.end(), 0.0));
+    }
+    state.counters["bytes"] = double(dict_bytes(view));
+}
+// Through read_n(), a block at a time, into a buffer on the stack.
+void BM_sum_doubles_dict_read_n(benchmark::State & state)
+{
+    dict_encoded_column<double, std::uint8_t> const column(
+        doubles.begin(), doubles.end());
+    auto const view = column.view();
+    for (auto _ : state) {
+        double buf[256];
+        double sum = 0.0;
+        for (auto it = view.begin(); it != view.end(); it += 256) {
+            bsi::read_n(it, 256, buf);
+            sum = std::accumulate(buf, buf + 256, sum);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.counters["bytes"] = double(dict_bytes(view));
+}
+
+// Sums a column of ints with long runs.
+void BM_sum_runs_plain(benchmark::State & state)
+{
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::accumulate(runs.begin(), runs.end(), 0));
+    }
+    state.counters["bytes"] = double(n * sizeof(int));
+}
+void BM_sum_runs_rle_iterator(benchmark::State & state)
+{
+    rle_column<int> const column(runs.begin(), runs.end());
+    auto const view = column.view();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            std::accumulate(view.begin(), view.end(), 0));
+    }
+    state.counters["bytes"] = double(
+        view.run_count() * (sizeof(int) + sizeof(std::ptrdiff_t)));
+}
+// A run at a time, through run_iterators.
+void BM_sum_runs_rle_segmented(benchmark::State & state)
+{
+    rle_column<int> const column(runs.begin(), runs.end());
+    auto const view = column.view();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            bsi::segmented_accumulate(view.begin(), view.end(), 0));
+    }
+}
+// A multiply per run, using run_values() and run_ends().
+void BM_sum_runs_rle_runs(benchmark::State & state)
+{
+    rle_column<int> const column(runs.begin(), runs.end());
+    auto const view = column.view();
+    for (auto _ : state) {
+        int sum = 0;
+        std::ptrdiff_t first = 0;
+        for (std::ptrdiff_t r = 0; r < view.run_count(); ++r) {
+            auto const last = view.run_ends()[r];
+            sum += view.run_values()[r] * int(last - first);
+            first = last;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+BENCHMARK(BM_count_strings_plain);
+BENCHMARK(BM_count_strings_dict);
+BENCHMARK(BM_sum_doubles_plain);
+BENCHMARK(BM_sum_doubles_dict_iterator);
+BENCHMARK(BM_sum_doubles_dict_read_n);
+BENCHMARK(BM_sum_runs_plain);
+BENCHMARK(BM_sum_runs_rle_iterator);
+BENCHMARK(BM_sum_runs_rle_segmented);
+BENCHMARK(BM_sum_runs_rle_runs);
+
+BENCHMARK_MAIN();
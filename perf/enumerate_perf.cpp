@@ -0,0 +1,68 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/enumerate_view.hpp>
+#include "bench_data.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+
+// These benchmarks compute a position-weighted feature, the sum of i * x[i],
+// over 64K floats: with an iterator loop that keeps its own index beside
+// the iterator, with an index-only loop, and with an enumerate_view, whose
+// iterator computes each index from its position.
+
+std::vector<float> make_floats()
+{
+    auto const ints = bench_data::random_ints(1 << 16, 1000);
+    return std::vector<float>(ints.begin(), ints.end());
+}
+
+std::vector<float> const floats = make_floats();
+
+void BM_parallel_counter(benchmark::State & state)
+{
+    for (auto _ : state) {
+        float sum = 0;
+        std::ptrdiff_t i = 0;
+        for (auto it = floats.data(), last = it + floats.size(); it != last;
+             ++it, ++i) {
+            sum += float(i) * *it;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+void BM_index_loop(benchmark::State & state)
+{
+    for (auto _ : state) {
+        float sum = 0;
+        for (std::ptrdiff_t i = 0, n = floats.size(); i < n; ++i) {
+            sum += float(i) * floats[i];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+void BM_enumerate_view(benchmark::State & state)
+{
+    auto const v = boost::stl_interfaces::enumerate_view<float const *>(
+        floats.data(), floats.data() + floats.size());
+    for (auto _ : state) {
+        float sum = 0;
+        for (auto p : v) {
+            sum += float(p.first) * p.second;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+BENCHMARK(BM_parallel_counter);
+BENCHMARK(BM_index_loop);
+BENCHMARK(BM_enumerate_view);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,93 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/stl_interfaces/eytzinger_set.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <random>
+#include <set>
+#include <vector>
+
+
+using boost::stl_interfaces::eytzinger_set;
+
+
+// These benchmarks look up 1024 random keys in a set of state.range(0)
+// ints, with std::lower_bound() over a sorted vector, with std::set, and
+// with eytzinger_set.
+
+std::vector<int> keys(int n)
+{
+    std::vector<int> retval(n);
+    for (int i = 0; i < n; ++i) {
+        retval[i] = 2 * i;
+    }
+    return retval;
+}
+
+std::vector<int> lookups(int n)
+{
+    std::vector<int> retval(1024);
+    std::mt19937 gen(1);
+    std::uniform_int_distribution<int> dist(0, 2 * n);
+    std::generate(retval.begin(), retval.end(), [&] { return dist(gen); });
+    return retval;
+}
+
+void BM_sorted_vector(benchmark::State & state)
+{
+    auto const v = keys(state.range(0));
+    auto const xs = lookups(state.range(0));
+    for (auto _ : state) {
+        long sum = 0;
+        for (auto x : xs) {
+            auto const it = std::lower_bound(v.begin(), v.end(), x);
+            if (it != v.end())
+                sum += *it;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+void BM_std_set(benchmark::State & state)
+{
+    auto const v = keys(state.range(0));
+    std::set<int> const s(v.begin(), v.end());
+    auto const xs = lookups(state.range(0));
+    for (auto _ : state) {
+        long sum = 0;
+        for (auto x : xs) {
+            auto const it = s.lower_bound(x);
+            if (it != s.end())
+                sum += *it;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+void BM_eytzinger_set(benchmark::State & state)
+{
+    auto const v = keys(state.range(0));
+    eytzinger_set<int> const s(v.begin(), v.end());
+    auto const xs = lookups(state.range(0));
+    for (auto _ : state) {
+        long sum = 0;
+        for (auto x : xs) {
+            auto const it = s.lower_bound(x);
+            if (it != s.end())
+                sum += *it;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+BENCHMARK(BM_sorted_vector)->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_std_set)->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_eytzinger_set)->Range(1 << 10, 1 << 22);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,102 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/stl_interfaces/fd_input_iterator.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <numeric>
+#include <vector>
+
+#include <fcntl.h>
+
+
+using boost::stl_interfaces::fd_input_iterator;
+using boost::stl_interfaces::fd_reader;
+
+
+// These benchmarks sum a 64MB file of std::uint64_t records, which stays in
+// the page cache: read into a std::vector first, through
+// std::istreambuf_iterator-style stream reads of one element at a time,
+// through fd_input_iterator, and a block at a time through
+// fd_block_iterator.
+
+char const * const path = "fd_input_perf.bin";
+std::size_t const records = std::size_t(1) << 23;
+
+struct file
+{
+    file()
+    {
+        std::vector<std::uint64_t> v(records);
+        std::iota(v.begin(), v.end(), 0u);
+        std::ofstream ofs(path, std::ios::binary);
+        ofs.write(reinterpret_cast<char const *>(v.data()), v.size() * 8);
+    }
+    ~file() { std::remove(path); }
+};
+
+file const the_file;
+
+void BM_read_whole_file(benchmark::State & state)
+{
+    for (auto _ : state) {
+        std::ifstream ifs(path, std::ios::binary);
+        std::vector<std::uint64_t> v(records);
+        ifs.read(reinterpret_cast<char *>(v.data()), v.size() * 8);
+        benchmark::DoNotOptimize(
+            std::accumulate(v.begin(), v.end(), std::uint64_t(0)));
+    }
+}
+
+void BM_stream_reads(benchmark::State & state)
+{
+    for (auto _ : state) {
+        std::ifstream ifs(path, std::ios::binary);
+        std::uint64_t sum = 0;
+        std::uint64_t x;
+        while (ifs.read(reinterpret_cast<char *>(&x), 8)) {
+            sum += x;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+void BM_fd_input_iterator(benchmark::State & state)
+{
+    for (auto _ : state) {
+        int const fd = ::open(path, O_RDONLY);
+        fd_reader<std::uint64_t> reader(fd);
+        auto elements = reader.elements();
+        benchmark::DoNotOptimize(std::accumulate(
+            elements.begin(), elements.end(), std::uint64_t(0)));
+        ::close(fd);
+    }
+}
+
+void BM_fd_block_iterator(benchmark::State & state)
+{
+    for (auto _ : state) {
+        int const fd = ::open(path, O_RDONLY);
+        fd_reader<std::uint64_t> reader(fd);
+        std::uint64_t sum = 0;
+        for (auto block : reader.blocks()) {
+            sum = std::accumulate(block.begin(), block.end(), sum);
+        }
+        benchmark::DoNotOptimize(sum);
+        ::close(fd);
+    }
+}
+
+BENCHMARK(BM_read_whole_file)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_stream_reads)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_fd_input_iterator)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_fd_block_iterator)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,140 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/filter_view.hpp>
+#include <boost/stl_interfaces/reverse_iterator.hpp>
+#include "hw_counters.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+
+// These benchmarks sum the elements of a large array of telemetry samples
+// that exceed a threshold.  The benchmark argument is the percentage of the
+// samples that do.  Built with BENCH_HW_COUNTERS, they also report the
+// branch misses of each filter, which are what the percentage varies.
+
+std::vector<int> make_samples(int percent)
+{
+    std::mt19937 gen(percent);
+    std::uniform_int_distribution<int> dist(0, 99);
+    std::vector<int> retval(1 << 20);
+    for (auto & x : retval) {
+        x = dist(gen) < percent ? 100 : 0;
+    }
+    return retval;
+}
+
+int const threshold = 50;
+
+// The filtered_int_iterator from the iterator tutorial, which calls
+// std::find_if() for one element at a time.
+template<typename Pred>
+struct filtered_int_iterator : boost::stl_interfaces::iterator_interface<
+                                   filtered_int_iterator<Pred>,
+                                   std::bidirectional_iterator_tag,
+                                   int>
+{
+    filtered_int_iterator() : it_(nullptr) {}
+    filtered_int_iterator(int const * it, int const * last, Pred pred) :
+        it_(it),
+        last_(last),
+        pred_(std::move(pred))
+    {
+        it_ = std::find_if(it_, last_, pred_);
+    }
+
+    filtered_int_iterator & operator++()
+    {
+        it_ = std::find_if(std::next(it_), last_, pred_);
+        return *this;
+    }
+
+private:
+    friend boost::stl_interfaces::access;
+    constexpr int const *& base_reference() noexcept { return it_; }
+    constexpr int const * base_reference() const noexcept { return it_; }
+
+    int const * it_;
+    int const * last_;
+    Pred pred_;
+};
+
+void BM_scalar_filter(benchmark::State & state)
+{
+    auto const samples = make_samples(state.range(0));
+    auto const pred = [](int x) { return threshold < x; };
+    using iter = filtered_int_iterator<decltype(pred)>;
+    int const * const first = samples.data();
+    int const * const last = first + samples.size();
+    hw_counters::scope counters(state);
+    for (auto _ : state) {
+        long sum = 0;
+        for (iter it(first, last, pred), end(last, last, pred); it != end;
+             ++it) {
+            sum += *it;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+void BM_block_filter(benchmark::State & state)
+{
+    auto const samples = make_samples(state.range(0));
+    auto v = boost::stl_interfaces::make_filter_view(
+        samples, [](int x) { return threshold < x; });
+    hw_counters::scope counters(state);
+    for (auto _ : state) {
+        long sum = 0;
+        for (auto x : v) {
+            sum += x;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+// The same sum, latest sample first, through reverse_iterator, which
+// decrements the filter_iterator twice per element, or through
+// cached_reverse_iterator, which decrements it once.
+// (A lambda would make filter_iterator unassignable.)
+struct above_threshold
+{
+    bool operator()(int x) const { return threshold < x; }
+};
+
+template<bool Cached>
+void BM_reverse_filter(benchmark::State & state)
+{
+    auto const samples = make_samples(state.range(0));
+    above_threshold const pred;
+    using iter =
+        boost::stl_interfaces::filter_iterator<int const *, above_threshold>;
+    using rev_iter = std::conditional_t<
+        Cached,
+        boost::stl_interfaces::cached_reverse_iterator<iter>,
+        boost::stl_interfaces::reverse_iterator<iter>>;
+    int const * const first = samples.data();
+    int const * const last = first + samples.size();
+    rev_iter const rfirst(iter(last, last, pred));
+    rev_iter const rlast(iter(first, last, pred));
+    hw_counters::scope counters(state);
+    for (auto _ : state) {
+        long sum = 0;
+        for (auto it = rfirst; it != rlast; ++it) {
+            sum += *it;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+BENCHMARK(BM_scalar_filter)->Arg(1)->Arg(10)->Arg(50)->Arg(90);
+BENCHMARK_TEMPLATE(BM_reverse_filter, false)->Arg(1)->Arg(10)->Arg(50)->Arg(90);
+BENCHMARK_TEMPLATE(BM_reverse_filter, true)->Arg(1)->Arg(10)->Arg(50)->Arg(90);
+BENCHMARK(BM_block_filter)->Arg(1)->Arg(10)->Arg(50)->Arg(90);
+
+BENCHMARK_MAIN();
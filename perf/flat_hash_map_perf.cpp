@@ -0,0 +1,108 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/flat_hash_map.hpp>
+
+#include "bench_data.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <unordered_map>
+#include <vector>
+
+
+using boost::stl_interfaces::flat_hash_map;
+
+
+// These benchmarks compare flat_hash_map<int, int> with
+// std::unordered_map<int, int>: inserting 1M random keys; looking up 1M
+// keys, all present, or none; and summing the elements of a map of 1M keys
+// of which state.range(0) percent have then been erased.  The sparse
+// iteration is where skipping a group of slots at a time pays.
+
+constexpr int n = 1 << 20;
+
+std::vector<int> const keys = bench_data::random_ints(n, 1 << 30, 1);
+std::vector<int> const missing = bench_data::random_ints(n, 1 << 30, 2);
+
+template<typename Map>
+Map make_map()
+{
+    Map retval;
+    for (int k : keys) {
+        retval[k] = k;
+    }
+    return retval;
+}
+
+template<typename Map>
+void BM_insert(benchmark::State & state)
+{
+    for (auto _ : state) {
+        auto const m = make_map<Map>();
+        benchmark::DoNotOptimize(&m);
+    }
+}
+
+template<typename Map>
+void BM_find_hit(benchmark::State & state)
+{
+    auto const m = make_map<Map>();
+    for (auto _ : state) {
+        long sum = 0;
+        for (int k : keys) {
+            sum += m.find(k)->second;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+template<typename Map>
+void BM_find_miss(benchmark::State & state)
+{
+    auto const m = make_map<Map>();
+    for (auto _ : state) {
+        int found = 0;
+        for (int k : missing) {
+            found += m.find(k) != m.end();
+        }
+        benchmark::DoNotOptimize(found);
+    }
+}
+
+template<typename Map>
+void BM_iterate(benchmark::State & state)
+{
+    auto m = make_map<Map>();
+    int const percent = int(state.range(0));
+    for (int k : keys) {
+        if (int(unsigned(k) % 100) < percent)
+            m.erase(k);
+    }
+    for (auto _ : state) {
+        long sum = 0;
+        for (auto const & x : m) {
+            sum += x.second;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_insert, std::unordered_map<int, int>);
+BENCHMARK_TEMPLATE(BM_insert, flat_hash_map<int, int>);
+BENCHMARK_TEMPLATE(BM_find_hit, std::unordered_map<int, int>);
+BENCHMARK_TEMPLATE(BM_find_hit, flat_hash_map<int, int>);
+BENCHMARK_TEMPLATE(BM_find_miss, std::unordered_map<int, int>);
+BENCHMARK_TEMPLATE(BM_find_miss, flat_hash_map<int, int>);
+BENCHMARK_TEMPLATE(BM_iterate, std::unordered_map<int, int>)
+    ->Arg(0)
+    ->Arg(90)
+    ->Arg(99);
+BENCHMARK_TEMPLATE(BM_iterate, flat_hash_map<int, int>)
+    ->Arg(0)
+    ->Arg(90)
+    ->Arg(99);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,173 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/flat_map.hpp>
+#include <boost/stl_interfaces/static_string.hpp>
+#include "bench_data.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+
+// These benchmarks look up state.range(0) random keys in a map of
+// state.range(0) elements, uniformly distributed or skewed toward the
+// smallest keys, and merge state.range(0) sorted elements into one.  The
+// string benchmarks look up static_string keys, as parsed from a message,
+// in a map of 4K std::strings too long for the inline buffer, with
+// std::less<std::string>, which needs a std::string of each key, and with
+// the transparent std::less<>, which compares the keys as they are.
+
+namespace bsi = boost::stl_interfaces;
+using bsi::flat_map;
+using bsi::flat_set;
+using bsi::sorted_unique;
+
+template<typename Map>
+Map random_map(int n)
+{
+    std::vector<std::pair<int, int>> elements;
+    for (auto k : bench_data::random_ints(n, 2 * n)) {
+        elements.emplace_back(k, k);
+    }
+    return Map(elements.begin(), elements.end());
+}
+
+template<typename Map>
+void find(benchmark::State & state, std::vector<int> const & lookups)
+{
+    Map const m = random_map<Map>(state.range(0));
+    for (auto _ : state) {
+        long sum = 0;
+        for (auto k : lookups) {
+            auto const it = m.find(k);
+            if (it != m.end())
+                sum += (*it).second;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+template<typename Map>
+void BM_find(benchmark::State & state)
+{
+    find<Map>(
+        state, bench_data::random_ints(state.range(0), 2 * state.range(0), 2));
+}
+
+template<typename Map>
+void BM_find_skewed(benchmark::State & state)
+{
+    find<Map>(
+        state, bench_data::skewed_keys(state.range(0), 2 * state.range(0), 2));
+}
+
+template<typename Map>
+void BM_sorted_insert(benchmark::State & state)
+{
+    std::vector<std::pair<int, int>> evens, odds;
+    for (int i = 0; i < state.range(0); ++i) {
+        evens.emplace_back(2 * i, i);
+        odds.emplace_back(2 * i + 1, i);
+    }
+    for (auto _ : state) {
+        Map m(evens.begin(), evens.end());
+        m.insert(odds.begin(), odds.end());
+        benchmark::DoNotOptimize(&m);
+    }
+}
+
+template<>
+void BM_sorted_insert<flat_map<int, int>>(benchmark::State & state)
+{
+    std::vector<std::pair<int, int>> evens, odds;
+    for (int i = 0; i < state.range(0); ++i) {
+        evens.emplace_back(2 * i, i);
+        odds.emplace_back(2 * i + 1, i);
+    }
+    for (auto _ : state) {
+        flat_map<int, int> m(sorted_unique, evens.begin(), evens.end());
+        m.insert(sorted_unique, odds.begin(), odds.end());
+        benchmark::DoNotOptimize(&m);
+    }
+}
+
+template<typename Map>
+auto find_key(
+    Map const & m, bsi::static_string<32> const & k, std::false_type)
+{
+    return m.find(std::string(k.data(), k.size()));
+}
+template<typename Map>
+auto find_key(Map const & m, bsi::static_string<32> const & k, std::true_type)
+{
+    return m.find(k);
+}
+
+template<typename Compare>
+void BM_find_string(benchmark::State & state)
+{
+    auto const keys = bench_data::random_strings(1 << 12, 16, 32);
+    std::vector<std::pair<std::string, int>> elements;
+    std::vector<bsi::static_string<32>> lookups;
+    for (auto const & k : keys) {
+        elements.emplace_back(k, int(k.size()));
+        lookups.emplace_back(k.data(), k.size());
+    }
+    flat_map<std::string, int, Compare> const m(
+        elements.begin(), elements.end());
+    std::reverse(lookups.begin(), lookups.end());
+    for (auto _ : state) {
+        long sum = 0;
+        for (auto const & k : lookups) {
+            auto const it = find_key(
+                m,
+                k,
+                std::integral_constant<
+                    bool,
+                    !std::is_same<Compare, std::less<std::string>>::value>{});
+            if (it != m.end())
+                sum += (*it).second;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+// Merges state.range(0) odd keys into a flat_set of as many even ones, in
+// batches of 64, as a table that is loaded in pieces would be.
+void BM_set_batched_insert(benchmark::State & state)
+{
+    std::vector<int> evens, odds;
+    for (int i = 0; i < state.range(0); ++i) {
+        evens.push_back(2 * i);
+        odds.push_back(2 * i + 1);
+    }
+    for (auto _ : state) {
+        flat_set<int> s(sorted_unique, evens.begin(), evens.end());
+        for (std::size_t i = 0; i < odds.size(); i += 64) {
+            auto const last = odds.begin() + std::min(odds.size(), i + 64);
+            s.insert(sorted_unique, odds.begin() + i, last);
+        }
+        benchmark::DoNotOptimize(&s);
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_find, std::map<int, int>)->Range(64, 64 << 10);
+BENCHMARK_TEMPLATE(BM_find, flat_map<int, int>)->Range(64, 64 << 10);
+BENCHMARK_TEMPLATE(BM_find_skewed, std::map<int, int>)->Range(64, 64 << 10);
+BENCHMARK_TEMPLATE(BM_find_skewed, flat_map<int, int>)->Range(64, 64 << 10);
+BENCHMARK_TEMPLATE(BM_sorted_insert, std::map<int, int>)
+    ->Range(64, 64 << 10);
+BENCHMARK_TEMPLATE(BM_sorted_insert, flat_map<int, int>)
+    ->Range(64, 64 << 10);
+BENCHMARK(BM_set_batched_insert)->Range(64, 16 << 10);
+BENCHMARK_TEMPLATE(BM_find_string, std::less<std::string>);
+BENCHMARK_TEMPLATE(BM_find_string, std::less<>);
+
+BENCHMARK_MAIN();
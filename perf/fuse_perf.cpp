@@ -0,0 +1,119 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/range_adaptor_closure.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vector>
+
+
+// These benchmarks sum the elements of a six-stage pipeline over a large
+// array of prices: filter | transform | filter | transform | filter | take.
+
+std::vector<int> make_prices()
+{
+    std::mt19937 gen(7);
+    std::uniform_int_distribution<int> dist(-500, 5000);
+    std::vector<int> retval(1 << 20);
+    for (auto & x : retval) {
+        x = dist(gen);
+    }
+    return retval;
+}
+
+std::vector<int> const prices = make_prices();
+std::ptrdiff_t const count = 1 << 16;
+
+struct positive
+{
+    bool operator()(int x) const { return 0 < x; }
+};
+struct with_tax
+{
+    int operator()(int x) const { return x + x / 8; }
+};
+struct below_limit
+{
+    bool operator()(int x) const { return x < 4000; }
+};
+struct in_cents
+{
+    long operator()(int x) const { return 100L * x; }
+};
+struct not_round
+{
+    bool operator()(long x) const { return x % 1000 != 0; }
+};
+
+// Views nested one inside another, each iterator wrapping the last.
+void BM_nested(benchmark::State & state)
+{
+    namespace bsi = boost::stl_interfaces;
+    auto v1 = bsi::make_filter_view(prices, positive{});
+    auto v2 = bsi::make_transform_view(v1, with_tax{});
+    auto v3 = bsi::make_filter_view(v2, below_limit{});
+    auto v4 = bsi::make_transform_view(v3, in_cents{});
+    auto v5 = bsi::make_filter_view(v4, not_round{});
+    bsi::take_view<decltype(v5)> v6(v5, count);
+    for (auto _ : state) {
+        long sum = 0;
+        for (auto x : v6) {
+            sum += x;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+// The same views, fused into a take_view of one filter_view.
+void BM_fused(benchmark::State & state)
+{
+    namespace bsi = boost::stl_interfaces;
+    auto v1 = bsi::make_filter_view(prices, positive{});
+    auto v2 = bsi::make_transform_view(v1, with_tax{});
+    auto v3 = bsi::make_filter_view(v2, below_limit{});
+    auto v4 = bsi::make_transform_view(v3, in_cents{});
+    auto v5 = bsi::make_filter_view(v4, not_round{});
+    bsi::take_view<decltype(v5)> v6(v5, count);
+    auto fused = bsi::fuse(v6);
+    for (auto _ : state) {
+        long sum = 0;
+        for (auto x : fused) {
+            sum += x;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+// The loop one would write by hand.
+void BM_hand_fused(benchmark::State & state)
+{
+    for (auto _ : state) {
+        long sum = 0;
+        std::ptrdiff_t n = count;
+        for (auto it = prices.begin(), last = prices.end(); it != last && n;
+             ++it) {
+            int const x = *it;
+            if (!(0 < x))
+                continue;
+            int const taxed = x + x / 8;
+            if (!(taxed < 4000))
+                continue;
+            long const cents = 100L * taxed;
+            if (!(cents % 1000 != 0))
+                continue;
+            sum += cents;
+            --n;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+BENCHMARK(BM_nested);
+BENCHMARK(BM_fused);
+BENCHMARK(BM_hand_fused);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,131 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/gap_buffer.hpp>
+#include <boost/stl_interfaces/rope.hpp>
+
+#include "bench_data.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+
+using boost::stl_interfaces::gap_buffer;
+using boost::stl_interfaces::rope;
+
+
+// The typing benchmarks make 4K one-char edits to a 4MB buffer of chars,
+// at a cursor that starts at a random position and wanders a few chars
+// either way between edits, as a person typing does; 1 edit in 4 is a
+// backspace.  The random edit benchmarks are those of rope_perf.cpp: 1K
+// 16-char inserts and erases, anywhere in the buffer.  The scan benchmarks
+// count the newlines in the buffer, with the gap in the middle.
+
+constexpr int buffer_size = 1 << 22;
+constexpr int keystrokes = 1 << 12;
+constexpr int edits = 1 << 10;
+
+std::vector<int> const steps = bench_data::random_ints(keystrokes, 8, 3);
+std::vector<int> const positions =
+    bench_data::random_ints(edits, buffer_size - 16);
+std::string const snippet = "inserted text.\n ";
+
+template<typename Container>
+Container make_buffer()
+{
+    auto const ints = bench_data::random_ints(buffer_size, 64, 2);
+    Container retval;
+    for (int x : ints) {
+        retval.push_back(x ? char('a' + x % 26) : '\n');
+    }
+    return retval;
+}
+
+template<typename Container>
+void BM_typing(benchmark::State & state)
+{
+    auto c = make_buffer<Container>();
+    int cursor = buffer_size / 3;
+    for (auto _ : state) {
+        for (int step : steps) {
+            // Steps 0-5 type a char at the cursor, after moving it back by
+            // up to 2; 6 and 7 backspace.
+            if (step < 6) {
+                cursor -= (std::min)(step % 3, cursor);
+                c.insert(c.begin() + cursor, 'x');
+                ++cursor;
+            } else if (cursor) {
+                --cursor;
+                c.erase(c.begin() + cursor);
+            }
+        }
+        benchmark::DoNotOptimize(&c);
+    }
+}
+
+template<typename Container>
+void BM_random_edit(benchmark::State & state)
+{
+    auto c = make_buffer<Container>();
+    bool insert = true;
+    for (auto _ : state) {
+        for (int pos : positions) {
+            auto const it = c.begin() + pos;
+            if (insert)
+                c.insert(it, snippet.begin(), snippet.end());
+            else
+                c.erase(it, it + snippet.size());
+            insert = !insert;
+        }
+        benchmark::DoNotOptimize(&c);
+    }
+}
+
+template<typename Container>
+Container make_gapped_buffer()
+{
+    auto retval = make_buffer<Container>();
+    retval.insert(retval.begin() + buffer_size / 2, '\n');
+    return retval;
+}
+
+template<typename Container>
+void BM_scan(benchmark::State & state)
+{
+    auto const c = make_gapped_buffer<Container>();
+    for (auto _ : state) {
+        int n = 0;
+        for (char x : c) {
+            n += x == '\n';
+        }
+        benchmark::DoNotOptimize(n);
+    }
+}
+
+void BM_scan_gap_buffer_segmented(benchmark::State & state)
+{
+    auto const c = make_gapped_buffer<gap_buffer<char>>();
+    for (auto _ : state) {
+        int const n = boost::stl_interfaces::segmented_accumulate(
+            c.begin(), c.end(), 0, [](int n, char x) {
+                return n + (x == '\n');
+            });
+        benchmark::DoNotOptimize(n);
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_typing, std::vector<char>);
+BENCHMARK_TEMPLATE(BM_typing, gap_buffer<char>);
+BENCHMARK_TEMPLATE(BM_typing, rope<char>);
+BENCHMARK_TEMPLATE(BM_random_edit, std::vector<char>);
+BENCHMARK_TEMPLATE(BM_random_edit, gap_buffer<char>);
+BENCHMARK_TEMPLATE(BM_random_edit, rope<char>);
+BENCHMARK_TEMPLATE(BM_scan, std::vector<char>);
+BENCHMARK_TEMPLATE(BM_scan, gap_buffer<char>);
+BENCHMARK(BM_scan_gap_buffer_segmented);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,68 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/gather_buffers.hpp>
+#include <boost/stl_interfaces/concurrent_append_vector.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <vector>
+
+
+// These benchmarks send a 1MB message held in a chunked container -- a
+// concurrent_append_vector<char>, whose buckets double in size -- to
+// /dev/null, by flattening it into one buffer with segmented_copy() and
+// calling write(), or by gathering its buckets into iovecs and calling
+// writev() once.  The flat buffer is allocated once, up front.  Writing to
+// /dev/null reads none of the data, so these measure what the sender does
+// before the kernel copies the message.
+
+namespace bsi = boost::stl_interfaces;
+
+constexpr int message_size = 1 << 20;
+
+bsi::concurrent_append_vector<char> const & message()
+{
+    static bsi::concurrent_append_vector<char> retval;
+    if (retval.empty()) {
+        for (int i = 0; i < message_size; ++i) {
+            retval.push_back(char(i));
+        }
+    }
+    return retval;
+}
+
+void BM_flatten_write(benchmark::State & state)
+{
+    auto const & msg = message();
+    int const fd = ::open("/dev/null", O_WRONLY);
+    std::vector<char> flat(msg.size());
+    for (auto _ : state) {
+        bsi::segmented_copy(msg.begin(), msg.end(), flat.data());
+        benchmark::DoNotOptimize(::write(fd, flat.data(), flat.size()));
+    }
+    ::close(fd);
+}
+
+void BM_gather_writev(benchmark::State & state)
+{
+    auto const & msg = message();
+    int const fd = ::open("/dev/null", O_WRONLY);
+    ::iovec iovs[64];
+    for (auto _ : state) {
+        auto const last =
+            bsi::gather_buffers(msg, std::begin(iovs), bsi::to_iovec{});
+        benchmark::DoNotOptimize(::writev(fd, iovs, int(last - iovs)));
+    }
+    ::close(fd);
+}
+
+BENCHMARK(BM_flatten_write)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_gather_writev)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,58 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/hash.hpp>
+#include <boost/stl_interfaces/static_vector.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <functional>
+
+
+// These benchmarks hash static_vector<std::uint8_t> keys of several sizes,
+// by combining the std::hash of each element, boost::hash_combine-style, and
+// with hash_value().
+
+namespace bsi = boost::stl_interfaces;
+
+using key_type = bsi::static_vector<std::uint8_t, 1024>;
+
+key_type make_key(std::size_t n)
+{
+    key_type retval;
+    for (std::size_t i = 0; i < n; ++i) {
+        retval.push_back(std::uint8_t(i * 131 + 7));
+    }
+    return retval;
+}
+
+void BM_hash_combine(benchmark::State & state)
+{
+    auto const key = make_key(state.range(0));
+    for (auto _ : state) {
+        std::size_t seed = 0;
+        for (auto x : key) {
+            seed ^= std::hash<std::uint8_t>{}(x) + 0x9e3779b9 + (seed << 6) +
+                    (seed >> 2);
+        }
+        benchmark::DoNotOptimize(seed);
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+void BM_hash_value(benchmark::State & state)
+{
+    auto const key = make_key(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(bsi::hash_value(key));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_hash_combine)->Arg(16)->Arg(64)->Arg(256)->Arg(1024);
+BENCHMARK(BM_hash_value)->Arg(16)->Arg(64)->Arg(256)->Arg(1024);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,83 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/stl_interfaces/hive.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vector>
+
+
+using boost::stl_interfaces::hive;
+
+
+// These benchmarks sum the live elements of a pool of 1M int slots of which
+// state.range(0) percent have been erased at random: a vector of
+// optional-like slots, with a branch per slot, and a hive.
+
+struct slot
+{
+    bool alive;
+    int value;
+};
+
+std::vector<bool> erased(int n, int percent)
+{
+    std::mt19937 gen(3);
+    std::vector<bool> retval(n);
+    for (int i = 0; i < n; ++i) {
+        retval[i] = int(gen() % 100) < percent;
+    }
+    return retval;
+}
+
+void BM_optional_slots(benchmark::State & state)
+{
+    int const n = 1 << 20;
+    auto const dead = erased(n, state.range(0));
+    std::vector<slot> slots(n);
+    for (int i = 0; i < n; ++i) {
+        slots[i] = slot{!dead[i], i};
+    }
+    for (auto _ : state) {
+        long sum = 0;
+        for (auto const & s : slots) {
+            if (s.alive)
+                sum += s.value;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+void BM_hive(benchmark::State & state)
+{
+    int const n = 1 << 20;
+    auto const dead = erased(n, state.range(0));
+    hive<int> h;
+    for (int i = 0; i < n; ++i) {
+        h.insert(i);
+    }
+    int i = 0;
+    for (auto it = h.begin(); it != h.end(); ++i) {
+        if (dead[i])
+            it = h.erase(it);
+        else
+            ++it;
+    }
+    for (auto _ : state) {
+        long sum = 0;
+        for (auto x : h) {
+            sum += x;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+BENCHMARK(BM_optional_slots)->Arg(10)->Arg(50)->Arg(90)->Arg(99);
+BENCHMARK(BM_hive)->Arg(10)->Arg(50)->Arg(90)->Arg(99);
+
+BENCHMARK_MAIN();
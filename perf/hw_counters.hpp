@@ -0,0 +1,172 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_PERF_HW_COUNTERS_HPP
+#define BOOST_STL_INTERFACES_PERF_HW_COUNTERS_HPP
+
+#include <benchmark/benchmark.h>
+
+#if defined(BENCH_HW_COUNTERS) && defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define BENCH_HW_COUNTERS_PERF_EVENT
+#endif
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+
+// Hardware counters for the perf executables.  A hw_counters::scope made in
+// a benchmark function, after its setup and just before its timing loop,
+// counts the cycles, instructions, L1 data cache and last-level cache
+// misses, branch misses and page faults of the loop, and adds them to the
+// benchmark's results as user counters -- per iteration, with the IPC and
+// the miss rates -- so that they appear in the console output and in the
+// bench target's JSON next to the times.
+//
+// Counting is compiled in only if BENCH_HW_COUNTERS is defined, as it is
+// when CMake is configured with -DBENCH_HW_COUNTERS=true, and only on Linux,
+// where it uses perf_event_open(); otherwise a scope does nothing.  A
+// counter that cannot be opened -- virtual machines often have no PMU, and
+// /proc/sys/kernel/perf_event_paranoid may forbid counting -- is left out of
+// the results, as are the rates that depend on it.  Only user-space events
+// in the calling thread are counted, so the work of a thread pool's workers
+// is not.
+
+namespace hw_counters {
+
+#if defined(BENCH_HW_COUNTERS_PERF_EVENT)
+
+    // One perf_event counter of the calling thread, counting from its
+    // construction.
+    struct counter
+    {
+        counter(std::uint32_t type, std::uint64_t config) noexcept
+        {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = type;
+            attr.config = config;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format =
+                PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            fd_ = int(::syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+        }
+        counter(counter const &) = delete;
+        counter & operator=(counter const &) = delete;
+        ~counter()
+        {
+            if (0 <= fd_)
+                ::close(fd_);
+        }
+
+        // The count, scaled up for the time that the counter was not
+        // running because the kernel was multiplexing more counters than
+        // the PMU has; or a negative value if there is no count.
+        double value() const noexcept
+        {
+            std::uint64_t values[3];
+            if (fd_ < 0 || ::read(fd_, values, sizeof(values)) !=
+                               ssize_t(sizeof(values)) ||
+                !values[2]) {
+                return -1.0;
+            }
+            return double(values[0]) * double(values[1]) / double(values[2]);
+        }
+
+    private:
+        int fd_;
+    };
+
+    constexpr std::uint64_t cache_event(std::uint64_t cache, bool miss)
+    {
+        return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+               ((miss ? PERF_COUNT_HW_CACHE_RESULT_MISS
+                      : PERF_COUNT_HW_CACHE_RESULT_ACCESS)
+                << 16);
+    }
+
+    struct scope
+    {
+        explicit scope(benchmark::State & state) noexcept :
+            state_(state),
+            cycles_(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES),
+            instructions_(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS),
+            l1d_loads_(
+                PERF_TYPE_HW_CACHE,
+                cache_event(PERF_COUNT_HW_CACHE_L1D, false)),
+            l1d_misses_(
+                PERF_TYPE_HW_CACHE, cache_event(PERF_COUNT_HW_CACHE_L1D, true)),
+            llc_references_(
+                PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_REFERENCES),
+            llc_misses_(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES),
+            branches_(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_INSTRUCTIONS),
+            branch_misses_(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES),
+            page_faults_(PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS)
+        {}
+        scope(scope const &) = delete;
+        scope & operator=(scope const &) = delete;
+
+        ~scope()
+        {
+            double const cycles = cycles_.value();
+            double const instructions = instructions_.value();
+            per_iteration("cycles", cycles);
+            per_iteration("instructions", instructions);
+            ratio("IPC", instructions, cycles);
+            misses("L1d", l1d_misses_.value(), l1d_loads_.value());
+            misses("LLC", llc_misses_.value(), llc_references_.value());
+            misses("branch", branch_misses_.value(), branches_.value());
+            per_iteration("page_faults", page_faults_.value());
+        }
+
+    private:
+        void per_iteration(std::string const & name, double count)
+        {
+            if (0.0 <= count) {
+                state_.counters[name] = benchmark::Counter(
+                    count, benchmark::Counter::kAvgIterations);
+            }
+        }
+        void ratio(std::string const & name, double num, double denom)
+        {
+            if (0.0 <= num && 0.0 < denom)
+                state_.counters[name] = num / denom;
+        }
+        void
+        misses(std::string const & name, double misses, double accesses)
+        {
+            per_iteration(name + "_misses", misses);
+            ratio(name + "_miss_rate", misses, accesses);
+        }
+
+        benchmark::State & state_;
+        counter cycles_;
+        counter instructions_;
+        counter l1d_loads_;
+        counter l1d_misses_;
+        counter llc_references_;
+        counter llc_misses_;
+        counter branches_;
+        counter branch_misses_;
+        counter page_faults_;
+    };
+
+#else
+
+    struct scope
+    {
+        explicit scope(benchmark::State &) noexcept {}
+    };
+
+#endif
+
+}
+
+#endif
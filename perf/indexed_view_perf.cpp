@@ -0,0 +1,105 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/indexed_view.hpp>
+#include <boost/stl_interfaces/iterator_interface.hpp>
+#include "bench_data.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+
+// These benchmarks read log records at random offsets, as a UI backend
+// paging through a log does.  The log is 64K variable-length records, each
+// a length byte and its payload, packed into one buffer, so its iterator
+// is forward only.  Each lookup is std::next(begin(), n), or operator[] of
+// an indexed_view with a checkpoint every 64 records.
+
+// A forward iterator over the records; *it is the record's length.
+struct record_iterator : boost::stl_interfaces::iterator_interface<
+                             record_iterator,
+                             std::forward_iterator_tag,
+                             unsigned char const>
+{
+    record_iterator() = default;
+    explicit record_iterator(unsigned char const * p) : p_(p) {}
+
+    unsigned char const & operator*() const { return *p_; }
+    record_iterator & operator++()
+    {
+        p_ += 1 + *p_;
+        return *this;
+    }
+    friend bool operator==(record_iterator lhs, record_iterator rhs)
+    {
+        return lhs.p_ == rhs.p_;
+    }
+
+    using base_type = boost::stl_interfaces::iterator_interface<
+        record_iterator,
+        std::forward_iterator_tag,
+        unsigned char const>;
+    using base_type::operator++;
+
+private:
+    unsigned char const * p_ = nullptr;
+};
+
+constexpr int records = 1 << 16;
+
+std::vector<unsigned char> const & log_buffer()
+{
+    static auto const retval = [] {
+        std::vector<unsigned char> buffer;
+        for (int len : bench_data::random_ints(records, 200, 1)) {
+            buffer.push_back((unsigned char)len);
+            buffer.resize(buffer.size() + std::size_t(len), 'x');
+        }
+        return buffer;
+    }();
+    return retval;
+}
+
+std::vector<int> const & offsets()
+{
+    static auto const retval = bench_data::random_ints(1024, records, 2);
+    return retval;
+}
+
+void BM_lookup_next(benchmark::State & state)
+{
+    auto const & buffer = log_buffer();
+    record_iterator const first(buffer.data());
+    for (auto _ : state) {
+        std::uint64_t sum = 0;
+        for (int n : offsets()) {
+            sum += *std::next(first, n);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+void BM_lookup_indexed(benchmark::State & state)
+{
+    auto const & buffer = log_buffer();
+    boost::stl_interfaces::indexed_view<record_iterator> const v(
+        record_iterator(buffer.data()),
+        record_iterator(buffer.data() + buffer.size()));
+    for (auto _ : state) {
+        std::uint64_t sum = 0;
+        for (int n : offsets()) {
+            sum += v[n];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+BENCHMARK(BM_lookup_next)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_lookup_indexed)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
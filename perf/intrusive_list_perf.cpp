@@ -0,0 +1,103 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/stl_interfaces/intrusive_list.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <list>
+#include <random>
+#include <vector>
+
+
+using boost::stl_interfaces::intrusive_list;
+using boost::stl_interfaces::list_hook;
+
+
+// These benchmarks churn an order book of 64K live orders in 256 price
+// levels: each step cancels a random order, and puts a new one in its slot
+// at a random level.  With std::list, each order keeps the iterator to its
+// node, and each new order allocates a node; intrusive_list just relinks
+// the order's hook.
+
+int const orders = 1 << 16;
+int const levels = 256;
+
+std::vector<int> random_ints(int n, int max)
+{
+    std::mt19937 gen(5);
+    std::vector<int> retval(n);
+    for (auto & x : retval) {
+        x = int(gen() % max);
+    }
+    return retval;
+}
+
+struct std_order
+{
+    int quantity;
+    int level;
+    std::list<std_order *>::iterator it;
+};
+
+void BM_std_list(benchmark::State & state)
+{
+    auto const slots = random_ints(1 << 16, orders);
+    auto const prices = random_ints(1 << 16, levels);
+    std::vector<std_order> book(orders);
+    std::vector<std::list<std_order *>> level(levels);
+    for (int i = 0; i < orders; ++i) {
+        auto & o = book[i];
+        o.level = prices[i];
+        level[o.level].push_back(&o);
+        o.it = std::prev(level[o.level].end());
+    }
+    std::size_t i = 0;
+    for (auto _ : state) {
+        auto & o = book[slots[i]];
+        level[o.level].erase(o.it);
+        o.level = prices[i];
+        level[o.level].push_back(&o);
+        o.it = std::prev(level[o.level].end());
+        i = (i + 1) % slots.size();
+    }
+    benchmark::DoNotOptimize(level[0].size());
+}
+
+struct intrusive_order
+{
+    int quantity;
+    int level;
+    list_hook hook;
+};
+using level_list = intrusive_list<intrusive_order, &intrusive_order::hook>;
+
+void BM_intrusive_list(benchmark::State & state)
+{
+    auto const slots = random_ints(1 << 16, orders);
+    auto const prices = random_ints(1 << 16, levels);
+    std::vector<intrusive_order> book(orders);
+    std::vector<level_list> level(levels);
+    for (int i = 0; i < orders; ++i) {
+        auto & o = book[i];
+        o.level = prices[i];
+        level[o.level].push_back(o);
+    }
+    std::size_t i = 0;
+    for (auto _ : state) {
+        auto & o = book[slots[i]];
+        level[o.level].erase(level_list::iterator_to(o));
+        o.level = prices[i];
+        level[o.level].push_back(o);
+        i = (i + 1) % slots.size();
+    }
+    benchmark::DoNotOptimize(level[0].size());
+}
+
+BENCHMARK(BM_std_list);
+BENCHMARK(BM_intrusive_list);
+
+BENCHMARK_MAIN();
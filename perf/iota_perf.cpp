@@ -0,0 +1,88 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/iota_view.hpp>
+#include <boost/stl_interfaces/algorithm.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+
+// BM_copy_* write 64K consecutive (or stepped) integers from an iota_view
+// into an array: with std::copy(), one iterator increment and dereference
+// at a time, and with the copy() from algorithm.hpp, which is one
+// read_n() loop.  BM_std_iota is std::iota() into the same array, for
+// comparison.  BM_transform_* write a function of each index, with
+// std::transform() and with the transform() from iota_view.hpp.
+
+int const n = 1 << 16;
+
+void BM_std_iota(benchmark::State & state)
+{
+    std::vector<int> out(n);
+    for (auto _ : state) {
+        std::iota(out.begin(), out.end(), 0);
+        benchmark::DoNotOptimize(out.data());
+    }
+}
+
+void BM_copy_std(benchmark::State & state)
+{
+    namespace bsi = boost::stl_interfaces;
+    std::vector<int> out(n);
+    auto const v =
+        bsi::make_iota_view(0, n * int(state.range(0)), state.range(0));
+    for (auto _ : state) {
+        std::copy(v.begin(), v.end(), out.data());
+        benchmark::DoNotOptimize(out.data());
+    }
+}
+
+void BM_copy_batch(benchmark::State & state)
+{
+    namespace bsi = boost::stl_interfaces;
+    std::vector<int> out(n);
+    auto const v =
+        bsi::make_iota_view(0, n * int(state.range(0)), state.range(0));
+    for (auto _ : state) {
+        bsi::copy(v.begin(), v.end(), out.data());
+        benchmark::DoNotOptimize(out.data());
+    }
+}
+
+auto const scale = [](int i) { return 3 * i + 1; };
+
+void BM_transform_std(benchmark::State & state)
+{
+    namespace bsi = boost::stl_interfaces;
+    std::vector<int> out(n);
+    auto const v = bsi::make_iota_view(0, n);
+    for (auto _ : state) {
+        std::transform(v.begin(), v.end(), out.data(), scale);
+        benchmark::DoNotOptimize(out.data());
+    }
+}
+
+void BM_transform_batch(benchmark::State & state)
+{
+    namespace bsi = boost::stl_interfaces;
+    std::vector<int> out(n);
+    auto const v = bsi::make_iota_view(0, n);
+    for (auto _ : state) {
+        bsi::transform(v.begin(), v.end(), out.data(), scale);
+        benchmark::DoNotOptimize(out.data());
+    }
+}
+
+BENCHMARK(BM_std_iota);
+BENCHMARK(BM_copy_std)->Arg(1)->Arg(3);
+BENCHMARK(BM_copy_batch)->Arg(1)->Arg(3);
+BENCHMARK(BM_transform_std);
+BENCHMARK(BM_transform_batch);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,97 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/join_view.hpp>
+#include <boost/stl_interfaces/static_vector.hpp>
+#include "bench_data.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+
+// These benchmarks sum and search a bucketed table -- 16K buckets of up to
+// 8 ints, as a hash table's are -- with a hand-written loop over the
+// buckets, with the std algorithms over a join_view, and with the
+// segmented_*() algorithms over a join_view.
+
+using bucket = boost::stl_interfaces::static_vector<int, 8>;
+
+std::vector<bucket> make_table()
+{
+    auto const sizes = bench_data::random_ints(1 << 14, 9);
+    auto const ints = bench_data::random_ints(1 << 17, 1000, 2);
+    std::vector<bucket> retval(sizes.size());
+    auto it = ints.begin();
+    for (std::size_t i = 0; i < sizes.size(); ++i) {
+        retval[i].assign(it, it + sizes[i]);
+        it += sizes[i];
+    }
+    retval.back().push_back(-1);
+    return retval;
+}
+
+std::vector<bucket> const table = make_table();
+
+void BM_nested_loop_accumulate(benchmark::State & state)
+{
+    for (auto _ : state) {
+        long sum = 0;
+        for (auto const & b : table) {
+            for (int x : b) {
+                sum += x;
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+void BM_join_accumulate(benchmark::State & state)
+{
+    auto const v = boost::stl_interfaces::make_join_view(table);
+    for (auto _ : state) {
+        long const sum = std::accumulate(v.begin(), v.end(), 0l);
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+void BM_join_segmented_accumulate(benchmark::State & state)
+{
+    auto const v = boost::stl_interfaces::make_join_view(table);
+    for (auto _ : state) {
+        long const sum = boost::stl_interfaces::segmented_accumulate(
+            v.begin(), v.end(), 0l);
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+void BM_join_find(benchmark::State & state)
+{
+    auto const v = boost::stl_interfaces::make_join_view(table);
+    for (auto _ : state) {
+        auto const it = std::find(v.begin(), v.end(), -1);
+        benchmark::DoNotOptimize(it);
+    }
+}
+
+void BM_join_segmented_find(benchmark::State & state)
+{
+    auto const v = boost::stl_interfaces::make_join_view(table);
+    for (auto _ : state) {
+        auto const it =
+            boost::stl_interfaces::segmented_find(v.begin(), v.end(), -1);
+        benchmark::DoNotOptimize(it);
+    }
+}
+
+BENCHMARK(BM_nested_loop_accumulate);
+BENCHMARK(BM_join_accumulate);
+BENCHMARK(BM_join_segmented_accumulate);
+BENCHMARK(BM_join_find);
+BENCHMARK(BM_join_segmented_find);
+
+BENCHMARK_MAIN();
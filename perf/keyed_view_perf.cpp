@@ -0,0 +1,139 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/keyed_view.hpp>
+#include "bench_data.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <vector>
+
+
+// These benchmarks sort 256K records of 128 and 512 bytes by one 8-byte
+// member of each, and look up 64K keys in the sorted records: directly,
+// with a comparison that reads the member; through the zip_iterators of a
+// keyed_view, which compare keys but still swap whole records; and with
+// keyed_view's own sort() and lower_bound(), which work on the keys alone,
+// and move each record once.  The sorts include extracting the keys.
+
+namespace bsi = boost::stl_interfaces;
+
+template<int Size>
+struct record
+{
+    long key;
+    long payload[Size / sizeof(long) - 1];
+};
+
+template<int Size>
+std::vector<record<Size>> const & records()
+{
+    static std::vector<record<Size>> const retval = [] {
+        std::vector<int> const keys =
+            bench_data::random_ints(1 << 18, 1 << 30);
+        std::vector<record<Size>> v(keys.size());
+        for (std::size_t i = 0; i < keys.size(); ++i) {
+            v[i].key = keys[i];
+            v[i].payload[0] = long(i);
+        }
+        return v;
+    }();
+    return retval;
+}
+std::vector<int> const queries = bench_data::random_ints(1 << 16, 1 << 30, 2);
+
+auto const key_of = [](auto const & r) { return r.key; };
+auto const key_less = [](auto const & a, auto const & b) {
+    return a.key < b.key;
+};
+
+template<int Size>
+void BM_sort_records(benchmark::State & state)
+{
+    std::vector<record<Size>> v;
+    for (auto _ : state) {
+        state.PauseTiming();
+        v = records<Size>();
+        state.ResumeTiming();
+        std::sort(v.begin(), v.end(), key_less);
+        benchmark::DoNotOptimize(v.data());
+    }
+}
+template<int Size>
+void BM_sort_keyed_view_zip(benchmark::State & state)
+{
+    std::vector<record<Size>> v;
+    for (auto _ : state) {
+        state.PauseTiming();
+        v = records<Size>();
+        state.ResumeTiming();
+        auto keyed = bsi::make_keyed_view(v, key_of);
+        std::sort(
+            keyed.begin(), keyed.end(), [](auto const & a, auto const & b) {
+                return std::get<0>(a) < std::get<0>(b);
+            });
+        benchmark::DoNotOptimize(v.data());
+    }
+}
+template<int Size>
+void BM_sort_keyed_view(benchmark::State & state)
+{
+    std::vector<record<Size>> v;
+    for (auto _ : state) {
+        state.PauseTiming();
+        v = records<Size>();
+        state.ResumeTiming();
+        auto keyed = bsi::make_keyed_view(v, key_of);
+        keyed.sort();
+        benchmark::DoNotOptimize(v.data());
+    }
+}
+
+template<int Size>
+void BM_search_records(benchmark::State & state)
+{
+    std::vector<record<Size>> v = records<Size>();
+    std::sort(v.begin(), v.end(), key_less);
+    for (auto _ : state) {
+        long sum = 0;
+        for (int q : queries) {
+            auto const it = std::lower_bound(
+                v.begin(), v.end(), long(q), [](auto const & r, long k) {
+                    return r.key < k;
+                });
+            sum += it == v.end() ? 0 : it->payload[0];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+template<int Size>
+void BM_search_keyed_view(benchmark::State & state)
+{
+    std::vector<record<Size>> v = records<Size>();
+    auto keyed = bsi::make_keyed_view(v, key_of);
+    keyed.sort();
+    for (auto _ : state) {
+        long sum = 0;
+        for (int q : queries) {
+            auto const it = keyed.lower_bound(long(q));
+            sum += it == keyed.end() ? 0 : std::get<1>(*it).payload[0];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_sort_records, 128)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_sort_keyed_view_zip, 128)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_sort_keyed_view, 128)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_search_records, 128)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_search_keyed_view, 128)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_sort_records, 512)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_sort_keyed_view_zip, 512)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_sort_keyed_view, 512)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_search_records, 512)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_search_keyed_view, 512)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
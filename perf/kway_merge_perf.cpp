@@ -0,0 +1,153 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/kway_merge_view.hpp>
+#include "bench_data.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+// These benchmarks merge k sorted runs of keys into one output buffer, as
+// the compaction of a log-structured merge tree does: with a
+// std::priority_queue of the runs' heads, which is how such merges are
+// usually written; with a loop over the iterators of a kway_merge_view; and
+// with kway_merge_view::copy().  There are 1M int keys, or 256K string keys
+// of 8 to 24 letters.
+//
+// The emptiness benchmarks test a kway_merge_view of k int runs for
+// emptiness, with begin() == end(), which builds the loser tree, and with
+// operator bool, which uses the count of elements the view keeps.
+
+template<typename T>
+std::vector<T> random_keys(std::size_t n, std::uint64_t seed);
+template<>
+std::vector<int> random_keys<int>(std::size_t n, std::uint64_t seed)
+{
+    return bench_data::random_ints(n, 1 << 30, seed);
+}
+template<>
+std::vector<std::string>
+random_keys<std::string>(std::size_t n, std::uint64_t seed)
+{
+    return bench_data::random_strings(n, 8, 24, seed);
+}
+
+template<typename T>
+std::size_t total_keys()
+{
+    return std::is_same<T, int>::value ? 1 << 20 : 1 << 18;
+}
+
+template<typename T>
+std::vector<std::vector<T>> make_runs(int k)
+{
+    std::vector<std::vector<T>> retval;
+    for (int r = 0; r < k; ++r) {
+        retval.push_back(random_keys<T>(total_keys<T>() / k, r + 1));
+        std::sort(retval.back().begin(), retval.back().end());
+    }
+    return retval;
+}
+
+template<typename T>
+void BM_priority_queue(benchmark::State & state)
+{
+    auto const runs = make_runs<T>(int(state.range(0)));
+    std::vector<T> out(total_keys<T>());
+    std::vector<std::size_t> pos(runs.size());
+    // The heap holds positions, so that string keys are not copied into it.
+    using head = std::pair<T const *, std::size_t>;
+    auto const greater = [](head const & a, head const & b) {
+        return *b.first < *a.first || (!(*a.first < *b.first) && b < a);
+    };
+    for (auto _ : state) {
+        std::priority_queue<head, std::vector<head>, decltype(greater)> heads(
+            greater);
+        for (std::size_t r = 0; r < runs.size(); ++r) {
+            pos[r] = 0;
+            heads.push(head(runs[r].data(), r));
+        }
+        auto it = out.begin();
+        while (!heads.empty()) {
+            head const h = heads.top();
+            heads.pop();
+            *it++ = *h.first;
+            if (++pos[h.second] != runs[h.second].size())
+                heads.push(head(h.first + 1, h.second));
+        }
+        benchmark::DoNotOptimize(out.data());
+    }
+}
+template<typename T>
+void BM_kway_merge_view(benchmark::State & state)
+{
+    auto const runs = make_runs<T>(int(state.range(0)));
+    std::vector<T> out(total_keys<T>());
+    for (auto _ : state) {
+        auto const v = boost::stl_interfaces::make_kway_merge_view(runs);
+        std::copy(v.begin(), v.end(), out.begin());
+        benchmark::DoNotOptimize(out.data());
+    }
+}
+template<typename T>
+void BM_kway_merge_view_copy(benchmark::State & state)
+{
+    auto const runs = make_runs<T>(int(state.range(0)));
+    std::vector<T> out(total_keys<T>());
+    for (auto _ : state) {
+        auto const v = boost::stl_interfaces::make_kway_merge_view(runs);
+        v.copy(out.begin());
+        benchmark::DoNotOptimize(out.data());
+    }
+}
+void BM_empty_begin_end(benchmark::State & state)
+{
+    auto const runs = make_runs<int>(int(state.range(0)));
+    auto const v = boost::stl_interfaces::make_kway_merge_view(runs);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(v.begin() == v.end());
+    }
+}
+void BM_empty_operator_bool(benchmark::State & state)
+{
+    auto const runs = make_runs<int>(int(state.range(0)));
+    auto const v = boost::stl_interfaces::make_kway_merge_view(runs);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(bool(v));
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_priority_queue, int)
+    ->Arg(4)
+    ->Arg(16)
+    ->Arg(64)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_kway_merge_view, int)
+    ->Arg(4)
+    ->Arg(16)
+    ->Arg(64)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_kway_merge_view_copy, int)
+    ->Arg(4)
+    ->Arg(16)
+    ->Arg(64)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_priority_queue, std::string)
+    ->Arg(16)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_kway_merge_view, std::string)
+    ->Arg(16)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_empty_begin_end)->Arg(4)->Arg(16)->Arg(64);
+BENCHMARK(BM_empty_operator_bool)->Arg(4)->Arg(16)->Arg(64);
+
+BENCHMARK_MAIN();
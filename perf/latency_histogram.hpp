@@ -0,0 +1,118 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_PERF_LATENCY_HISTOGRAM_HPP
+#define BOOST_STL_INTERFACES_PERF_LATENCY_HISTOGRAM_HPP
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+
+// Latency histograms for the perf executables that report tail latencies
+// rather than throughput.  A latency_histogram::histogram counts recorded
+// times in nanoseconds in log-linear buckets, as an HDR histogram does:
+// times below 64ns each have a bucket of their own, and each power of two
+// above that is split into 32 buckets, so that a percentile read back is
+// within about 3% of the time recorded, at any magnitude, in a fixed 16KB.
+// report() adds the p50, p99, p99.9 and maximum of a histogram to a
+// benchmark's results as user counters.
+
+namespace latency_histogram {
+
+    struct histogram
+    {
+        static constexpr int sub_buckets = 32;
+        static constexpr int linear_limit = 2 * sub_buckets;
+        static constexpr int buckets = linear_limit + 58 * sub_buckets;
+
+        void record(std::uint64_t ns) noexcept
+        {
+            ++counts_[index(ns)];
+            ++count_;
+            if (max_ < ns)
+                max_ = ns;
+        }
+
+        std::uint64_t count() const noexcept { return count_; }
+        std::uint64_t max() const noexcept { return max_; }
+
+        // The least time that at least q of the recorded times are at or
+        // below, rounded up to the top of its bucket; q is in [0, 1].
+        std::uint64_t percentile(double q) const noexcept
+        {
+            if (!count_)
+                return 0;
+            auto rank = std::uint64_t(q * double(count_) + 0.5);
+            if (rank < 1)
+                rank = 1;
+            std::uint64_t seen = 0;
+            for (int i = 0; i < buckets; ++i) {
+                seen += counts_[i];
+                if (rank <= seen)
+                    return top(i) < max_ ? top(i) : max_;
+            }
+            return max_;
+        }
+
+    private:
+        static int index(std::uint64_t ns) noexcept
+        {
+            if (ns < std::uint64_t(linear_limit))
+                return int(ns);
+            int shift = 1;
+            while (std::uint64_t(linear_limit) <= (ns >> shift)) {
+                ++shift;
+            }
+            return linear_limit + (shift - 1) * sub_buckets +
+                   int(ns >> shift) - sub_buckets;
+        }
+
+        static std::uint64_t top(int i) noexcept
+        {
+            if (i < linear_limit)
+                return std::uint64_t(i);
+            int const shift = (i - linear_limit) / sub_buckets + 1;
+            std::uint64_t const sub = (i - linear_limit) % sub_buckets;
+            return ((sub_buckets + sub + 1) << shift) - 1;
+        }
+
+        std::uint64_t counts_[buckets] = {};
+        std::uint64_t count_ = 0;
+        std::uint64_t max_ = 0;
+    };
+
+    // The time f() takes, in nanoseconds, which includes the cost of
+    // reading the clock twice; BM_timer_floor in container_latency_perf
+    // measures that.
+    template<typename F>
+    std::uint64_t time_ns(F && f)
+    {
+        auto const start = std::chrono::steady_clock::now();
+        f();
+        auto const stop = std::chrono::steady_clock::now();
+        return std::uint64_t(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start)
+                .count());
+    }
+
+    // Adds name_p50, name_p99, name_p99.9 and name_max, in nanoseconds, to
+    // the results of state.  A histogram with no times in it adds nothing.
+    inline void report(
+        benchmark::State & state, std::string const & name, histogram const & h)
+    {
+        if (!h.count())
+            return;
+        state.counters[name + "_p50"] = double(h.percentile(0.5));
+        state.counters[name + "_p99"] = double(h.percentile(0.99));
+        state.counters[name + "_p99.9"] = double(h.percentile(0.999));
+        state.counters[name + "_max"] = double(h.max());
+    }
+
+}
+
+#endif
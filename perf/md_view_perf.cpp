@@ -0,0 +1,143 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/md_view.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+
+// These benchmarks apply a 3-point horizontal stencil to a row-major
+// matrix -- out(i, j) = in(i, j - 1) + in(i, j) + in(i, j + 1) -- through
+// raw pointer arithmetic, and through md_views with dynamic and static
+// extents; and then sum its columns.
+
+namespace bsi = boost::stl_interfaces;
+
+constexpr int rows = 256;
+constexpr int cols = 256;
+std::vector<float> const input(rows * cols, 1.0f);
+
+void BM_stencil_raw(benchmark::State & state)
+{
+    std::vector<float> output(rows * cols);
+    int const r = rows;
+    int const c = cols;
+    benchmark::DoNotOptimize(r);
+    benchmark::DoNotOptimize(c);
+    for (auto _ : state) {
+        float const * in = input.data();
+        float * out = output.data();
+        for (int i = 0; i < r; ++i) {
+            for (int j = 1; j < c - 1; ++j) {
+                out[i * c + j] =
+                    in[i * c + j - 1] + in[i * c + j] + in[i * c + j + 1];
+            }
+        }
+        benchmark::DoNotOptimize(output.data());
+    }
+}
+
+void BM_stencil_md_view_dynamic(benchmark::State & state)
+{
+    using extents =
+        bsi::extents<bsi::dynamic_extent, bsi::dynamic_extent>;
+    std::vector<float> output(rows * cols);
+    int r = rows;
+    int c = cols;
+    benchmark::DoNotOptimize(r);
+    benchmark::DoNotOptimize(c);
+    bsi::md_view<float const, extents> const in(input.data(), r, c);
+    bsi::md_view<float, extents> const out(output.data(), r, c);
+    for (auto _ : state) {
+        for (int i = 0; i < in.extent(0); ++i) {
+            for (int j = 1; j < in.extent(1) - 1; ++j) {
+                out(i, j) = in(i, j - 1) + in(i, j) + in(i, j + 1);
+            }
+        }
+        benchmark::DoNotOptimize(output.data());
+    }
+}
+
+void BM_stencil_md_view_static(benchmark::State & state)
+{
+    using extents = bsi::extents<rows, cols>;
+    std::vector<float> output(rows * cols);
+    bsi::md_view<float const, extents> const in(input.data());
+    bsi::md_view<float, extents> const out(output.data());
+    for (auto _ : state) {
+        for (int i = 0; i < in.extent(0); ++i) {
+            for (int j = 1; j < in.extent(1) - 1; ++j) {
+                out(i, j) = in(i, j - 1) + in(i, j) + in(i, j + 1);
+            }
+        }
+        benchmark::DoNotOptimize(output.data());
+    }
+}
+
+// The rows, as contiguous md_views.
+void BM_stencil_md_view_rows(benchmark::State & state)
+{
+    using extents = bsi::extents<rows, cols>;
+    std::vector<float> output(rows * cols);
+    bsi::md_view<float const, extents> const in(input.data());
+    bsi::md_view<float, extents> const out(output.data());
+    for (auto _ : state) {
+        auto out_it = out.begin();
+        for (auto it = in.begin(); it != in.end(); ++it, ++out_it) {
+            float const * row = (*it).data();
+            float * out_row = (*out_it).data();
+            for (int j = 1; j < cols - 1; ++j) {
+                out_row[j] = row[j - 1] + row[j] + row[j + 1];
+            }
+        }
+        benchmark::DoNotOptimize(output.data());
+    }
+}
+
+void BM_column_sums_raw(benchmark::State & state)
+{
+    std::vector<float> sums(cols);
+    int const c = cols;
+    benchmark::DoNotOptimize(c);
+    for (auto _ : state) {
+        for (int j = 0; j < c; ++j) {
+            float sum = 0.0f;
+            for (int i = 0; i < rows; ++i) {
+                sum += input[i * c + j];
+            }
+            sums[j] = sum;
+        }
+        benchmark::DoNotOptimize(sums.data());
+    }
+}
+
+// Each column, as a strided md_view from submd().
+void BM_column_sums_submd(benchmark::State & state)
+{
+    using extents = bsi::extents<rows, cols>;
+    std::vector<float> sums(cols);
+    bsi::md_view<float const, extents> const in(input.data());
+    for (auto _ : state) {
+        for (int j = 0; j < cols; ++j) {
+            float sum = 0.0f;
+            for (float x : bsi::submd(in, bsi::full_extent, j)) {
+                sum += x;
+            }
+            sums[j] = sum;
+        }
+        benchmark::DoNotOptimize(sums.data());
+    }
+}
+
+BENCHMARK(BM_stencil_raw);
+BENCHMARK(BM_stencil_md_view_dynamic);
+BENCHMARK(BM_stencil_md_view_static);
+BENCHMARK(BM_stencil_md_view_rows);
+BENCHMARK(BM_column_sums_raw);
+BENCHMARK(BM_column_sums_submd);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,86 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/bloom_filter.hpp>
+#include <boost/stl_interfaces/cuckoo_filter.hpp>
+#include "bench_data.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <vector>
+
+
+// These benchmarks check 64K keys, half of them present, against a
+// bloom_filter and a cuckoo_filter of 8M 64-bit keys, much larger than
+// the cache, as a dedup stage does: one contains(x) at a time, and with
+// the batch contains(first, last, out), which prefetches the slots of 32
+// keys before testing any of them.
+
+constexpr int filter_keys = 1 << 23;
+constexpr int queries = 1 << 16;
+
+std::uint64_t key(std::uint64_t i) { return i * 0x9e3779b97f4a7c15ull; }
+
+std::vector<std::uint64_t> const & query_keys()
+{
+    static auto const retval = [] {
+        std::vector<std::uint64_t> keys;
+        for (int x : bench_data::random_ints(queries, 2 * filter_keys, 1)) {
+            keys.push_back(key(std::uint64_t(x)));
+        }
+        return keys;
+    }();
+    return retval;
+}
+
+template<typename Filter>
+Filter const & filter()
+{
+    static auto const retval = [] {
+        Filter f(filter_keys);
+        for (int i = 0; i < filter_keys; ++i) {
+            f.insert(key(std::uint64_t(i)));
+        }
+        return f;
+    }();
+    return retval;
+}
+
+template<typename Filter>
+void BM_one_at_a_time(benchmark::State & state)
+{
+    auto const & f = filter<Filter>();
+    auto const & keys = query_keys();
+    std::vector<bool> found(keys.size());
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < keys.size(); ++i) {
+            found[i] = f.contains(keys[i]);
+        }
+        benchmark::ClobberMemory();
+    }
+}
+
+template<typename Filter>
+void BM_batch(benchmark::State & state)
+{
+    auto const & f = filter<Filter>();
+    auto const & keys = query_keys();
+    std::vector<bool> found(keys.size());
+    for (auto _ : state) {
+        f.contains(keys.begin(), keys.end(), found.begin());
+        benchmark::ClobberMemory();
+    }
+}
+
+using bloom = boost::stl_interfaces::bloom_filter<std::uint64_t>;
+using cuckoo = boost::stl_interfaces::cuckoo_filter<std::uint64_t>;
+
+BENCHMARK_TEMPLATE(BM_one_at_a_time, bloom)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_batch, bloom)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_one_at_a_time, cuckoo)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_batch, cuckoo)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,71 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/stl_interfaces/mmap_view.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cstdio>
+#include <fstream>
+#include <numeric>
+#include <vector>
+
+
+using boost::stl_interfaces::mmap_view;
+using boost::stl_interfaces::mmap_huge_page_align;
+using boost::stl_interfaces::mmap_sequential;
+using boost::stl_interfaces::mmap_willneed;
+
+
+// These benchmarks open a 64MB file of std::uint64_t records (which stays in
+// the page cache), and sum the records: read into a std::vector first, as
+// with a copy of the file, and through an mmap_view.
+
+char const * const path = "mmap_view_perf.bin";
+std::size_t const records = std::size_t(1) << 23;
+
+struct file
+{
+    file()
+    {
+        std::vector<std::uint64_t> v(records);
+        std::iota(v.begin(), v.end(), 0u);
+        std::ofstream ofs(path, std::ios::binary);
+        ofs.write(reinterpret_cast<char const *>(v.data()), v.size() * 8);
+    }
+    ~file() { std::remove(path); }
+};
+
+file const the_file;
+
+void BM_read_into_vector(benchmark::State & state)
+{
+    for (auto _ : state) {
+        std::ifstream ifs(path, std::ios::binary);
+        std::vector<std::uint64_t> v(records);
+        ifs.read(reinterpret_cast<char *>(v.data()), v.size() * 8);
+        benchmark::DoNotOptimize(
+            std::accumulate(v.begin(), v.end(), std::uint64_t(0)));
+    }
+}
+
+void BM_mmap_view(benchmark::State & state)
+{
+    for (auto _ : state) {
+        mmap_view<std::uint64_t> v(path, unsigned(state.range(0)));
+        benchmark::DoNotOptimize(
+            std::accumulate(v.begin(), v.end(), std::uint64_t(0)));
+    }
+}
+
+BENCHMARK(BM_read_into_vector)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_mmap_view)
+    ->Arg(0)
+    ->Arg(mmap_sequential | mmap_willneed)
+    ->Arg(mmap_huge_page_align)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
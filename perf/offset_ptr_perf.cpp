@@ -0,0 +1,127 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/offset_ptr.hpp>
+
+#include "bench_data.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <numeric>
+#include <vector>
+
+#include <cstring>
+
+
+using boost::stl_interfaces::offset_iterator;
+using boost::stl_interfaces::offset_ptr;
+using boost::stl_interfaces::offset_vector;
+
+
+// The sums show what the offset costs a scan: offset_vector's iterators
+// are plain pointers, and an offset_iterator adds its offset to its own
+// address on every dereference.  The hops pass a 64-level book from a
+// writer to a reader: once through a byte buffer, encoded and decoded on
+// each hop, and once by building the book in a shared block that the
+// reader reads in place.
+
+std::vector<int> const ints = bench_data::random_ints(1 << 20, 1000);
+
+void BM_sum_vector(benchmark::State & state)
+{
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            std::accumulate(ints.begin(), ints.end(), 0L));
+    }
+}
+void BM_sum_offset_vector(benchmark::State & state)
+{
+    std::vector<int> buffer(ints.size());
+    offset_vector<int> v(buffer.data(), buffer.size());
+    for (int x : ints) {
+        v.push_back(x);
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::accumulate(v.begin(), v.end(), 0L));
+    }
+}
+void BM_sum_offset_iterator(benchmark::State & state)
+{
+    offset_iterator<int const> const first(ints.data());
+    offset_iterator<int const> const last(ints.data() + ints.size());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::accumulate(first, last, 0L));
+    }
+}
+
+struct level
+{
+    long price;
+    long quantity;
+};
+int const book_size = 64;
+std::vector<int> const prices = bench_data::random_ints(book_size, 1000);
+
+void BM_hop_serialized(benchmark::State & state)
+{
+    std::vector<level> book;
+    std::vector<char> wire;
+    std::vector<level> received;
+    for (auto _ : state) {
+        book.clear();
+        for (int i = 0; i < book_size; ++i) {
+            book.push_back(level{prices[i], i});
+        }
+
+        wire.resize(sizeof(std::size_t) + book.size() * sizeof(level));
+        std::size_t const n = book.size();
+        std::memcpy(wire.data(), &n, sizeof(n));
+        std::memcpy(
+            wire.data() + sizeof(n), book.data(), n * sizeof(level));
+        benchmark::ClobberMemory();
+
+        std::size_t m = 0;
+        std::memcpy(&m, wire.data(), sizeof(m));
+        received.resize(m);
+        std::memcpy(
+            received.data(), wire.data() + sizeof(m), m * sizeof(level));
+        long total = 0;
+        for (auto const & l : received) {
+            total += l.price * l.quantity;
+        }
+        benchmark::DoNotOptimize(total);
+    }
+}
+void BM_hop_shared(benchmark::State & state)
+{
+    struct block
+    {
+        block() : book(buffer, book_size) {}
+        offset_vector<level> book;
+        level buffer[book_size];
+    };
+    block shared;
+    for (auto _ : state) {
+        shared.book.clear();
+        for (int i = 0; i < book_size; ++i) {
+            shared.book.push_back(level{prices[i], i});
+        }
+        benchmark::ClobberMemory();
+
+        long total = 0;
+        for (auto const & l : shared.book) {
+            total += l.price * l.quantity;
+        }
+        benchmark::DoNotOptimize(total);
+    }
+}
+
+BENCHMARK(BM_sum_vector);
+BENCHMARK(BM_sum_offset_vector);
+BENCHMARK(BM_sum_offset_iterator);
+BENCHMARK(BM_hop_serialized);
+BENCHMARK(BM_hop_shared);
+
+BENCHMARK_MAIN();
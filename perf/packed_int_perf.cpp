@@ -0,0 +1,117 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/stl_interfaces/packed_int_vector.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <vector>
+
+
+using boost::stl_interfaces::packed_int_vector;
+
+
+// These benchmarks unpack state.range(0) 12-bit elements into a
+// std::uint32_t buffer, one at a time with std::copy(), and 64 at a time
+// with the read_n() overload of copy().  BM_uint32_copy copies unpacked
+// std::uint32_ts, as a floor.  The pack benchmarks go the other way, and
+// the transform ones apply a function on the way out.
+
+packed_int_vector<12> values(int n)
+{
+    packed_int_vector<12> retval;
+    for (int i = 0; i < n; ++i) {
+        retval.push_back(i * 7 % 4096);
+    }
+    return retval;
+}
+
+void BM_unpack_per_element(benchmark::State & state)
+{
+    auto const v = values(state.range(0));
+    std::vector<std::uint32_t> out(v.size());
+    for (auto _ : state) {
+        std::copy(v.begin(), v.end(), out.begin());
+        benchmark::DoNotOptimize(out.data());
+    }
+}
+
+void BM_unpack_blocks(benchmark::State & state)
+{
+    auto const v = values(state.range(0));
+    std::vector<std::uint32_t> out(v.size());
+    for (auto _ : state) {
+        copy(v.begin(), v.end(), out.data());
+        benchmark::DoNotOptimize(out.data());
+    }
+}
+
+void BM_uint32_copy(benchmark::State & state)
+{
+    std::vector<std::uint32_t> const v(state.range(0), 7);
+    std::vector<std::uint32_t> out(v.size());
+    for (auto _ : state) {
+        std::copy(v.begin(), v.end(), out.begin());
+        benchmark::DoNotOptimize(out.data());
+    }
+}
+
+void BM_pack_per_element(benchmark::State & state)
+{
+    std::vector<std::uint32_t> const in(state.range(0), 99);
+    packed_int_vector<12> v(in.size());
+    for (auto _ : state) {
+        std::copy(in.begin(), in.end(), v.begin());
+        benchmark::DoNotOptimize(v.words());
+    }
+}
+
+void BM_pack_blocks(benchmark::State & state)
+{
+    std::vector<std::uint32_t> const in(state.range(0), 99);
+    packed_int_vector<12> v(in.size());
+    for (auto _ : state) {
+        copy(in.data(), in.data() + in.size(), v.begin());
+        benchmark::DoNotOptimize(v.words());
+    }
+}
+
+void BM_transform_per_element(benchmark::State & state)
+{
+    auto const v = values(state.range(0));
+    std::vector<std::uint32_t> out(v.size());
+    for (auto _ : state) {
+        std::transform(
+            v.begin(), v.end(), out.data(), [](std::uint32_t x) {
+                return x * 3 + 1;
+            });
+        benchmark::DoNotOptimize(out.data());
+    }
+}
+
+void BM_transform_blocks(benchmark::State & state)
+{
+    auto const v = values(state.range(0));
+    std::vector<std::uint32_t> out(v.size());
+    for (auto _ : state) {
+        boost::stl_interfaces::transform(
+            v.begin(), v.end(), out.data(), [](std::uint32_t x) {
+                return x * 3 + 1;
+            });
+        benchmark::DoNotOptimize(out.data());
+    }
+}
+
+BENCHMARK(BM_unpack_per_element)->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK(BM_unpack_blocks)->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK(BM_uint32_copy)->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK(BM_pack_per_element)->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK(BM_pack_blocks)->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK(BM_transform_per_element)->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK(BM_transform_blocks)->Arg(1 << 10)->Arg(1 << 20);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,177 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/parallel.hpp>
+#include <boost/stl_interfaces/strided_view.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <numeric>
+#include <vector>
+
+
+// These benchmarks compare the standard sequential algorithms with
+// parallel_transform() and parallel_reduce() on default_thread_pool(), over
+// contiguous iterators and over strided_iterators, which are
+// iterator_interface iterators that are not contiguous.  The scan
+// benchmarks turn 4M record lengths into the records' offsets, with
+// std::partial_sum() and with parallel_inclusive_scan() and
+// parallel_exclusive_scan().  The filter benchmarks keep the lengths under
+// 100, about half of them, at random, with std::copy_if() and with
+// parallel_copy_if().
+
+namespace bsi = boost::stl_interfaces;
+
+int const n = 1 << 22;
+std::vector<float> const input(n, 1.5f);
+
+struct f_
+{
+    float operator()(float x) const
+    {
+        return std::sqrt(x) * 1.25f + std::sin(x);
+    }
+};
+f_ const f;
+
+void BM_transform_std(benchmark::State & state)
+{
+    std::vector<float> output(n);
+    for (auto _ : state) {
+        std::transform(input.begin(), input.end(), output.begin(), f);
+        benchmark::DoNotOptimize(output.data());
+    }
+}
+
+void BM_transform_parallel(benchmark::State & state)
+{
+    std::vector<float> output(n);
+    for (auto _ : state) {
+        bsi::parallel_transform(
+            input.begin(), input.end(), output.begin(), f, 1 << 14);
+        benchmark::DoNotOptimize(output.data());
+    }
+}
+
+void BM_reduce_std(benchmark::State & state)
+{
+    for (auto _ : state) {
+        double sum =
+            std::accumulate(input.begin(), input.end(), 0.0, std::plus<>{});
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+void BM_reduce_parallel(benchmark::State & state)
+{
+    for (auto _ : state) {
+        double sum = bsi::parallel_reduce(
+            input.data(),
+            input.data() + n,
+            0.0,
+            std::plus<>{},
+            1 << 14);
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+void BM_strided_reduce_std(benchmark::State & state)
+{
+    auto const v = bsi::make_strided_view(input.data(), n / 2, 2);
+    for (auto _ : state) {
+        double sum = std::accumulate(v.begin(), v.end(), 0.0, std::plus<>{});
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+void BM_strided_reduce_parallel(benchmark::State & state)
+{
+    auto const v = bsi::make_strided_view(input.data(), n / 2, 2);
+    for (auto _ : state) {
+        double sum = bsi::parallel_reduce(
+            v.begin(), v.end(), 0.0, std::plus<>{}, 1 << 14);
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+std::vector<std::int32_t> const lengths = [] {
+    std::vector<std::int32_t> retval(n);
+    for (int i = 0; i < n; ++i) {
+        retval[i] = std::int32_t(i * 2654435761u % 200);
+    }
+    return retval;
+}();
+
+void BM_scan_std(benchmark::State & state)
+{
+    std::vector<std::int32_t> offsets(n);
+    for (auto _ : state) {
+        std::partial_sum(lengths.begin(), lengths.end(), offsets.begin());
+        benchmark::DoNotOptimize(offsets.data());
+    }
+}
+
+void BM_inclusive_scan_parallel(benchmark::State & state)
+{
+    std::vector<std::int32_t> offsets(n);
+    for (auto _ : state) {
+        bsi::parallel_inclusive_scan(
+            lengths.data(), lengths.data() + n, offsets.data());
+        benchmark::DoNotOptimize(offsets.data());
+    }
+}
+
+void BM_exclusive_scan_parallel(benchmark::State & state)
+{
+    std::vector<std::int32_t> offsets(n);
+    for (auto _ : state) {
+        bsi::parallel_exclusive_scan(
+            lengths.data(), lengths.data() + n, offsets.data(), 0);
+        benchmark::DoNotOptimize(offsets.data());
+    }
+}
+
+struct short_
+{
+    bool operator()(std::int32_t x) const { return x < 100; }
+};
+
+void BM_copy_if_std(benchmark::State & state)
+{
+    std::vector<std::int32_t> kept(n);
+    for (auto _ : state) {
+        auto const last = std::copy_if(
+            lengths.begin(), lengths.end(), kept.begin(), short_{});
+        benchmark::DoNotOptimize(last);
+    }
+}
+
+void BM_copy_if_parallel(benchmark::State & state)
+{
+    std::vector<std::int32_t> kept(n);
+    for (auto _ : state) {
+        auto const last = bsi::parallel_copy_if(
+            lengths.data(), lengths.data() + n, kept.data(), short_{});
+        benchmark::DoNotOptimize(last);
+    }
+}
+
+BENCHMARK(BM_transform_std)->UseRealTime();
+BENCHMARK(BM_transform_parallel)->UseRealTime();
+BENCHMARK(BM_reduce_std)->UseRealTime();
+BENCHMARK(BM_reduce_parallel)->UseRealTime();
+BENCHMARK(BM_strided_reduce_std)->UseRealTime();
+BENCHMARK(BM_strided_reduce_parallel)->UseRealTime();
+BENCHMARK(BM_scan_std)->UseRealTime();
+BENCHMARK(BM_inclusive_scan_parallel)->UseRealTime();
+BENCHMARK(BM_exclusive_scan_parallel)->UseRealTime();
+BENCHMARK(BM_copy_if_std)->UseRealTime();
+BENCHMARK(BM_copy_if_parallel)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,301 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include "bench_data.hpp"
+#include <boost/stl_interfaces/parallel.hpp>
+#include <boost/stl_interfaces/parallel_sort.hpp>
+#include <boost/stl_interfaces/segmented_vector.hpp>
+#include <boost/stl_interfaces/zip_view.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+
+// These benchmarks measure how parallel_for_each(), parallel_reduce(),
+// parallel_inclusive_scan() and parallel_sort() scale with the number of
+// threads, over three kinds of iterators: the pointers of a
+// std::vector<unsigned>, the zip_iterators of two of them, and the
+// iterators of the example segmented_vector<unsigned>, which are
+// iterator_interface iterators that are neither contiguous nor proxies.
+//
+// Each benchmark's arguments are the number of elements -- 4K, 64K, 1M
+// and 16M unsigned ints, which fit in the L1 cache, the L2 cache and the
+// last-level cache of a typical server core, and do not fit in any cache --
+// the grain size, and the number of threads, 1, 2, 4, ... up to
+// std::thread::hardware_concurrency().  A run with t threads uses a
+// thread_pool of t - 1 workers, since the calling thread does a share of
+// the work.  Only the algorithm is timed; restoring the input that sort()
+// sorted is not.
+//
+// Each benchmark with more than one thread reports its speedup over the
+// one-thread run of the same algorithm, iterators, size and grain size,
+// and its efficiency, the speedup divided by the number of threads.  The
+// one-thread runs come first, so these appear unless a --benchmark_filter
+// leaves the one-thread runs out.
+
+namespace bsi = boost::stl_interfaces;
+using bsi::segmented_vector;
+
+std::vector<unsigned> const & source(std::size_t n)
+{
+    static std::map<std::size_t, std::vector<unsigned>> sources;
+    auto & retval = sources[n];
+    if (retval.empty()) {
+        auto const ints = bench_data::random_ints(n, 1 << 20);
+        retval.assign(ints.begin(), ints.end());
+    }
+    return retval;
+}
+
+struct contiguous
+{
+    static constexpr char const * name = "contiguous";
+
+    explicit contiguous(std::vector<unsigned> const & src) :
+        in(src), out(src.size())
+    {}
+
+    auto first() { return in.begin(); }
+    auto last() { return in.end(); }
+    auto out_first() { return out.begin(); }
+    void reset(std::vector<unsigned> const & src)
+    {
+        std::copy(src.begin(), src.end(), in.begin());
+    }
+
+    static unsigned init() { return 0; }
+    using plus = std::plus<>;
+    struct mutate
+    {
+        void operator()(unsigned & x) const { x = x * 3 + 1; }
+    };
+
+    std::vector<unsigned> in;
+    std::vector<unsigned> out;
+};
+
+struct zip
+{
+    static constexpr char const * name = "zip";
+
+    explicit zip(std::vector<unsigned> const & src) :
+        a(src),
+        b(src.rbegin(), src.rend()),
+        out_a(src.size()),
+        out_b(src.size()),
+        in(bsi::make_zip_view(a, b)),
+        out(bsi::make_zip_view(out_a, out_b))
+    {}
+
+    auto first() { return in.begin(); }
+    auto last() { return in.end(); }
+    auto out_first() { return out.begin(); }
+    void reset(std::vector<unsigned> const & src)
+    {
+        std::copy(src.begin(), src.end(), a.begin());
+        std::copy(src.rbegin(), src.rend(), b.begin());
+    }
+
+    static std::tuple<unsigned, unsigned> init()
+    {
+        return std::tuple<unsigned, unsigned>(0, 0);
+    }
+    struct plus
+    {
+        template<typename T, typename U>
+        std::tuple<unsigned, unsigned>
+        operator()(T const & x, U const & y) const
+        {
+            return std::tuple<unsigned, unsigned>(
+                std::get<0>(x) + std::get<0>(y),
+                std::get<1>(x) + std::get<1>(y));
+        }
+    };
+    struct mutate
+    {
+        template<typename T>
+        void operator()(T && x) const
+        {
+            std::get<0>(x) += std::get<1>(x);
+        }
+    };
+
+    std::vector<unsigned> a;
+    std::vector<unsigned> b;
+    std::vector<unsigned> out_a;
+    std::vector<unsigned> out_b;
+    decltype(bsi::make_zip_view(a, b)) in;
+    decltype(bsi::make_zip_view(out_a, out_b)) out;
+};
+
+struct segmented
+{
+    static constexpr char const * name = "segmented";
+
+    explicit segmented(std::vector<unsigned> const & src) :
+        in(src.begin(), src.end()), out(src.size())
+    {}
+
+    auto first() { return in.begin(); }
+    auto last() { return in.end(); }
+    auto out_first() { return out.begin(); }
+    void reset(std::vector<unsigned> const & src)
+    {
+        std::copy(src.begin(), src.end(), in.begin());
+    }
+
+    static unsigned init() { return 0; }
+    using plus = contiguous::plus;
+    using mutate = contiguous::mutate;
+
+    segmented_vector<unsigned> in;
+    segmented_vector<unsigned> out;
+};
+
+struct for_each
+{
+    static constexpr char const * name = "for_each";
+    static constexpr bool resets = false;
+    template<typename Data>
+    static void
+    run(bsi::thread_pool & pool, Data & data, std::ptrdiff_t grain)
+    {
+        bsi::parallel_for_each(
+            pool,
+            data.first(),
+            data.last(),
+            typename Data::mutate{},
+            grain);
+    }
+};
+
+struct reduce
+{
+    static constexpr char const * name = "reduce";
+    static constexpr bool resets = false;
+    template<typename Data>
+    static void
+    run(bsi::thread_pool & pool, Data & data, std::ptrdiff_t grain)
+    {
+        benchmark::DoNotOptimize(bsi::parallel_reduce(
+            pool,
+            data.first(),
+            data.last(),
+            Data::init(),
+            typename Data::plus{},
+            grain));
+    }
+};
+
+struct scan
+{
+    static constexpr char const * name = "scan";
+    static constexpr bool resets = false;
+    template<typename Data>
+    static void
+    run(bsi::thread_pool & pool, Data & data, std::ptrdiff_t grain)
+    {
+        bsi::parallel_inclusive_scan(
+            pool,
+            data.first(),
+            data.last(),
+            data.out_first(),
+            typename Data::plus{},
+            grain);
+    }
+};
+
+struct sort
+{
+    static constexpr char const * name = "sort";
+    static constexpr bool resets = true;
+    template<typename Data>
+    static void
+    run(bsi::thread_pool & pool, Data & data, std::ptrdiff_t grain)
+    {
+        bsi::parallel_sort(
+            pool, data.first(), data.last(), std::less<>{}, grain);
+    }
+};
+
+template<typename Algorithm, typename Data>
+void BM_scaling(benchmark::State & state)
+{
+    // The one-thread time of each algorithm, data, size and grain size.
+    static std::map<std::string, double> one_thread_seconds;
+
+    std::size_t const n = state.range(0);
+    std::ptrdiff_t const grain = state.range(1);
+    auto const threads = unsigned(state.range(2));
+    auto const & src = source(n);
+    Data data(src);
+    bsi::thread_pool pool(threads - 1);
+
+    double seconds = 0;
+    for (auto _ : state) {
+        if (Algorithm::resets)
+            data.reset(src);
+        auto const start = std::chrono::steady_clock::now();
+        Algorithm::run(pool, data, grain);
+        auto const iteration_seconds =
+            std::chrono::duration<double>(
+                std::chrono::steady_clock::now() - start)
+                .count();
+        state.SetIterationTime(iteration_seconds);
+        seconds += iteration_seconds;
+    }
+    seconds /= double(state.iterations());
+
+    auto const key = std::string(Algorithm::name) + '/' + Data::name + '/' +
+                     std::to_string(n) + '/' + std::to_string(grain);
+    if (threads == 1) {
+        one_thread_seconds[key] = seconds;
+    } else {
+        auto const it = one_thread_seconds.find(key);
+        if (it != one_thread_seconds.end()) {
+            double const speedup = it->second / seconds;
+            state.counters["speedup"] = speedup;
+            state.counters["efficiency"] = speedup / threads;
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * std::int64_t(n));
+}
+
+void scaling_args(benchmark::internal::Benchmark * b)
+{
+    unsigned const max_threads =
+        (std::max)(std::thread::hardware_concurrency(), 1u);
+    for (int n : {1 << 12, 1 << 16, 1 << 20, 1 << 24}) {
+        for (int grain : {1 << 12, 1 << 16}) {
+            for (unsigned t = 1; t < max_threads; t *= 2) {
+                b->Args({n, grain, int(t)});
+            }
+            b->Args({n, grain, int(max_threads)});
+        }
+    }
+    b->ArgNames({"n", "grain", "threads"})->UseManualTime();
+    b->Unit(benchmark::kMicrosecond);
+}
+
+#define SCALING(algorithm)                                                     \
+    BENCHMARK_TEMPLATE(BM_scaling, algorithm, contiguous)                      \
+        ->Apply(scaling_args);                                                 \
+    BENCHMARK_TEMPLATE(BM_scaling, algorithm, zip)->Apply(scaling_args);       \
+    BENCHMARK_TEMPLATE(BM_scaling, algorithm, segmented)->Apply(scaling_args)
+
+SCALING(for_each);
+SCALING(reduce);
+SCALING(scan);
+SCALING(sort);
+
+BENCHMARK_MAIN();
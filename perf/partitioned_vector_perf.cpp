@@ -0,0 +1,98 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/parallel.hpp>
+#include <boost/stl_interfaces/partitioned_vector.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <numeric>
+#include <vector>
+
+
+// These benchmarks scan 16M ints (64MB) with 4 threads: a std::vector,
+// written by the main thread, with parallel_for_each() on a thread_pool;
+// and a partitioned_vector, each partition of which was written by the
+// thread that scans it, with parallel_for_each() on its partition_threads.
+// On a multi-socket machine, with the threads pinned to nodes, the second
+// reads only node-local memory.  They also sum the partitioned_vector on one
+// thread, through its iterators, which divide at every step, and with
+// segmented_accumulate(), which runs a pointer loop per partition.
+
+namespace bsi = boost::stl_interfaces;
+
+constexpr std::size_t size = 1 << 24;
+constexpr unsigned int threads = 4;
+
+void BM_vector_parallel_for_each(benchmark::State & state)
+{
+    bsi::thread_pool pool(threads - 1);
+    std::vector<int> v(size, 1);
+    for (auto _ : state) {
+        std::atomic<long> sum(0);
+        bsi::parallel_for_each(
+            pool,
+            v.begin(),
+            v.end(),
+            [&](int x) {
+                if (x == 2)
+                    sum += x;
+            },
+            1 << 16);
+        benchmark::DoNotOptimize(sum.load());
+    }
+}
+void BM_partitioned_parallel_for_each(benchmark::State & state)
+{
+    bsi::partition_threads home(threads);
+    bsi::partitioned_vector<int> v(home, size, 1);
+    for (auto _ : state) {
+        std::atomic<long> sum(0);
+        bsi::parallel_for_each(home, v, [&](int x) {
+            if (x == 2)
+                sum += x;
+        });
+        benchmark::DoNotOptimize(sum.load());
+    }
+}
+
+void BM_vector_accumulate(benchmark::State & state)
+{
+    std::vector<int> v(size, 1);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::accumulate(v.begin(), v.end(), 0L));
+    }
+}
+void BM_partitioned_accumulate(benchmark::State & state)
+{
+    bsi::partition_threads home(threads);
+    bsi::partitioned_vector<int> v(home, size, 1);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::accumulate(v.begin(), v.end(), 0L));
+    }
+}
+void BM_partitioned_segmented_accumulate(benchmark::State & state)
+{
+    bsi::partition_threads home(threads);
+    bsi::partitioned_vector<int> v(home, size, 1);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            bsi::segmented_accumulate(v.begin(), v.end(), 0L));
+    }
+}
+
+BENCHMARK(BM_vector_parallel_for_each)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK(BM_partitioned_parallel_for_each)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK(BM_vector_accumulate)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_partitioned_accumulate)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_partitioned_segmented_accumulate)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
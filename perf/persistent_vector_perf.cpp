@@ -0,0 +1,111 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/persistent_vector.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <numeric>
+#include <vector>
+
+
+// These benchmarks keep an undo history of a document of 64K ints, as an
+// editor does: each edit changes one element and keeps the previous
+// version, by copying a std::vector, or by set() on a persistent_vector.
+// The history holds the last 16 versions.  The others sum a version
+// sequentially, to show what the shared, 32-element leaves cost a reader:
+// through the leaf-caching iterators, with segmented_accumulate(), which
+// sums each leaf through pointers, and with operator[].
+
+constexpr int document_size = 1 << 16;
+constexpr int history_size = 16;
+
+std::vector<int> make_document()
+{
+    std::vector<int> retval(document_size);
+    std::iota(retval.begin(), retval.end(), 0);
+    return retval;
+}
+
+void BM_undo_history_vector(benchmark::State & state)
+{
+    std::vector<std::vector<int>> history(history_size, make_document());
+    std::size_t i = 0;
+    for (auto _ : state) {
+        auto & next = history[(i + 1) % history_size];
+        next = history[i % history_size];
+        next[(i * 7919) % document_size] = int(i);
+        ++i;
+    }
+    benchmark::DoNotOptimize(history.data());
+}
+
+void BM_undo_history_persistent(benchmark::State & state)
+{
+    auto const document = make_document();
+    using vec_type = boost::stl_interfaces::persistent_vector<int>;
+    std::vector<vec_type> history(
+        history_size, vec_type(document.begin(), document.end()));
+    std::size_t i = 0;
+    for (auto _ : state) {
+        history[(i + 1) % history_size] =
+            history[i % history_size].set((i * 7919) % document_size, int(i));
+        ++i;
+    }
+    benchmark::DoNotOptimize(history.data());
+}
+
+void BM_sum_vector(benchmark::State & state)
+{
+    auto const document = make_document();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            std::accumulate(document.begin(), document.end(), 0));
+    }
+}
+
+void BM_sum_persistent(benchmark::State & state)
+{
+    auto const document = make_document();
+    boost::stl_interfaces::persistent_vector<int> const v(
+        document.begin(), document.end());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::accumulate(v.begin(), v.end(), 0));
+    }
+}
+
+void BM_sum_persistent_segmented(benchmark::State & state)
+{
+    auto const document = make_document();
+    boost::stl_interfaces::persistent_vector<int> const v(
+        document.begin(), document.end());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(boost::stl_interfaces::segmented_accumulate(
+            v.begin(), v.end(), 0));
+    }
+}
+
+void BM_sum_persistent_indexed(benchmark::State & state)
+{
+    auto const document = make_document();
+    boost::stl_interfaces::persistent_vector<int> const v(
+        document.begin(), document.end());
+    for (auto _ : state) {
+        int sum = 0;
+        for (std::size_t i = 0, n = v.size(); i < n; ++i) {
+            sum += v[i];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+BENCHMARK(BM_undo_history_vector);
+BENCHMARK(BM_undo_history_persistent);
+BENCHMARK(BM_sum_vector);
+BENCHMARK(BM_sum_persistent);
+BENCHMARK(BM_sum_persistent_segmented);
+BENCHMARK(BM_sum_persistent_indexed);
+
+BENCHMARK_MAIN();
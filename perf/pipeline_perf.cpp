@@ -0,0 +1,121 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/range_adaptor_closure.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+
+// These benchmarks sum the first 1/4 of the scaled readings, among a large
+// array of sensor readings, that are valid and in range after scaling: a
+// filter | transform | filter | take pipeline.
+
+std::vector<int> make_readings()
+{
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> dist(-1000, 1000);
+    std::vector<int> retval(1 << 20);
+    for (auto & x : retval) {
+        x = dist(gen);
+    }
+    return retval;
+}
+
+std::vector<int> const readings = make_readings();
+std::ptrdiff_t const count = 1 << 17;
+
+struct valid
+{
+    bool operator()(int x) const { return 0 <= x; }
+};
+struct scale
+{
+    int operator()(int x) const { return 3 * x + 7; }
+};
+struct in_range
+{
+    bool operator()(int x) const { return x < 2000; }
+};
+
+// Each stage materialized into a vector, as code without lazy views does.
+void BM_materialized(benchmark::State & state)
+{
+    std::vector<int> valid_readings;
+    std::vector<int> scaled;
+    std::vector<int> in_range_readings;
+    for (auto _ : state) {
+        valid_readings.clear();
+        scaled.clear();
+        in_range_readings.clear();
+        std::copy_if(
+            readings.begin(),
+            readings.end(),
+            std::back_inserter(valid_readings),
+            valid{});
+        std::transform(
+            valid_readings.begin(),
+            valid_readings.end(),
+            std::back_inserter(scaled),
+            scale{});
+        std::copy_if(
+            scaled.begin(),
+            scaled.end(),
+            std::back_inserter(in_range_readings),
+            in_range{});
+        auto const n = (std::min)(
+            count, std::ptrdiff_t(in_range_readings.size()));
+        long sum = 0;
+        for (auto it = in_range_readings.begin(),
+                  last = in_range_readings.begin() + n;
+             it != last;
+             ++it) {
+            sum += *it;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+// Views nested one inside another, each iterator wrapping the last.
+void BM_nested(benchmark::State & state)
+{
+    namespace bsi = boost::stl_interfaces;
+    for (auto _ : state) {
+        auto valid_view = bsi::make_filter_view(readings, valid{});
+        auto scaled_view = bsi::make_transform_view(valid_view, scale{});
+        auto in_range_view = bsi::make_filter_view(scaled_view, in_range{});
+        auto v = in_range_view | bsi::take(count);
+        long sum = 0;
+        for (auto x : v) {
+            sum += x;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+// The pipeline, whose filter and transform stages are fused.
+void BM_pipeline(benchmark::State & state)
+{
+    namespace bsi = boost::stl_interfaces;
+    for (auto _ : state) {
+        auto v = readings | bsi::filter(valid{}) |
+                       bsi::transform(scale{}) | bsi::filter(in_range{}) |
+                       bsi::take(count);
+        long sum = 0;
+        for (auto x : v) {
+            sum += x;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+BENCHMARK(BM_materialized);
+BENCHMARK(BM_nested);
+BENCHMARK(BM_pipeline);
+
+BENCHMARK_MAIN();
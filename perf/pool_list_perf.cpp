@@ -0,0 +1,78 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/stl_interfaces/pool_forward_list.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <forward_list>
+
+
+using boost::stl_interfaces::pool_forward_list;
+
+
+// These benchmarks fill a list with state.range(0) elements and then clear
+// it, over and over, as an event queue does; std::forward_list allocates
+// and frees every node, and pool_forward_list reuses its slabs.
+
+template<typename List>
+void fill_and_clear(benchmark::State & state)
+{
+    List l;
+    for (auto _ : state) {
+        for (int i = 0, n = state.range(0); i < n; ++i) {
+            l.push_front(i);
+        }
+        benchmark::DoNotOptimize(l.front());
+        l.clear();
+    }
+}
+
+void BM_fill_clear_std_forward_list(benchmark::State & state)
+{
+    fill_and_clear<std::forward_list<int>>(state);
+}
+
+void BM_fill_clear_pool_forward_list(benchmark::State & state)
+{
+    fill_and_clear<pool_forward_list<int>>(state);
+}
+
+// Pushes and pops in steady state, one element at a time.
+template<typename List>
+void push_pop(benchmark::State & state)
+{
+    List l;
+    for (int i = 0, n = state.range(0); i < n; ++i) {
+        l.push_front(i);
+    }
+    for (auto _ : state) {
+        l.push_front(0);
+        benchmark::DoNotOptimize(l.front());
+        l.pop_front();
+    }
+}
+
+void BM_push_pop_std_forward_list(benchmark::State & state)
+{
+    push_pop<std::forward_list<int>>(state);
+}
+
+void BM_push_pop_pool_forward_list(benchmark::State & state)
+{
+    push_pop<pool_forward_list<int>>(state);
+}
+
+BENCHMARK(BM_fill_clear_std_forward_list)
+    ->RangeMultiplier(16)
+    ->Range(1 << 4, 1 << 16);
+BENCHMARK(BM_fill_clear_pool_forward_list)
+    ->RangeMultiplier(16)
+    ->Range(1 << 4, 1 << 16);
+BENCHMARK(BM_push_pop_std_forward_list)->Arg(1 << 10);
+BENCHMARK(BM_push_pop_pool_forward_list)->Arg(1 << 10);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,106 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/prefetch_view.hpp>
+
+#include "bench_data.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+
+// These benchmarks walk a linked list of 1M nodes, scattered at random
+// through an array of them, as the nodes of a long-lived order book are.
+// Each node holds an index into a 64MB table, and the walk sums the table
+// entries: two cache misses per element, one of them dependent on the
+// other.  The walks go through the plain node_iterator, and through a
+// prefetching_iterator that prefetches the nodes ahead.
+
+using node = bench_data::node<int>;
+
+struct node_iterator : boost::stl_interfaces::iterator_interface<
+                           node_iterator,
+                           std::forward_iterator_tag,
+                           int>
+{
+    node_iterator() noexcept : n_(nullptr) {}
+    node_iterator(node * n) noexcept : n_(n) {}
+
+    int & operator*() const noexcept { return n_->value_; }
+    node_iterator & operator++() noexcept
+    {
+        n_ = n_->next_;
+        return *this;
+    }
+    friend bool operator==(node_iterator lhs, node_iterator rhs) noexcept
+    {
+        return lhs.n_ == rhs.n_;
+    }
+
+    using base_type = boost::stl_interfaces::
+        iterator_interface<node_iterator, std::forward_iterator_tag, int>;
+    using base_type::operator++;
+
+private:
+    node * n_;
+};
+
+constexpr int list_size = 1 << 20;
+constexpr int table_size = 1 << 24;
+
+struct fixture
+{
+    fixture() :
+        list(bench_data::random_linked_nodes(list_size, table_size, 7)),
+        table(table_size, 1),
+        head(list.head)
+    {}
+
+    bench_data::linked_nodes<int> list;
+    std::vector<int> table;
+    node * head;
+};
+
+fixture const & data()
+{
+    static fixture const retval;
+    return retval;
+}
+
+void BM_walk(benchmark::State & state)
+{
+    auto const & d = data();
+    node_iterator const first(d.head);
+    node_iterator const last;
+    for (auto _ : state) {
+        long sum = 0;
+        for (auto it = first; it != last; ++it) {
+            sum += d.table[*it];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+template<int Distance>
+void BM_walk_prefetch_nodes(benchmark::State & state)
+{
+    auto const & d = data();
+    boost::stl_interfaces::prefetch_view<node_iterator, Distance> const v(
+        d.head, node_iterator());
+    for (auto _ : state) {
+        long sum = 0;
+        for (int key : v) {
+            sum += d.table[key];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+BENCHMARK(BM_walk);
+BENCHMARK_TEMPLATE(BM_walk_prefetch_nodes, 4);
+BENCHMARK_TEMPLATE(BM_walk_prefetch_nodes, 16);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,107 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/iterator_interface.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <numeric>
+#include <vector>
+
+
+// These benchmarks time it->member on proxy iterators, with
+// proxy_arrow_result (which moves *it into itself) and with
+// in_place_proxy_arrow_result (which is initialized by *it directly).
+
+namespace bsi = boost::stl_interfaces;
+
+// A reference to a row of eight int columns.
+struct wide_ref
+{
+    int & value;
+    int &c1, &c2, &c3, &c4, &c5, &c6, &c7;
+};
+
+// A reference to a row that also keeps the storage it refers to alive, like
+// a pinned page in a buffer pool.  Moving it is not free.
+struct pinned_ref
+{
+    std::shared_ptr<int> page;
+    int & value;
+};
+
+template<typename Reference>
+Reference make_ref(int * p, std::shared_ptr<int> const & page);
+
+template<>
+wide_ref make_ref<wide_ref>(int * p, std::shared_ptr<int> const &)
+{
+    return wide_ref{p[0], p[1], p[2], p[3], p[4], p[5], p[6], p[7]};
+}
+template<>
+pinned_ref make_ref<pinned_ref>(int * p, std::shared_ptr<int> const & page)
+{
+    return pinned_ref{page, *p};
+}
+
+template<typename Reference, typename Pointer>
+struct row_iter : bsi::iterator_interface<
+                      row_iter<Reference, Pointer>,
+                      std::random_access_iterator_tag,
+                      int,
+                      Reference,
+                      Pointer>
+{
+    row_iter() noexcept : it_(nullptr) {}
+    row_iter(int * it, std::shared_ptr<int> const * page) noexcept :
+        it_(it),
+        page_(page)
+    {}
+
+    Reference operator*() const { return make_ref<Reference>(it_, *page_); }
+    row_iter & operator+=(std::ptrdiff_t i) noexcept
+    {
+        it_ += 8 * i;
+        return *this;
+    }
+    friend std::ptrdiff_t operator-(row_iter lhs, row_iter rhs) noexcept
+    {
+        return (lhs.it_ - rhs.it_) / 8;
+    }
+
+private:
+    int * it_;
+    std::shared_ptr<int> const * page_;
+};
+
+template<typename Reference, template<class> class Arrow>
+void BM_arrow(benchmark::State & state)
+{
+    using iter = row_iter<Reference, Arrow<Reference>>;
+    std::vector<int> values(state.range(0) * 8);
+    std::iota(values.begin(), values.end(), 0);
+    auto const page = std::make_shared<int>(0);
+    for (auto _ : state) {
+        iter first(values.data(), &page);
+        iter const last(values.data() + values.size(), &page);
+        long sum = 0;
+        for (; first != last; ++first) {
+            sum += first->value;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_arrow, wide_ref, bsi::proxy_arrow_result)
+    ->Range(1 << 10, 1 << 14);
+BENCHMARK_TEMPLATE(BM_arrow, wide_ref, bsi::in_place_proxy_arrow_result)
+    ->Range(1 << 10, 1 << 14);
+BENCHMARK_TEMPLATE(BM_arrow, pinned_ref, bsi::proxy_arrow_result)
+    ->Range(1 << 10, 1 << 14);
+BENCHMARK_TEMPLATE(BM_arrow, pinned_ref, bsi::in_place_proxy_arrow_result)
+    ->Range(1 << 10, 1 << 14);
+
+BENCHMARK_MAIN();
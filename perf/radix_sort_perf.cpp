@@ -0,0 +1,132 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/packed_int_vector.hpp>
+#include <boost/stl_interfaces/radix_sort.hpp>
+
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+
+// These benchmarks sort 1M integer IDs -- 32-bit, 64-bit IDs below 2^24,
+// IDs in a packed container, and IDs below 256 -- with std::sort(), and
+// with radix_sort(), parallel_radix_sort() and counting_sort().
+
+namespace bsi = boost::stl_interfaces;
+using bsi::packed_int_vector;
+
+constexpr std::size_t size = 1 << 20;
+
+template<typename T>
+std::vector<T> make_ids(std::uint64_t max)
+{
+    std::mt19937_64 gen(42);
+    std::uniform_int_distribution<std::uint64_t> dist(0, max);
+    std::vector<T> retval(size);
+    for (auto & x : retval) {
+        x = T(dist(gen));
+    }
+    return retval;
+}
+
+std::vector<std::uint32_t> const ids32 = make_ids<std::uint32_t>(~0u);
+std::vector<std::uint64_t> const ids64 = make_ids<std::uint64_t>(1 << 24);
+std::vector<std::uint32_t> const small_ids = make_ids<std::uint32_t>(255);
+
+template<typename T>
+void sort_benchmark(
+    benchmark::State & state, std::vector<T> const & input, int which)
+{
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto v = input;
+        state.ResumeTiming();
+        if (which == 0)
+            std::sort(v.begin(), v.end());
+        else if (which == 1)
+            bsi::radix_sort(v.begin(), v.end());
+        else if (which == 2)
+            bsi::parallel_radix_sort(v.begin(), v.end());
+        else
+            bsi::counting_sort(v.begin(), v.end(), 256);
+        benchmark::DoNotOptimize(v.data());
+    }
+}
+
+void BM_std_sort_32(benchmark::State & state)
+{
+    sort_benchmark(state, ids32, 0);
+}
+void BM_radix_sort_32(benchmark::State & state)
+{
+    sort_benchmark(state, ids32, 1);
+}
+void BM_parallel_radix_sort_32(benchmark::State & state)
+{
+    sort_benchmark(state, ids32, 2);
+}
+
+void BM_std_sort_64(benchmark::State & state)
+{
+    sort_benchmark(state, ids64, 0);
+}
+void BM_radix_sort_64(benchmark::State & state)
+{
+    sort_benchmark(state, ids64, 1);
+}
+
+void BM_std_sort_small(benchmark::State & state)
+{
+    sort_benchmark(state, small_ids, 0);
+}
+void BM_radix_sort_small(benchmark::State & state)
+{
+    sort_benchmark(state, small_ids, 1);
+}
+void BM_counting_sort_small(benchmark::State & state)
+{
+    sort_benchmark(state, small_ids, 3);
+}
+
+packed_int_vector<24> const packed(ids64.begin(), ids64.end());
+
+void BM_std_sort_packed(benchmark::State & state)
+{
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto v = packed;
+        state.ResumeTiming();
+        std::sort(v.begin(), v.end());
+        benchmark::DoNotOptimize(v.front());
+    }
+}
+void BM_radix_sort_packed(benchmark::State & state)
+{
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto v = packed;
+        state.ResumeTiming();
+        bsi::radix_sort(v.begin(), v.end());
+        benchmark::DoNotOptimize(v.front());
+    }
+}
+
+BENCHMARK(BM_std_sort_32)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_radix_sort_32)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_parallel_radix_sort_32)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_std_sort_64)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_radix_sort_64)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_std_sort_small)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_radix_sort_small)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_counting_sort_small)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_std_sort_packed)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_radix_sort_packed)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
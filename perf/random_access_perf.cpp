@@ -0,0 +1,317 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/iterator_interface.hpp>
+#include <boost/stl_interfaces/pointer_iterator_interface.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+
+// These benchmarks compare std algorithms over random access iterators
+// generated by iterator_interface against the same algorithms over int * and
+// over a hand-written iterator that implements every operation directly.  If
+// iterator_interface is doing its job, all of them should produce the same
+// numbers.
+
+// A random access iterator that uses none of the library.  Every operation is
+// written out by hand, the way one would without iterator_interface.
+struct hand_written_iter
+{
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = int;
+    using difference_type = std::ptrdiff_t;
+    using pointer = int *;
+    using reference = int &;
+
+    hand_written_iter() noexcept {}
+    hand_written_iter(int * it) noexcept : it_(it) {}
+
+    reference operator*() const noexcept { return *it_; }
+    pointer operator->() const noexcept { return it_; }
+    reference operator[](difference_type n) const noexcept { return it_[n]; }
+
+    hand_written_iter & operator++() noexcept
+    {
+        ++it_;
+        return *this;
+    }
+    hand_written_iter operator++(int)noexcept
+    {
+        hand_written_iter retval = *this;
+        ++it_;
+        return retval;
+    }
+    hand_written_iter & operator--() noexcept
+    {
+        --it_;
+        return *this;
+    }
+    hand_written_iter operator--(int)noexcept
+    {
+        hand_written_iter retval = *this;
+        --it_;
+        return retval;
+    }
+    hand_written_iter & operator+=(difference_type n) noexcept
+    {
+        it_ += n;
+        return *this;
+    }
+    hand_written_iter & operator-=(difference_type n) noexcept
+    {
+        it_ -= n;
+        return *this;
+    }
+
+    friend hand_written_iter
+    operator+(hand_written_iter it, difference_type n) noexcept
+    {
+        return it += n;
+    }
+    friend hand_written_iter
+    operator+(difference_type n, hand_written_iter it) noexcept
+    {
+        return it += n;
+    }
+    friend hand_written_iter
+    operator-(hand_written_iter it, difference_type n) noexcept
+    {
+        return it -= n;
+    }
+    friend difference_type
+    operator-(hand_written_iter lhs, hand_written_iter rhs) noexcept
+    {
+        return lhs.it_ - rhs.it_;
+    }
+
+    friend bool operator==(hand_written_iter lhs, hand_written_iter rhs) noexcept
+    {
+        return lhs.it_ == rhs.it_;
+    }
+    friend bool operator!=(hand_written_iter lhs, hand_written_iter rhs) noexcept
+    {
+        return lhs.it_ != rhs.it_;
+    }
+    friend bool operator<(hand_written_iter lhs, hand_written_iter rhs) noexcept
+    {
+        return lhs.it_ < rhs.it_;
+    }
+    friend bool operator<=(hand_written_iter lhs, hand_written_iter rhs) noexcept
+    {
+        return lhs.it_ <= rhs.it_;
+    }
+    friend bool operator>(hand_written_iter lhs, hand_written_iter rhs) noexcept
+    {
+        return lhs.it_ > rhs.it_;
+    }
+    friend bool operator>=(hand_written_iter lhs, hand_written_iter rhs) noexcept
+    {
+        return lhs.it_ >= rhs.it_;
+    }
+
+private:
+    int * it_;
+};
+
+// The same as basic_random_access_iter in test/random_access.cpp: the user
+// provides operator*(), operator+=(), and operator-().
+struct v1_random_access_iter : boost::stl_interfaces::v1::iterator_interface<
+                                   v1_random_access_iter,
+                                   std::random_access_iterator_tag,
+                                   int>
+{
+    v1_random_access_iter() noexcept {}
+    v1_random_access_iter(int * it) noexcept : it_(it) {}
+
+    int & operator*() const noexcept { return *it_; }
+    v1_random_access_iter & operator+=(std::ptrdiff_t i) noexcept
+    {
+        it_ += i;
+        return *this;
+    }
+    friend std::ptrdiff_t
+    operator-(v1_random_access_iter lhs, v1_random_access_iter rhs) noexcept
+    {
+        return lhs.it_ - rhs.it_;
+    }
+
+private:
+    int * it_;
+};
+
+// The same as basic_adapted_random_access_iter in test/random_access.cpp:
+// everything goes through access::base() and base_reference().
+struct v1_adapted_random_access_iter
+    : boost::stl_interfaces::v1::iterator_interface<
+          v1_adapted_random_access_iter,
+          std::random_access_iterator_tag,
+          int>
+{
+    v1_adapted_random_access_iter() noexcept {}
+    v1_adapted_random_access_iter(int * it) noexcept : it_(it) {}
+
+private:
+    friend boost::stl_interfaces::access;
+    int *& base_reference() noexcept { return it_; }
+    int * base_reference() const noexcept { return it_; }
+
+    int * it_;
+};
+
+// The same iterator again, with the pointer stored and operated on by
+// pointer_iterator_interface.  Its operations are one call deep, which is
+// what matters in unoptimized builds.
+struct v1_pointer_iter : boost::stl_interfaces::v1::pointer_iterator_interface<
+                             v1_pointer_iter,
+                             int,
+                             std::random_access_iterator_tag>
+{
+    using pointer_iterator_interface::pointer_iterator_interface;
+};
+
+#if 201703L < __cplusplus && defined(__cpp_lib_concepts) ||                    \
+    201703L <= __cplusplus && __has_include(<stl2/ranges.hpp>) &&              \
+        !defined(BOOST_STL_INTERFACES_DISABLE_CMCSTL2)
+#define BOOST_STL_INTERFACES_PERF_V2 1
+
+// The v2 equivalents of the two iterators above; see
+// test/v2_random_access.cpp.
+struct v2_random_access_iter : boost::stl_interfaces::v2::iterator_interface<
+                                   v2_random_access_iter,
+                                   std::random_access_iterator_tag,
+                                   int>
+{
+    v2_random_access_iter() noexcept {}
+    v2_random_access_iter(int * it) noexcept : it_(it) {}
+
+    int & operator*() const noexcept { return *it_; }
+    v2_random_access_iter & operator+=(std::ptrdiff_t i) noexcept
+    {
+        it_ += i;
+        return *this;
+    }
+    friend std::ptrdiff_t
+    operator-(v2_random_access_iter lhs, v2_random_access_iter rhs) noexcept
+    {
+        return lhs.it_ - rhs.it_;
+    }
+
+private:
+    int * it_;
+};
+
+struct v2_adapted_random_access_iter
+    : boost::stl_interfaces::v2::iterator_interface<
+          v2_adapted_random_access_iter,
+          std::random_access_iterator_tag,
+          int>
+{
+    v2_adapted_random_access_iter() noexcept {}
+    v2_adapted_random_access_iter(int * it) noexcept : it_(it) {}
+
+private:
+    friend boost::stl_interfaces::access;
+    int *& base_reference() noexcept { return it_; }
+    int * base_reference() const noexcept { return it_; }
+
+    int * it_;
+};
+#endif
+
+
+std::vector<int> random_ints(std::ptrdiff_t n)
+{
+    std::mt19937 g(42);
+    std::uniform_int_distribution<int> dist;
+    std::vector<int> retval(n);
+    std::generate(retval.begin(), retval.end(), [&] { return dist(g); });
+    return retval;
+}
+
+template<typename Iter>
+void BM_sort(benchmark::State & state)
+{
+    std::vector<int> const ints = random_ints(state.range(0));
+    std::vector<int> buf(ints.size());
+    for (auto _ : state) {
+        std::copy(ints.begin(), ints.end(), buf.begin());
+        std::sort(Iter(buf.data()), Iter(buf.data() + buf.size()));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template<typename Iter>
+void BM_copy(benchmark::State & state)
+{
+    std::vector<int> const ints = random_ints(state.range(0));
+    std::vector<int> src = ints;
+    std::vector<int> dst(ints.size());
+    for (auto _ : state) {
+        std::copy(
+            Iter(src.data()), Iter(src.data() + src.size()), Iter(dst.data()));
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(
+        state.iterations() * state.range(0) * int64_t(sizeof(int)));
+}
+
+template<typename Iter>
+void BM_accumulate(benchmark::State & state)
+{
+    std::vector<int> ints = random_ints(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::accumulate(
+            Iter(ints.data()), Iter(ints.data() + ints.size()), 0u));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template<typename Iter>
+void BM_lower_bound(benchmark::State & state)
+{
+    std::vector<int> ints = random_ints(state.range(0));
+    std::sort(ints.begin(), ints.end());
+    std::vector<int> const keys = random_ints(1024);
+    Iter const first(ints.data());
+    Iter const last(ints.data() + ints.size());
+    for (auto _ : state) {
+        for (auto key : keys) {
+            benchmark::DoNotOptimize(std::lower_bound(first, last, key));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * int64_t(keys.size()));
+}
+
+#define BOOST_STL_INTERFACES_PERF_ITERATOR(iter)                               \
+    BENCHMARK_TEMPLATE(BM_sort, iter)                                          \
+        ->RangeMultiplier(32)                                                  \
+        ->Range(1 << 10, 1 << 20);                                             \
+    BENCHMARK_TEMPLATE(BM_copy, iter)                                          \
+        ->RangeMultiplier(32)                                                  \
+        ->Range(1 << 10, 1 << 20);                                             \
+    BENCHMARK_TEMPLATE(BM_accumulate, iter)                                    \
+        ->RangeMultiplier(32)                                                  \
+        ->Range(1 << 10, 1 << 20);                                             \
+    BENCHMARK_TEMPLATE(BM_lower_bound, iter)                                   \
+        ->RangeMultiplier(32)                                                  \
+        ->Range(1 << 10, 1 << 20)
+
+BOOST_STL_INTERFACES_PERF_ITERATOR(int *);
+BOOST_STL_INTERFACES_PERF_ITERATOR(hand_written_iter);
+BOOST_STL_INTERFACES_PERF_ITERATOR(v1_random_access_iter);
+BOOST_STL_INTERFACES_PERF_ITERATOR(v1_adapted_random_access_iter);
+BOOST_STL_INTERFACES_PERF_ITERATOR(v1_pointer_iter);
+#if BOOST_STL_INTERFACES_PERF_V2
+BOOST_STL_INTERFACES_PERF_ITERATOR(v2_random_access_iter);
+BOOST_STL_INTERFACES_PERF_ITERATOR(v2_adapted_random_access_iter);
+#endif
+
+BENCHMARK_MAIN();
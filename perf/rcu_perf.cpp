@@ -0,0 +1,68 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/rcu_container.hpp>
+#include "bench_data.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <shared_mutex>
+#include <vector>
+
+
+// These benchmarks look up keys in a routing table of 4K sorted int keys,
+// on 1 and 4 threads, as a service reading its configuration does: under a
+// std::shared_timed_mutex's shared lock, and in an rcu_container's view.
+// Each lookup takes the lock or the view anew.  Nothing updates the table;
+// an update only makes the shared lock's readers wait.
+
+constexpr int table_size = 1 << 12;
+
+std::vector<int> make_table()
+{
+    auto retval = bench_data::random_ints(table_size, 1 << 30, 1);
+    std::sort(retval.begin(), retval.end());
+    return retval;
+}
+
+std::vector<int> const & keys()
+{
+    static auto const retval = bench_data::random_ints(1 << 10, 1 << 30, 2);
+    return retval;
+}
+
+std::vector<int> mutex_table = make_table();
+std::shared_timed_mutex table_mutex;
+
+void BM_shared_mutex(benchmark::State & state)
+{
+    auto const & k = keys();
+    std::size_t i = 0;
+    for (auto _ : state) {
+        std::shared_lock<std::shared_timed_mutex> lock(table_mutex);
+        benchmark::DoNotOptimize(*std::lower_bound(
+            mutex_table.begin(), mutex_table.end(), k[i++ % k.size()]));
+    }
+}
+
+boost::stl_interfaces::rcu_container<std::vector<int>> rcu_table(
+    make_table());
+
+void BM_rcu(benchmark::State & state)
+{
+    auto const & k = keys();
+    std::size_t i = 0;
+    for (auto _ : state) {
+        auto const table = rcu_table.read();
+        benchmark::DoNotOptimize(*std::lower_bound(
+            table.begin(), table.end(), k[i++ % k.size()]));
+    }
+}
+
+BENCHMARK(BM_shared_mutex)->Threads(1)->Threads(4);
+BENCHMARK(BM_rcu)->Threads(1)->Threads(4);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,74 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/stl_interfaces/record_view.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+
+using boost::stl_interfaces::record_view;
+
+
+// These benchmarks parse a buffer of 64K length-prefixed records of 0-199
+// bytes each, and sum the first byte of each non-empty record: with the
+// usual parser loop that copies each record into a std::string, and with
+// record_view.
+
+std::vector<unsigned char> make_buffer()
+{
+    std::mt19937 gen(9);
+    std::vector<unsigned char> retval;
+    for (int i = 0; i < 1 << 16; ++i) {
+        std::uint32_t const length = gen() % 200;
+        auto const p = reinterpret_cast<unsigned char const *>(&length);
+        retval.insert(retval.end(), p, p + 4);
+        retval.insert(retval.end(), length, (unsigned char)(i));
+    }
+    return retval;
+}
+
+std::vector<unsigned char> const buffer = make_buffer();
+
+void BM_copy_to_strings(benchmark::State & state)
+{
+    for (auto _ : state) {
+        unsigned sum = 0;
+        std::size_t i = 0;
+        while (i + 4 <= buffer.size()) {
+            std::uint32_t length;
+            std::memcpy(&length, &buffer[i], 4);
+            if (buffer.size() - i - 4 < length)
+                break;
+            std::string const record(
+                reinterpret_cast<char const *>(&buffer[i + 4]), length);
+            if (!record.empty())
+                sum += (unsigned char)record[0];
+            i += 4 + length;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+void BM_record_view(benchmark::State & state)
+{
+    for (auto _ : state) {
+        unsigned sum = 0;
+        for (auto record : record_view<>(buffer.data(), buffer.size())) {
+            if (!record.empty())
+                sum += record[0];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+BENCHMARK(BM_copy_to_strings);
+BENCHMARK(BM_record_view);
+
+BENCHMARK_MAIN();
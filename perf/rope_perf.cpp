@@ -0,0 +1,93 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/rope.hpp>
+
+#include "bench_data.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <numeric>
+#include <string>
+#include <vector>
+
+
+using boost::stl_interfaces::rope;
+
+
+// The edit benchmarks make 1K edits at random positions in a 4MB buffer of
+// chars -- each one inserts 16 chars, or erases 16 -- as a document editor
+// does.  The scan benchmarks count the newlines in the buffer, element by
+// element through the iterators, and a leaf at a time with
+// segmented_accumulate().
+
+constexpr int buffer_size = 1 << 22;
+constexpr int edits = 1 << 10;
+
+std::vector<int> const positions =
+    bench_data::random_ints(edits, buffer_size - 16);
+std::string const snippet = "inserted text.\n ";
+
+template<typename Container>
+Container make_buffer()
+{
+    auto const ints = bench_data::random_ints(buffer_size, 64, 2);
+    Container retval;
+    for (int x : ints) {
+        retval.push_back(x ? char('a' + x % 26) : '\n');
+    }
+    return retval;
+}
+
+template<typename Container>
+void BM_edit(benchmark::State & state)
+{
+    auto c = make_buffer<Container>();
+    bool insert = true;
+    for (auto _ : state) {
+        for (int pos : positions) {
+            auto const it = c.begin() + pos;
+            if (insert)
+                c.insert(it, snippet.begin(), snippet.end());
+            else
+                c.erase(it, it + snippet.size());
+            insert = !insert;
+        }
+        benchmark::DoNotOptimize(&c);
+    }
+}
+
+template<typename Container>
+void BM_scan(benchmark::State & state)
+{
+    auto const c = make_buffer<Container>();
+    for (auto _ : state) {
+        int n = 0;
+        for (char x : c) {
+            n += x == '\n';
+        }
+        benchmark::DoNotOptimize(n);
+    }
+}
+
+void BM_scan_rope_segmented(benchmark::State & state)
+{
+    auto const c = make_buffer<rope<char>>();
+    for (auto _ : state) {
+        int const n = boost::stl_interfaces::segmented_accumulate(
+            c.begin(), c.end(), 0, [](int n, char x) {
+                return n + (x == '\n');
+            });
+        benchmark::DoNotOptimize(n);
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_edit, std::vector<char>);
+BENCHMARK_TEMPLATE(BM_edit, rope<char>);
+BENCHMARK_TEMPLATE(BM_scan, std::vector<char>);
+BENCHMARK_TEMPLATE(BM_scan, rope<char>);
+BENCHMARK(BM_scan_rope_segmented);
+
+BENCHMARK_MAIN();
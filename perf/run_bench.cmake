@@ -0,0 +1,59 @@
+# Usage:
+#
+#     cmake -DEXE=<perf executable> -DOUTPUT=<file.json>
+#           [-DSOURCE_DIR=<repo>] [-DFILTER=<regex>] [-DREPETITIONS=<n>]
+#           -P run_bench.cmake
+#
+# Runs one perf executable, and writes its results to OUTPUT as Google
+# Benchmark JSON.  The JSON context records the commit of SOURCE_DIR (with
+# "-dirty" appended if the tree has changes), and the bench_data version of
+# the datasets; with REPETITIONS greater than 1, only the mean, median, and
+# standard deviation of each benchmark are written.  If no benchmark matches
+# FILTER, OUTPUT is not written.
+
+foreach(var EXE OUTPUT)
+    if (NOT DEFINED ${var})
+        message(FATAL_ERROR "run_bench.cmake requires -D${var}=...")
+    endif ()
+endforeach()
+if (NOT DEFINED REPETITIONS)
+    set(REPETITIONS 1)
+endif ()
+
+set(commit unknown)
+if (DEFINED SOURCE_DIR)
+    execute_process(
+        COMMAND git describe --always --dirty --abbrev=12
+        WORKING_DIRECTORY ${SOURCE_DIR}
+        OUTPUT_VARIABLE git_output
+        OUTPUT_STRIP_TRAILING_WHITESPACE
+        RESULT_VARIABLE git_result
+        ERROR_QUIET)
+    if (git_result EQUAL 0)
+        set(commit ${git_output})
+    endif ()
+endif ()
+
+set(args
+    --benchmark_out=${OUTPUT}
+    --benchmark_out_format=json
+    --benchmark_context=git_commit=${commit}
+    --benchmark_repetitions=${REPETITIONS})
+if (1 LESS REPETITIONS)
+    list(APPEND args --benchmark_report_aggregates_only=true)
+endif ()
+if (DEFINED FILTER AND NOT FILTER STREQUAL "")
+    list(APPEND args --benchmark_filter=${FILTER})
+endif ()
+
+message(STATUS "${EXE} -> ${OUTPUT}")
+execute_process(COMMAND ${EXE} ${args} RESULT_VARIABLE result)
+if (NOT result EQUAL 0)
+    message(FATAL_ERROR "${EXE} failed: ${result}")
+endif ()
+
+# An executable none of whose benchmarks match FILTER writes nothing.
+file(READ ${OUTPUT} content LIMIT 1)
+if (content STREQUAL "")
+    file(REMOVE ${OUTPUT})
+endif ()
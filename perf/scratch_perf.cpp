@@ -0,0 +1,106 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/parallel_sort.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+
+// A request handler that sorts a small batch of IDs many times, as each
+// request does: BM_*_new takes the algorithms' scratch buffers from
+// operator new, and BM_*_arena from a bump arena that is reset after each
+// request, under a scratch_scope.  The sizes are the number of IDs per
+// request.
+
+namespace bsi = boost::stl_interfaces;
+
+std::vector<std::uint32_t> make_ids(std::size_t n)
+{
+    std::mt19937 gen(42);
+    std::vector<std::uint32_t> retval(n);
+    for (auto & x : retval) {
+        x = gen();
+    }
+    return retval;
+}
+
+// A bump arena, with the members of std::pmr::memory_resource.
+struct request_arena
+{
+    explicit request_arena(std::size_t capacity) : buf_(capacity), used_(0)
+    {}
+
+    void * allocate(std::size_t bytes, std::size_t alignment)
+    {
+        std::size_t const first =
+            (used_ + alignment - 1) / alignment * alignment;
+        if (buf_.size() < first + bytes)
+            throw std::bad_alloc();
+        used_ = first + bytes;
+        return buf_.data() + first;
+    }
+    void deallocate(void *, std::size_t, std::size_t) noexcept {}
+    void reset() noexcept { used_ = 0; }
+
+private:
+    std::vector<unsigned char> buf_;
+    std::size_t used_;
+};
+
+template<bool Arena, typename Sort>
+void bench(benchmark::State & state, Sort sort)
+{
+    auto const ids = make_ids(state.range(0));
+    std::vector<std::uint32_t> v(ids.size());
+    request_arena arena(64 * ids.size() + 4096);
+    for (auto _ : state) {
+        std::copy(ids.begin(), ids.end(), v.begin());
+        if (Arena) {
+            bsi::scratch_scope scope(arena);
+            sort(v);
+            arena.reset();
+        } else {
+            sort(v);
+        }
+        benchmark::DoNotOptimize(v.data());
+    }
+}
+
+auto const radix = [](std::vector<std::uint32_t> & v) {
+    bsi::radix_sort(v.begin(), v.end());
+};
+auto const by_key = [](std::vector<std::uint32_t> & v) {
+    bsi::parallel_sort_by_key(
+        v.begin(), v.end(), [](std::uint32_t x) { return x >> 8; });
+};
+
+void BM_radix_sort_new(benchmark::State & state)
+{
+    bench<false>(state, radix);
+}
+void BM_radix_sort_arena(benchmark::State & state)
+{
+    bench<true>(state, radix);
+}
+void BM_sort_by_key_new(benchmark::State & state)
+{
+    bench<false>(state, by_key);
+}
+void BM_sort_by_key_arena(benchmark::State & state)
+{
+    bench<true>(state, by_key);
+}
+
+BENCHMARK(BM_radix_sort_new)->Arg(256)->Arg(4096)->Arg(1 << 18);
+BENCHMARK(BM_radix_sort_arena)->Arg(256)->Arg(4096)->Arg(1 << 18);
+BENCHMARK(BM_sort_by_key_new)->Arg(256)->Arg(4096);
+BENCHMARK(BM_sort_by_key_arena)->Arg(256)->Arg(4096);
+
+BENCHMARK_MAIN();
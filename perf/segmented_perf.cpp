@@ -0,0 +1,187 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/segmented_iterator.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+
+// These benchmarks compare the std algorithms against the segmented_*()
+// algorithms over a deque-like chunked buffer.  The std algorithms pay for a
+// segment-boundary check on every increment; the segmented ones run over
+// each chunk as an int * range.
+
+struct chunked_iterator : boost::stl_interfaces::iterator_interface<
+                              chunked_iterator,
+                              std::forward_iterator_tag,
+                              int>
+{
+    using chunk = std::vector<int>;
+
+    chunked_iterator() : seg_(nullptr), it_(nullptr), last_seg_(nullptr) {}
+    chunked_iterator(chunk * seg, int * it, chunk * last_seg) :
+        seg_(seg),
+        it_(it),
+        last_seg_(last_seg)
+    {}
+
+    int & operator*() const { return *it_; }
+    chunked_iterator & operator++()
+    {
+        ++it_;
+        if (seg_ != last_seg_ && it_ == local_end(seg_)) {
+            ++seg_;
+            it_ = seg_->data();
+        }
+        return *this;
+    }
+    friend bool operator==(chunked_iterator lhs, chunked_iterator rhs)
+    {
+        return lhs.it_ == rhs.it_;
+    }
+
+private:
+    friend boost::stl_interfaces::access;
+    chunk * segment() const { return seg_; }
+    int * local() const { return it_; }
+    int * local_begin(chunk * seg) const { return seg->data(); }
+    int * local_end(chunk * seg) const { return seg->data() + seg->size(); }
+    chunked_iterator compose(chunk * seg, int * it) const
+    {
+        return chunked_iterator(seg, it, last_seg_);
+    }
+
+    chunk * seg_;
+    int * it_;
+    chunk * last_seg_;
+};
+
+struct chunked_buffer
+{
+    explicit chunked_buffer(std::ptrdiff_t n)
+    {
+        std::ptrdiff_t const chunk_size = 512;
+        for (std::ptrdiff_t i = 0; i < n; i += chunk_size) {
+            chunks_.emplace_back((std::min)(chunk_size, n - i));
+            std::iota(chunks_.back().begin(), chunks_.back().end(), int(i));
+        }
+    }
+
+    chunked_iterator begin()
+    {
+        return chunked_iterator(
+            &chunks_.front(), chunks_.front().data(), &chunks_.back());
+    }
+    chunked_iterator end()
+    {
+        return chunked_iterator(
+            &chunks_.back(),
+            chunks_.back().data() + chunks_.back().size(),
+            &chunks_.back());
+    }
+
+    std::vector<std::vector<int>> chunks_;
+};
+
+void BM_std_copy(benchmark::State & state)
+{
+    chunked_buffer buf(state.range(0));
+    std::vector<int> out(state.range(0));
+    for (auto _ : state) {
+        std::copy(buf.begin(), buf.end(), out.begin());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_segmented_copy(benchmark::State & state)
+{
+    chunked_buffer buf(state.range(0));
+    std::vector<int> out(state.range(0));
+    for (auto _ : state) {
+        boost::stl_interfaces::segmented_copy(
+            buf.begin(), buf.end(), out.begin());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_std_fill(benchmark::State & state)
+{
+    chunked_buffer buf(state.range(0));
+    for (auto _ : state) {
+        std::fill(buf.begin(), buf.end(), 3);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_segmented_fill(benchmark::State & state)
+{
+    chunked_buffer buf(state.range(0));
+    for (auto _ : state) {
+        boost::stl_interfaces::segmented_fill(buf.begin(), buf.end(), 3);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_std_accumulate(benchmark::State & state)
+{
+    chunked_buffer buf(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            std::accumulate(buf.begin(), buf.end(), 0u));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_segmented_accumulate(benchmark::State & state)
+{
+    chunked_buffer buf(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(boost::stl_interfaces::segmented_accumulate(
+            buf.begin(), buf.end(), 0u));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_std_find(benchmark::State & state)
+{
+    chunked_buffer buf(state.range(0));
+    int const x = int(state.range(0) - 1);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::find(buf.begin(), buf.end(), x));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_segmented_find(benchmark::State & state)
+{
+    chunked_buffer buf(state.range(0));
+    int const x = int(state.range(0) - 1);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            boost::stl_interfaces::segmented_find(buf.begin(), buf.end(), x));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_std_copy)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_segmented_copy)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_std_fill)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_segmented_fill)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_std_accumulate)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_segmented_accumulate)
+    ->RangeMultiplier(32)
+    ->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_std_find)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_segmented_find)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,76 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/stl_interfaces/segmented_vector.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <deque>
+#include <numeric>
+#include <vector>
+
+
+using boost::stl_interfaces::segmented_vector;
+
+
+// The push_back benchmarks append state.range(0) ints, and report the
+// longest single push_back() as max_ns; for std::vector, that is the last
+// reallocation.  The sum benchmarks add up state.range(0) ints, element by
+// element through the iterators, and segment by segment with
+// segmented_accumulate().
+
+template<typename Container>
+void BM_push_back(benchmark::State & state)
+{
+    double max_ns = 0;
+    for (auto _ : state) {
+        Container c;
+        for (int i = 0, n = state.range(0); i < n; ++i) {
+            auto const start = std::chrono::steady_clock::now();
+            c.push_back(i);
+            auto const ns = std::chrono::duration<double, std::nano>(
+                                std::chrono::steady_clock::now() - start)
+                                .count();
+            max_ns = (std::max)(max_ns, ns);
+        }
+        benchmark::DoNotOptimize(&c);
+    }
+    state.counters["max_ns"] = max_ns;
+}
+
+template<typename Container>
+void BM_sum_per_element(benchmark::State & state)
+{
+    Container c;
+    for (int i = 0, n = state.range(0); i < n; ++i) {
+        c.push_back(i);
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::accumulate(c.begin(), c.end(), 0));
+    }
+}
+
+void BM_sum_segmented(benchmark::State & state)
+{
+    segmented_vector<int> c;
+    for (int i = 0, n = state.range(0); i < n; ++i) {
+        c.push_back(i);
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(boost::stl_interfaces::segmented_accumulate(
+            c.begin(), c.end(), 0));
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_push_back, std::vector<int>)->Arg(1 << 24);
+BENCHMARK_TEMPLATE(BM_push_back, segmented_vector<int>)->Arg(1 << 24);
+BENCHMARK_TEMPLATE(BM_sum_per_element, std::vector<int>)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_sum_per_element, std::deque<int>)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_sum_per_element, segmented_vector<int>)->Arg(1 << 20);
+BENCHMARK(BM_sum_segmented)->Arg(1 << 20);
+
+BENCHMARK_MAIN();
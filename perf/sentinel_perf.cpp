@@ -0,0 +1,113 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/sentinel_interface.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+
+// These benchmarks scan C strings, as a tokenizer handed const char *s
+// does: BM_*_field find the length of the first comma-separated field of
+// each of many CSV lines, and BM_*_count count the commas in a long
+// string.
+
+std::vector<std::string> make_lines()
+{
+    std::vector<std::string> retval;
+    unsigned x = 1;
+    for (int i = 0; i < (1 << 14); ++i) {
+        std::string line;
+        while (line.size() < 120) {
+            x = x * 1103515245 + 12345;
+            line += (x >> 16) % 8 ? char('a' + (x >> 8) % 26) : ',';
+        }
+        retval.push_back(line);
+    }
+    return retval;
+}
+
+std::vector<std::string> const lines = make_lines();
+std::string const text = [] {
+    std::string retval;
+    for (auto const & line : lines) {
+        retval += line;
+    }
+    return retval;
+}();
+
+// The end found first, so that the string can be an iterator pair.
+void BM_strlen_then_pair_field(benchmark::State & state)
+{
+    for (auto _ : state) {
+        std::size_t n = 0;
+        for (auto const & line : lines) {
+            char const * first = line.c_str();
+            benchmark::DoNotOptimize(first);
+            char const * const last = first + std::strlen(first);
+            char const * it = first;
+            while (it != last && *it != ',') {
+                ++it;
+            }
+            n += it - first;
+        }
+        benchmark::DoNotOptimize(n);
+    }
+}
+
+// One pass, up to the comma or the null terminator.
+void BM_null_sentinel_field(benchmark::State & state)
+{
+    for (auto _ : state) {
+        std::size_t n = 0;
+        for (auto const & line : lines) {
+            char const * first = line.c_str();
+            benchmark::DoNotOptimize(first);
+            char const * it = first;
+            while (it != boost::stl_interfaces::null_sentinel && *it != ',') {
+                ++it;
+            }
+            n += it - first;
+        }
+        benchmark::DoNotOptimize(n);
+    }
+}
+
+void BM_strlen_then_pair_count(benchmark::State & state)
+{
+    for (auto _ : state) {
+        char const * first = text.c_str();
+        benchmark::DoNotOptimize(first);
+        char const * const last = first + std::strlen(first);
+        int n = 0;
+        for (; first != last; ++first) {
+            n += *first == ',';
+        }
+        benchmark::DoNotOptimize(n);
+    }
+}
+
+void BM_null_sentinel_count(benchmark::State & state)
+{
+    for (auto _ : state) {
+        char const * first = text.c_str();
+        benchmark::DoNotOptimize(first);
+        int n = 0;
+        for (; first != boost::stl_interfaces::null_sentinel; ++first) {
+            n += *first == ',';
+        }
+        benchmark::DoNotOptimize(n);
+    }
+}
+
+BENCHMARK(BM_strlen_then_pair_field);
+BENCHMARK(BM_null_sentinel_field);
+BENCHMARK(BM_strlen_then_pair_count);
+BENCHMARK(BM_null_sentinel_count);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,96 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/set_operation_view.hpp>
+#include "bench_data.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <iterator>
+#include <list>
+#include <vector>
+
+
+// These benchmarks intersect a posting list of 1K document ids with one of
+// 1M, as a two-term search query does: with std::set_intersection(), which
+// merges the lists linearly, and with a set_intersection_view, which
+// gallops over the long list.  They also count the elements of the union of
+// two lists of the same length, where there is nothing to skip.
+
+std::vector<int> posting_list(std::size_t n, int bound, std::uint64_t seed)
+{
+    auto retval = bench_data::random_ints(n, bound, seed);
+    std::sort(retval.begin(), retval.end());
+    retval.erase(std::unique(retval.begin(), retval.end()), retval.end());
+    return retval;
+}
+
+std::vector<int> const long_list = posting_list(1 << 20, 1 << 24, 1);
+std::vector<int> const short_list = posting_list(1 << 10, 1 << 24, 2);
+std::vector<int> const other_long_list = posting_list(1 << 20, 1 << 24, 3);
+
+void BM_std_set_intersection(benchmark::State & state)
+{
+    std::vector<int> result;
+    for (auto _ : state) {
+        result.clear();
+        std::set_intersection(
+            short_list.begin(),
+            short_list.end(),
+            long_list.begin(),
+            long_list.end(),
+            std::back_inserter(result));
+        benchmark::DoNotOptimize(result.data());
+    }
+}
+
+void BM_set_intersection_view(benchmark::State & state)
+{
+    auto const v = boost::stl_interfaces::make_set_intersection_view(
+        short_list, long_list);
+    for (auto _ : state) {
+        int count = 0;
+        for (int x : v) {
+            count += x & 1;
+        }
+        benchmark::DoNotOptimize(count);
+    }
+}
+
+void BM_std_set_union(benchmark::State & state)
+{
+    std::vector<int> result;
+    for (auto _ : state) {
+        result.clear();
+        std::set_union(
+            long_list.begin(),
+            long_list.end(),
+            other_long_list.begin(),
+            other_long_list.end(),
+            std::back_inserter(result));
+        benchmark::DoNotOptimize(result.data());
+    }
+}
+
+void BM_set_union_view(benchmark::State & state)
+{
+    auto const v = boost::stl_interfaces::make_set_union_view(
+        long_list, other_long_list);
+    for (auto _ : state) {
+        int count = 0;
+        for (int x : v) {
+            count += x & 1;
+        }
+        benchmark::DoNotOptimize(count);
+    }
+}
+
+BENCHMARK(BM_std_set_intersection);
+BENCHMARK(BM_set_intersection_view);
+BENCHMARK(BM_std_set_union);
+BENCHMARK(BM_set_union_view);
+
+BENCHMARK_MAIN();
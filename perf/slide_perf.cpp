@@ -0,0 +1,101 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/slide_view.hpp>
+#include "bench_data.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <list>
+#include <numeric>
+#include <vector>
+
+
+// These benchmarks compute the 8-element moving sums of 64K ints: by copying
+// each window into a vector of its own, as code that builds its windows by
+// hand often does; with a slide_view and an adjacent_view over pointers; and
+// with both views over a std::list, where each window is a pair of list
+// iterators or an array of them.
+
+constexpr int window = 8;
+
+std::vector<int> const ints = bench_data::random_ints(1 << 16, 1000);
+std::list<int> const int_list(ints.begin(), ints.end());
+
+void BM_vector_per_window(benchmark::State & state)
+{
+    for (auto _ : state) {
+        long sum = 0;
+        for (std::size_t i = 0; i + window <= ints.size(); ++i) {
+            std::vector<int> const w(
+                ints.begin() + i, ints.begin() + i + window);
+            sum += std::accumulate(w.begin(), w.end(), 0l);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+void BM_slide_view(benchmark::State & state)
+{
+    auto const windows = boost::stl_interfaces::slide_view<int const *>(
+        ints.data(), ints.data() + ints.size(), window);
+    for (auto _ : state) {
+        long sum = 0;
+        for (auto w : windows) {
+            sum += std::accumulate(w.begin(), w.end(), 0l);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+void BM_adjacent_view(benchmark::State & state)
+{
+    auto const windows =
+        boost::stl_interfaces::adjacent_view<int const *, window>(
+            ints.data(), ints.data() + ints.size());
+    for (auto _ : state) {
+        long sum = 0;
+        for (auto w : windows) {
+            sum += std::accumulate(w.begin(), w.end(), 0l);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+void BM_list_slide_view(benchmark::State & state)
+{
+    auto const windows =
+        boost::stl_interfaces::make_slide_view(int_list, window);
+    for (auto _ : state) {
+        long sum = 0;
+        for (auto w : windows) {
+            sum += std::accumulate(w.begin(), w.end(), 0l);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+void BM_list_adjacent_view(benchmark::State & state)
+{
+    auto const windows =
+        boost::stl_interfaces::make_adjacent_view<window>(int_list);
+    for (auto _ : state) {
+        long sum = 0;
+        for (auto const & w : windows) {
+            for (auto it : w) {
+                sum += *it;
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+BENCHMARK(BM_vector_per_window);
+BENCHMARK(BM_slide_view);
+BENCHMARK(BM_adjacent_view);
+BENCHMARK(BM_list_slide_view);
+BENCHMARK(BM_list_adjacent_view);
+
+BENCHMARK_MAIN();
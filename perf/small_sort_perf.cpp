@@ -0,0 +1,89 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/static_vector.hpp>
+#include "bench_data.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <vector>
+
+
+// The sort benchmarks sort static_vector<int, 32>s of state.range(0)
+// random ints, with std::sort() and with static_vector's sort(), whose
+// sorting networks have no branches.  Each iteration copies the next of
+// 1024 unsorted vectors and sorts the copy, so both include the copy.  The
+// lower_bound benchmarks search a sorted vector of state.range(0) ints for
+// 64K random keys, too many for the branch predictor to learn, with
+// std::lower_bound() and with static_vector's lower_bound().
+
+namespace bsi = boost::stl_interfaces;
+
+using vec = bsi::static_vector<int, 32>;
+
+std::vector<vec> unsorted(std::size_t size)
+{
+    auto const ints = bench_data::random_ints(1024 * size, 1 << 20);
+    std::vector<vec> retval(1024);
+    for (std::size_t i = 0; i < retval.size(); ++i) {
+        retval[i].assign(
+            ints.begin() + i * size, ints.begin() + (i + 1) * size);
+    }
+    return retval;
+}
+
+void BM_sort_std(benchmark::State & state)
+{
+    auto const vecs = unsorted(state.range(0));
+    std::size_t i = 0;
+    for (auto _ : state) {
+        vec v = vecs[i++ % vecs.size()];
+        std::sort(v.begin(), v.end());
+        benchmark::DoNotOptimize(v);
+    }
+}
+
+void BM_sort_network(benchmark::State & state)
+{
+    auto const vecs = unsorted(state.range(0));
+    std::size_t i = 0;
+    for (auto _ : state) {
+        vec v = vecs[i++ % vecs.size()];
+        bsi::sort(v);
+        benchmark::DoNotOptimize(v);
+    }
+}
+
+void BM_lower_bound_std(benchmark::State & state)
+{
+    vec v = unsorted(state.range(0))[0];
+    std::sort(v.begin(), v.end());
+    auto const keys = bench_data::random_ints(1 << 16, 1 << 20, 2);
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::lower_bound(
+            v.begin(), v.end(), keys[i++ % keys.size()]));
+    }
+}
+
+void BM_lower_bound_branchless(benchmark::State & state)
+{
+    vec v = unsorted(state.range(0))[0];
+    std::sort(v.begin(), v.end());
+    auto const keys = bench_data::random_ints(1 << 16, 1 << 20, 2);
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            bsi::lower_bound(v, keys[i++ % keys.size()]));
+    }
+}
+
+BENCHMARK(BM_sort_std)->Arg(8)->Arg(16)->Arg(32);
+BENCHMARK(BM_sort_network)->Arg(8)->Arg(16)->Arg(32);
+BENCHMARK(BM_lower_bound_std)->Arg(8)->Arg(16)->Arg(32);
+BENCHMARK(BM_lower_bound_branchless)->Arg(8)->Arg(16)->Arg(32);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,160 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/stl_interfaces/small_vector.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+using boost::stl_interfaces::small_vector;
+
+
+// These benchmarks build a short-lived collection of state.range(0)
+// elements, as when handling one message.  small_vector<int, 8> only goes to
+// the heap for collections of more than 8 elements.
+
+template<typename Vector>
+void build_collection(benchmark::State & state)
+{
+    for (auto _ : state) {
+        Vector v;
+        for (int i = 0, n = state.range(0); i < n; ++i) {
+            v.push_back(i);
+        }
+        benchmark::DoNotOptimize(v.data());
+    }
+}
+
+void BM_collection_std_vector(benchmark::State & state)
+{
+    build_collection<std::vector<int>>(state);
+}
+
+void BM_collection_small_vector(benchmark::State & state)
+{
+    build_collection<small_vector<int, 8>>(state);
+}
+
+BENCHMARK(BM_collection_std_vector)->DenseRange(2, 8, 3)->Arg(32);
+BENCHMARK(BM_collection_small_vector)->DenseRange(2, 8, 3)->Arg(32);
+
+// These benchmarks assign state.range(0) copies of a value to a
+// small_vector that is full, with its elements inline, so that it has to
+// grow.  assign() erases the elements and then reserve()s, so there is only
+// ever one buffer.  The alternative that container_interface used to take,
+// and that the _swap benchmarks do by hand, builds a temporary and swaps it
+// in, which moves the inline elements three times, and holds both buffers
+// at once.
+
+template<typename Vector>
+void assign_grow_swap(benchmark::State & state, Vector const & full)
+{
+    auto const n = std::size_t(state.range(0));
+    for (auto _ : state) {
+        Vector v = full;
+        Vector temp(n, full[0]);
+        v.swap(temp);
+        benchmark::DoNotOptimize(v.data());
+    }
+}
+
+template<typename Vector>
+void assign_grow(benchmark::State & state, Vector const & full)
+{
+    auto const n = std::size_t(state.range(0));
+    for (auto _ : state) {
+        Vector v = full;
+        v.assign(n, full[0]);
+        benchmark::DoNotOptimize(v.data());
+    }
+}
+
+using int_vec = small_vector<int, 1024>;
+using string_vec = small_vector<std::string, 8>;
+
+int_vec const full_ints(1024, 7);
+string_vec const full_strings(8, std::string(40, 'x'));
+
+void BM_assign_grow_swap_ints(benchmark::State & state)
+{
+    assign_grow_swap(state, full_ints);
+}
+
+void BM_assign_grow_ints(benchmark::State & state)
+{
+    assign_grow(state, full_ints);
+}
+
+void BM_assign_grow_swap_strings(benchmark::State & state)
+{
+    assign_grow_swap(state, full_strings);
+}
+
+void BM_assign_grow_strings(benchmark::State & state)
+{
+    assign_grow(state, full_strings);
+}
+
+BENCHMARK(BM_assign_grow_swap_ints)->Arg(2048)->Arg(16384);
+BENCHMARK(BM_assign_grow_ints)->Arg(2048)->Arg(16384);
+BENCHMARK(BM_assign_grow_swap_strings)->Arg(16)->Arg(256);
+BENCHMARK(BM_assign_grow_strings)->Arg(16)->Arg(256);
+
+// These benchmarks hand state.range(0) unique_ptrs from a small_vector to a
+// static_vector and back, as when data crosses from one layer to another.
+// The _move benchmarks move the elements one at a time through
+// std::move_iterators, and destroy the moved-from ones; the _relocate
+// benchmarks use the relocating constructors, which memcpy() them.
+
+using ptr_small_vec = small_vector<std::unique_ptr<int>, 8>;
+using ptr_static_vec =
+    boost::stl_interfaces::static_vector<std::unique_ptr<int>, 256>;
+
+ptr_small_vec make_ptrs(std::size_t n)
+{
+    ptr_small_vec retval;
+    for (std::size_t i = 0; i < n; ++i) {
+        retval.push_back(std::make_unique<int>(int(i)));
+    }
+    return retval;
+}
+
+void BM_hand_off_move(benchmark::State & state)
+{
+    auto v = make_ptrs(state.range(0));
+    for (auto _ : state) {
+        ptr_static_vec sv(
+            std::make_move_iterator(v.begin()),
+            std::make_move_iterator(v.end()));
+        v.clear();
+        ptr_small_vec v2(
+            std::make_move_iterator(sv.begin()),
+            std::make_move_iterator(sv.end()));
+        sv.clear();
+        v = std::move(v2);
+        benchmark::DoNotOptimize(v.data());
+    }
+}
+
+void BM_hand_off_relocate(benchmark::State & state)
+{
+    auto v = make_ptrs(state.range(0));
+    for (auto _ : state) {
+        ptr_static_vec sv(std::move(v));
+        v = ptr_small_vec(std::move(sv));
+        benchmark::DoNotOptimize(v.data());
+    }
+}
+
+BENCHMARK(BM_hand_off_move)->Arg(8)->Arg(64)->Arg(256);
+BENCHMARK(BM_hand_off_relocate)->Arg(8)->Arg(64)->Arg(256);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,88 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/stl_interfaces/soa_vector.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <numeric>
+#include <tuple>
+#include <vector>
+
+
+using boost::stl_interfaces::soa_vector;
+
+
+// These benchmarks compare a scan over one field of soa_vector with the same
+// scan over a std::vector of structs (an array of structures).
+
+struct record
+{
+    double price;
+    int quantity;
+    int id;
+    double weight;
+    long timestamp;
+};
+
+using soa_type = soa_vector<double, int, int, double, long>;
+
+void BM_field_sum_aos(benchmark::State & state)
+{
+    std::vector<record> records(state.range(0));
+    for (std::size_t i = 0; i < records.size(); ++i) {
+        records[i] = record{double(i), int(i), int(i), 1.0, long(i)};
+    }
+    for (auto _ : state) {
+        double sum = 0.0;
+        for (auto const & r : records) {
+            sum += r.price;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+void BM_field_sum_soa(benchmark::State & state)
+{
+    soa_type records;
+    records.reserve(state.range(0));
+    for (int i = 0, n = state.range(0); i < n; ++i) {
+        records.emplace_back(double(i), i, i, 1.0, long(i));
+    }
+    for (auto _ : state) {
+        auto const prices = records.data<0>();
+        double sum = 0.0;
+        for (std::size_t i = 0, n = records.size(); i < n; ++i) {
+            sum += prices[i];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+// The same scan as above, but through the proxy iterators.
+void BM_field_sum_soa_iterators(benchmark::State & state)
+{
+    soa_type records;
+    records.reserve(state.range(0));
+    for (int i = 0, n = state.range(0); i < n; ++i) {
+        records.emplace_back(double(i), i, i, 1.0, long(i));
+    }
+    for (auto _ : state) {
+        double sum = 0.0;
+        for (auto r : records) {
+            sum += std::get<0>(r);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+BENCHMARK(BM_field_sum_aos)->RangeMultiplier(16)->Range(1 << 8, 1 << 20);
+BENCHMARK(BM_field_sum_soa)->RangeMultiplier(16)->Range(1 << 8, 1 << 20);
+BENCHMARK(BM_field_sum_soa_iterators)
+    ->RangeMultiplier(16)
+    ->Range(1 << 8, 1 << 20);
+
+BENCHMARK_MAIN();
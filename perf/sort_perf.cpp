@@ -0,0 +1,104 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/parallel_sort.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vector>
+
+
+// These benchmarks sort a structure-of-arrays table of 1M rows -- an int
+// key, a double and a long -- by its key, through a zip_iterator: with
+// std::sort(), which swaps the rows' tuples of references; with
+// parallel_sort(), which sorts their indices and then permutes each
+// column; and with parallel_sort_by_key(), which radix sorts the keys.
+
+namespace bsi = boost::stl_interfaces;
+
+constexpr std::size_t rows = 1 << 20;
+
+struct table
+{
+    table() : keys(rows), doubles(rows), longs(rows)
+    {
+        std::mt19937 gen(42);
+        std::uniform_int_distribution<int> dist(0, 1 << 30);
+        for (std::size_t i = 0; i < rows; ++i) {
+            keys[i] = dist(gen);
+            doubles[i] = i;
+            longs[i] = long(i);
+        }
+    }
+
+    auto zip() { return bsi::make_zip_view(keys, doubles, longs); }
+
+    std::vector<int> keys;
+    std::vector<double> doubles;
+    std::vector<long> longs;
+};
+
+table const input;
+
+struct key_of
+{
+    template<typename Tuple>
+    int operator()(Tuple const & t) const
+    {
+        return std::get<0>(t);
+    }
+};
+
+struct key_less
+{
+    template<typename Tuple1, typename Tuple2>
+    bool operator()(Tuple1 const & lhs, Tuple2 const & rhs) const
+    {
+        return std::get<0>(lhs) < std::get<0>(rhs);
+    }
+};
+
+void BM_std_sort(benchmark::State & state)
+{
+    for (auto _ : state) {
+        state.PauseTiming();
+        table t = input;
+        state.ResumeTiming();
+        auto const zip = t.zip();
+        std::sort(zip.begin(), zip.end(), key_less{});
+        benchmark::DoNotOptimize(t.keys.data());
+    }
+}
+
+void BM_parallel_sort(benchmark::State & state)
+{
+    for (auto _ : state) {
+        state.PauseTiming();
+        table t = input;
+        state.ResumeTiming();
+        auto const zip = t.zip();
+        bsi::parallel_sort(zip.begin(), zip.end(), key_less{});
+        benchmark::DoNotOptimize(t.keys.data());
+    }
+}
+
+void BM_parallel_sort_by_key(benchmark::State & state)
+{
+    for (auto _ : state) {
+        state.PauseTiming();
+        table t = input;
+        state.ResumeTiming();
+        auto const zip = t.zip();
+        bsi::parallel_sort_by_key(zip.begin(), zip.end(), key_of{});
+        benchmark::DoNotOptimize(t.keys.data());
+    }
+}
+
+BENCHMARK(BM_std_sort)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_parallel_sort)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_parallel_sort_by_key)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
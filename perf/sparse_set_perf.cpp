@@ -0,0 +1,159 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/sparse_set.hpp>
+#include "bench_data.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <unordered_set>
+#include <vector>
+
+
+// These benchmarks keep 64K indices out of a universe of 1M, as an
+// entity-component system keeps the entities that have some component.  The
+// bitmap is a std::vector<bool> over the whole universe; it has to scan all
+// of it to iterate.
+
+namespace bsi = boost::stl_interfaces;
+
+int const universe = 1 << 20;
+std::vector<int> const indices = bench_data::random_ints(1 << 16, universe);
+std::vector<int> const queries =
+    bench_data::random_ints(1 << 16, universe, 2);
+
+struct bitmap
+{
+    bitmap() : bits_(universe) {}
+    void insert(int i) { bits_[i] = true; }
+    std::size_t erase(int i)
+    {
+        bool const retval = bits_[i];
+        bits_[i] = false;
+        return retval;
+    }
+    std::size_t count(int i) const { return bits_[i]; }
+    template<typename F>
+    void for_each(F f) const
+    {
+        for (int i = 0; i < universe; ++i) {
+            if (bits_[i])
+                f(i);
+        }
+    }
+
+private:
+    std::vector<bool> bits_;
+};
+
+template<typename Set>
+Set make_set()
+{
+    Set retval;
+    for (int i : indices) {
+        retval.insert(i);
+    }
+    return retval;
+}
+
+template<typename Set>
+void sum_all(Set const & s, long long & sum)
+{
+    for (int i : s) {
+        sum += i;
+    }
+}
+void sum_all(bitmap const & s, long long & sum)
+{
+    s.for_each([&](int i) { sum += i; });
+}
+
+// Sums the indices in the set.
+template<typename Set>
+void iterate(benchmark::State & state)
+{
+    auto const s = make_set<Set>();
+    for (auto _ : state) {
+        long long sum = 0;
+        sum_all(s, sum);
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+// Looks up random indices, about 6% of which are in the set.
+template<typename Set>
+void contains(benchmark::State & state)
+{
+    auto const s = make_set<Set>();
+    for (auto _ : state) {
+        std::size_t n = 0;
+        for (int i : queries) {
+            n += s.count(i);
+        }
+        benchmark::DoNotOptimize(n);
+    }
+}
+
+// Erases random indices and inserts others in their place, as entities gain
+// and lose a component.
+template<typename Set>
+void churn(benchmark::State & state)
+{
+    auto s = make_set<Set>();
+    for (auto _ : state) {
+        std::size_t n = 0;
+        for (std::size_t j = 0; j < queries.size(); ++j) {
+            n += s.erase(indices[j]);
+            s.insert(queries[j]);
+        }
+        for (std::size_t j = 0; j < queries.size(); ++j) {
+            n += s.erase(queries[j]);
+            s.insert(indices[j]);
+        }
+        benchmark::DoNotOptimize(n);
+    }
+}
+
+void BM_iterate_sparse_set(benchmark::State & state)
+{
+    iterate<bsi::sparse_set<int>>(state);
+}
+void BM_iterate_unordered_set(benchmark::State & state)
+{
+    iterate<std::unordered_set<int>>(state);
+}
+void BM_iterate_bitmap(benchmark::State & state) { iterate<bitmap>(state); }
+
+void BM_contains_sparse_set(benchmark::State & state)
+{
+    contains<bsi::sparse_set<int>>(state);
+}
+void BM_contains_unordered_set(benchmark::State & state)
+{
+    contains<std::unordered_set<int>>(state);
+}
+void BM_contains_bitmap(benchmark::State & state) { contains<bitmap>(state); }
+
+void BM_churn_sparse_set(benchmark::State & state)
+{
+    churn<bsi::sparse_set<int>>(state);
+}
+void BM_churn_unordered_set(benchmark::State & state)
+{
+    churn<std::unordered_set<int>>(state);
+}
+void BM_churn_bitmap(benchmark::State & state) { churn<bitmap>(state); }
+
+BENCHMARK(BM_iterate_sparse_set);
+BENCHMARK(BM_iterate_unordered_set);
+BENCHMARK(BM_iterate_bitmap);
+BENCHMARK(BM_contains_sparse_set);
+BENCHMARK(BM_contains_unordered_set);
+BENCHMARK(BM_contains_bitmap);
+BENCHMARK(BM_churn_sparse_set);
+BENCHMARK(BM_churn_unordered_set);
+BENCHMARK(BM_churn_bitmap);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,105 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/stl_interfaces/split_vector.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+
+using boost::stl_interfaces::split_vector;
+
+
+// These benchmarks compute the notional value, price times quantity, of
+// state.range(0) 200-byte orders, 16 bytes of which the scan reads: over a
+// std::vector of whole orders, over the hot halves of a split_vector
+// through hot_data(), and over the split_vector through its proxy
+// iterators.  The last is a scan that reads the cold halves' addresses but
+// not their bytes.
+
+struct order_hot
+{
+    double price;
+    int quantity;
+};
+
+struct order_cold
+{
+    char details[184];
+};
+
+struct order
+{
+    order_hot hot;
+    order_cold cold;
+};
+
+static_assert(sizeof(order) == 200, "");
+
+void BM_notional_whole(benchmark::State & state)
+{
+    std::vector<order> orders(state.range(0));
+    for (std::size_t i = 0; i < orders.size(); ++i) {
+        orders[i].hot = order_hot{double(i % 100), int(i % 7)};
+    }
+    for (auto _ : state) {
+        double sum = 0.0;
+        for (auto const & o : orders) {
+            sum += o.hot.price * o.hot.quantity;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+split_vector<order_hot, order_cold> split_orders(std::size_t n)
+{
+    split_vector<order_hot, order_cold> retval;
+    retval.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        retval.emplace_back(
+            order_hot{double(i % 100), int(i % 7)}, order_cold{});
+    }
+    return retval;
+}
+
+void BM_notional_split_hot_data(benchmark::State & state)
+{
+    auto const orders = split_orders(state.range(0));
+    for (auto _ : state) {
+        auto const hot = orders.hot_data();
+        double sum = 0.0;
+        for (std::size_t i = 0, n = orders.size(); i < n; ++i) {
+            sum += hot[i].price * hot[i].quantity;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_notional_split_iterators(benchmark::State & state)
+{
+    auto const orders = split_orders(state.range(0));
+    for (auto _ : state) {
+        double sum = 0.0;
+        for (auto o : orders) {
+            sum += o.hot.price * o.hot.quantity;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_notional_whole)->RangeMultiplier(16)->Range(1 << 8, 1 << 20);
+BENCHMARK(BM_notional_split_hot_data)
+    ->RangeMultiplier(16)
+    ->Range(1 << 8, 1 << 20);
+BENCHMARK(BM_notional_split_iterators)
+    ->RangeMultiplier(16)
+    ->Range(1 << 8, 1 << 20);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,90 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/stl_interfaces/split_view.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <random>
+#include <sstream>
+#include <string>
+
+
+using boost::stl_interfaces::lines;
+using boost::stl_interfaces::split_view;
+
+
+// These benchmarks count the lines of 16MB of log text, with lines of 20 to
+// 199 chars, and sum their lengths: with std::getline(), with a loop that
+// looks for each '\n' with std::find(), and with lines().
+
+std::string make_log()
+{
+    std::mt19937 gen(2);
+    std::string retval;
+    while (retval.size() < (1u << 24)) {
+        retval.append(20 + gen() % 180, 'x');
+        retval += '\n';
+    }
+    return retval;
+}
+
+std::string const text = make_log();
+
+void BM_getline(benchmark::State & state)
+{
+    for (auto _ : state) {
+        std::istringstream is(text);
+        std::size_t n = 0;
+        std::size_t chars = 0;
+        std::string line;
+        while (std::getline(is, line)) {
+            ++n;
+            chars += line.size();
+        }
+        benchmark::DoNotOptimize(n + chars);
+    }
+    state.SetBytesProcessed(state.iterations() * text.size());
+}
+
+void BM_find_loop(benchmark::State & state)
+{
+    for (auto _ : state) {
+        std::size_t n = 0;
+        std::size_t chars = 0;
+        auto first = text.data();
+        auto const last = text.data() + text.size();
+        while (first != last) {
+            auto const eol = std::find(first, last, '\n');
+            ++n;
+            chars += eol - first;
+            first = eol == last ? last : eol + 1;
+        }
+        benchmark::DoNotOptimize(n + chars);
+    }
+    state.SetBytesProcessed(state.iterations() * text.size());
+}
+
+void BM_lines(benchmark::State & state)
+{
+    for (auto _ : state) {
+        std::size_t n = 0;
+        std::size_t chars = 0;
+        for (auto line : lines(text)) {
+            ++n;
+            chars += line.size();
+        }
+        benchmark::DoNotOptimize(n + chars);
+    }
+    state.SetBytesProcessed(state.iterations() * text.size());
+}
+
+BENCHMARK(BM_getline)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_find_loop)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_lines)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
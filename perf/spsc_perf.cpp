@@ -0,0 +1,80 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/stl_interfaces/spsc_queue.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <numeric>
+#include <vector>
+
+
+using boost::stl_interfaces::spsc_queue;
+
+
+// These benchmarks pass state.range(0) ints through an spsc_queue and back
+// out, on one thread, to measure the cost of the queue operations
+// themselves: one atomic store per element with push() and pop(), or one
+// per batch with write() and read().
+
+void BM_spsc_per_element(benchmark::State & state)
+{
+    spsc_queue<int, 1024> q;
+    int const n = state.range(0);
+    for (auto _ : state) {
+        for (int i = 0; i < n; ++i) {
+            q.push(i);
+        }
+        int sum = 0;
+        for (int i = 0, x = 0; i < n; ++i) {
+            q.pop(x);
+            sum += x;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+void BM_spsc_bulk(benchmark::State & state)
+{
+    spsc_queue<int, 1024> q;
+    std::vector<int> in(state.range(0));
+    std::iota(in.begin(), in.end(), 0);
+    std::vector<int> out(state.range(0));
+    for (auto _ : state) {
+        q.write(in.data(), in.size());
+        q.read(out.data(), out.size());
+        benchmark::DoNotOptimize(out.data());
+    }
+}
+
+void BM_spsc_spans(benchmark::State & state)
+{
+    spsc_queue<int, 1024> q;
+    int const n = state.range(0);
+    for (auto _ : state) {
+        for (int i = 0; i < n;) {
+            auto const s = q.write_span(n - i);
+            auto const m = (std::min)(int(s.size()), n - i);
+            std::iota(s.begin(), s.begin() + m, i);
+            q.commit_write(m);
+            i += m;
+        }
+        int sum = 0;
+        for (int i = 0; i < n;) {
+            auto const r = q.read_span(n - i);
+            sum = std::accumulate(r.begin(), r.end(), sum);
+            q.commit_read(r.size());
+            i += int(r.size());
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+BENCHMARK(BM_spsc_per_element)->Arg(64)->Arg(1000);
+BENCHMARK(BM_spsc_bulk)->Arg(64)->Arg(1000);
+BENCHMARK(BM_spsc_spans)->Arg(64)->Arg(1000);
+
+BENCHMARK_MAIN();
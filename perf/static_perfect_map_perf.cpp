@@ -0,0 +1,183 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/static_perfect_map.hpp>
+#include "bench_data.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <iterator>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+// The lookups resolve 4K field names from a message stream, one in eight of
+// which is not a known field, against a table of 32 names; the enum lookups
+// do the same with 4K integer codes.  The builds measure what a table costs
+// at startup: a std::unordered_map is built on the heap when the program
+// starts, and a constexpr static_perfect_map is built by the compiler.
+
+namespace bsi = boost::stl_interfaces;
+
+using name_t = bsi::static_string<23>;
+using name_entry = bsi::perfect_map_entry<name_t, int>;
+
+constexpr name_entry field_entries[] = {
+    {"account", 0},      {"avg_price", 1},     {"client_order_id", 2},
+    {"commission", 3},   {"currency", 4},      {"cum_quantity", 5},
+    {"exec_id", 6},      {"exec_type", 7},     {"exchange", 8},
+    {"expire_time", 9},  {"last_price", 10},   {"last_quantity", 11},
+    {"leaves_quantity", 12}, {"max_floor", 13}, {"min_quantity", 14},
+    {"order_id", 15},    {"order_status", 16}, {"order_type", 17},
+    {"orig_client_id", 18}, {"price", 19},     {"quantity", 20},
+    {"security_id", 21}, {"sending_time", 22}, {"settle_date", 23},
+    {"side", 24},        {"stop_price", 25},   {"symbol", 26},
+    {"text", 27},        {"time_in_force", 28}, {"trade_date", 29},
+    {"transact_time", 30}, {"venue", 31}};
+int const field_count = 32;
+
+constexpr bsi::static_perfect_map<name_t, int, field_count> fields(
+    field_entries);
+
+std::unordered_map<std::string, int> make_unordered_fields()
+{
+    std::unordered_map<std::string, int> retval;
+    for (auto const & e : field_entries) {
+        retval.emplace(std::string(e.first.data(), e.first.size()), e.second);
+    }
+    return retval;
+}
+
+std::vector<std::string> make_stream()
+{
+    std::vector<std::string> retval;
+    std::vector<int> const picks = bench_data::random_ints(1 << 12, 256);
+    for (int pick : picks) {
+        if (pick < 224) {
+            name_t const & name = field_entries[pick % field_count].first;
+            retval.push_back(std::string(name.data(), name.size()));
+        } else {
+            retval.push_back("unknown_" + std::to_string(pick));
+        }
+    }
+    return retval;
+}
+std::vector<std::string> const stream = make_stream();
+
+void BM_names_unordered_map(benchmark::State & state)
+{
+    auto const map = make_unordered_fields();
+    for (auto _ : state) {
+        int sum = 0;
+        for (auto const & s : stream) {
+            auto const it = map.find(s);
+            sum += it == map.end() ? -1 : it->second;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+void BM_names_perfect_map(benchmark::State & state)
+{
+    std::vector<name_t> names;
+    for (auto const & s : stream) {
+        names.push_back(name_t(s.data(), s.size()));
+    }
+    for (auto _ : state) {
+        int sum = 0;
+        for (auto const & s : names) {
+            sum += fields.get(s, -1);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+using code_entry = bsi::perfect_map_entry<int, int>;
+
+template<int N>
+struct code_table
+{
+    code_entry entries[N];
+};
+// Sparse codes, as enumerators with explicit values often are.
+template<int N>
+constexpr code_table<N> make_codes()
+{
+    code_table<N> retval{};
+    for (int i = 0; i < N; ++i) {
+        retval.entries[i] = code_entry{1000 + 37 * i, i};
+    }
+    return retval;
+}
+int const code_count = 64;
+constexpr code_table<code_count> code_entries = make_codes<code_count>();
+constexpr bsi::static_perfect_map<int, int, code_count> codes(
+    code_entries.entries);
+
+std::vector<int> make_code_stream()
+{
+    std::vector<int> retval;
+    for (int pick : bench_data::random_ints(1 << 12, 2 * code_count)) {
+        int const miss = code_count <= pick;
+        retval.push_back(1000 + 37 * (pick % code_count) + miss);
+    }
+    return retval;
+}
+std::vector<int> const code_stream = make_code_stream();
+
+void BM_codes_unordered_map(benchmark::State & state)
+{
+    std::unordered_map<int, int> map;
+    for (auto const & e : code_entries.entries) {
+        map.emplace(e.first, e.second);
+    }
+    for (auto _ : state) {
+        int sum = 0;
+        for (int code : code_stream) {
+            auto const it = map.find(code);
+            sum += it == map.end() ? -1 : it->second;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+void BM_codes_perfect_map(benchmark::State & state)
+{
+    for (auto _ : state) {
+        int sum = 0;
+        for (int code : code_stream) {
+            sum += codes.get(code, -1);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+void BM_build_unordered_map(benchmark::State & state)
+{
+    for (auto _ : state) {
+        auto map = make_unordered_fields();
+        benchmark::DoNotOptimize(&map);
+    }
+}
+// A static_perfect_map built at runtime, which a constexpr one avoids.
+void BM_build_perfect_map(benchmark::State & state)
+{
+    name_entry entries[field_count] = {};
+    std::copy(std::begin(field_entries), std::end(field_entries), entries);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(entries);
+        bsi::static_perfect_map<name_t, int, field_count> map(entries);
+        benchmark::DoNotOptimize(&map);
+    }
+}
+
+BENCHMARK(BM_names_unordered_map);
+BENCHMARK(BM_names_perfect_map);
+BENCHMARK(BM_codes_unordered_map);
+BENCHMARK(BM_codes_perfect_map);
+BENCHMARK(BM_build_unordered_map);
+BENCHMARK(BM_build_perfect_map);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,157 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/small_string.hpp>
+#include "bench_data.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+
+// These benchmarks work on 4K symbols of 8 to 22 characters, some of which
+// are too long for libstdc++'s 15-character inline std::string; they fit in
+// a static_string<22>, which is 24 bytes, and in a small_string<22>, whose
+// inline buffer holds them.
+
+namespace bsi = boost::stl_interfaces;
+
+std::vector<std::string> const symbols =
+    bench_data::random_strings(1 << 12, 8, 22);
+
+template<typename String>
+std::vector<String> make_symbols()
+{
+    std::vector<String> retval;
+    for (auto const & s : symbols) {
+        retval.push_back(String(s.data(), s.size()));
+    }
+    return retval;
+}
+
+// Copies all the symbols, as when building a message.
+template<typename String>
+void copy_symbols(benchmark::State & state)
+{
+    auto const source = make_symbols<String>();
+    for (auto _ : state) {
+        std::vector<String> copy = source;
+        benchmark::DoNotOptimize(copy.data());
+    }
+}
+
+// Counts the symbols that contain "abc".
+template<typename String>
+void find_symbols(benchmark::State & state)
+{
+    auto const source = make_symbols<String>();
+    for (auto _ : state) {
+        int n = 0;
+        for (auto const & s : source) {
+            n += s.find("abc") != String::npos;
+        }
+        benchmark::DoNotOptimize(n);
+    }
+}
+
+// Compares each symbol with an equal std::string, as when matching a
+// field of a message: through a temporary String made from the
+// std::string, or directly, with the heterogeneous operator==().
+template<typename String, bool Temporary>
+void compare_symbols(benchmark::State & state)
+{
+    auto const source = make_symbols<String>();
+    for (auto _ : state) {
+        int n = 0;
+        for (std::size_t i = 0; i < source.size(); ++i) {
+            auto const & s = symbols[i];
+            if (Temporary)
+                n += source[i] == String(s.data(), s.size());
+            else
+                n += source[i] == s;
+        }
+        benchmark::DoNotOptimize(n);
+    }
+}
+
+// Sorts the symbols, with compare().
+template<typename String>
+void sort_symbols(benchmark::State & state)
+{
+    auto const source = make_symbols<String>();
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto v = source;
+        state.ResumeTiming();
+        std::sort(v.begin(), v.end(), [](String const & a, String const & b) {
+            return a.compare(b) < 0;
+        });
+        benchmark::DoNotOptimize(v.data());
+    }
+}
+
+void BM_copy_std_string(benchmark::State & state)
+{
+    copy_symbols<std::string>(state);
+}
+void BM_copy_static_string(benchmark::State & state)
+{
+    copy_symbols<bsi::static_string<22>>(state);
+}
+void BM_copy_small_string(benchmark::State & state)
+{
+    copy_symbols<bsi::small_string<22>>(state);
+}
+
+void BM_find_std_string(benchmark::State & state)
+{
+    find_symbols<std::string>(state);
+}
+void BM_find_static_string(benchmark::State & state)
+{
+    find_symbols<bsi::static_string<22>>(state);
+}
+void BM_find_small_string(benchmark::State & state)
+{
+    find_symbols<bsi::small_string<22>>(state);
+}
+
+void BM_compare_static_string_via_temporary(benchmark::State & state)
+{
+    compare_symbols<bsi::static_string<22>, true>(state);
+}
+void BM_compare_static_string(benchmark::State & state)
+{
+    compare_symbols<bsi::static_string<22>, false>(state);
+}
+
+void BM_sort_std_string(benchmark::State & state)
+{
+    sort_symbols<std::string>(state);
+}
+void BM_sort_static_string(benchmark::State & state)
+{
+    sort_symbols<bsi::static_string<22>>(state);
+}
+void BM_sort_small_string(benchmark::State & state)
+{
+    sort_symbols<bsi::small_string<22>>(state);
+}
+
+BENCHMARK(BM_copy_std_string);
+BENCHMARK(BM_copy_static_string);
+BENCHMARK(BM_copy_small_string);
+BENCHMARK(BM_find_std_string);
+BENCHMARK(BM_find_static_string);
+BENCHMARK(BM_find_small_string);
+BENCHMARK(BM_compare_static_string_via_temporary);
+BENCHMARK(BM_compare_static_string);
+BENCHMARK(BM_sort_std_string);
+BENCHMARK(BM_sort_static_string);
+BENCHMARK(BM_sort_small_string);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,108 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/static_vector.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <new>
+
+
+// These benchmarks run two simple loops, a sum and an in-place scale, over
+// state.range(0) elements of static_vector<value, 1024>, whose element type
+// has a user-provided copy constructor, so static_vector keeps it in its
+// union-of-T[N] storage, and over the same elements in a buffer_vector,
+// which keeps them in an alignas(T) unsigned char buffer that is read
+// through reinterpret_cast, as static_vector used to.  Any difference is
+// the difference the compiler's view of the storage makes to how the loops
+// are optimized, vectorized or not.
+
+namespace bsi = boost::stl_interfaces;
+
+struct value
+{
+    value(int x) : x(x) {}
+    value(value const & other) : x(other.x) {}
+    value & operator=(value const & other)
+    {
+        x = other.x;
+        return *this;
+    }
+    int x;
+};
+
+constexpr std::size_t capacity = 1024;
+
+using union_vector = bsi::static_vector<value, capacity>;
+
+// Just enough of the old layout to loop over.
+struct buffer_vector
+{
+    buffer_vector() = default;
+    buffer_vector(buffer_vector const &) = delete;
+    ~buffer_vector()
+    {
+        for (auto & x : *this) {
+            x.~value();
+        }
+    }
+
+    void push_back(value const & x)
+    {
+        new (buf_ + size_ * sizeof(value)) value(x);
+        ++size_;
+    }
+
+    value * begin() noexcept { return reinterpret_cast<value *>(buf_); }
+    value * end() noexcept { return begin() + size_; }
+
+private:
+    alignas(value) unsigned char buf_[capacity * sizeof(value)];
+    std::size_t size_ = 0;
+};
+
+template<typename Vec>
+void fill(Vec & v, benchmark::State & state)
+{
+    for (int i = 0, n = state.range(0); i < n; ++i) {
+        v.push_back(value(i * 7 % 1000));
+    }
+}
+
+template<typename Vec>
+void BM_sum(benchmark::State & state)
+{
+    Vec v;
+    fill(v, state);
+    for (auto _ : state) {
+        int sum = 0;
+        for (auto const & x : v) {
+            sum += x.x;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template<typename Vec>
+void BM_scale(benchmark::State & state)
+{
+    Vec v;
+    fill(v, state);
+    for (auto _ : state) {
+        for (auto & x : v) {
+            x.x = x.x * 3 + 1;
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_TEMPLATE(BM_sum, union_vector)->Arg(64)->Arg(1024);
+BENCHMARK_TEMPLATE(BM_sum, buffer_vector)->Arg(64)->Arg(1024);
+BENCHMARK_TEMPLATE(BM_scale, union_vector)->Arg(64)->Arg(1024);
+BENCHMARK_TEMPLATE(BM_scale, buffer_vector)->Arg(64)->Arg(1024);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,88 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/strided_view.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <vector>
+
+
+// BM_deinterleave_* copy the left channel out of a buffer of interleaved
+// stereo samples; BM_column_* copy a column out of a row-major matrix.
+
+int const frames = 1 << 16;
+std::vector<float> const samples(2 * frames, 1.0f);
+
+int const rows = 1024;
+int const cols = 1024;
+std::vector<float> const matrix(rows * cols, 1.0f);
+
+// A stride known only at run time, copied one element at a time.
+void BM_deinterleave_std_copy(benchmark::State & state)
+{
+    namespace bsi = boost::stl_interfaces;
+    std::vector<float> left(frames);
+    auto const v = bsi::make_strided_view(samples.data(), frames, 2);
+    for (auto _ : state) {
+        std::copy(v.begin(), v.end(), left.data());
+        benchmark::DoNotOptimize(left.data());
+    }
+}
+
+// The gather copy(), with a stride known only at run time.
+void BM_deinterleave_gather(benchmark::State & state)
+{
+    namespace bsi = boost::stl_interfaces;
+    std::vector<float> left(frames);
+    auto const v = bsi::make_strided_view(samples.data(), frames, 2);
+    for (auto _ : state) {
+        bsi::copy(v.begin(), v.end(), left.data());
+        benchmark::DoNotOptimize(left.data());
+    }
+}
+
+// The gather copy(), with a stride known at compile time.
+void BM_deinterleave_gather_static(benchmark::State & state)
+{
+    namespace bsi = boost::stl_interfaces;
+    std::vector<float> left(frames);
+    auto const v = bsi::make_strided_view<2>(samples.data(), frames);
+    for (auto _ : state) {
+        bsi::copy(v.begin(), v.end(), left.data());
+        benchmark::DoNotOptimize(left.data());
+    }
+}
+
+void BM_column_std_copy(benchmark::State & state)
+{
+    namespace bsi = boost::stl_interfaces;
+    std::vector<float> col(rows);
+    auto const v = bsi::make_strided_view(matrix.data() + 7, rows, cols);
+    for (auto _ : state) {
+        std::copy(v.begin(), v.end(), col.data());
+        benchmark::DoNotOptimize(col.data());
+    }
+}
+
+void BM_column_gather_static(benchmark::State & state)
+{
+    namespace bsi = boost::stl_interfaces;
+    std::vector<float> col(rows);
+    auto const v = bsi::make_strided_view<cols>(matrix.data() + 7, rows);
+    for (auto _ : state) {
+        bsi::copy(v.begin(), v.end(), col.data());
+        benchmark::DoNotOptimize(col.data());
+    }
+}
+
+BENCHMARK(BM_deinterleave_std_copy);
+BENCHMARK(BM_deinterleave_gather);
+BENCHMARK(BM_deinterleave_gather_static);
+BENCHMARK(BM_column_std_copy);
+BENCHMARK(BM_column_gather_static);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,81 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/thread_caching_allocator.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <list>
+#include <map>
+#include <memory>
+#include <thread>
+#include <vector>
+
+
+// These benchmarks compare std::allocator with thread_caching_allocator for
+// the nodes of std::list<int> and std::map<int, int>: filling and clearing
+// a container on one thread; and, as in a pipeline, filling lists of 1K
+// nodes on one thread and destroying them on another, 256 lists at a time.
+
+constexpr int nodes = 1 << 10;
+
+template<template<typename> class Alloc>
+void BM_list_churn(benchmark::State & state)
+{
+    std::list<int, Alloc<int>> l;
+    for (auto _ : state) {
+        for (int i = 0; i < nodes; ++i) {
+            l.push_back(i);
+        }
+        l.clear();
+    }
+}
+
+template<template<typename> class Alloc>
+void BM_map_churn(benchmark::State & state)
+{
+    std::map<int, int, std::less<int>, Alloc<std::pair<int const, int>>> m;
+    for (auto _ : state) {
+        for (int i = 0; i < nodes; ++i) {
+            m.emplace(i * 7919 % nodes, i);
+        }
+        m.clear();
+    }
+}
+
+template<template<typename> class Alloc>
+void BM_cross_thread(benchmark::State & state)
+{
+    using list_type = std::list<int, Alloc<int>>;
+    for (auto _ : state) {
+        std::vector<list_type> lists(256);
+        std::thread producer([&] {
+            for (auto & l : lists) {
+                for (int i = 0; i < nodes; ++i) {
+                    l.push_back(i);
+                }
+            }
+        });
+        producer.join();
+        std::thread consumer([&] { lists.clear(); });
+        consumer.join();
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_list_churn, std::allocator);
+BENCHMARK_TEMPLATE(
+    BM_list_churn, boost::stl_interfaces::thread_caching_allocator);
+BENCHMARK_TEMPLATE(BM_map_churn, std::allocator);
+BENCHMARK_TEMPLATE(
+    BM_map_churn, boost::stl_interfaces::thread_caching_allocator);
+BENCHMARK_TEMPLATE(BM_cross_thread, std::allocator)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(
+    BM_cross_thread, boost::stl_interfaces::thread_caching_allocator)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+BENCHMARK_MAIN();
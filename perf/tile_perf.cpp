@@ -0,0 +1,83 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/tile_view.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <vector>
+
+
+// These benchmarks transpose a 2048x2048 row-major matrix of floats: one
+// element at a time, in hand-coded 32x32 blocks, and in the tiles of a
+// tile_view.
+
+namespace bsi = boost::stl_interfaces;
+
+using extents = bsi::extents<bsi::dynamic_extent, bsi::dynamic_extent>;
+
+int const n = 2048;
+int const block = 32;
+std::vector<float> const input(n * n, 1.0f);
+
+void BM_transpose_naive(benchmark::State & state)
+{
+    std::vector<float> output(n * n);
+    for (auto _ : state) {
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < n; ++j) {
+                output[j * n + i] = input[i * n + j];
+            }
+        }
+        benchmark::DoNotOptimize(output.data());
+    }
+}
+
+void BM_transpose_hand_blocked(benchmark::State & state)
+{
+    std::vector<float> output(n * n);
+    for (auto _ : state) {
+        for (int i0 = 0; i0 < n; i0 += block) {
+            for (int j0 = 0; j0 < n; j0 += block) {
+                int const i_last = (std::min)(i0 + block, n);
+                int const j_last = (std::min)(j0 + block, n);
+                for (int i = i0; i < i_last; ++i) {
+                    for (int j = j0; j < j_last; ++j) {
+                        output[j * n + i] = input[i * n + j];
+                    }
+                }
+            }
+        }
+        benchmark::DoNotOptimize(output.data());
+    }
+}
+
+void BM_transpose_tile_view(benchmark::State & state)
+{
+    std::vector<float> output(n * n);
+    bsi::md_view<float const, extents> const in(input.data(), n, n);
+    bsi::md_view<float, extents> const out(output.data(), n, n);
+    auto const tiles = bsi::make_tile_view(in, block, block);
+    for (auto _ : state) {
+        for (auto it = tiles.begin(); it != tiles.end(); ++it) {
+            auto const tile = *it;
+            auto const r = it.row();
+            auto const c = it.column();
+            for (std::ptrdiff_t i = 0; i < tile.extent(0); ++i) {
+                for (std::ptrdiff_t j = 0; j < tile.extent(1); ++j) {
+                    out(c + j, r + i) = tile(i, j);
+                }
+            }
+        }
+        benchmark::DoNotOptimize(output.data());
+    }
+}
+
+BENCHMARK(BM_transpose_naive);
+BENCHMARK(BM_transpose_hand_blocked);
+BENCHMARK(BM_transpose_tile_view);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,95 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/parallel.hpp>
+#include <boost/stl_interfaces/to.hpp>
+#include <boost/stl_interfaces/transform_view.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+#include <vector>
+
+
+// These benchmarks materialize 4M ints into a new std::vector, from a
+// std::vector and from a transform_view of one, as the last step of a
+// pipeline does: with std::copy() through std::back_inserter(), with to(),
+// and with parallel_to() on default_thread_pool().
+
+namespace bsi = boost::stl_interfaces;
+
+int const size = 1 << 22;
+
+std::vector<int> make_ints()
+{
+    std::vector<int> retval(size);
+    std::iota(retval.begin(), retval.end(), 0);
+    return retval;
+}
+
+std::vector<int> const ints = make_ints();
+
+auto const doubled =
+    bsi::make_transform_view(ints, [](int x) { return 2 * x; });
+
+template<typename Range>
+void back_inserter_copy(benchmark::State & state, Range const & r)
+{
+    for (auto _ : state) {
+        std::vector<int> out;
+        std::copy(r.begin(), r.end(), std::back_inserter(out));
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+template<typename Range>
+void to(benchmark::State & state, Range const & r)
+{
+    for (auto _ : state) {
+        auto const out = bsi::to<std::vector<int>>(r);
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+template<typename Range>
+void parallel_to(benchmark::State & state, Range const & r)
+{
+    for (auto _ : state) {
+        auto const out = bsi::parallel_to<std::vector<int>>(r);
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+void BM_vector_back_inserter(benchmark::State & state)
+{
+    back_inserter_copy(state, ints);
+}
+void BM_vector_to(benchmark::State & state) { to(state, ints); }
+void BM_vector_parallel_to(benchmark::State & state)
+{
+    parallel_to(state, ints);
+}
+
+void BM_transform_back_inserter(benchmark::State & state)
+{
+    back_inserter_copy(state, doubled);
+}
+void BM_transform_to(benchmark::State & state) { to(state, doubled); }
+void BM_transform_parallel_to(benchmark::State & state)
+{
+    parallel_to(state, doubled);
+}
+
+BENCHMARK(BM_vector_back_inserter);
+BENCHMARK(BM_vector_to);
+BENCHMARK(BM_vector_parallel_to);
+BENCHMARK(BM_transform_back_inserter);
+BENCHMARK(BM_transform_to);
+BENCHMARK(BM_transform_parallel_to);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,107 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/transform_view.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+
+// These benchmarks binary-search a large sorted array of records by a key
+// projected out of each record, as a query pipeline does; std::lower_bound
+// copies its iterators at each step.
+
+struct record
+{
+    long key;
+    long payload[3];
+};
+
+std::vector<record> make_records()
+{
+    std::vector<record> retval(1 << 20);
+    for (std::size_t i = 0; i < retval.size(); ++i) {
+        retval[i].key = long(2 * i);
+    }
+    return retval;
+}
+
+std::vector<record> const records = make_records();
+
+// A hand-written projecting iterator, which holds its functor as a member,
+// as the ad-hoc ones do: even an empty functor costs a word.
+template<typename F>
+struct member_transform_iterator : boost::stl_interfaces::iterator_interface<
+                                       member_transform_iterator<F>,
+                                       std::random_access_iterator_tag,
+                                       long,
+                                       long const &>
+{
+    member_transform_iterator() = default;
+    member_transform_iterator(record const * it, F f) : it_(it), f_(f) {}
+
+    long const & operator*() const { return f_(*it_); }
+
+private:
+    friend boost::stl_interfaces::access;
+    record const *& base_reference() noexcept { return it_; }
+    record const * base_reference() const noexcept { return it_; }
+
+    record const * it_;
+    F f_;
+};
+
+struct key_of
+{
+    long const & operator()(record const & r) const { return r.key; }
+};
+
+void BM_lower_bound_member(benchmark::State & state)
+{
+    using iter = member_transform_iterator<key_of>;
+    iter const first(records.data(), key_of{});
+    iter const last(records.data() + records.size(), key_of{});
+    long k = 0;
+    for (auto _ : state) {
+        auto const it = std::lower_bound(first, last, k);
+        benchmark::DoNotOptimize(it);
+        k = (k + 7919) & ((1 << 21) - 1);
+    }
+}
+
+void BM_lower_bound_transform_iterator(benchmark::State & state)
+{
+    auto const v =
+        boost::stl_interfaces::make_transform_view(records, key_of{});
+    long k = 0;
+    for (auto _ : state) {
+        auto const it = std::lower_bound(v.begin(), v.end(), k);
+        benchmark::DoNotOptimize(it);
+        k = (k + 7919) & ((1 << 21) - 1);
+    }
+}
+
+void BM_lower_bound_projection(benchmark::State & state)
+{
+    long k = 0;
+    for (auto _ : state) {
+        auto const it = std::lower_bound(
+            records.begin(),
+            records.end(),
+            k,
+            [](record const & r, long k) { return r.key < k; });
+        benchmark::DoNotOptimize(it);
+        k = (k + 7919) & ((1 << 21) - 1);
+    }
+}
+
+BENCHMARK(BM_lower_bound_member);
+BENCHMARK(BM_lower_bound_transform_iterator);
+BENCHMARK(BM_lower_bound_projection);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,153 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#define BOOST_STL_INTERFACES_DISABLE_CMCSTL2
+#include <boost/stl_interfaces/iterator_interface.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+
+// These benchmarks compare iterators made with v1's iterator_interface
+// against identical iterators made with v2's, in the same C++20 build, so
+// that nothing differs but the interface: user_ops iterators define
+// operator*(), operator+=() and operator-(), and adapted iterators only
+// base_reference().  BM_ordered_sum loops on the relational operators,
+// which v1 defines in terms of operator-(), and v2 synthesizes from its
+// operator<=>(); BM_sort, BM_lower_bound and BM_reverse_find use the
+// iterators through the std algorithms.  See also
+// test/codegen/v1_v2_random_access.cpp, which compares the code generated
+// for each.
+
+#define BOOST_STL_INTERFACES_PERF_ITERATORS(ns)                                \
+    struct ns##_user_ops_iter : boost::stl_interfaces::ns::iterator_interface< \
+                                    ns##_user_ops_iter,                        \
+                                    std::random_access_iterator_tag,           \
+                                    int>                                       \
+    {                                                                          \
+        ns##_user_ops_iter() noexcept {}                                       \
+        ns##_user_ops_iter(int * it) noexcept : it_(it) {}                     \
+                                                                               \
+        int & operator*() const noexcept { return *it_; }                      \
+        ns##_user_ops_iter & operator+=(std::ptrdiff_t i) noexcept             \
+        {                                                                      \
+            it_ += i;                                                          \
+            return *this;                                                      \
+        }                                                                      \
+        friend std::ptrdiff_t                                                  \
+        operator-(ns##_user_ops_iter lhs, ns##_user_ops_iter rhs) noexcept     \
+        {                                                                      \
+            return lhs.it_ - rhs.it_;                                          \
+        }                                                                      \
+                                                                               \
+    private:                                                                   \
+        int * it_;                                                             \
+    };                                                                         \
+                                                                               \
+    struct ns##_adapted_iter : boost::stl_interfaces::ns::iterator_interface<  \
+                                   ns##_adapted_iter,                          \
+                                   std::random_access_iterator_tag,            \
+                                   int>                                        \
+    {                                                                          \
+        ns##_adapted_iter() noexcept {}                                        \
+        ns##_adapted_iter(int * it) noexcept : it_(it) {}                      \
+                                                                               \
+    private:                                                                   \
+        friend boost::stl_interfaces::access;                                  \
+        int *& base_reference() noexcept { return it_; }                       \
+        int * base_reference() const noexcept { return it_; }                  \
+                                                                               \
+        int * it_;                                                             \
+    }
+
+BOOST_STL_INTERFACES_PERF_ITERATORS(v1);
+BOOST_STL_INTERFACES_PERF_ITERATORS(v2);
+
+
+std::vector<int> random_ints(std::ptrdiff_t n)
+{
+    std::mt19937 g(42);
+    std::uniform_int_distribution<int> dist;
+    std::vector<int> retval(n);
+    std::generate(retval.begin(), retval.end(), [&] { return dist(g); });
+    return retval;
+}
+
+template<typename Iter>
+void BM_ordered_sum(benchmark::State & state)
+{
+    std::vector<int> ints = random_ints(state.range(0));
+    for (auto _ : state) {
+        unsigned int sum = 0;
+        Iter first(ints.data());
+        Iter const last(ints.data() + ints.size());
+        for (; first < last; first += 2) {
+            if (first + 1 <= last - 1)
+                sum += first[1];
+            sum += *first;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template<typename Iter>
+void BM_sort(benchmark::State & state)
+{
+    std::vector<int> const ints = random_ints(state.range(0));
+    std::vector<int> buf(ints.size());
+    for (auto _ : state) {
+        std::copy(ints.begin(), ints.end(), buf.begin());
+        std::sort(Iter(buf.data()), Iter(buf.data() + buf.size()));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template<typename Iter>
+void BM_lower_bound(benchmark::State & state)
+{
+    std::vector<int> ints = random_ints(state.range(0));
+    std::sort(ints.begin(), ints.end());
+    std::vector<int> const keys = random_ints(1024);
+    Iter const first(ints.data());
+    Iter const last(ints.data() + ints.size());
+    for (auto _ : state) {
+        for (auto key : keys) {
+            benchmark::DoNotOptimize(std::lower_bound(first, last, key));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * int64_t(keys.size()));
+}
+
+template<typename Iter>
+void BM_reverse_find(benchmark::State & state)
+{
+    std::vector<int> ints(state.range(0), 0);
+    ints.front() = 1;
+    std::reverse_iterator<Iter> const first(Iter(ints.data() + ints.size()));
+    std::reverse_iterator<Iter> const last(Iter(ints.data()));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::find(first, last, 1));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+#define BOOST_STL_INTERFACES_PERF_ITERATOR(iter)                               \
+    BENCHMARK_TEMPLATE(BM_ordered_sum, iter)->Arg(1 << 16);                    \
+    BENCHMARK_TEMPLATE(BM_sort, iter)->Arg(1 << 16);                           \
+    BENCHMARK_TEMPLATE(BM_lower_bound, iter)->Arg(1 << 16);                    \
+    BENCHMARK_TEMPLATE(BM_reverse_find, iter)->Arg(1 << 16)
+
+BOOST_STL_INTERFACES_PERF_ITERATOR(int *);
+BOOST_STL_INTERFACES_PERF_ITERATOR(v1_user_ops_iter);
+BOOST_STL_INTERFACES_PERF_ITERATOR(v2_user_ops_iter);
+BOOST_STL_INTERFACES_PERF_ITERATOR(v1_adapted_iter);
+BOOST_STL_INTERFACES_PERF_ITERATOR(v2_adapted_iter);
+
+BENCHMARK_MAIN();
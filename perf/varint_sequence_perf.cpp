@@ -0,0 +1,136 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/varint_sequence.hpp>
+
+#include "bench_data.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <numeric>
+#include <vector>
+
+
+using boost::stl_interfaces::varint_sequence;
+
+namespace stream_vbyte = boost::stl_interfaces::stream_vbyte;
+
+
+// These benchmarks decode a posting list of 1M sorted document IDs, whose
+// differences are random in [0, 1000), so that most take two bytes.  The
+// LEB128 baseline is the usual varint: 7 bits per byte, with the high bit
+// set on every byte but a value's last.  Each reports the bytes its
+// encoding takes as the "bytes" counter.
+
+std::vector<std::uint32_t> make_postings()
+{
+    std::vector<std::uint32_t> retval;
+    std::uint32_t x = 0;
+    for (int delta : bench_data::random_ints(1 << 20, 1000)) {
+        x += std::uint32_t(delta);
+        retval.push_back(x);
+    }
+    return retval;
+}
+
+std::vector<std::uint32_t> const postings = make_postings();
+
+std::vector<std::uint8_t> leb128_encode(std::vector<std::uint32_t> const & v)
+{
+    std::vector<std::uint8_t> retval;
+    std::uint32_t prev = 0;
+    for (auto x : v) {
+        auto delta = x - prev;
+        prev = x;
+        for (; 0x80 <= delta; delta >>= 7) {
+            retval.push_back(std::uint8_t(delta | 0x80));
+        }
+        retval.push_back(std::uint8_t(delta));
+    }
+    return retval;
+}
+
+void BM_sum_plain(benchmark::State & state)
+{
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            std::accumulate(postings.begin(), postings.end(), 0u));
+    }
+    state.counters["bytes"] = double(postings.size() * 4);
+}
+
+void BM_decode_leb128(benchmark::State & state)
+{
+    auto const bytes = leb128_encode(postings);
+    std::vector<std::uint32_t> out(postings.size());
+    for (auto _ : state) {
+        auto p = bytes.data();
+        std::uint32_t prev = 0;
+        for (auto & x : out) {
+            std::uint32_t delta = 0;
+            int shift = 0;
+            for (;; shift += 7) {
+                auto const b = *p++;
+                delta |= std::uint32_t(b & 0x7f) << shift;
+                if (b < 0x80)
+                    break;
+            }
+            prev += delta;
+            x = prev;
+        }
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.counters["bytes"] = double(bytes.size());
+}
+
+// One value per operator++().
+void BM_decode_iterator(benchmark::State & state)
+{
+    varint_sequence const s(postings.begin(), postings.end());
+    std::vector<std::uint32_t> out(postings.size());
+    for (auto _ : state) {
+        std::copy(s.begin(), s.end(), out.begin());
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.counters["bytes"] = double(s.encoded_size());
+}
+
+// Four values at a time, without the SIMD shuffle.
+void BM_decode_bulk_scalar(benchmark::State & state)
+{
+    varint_sequence const s(postings.begin(), postings.end());
+    auto const view = s.view();
+    std::vector<std::uint32_t> out(postings.size());
+    for (auto _ : state) {
+        stream_vbyte::decode_groups_scalar(
+            view.control_bytes(),
+            view.data_bytes(),
+            out.size() / 4,
+            0,
+            out.data());
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.counters["bytes"] = double(s.encoded_size());
+}
+
+// Four values at a time, with the shuffle where the CPU has it.
+void BM_decode_bulk(benchmark::State & state)
+{
+    varint_sequence const s(postings.begin(), postings.end());
+    std::vector<std::uint32_t> out(postings.size());
+    for (auto _ : state) {
+        s.view().decode(out.data());
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.counters["bytes"] = double(s.encoded_size());
+}
+
+BENCHMARK(BM_sum_plain);
+BENCHMARK(BM_decode_leb128);
+BENCHMARK(BM_decode_iterator);
+BENCHMARK(BM_decode_bulk_scalar);
+BENCHMARK(BM_decode_bulk);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,92 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/work_stealing_pool.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+
+// These benchmarks run a skewed workload -- the cost of element i falls off
+// as 1 / (i + 1) -- through the fork-join parallel_for_each() on views,
+// the chunked parallel_for_each() on a thread_pool, and parallel_for_each()
+// on a work_stealing_pool.
+
+namespace bsi = boost::stl_interfaces;
+
+struct int_view : bsi::view_interface<int_view>
+{
+    int_view(int const * first, int const * last) : first_(first), last_(last)
+    {}
+
+    int const * begin() const { return first_; }
+    int const * end() const { return last_; }
+
+private:
+    int const * first_;
+    int const * last_;
+};
+
+std::vector<int> const ints = [] {
+    std::vector<int> retval(1 << 14);
+    std::iota(retval.begin(), retval.end(), 0);
+    return retval;
+}();
+int_view const v(ints.data(), ints.data() + ints.size());
+
+unsigned int const threads =
+    (std::max)(std::thread::hardware_concurrency(), 2u);
+
+struct work
+{
+    void operator()(int x) const
+    {
+        unsigned int s = x;
+        for (int i = 0, n = (1 << 18) / (x + 1) + 8; i < n; ++i) {
+            s = s * 1664525u + 1013904223u;
+        }
+        sum_ += s;
+    }
+    std::atomic<unsigned int> & sum_;
+};
+
+void BM_fork_join(benchmark::State & state)
+{
+    std::atomic<unsigned int> sum(0);
+    for (auto _ : state) {
+        bsi::parallel_for_each(v, work{sum}, 64, threads);
+    }
+    benchmark::DoNotOptimize(sum.load());
+}
+
+void BM_thread_pool(benchmark::State & state)
+{
+    bsi::thread_pool pool(threads - 1);
+    std::atomic<unsigned int> sum(0);
+    for (auto _ : state) {
+        bsi::parallel_for_each(pool, v.begin(), v.end(), work{sum}, 64);
+    }
+    benchmark::DoNotOptimize(sum.load());
+}
+
+void BM_work_stealing(benchmark::State & state)
+{
+    bsi::work_stealing_pool pool(threads);
+    std::atomic<unsigned int> sum(0);
+    for (auto _ : state) {
+        bsi::parallel_for_each(pool, v, work{sum}, 64);
+    }
+    benchmark::DoNotOptimize(sum.load());
+}
+
+BENCHMARK(BM_fork_join)->UseRealTime();
+BENCHMARK(BM_thread_pool)->UseRealTime();
+BENCHMARK(BM_work_stealing)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,128 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/zip_view.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <numeric>
+#include <vector>
+
+
+namespace bsi = boost::stl_interfaces;
+
+// The zip iterator from the zip_proxy_iterator example, generalized to three
+// components: each step advances every component.
+struct per_component_zip : bsi::proxy_iterator_interface<
+                               per_component_zip,
+                               std::random_access_iterator_tag,
+                               std::tuple<int, double, long>,
+                               bsi::zip_reference<int &, double &, long &>>
+{
+    per_component_zip() noexcept : a_(), b_(), c_() {}
+    per_component_zip(int * a, double * b, long * c) noexcept :
+        a_(a),
+        b_(b),
+        c_(c)
+    {}
+
+    reference operator*() const noexcept { return reference(*a_, *b_, *c_); }
+    per_component_zip & operator+=(std::ptrdiff_t i) noexcept
+    {
+        a_ += i;
+        b_ += i;
+        c_ += i;
+        return *this;
+    }
+    friend std::ptrdiff_t
+    operator-(per_component_zip lhs, per_component_zip rhs) noexcept
+    {
+        return lhs.a_ - rhs.a_;
+    }
+
+private:
+    int * a_;
+    double * b_;
+    long * c_;
+};
+
+struct columns
+{
+    explicit columns(std::size_t n) : a(n), b(n), c(n)
+    {
+        std::iota(a.begin(), a.end(), 0);
+        std::iota(b.begin(), b.end(), 0.0);
+        std::iota(c.begin(), c.end(), 0l);
+    }
+    std::vector<int> a;
+    std::vector<double> b;
+    std::vector<long> c;
+};
+
+using zip_type = bsi::zip_iterator<int *, double *, long *>;
+
+zip_type zip_begin(columns & cols)
+{
+    return zip_type(cols.a.data(), cols.b.data(), cols.c.data());
+}
+
+void BM_sum_per_component_zip(benchmark::State & state)
+{
+    columns cols(state.range(0));
+    for (auto _ : state) {
+        per_component_zip first(cols.a.data(), cols.b.data(), cols.c.data());
+        auto const last = first + cols.a.size();
+        double sum = 0.0;
+        for (; first != last; ++first) {
+            auto const elem = *first;
+            sum += std::get<0>(elem) * std::get<1>(elem) + std::get<2>(elem);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+void BM_sum_zip_iterator(benchmark::State & state)
+{
+    columns cols(state.range(0));
+    for (auto _ : state) {
+        auto first = zip_begin(cols);
+        auto const last = first + cols.a.size();
+        double sum = 0.0;
+        for (; first != last; ++first) {
+            auto const elem = *first;
+            sum += std::get<0>(elem) * std::get<1>(elem) + std::get<2>(elem);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+void BM_copy_std(benchmark::State & state)
+{
+    columns from(state.range(0));
+    columns to(state.range(0));
+    for (auto _ : state) {
+        auto const first = zip_begin(from);
+        std::copy(first, first + from.a.size(), zip_begin(to));
+        benchmark::ClobberMemory();
+    }
+}
+
+void BM_copy_zip(benchmark::State & state)
+{
+    columns from(state.range(0));
+    columns to(state.range(0));
+    for (auto _ : state) {
+        auto const first = zip_begin(from);
+        bsi::copy(first, first + from.a.size(), zip_begin(to));
+        benchmark::ClobberMemory();
+    }
+}
+
+BENCHMARK(BM_sum_per_component_zip)->RangeMultiplier(16)->Range(1 << 8, 1 << 16);
+BENCHMARK(BM_sum_zip_iterator)->RangeMultiplier(16)->Range(1 << 8, 1 << 16);
+BENCHMARK(BM_copy_std)->RangeMultiplier(16)->Range(1 << 8, 1 << 16);
+BENCHMARK(BM_copy_zip)->RangeMultiplier(16)->Range(1 << 8, 1 << 16);
+
+BENCHMARK_MAIN();
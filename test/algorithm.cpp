@@ -0,0 +1,411 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/algorithm.hpp>
+#include <boost/stl_interfaces/static_vector.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <list>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+
+namespace bsi = boost::stl_interfaces;
+
+template<typename T, typename Tag>
+struct adapted_iter
+    : bsi::iterator_interface<adapted_iter<T, Tag>, Tag, T>
+{
+    adapted_iter() : it_(nullptr) {}
+    adapted_iter(T * it) : it_(it) {}
+
+private:
+    friend bsi::access;
+    T *& base_reference() noexcept { return it_; }
+    T * base_reference() const noexcept { return it_; }
+
+    T * it_;
+};
+
+template<typename T>
+using contiguous_iter = adapted_iter<T, bsi::contiguous_iterator_tag>;
+template<typename T>
+using random_access_iter = adapted_iter<T, std::random_access_iterator_tag>;
+
+static_assert(
+    bsi::v1_dtl::simd_searchable<contiguous_iter<int>, int>::value, "");
+static_assert(bsi::v1_dtl::simd_searchable<char const *, int>::value, "");
+static_assert(
+    !bsi::v1_dtl::simd_searchable<random_access_iter<int>, int>::value, "");
+static_assert(!bsi::v1_dtl::simd_searchable<double *, int>::value, "");
+static_assert(!bsi::v1_dtl::simd_searchable<int *, double>::value, "");
+static_assert(!bsi::v1_dtl::simd_searchable<bool *, bool>::value, "");
+static_assert(!bsi::v1_dtl::simd_orderable<float *>::value, "");
+static_assert(
+    bsi::v1_dtl::simd_searchable_reversed<
+        bsi::reverse_iterator<contiguous_iter<int>>,
+        int>::value,
+    "");
+static_assert(
+    bsi::v1_dtl::simd_searchable_reversed<std::reverse_iterator<int *>, int>::
+        value,
+    "");
+static_assert(
+    !bsi::v1_dtl::simd_searchable_reversed<
+        bsi::reverse_iterator<random_access_iter<int>>,
+        int>::value,
+    "");
+static_assert(!bsi::v1_dtl::simd_searchable_reversed<int *, int>::value, "");
+
+namespace {
+    template<typename T>
+    std::vector<T> random_values(std::size_t n, int lo, int hi)
+    {
+        std::mt19937 gen(42);
+        std::uniform_int_distribution<int> dist(lo, hi);
+        std::vector<T> retval(n);
+        for (auto & x : retval) {
+            x = T(dist(gen));
+        }
+        return retval;
+    }
+
+    // Checks find(), count(), mismatch(), equal(), min_element() and
+    // max_element() against their std:: counterparts, forward and (for
+    // find(), count() and equal()) backward, for every length up to 200,
+    // so that every vector loop and tail is used.
+    template<typename T>
+    void check_against_std()
+    {
+        auto values = random_values<T>(200, 0, 40);
+        for (std::size_t n = 0; n <= values.size(); ++n) {
+            T * const first = values.data();
+            T * const last = first + n;
+            contiguous_iter<T> const cfirst(first);
+            contiguous_iter<T> const clast(last);
+            for (int x : {0, 7, 40, 41}) {
+                EXPECT_EQ(
+                    bsi::find(cfirst, clast, T(x)) - cfirst,
+                    std::find(first, last, T(x)) - first)
+                    << "n=" << n << " x=" << x;
+                EXPECT_EQ(
+                    bsi::count(first, last, T(x)),
+                    std::count(first, last, T(x)))
+                    << "n=" << n << " x=" << x;
+
+                bsi::reverse_iterator<contiguous_iter<T>> const rfirst(clast);
+                bsi::reverse_iterator<contiguous_iter<T>> const rlast(cfirst);
+                std::reverse_iterator<T *> const std_rfirst(last);
+                std::reverse_iterator<T *> const std_rlast(first);
+                EXPECT_EQ(
+                    bsi::find(rfirst, rlast, T(x)) - rfirst,
+                    std::find(std_rfirst, std_rlast, T(x)) - std_rfirst)
+                    << "n=" << n << " x=" << x;
+                EXPECT_EQ(
+                    bsi::find(std_rfirst, std_rlast, T(x)),
+                    std::find(std_rfirst, std_rlast, T(x)))
+                    << "n=" << n << " x=" << x;
+                EXPECT_EQ(
+                    bsi::count(rfirst, rlast, T(x)),
+                    std::count(first, last, T(x)))
+                    << "n=" << n << " x=" << x;
+            }
+
+            std::vector<T> other(first, last);
+            for (std::size_t i = 0; i <= n; i += 13) {
+                if (i < n)
+                    other[i] = T(other[i] + 1);
+                auto const result =
+                    bsi::mismatch(cfirst, clast, other.begin());
+                auto const expected =
+                    std::mismatch(first, last, other.begin());
+                EXPECT_EQ(result.first - cfirst, expected.first - first);
+                EXPECT_EQ(result.second, expected.second);
+                EXPECT_EQ(
+                    bsi::equal(cfirst, clast, other.begin()),
+                    std::equal(first, last, other.begin()));
+                EXPECT_EQ(
+                    bsi::equal(
+                        bsi::make_reverse_iterator(clast),
+                        bsi::make_reverse_iterator(cfirst),
+                        other.rbegin(),
+                        other.rend()),
+                    i == n);
+                if (i < n)
+                    other[i] = values[i];
+            }
+
+            EXPECT_EQ(
+                bsi::min_element(cfirst, clast) - cfirst,
+                std::min_element(first, last) - first);
+            EXPECT_EQ(
+                bsi::max_element(cfirst, clast) - cfirst,
+                std::max_element(first, last) - first);
+        }
+    }
+}
+
+
+TEST(algorithm, every_element_type)
+{
+    check_against_std<char>();
+    check_against_std<signed char>();
+    check_against_std<std::uint8_t>();
+    check_against_std<short>();
+    check_against_std<std::uint16_t>();
+    check_against_std<int>();
+    check_against_std<unsigned int>();
+    check_against_std<long>();
+    check_against_std<unsigned long long>();
+    check_against_std<float>();
+    check_against_std<double>();
+}
+
+#ifdef BOOST_STL_INTERFACES_SIMD_DISPATCH
+
+namespace {
+    // Checks one instruction set's kernels against the std:: algorithms,
+    // for every length up to 600, which is more than four 64-byte vectors
+    // of bytes, plus tails of every length.
+    template<typename T>
+    void check_kernels(
+        std::size_t (*find)(T const *, std::size_t, T),
+        std::size_t (*find_last)(T const *, std::size_t, T),
+        std::size_t (*count)(T const *, std::size_t, T),
+        std::size_t (*mismatch)(T const *, T const *, std::size_t),
+        void (*reverse_copy)(T const *, std::size_t, T *),
+        T (*min)(T const *, std::size_t),
+        T (*max)(T const *, std::size_t))
+    {
+        auto const values = random_values<T>(600, 0, 100);
+        auto other = values;
+        T const * const p = values.data();
+        for (std::size_t n = 1; n <= values.size(); ++n) {
+            T const x = values[n - 1];
+            EXPECT_EQ(find(p, n, x), std::size_t(std::find(p, p + n, x) - p))
+                << "n=" << n;
+            EXPECT_EQ(find(p, n, T(101)), n) << "n=" << n;
+            T const y = values[n / 3];
+            EXPECT_EQ(
+                find_last(p, n, y),
+                std::size_t(
+                    std::find(
+                        std::reverse_iterator<T const *>(p + n),
+                        std::reverse_iterator<T const *>(p),
+                        y)
+                        .base() -
+                    p))
+                << "n=" << n;
+            EXPECT_EQ(find_last(p, n, T(101)), 0u) << "n=" << n;
+            EXPECT_EQ(count(p, n, x), std::size_t(std::count(p, p + n, x)))
+                << "n=" << n;
+            other[n / 2] = T(101);
+            EXPECT_EQ(mismatch(p, other.data(), n), n / 2) << "n=" << n;
+            other[n / 2] = values[n / 2];
+            EXPECT_EQ(mismatch(p, other.data(), n), n) << "n=" << n;
+            std::vector<T> reversed(n);
+            reverse_copy(p, n, reversed.data());
+            EXPECT_TRUE(std::equal(
+                reversed.begin(),
+                reversed.end(),
+                std::reverse_iterator<T const *>(p + n)))
+                << "n=" << n;
+            EXPECT_EQ(min(p, n), *std::min_element(p, p + n)) << "n=" << n;
+            EXPECT_EQ(max(p, n), *std::max_element(p, p + n)) << "n=" << n;
+        }
+    }
+
+#define CHECK_KERNELS(isa)                                                     \
+    check_kernels<T>(                                                          \
+        &bsi::detail::isa::find<L, T>,                                         \
+        &bsi::detail::isa::find_last<L, T>,                                    \
+        &bsi::detail::isa::count<L, T>,                                        \
+        &bsi::detail::isa::mismatch<L, T>,                                     \
+        &bsi::detail::isa::reverse_copy<L, T>,                                 \
+        &bsi::detail::isa::extremum<L, false, T>,                              \
+        &bsi::detail::isa::extremum<L, true, T>)
+
+    template<typename T>
+    void check_every_instruction_set()
+    {
+        using L = bsi::detail::simd_lane_t<T>;
+        auto const host = bsi::detail::simd_host_isa();
+        CHECK_KERNELS(simd_base);
+        if (bsi::detail::simd_isa::avx2 <= host)
+            CHECK_KERNELS(simd_avx2);
+        if (bsi::detail::simd_isa::avx512 <= host)
+            CHECK_KERNELS(simd_avx512);
+    }
+
+#undef CHECK_KERNELS
+}
+
+TEST(algorithm, every_instruction_set)
+{
+    check_every_instruction_set<std::int8_t>();
+    check_every_instruction_set<std::uint8_t>();
+    check_every_instruction_set<std::int16_t>();
+    check_every_instruction_set<std::uint32_t>();
+    check_every_instruction_set<std::int64_t>();
+    check_every_instruction_set<std::uint64_t>();
+}
+
+#endif
+
+TEST(algorithm, value_conversions)
+{
+    std::vector<std::uint8_t> bytes(100, 0);
+    bytes[60] = 255;
+    auto const b = bytes.data();
+    // 255 == -1 is false, and 255 == 511 is false, though both convert to
+    // 255.
+    EXPECT_EQ(bsi::find(b, b + 100, -1), b + 100);
+    EXPECT_EQ(bsi::count(b, b + 100, 511), 0);
+    EXPECT_EQ(bsi::find(b, b + 100, 255), b + 60);
+    EXPECT_EQ(bsi::count(b, b + 100, 0L), 99);
+
+    // UINT_MAX == -1 is true.
+    std::vector<unsigned int> uints(100, 0);
+    uints[70] = (std::numeric_limits<unsigned int>::max)();
+    auto const u = uints.data();
+    EXPECT_EQ(bsi::find(u, u + 100, -1), u + 70);
+
+    std::vector<int> ints(100, 0);
+    ints[30] = -1;
+    auto const i = ints.data();
+    EXPECT_EQ(bsi::find(i, i + 100, -1LL), i + 30);
+    EXPECT_EQ(bsi::count(i, i + 100, 1LL << 32), 0);
+    EXPECT_EQ(bsi::find(i, i + 100, 0.5), i + 100);
+
+    std::vector<double> doubles(100, 1.0);
+    doubles[20] = -0.0;
+    doubles[40] = std::numeric_limits<double>::quiet_NaN();
+    auto const d = doubles.data();
+    EXPECT_EQ(bsi::find(d, d + 100, 0.0), d + 20);
+    EXPECT_EQ(
+        bsi::find(d, d + 100, std::numeric_limits<double>::quiet_NaN()),
+        d + 100);
+    std::vector<double> const copy = doubles;
+    EXPECT_EQ(bsi::mismatch(d, d + 100, copy.data()).first, d + 40);
+}
+
+TEST(algorithm, extrema)
+{
+    std::vector<int> ints(1000, 5);
+    ints[100] = -3;
+    ints[900] = -3;
+    ints[200] = 8;
+    ints[999] = 8;
+    auto const i = ints.data();
+    EXPECT_EQ(bsi::min_element(i, i + 1000), i + 100);
+    EXPECT_EQ(bsi::max_element(i, i + 1000), i + 200);
+    EXPECT_EQ(bsi::min_element(i, i), i);
+
+    ints[999] = (std::numeric_limits<int>::max)();
+    ints[0] = (std::numeric_limits<int>::min)();
+    EXPECT_EQ(bsi::min_element(i, i + 1000), i);
+    EXPECT_EQ(bsi::max_element(i, i + 1000), i + 999);
+}
+
+TEST(algorithm, fallbacks)
+{
+    std::list<int> const list = {3, 1, 4, 1, 5, 9, 2, 6};
+    EXPECT_EQ(*std::next(bsi::find(list.begin(), list.end(), 5), 1), 9);
+    EXPECT_EQ(bsi::count(list.begin(), list.end(), 1), 2);
+    EXPECT_EQ(*bsi::min_element(list.begin(), list.end()), 1);
+    EXPECT_EQ(*bsi::max_element(list.begin(), list.end()), 9);
+
+    std::vector<int> ints(list.begin(), list.end());
+    random_access_iter<int> const first(ints.data());
+    random_access_iter<int> const last(ints.data() + ints.size());
+    EXPECT_EQ(bsi::find(first, last, 9) - first, 5);
+    EXPECT_EQ(
+        bsi::mismatch(first, last, list.begin(), list.end()).first, last);
+
+    bsi::static_vector<std::string, 8> strings = {"a", "b", "c"};
+    EXPECT_EQ(
+        bsi::find(strings.begin(), strings.end(), "b"), strings.begin() + 1);
+    EXPECT_EQ(bsi::count(strings.begin(), strings.end(), "d"), 0);
+    EXPECT_EQ(*bsi::max_element(strings.begin(), strings.end()), "c");
+}
+
+TEST(algorithm, static_vector)
+{
+    bsi::static_vector<std::uint16_t, 512> v;
+    for (int i = 0; i < 500; ++i) {
+        v.push_back(std::uint16_t(i * 7 % 501));
+    }
+    EXPECT_EQ(bsi::find(v.begin(), v.end(), 7 * 300 % 501), v.begin() + 300);
+    EXPECT_EQ(bsi::count(v.begin(), v.end(), 0), 1);
+    EXPECT_EQ(*bsi::max_element(v.begin(), v.end()), 500);
+    auto w = v;
+    w[321] = 0;
+    EXPECT_EQ(
+        bsi::mismatch(v.begin(), v.end(), w.begin(), w.end()).second,
+        w.begin() + 321);
+}
+
+TEST(algorithm, reverse_ranges)
+{
+    // A "latest first" scan over a time series.
+    bsi::static_vector<int, 1000> v;
+    for (int i = 0; i < 1000; ++i) {
+        v.push_back(i % 100);
+    }
+    EXPECT_EQ(bsi::find(v.rbegin(), v.rend(), 42).base(), v.begin() + 943);
+    EXPECT_EQ(bsi::find(v.crbegin(), v.crend(), 100), v.crend());
+    EXPECT_EQ(bsi::count(v.rbegin(), v.rend(), 7), 10);
+
+    // Backward into a forward array, a reverse range, and back; the bytes
+    // go through the vector kernels.
+    std::vector<int> out(1000);
+    EXPECT_EQ(bsi::copy(v.rbegin(), v.rend(), out.data()), out.data() + 1000);
+    EXPECT_TRUE(std::equal(v.rbegin(), v.rend(), out.begin()));
+    bsi::static_vector<int, 1000> w(1000);
+    EXPECT_EQ(bsi::copy(v.crbegin(), v.crend(), w.rbegin()), w.rend());
+    EXPECT_EQ(v, w);
+    EXPECT_EQ(bsi::copy(out.data(), out.data() + 1000, w.rbegin()), w.rend());
+    EXPECT_EQ(v, w);
+    std::vector<std::uint8_t> bytes(300);
+    std::iota(bytes.begin(), bytes.end(), std::uint8_t(0));
+    std::vector<std::uint8_t> reversed_bytes(300);
+    bsi::copy(
+        bytes.data(),
+        bytes.data() + 300,
+        bsi::make_reverse_iterator(reversed_bytes.data() + 300));
+    EXPECT_TRUE(std::equal(
+        reversed_bytes.begin(), reversed_bytes.end(), bytes.rbegin()));
+
+    EXPECT_TRUE(bsi::equal(v.rbegin(), v.rend(), w.rbegin(), w.rend()));
+    EXPECT_TRUE(bsi::equal(v.rbegin(), v.rend(), w.rbegin()));
+    w[3] = -1;
+    EXPECT_FALSE(bsi::equal(v.rbegin(), v.rend(), w.rbegin(), w.rend()));
+    EXPECT_FALSE(bsi::equal(v.rbegin(), v.rend() - 1, w.rbegin(), w.rend()));
+
+    // The 5 at w[5] is outside the fill.
+    bsi::fill(w.rbegin() + 10, w.rend() - 10, 5);
+    EXPECT_EQ(w[9], 9);
+    EXPECT_EQ(w[10], 5);
+    EXPECT_EQ(w[989], 5);
+    EXPECT_EQ(w[990], 90);
+    EXPECT_EQ(bsi::count(w.begin(), w.end(), 5), 980 + 1);
+
+    // Elements that are not trivially copyable use the std:: algorithms.
+    bsi::static_vector<std::string, 4> strings = {"a", "b", "c"};
+    std::vector<std::string> reversed(3);
+    using std::copy;
+    copy(strings.rbegin(), strings.rend(), reversed.begin());
+    EXPECT_EQ(reversed, std::vector<std::string>({"c", "b", "a"}));
+    bsi::fill(strings.rbegin(), strings.rend(), "d");
+    EXPECT_EQ(strings[0], "d");
+    EXPECT_TRUE(bsi::equal(
+        strings.rbegin(), strings.rend(), strings.begin(), strings.end()));
+}
@@ -0,0 +1,252 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/alloc_vector.hpp>
+#include <boost/stl_interfaces/container_interface.hpp>
+#include <boost/stl_interfaces/small_vector.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+
+// These tests count the allocations and element constructions that the
+// members container_interface defaults -- assign(), insert(), resize(),
+// append_range() and swap() -- make in reference containers, so that a
+// change that adds an allocation or a copy to one of them fails here rather
+// than going unnoticed.
+
+namespace bsi = boost::stl_interfaces;
+using bsi::alloc_vector;
+using bsi::small_vector;
+
+namespace {
+    long allocations = 0;
+    long constructions = 0;
+}
+
+// Every allocation of the program goes through these.
+void * operator new(std::size_t size)
+{
+    ++allocations;
+    if (void * p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+void operator delete(void * p) noexcept { std::free(p); }
+void operator delete(void * p, std::size_t) noexcept { std::free(p); }
+
+// An element that counts its constructions.  Its copy constructor is not
+// noexcept, as that of a type with heap-allocated members would not be.
+struct counted
+{
+    counted() noexcept : x(0) { ++constructions; }
+    counted(int x) noexcept : x(x) { ++constructions; }
+    counted(counted const & other) : x(other.x) { ++constructions; }
+    counted(counted && other) noexcept : x(other.x) { ++constructions; }
+    counted & operator=(counted const &) = default;
+    counted & operator=(counted &&) = default;
+
+    int x;
+};
+
+struct tally
+{
+    long allocations;
+    long constructions;
+
+};
+
+// The allocations and constructions that f() makes.
+template<typename F>
+tally count(F f)
+{
+    long const allocations_before = allocations;
+    long const constructions_before = constructions;
+    f();
+    return {
+        allocations - allocations_before,
+        constructions - constructions_before};
+}
+
+::testing::AssertionResult
+made(tally t, long allocations, long constructions)
+{
+    if (t.allocations == allocations && t.constructions == constructions)
+        return ::testing::AssertionSuccess();
+    return ::testing::AssertionFailure()
+           << "made " << t.allocations << " allocations and "
+           << t.constructions << " constructions, instead of " << allocations
+           << " and " << constructions;
+}
+
+// A vector whose members, other than the few below, all come from
+// container_interface.  It has reserve() only if Reservable is true.
+template<typename T, bool Reservable>
+struct ref_vector
+    : bsi::container_interface<ref_vector<T, Reservable>, bsi::contiguous>
+{
+    using value_type = T;
+    using pointer = T *;
+    using const_pointer = T const *;
+    using reference = T &;
+    using const_reference = T const &;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using iterator = T *;
+    using const_iterator = T const *;
+
+    ref_vector() = default;
+    ref_vector(size_type n, T const & x) : v_(n, x) {}
+
+    iterator begin() noexcept { return v_.data(); }
+    iterator end() noexcept { return v_.data() + v_.size(); }
+    size_type max_size() const noexcept { return v_.max_size(); }
+    size_type capacity() const noexcept { return v_.capacity(); }
+
+    template<bool R = Reservable, typename Enable = std::enable_if_t<R>>
+    void reserve(size_type n)
+    {
+        v_.reserve(n);
+    }
+
+    template<typename Iter>
+    iterator insert(const_iterator pos, Iter first, Iter last)
+    {
+        auto const offset = pos - v_.data();
+        v_.insert(v_.begin() + offset, first, last);
+        return begin() + offset;
+    }
+    iterator erase(const_iterator first, const_iterator last)
+    {
+        auto const offset = first - v_.data();
+        v_.erase(v_.begin() + offset, v_.begin() + (last - v_.data()));
+        return begin() + offset;
+    }
+    void swap(ref_vector & other) noexcept { v_.swap(other.v_); }
+
+    using base_type =
+        bsi::container_interface<ref_vector<T, Reservable>, bsi::contiguous>;
+    using base_type::begin;
+
+    using base_type::end;
+
+    using base_type::erase;
+
+    using base_type::insert;
+
+private:
+    std::vector<T> v_;
+};
+
+TEST(allocation_counts, assign)
+{
+    counted const one(1);
+    std::vector<counted> const src(300, counted(2));
+
+    // Past the capacity of a reservable container, assign(n, x) erases,
+    // reserves and inserts: one allocation, n copies, and one more copy of
+    // x, which might be one of the elements erased.
+    {
+        ref_vector<counted, true> v;
+        EXPECT_TRUE(made(count([&] { v.assign(100, one); }), 1, 101));
+        EXPECT_TRUE(made(count([&] { v.assign(50, one); }), 0, 0));
+        EXPECT_TRUE(made(count([&] { v.assign(100, one); }), 0, 50));
+        EXPECT_TRUE(made(
+            count([&] { v.assign(src.begin(), src.end()); }), 1, 300));
+        EXPECT_TRUE(made(count([&] { v.assign({one, one}); }), 0, 2));
+    }
+    {
+        small_vector<counted, 4> v;
+        EXPECT_TRUE(made(count([&] { v.assign(100, one); }), 1, 101));
+        EXPECT_TRUE(made(
+            count([&] { v.assign(src.begin(), src.end()); }), 1, 300));
+    }
+
+    // Without reserve(), a copy that may throw is made into a D(n, x),
+    // which is swapped in; a copy that cannot is made in place.  Either
+    // way, there is one allocation.
+    {
+        ref_vector<counted, false> v;
+        EXPECT_TRUE(made(count([&] { v.assign(100, one); }), 1, 100));
+        ref_vector<int, false> ints;
+        EXPECT_TRUE(made(count([&] { ints.assign(100, 1); }), 1, 0));
+    }
+}
+
+TEST(allocation_counts, insert)
+{
+    counted const three(3);
+    {
+        ref_vector<counted, true> v;
+        v.assign(300, three);
+        // Growing moves the 300 elements to the new storage.
+        EXPECT_TRUE(made(
+            count([&] { v.insert(v.begin(), 10, three); }), 1, 310));
+        v.erase(v.begin(), v.begin() + 10);
+        EXPECT_TRUE(made(count([&] { v.insert(v.begin(), {three}); }), 0, 2));
+    }
+    {
+        small_vector<counted, 4> v(200, three);
+        EXPECT_TRUE(made(
+            count([&] { v.insert(v.begin(), 10, three); }), 1, 210));
+        EXPECT_TRUE(made(count([&] { v.insert(v.end(), {three}); }), 0, 2));
+    }
+}
+
+TEST(allocation_counts, resize)
+{
+    small_vector<counted, 4> v(100, counted(1));
+    // resize(n) copies a value-initialized element into each new one.
+    EXPECT_TRUE(made(count([&] { v.resize(200); }), 1, 201));
+    EXPECT_TRUE(made(count([&] { v.resize(50); }), 0, 1));
+    EXPECT_TRUE(made(count([&] { v.resize(60); }), 0, 11));
+}
+
+TEST(allocation_counts, append_range)
+{
+    std::vector<counted> const src(300, counted(2));
+    {
+        // Room for all of a sized range is reserved at once.
+        alloc_vector<counted> v;
+        EXPECT_TRUE(made(count([&] { v.append_range(src); }), 1, 300));
+        EXPECT_TRUE(made(count([&] { v.append_range(src); }), 1, 600));
+
+        // emplace_back() past the capacity constructs the new element
+        // before moving the old ones, in case it refers to one of them.
+        counted const three(3);
+        v.reserve(v.size());
+        EXPECT_TRUE(made(count([&] { v.push_back(three); }), 1, 602));
+    }
+    {
+        small_vector<counted, 4> v(210, counted(1));
+        EXPECT_TRUE(made(count([&] { v.append_range(src); }), 1, 510));
+    }
+}
+
+TEST(allocation_counts, swap)
+{
+    {
+        ref_vector<counted, true> v(100, counted(1));
+        ref_vector<counted, true> w(3, counted(2));
+        EXPECT_TRUE(made(count([&] { swap(v, w); }), 0, 0));
+        EXPECT_EQ(v.size(), 3u);
+    }
+    {
+        small_vector<counted, 4> v(100, counted(1));
+        small_vector<counted, 4> w(200, counted(2));
+        EXPECT_TRUE(made(count([&] { swap(v, w); }), 0, 0));
+        EXPECT_EQ(v.size(), 200u);
+    }
+    {
+        alloc_vector<counted> v;
+        alloc_vector<counted> w;
+        w.append_range(std::vector<counted>(3));
+        EXPECT_TRUE(made(count([&] { v.swap(w); }), 0, 0));
+        EXPECT_EQ(v.size(), 3u);
+    }
+}
@@ -0,0 +1,220 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/stl_interfaces/alloc_vector.hpp>
+
+#include <gtest/gtest.h>
+
+#include <scoped_allocator>
+#include <vector>
+
+#if defined(__cpp_lib_memory_resource)
+#include <memory_resource>
+#endif
+
+
+using boost::stl_interfaces::alloc_vector;
+
+
+// An allocator that counts live allocations in an arena, identified by a
+// pointer to its counter; two of them compare equal only if they share an
+// arena.  Propagate selects all three propagate_on_container_* traits.
+template<typename T, bool Propagate>
+struct arena_allocator
+{
+    using value_type = T;
+    using propagate_on_container_copy_assignment =
+        std::integral_constant<bool, Propagate>;
+    using propagate_on_container_move_assignment =
+        std::integral_constant<bool, Propagate>;
+    using propagate_on_container_swap = std::integral_constant<bool, Propagate>;
+    template<typename U>
+    struct rebind
+    {
+        using other = arena_allocator<U, Propagate>;
+    };
+
+    explicit arena_allocator(int * live) noexcept : live_(live) {}
+    template<typename U>
+    arena_allocator(arena_allocator<U, Propagate> other) noexcept :
+        live_(other.live_)
+    {}
+
+    T * allocate(std::size_t n)
+    {
+        ++*live_;
+        return std::allocator<T>().allocate(n);
+    }
+    void deallocate(T * p, std::size_t n) noexcept
+    {
+        --*live_;
+        std::allocator<T>().deallocate(p, n);
+    }
+
+    arena_allocator select_on_container_copy_construction() const
+    {
+        return Propagate ? *this : arena_allocator(copies_arena());
+    }
+
+    friend bool operator==(arena_allocator lhs, arena_allocator rhs) noexcept
+    {
+        return lhs.live_ == rhs.live_;
+    }
+    friend bool operator!=(arena_allocator lhs, arena_allocator rhs) noexcept
+    {
+        return lhs.live_ != rhs.live_;
+    }
+
+    static int * copies_arena()
+    {
+        static int live = 0;
+        return &live;
+    }
+
+    int * live_;
+};
+
+static_assert(
+    sizeof(alloc_vector<int>) == sizeof(int *) + 2 * sizeof(std::size_t),
+    "");
+static_assert(
+    std::is_same<
+        alloc_vector<int>::allocator_type,
+        std::allocator<int>>::value,
+    "");
+
+
+TEST(allocator_aware, get_allocator)
+{
+    int live = 0;
+    using alloc_type = arena_allocator<int, true>;
+    {
+        alloc_vector<int, alloc_type> v{{1, 2, 3}, alloc_type(&live)};
+        EXPECT_EQ(v.get_allocator(), alloc_type(&live));
+        EXPECT_EQ(live, 1);
+        EXPECT_EQ(v.size(), 3u);
+        EXPECT_EQ(v[2], 3);
+        v.push_back(4);
+        v.push_back(5);
+        EXPECT_EQ(live, 1);
+        EXPECT_EQ(v.back(), 5);
+    }
+    EXPECT_EQ(live, 0);
+
+    alloc_vector<int> v = {};
+    EXPECT_EQ(v.get_allocator(), std::allocator<int>());
+}
+
+TEST(allocator_aware, propagating)
+{
+    using alloc_type = arena_allocator<int, true>;
+    int live_a = 0;
+    int live_b = 0;
+    {
+        alloc_vector<int, alloc_type> a{{1, 2}, alloc_type(&live_a)};
+        alloc_vector<int, alloc_type> b{{3}, alloc_type(&live_b)};
+
+        alloc_vector<int, alloc_type> c = a;
+        EXPECT_EQ(c.get_allocator(), a.get_allocator());
+        EXPECT_EQ(live_a, 2);
+
+        c = b;
+        EXPECT_EQ(c.get_allocator(), b.get_allocator());
+        EXPECT_EQ(live_a, 1);
+        EXPECT_EQ(live_b, 2);
+        EXPECT_EQ(c, b);
+
+        c = std::move(a);
+        EXPECT_EQ(c.get_allocator(), alloc_type(&live_a));
+        EXPECT_EQ(live_a, 1);
+        EXPECT_EQ(live_b, 1);
+        EXPECT_EQ(
+            c, (alloc_vector<int, alloc_type>{{1, 2}, c.get_allocator()}));
+
+        swap(b, c);
+        EXPECT_EQ(b.get_allocator(), alloc_type(&live_a));
+        EXPECT_EQ(c.get_allocator(), alloc_type(&live_b));
+        EXPECT_EQ(b[1], 2);
+        EXPECT_EQ(c[0], 3);
+    }
+    EXPECT_EQ(live_a, 0);
+    EXPECT_EQ(live_b, 0);
+}
+
+TEST(allocator_aware, non_propagating)
+{
+    using alloc_type = arena_allocator<int, false>;
+    int live_a = 0;
+    int live_b = 0;
+    {
+        alloc_vector<int, alloc_type> a{{1, 2}, alloc_type(&live_a)};
+        alloc_vector<int, alloc_type> b{{3}, alloc_type(&live_b)};
+
+        alloc_vector<int, alloc_type> c = a;
+        EXPECT_EQ(c.get_allocator(), alloc_type(alloc_type::copies_arena()));
+        EXPECT_EQ(live_a, 1);
+
+        alloc_vector<int, alloc_type> d = std::move(a);
+        EXPECT_EQ(d.get_allocator(), alloc_type(&live_a));
+
+        b = d;
+        EXPECT_EQ(b.get_allocator(), alloc_type(&live_b));
+        EXPECT_EQ(b, d);
+
+        // Different arenas, so the elements are moved one at a time.
+        alloc_vector<int, alloc_type> e{{7, 8, 9}, alloc_type(&live_b)};
+        d = std::move(e);
+        EXPECT_EQ(d.get_allocator(), alloc_type(&live_a));
+        EXPECT_EQ(
+            d,
+            (alloc_vector<int, alloc_type>{{7, 8, 9}, d.get_allocator()}));
+
+        // The same arena, so the storage is moved.
+        alloc_vector<int, alloc_type> f{{4}, alloc_type(&live_b)};
+        int const live_b_before = live_b;
+        b = std::move(f);
+        EXPECT_EQ(live_b, live_b_before - 1);
+        EXPECT_EQ(b[0], 4);
+
+        alloc_vector<int, alloc_type> g{{5}, alloc_type(&live_b)};
+        swap(b, g);
+        EXPECT_EQ(b[0], 5);
+        EXPECT_EQ(g[0], 4);
+    }
+    EXPECT_EQ(live_a, 0);
+    EXPECT_EQ(live_b, 0);
+    EXPECT_EQ(*alloc_type::copies_arena(), 0);
+}
+
+TEST(allocator_aware, nested_allocators)
+{
+    // construct() goes through allocator_traits, so a scoped allocator
+    // passes itself on to the elements.
+    using alloc_type = std::scoped_allocator_adaptor<
+        std::allocator<std::vector<int>>>;
+    alloc_vector<std::vector<int>, alloc_type> v;
+    v.emplace_back(3, 1);
+    v.emplace_back(v[0]);
+    EXPECT_EQ(v[1], std::vector<int>(3, 1));
+}
+
+#if defined(__cpp_lib_memory_resource)
+TEST(allocator_aware, pmr)
+{
+    char buf[1024];
+    std::pmr::monotonic_buffer_resource arena(buf, sizeof(buf));
+    using alloc_type = std::pmr::polymorphic_allocator<int>;
+    alloc_vector<int, alloc_type> v{{1, 2, 3}, alloc_type(&arena)};
+    EXPECT_EQ(v.get_allocator().resource(), &arena);
+    EXPECT_GE(v.data(), (int const *)buf);
+    EXPECT_LT(v.data(), (int const *)(buf + sizeof(buf)));
+
+    // polymorphic_allocator does not propagate on copy.
+    alloc_vector<int, alloc_type> v2 = v;
+    EXPECT_EQ(v2.get_allocator().resource(), std::pmr::get_default_resource());
+    EXPECT_EQ(v2, v);
+}
+#endif
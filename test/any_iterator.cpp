@@ -0,0 +1,216 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/any_iterator.hpp>
+#include <boost/stl_interfaces/transform_view.hpp>
+
+#include "ill_formed.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <list>
+#include <numeric>
+#include <sstream>
+#include <vector>
+
+
+namespace bsi = boost::stl_interfaces;
+
+using ra_iter = bsi::any_iterator<int, std::random_access_iterator_tag>;
+using bidi_iter = bsi::any_iterator<int, std::bidirectional_iterator_tag>;
+using fwd_iter = bsi::any_iterator<int const>;
+using in_iter = bsi::any_iterator<int, std::input_iterator_tag, int>;
+
+BOOST_STL_INTERFACES_STATIC_ASSERT_CONCEPT(
+    ra_iter, std::random_access_iterator)
+BOOST_STL_INTERFACES_STATIC_ASSERT_ITERATOR_TRAITS(
+    ra_iter,
+    std::random_access_iterator_tag,
+    std::random_access_iterator_tag,
+    int,
+    int &,
+    int *,
+    std::ptrdiff_t)
+BOOST_STL_INTERFACES_STATIC_ASSERT_CONCEPT(
+    bidi_iter, std::bidirectional_iterator)
+BOOST_STL_INTERFACES_STATIC_ASSERT_CONCEPT(fwd_iter, std::forward_iterator)
+BOOST_STL_INTERFACES_STATIC_ASSERT_CONCEPT(in_iter, std::input_iterator)
+
+template<typename Iter>
+using plus_eq_t = decltype(std::declval<Iter &>() += 1);
+static_assert(ill_formed<plus_eq_t, bidi_iter>::value, "");
+static_assert(!ill_formed<plus_eq_t, ra_iter>::value, "");
+
+static_assert(std::is_convertible<int *, ra_iter>::value, "");
+static_assert(!std::is_convertible<int, ra_iter>::value, "");
+
+// Too big to store inline.
+struct big_iterator
+    : bsi::iterator_interface<
+          big_iterator,
+          std::random_access_iterator_tag,
+          int>
+{
+    big_iterator() = default;
+    explicit big_iterator(int * it) : it_(it) {}
+
+    int * it_ = nullptr;
+    char padding_[64] = {};
+
+    int *& base_reference() noexcept { return it_; }
+    int * base_reference() const noexcept { return it_; }
+};
+
+
+TEST(any_iterator, random_access)
+{
+    std::vector<int> v = {4, 2, 0, 3, 1};
+    ra_iter first = v.begin();
+    ra_iter last = v.end();
+    EXPECT_EQ(last - first, 5);
+    EXPECT_EQ(first[1], 2);
+    EXPECT_TRUE(first < last);
+    std::sort(first, last);
+    EXPECT_EQ(v, (std::vector<int>{0, 1, 2, 3, 4}));
+    EXPECT_EQ(*std::lower_bound(first, last, 3), 3);
+    EXPECT_EQ(*(last - 1), 4);
+
+    ra_iter it = first;
+    EXPECT_EQ(it, first);
+    ++it;
+    EXPECT_NE(it, first);
+    EXPECT_EQ(*it++, 1);
+    EXPECT_EQ(*it--, 2);
+    EXPECT_EQ(*it, 1);
+    it += 3;
+    EXPECT_EQ(*it, 4);
+
+    int a[] = {1, 2, 3};
+    ra_iter pa = a;
+    EXPECT_EQ(*(pa + 2), 3);
+}
+
+TEST(any_iterator, bidirectional_and_forward)
+{
+    std::list<int> l = {1, 2, 3};
+    bidi_iter first = l.begin();
+    bidi_iter last = l.end();
+    EXPECT_EQ(std::distance(first, last), 3);
+    EXPECT_EQ(*std::prev(last), 3);
+    std::reverse(first, last);
+    EXPECT_EQ(l, (std::list<int>{3, 2, 1}));
+
+    std::vector<int> const v = {1, 2, 3};
+    fwd_iter vfirst = v.begin();
+    fwd_iter vlast = v.end();
+    EXPECT_EQ(std::accumulate(vfirst, vlast, 0), 6);
+    EXPECT_EQ(&*vfirst, v.data());
+
+    // An iterator over a different container type is a different iterator.
+    std::list<int> const l2 = {1, 2, 3};
+    EXPECT_NE(fwd_iter(l2.begin()), vfirst);
+    EXPECT_TRUE(std::equal(vfirst, vlast, fwd_iter(l2.begin())));
+}
+
+TEST(any_iterator, input_with_prvalues)
+{
+    std::istringstream is("1 2 3");
+    in_iter first = std::istream_iterator<int>(is);
+    in_iter last = std::istream_iterator<int>();
+    EXPECT_EQ(std::accumulate(first, last, 0), 6);
+
+    std::vector<int> const v = {1, 2, 3};
+    auto const squares =
+        bsi::make_transform_view(v, [](int x) { return x * x; });
+    in_iter sfirst = squares.begin();
+    EXPECT_EQ(*sfirst, 1);
+    EXPECT_EQ(*++sfirst, 4);
+}
+
+TEST(any_iterator, copy_move_and_empty)
+{
+    std::vector<int> v = {1, 2, 3};
+    ra_iter empty;
+    EXPECT_TRUE(empty.empty());
+    EXPECT_EQ(empty, ra_iter());
+
+    for (ra_iter it : {ra_iter(v.begin()), ra_iter(big_iterator(v.data()))}) {
+        ra_iter copy = it;
+        EXPECT_EQ(copy, it);
+        ++copy;
+        EXPECT_EQ(*it, 1);
+        EXPECT_EQ(*copy, 2);
+
+        ra_iter moved = std::move(copy);
+        EXPECT_TRUE(copy.empty());
+        EXPECT_EQ(*moved, 2);
+
+        copy = moved;
+        EXPECT_EQ(*copy, 2);
+        copy = std::move(it);
+        EXPECT_EQ(*copy, 1);
+        EXPECT_TRUE(it.empty());
+        it = copy;
+        EXPECT_EQ(it, copy);
+        copy = empty;
+        EXPECT_TRUE(copy.empty());
+    }
+
+    ra_iter big = big_iterator(v.data());
+    EXPECT_EQ(big + 3, ra_iter(big_iterator(v.data() + 3)));
+    EXPECT_EQ(ra_iter(big_iterator(v.data() + 3)) - big, 3);
+}
+
+TEST(any_iterator, next_n)
+{
+    std::vector<int> v(100);
+    std::iota(v.begin(), v.end(), 0);
+
+    ra_iter it = v.begin();
+    int buf[32];
+    EXPECT_EQ(it.next_n(buf, 32), 32);
+    EXPECT_EQ(buf[0], 0);
+    EXPECT_EQ(buf[31], 31);
+    EXPECT_EQ(*it, 32);
+
+    std::list<int> l(v.begin(), v.end());
+    fwd_iter first = l.begin();
+    fwd_iter const last = l.end();
+    std::vector<int> out;
+    int cbuf[32];
+    std::ptrdiff_t n = 0;
+    while ((n = first.next_n(cbuf, 32, last))) {
+        out.insert(out.end(), cbuf, cbuf + n);
+    }
+    EXPECT_EQ(out, v);
+    EXPECT_EQ(first, last);
+}
+
+TEST(any_view, basic)
+{
+    std::vector<int> v = {1, 2, 3};
+    bsi::any_view<int, std::random_access_iterator_tag> view(v);
+    EXPECT_EQ(view.size(), 3u);
+    EXPECT_EQ(view[1], 2);
+    EXPECT_FALSE(view.empty());
+    EXPECT_TRUE(std::equal(view.begin(), view.end(), v.begin(), v.end()));
+
+    std::list<int> l = {1, 2, 3};
+    bsi::any_view<int> lview(l);
+    int sum = 0;
+    for (int x : lview) {
+        sum += x;
+    }
+    EXPECT_EQ(sum, 6);
+
+    std::array<int, 2> const a = {{4, 5}};
+    bsi::any_view<int const> aview(a.begin(), a.end());
+    EXPECT_EQ(std::accumulate(aview.begin(), aview.end(), 0), 9);
+
+    bsi::any_view<int const> empty;
+    EXPECT_TRUE(empty.empty());
+}
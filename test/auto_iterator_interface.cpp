@@ -0,0 +1,240 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/auto_iterator_interface.hpp>
+#include <boost/stl_interfaces/algorithm.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <list>
+#include <numeric>
+#include <vector>
+
+
+namespace bsi = boost::stl_interfaces;
+
+// An iterator whose core is any other iterator.
+template<typename Iter>
+struct wrapped_iter : bsi::auto_iterator_interface<
+                          wrapped_iter<Iter>,
+                          Iter,
+                          typename std::iterator_traits<Iter>::value_type,
+                          typename std::iterator_traits<Iter>::reference>
+{
+    using wrapped_iter::auto_iterator_interface::auto_iterator_interface;
+};
+
+// A core that steps along a singly-linked list.
+struct node
+{
+    int value;
+    node * next;
+};
+struct node_core
+{
+    int & operator*() const { return n->value; }
+    node_core & operator++()
+    {
+        n = n->next;
+        return *this;
+    }
+    friend bool operator==(node_core lhs, node_core rhs)
+    {
+        return lhs.n == rhs.n;
+    }
+    node * n = nullptr;
+};
+struct node_iter : bsi::auto_iterator_interface<node_iter, node_core, int>
+{
+    using auto_iterator_interface::auto_iterator_interface;
+};
+
+// A core that is an index into an array: random access, but the elements
+// are reached through the array, so the iterator is not contiguous.
+struct index_core
+{
+    int & operator*() const { return array[i]; }
+    index_core & operator++()
+    {
+        ++i;
+        return *this;
+    }
+    index_core & operator--()
+    {
+        --i;
+        return *this;
+    }
+    index_core & operator+=(std::ptrdiff_t n)
+    {
+        i += n;
+        return *this;
+    }
+    friend std::ptrdiff_t operator-(index_core lhs, index_core rhs)
+    {
+        return lhs.i - rhs.i;
+    }
+    friend bool operator==(index_core lhs, index_core rhs)
+    {
+        return lhs.i == rhs.i;
+    }
+    int * array = nullptr;
+    std::ptrdiff_t i = 0;
+};
+struct index_iter : bsi::auto_iterator_interface<index_iter, index_core, int>
+{
+    using auto_iterator_interface::auto_iterator_interface;
+};
+
+// The same, over a pointer that its base_reference() exposes, which makes
+// it contiguous.
+struct pointer_core
+{
+    int & operator*() const { return *p; }
+    pointer_core & operator++()
+    {
+        ++p;
+        return *this;
+    }
+    pointer_core & operator--()
+    {
+        --p;
+        return *this;
+    }
+    pointer_core & operator+=(std::ptrdiff_t n)
+    {
+        p += n;
+        return *this;
+    }
+    friend std::ptrdiff_t operator-(pointer_core lhs, pointer_core rhs)
+    {
+        return lhs.p - rhs.p;
+    }
+    friend bool operator==(pointer_core lhs, pointer_core rhs)
+    {
+        return lhs.p == rhs.p;
+    }
+
+private:
+    friend bsi::access;
+    int *& base_reference() noexcept { return p; }
+    int * base_reference() const noexcept { return p; }
+
+public:
+    int * p = nullptr;
+};
+struct pointer_iter
+    : bsi::auto_iterator_interface<pointer_iter, pointer_core, int>
+{
+    using auto_iterator_interface::auto_iterator_interface;
+};
+
+// A core with no default constructor can only be an input iterator.
+struct counter_core
+{
+    explicit counter_core(int n) : n(n) {}
+    int operator*() const { return n; }
+    counter_core & operator++()
+    {
+        ++n;
+        return *this;
+    }
+    friend bool operator==(counter_core lhs, counter_core rhs)
+    {
+        return lhs.n == rhs.n;
+    }
+    int n;
+};
+
+template<typename Iter, typename Concept>
+using has_concept = std::is_same<typename Iter::iterator_concept, Concept>;
+
+static_assert(has_concept<node_iter, std::forward_iterator_tag>::value, "");
+static_assert(
+    has_concept<
+        wrapped_iter<std::list<int>::iterator>,
+        std::bidirectional_iterator_tag>::value,
+    "");
+static_assert(
+    has_concept<index_iter, std::random_access_iterator_tag>::value, "");
+static_assert(
+    std::is_same<
+        std::iterator_traits<index_iter>::iterator_category,
+        std::random_access_iterator_tag>::value,
+    "");
+static_assert(
+    has_concept<pointer_iter, bsi::contiguous_iterator_tag>::value, "");
+static_assert(
+    has_concept<wrapped_iter<int *>, bsi::contiguous_iterator_tag>::value,
+    "");
+static_assert(
+    std::is_same<
+        bsi::deduced_iterator_concept_t<counter_core>,
+        std::input_iterator_tag>::value,
+    "");
+static_assert(bsi::is_contiguous_iterator<pointer_iter>::value, "");
+static_assert(!bsi::is_contiguous_iterator<index_iter>::value, "");
+static_assert(sizeof(pointer_iter) == sizeof(int *), "");
+
+
+TEST(auto_iterator_interface, forward)
+{
+    node nodes[3] = {{1, nullptr}, {2, nullptr}, {3, nullptr}};
+    nodes[0].next = &nodes[1];
+    nodes[1].next = &nodes[2];
+    node_iter const first(node_core{&nodes[0]});
+    node_iter const last{};
+    EXPECT_EQ(std::distance(first, last), 3);
+    EXPECT_EQ(std::accumulate(first, last, 0), 6);
+    auto it = first;
+    EXPECT_EQ(*it++, 1);
+    EXPECT_EQ(*it, 2);
+    EXPECT_EQ(it.core().n, &nodes[1]);
+    EXPECT_NE(it, first);
+}
+
+TEST(auto_iterator_interface, bidirectional)
+{
+    std::list<int> l = {3, 1, 2};
+    using iter = wrapped_iter<std::list<int>::iterator>;
+    iter const first(l.begin());
+    iter const last(l.end());
+    std::vector<int> reversed(
+        std::make_reverse_iterator(last), std::make_reverse_iterator(first));
+    EXPECT_EQ(reversed, (std::vector<int>{2, 1, 3}));
+    auto it = last;
+    EXPECT_EQ(*--it, 2);
+}
+
+TEST(auto_iterator_interface, random_access)
+{
+    std::array<int, 6> a = {{5, 3, 6, 1, 4, 2}};
+    index_iter const first(index_core{a.data(), 0});
+    index_iter const last(index_core{a.data(), 6});
+    EXPECT_EQ(last - first, 6);
+    EXPECT_EQ(first[2], 6);
+    EXPECT_TRUE(first < last);
+    std::sort(first, last);
+    EXPECT_EQ(a, (std::array<int, 6>{{1, 2, 3, 4, 5, 6}}));
+    EXPECT_EQ(*std::lower_bound(first, last, 4), 4);
+    EXPECT_EQ(*(last - 1), 6);
+}
+
+TEST(auto_iterator_interface, contiguous)
+{
+    std::vector<int> v = {4, 8, 15, 16, 23, 42};
+    pointer_iter const first(pointer_core{v.data()});
+    pointer_iter const last(pointer_core{v.data() + v.size()});
+    EXPECT_EQ(bsi::to_address(last), v.data() + v.size());
+    EXPECT_EQ(bsi::find(first, last, 16) - first, 3);
+    EXPECT_EQ(bsi::count(first, last, 42), 1);
+
+    wrapped_iter<int *> const pfirst(v.data());
+    wrapped_iter<int *> const plast(v.data() + v.size());
+    EXPECT_EQ(bsi::to_address(pfirst), v.data());
+    EXPECT_EQ(bsi::find(pfirst, plast, 23) - pfirst, 4);
+    EXPECT_TRUE(std::equal(pfirst, plast, first, last));
+}
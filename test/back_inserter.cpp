@@ -0,0 +1,148 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/back_insert_iterator.hpp>
+#include <boost/stl_interfaces/static_vector.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <list>
+#include <string>
+#include <vector>
+
+
+namespace bsi = boost::stl_interfaces;
+
+// A vector that counts its calls to reserve() and push_back().
+struct counting_vector
+{
+    using value_type = int;
+
+    std::size_t size() const { return elements.size(); }
+    std::size_t capacity() const { return elements.capacity(); }
+    void reserve(std::size_t n)
+    {
+        elements.reserve(n);
+        ++reserves;
+    }
+    void push_back(int x) { elements.push_back(x); }
+
+    std::vector<int> elements;
+    int reserves = 0;
+};
+
+// A container with append_range(), that counts its calls.
+struct appendable
+{
+    using value_type = int;
+
+    void push_back(int x) { elements.push_back(x); }
+    template<typename R>
+    void append_range(R && r)
+    {
+        elements.insert(elements.end(), r.begin(), r.end());
+        ++appends;
+    }
+
+    std::vector<int> elements;
+    int appends = 0;
+};
+
+static_assert(
+    std::is_same<
+        std::iterator_traits<
+            bsi::back_insert_iterator<std::vector<int>>>::iterator_category,
+        std::output_iterator_tag>::value,
+    "");
+
+
+TEST(back_inserter, std_algorithms)
+{
+    std::vector<int> const ints = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    std::vector<int> ints_copy;
+    std::copy(ints.begin(), ints.end(), bsi::back_inserter(ints_copy));
+    EXPECT_EQ(ints_copy, ints);
+
+    auto out = bsi::back_inserter(ints_copy);
+    *out++ = 10;
+    *out = 11;
+    EXPECT_EQ(ints_copy.size(), 12u);
+    EXPECT_EQ(&out.container(), &ints_copy);
+}
+
+TEST(back_inserter, copy_reserves)
+{
+    std::vector<int> const ints = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    counting_vector c;
+    auto out = bsi::copy(ints.begin(), ints.end(), bsi::back_inserter(c));
+    EXPECT_EQ(c.elements, ints);
+    EXPECT_EQ(c.reserves, 1);
+    EXPECT_EQ(&out.container(), &c);
+
+    // Enough room already; no reserve.
+    c.elements.clear();
+    bsi::copy(ints.begin(), ints.end(), bsi::back_inserter(c));
+    EXPECT_EQ(c.reserves, 1);
+
+    // Not random access; no reserve.
+    std::list<int> const list(ints.begin(), ints.end());
+    bsi::copy(list.begin(), list.end(), bsi::back_inserter(c));
+    EXPECT_EQ(c.reserves, 1);
+    EXPECT_EQ(c.elements.size(), 20u);
+}
+
+TEST(back_inserter, copy_grows_geometrically)
+{
+    int const ints[] = {0, 1, 2};
+    counting_vector c;
+    for (int i = 0; i < 1000; ++i) {
+        bsi::copy(std::begin(ints), std::end(ints), bsi::back_inserter(c));
+    }
+    EXPECT_EQ(c.elements.size(), 3000u);
+    EXPECT_LT(c.reserves, 12);
+}
+
+TEST(back_inserter, copy_append_range)
+{
+    std::vector<int> const ints = {0, 1, 2, 3, 4};
+    appendable c;
+    bsi::copy(ints.begin(), ints.end(), bsi::back_inserter(c));
+    EXPECT_EQ(c.elements, ints);
+    EXPECT_EQ(c.appends, 1);
+
+    bsi::static_vector<int, 8> sv;
+    bsi::copy(ints.begin(), ints.end(), bsi::back_inserter(sv));
+    EXPECT_EQ(sv.size(), 5u);
+    EXPECT_TRUE(std::equal(sv.begin(), sv.end(), ints.begin()));
+}
+
+TEST(back_inserter, unqualified_copy)
+{
+    using std::copy;
+    std::string const s = "text";
+    counting_vector c;
+    copy(s.begin(), s.end(), bsi::back_inserter(c));
+    EXPECT_EQ(c.reserves, 1);
+    EXPECT_EQ(c.elements, (std::vector<int>{'t', 'e', 'x', 't'}));
+}
+
+TEST(back_inserter, transform)
+{
+    std::vector<int> const ints = {0, 1, 2, 3};
+    counting_vector c;
+    bsi::transform(ints.begin(), ints.end(), bsi::back_inserter(c), [](int x) {
+        return x * x;
+    });
+    EXPECT_EQ(c.elements, (std::vector<int>{0, 1, 4, 9}));
+    EXPECT_EQ(c.reserves, 1);
+
+    std::string s;
+    bsi::transform(
+        ints.begin(), ints.end(), bsi::back_inserter(s), [](int x) {
+            return char('a' + x);
+        });
+    EXPECT_EQ(s, "abcd");
+}
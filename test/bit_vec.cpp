@@ -0,0 +1,219 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/stl_interfaces/bit_vector.hpp>
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+
+using boost::stl_interfaces::bit_reference;
+using boost::stl_interfaces::bit_span;
+using boost::stl_interfaces::bit_vector;
+using boost::stl_interfaces::bit_word;
+using boost::stl_interfaces::bits_per_word;
+
+
+using const_iterator = bit_vector::const_iterator;
+
+static_assert(
+    std::is_same<
+        std::iterator_traits<bit_vector::iterator>::iterator_category,
+        std::random_access_iterator_tag>::value,
+    "");
+static_assert(
+    std::is_same<bit_vector::iterator::reference, bit_reference>::value, "");
+static_assert(std::is_same<const_iterator::reference, bool>::value, "");
+static_assert(
+    std::is_convertible<bit_vector::iterator, const_iterator>::value, "");
+static_assert(
+    !std::is_convertible<const_iterator, bit_vector::iterator>::value, "");
+
+std::vector<bool> random_bits(int n, int seed)
+{
+    std::mt19937 gen(seed);
+    std::vector<bool> retval(n);
+    for (int i = 0; i < n; ++i) {
+        retval[i] = gen() & 1;
+    }
+    return retval;
+}
+
+bool equal(bit_vector const & bv, std::vector<bool> const & v)
+{
+    return std::equal(bv.begin(), bv.end(), v.begin(), v.end());
+}
+
+
+TEST(bit_vec, default_ctor)
+{
+    bit_vector v;
+    EXPECT_TRUE(v.empty());
+    EXPECT_EQ(v.size(), 0u);
+    EXPECT_EQ(v.begin(), v.end());
+    EXPECT_EQ(count(v.begin(), v.end(), true), 0);
+    EXPECT_EQ(find(v.begin(), v.end(), true), v.end());
+    EXPECT_EQ(v, v);
+}
+
+TEST(bit_vec, element_access)
+{
+    bit_vector v(130);
+    EXPECT_EQ(v.size(), 130u);
+    EXPECT_EQ(v.capacity() % bits_per_word, 0u);
+    v[0] = true;
+    v[64] = true;
+    v.back() = true;
+    EXPECT_TRUE(v[0]);
+    EXPECT_FALSE(v[1]);
+    EXPECT_TRUE(v.cbegin()[64]);
+    EXPECT_TRUE(v.back());
+    v[1] = v[0];
+    EXPECT_TRUE(v[1]);
+    v[1].flip();
+    EXPECT_FALSE(v[1]);
+    swap(v[0], v[1]);
+    EXPECT_FALSE(v[0]);
+    EXPECT_TRUE(v[1]);
+
+    auto it = v.end();
+    --it;
+    EXPECT_TRUE(*it);
+    it -= 65;
+    EXPECT_TRUE(*it);
+    EXPECT_EQ(it - v.begin(), 64);
+    it += -63;
+    EXPECT_EQ(it - v.begin(), 1);
+    EXPECT_EQ(v.end() - v.begin(), 130);
+
+    bit_vector const ones(70, true);
+    EXPECT_EQ(count(ones.begin(), ones.end(), true), 70);
+    EXPECT_EQ(count(ones.begin(), ones.end(), false), 0);
+}
+
+TEST(bit_vec, algorithms_at_every_offset)
+{
+    auto const bits = random_bits(300, 1);
+    bit_vector const bv(bits.begin(), bits.end());
+    for (int first = 0; first < 140; first += 3) {
+        for (int last = first; last < 300; last += 7) {
+            auto const f = bv.begin() + first;
+            auto const l = bv.begin() + last;
+            auto const vf = bits.begin() + first;
+            auto const vl = bits.begin() + last;
+            EXPECT_EQ(count(f, l, true), std::count(vf, vl, true));
+            EXPECT_EQ(count(f, l, false), std::count(vf, vl, false));
+            EXPECT_EQ(
+                find(f, l, true) - bv.begin(),
+                std::find(vf, vl, true) - bits.begin());
+            EXPECT_EQ(
+                find(f, l, false) - bv.begin(),
+                std::find(vf, vl, false) - bits.begin());
+
+            for (int out = 0; out < 70; out += 23) {
+                bit_vector dst(400);
+                std::vector<bool> vdst(400);
+                auto const end = copy(f, l, dst.begin() + out);
+                std::copy(vf, vl, vdst.begin() + out);
+                EXPECT_EQ(end - dst.begin(), out + last - first);
+                EXPECT_TRUE(equal(dst, vdst));
+
+                fill(dst.begin() + out, end, true);
+                std::fill(
+                    vdst.begin() + out,
+                    vdst.begin() + (end - dst.begin()),
+                    true);
+                EXPECT_TRUE(equal(dst, vdst));
+            }
+        }
+    }
+}
+
+TEST(bit_vec, modifiers)
+{
+    std::vector<bool> v;
+    bit_vector bv;
+    for (int i = 0; i < 200; ++i) {
+        v.push_back(i % 3 == 0);
+        bv.push_back(i % 3 == 0);
+    }
+    EXPECT_TRUE(equal(bv, v));
+
+    bv.insert(bv.begin() + 5, 70, true);
+    v.insert(v.begin() + 5, 70, true);
+    EXPECT_TRUE(equal(bv, v));
+
+    auto const more = random_bits(90, 2);
+    bv.insert(bv.begin() + 131, more.begin(), more.end());
+    v.insert(v.begin() + 131, more.begin(), more.end());
+    EXPECT_TRUE(equal(bv, v));
+
+    bv.insert(bv.begin(), false);
+    v.insert(v.begin(), false);
+    bv.emplace(bv.end(), true);
+    v.insert(v.end(), true);
+    EXPECT_TRUE(equal(bv, v));
+
+    bv.erase(bv.begin() + 3, bv.begin() + 150);
+    v.erase(v.begin() + 3, v.begin() + 150);
+    EXPECT_TRUE(equal(bv, v));
+    bv.erase(bv.begin() + 1);
+    v.erase(v.begin() + 1);
+    EXPECT_TRUE(equal(bv, v));
+
+    bv.pop_back();
+    v.pop_back();
+    bv.resize(500, true);
+    v.resize(500, true);
+    EXPECT_TRUE(equal(bv, v));
+    bv.resize(10);
+    v.resize(10);
+    bv.resize(100);
+    v.resize(100);
+    EXPECT_TRUE(equal(bv, v));
+
+    bv.flip();
+    v.flip();
+    EXPECT_TRUE(equal(bv, v));
+
+    bv.clear();
+    EXPECT_TRUE(bv.empty());
+}
+
+TEST(bit_vec, copy_move_swap_compare)
+{
+    bit_vector a = {true, false, true};
+    bit_vector b = a;
+    EXPECT_EQ(a, b);
+    bit_vector c = std::move(b);
+    EXPECT_TRUE(b.empty());
+    EXPECT_EQ(c, a);
+    b = {false};
+    swap(b, c);
+    EXPECT_EQ(b, a);
+    EXPECT_EQ(c, (bit_vector{false}));
+    EXPECT_LT(c, a);
+    c = std::move(a);
+    EXPECT_EQ(c, b);
+}
+
+TEST(bit_vec, span)
+{
+    bit_word words[2] = {0x5, bit_word(1) << 63};
+    bit_span<bit_word> const s(words, 128);
+    EXPECT_EQ(s.size(), 128);
+    EXPECT_TRUE(s[0]);
+    EXPECT_FALSE(s[1]);
+    EXPECT_TRUE(s.back());
+    EXPECT_EQ(count(s.begin(), s.end(), true), 3);
+    s[1] = true;
+    EXPECT_EQ(words[0], 0x7u);
+
+    bit_span<bit_word const> const cs(words, 64);
+    EXPECT_EQ(find(cs.begin() + 3, cs.end(), true), cs.end());
+}
@@ -0,0 +1,114 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/bloom_filter.hpp>
+#include <boost/stl_interfaces/iterator_interface.hpp>
+
+#include <gtest/gtest.h>
+
+#include <iterator>
+#include <string>
+#include <vector>
+
+
+namespace bsi = boost::stl_interfaces;
+
+// The ints in [0, n), as an input range of prvalues.
+struct int_iterator : bsi::proxy_iterator_interface<
+                          int_iterator,
+                          std::input_iterator_tag,
+                          int>
+{
+    int_iterator() = default;
+    explicit int_iterator(int i) : i_(i) {}
+
+    int operator*() const { return i_; }
+    int_iterator & operator++()
+    {
+        ++i_;
+        return *this;
+    }
+    friend bool operator==(int_iterator lhs, int_iterator rhs)
+    {
+        return lhs.i_ == rhs.i_;
+    }
+
+    using base_type = bsi::proxy_iterator_interface<
+        int_iterator,
+        std::input_iterator_tag,
+        int>;
+    using base_type::operator++;
+
+private:
+    int i_ = 0;
+};
+
+TEST(bloom_filter, no_false_negatives)
+{
+    bsi::bloom_filter<int> f(10000);
+    EXPECT_TRUE(f.empty());
+    EXPECT_EQ(f.hash_count(), 7);
+    EXPECT_EQ(f.bit_count() % 512, 0u);
+    EXPECT_FALSE(f.contains(3));
+    for (int i = 0; i < 10000; ++i) {
+        f.insert(i * 3);
+    }
+    EXPECT_EQ(f.size(), 10000u);
+    for (int i = 0; i < 10000; ++i) {
+        ASSERT_TRUE(f.contains(i * 3));
+    }
+    f.clear();
+    EXPECT_TRUE(f.empty());
+    EXPECT_FALSE(f.contains(3));
+}
+
+TEST(bloom_filter, false_positive_rate)
+{
+    bsi::bloom_filter<int> f(100000, 0.01);
+    for (int i = 0; i < 100000; ++i) {
+        f.insert(i);
+    }
+    int false_positives = 0;
+    for (int i = 100000; i < 1100000; ++i) {
+        false_positives += f.contains(i);
+    }
+    // Blocking costs a little over the classic 1%.
+    EXPECT_LT(false_positives, 15000);
+    EXPECT_GT(false_positives, 5000);
+}
+
+TEST(bloom_filter, batch_contains)
+{
+    bsi::bloom_filter<std::string> f(1000);
+    std::vector<std::string> keys;
+    for (int i = 0; i < 1000; ++i) {
+        keys.push_back(std::to_string(i));
+    }
+    f.insert(keys.begin(), keys.begin() + 500);
+
+    // Any number of keys, not just whole batches.
+    for (int n : {0, 1, 15, 16, 17, 1000}) {
+        std::vector<bool> batch;
+        f.contains(keys.begin(), keys.begin() + n, std::back_inserter(batch));
+        ASSERT_EQ(batch.size(), std::size_t(n));
+        for (int i = 0; i < n; ++i) {
+            ASSERT_EQ(batch[std::size_t(i)], f.contains(keys[std::size_t(i)]));
+        }
+    }
+
+    // Into a bool array, from an iterator_interface input range.
+    bsi::bloom_filter<int> ints(100);
+    ints.insert(7);
+    ints.insert(40);
+    bool found[50];
+    bool * const last =
+        ints.contains(int_iterator(0), int_iterator(50), found);
+    EXPECT_EQ(last, found + 50);
+    EXPECT_TRUE(found[7]);
+    EXPECT_TRUE(found[40]);
+    for (int i = 0; i < 50; ++i) {
+        EXPECT_EQ(found[i], ints.contains(i));
+    }
+}
@@ -0,0 +1,255 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/btree.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <map>
+#include <numeric>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+
+namespace bsi = boost::stl_interfaces;
+
+using map_type = bsi::btree_map<int, int>;
+
+static_assert(
+    bsi::is_segmented_iterator<map_type::iterator>::value,
+    "btree_iterator models the segmented iterator protocol");
+static_assert(
+    std::is_convertible<map_type::iterator, map_type::const_iterator>::
+        value,
+    "");
+static_assert(
+    !std::is_convertible<map_type::const_iterator, map_type::iterator>::
+        value,
+    "");
+
+template<typename Map, typename StdMap>
+void check(Map const & m, StdMap const & expected)
+{
+    ASSERT_EQ(m.size(), expected.size());
+    ASSERT_EQ(m.empty(), expected.empty());
+    EXPECT_TRUE(std::equal(m.begin(), m.end(), expected.begin()));
+    EXPECT_TRUE(std::equal(m.rbegin(), m.rend(), expected.rbegin()));
+    EXPECT_EQ(
+        std::distance(m.begin(), m.end()), std::ptrdiff_t(expected.size()));
+}
+
+TEST(btree, map_basics)
+{
+    map_type m;
+    EXPECT_TRUE(m.empty());
+    EXPECT_TRUE(m.begin() == m.end());
+    EXPECT_TRUE(m.find(1) == m.end());
+    EXPECT_EQ(m.erase(1), 0u);
+
+    EXPECT_TRUE(m.insert({3, 30}).second);
+    EXPECT_FALSE(m.insert({3, 31}).second);
+    EXPECT_EQ(m[3], 30);
+    m[1] = 10;
+    EXPECT_TRUE(m.emplace(2, 20).second);
+    EXPECT_FALSE(m.try_emplace(2, 21).second);
+    EXPECT_TRUE(m.insert_or_assign(4, 40).second);
+    EXPECT_FALSE(m.insert_or_assign(4, 41).second);
+    EXPECT_EQ(m.at(4), 41);
+    EXPECT_THROW(m.at(5), std::out_of_range);
+
+    check(m, std::map<int, int>{{1, 10}, {2, 20}, {3, 30}, {4, 41}});
+    EXPECT_EQ(m.front().first, 1);
+    EXPECT_EQ(m.back().first, 4);
+    EXPECT_EQ(m.lower_bound(2)->first, 2);
+    EXPECT_EQ(m.upper_bound(2)->first, 3);
+    EXPECT_TRUE(m.upper_bound(4) == m.end());
+    EXPECT_TRUE(m.contains(3));
+    EXPECT_EQ(m.count(5), 0u);
+
+    map_type const & cm = m;
+    EXPECT_EQ(cm.find(2)->second, 20);
+    auto const range = cm.equal_range(3);
+    EXPECT_EQ(std::distance(range.first, range.second), 1);
+
+    m.begin()->second = 11;
+    EXPECT_EQ(m[1], 11);
+
+    map_type copy = m;
+    EXPECT_TRUE(copy == m);
+    copy[0] = 0;
+    EXPECT_TRUE(m < copy || copy < m);
+    EXPECT_TRUE(m != copy);
+    map_type moved = std::move(copy);
+    EXPECT_EQ(moved.size(), 5u);
+    swap(moved, m);
+    EXPECT_EQ(m.size(), 5u);
+    m.clear();
+    EXPECT_TRUE(m.empty());
+    m = moved;
+    EXPECT_EQ(m.size(), 4u);
+}
+
+TEST(btree, map_random_against_std_map)
+{
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> keys(0, 20000);
+    map_type m;
+    std::map<int, int> expected;
+    for (int round = 0; round < 6; ++round) {
+        for (int i = 0; i < 20000; ++i) {
+            int const k = keys(gen);
+            auto const result = m.insert({k, i});
+            EXPECT_EQ(result.second, expected.insert({k, i}).second);
+            ASSERT_EQ(result.first->first, k);
+        }
+        check(m, expected);
+        for (int i = 0; i < 25000; ++i) {
+            int const k = keys(gen);
+            ASSERT_EQ(m.erase(k), expected.erase(k));
+        }
+        check(m, expected);
+        for (int k = 0; k <= 20000; k += 7) {
+            auto const it = m.lower_bound(k);
+            auto const expected_it = expected.lower_bound(k);
+            if (expected_it == expected.end()) {
+                ASSERT_TRUE(it == m.end());
+            } else {
+                ASSERT_EQ(it->first, expected_it->first);
+            }
+        }
+    }
+
+    // Erasing through the returned iterators visits every element.
+    std::mt19937 erase_gen(7);
+    auto it = m.begin();
+    while (it != m.end()) {
+        auto const k = it->first;
+        if (erase_gen() % 3) {
+            it = m.erase(it);
+            expected.erase(k);
+            ASSERT_TRUE(it == m.end() || k < it->first);
+            ASSERT_TRUE(
+                it == m.end() || it->first == expected.upper_bound(k)->first);
+        } else {
+            ++it;
+        }
+    }
+    check(m, expected);
+    auto const first = std::next(m.begin(), 10);
+    auto const last = std::next(m.begin(), 1000);
+    auto const last_key = last->first;
+    auto const after = m.erase(first, last);
+    EXPECT_EQ(after->first, last_key);
+    expected.erase(
+        std::next(expected.begin(), 10), std::next(expected.begin(), 1000));
+    check(m, expected);
+    while (!m.empty()) {
+        m.erase(std::prev(m.end()));
+    }
+    EXPECT_TRUE(m.begin() == m.end());
+}
+
+TEST(btree, sequential_keys)
+{
+    // Increasing keys fill each leaf; decreasing ones split at the front.
+    map_type up;
+    map_type down;
+    std::map<int, int> expected;
+    for (int i = 0; i < 100000; ++i) {
+        up.insert(up.end(), {i, -i});
+        down.insert({100000 - 1 - i, -(100000 - 1 - i)});
+        expected.emplace(i, -i);
+    }
+    check(up, expected);
+    check(down, expected);
+    EXPECT_TRUE(up == down);
+    for (int i = 0; i < 100000; i += 2) {
+        up.erase(i);
+        expected.erase(i);
+    }
+    check(up, expected);
+
+    std::vector<std::pair<int, int>> sorted(expected.begin(), expected.end());
+    map_type const from_range(sorted.begin(), sorted.end());
+    check(from_range, expected);
+}
+
+TEST(btree, segmented_algorithms)
+{
+    bsi::btree_set<int> s;
+    for (int i = 0; i < 5000; ++i) {
+        s.insert(i * 3);
+    }
+    long long expected = 0;
+    for (int i = 0; i < 5000; ++i) {
+        expected += i * 3;
+    }
+    EXPECT_EQ(bsi::segmented_accumulate(s.begin(), s.end(), 0ll), expected);
+    auto const it = bsi::segmented_find(s.begin(), s.end(), 2997);
+    EXPECT_EQ(*it, 2997);
+    EXPECT_TRUE(it == s.find(2997));
+    EXPECT_TRUE(bsi::segmented_find(s.begin(), s.end(), 1) == s.end());
+
+    auto const first = s.lower_bound(100);
+    auto const last = s.lower_bound(10000);
+    EXPECT_EQ(
+        bsi::segmented_accumulate(first, last, 0ll),
+        std::accumulate(first, last, 0ll));
+
+    bsi::btree_set<int> const empty;
+    EXPECT_EQ(
+        bsi::segmented_accumulate(empty.begin(), empty.end(), 0ll), 0ll);
+}
+
+TEST(btree, set_of_strings)
+{
+    bsi::btree_set<std::string> s = {"b", "a", "c"};
+    std::set<std::string> expected = {"a", "b", "c"};
+    for (int i = 0; i < 3000; ++i) {
+        auto const x = std::to_string(i * 7919 % 3001);
+        EXPECT_EQ(s.insert(x).second, expected.insert(x).second);
+    }
+    check(s, expected);
+    EXPECT_FALSE(s.emplace("b").second);
+    EXPECT_EQ(*s.find("123"), "123");
+    for (int i = 0; i < 3000; i += 3) {
+        auto const x = std::to_string(i);
+        EXPECT_EQ(s.erase(x), expected.erase(x));
+    }
+    check(s, expected);
+    bsi::btree_set<std::string> copy = s;
+    check(copy, expected);
+}
+
+struct throws_on_construct
+{
+    explicit throws_on_construct(int x) : x(x)
+    {
+        if (x < 0)
+            throw x;
+    }
+    int x;
+};
+
+TEST(btree, insertion_that_throws)
+{
+    bsi::btree_map<int, throws_on_construct> m;
+    for (int i = 0; i < 2000; ++i) {
+        m.try_emplace(i * 2, i);
+    }
+    for (int i = 0; i < 2000; ++i) {
+        EXPECT_THROW(m.try_emplace(i * 2 + 1, -1), int);
+    }
+    EXPECT_EQ(m.size(), 2000u);
+    int i = 0;
+    for (auto const & x : m) {
+        ASSERT_EQ(x.first, i * 2);
+        ASSERT_EQ(x.second.x, i);
+        ++i;
+    }
+}
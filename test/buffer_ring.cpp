@@ -0,0 +1,126 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/buffer_ring.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <vector>
+
+
+namespace bsi = boost::stl_interfaces;
+
+// A sink that finishes writes in the order they were committed, when
+// wait() is called, and records what it was given.
+struct recording_sink
+{
+    void submit(std::size_t i, bsi::pointer_view<unsigned char const> bytes)
+    {
+        prepared.push_back(i);
+        written.append(bytes.begin(), bytes.end());
+        sizes.push_back(std::size_t(bytes.size()));
+    }
+    void commit()
+    {
+        ++commits;
+        committed.insert(committed.end(), prepared.begin(), prepared.end());
+        max_in_flight = (std::max)(max_in_flight, committed.size());
+        prepared.clear();
+    }
+    std::size_t wait()
+    {
+        EXPECT_FALSE(committed.empty());
+        auto const i = committed.front();
+        committed.pop_front();
+        return i;
+    }
+
+    std::vector<std::size_t> prepared;
+    std::deque<std::size_t> committed;
+    std::string written;
+    std::vector<std::size_t> sizes;
+    int commits = 0;
+    std::size_t max_in_flight = 0;
+};
+
+std::string message(int n)
+{
+    std::string retval;
+    for (int i = 0; i < n; ++i) {
+        retval += char('a' + i % 26);
+    }
+    return retval;
+}
+
+TEST(buffer_ring, std_copy)
+{
+    recording_sink sink;
+    std::string const msg = message(1000);
+    {
+        bsi::buffer_ring<recording_sink> ring(sink, 3, 64, 2);
+        EXPECT_EQ(ring.buffer_count(), 3u);
+        EXPECT_EQ(ring.buffer_size(), 64u);
+        EXPECT_EQ(
+            reinterpret_cast<std::uintptr_t>(ring.data()) %
+                bsi::buffer_ring<recording_sink>::alignment,
+            0u);
+
+        std::copy(msg.begin(), msg.end(), ring.begin());
+        EXPECT_LE(ring.in_flight(), 3u);
+        ring.flush();
+        EXPECT_EQ(sink.written, msg);
+        EXPECT_TRUE(sink.prepared.empty());
+    }
+    // The destructor drained the ring.
+    EXPECT_TRUE(sink.committed.empty());
+    EXPECT_LE(sink.max_in_flight, 3u);
+    ASSERT_EQ(sink.sizes.size(), 1000u / 64 + 1);
+    EXPECT_EQ(sink.sizes.front(), 64u);
+    EXPECT_EQ(sink.sizes.back(), 1000u % 64);
+    // Batches are committed early when the ring runs out of buffers.
+    EXPECT_LT(sink.commits, int(sink.sizes.size()));
+}
+
+TEST(buffer_ring, transform_and_write)
+{
+    recording_sink sink;
+    bsi::buffer_ring<recording_sink> ring(sink, 2, 16);
+    std::vector<int> const ints = {1, 2, 3};
+    std::transform(ints.begin(), ints.end(), ring.begin(), [](int x) {
+        return (unsigned char)('0' + x);
+    });
+    ring.write("-header-", 8);
+    char const tail[] = "0123456789abcdefghij";
+    copy(tail, tail + 20, ring.begin());
+    ring.drain();
+    EXPECT_EQ(sink.written, std::string("123-header-") + tail);
+    EXPECT_EQ(ring.in_flight(), 0u);
+    EXPECT_EQ(sink.max_in_flight, 2u);
+
+    // Nothing written, nothing submitted.
+    auto const commits = sink.commits;
+    ring.flush();
+    EXPECT_EQ(sink.commits, commits);
+}
+
+TEST(buffer_ring, back_pressure)
+{
+    recording_sink sink;
+    bsi::buffer_ring<recording_sink> ring(sink, 4, 8, 16);
+    std::string const msg = message(200);
+    auto out = ring.begin();
+    for (char c : msg) {
+        *out++ = (unsigned char)c;
+        ASSERT_LE(ring.in_flight(), 4u);
+    }
+    ring.drain();
+    EXPECT_EQ(sink.written, msg);
+    EXPECT_EQ(sink.max_in_flight, 4u);
+    EXPECT_EQ(sink.sizes.size(), 25u);
+}
@@ -0,0 +1,138 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/stl_interfaces/buffered_output_iterator.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <numeric>
+#include <string>
+#include <vector>
+
+
+using boost::stl_interfaces::buffered_output_iterator;
+using boost::stl_interfaces::container_output_buffer;
+using boost::stl_interfaces::fd_output_buffer;
+
+
+// A container with append_range(), that counts its calls.
+struct appendable
+{
+    using value_type = std::string;
+
+    template<typename R>
+    void append_range(R && r)
+    {
+        elements.insert(elements.end(), r.begin(), r.end());
+        ++appends;
+    }
+
+    std::vector<std::string> elements;
+    int appends = 0;
+};
+
+static_assert(
+    std::is_same<
+        std::iterator_traits<
+            container_output_buffer<std::vector<int>>::iterator>::
+            iterator_category,
+        std::output_iterator_tag>::value,
+    "");
+
+
+TEST(buffered_output, container)
+{
+    std::vector<int> v;
+    {
+        container_output_buffer<std::vector<int>, 4> buffer(v);
+        auto out = buffer.out();
+        *out++ = 1;
+        *out++ = 2;
+        *out++ = 3;
+        EXPECT_TRUE(v.empty());
+        EXPECT_EQ(buffer.size(), 3u);
+        *out++ = 4;
+        EXPECT_EQ(v, (std::vector<int>{1, 2, 3, 4}));
+        EXPECT_EQ(buffer.size(), 0u);
+
+        out = std::fill_n(out, 6, 7);
+        EXPECT_EQ(v.size(), 8u);
+        buffer.flush();
+        EXPECT_EQ(v.size(), 10u);
+        buffer.flush();
+        EXPECT_EQ(v.size(), 10u);
+
+        // Copies of the iterator all write to the same buffer.
+        auto out2 = out;
+        *out = 8;
+        *out2 = 9;
+        EXPECT_EQ(buffer.size(), 2u);
+    }
+    EXPECT_EQ(v, (std::vector<int>{1, 2, 3, 4, 7, 7, 7, 7, 7, 7, 8, 9}));
+}
+
+TEST(buffered_output, append_range)
+{
+    appendable c;
+    {
+        container_output_buffer<appendable, 3> buffer(c);
+        std::vector<std::string> const strings = {"a", "b", "c", "d", "e"};
+        std::copy(strings.begin(), strings.end(), buffer.out());
+        EXPECT_EQ(c.appends, 1);
+        std::string s = "f";
+        *buffer.out() = std::move(s);
+    }
+    EXPECT_EQ(c.appends, 2);
+    EXPECT_EQ(
+        c.elements,
+        (std::vector<std::string>{"a", "b", "c", "d", "e", "f"}));
+}
+
+TEST(buffered_output, fd)
+{
+    int fds[2];
+    ASSERT_EQ(::pipe(fds), 0);
+    std::vector<std::uint16_t> expected(1000);
+    std::iota(expected.begin(), expected.end(), 0);
+    {
+        fd_output_buffer<std::uint16_t, 64> buffer(fds[1]);
+        std::copy(expected.begin(), expected.end(), buffer.out());
+        buffer.flush();
+    }
+    ::close(fds[1]);
+
+    std::vector<std::uint16_t> result(2000);
+    std::size_t bytes = 0;
+    for (;;) {
+        auto const n = ::read(
+            fds[0],
+            reinterpret_cast<char *>(result.data()) + bytes,
+            result.size() * 2 - bytes);
+        ASSERT_LE(0, n);
+        if (!n)
+            break;
+        bytes += std::size_t(n);
+    }
+    ::close(fds[0]);
+    result.resize(bytes / 2);
+    EXPECT_EQ(result, expected);
+}
+
+TEST(buffered_output, fd_errors)
+{
+    fd_output_buffer<int, 4> buffer(-1);
+    *buffer.out() = 1;
+    try {
+        buffer.flush();
+        ADD_FAILURE();
+    } catch (std::system_error const & e) {
+        EXPECT_EQ(e.code(), std::errc::bad_file_descriptor);
+    }
+    EXPECT_EQ(buffer.size(), 0u);
+    // The destructor's flush() swallows the error.
+    *buffer.out() = 2;
+}
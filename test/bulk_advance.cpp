@@ -0,0 +1,192 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/cached_view_interface.hpp>
+#include <boost/stl_interfaces/container_interface.hpp>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <numeric>
+
+
+// A forward iterator over an array, with bulk advance_n() and distance_to()
+// primitives; every single-step increment is counted, so that the tests can
+// tell whether the primitives were used.
+struct skip_iter : boost::stl_interfaces::
+                       iterator_interface<skip_iter, std::forward_iterator_tag, int>
+{
+    skip_iter() : it_(nullptr), increments_(nullptr) {}
+    skip_iter(int * it, int * increments) : it_(it), increments_(increments)
+    {}
+
+    int & operator*() const { return *it_; }
+    skip_iter & operator++()
+    {
+        ++it_;
+        ++*increments_;
+        return *this;
+    }
+    friend bool operator==(skip_iter lhs, skip_iter rhs) noexcept
+    {
+        return lhs.it_ == rhs.it_;
+    }
+
+    using base_type = boost::stl_interfaces::
+        iterator_interface<skip_iter, std::forward_iterator_tag, int>;
+    using base_type::operator++;
+
+private:
+    friend boost::stl_interfaces::access;
+
+    void advance_n(std::ptrdiff_t n) { it_ += n; }
+    std::ptrdiff_t distance_to(skip_iter other) const
+    {
+        return other.it_ - it_;
+    }
+
+    int * it_;
+    int * increments_;
+};
+
+// The same, without the primitives.
+struct plain_iter
+    : boost::stl_interfaces::
+          iterator_interface<plain_iter, std::forward_iterator_tag, int>
+{
+    plain_iter() : it_(nullptr), increments_(nullptr) {}
+    plain_iter(int * it, int * increments) : it_(it), increments_(increments)
+    {}
+
+    int & operator*() const { return *it_; }
+    plain_iter & operator++()
+    {
+        ++it_;
+        ++*increments_;
+        return *this;
+    }
+    friend bool operator==(plain_iter lhs, plain_iter rhs) noexcept
+    {
+        return lhs.it_ == rhs.it_;
+    }
+
+    using base_type = boost::stl_interfaces::
+        iterator_interface<plain_iter, std::forward_iterator_tag, int>;
+    using base_type::operator++;
+
+private:
+    int * it_;
+    int * increments_;
+};
+
+template<typename Iter>
+struct skip_container : boost::stl_interfaces::container_interface<
+                            skip_container<Iter>,
+                            boost::stl_interfaces::discontiguous>
+{
+    using value_type = int;
+    using reference = int &;
+    using const_reference = int const &;
+    using iterator = Iter;
+    using const_iterator = Iter;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    skip_container() : increments_(0) { std::iota(a_.begin(), a_.end(), 0); }
+
+    iterator begin() const { return iterator(a_.data(), &increments_); }
+    iterator end() const
+    {
+        return iterator(a_.data() + a_.size(), &increments_);
+    }
+
+    int increments() const { return increments_; }
+
+private:
+    mutable std::array<int, 100> a_;
+    mutable int increments_;
+};
+
+template<typename Iter>
+struct skip_view : boost::stl_interfaces::cached_size_view_interface<
+                       skip_view<Iter>>
+{
+    Iter begin() const { return c_.begin(); }
+    Iter end() const { return c_.end(); }
+
+    int increments() const { return c_.increments(); }
+
+private:
+    skip_container<Iter> c_;
+};
+
+
+TEST(bulk_advance, advance_next_distance)
+{
+    std::array<int, 10> a = {{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}};
+
+    {
+        int increments = 0;
+        skip_iter first(a.data(), &increments);
+        skip_iter last(a.data() + a.size(), &increments);
+
+        boost::stl_interfaces::advance(first, 3);
+        EXPECT_EQ(*first, 3);
+        EXPECT_EQ(*boost::stl_interfaces::next(first), 4);
+        EXPECT_EQ(*boost::stl_interfaces::next(first, 5), 8);
+        EXPECT_EQ(boost::stl_interfaces::distance(first, last), 7);
+        EXPECT_EQ(increments, 0);
+
+        using namespace boost::stl_interfaces;
+        advance(first, 1);
+        EXPECT_EQ(*first, 4);
+        EXPECT_EQ(increments, 0);
+    }
+    {
+        int increments = 0;
+        plain_iter first(a.data(), &increments);
+        plain_iter last(a.data() + a.size(), &increments);
+
+        boost::stl_interfaces::advance(first, 3);
+        EXPECT_EQ(*first, 3);
+        EXPECT_EQ(*boost::stl_interfaces::next(first, 5), 8);
+        EXPECT_EQ(boost::stl_interfaces::distance(first, last), 7);
+        EXPECT_EQ(increments, 3 + 5 + 7);
+    }
+}
+
+TEST(bulk_advance, container_size)
+{
+    {
+        skip_container<skip_iter> const c;
+        EXPECT_EQ(c.size(), 100u);
+        EXPECT_EQ(c.increments(), 0);
+        skip_container<skip_iter> c2;
+        EXPECT_EQ(c2.size(), 100u);
+        EXPECT_EQ(c2.increments(), 0);
+    }
+    {
+        // Without distance_to(), a forward-only container is not sized.
+        skip_container<plain_iter> const c;
+        EXPECT_EQ(std::distance(c.begin(), c.end()), 100);
+        EXPECT_EQ(c.increments(), 100);
+    }
+}
+
+TEST(bulk_advance, cached_size)
+{
+    {
+        skip_view<skip_iter> v;
+        EXPECT_EQ(v.size(), 100);
+        EXPECT_EQ(v.increments(), 0);
+    }
+    {
+        skip_view<plain_iter> v;
+        EXPECT_EQ(v.size(), 100);
+        EXPECT_EQ(v.increments(), 100);
+        EXPECT_EQ(v.size(), 100);
+        EXPECT_EQ(v.increments(), 100);
+    }
+}
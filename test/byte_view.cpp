@@ -0,0 +1,86 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/byte_view.hpp>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+
+namespace bsi = boost::stl_interfaces;
+
+struct wire_header
+{
+    std::uint32_t id;
+    std::uint16_t kind;
+    std::uint16_t length;
+};
+
+TEST(byte_view, as_bytes)
+{
+    std::vector<std::uint32_t> ints = {1, 2, 3};
+    auto const bytes = bsi::as_bytes(ints);
+    static_assert(
+        std::is_same<
+            decltype(bytes),
+            bsi::pointer_view<unsigned char const> const>::value,
+        "");
+    EXPECT_EQ(bytes.size(), 12);
+    EXPECT_EQ((void const *)bytes.data(), (void const *)ints.data());
+
+    auto writable = bsi::as_writable_bytes(ints);
+    std::memset(writable.data(), 0, writable.size());
+    EXPECT_EQ(ints, (std::vector<std::uint32_t>(3, 0)));
+
+    std::array<std::uint16_t, 4> const shorts = {{1, 2, 3, 4}};
+    EXPECT_EQ(bsi::as_bytes(shorts).size(), 8);
+
+    // A contiguous view, as well as a container.
+    bsi::pointer_view<std::uint32_t> sub(ints.data() + 1, ints.data() + 3);
+    EXPECT_EQ(bsi::as_bytes(sub).size(), 8);
+    EXPECT_EQ(
+        (void const *)bsi::as_bytes(sub).data(),
+        (void const *)(ints.data() + 1));
+}
+
+TEST(byte_view, view_as)
+{
+    std::vector<wire_header> headers = {{1, 2, 3}, {4, 5, 6}};
+    std::vector<std::uint32_t> buffer(headers.size() * sizeof(wire_header) / 4);
+    std::memcpy(
+        buffer.data(), headers.data(), headers.size() * sizeof(wire_header));
+
+    auto const bytes = bsi::as_bytes(buffer);
+    ASSERT_TRUE(bsi::can_view_as<wire_header>(bytes));
+    auto const received = bsi::view_as<wire_header>(bytes);
+    static_assert(
+        std::is_same<
+            decltype(received),
+            bsi::pointer_view<wire_header const> const>::value,
+        "");
+    ASSERT_EQ(received.size(), 2);
+    EXPECT_EQ((void const *)received.data(), (void const *)buffer.data());
+    EXPECT_EQ(received[1].id, 4u);
+    EXPECT_EQ(received.back().length, 6);
+
+    auto editable = bsi::view_as<wire_header>(bsi::as_writable_bytes(buffer));
+    editable[0].kind = 7;
+    EXPECT_EQ(bsi::view_as<wire_header>(bytes).front().kind, 7);
+
+    // Not a whole number of headers, and misaligned.
+    EXPECT_FALSE(bsi::can_view_as<wire_header>(bytes.subview(0, 12)));
+    EXPECT_FALSE(bsi::can_view_as<wire_header>(bytes.subview(1, 8)));
+    EXPECT_TRUE(bsi::can_view_as<wire_header>(bytes.subview(8, 8)));
+    EXPECT_EQ(bsi::view_as<wire_header>(bytes.subview(8)).front().id, 4u);
+
+    std::vector<char> chars(16);
+    EXPECT_EQ(bsi::view_as<char>(chars).size(), 16);
+    EXPECT_TRUE(bsi::view_as<wire_header>(bytes.subview(0, 0)).empty());
+}
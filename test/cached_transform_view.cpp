@@ -0,0 +1,150 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/cached_transform_view.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <numeric>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+namespace bsi = boost::stl_interfaces;
+
+// Counts its calls, so that the tests can tell how often each element was
+// computed.
+struct parse_count
+{
+    int operator()(std::string const & s) const
+    {
+        ++*calls;
+        return std::stoi(s);
+    }
+    int * calls;
+};
+
+using parse_view =
+    bsi::cached_transform_view<std::vector<std::string>::iterator, parse_count>;
+
+std::vector<std::string> numbers(int n)
+{
+    std::vector<std::string> retval;
+    for (int i = 0; i < n; ++i) {
+        retval.push_back(std::to_string((i * 7919) % n));
+    }
+    return retval;
+}
+
+TEST(cached_transform_view, computes_once)
+{
+    auto strings = numbers(100);
+    int calls = 0;
+    auto const v =
+        bsi::make_cached_transform_view(strings, parse_count{&calls});
+
+    EXPECT_EQ(v.size(), 100);
+    EXPECT_FALSE(v.cached(3));
+    EXPECT_EQ(v[3], (3 * 7919) % 100);
+    EXPECT_TRUE(v.cached(3));
+    EXPECT_EQ(calls, 1);
+    EXPECT_EQ(v[3], (3 * 7919) % 100);
+    EXPECT_EQ(*(v.begin() + 3), (3 * 7919) % 100);
+    EXPECT_EQ(calls, 1);
+
+    // Repeated passes compute each element once.
+    for (int pass = 0; pass < 3; ++pass) {
+        EXPECT_EQ(std::accumulate(v.begin(), v.end(), 0), 99 * 100 / 2);
+    }
+    EXPECT_EQ(calls, 100);
+
+    // The references are stable.
+    int const * p = &v[50];
+    EXPECT_EQ(&v[50], p);
+    EXPECT_EQ(&*(v.begin() + 50), p);
+}
+
+TEST(cached_transform_view, sort_by_key)
+{
+    auto strings = numbers(1000);
+    int calls = 0;
+    auto const keys =
+        bsi::make_cached_transform_view(strings, parse_count{&calls});
+
+    std::vector<int> order(1000);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](int a, int b) {
+        return keys[a] < keys[b];
+    });
+    EXPECT_EQ(calls, 1000);
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_EQ(std::stoi(strings[order[i]]), i);
+    }
+
+    // The view's own iterators work with the standard algorithms too.
+    EXPECT_EQ(*std::max_element(keys.begin(), keys.end()), 999);
+    EXPECT_EQ(std::find(keys.begin(), keys.end(), 0) - keys.begin(), 0);
+    EXPECT_EQ(calls, 1000);
+}
+
+TEST(cached_transform_view, reset_cache)
+{
+    auto strings = numbers(10);
+    int calls = 0;
+    parse_view v(strings.begin(), strings.end(), parse_count{&calls});
+
+    EXPECT_EQ(v[1], 9);
+    strings[1] = "42";
+    EXPECT_EQ(v[1], 9);
+    v.reset_cache();
+    EXPECT_FALSE(v.cached(1));
+    EXPECT_EQ(v[1], 42);
+    EXPECT_EQ(calls, 2);
+}
+
+TEST(cached_transform_view, copy_and_move)
+{
+    auto strings = numbers(10);
+    int calls = 0;
+    parse_view v(strings.begin(), strings.end(), parse_count{&calls});
+    EXPECT_EQ(v[2], 8);
+
+    // A copy has a cache of its own.
+    parse_view copy = v;
+    EXPECT_FALSE(copy.cached(2));
+    EXPECT_EQ(copy[2], 8);
+    EXPECT_EQ(calls, 2);
+
+    // A move takes the cache.
+    parse_view moved = std::move(v);
+    EXPECT_TRUE(moved.cached(2));
+    EXPECT_TRUE(v.empty());
+    EXPECT_EQ(moved[2], 8);
+    EXPECT_EQ(calls, 2);
+
+    copy = std::move(moved);
+    EXPECT_TRUE(copy.cached(2));
+    EXPECT_EQ(copy.size(), 10);
+    EXPECT_EQ(copy.base_end() - copy.base_begin(), 10);
+}
+
+TEST(cached_transform_view, nontrivial_results)
+{
+    // Computed strings are destroyed with the view, and by reset_cache();
+    // the sanitizers check that nothing leaks.
+    std::vector<int> ints(200);
+    std::iota(ints.begin(), ints.end(), 0);
+    auto const to_string = [](int x) {
+        return std::string(40, char('a' + x % 26));
+    };
+    auto v = bsi::make_cached_transform_view(ints, to_string);
+    for (int i = 0; i < 200; i += 3) {
+        EXPECT_EQ(v[i][0], char('a' + i % 26));
+    }
+    v.reset_cache();
+    EXPECT_EQ(v[5], std::string(40, 'f'));
+}
@@ -0,0 +1,328 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/cached_view_interface.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+
+// Drops the leading elements that are less than a threshold, counting the
+// comparisons.
+struct drop_less_view : boost::stl_interfaces::cached_begin_view_interface<
+                            drop_less_view,
+                            std::vector<int>::iterator>
+{
+    drop_less_view(std::vector<int> & v, int threshold) :
+        v_(&v),
+        threshold_(threshold),
+        comparisons_(0)
+    {}
+
+    std::vector<int>::iterator end() { return v_->end(); }
+
+    int comparisons() const { return comparisons_; }
+
+private:
+    friend boost::stl_interfaces::access;
+
+    std::vector<int>::iterator uncached_begin()
+    {
+        auto first = v_->begin();
+        for (; first != v_->end(); ++first) {
+            ++comparisons_;
+            if (threshold_ <= *first)
+                break;
+        }
+        return first;
+    }
+
+    std::vector<int> * v_;
+    int threshold_;
+    int comparisons_;
+};
+
+
+TEST(cached_view, begin_is_computed_once)
+{
+    std::vector<int> ints = {1, 2, 3, 4, 5};
+    drop_less_view v(ints, 3);
+
+    EXPECT_EQ(v.comparisons(), 0);
+    EXPECT_EQ(v.begin(), ints.begin() + 2);
+    EXPECT_EQ(v.comparisons(), 3);
+
+    EXPECT_EQ(v.begin(), ints.begin() + 2);
+    EXPECT_FALSE(v.empty());
+    EXPECT_TRUE((bool)v);
+    EXPECT_EQ(v.front(), 3);
+    EXPECT_EQ(v.back(), 5);
+    EXPECT_EQ(v[1], 4);
+    EXPECT_EQ(v.size(), 3);
+    EXPECT_EQ(v.comparisons(), 3);
+}
+
+TEST(cached_view, empty_result)
+{
+    std::vector<int> ints = {1, 2};
+    drop_less_view v(ints, 10);
+    EXPECT_TRUE(v.empty());
+    EXPECT_TRUE(v.empty());
+    EXPECT_EQ(v.comparisons(), 2);
+}
+
+TEST(cached_view, copies_do_not_share_the_cache)
+{
+    std::vector<int> ints = {1, 2, 3, 4, 5};
+    drop_less_view v(ints, 3);
+    EXPECT_EQ(v.front(), 3);
+    EXPECT_EQ(v.comparisons(), 3);
+
+    drop_less_view copy(v);
+    EXPECT_EQ(copy.front(), 3);
+    EXPECT_EQ(copy.comparisons(), 6);
+
+    std::vector<int> other_ints = {7, 8};
+    drop_less_view assigned(other_ints, 0);
+    EXPECT_EQ(assigned.front(), 7);
+    assigned = v;
+    EXPECT_EQ(assigned.front(), 3);
+}
+
+TEST(cached_view, reset_begin_cache)
+{
+    std::vector<int> ints = {1, 2, 3, 4, 5};
+    drop_less_view v(ints, 3);
+    EXPECT_EQ(v.front(), 3);
+
+    ints[2] = 0;
+    v.reset_begin_cache();
+    EXPECT_EQ(v.front(), 4);
+    EXPECT_EQ(v.comparisons(), 3 + 4);
+}
+
+// A forward-only view of the even elements of a vector, counting the
+// increments of its iterator.
+struct even_iterator : boost::stl_interfaces::iterator_interface<
+                           even_iterator,
+                           std::forward_iterator_tag,
+                           int>
+{
+    even_iterator() : it_(nullptr), last_(nullptr), increments_(nullptr) {}
+    even_iterator(int * it, int * last, int * increments) :
+        it_(it),
+        last_(last),
+        increments_(increments)
+    {
+        skip_odd();
+    }
+
+    int & operator*() const { return *it_; }
+    even_iterator & operator++()
+    {
+        ++*increments_;
+        ++it_;
+        skip_odd();
+        return *this;
+    }
+    friend bool operator==(even_iterator lhs, even_iterator rhs)
+    {
+        return lhs.it_ == rhs.it_;
+    }
+
+private:
+    void skip_odd()
+    {
+        while (it_ != last_ && *it_ % 2)
+            ++it_;
+    }
+
+    int * it_;
+    int * last_;
+    int * increments_;
+};
+
+struct evens_view
+    : boost::stl_interfaces::cached_size_view_interface<evens_view>
+{
+    evens_view(std::vector<int> & v) : v_(&v), increments_(0) {}
+
+    even_iterator begin()
+    {
+        return even_iterator(
+            v_->data(), v_->data() + v_->size(), &increments_);
+    }
+    even_iterator end()
+    {
+        return even_iterator(
+            v_->data() + v_->size(), v_->data() + v_->size(), &increments_);
+    }
+
+    int increments() const { return increments_; }
+
+private:
+    std::vector<int> * v_;
+    int increments_;
+};
+
+TEST(cached_view, size_is_computed_once)
+{
+    std::vector<int> ints = {1, 2, 3, 4, 5, 6};
+    evens_view v(ints);
+
+    EXPECT_FALSE(v.empty());
+    EXPECT_EQ(v.increments(), 0);
+
+    EXPECT_EQ(v.size(), 3);
+    EXPECT_EQ(v.increments(), 3);
+    EXPECT_EQ(v.size(), 3);
+    EXPECT_FALSE(v.empty());
+    EXPECT_TRUE((bool)v);
+    EXPECT_EQ(v.front(), 2);
+    EXPECT_EQ(v.increments(), 3);
+
+    evens_view copy(v);
+    EXPECT_EQ(copy.size(), 3);
+
+    ints.push_back(8);
+    v.reset_size_cache();
+    EXPECT_EQ(v.size(), 4);
+}
+
+TEST(cached_view, empty_size)
+{
+    std::vector<int> ints = {1, 3};
+    evens_view v(ints);
+    EXPECT_EQ(v.size(), 0);
+    EXPECT_TRUE(v.empty());
+}
+
+// Caches both begin() and size().
+struct cached_drop_less_view
+    : boost::stl_interfaces::cached_size_view_interface<
+          cached_drop_less_view,
+          boost::stl_interfaces::cached_begin_view_interface<
+              cached_drop_less_view,
+              std::vector<int>::iterator>>
+{
+    cached_drop_less_view(std::vector<int> & v, int threshold) :
+        v_(&v),
+        threshold_(threshold),
+        begins_(0)
+    {}
+
+    std::vector<int>::iterator end() { return v_->end(); }
+
+    int begins() const { return begins_; }
+
+private:
+    friend boost::stl_interfaces::access;
+
+    std::vector<int>::iterator uncached_begin()
+    {
+        ++begins_;
+        return std::find_if(
+            v_->begin(), v_->end(), [this](int x) { return threshold_ <= x; });
+    }
+
+    std::vector<int> * v_;
+    int threshold_;
+    int begins_;
+};
+
+TEST(cached_view, cached_begin_and_size)
+{
+    std::vector<int> ints = {1, 2, 3, 4, 5};
+    cached_drop_less_view v(ints, 3);
+    EXPECT_EQ(v.size(), 3);
+    EXPECT_EQ(v.size(), 3);
+    EXPECT_FALSE(v.empty());
+    EXPECT_EQ(v.front(), 3);
+    EXPECT_EQ(v.begins(), 1);
+}
+
+// Knows whether it is empty, and its size, without calling begin(), like a
+// view of the elements of a sorted vector at or above a threshold.
+struct at_least_view : boost::stl_interfaces::view_interface<at_least_view>
+{
+    at_least_view(std::vector<int> const & v, int threshold) :
+        v_(&v),
+        threshold_(threshold),
+        begins_(0)
+    {}
+
+    std::vector<int>::const_iterator begin() const
+    {
+        ++begins_;
+        return std::find_if(v_->begin(), v_->end(), [this](int x) {
+            return threshold_ <= x;
+        });
+    }
+    std::vector<int>::const_iterator end() const { return v_->end(); }
+
+    int begins() const { return begins_; }
+
+private:
+    friend boost::stl_interfaces::access;
+
+    bool cheap_empty() const
+    {
+        return v_->empty() || v_->back() < threshold_;
+    }
+
+    std::vector<int> const * v_;
+    int threshold_;
+    mutable int begins_;
+};
+
+// Knows its size without calling begin().
+struct first_n_view : boost::stl_interfaces::view_interface<first_n_view>
+{
+    first_n_view(std::vector<int> const & v, std::ptrdiff_t n) :
+        v_(&v),
+        n_(n),
+        begins_(0)
+    {}
+
+    std::vector<int>::const_iterator begin() const
+    {
+        ++begins_;
+        return v_->begin();
+    }
+    std::vector<int>::const_iterator end() const { return v_->begin() + n_; }
+
+    std::ptrdiff_t cheap_size() const noexcept { return n_; }
+
+    int begins() const { return begins_; }
+
+private:
+    std::vector<int> const * v_;
+    std::ptrdiff_t n_;
+    mutable int begins_;
+};
+
+TEST(cached_view, cheap_empty_and_size)
+{
+    std::vector<int> const ints = {1, 2, 3, 4, 5};
+
+    at_least_view const v(ints, 3);
+    EXPECT_FALSE(v.empty());
+    EXPECT_TRUE((bool)v);
+    EXPECT_EQ(v.begins(), 0);
+    EXPECT_EQ(v.front(), 3);
+    EXPECT_EQ(v.size(), 3);
+    EXPECT_TRUE(at_least_view(ints, 6).empty());
+    EXPECT_FALSE((bool)at_least_view(ints, 6));
+
+    first_n_view const w(ints, 2);
+    EXPECT_EQ(w.size(), 2);
+    EXPECT_FALSE(w.empty());
+    EXPECT_TRUE((bool)w);
+    EXPECT_EQ(w.begins(), 0);
+    EXPECT_EQ(w.back(), 2);
+    EXPECT_TRUE(first_n_view(ints, 0).empty());
+}
@@ -0,0 +1,189 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/cartesian_product_view.hpp>
+#include <boost/stl_interfaces/parallel.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <forward_list>
+#include <list>
+#include <string>
+#include <vector>
+
+
+namespace bsi = boost::stl_interfaces;
+
+using ra_product = bsi::
+    cartesian_product_iterator<int *, std::vector<std::string>::iterator>;
+using bidi_product =
+    bsi::cartesian_product_iterator<int *, std::list<int>::iterator>;
+using fwd_product = bsi::cartesian_product_iterator<
+    std::forward_list<int>::iterator,
+    std::list<int>::iterator>;
+
+static_assert(
+    std::is_same<
+        ra_product::iterator_category,
+        std::random_access_iterator_tag>::value,
+    "");
+static_assert(
+    std::is_same<
+        bidi_product::iterator_category,
+        std::bidirectional_iterator_tag>::value,
+    "");
+static_assert(
+    std::is_same<fwd_product::iterator_category, std::forward_iterator_tag>::
+        value,
+    "");
+static_assert(
+    std::is_same<ra_product::value_type, std::tuple<int, std::string>>::value,
+    "");
+static_assert(
+    std::is_same<ra_product::reference, std::tuple<int &, std::string &>>::
+        value,
+    "");
+
+using triple = std::tuple<int, char, int>;
+
+// The product in the order of the loop nest it replaces.
+template<typename R0, typename R1, typename R2>
+std::vector<triple> nested(R0 const & r0, R1 const & r1, R2 const & r2)
+{
+    std::vector<triple> retval;
+    for (auto x : r0) {
+        for (auto y : r1) {
+            for (auto z : r2) {
+                retval.emplace_back(x, y, z);
+            }
+        }
+    }
+    return retval;
+}
+
+
+TEST(cartesian_product_view, random_access)
+{
+    std::array<int, 2> xs = {{1, 2}};
+    std::string const ys = "abc";
+    std::vector<int> zs = {10, 20, 30, 40};
+    auto const v = bsi::make_cartesian_product_view(xs, ys, zs);
+    auto const expected = nested(xs, ys, zs);
+
+    EXPECT_EQ(v.size(), 24);
+    EXPECT_EQ(std::vector<triple>(v.begin(), v.end()), expected);
+
+    // Every jump agrees with the same number of increments.
+    for (std::ptrdiff_t i = 0; i <= 24; ++i) {
+        auto it = v.begin();
+        for (std::ptrdiff_t j = 0; j < i; ++j) {
+            ++it;
+        }
+        EXPECT_TRUE(v.begin() + i == it);
+        EXPECT_EQ(it - v.begin(), i);
+        EXPECT_EQ(v.end() - it, 24 - i);
+        if (i < 24) {
+            EXPECT_EQ(triple(v[i]), expected[i]);
+            EXPECT_EQ(triple(*it), expected[i]);
+        }
+        if (0 < i) {
+            auto prev = it;
+            --prev;
+            EXPECT_EQ(triple(*prev), expected[i - 1]);
+            EXPECT_EQ(prev + 1, it);
+        }
+    }
+    EXPECT_EQ(v.end() - 24, v.begin());
+    EXPECT_EQ(v.begin() + 13 - 8, v.begin() + 5);
+    EXPECT_TRUE(v.begin() + 3 < v.begin() + 4);
+
+    // The references refer to the elements.
+    std::get<2>(*(v.begin() + 5)) = 99;
+    EXPECT_EQ(zs[1], 99);
+
+    std::vector<triple> reversed(
+        std::make_reverse_iterator(v.end()),
+        std::make_reverse_iterator(v.begin()));
+    std::reverse(reversed.begin(), reversed.end());
+    EXPECT_EQ(reversed, nested(xs, ys, zs));
+}
+
+TEST(cartesian_product_view, forward_and_bidirectional)
+{
+    std::forward_list<int> const xs = {1, 2, 3};
+    std::list<char> const ys = {'x', 'y'};
+    std::vector<int> const zs = {7, 8};
+
+    auto const fwd = bsi::make_cartesian_product_view(xs, ys, zs);
+    EXPECT_EQ(std::distance(fwd.begin(), fwd.end()), 12);
+    EXPECT_EQ(std::vector<triple>(fwd.begin(), fwd.end()), nested(xs, ys, zs));
+
+    std::vector<int> const ws = {1, 2, 3};
+    auto const bidi = bsi::make_cartesian_product_view(ws, ys, zs);
+    std::vector<triple> backward;
+    for (auto it = bidi.end(); it != bidi.begin();) {
+        --it;
+        backward.push_back(*it);
+    }
+    std::reverse(backward.begin(), backward.end());
+    EXPECT_EQ(backward, nested(ws, ys, zs));
+}
+
+TEST(cartesian_product_view, empty_and_single)
+{
+    std::vector<int> const xs = {1, 2};
+    std::vector<int> const none;
+
+    auto const e0 = bsi::make_cartesian_product_view(none, xs);
+    auto const e1 = bsi::make_cartesian_product_view(xs, none);
+    auto const e2 = bsi::make_cartesian_product_view(xs, none, xs);
+    EXPECT_TRUE(e0.empty());
+    EXPECT_TRUE(e1.empty());
+    EXPECT_TRUE(e2.empty());
+    EXPECT_EQ(e2.size(), 0);
+    EXPECT_EQ(e2.begin() + 0, e2.end());
+
+    std::list<int> const empty_list;
+    auto const e3 = bsi::make_cartesian_product_view(xs, empty_list);
+    EXPECT_EQ(e3.begin(), e3.end());
+
+    auto const one = bsi::make_cartesian_product_view(xs);
+    EXPECT_EQ(one.size(), 2);
+    EXPECT_EQ(std::get<0>(one[1]), 2);
+}
+
+TEST(cartesian_product_view, parallel_grid)
+{
+    // A parameter grid, flattened and split across threads.
+    std::vector<int> const as = {1, 2, 3, 4, 5, 6, 7};
+    std::vector<int> const bs = {10, 20, 30};
+    std::vector<int> cs(500);
+    for (int i = 0; i < 500; ++i) {
+        cs[i] = i;
+    }
+    auto const grid = bsi::make_cartesian_product_view(as, bs, cs);
+
+    std::atomic<long long> total{0};
+    bsi::parallel_for_each(
+        grid.begin(),
+        grid.end(),
+        [&](std::tuple<int const &, int const &, int const &> p) {
+            total += std::get<0>(p) * std::get<1>(p) + std::get<2>(p);
+        },
+        100);
+
+    long long expected = 0;
+    for (int a : as) {
+        for (int b : bs) {
+            for (int c : cs) {
+                expected += a * b + c;
+            }
+        }
+    }
+    EXPECT_EQ(total, expected);
+}
@@ -0,0 +1,140 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#define BOOST_STL_INTERFACES_CHECKED_ITERATORS
+#include <boost/stl_interfaces/static_vector.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <numeric>
+#include <string>
+#include <vector>
+
+
+namespace bsi = boost::stl_interfaces;
+
+using vec_type = bsi::static_vector<int, 16>;
+
+static_assert(
+    std::is_same<vec_type::iterator, bsi::checked_iterator<int *>>::value, "");
+static_assert(
+    std::is_same<
+        vec_type::const_iterator,
+        bsi::checked_iterator<int const *>>::value,
+    "");
+static_assert(
+    std::is_convertible<vec_type::iterator, vec_type::const_iterator>::value,
+    "");
+static_assert(
+    !std::is_convertible<vec_type::const_iterator, vec_type::iterator>::value,
+    "");
+
+BOOST_STL_INTERFACES_STATIC_ASSERT_CONCEPT(
+    vec_type::iterator, std::contiguous_iterator)
+BOOST_STL_INTERFACES_STATIC_ASSERT_ITERATOR_TRAITS(
+    vec_type::iterator,
+    std::random_access_iterator_tag,
+    bsi::contiguous_iterator_tag,
+    int,
+    int &,
+    int *,
+    std::ptrdiff_t)
+
+
+TEST(checked_iterator, valid_use)
+{
+    vec_type v = {4, 2, 0, 3, 1};
+    std::sort(v.begin(), v.end());
+    EXPECT_EQ(v, (vec_type{0, 1, 2, 3, 4}));
+    EXPECT_EQ(std::accumulate(v.cbegin(), v.cend(), 0), 10);
+    EXPECT_EQ(*std::lower_bound(v.begin(), v.end(), 3), 3);
+    EXPECT_EQ(v.data(), bsi::to_address(v.begin()));
+    EXPECT_EQ(v.end() - v.begin(), 5);
+    EXPECT_EQ(v.rbegin()[1], 3);
+
+    vec_type::const_iterator const cit = v.begin() + 2;
+    EXPECT_EQ(cit, v.begin() + 2);
+    EXPECT_TRUE(v.begin() < cit);
+    EXPECT_EQ(cit - v.begin(), 2);
+
+    // Appending leaves iterators valid, and the old end now refers to the
+    // new element.
+    auto const it = v.begin() + 1;
+    auto const old_end = v.end();
+    v.push_back(5);
+    EXPECT_EQ(*it, 1);
+    EXPECT_EQ(*old_end, 5);
+
+    // So does erasing from the end, for the elements that are left.
+    v.pop_back();
+    v.erase(v.end() - 1, v.end());
+    v.resize(3);
+    EXPECT_EQ(*it, 1);
+    EXPECT_EQ(it[1], 2);
+
+    auto pos = v.insert(v.begin() + 1, 7);
+    EXPECT_EQ(*pos, 7);
+    pos = v.erase(pos);
+    EXPECT_EQ(*pos, 1);
+    v.assign({1, 2});
+    EXPECT_EQ(v, (vec_type{1, 2}));
+    v.clear();
+    EXPECT_EQ(v.begin(), v.end());
+    EXPECT_EQ(v.data(), bsi::to_address(v.end()));
+
+    EXPECT_EQ(vec_type::iterator(), vec_type::iterator());
+
+    bsi::static_vector<std::string, 4> strings = {"a", "b", "c"};
+    strings.erase(strings.begin());
+    strings.emplace(strings.begin(), 1, 'd');
+    EXPECT_EQ(strings.begin()->size(), 1u);
+    EXPECT_EQ(strings[0], "d");
+    EXPECT_EQ(strings[2], "c");
+}
+
+TEST(checked_iterator_death, out_of_range)
+{
+    vec_type v = {0, 1, 2};
+    EXPECT_DEATH(*v.end(), "dereferenced");
+    EXPECT_DEATH(v.end() + 1, "moved");
+    EXPECT_DEATH(v.begin() - 1, "moved");
+    EXPECT_DEATH(vec_type::iterator() + 1, "moved");
+
+    auto const last = v.end() - 1;
+    v.pop_back();
+    EXPECT_DEATH(*last, "dereferenced");
+}
+
+TEST(checked_iterator_death, invalidated)
+{
+    vec_type v = {0, 1, 2};
+
+    auto it = v.begin();
+    v.insert(v.begin(), 3);
+    EXPECT_DEATH(*it, "dereferenced");
+    EXPECT_DEATH(++it, "moved");
+    EXPECT_DEATH((void)(it == v.begin()), "compared");
+
+    it = v.begin();
+    v.erase(v.begin());
+    EXPECT_DEATH(*it, "dereferenced");
+
+    it = v.begin();
+    v.clear();
+    v.push_back(4);
+    EXPECT_DEATH(*it, "dereferenced");
+
+    it = v.begin();
+    v.assign(2, 5);
+    EXPECT_DEATH(*it, "dereferenced");
+
+    it = v.begin();
+    v = vec_type{6};
+    EXPECT_DEATH(*it, "dereferenced");
+
+    vec_type w = {0, 1, 2};
+    EXPECT_DEATH((void)(v.begin() == w.begin()), "different containers");
+}
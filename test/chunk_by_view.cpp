@@ -0,0 +1,150 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/chunk_by_view.hpp>
+
+#include <gtest/gtest.h>
+
+#include <list>
+#include <string>
+#include <vector>
+
+
+namespace bsi = boost::stl_interfaces;
+
+using ptr_chunk_by_iter = bsi::chunk_by_iterator<int *, std::equal_to<>>;
+using list_chunk_by_iter =
+    bsi::chunk_by_iterator<std::list<int>::iterator, std::less<>>;
+
+static_assert(
+    std::is_same<
+        ptr_chunk_by_iter::value_type,
+        bsi::chunk_range<int *, bsi::contiguous>>::value,
+    "");
+static_assert(
+    std::is_same<
+        list_chunk_by_iter::value_type,
+        bsi::chunk_range<std::list<int>::iterator>>::value,
+    "");
+static_assert(
+    std::is_same<
+        ptr_chunk_by_iter::iterator_category,
+        std::forward_iterator_tag>::value,
+    "");
+
+static_assert(
+    bsi::v1_dtl::chunk_by_simd<int *, std::equal_to<>>::value, "");
+static_assert(
+    bsi::v1_dtl::chunk_by_simd<double const *, std::equal_to<double>>::value,
+    "");
+static_assert(!bsi::v1_dtl::chunk_by_simd<int *, std::less<>>::value, "");
+static_assert(
+    !bsi::v1_dtl::chunk_by_simd<std::list<int>::iterator, std::equal_to<>>::
+        value,
+    "");
+
+template<typename View>
+std::vector<std::vector<int>> to_vectors(View const & runs)
+{
+    std::vector<std::vector<int>> retval;
+    for (auto run : runs) {
+        retval.push_back(std::vector<int>(run.begin(), run.end()));
+    }
+    return retval;
+}
+
+
+TEST(chunk_by_view, equal)
+{
+    std::vector<int> ints = {1, 1, 2, 3, 3, 3, 1};
+    int * const first = ints.data();
+
+    bsi::chunk_by_view<int *, std::equal_to<>> const runs(
+        first, first + ints.size(), std::equal_to<>{});
+    EXPECT_EQ(
+        to_vectors(runs),
+        (std::vector<std::vector<int>>{{1, 1}, {2}, {3, 3, 3}, {1}}));
+
+    // Each run is a span of the underlying elements.
+    auto it = runs.begin();
+    EXPECT_EQ((*it).data(), first);
+    ++it;
+    ++it;
+    EXPECT_EQ((*it).data(), first + 3);
+    EXPECT_EQ((*it).size(), 3);
+    EXPECT_EQ(std::distance(runs.begin(), runs.end()), 4);
+
+    // Long runs span several vector registers.
+    std::vector<int> keys(1000, 7);
+    keys.insert(keys.end(), 33, 8);
+    keys.push_back(9);
+    auto const key_runs = bsi::make_chunk_by_view(keys);
+    std::vector<int> sizes;
+    for (auto run : key_runs) {
+        sizes.push_back(int(run.size()));
+    }
+    EXPECT_EQ(sizes, (std::vector<int>{1000, 33, 1}));
+}
+
+TEST(chunk_by_view, empty_and_single)
+{
+    std::vector<int> empty;
+    EXPECT_TRUE(bsi::make_chunk_by_view(empty).empty());
+
+    std::vector<int> one = {5};
+    EXPECT_EQ(
+        to_vectors(bsi::make_chunk_by_view(one)),
+        (std::vector<std::vector<int>>{{5}}));
+
+    std::vector<double> all_same(17, 0.5);
+    auto const runs = bsi::make_chunk_by_view(all_same);
+    EXPECT_EQ(std::distance(runs.begin(), runs.end()), 1);
+    EXPECT_EQ(runs.front().size(), 17);
+}
+
+TEST(chunk_by_view, relation)
+{
+    // Ascending runs.
+    std::list<int> ints = {1, 2, 3, 2, 5, 4, 4};
+    auto const runs = bsi::make_chunk_by_view(ints, std::less<>{});
+    EXPECT_EQ(
+        to_vectors(runs),
+        (std::vector<std::vector<int>>{{1, 2, 3}, {2, 5}, {4}, {4}}));
+
+    // The relation is between adjacent elements, not with the first of the
+    // run.
+    std::vector<int> steps = {1, 2, 3, 4, 10, 11};
+    auto const close = [](int a, int b) { return b - a <= 1; };
+    EXPECT_EQ(
+        to_vectors(bsi::make_chunk_by_view(steps, close)),
+        (std::vector<std::vector<int>>{{1, 2, 3, 4}, {10, 11}}));
+}
+
+TEST(chunk_by_view, aggregation)
+{
+    // Run-length aggregation over records sorted by key.
+    struct record
+    {
+        std::string key;
+        int value;
+    };
+    std::vector<record> const records = {
+        {"a", 1}, {"a", 2}, {"b", 10}, {"c", 5}, {"c", 5}, {"c", 5}};
+    auto const same_key = [](record const & x, record const & y) {
+        return x.key == y.key;
+    };
+    std::vector<std::pair<std::string, int>> totals;
+    for (auto run : bsi::make_chunk_by_view(records, same_key)) {
+        int total = 0;
+        for (auto const & r : run) {
+            total += r.value;
+        }
+        totals.emplace_back(run.front().key, total);
+    }
+    EXPECT_EQ(
+        totals,
+        (std::vector<std::pair<std::string, int>>{
+            {"a", 3}, {"b", 10}, {"c", 15}}));
+}
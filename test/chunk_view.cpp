@@ -0,0 +1,186 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/chunk_view.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <list>
+#include <numeric>
+#include <vector>
+
+
+namespace bsi = boost::stl_interfaces;
+
+// A random access iterator that is not contiguous.
+struct ra_iter
+    : bsi::iterator_interface<ra_iter, std::random_access_iterator_tag, int>
+{
+    ra_iter() : it_(nullptr) {}
+    ra_iter(int * it) : it_(it) {}
+
+private:
+    friend bsi::access;
+    int *& base_reference() noexcept { return it_; }
+    int * base_reference() const noexcept { return it_; }
+
+    int * it_;
+};
+
+using ptr_chunk_iter = bsi::chunk_iterator<int *>;
+using ra_chunk_iter = bsi::chunk_iterator<ra_iter>;
+using list_chunk_iter = bsi::chunk_iterator<std::list<int>::iterator>;
+
+static_assert(
+    std::is_same<
+        ptr_chunk_iter::value_type,
+        bsi::chunk_range<int *, bsi::contiguous>>::value,
+    "");
+static_assert(
+    std::is_same<ra_chunk_iter::value_type, bsi::chunk_range<ra_iter>>::value,
+    "");
+static_assert(
+    std::is_same<
+        list_chunk_iter::value_type,
+        bsi::chunk_range<std::list<int>::iterator>>::value,
+    "");
+
+static_assert(
+    std::is_same<
+        ptr_chunk_iter::iterator_category,
+        std::random_access_iterator_tag>::value,
+    "");
+static_assert(
+    std::is_same<
+        list_chunk_iter::iterator_category,
+        std::forward_iterator_tag>::value,
+    "");
+
+template<typename ChunkView>
+std::vector<std::vector<int>> to_vectors(ChunkView const & chunks)
+{
+    std::vector<std::vector<int>> retval;
+    for (auto chunk : chunks) {
+        retval.push_back(std::vector<int>(chunk.begin(), chunk.end()));
+    }
+    return retval;
+}
+
+
+TEST(chunk_view, contiguous)
+{
+    std::vector<int> ints(7);
+    std::iota(ints.begin(), ints.end(), 0);
+
+    bsi::chunk_view<int *> const chunks(ints.data(), ints.data() + 7, 3);
+    EXPECT_EQ(chunks.chunk_size(), 3);
+    EXPECT_EQ(chunks.size(), 3);
+    EXPECT_EQ(
+        to_vectors(chunks),
+        (std::vector<std::vector<int>>{{0, 1, 2}, {3, 4, 5}, {6}}));
+
+    auto const first = *chunks.begin();
+    EXPECT_EQ(first.data(), ints.data());
+    EXPECT_EQ(first.size(), 3);
+    EXPECT_EQ(chunks[2].size(), 1);
+    EXPECT_EQ(chunks[2].front(), 6);
+    EXPECT_EQ(chunks.back().data(), ints.data() + 6);
+}
+
+TEST(chunk_view, random_access)
+{
+    {
+        // std::vector<int>::iterator is not known to be contiguous in this
+        // language mode, but is still random access.
+        std::vector<int> ints = {0, 1, 2, 3, 4};
+        auto const chunks = bsi::make_chunk_view(ints, 2);
+        EXPECT_EQ(chunks.size(), 3);
+        EXPECT_EQ(
+            to_vectors(chunks),
+            (std::vector<std::vector<int>>{{0, 1}, {2, 3}, {4}}));
+        EXPECT_EQ(chunks[1].front(), 2);
+    }
+
+    std::vector<int> ints(6);
+    std::iota(ints.begin(), ints.end(), 0);
+    ra_iter const first(ints.data());
+    ra_iter const last(ints.data() + ints.size());
+
+    {
+        bsi::chunk_view<ra_iter> const chunks(first, last, 2);
+        EXPECT_EQ(chunks.size(), 3);
+        EXPECT_EQ(
+            to_vectors(chunks),
+            (std::vector<std::vector<int>>{{0, 1}, {2, 3}, {4, 5}}));
+    }
+    {
+        bsi::chunk_view<ra_iter> const chunks(first, last, 4);
+        auto it = chunks.end();
+        --it;
+        EXPECT_EQ((*it).size(), 2);
+        EXPECT_EQ((*it).front(), 4);
+        --it;
+        EXPECT_EQ(it, chunks.begin());
+        EXPECT_EQ(chunks.end() - chunks.begin(), 2);
+        EXPECT_EQ(chunks.begin() + 2, chunks.end());
+        EXPECT_EQ(chunks.end() - 2, chunks.begin());
+    }
+    {
+        bsi::chunk_view<ra_iter> const chunks(first, last, 10);
+        EXPECT_EQ(chunks.size(), 1);
+        EXPECT_EQ(chunks.front().size(), 6);
+    }
+    {
+        bsi::chunk_view<ra_iter> const chunks(first, first, 3);
+        EXPECT_TRUE(chunks.empty());
+        EXPECT_EQ(chunks.size(), 0);
+    }
+}
+
+TEST(chunk_view, forward)
+{
+    std::list<int> ints = {0, 1, 2, 3, 4};
+
+    {
+        auto const chunks = bsi::make_chunk_view(ints, 2);
+        EXPECT_EQ(
+            to_vectors(chunks),
+            (std::vector<std::vector<int>>{{0, 1}, {2, 3}, {4}}));
+        EXPECT_EQ(std::distance(chunks.begin(), chunks.end()), 3);
+        EXPECT_EQ(*chunks.front().begin(), 0);
+    }
+    {
+        auto const chunks = bsi::make_chunk_view(ints, 5);
+        EXPECT_EQ(
+            to_vectors(chunks),
+            (std::vector<std::vector<int>>{{0, 1, 2, 3, 4}}));
+    }
+    {
+        std::list<int> empty;
+        auto const chunks = bsi::make_chunk_view(empty, 5);
+        EXPECT_TRUE(chunks.empty());
+    }
+}
+
+TEST(chunk_view, algorithms)
+{
+    std::vector<int> ints(100);
+    std::iota(ints.begin(), ints.end(), 0);
+    bsi::chunk_view<int *> const chunks(
+        ints.data(), ints.data() + ints.size(), 16);
+
+    std::vector<int> sums;
+    std::transform(
+        chunks.begin(),
+        chunks.end(),
+        std::back_inserter(sums),
+        [](bsi::chunk_range<int *, bsi::contiguous> chunk) {
+            return std::accumulate(chunk.begin(), chunk.end(), 0);
+        });
+    EXPECT_EQ(sums.size(), 7u);
+    EXPECT_EQ(std::accumulate(sums.begin(), sums.end(), 0), 4950);
+    EXPECT_EQ(sums.back(), 96 + 97 + 98 + 99);
+}
@@ -0,0 +1,278 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/stl_interfaces/circular_buffer.hpp>
+
+#include <gtest/gtest.h>
+
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+using boost::stl_interfaces::circular_buffer;
+
+
+// Instantiate all the members we can.
+template struct circular_buffer<int>;
+template struct circular_buffer<int, 16>;
+template struct circular_buffer<std::string>;
+template struct circular_buffer<std::string, 4>;
+
+using growing = circular_buffer<int>;
+using fixed = circular_buffer<int, 8>;
+
+static_assert(
+    std::is_same<
+        std::iterator_traits<growing::iterator>::iterator_category,
+        std::random_access_iterator_tag>::value,
+    "");
+static_assert(std::is_nothrow_move_constructible<growing>::value, "");
+
+template<typename Buffer>
+std::vector<typename Buffer::value_type> to_vector(Buffer const & b)
+{
+    return std::vector<typename Buffer::value_type>(b.begin(), b.end());
+}
+
+// Moves the front of the empty buffer b to the slot before the last one, so
+// that elements pushed onto it afterward wrap around the end of the slots.
+template<typename Buffer>
+void wrap(Buffer & b)
+{
+    assert(b.empty());
+    auto const n = int(b.capacity()) - 2;
+    for (int i = 0; i < n; ++i) {
+        b.push_back(0);
+        b.pop_front();
+    }
+}
+
+
+TEST(circular_buf, default_ctor)
+{
+    growing g;
+    EXPECT_TRUE(g.empty());
+    EXPECT_EQ(g.size(), 0u);
+    EXPECT_EQ(g.capacity(), 0u);
+    EXPECT_EQ(g.begin(), g.end());
+    EXPECT_EQ(g.array_one().second, 0u);
+    EXPECT_EQ(g.array_two().second, 0u);
+
+    fixed f;
+    EXPECT_TRUE(f.empty());
+    EXPECT_EQ(f.capacity(), 8u);
+    EXPECT_EQ(f.max_size(), 8u);
+    EXPECT_EQ(f, f);
+}
+
+TEST(circular_buf, push_pop_both_ends)
+{
+    fixed f;
+    f.push_back(2);
+    f.push_front(1);
+    f.push_back(3);
+    f.push_front(0);
+    EXPECT_EQ(to_vector(f), (std::vector<int>{0, 1, 2, 3}));
+    EXPECT_EQ(f.front(), 0);
+    EXPECT_EQ(f.back(), 3);
+    EXPECT_EQ(f[2], 2);
+
+    f.pop_front();
+    f.pop_back();
+    EXPECT_EQ(to_vector(f), (std::vector<int>{1, 2}));
+
+    for (int i = 3; i < 9; ++i) {
+        f.push_back(i);
+    }
+    EXPECT_TRUE(f.full());
+    EXPECT_EQ(to_vector(f), (std::vector<int>{1, 2, 3, 4, 5, 6, 7, 8}));
+    EXPECT_EQ(
+        std::vector<int>(f.rbegin(), f.rend()),
+        (std::vector<int>{8, 7, 6, 5, 4, 3, 2, 1}));
+}
+
+TEST(circular_buf, growing)
+{
+    growing g;
+    for (int i = 0; i < 8; ++i) {
+        g.push_back(i);
+    }
+    EXPECT_EQ(g.capacity(), 8u);
+    g.push_front(-1);
+    EXPECT_EQ(g.capacity(), 16u);
+    EXPECT_EQ(g.size(), 9u);
+    EXPECT_EQ(g.front(), -1);
+    EXPECT_EQ(g.back(), 7);
+
+    // Growing while wrapped unwraps the elements.
+    growing w;
+    w.reserve(8);
+    wrap(w);
+    w.insert(w.end(), 6, 1);
+    EXPECT_EQ(w.capacity(), 8u);
+    EXPECT_NE(w.array_two().second, 0u);
+    w.push_back(2);
+    w.push_back(3);
+    w.push_back(4);
+    EXPECT_EQ(w.capacity(), 16u);
+    EXPECT_EQ(w.array_two().second, 0u);
+    EXPECT_EQ(to_vector(w), (std::vector<int>{1, 1, 1, 1, 1, 1, 2, 3, 4}));
+
+    growing r;
+    r.reserve(9);
+    EXPECT_EQ(r.capacity(), 16u);
+}
+
+TEST(circular_buf, spans)
+{
+    fixed f;
+    wrap(f);
+    f.insert(f.end(), {1, 2, 3, 4, 5, 6});
+    EXPECT_EQ(to_vector(f), (std::vector<int>{1, 2, 3, 4, 5, 6}));
+
+    auto const one = f.array_one();
+    auto const two = f.array_two();
+    EXPECT_EQ(one.second, 2u);
+    EXPECT_EQ(two.second, 4u);
+    EXPECT_EQ(one.first[0], 1);
+    EXPECT_EQ(one.first[1], 2);
+    EXPECT_EQ(two.first[0], 3);
+    EXPECT_EQ(&f.back(), two.first + 3);
+}
+
+TEST(circular_buf, read_write)
+{
+    fixed f;
+    wrap(f);
+    int const in[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    EXPECT_EQ(f.write(in, 5), 5u);
+    EXPECT_EQ(f.write(in + 5, 5), 3u);
+    EXPECT_TRUE(f.full());
+    EXPECT_EQ(to_vector(f), (std::vector<int>{1, 2, 3, 4, 5, 6, 7, 8}));
+
+    int out[10] = {};
+    EXPECT_EQ(f.read(out, 3), 3u);
+    EXPECT_EQ(out[2], 3);
+    EXPECT_EQ(f.read(out, 10), 5u);
+    EXPECT_EQ(out[0], 4);
+    EXPECT_EQ(out[4], 8);
+    EXPECT_TRUE(f.empty());
+
+    growing g;
+    EXPECT_EQ(g.write(in, 10), 10u);
+    EXPECT_EQ(g.capacity(), 16u);
+    EXPECT_EQ(g.read(out, 4), 4u);
+    EXPECT_EQ(g.write(in, 10), 10u);
+    EXPECT_EQ(g.capacity(), 16u);
+    EXPECT_EQ(g.size(), 16u);
+    EXPECT_EQ(g.front(), 5);
+    EXPECT_EQ(g.back(), 10);
+}
+
+TEST(circular_buf, emplace_insert_erase)
+{
+    for (int start = 0; start < 8; ++start) {
+        fixed f;
+        for (int i = 0; i < start; ++i) {
+            f.push_back(0);
+            f.pop_front();
+        }
+        f.insert(f.end(), {1, 2, 3, 4});
+        std::deque<int> d = {1, 2, 3, 4};
+
+        f.emplace(f.begin() + 1, 10);
+        d.emplace(d.begin() + 1, 10);
+        f.emplace(f.begin() + 4, 11);
+        d.emplace(d.begin() + 4, 11);
+        EXPECT_TRUE(std::equal(f.begin(), f.end(), d.begin(), d.end()));
+
+        int const more[] = {20, 21};
+        f.insert(f.begin() + 2, std::begin(more), std::end(more));
+        d.insert(d.begin() + 2, std::begin(more), std::end(more));
+        EXPECT_TRUE(std::equal(f.begin(), f.end(), d.begin(), d.end()));
+
+        f.erase(f.begin() + 1, f.begin() + 3);
+        d.erase(d.begin() + 1, d.begin() + 3);
+        EXPECT_TRUE(std::equal(f.begin(), f.end(), d.begin(), d.end()));
+        f.erase(f.end() - 3, f.end() - 1);
+        d.erase(d.end() - 3, d.end() - 1);
+        EXPECT_TRUE(std::equal(f.begin(), f.end(), d.begin(), d.end()));
+    }
+}
+
+TEST(circular_buf, copy_move_swap)
+{
+    growing g = {1, 2, 3};
+    growing g2 = g;
+    EXPECT_EQ(g2, g);
+    growing g3 = std::move(g2);
+    EXPECT_TRUE(g2.empty());
+    EXPECT_EQ(g3, g);
+    g2 = {4, 5};
+    swap(g2, g3);
+    EXPECT_EQ(g2, g);
+    EXPECT_EQ(g3, (growing{4, 5}));
+
+    fixed f;
+    wrap(f);
+    f.insert(f.end(), {1, 2, 3, 4});
+    fixed f2 = f;
+    EXPECT_EQ(f2, f);
+    fixed f3 = std::move(f2);
+    EXPECT_TRUE(f2.empty());
+    EXPECT_EQ(f3, f);
+    f2 = {9};
+    f2.swap(f3);
+    EXPECT_EQ(f2, f);
+    EXPECT_EQ(f3, (fixed{9}));
+}
+
+TEST(circular_buf, non_trivial_elements)
+{
+    using string_buf = circular_buffer<std::string, 4>;
+    string_buf s;
+    s.push_back(std::string(40, 'a'));
+    s.push_back("b");
+    s.pop_front();
+    s.push_back("c");
+    s.push_back("d");
+    s.emplace_back(s.front()); // Aliases an element.
+    EXPECT_TRUE(s.full());
+    EXPECT_EQ(to_vector(s), (std::vector<std::string>{"b", "c", "d", "b"}));
+    s.erase(s.begin() + 1);
+    s.insert(s.begin(), std::string(40, 'x'));
+    EXPECT_EQ(
+        to_vector(s),
+        (std::vector<std::string>{std::string(40, 'x'), "b", "d", "b"}));
+
+    circular_buffer<std::unique_ptr<int>> p;
+    for (int i = 0; i < 20; ++i) {
+        p.emplace_front(new int(i));
+    }
+    EXPECT_EQ(*p.front(), 19);
+    EXPECT_EQ(*p.back(), 0);
+    auto p2 = std::move(p);
+    EXPECT_EQ(p2.size(), 20u);
+}
+
+TEST(circular_buf, backward_scans)
+{
+    fixed b;
+    wrap(b);
+    for (int i = 0; i < 6; ++i) {
+        b.push_back(i % 3);
+    }
+    EXPECT_EQ(b.find_last(1) - b.begin(), 4);
+    EXPECT_EQ(b.find_last(3), b.end());
+    auto const zero = [](int x) { return x == 0; };
+    EXPECT_EQ(b.rfind_if(zero) - b.begin(), 3);
+
+    std::vector<int> reversed(6);
+    b.copy_reversed_to(reversed.begin());
+    EXPECT_EQ(reversed, std::vector<int>({2, 1, 0, 2, 1, 0}));
+}
@@ -0,0 +1,92 @@
+# Usage:
+#
+#     cmake -DCXX=<compiler> -DCXX_STD=<n> -DSOURCE=<file.cpp> -DOUTPUT=<file.s>
+#           -DLIB_INCLUDE=<dir> -DBOOST_INCLUDE=<dir> -P compare_codegen.cmake
+#
+# Compiles SOURCE to assembly, and then checks every pair of functions named
+# in a line of SOURCE of the form
+#
+#     // CODEGEN_EQUIVALENT(function, baseline_function[, slack])
+#
+# by counting the instructions emitted for each.  The check fails if
+# function has more than slack (default 0) instructions beyond the number in
+# baseline_function.  Each function so named must be extern "C", so that its
+# assembly label is its unmangled name.
+
+foreach(var CXX CXX_STD SOURCE OUTPUT LIB_INCLUDE BOOST_INCLUDE)
+    if (NOT DEFINED ${var})
+        message(FATAL_ERROR "compare_codegen.cmake requires -D${var}=...")
+    endif ()
+endforeach()
+
+execute_process(
+    COMMAND ${CXX} -std=c++${CXX_STD} -O2 -DNDEBUG -S
+        -fno-asynchronous-unwind-tables
+        -I${LIB_INCLUDE} -I${BOOST_INCLUDE}
+        -o ${OUTPUT} ${SOURCE}
+    RESULT_VARIABLE compile_result
+    ERROR_VARIABLE compile_errors
+)
+if (NOT compile_result EQUAL 0)
+    message(FATAL_ERROR "Compiling ${SOURCE} failed:\n${compile_errors}")
+endif ()
+
+# Sets ${out_var} to the number of instructions in the body of function
+# name within the assembly lines in ${asm_lines}.
+function(count_instructions name out_var)
+    set(in_function false)
+    set(count 0)
+    foreach(line IN LISTS asm_lines)
+        if (line STREQUAL "${name}:")
+            set(in_function true)
+        elseif (in_function)
+            if (line MATCHES "^\t\\.size\t${name}," OR
+                line MATCHES "^\t\\.cfi_endproc")
+                break()
+            endif ()
+            if (line MATCHES "^\t[a-z]")
+                math(EXPR count "${count} + 1")
+            endif ()
+        endif ()
+    endforeach()
+    if (NOT in_function)
+        message(FATAL_ERROR "Function ${name} not found in ${OUTPUT}.")
+    endif ()
+    set(${out_var} ${count} PARENT_SCOPE)
+endfunction()
+
+file(STRINGS ${OUTPUT} asm_lines)
+file(STRINGS ${SOURCE} checks REGEX "// CODEGEN_EQUIVALENT\\(")
+
+set(failures 0)
+foreach(check IN LISTS checks)
+    string(REGEX REPLACE
+        ".*CODEGEN_EQUIVALENT\\(([^)]*)\\).*" "\\1" args "${check}")
+    string(REPLACE "," ";" args "${args}")
+    string(REPLACE " " "" args "${args}")
+    list(GET args 0 function)
+    list(GET args 1 baseline)
+    list(LENGTH args num_args)
+    set(slack 0)
+    if (num_args GREATER 2)
+        list(GET args 2 slack)
+    endif ()
+
+    count_instructions(${function} function_count)
+    count_instructions(${baseline} baseline_count)
+    math(EXPR limit "${baseline_count} + ${slack}")
+    if (function_count GREATER limit)
+        message(SEND_ERROR
+            "${function}: ${function_count} instructions; "
+            "${baseline}: ${baseline_count} instructions (slack ${slack})")
+        math(EXPR failures "${failures} + 1")
+    else ()
+        message(STATUS
+            "${function}: ${function_count} instructions; "
+            "${baseline}: ${baseline_count} instructions")
+    endif ()
+endforeach()
+
+if (failures)
+    message(FATAL_ERROR "${failures} codegen check(s) failed; see ${OUTPUT}.")
+endif ()
@@ -0,0 +1,50 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#define BOOST_STL_INTERFACES_DISABLE_CMCSTL2
+#define BOOST_STL_INTERFACES_DISABLE_ITERATOR_COUNTING
+#include <boost/stl_interfaces/counting_iterator_adaptor.hpp>
+
+#include <algorithm>
+#include <numeric>
+
+
+// With counting compiled out, a counting_iterator_adaptor must cost nothing
+// over the iterator it adapts.
+
+extern "C" {
+
+int sum_ptr(int const * first, int const * last)
+{
+    return std::accumulate(first, last, 0);
+}
+
+// CODEGEN_EQUIVALENT(sum_counting, sum_ptr)
+int sum_counting(int const * first, int const * last)
+{
+    namespace bsi = boost::stl_interfaces;
+    return std::accumulate(
+        bsi::make_counting_iterator(first),
+        bsi::make_counting_iterator(last),
+        0);
+}
+
+int const * find_ptr(int const * first, int const * last, int x)
+{
+    return std::find(first, last, x);
+}
+
+// CODEGEN_EQUIVALENT(find_counting, find_ptr)
+int const * find_counting(int const * first, int const * last, int x)
+{
+    namespace bsi = boost::stl_interfaces;
+    return std::find(
+               bsi::make_counting_iterator(first),
+               bsi::make_counting_iterator(last),
+               x)
+        .base();
+}
+
+}
@@ -0,0 +1,112 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#define BOOST_STL_INTERFACES_DISABLE_CMCSTL2
+#include <boost/stl_interfaces/iterator_interface.hpp>
+
+#include <algorithm>
+#include <numeric>
+
+
+// Summing through a filtering adaptor; the library version is
+// filtered_int_iterator from example/filtered_int_iterator.cpp, and the
+// baseline is the same iterator written without the library.
+
+struct is_even
+{
+    bool operator()(int x) const noexcept { return (x % 2) == 0; }
+};
+
+struct filtered_int_iterator : boost::stl_interfaces::iterator_interface<
+                                   filtered_int_iterator,
+                                   std::bidirectional_iterator_tag,
+                                   int>
+{
+    filtered_int_iterator() : it_(nullptr) {}
+    filtered_int_iterator(int * it, int * last) : it_(it), last_(last)
+    {
+        it_ = std::find_if(it_, last_, is_even{});
+    }
+
+    filtered_int_iterator & operator++()
+    {
+        it_ = std::find_if(std::next(it_), last_, is_even{});
+        return *this;
+    }
+
+    using base_type = boost::stl_interfaces::iterator_interface<
+        filtered_int_iterator,
+        std::bidirectional_iterator_tag,
+        int>;
+    using base_type::operator++;
+
+private:
+    friend boost::stl_interfaces::access;
+    constexpr int *& base_reference() noexcept { return it_; }
+    constexpr int * base_reference() const noexcept { return it_; }
+
+    int * it_;
+    int * last_;
+};
+
+struct hand_written_filtered_iterator
+{
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = int;
+    using difference_type = std::ptrdiff_t;
+    using pointer = int *;
+    using reference = int &;
+
+    hand_written_filtered_iterator() : it_(nullptr) {}
+    hand_written_filtered_iterator(int * it, int * last) : it_(it), last_(last)
+    {
+        it_ = std::find_if(it_, last_, is_even{});
+    }
+
+    int & operator*() const { return *it_; }
+    hand_written_filtered_iterator & operator++()
+    {
+        it_ = std::find_if(std::next(it_), last_, is_even{});
+        return *this;
+    }
+    hand_written_filtered_iterator operator++(int)
+    {
+        auto retval = *this;
+        ++*this;
+        return retval;
+    }
+
+    friend bool operator==(
+        hand_written_filtered_iterator lhs, hand_written_filtered_iterator rhs)
+    {
+        return lhs.it_ == rhs.it_;
+    }
+    friend bool operator!=(
+        hand_written_filtered_iterator lhs, hand_written_filtered_iterator rhs)
+    {
+        return lhs.it_ != rhs.it_;
+    }
+
+private:
+    int * it_;
+    int * last_;
+};
+
+extern "C" {
+
+int filtered_sum_ptr(int * f, int * l)
+{
+    hand_written_filtered_iterator first(f, l), last(l, l);
+    return std::accumulate(first, last, 0);
+}
+
+// CODEGEN_EQUIVALENT(filtered_sum, filtered_sum_ptr)
+int filtered_sum(int * f, int * l)
+{
+    filtered_int_iterator first(f, l), last(l, l);
+    return std::accumulate(first, last, 0);
+}
+
+}
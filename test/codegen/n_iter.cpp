@@ -0,0 +1,65 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#define BOOST_STL_INTERFACES_DISABLE_CMCSTL2
+#include <boost/stl_interfaces/container_interface.hpp>
+
+#include <algorithm>
+
+
+// detail::n_iter is what container_interface uses to implement insert(pos,
+// n, x) and assign(n, x) in terms of a range insert.  It must cost no more
+// than the equivalent pointer-and-count loop.
+
+extern "C" {
+
+void n_copy_ptr(int * out, int const & x, int n)
+{
+    int const * value = &x;
+    for (int i = 0; i < n; ++i) {
+        *out++ = *value;
+    }
+}
+
+// CODEGEN_EQUIVALENT(n_copy, n_copy_ptr)
+void n_copy(int * out, int const & x, int n)
+{
+    namespace detail = boost::stl_interfaces::detail;
+    std::copy(detail::make_n_iter(x, n), detail::make_n_iter_end(x, n), out);
+}
+
+void n_fill_ptr(unsigned char * out, unsigned char const & x, int n)
+{
+    unsigned char const value = x;
+    for (int i = 0; i < n; ++i) {
+        out[i] = value;
+    }
+}
+
+// n_iter_copy() must see that the value does not change, and emit the same
+// memset() as the loop above.
+// CODEGEN_EQUIVALENT(n_fill, n_fill_ptr)
+void n_fill(unsigned char * out, unsigned char const & x, int n)
+{
+    namespace detail = boost::stl_interfaces::detail;
+    detail::n_iter_copy(
+        detail::make_n_iter(x, n), detail::make_n_iter_end(x, n), out);
+}
+
+int n_index_ptr(int const & x, int n, int i)
+{
+    int const * value = &x;
+    return i < n ? *value : 0;
+}
+
+// CODEGEN_EQUIVALENT(n_index, n_index_ptr)
+int n_index(int const & x, int n, int i)
+{
+    namespace detail = boost::stl_interfaces::detail;
+    auto const first = detail::make_n_iter(x, n);
+    return i < n ? first[i] : 0;
+}
+
+}
@@ -0,0 +1,171 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#define BOOST_STL_INTERFACES_DISABLE_CMCSTL2
+#include <boost/stl_interfaces/iterator_interface.hpp>
+
+#include <cstddef>
+
+
+// Each function below that uses an iterator_interface iterator must compile
+// to no more instructions than the raw-pointer function it is paired with.
+// See compare_codegen.cmake.
+
+struct user_ops_iter : boost::stl_interfaces::iterator_interface<
+                           user_ops_iter,
+                           std::random_access_iterator_tag,
+                           int>
+{
+    user_ops_iter() noexcept {}
+    user_ops_iter(int * it) noexcept : it_(it) {}
+
+    int & operator*() const noexcept { return *it_; }
+    user_ops_iter & operator+=(std::ptrdiff_t i) noexcept
+    {
+        it_ += i;
+        return *this;
+    }
+    friend std::ptrdiff_t
+    operator-(user_ops_iter lhs, user_ops_iter rhs) noexcept
+    {
+        return lhs.it_ - rhs.it_;
+    }
+
+private:
+    int * it_;
+};
+
+struct adapted_iter : boost::stl_interfaces::iterator_interface<
+                          adapted_iter,
+                          std::random_access_iterator_tag,
+                          int>
+{
+    adapted_iter() noexcept {}
+    adapted_iter(int * it) noexcept : it_(it) {}
+
+private:
+    friend boost::stl_interfaces::access;
+    int *& base_reference() noexcept { return it_; }
+    int * base_reference() const noexcept { return it_; }
+
+    int * it_;
+};
+
+template<typename Iter>
+int sum_impl(int * f, int * l)
+{
+    int retval = 0;
+    for (Iter first(f), last(l); first != last; ++first) {
+        retval += *first;
+    }
+    return retval;
+}
+
+template<typename Iter>
+int index_sum_impl(int * f, std::ptrdiff_t n)
+{
+    Iter const first(f);
+    int retval = 0;
+    for (std::ptrdiff_t i = 0; i < n; ++i) {
+        retval += first[i];
+    }
+    return retval;
+}
+
+extern "C" {
+
+// Iteration with operator++, operator!=, and operator*.
+
+int sum_ptr(int * first, int * last)
+{
+    int retval = 0;
+    for (; first != last; ++first) {
+        retval += *first;
+    }
+    return retval;
+}
+
+// CODEGEN_EQUIVALENT(sum_user_ops, sum_ptr)
+int sum_user_ops(int * f, int * l) { return sum_impl<user_ops_iter>(f, l); }
+// CODEGEN_EQUIVALENT(sum_adapted, sum_ptr)
+int sum_adapted(int * f, int * l) { return sum_impl<adapted_iter>(f, l); }
+
+// Indexing with operator[].
+
+int index_sum_ptr(int * first, std::ptrdiff_t n)
+{
+    int retval = 0;
+    for (std::ptrdiff_t i = 0; i < n; ++i) {
+        retval += first[i];
+    }
+    return retval;
+}
+
+// CODEGEN_EQUIVALENT(index_sum_user_ops, index_sum_ptr)
+int index_sum_user_ops(int * f, std::ptrdiff_t n)
+{
+    return index_sum_impl<user_ops_iter>(f, n);
+}
+// CODEGEN_EQUIVALENT(index_sum_adapted, index_sum_ptr)
+int index_sum_adapted(int * f, std::ptrdiff_t n)
+{
+    return index_sum_impl<adapted_iter>(f, n);
+}
+
+// operator+() and operator-().
+
+int * advance_ptr(int * it, std::ptrdiff_t n) { return it + n; }
+// CODEGEN_EQUIVALENT(advance_user_ops, advance_ptr)
+int * advance_user_ops(int * it, std::ptrdiff_t n)
+{
+    return &*(user_ops_iter(it) + n);
+}
+// CODEGEN_EQUIVALENT(advance_adapted, advance_ptr)
+int * advance_adapted(int * it, std::ptrdiff_t n)
+{
+    return &*(adapted_iter(it) + n);
+}
+
+std::ptrdiff_t distance_ptr(int * f, int * l) { return l - f; }
+// CODEGEN_EQUIVALENT(distance_user_ops, distance_ptr)
+std::ptrdiff_t distance_user_ops(int * f, int * l)
+{
+    return user_ops_iter(l) - user_ops_iter(f);
+}
+// CODEGEN_EQUIVALENT(distance_adapted, distance_ptr)
+std::ptrdiff_t distance_adapted(int * f, int * l)
+{
+    return adapted_iter(l) - adapted_iter(f);
+}
+
+// Comparisons.  iterator_interface implements operator<() as (lhs - rhs) <
+// 0, which compiles to a subtract and a shift instead of a compare and a
+// setcc; that is the one extra instruction allowed below.
+
+bool less_ptr(int * lhs, int * rhs) { return lhs < rhs; }
+// CODEGEN_EQUIVALENT(less_user_ops, less_ptr, 1)
+bool less_user_ops(int * lhs, int * rhs)
+{
+    return user_ops_iter(lhs) < user_ops_iter(rhs);
+}
+// CODEGEN_EQUIVALENT(less_adapted, less_ptr, 1)
+bool less_adapted(int * lhs, int * rhs)
+{
+    return adapted_iter(lhs) < adapted_iter(rhs);
+}
+
+bool equal_ptr(int * lhs, int * rhs) { return lhs == rhs; }
+// CODEGEN_EQUIVALENT(equal_user_ops, equal_ptr)
+bool equal_user_ops(int * lhs, int * rhs)
+{
+    return user_ops_iter(lhs) == user_ops_iter(rhs);
+}
+// CODEGEN_EQUIVALENT(equal_adapted, equal_ptr)
+bool equal_adapted(int * lhs, int * rhs)
+{
+    return adapted_iter(lhs) == adapted_iter(rhs);
+}
+
+}
@@ -0,0 +1,133 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/stl_interfaces/column_table.hpp>
+
+#include <gtest/gtest.h>
+
+#include <numeric>
+#include <string>
+#include <vector>
+
+
+using boost::stl_interfaces::column_table;
+using boost::stl_interfaces::soa_iterator;
+
+
+// Instantiate all the members we can.
+template struct column_table<std::tuple<int, double>>;
+
+using table_t = column_table<std::tuple<int, std::string, double>>;
+using row_t = table_t::value_type;
+
+static_assert(
+    std::is_same<
+        std::iterator_traits<table_t::iterator>::iterator_category,
+        std::random_access_iterator_tag>::value,
+    "");
+static_assert(
+    std::is_same<
+        decltype(std::declval<table_t &>().column<2>().begin()),
+        double *>::value,
+    "");
+static_assert(
+    std::is_same<
+        decltype(std::declval<table_t const &>().column<2>().begin()),
+        double const *>::value,
+    "");
+static_assert(
+    std::is_same<
+        decltype(std::declval<table_t &>().select<2, 0>())::iterator,
+        soa_iterator<double, int>>::value,
+    "");
+static_assert(
+    boost::stl_interfaces::is_trivially_relocatable<table_t>::value, "");
+static_assert(table_t::columns() == 3u, "");
+
+
+TEST(column_table, empty)
+{
+    table_t t;
+    EXPECT_TRUE(t.empty());
+    EXPECT_TRUE(t.column<0>().empty());
+    EXPECT_EQ(t.column<1>().size(), 0u);
+    auto const p = t.select<0, 2>();
+    EXPECT_EQ(p.begin(), p.end());
+}
+
+TEST(column_table, columns)
+{
+    table_t t = {{1, "one", 1.5}, {2, "two", 2.5}, {3, "three", 3.5}};
+    auto const ids = t.column<0>();
+    EXPECT_EQ(ids.size(), 3u);
+    EXPECT_EQ(ids.data(), t.data<0>());
+    EXPECT_EQ(ids[1], 2);
+    EXPECT_EQ(ids.back(), 3);
+    EXPECT_EQ(
+        std::vector<int>(ids.begin(), ids.end()), (std::vector<int>{1, 2, 3}));
+
+    t.column<2>()[0] = 10.0;
+    EXPECT_EQ(t.front(), row_t(1, "one", 10.0));
+
+    table_t const & ct = t;
+    EXPECT_EQ(ct.column<1>().front(), "one");
+    EXPECT_EQ(
+        std::accumulate(ct.column<2>().begin(), ct.column<2>().end(), 0.0),
+        16.0);
+}
+
+TEST(column_table, select)
+{
+    table_t t;
+    for (int i = 0; i < 100; ++i) {
+        t.emplace_back(i, std::to_string(i), i * 0.5);
+    }
+
+    // The columns come in the order asked for, and may repeat.
+    auto const p = t.select<2, 0>();
+    EXPECT_EQ(p.size(), 100u);
+    EXPECT_EQ(p[10], std::make_tuple(5.0, 10));
+    double sum = 0.0;
+    for (auto row : p) {
+        sum += std::get<0>(row) * std::get<1>(row);
+    }
+    EXPECT_EQ(sum, 0.5 * 328350);
+
+    for (auto row : t.select<0, 0>()) {
+        EXPECT_EQ(std::get<0>(row), std::get<1>(row));
+    }
+
+    // Writes through a projection, and sorts by one column, moving only
+    // that column.
+    for (auto row : t.select<0>()) {
+        std::get<0>(row) = -std::get<0>(row);
+    }
+    EXPECT_EQ(std::get<0>(t[7]), -7);
+    auto ids = t.select<0>();
+    std::sort(ids.begin(), ids.end());
+    EXPECT_EQ(std::get<0>(t[0]), -99);
+    EXPECT_EQ(std::get<1>(t[0]), "0");
+
+    table_t const & ct = t;
+    auto const cp = ct.select<1>();
+    EXPECT_EQ(std::get<0>(cp.back()), "99");
+}
+
+TEST(column_table, rows)
+{
+    table_t t = {{3, "c", 0.3}, {1, "a", 0.1}, {2, "b", 0.2}};
+    std::sort(t.begin(), t.end());
+    EXPECT_EQ(
+        t, (table_t{{1, "a", 0.1}, {2, "b", 0.2}, {3, "c", 0.3}}));
+    t.erase(t.begin() + 1);
+    EXPECT_EQ(t.size(), 2u);
+    EXPECT_EQ(t.column<1>().back(), "c");
+
+    table_t copy = t;
+    table_t moved = std::move(copy);
+    EXPECT_EQ(moved, t);
+    EXPECT_TRUE(copy.empty());
+}
@@ -0,0 +1,145 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/concat_view.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <forward_list>
+#include <numeric>
+#include <vector>
+
+
+namespace bsi = boost::stl_interfaces;
+
+using vec_iter = std::vector<int>::iterator;
+
+BOOST_STL_INTERFACES_STATIC_ASSERT_CONCEPT(
+    bsi::concat_iterator<vec_iter>, std::bidirectional_iterator)
+BOOST_STL_INTERFACES_STATIC_ASSERT_ITERATOR_TRAITS(
+    bsi::concat_iterator<vec_iter>,
+    std::bidirectional_iterator_tag,
+    std::bidirectional_iterator_tag,
+    int,
+    int &,
+    int *,
+    std::ptrdiff_t)
+BOOST_STL_INTERFACES_STATIC_ASSERT_CONCEPT(
+    bsi::concat_iterator<std::forward_list<int>::iterator>,
+    std::forward_iterator)
+
+static_assert(
+    bsi::is_segmented_iterator<bsi::concat_iterator<int *>>::value, "");
+
+TEST(concat_view, basic)
+{
+    std::vector<int> live = {1, 2};
+    std::vector<int> spilled1 = {3, 4, 5};
+    std::vector<int> spilled2;
+    std::vector<int> spilled3 = {6};
+    auto const v = bsi::make_concat_view(live, spilled1, spilled2, spilled3);
+
+    std::vector<int> const expected = {1, 2, 3, 4, 5, 6};
+    EXPECT_TRUE(
+        std::equal(v.begin(), v.end(), expected.begin(), expected.end()));
+    EXPECT_EQ(std::distance(v.begin(), v.end()), 6);
+    EXPECT_FALSE(v.empty());
+
+    std::vector<int> reversed(v.begin(), v.end());
+    std::reverse(reversed.begin(), reversed.end());
+    EXPECT_TRUE(std::equal(
+        std::make_reverse_iterator(v.end()),
+        std::make_reverse_iterator(v.begin()),
+        reversed.begin(),
+        reversed.end()));
+
+    auto it = v.begin();
+    std::advance(it, 2);
+    EXPECT_EQ(*it, 3);
+    EXPECT_EQ(&*it, spilled1.data());
+    --it;
+    EXPECT_EQ(*it, 2);
+    *it = 20;
+    EXPECT_EQ(live[1], 20);
+    it++;
+    it++;
+    it++;
+    EXPECT_EQ(*it, 5);
+    ++it;
+    EXPECT_EQ(*it, 6);
+    --it;
+    EXPECT_EQ(*it, 5);
+}
+
+TEST(concat_view, empty_ranges)
+{
+    std::vector<int> a;
+    std::vector<int> b;
+    std::vector<int> c = {1};
+    auto const empty = bsi::make_concat_view(a, b);
+    EXPECT_TRUE(empty.begin() == empty.end());
+    EXPECT_TRUE(empty.empty());
+
+    auto const v = bsi::make_concat_view(a, c, b);
+    EXPECT_EQ(*v.begin(), 1);
+    EXPECT_EQ(std::next(v.begin()), v.end());
+    EXPECT_EQ(*std::prev(v.end()), 1);
+
+    auto const one = bsi::make_concat_view(c);
+    EXPECT_EQ(std::distance(one.begin(), one.end()), 1);
+}
+
+TEST(concat_view, forward)
+{
+    std::forward_list<int> a = {1, 2};
+    std::forward_list<int> b = {3};
+    auto const v = bsi::make_concat_view(a, b);
+    EXPECT_EQ(std::accumulate(v.begin(), v.end(), 0), 6);
+    EXPECT_EQ(bsi::segmented_accumulate(v.begin(), v.end(), 0), 6);
+}
+
+TEST(concat_view, segmented_algorithms)
+{
+    std::vector<int> a(100);
+    std::vector<int> b;
+    std::vector<int> c(37);
+    std::iota(a.begin(), a.end(), 0);
+    std::iota(c.begin(), c.end(), 100);
+    auto const v = bsi::make_concat_view(a, b, c);
+
+    std::vector<int> out(137);
+    auto const out_last = bsi::segmented_copy(v.begin(), v.end(), out.begin());
+    EXPECT_EQ(out_last, out.end());
+    std::vector<int> expected(137);
+    std::iota(expected.begin(), expected.end(), 0);
+    EXPECT_EQ(out, expected);
+
+    EXPECT_EQ(
+        bsi::segmented_accumulate(v.begin(), v.end(), 0),
+        std::accumulate(v.begin(), v.end(), 0));
+
+    auto const found = bsi::segmented_find(v.begin(), v.end(), 120);
+    EXPECT_EQ(*found, 120);
+    EXPECT_EQ(&*found, &c[20]);
+    EXPECT_EQ(std::distance(v.begin(), found), 120);
+    EXPECT_EQ(bsi::segmented_find(v.begin(), v.end(), 1000), v.end());
+    // A match at the end of a segment composes to the start of the next.
+    EXPECT_EQ(
+        bsi::segmented_find(std::next(v.begin(), 99), v.end(), 100),
+        std::next(v.begin(), 100));
+
+    bsi::segmented_fill(std::next(v.begin(), 98), std::next(v.begin(), 102), 0);
+    EXPECT_EQ(a[97], 97);
+    EXPECT_EQ(a[98], 0);
+    EXPECT_EQ(a[99], 0);
+    EXPECT_EQ(c[0], 0);
+    EXPECT_EQ(c[1], 0);
+    EXPECT_EQ(c[2], 102);
+
+    int count = 0;
+    bsi::segmented_for_each(v.begin(), v.end(), [&](int) { ++count; });
+    EXPECT_EQ(count, 137);
+}
@@ -0,0 +1,165 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/concurrent_append_vector.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+namespace bsi = boost::stl_interfaces;
+
+TEST(concurrent_append_vector, single_thread)
+{
+    bsi::concurrent_append_vector<int> v;
+    EXPECT_TRUE(v.empty());
+    EXPECT_EQ(v.begin(), v.end());
+    EXPECT_EQ(v.capacity(), 0u);
+
+    std::vector<int *> addresses;
+    for (int i = 0; i < 1000; ++i) {
+        int & x = v.emplace_back(i);
+        EXPECT_EQ(x, i);
+        addresses.push_back(&x);
+    }
+    v.push_back(1000);
+    EXPECT_EQ(v.size(), 1001u);
+    EXPECT_EQ(v.end() - v.begin(), 1001);
+    EXPECT_GE(v.capacity(), 1001u);
+
+    // The elements never move.
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_EQ(&v[i], addresses[i]);
+        EXPECT_EQ(v[i], i);
+    }
+    EXPECT_EQ(v.front(), 0);
+    EXPECT_EQ(v.back(), 1000);
+    EXPECT_EQ(*v.rbegin(), 1000);
+    EXPECT_TRUE(std::is_sorted(v.begin(), v.end()));
+    EXPECT_EQ(*std::lower_bound(v.begin(), v.end(), 500), 500);
+
+    auto const & cv = v;
+    bsi::concurrent_append_vector<int>::const_iterator it = v.begin();
+    EXPECT_EQ(it, cv.begin());
+    EXPECT_EQ(cv.end() - it, 1001);
+}
+
+TEST(concurrent_append_vector, bucket_boundaries)
+{
+    bsi::concurrent_append_vector<std::size_t> v;
+    for (std::size_t i = 0; i < 64 + 128 + 256 + 1; ++i) {
+        v.push_back(i);
+    }
+    for (std::size_t i : {0u, 63u, 64u, 191u, 192u, 447u, 448u}) {
+        EXPECT_EQ(v[i], i);
+        EXPECT_EQ(*(v.begin() + std::ptrdiff_t(i)), i);
+    }
+    EXPECT_EQ(
+        std::accumulate(v.begin(), v.end(), std::size_t(0)),
+        448u * 449u / 2);
+}
+
+TEST(concurrent_append_vector, segmented_algorithms)
+{
+    EXPECT_TRUE(bsi::is_segmented_iterator<
+                bsi::concurrent_append_vector<long>::iterator>::value);
+    for (long n : {0L, 1L, 63L, 64L, 65L, 192L, 1000L}) {
+        bsi::concurrent_append_vector<long> v;
+        for (long i = 1; i <= n; ++i) {
+            v.push_back(i);
+        }
+        EXPECT_EQ(
+            bsi::segmented_accumulate(v.begin(), v.end(), 0L),
+            n * (n + 1) / 2);
+        if (n < 10)
+            continue;
+        EXPECT_EQ(
+            bsi::segmented_accumulate(v.begin() + 5, v.end() - 3, 0L),
+            std::accumulate(v.begin() + 5, v.end() - 3, 0L));
+        auto const it = bsi::segmented_find(v.begin(), v.end(), n - 1);
+        EXPECT_EQ(it - v.begin(), n - 2);
+        bsi::segmented_fill(v.begin(), v.end(), 2L);
+        EXPECT_EQ(std::count(v.begin(), v.end(), 2L), n);
+    }
+}
+
+TEST(concurrent_append_vector, reserve)
+{
+    bsi::concurrent_append_vector<int> v;
+    v.reserve(1000);
+    auto const capacity = v.capacity();
+    EXPECT_GE(capacity, 1000u);
+    for (int i = 0; i < 1000; ++i) {
+        v.push_back(i);
+    }
+    EXPECT_EQ(v.capacity(), capacity);
+    EXPECT_EQ(v.size(), 1000u);
+}
+
+TEST(concurrent_append_vector, move_only_elements)
+{
+    bsi::concurrent_append_vector<std::unique_ptr<std::string>> v;
+    for (int i = 0; i < 100; ++i) {
+        v.push_back(std::make_unique<std::string>(std::to_string(i)));
+    }
+    EXPECT_EQ(*v[0], "0");
+    EXPECT_EQ(*v[99], "99");
+}
+
+TEST(concurrent_append_vector, concurrent_appends)
+{
+    int const threads = 4;
+    int const per_thread = 20000;
+    bsi::concurrent_append_vector<int> v;
+    std::atomic<bool> done(false);
+
+    // A reader iterates over snapshots while the writers append; every
+    // element it sees must be complete.
+    std::thread reader([&] {
+        while (!done.load()) {
+            auto const first = v.begin();
+            auto const last = v.end();
+            for (auto it = first; it != last; ++it) {
+                ASSERT_GE(*it, 0);
+                ASSERT_LT(*it, threads * per_thread);
+            }
+        }
+    });
+
+    std::vector<std::thread> writers;
+    for (int t = 0; t < threads; ++t) {
+        writers.emplace_back([&, t] {
+            for (int i = 0; i < per_thread; ++i) {
+                v.push_back(t * per_thread + i);
+            }
+        });
+    }
+    for (auto & w : writers) {
+        w.join();
+    }
+    done = true;
+    reader.join();
+
+    ASSERT_EQ(v.size(), std::size_t(threads * per_thread));
+    std::vector<int> sorted(v.begin(), v.end());
+    std::sort(sorted.begin(), sorted.end());
+    for (int i = 0; i < threads * per_thread; ++i) {
+        ASSERT_EQ(sorted[i], i);
+    }
+
+    // Each writer's elements are in the order it appended them.
+    std::vector<int> last(threads, -1);
+    for (int x : v) {
+        EXPECT_LT(last[x / per_thread], x);
+        last[x / per_thread] = x;
+    }
+}
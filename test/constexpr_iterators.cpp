@@ -0,0 +1,125 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// The formulation of the operators for compilers whose hidden friends
+// cannot be constexpr, tested on all of them.
+#define BOOST_STL_INTERFACES_NO_HIDDEN_FRIEND_CONSTEXPR
+#include <boost/stl_interfaces/iterator_interface.hpp>
+#include <boost/stl_interfaces/reverse_iterator.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+
+namespace bsi = boost::stl_interfaces;
+
+struct ra_iter : bsi::iterator_interface<
+                     ra_iter,
+                     std::random_access_iterator_tag,
+                     int const>
+{
+    constexpr ra_iter() noexcept : p_(nullptr) {}
+    constexpr ra_iter(int const * p) noexcept : p_(p) {}
+
+    constexpr int const & operator*() const noexcept { return *p_; }
+    constexpr ra_iter & operator+=(std::ptrdiff_t n) noexcept
+    {
+        p_ += n;
+        return *this;
+    }
+    friend constexpr std::ptrdiff_t
+    operator-(ra_iter lhs, ra_iter rhs) noexcept
+    {
+        return lhs.p_ - rhs.p_;
+    }
+
+private:
+    int const * p_;
+};
+
+// An iterator over the squares, which builds a table of them at compile
+// time with the operators that used to be hidden friends.
+struct squares_iter : bsi::proxy_iterator_interface<
+                          squares_iter,
+                          std::random_access_iterator_tag,
+                          int>
+{
+    constexpr squares_iter() noexcept : i_(0) {}
+    constexpr explicit squares_iter(int i) noexcept : i_(i) {}
+
+    constexpr int operator*() const noexcept { return i_ * i_; }
+    constexpr squares_iter & operator+=(std::ptrdiff_t n) noexcept
+    {
+        i_ += int(n);
+        return *this;
+    }
+    friend constexpr std::ptrdiff_t
+    operator-(squares_iter lhs, squares_iter rhs) noexcept
+    {
+        return lhs.i_ - rhs.i_;
+    }
+
+private:
+    int i_;
+};
+
+template<std::size_t N>
+struct table
+{
+    int values[N];
+};
+
+template<std::size_t N>
+constexpr table<N> squares_table()
+{
+    table<N> retval = {};
+    auto const last = squares_iter(0) + N;
+    for (auto it = 0 + squares_iter(0); it != last; ++it) {
+        retval.values[it - squares_iter(0)] = *(last - (last - it));
+    }
+    return retval;
+}
+
+constexpr int ints[5] = {0, 1, 2, 3, 4};
+constexpr ra_iter first(ints);
+constexpr ra_iter last(ints + 5);
+
+static_assert(*(2 + first) == 2, "");
+static_assert(*(last - 2) == 3, "");
+static_assert(last - 2 - first == 3, "");
+static_assert(
+    bsi::reverse_iterator<ra_iter>(first) -
+            bsi::reverse_iterator<ra_iter>(last) ==
+        5,
+    "");
+static_assert(*(bsi::reverse_iterator<ra_iter>(last) + 1) == 3, "");
+static_assert(squares_table<8>().values[7] == 49, "");
+
+
+TEST(constexpr_iterators, runtime)
+{
+    std::vector<int> v = {3, 1, 2};
+    std::array<int, 3> a = {{0, 0, 0}};
+    std::copy(
+        bsi::make_reverse_iterator(v.end()),
+        bsi::make_reverse_iterator(v.begin()),
+        a.begin());
+    EXPECT_EQ(a, (std::array<int, 3>{{2, 1, 3}}));
+
+    auto const rfirst = bsi::make_reverse_iterator(v.end());
+    auto const rlast = bsi::make_reverse_iterator(v.begin());
+    EXPECT_EQ(rlast - rfirst, 3);
+    EXPECT_EQ(*(rlast - 1), 3);
+    EXPECT_EQ(*(1 + rfirst), 1);
+    std::sort(rfirst, rlast);
+    EXPECT_EQ(v, (std::vector<int>{3, 2, 1}));
+
+    EXPECT_EQ(std::upper_bound(first, last, 2) - first, 3);
+    EXPECT_EQ(*(3 + first), 3);
+}
@@ -0,0 +1,517 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/static_vector.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <cstdint>
+#include <cstring>
+
+
+namespace bsi = boost::stl_interfaces;
+
+// Instantiate all the members we can.
+template struct bsi::static_vector<int, 1024>;
+template struct bsi::static_vector<std::string, 16>;
+
+using int_vec = bsi::static_vector<int, 8>;
+using string_vec = bsi::static_vector<std::string, 8>;
+
+static_assert(std::is_trivially_copyable<int_vec>::value, "");
+static_assert(std::is_trivially_destructible<int_vec>::value, "");
+static_assert(!std::is_trivially_copyable<string_vec>::value, "");
+static_assert(bsi::is_trivially_relocatable<int_vec>::value, "");
+// The size is stored in the smallest type that holds N.
+static_assert(sizeof(int_vec) == 9 * sizeof(int), "");
+static_assert(sizeof(bsi::static_vector<char, 15>) == 16, "");
+static_assert(sizeof(bsi::static_vector<char, 300>) == 302, "");
+static_assert(
+    std::is_same<bsi::static_vector<char, 15>::size_type, std::size_t>::value,
+    "");
+
+// Over-aligned storage is padded out to a multiple of the alignment.
+using simd_vec = bsi::static_vector<float, 10, 32>;
+static_assert(alignof(simd_vec) == 32, "");
+static_assert(simd_vec::capacity() == 10u, "");
+static_assert(simd_vec::padded_capacity() == 16u, "");
+static_assert(sizeof(simd_vec) == 96, "");
+static_assert(bsi::static_vector<float, 16, 64>::padded_capacity() == 16u, "");
+static_assert(int_vec::padded_capacity() == 8u, "");
+static_assert(sizeof(bsi::cache_padded<int>) == 64, "");
+static_assert(std::is_trivially_copyable<simd_vec>::value, "");
+
+constexpr int_vec squares(int n)
+{
+    int_vec retval;
+    for (int i = 0; i < n; ++i) {
+        retval.push_back(i * i);
+    }
+    return retval;
+}
+
+constexpr int_vec edited()
+{
+    int_vec retval = {1, 2, 3, 4};
+    retval.insert(retval.begin() + 1, 9);
+    retval.erase(retval.begin() + 3);
+    retval.emplace(retval.end(), 7);
+    int_vec other = {5};
+    retval.swap(other);
+    retval.push_back(6);
+    other.pop_back();
+    retval.insert(retval.begin(), other.begin(), other.end());
+    return retval;
+}
+
+constexpr int sum(int_vec const & v)
+{
+    int retval = 0;
+    for (int x : v) {
+        retval += x;
+    }
+    return retval;
+}
+
+constexpr int_vec table = squares(5);
+static_assert(table.size() == 5u, "");
+static_assert(table[4] == 16, "");
+static_assert(sum(table) == 0 + 1 + 4 + 9 + 16, "");
+static_assert(edited().size() == 6u, "");
+static_assert(sum(edited()) == 1 + 9 + 2 + 4 + 5 + 6, "");
+static_assert(edited()[1] == 9 && edited()[5] == 6, "");
+static_assert(squares(3) < squares(4) && !(table < squares(4)), "");
+
+constexpr int_vec sorted()
+{
+    int_vec retval = {5, 3, 8, 1, 9, 2, 3};
+    bsi::sort(retval);
+    return retval;
+}
+
+static_assert(sorted()[0] == 1 && sorted()[2] == 3 && sorted()[6] == 9, "");
+constexpr std::ptrdiff_t lower_bound_index(int x)
+{
+    int_vec const v = sorted();
+    return bsi::lower_bound(v, x) - v.begin();
+}
+
+static_assert(lower_bound_index(3) == 2 && lower_bound_index(4) == 4, "");
+static_assert(lower_bound_index(0) == 0 && lower_bound_index(10) == 7, "");
+
+// Static vectors of different capacities compare without a copy, in
+// constant expressions too.
+constexpr bool heterogeneous_less()
+{
+    int_vec const v = sorted();
+    bsi::static_vector<int, 4> w = {1, 2, 4};
+    return w != v && v < w && w >= v && !(w == v);
+}
+
+static_assert(heterogeneous_less(), "");
+
+// chars are ordered as unsigned in constant expressions too, where the
+// elements are compared one at a time.
+constexpr bool char_less()
+{
+    bsi::static_vector<char, 8> const a = {'a'};
+    bsi::static_vector<char, 8> const b = {char(0xe9)};
+    bsi::static_vector<char, 16> const b16 = {char(0xe9)};
+    return a < b && a < b16 && !(b < a) && !(b16 < a);
+}
+
+static_assert(char_less(), "");
+
+#if BOOST_STL_INTERFACES_CONSTEXPR_STATIC_VECTOR
+// In C++20, static_vector is usable in constant expressions for element types
+// that are not trivial, too.
+constexpr std::size_t string_lengths()
+{
+    string_vec v;
+    v.push_back("abc");
+    v.push_back(std::string(30, 'x'));
+    v.insert(v.begin(), "first");
+    v.insert(v.begin() + 1, 2, std::string("ff"));
+    std::string const more[] = {"p", "q", "r"};
+    v.insert(v.end() - 1, std::begin(more), std::end(more));
+    v.erase(v.begin() + 2);
+    string_vec w = v;
+    w.pop_back();
+    string_vec m = std::move(w);
+    m.swap(v);
+    v.resize(2);
+    v.clear();
+    std::size_t retval = m.size() + v.size();
+    for (auto const & s : m) {
+        retval += s.size();
+    }
+    return retval;
+}
+
+static_assert(string_lengths() == 7 + 5 + 2 + 3 + 1 + 1 + 1 + 30, "");
+
+struct counted
+{
+    constexpr counted(int x) : x(x) {}
+    constexpr counted(counted const & other) : x(other.x) {}
+    constexpr counted & operator=(counted const & other)
+    {
+        x = other.x;
+        return *this;
+    }
+    constexpr ~counted() {}
+    int x;
+};
+
+constexpr int counted_digits()
+{
+    bsi::static_vector<counted, 4> v;
+    v.emplace_back(1);
+    v.emplace(v.begin(), 2);
+    v.insert(v.begin() + 1, 2, counted(5));
+    v.erase(v.begin());
+    auto w = std::move(v);
+    return w[0].x * 100 + w[1].x * 10 + w[2].x;
+}
+
+static_assert(counted_digits() == 551, "");
+#endif
+
+
+TEST(constexpr_static_vec, compile_time_table)
+{
+    std::vector<int> const expected = {0, 1, 4, 9, 16};
+    EXPECT_TRUE(std::equal(
+        table.begin(), table.end(), expected.begin(), expected.end()));
+    EXPECT_EQ(edited(), int_vec({1, 9, 2, 4, 5, 6}));
+}
+
+TEST(constexpr_static_vec, narrow_size)
+{
+    bsi::static_vector<char, 255> v(255, 'x');
+    EXPECT_EQ(v.size(), 255u);
+    v.erase(v.begin(), v.begin() + 200);
+    EXPECT_EQ(v.size(), 55u);
+    v.insert(v.begin(), 200, 'y');
+    EXPECT_EQ(v.size(), 255u);
+    EXPECT_EQ(v.front(), 'y');
+
+    bsi::static_vector<std::string, 256> s(256, "s");
+    EXPECT_EQ(s.size(), 256u);
+    s.resize(3);
+    bsi::static_vector<std::string, 256> t(256, "t");
+    s.swap(t);
+    EXPECT_EQ(s.size(), 256u);
+    EXPECT_EQ(t.size(), 3u);
+}
+
+TEST(constexpr_static_vec, aligned)
+{
+    simd_vec v(7, 1.0f);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(v.data()) % 32, 0u);
+    // The padding may be written and read.
+    std::fill(v.data() + v.size(), v.data() + v.padded_capacity(), 0.0f);
+    float sum = 0;
+    for (std::size_t i = 0; i < v.padded_capacity(); ++i) {
+        sum += v.data()[i];
+    }
+    EXPECT_EQ(sum, 7.0f);
+    v.push_back(2.0f);
+    EXPECT_EQ(v, simd_vec({1, 1, 1, 1, 1, 1, 1, 2}));
+
+    bsi::static_vector<std::string, 3, 64> s = {"a", "b"};
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(s.data()) % 64, 0u);
+    s.insert(s.begin(), std::string(40, 'x'));
+    auto t = std::move(s);
+    EXPECT_EQ(t[0], std::string(40, 'x'));
+    EXPECT_EQ(t[2], "b");
+    bsi::sort(t);
+    EXPECT_EQ(t[0], "a");
+
+    bsi::static_vector<bsi::cache_padded<long>, 4> counters(4);
+    EXPECT_EQ(
+        reinterpret_cast<char *>(&counters[1]) -
+            reinterpret_cast<char *>(&counters[0]),
+        64);
+    *counters[2] += 5;
+    EXPECT_EQ(counters[2].value, 5);
+}
+
+TEST(constexpr_static_vec, memcpy)
+{
+    int_vec v = {1, 2, 3};
+    unsigned char bytes[sizeof(int_vec)];
+    std::memcpy(bytes, &v, sizeof(v));
+
+    int_vec copy;
+    std::memcpy(&copy, bytes, sizeof(copy));
+    EXPECT_EQ(copy, v);
+    copy.push_back(4);
+    EXPECT_EQ(copy, int_vec({1, 2, 3, 4}));
+    EXPECT_EQ(v.size(), 3u);
+}
+
+TEST(constexpr_static_vec, trivial_ops)
+{
+    int_vec v(3, 7);
+    EXPECT_EQ(v, int_vec({7, 7, 7}));
+
+    v.resize(5, 1);
+    EXPECT_EQ(v, int_vec({7, 7, 7, 1, 1}));
+    v.resize(2);
+    EXPECT_EQ(v, int_vec({7, 7}));
+
+    int const a[] = {1, 2, 3};
+    v.insert(v.begin() + 1, std::begin(a), std::end(a));
+    EXPECT_EQ(v, int_vec({7, 1, 2, 3, 7}));
+    v.insert(v.end(), 2, 0);
+    EXPECT_EQ(v, int_vec({7, 1, 2, 3, 7, 0, 0}));
+    v.erase(v.begin(), v.begin() + 2);
+    EXPECT_EQ(v, int_vec({2, 3, 7, 0, 0}));
+
+    int_vec w = {9};
+    swap(v, w);
+    EXPECT_EQ(v, int_vec({9}));
+    EXPECT_EQ(w, int_vec({2, 3, 7, 0, 0}));
+
+    w.clear();
+    EXPECT_TRUE(w.empty());
+}
+
+TEST(constexpr_static_vec, strings)
+{
+    string_vec v = {"a", "b", "c"};
+    v.insert(v.begin() + 1, std::string(40, 'x'));
+    EXPECT_EQ(v, string_vec({"a", std::string(40, 'x'), "b", "c"}));
+
+    // args refers to an element that moves.
+    v.emplace(v.begin(), v[3]);
+    EXPECT_EQ(v, string_vec({"c", "a", std::string(40, 'x'), "b", "c"}));
+
+    std::string const more[] = {"d", "e"};
+    v.insert(v.begin() + 4, std::begin(more), std::end(more));
+    EXPECT_EQ(
+        v, string_vec({"c", "a", std::string(40, 'x'), "b", "d", "e", "c"}));
+
+    v.erase(v.begin() + 1, v.begin() + 3);
+    EXPECT_EQ(v, string_vec({"c", "b", "d", "e", "c"}));
+
+    // An empty range moves nothing onto itself.  (Found by
+    // fuzz/static_vector_fuzz.)
+    v.erase(v.begin() + 1, v.begin() + 1);
+    EXPECT_EQ(v, string_vec({"c", "b", "d", "e", "c"}));
+
+    string_vec copy = v;
+    string_vec moved = std::move(copy);
+    EXPECT_TRUE(copy.empty());
+    EXPECT_EQ(moved, v);
+
+    string_vec w = {"z"};
+    w.swap(moved);
+    EXPECT_EQ(w, v);
+    EXPECT_EQ(moved, string_vec({"z"}));
+
+    moved = w;
+    EXPECT_EQ(moved, v);
+    w = string_vec(2, "y");
+    EXPECT_EQ(w, string_vec({"y", "y"}));
+
+    v.resize(1);
+    EXPECT_EQ(v, string_vec({"c"}));
+    v.resize(3, "q");
+    EXPECT_EQ(v, string_vec({"c", "q", "q"}));
+}
+
+TEST(constexpr_static_vec, fill_insert)
+{
+    // x refers to an element that moves.
+    int_vec v = {1, 2, 3};
+    v.insert(v.begin(), 2, v[2]);
+    EXPECT_EQ(v, int_vec({3, 3, 1, 2, 3}));
+    v.fill_insert(v.begin() + 4, 3, v[3]);
+    EXPECT_EQ(v, int_vec({3, 3, 1, 2, 2, 2, 2, 3}));
+    v.assign(2, 5);
+    EXPECT_EQ(v, int_vec({5, 5}));
+    v.assign(4, v[0]);
+    EXPECT_EQ(v, int_vec({5, 5, 5, 5}));
+
+    string_vec s = {"a", "b"};
+    s.insert(s.begin(), 3, s[1]);
+    EXPECT_EQ(s, string_vec({"b", "b", "b", "a", "b"}));
+    s.insert(s.end(), 1, s[3]);
+    EXPECT_EQ(s, string_vec({"b", "b", "b", "a", "b", "a"}));
+    s.assign(7, std::string(40, 'x'));
+    EXPECT_EQ(s, string_vec(7, std::string(40, 'x')));
+}
+
+TEST(constexpr_static_vec, move_only)
+{
+    using ptr_vec = bsi::static_vector<std::unique_ptr<int>, 4>;
+
+    ptr_vec v;
+    v.emplace_back(new int(1));
+    v.emplace_back(new int(3));
+    v.emplace(v.begin() + 1, new int(2));
+    EXPECT_EQ(v.size(), 3u);
+    EXPECT_EQ(*v[0], 1);
+    EXPECT_EQ(*v[1], 2);
+    EXPECT_EQ(*v[2], 3);
+
+    ptr_vec w = std::move(v);
+    EXPECT_TRUE(v.empty());
+    EXPECT_EQ(*w[2], 3);
+
+    w.erase(w.begin());
+    EXPECT_EQ(w.size(), 2u);
+    EXPECT_EQ(*w[0], 2);
+}
+
+// Sorts and searches every size of vector up to N, with few enough
+// distinct values that there are plenty of duplicates.
+template<typename T, std::size_t N>
+void check_sort_and_search(int distinct)
+{
+    unsigned state = 1;
+    for (std::size_t size = 0; size <= N; ++size) {
+        bsi::static_vector<T, N> v;
+        for (std::size_t i = 0; i < size; ++i) {
+            state = state * 1103515245u + 12345u;
+            v.push_back(T(int(state >> 16) % distinct - distinct / 3));
+        }
+        std::vector<T> expected(v.begin(), v.end());
+        std::sort(expected.begin(), expected.end());
+        bsi::sort(v);
+        EXPECT_TRUE(std::equal(
+            v.begin(), v.end(), expected.begin(), expected.end()))
+            << "size " << size;
+
+        auto const & cv = v;
+        for (int x = -distinct / 3 - 1; x <= distinct; ++x) {
+            auto const expected_it =
+                std::lower_bound(expected.begin(), expected.end(), T(x));
+            EXPECT_EQ(
+                bsi::lower_bound(cv, T(x)) - cv.begin(),
+                expected_it - expected.begin())
+                << "size " << size << ", " << x;
+        }
+    }
+}
+
+TEST(constexpr_static_vec, sort_and_lower_bound)
+{
+    check_sort_and_search<int, 32>(20);
+    check_sort_and_search<int, 48>(1000);
+    check_sort_and_search<double, 17>(10);
+    check_sort_and_search<unsigned char, 32>(200);
+
+    string_vec s = {"d", "a", "c", "b"};
+    bsi::sort(s);
+    EXPECT_EQ(s, string_vec({"a", "b", "c", "d"}));
+    EXPECT_EQ(bsi::lower_bound(s, std::string("bb")) - s.begin(), 2);
+}
+
+TEST(constexpr_static_vec, relocate_to)
+{
+    {
+        bsi::static_vector<std::unique_ptr<int>, 8> v;
+        for (int i = 0; i < 3; ++i) {
+            v.push_back(std::make_unique<int>(i));
+        }
+        bsi::static_vector<std::unique_ptr<int>, 4> small(std::move(v));
+        EXPECT_TRUE(v.empty());
+        ASSERT_EQ(small.size(), 3u);
+        EXPECT_EQ(*small[2], 2);
+
+        bsi::static_vector<std::unique_ptr<int>, 16, 64> aligned(
+            std::move(small));
+        EXPECT_TRUE(small.empty());
+        ASSERT_EQ(aligned.size(), 3u);
+        EXPECT_EQ(*aligned[0], 0);
+    }
+    {
+        int_vec v = {1, 2, 3};
+        bsi::static_vector<int, 3> exact(std::move(v));
+        EXPECT_TRUE(v.empty());
+        EXPECT_EQ(exact, (bsi::static_vector<int, 3>{1, 2, 3}));
+    }
+    {
+        string_vec v = {"a", std::string(30, 'b')};
+        std::allocator<std::string> a;
+        std::string * const out = a.allocate(4);
+        std::string * const last = v.relocate_to(out);
+        EXPECT_TRUE(v.empty());
+        ASSERT_EQ(last - out, 2);
+        EXPECT_EQ(out[1], std::string(30, 'b'));
+        for (auto it = out; it != last; ++it) {
+            it->~basic_string();
+        }
+        a.deallocate(out, 4);
+    }
+}
+
+TEST(constexpr_static_vec, heterogeneous_comparisons)
+{
+    int_vec const v = {1, 2, 3};
+    bsi::static_vector<int, 3> const exact = {1, 2, 3};
+    bsi::static_vector<int, 16> const longer = {1, 2, 3, 0};
+    std::vector<int> const vec = {1, 2, 3};
+    std::array<int, 3> const arr = {{1, 2, 4}};
+
+    EXPECT_TRUE(v == exact);
+    EXPECT_TRUE(exact == v);
+    EXPECT_FALSE(v != exact);
+    EXPECT_TRUE(v != longer);
+    EXPECT_TRUE(v < longer);
+    EXPECT_TRUE(longer > v);
+    EXPECT_TRUE(v <= exact);
+    EXPECT_TRUE(v >= exact);
+
+    EXPECT_TRUE(v == vec);
+    EXPECT_TRUE(vec == v);
+    EXPECT_TRUE(v < arr);
+    EXPECT_TRUE(arr > v);
+    EXPECT_FALSE(arr <= v);
+
+    bsi::static_vector<std::string, 2> const strings = {"a", "b"};
+    std::vector<std::string> const more_strings = {"a", "b", "c"};
+    EXPECT_TRUE(strings != more_strings);
+    EXPECT_TRUE(strings < more_strings);
+
+    // chars are ordered as unsigned, as std::string orders them.
+    bsi::static_vector<char, 4> const high = {char(0xc3), 'a'};
+    std::string const low = "za";
+    EXPECT_TRUE(low < high);
+    EXPECT_TRUE(high > low);
+    EXPECT_EQ(high < low, std::string(high.begin(), high.end()) < low);
+    bsi::static_vector<char, 2> const same = {char(0xc3), 'a'};
+    EXPECT_TRUE(high == same);
+    EXPECT_FALSE(high < same);
+}
+
+TEST(constexpr_static_vec, char_ordering)
+{
+    // chars order the same way whether the containers are of the same type
+    // or not.
+    bsi::static_vector<char, 8> const a = {'a'};
+    bsi::static_vector<char, 8> const b = {char(0xe9)};
+    bsi::static_vector<char, 16> const b16 = {char(0xe9)};
+    bsi::static_vector<char, 8> const ab = {'a', char(0xe9)};
+    bsi::static_vector<char, 8> const aa = {'a', 'a'};
+    EXPECT_TRUE(a < b);
+    EXPECT_TRUE(a < b16);
+    EXPECT_FALSE(b < a);
+    EXPECT_FALSE(b16 < a);
+    EXPECT_TRUE(b >= a);
+    EXPECT_TRUE(b16 >= a);
+    EXPECT_TRUE(aa < ab);
+    EXPECT_EQ(a < b, std::string(1, 'a') < std::string(1, char(0xe9)));
+}
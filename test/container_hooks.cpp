@@ -0,0 +1,149 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/small_vector.hpp>
+#include <boost/stl_interfaces/static_vector.hpp>
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <vector>
+
+
+namespace bsi = boost::stl_interfaces;
+using bsi::small_vector;
+
+using traced_vec = small_vector<int, 4>;
+
+// What the hooks for traced_vec saw.
+struct op_log
+{
+    std::vector<std::pair<std::size_t, std::size_t>> grows;
+    std::map<std::size_t, int> insert_sizes;
+    std::map<std::size_t, int> erase_sizes;
+    std::size_t moves = 0;
+};
+
+op_log traced_log;
+
+namespace boost { namespace stl_interfaces {
+    template<>
+    struct container_op_hooks<traced_vec> : container_op_hooks_base
+    {
+        static void grow(
+            traced_vec const &,
+            std::size_t old_capacity,
+            std::size_t new_capacity)
+        {
+            traced_log.grows.emplace_back(old_capacity, new_capacity);
+        }
+        static void insert(traced_vec const &, std::size_t n)
+        {
+            ++traced_log.insert_sizes[n];
+        }
+        static void erase(traced_vec const &, std::size_t n)
+        {
+            ++traced_log.erase_sizes[n];
+        }
+        static void moves(traced_vec const &, std::size_t n)
+        {
+            traced_log.moves += n;
+        }
+    };
+
+    // Observes only erasures.
+    template<>
+    struct container_op_hooks<static_vector<int, 16>>
+        : container_op_hooks_base
+    {
+        static void erase(static_vector<int, 16> const &, std::size_t n)
+        {
+            ++traced_log.erase_sizes[n];
+        }
+    };
+}}
+
+static_assert(!bsi::container_op_hooks<small_vector<int, 8>>::enabled, "");
+static_assert(bsi::container_op_hooks<traced_vec>::enabled, "");
+
+
+TEST(container_hooks, insert_and_grow)
+{
+    traced_log = op_log();
+    traced_vec v;
+    v.insert(v.end(), 3, 1);
+    EXPECT_TRUE(traced_log.grows.empty());
+    EXPECT_EQ(traced_log.insert_sizes[3], 1);
+    EXPECT_EQ(traced_log.moves, 0u);
+
+    // Inserting at the front shifts the 3 elements already there.
+    v.insert(v.begin(), {7, 8});
+    ASSERT_EQ(traced_log.grows.size(), 1u);
+    EXPECT_EQ(traced_log.grows[0].first, 4u);
+    EXPECT_EQ(traced_log.grows[0].second, 8u);
+    EXPECT_EQ(traced_log.insert_sizes[2], 1);
+    EXPECT_EQ(traced_log.moves, 3u);
+
+    std::vector<int> const more(10, 2);
+    v.insert_range(v.begin() + 1, more);
+    v.append_range(more);
+    EXPECT_EQ(traced_log.insert_sizes[10], 2);
+    EXPECT_EQ(traced_log.grows.size(), 3u);
+    EXPECT_EQ(traced_log.moves, 3u + 4u);
+    EXPECT_EQ(v.size(), 25u);
+}
+
+TEST(container_hooks, assign_resize_clear)
+{
+    traced_log = op_log();
+    traced_vec v = {1, 2, 3};
+
+    // Only the change in size is reported.  Since v has to grow, its
+    // elements are erased, and none is assigned over.
+    std::vector<int> const five = {5, 5, 5, 5, 5};
+    v.assign(five.begin(), five.end());
+    EXPECT_EQ(traced_log.moves, 0u);
+    EXPECT_EQ(traced_log.insert_sizes[2], 1);
+    EXPECT_EQ(traced_log.grows.size(), 1u);
+
+    v.assign(2, 9);
+    EXPECT_EQ(traced_log.moves, 2u);
+    EXPECT_EQ(traced_log.erase_sizes[3], 1);
+
+    v.resize(6);
+    EXPECT_EQ(traced_log.insert_sizes[4], 1);
+    v.resize(1);
+    EXPECT_EQ(traced_log.erase_sizes[5], 1);
+
+    // small_vector's own clear() is not observed; only the members of
+    // container_interface report their operations.
+    v.clear();
+    EXPECT_EQ(traced_log.erase_sizes.count(1), 0u);
+    EXPECT_EQ(v.size(), 0u);
+}
+
+TEST(container_hooks, partial_hooks)
+{
+    traced_log = op_log();
+    bsi::static_vector<int, 16> v(10, 1);
+    v.resize(4);
+    v.insert(v.begin(), 2, 3);
+    v.assign({1, 2});
+    EXPECT_EQ(traced_log.erase_sizes[6], 1);
+    EXPECT_EQ(traced_log.erase_sizes[4], 1);
+    EXPECT_TRUE(traced_log.insert_sizes.empty());
+    EXPECT_EQ(traced_log.moves, 0u);
+}
+
+TEST(container_hooks, disabled)
+{
+    traced_log = op_log();
+    small_vector<int, 8> v;
+    v.insert(v.begin(), 20, 1);
+    v.resize(2);
+    EXPECT_TRUE(traced_log.grows.empty());
+    EXPECT_TRUE(traced_log.insert_sizes.empty());
+    EXPECT_TRUE(traced_log.erase_sizes.empty());
+}
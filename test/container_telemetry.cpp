@@ -0,0 +1,132 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/container_telemetry.hpp>
+#include <boost/stl_interfaces/small_vector.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+namespace bsi = boost::stl_interfaces;
+using bsi::small_vector;
+
+using counted_vec = small_vector<int, 4>;
+using named_vec = small_vector<short, 8>;
+
+std::vector<named_vec const *> oversized_objects;
+
+namespace boost { namespace stl_interfaces {
+    template<>
+    struct container_op_hooks<counted_vec>
+        : container_telemetry_hooks<counted_vec>
+    {
+    };
+
+    template<>
+    struct container_op_hooks<named_vec>
+        : container_telemetry_hooks<named_vec>
+    {
+        static char const * name() { return "named \"vec\""; }
+        static constexpr std::size_t expected_size = 16;
+        static void oversized(named_vec const & v, std::size_t)
+        {
+            oversized_objects.push_back(&v);
+        }
+    };
+}}
+
+bsi::container_stats stats_of(char const * name)
+{
+    for (auto const & s : bsi::container_telemetry()) {
+        if (std::string(s.name) == name)
+            return s;
+    }
+    return bsi::container_stats{name, 0, 0, 0, 0, 0, 0, 0, 0};
+}
+
+
+TEST(container_telemetry, counts)
+{
+    char const * const name = typeid(counted_vec).name();
+    auto const before = stats_of(name);
+
+    counted_vec v;
+    v.insert(v.end(), 3, 1);
+    v.insert(v.begin(), {7, 8});
+    v.resize(2);
+    v.assign(2, 9);
+
+    auto const after = stats_of(name);
+    // The first insert fits in the inline buffer; the second spills out of
+    // it, to a capacity of 8, shifting the 3 elements already there.
+    EXPECT_EQ(after.grows - before.grows, 1u);
+    EXPECT_EQ(after.spills - before.spills, 1u);
+    EXPECT_EQ(after.oversized - before.oversized, 0u);
+    EXPECT_EQ(after.inserted - before.inserted, 5u);
+    EXPECT_EQ(after.erased - before.erased, 3u);
+    EXPECT_EQ(after.bytes_moved - before.bytes_moved, 5 * sizeof(int));
+    EXPECT_LE(5u, after.peak_size);
+    EXPECT_LE(8u, after.peak_capacity);
+}
+
+TEST(container_telemetry, threads)
+{
+    auto const before = stats_of("named \"vec\"");
+
+    // Each thread's counts are merged in when the thread exits.
+    std::vector<std::thread> threads;
+    std::vector<named_vec> vecs(4);
+    for (auto & v : vecs) {
+        threads.emplace_back([&v] {
+            for (int i = 0; i < 100; ++i) {
+                v.insert(v.end(), 5, short(i));
+                v.resize(0);
+            }
+            v.insert(v.end(), 20, 1);
+        });
+    }
+    for (auto & t : threads) {
+        t.join();
+    }
+
+    // A live thread's counts are merged in as well.
+    named_vec local;
+    local.insert(local.end(), 9, 1);
+
+    auto const after = stats_of("named \"vec\"");
+    EXPECT_EQ(after.inserted - before.inserted, 4u * (500 + 20) + 9);
+    EXPECT_EQ(after.erased - before.erased, 4u * 500);
+    EXPECT_EQ(after.spills - before.spills, 5u);
+    EXPECT_EQ(after.oversized - before.oversized, 4u);
+    EXPECT_EQ(after.peak_size, 20u);
+    ASSERT_EQ(oversized_objects.size(), 4u);
+    for (auto const & v : vecs) {
+        EXPECT_EQ(
+            std::count(oversized_objects.begin(), oversized_objects.end(), &v),
+            1);
+    }
+}
+
+TEST(container_telemetry, prometheus)
+{
+    named_vec v;
+    v.insert(v.end(), 20, 1);
+
+    std::ostringstream os;
+    bsi::write_container_telemetry(os, "app_vec");
+    std::string const text = os.str();
+    auto const npos = std::string::npos;
+    EXPECT_NE(text.find("# TYPE app_vec_grows_total counter\n"), npos);
+    EXPECT_NE(text.find("# TYPE app_vec_peak_size gauge\n"), npos);
+    EXPECT_NE(
+        text.find("app_vec_peak_size{container=\"named \\\"vec\\\"\"} 20\n"),
+        npos);
+}
@@ -0,0 +1,265 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/iterator_interface.hpp>
+#include <boost/stl_interfaces/reverse_iterator.hpp>
+#include <boost/stl_interfaces/container_interface.hpp>
+
+#include "ill_formed.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <tuple>
+
+
+namespace bsi = boost::stl_interfaces;
+
+struct adapted_contiguous_iter : bsi::iterator_interface<
+                                     adapted_contiguous_iter,
+                                     bsi::contiguous_iterator_tag,
+                                     int>
+{
+    adapted_contiguous_iter() : it_(nullptr) {}
+    adapted_contiguous_iter(int * it) : it_(it) {}
+
+private:
+    friend bsi::access;
+    int *& base_reference() noexcept { return it_; }
+    int * base_reference() const noexcept { return it_; }
+
+    int * it_;
+};
+
+struct user_ops_contiguous_iter : bsi::iterator_interface<
+                                      user_ops_contiguous_iter,
+                                      bsi::contiguous_iterator_tag,
+                                      int>
+{
+    user_ops_contiguous_iter() : it_(nullptr) {}
+    user_ops_contiguous_iter(int * it) : it_(it) {}
+
+    int & operator*() const { return *it_; }
+    user_ops_contiguous_iter & operator+=(std::ptrdiff_t i)
+    {
+        it_ += i;
+        return *this;
+    }
+    friend std::ptrdiff_t
+    operator-(user_ops_contiguous_iter lhs, user_ops_contiguous_iter rhs)
+    {
+        return lhs.it_ - rhs.it_;
+    }
+
+private:
+    int * it_;
+};
+
+struct random_access_iter : bsi::iterator_interface<
+                                random_access_iter,
+                                std::random_access_iterator_tag,
+                                int>
+{
+    random_access_iter() : it_(nullptr) {}
+    random_access_iter(int * it) : it_(it) {}
+
+private:
+    friend bsi::access;
+    int *& base_reference() noexcept { return it_; }
+    int * base_reference() const noexcept { return it_; }
+
+    int * it_;
+};
+
+struct zip_iter : bsi::proxy_iterator_interface<
+                      zip_iter,
+                      std::random_access_iterator_tag,
+                      std::tuple<int, int>,
+                      std::tuple<int &, int &>>
+{
+    zip_iter() : it1_(nullptr), it2_(nullptr) {}
+    zip_iter(int * it1, int * it2) : it1_(it1), it2_(it2) {}
+
+    std::tuple<int &, int &> operator*() const
+    {
+        return std::tuple<int &, int &>{*it1_, *it2_};
+    }
+    zip_iter & operator+=(std::ptrdiff_t i)
+    {
+        it1_ += i;
+        it2_ += i;
+        return *this;
+    }
+    friend std::ptrdiff_t operator-(zip_iter lhs, zip_iter rhs)
+    {
+        return lhs.it1_ - rhs.it1_;
+    }
+
+private:
+    int * it1_;
+    int * it2_;
+};
+
+template<typename Iter>
+using to_address_t = decltype(bsi::to_address(std::declval<Iter>()));
+
+static_assert(
+    std::is_same<
+        std::iterator_traits<adapted_contiguous_iter>::iterator_category,
+        std::random_access_iterator_tag>::value,
+    "");
+static_assert(
+    std::is_same<
+        adapted_contiguous_iter::iterator_concept,
+        bsi::contiguous_iterator_tag>::value,
+    "");
+
+static_assert(bsi::is_contiguous_iterator<int *>::value, "");
+static_assert(bsi::is_contiguous_iterator<int const *>::value, "");
+static_assert(bsi::is_contiguous_iterator<adapted_contiguous_iter>::value, "");
+static_assert(bsi::is_contiguous_iterator<user_ops_contiguous_iter>::value, "");
+static_assert(!bsi::is_contiguous_iterator<random_access_iter>::value, "");
+static_assert(!bsi::is_contiguous_iterator<zip_iter>::value, "");
+static_assert(
+    !bsi::is_contiguous_iterator<
+        bsi::reverse_iterator<adapted_contiguous_iter>>::value,
+    "");
+static_assert(
+    !bsi::is_contiguous_iterator<bsi::reverse_iterator<int *>>::value, "");
+
+static_assert(
+    std::is_same<to_address_t<adapted_contiguous_iter>, int *>::value, "");
+static_assert(
+    std::is_same<to_address_t<user_ops_contiguous_iter>, int *>::value, "");
+static_assert(std::is_same<to_address_t<int const *>, int const *>::value, "");
+static_assert(ill_formed<to_address_t, zip_iter>::value, "");
+static_assert(ill_formed<to_address_t, int>::value, "");
+
+static_assert(
+    noexcept(bsi::to_address(std::declval<adapted_contiguous_iter>())), "");
+
+
+TEST(contiguous, to_address)
+{
+    std::array<int, 4> ints = {{0, 1, 2, 3}};
+
+    {
+        adapted_contiguous_iter first(ints.data());
+        adapted_contiguous_iter last(ints.data() + ints.size());
+        EXPECT_EQ(bsi::to_address(first), ints.data());
+        EXPECT_EQ(bsi::to_address(first + 2), ints.data() + 2);
+        // The end iterator is never dereferenced.
+        EXPECT_EQ(bsi::to_address(last), ints.data() + ints.size());
+        EXPECT_EQ(
+            bsi::to_address(last) - bsi::to_address(first), last - first);
+    }
+
+    {
+        user_ops_contiguous_iter first(ints.data());
+        EXPECT_EQ(bsi::to_address(first), ints.data());
+        EXPECT_EQ(bsi::to_address(first + 3), ints.data() + 3);
+    }
+
+    {
+        int * p = ints.data() + 1;
+        EXPECT_EQ(bsi::to_address(p), p);
+    }
+}
+
+TEST(contiguous, algorithms)
+{
+    std::array<int, 4> ints = {{0, 1, 2, 3}};
+    std::array<int, 4> result = {{}};
+
+    adapted_contiguous_iter first(ints.data());
+    adapted_contiguous_iter last(ints.data() + ints.size());
+    std::copy(first, last, result.begin());
+    EXPECT_EQ(result, ints);
+
+    std::sort(first, last, std::greater<>{});
+    std::array<int, 4> const expected = {{3, 2, 1, 0}};
+    EXPECT_EQ(ints, expected);
+
+    bsi::reverse_iterator<adapted_contiguous_iter> rfirst(last);
+    EXPECT_EQ(*rfirst, 0);
+    EXPECT_EQ(bsi::to_address(rfirst.base()), ints.data() + ints.size());
+}
+
+template<typename T, std::size_t N>
+struct contiguous_array
+    : bsi::container_interface<contiguous_array<T, N>, bsi::contiguous>
+{
+    struct iterator : bsi::iterator_interface<
+                          iterator,
+                          bsi::contiguous_iterator_tag,
+                          T>
+    {
+        iterator() : it_(nullptr) {}
+        iterator(T * it) : it_(it) {}
+
+        friend struct contiguous_array;
+
+    private:
+        friend bsi::access;
+        T *& base_reference() noexcept { return it_; }
+        T * base_reference() const noexcept { return it_; }
+
+        T * it_;
+    };
+
+    using value_type = T;
+    using pointer = T *;
+    using const_pointer = T const *;
+    using reference = value_type &;
+    using const_reference = value_type const &;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using const_iterator = iterator;
+
+    contiguous_array() : size_() {}
+    explicit contiguous_array(size_type n) : size_(n) {}
+
+    iterator begin() noexcept { return iterator(elements_); }
+    iterator end() noexcept { return iterator(elements_ + size_); }
+    size_type max_size() const noexcept { return N; }
+    void swap(contiguous_array & other)
+    {
+        std::swap(elements_, other.elements_);
+        std::swap(size_, other.size_);
+    }
+
+    using base_type =
+        bsi::container_interface<contiguous_array<T, N>, bsi::contiguous>;
+    using base_type::begin;
+    using base_type::end;
+
+    T elements_[N];
+    size_type size_;
+};
+
+template<typename Container>
+using resize_for_overwrite_t =
+    decltype(std::declval<Container &>().resize_for_overwrite(1));
+
+// contiguous_array has no resize(n, default_init_t).
+static_assert(
+    ill_formed<resize_for_overwrite_t, contiguous_array<int, 4>>::value, "");
+
+TEST(contiguous, container_data)
+{
+    {
+        contiguous_array<int, 4> a(4);
+        EXPECT_EQ(a.data(), a.elements_);
+        EXPECT_EQ(decltype(a)::iterator(a.data()), a.begin());
+    }
+    {
+        // data() of an empty container is the address of its storage; it
+        // does not dereference begin().
+        contiguous_array<int, 4> const a;
+        EXPECT_EQ(a.data(), a.elements_);
+        EXPECT_TRUE(a.empty());
+    }
+}
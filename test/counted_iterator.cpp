@@ -0,0 +1,89 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/counted_iterator.hpp>
+
+#include <gtest/gtest.h>
+
+#include <forward_list>
+#include <list>
+#include <vector>
+
+
+namespace bsi = boost::stl_interfaces;
+
+static_assert(
+    std::is_same<
+        std::iterator_traits<bsi::counted_iterator<
+            std::forward_list<int>::iterator>>::iterator_category,
+        std::forward_iterator_tag>::value,
+    "");
+static_assert(
+    std::is_same<
+        std::iterator_traits<
+            bsi::counted_iterator<int *>>::iterator_category,
+        std::random_access_iterator_tag>::value,
+    "");
+
+template<typename View>
+std::vector<int> to_vector(View const & v)
+{
+    std::vector<int> retval;
+    for (auto it = v.begin(); it != v.end(); ++it) {
+        retval.push_back(*it);
+    }
+    return retval;
+}
+
+
+TEST(counted_iterator, forward)
+{
+    std::forward_list<int> l = {1, 2, 3, 4, 5};
+    auto const v = bsi::make_counted_view(l.begin(), 3);
+    EXPECT_EQ(to_vector(v), (std::vector<int>{1, 2, 3}));
+    EXPECT_EQ(v.size(), 3);
+    EXPECT_FALSE(v.empty());
+    EXPECT_EQ(v.front(), 1);
+
+    auto it = v.begin();
+    EXPECT_EQ(it.count(), 3);
+    EXPECT_TRUE(it != bsi::default_sentinel);
+    ++it;
+    EXPECT_EQ(*it, 2);
+    EXPECT_EQ(it.count(), 2);
+    EXPECT_EQ(*it.base(), 2);
+    EXPECT_TRUE(it == std::next(v.begin()));
+    EXPECT_TRUE(it != v.begin());
+    EXPECT_EQ(bsi::default_sentinel - it, 2);
+    EXPECT_EQ(it - bsi::default_sentinel, -2);
+
+    EXPECT_TRUE(bsi::make_counted_view(l.begin(), 0).empty());
+}
+
+TEST(counted_iterator, bidirectional)
+{
+    std::list<int> l = {1, 2, 3, 4, 5};
+    auto it = bsi::counted_iterator<std::list<int>::iterator>(
+        std::next(l.begin(), 2), 3);
+    --it;
+    EXPECT_EQ(*it, 2);
+    EXPECT_EQ(it.count(), 4);
+}
+
+TEST(counted_iterator, random_access)
+{
+    std::vector<int> ints = {1, 2, 3, 4, 5};
+    auto const v = bsi::make_counted_view(ints.data() + 1, 3);
+    EXPECT_EQ(to_vector(v), (std::vector<int>{2, 3, 4}));
+    EXPECT_EQ(v.size(), 3);
+
+    auto const first = v.begin();
+    auto const last = first + 3;
+    EXPECT_TRUE(last == bsi::default_sentinel);
+    EXPECT_EQ(last - first, 3);
+    EXPECT_TRUE(first < last);
+    EXPECT_EQ(first[2], 4);
+    EXPECT_EQ(last.base(), ints.data() + 4);
+}
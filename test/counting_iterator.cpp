@@ -0,0 +1,147 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/counting_iterator_adaptor.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <forward_list>
+#include <list>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+
+namespace bsi = boost::stl_interfaces;
+
+using vec_iter = bsi::counting_iterator_adaptor<std::vector<int>::iterator>;
+using list_iter = bsi::counting_iterator_adaptor<std::list<int>::iterator>;
+using flist_iter =
+    bsi::counting_iterator_adaptor<std::forward_list<int>::iterator>;
+
+static_assert(
+    std::is_same<
+        std::iterator_traits<vec_iter>::iterator_category,
+        std::random_access_iterator_tag>::value,
+    "");
+static_assert(
+    std::is_same<
+        std::iterator_traits<list_iter>::iterator_category,
+        std::bidirectional_iterator_tag>::value,
+    "");
+static_assert(
+    std::is_same<
+        std::iterator_traits<flist_iter>::iterator_category,
+        std::forward_iterator_tag>::value,
+    "");
+static_assert(
+    std::is_same<
+        std::iterator_traits<bsi::counting_iterator_adaptor<int *>>::
+            iterator_category,
+        std::random_access_iterator_tag>::value,
+    "");
+
+
+TEST(counting_iterator, distance)
+{
+    std::vector<int> v(100);
+    std::list<int> l(100);
+
+    {
+        bsi::counted_op_scope scope;
+        auto const n = std::distance(
+            bsi::make_counting_iterator(v.begin()),
+            bsi::make_counting_iterator(v.end()));
+        EXPECT_EQ(n, 100);
+        EXPECT_EQ(scope.counts().differences, 1u);
+        EXPECT_EQ(scope.counts().increments, 0u);
+    }
+    {
+        // The O(n) distance of a bidirectional range shows up as n
+        // increments and n + 1 comparisons.
+        bsi::counted_op_scope scope;
+        auto const n = std::distance(
+            bsi::make_counting_iterator(l.begin()),
+            bsi::make_counting_iterator(l.end()));
+        EXPECT_EQ(n, 100);
+        EXPECT_EQ(scope.counts().differences, 0u);
+        EXPECT_EQ(scope.counts().increments, 100u);
+        EXPECT_EQ(scope.counts().comparisons, 101u);
+    }
+}
+
+TEST(counting_iterator, operations)
+{
+    std::vector<int> v = {1, 2, 3, 4, 5, 6, 7, 8};
+    vec_iter const first(v.begin());
+    vec_iter const last(v.end());
+
+    bsi::counted_op_scope scope;
+    auto it = first;
+    ++it;
+    it++;
+    --it;
+    it += 3;
+    it -= 1;
+    EXPECT_EQ(*it, 4);
+    EXPECT_EQ(it[1], 5);
+    EXPECT_TRUE(it != last);
+    EXPECT_EQ(last - it, 5);
+
+    auto const counts = scope.counts();
+    EXPECT_EQ(counts.increments, 2u);
+    EXPECT_EQ(counts.decrements, 1u);
+    EXPECT_EQ(counts.advances, 3u);
+    EXPECT_EQ(counts.dereferences, 2u);
+    EXPECT_EQ(counts.comparisons, 1u);
+    EXPECT_EQ(counts.differences, 1u);
+    EXPECT_EQ(it.base(), v.begin() + 3);
+
+    std::list<int> l(v.begin(), v.end());
+    bsi::counted_op_scope list_scope;
+    auto const found = std::find(
+        bsi::make_counting_iterator(l.begin()),
+        bsi::make_counting_iterator(l.end()),
+        6);
+    EXPECT_EQ(*found.base(), 6);
+    EXPECT_EQ(list_scope.counts().dereferences, 6u);
+    EXPECT_EQ(list_scope.counts().increments, 5u);
+}
+
+TEST(counting_iterator, per_thread)
+{
+    std::vector<int> v(1000);
+    auto const before = bsi::this_thread_iterator_op_counts();
+    std::thread t([&] {
+        bsi::counted_op_scope scope;
+        std::fill(
+            bsi::make_counting_iterator(v.begin()),
+            bsi::make_counting_iterator(v.end()),
+            1);
+        EXPECT_EQ(scope.counts().dereferences, 1000u);
+    });
+    t.join();
+    auto const counts = bsi::this_thread_iterator_op_counts().since(before);
+    EXPECT_EQ(counts.dereferences, 0u);
+    EXPECT_EQ(std::count(v.begin(), v.end(), 1), 1000);
+}
+
+TEST(counting_iterator, report)
+{
+    bsi::iterator_op_counts counts;
+    std::ostringstream none;
+    none << counts;
+    EXPECT_EQ(none.str(), "no iterator operations");
+
+    counts.dereferences = 3;
+    counts.differences = 1;
+    std::ostringstream some;
+    some << counts;
+    EXPECT_EQ(some.str(), "dereferences: 3, differences: 1");
+
+    bsi::this_thread_iterator_op_counts() = bsi::iterator_op_counts();
+    EXPECT_EQ(bsi::this_thread_iterator_op_counts().dereferences, 0u);
+}
@@ -0,0 +1,233 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/cow_vector.hpp>
+
+#include <gtest/gtest.h>
+
+#include <list>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+namespace bsi = boost::stl_interfaces;
+
+using vec_type = bsi::cow_vector<std::string>;
+
+// Instantiate all the members we can.
+template struct bsi::cow_vector<std::string>;
+
+std::vector<std::string> strings(std::initializer_list<char const *> il)
+{
+    return std::vector<std::string>(il.begin(), il.end());
+}
+template<typename V>
+std::vector<std::string> to_vector(V const & v)
+{
+    return std::vector<std::string>(v.begin(), v.end());
+}
+
+TEST(cow_vector, construction)
+{
+    vec_type v;
+    EXPECT_TRUE(v.empty());
+    EXPECT_EQ(v.size(), 0u);
+    EXPECT_EQ(v.use_count(), 0u);
+    EXPECT_EQ(v.begin(), v.end());
+
+    vec_type a(3, "x");
+    EXPECT_EQ(to_vector(a), strings({"x", "x", "x"}));
+    vec_type b(2);
+    EXPECT_EQ(to_vector(b), strings({"", ""}));
+    vec_type c = {"a", "b", "c"};
+    EXPECT_EQ(to_vector(c), strings({"a", "b", "c"}));
+    std::istringstream is("d e f");
+    vec_type d{
+        std::istream_iterator<std::string>(is),
+        std::istream_iterator<std::string>()};
+    EXPECT_EQ(to_vector(d), strings({"d", "e", "f"}));
+    EXPECT_EQ(c.front(), "a");
+    EXPECT_EQ(c.back(), "c");
+    EXPECT_EQ(c[1], "b");
+    EXPECT_EQ(c.at(2), "c");
+    EXPECT_THROW(c.at(3), std::out_of_range);
+    EXPECT_TRUE(a != c);
+    EXPECT_TRUE(c < vec_type({"b"}));
+}
+
+TEST(cow_vector, copies_share)
+{
+    vec_type const a = {"a", "b", "c"};
+    vec_type b = a;
+    vec_type c;
+    c = b;
+    EXPECT_EQ(a.use_count(), 3u);
+    EXPECT_EQ(a.data(), b.cbegin());
+    EXPECT_EQ(a.data(), c.cbegin());
+    EXPECT_EQ(a, c);
+
+    // Reading through const members does not copy.
+    vec_type const & cb = b;
+    EXPECT_EQ(cb[0], "a");
+    EXPECT_EQ(cb.front(), "a");
+    EXPECT_EQ(std::count(b.cbegin(), b.cend(), "b"), 1);
+    EXPECT_EQ(b.size(), 3u);
+    EXPECT_FALSE(b.empty());
+    EXPECT_EQ(a.use_count(), 3u);
+
+    // Writing copies once.
+    b[0] = "z";
+    EXPECT_EQ(a.use_count(), 2u);
+    EXPECT_EQ(b.use_count(), 1u);
+    EXPECT_NE(a.data(), b.cbegin());
+    auto const p = b.cbegin();
+    b[1] = "y";
+    b.back() = "x";
+    EXPECT_EQ(b.cbegin(), p);
+    EXPECT_EQ(to_vector(a), strings({"a", "b", "c"}));
+    EXPECT_EQ(to_vector(b), strings({"z", "y", "x"}));
+    EXPECT_EQ(to_vector(c), strings({"a", "b", "c"}));
+
+    vec_type d = std::move(c);
+    EXPECT_TRUE(c.empty());
+    EXPECT_EQ(a.use_count(), 2u);
+    d.clear();
+    EXPECT_TRUE(d.empty());
+    EXPECT_EQ(a.use_count(), 1u);
+}
+
+TEST(cow_vector, mutations_of_shared)
+{
+    vec_type const original = {"a", "b", "c", "d"};
+    {
+        vec_type v = original;
+        v.push_back("e");
+        EXPECT_EQ(to_vector(v), strings({"a", "b", "c", "d", "e"}));
+    }
+    {
+        vec_type v = original;
+        auto const it = v.insert(v.cbegin() + 1, "x");
+        EXPECT_EQ(*it, "x");
+        EXPECT_EQ(to_vector(v), strings({"a", "x", "b", "c", "d"}));
+    }
+    {
+        vec_type v = original;
+        auto const it = v.erase(v.cbegin() + 1, v.cbegin() + 3);
+        EXPECT_EQ(*it, "d");
+        EXPECT_EQ(to_vector(v), strings({"a", "d"}));
+    }
+    {
+        vec_type v = original;
+        v.pop_back();
+        EXPECT_EQ(to_vector(v), strings({"a", "b", "c"}));
+    }
+    {
+        vec_type v = original;
+        v.resize(2);
+        EXPECT_EQ(to_vector(v), strings({"a", "b"}));
+        vec_type w = original;
+        w.resize(5, "z");
+        EXPECT_EQ(to_vector(w), strings({"a", "b", "c", "d", "z"}));
+    }
+    {
+        vec_type v = original;
+        std::list<std::string> l = {"p", "q"};
+        v.insert(v.cbegin() + 2, l.begin(), l.end());
+        EXPECT_EQ(to_vector(v), strings({"a", "b", "p", "q", "c", "d"}));
+    }
+    {
+        vec_type v = original;
+        v.reserve(100);
+        EXPECT_GE(v.capacity(), 100u);
+        EXPECT_EQ(v.use_count(), 1u);
+        EXPECT_EQ(to_vector(v), to_vector(original));
+    }
+    EXPECT_EQ(original.use_count(), 1u);
+    EXPECT_EQ(to_vector(original), strings({"a", "b", "c", "d"}));
+}
+
+TEST(cow_vector, mutations_of_unshared)
+{
+    vec_type v;
+    for (int i = 0; i < 100; ++i) {
+        v.push_back(std::to_string(i));
+    }
+    EXPECT_EQ(v.size(), 100u);
+    v.insert(v.begin(), "front");
+    v.emplace(v.begin() + 50, "middle");
+    EXPECT_EQ(v[0], "front");
+    EXPECT_EQ(v[50], "middle");
+    EXPECT_EQ(v[51], "49");
+    v.erase(v.begin(), v.begin() + 2);
+    EXPECT_EQ(v[0], "1");
+    EXPECT_EQ(v.size(), 100u);
+
+    // Inserting elements of the vector into itself.
+    vec_type w = {"a", "b"};
+    w.push_back(w[0]);
+    w.insert(w.begin() + 1, w.cbegin(), w.cend());
+    EXPECT_EQ(to_vector(w), strings({"a", "a", "b", "a", "b", "a"}));
+    w.reserve(20);
+    w.insert(w.begin(), w.cbegin() + 1, w.cbegin() + 3);
+    EXPECT_EQ(
+        to_vector(w), strings({"a", "b", "a", "a", "b", "a", "b", "a"}));
+    w.assign({"q"});
+    EXPECT_EQ(to_vector(w), strings({"q"}));
+}
+
+struct throws_on_copy
+{
+    throws_on_copy(int x) : x(x) {}
+    throws_on_copy(throws_on_copy const & other) : x(other.x)
+    {
+        if (x == 2)
+            throw std::runtime_error("copy");
+    }
+    throws_on_copy & operator=(throws_on_copy const &) = default;
+    int x;
+};
+
+TEST(cow_vector, detach_throws)
+{
+    bsi::cow_vector<throws_on_copy> const a = {0, 1};
+    auto v = a;
+    v.push_back(throws_on_copy(3));
+    // v is unshared now; sharing it with b, and then writing to v, copies
+    // the element 2, which throws, and leaves both as they were.
+    v[1].x = 2;
+    auto const b = v;
+    EXPECT_THROW(v[0].x = 5, std::runtime_error);
+    EXPECT_EQ(v.use_count(), 2u);
+    EXPECT_EQ(b.cbegin()->x, 0);
+}
+
+TEST(cow_vector, copies_across_threads)
+{
+    // Copies of one vector are copied and destroyed on several threads at
+    // once.
+    vec_type const message(100, "payload");
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&message] {
+            for (int i = 0; i < 10000; ++i) {
+                vec_type copy = message;
+                EXPECT_EQ(copy.size(), 100u);
+                if (i % 1000 == 0) {
+                    copy[0] = "changed";
+                    EXPECT_EQ(copy.use_count(), 1u);
+                }
+            }
+        });
+    }
+    for (auto & t : threads) {
+        t.join();
+    }
+    EXPECT_EQ(message.use_count(), 1u);
+    EXPECT_EQ(message[0], "payload");
+}
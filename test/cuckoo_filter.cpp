@@ -0,0 +1,113 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/cuckoo_filter.hpp>
+
+#include <gtest/gtest.h>
+
+#include <iterator>
+#include <string>
+#include <vector>
+
+
+namespace bsi = boost::stl_interfaces;
+
+TEST(cuckoo_filter, insert_contains_erase)
+{
+    bsi::cuckoo_filter<int> f(10000);
+    EXPECT_TRUE(f.empty());
+    EXPECT_GE(f.slot_count(), 10000u);
+    EXPECT_FALSE(f.contains(3));
+    for (int i = 0; i < 10000; ++i) {
+        ASSERT_TRUE(f.insert(i * 3));
+    }
+    EXPECT_EQ(f.size(), 10000u);
+    for (int i = 0; i < 10000; ++i) {
+        ASSERT_TRUE(f.contains(i * 3));
+    }
+    for (int i = 0; i < 10000; i += 2) {
+        ASSERT_TRUE(f.erase(i * 3));
+    }
+    EXPECT_EQ(f.size(), 5000u);
+    for (int i = 1; i < 10000; i += 2) {
+        ASSERT_TRUE(f.contains(i * 3));
+    }
+    int false_positives = 0;
+    for (int i = 0; i < 10000; i += 2) {
+        false_positives += f.contains(i * 3);
+    }
+    EXPECT_LT(false_positives, 10);
+
+    // A key inserted twice is erased once at a time.
+    ASSERT_TRUE(f.insert(-1));
+    ASSERT_TRUE(f.insert(-1));
+    EXPECT_TRUE(f.erase(-1));
+    EXPECT_TRUE(f.contains(-1));
+    EXPECT_TRUE(f.erase(-1));
+    EXPECT_FALSE(f.contains(-1));
+    EXPECT_FALSE(f.erase(-1));
+
+    f.clear();
+    EXPECT_TRUE(f.empty());
+    EXPECT_FALSE(f.contains(3));
+}
+
+TEST(cuckoo_filter, false_positive_rate)
+{
+    bsi::cuckoo_filter<int> f(100000);
+    for (int i = 0; i < 100000; ++i) {
+        ASSERT_TRUE(f.insert(i));
+    }
+    int false_positives = 0;
+    for (int i = 100000; i < 1100000; ++i) {
+        false_positives += f.contains(i);
+    }
+    // About 8 / 2^16 of 1M, scaled down by the load.
+    EXPECT_LT(false_positives, 200);
+}
+
+TEST(cuckoo_filter, full)
+{
+    bsi::cuckoo_filter<int> f(1000);
+    int inserted = 0;
+    while (f.insert(inserted)) {
+        ++inserted;
+    }
+    EXPECT_EQ(f.size(), std::size_t(inserted));
+    EXPECT_GT(inserted, int(f.slot_count() * 9 / 10));
+    EXPECT_LE(inserted, int(f.slot_count()) + 1);
+    for (int i = 0; i < inserted; ++i) {
+        ASSERT_TRUE(f.contains(i));
+    }
+
+    // Erasing makes room again, and keeps every other key.
+    for (int i = 0; i < inserted; i += 4) {
+        ASSERT_TRUE(f.erase(i));
+    }
+    for (int i = 1; i < inserted; i += 4) {
+        ASSERT_TRUE(f.contains(i));
+    }
+    EXPECT_TRUE(f.insert(-1));
+    EXPECT_TRUE(f.contains(-1));
+}
+
+TEST(cuckoo_filter, batch_contains)
+{
+    bsi::cuckoo_filter<std::string> f(1000);
+    std::vector<std::string> keys;
+    for (int i = 0; i < 1000; ++i) {
+        keys.push_back(std::to_string(i));
+    }
+    for (int i = 0; i < 500; ++i) {
+        f.insert(keys[std::size_t(i)]);
+    }
+    std::vector<bool> batch(keys.size());
+    auto const out = f.contains(keys.begin(), keys.end(), batch.begin());
+    EXPECT_TRUE(out == batch.end());
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        ASSERT_EQ(batch[i], f.contains(keys[i]));
+        ASSERT_TRUE(500 <= i || batch[i]);
+    }
+}
@@ -0,0 +1,103 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/cycle_view.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <string>
+#include <vector>
+
+
+namespace bsi = boost::stl_interfaces;
+
+using cyclic = bsi::cyclic_iterator<char const *>;
+using fixed_cyclic = bsi::cyclic_iterator<int *, 4>;
+
+static_assert(
+    std::is_same<
+        std::iterator_traits<cyclic>::iterator_category,
+        std::random_access_iterator_tag>::value,
+    "");
+static_assert(std::is_same<cyclic::reference, char const &>::value, "");
+static_assert(sizeof(fixed_cyclic) < sizeof(cyclic), "");
+
+// The period is 3, which is not a power of two, and the view is long enough
+// to wrap several times.
+TEST(cycle_view, runtime_period)
+{
+    std::string const foo = "foo";
+    auto const v = bsi::make_cycle_view(foo, 8);
+    EXPECT_EQ(v.size(), 8);
+    EXPECT_EQ(v.period(), 3);
+    EXPECT_EQ(std::string(v.begin(), v.end()), "foofoofo");
+    EXPECT_EQ(v[7], 'o');
+    EXPECT_EQ(v[6], 'f');
+
+    std::string reversed(
+        std::make_reverse_iterator(v.end()),
+        std::make_reverse_iterator(v.begin()));
+    EXPECT_EQ(reversed, "ofoofoof");
+
+    auto it = v.begin();
+    it += 5;
+    EXPECT_EQ(*it, 'o');
+    ++it;
+    EXPECT_EQ(*it, 'f');
+    --it;
+    --it;
+    EXPECT_EQ(*it, 'o');
+    EXPECT_EQ(it - v.begin(), 4);
+    EXPECT_TRUE(v.begin() < it);
+    EXPECT_EQ(it + 4, v.end());
+}
+
+TEST(cycle_view, power_of_two_period)
+{
+    std::vector<int> const pattern = {0, 1, 2, 3};
+    auto const v = bsi::make_cycle_view(pattern, 1000);
+    std::vector<int> out(v.begin(), v.end());
+    ASSERT_EQ(out.size(), 1000u);
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_EQ(out[i], i % 4);
+    }
+    EXPECT_EQ(v[997], 1);
+    EXPECT_EQ(*(v.end() - 1), 3);
+}
+
+TEST(cycle_view, compile_time_period)
+{
+    std::array<int, 4> pattern = {{5, 6, 7, 8}};
+    auto const v = bsi::make_cycle_view<4>(pattern, 10);
+    EXPECT_TRUE(std::equal(
+        v.begin(),
+        v.end(),
+        std::vector<int>{5, 6, 7, 8, 5, 6, 7, 8, 5, 6}.begin()));
+
+    // The elements are mutable if the underlying ones are.
+    fixed_cyclic it(pattern.data(), 4, 6);
+    *it = 70;
+    EXPECT_EQ(pattern[2], 70);
+    EXPECT_EQ(it.period(), 4);
+
+    bsi::cycle_view<int *, 3> odd(pattern.data(), pattern.data() + 3, 7);
+    EXPECT_EQ(
+        std::vector<int>(odd.begin(), odd.end()),
+        (std::vector<int>{5, 6, 70, 5, 6, 70, 5}));
+}
+
+TEST(cycle_view, empty_and_single)
+{
+    std::string const x = "x";
+    auto const empty = bsi::make_cycle_view(x, 0);
+    EXPECT_TRUE(empty.empty());
+    EXPECT_EQ(empty.begin(), empty.end());
+
+    auto const xs = bsi::make_cycle_view(x, 3);
+    EXPECT_EQ(std::string(xs.begin(), xs.end()), "xxx");
+}
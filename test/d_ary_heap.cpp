@@ -0,0 +1,175 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/d_ary_heap.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <random>
+#include <string>
+#include <vector>
+
+
+namespace bsi = boost::stl_interfaces;
+
+// Instantiate all the members we can.
+template struct bsi::d_ary_heap<int>;
+template struct bsi::d_ary_heap<int, 2, std::greater<int>>;
+template struct bsi::d_ary_heap<std::string, 8>;
+
+static_assert(
+    std::is_same<bsi::d_ary_heap<int>::iterator, int const *>::value, "");
+static_assert(sizeof(bsi::d_ary_heap<int>) == sizeof(std::vector<int>), "");
+
+// Checks the heap property directly.
+template<typename T, std::size_t D, typename Compare>
+bool is_heap(bsi::d_ary_heap<T, D, Compare> const & h)
+{
+    for (std::size_t i = 1; i < h.size(); ++i) {
+        if (h.value_comp()(h[(i - 1) / D], h[i]))
+            return false;
+    }
+    return true;
+}
+
+template<typename T, std::size_t D, typename Compare>
+std::vector<T> drain(bsi::d_ary_heap<T, D, Compare> h)
+{
+    std::vector<T> retval;
+    while (!h.empty()) {
+        retval.push_back(h.top());
+        h.pop();
+    }
+    return retval;
+}
+
+
+TEST(d_ary_heap, basics)
+{
+    bsi::d_ary_heap<int> h;
+    EXPECT_TRUE(h.empty());
+    EXPECT_EQ(h.begin(), h.end());
+
+    h.push(3);
+    h.push(7);
+    h.emplace(1);
+    int const five = 5;
+    h.push(five);
+    EXPECT_EQ(h.size(), 4u);
+    EXPECT_EQ(h.top(), 7);
+    EXPECT_EQ(h.data(), &*h.begin());
+    EXPECT_TRUE(is_heap(h));
+
+    h.pop();
+    EXPECT_EQ(h.top(), 5);
+    h.replace_top(0);
+    EXPECT_EQ(h.top(), 3);
+    EXPECT_EQ(drain(h), (std::vector<int>{3, 1, 0}));
+
+    h.pop();
+    h.pop();
+    h.pop();
+    EXPECT_TRUE(h.empty());
+}
+
+TEST(d_ary_heap, min_heap)
+{
+    bsi::d_ary_heap<int, 2, std::greater<int>> h = {5, 2, 8, 1, 9, 3};
+    EXPECT_TRUE(is_heap(h));
+    EXPECT_EQ(h.top(), 1);
+    EXPECT_EQ(drain(h), (std::vector<int>{1, 2, 3, 5, 8, 9}));
+
+    bsi::d_ary_heap<int, 2, std::greater<int>> other;
+    swap(h, other);
+    EXPECT_TRUE(h.empty());
+    EXPECT_EQ(other.size(), 6u);
+}
+
+TEST(d_ary_heap, push_range)
+{
+    std::mt19937 gen(42);
+    std::vector<int> values(1000);
+    for (auto & x : values) {
+        x = std::uniform_int_distribution<int>(0, 500)(gen);
+    }
+
+    // Into an empty heap, and a big one, with Floyd's method; and a few
+    // into a big heap, by sifting up.
+    bsi::d_ary_heap<int> h;
+    h.push_range(values.begin(), values.begin() + 400);
+    EXPECT_TRUE(is_heap(h));
+    h.push_range(values.begin() + 400, values.begin() + 990);
+    EXPECT_TRUE(is_heap(h));
+    h.push_range(values.begin() + 990, values.end());
+    EXPECT_TRUE(is_heap(h));
+    h.push_range({1000, -1});
+    EXPECT_TRUE(is_heap(h));
+    EXPECT_EQ(h.top(), 1000);
+
+    values.push_back(1000);
+    values.push_back(-1);
+    std::sort(values.begin(), values.end(), std::greater<int>());
+    EXPECT_EQ(drain(h), values);
+}
+
+TEST(d_ary_heap, random_edits)
+{
+    // Random pushes, pops, and erasures, checked against an unsorted
+    // std::vector, and at the end against std::priority_queue.
+    std::mt19937 gen(42);
+    bsi::d_ary_heap<int, 4> h;
+    std::vector<int> expected;
+    for (int step = 0; step < 5000; ++step) {
+        auto const op = std::uniform_int_distribution<int>(0, 3)(gen);
+        if (op < 2 || expected.empty()) {
+            int const x = std::uniform_int_distribution<int>(0, 1000)(gen);
+            h.push(x);
+            expected.push_back(x);
+        } else if (op == 2) {
+            auto const it = std::max_element(expected.begin(), expected.end());
+            EXPECT_EQ(h.top(), *it);
+            h.pop();
+            expected.erase(it);
+        } else {
+            auto const i = std::uniform_int_distribution<std::size_t>(
+                0, h.size() - 1)(gen);
+            auto const it =
+                std::find(expected.begin(), expected.end(), h[i]);
+            ASSERT_NE(it, expected.end());
+            expected.erase(it);
+            h.erase(h.begin() + i);
+        }
+        ASSERT_EQ(h.size(), expected.size());
+        ASSERT_TRUE(is_heap(h));
+    }
+
+    std::priority_queue<int> pq(expected.begin(), expected.end());
+    std::vector<int> pq_order;
+    while (!pq.empty()) {
+        pq_order.push_back(pq.top());
+        pq.pop();
+    }
+    EXPECT_EQ(drain(h), pq_order);
+}
+
+TEST(d_ary_heap, non_trivial_elements)
+{
+    bsi::d_ary_heap<std::string, 8> h;
+    for (int i = 0; i < 100; ++i) {
+        h.push(std::string(20, char('a' + i % 26)) + std::to_string(i));
+    }
+    EXPECT_EQ(h.top(), std::string(20, 'z') + "77");
+    EXPECT_TRUE(is_heap(h));
+
+    auto copy = h;
+    EXPECT_EQ(drain(copy), drain(h));
+    auto moved = std::move(copy);
+    EXPECT_EQ(moved.size(), 100u);
+    moved.clear();
+    EXPECT_TRUE(moved.empty());
+}
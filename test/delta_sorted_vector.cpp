@@ -0,0 +1,173 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/delta_sorted_vector.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+namespace bsi = boost::stl_interfaces;
+
+using vec_type = bsi::delta_sorted_vector<int>;
+
+template<typename V, typename Set>
+void check(V const & v, Set const & expected)
+{
+    ASSERT_EQ(v.size(), expected.size());
+    ASSERT_EQ(v.empty(), expected.empty());
+    EXPECT_TRUE(std::equal(v.begin(), v.end(), expected.begin()));
+    EXPECT_TRUE(std::equal(v.rbegin(), v.rend(), expected.rbegin()));
+    EXPECT_EQ(
+        std::distance(v.begin(), v.end()), std::ptrdiff_t(expected.size()));
+}
+
+TEST(delta_sorted_vector, basics)
+{
+    vec_type v = {5, 1, 3};
+    EXPECT_EQ(v.delta_size(), 0u);
+    EXPECT_EQ(*v.insert(4), 4);
+    EXPECT_EQ(*v.insert(0), 0);
+    EXPECT_EQ(*v.emplace(3), 3);
+    EXPECT_EQ(v.delta_size(), 3u);
+    check(v, std::multiset<int>{0, 1, 3, 3, 4, 5});
+
+    EXPECT_EQ(v.front(), 0);
+    EXPECT_EQ(v.back(), 5);
+    EXPECT_EQ(v.count(3), 2u);
+    EXPECT_EQ(v.count(2), 0u);
+    EXPECT_TRUE(v.contains(4));
+    EXPECT_TRUE(v.find(2) == v.end());
+    EXPECT_EQ(*v.lower_bound(2), 3);
+    EXPECT_EQ(*v.upper_bound(3), 4);
+    auto const range = v.equal_range(3);
+    EXPECT_EQ(std::distance(range.first, range.second), 2);
+
+    vec_type const copy = v;
+    EXPECT_TRUE(copy == v);
+    v.compact();
+    EXPECT_EQ(v.delta_size(), 0u);
+    EXPECT_TRUE(copy == v);
+
+    EXPECT_EQ(v.erase(3), 2u);
+    auto const it = v.erase(v.begin());
+    EXPECT_EQ(*it, 1);
+    check(v, std::multiset<int>{1, 4, 5});
+    EXPECT_TRUE(v < copy || copy < v);
+    v.clear();
+    EXPECT_TRUE(v.empty());
+    EXPECT_TRUE(v.begin() == v.end());
+}
+
+TEST(delta_sorted_vector, random_against_multiset)
+{
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> values(0, 5000);
+    vec_type v;
+    std::multiset<int> expected;
+    for (int round = 0; round < 4; ++round) {
+        for (int i = 0; i < 10000; ++i) {
+            int const x = values(gen);
+            auto const it = v.insert(x);
+            expected.insert(x);
+            ASSERT_EQ(*it, x);
+            ASSERT_TRUE(std::next(it) == v.upper_bound(x));
+            ASSERT_LE(v.delta_size(), 200u);
+        }
+        check(v, expected);
+        for (int i = 0; i < 3000; ++i) {
+            int const x = values(gen);
+            ASSERT_EQ(v.count(x), expected.count(x));
+            ASSERT_EQ(v.erase(x), expected.erase(x));
+        }
+        check(v, expected);
+        for (int x = 0; x <= 5000; x += 7) {
+            auto const it = v.lower_bound(x);
+            auto const expected_it = expected.lower_bound(x);
+            ASSERT_EQ(
+                std::distance(v.begin(), it),
+                std::distance(expected.begin(), expected_it));
+        }
+    }
+
+    // Erasing through the returned iterators visits every element.
+    auto it = v.begin();
+    std::size_t i = 0;
+    while (it != v.end()) {
+        if (i++ % 3) {
+            auto const x = *it;
+            it = v.erase(it);
+            expected.erase(expected.find(x));
+        } else {
+            ++it;
+        }
+    }
+    check(v, expected);
+    auto const first = std::next(v.begin(), 10);
+    auto const last = std::next(v.begin(), 500);
+    auto const after = v.erase(first, last);
+    expected.erase(
+        std::next(expected.begin(), 10), std::next(expected.begin(), 500));
+    EXPECT_EQ(std::distance(v.begin(), after), 10);
+    check(v, expected);
+}
+
+TEST(delta_sorted_vector, equal_elements_keep_insertion_order)
+{
+    using pair = std::pair<int, int>;
+    struct by_first
+    {
+        bool operator()(pair const & lhs, pair const & rhs) const
+        {
+            return lhs.first < rhs.first;
+        }
+    };
+    bsi::delta_sorted_vector<pair, by_first> v(
+        {{1, 0}, {0, 0}, {1, 1}, {0, 1}});
+    std::vector<pair> expected = {{0, 0}, {0, 1}, {1, 0}, {1, 1}};
+    EXPECT_TRUE(std::equal(v.begin(), v.end(), expected.begin()));
+    for (int i = 2; i < 300; ++i) {
+        auto const it = v.insert(pair(i % 2, i));
+        EXPECT_EQ(it->second, i);
+        expected.insert(
+            std::upper_bound(
+                expected.begin(), expected.end(), pair(i % 2, i), by_first{}),
+            pair(i % 2, i));
+        ASSERT_TRUE(std::equal(v.begin(), v.end(), expected.begin()));
+    }
+    std::vector<pair> const bulk = {{1, -1}, {0, -1}, {1, -2}};
+    v.insert(bulk.begin(), bulk.end());
+    for (auto const & x : bulk) {
+        expected.insert(
+            std::upper_bound(expected.begin(), expected.end(), x, by_first{}),
+            x);
+    }
+    EXPECT_TRUE(std::equal(v.begin(), v.end(), expected.begin()));
+    EXPECT_TRUE(std::equal(v.rbegin(), v.rend(), expected.rbegin()));
+}
+
+TEST(delta_sorted_vector, strings_and_comparator)
+{
+    bsi::delta_sorted_vector<std::string, std::greater<std::string>> v;
+    std::multiset<std::string, std::greater<std::string>> expected;
+    for (int i = 0; i < 1000; ++i) {
+        auto const x = std::to_string(i * 7919 % 1009);
+        v.insert(x);
+        expected.insert(x);
+    }
+    check(v, expected);
+    EXPECT_EQ(v.front(), "999");
+    bsi::delta_sorted_vector<std::string, std::greater<std::string>> other;
+    swap(v, other);
+    EXPECT_TRUE(v.empty());
+    check(other, expected);
+}
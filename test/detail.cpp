@@ -6,6 +6,7 @@
 #include <boost/stl_interfaces/iterator_interface.hpp>
 #include <boost/stl_interfaces/view_interface.hpp>
 #include <boost/stl_interfaces/container_interface.hpp>
+#include <boost/stl_interfaces/reverse_iterator.hpp>
 
 #include <boost/mpl/assert.hpp>
 
@@ -73,6 +74,101 @@ static_assert(v1_dtl::common_range<std::list<double>>::value, "");
 static_assert(!v1_dtl::common_range<ridiculous_range>::value, "");
 
 
+// The interfaces add no storage, and keep the derived iterators trivially
+// copyable and standard layout, so that they are passed in registers.
+namespace bsi = boost::stl_interfaces;
+
+struct ptr_iter : bsi::iterator_interface<
+                      ptr_iter,
+                      std::random_access_iterator_tag,
+                      int>
+{
+    ptr_iter() = default;
+    constexpr ptr_iter(int * p) noexcept : p_(p) {}
+
+    constexpr int & operator*() const noexcept { return *p_; }
+    constexpr ptr_iter & operator+=(std::ptrdiff_t n) noexcept
+    {
+        p_ += n;
+        return *this;
+    }
+    friend constexpr std::ptrdiff_t
+    operator-(ptr_iter lhs, ptr_iter rhs) noexcept
+    {
+        return lhs.p_ - rhs.p_;
+    }
+
+    int * p_;
+};
+
+struct index_proxy_iter : bsi::proxy_iterator_interface<
+                              index_proxy_iter,
+                              std::random_access_iterator_tag,
+                              int>
+{
+    index_proxy_iter() = default;
+    constexpr index_proxy_iter(int i) noexcept : i_(i) {}
+
+    constexpr int operator*() const noexcept { return i_; }
+    constexpr index_proxy_iter & operator+=(std::ptrdiff_t n) noexcept
+    {
+        i_ += int(n);
+        return *this;
+    }
+    friend constexpr std::ptrdiff_t
+    operator-(index_proxy_iter lhs, index_proxy_iter rhs) noexcept
+    {
+        return lhs.i_ - rhs.i_;
+    }
+
+    int i_;
+};
+
+template<typename Iter, typename Storage>
+constexpr bool register_friendly()
+{
+    return sizeof(Iter) == sizeof(Storage) &&
+           std::is_trivially_copyable<Iter>::value &&
+           std::is_standard_layout<Iter>::value;
+}
+
+static_assert(
+    std::is_empty<bsi::iterator_interface<
+        ptr_iter,
+        std::random_access_iterator_tag,
+        int>>::value,
+    "");
+static_assert(register_friendly<ptr_iter, int *>(), "");
+static_assert(register_friendly<index_proxy_iter, int>(), "");
+static_assert(
+    std::is_trivially_copyable<bsi::proxy_arrow_result<int>>::value, "");
+static_assert(
+    std::is_standard_layout<bsi::proxy_arrow_result<int>>::value, "");
+static_assert(register_friendly<bsi::reverse_iterator<int *>, int *>(), "");
+static_assert(register_friendly<bsi::reverse_iterator<ptr_iter>, int *>(), "");
+static_assert(
+    register_friendly<
+        bsi::reverse_iterator<bsi::reverse_iterator<ptr_iter>>,
+        int *>(),
+    "");
+static_assert(
+    register_friendly<bsi::reverse_iterator<index_proxy_iter>, int>(), "");
+static_assert(
+    register_friendly<bsi::reverse_iterator<std::vector<int>::iterator>,
+                      int *>(),
+    "");
+
+// The converting constructor is constexpr and noexcept.
+constexpr bsi::reverse_iterator<int const *> const_rit =
+    bsi::reverse_iterator<int *>(nullptr);
+static_assert(const_rit.base() == nullptr, "");
+static_assert(
+    std::is_nothrow_constructible<
+        bsi::reverse_iterator<int const *>,
+        bsi::reverse_iterator<int *>>::value,
+    "");
+
+
 struct no_clear
 {};
 
@@ -0,0 +1,106 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/double_buffer.hpp>
+#include <boost/stl_interfaces/static_vector.hpp>
+
+#include <gtest/gtest.h>
+
+#include <numeric>
+#include <thread>
+#include <vector>
+
+
+namespace bsi = boost::stl_interfaces;
+
+TEST(double_buffer, publish_and_read)
+{
+    using vec = bsi::static_vector<int, 8>;
+    bsi::double_buffer<vec> db;
+    EXPECT_TRUE(db.can_publish());
+    EXPECT_FALSE(db.ready());
+
+    vec * const first = &db.back_buffer();
+    db.back_buffer().push_back(1);
+    db.back_buffer().push_back(2);
+    db.publish();
+    EXPECT_FALSE(db.can_publish());
+    EXPECT_TRUE(db.ready());
+    // The producer now fills the other buffer, which starts out empty.
+    EXPECT_NE(&db.back_buffer(), first);
+    EXPECT_TRUE(db.back_buffer().empty());
+    db.back_buffer().push_back(3);
+
+    {
+        auto const v = db.read();
+        EXPECT_FALSE(db.ready());
+        EXPECT_FALSE(db.can_publish());
+        EXPECT_EQ(&v.batch(), first);
+        EXPECT_EQ(v.size(), 2u);
+        EXPECT_EQ(v[0], 1);
+        EXPECT_EQ(v.back(), 2);
+    }
+    EXPECT_TRUE(db.can_publish());
+
+    db.publish();
+    // The buffer the consumer read is the back buffer again, cleared.
+    EXPECT_EQ(&db.back_buffer(), first);
+    EXPECT_TRUE(db.back_buffer().empty());
+    {
+        auto v = db.read();
+        bsi::double_buffer_view<vec> w(std::move(v));
+        ASSERT_EQ(w.size(), 1u);
+        EXPECT_EQ(w[0], 3);
+        v = std::move(w);
+        EXPECT_EQ(v.front(), 3);
+    }
+    EXPECT_TRUE(db.can_publish());
+}
+
+TEST(double_buffer, capacity)
+{
+    std::vector<int> back, front;
+    back.reserve(100);
+    front.reserve(200);
+    bsi::double_buffer<std::vector<int>> db(std::move(back), std::move(front));
+    EXPECT_EQ(db.back_buffer().capacity(), 100u);
+    db.back_buffer().assign(50, 1);
+    db.publish();
+    // Clearing the old front buffer keeps its capacity.
+    EXPECT_EQ(db.back_buffer().capacity(), 200u);
+    EXPECT_EQ(db.read().size(), 50u);
+}
+
+TEST(double_buffer, threads)
+{
+    constexpr int batches = 2000;
+    constexpr int batch_size = 100;
+    bsi::double_buffer<std::vector<int>> db;
+
+    std::thread producer([&] {
+        for (int i = 0; i < batches; ++i) {
+            auto & batch = db.back_buffer();
+            EXPECT_TRUE(batch.empty());
+            for (int j = 0; j < batch_size; ++j) {
+                batch.push_back(i);
+            }
+            db.publish();
+        }
+    });
+
+    long long sum = 0;
+    int bad_batches = 0;
+    for (int i = 0; i < batches; ++i) {
+        auto const batch = db.read();
+        bad_batches += batch.size() != std::size_t(batch_size) ||
+                       batch.front() != i || batch.back() != i;
+        sum += std::accumulate(batch.begin(), batch.end(), 0ll);
+    }
+    producer.join();
+
+    EXPECT_EQ(bad_batches, 0);
+    EXPECT_EQ(sum, (long long)batch_size * batches * (batches - 1) / 2);
+    EXPECT_TRUE(db.can_publish());
+}
@@ -0,0 +1,194 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/stl_interfaces/encoded_column.hpp>
+
+#include <gtest/gtest.h>
+
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+
+namespace bsi = boost::stl_interfaces;
+using bsi::dict_encoded_column;
+using bsi::dict_encoded_iterator;
+using bsi::rle_column;
+using bsi::rle_iterator;
+
+using dict_iter = dict_encoded_iterator<std::string, std::uint8_t>;
+using rle_iter = rle_iterator<int>;
+
+static_assert(
+    std::is_same<
+        std::iterator_traits<dict_iter>::iterator_category,
+        std::random_access_iterator_tag>::value,
+    "");
+static_assert(
+    std::is_same<
+        std::iterator_traits<dict_iter>::reference,
+        std::string const &>::value,
+    "");
+static_assert(
+    std::is_same<
+        std::iterator_traits<rle_iter>::iterator_category,
+        std::random_access_iterator_tag>::value,
+    "");
+static_assert(bsi::is_segmented_iterator<rle_iter>::value, "");
+static_assert(!bsi::is_segmented_iterator<dict_iter>::value, "");
+
+std::vector<int> random_runs(std::size_t runs, int max_length)
+{
+    std::mt19937 gen(42);
+    std::vector<int> retval;
+    for (std::size_t i = 0; i < runs; ++i) {
+        auto const length =
+            std::uniform_int_distribution<int>(1, max_length)(gen);
+        // Equal neighbors merge into one run.
+        auto const value = std::uniform_int_distribution<int>(0, 5)(gen);
+        retval.insert(retval.end(), length, value);
+    }
+    return retval;
+}
+
+
+TEST(dict_encoded, empty)
+{
+    std::vector<int> const v;
+    dict_encoded_column<int> const column(v.begin(), v.end());
+    auto const view = column.view();
+    EXPECT_TRUE(view.empty());
+    EXPECT_EQ(view.begin(), view.end());
+    EXPECT_EQ(view.count(0), 0);
+    EXPECT_EQ(view.code_of(0), 0u);
+}
+
+TEST(dict_encoded, strings)
+{
+    std::vector<std::string> v;
+    for (int i = 0; i < 1000; ++i) {
+        v.push_back("value " + std::to_string(i * 7919 % 37));
+    }
+    dict_encoded_column<std::string, std::uint8_t> const column(
+        v.begin(), v.end());
+    auto const view = column.view();
+    EXPECT_EQ(view.size(), 1000);
+    EXPECT_EQ(view.dictionary_size(), 37u);
+    EXPECT_TRUE(std::is_sorted(
+        view.dictionary(), view.dictionary() + view.dictionary_size()));
+    EXPECT_TRUE(std::equal(view.begin(), view.end(), v.begin(), v.end()));
+    EXPECT_EQ(view[500], v[500]);
+    EXPECT_EQ(view.begin()[999], v[999]);
+    EXPECT_EQ((view.end() - 3)->size(), v[997].size());
+
+    for (int i = 0; i < 40; ++i) {
+        auto const x = "value " + std::to_string(i);
+        EXPECT_EQ(view.count(x), std::count(v.begin(), v.end(), x));
+    }
+    EXPECT_EQ(view.code_of("nothing"), view.dictionary_size());
+
+    std::vector<std::string> decoded(v.size());
+    EXPECT_EQ(
+        bsi::copy(view.begin() + 10, view.end(), decoded.data()),
+        decoded.data() + 990);
+    EXPECT_TRUE(std::equal(v.begin() + 10, v.end(), decoded.begin()));
+
+    std::vector<std::size_t> sizes(v.size());
+    bsi::transform(
+        view.begin(),
+        view.end(),
+        sizes.data(),
+        [](std::string const & s) { return s.size(); });
+    EXPECT_EQ(sizes[3], v[3].size());
+}
+
+TEST(dict_encoded, too_many_values)
+{
+    std::vector<int> v(300);
+    std::iota(v.begin(), v.end(), 0);
+    EXPECT_THROW(
+        (dict_encoded_column<int, std::uint8_t>(v.begin(), v.end())),
+        std::length_error);
+    dict_encoded_column<int> const column(v.begin(), v.end());
+    EXPECT_EQ(column.view().dictionary_size(), 300u);
+}
+
+TEST(rle, empty)
+{
+    std::vector<int> const v;
+    rle_column<int> const column(v.begin(), v.end());
+    auto const view = column.view();
+    EXPECT_TRUE(view.empty());
+    EXPECT_EQ(view.run_count(), 0);
+    EXPECT_EQ(view.begin(), view.end());
+    EXPECT_EQ(bsi::segmented_accumulate(view.begin(), view.end(), 0), 0);
+    EXPECT_EQ(bsi::segmented_find(view.begin(), view.end(), 0), view.end());
+}
+
+TEST(rle, iteration)
+{
+    auto const v = random_runs(300, 20);
+    rle_column<int> const column(v.begin(), v.end());
+    auto const view = column.view();
+    EXPECT_EQ(std::size_t(view.size()), v.size());
+    EXPECT_LT(std::size_t(view.run_count()), v.size() / 5);
+    EXPECT_TRUE(std::equal(view.begin(), view.end(), v.begin(), v.end()));
+
+    // Random access, including long jumps and steps backward.
+    std::vector<int> reversed(
+        std::make_reverse_iterator(view.end()),
+        std::make_reverse_iterator(view.begin()));
+    EXPECT_TRUE(std::equal(reversed.rbegin(), reversed.rend(), v.begin()));
+    std::mt19937 gen(7);
+    auto it = view.begin();
+    std::ptrdiff_t i = 0;
+    for (int step = 0; step < 2000; ++step) {
+        auto const j = std::uniform_int_distribution<std::ptrdiff_t>(
+            0, std::ptrdiff_t(v.size()) - 1)(gen);
+        it += j - i;
+        i = j;
+        ASSERT_EQ(*it, v[i]);
+        ASSERT_EQ(it - view.begin(), i);
+        ASSERT_EQ(view[j], v[j]);
+    }
+    EXPECT_EQ(view.begin() + std::ptrdiff_t(v.size()), view.end());
+}
+
+TEST(rle, segmented_algorithms)
+{
+    auto const v = random_runs(50, 6);
+    rle_column<int> const column(v.begin(), v.end());
+    auto const view = column.view();
+    auto const n = std::ptrdiff_t(v.size());
+    for (std::ptrdiff_t first = 0; first <= n; first += 3) {
+        for (std::ptrdiff_t last = first; last <= n; last += 5) {
+            auto const f = view.begin() + first;
+            auto const l = view.begin() + last;
+            EXPECT_EQ(
+                bsi::segmented_accumulate(f, l, 0),
+                std::accumulate(v.begin() + first, v.begin() + last, 0));
+            std::vector<int> copied;
+            bsi::segmented_copy(f, l, std::back_inserter(copied));
+            EXPECT_TRUE(std::equal(
+                copied.begin(),
+                copied.end(),
+                v.begin() + first,
+                v.begin() + last));
+            for (int x = 0; x <= 6; ++x) {
+                EXPECT_EQ(
+                    bsi::segmented_find(f, l, x) - view.begin(),
+                    std::find(v.begin() + first, v.begin() + last, x) -
+                        v.begin());
+            }
+
+            std::vector<int> decoded(last - first);
+            bsi::copy(f, l, decoded.data());
+            EXPECT_TRUE(std::equal(
+                decoded.begin(), decoded.end(), v.begin() + first));
+        }
+    }
+}
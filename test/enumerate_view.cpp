@@ -0,0 +1,112 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/enumerate_view.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <list>
+#include <string>
+#include <vector>
+
+
+namespace bsi = boost::stl_interfaces;
+
+using ptr_enumerate_iter = bsi::enumerate_iterator<int *>;
+using list_enumerate_iter = bsi::enumerate_iterator<std::list<int>::iterator>;
+
+static_assert(
+    std::is_same<
+        ptr_enumerate_iter::reference,
+        std::pair<std::ptrdiff_t, int &>>::value,
+    "");
+static_assert(
+    std::is_same<
+        ptr_enumerate_iter::value_type,
+        std::pair<std::ptrdiff_t, int>>::value,
+    "");
+static_assert(
+    std::is_same<
+        ptr_enumerate_iter::iterator_category,
+        std::random_access_iterator_tag>::value,
+    "");
+static_assert(
+    std::is_same<
+        list_enumerate_iter::iterator_category,
+        std::forward_iterator_tag>::value,
+    "");
+
+// A random access enumerate_iterator keeps no counter.
+static_assert(sizeof(ptr_enumerate_iter) == 2 * sizeof(int *), "");
+
+
+TEST(enumerate_view, random_access)
+{
+    std::vector<int> ints = {10, 20, 30};
+    auto const v = bsi::make_enumerate_view(ints);
+    EXPECT_EQ(v.size(), 3);
+
+    std::vector<std::ptrdiff_t> indices;
+    std::vector<int> values;
+    for (auto p : v) {
+        indices.push_back(p.first);
+        values.push_back(p.second);
+    }
+    EXPECT_EQ(indices, (std::vector<std::ptrdiff_t>{0, 1, 2}));
+    EXPECT_EQ(values, ints);
+
+    EXPECT_EQ(v[2].first, 2);
+    EXPECT_EQ(v[2].second, 30);
+    auto it = v.end();
+    --it;
+    EXPECT_EQ(it.index(), 2);
+    EXPECT_EQ((*it).second, 30);
+    EXPECT_EQ(v.end() - v.begin(), 3);
+    EXPECT_EQ((v.begin() + 1).index(), 1);
+    EXPECT_EQ((v.begin() + 1).base(), ints.begin() + 1);
+
+    // Writes go through to the underlying elements.
+    for (auto p : v) {
+        p.second += int(p.first);
+    }
+    EXPECT_EQ(ints, (std::vector<int>{10, 21, 32}));
+}
+
+TEST(enumerate_view, forward)
+{
+    std::list<std::string> strings = {"a", "b", "c"};
+    auto const v = bsi::make_enumerate_view(strings);
+
+    std::string result;
+    for (auto p : v) {
+        result += std::to_string(p.first) + p.second;
+    }
+    EXPECT_EQ(result, "0a1b2c");
+    EXPECT_EQ(std::distance(v.begin(), v.end()), 3);
+
+    auto it = v.begin();
+    ++it;
+    EXPECT_EQ(it.index(), 1);
+    EXPECT_EQ(*it.base(), "b");
+
+    std::list<int> empty;
+    EXPECT_TRUE(bsi::make_enumerate_view(empty).empty());
+}
+
+TEST(enumerate_view, algorithms)
+{
+    std::vector<int> ints = {5, 3, 9, 1};
+    auto const v = bsi::make_enumerate_view(ints);
+
+    auto const it = std::find_if(v.begin(), v.end(), [](auto p) {
+        return p.second == 9;
+    });
+    EXPECT_EQ(it.index(), 2);
+
+    auto const odd_index_count = std::count_if(
+        v.begin(), v.end(), [](auto p) { return p.first % 2 == 1; });
+    EXPECT_EQ(odd_index_count, 2);
+}
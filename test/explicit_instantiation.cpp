@@ -0,0 +1,56 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include "explicit_instantiation.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+
+namespace bsi = boost::stl_interfaces;
+
+
+TEST(explicit_instantiation, reverse_iterator)
+{
+    int ints[] = {0, 1, 2, 3};
+    std::vector<int> vec(std::begin(ints), std::end(ints));
+    std::list<int> list(std::begin(ints), std::end(ints));
+
+    auto const first = bsi::make_reverse_iterator(std::end(ints));
+    auto const last = bsi::make_reverse_iterator(std::begin(ints));
+    EXPECT_EQ(last - first, 4);
+    EXPECT_EQ(first[1], 2);
+    EXPECT_TRUE(std::equal(
+        first,
+        last,
+        bsi::make_reverse_iterator(vec.end()),
+        bsi::make_reverse_iterator(vec.begin())));
+
+    bsi::reverse_iterator<std::list<int>::iterator> const list_first(
+        list.end());
+    bsi::reverse_iterator<std::list<int>::iterator> const list_last(
+        list.begin());
+    EXPECT_TRUE(std::equal(list_first, list_last, first, last));
+    EXPECT_TRUE(std::equal(
+        bsi::make_cached_reverse_iterator(list.end()),
+        bsi::make_cached_reverse_iterator(list.begin()),
+        first,
+        last));
+}
+
+TEST(explicit_instantiation, container_interface)
+{
+    bsi::static_vector<int, 16> v = {3, 1, 2};
+    v.push_back(0);
+    std::sort(v.begin(), v.end());
+    EXPECT_EQ(v.size(), 4u);
+    EXPECT_EQ(v.front(), 0);
+    EXPECT_EQ(v.back(), 3);
+    EXPECT_EQ(*v.rbegin(), 3);
+    v.erase(v.begin() + 1, v.end() - 1);
+    EXPECT_EQ(v, (bsi::static_vector<int, 16>{0, 3}));
+}
+
@@ -0,0 +1,37 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_STL_INTERFACES_EXPLICIT_INSTANTIATION_TESTING_HPP
+#define BOOST_STL_INTERFACES_EXPLICIT_INSTANTIATION_TESTING_HPP
+
+#include <boost/stl_interfaces/reverse_iterator.hpp>
+#include <boost/stl_interfaces/static_vector.hpp>
+
+#include <list>
+#include <vector>
+
+
+// A program that uses these specializations in many translation units can
+// declare them in a common header, like this one, and define them in one
+// translation unit, like explicit_instantiation_defs.cpp.  An explicit
+// instantiation definition instantiates every member that is not itself a
+// template, so the definitions check that each of those members is
+// well-formed for these types.
+
+extern template struct boost::stl_interfaces::reverse_iterator<int *>;
+extern template struct boost::stl_interfaces::reverse_iterator<int const *>;
+extern template struct boost::stl_interfaces::reverse_iterator<
+    std::vector<int>::iterator>;
+extern template struct boost::stl_interfaces::reverse_iterator<
+    std::list<int>::iterator>;
+extern template struct boost::stl_interfaces::cached_reverse_iterator<
+    std::list<int>::iterator>;
+
+extern template struct boost::stl_interfaces::static_vector<int, 16>;
+extern template struct boost::stl_interfaces::container_interface<
+    boost::stl_interfaces::static_vector<int, 16>,
+    boost::stl_interfaces::contiguous>;
+
+#endif
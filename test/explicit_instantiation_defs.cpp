@@ -0,0 +1,21 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include "explicit_instantiation.hpp"
+
+
+template struct boost::stl_interfaces::reverse_iterator<int *>;
+template struct boost::stl_interfaces::reverse_iterator<int const *>;
+template struct boost::stl_interfaces::reverse_iterator<
+    std::vector<int>::iterator>;
+template struct boost::stl_interfaces::reverse_iterator<
+    std::list<int>::iterator>;
+template struct boost::stl_interfaces::cached_reverse_iterator<
+    std::list<int>::iterator>;
+
+template struct boost::stl_interfaces::static_vector<int, 16>;
+template struct boost::stl_interfaces::container_interface<
+    boost::stl_interfaces::static_vector<int, 16>,
+    boost::stl_interfaces::contiguous>;
@@ -0,0 +1,117 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/stl_interfaces/eytzinger_set.hpp>
+
+#include <gtest/gtest.h>
+
+#include <numeric>
+#include <string>
+#include <vector>
+
+
+using boost::stl_interfaces::eytzinger_set;
+
+
+// Instantiate all the members we can.
+template struct eytzinger_set<int>;
+template struct eytzinger_set<std::string, std::greater<std::string>>;
+
+using set_t = eytzinger_set<int>;
+
+static_assert(
+    std::is_same<
+        std::iterator_traits<set_t::iterator>::iterator_category,
+        std::bidirectional_iterator_tag>::value,
+    "");
+
+
+TEST(eytzinger, default_ctor)
+{
+    set_t s;
+    EXPECT_TRUE(s.empty());
+    EXPECT_EQ(s.size(), 0u);
+    EXPECT_EQ(s.begin(), s.end());
+    EXPECT_EQ(s.find(0), s.end());
+    EXPECT_EQ(s.lower_bound(0), s.end());
+    EXPECT_EQ(s, s);
+}
+
+TEST(eytzinger, every_size)
+{
+    // The odd numbers below 2n, looked up with every number below 2n + 1.
+    for (int n = 0; n < 70; ++n) {
+        std::vector<int> sorted(n);
+        for (int i = 0; i < n; ++i) {
+            sorted[i] = 2 * i + 1;
+        }
+        set_t const s(sorted.rbegin(), sorted.rend());
+        ASSERT_EQ(s.size(), std::size_t(n));
+
+        EXPECT_EQ(std::vector<int>(s.begin(), s.end()), sorted);
+        EXPECT_EQ(
+            std::vector<int>(s.rbegin(), s.rend()),
+            std::vector<int>(sorted.rbegin(), sorted.rend()));
+
+        for (int x = 0; x <= 2 * n; ++x) {
+            auto const lb = std::lower_bound(sorted.begin(), sorted.end(), x);
+            auto const ub = std::upper_bound(sorted.begin(), sorted.end(), x);
+            auto const s_lb = s.lower_bound(x);
+            auto const s_ub = s.upper_bound(x);
+            if (lb == sorted.end())
+                EXPECT_EQ(s_lb, s.end());
+            else
+                EXPECT_EQ(*s_lb, *lb);
+            if (ub == sorted.end())
+                EXPECT_EQ(s_ub, s.end());
+            else
+                EXPECT_EQ(*s_ub, *ub);
+            EXPECT_EQ(s.contains(x), x % 2 == 1);
+            auto const range = s.equal_range(x);
+            EXPECT_EQ(std::distance(range.first, range.second), x % 2);
+        }
+    }
+}
+
+TEST(eytzinger, layout)
+{
+    std::vector<int> v(15);
+    std::iota(v.begin(), v.end(), 1);
+    set_t const s(v.begin(), v.end());
+    EXPECT_EQ(
+        s.elements(),
+        (std::vector<int>{
+            8, 4, 12, 2, 6, 10, 14, 1, 3, 5, 7, 9, 11, 13, 15}));
+
+    auto it = s.find(8);
+    EXPECT_EQ(it.node(), 1u);
+    EXPECT_EQ(*--it, 7);
+    EXPECT_EQ(it.node(), 11u);
+    EXPECT_EQ(*++++it, 9);
+    EXPECT_EQ(s.front(), 1);
+    EXPECT_EQ(s.back(), 15);
+}
+
+TEST(eytzinger, assign_swap_compare)
+{
+    set_t s = {3, 1, 2, 2, 1};
+    EXPECT_EQ(s.size(), 3u);
+    EXPECT_EQ(s, (set_t{1, 2, 3}));
+    s.assign({5, 4});
+    EXPECT_EQ(std::vector<int>(s.begin(), s.end()), (std::vector<int>{4, 5}));
+
+    set_t s2 = {1};
+    swap(s, s2);
+    EXPECT_EQ(s, (set_t{1}));
+    EXPECT_LT(s, s2);
+    s2.clear();
+    EXPECT_TRUE(s2.empty());
+
+    eytzinger_set<std::string, std::greater<std::string>> const strings = {
+        "b", "a", "c"};
+    EXPECT_EQ(strings.front(), "c");
+    EXPECT_EQ(*strings.lower_bound("bb"), "b");
+}
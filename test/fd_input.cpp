@@ -0,0 +1,155 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/stl_interfaces/fd_input_iterator.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+
+
+using boost::stl_interfaces::fd_input_iterator;
+using boost::stl_interfaces::fd_reader;
+
+
+char const * const path = "fd_input_test.bin";
+
+template<typename T>
+void write_file(std::vector<T> const & v, std::size_t extra = 0)
+{
+    std::ofstream ofs(path, std::ios::binary);
+    ofs.write(
+        reinterpret_cast<char const *>(v.data()), v.size() * sizeof(T));
+    for (std::size_t i = 0; i < extra; ++i) {
+        ofs.put('x');
+    }
+}
+
+struct fd_guard
+{
+    explicit fd_guard(int fd) : fd(fd) {}
+    ~fd_guard() { ::close(fd); }
+    int fd;
+};
+
+struct record
+{
+    std::uint32_t id;
+    char tag[9];
+};
+
+static_assert(
+    std::is_same<
+        std::iterator_traits<fd_input_iterator<int>>::iterator_category,
+        std::input_iterator_tag>::value,
+    "");
+
+
+TEST(fd_input, elements)
+{
+    std::vector<std::uint64_t> expected(100000);
+    std::iota(expected.begin(), expected.end(), 3u);
+    write_file(expected);
+
+    for (std::size_t block_size : {1, 4096, 10000, 1 << 20}) {
+        fd_guard file(::open(path, O_RDONLY));
+        ASSERT_LE(0, file.fd);
+        fd_reader<std::uint64_t> reader(file.fd, block_size);
+        auto elements = reader.elements();
+        std::vector<std::uint64_t> const result(
+            elements.begin(), elements.end());
+        EXPECT_EQ(result, expected) << "block_size=" << block_size;
+        EXPECT_EQ(reader.trailing_bytes(), 0u);
+        EXPECT_FALSE(reader.read_block());
+    }
+    std::remove(path);
+}
+
+TEST(fd_input, blocks)
+{
+    std::vector<record> expected(1000);
+    for (std::uint32_t i = 0; i < 1000; ++i) {
+        expected[i].id = i;
+        std::snprintf(expected[i].tag, sizeof(expected[i].tag), "r%u", i);
+    }
+    // Two bytes more than a whole number of records.
+    write_file(expected, 2);
+
+    fd_guard file(::open(path, O_RDONLY));
+    fd_reader<record> reader(file.fd, 4096);
+    std::uint32_t next = 0;
+    int blocks = 0;
+    for (auto block : reader.blocks()) {
+        EXPECT_FALSE(block.empty());
+        EXPECT_LE(block.size(), std::ptrdiff_t(4096 / sizeof(record)));
+        for (auto const & r : block) {
+            EXPECT_EQ(r.id, next);
+            EXPECT_STREQ(r.tag, expected[next].tag);
+            ++next;
+        }
+        ++blocks;
+    }
+    EXPECT_EQ(next, 1000u);
+    EXPECT_EQ(blocks, 4);
+    EXPECT_EQ(reader.trailing_bytes(), 2u);
+    std::remove(path);
+}
+
+TEST(fd_input, empty)
+{
+    write_file(std::vector<int>(), 3);
+    fd_guard file(::open(path, O_RDONLY));
+    fd_reader<int> reader(file.fd);
+    auto elements = reader.elements();
+    EXPECT_EQ(elements.begin(), elements.end());
+    EXPECT_EQ(reader.trailing_bytes(), 3u);
+    std::remove(path);
+}
+
+// A pipe delivers whatever has been written so far, so reads end in the
+// middle of elements.
+TEST(fd_input, pipe)
+{
+    int fds[2];
+    ASSERT_EQ(::pipe(fds), 0);
+    fd_guard read_end(fds[0]);
+
+    std::vector<std::uint32_t> expected(5000);
+    std::iota(expected.begin(), expected.end(), 0u);
+    std::thread writer([&] {
+        auto p = reinterpret_cast<char const *>(expected.data());
+        auto const last = p + expected.size() * 4;
+        while (p != last) {
+            auto const n = std::min<std::ptrdiff_t>(7, last - p);
+            EXPECT_EQ(::write(fds[1], p, n), n);
+            p += n;
+        }
+        ::close(fds[1]);
+    });
+
+    fd_reader<std::uint32_t> reader(read_end.fd, 1 << 16);
+    auto elements = reader.elements();
+    std::vector<std::uint32_t> const result(elements.begin(), elements.end());
+    writer.join();
+    EXPECT_EQ(result, expected);
+}
+
+TEST(fd_input, errors)
+{
+    fd_reader<int> reader(-1);
+    try {
+        reader.read_block();
+        ADD_FAILURE();
+    } catch (std::system_error const & e) {
+        EXPECT_EQ(e.code(), std::errc::bad_file_descriptor);
+    }
+}
@@ -0,0 +1,203 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/filter_view.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <forward_list>
+#include <functional>
+#include <random>
+#include <vector>
+
+
+namespace bsi = boost::stl_interfaces;
+
+auto const even = [](int x) { return x % 2 == 0; };
+using even_t = decltype(even);
+
+static_assert(
+    std::is_same<
+        std::iterator_traits<
+            bsi::filter_iterator<int *, even_t>>::iterator_category,
+        std::bidirectional_iterator_tag>::value,
+    "");
+static_assert(
+    std::is_same<
+        std::iterator_traits<bsi::filter_iterator<
+            std::forward_list<int>::iterator,
+            even_t>>::iterator_category,
+        std::forward_iterator_tag>::value,
+    "");
+static_assert(bsi::is_block_filter_predicate<even_t>::value, "");
+static_assert(
+    !bsi::is_block_filter_predicate<std::function<bool(int)>>::value, "");
+
+// A predicate with a large lookup table, as a bloom filter might have.
+struct in_table
+{
+    bool operator()(int x) const { return table[x & 255]; }
+
+    std::array<bool, 256> table;
+    std::vector<int> extra;
+};
+
+static_assert(
+    sizeof(bsi::filter_view<int *, in_table>::iterator) ==
+        2 * sizeof(void *),
+    "");
+static_assert(
+    sizeof(bsi::filter_view<int *, even_t>::iterator) ==
+        2 * sizeof(void *) + 2 * sizeof(std::uint64_t),
+    "");
+static_assert(
+    sizeof(bsi::filter_iterator<int *, in_table>) > sizeof(in_table), "");
+
+std::vector<int> random_ints(int n, int modulus)
+{
+    std::mt19937 gen(n);
+    std::uniform_int_distribution<int> dist(0, modulus - 1);
+    std::vector<int> retval(n);
+    for (auto & x : retval) {
+        x = dist(gen);
+    }
+    return retval;
+}
+
+template<typename View>
+std::vector<int> reversed(View & v)
+{
+    std::vector<int> retval;
+    auto const first = v.begin();
+    for (auto it = v.end(); it != first;) {
+        retval.push_back(*--it);
+    }
+    return retval;
+}
+
+
+TEST(filter_view, basic)
+{
+    std::vector<int> ints = {0, 1, 2, 3, 4, 5, 6, 7};
+    auto v = bsi::make_filter_view(ints, even);
+    EXPECT_EQ(
+        std::vector<int>(v.begin(), v.end()), (std::vector<int>{0, 2, 4, 6}));
+    EXPECT_EQ(reversed(v), (std::vector<int>{6, 4, 2, 0}));
+    EXPECT_EQ(v.begin().base(), ints.data());
+    EXPECT_FALSE(v.empty());
+    EXPECT_EQ(v.front(), 0);
+    EXPECT_EQ(v.back(), 6);
+
+    auto none = bsi::make_filter_view(ints, [](int x) { return 8 < x; });
+    EXPECT_TRUE(none.empty());
+
+    std::vector<int> empty;
+    EXPECT_TRUE(bsi::make_filter_view(empty, even).empty());
+}
+
+TEST(filter_view, blocks)
+{
+    // Lengths around the 64-element block size, with sparse and dense
+    // matches.
+    for (int n : {1, 63, 64, 65, 127, 128, 129, 1000}) {
+        for (int modulus : {1, 2, 3, 100}) {
+            auto const ints = random_ints(n, modulus);
+            auto const pred = [](int x) { return x == 0; };
+            std::vector<int> expected;
+            std::copy_if(
+                ints.begin(), ints.end(), std::back_inserter(expected), pred);
+
+            auto v = bsi::make_filter_view(ints, pred);
+            std::vector<int> const result(v.begin(), v.end());
+            EXPECT_EQ(result, expected);
+            EXPECT_EQ(
+                std::distance(v.begin(), v.end()),
+                std::ptrdiff_t(expected.size()));
+
+            std::reverse(expected.begin(), expected.end());
+            EXPECT_EQ(reversed(v), expected);
+        }
+    }
+}
+
+TEST(filter_view, back_and_forth)
+{
+    auto const ints = random_ints(300, 5);
+    auto const pred = [](int x) { return x < 2; };
+    std::vector<int const *> expected;
+    for (auto & x : ints) {
+        if (pred(x))
+            expected.push_back(&x);
+    }
+
+    auto v = bsi::make_filter_view(ints, pred);
+    auto it = v.begin();
+    std::size_t i = 0;
+    for (int step = 0; step < 1000; ++step) {
+        ASSERT_EQ(it.base(), expected[i]);
+        if (i && (step % 3 == 0 || i == expected.size() - 1)) {
+            --it;
+            --i;
+        } else {
+            ++it;
+            ++i;
+        }
+    }
+}
+
+TEST(filter_view, scalar)
+{
+    auto const ints = random_ints(200, 3);
+    std::vector<int> expected;
+    std::copy_if(
+        ints.begin(), ints.end(), std::back_inserter(expected), even);
+
+    std::function<bool(int)> const pred = even;
+    auto v = bsi::make_filter_view(ints, pred);
+    EXPECT_EQ(std::vector<int>(v.begin(), v.end()), expected);
+
+    std::forward_list<int> const list(ints.begin(), ints.end());
+    auto list_v = bsi::make_filter_view(list, even);
+    EXPECT_EQ(std::vector<int>(list_v.begin(), list_v.end()), expected);
+}
+
+TEST(filter_view, stateful_predicate)
+{
+    in_table pred;
+    pred.table.fill(false);
+    pred.table[3] = pred.table[5] = true;
+    std::vector<int> ints = {1, 3, 5, 259, 7, 256 + 5};
+    bsi::filter_view<int *, in_table> v(
+        ints.data(), ints.data() + ints.size(), pred);
+    EXPECT_EQ(
+        std::vector<int>(v.begin(), v.end()),
+        (std::vector<int>{3, 5, 259, 261}));
+    EXPECT_EQ(reversed(v), (std::vector<int>{261, 259, 5, 3}));
+}
+
+TEST(filter_view, standalone_iterator)
+{
+    std::vector<int> ints = {1, 2, 3, 4, 5, 6};
+    int * const first = ints.data();
+    int * const last = first + ints.size();
+    bsi::filter_iterator<int *, even_t> it(first, last, even);
+    bsi::filter_iterator<int *, even_t> const end(last, last, even);
+    EXPECT_EQ(std::vector<int>(it, end), (std::vector<int>{2, 4, 6}));
+    auto it2 = end;
+    --it2;
+    EXPECT_EQ(*it2, 6);
+    EXPECT_EQ(*--it2, 4);
+}
+
+TEST(filter_view, mutable_elements)
+{
+    std::vector<int> ints = {1, 2, 3, 4};
+    for (auto & x : bsi::make_filter_view(ints, even)) {
+        x = 0;
+    }
+    EXPECT_EQ(ints, (std::vector<int>{1, 0, 3, 0}));
+}
@@ -0,0 +1,277 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/stl_interfaces/flat_map.hpp>
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <memory>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+
+using boost::stl_interfaces::flat_map;
+using boost::stl_interfaces::flat_set;
+using boost::stl_interfaces::sorted_unique;
+
+
+// Instantiate all the members we can.
+template struct flat_map<int, std::string>;
+template struct flat_map<std::string, int, std::greater<std::string>>;
+template struct flat_set<int>;
+template struct flat_set<std::string>;
+
+using map_t = flat_map<int, int>;
+using set_t = flat_set<int>;
+
+static_assert(
+    std::is_same<
+        std::iterator_traits<map_t::iterator>::iterator_category,
+        std::random_access_iterator_tag>::value,
+    "");
+static_assert(
+    std::is_convertible<map_t::iterator, map_t::const_iterator>::value, "");
+static_assert(
+    !std::is_convertible<map_t::const_iterator, map_t::iterator>::value, "");
+static_assert(
+    std::is_same<map_t::reference, std::pair<int const &, int &>>::value,
+    "");
+
+template<typename Map>
+std::map<typename Map::key_type, typename Map::mapped_type>
+to_map(Map const & m)
+{
+    std::map<typename Map::key_type, typename Map::mapped_type> retval;
+    for (auto && x : m) {
+        retval.emplace(x.first, x.second);
+    }
+    return retval;
+}
+
+// A key that is equivalent to every string that starts with c, and that
+// cannot be converted to a std::string.
+struct first_letter
+{
+    char c;
+};
+bool operator<(std::string const & s, first_letter l) { return s[0] < l.c; }
+bool operator<(first_letter l, std::string const & s) { return l.c < s[0]; }
+
+
+TEST(flat_containers, default_ctor)
+{
+    map_t m;
+    EXPECT_TRUE(m.empty());
+    EXPECT_EQ(m.size(), 0u);
+    EXPECT_EQ(m.begin(), m.end());
+    EXPECT_EQ(m.find(0), m.end());
+    EXPECT_EQ(m, m);
+
+    set_t s;
+    EXPECT_TRUE(s.empty());
+    EXPECT_EQ(s.begin(), s.end());
+    EXPECT_FALSE(s.contains(0));
+}
+
+TEST(flat_containers, map_lookup)
+{
+    map_t const m = {{5, 50}, {1, 10}, {3, 30}, {1, 11}};
+    EXPECT_EQ(m.size(), 3u);
+    EXPECT_EQ(m.keys(), (std::vector<int>{1, 3, 5}));
+    // The first of equal keys wins.
+    EXPECT_EQ(m.values(), (std::vector<int>{10, 30, 50}));
+
+    EXPECT_EQ((*m.find(3)).second, 30);
+    EXPECT_EQ(m.find(4), m.end());
+    EXPECT_EQ(m.count(5), 1u);
+    EXPECT_EQ(m.count(6), 0u);
+    EXPECT_EQ(m.lower_bound(2)->first, 3);
+    EXPECT_EQ(m.lower_bound(3)->first, 3);
+    EXPECT_EQ(m.upper_bound(3)->first, 5);
+    EXPECT_EQ(m.upper_bound(5), m.end());
+    auto const range = m.equal_range(3);
+    EXPECT_EQ(range.second - range.first, 1);
+    auto const empty = m.equal_range(4);
+    EXPECT_EQ(empty.first, empty.second);
+
+    EXPECT_EQ(m.at(1), 10);
+    EXPECT_THROW(m.at(2), std::out_of_range);
+}
+
+TEST(flat_containers, transparent_lookup)
+{
+    flat_map<std::string, int, std::less<>> m = {
+        {"apple", 1}, {"avocado", 2}, {"banana", 3}, {"cherry", 4}};
+    EXPECT_EQ((*m.find("banana")).second, 3);
+    EXPECT_TRUE(m.contains(first_letter{'a'}));
+    EXPECT_FALSE(m.contains(first_letter{'d'}));
+    EXPECT_EQ(m.count(first_letter{'a'}), 2u);
+    EXPECT_EQ(m.find(first_letter{'d'}), m.end());
+    EXPECT_EQ((*m.lower_bound(first_letter{'b'})).first, "banana");
+    EXPECT_EQ((*m.upper_bound(first_letter{'a'})).first, "banana");
+    auto const range = m.equal_range(first_letter{'a'});
+    EXPECT_EQ(range.first, m.begin());
+    EXPECT_EQ(range.second - range.first, 2);
+
+    auto const & cm = m;
+    EXPECT_EQ((*cm.find(first_letter{'c'})).second, 4);
+    EXPECT_EQ(cm.equal_range(first_letter{'c'}).first, cm.end() - 1);
+
+    flat_set<std::string, std::less<>> s = {"kiwi", "lemon", "lime"};
+    EXPECT_EQ(*s.find("lemon"), "lemon");
+    EXPECT_EQ(s.count(first_letter{'l'}), 2u);
+    EXPECT_TRUE(s.contains(first_letter{'k'}));
+    EXPECT_FALSE(s.contains(first_letter{'m'}));
+    EXPECT_EQ(*s.upper_bound(first_letter{'k'}), "lemon");
+    auto const set_range = s.equal_range(first_letter{'l'});
+    EXPECT_EQ(set_range.second, s.end());
+    EXPECT_EQ(set_range.second - set_range.first, 2);
+}
+
+TEST(flat_containers, map_modifiers)
+{
+    map_t m;
+    EXPECT_TRUE(m.insert({2, 20}).second);
+    EXPECT_FALSE(m.insert({2, 21}).second);
+    EXPECT_TRUE(m.emplace(1, 10).second);
+    EXPECT_TRUE(m.try_emplace(3, 30).second);
+    EXPECT_FALSE(m.try_emplace(3, 31).second);
+    EXPECT_FALSE(m.insert_or_assign(3, 32).second);
+    m[0] = 0;
+    ++m[4];
+    EXPECT_EQ(
+        to_map(m),
+        (std::map<int, int>{{0, 0}, {1, 10}, {2, 20}, {3, 32}, {4, 1}}));
+
+    // Writes through an iterator go to the value array.
+    m.begin()->second = 100;
+    EXPECT_EQ(m.values().front(), 100);
+
+    EXPECT_EQ(m.erase(2), 1u);
+    EXPECT_EQ(m.erase(2), 0u);
+    auto const it = m.erase(m.begin());
+    EXPECT_EQ(it->first, 1);
+    m.erase(m.begin() + 1, m.end());
+    EXPECT_EQ(to_map(m), (std::map<int, int>{{1, 10}}));
+    m.clear();
+    EXPECT_TRUE(m.empty());
+}
+
+TEST(flat_containers, map_bulk_insert)
+{
+    map_t m = {{2, 20}, {4, 40}, {6, 60}};
+    std::vector<std::pair<int, int>> const sorted = {
+        {1, 10}, {2, 21}, {3, 30}, {7, 70}, {8, 80}};
+    m.insert(sorted_unique, sorted.begin(), sorted.end());
+    EXPECT_EQ(m.keys(), (std::vector<int>{1, 2, 3, 4, 6, 7, 8}));
+    EXPECT_EQ(m.values(), (std::vector<int>{10, 20, 30, 40, 60, 70, 80}));
+
+    std::vector<std::pair<int, int>> const unsorted = {
+        {9, 90}, {0, 0}, {5, 50}, {0, 1}, {4, 41}};
+    m.insert(unsorted.begin(), unsorted.end());
+    EXPECT_EQ(m.keys(), (std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+    EXPECT_EQ(m.at(0), 0);
+    EXPECT_EQ(m.at(4), 40);
+
+    map_t const m2(sorted_unique, sorted.begin(), sorted.end());
+    EXPECT_EQ(m2.keys(), (std::vector<int>{1, 2, 3, 7, 8}));
+}
+
+TEST(flat_containers, map_against_std_map)
+{
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> dist(0, 200);
+    flat_map<int, std::string> f;
+    std::map<int, std::string> m;
+    for (int i = 0; i < 1000; ++i) {
+        int const k = dist(gen);
+        switch (i % 4) {
+        case 0:
+        case 1: f[k] = std::to_string(i); m[k] = std::to_string(i); break;
+        case 2: EXPECT_EQ(f.erase(k), m.erase(k)); break;
+        case 3: EXPECT_EQ(f.contains(k), m.count(k) == 1u); break;
+        }
+    }
+    EXPECT_EQ(to_map(f), m);
+}
+
+TEST(flat_containers, map_copy_move_swap)
+{
+    flat_map<std::string, std::unique_ptr<int>> m;
+    m.try_emplace("b", new int(2));
+    m.try_emplace("a", new int(1));
+    auto m2 = std::move(m);
+    EXPECT_EQ(m2.size(), 2u);
+    EXPECT_EQ(*m2.begin()->second, 1);
+
+    map_t a = {{1, 1}};
+    map_t b = {{2, 2}, {3, 3}};
+    map_t const a2 = a;
+    swap(a, b);
+    EXPECT_EQ(b, a2);
+    EXPECT_EQ(a.size(), 2u);
+    EXPECT_LT(a2, a);
+
+    flat_map<int, int, std::greater<int>> g = {{1, 1}, {3, 3}, {2, 2}};
+    EXPECT_EQ(g.keys(), (std::vector<int>{3, 2, 1}));
+}
+
+TEST(flat_containers, set)
+{
+    set_t s = {4, 2, 6, 2};
+    EXPECT_EQ(s.keys(), (std::vector<int>{2, 4, 6}));
+    EXPECT_TRUE(s.insert(3).second);
+    EXPECT_FALSE(s.insert(3).second);
+    EXPECT_EQ(*s.emplace(5).first, 5);
+    EXPECT_EQ(s.keys(), (std::vector<int>{2, 3, 4, 5, 6}));
+
+    EXPECT_EQ(*s.find(4), 4);
+    EXPECT_EQ(s.find(7), s.end());
+    EXPECT_EQ(*s.lower_bound(1), 2);
+    EXPECT_EQ(s.upper_bound(6), s.end());
+    EXPECT_EQ(s[1], 3);
+    EXPECT_EQ(s.data(), s.keys().data());
+
+    int const sorted[] = {0, 1, 3, 7};
+    s.insert(sorted_unique, std::begin(sorted), std::end(sorted));
+    EXPECT_EQ(s.keys(), (std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7}));
+    s.insert({9, 8, 8});
+    EXPECT_EQ(s.size(), 10u);
+
+    EXPECT_EQ(s.erase(4), 1u);
+    EXPECT_EQ(*s.erase(s.begin()), 1);
+    s.erase(s.begin(), s.begin() + 2);
+    EXPECT_EQ(s.keys(), (std::vector<int>{3, 5, 6, 7, 8, 9}));
+
+    flat_set<std::string> strings = {"b", "c", "a"};
+    EXPECT_EQ(strings.front(), "a");
+    EXPECT_EQ(strings.back(), "c");
+}
+
+TEST(flat_containers, set_bulk_insert_against_std_set)
+{
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> dist(0, 500);
+    flat_set<std::string> f;
+    std::set<std::string> s;
+    for (int i = 0; i < 50; ++i) {
+        std::vector<std::string> batch;
+        for (int j = 0, n = dist(gen) % 20; j < n; ++j) {
+            batch.push_back(std::to_string(dist(gen)));
+        }
+        if (i % 2) {
+            f.insert(batch.begin(), batch.end());
+        } else {
+            std::set<std::string> const sorted(batch.begin(), batch.end());
+            f.insert(sorted_unique, sorted.begin(), sorted.end());
+        }
+        s.insert(batch.begin(), batch.end());
+        ASSERT_TRUE(std::equal(f.begin(), f.end(), s.begin(), s.end()));
+    }
+}
@@ -0,0 +1,286 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/stl_interfaces/flat_hash_map.hpp>
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+
+using boost::stl_interfaces::flat_hash_map;
+
+namespace hash_group = boost::stl_interfaces::hash_group;
+
+
+// Instantiate all the members we can.
+template struct flat_hash_map<int, int>;
+template struct flat_hash_map<std::string, std::string>;
+
+using map_t = flat_hash_map<int, int>;
+
+static_assert(
+    std::is_same<
+        std::iterator_traits<map_t::iterator>::iterator_category,
+        std::forward_iterator_tag>::value,
+    "");
+static_assert(
+    std::is_same<map_t::iterator::reference, std::pair<int const, int> &>::
+        value,
+    "");
+static_assert(
+    std::is_convertible<map_t::iterator, map_t::const_iterator>::value, "");
+static_assert(
+    !std::is_convertible<map_t::const_iterator, map_t::iterator>::value, "");
+
+template<typename Map>
+std::map<typename Map::key_type, typename Map::mapped_type>
+to_map(Map const & m)
+{
+    return std::map<typename Map::key_type, typename Map::mapped_type>(
+        m.begin(), m.end());
+}
+
+// A string key that cannot be converted to a std::string, and a hash and
+// an equality that accept it as well as std::string.
+struct name_view
+{
+    char const * data;
+    std::size_t size;
+};
+struct name_hash
+{
+    using is_transparent = void;
+    std::size_t operator()(char const * s, std::size_t n) const noexcept
+    {
+        std::size_t h = 14695981039346656037ull;
+        for (std::size_t i = 0; i < n; ++i) {
+            h = (h ^ (unsigned char)s[i]) * 1099511628211ull;
+        }
+        return h;
+    }
+    std::size_t operator()(std::string const & s) const noexcept
+    {
+        return (*this)(s.data(), s.size());
+    }
+    std::size_t operator()(name_view v) const noexcept
+    {
+        return (*this)(v.data, v.size);
+    }
+};
+struct name_equal
+{
+    using is_transparent = void;
+    bool operator()(std::string const & a, std::string const & b) const
+    {
+        return a == b;
+    }
+    bool operator()(std::string const & a, name_view b) const
+    {
+        return a.size() == b.size && !a.compare(0, a.size(), b.data, b.size);
+    }
+};
+
+// A hash that sends every key to the same group, to test long probe
+// sequences.
+struct bad_hash
+{
+    std::size_t operator()(int x) const noexcept { return x & 1; }
+};
+
+
+TEST(flat_hash_map, hash_group)
+{
+    std::int8_t ctrl[hash_group::size];
+    for (std::size_t i = 0; i < hash_group::size; ++i) {
+        ctrl[i] = std::int8_t(i);
+    }
+    ctrl[3] = hash_group::empty;
+    ctrl[9] = hash_group::deleted;
+    ctrl[15] = hash_group::sentinel;
+    ctrl[12] = 5;
+    EXPECT_EQ(hash_group::match(ctrl, 5), (1u << 5) | (1u << 12));
+    EXPECT_EQ(hash_group::match(ctrl, 3), 0u);
+    EXPECT_EQ(hash_group::match_empty(ctrl), 1u << 3);
+    EXPECT_EQ(
+        hash_group::match_empty_or_deleted(ctrl), (1u << 3) | (1u << 9));
+}
+
+TEST(flat_hash_map, default_ctor)
+{
+    map_t m;
+    EXPECT_TRUE(m.empty());
+    EXPECT_EQ(m.size(), 0u);
+    EXPECT_EQ(m.capacity(), 0u);
+    EXPECT_EQ(m.begin(), m.end());
+    EXPECT_EQ(m.find(0), m.end());
+    EXPECT_FALSE(m.contains(0));
+    EXPECT_EQ(m.erase(0), 0u);
+    EXPECT_EQ(m, m);
+    m.clear();
+    EXPECT_TRUE(m.empty());
+}
+
+TEST(flat_hash_map, access)
+{
+    map_t m = {{1, 10}, {2, 20}, {3, 30}};
+    EXPECT_EQ(m.size(), 3u);
+    EXPECT_EQ(m.at(2), 20);
+    EXPECT_THROW(m.at(4), std::out_of_range);
+    EXPECT_EQ(m[4], 0);
+    EXPECT_EQ(m.size(), 4u);
+    m[4] = 40;
+
+    EXPECT_FALSE(m.insert({1, 100}).second);
+    EXPECT_EQ(m.at(1), 10);
+    EXPECT_FALSE(m.insert_or_assign(1, 100).second);
+    EXPECT_EQ(m.at(1), 100);
+    EXPECT_TRUE(m.emplace(5, 50).second);
+    EXPECT_TRUE(m.try_emplace(6, 60).second);
+    EXPECT_FALSE(m.try_emplace(6, 0).second);
+
+    auto const it = m.find(3);
+    ASSERT_NE(it, m.end());
+    EXPECT_EQ(it->first, 3);
+    it->second = 33;
+    EXPECT_EQ(m.count(3), 1u);
+    EXPECT_EQ(
+        to_map(m),
+        (std::map<int, int>{
+            {1, 100}, {2, 20}, {3, 33}, {4, 40}, {5, 50}, {6, 60}}));
+
+    map_t const & cm = m;
+    EXPECT_EQ(cm.find(5)->second, 50);
+    EXPECT_EQ(cm.find(7), cm.end());
+}
+
+TEST(flat_hash_map, transparent_lookup)
+{
+    flat_hash_map<std::string, int, name_hash, name_equal> m;
+    for (int i = 0; i < 100; ++i) {
+        m[std::to_string(i)] = i;
+    }
+    EXPECT_EQ(m.find(name_view{"42", 2})->second, 42);
+    EXPECT_EQ(m.find(name_view{"420", 3}), m.end());
+    EXPECT_TRUE(m.contains(name_view{"7", 1}));
+    EXPECT_EQ(m.count(name_view{"100", 3}), 0u);
+    auto const & cm = m;
+    EXPECT_EQ(cm.find(name_view{"99", 2})->second, 99);
+    EXPECT_EQ(cm.find(std::string("99"))->second, 99);
+}
+
+TEST(flat_hash_map, random_edits)
+{
+    // Random inserts and erases, checked against std::map.  Erasures leave
+    // deleted slots, which the inserts reuse or a rehash clears out.
+    std::mt19937 gen(42);
+    map_t m;
+    std::map<int, int> expected;
+    for (int step = 0; step < 20000; ++step) {
+        int const k = std::uniform_int_distribution<int>(0, 2000)(gen);
+        if (std::uniform_int_distribution<int>(0, 2)(gen)) {
+            EXPECT_EQ(
+                m.insert({k, step}).second,
+                expected.insert({k, step}).second);
+        } else {
+            EXPECT_EQ(m.erase(k), expected.erase(k));
+        }
+        ASSERT_EQ(m.size(), expected.size());
+    }
+    EXPECT_EQ(to_map(m), expected);
+    EXPECT_EQ(std::distance(m.begin(), m.end()), std::ptrdiff_t(m.size()));
+    for (int k = 0; k <= 2000; ++k) {
+        EXPECT_EQ(m.contains(k), expected.count(k) == 1u);
+    }
+
+    // Erasing while iterating.
+    for (auto it = m.begin(); it != m.end();) {
+        if (it->first % 3)
+            it = m.erase(it);
+        else
+            ++it;
+    }
+    for (auto it = expected.begin(); it != expected.end();) {
+        if (it->first % 3)
+            it = expected.erase(it);
+        else
+            ++it;
+    }
+    EXPECT_EQ(to_map(m), expected);
+    m.erase(m.begin(), m.end());
+    EXPECT_TRUE(m.empty());
+    EXPECT_EQ(m.begin(), m.end());
+}
+
+TEST(flat_hash_map, collisions)
+{
+    // Every even key goes to one group, and every odd key to another, with
+    // the same 7 bits.
+    flat_hash_map<int, int, bad_hash> m;
+    for (int i = 0; i < 200; ++i) {
+        m[i] = i;
+    }
+    EXPECT_EQ(m.size(), 200u);
+    for (int i = 0; i < 200; ++i) {
+        ASSERT_NE(m.find(i), m.end());
+        EXPECT_EQ(m.find(i)->second, i);
+    }
+    for (int i = 0; i < 200; i += 2) {
+        m.erase(i);
+    }
+    EXPECT_EQ(m.find(0), m.end());
+    EXPECT_EQ(m.find(199)->second, 199);
+    EXPECT_EQ(m.size(), 100u);
+}
+
+TEST(flat_hash_map, reserve_and_equality)
+{
+    map_t m;
+    m.reserve(1000);
+    auto const capacity = m.capacity();
+    EXPECT_GE(capacity, 1000u);
+    for (int i = 0; i < 1000; ++i) {
+        m[i] = -i;
+    }
+    EXPECT_EQ(m.capacity(), capacity);
+
+    // Same elements, different insertion order and capacity.
+    map_t other;
+    for (int i = 999; 0 <= i; --i) {
+        other[i] = -i;
+    }
+    EXPECT_EQ(m, other);
+    other[0] = 1;
+    EXPECT_NE(m, other);
+    other.erase(0);
+    EXPECT_NE(m, other);
+}
+
+TEST(flat_hash_map, non_trivial_elements)
+{
+    flat_hash_map<std::string, std::string> m;
+    for (int i = 0; i < 100; ++i) {
+        m[std::string(20, char('a' + i % 26)) + std::to_string(i)] =
+            std::to_string(i);
+    }
+    EXPECT_EQ(m.size(), 100u);
+    EXPECT_EQ(m.at(std::string(20, 'c') + "2"), "2");
+
+    flat_hash_map<std::string, std::string> copy = m;
+    EXPECT_EQ(copy, m);
+    flat_hash_map<std::string, std::string> moved = std::move(copy);
+    EXPECT_TRUE(copy.empty());
+    EXPECT_EQ(moved, m);
+    moved.clear();
+    EXPECT_TRUE(moved.empty());
+    EXPECT_EQ(moved.begin(), moved.end());
+    moved.swap(m);
+    EXPECT_EQ(moved.size(), 100u);
+    EXPECT_TRUE(m.empty());
+}
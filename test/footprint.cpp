@@ -0,0 +1,163 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/any_iterator.hpp>
+#include <boost/stl_interfaces/bit_vector.hpp>
+#include <boost/stl_interfaces/checked_iterator.hpp>
+#include <boost/stl_interfaces/counted_iterator.hpp>
+#include <boost/stl_interfaces/filter_view.hpp>
+#include <boost/stl_interfaces/record_view.hpp>
+#include <boost/stl_interfaces/reverse_iterator.hpp>
+#include <boost/stl_interfaces/segmented_vector.hpp>
+#include <boost/stl_interfaces/soa_vector.hpp>
+#include <boost/stl_interfaces/split_view.hpp>
+#include <boost/stl_interfaces/transform_view.hpp>
+#include <boost/stl_interfaces/view_interface.hpp>
+#include <boost/stl_interfaces/zip_view.hpp>
+
+
+#include <gtest/gtest.h>
+
+#include <iostream>
+#include <iomanip>
+#include <utility>
+#include <vector>
+
+
+// The sizes of the iterators and views that the library and the examples
+// provide, as multiples of a pointer.  An iterator's size is the number of
+// registers it takes in a loop, so these catch footprint regressions, such
+// as an empty predicate or function that is a member instead of an empty
+// base, or an interface base that is not empty.
+
+namespace bsi = boost::stl_interfaces;
+using bsi::bit_iterator;
+using bsi::bit_vector;
+using bsi::bit_word;
+using bsi::char_span;
+using bsi::record_view;
+using bsi::segmented_vector;
+using bsi::soa_vector;
+using bsi::split_iterator;
+using bsi::split_view;
+
+constexpr std::size_t ptr = sizeof(void *);
+
+struct even
+{
+    bool operator()(int x) const { return x % 2 == 0; }
+};
+struct square
+{
+    int operator()(int x) const { return x * x; }
+};
+
+// The drop_while_view of the view tutorial, without its logic: a view is
+// its members, and view_interface adds nothing.
+template<typename Iter, typename Pred>
+struct drop_while_view
+    : bsi::view_interface<drop_while_view<Iter, Pred>>
+{
+    Iter begin() const { return first_; }
+    Iter end() const { return last_; }
+
+    Iter first_;
+    Iter last_;
+    Pred pred_;
+};
+
+template<typename T, std::size_t Size, std::size_t Align = alignof(void *)>
+constexpr bool footprint()
+{
+    return sizeof(T) == Size && alignof(T) == Align;
+}
+
+// Library iterators.
+static_assert(footprint<bsi::reverse_iterator<int *>, ptr>(), "");
+static_assert(footprint<bsi::cached_reverse_iterator<int *>, 3 * ptr>(), "");
+static_assert(
+    footprint<
+        bsi::proxy_arrow_result<std::pair<int, int>>,
+        sizeof(std::pair<int, int>),
+        alignof(int)>(),
+    "");
+static_assert(footprint<bsi::counted_iterator<int *>, 2 * ptr>(), "");
+static_assert(footprint<bsi::checked_iterator<int *>, 5 * ptr>(), "");
+static_assert(footprint<bsi::transform_iterator<int *, square>, ptr>(), "");
+static_assert(
+    footprint<
+        bsi::filter_iterator<std::vector<int>::iterator, even>,
+        2 * ptr>(),
+    "");
+// The blockwise cursor keeps a 64-bit mask and a count besides the pointer.
+static_assert(footprint<bsi::filter_iterator<int *, even>, 4 * ptr>(), "");
+static_assert(
+    footprint<bsi::filter_view_iterator<int *, even>, 4 * ptr>(), "");
+// A table pointer and a 32-byte buffer.
+static_assert(footprint<bsi::any_iterator<int>, 5 * ptr>(), "");
+// A random access zip_iterator is its initial iterators and one offset.
+static_assert(footprint<bsi::zip_iterator<int *, int *>, 3 * ptr>(), "");
+
+// Library views.
+static_assert(footprint<bsi::transform_view<int *, square>, 2 * ptr>(), "");
+static_assert(footprint<bsi::zip_view<int *, int *>, 6 * ptr>(), "");
+// The cached begin() and its flag, then first, last, and pred; the view's
+// iterators refer to pred through the view, so it is a member.
+static_assert(
+    footprint<
+        bsi::filter_view<int *, even>,
+        sizeof(bsi::filter_view_iterator<int *, even>) + 4 * ptr>(),
+    "");
+static_assert(footprint<drop_while_view<int *, even>, 3 * ptr>(), "");
+
+// Example iterators and views.
+static_assert(footprint<bit_iterator<bit_word>, 2 * ptr>(), "");
+// A pointer per field, and an index.
+static_assert(footprint<soa_vector<int, double>::iterator, 3 * ptr>(), "");
+static_assert(footprint<segmented_vector<int>::iterator, 2 * ptr>(), "");
+static_assert(footprint<record_view<>::iterator, 2 * ptr>(), "");
+static_assert(footprint<char_span, 2 * ptr>(), "");
+// Three pointers, then the delimiter, mode, and flag, packed into one more.
+static_assert(footprint<split_iterator, 4 * ptr>(), "");
+static_assert(footprint<split_view, 3 * ptr>(), "");
+
+
+template<typename T>
+void print_footprint(char const * name)
+{
+    std::cout << std::left << std::setw(48) << name << std::right
+              << std::setw(4) << sizeof(T) << std::setw(4) << alignof(T)
+              << "\n";
+}
+
+#define PRINT_FOOTPRINT(...) print_footprint<__VA_ARGS__>(#__VA_ARGS__)
+
+TEST(footprint, report)
+{
+    std::cout << std::left << std::setw(48) << "type" << std::right
+              << std::setw(4) << "size" << std::setw(4) << "align" << "\n";
+    PRINT_FOOTPRINT(bsi::reverse_iterator<int *>);
+    PRINT_FOOTPRINT(bsi::cached_reverse_iterator<int *>);
+    PRINT_FOOTPRINT(bsi::proxy_arrow_result<std::pair<int, int>>);
+    PRINT_FOOTPRINT(bsi::counted_iterator<int *>);
+    PRINT_FOOTPRINT(bsi::checked_iterator<int *>);
+    PRINT_FOOTPRINT(bsi::transform_iterator<int *, square>);
+    PRINT_FOOTPRINT(bsi::filter_iterator<std::vector<int>::iterator, even>);
+    PRINT_FOOTPRINT(bsi::filter_iterator<int *, even>);
+    PRINT_FOOTPRINT(bsi::filter_view_iterator<int *, even>);
+    PRINT_FOOTPRINT(bsi::any_iterator<int>);
+    PRINT_FOOTPRINT(bsi::zip_iterator<int *, int *>);
+    PRINT_FOOTPRINT(bsi::transform_view<int *, square>);
+    PRINT_FOOTPRINT(bsi::zip_view<int *, int *>);
+    PRINT_FOOTPRINT(bsi::filter_view<int *, even>);
+    PRINT_FOOTPRINT(drop_while_view<int *, even>);
+    PRINT_FOOTPRINT(bit_iterator<bit_word>);
+    PRINT_FOOTPRINT(soa_vector<int, double>::iterator);
+    PRINT_FOOTPRINT(segmented_vector<int>::iterator);
+    PRINT_FOOTPRINT(record_view<>::iterator);
+    PRINT_FOOTPRINT(char_span);
+    PRINT_FOOTPRINT(split_iterator);
+    PRINT_FOOTPRINT(split_view);
+}
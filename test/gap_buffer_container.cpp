@@ -0,0 +1,231 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/stl_interfaces/gap_buffer.hpp>
+
+#include <gtest/gtest.h>
+
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+
+using boost::stl_interfaces::gap_buffer;
+
+
+// Instantiate all the members we can.
+template struct gap_buffer<int>;
+template struct gap_buffer<std::string>;
+
+using gap_buffer_t = gap_buffer<int>;
+
+static_assert(
+    std::is_same<
+        std::iterator_traits<gap_buffer_t::iterator>::iterator_category,
+        std::random_access_iterator_tag>::value,
+    "");
+static_assert(
+    std::is_convertible<
+        gap_buffer_t::iterator,
+        gap_buffer_t::const_iterator>::value,
+    "");
+static_assert(
+    !std::is_convertible<
+        gap_buffer_t::const_iterator,
+        gap_buffer_t::iterator>::value,
+    "");
+static_assert(
+    boost::stl_interfaces::is_segmented_iterator<
+        gap_buffer_t::iterator>::value,
+    "");
+
+template<typename Buffer>
+std::vector<typename Buffer::value_type> to_vector(Buffer const & b)
+{
+    return std::vector<typename Buffer::value_type>(b.begin(), b.end());
+}
+
+
+TEST(gap_buffer, default_ctor)
+{
+    gap_buffer_t b;
+    EXPECT_TRUE(b.empty());
+    EXPECT_EQ(b.size(), 0u);
+    EXPECT_EQ(b.capacity(), 0u);
+    EXPECT_EQ(b.begin(), b.end());
+    EXPECT_EQ(
+        boost::stl_interfaces::segmented_find(b.begin(), b.end(), 0),
+        b.end());
+    EXPECT_EQ(b, b);
+}
+
+TEST(gap_buffer, gap)
+{
+    gap_buffer_t b = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    EXPECT_EQ(b.gap_position(), 10u);
+
+    b.move_gap(b.begin() + 3);
+    EXPECT_EQ(b.gap_position(), 3u);
+    EXPECT_EQ(to_vector(b), (std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+    EXPECT_EQ(b[2], 2);
+    EXPECT_EQ(b[3], 3);
+    EXPECT_EQ(*(b.end() - 1), 9);
+    EXPECT_EQ(*(b.rbegin() + 7), 2);
+
+    // Inserting at the gap fills it from the front.
+    auto const capacity = b.capacity();
+    b.insert(b.begin() + 3, 100);
+    b.insert(b.begin() + 4, 101);
+    EXPECT_EQ(b.gap_position(), 5u);
+    EXPECT_EQ(b.capacity(), capacity);
+    EXPECT_EQ(
+        to_vector(b),
+        (std::vector<int>{0, 1, 2, 100, 101, 3, 4, 5, 6, 7, 8, 9}));
+
+    // Erasing just before the gap, or just after it, leaves it in place.
+    b.erase(b.begin() + 4);
+    EXPECT_EQ(b.gap_position(), 4u);
+    b.erase(b.begin() + 4);
+    EXPECT_EQ(b.gap_position(), 4u);
+    EXPECT_EQ(
+        to_vector(b), (std::vector<int>{0, 1, 2, 100, 4, 5, 6, 7, 8, 9}));
+
+    b.move_gap(b.begin() + 8);
+    EXPECT_EQ(b.gap_position(), 8u);
+    b.move_gap(b.begin());
+    EXPECT_EQ(b.gap_position(), 0u);
+    b.move_gap(b.end());
+    EXPECT_EQ(b.gap_position(), 10u);
+    EXPECT_EQ(
+        to_vector(b), (std::vector<int>{0, 1, 2, 100, 4, 5, 6, 7, 8, 9}));
+}
+
+TEST(gap_buffer, random_edits)
+{
+    // Random inserts and erases, checked against std::vector.
+    std::mt19937 gen(42);
+    gap_buffer_t b;
+    std::vector<int> v;
+    int next = 0;
+    for (int step = 0; step < 3000; ++step) {
+        auto const where = std::uniform_int_distribution<std::size_t>(
+            0, v.size())(gen);
+        if (std::uniform_int_distribution<int>(0, 2)(gen) || v.empty()) {
+            auto const n = std::uniform_int_distribution<int>(1, 20)(gen);
+            std::vector<int> values(n);
+            std::iota(values.begin(), values.end(), next);
+            next += n;
+            b.insert(b.begin() + where, values.begin(), values.end());
+            v.insert(v.begin() + where, values.begin(), values.end());
+        } else {
+            auto const n = std::uniform_int_distribution<std::size_t>(
+                0, (std::min)(v.size() - where, std::size_t(20)))(gen);
+            b.erase(b.begin() + where, b.begin() + where + n);
+            v.erase(v.begin() + where, v.begin() + where + n);
+        }
+        ASSERT_EQ(b.size(), v.size());
+    }
+    EXPECT_EQ(to_vector(b), v);
+    for (std::size_t i = 0; i < v.size(); i += 7) {
+        EXPECT_EQ(b[i], v[i]);
+    }
+
+    std::vector<int> reversed(b.rbegin(), b.rend());
+    EXPECT_TRUE(std::equal(reversed.rbegin(), reversed.rend(), v.begin()));
+
+    b.shrink_to_fit();
+    EXPECT_EQ(b.capacity(), b.size());
+    EXPECT_EQ(to_vector(b), v);
+}
+
+TEST(gap_buffer, segmented_algorithms)
+{
+    gap_buffer_t b;
+    for (int i = 0; i < 10; ++i) {
+        b.push_back(i);
+    }
+    for (int gap = 0; gap <= 10; ++gap) {
+        b.move_gap(b.begin() + gap);
+        for (int first = 0; first <= 10; ++first) {
+            for (int last = first; last <= 10; ++last) {
+                auto const f = b.cbegin() + first;
+                auto const l = b.cbegin() + last;
+                std::vector<int> expected(last - first);
+                std::iota(expected.begin(), expected.end(), first);
+
+                std::vector<int> copied;
+                boost::stl_interfaces::segmented_copy(
+                    f, l, std::back_inserter(copied));
+                EXPECT_EQ(copied, expected);
+                EXPECT_EQ(
+                    boost::stl_interfaces::segmented_accumulate(f, l, 0),
+                    std::accumulate(expected.begin(), expected.end(), 0));
+                for (int x = first - 1; x <= last; ++x) {
+                    auto const it =
+                        boost::stl_interfaces::segmented_find(f, l, x);
+                    EXPECT_EQ(
+                        it - b.cbegin(),
+                        first <= x && x < last ? x : last);
+                }
+            }
+        }
+    }
+}
+
+TEST(gap_buffer, non_trivial_elements)
+{
+    gap_buffer<std::string> b;
+    for (int i = 0; i < 20; ++i) {
+        b.push_back(std::string(30, char('a' + i)));
+    }
+    b.insert(b.begin() + 5, std::string(30, 'z'));
+    // The argument is an element that moves with the gap.
+    b.emplace(b.begin() + 15, b[2]);
+    b.emplace(b.begin() + 3, b[16]);
+    b.erase(b.begin() + 1, b.begin() + 3);
+    EXPECT_EQ(b.size(), 21u);
+    EXPECT_EQ(b[1], std::string(30, 'o'));
+    EXPECT_EQ(b[2], std::string(30, 'd'));
+    EXPECT_EQ(b[3], std::string(30, 'e'));
+    EXPECT_EQ(b[4], std::string(30, 'z'));
+    EXPECT_EQ(b[14], std::string(30, 'c'));
+
+    gap_buffer<std::string> copy = b;
+    EXPECT_EQ(copy, b);
+    gap_buffer<std::string> moved = std::move(copy);
+    EXPECT_TRUE(copy.empty());
+    EXPECT_EQ(moved, b);
+    moved.clear();
+    EXPECT_TRUE(moved.empty());
+    moved.swap(b);
+    EXPECT_EQ(moved.size(), 21u);
+}
+
+TEST(gap_buffer, erase_when_full)
+{
+    // A full buffer's gap is empty; moving it must not move any element
+    // onto itself.
+    gap_buffer<std::string> b;
+    std::vector<std::string> expected;
+    for (int i = 0; i < 16; ++i) {
+        expected.push_back(std::string(30, char('a' + i)));
+        b.push_back(expected.back());
+    }
+    EXPECT_EQ(b.size(), b.capacity());
+    b.erase(b.begin());
+    expected.erase(expected.begin());
+    EXPECT_EQ(std::vector<std::string>(b.begin(), b.end()), expected);
+
+    std::vector<std::string> const strings(b.capacity() + 5, "0123456789");
+    b.assign(strings.begin(), strings.end());
+    expected = strings;
+    b.erase(b.begin() + 7, b.begin() + 8);
+    expected.erase(expected.begin() + 7, expected.begin() + 8);
+    EXPECT_EQ(std::vector<std::string>(b.begin(), b.end()), expected);
+    b.erase(b.begin() + 3, b.begin() + 3);
+    EXPECT_EQ(std::vector<std::string>(b.begin(), b.end()), expected);
+}
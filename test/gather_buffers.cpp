@@ -0,0 +1,119 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/gather_buffers.hpp>
+#include <boost/stl_interfaces/concat_view.hpp>
+#include <boost/stl_interfaces/concurrent_append_vector.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <iterator>
+#include <vector>
+
+
+namespace bsi = boost::stl_interfaces;
+
+using byte_view = bsi::pointer_view<unsigned char const>;
+
+template<typename T>
+std::vector<T> flatten(std::vector<byte_view> const & buffers)
+{
+    std::vector<unsigned char> bytes;
+    for (auto b : buffers) {
+        bytes.insert(bytes.end(), b.begin(), b.end());
+    }
+    std::vector<T> retval(bytes.size() / sizeof(T));
+    std::memcpy(retval.data(), bytes.data(), bytes.size());
+    return retval;
+}
+
+TEST(gather_buffers, contiguous)
+{
+    std::vector<int> const ints = {1, 2, 3};
+    std::vector<byte_view> buffers;
+    bsi::gather_buffers(ints, std::back_inserter(buffers));
+    ASSERT_EQ(buffers.size(), 1u);
+    EXPECT_EQ((void const *)buffers[0].data(), (void const *)ints.data());
+    EXPECT_EQ(buffers[0].size(), 12);
+
+    buffers.clear();
+    bsi::gather_buffers(std::vector<int>(), std::back_inserter(buffers));
+    EXPECT_TRUE(buffers.empty());
+
+    int array[] = {4, 5};
+    bsi::gather_buffers(array, std::back_inserter(buffers));
+    EXPECT_EQ(flatten<int>(buffers), (std::vector<int>{4, 5}));
+}
+
+TEST(gather_buffers, segmented)
+{
+    bsi::concurrent_append_vector<int> chunked;
+    for (int i = 0; i < 300; ++i) {
+        chunked.push_back(i);
+    }
+    std::vector<int> expected(300);
+    for (int i = 0; i < 300; ++i) {
+        expected[std::size_t(i)] = i;
+    }
+
+    // Buckets of 64, 128 and 256 elements.
+    std::vector<byte_view> buffers;
+    bsi::gather_buffers(chunked, std::back_inserter(buffers));
+    EXPECT_EQ(buffers.size(), 3u);
+    EXPECT_EQ(buffers[0].size(), 64 * 4);
+    EXPECT_EQ((void const *)buffers[0].data(), (void const *)&chunked[0]);
+    EXPECT_EQ(flatten<int>(buffers), expected);
+
+    buffers.clear();
+    bsi::gather_buffers(
+        chunked.begin() + 10,
+        chunked.begin() + 70,
+        std::back_inserter(buffers));
+    ASSERT_EQ(buffers.size(), 2u);
+    EXPECT_EQ((void const *)buffers[0].data(), (void const *)&chunked[10]);
+    EXPECT_EQ(
+        flatten<int>(buffers),
+        std::vector<int>(expected.begin() + 10, expected.begin() + 70));
+
+    buffers.clear();
+    bsi::gather_buffers(
+        chunked.begin() + 5, chunked.begin() + 5, std::back_inserter(buffers));
+    EXPECT_TRUE(buffers.empty());
+}
+
+TEST(gather_buffers, adjacent_runs_join)
+{
+    int a[] = {0, 1, 2, 3};
+    int b[] = {4, 5, 6};
+    bsi::pointer_view<int> const a0(a, a + 2);
+    bsi::pointer_view<int> const a1(a + 2, a + 4);
+    bsi::pointer_view<int> const b0(b, b + 3);
+    auto const v = bsi::make_concat_view(a0, a1, b0);
+
+    std::vector<byte_view> buffers;
+    bsi::gather_buffers(v, std::back_inserter(buffers));
+    ASSERT_EQ(buffers.size(), 2u);
+    EXPECT_EQ((void const *)buffers[0].data(), (void const *)a);
+    EXPECT_EQ(buffers[0].size(), 16);
+    EXPECT_EQ(flatten<int>(buffers), (std::vector<int>{0, 1, 2, 3, 4, 5, 6}));
+}
+
+#if defined(BOOST_STL_INTERFACES_HAS_IOVEC)
+TEST(gather_buffers, iovec)
+{
+    bsi::concurrent_append_vector<char> message;
+    for (int i = 0; i < 100; ++i) {
+        message.push_back(char('a' + i % 26));
+    }
+    ::iovec iovs[8];
+    auto const last =
+        bsi::gather_buffers(message, std::begin(iovs), bsi::to_iovec{});
+    ASSERT_EQ(last - iovs, 2);
+    EXPECT_EQ(iovs[0].iov_len + iovs[1].iov_len, 100u);
+    EXPECT_EQ(static_cast<char const *>(iovs[0].iov_base), &message[0]);
+    EXPECT_EQ(static_cast<char const *>(iovs[1].iov_base), &message[64]);
+}
+#endif
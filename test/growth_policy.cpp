@@ -0,0 +1,264 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/alloc_vector.hpp>
+#include <boost/stl_interfaces/small_vector.hpp>
+#include <boost/stl_interfaces/static_vector.hpp>
+
+#include <gtest/gtest.h>
+
+#include <list>
+#include <string>
+#include <vector>
+
+
+namespace bsi = boost::stl_interfaces;
+using bsi::alloc_vector;
+using bsi::small_vector;
+
+using vec_type = small_vector<int, 4>;
+using slow_vec_type = small_vector<short, 4>;
+
+namespace boost { namespace stl_interfaces {
+    template<>
+    struct container_growth_policy<slow_vec_type>
+        : default_container_growth_policy<slow_vec_type, std::ratio<3, 2>>
+    {
+    };
+}}
+
+static_assert(bsi::container_growth_policy<vec_type>::reservable, "");
+static_assert(
+    bsi::container_growth_policy<bsi::static_vector<int, 4>>::reservable, "");
+static_assert(
+    !bsi::container_growth_policy<std::list<int>>::reservable, "");
+static_assert(
+    std::is_same<
+        bsi::container_growth_policy<slow_vec_type>::growth_factor,
+        std::ratio<3, 2>>::value,
+    "");
+
+
+TEST(growth_policy, members)
+{
+    using policy = bsi::container_growth_policy<vec_type>;
+    vec_type v = {1, 2, 3};
+    EXPECT_EQ(policy::capacity(v), 4u);
+    EXPECT_EQ(policy::max_size(v), v.max_size());
+    EXPECT_EQ(policy::grown_capacity(v, 4), 4u);
+    EXPECT_EQ(policy::grown_capacity(v, 5), 8u);
+    EXPECT_EQ(policy::grown_capacity(v, 20), 20u);
+    policy::reserve(v, 10);
+    EXPECT_EQ(v.capacity(), 10u);
+
+    std::list<int> const l(3);
+    using list_policy = bsi::container_growth_policy<std::list<int>>;
+    EXPECT_EQ(list_policy::capacity(l), SIZE_MAX);
+    EXPECT_EQ(list_policy::grown_capacity(l, 100), SIZE_MAX);
+
+    // Growth stops at max_size(), unless more than that is asked for.
+    using static_policy =
+        bsi::container_growth_policy<bsi::static_vector<int, 10>>;
+    bsi::static_vector<int, 10> const sv;
+    EXPECT_EQ(static_policy::grown_capacity(sv, 10), 10u);
+    EXPECT_EQ(static_policy::grown_capacity(sv, 11), 11u);
+
+    using slow_policy = bsi::container_growth_policy<slow_vec_type>;
+    slow_vec_type const s;
+    EXPECT_EQ(slow_policy::grown_capacity(s, 5), 6u);
+}
+
+TEST(growth_policy, append)
+{
+    // alloc_vector has no range insert, so append_range() appends one
+    // element at a time; it reserves the room for all of them first,
+    // instead of growing 4, 8, 16, ...
+    std::vector<int> const src(100, 1);
+    {
+        alloc_vector<int> v;
+        v.append_range(src);
+        EXPECT_EQ(v.capacity(), 100u);
+        v.append_range(src);
+        EXPECT_EQ(v.capacity(), 200u);
+        EXPECT_EQ(v.size(), 200u);
+    }
+
+    // Appends go by the policy's growth factor; insertions elsewhere are
+    // left to the container.
+    {
+        slow_vec_type v = {1, 2, 3, 4};
+        v.insert(v.end(), {5});
+        EXPECT_EQ(v.capacity(), 6u);
+        v.insert(v.end(), 2, 6);
+        EXPECT_EQ(v.capacity(), 9u);
+        v.insert_range(v.end(), std::vector<short>(3, 7));
+        EXPECT_EQ(v.capacity(), 13u);
+        v.insert(v.begin(), {0, 0, 0, 0});
+        EXPECT_EQ(v.capacity(), 26u);
+        std::vector<short> const expected = {
+            0, 0, 0, 0, 1, 2, 3, 4, 5, 6, 6, 7, 7, 7};
+        EXPECT_TRUE(
+            std::equal(v.begin(), v.end(), expected.begin(), expected.end()));
+    }
+}
+
+TEST(growth_policy, construct_at_end)
+{
+    // alloc_vector has construct_at_end() but no emplace_back(); the
+    // emplace_back() that container_interface provides grows it by the
+    // growth factor.
+    alloc_vector<std::vector<int>> v;
+    EXPECT_EQ(v.capacity(), 0u);
+    v.emplace_back(3, 1);
+    EXPECT_EQ(v.capacity(), 1u);
+    v.push_back(v.front());
+    EXPECT_EQ(v.capacity(), 2u);
+    v.emplace_back(v.back());
+    EXPECT_EQ(v.capacity(), 4u);
+    for (auto const & x : v) {
+        EXPECT_EQ(x, std::vector<int>(3, 1));
+    }
+
+    // An argument that refers to an element survives the growth.
+    v.emplace_back(std::vector<int>(1, 2));
+    EXPECT_EQ(v.size(), v.capacity());
+    v.emplace_back(v.back());
+    EXPECT_EQ(v.capacity(), 8u);
+    EXPECT_EQ(v.back(), std::vector<int>(1, 2));
+
+    // unchecked_emplace_back() goes straight to construct_at_end().
+    v.unchecked_emplace_back(2, 3);
+    v.unchecked_push_back(std::vector<int>());
+    EXPECT_EQ(v.size(), 7u);
+    EXPECT_EQ(v[5], std::vector<int>(2, 3));
+    EXPECT_TRUE(v.back().empty());
+
+    v.pop_back();
+    EXPECT_EQ(v.size(), 6u);
+}
+
+// A vector with capacity() but no reserve(), which grows only through its
+// range insert, and counts the vectors that it constructs.
+template<typename T>
+struct unreservable_vector : bsi::container_interface<
+                                 unreservable_vector<T>,
+                                 bsi::contiguous>
+{
+    using value_type = T;
+    using pointer = T *;
+    using const_pointer = T const *;
+    using reference = T &;
+    using const_reference = T const &;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using iterator = T *;
+    using const_iterator = T const *;
+
+    unreservable_vector() = default;
+    unreservable_vector(size_type n, T const & x) : v_(n, x) { ++fills; }
+
+    iterator begin() noexcept { return v_.data(); }
+    iterator end() noexcept { return v_.data() + v_.size(); }
+    size_type max_size() const noexcept { return v_.max_size(); }
+    size_type capacity() const noexcept { return v_.capacity(); }
+
+    template<typename Iter>
+    iterator insert(const_iterator pos, Iter first, Iter last)
+    {
+        auto const offset = pos - v_.data();
+        v_.insert(v_.begin() + offset, first, last);
+        return begin() + offset;
+    }
+    iterator erase(const_iterator first, const_iterator last)
+    {
+        auto const offset = first - v_.data();
+        v_.erase(
+            v_.begin() + offset, v_.begin() + (last - v_.data()));
+        return begin() + offset;
+    }
+    void swap(unreservable_vector & other) { v_.swap(other.v_); }
+
+    using base_type =
+        bsi::container_interface<unreservable_vector<T>, bsi::contiguous>;
+    using base_type::begin;
+
+    using base_type::end;
+
+    using base_type::erase;
+
+    using base_type::insert;
+
+    static int fills;
+
+private:
+    std::vector<T> v_;
+};
+template<typename T>
+int unreservable_vector<T>::fills = 0;
+
+// Throws from its copy constructor once copies_left copies have been made.
+struct fragile
+{
+    explicit fragile(int x) : x(x) {}
+    fragile(fragile const & other) : x(other.x)
+    {
+        if (copies_left-- == 0)
+            throw std::runtime_error("fragile copy");
+    }
+    fragile & operator=(fragile const & other) = default;
+
+    friend bool operator==(fragile const & lhs, fragile const & rhs)
+    {
+        return lhs.x == rhs.x;
+    }
+
+    int x;
+    static int copies_left;
+};
+int fragile::copies_left = 1000;
+
+static_assert(bsi::is_nothrow_insertable<int>::value, "");
+static_assert(bsi::is_nothrow_insertable<int, int &>::value, "");
+static_assert(!bsi::is_nothrow_insertable<std::string>::value, "");
+static_assert(
+    bsi::is_nothrow_insertable<std::string, std::string &&>::value, "");
+static_assert(!bsi::is_nothrow_insertable<fragile>::value, "");
+
+TEST(growth_policy, nothrow_assign)
+{
+    // Copying an int cannot throw, so assign() grows the vector in place,
+    // rather than constructing a new one and swapping it in.
+    {
+        unreservable_vector<int> v;
+        v.assign(3, 1);
+        v.assign(100, 2);
+        EXPECT_EQ(v.size(), 100u);
+        EXPECT_EQ(std::count(v.begin(), v.end(), 2), 100);
+        v.assign(1000, v.front());
+        EXPECT_EQ(v.size(), 1000u);
+        EXPECT_EQ(std::count(v.begin(), v.end(), 2), 1000);
+        EXPECT_EQ(unreservable_vector<int>::fills, 0);
+    }
+
+    // Copying a fragile can, so assign() leaves the vector unchanged when
+    // one does.
+    {
+        unreservable_vector<fragile> v;
+        v.assign(2, fragile(1));
+        ASSERT_EQ(v.size(), 2u);
+        fragile::copies_left = 10;
+        EXPECT_THROW(v.assign(100, fragile(2)), std::runtime_error);
+        EXPECT_EQ(unreservable_vector<fragile>::fills, 1);
+        EXPECT_EQ(v.size(), 2u);
+        EXPECT_EQ(v[0], fragile(1));
+        EXPECT_EQ(v[1], fragile(1));
+
+        fragile::copies_left = 1000;
+        v.assign(100, fragile(2));
+        EXPECT_EQ(unreservable_vector<fragile>::fills, 2);
+        EXPECT_EQ(v.size(), 100u);
+        EXPECT_EQ(v.back(), fragile(2));
+    }
+}
@@ -0,0 +1,131 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/circular_buffer.hpp>
+#include <boost/stl_interfaces/hash.hpp>
+#include <boost/stl_interfaces/static_vector.hpp>
+
+#include "ill_formed.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <set>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+
+namespace bsi = boost::stl_interfaces;
+using bsi::circular_buffer;
+
+using byte_vec = bsi::static_vector<std::uint8_t, 128>;
+using int_vec = bsi::static_vector<int, 32>;
+using string_vec = bsi::static_vector<std::string, 8>;
+
+static_assert(bsi::v1_dtl::bytewise_hashable<byte_vec>::value, "");
+static_assert(bsi::v1_dtl::bytewise_hashable<int_vec>::value, "");
+static_assert(!bsi::v1_dtl::bytewise_hashable<string_vec>::value, "");
+static_assert(
+    !bsi::v1_dtl::bytewise_hashable<circular_buffer<int, 8>>::value, "");
+
+namespace {
+    struct not_a_container
+    {};
+
+    template<typename T>
+    using hash_value_expr = decltype(bsi::hash_value(std::declval<T>()));
+}
+
+static_assert(!ill_formed<hash_value_expr, int_vec const &>::value, "");
+static_assert(ill_formed<hash_value_expr, not_a_container const &>::value, "");
+
+
+TEST(hash, equal_containers_hash_equal)
+{
+    int_vec const a = {1, 2, 3, 4, 5};
+    int_vec b;
+    for (int i = 1; i <= 5; ++i) {
+        b.push_back(i);
+    }
+    EXPECT_EQ(bsi::hash_value(a), bsi::hash_value(b));
+    EXPECT_EQ(std::hash<int_vec>{}(a), bsi::hash_value(a));
+    EXPECT_EQ(bsi::container_hash{}(a), bsi::hash_value(a));
+
+    b.back() = 6;
+    EXPECT_NE(bsi::hash_value(a), bsi::hash_value(b));
+    b.pop_back();
+    EXPECT_NE(bsi::hash_value(a), bsi::hash_value(b));
+
+    EXPECT_EQ(bsi::hash_value(int_vec{}), bsi::hash_value(int_vec{}));
+    EXPECT_NE(bsi::hash_value(int_vec{}), bsi::hash_value(int_vec{0}));
+}
+
+TEST(hash, every_length)
+{
+    // Every length through several 48-byte blocks, so that each of
+    // hash_bytes()'s tail cases is used.  Prefixes of one sequence, and the
+    // same sequences with one byte changed, should all hash differently.
+    std::set<std::size_t> hashes;
+    byte_vec v;
+    for (std::size_t i = 0; i < 128; ++i) {
+        hashes.insert(bsi::hash_value(v));
+        byte_vec w = v;
+        if (!w.empty()) {
+            w[i / 2] ^= 0x40;
+            hashes.insert(bsi::hash_value(w));
+        }
+        v.push_back(std::uint8_t(i * 37 + 11));
+    }
+    EXPECT_EQ(hashes.size(), 128u + 127u);
+
+    byte_vec const v2 = v;
+    EXPECT_EQ(bsi::hash_value(v), bsi::hash_value(v2));
+}
+
+TEST(hash, element_hashes)
+{
+    string_vec const a = {"one", "two", "three"};
+    string_vec b = a;
+    EXPECT_EQ(bsi::hash_value(a), bsi::hash_value(b));
+    EXPECT_EQ(std::hash<string_vec>{}(a), bsi::hash_value(a));
+    b[1] = "too";
+    EXPECT_NE(bsi::hash_value(a), bsi::hash_value(b));
+    std::swap(b[1], b[2]);
+    b[2] = "two";
+    EXPECT_NE(bsi::hash_value(a), bsi::hash_value(b));
+
+    // A discontiguous container's hash depends only on its elements, not
+    // on where in its storage they wrapped around.
+    circular_buffer<int, 8> ring;
+    for (int i = 0; i < 6; ++i) {
+        ring.push_back(i);
+    }
+    ring.pop_front();
+    ring.pop_front();
+    for (int i = 6; i < 9; ++i) {
+        ring.push_back(i);
+    }
+    circular_buffer<int, 8> const straight = {2, 3, 4, 5, 6, 7, 8};
+    EXPECT_EQ(bsi::hash_value(ring), bsi::hash_value(straight));
+    ring.pop_front();
+    EXPECT_NE(bsi::hash_value(ring), bsi::hash_value(straight));
+}
+
+TEST(hash, unordered_containers)
+{
+    std::unordered_set<int_vec> set;
+    std::unordered_set<circular_buffer<int, 4>, bsi::container_hash> rings;
+    for (int i = 0; i < 100; ++i) {
+        set.insert(int_vec{i, i + 1});
+        set.insert(int_vec{i, i + 1});
+        rings.insert(circular_buffer<int, 4>{i, i * 2});
+    }
+    EXPECT_EQ(set.size(), 100u);
+    EXPECT_EQ(rings.size(), 100u);
+    EXPECT_EQ(set.count(int_vec{7, 8}), 1u);
+    EXPECT_EQ(set.count(int_vec{7, 9}), 0u);
+    EXPECT_EQ(rings.count(circular_buffer<int, 4>{7, 14}), 1u);
+}
@@ -0,0 +1,185 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/stl_interfaces/hive.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+
+using boost::stl_interfaces::hive;
+
+
+// Instantiate all the members we can.
+template struct hive<int>;
+template struct hive<std::string, 4>;
+
+using hive_t = hive<int, 8>;
+
+static_assert(
+    std::is_same<
+        std::iterator_traits<hive_t::iterator>::iterator_category,
+        std::bidirectional_iterator_tag>::value,
+    "");
+static_assert(
+    std::is_convertible<hive_t::iterator, hive_t::const_iterator>::value, "");
+static_assert(
+    !std::is_convertible<hive_t::const_iterator, hive_t::iterator>::value,
+    "");
+static_assert(std::is_nothrow_move_constructible<hive_t>::value, "");
+
+template<typename Hive>
+std::vector<int> sorted(Hive const & h)
+{
+    std::vector<int> retval(h.begin(), h.end());
+    std::sort(retval.begin(), retval.end());
+    return retval;
+}
+
+// Checks that iteration in both directions visits size() elements.
+template<typename Hive>
+void check_iteration(Hive const & h)
+{
+    EXPECT_EQ(std::distance(h.begin(), h.end()), std::ptrdiff_t(h.size()));
+    std::vector<int> const forward(h.begin(), h.end());
+    std::vector<int> backward(h.rbegin(), h.rend());
+    std::reverse(backward.begin(), backward.end());
+    EXPECT_EQ(forward, backward);
+}
+
+
+TEST(hive_container, default_ctor)
+{
+    hive_t h;
+    EXPECT_TRUE(h.empty());
+    EXPECT_EQ(h.size(), 0u);
+    EXPECT_EQ(h.begin(), h.end());
+    EXPECT_EQ(h.rbegin(), h.rend());
+    EXPECT_EQ(h, h);
+}
+
+TEST(hive_container, insert_and_iterate)
+{
+    hive_t h;
+    for (int i = 0; i < 20; ++i) {
+        h.insert(i);
+    }
+    EXPECT_EQ(h.size(), 20u);
+    std::vector<int> expected(20);
+    std::iota(expected.begin(), expected.end(), 0);
+    EXPECT_EQ(std::vector<int>(h.begin(), h.end()), expected);
+    check_iteration(h);
+    EXPECT_EQ(h.front(), 0);
+    EXPECT_EQ(h.back(), 19);
+}
+
+TEST(hive_container, erase_patterns)
+{
+    // Erase each subset of a block's 8 slots, so that every combination of
+    // holes merging on the left, the right, and both sides happens, and
+    // iteration has to step over holes at the start, middle, and end.
+    for (int mask = 0; mask < 256; ++mask) {
+        hive_t h;
+        std::vector<int *> addresses;
+        for (int i = 0; i < 24; ++i) {
+            addresses.push_back(&*h.insert(i));
+        }
+        std::vector<int> expected;
+        for (int i = 0; i < 24; ++i) {
+            if (!(mask & (1 << (i % 8))) || i / 8 == 1)
+                expected.push_back(i);
+        }
+        // Erase from the first and last blocks.
+        for (auto it = h.begin(); it != h.end();) {
+            if (*it / 8 != 1 && (mask & (1 << (*it % 8))))
+                it = h.erase(it);
+            else
+                ++it;
+        }
+        EXPECT_EQ(sorted(h), expected);
+        check_iteration(h);
+        // The survivors have not moved.
+        for (auto & x : h) {
+            EXPECT_EQ(addresses[x], &x);
+        }
+
+        // Refill the holes.
+        auto const holes = 24 - int(h.size());
+        for (int i = 0; i < holes; ++i) {
+            h.insert(100 + i);
+        }
+        EXPECT_EQ(h.size(), 24u);
+        check_iteration(h);
+    }
+}
+
+TEST(hive_container, against_multiset)
+{
+    std::mt19937 gen(7);
+    hive_t h;
+    std::multiset<int> m;
+    std::vector<hive_t::iterator> its;
+    for (int i = 0; i < 5000; ++i) {
+        if (gen() % 3 || its.empty()) {
+            int const x = gen() % 100;
+            its.push_back(h.insert(x));
+            m.insert(x);
+        } else {
+            auto const j = gen() % its.size();
+            m.erase(m.find(*its[j]));
+            h.erase(its[j]);
+            its[j] = its.back();
+            its.pop_back();
+        }
+        ASSERT_EQ(h.size(), m.size());
+    }
+    EXPECT_EQ(sorted(h), std::vector<int>(m.begin(), m.end()));
+    check_iteration(h);
+
+    // Emptying whole blocks frees them.
+    h.erase(h.begin(), h.end());
+    EXPECT_TRUE(h.empty());
+    EXPECT_EQ(h.begin(), h.end());
+    h.insert(1);
+    EXPECT_EQ(h.size(), 1u);
+}
+
+TEST(hive_container, copy_move_swap)
+{
+    hive_t a = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+    a.erase(std::next(a.begin(), 3));
+    hive_t b = a;
+    EXPECT_EQ(b, a);
+    hive_t c = std::move(b);
+    EXPECT_TRUE(b.empty());
+    EXPECT_EQ(c, a);
+    b = {42};
+    swap(b, c);
+    EXPECT_EQ(b, a);
+    EXPECT_EQ(c, (hive_t{42}));
+    check_iteration(b);
+    check_iteration(c);
+    c = std::move(b);
+    EXPECT_EQ(c, a);
+    c.clear();
+    EXPECT_TRUE(c.empty());
+
+    hive<std::unique_ptr<int>, 4> p;
+    for (int i = 0; i < 10; ++i) {
+        p.emplace(new int(i));
+    }
+    p.erase(p.begin());
+    EXPECT_EQ(p.size(), 9u);
+    auto p2 = std::move(p);
+    EXPECT_EQ(**p2.begin(), 1);
+}
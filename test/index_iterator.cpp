@@ -0,0 +1,90 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/index_iterator.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <numeric>
+#include <vector>
+
+
+namespace bsi = boost::stl_interfaces;
+
+// A ring of 8 ints, addressed by position from its head, and with no
+// iterators of its own.
+struct ring
+{
+    int & operator[](std::size_t i) noexcept { return slots[(head + i) % 8]; }
+    int const & operator[](std::size_t i) const noexcept
+    {
+        return slots[(head + i) % 8];
+    }
+
+    std::array<int, 8> slots;
+    std::size_t head;
+};
+
+using ring_iter = bsi::index_iterator<ring>;
+using const_ring_iter = bsi::index_iterator<ring const>;
+using bool_iter = bsi::index_iterator<std::vector<bool>>;
+
+static_assert(sizeof(ring_iter) == 2 * sizeof(void *), "");
+static_assert(
+    std::is_same<
+        std::iterator_traits<ring_iter>::iterator_category,
+        std::random_access_iterator_tag>::value,
+    "");
+static_assert(std::is_same<ring_iter::reference, int &>::value, "");
+static_assert(
+    std::is_same<const_ring_iter::reference, int const &>::value, "");
+static_assert(std::is_convertible<ring_iter, const_ring_iter>::value, "");
+static_assert(!std::is_convertible<const_ring_iter, ring_iter>::value, "");
+static_assert(
+    std::is_same<bool_iter::reference, std::vector<bool>::reference>::value,
+    "");
+static_assert(std::is_same<bool_iter::value_type, bool>::value, "");
+
+
+TEST(index_iterator, ring)
+{
+    ring r = {{0, 1, 2, 3, 4, 5, 6, 7}, 5};
+    ring_iter const first(r);
+    ring_iter const last(r, 8);
+    EXPECT_EQ(last - first, 8);
+    EXPECT_EQ(*first, 5);
+    EXPECT_EQ(first[3], 0);
+    EXPECT_EQ(last.index(), 8);
+    EXPECT_EQ(first.container(), &r);
+
+    std::vector<int> const expected = {5, 6, 7, 0, 1, 2, 3, 4};
+    EXPECT_TRUE(std::equal(first, last, expected.begin(), expected.end()));
+
+    // The ring wraps, but the iterators do not.
+    std::sort(first, last, std::greater<int>());
+    EXPECT_EQ(r.slots[5], 7);
+    EXPECT_EQ(r.slots[4], 0);
+    EXPECT_TRUE(std::is_sorted(first, last, std::greater<int>()));
+
+    const_ring_iter it = first + 2;
+    EXPECT_EQ(*it, 5);
+    EXPECT_LT(it, const_ring_iter(last));
+    EXPECT_EQ(std::accumulate(it, const_ring_iter(last), 0), 15);
+    EXPECT_EQ(bsi::make_index_iterator(r, 4), first + 4);
+}
+
+TEST(index_iterator, proxy)
+{
+    std::vector<bool> v(10);
+    bool_iter const first(v);
+    bool_iter const last(v, 10);
+    std::fill(first + 2, first + 5, true);
+    EXPECT_EQ(std::count(v.begin(), v.end(), true), 3);
+    EXPECT_EQ(std::find(first, last, true) - first, 2);
+    *(last - 1) = true;
+    EXPECT_TRUE(v.back());
+}
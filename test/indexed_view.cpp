@@ -0,0 +1,133 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/indexed_view.hpp>
+#include <boost/stl_interfaces/iterator_interface.hpp>
+
+#include <gtest/gtest.h>
+
+#include <forward_list>
+#include <iterator>
+#include <vector>
+
+
+namespace bsi = boost::stl_interfaces;
+
+// A forward iterator over an int array that counts its increments.
+struct counted_iterator : bsi::iterator_interface<
+                              counted_iterator,
+                              std::forward_iterator_tag,
+                              int const>
+{
+    counted_iterator() = default;
+    counted_iterator(int const * it, int * steps) : it_(it), steps_(steps)
+    {}
+
+    int const & operator*() const { return *it_; }
+    counted_iterator & operator++()
+    {
+        ++it_;
+        ++*steps_;
+        return *this;
+    }
+    friend bool operator==(counted_iterator lhs, counted_iterator rhs)
+    {
+        return lhs.it_ == rhs.it_;
+    }
+
+    using base_type = bsi::iterator_interface<
+        counted_iterator,
+        std::forward_iterator_tag,
+        int const>;
+    using base_type::operator++;
+
+private:
+    int const * it_ = nullptr;
+    int * steps_ = nullptr;
+};
+
+TEST(indexed_view, forward_list)
+{
+    std::forward_list<int> list;
+    for (int i = 999; 0 <= i; --i) {
+        list.push_front(i);
+    }
+    auto const v = bsi::make_indexed_view(list, 16);
+    EXPECT_EQ(v.stride(), 16);
+    EXPECT_EQ(v.front(), 0);
+    EXPECT_FALSE(v.empty());
+    for (int i : {500, 3, 999, 0, 16, 17, 15, 640}) {
+        EXPECT_EQ(v[i], i);
+    }
+    EXPECT_EQ(v.size(), 1000);
+    EXPECT_EQ(v.back(), 999);
+    EXPECT_TRUE(v.advance(1000) == v.end());
+    EXPECT_EQ(v.checkpoints(), 1000u / 16 + 1);
+    EXPECT_EQ(std::distance(v.begin(), v.end()), 1000);
+
+    auto const copy = v;
+    EXPECT_EQ(copy[123], 123);
+    EXPECT_EQ(copy.checkpoints(), v.checkpoints());
+}
+
+TEST(indexed_view, lookups_are_o_stride)
+{
+    std::vector<int> data(10000);
+    for (int i = 0; i < 10000; ++i) {
+        data[std::size_t(i)] = i;
+    }
+    int steps = 0;
+    bsi::indexed_view<counted_iterator> v(
+        counted_iterator(data.data(), &steps),
+        counted_iterator(data.data() + data.size(), &steps),
+        64);
+
+    // The first lookup builds the index only as far as it needs.
+    EXPECT_EQ(v[130], 130);
+    EXPECT_EQ(steps, 130);
+    EXPECT_EQ(v.checkpoints(), 3u);
+
+    // Lookups behind the frontier walk at most stride - 1 elements.
+    steps = 0;
+    EXPECT_EQ(v[63], 63);
+    EXPECT_EQ(v[64], 64);
+    EXPECT_EQ(steps, 63);
+
+    // size() completes the index, once.
+    steps = 0;
+    EXPECT_EQ(v.size(), 10000);
+    EXPECT_EQ(steps, 10000 - 128);
+    steps = 0;
+    EXPECT_EQ(v.size(), 10000);
+    EXPECT_EQ(steps, 0);
+    for (int i = 0; i < 10000; i += 37) {
+        int const before = steps;
+        ASSERT_EQ(v[i], i);
+        ASSERT_LT(steps - before, 64);
+    }
+
+    v.reset_index();
+    EXPECT_EQ(v.checkpoints(), 0u);
+    steps = 0;
+    EXPECT_EQ(v[5000], 5000);
+    EXPECT_EQ(steps, 5000);
+}
+
+TEST(indexed_view, sizes_around_the_stride)
+{
+    for (int n : {0, 1, 7, 8, 9, 16, 17}) {
+        std::forward_list<int> list;
+        for (int i = n - 1; 0 <= i; --i) {
+            list.push_front(i);
+        }
+        auto const v = bsi::make_indexed_view(list, 8);
+        EXPECT_EQ(v.size(), n);
+        EXPECT_EQ(v.empty(), n == 0);
+        EXPECT_TRUE(v.advance(n) == v.end());
+        for (int i = 0; i < n; ++i) {
+            EXPECT_EQ(v[i], i);
+        }
+    }
+}
@@ -0,0 +1,255 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/stl_interfaces/intrusive_list.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <list>
+#include <random>
+#include <string>
+#include <vector>
+
+
+using boost::stl_interfaces::intrusive_list;
+using boost::stl_interfaces::list_hook;
+
+
+struct item
+{
+    explicit item(int v = 0) : value(v) {}
+
+    std::string name;
+    int value;
+    list_hook a;
+    list_hook b;
+};
+
+bool operator==(item const & lhs, item const & rhs)
+{
+    return lhs.value == rhs.value;
+}
+bool operator!=(item const & lhs, item const & rhs) { return !(lhs == rhs); }
+bool operator<(item const & lhs, item const & rhs)
+{
+    return lhs.value < rhs.value;
+}
+
+using a_list = intrusive_list<item, &item::a>;
+using b_list = intrusive_list<item, &item::b>;
+
+// Instantiate all the members we can.
+template struct intrusive_list<item, &item::a>;
+
+static_assert(
+    std::is_same<
+        std::iterator_traits<a_list::iterator>::iterator_category,
+        std::bidirectional_iterator_tag>::value,
+    "");
+static_assert(
+    std::is_convertible<a_list::iterator, a_list::const_iterator>::value, "");
+static_assert(
+    !std::is_convertible<a_list::const_iterator, a_list::iterator>::value,
+    "");
+static_assert(!std::is_copy_constructible<a_list>::value, "");
+static_assert(std::is_nothrow_move_constructible<a_list>::value, "");
+
+template<typename List>
+std::vector<int> values(List const & l)
+{
+    std::vector<int> retval;
+    for (auto const & x : l) {
+        retval.push_back(x.value);
+    }
+    std::vector<int> backward;
+    for (auto it = l.rbegin(); it != l.rend(); ++it) {
+        backward.push_back(it->value);
+    }
+    std::reverse(backward.begin(), backward.end());
+    EXPECT_EQ(retval, backward);
+    EXPECT_EQ(retval.size(), l.size());
+    return retval;
+}
+
+
+TEST(intrusive, default_ctor)
+{
+    a_list l;
+    EXPECT_TRUE(l.empty());
+    EXPECT_EQ(l.size(), 0u);
+    EXPECT_EQ(l.begin(), l.end());
+    EXPECT_EQ(l.rbegin(), l.rend());
+}
+
+TEST(intrusive, insert_erase)
+{
+    std::vector<item> items = {item(0), item(1), item(2), item(3), item(4)};
+    {
+        a_list l;
+        l.push_back(items[2]);
+        l.push_front(items[0]);
+        l.insert(std::next(l.begin()), items[1]);
+        l.push_back(items[4]);
+        l.insert(std::prev(l.end()), items[3]);
+        EXPECT_EQ(values(l), (std::vector<int>{0, 1, 2, 3, 4}));
+        EXPECT_EQ(&l.front(), &items[0]);
+        EXPECT_EQ(&l.back(), &items[4]);
+        EXPECT_TRUE(items[3].a.is_linked());
+        EXPECT_FALSE(items[3].b.is_linked());
+
+        auto it = l.erase(a_list::iterator_to(items[2]));
+        EXPECT_EQ(&*it, &items[3]);
+        EXPECT_FALSE(items[2].a.is_linked());
+        EXPECT_EQ(values(l), (std::vector<int>{0, 1, 3, 4}));
+
+        l.pop_front();
+        l.pop_back();
+        EXPECT_EQ(values(l), (std::vector<int>{1, 3}));
+
+        it = l.erase(l.begin(), l.end());
+        EXPECT_EQ(it, l.end());
+        EXPECT_TRUE(l.empty());
+        for (auto const & x : items) {
+            EXPECT_FALSE(x.a.is_linked());
+        }
+
+        // The list unlinks whatever is left when it goes away.
+        l.push_back(items[0]);
+    }
+    EXPECT_FALSE(items[0].a.is_linked());
+}
+
+TEST(intrusive, two_hooks)
+{
+    std::vector<item> items(6);
+    a_list evens;
+    b_list all;
+    for (int i = 0; i < 6; ++i) {
+        items[i].value = i;
+        all.push_front(items[i]);
+        if (i % 2 == 0)
+            evens.push_back(items[i]);
+    }
+    EXPECT_EQ(values(evens), (std::vector<int>{0, 2, 4}));
+    EXPECT_EQ(values(all), (std::vector<int>{5, 4, 3, 2, 1, 0}));
+
+    evens.erase(a_list::iterator_to(items[2]));
+    all.erase(b_list::iterator_to(items[4]));
+    EXPECT_EQ(values(evens), (std::vector<int>{0, 4}));
+    EXPECT_EQ(values(all), (std::vector<int>{5, 3, 2, 1, 0}));
+
+    // Copying an element does not copy its links.
+    item copy = items[0];
+    EXPECT_FALSE(copy.a.is_linked());
+    EXPECT_FALSE(copy.b.is_linked());
+    items[1] = copy;
+    EXPECT_TRUE(items[1].b.is_linked());
+    EXPECT_EQ(values(all), (std::vector<int>{5, 3, 2, 0, 0}));
+
+    evens.clear();
+    all.clear();
+}
+
+TEST(intrusive, splice)
+{
+    std::vector<item> items(8);
+    for (int i = 0; i < 8; ++i) {
+        items[i].value = i;
+    }
+    a_list l1;
+    a_list l2;
+    for (int i = 0; i < 4; ++i) {
+        l1.push_back(items[i]);
+        l2.push_back(items[i + 4]);
+    }
+
+    l1.splice(std::next(l1.begin()), l2, std::next(l2.begin()));
+    EXPECT_EQ(values(l1), (std::vector<int>{0, 5, 1, 2, 3}));
+    EXPECT_EQ(values(l2), (std::vector<int>{4, 6, 7}));
+
+    l1.splice(l1.begin(), l2, std::next(l2.begin()), l2.end());
+    EXPECT_EQ(values(l1), (std::vector<int>{6, 7, 0, 5, 1, 2, 3}));
+    EXPECT_EQ(values(l2), (std::vector<int>{4}));
+
+    // Within one list.
+    l1.splice(l1.end(), l1, l1.begin(), std::next(l1.begin(), 2));
+    EXPECT_EQ(values(l1), (std::vector<int>{0, 5, 1, 2, 3, 6, 7}));
+    l1.splice(l1.begin(), l1, std::prev(l1.end()));
+    EXPECT_EQ(values(l1), (std::vector<int>{7, 0, 5, 1, 2, 3, 6}));
+    l1.splice(l1.begin(), l1, l1.begin());
+    EXPECT_EQ(values(l1), (std::vector<int>{7, 0, 5, 1, 2, 3, 6}));
+
+    l2.splice(l2.begin(), l1);
+    EXPECT_TRUE(l1.empty());
+    EXPECT_EQ(values(l2), (std::vector<int>{7, 0, 5, 1, 2, 3, 6, 4}));
+    l2.splice(l2.end(), l1);
+    EXPECT_EQ(l2.size(), 8u);
+}
+
+TEST(intrusive, move_swap)
+{
+    std::vector<item> items(5);
+    for (int i = 0; i < 5; ++i) {
+        items[i].value = i;
+    }
+    a_list l1;
+    for (int i = 0; i < 3; ++i) {
+        l1.push_back(items[i]);
+    }
+
+    a_list l2 = std::move(l1);
+    EXPECT_TRUE(l1.empty());
+    EXPECT_EQ(values(l2), (std::vector<int>{0, 1, 2}));
+
+    l1.push_back(items[3]);
+    l1.push_back(items[4]);
+    swap(l1, l2);
+    EXPECT_EQ(values(l1), (std::vector<int>{0, 1, 2}));
+    EXPECT_EQ(values(l2), (std::vector<int>{3, 4}));
+
+    l1 = std::move(l2);
+    EXPECT_EQ(values(l1), (std::vector<int>{3, 4}));
+    EXPECT_TRUE(l2.empty());
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_FALSE(items[i].a.is_linked());
+    }
+
+    a_list empty;
+    EXPECT_TRUE(l1 != empty);
+    EXPECT_TRUE(empty < l1);
+    l1.swap(empty);
+    EXPECT_TRUE(l1.empty());
+    EXPECT_EQ(values(empty), (std::vector<int>{3, 4}));
+    empty.clear();
+}
+
+TEST(intrusive, against_std_list)
+{
+    std::mt19937 gen(11);
+    std::vector<item> items(200);
+    for (int i = 0; i < 200; ++i) {
+        items[i].value = i;
+    }
+    a_list l;
+    std::list<int> expected;
+    for (int n = 0; n < 5000; ++n) {
+        auto & x = items[gen() % items.size()];
+        if (x.a.is_linked()) {
+            l.erase(a_list::iterator_to(x));
+            expected.remove(x.value);
+        } else if (gen() % 2) {
+            l.push_front(x);
+            expected.push_front(x.value);
+        } else {
+            l.push_back(x);
+            expected.push_back(x.value);
+        }
+    }
+    EXPECT_EQ(
+        values(l), std::vector<int>(expected.begin(), expected.end()));
+    l.clear();
+}
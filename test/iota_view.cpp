@@ -0,0 +1,146 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/iota_view.hpp>
+#include <boost/stl_interfaces/algorithm.hpp>
+#include <boost/stl_interfaces/parallel.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <vector>
+
+
+namespace bsi = boost::stl_interfaces;
+
+static_assert(
+    std::is_same<
+        std::iterator_traits<bsi::counting_iterator<int>>::iterator_category,
+        std::random_access_iterator_tag>::value,
+    "");
+static_assert(
+    std::is_same<
+        std::iterator_traits<bsi::counting_iterator<short>>::reference,
+        short>::value,
+    "");
+static_assert(
+    bsi::v1::v1_dtl::has_read_n<bsi::counting_iterator<int>, long>::value,
+    "");
+
+constexpr int sum(bsi::iota_view<int> v)
+{
+    int retval = 0;
+    for (int x : v) {
+        retval += x;
+    }
+    return retval;
+}
+static_assert(sum(bsi::make_iota_view(0, 10, 3)) == 0 + 3 + 6 + 9, "");
+
+
+TEST(iota_view, unit_step)
+{
+    auto const v = bsi::make_iota_view(3, 8);
+    EXPECT_EQ(v.size(), 5);
+    EXPECT_EQ(std::vector<int>(v.begin(), v.end()),
+              (std::vector<int>{3, 4, 5, 6, 7}));
+    EXPECT_EQ(v[2], 5);
+    EXPECT_EQ(v.back(), 7);
+
+    auto it = v.begin();
+    EXPECT_EQ(it.step(), 1);
+    it += 3;
+    EXPECT_EQ(*it, 6);
+    EXPECT_EQ(it.index(), 3);
+    EXPECT_EQ(it - v.begin(), 3);
+    EXPECT_TRUE(v.begin() < it);
+    EXPECT_EQ(*--it, 5);
+    EXPECT_EQ(it[1], 6);
+
+    EXPECT_TRUE(bsi::make_iota_view(4, 4).empty());
+    EXPECT_TRUE(bsi::iota_view<int>().empty());
+}
+
+TEST(iota_view, steps)
+{
+    // The end is rounded up to a whole number of steps.
+    auto const up = bsi::make_iota_view(0, 10, 3);
+    EXPECT_EQ(up.size(), 4);
+    EXPECT_EQ(std::vector<int>(up.begin(), up.end()),
+              (std::vector<int>{0, 3, 6, 9}));
+    EXPECT_EQ(bsi::make_iota_view(0, 9, 3).size(), 3);
+
+    auto const down = bsi::make_iota_view(10, 0, -4);
+    EXPECT_EQ(std::vector<int>(down.begin(), down.end()),
+              (std::vector<int>{10, 6, 2}));
+    EXPECT_EQ(bsi::make_iota_view(10, 2, -4).size(), 2);
+
+    // An unsigned range may count down.
+    auto const u = bsi::make_iota_view(5u, 0u, -1);
+    EXPECT_EQ(std::vector<unsigned int>(u.begin(), u.end()),
+              (std::vector<unsigned int>{5, 4, 3, 2, 1}));
+
+    auto const c = bsi::make_iota_view('a', 'f', 2);
+    EXPECT_EQ(std::string(c.begin(), c.end()), "ace");
+}
+
+TEST(iota_view, batch_copy)
+{
+    // copy() and transform() from algorithm.hpp go through read_n().
+    for (std::ptrdiff_t step : {1, 3, -2}) {
+        int const last = step < 0 ? -1000 : 1000;
+        auto const v = bsi::make_iota_view(0, last, step);
+        std::vector<int> expected;
+        for (auto it = v.begin(); it != v.end(); ++it) {
+            expected.push_back(*it);
+        }
+
+        std::vector<int> out(v.size());
+        EXPECT_EQ(
+            bsi::copy(v.begin(), v.end(), out.data()),
+            out.data() + out.size());
+        EXPECT_EQ(out, expected);
+
+        // Into a wider type, from the middle.
+        std::vector<long long> wide(v.size() - 7);
+        bsi::copy(v.begin() + 7, v.end(), wide.data());
+        EXPECT_TRUE(std::equal(
+            wide.begin(), wide.end(), expected.begin() + 7));
+
+        auto const square = [](int x) { return x * x; };
+        std::vector<int> squares(v.size());
+        bsi::transform(v.begin(), v.end(), squares.data(), square);
+        std::transform(
+            expected.begin(), expected.end(), expected.begin(), square);
+        EXPECT_EQ(squares, expected);
+    }
+
+    // Unqualified, with using std::copy, the batch copy() is picked.
+    using std::copy;
+    auto const v = bsi::make_iota_view(100, 110);
+    int out[10];
+    copy(v.begin(), v.end(), out);
+    EXPECT_EQ(out[0], 100);
+    EXPECT_EQ(out[9], 109);
+}
+
+TEST(iota_view, parallel_index_space)
+{
+    std::vector<int> data(100000);
+    auto const v = bsi::make_iota_view(0, int(data.size()));
+    bsi::parallel_for_each(
+        v.begin(), v.end(), [&](int i) { data[i] = 2 * i; }, 1000);
+    std::vector<int> expected(data.size());
+    bsi::transform(
+        v.begin(), v.end(), expected.data(), [](int i) { return 2 * i; });
+    EXPECT_EQ(data, expected);
+
+    std::atomic<long long> total{0};
+    bsi::parallel_for_each(
+        v.begin(), v.end(), [&](int i) { total += i; }, 1000);
+    EXPECT_EQ(total, 100000LL * 99999 / 2);
+}
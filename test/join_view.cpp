@@ -0,0 +1,147 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/join_view.hpp>
+#include <boost/stl_interfaces/concat_view.hpp>
+#include <boost/stl_interfaces/static_vector.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <forward_list>
+#include <list>
+#include <numeric>
+#include <vector>
+
+
+namespace bsi = boost::stl_interfaces;
+
+using bucket = bsi::static_vector<int, 4>;
+using buckets = std::vector<bucket>;
+using join_iter = bsi::join_iterator<buckets::iterator>;
+
+BOOST_STL_INTERFACES_STATIC_ASSERT_CONCEPT(
+    join_iter, std::bidirectional_iterator)
+BOOST_STL_INTERFACES_STATIC_ASSERT_ITERATOR_TRAITS(
+    join_iter,
+    std::bidirectional_iterator_tag,
+    std::bidirectional_iterator_tag,
+    int,
+    int &,
+    int *,
+    std::ptrdiff_t)
+BOOST_STL_INTERFACES_STATIC_ASSERT_CONCEPT(
+    bsi::join_iterator<std::forward_list<std::vector<int>>::iterator>,
+    std::forward_iterator)
+static_assert(bsi::is_segmented_iterator<join_iter>::value, "");
+
+TEST(join_view, basic)
+{
+    buckets b = {{1, 2}, {}, {3}, {4, 5, 6, 7}, {}};
+    auto const v = bsi::make_join_view(b);
+    std::vector<int> const expected = {1, 2, 3, 4, 5, 6, 7};
+    EXPECT_TRUE(
+        std::equal(v.begin(), v.end(), expected.begin(), expected.end()));
+    EXPECT_EQ(std::distance(v.begin(), v.end()), 7);
+    EXPECT_FALSE(v.empty());
+
+    EXPECT_TRUE(std::equal(
+        std::make_reverse_iterator(v.end()),
+        std::make_reverse_iterator(v.begin()),
+        expected.rbegin(),
+        expected.rend()));
+
+    auto it = std::next(v.begin(), 2);
+    EXPECT_EQ(*it, 3);
+    EXPECT_EQ(it.outer(), b.begin() + 2);
+    --it;
+    EXPECT_EQ(*it, 2);
+    *it = 20;
+    EXPECT_EQ(b[0][1], 20);
+
+    std::replace(v.begin(), v.end(), 5, 50);
+    EXPECT_EQ(b[3][1], 50);
+}
+
+TEST(join_view, empty)
+{
+    buckets none;
+    auto const v = bsi::make_join_view(none);
+    EXPECT_TRUE(v.begin() == v.end());
+    EXPECT_TRUE(v.empty());
+
+    buckets all_empty(3);
+    auto const v2 = bsi::make_join_view(all_empty);
+    EXPECT_TRUE(v2.begin() == v2.end());
+
+    bsi::join_view<buckets::iterator> const v3;
+    EXPECT_TRUE(v3.begin() == v3.end());
+}
+
+TEST(join_view, forward_outer)
+{
+    std::forward_list<std::vector<int>> l = {{1}, {}, {2, 3}, {}};
+    auto const v = bsi::make_join_view(l);
+    EXPECT_EQ(std::accumulate(v.begin(), v.end(), 0), 6);
+    EXPECT_EQ(bsi::segmented_accumulate(v.begin(), v.end(), 0), 6);
+    EXPECT_EQ(std::distance(v.begin(), v.end()), 3);
+}
+
+TEST(join_view, segmented_algorithms)
+{
+    std::vector<std::vector<int>> chunks(10);
+    int n = 0;
+    for (auto & chunk : chunks) {
+        chunk.resize(n % 3 == 1 ? 0 : 10 + n);
+        std::iota(chunk.begin(), chunk.end(), 1000 * n);
+        ++n;
+    }
+    auto const v = bsi::make_join_view(chunks);
+
+    std::vector<int> expected;
+    for (auto const & chunk : chunks) {
+        expected.insert(expected.end(), chunk.begin(), chunk.end());
+    }
+
+    std::vector<int> out(expected.size());
+    EXPECT_EQ(
+        bsi::segmented_copy(v.begin(), v.end(), out.begin()), out.end());
+    EXPECT_EQ(out, expected);
+
+    EXPECT_EQ(
+        bsi::segmented_accumulate(v.begin(), v.end(), 0),
+        std::accumulate(expected.begin(), expected.end(), 0));
+
+    auto const found = bsi::segmented_find(v.begin(), v.end(), 5003);
+    EXPECT_EQ(&*found, &chunks[5][3]);
+    EXPECT_EQ(found, std::find(v.begin(), v.end(), 5003));
+    EXPECT_EQ(bsi::segmented_find(v.begin(), v.end(), -1), v.end());
+
+    // A match that is the first element of a segment after an empty one.
+    auto const first_of_2 = bsi::segmented_find(v.begin(), v.end(), 2000);
+    EXPECT_EQ(&*first_of_2, &chunks[2][0]);
+
+    bsi::segmented_fill(v.begin(), v.end(), 7);
+    EXPECT_TRUE(std::all_of(v.begin(), v.end(), [](int x) { return x == 7; }));
+}
+
+TEST(join_view, nested_segments)
+{
+    // The inner ranges are concat_views, whose iterators are segmented
+    // too, so the segmented algorithms recurse through both levels.
+    std::vector<int> a = {1, 2};
+    std::vector<int> b = {3};
+    std::vector<int> c;
+    std::vector<int> d = {4, 5};
+    using concat = bsi::concat_view<std::vector<int>::iterator, 2>;
+    std::list<concat> outer = {
+        bsi::make_concat_view(a, b), bsi::make_concat_view(c, d)};
+    auto const v = bsi::make_join_view(outer);
+    EXPECT_EQ(bsi::segmented_accumulate(v.begin(), v.end(), 0), 15);
+    std::vector<int> out(5);
+    bsi::segmented_copy(v.begin(), v.end(), out.begin());
+    EXPECT_EQ(out, (std::vector<int>{1, 2, 3, 4, 5}));
+    EXPECT_EQ(*bsi::segmented_find(v.begin(), v.end(), 4), 4);
+}
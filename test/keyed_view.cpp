@@ -0,0 +1,133 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/keyed_view.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+
+namespace bsi = boost::stl_interfaces;
+
+struct order
+{
+    long price;
+    int id;
+    std::string trader;
+};
+
+auto const price_of = [](order const & o) { return o.price; };
+
+std::vector<order> make_orders(int n)
+{
+    std::mt19937 gen(7);
+    std::vector<order> retval;
+    for (int i = 0; i < n; ++i) {
+        long const price = long(gen() % 50);
+        retval.push_back(order{price, i, "trader" + std::to_string(i)});
+    }
+    return retval;
+}
+
+template<typename View>
+void check_aligned(View const & v)
+{
+    for (std::size_t i = 0; i < v.size(); ++i) {
+        EXPECT_EQ(v.key(i), v.base_begin()[i].price);
+    }
+}
+
+TEST(keyed_view, sort)
+{
+    auto orders = make_orders(1000);
+    auto expected = orders;
+    std::stable_sort(
+        expected.begin(),
+        expected.end(),
+        [](order const & a, order const & b) { return a.price < b.price; });
+
+    auto v = bsi::make_keyed_view(orders, price_of);
+    EXPECT_EQ(v.size(), 1000u);
+    check_aligned(v);
+
+    v.sort();
+    check_aligned(v);
+    // Stable: equal prices keep their original order.
+    for (std::size_t i = 0; i < orders.size(); ++i) {
+        EXPECT_EQ(orders[i].id, expected[i].id);
+        EXPECT_EQ(orders[i].trader, expected[i].trader);
+    }
+
+    v.sort(std::greater<long>{});
+    check_aligned(v);
+    EXPECT_TRUE(std::is_sorted(
+        orders.begin(), orders.end(), [](order const & a, order const & b) {
+            return a.price > b.price;
+        }));
+
+    // Sorting a sorted range moves nothing, and changes nothing.
+    auto const before = orders;
+    v.sort(std::greater<long>{});
+    for (std::size_t i = 0; i < orders.size(); ++i) {
+        EXPECT_EQ(orders[i].id, before[i].id);
+    }
+}
+
+TEST(keyed_view, zip_iterators)
+{
+    auto orders = make_orders(100);
+    auto v = bsi::make_keyed_view(orders, price_of);
+
+    // The standard algorithms permute keys and elements together.
+    auto const by_key = [](auto const & a, auto const & b) {
+        return std::get<0>(a) < std::get<0>(b);
+    };
+    std::sort(v.begin(), v.end(), by_key);
+    check_aligned(v);
+    EXPECT_TRUE(std::is_sorted(v.keys(), v.keys() + v.size()));
+
+    auto const & first = *v.begin();
+    EXPECT_EQ(std::get<0>(first), std::get<1>(first).price);
+    EXPECT_EQ(v.end() - v.begin(), 100);
+}
+
+TEST(keyed_view, search)
+{
+    auto orders = make_orders(500);
+    auto v = bsi::make_keyed_view(orders, price_of);
+    v.sort();
+
+    auto const r = v.equal_range(17);
+    EXPECT_EQ(
+        r.second - r.first,
+        std::count_if(orders.begin(), orders.end(), [](order const & o) {
+            return o.price == 17;
+        }));
+    for (auto it = r.first; it != r.second; ++it) {
+        EXPECT_EQ(std::get<1>(*it).price, 17);
+    }
+    EXPECT_EQ(v.lower_bound(17), r.first);
+    EXPECT_EQ(v.upper_bound(17), r.second);
+    EXPECT_EQ(v.find(17), r.first);
+    EXPECT_EQ(v.find(100), v.end());
+    EXPECT_EQ(v.lower_bound(-1), v.begin());
+}
+
+TEST(keyed_view, refresh)
+{
+    auto orders = make_orders(10);
+    auto v = bsi::make_keyed_view(orders, price_of);
+    orders[3].price = 1000;
+    EXPECT_NE(v.key(3), 1000);
+    v.refresh();
+    check_aligned(v);
+    v.sort();
+    EXPECT_EQ(orders.back().price, 1000);
+    EXPECT_EQ(orders.back().id, 3);
+}
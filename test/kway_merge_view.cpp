@@ -0,0 +1,166 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/kway_merge_view.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <iterator>
+#include <list>
+#include <random>
+#include <utility>
+#include <vector>
+
+
+namespace bsi = boost::stl_interfaces;
+
+std::vector<std::vector<int>> make_runs(int k, int max_size)
+{
+    std::mt19937 gen(k);
+    std::vector<std::vector<int>> retval(k);
+    for (auto & run : retval) {
+        run.resize(gen() % (max_size + 1));
+        for (auto & x : run) {
+            x = int(gen() % 100);
+        }
+        std::sort(run.begin(), run.end());
+    }
+    return retval;
+}
+
+std::vector<int> merged(std::vector<std::vector<int>> const & runs)
+{
+    std::vector<int> retval;
+    for (auto const & run : runs) {
+        retval.insert(retval.end(), run.begin(), run.end());
+    }
+    std::sort(retval.begin(), retval.end());
+    return retval;
+}
+
+TEST(kway_merge_view, merge)
+{
+    for (int k : {0, 1, 2, 3, 5, 8, 13, 32}) {
+        auto const runs = make_runs(k, 40);
+        auto const expected = merged(runs);
+        auto const v = bsi::make_kway_merge_view(runs);
+        EXPECT_EQ(v.size(), expected.size()) << "k=" << k;
+        EXPECT_EQ(std::size_t(std::distance(v.begin(), v.end())), v.size());
+        EXPECT_TRUE(std::equal(
+            v.begin(), v.end(), expected.begin(), expected.end()))
+            << "k=" << k;
+        EXPECT_EQ(v.empty(), expected.empty());
+    }
+}
+
+TEST(kway_merge_view, empty_runs)
+{
+    std::vector<std::vector<int>> runs = {{}, {1, 4}, {}, {}, {2, 3}, {}};
+    auto const v = bsi::make_kway_merge_view(runs);
+    EXPECT_EQ(
+        std::vector<int>(v.begin(), v.end()),
+        (std::vector<int>{1, 2, 3, 4}));
+
+    std::vector<std::vector<int>> none = {{}, {}};
+    auto const w = bsi::make_kway_merge_view(none);
+    EXPECT_TRUE(w.empty());
+    EXPECT_EQ(w.begin(), w.end());
+}
+
+TEST(kway_merge_view, empty_does_not_build_the_tree)
+{
+    auto const runs = make_runs(8, 40);
+    int comparisons = 0;
+    auto const v = bsi::make_kway_merge_view(runs, [&](int a, int b) {
+        ++comparisons;
+        return a < b;
+    });
+    EXPECT_TRUE((bool)v);
+    EXPECT_FALSE(v.empty());
+    EXPECT_EQ(comparisons, 0);
+    (void)v.begin();
+    EXPECT_LT(0, comparisons);
+}
+
+TEST(kway_merge_view, stable)
+{
+    // Equivalent elements come in the order of their runs.
+    using pair = std::pair<int, int>;
+    std::vector<std::vector<pair>> runs(7);
+    for (int r = 0; r < 7; ++r) {
+        for (int key = 0; key < 10; key += 1 + r % 3) {
+            runs[r].push_back(pair(key, r));
+        }
+    }
+    auto const by_key = [](pair const & a, pair const & b) {
+        return a.first < b.first;
+    };
+    auto const v = bsi::make_kway_merge_view(runs, by_key);
+    std::vector<pair> const result(v.begin(), v.end());
+    EXPECT_TRUE(std::is_sorted(result.begin(), result.end()));
+    for (auto it = v.begin(); it != v.end(); ++it) {
+        EXPECT_EQ(std::size_t(it->second), it.run());
+    }
+
+    // Integers take another path through the tree.
+    std::vector<std::vector<int>> ints = {{1, 2}, {2}, {0, 1, 2}, {1}, {2}};
+    auto const w = bsi::make_kway_merge_view(ints);
+    std::vector<std::size_t> order;
+    for (auto it = w.begin(); it != w.end(); ++it) {
+        order.push_back(it.run());
+    }
+    EXPECT_EQ(order, (std::vector<std::size_t>{2, 0, 2, 3, 0, 1, 2, 4}));
+}
+
+TEST(kway_merge_view, descending)
+{
+    std::vector<std::vector<long>> runs = {{9, 4, -3}, {8, 8, 0}, {7, -5}};
+    auto const v = bsi::make_kway_merge_view(runs, std::greater<>{});
+    EXPECT_EQ(
+        std::vector<long>(v.begin(), v.end()),
+        (std::vector<long>{9, 8, 8, 7, 4, 0, -3, -5}));
+}
+
+TEST(kway_merge_view, copy)
+{
+    auto const runs = make_runs(20, 100);
+    auto const expected = merged(runs);
+    auto const v = bsi::make_kway_merge_view(runs);
+
+    std::vector<int> all(v.size());
+    EXPECT_EQ(v.copy(all.data()), all.data() + all.size());
+    EXPECT_EQ(all, expected);
+
+    // Copying in batches, as into a fixed-size output block, mixed with
+    // single steps.
+    std::vector<int> batched;
+    auto it = v.begin();
+    int block[64];
+    while (it != v.end()) {
+        batched.push_back(*it++);
+        int * const out = it.copy(block, 64);
+        batched.insert(batched.end(), block, out);
+        EXPECT_EQ(it.count(), std::ptrdiff_t(batched.size()));
+    }
+    EXPECT_EQ(batched, expected);
+    EXPECT_EQ(it.copy(block, 64), block);
+}
+
+TEST(kway_merge_view, forward_runs)
+{
+    std::vector<std::list<int>> runs = {{1, 5, 9}, {2, 6}, {0, 3, 4, 7, 8}};
+    auto const v = bsi::make_kway_merge_view(runs);
+    std::vector<int> const result(v.begin(), v.end());
+    EXPECT_EQ(result, (std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+
+    // A copy of an iterator is independent of the original.
+    auto it = v.begin();
+    ++it;
+    auto copy = it;
+    ++it;
+    EXPECT_EQ(*copy, 1);
+    EXPECT_EQ(*it, 2);
+}
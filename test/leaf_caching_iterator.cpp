@@ -0,0 +1,124 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/leaf_caching_iterator.hpp>
+#include <boost/stl_interfaces/persistent_vector.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+#include <vector>
+
+
+namespace bsi = boost::stl_interfaces;
+
+// persistent_vector is the leaf_caching_iterator user in this library: its
+// leaves hold 32 elements, except the tail, which holds the last 1 to 32.
+using vec_type = bsi::persistent_vector<int>;
+
+static_assert(
+    bsi::is_segmented_iterator<vec_type::const_iterator>::value,
+    "leaf_caching_iterator models the segmented iterator protocol");
+static_assert(
+    std::is_same<
+        std::iterator_traits<vec_type::const_iterator>::iterator_category,
+        std::random_access_iterator_tag>::value,
+    "");
+
+std::vector<int> iota_vector(std::size_t n)
+{
+    std::vector<int> retval(n);
+    std::iota(retval.begin(), retval.end(), 0);
+    return retval;
+}
+
+TEST(leaf_caching_iterator, traversal)
+{
+    for (std::size_t n : {1u, 31u, 32u, 33u, 64u, 32u * 33 + 5}) {
+        std::vector<int> const expected = iota_vector(n);
+        vec_type const v(expected.begin(), expected.end());
+        EXPECT_EQ(v.end() - v.begin(), std::ptrdiff_t(n));
+        EXPECT_TRUE(std::equal(v.begin(), v.end(), expected.begin()));
+        EXPECT_TRUE(std::equal(
+            std::make_reverse_iterator(v.end()),
+            std::make_reverse_iterator(v.begin()),
+            expected.rbegin()));
+    }
+}
+
+TEST(leaf_caching_iterator, random_access)
+{
+    std::vector<int> const expected = iota_vector(32 * 3 + 7);
+    vec_type const v(expected.begin(), expected.end());
+    auto it = v.begin();
+    EXPECT_EQ(it[40], 40);
+    it += 70;
+    EXPECT_EQ(*it, 70);
+    it -= 38;
+    EXPECT_EQ(*it, 32);
+    --it;
+    EXPECT_EQ(*it, 31);
+    it += 70;
+    EXPECT_EQ(*it, 101);
+    EXPECT_EQ(v.end() - it, 2);
+    EXPECT_EQ(*std::lower_bound(v.begin(), v.end(), 97), 97);
+    EXPECT_TRUE(v.begin() + 103 == v.end());
+    EXPECT_TRUE(v.end() - 103 == v.begin());
+}
+
+TEST(leaf_caching_iterator, segmented_algorithms)
+{
+    std::vector<int> const expected = iota_vector(32 * 40 + 7);
+    vec_type const v(expected.begin(), expected.end());
+
+    EXPECT_EQ(
+        bsi::segmented_accumulate(v.begin(), v.end(), 0),
+        std::accumulate(expected.begin(), expected.end(), 0));
+    // Subranges that start and end within a leaf, and on leaf boundaries.
+    EXPECT_EQ(
+        bsi::segmented_accumulate(v.begin() + 31, v.end() - 33, 0),
+        std::accumulate(expected.begin() + 31, expected.end() - 33, 0));
+    EXPECT_EQ(
+        bsi::segmented_accumulate(v.begin() + 32, v.begin() + 64, 0),
+        std::accumulate(expected.begin() + 32, expected.begin() + 64, 0));
+    EXPECT_EQ(
+        bsi::segmented_accumulate(v.begin() + 3, v.begin() + 5, 0), 3 + 4);
+
+    auto const it = bsi::segmented_find(v.begin(), v.end(), 1000);
+    EXPECT_EQ(it - v.begin(), 1000);
+    EXPECT_EQ(*it, 1000);
+    EXPECT_TRUE(bsi::segmented_find(v.begin(), v.end(), -1) == v.end());
+    EXPECT_EQ(
+        bsi::segmented_find(v.begin(), v.end(), 32 * 40 + 6) - v.begin(),
+        32 * 40 + 6);
+
+    std::vector<int> out;
+    bsi::segmented_copy(v.begin() + 1, v.end(), std::back_inserter(out));
+    EXPECT_TRUE(std::equal(
+        out.begin(), out.end(), expected.begin() + 1, expected.end()));
+}
+
+TEST(leaf_caching_iterator, empty)
+{
+    vec_type const v;
+    EXPECT_TRUE(v.begin() == v.end());
+    EXPECT_EQ(bsi::segmented_accumulate(v.begin(), v.end(), 0), 0);
+    EXPECT_TRUE(bsi::segmented_find(v.begin(), v.end(), 0) == v.end());
+}
+
+TEST(leaf_caching_iterator, versions)
+{
+    // Each version's iterators see that version's leaves.
+    std::vector<int> const expected = iota_vector(100);
+    vec_type const v(expected.begin(), expected.end());
+    vec_type const w = v.set(50, -1).push_back(100);
+    EXPECT_EQ(bsi::segmented_accumulate(v.begin(), v.end(), 0), 99 * 100 / 2);
+    EXPECT_EQ(
+        bsi::segmented_accumulate(w.begin(), w.end(), 0),
+        99 * 100 / 2 - 50 - 1 + 100);
+    EXPECT_EQ(bsi::segmented_find(w.begin(), w.end(), 50) - w.begin(), 101);
+}
@@ -0,0 +1,226 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/md_view.hpp>
+
+#include <gtest/gtest.h>
+
+#include <numeric>
+#include <vector>
+
+
+namespace bsi = boost::stl_interfaces;
+
+using dyn2 = bsi::extents<bsi::dynamic_extent, bsi::dynamic_extent>;
+using fixed34 = bsi::extents<3, 4>;
+
+static_assert(fixed34::rank() == 2, "");
+static_assert(fixed34::rank_dynamic() == 0, "");
+static_assert(dyn2::rank_dynamic() == 2, "");
+static_assert(
+    bsi::extents<3, bsi::dynamic_extent, 5>::static_extent(1) ==
+        bsi::dynamic_extent,
+    "");
+static_assert(bsi::extents<3, bsi::dynamic_extent, 5>(4).extent(1) == 4, "");
+static_assert(bsi::extents<3, bsi::dynamic_extent, 5>(4).extent(2) == 5, "");
+
+// Static extents are not stored.
+static_assert(
+    sizeof(bsi::md_view<int, fixed34>) == sizeof(int *), "");
+static_assert(
+    sizeof(bsi::md_view<int, dyn2>) == 3 * sizeof(int *), "");
+
+// Rows of a row-major matrix are contiguous; its columns are strided.
+static_assert(
+    std::is_same<
+        decltype(bsi::submd(
+            std::declval<bsi::md_view<int, fixed34>>(), 1, bsi::full_extent)),
+        bsi::md_view<int, bsi::extents<4>>>::value,
+    "");
+static_assert(
+    std::is_same<
+        decltype(bsi::submd(
+            std::declval<bsi::md_view<int, fixed34>>(), bsi::full_extent, 1)),
+        bsi::md_view<int, bsi::extents<3>, bsi::layout_stride>>::value,
+    "");
+static_assert(
+    std::is_same<
+        bsi::md_view<int, bsi::extents<4>>::iterator,
+        int *>::value,
+    "");
+static_assert(
+    std::is_same<
+        bsi::md_view<int, bsi::extents<3>, bsi::layout_stride>::iterator,
+        bsi::strided_iterator<int *>>::value,
+    "");
+static_assert(
+    std::is_same<
+        std::iterator_traits<
+            bsi::md_view<int, fixed34>::iterator>::iterator_category,
+        std::random_access_iterator_tag>::value,
+    "");
+
+std::vector<int> iota(int n)
+{
+    std::vector<int> retval(n);
+    std::iota(retval.begin(), retval.end(), 0);
+    return retval;
+}
+
+
+TEST(md_view, layout_right)
+{
+    std::vector<int> a = iota(12);
+    bsi::md_view<int, fixed34> m(a.data());
+    EXPECT_EQ(m.extent(0), 3);
+    EXPECT_EQ(m.extent(1), 4);
+    EXPECT_EQ(m.stride(0), 4);
+    EXPECT_EQ(m.stride(1), 1);
+    EXPECT_EQ(m.mapping().required_span_size(), 12);
+    EXPECT_EQ(m(0, 0), 0);
+    EXPECT_EQ(m(1, 2), 6);
+    EXPECT_EQ(m(2, 3), 11);
+    m(1, 2) = 42;
+    EXPECT_EQ(a[6], 42);
+
+    bsi::md_view<int, dyn2> d(a.data(), 3, 4);
+    EXPECT_EQ(d.extents(), dyn2(3, 4));
+    EXPECT_EQ(d(2, 1), 9);
+}
+
+TEST(md_view, layout_left)
+{
+    std::vector<int> a = iota(12);
+    bsi::md_view<int, fixed34, bsi::layout_left> m(a.data());
+    EXPECT_EQ(m.stride(0), 1);
+    EXPECT_EQ(m.stride(1), 3);
+    EXPECT_EQ(m(1, 2), 7);
+    EXPECT_EQ(m(2, 3), 11);
+
+    // The columns of a column-major matrix are contiguous.
+    auto const col = bsi::submd(m, bsi::full_extent, 2);
+    static_assert(
+        std::is_same<
+            decltype(col),
+            bsi::md_view<int, bsi::extents<3>, bsi::layout_left> const>::
+            value,
+        "");
+    EXPECT_EQ(
+        std::vector<int>(col.begin(), col.end()), (std::vector<int>{6, 7, 8}));
+}
+
+TEST(md_view, layout_stride)
+{
+    // Every other element of every other row of a 4x6 array.
+    std::vector<int> a = iota(24);
+    bsi::md_view<int, bsi::extents<2, 3>, bsi::layout_stride> m(
+        a.data(),
+        bsi::layout_stride::mapping<bsi::extents<2, 3>>({}, {{12, 2}}));
+    EXPECT_EQ(m(0, 0), 0);
+    EXPECT_EQ(m(0, 2), 4);
+    EXPECT_EQ(m(1, 1), 14);
+    EXPECT_EQ(m.mapping().required_span_size(), 17);
+
+    std::vector<int> row;
+    for (auto x : *(m.begin() + 1)) {
+        row.push_back(x);
+    }
+    EXPECT_EQ(row, (std::vector<int>{12, 14, 16}));
+}
+
+TEST(md_view, rows_and_columns)
+{
+    std::vector<int> a = iota(12);
+    bsi::md_view<int, dyn2> m(a.data(), 3, 4);
+    EXPECT_EQ(m.size(), 3);
+
+    std::vector<std::vector<int>> rows;
+    for (auto it = m.begin(); it != m.end(); ++it) {
+        auto row = *it;
+        rows.push_back(std::vector<int>(row.begin(), row.end()));
+    }
+    EXPECT_EQ(
+        rows,
+        (std::vector<std::vector<int>>{
+            {0, 1, 2, 3}, {4, 5, 6, 7}, {8, 9, 10, 11}}));
+    EXPECT_EQ(m[1].data(), a.data() + 4);
+    EXPECT_EQ(m.begin()[2](3), 11);
+    EXPECT_EQ(m.end() - m.begin(), 3);
+
+    auto const col = bsi::submd(m, bsi::full_extent, 1);
+    EXPECT_EQ(col.stride(0), 4);
+    EXPECT_EQ(
+        std::vector<int>(col.begin(), col.end()), (std::vector<int>{1, 5, 9}));
+    EXPECT_EQ(col.begin().stride(), 4);
+}
+
+TEST(md_view, submd)
+{
+    // A 2x3x4 array.
+    std::vector<int> a = iota(24);
+    bsi::md_view<int, bsi::extents<2, 3, 4>> m(a.data());
+
+    // A plane is contiguous, with its static extents.
+    auto const plane = bsi::submd(m, 1, bsi::full_extent, bsi::full_extent);
+    static_assert(
+        std::is_same<
+            decltype(plane),
+            bsi::md_view<int, bsi::extents<3, 4>> const>::value,
+        "");
+    EXPECT_EQ(plane(0, 0), 12);
+    EXPECT_EQ(plane(2, 3), 23);
+
+    // So is a range of rows, with a dynamic extent.
+    auto const rows =
+        bsi::submd(m, 1, std::make_pair(1, 3), bsi::full_extent);
+    static_assert(
+        std::is_same<
+            decltype(rows),
+            bsi::md_view<int, bsi::extents<bsi::dynamic_extent, 4>> const>::
+            value,
+        "");
+    EXPECT_EQ(rows.extent(0), 2);
+    EXPECT_EQ(rows(0, 0), 16);
+    EXPECT_EQ(rows(1, 3), 23);
+
+    // A block is padded: its rows are contiguous, but not adjacent.
+    auto const block = bsi::submd(
+        m, bsi::full_extent, std::make_pair(1, 3), std::make_pair(2, 4));
+    static_assert(
+        std::is_same<
+            decltype(block)::layout_type, bsi::layout_right_padded>::value,
+        "");
+    EXPECT_EQ(block.extent(0), 2);
+    EXPECT_EQ(block.extent(1), 2);
+    EXPECT_EQ(block.extent(2), 2);
+    EXPECT_EQ(block.stride(0), 12);
+    EXPECT_EQ(block.stride(1), 4);
+    EXPECT_EQ(block.stride(2), 1);
+    EXPECT_EQ(block(0, 0, 0), 6);
+    EXPECT_EQ(block(1, 1, 1), 23);
+
+    // And a slice of a slice.
+    auto const corner = bsi::submd(block, 1, 0, bsi::full_extent);
+    static_assert(
+        std::is_same<decltype(corner.begin()), int *>::value, "");
+    EXPECT_EQ(
+        std::vector<int>(corner.begin(), corner.end()),
+        (std::vector<int>{18, 19}));
+    auto const depth = bsi::submd(block, bsi::full_extent, 1, 1);
+    static_assert(
+        std::is_same<decltype(depth)::layout_type, bsi::layout_stride>::value,
+        "");
+    EXPECT_EQ(
+        std::vector<int>(depth.begin(), depth.end()),
+        (std::vector<int>{11, 23}));
+}
+
+TEST(md_view, constexpr_)
+{
+    static constexpr int a[6] = {0, 1, 2, 3, 4, 5};
+    constexpr bsi::md_view<int const, bsi::extents<2, 3>> m(a);
+    static_assert(m(1, 2) == 5, "");
+    static_assert(bsi::submd(m, bsi::full_extent, 1)(1) == 4, "");
+}
@@ -0,0 +1,133 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/stl_interfaces/mmap_view.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <numeric>
+#include <vector>
+
+
+using boost::stl_interfaces::mmap_view;
+using boost::stl_interfaces::mmap_huge_page_align;
+using boost::stl_interfaces::mmap_random;
+using boost::stl_interfaces::mmap_sequential;
+using boost::stl_interfaces::mmap_willneed;
+
+
+// Writes the bytes of the elements of v to path, plus extra bytes.
+template<typename T>
+void write_file(
+    char const * path, std::vector<T> const & v, std::size_t extra = 0)
+{
+    std::ofstream ofs(path, std::ios::binary);
+    ofs.write(
+        reinterpret_cast<char const *>(v.data()), v.size() * sizeof(T));
+    for (std::size_t i = 0; i < extra; ++i) {
+        ofs.put('x');
+    }
+}
+
+char const * const path = "mmap_test.bin";
+
+static_assert(!std::is_copy_constructible<mmap_view<int>>::value, "");
+static_assert(std::is_nothrow_move_constructible<mmap_view<int>>::value, "");
+
+
+TEST(mmap, default_ctor)
+{
+    mmap_view<int> v;
+    EXPECT_TRUE(v.empty());
+    EXPECT_EQ(v.size(), 0u);
+    EXPECT_EQ(v.begin(), v.end());
+}
+
+TEST(mmap, records)
+{
+    std::vector<std::uint64_t> expected(100000);
+    std::iota(expected.begin(), expected.end(), 7u);
+    write_file(path, expected);
+
+    unsigned const flag_sets[] = {
+        0,
+        mmap_sequential,
+        mmap_random | mmap_willneed,
+        mmap_huge_page_align,
+        mmap_sequential | mmap_willneed | mmap_huge_page_align};
+    for (auto flags : flag_sets) {
+        mmap_view<std::uint64_t> v(path, flags);
+        EXPECT_EQ(v.size(), std::ptrdiff_t(expected.size()));
+        EXPECT_EQ(v.mapped_size(), expected.size() * 8);
+        EXPECT_FALSE(v.empty());
+        EXPECT_TRUE(v);
+        EXPECT_EQ(v.front(), 7u);
+        EXPECT_EQ(v.back(), 7u + 99999u);
+        EXPECT_EQ(v[1234], 7u + 1234u);
+        EXPECT_EQ(v.data(), &*v.begin());
+        EXPECT_EQ(std::vector<std::uint64_t>(v.begin(), v.end()), expected);
+        if (flags & mmap_huge_page_align) {
+            EXPECT_EQ(
+                reinterpret_cast<std::uintptr_t>(v.data()) %
+                    mmap_view<std::uint64_t>::huge_page_size,
+                0u);
+        }
+    }
+    std::remove(path);
+}
+
+TEST(mmap, partial_record)
+{
+    std::vector<std::uint32_t> expected = {1, 2, 3};
+    write_file(path, expected, 3);
+    {
+        mmap_view<std::uint32_t> v(path);
+        EXPECT_EQ(v.size(), 3u);
+        EXPECT_EQ(v.mapped_size(), 15u);
+        EXPECT_EQ(std::vector<std::uint32_t>(v.begin(), v.end()), expected);
+    }
+
+    // A file shorter than one record is an empty view.
+    write_file(path, std::vector<std::uint32_t>(), 3);
+    {
+        mmap_view<std::uint32_t> v(path);
+        EXPECT_TRUE(v.empty());
+    }
+    std::remove(path);
+}
+
+TEST(mmap, move_swap)
+{
+    write_file(path, std::vector<int>{1, 2, 3});
+    mmap_view<int> v1(path);
+    std::remove(path);
+
+    // The mapping outlives the file's name.
+    mmap_view<int> v2 = std::move(v1);
+    EXPECT_TRUE(v1.empty());
+    EXPECT_EQ(v2.size(), 3u);
+    EXPECT_EQ(v2[2], 3);
+
+    swap(v1, v2);
+    EXPECT_TRUE(v2.empty());
+    EXPECT_EQ(v1[0], 1);
+
+    v2 = std::move(v1);
+    EXPECT_TRUE(v1.empty());
+    EXPECT_EQ(v2.size(), 3u);
+}
+
+TEST(mmap, errors)
+{
+    try {
+        mmap_view<int> v("no/such/file");
+        ADD_FAILURE();
+    } catch (std::system_error const & e) {
+        EXPECT_EQ(e.code(), std::errc::no_such_file_or_directory);
+    }
+}
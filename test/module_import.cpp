@@ -0,0 +1,129 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// A consumer of the boost.stl_interfaces module, built only when
+// BUILD_MODULE is set.  It uses no stl_interfaces header, so each name below
+// must be exported by module/stl_interfaces.cppm; the comparisons of
+// array_container also check that the namespace-scope operators are
+// reachable through ADL.
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <iterator>
+#include <vector>
+
+#include <cstddef>
+
+import boost.stl_interfaces;
+
+
+struct adapted_iter : boost::stl_interfaces::iterator_interface<
+                          adapted_iter,
+                          std::random_access_iterator_tag,
+                          int>
+{
+    adapted_iter() : it_(nullptr) {}
+    adapted_iter(int * it) : it_(it) {}
+
+private:
+    friend boost::stl_interfaces::access;
+    int *& base_reference() noexcept { return it_; }
+    int * base_reference() const noexcept { return it_; }
+
+    int * it_;
+};
+
+struct int_view : boost::stl_interfaces::view_interface<int_view>
+{
+    int_view(int * first, int * last) : first_(first), last_(last) {}
+
+    adapted_iter begin() const noexcept { return adapted_iter(first_); }
+    adapted_iter end() const noexcept { return adapted_iter(last_); }
+
+private:
+    int * first_;
+    int * last_;
+};
+
+struct array_container
+    : boost::stl_interfaces::container_interface<array_container>
+{
+    using value_type = int;
+    using reference = int &;
+    using const_reference = int const &;
+    using iterator = int *;
+    using const_iterator = int const *;
+    using reverse_iterator = boost::stl_interfaces::reverse_iterator<int *>;
+    using const_reverse_iterator =
+        boost::stl_interfaces::reverse_iterator<int const *>;
+    using difference_type = std::ptrdiff_t;
+    using size_type = std::size_t;
+
+    array_container() : elements_() {}
+    array_container(int a, int b, int c) : elements_{{a, b, c}} {}
+
+    iterator begin() noexcept { return elements_.data(); }
+    iterator end() noexcept { return elements_.data() + elements_.size(); }
+
+    size_type max_size() const noexcept { return elements_.size(); }
+
+    using base_type =
+        boost::stl_interfaces::container_interface<array_container>;
+    using base_type::begin;
+    using base_type::end;
+
+private:
+    std::array<int, 3> elements_;
+};
+
+
+TEST(module_import, iterator_interface)
+{
+    std::array<int, 4> ints = {{0, 1, 2, 3}};
+    adapted_iter first(ints.data());
+    adapted_iter last(ints.data() + ints.size());
+
+    EXPECT_EQ(last - first, 4);
+    EXPECT_EQ(first[2], 2);
+    EXPECT_TRUE(first < last);
+    EXPECT_EQ(std::vector<int>(first, last), (std::vector<int>{0, 1, 2, 3}));
+
+    auto rfirst =
+        boost::stl_interfaces::make_reverse_iterator(ints.data() + ints.size());
+    auto rlast = boost::stl_interfaces::make_reverse_iterator(ints.data());
+    EXPECT_EQ(std::vector<int>(rfirst, rlast), (std::vector<int>{3, 2, 1, 0}));
+}
+
+TEST(module_import, view_interface)
+{
+    std::array<int, 4> ints = {{0, 1, 2, 3}};
+    int_view v(ints.data() + 1, ints.data() + ints.size());
+
+    EXPECT_FALSE(v.empty());
+    EXPECT_TRUE(bool(v));
+    EXPECT_EQ(v.size(), 3u);
+    EXPECT_EQ(v.front(), 1);
+    EXPECT_EQ(v.back(), 3);
+    EXPECT_EQ(v[1], 2);
+}
+
+TEST(module_import, container_interface)
+{
+    array_container a(1, 2, 3);
+    array_container const b(1, 2, 4);
+
+    EXPECT_EQ(a.size(), 3u);
+    EXPECT_EQ(a.front(), 1);
+    EXPECT_EQ(a.back(), 3);
+    EXPECT_EQ(*a.rbegin(), 3);
+    EXPECT_EQ(*b.crbegin(), 4);
+
+    EXPECT_TRUE(a == a);
+    EXPECT_TRUE(a != b);
+    EXPECT_TRUE(a < b);
+    EXPECT_TRUE(b >= a);
+}
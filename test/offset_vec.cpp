@@ -0,0 +1,168 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/stl_interfaces/offset_ptr.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include <cstring>
+
+
+using boost::stl_interfaces::offset_iterator;
+using boost::stl_interfaces::offset_ptr;
+using boost::stl_interfaces::offset_vector;
+
+
+TEST(offset_ptr, pointer_semantics)
+{
+    int xs[3] = {1, 2, 3};
+
+    offset_ptr<int> null;
+    EXPECT_FALSE(null);
+    EXPECT_EQ(null.get(), nullptr);
+    EXPECT_EQ(null, offset_ptr<int>(nullptr));
+
+    offset_ptr<int> p(xs + 1);
+    EXPECT_TRUE(p);
+    EXPECT_EQ(p.get(), xs + 1);
+    EXPECT_EQ(*p, 2);
+    EXPECT_EQ(p[1], 3);
+
+    // A copy at another address points to the same object.
+    std::vector<offset_ptr<int>> copies(4, p);
+    for (auto const & q : copies) {
+        EXPECT_EQ(q.get(), xs + 1);
+        EXPECT_EQ(q, p);
+    }
+
+    offset_ptr<int const> c = p;
+    EXPECT_EQ(c.get(), xs + 1);
+    p = xs;
+    EXPECT_EQ(*p, 1);
+    p = nullptr;
+    EXPECT_FALSE(p);
+}
+
+TEST(offset_iterator, random_access)
+{
+    int xs[5] = {0, 1, 2, 3, 4};
+    offset_iterator<int> const first(xs);
+    offset_iterator<int> const last(xs + 5);
+
+    EXPECT_EQ(last - first, 5);
+    EXPECT_EQ(std::accumulate(first, last, 0), 10);
+    EXPECT_EQ(first[3], 3);
+    EXPECT_EQ((first + 2).get(), xs + 2);
+    EXPECT_TRUE(first < last);
+
+    offset_iterator<int const> cfirst = first;
+    EXPECT_EQ(*cfirst, 0);
+
+    std::reverse(first, last);
+    EXPECT_EQ(xs[0], 4);
+    EXPECT_EQ(xs[4], 0);
+}
+
+TEST(offset_vector, container)
+{
+    alignas(std::string) unsigned char buffer[8 * sizeof(std::string)];
+    offset_vector<std::string> v(
+        reinterpret_cast<std::string *>(buffer), 8);
+
+    EXPECT_TRUE(v.empty());
+    EXPECT_EQ(v.capacity(), 8u);
+    EXPECT_EQ(v.data(), reinterpret_cast<std::string *>(buffer));
+
+    v.push_back("b");
+    v.push_back("d");
+    v.insert(v.begin(), "a");
+    v.emplace(v.begin() + 2, "c");
+    EXPECT_EQ(v.size(), 4u);
+    EXPECT_EQ(v.front(), "a");
+    EXPECT_EQ(v[2], "c");
+    EXPECT_EQ(v.back(), "d");
+
+    v.erase(v.begin() + 1);
+    EXPECT_EQ(v.size(), 3u);
+    EXPECT_EQ(v[1], "c");
+
+    for (int i = 0; i < 5; ++i) {
+        v.push_back("x");
+    }
+    EXPECT_THROW(v.push_back("y"), std::length_error);
+
+    v.clear();
+    EXPECT_TRUE(v.empty());
+}
+
+TEST(offset_vector, swap)
+{
+    int a_buffer[4];
+    int b_buffer[2];
+    offset_vector<int> a(a_buffer, 4);
+    offset_vector<int> b(b_buffer, 2);
+    a.push_back(1);
+    a.push_back(2);
+    a.push_back(3);
+    b.push_back(4);
+
+    swap(a, b);
+    EXPECT_EQ(a.data(), b_buffer);
+    EXPECT_EQ(a.size(), 1u);
+    EXPECT_EQ(a.capacity(), 2u);
+    EXPECT_EQ(b.data(), a_buffer);
+    EXPECT_EQ(b.size(), 3u);
+    EXPECT_EQ(b[2], 3);
+}
+
+// A block that refers to itself only through offset_ptrs, including an
+// offset_vector of offset_vectors, is still correct after a memcpy() to
+// another address.
+struct block
+{
+    block() : rows(row_headers, 4), cursor()
+    {
+        for (int i = 0; i < 4; ++i) {
+            rows.emplace_back(cells[i], 4);
+            for (int j = 0; j <= i; ++j) {
+                rows.back().push_back(10 * i + j);
+            }
+        }
+        cursor = rows[2].begin() + 1;
+    }
+
+    offset_vector<offset_vector<int>> rows;
+    offset_iterator<int> cursor;
+    offset_vector<int> row_headers[4];
+    int cells[4][4];
+};
+
+TEST(offset_vector, relocated_block)
+{
+    alignas(block) unsigned char first[sizeof(block)];
+    alignas(block) unsigned char second[sizeof(block)];
+    ::new (first) block;
+
+    std::memcpy(second, first, sizeof(block));
+    // Scribble over the original, so that nothing can point into it.
+    std::memset(first, 0xff, sizeof(block));
+
+    auto const & b = *reinterpret_cast<block *>(second);
+    ASSERT_EQ(b.rows.size(), 4u);
+    EXPECT_EQ(b.rows.data(), b.row_headers);
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_EQ(b.rows[i].data(), b.cells[i]);
+        EXPECT_EQ(b.rows[i].size(), std::size_t(i + 1));
+        EXPECT_EQ(b.rows[i].back(), 10 * i + i);
+    }
+    EXPECT_EQ(*b.cursor, 21);
+    EXPECT_EQ(b.cursor.get(), b.cells[2] + 1);
+}
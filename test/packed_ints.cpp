@@ -0,0 +1,219 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/stl_interfaces/packed_int_vector.hpp>
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+
+using boost::stl_interfaces::packed_int_vector;
+
+
+// Instantiate all the members we can.
+template struct packed_int_vector<1>;
+template struct packed_int_vector<13>;
+template struct packed_int_vector<32>;
+
+using vec_t = packed_int_vector<7>;
+
+static_assert(
+    std::is_same<
+        std::iterator_traits<vec_t::iterator>::iterator_category,
+        std::random_access_iterator_tag>::value,
+    "");
+static_assert(
+    std::is_same<vec_t::const_iterator::reference, std::uint32_t>::value, "");
+static_assert(
+    std::is_convertible<vec_t::iterator, vec_t::const_iterator>::value, "");
+static_assert(vec_t::max_value == 127u, "");
+
+template<typename Vec>
+std::vector<std::uint32_t> random_values(int n)
+{
+    std::mt19937 gen(Vec::bits);
+    std::vector<std::uint32_t> retval(n);
+    for (auto & x : retval) {
+        x = gen() & Vec::max_value;
+    }
+    return retval;
+}
+
+template<typename Vec>
+void test_round_trip()
+{
+    auto const values = random_values<Vec>(300);
+    Vec v(values.begin(), values.end());
+    ASSERT_EQ(v.size(), values.size());
+    EXPECT_TRUE(std::equal(v.begin(), v.end(), values.begin(), values.end()));
+
+    // Every start and length modulo 64, and the full blocks between.
+    for (int first = 0; first < 70; first += 3) {
+        for (int last = first; last <= 300; last += 11) {
+            std::vector<std::uint32_t> out(last - first + 1, 0xdeadbeef);
+            auto const end =
+                copy(v.cbegin() + first, v.cbegin() + last, out.data());
+            ASSERT_EQ(end - out.data(), last - first);
+            EXPECT_TRUE(
+                std::equal(out.data(), end, values.begin() + first));
+            EXPECT_EQ(out.back(), 0xdeadbeef);
+        }
+    }
+
+    // The same, packing into the elements.  The elements outside [first,
+    // last) keep their values.
+    for (int first = 0; first < 70; first += 5) {
+        for (int last = first; last <= 300; last += 13) {
+            Vec w(values.begin(), values.end());
+            std::vector<std::uint32_t> in(last - first);
+            for (int i = 0; i < last - first; ++i) {
+                in[i] = Vec::max_value - values[first + i];
+            }
+            auto const end =
+                copy(in.data(), in.data() + in.size(), w.begin() + first);
+            ASSERT_EQ(end - w.begin(), last);
+            for (int i = 0; i < 300; ++i) {
+                auto const expected = first <= i && i < last
+                                          ? Vec::max_value - values[i]
+                                          : values[i];
+                ASSERT_EQ(w[i], expected);
+            }
+        }
+    }
+
+    // Writes do not disturb the neighbors.
+    auto expected = values;
+    for (int i = 0; i < 300; i += 5) {
+        v[i] = Vec::max_value;
+        expected[i] = Vec::max_value;
+        v[i + 1] = 0;
+        expected[i + 1] = 0;
+    }
+    EXPECT_TRUE(
+        std::equal(v.begin(), v.end(), expected.begin(), expected.end()));
+}
+
+
+TEST(packed_ints, default_ctor)
+{
+    vec_t v;
+    EXPECT_TRUE(v.empty());
+    EXPECT_EQ(v.size(), 0u);
+    EXPECT_EQ(v.begin(), v.end());
+    EXPECT_EQ(v.capacity(), 0u);
+    EXPECT_EQ(v, v);
+}
+
+TEST(packed_ints, round_trip)
+{
+    test_round_trip<packed_int_vector<1>>();
+    test_round_trip<packed_int_vector<4>>();
+    test_round_trip<packed_int_vector<7>>();
+    test_round_trip<packed_int_vector<13>>();
+    test_round_trip<packed_int_vector<20>>();
+    test_round_trip<packed_int_vector<31>>();
+    test_round_trip<packed_int_vector<32>>();
+}
+
+TEST(packed_ints, batch_access)
+{
+    namespace bsi = boost::stl_interfaces;
+    static_assert(
+        bsi::v1_dtl::has_read_n<vec_t::const_iterator, std::uint32_t>::value,
+        "");
+    static_assert(
+        bsi::v1_dtl::has_write_n<vec_t::iterator, std::uint32_t>::value, "");
+    static_assert(
+        !bsi::v1_dtl::has_write_n<vec_t::const_iterator, std::uint32_t>::
+            value,
+        "");
+    static_assert(
+        !bsi::v1_dtl::has_read_n<vec_t::const_iterator, int>::value, "");
+
+    auto const values = random_values<vec_t>(1000);
+    vec_t v(values.begin(), values.end());
+
+    std::vector<std::uint32_t> out(1000);
+    EXPECT_EQ(bsi::read_n(v.cbegin() + 3, 900, out.data()), &out[900]);
+    EXPECT_TRUE(std::equal(&out[0], &out[900], values.begin() + 3));
+
+    // Without a matching read_n(), one element at a time.
+    std::vector<int> ints(1000);
+    EXPECT_EQ(bsi::read_n(v.cbegin(), 1000, ints.data()), &ints[0] + 1000);
+    EXPECT_TRUE(std::equal(ints.begin(), ints.end(), values.begin()));
+
+    std::vector<std::uint32_t> const zeros(500, 0);
+    EXPECT_EQ(
+        bsi::write_n(zeros.data(), 500, v.begin() + 100), v.begin() + 600);
+    EXPECT_EQ(v[99], values[99]);
+    EXPECT_EQ(v[100], 0u);
+    EXPECT_EQ(v[599], 0u);
+    EXPECT_EQ(v[600], values[600]);
+
+    // transform() goes through a buffer, in batches of 256.
+    v = vec_t(values.begin(), values.end());
+    auto const twice = [](std::uint32_t x) { return 2 * x; };
+    EXPECT_EQ(
+        bsi::transform(v.cbegin(), v.cend(), out.data(), twice),
+        &out[0] + 1000);
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_EQ(out[i], 2 * values[i]);
+    }
+    auto const half = [](std::uint32_t x) { return x / 2; };
+    EXPECT_EQ(
+        bsi::transform(&out[0] + 1, &out[0] + 1000, v.begin(), half),
+        v.begin() + 999);
+    for (int i = 0; i < 999; ++i) {
+        EXPECT_EQ(v[i], values[i + 1]);
+    }
+    EXPECT_EQ(v[999], values[999]);
+}
+
+TEST(packed_ints, modifiers)
+{
+    vec_t v(10, 5);
+    EXPECT_EQ(v.size(), 10u);
+    EXPECT_EQ(v.front(), 5u);
+    v.resize(20, 9);
+    EXPECT_EQ(v[9], 5u);
+    EXPECT_EQ(v[10], 9u);
+    v.resize(5);
+    v.resize(6);
+    EXPECT_EQ(v.back(), 0u);
+
+    vec_t w = {1, 2, 3, 4};
+    w.insert(w.begin() + 1, 10);
+    w.emplace(w.end(), 11);
+    EXPECT_EQ(w, (vec_t{1, 10, 2, 3, 4, 11}));
+    w.erase(w.begin() + 2, w.begin() + 4);
+    EXPECT_EQ(w, (vec_t{1, 10, 4, 11}));
+    w.erase(w.begin());
+    w.pop_back();
+    EXPECT_EQ(w, (vec_t{10, 4}));
+
+    std::sort(v.begin(), v.end());
+    swap(v[0], v[5]);
+    EXPECT_EQ(v[5], 0u);
+    EXPECT_EQ(v[0], 5u);
+}
+
+TEST(packed_ints, copy_move_swap)
+{
+    vec_t a = {1, 2, 3};
+    vec_t b = a;
+    EXPECT_EQ(a, b);
+    vec_t c = std::move(b);
+    EXPECT_TRUE(b.empty());
+    EXPECT_EQ(c, a);
+    b = {4};
+    swap(b, c);
+    EXPECT_EQ(b, a);
+    EXPECT_LT(a, c);
+    c = std::move(a);
+    EXPECT_EQ(c, b);
+}
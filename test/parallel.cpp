@@ -0,0 +1,496 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/parallel.hpp>
+#include <boost/stl_interfaces/strided_view.hpp>
+
+#include "view_tests.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <iterator>
+#include <list>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+using int_view = subrange<int *, int *, boost::stl_interfaces::contiguous>;
+using list_view = subrange<
+    std::list<int>::iterator,
+    std::list<int>::iterator,
+    boost::stl_interfaces::discontiguous>;
+
+static_assert(boost::stl_interfaces::is_splittable_view<int_view>::value, "");
+static_assert(
+    !boost::stl_interfaces::is_splittable_view<list_view>::value, "");
+static_assert(
+    !boost::stl_interfaces::is_splittable_view<std::vector<int>>::value, "");
+
+
+TEST(parallel, split_at)
+{
+    std::vector<int> ints = {0, 1, 2, 3, 4};
+    int_view const v(ints.data(), ints.data() + ints.size());
+
+    auto const halves = boost::stl_interfaces::split_at(v, v.begin() + 2);
+    static_assert(
+        std::is_same<
+            decltype(halves),
+            std::pair<int_view, int_view> const>::value,
+        "");
+    EXPECT_EQ(halves.first.begin(), ints.data());
+    EXPECT_EQ(halves.first.size(), 2);
+    EXPECT_EQ(halves.second.begin(), ints.data() + 2);
+    EXPECT_EQ(halves.second.size(), 3);
+
+    auto const all_first = boost::stl_interfaces::split_at(v, v.end());
+    EXPECT_EQ(all_first.first.size(), 5);
+    EXPECT_TRUE(all_first.second.empty());
+}
+
+TEST(parallel, split)
+{
+    std::vector<int> ints(10);
+    std::iota(ints.begin(), ints.end(), 0);
+    int_view const v(ints.data(), ints.data() + ints.size());
+
+    {
+        auto const pieces = boost::stl_interfaces::split(v, 3);
+        ASSERT_EQ(pieces.size(), 3u);
+        EXPECT_EQ(pieces[0].size(), 4);
+        EXPECT_EQ(pieces[1].size(), 3);
+        EXPECT_EQ(pieces[2].size(), 3);
+        EXPECT_EQ(pieces[0].begin(), v.begin());
+        EXPECT_EQ(pieces[0].end(), pieces[1].begin());
+        EXPECT_EQ(pieces[1].end(), pieces[2].begin());
+        EXPECT_EQ(pieces[2].end(), v.end());
+    }
+    {
+        auto const pieces = boost::stl_interfaces::split(v, 20);
+        ASSERT_EQ(pieces.size(), 10u);
+        for (auto const & piece : pieces) {
+            EXPECT_EQ(piece.size(), 1);
+        }
+    }
+    {
+        int_view const empty(ints.data(), ints.data());
+        EXPECT_TRUE(boost::stl_interfaces::split(empty, 4).empty());
+    }
+}
+
+TEST(parallel, parallel_for_each)
+{
+    std::vector<int> ints(100000);
+    std::iota(ints.begin(), ints.end(), 0);
+    int_view const v(ints.data(), ints.data() + ints.size());
+
+    for (unsigned int threads : {0u, 1u, 2u, 3u, 8u}) {
+        std::atomic<long long> sum(0);
+        std::atomic<int> count(0);
+        boost::stl_interfaces::parallel_for_each(
+            v,
+            [&](int x) {
+                sum += x;
+                ++count;
+            },
+            1000,
+            threads);
+        EXPECT_EQ(count, 100000);
+        EXPECT_EQ(sum, 100000LL * 99999 / 2);
+    }
+
+    std::vector<int> doubled = ints;
+    int_view const dv(doubled.data(), doubled.data() + doubled.size());
+    boost::stl_interfaces::parallel_for_each(
+        dv, [](int & x) { x *= 2; }, 10, 4);
+    for (std::size_t i = 0; i < ints.size(); ++i) {
+        EXPECT_EQ(doubled[i], 2 * ints[i]);
+    }
+}
+
+TEST(parallel, parallel_for_each_throws)
+{
+    std::vector<int> ints(1000);
+    std::iota(ints.begin(), ints.end(), 0);
+    int_view const v(ints.data(), ints.data() + ints.size());
+    EXPECT_THROW(
+        boost::stl_interfaces::parallel_for_each(
+            v,
+            [](int x) {
+                if (x == 777)
+                    throw std::runtime_error("777");
+            },
+            10,
+            4),
+        std::runtime_error);
+}
+
+TEST(parallel, thread_pool)
+{
+    std::atomic<int> count(0);
+    {
+        boost::stl_interfaces::thread_pool pool(3);
+        EXPECT_EQ(pool.size(), 3u);
+        for (int i = 0; i < 100; ++i) {
+            pool.submit([&] { ++count; });
+        }
+    }
+    EXPECT_EQ(count, 100);
+}
+
+TEST(parallel, iterator_parallel_for_each)
+{
+    std::vector<int> ints(100000);
+    std::iota(ints.begin(), ints.end(), 0);
+
+    for (unsigned int threads : {0u, 1u, 3u}) {
+        boost::stl_interfaces::thread_pool pool(threads);
+        std::atomic<long long> sum(0);
+        boost::stl_interfaces::parallel_for_each(
+            pool,
+            ints.begin(),
+            ints.end(),
+            [&](int x) { sum += x; },
+            100);
+        EXPECT_EQ(sum, 100000LL * 99999 / 2);
+    }
+
+    // An iterator_interface iterator that is not contiguous: every other
+    // element.
+    std::vector<int> doubled = ints;
+    auto const evens = boost::stl_interfaces::make_strided_view(
+        doubled.data(), doubled.size() / 2, 2);
+    boost::stl_interfaces::parallel_for_each(
+        evens.begin(), evens.end(), [](int & x) { x *= 2; }, 10);
+    for (std::size_t i = 0; i < ints.size(); ++i) {
+        EXPECT_EQ(doubled[i], (i % 2 ? 1 : 2) * ints[i]);
+    }
+
+    boost::stl_interfaces::thread_pool pool(2);
+    EXPECT_THROW(
+        boost::stl_interfaces::parallel_for_each(
+            pool,
+            ints.data(),
+            ints.data() + ints.size(),
+            [](int x) {
+                if (x == 777)
+                    throw std::runtime_error("777");
+            },
+            10),
+        std::runtime_error);
+}
+
+TEST(parallel, parallel_transform)
+{
+    std::vector<int> ints(10000);
+    std::iota(ints.begin(), ints.end(), 0);
+    std::vector<long long> squares(ints.size());
+
+    boost::stl_interfaces::thread_pool pool(3);
+    auto const out = boost::stl_interfaces::parallel_transform(
+        pool,
+        ints.data(),
+        ints.data() + ints.size(),
+        squares.begin(),
+        [](int x) { return (long long)x * x; },
+        100);
+    EXPECT_EQ(out, squares.end());
+    for (std::size_t i = 0; i < ints.size(); ++i) {
+        EXPECT_EQ(squares[i], (long long)ints[i] * ints[i]);
+    }
+
+    std::vector<int> empty;
+    auto const empty_out = boost::stl_interfaces::parallel_transform(
+        empty.begin(), empty.end(), squares.begin(), [](int x) {
+            return (long long)x;
+        });
+    EXPECT_EQ(empty_out, squares.begin());
+}
+
+TEST(parallel, parallel_reduce)
+{
+    std::vector<int> ints(100000);
+    std::iota(ints.begin(), ints.end(), 0);
+
+    boost::stl_interfaces::thread_pool pool(3);
+    EXPECT_EQ(
+        boost::stl_interfaces::parallel_reduce(
+            pool,
+            ints.begin(),
+            ints.end(),
+            1LL,
+            std::plus<long long>{},
+            100),
+        1 + 100000LL * 99999 / 2);
+
+    // Not commutative: the order of the elements is kept.
+    std::vector<std::string> strs(300);
+    for (std::size_t i = 0; i < strs.size(); ++i) {
+        strs[i] = std::string(1, char('a' + i % 26));
+    }
+    std::string const expected =
+        std::accumulate(strs.begin(), strs.end(), std::string(">"));
+    EXPECT_EQ(
+        boost::stl_interfaces::parallel_reduce(
+            pool,
+            strs.begin(),
+            strs.end(),
+            std::string(">"),
+            std::plus<std::string>{},
+            7),
+        expected);
+
+    EXPECT_EQ(
+        boost::stl_interfaces::parallel_reduce(
+            ints.begin(), ints.begin(), 42, std::plus<int>{}),
+        42);
+}
+
+TEST(parallel, parallel_inclusive_scan)
+{
+    namespace bsi = boost::stl_interfaces;
+    std::vector<int> ints(100003);
+    for (std::size_t i = 0; i < ints.size(); ++i) {
+        ints[i] = int(i % 7) - 2;
+    }
+    std::vector<int> expected(ints.size());
+    std::partial_sum(ints.begin(), ints.end(), expected.begin());
+
+    for (unsigned int threads : {0u, 3u}) {
+        bsi::thread_pool pool(threads);
+        // Pointers to ints: the SIMD kernel.
+        std::vector<int> sums(ints.size());
+        auto const out = bsi::parallel_inclusive_scan(
+            pool,
+            ints.data(),
+            ints.data() + ints.size(),
+            sums.data(),
+            std::plus<>{},
+            1000);
+        EXPECT_EQ(out, sums.data() + sums.size());
+        EXPECT_EQ(sums, expected);
+
+        // Not pointers, and in place.
+        std::vector<long long> in_place(ints.begin(), ints.end());
+        bsi::parallel_inclusive_scan(
+            pool,
+            in_place.begin(),
+            in_place.end(),
+            in_place.begin(),
+            std::plus<long long>{},
+            1000);
+        EXPECT_TRUE(std::equal(
+            in_place.begin(), in_place.end(), expected.begin()));
+
+        // Not commutative.
+        std::vector<std::string> strs(300);
+        for (std::size_t i = 0; i < strs.size(); ++i) {
+            strs[i] = std::string(1, char('a' + i % 26));
+        }
+        std::vector<std::string> expected_strs(strs.size());
+        std::partial_sum(strs.begin(), strs.end(), expected_strs.begin());
+        std::vector<std::string> str_sums(strs.size());
+        bsi::parallel_inclusive_scan(
+            pool,
+            strs.begin(),
+            strs.end(),
+            str_sums.begin(),
+            std::plus<std::string>{},
+            7);
+        EXPECT_EQ(str_sums, expected_strs);
+    }
+
+    std::vector<int> few = {3, 1, 4};
+    std::vector<int> few_sums(3);
+    bsi::parallel_inclusive_scan(few.begin(), few.end(), few_sums.begin());
+    EXPECT_EQ(few_sums, (std::vector<int>{3, 4, 8}));
+    EXPECT_EQ(
+        bsi::parallel_inclusive_scan(
+            few.begin(), few.begin(), few_sums.begin()),
+        few_sums.begin());
+}
+
+TEST(parallel, parallel_exclusive_scan)
+{
+    namespace bsi = boost::stl_interfaces;
+    // Offsets of variable-length records from their lengths.
+    std::vector<std::uint32_t> lengths(50001);
+    for (std::size_t i = 0; i < lengths.size(); ++i) {
+        lengths[i] = std::uint32_t(i * 2654435761u % 97);
+    }
+    std::vector<std::uint32_t> expected(lengths.size());
+    std::uint32_t sum = 16;
+    for (std::size_t i = 0; i < lengths.size(); ++i) {
+        expected[i] = sum;
+        sum += lengths[i];
+    }
+
+    for (unsigned int threads : {0u, 3u}) {
+        bsi::thread_pool pool(threads);
+        std::vector<std::uint32_t> offsets(lengths.size());
+        bsi::parallel_exclusive_scan(
+            pool,
+            lengths.data(),
+            lengths.data() + lengths.size(),
+            offsets.data(),
+            std::uint32_t(16),
+            std::plus<>{},
+            1000);
+        EXPECT_EQ(offsets, expected);
+
+        std::vector<std::uint32_t> in_place = lengths;
+        bsi::parallel_exclusive_scan(
+            pool,
+            in_place.data(),
+            in_place.data() + in_place.size(),
+            in_place.data(),
+            std::uint32_t(16),
+            std::plus<>{},
+            1000);
+        EXPECT_EQ(in_place, expected);
+
+        // Through a strided_view's iterators: every other length.
+        auto const every_other = bsi::make_strided_view(
+            lengths.data(), std::ptrdiff_t(lengths.size() / 2), 2);
+        std::vector<long long> strided_offsets(every_other.size());
+        bsi::parallel_exclusive_scan(
+            pool,
+            every_other.begin(),
+            every_other.end(),
+            strided_offsets.begin(),
+            0LL,
+            std::plus<long long>{},
+            100);
+        long long strided_sum = 0;
+        for (std::size_t i = 0; i < strided_offsets.size(); ++i) {
+            ASSERT_EQ(strided_offsets[i], strided_sum);
+            strided_sum += lengths[2 * i];
+        }
+    }
+
+    std::vector<int> few = {3, 1, 4};
+    std::vector<int> few_offsets(3);
+    bsi::parallel_exclusive_scan(
+        few.begin(), few.end(), few_offsets.begin(), 0);
+    EXPECT_EQ(few_offsets, (std::vector<int>{0, 3, 4}));
+}
+
+TEST(parallel, parallel_copy_if)
+{
+    namespace bsi = boost::stl_interfaces;
+    std::vector<int> ints(100003);
+    for (std::size_t i = 0; i < ints.size(); ++i) {
+        ints[i] = int(i * 2654435761u % 1000);
+    }
+    auto const small = [](int x) { return x < 300; };
+    std::vector<int> expected;
+    std::copy_if(ints.begin(), ints.end(), std::back_inserter(expected), small);
+
+    for (unsigned int threads : {0u, 3u}) {
+        bsi::thread_pool pool(threads);
+        // Pointers to ints: the branch-free copy.
+        std::vector<int> kept(ints.size(), -1);
+        auto const out = bsi::parallel_copy_if(
+            pool,
+            ints.data(),
+            ints.data() + ints.size(),
+            kept.data(),
+            small,
+            1000);
+        EXPECT_EQ(out - kept.data(), std::ptrdiff_t(expected.size()));
+        EXPECT_TRUE(std::equal(expected.begin(), expected.end(), kept.data()));
+        EXPECT_EQ(kept[expected.size()], -1);
+
+        for (int bound : {0, 1000}) {
+            auto const below = [bound](int x) { return x < bound; };
+            EXPECT_EQ(
+                bsi::parallel_copy_if(
+                    pool,
+                    ints.data(),
+                    ints.data() + ints.size(),
+                    kept.data(),
+                    below,
+                    1000) -
+                    kept.data(),
+                bound ? std::ptrdiff_t(ints.size()) : 0);
+        }
+        EXPECT_TRUE(std::equal(ints.begin(), ints.end(), kept.begin()));
+
+        // Not trivially copyable.
+        std::vector<std::string> strs(1000);
+        for (std::size_t i = 0; i < strs.size(); ++i) {
+            strs[i] = std::to_string(i);
+        }
+        auto const odd = [](std::string const & s) {
+            return (s.back() - '0') % 2 == 1;
+        };
+        std::vector<std::string> kept_strs(strs.size());
+        auto const strs_out = bsi::parallel_copy_if(
+            pool, strs.begin(), strs.end(), kept_strs.begin(), odd, 7);
+        EXPECT_EQ(strs_out - kept_strs.begin(), 500);
+        for (std::size_t i = 0; i < 500; ++i) {
+            ASSERT_EQ(kept_strs[i], std::to_string(2 * i + 1));
+        }
+
+        // Through a strided_view's iterators.
+        auto const every_other = bsi::make_strided_view(
+            ints.data(), std::ptrdiff_t(ints.size() / 2), 2);
+        std::vector<int> strided_expected;
+        std::copy_if(
+            every_other.begin(),
+            every_other.end(),
+            std::back_inserter(strided_expected),
+            small);
+        std::vector<int> strided_kept(every_other.size());
+        strided_kept.resize(
+            bsi::parallel_copy_if(
+                pool,
+                every_other.begin(),
+                every_other.end(),
+                strided_kept.begin(),
+                small,
+                100) -
+            strided_kept.begin());
+        EXPECT_EQ(strided_kept, strided_expected);
+    }
+
+    std::vector<int> few = {3, 1, 4, 1, 5};
+    std::vector<int> few_kept(5);
+    few_kept.resize(
+        bsi::parallel_copy_if(
+            few.begin(),
+            few.end(),
+            few_kept.begin(),
+            [](int x) { return x != 1; }) -
+        few_kept.begin());
+    EXPECT_EQ(few_kept, (std::vector<int>{3, 4, 5}));
+    EXPECT_EQ(
+        bsi::parallel_copy_if(
+            few.begin(), few.begin(), few_kept.begin(), small),
+        few_kept.begin());
+}
+
+TEST(parallel, nested)
+{
+    // Nested calls on a pool with one worker finish, since each calling
+    // thread takes chunks too.
+    boost::stl_interfaces::thread_pool pool(1);
+    std::vector<int> ints(64, 1);
+    std::atomic<int> sum(0);
+    boost::stl_interfaces::parallel_for_each(
+        pool,
+        ints.begin(),
+        ints.end(),
+        [&](int) {
+            sum += boost::stl_interfaces::parallel_reduce(
+                pool, ints.begin(), ints.end(), 0, std::plus<int>{}, 4);
+        },
+        4);
+    EXPECT_EQ(sum, 64 * 64);
+}
@@ -0,0 +1,152 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/parallel_sort.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+
+namespace bsi = boost::stl_interfaces;
+
+namespace {
+    std::vector<int> random_ints(std::size_t n, int lo, int hi)
+    {
+        std::mt19937 gen(42);
+        std::uniform_int_distribution<int> dist(lo, hi);
+        std::vector<int> retval(n);
+        for (auto & x : retval) {
+            x = dist(gen);
+        }
+        return retval;
+    }
+
+    struct first_of
+    {
+        template<typename Tuple>
+        auto operator()(Tuple const & t) const
+        {
+            return std::get<0>(t);
+        }
+    };
+}
+
+
+TEST(parallel_sort, values)
+{
+    bsi::thread_pool pool(3);
+    for (std::size_t n : {0, 1, 2, 100, 5000, 100000}) {
+        auto ints = random_ints(n, -1000, 1000);
+        auto expected = ints;
+        std::sort(expected.begin(), expected.end());
+
+        bsi::parallel_sort(pool, ints.begin(), ints.end(), std::less<>{}, 64);
+        EXPECT_EQ(ints, expected) << "n=" << n;
+    }
+
+    {
+        auto ints = random_ints(10000, 0, 100);
+        auto expected = ints;
+        std::sort(expected.begin(), expected.end(), std::greater<>{});
+        bsi::parallel_sort(ints.begin(), ints.end(), std::greater<>{});
+        EXPECT_EQ(ints, expected);
+    }
+
+    {
+        bsi::thread_pool no_workers(0);
+        auto ints = random_ints(10000, -50, 50);
+        auto expected = ints;
+        std::sort(expected.begin(), expected.end());
+        bsi::parallel_sort(no_workers, ints.begin(), ints.end());
+        EXPECT_EQ(ints, expected);
+    }
+}
+
+TEST(parallel_sort, zip)
+{
+    bsi::thread_pool pool(3);
+    std::size_t const n = 20000;
+    auto keys = random_ints(n, -100000, 100000);
+    std::vector<std::string> strings(n);
+    std::vector<double> doubles(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        strings[i] = std::to_string(keys[i]);
+        doubles[i] = keys[i] * 0.5;
+    }
+
+    auto const zip = bsi::make_zip_view(keys, strings, doubles);
+    bsi::parallel_sort(pool, zip.begin(), zip.end(), std::less<>{}, 256);
+
+    EXPECT_TRUE(std::is_sorted(keys.begin(), keys.end()));
+    for (std::size_t i = 0; i < n; ++i) {
+        EXPECT_EQ(strings[i], std::to_string(keys[i]));
+        EXPECT_EQ(doubles[i], keys[i] * 0.5);
+    }
+}
+
+TEST(parallel_sort, by_integral_key)
+{
+    bsi::thread_pool pool(3);
+    std::size_t const n = 50000;
+    auto keys = random_ints(n, -300, 300);
+    std::vector<int> rows(n);
+    std::iota(rows.begin(), rows.end(), 0);
+
+    std::vector<std::pair<int, int>> expected(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        expected[i] = std::make_pair(keys[i], rows[i]);
+    }
+    std::stable_sort(
+        expected.begin(),
+        expected.end(),
+        [](auto const & lhs, auto const & rhs) {
+            return lhs.first < rhs.first;
+        });
+
+    auto const zip = bsi::make_zip_view(keys, rows);
+    bsi::parallel_sort_by_key(pool, zip.begin(), zip.end(), first_of{}, 256);
+
+    // The sort is stable: rows with equal keys stay in order.
+    for (std::size_t i = 0; i < n; ++i) {
+        EXPECT_EQ(keys[i], expected[i].first);
+        EXPECT_EQ(rows[i], expected[i].second);
+    }
+
+    // Keys that fit in the low byte of an unsigned long long.
+    std::vector<unsigned long long> wide(n);
+    std::vector<int> wide_rows(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        wide[i] = (n - i) % 200;
+        wide_rows[i] = int(i);
+    }
+    auto const wide_zip = bsi::make_zip_view(wide, wide_rows);
+    bsi::parallel_sort_by_key(wide_zip.begin(), wide_zip.end(), first_of{});
+    EXPECT_TRUE(std::is_sorted(wide.begin(), wide.end()));
+    for (std::size_t i = 0; i < n; ++i) {
+        EXPECT_EQ(wide[i], (n - wide_rows[i]) % 200);
+    }
+}
+
+TEST(parallel_sort, by_other_key)
+{
+    bsi::thread_pool pool(2);
+    std::vector<std::string> names = {
+        "delta", "alpha", "echo", "bravo", "alpha", "charlie", "delta"};
+    std::vector<int> ids = {0, 1, 2, 3, 4, 5, 6};
+
+    auto const zip = bsi::make_zip_view(names, ids);
+    bsi::parallel_sort_by_key(pool, zip.begin(), zip.end(), first_of{}, 2);
+
+    std::vector<std::string> const expected_names = {
+        "alpha", "alpha", "bravo", "charlie", "delta", "delta", "echo"};
+    std::vector<int> const expected_ids = {1, 4, 3, 5, 0, 6, 2};
+    EXPECT_EQ(names, expected_names);
+    EXPECT_EQ(ids, expected_ids);
+}
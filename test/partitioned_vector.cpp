@@ -0,0 +1,153 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/partitioned_vector.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+namespace bsi = boost::stl_interfaces;
+
+TEST(partitioned_vector, construction)
+{
+    std::vector<std::thread::id> ids(4);
+    bsi::partition_threads threads(
+        4, [&](unsigned int i) { ids[i] = std::this_thread::get_id(); });
+    EXPECT_EQ(threads.size(), 4u);
+
+    for (std::size_t n : {0u, 1u, 3u, 4u, 5u, 8u, 1001u}) {
+        bsi::partitioned_vector<int> v(threads, n, 7);
+        EXPECT_EQ(v.size(), n);
+        EXPECT_EQ(v.empty(), n == 0);
+        EXPECT_EQ(v.partitions(), 4u);
+        EXPECT_EQ(std::size_t(v.end() - v.begin()), n);
+        EXPECT_EQ(std::count(v.begin(), v.end(), 7), std::ptrdiff_t(n));
+
+        std::size_t total = 0;
+        for (std::size_t p = 0; p < v.partitions(); ++p) {
+            total += std::size_t(v.partition(p).last - v.partition(p).first);
+        }
+        EXPECT_EQ(total, n);
+    }
+
+    // on_start ran on each thread before anything else.
+    for (auto id : ids) {
+        EXPECT_NE(id, std::thread::id());
+        EXPECT_NE(id, std::this_thread::get_id());
+    }
+}
+
+TEST(partitioned_vector, random_access)
+{
+    bsi::partition_threads threads(3);
+    bsi::partitioned_vector<int> v(threads, 100);
+    std::iota(v.begin(), v.end(), 0);
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(v[i], i);
+    }
+    EXPECT_EQ(v.front(), 0);
+    EXPECT_EQ(v.back(), 99);
+    EXPECT_EQ(*(v.end() - 34), 66);
+    EXPECT_TRUE(std::is_sorted(v.begin(), v.end()));
+    EXPECT_EQ(*std::lower_bound(v.begin(), v.end(), 50), 50);
+    EXPECT_EQ(*v.rbegin(), 99);
+
+    auto const & cv = v;
+    bsi::partitioned_vector<int>::const_iterator it = v.begin();
+    EXPECT_EQ(it, cv.begin());
+    EXPECT_EQ(cv.end() - it, 100);
+}
+
+TEST(partitioned_vector, segmented_algorithms)
+{
+    bsi::partition_threads threads(4);
+    for (std::size_t n : {0u, 7u, 8u, 1000u}) {
+        bsi::partitioned_vector<long> v(threads, n);
+        EXPECT_TRUE(bsi::is_segmented_iterator<decltype(v.begin())>::value);
+        std::iota(v.begin(), v.end(), 1L);
+        EXPECT_EQ(
+            bsi::segmented_accumulate(v.begin(), v.end(), 0L),
+            long(n) * long(n + 1) / 2);
+        bsi::segmented_fill(v.begin(), v.end(), 2L);
+        EXPECT_EQ(std::accumulate(v.begin(), v.end(), 0L), 2L * long(n));
+        if (n) {
+            EXPECT_EQ(
+                bsi::segmented_accumulate(v.begin() + 1, v.end(), 0L),
+                2L * long(n - 1));
+            v[n / 2] = 5;
+            EXPECT_EQ(
+                bsi::segmented_find(v.begin(), v.end(), 5L) - v.begin(),
+                std::ptrdiff_t(n / 2));
+        }
+    }
+}
+
+TEST(partitioned_vector, parallel_for_each)
+{
+    bsi::partition_threads threads(4);
+    bsi::partitioned_vector<int> v(threads, 10000, 1);
+    std::atomic<long> sum(0);
+    bsi::parallel_for_each(threads, v, [&](int & x) {
+        x *= 3;
+        sum += x;
+    });
+    EXPECT_EQ(sum.load(), 30000);
+    EXPECT_EQ(std::count(v.begin(), v.end(), 3), 10000);
+
+    EXPECT_THROW(
+        bsi::parallel_for_each(
+            threads,
+            v,
+            [](int & x) {
+                if (x == 3)
+                    throw std::runtime_error("x");
+            }),
+        std::runtime_error);
+}
+
+TEST(partitioned_vector, move)
+{
+    bsi::partition_threads threads(2);
+    bsi::partitioned_vector<std::string> v(threads, 10, "abc");
+    auto w = std::move(v);
+    EXPECT_TRUE(v.empty());
+    EXPECT_EQ(w.size(), 10u);
+    EXPECT_EQ(w[9], "abc");
+    v = std::move(w);
+    EXPECT_EQ(v.size(), 10u);
+    EXPECT_EQ(v[0], "abc");
+    swap(v, w);
+    EXPECT_EQ(w.size(), 10u);
+    EXPECT_TRUE(v.empty());
+}
+
+struct throws_on_copy
+{
+    throws_on_copy() = default;
+    throws_on_copy(throws_on_copy const &)
+    {
+        if (++copies == 50)
+            throw std::runtime_error("copy");
+    }
+    static std::atomic<int> copies;
+};
+std::atomic<int> throws_on_copy::copies(0);
+
+TEST(partitioned_vector, construction_throws)
+{
+    // The partitions that were made are freed; the sanitizers check.
+    bsi::partition_threads threads(4);
+    EXPECT_THROW(
+        bsi::partitioned_vector<throws_on_copy>(threads, 1000),
+        std::runtime_error);
+}
@@ -0,0 +1,209 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/persistent_vector.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+namespace bsi = boost::stl_interfaces;
+
+using vec_type = bsi::persistent_vector<int>;
+
+template<typename T>
+void check(
+    bsi::persistent_vector<T> const & v, std::vector<T> const & expected)
+{
+    ASSERT_EQ(v.size(), expected.size());
+    EXPECT_TRUE(std::equal(v.begin(), v.end(), expected.begin()));
+    EXPECT_TRUE(std::equal(v.rbegin(), v.rend(), expected.rbegin()));
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+        ASSERT_EQ(v[i], expected[i]);
+    }
+}
+
+TEST(persistent_vector, push_back_keeps_old_versions)
+{
+    // Sizes past 32 * 32 + 32, where the tree grows a third level.
+    std::vector<vec_type> versions(1);
+    std::vector<int> expected;
+    for (int i = 0; i < 33 * 32 * 32 + 5; ++i) {
+        versions.push_back(versions.back().push_back(i));
+    }
+    for (std::size_t n = 0; n < versions.size(); n += 97) {
+        expected.resize(n);
+        std::iota(expected.begin(), expected.end(), 0);
+        check(versions[n], expected);
+    }
+    expected.resize(versions.size() - 1);
+    std::iota(expected.begin(), expected.end(), 0);
+    check(versions.back(), expected);
+}
+
+TEST(persistent_vector, rvalue_push_back)
+{
+    vec_type v;
+    for (int i = 0; i < 3000; ++i) {
+        v = std::move(v).push_back(i);
+        if (i == 1000) {
+            // A copy shares the tail, so the next push_back copies it.
+            vec_type const snapshot = v;
+            v = std::move(v).push_back(-1);
+            EXPECT_EQ(snapshot.size(), 1001u);
+            EXPECT_EQ(snapshot.back(), 1000);
+            EXPECT_EQ(v.back(), -1);
+            v = v.pop_back();
+        }
+    }
+    std::vector<int> expected(3000);
+    std::iota(expected.begin(), expected.end(), 0);
+    check(v, expected);
+
+    vec_type const il = {1, 2, 3};
+    check(il, std::vector<int>{1, 2, 3});
+    vec_type const from_range(expected.begin(), expected.end());
+    check(from_range, expected);
+    EXPECT_TRUE(from_range == v);
+}
+
+TEST(persistent_vector, set)
+{
+    int const n = 32 * 32 * 2 + 17;
+    std::vector<int> expected(n);
+    std::iota(expected.begin(), expected.end(), 0);
+    vec_type const v(expected.begin(), expected.end());
+
+    vec_type w = v;
+    for (int i = 0; i < n; i += 13) {
+        w = w.set(i, -i);
+        expected[i] = -i;
+    }
+    w = w.set(n - 1, 42);
+    expected[n - 1] = 42;
+    check(w, expected);
+
+    std::iota(expected.begin(), expected.end(), 0);
+    check(v, expected);
+}
+
+TEST(persistent_vector, pop_back)
+{
+    int const n = 32 * 32 * 32 + 40;
+    vec_type v;
+    for (int i = 0; i < n; ++i) {
+        v = std::move(v).push_back(i);
+    }
+    vec_type const full = v;
+    std::vector<int> expected(n);
+    std::iota(expected.begin(), expected.end(), 0);
+    while (!v.empty()) {
+        v = v.pop_back();
+        expected.pop_back();
+        if (expected.size() % 1021 == 0 || expected.size() < 70 ||
+            (expected.size() & (expected.size() - 1)) == 0) {
+            check(v, expected);
+        }
+    }
+    EXPECT_EQ(v.size(), 0u);
+
+    // The shrunk versions are still appendable.
+    vec_type w = full;
+    for (int i = 0; i < 32 * 32 + 1; ++i) {
+        w = w.pop_back();
+    }
+    w = w.push_back(-1);
+    EXPECT_EQ(w.size(), std::size_t(n - 32 * 32));
+    EXPECT_EQ(w.back(), -1);
+    EXPECT_EQ(w[w.size() - 2], n - 32 * 32 - 2);
+    EXPECT_EQ(full.size(), std::size_t(n));
+    EXPECT_EQ(full.back(), n - 1);
+}
+
+TEST(persistent_vector, iterators)
+{
+    std::vector<int> expected(5000);
+    std::iota(expected.begin(), expected.end(), 0);
+    vec_type const v(expected.begin(), expected.end());
+
+    EXPECT_EQ(v.end() - v.begin(), 5000);
+    EXPECT_EQ(*std::lower_bound(v.begin(), v.end(), 3333), 3333);
+    EXPECT_EQ(v.begin()[4321], 4321);
+    auto it = v.end();
+    --it;
+    EXPECT_EQ(*it, 4999);
+    it -= 4000;
+    EXPECT_EQ(*it, 999);
+    it += 31;
+    EXPECT_EQ(*it, 1030);
+    EXPECT_EQ(*(v.begin() + 4999), 4999);
+    EXPECT_EQ(std::accumulate(v.begin(), v.end(), 0), 4999 * 5000 / 2);
+
+    vec_type::const_iterator first = v.begin();
+    EXPECT_TRUE(first == v.begin());
+    EXPECT_TRUE(first < v.end());
+    EXPECT_EQ(v.front(), 0);
+    EXPECT_EQ(v.back(), 4999);
+}
+
+TEST(persistent_vector, elements_released)
+{
+    // Each element holds a shared_ptr; all of them are released with the
+    // last version that shares them.
+    auto const p = std::make_shared<int>(0);
+    {
+        bsi::persistent_vector<std::shared_ptr<int>> v;
+        std::vector<bsi::persistent_vector<std::shared_ptr<int>>> versions;
+        for (int i = 0; i < 2000; ++i) {
+            v = v.push_back(p);
+            if (i % 100 == 0)
+                versions.push_back(v);
+        }
+        versions.push_back(v.set(1500, nullptr));
+        versions.push_back(v.pop_back().pop_back());
+        EXPECT_LT(2000, p.use_count());
+    }
+    EXPECT_EQ(p.use_count(), 1);
+
+    bsi::persistent_vector<std::string> s;
+    for (int i = 0; i < 100; ++i) {
+        s = s.push_back(std::to_string(i));
+    }
+    EXPECT_EQ(s[57], "57");
+    EXPECT_EQ(s.set(57, "x")[57], "x");
+    EXPECT_EQ(s[57], "57");
+}
+
+TEST(persistent_vector, shared_between_threads)
+{
+    std::vector<int> expected(10000);
+    std::iota(expected.begin(), expected.end(), 0);
+    vec_type const base(expected.begin(), expected.end());
+
+    std::vector<std::thread> threads;
+    std::vector<long long> sums(4);
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&, t] {
+            vec_type v = base;
+            for (int i = 0; i < 1000; ++i) {
+                v = v.set((i * 7 + t) % 10000, 0).push_back(t);
+            }
+            sums[t] = std::accumulate(v.begin(), v.end(), 0ll);
+        });
+    }
+    for (auto & t : threads) {
+        t.join();
+    }
+    check(base, expected);
+    for (auto sum : sums) {
+        EXPECT_LT(0, sum);
+    }
+}
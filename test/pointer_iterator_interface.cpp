@@ -0,0 +1,159 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/pointer_iterator_interface.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <list>
+#include <numeric>
+#include <vector>
+
+
+namespace bsi = boost::stl_interfaces;
+
+template<typename T>
+struct ptr_iter : bsi::pointer_iterator_interface<ptr_iter<T>, T>
+{
+    using bsi::pointer_iterator_interface<ptr_iter<T>, T>::
+        pointer_iterator_interface;
+
+    template<
+        typename T2,
+        typename Enable = std::enable_if_t<
+            std::is_convertible<T2 *, T *>::value &&
+            !std::is_same<T2, T>::value>>
+    constexpr ptr_iter(ptr_iter<T2> other) noexcept : ptr_iter(other.base())
+    {}
+};
+
+using iter = ptr_iter<int>;
+using const_iter = ptr_iter<int const>;
+
+struct bidi_ptr_iter : bsi::pointer_iterator_interface<
+                           bidi_ptr_iter,
+                           int,
+                           std::bidirectional_iterator_tag>
+{
+    using pointer_iterator_interface::pointer_iterator_interface;
+};
+
+static_assert(sizeof(iter) == sizeof(int *), "");
+static_assert(std::is_trivially_copyable<iter>::value, "");
+static_assert(std::is_convertible<iter, const_iter>::value, "");
+static_assert(!std::is_convertible<const_iter, iter>::value, "");
+static_assert(!std::is_convertible<int *, iter>::value, "");
+
+BOOST_STL_INTERFACES_STATIC_ASSERT_CONCEPT(iter, std::contiguous_iterator)
+BOOST_STL_INTERFACES_STATIC_ASSERT_ITERATOR_TRAITS(
+    iter,
+    std::random_access_iterator_tag,
+    bsi::contiguous_iterator_tag,
+    int,
+    int &,
+    int *,
+    std::ptrdiff_t)
+BOOST_STL_INTERFACES_STATIC_ASSERT_ITERATOR_TRAITS(
+    const_iter,
+    std::random_access_iterator_tag,
+    bsi::contiguous_iterator_tag,
+    int,
+    int const &,
+    int const *,
+    std::ptrdiff_t)
+BOOST_STL_INTERFACES_STATIC_ASSERT_CONCEPT(
+    bidi_ptr_iter, std::bidirectional_iterator)
+BOOST_STL_INTERFACES_STATIC_ASSERT_ITERATOR_TRAITS(
+    bidi_ptr_iter,
+    std::bidirectional_iterator_tag,
+    std::bidirectional_iterator_tag,
+    int,
+    int &,
+    int *,
+    std::ptrdiff_t)
+
+
+TEST(pointer_iterator_interface, operations)
+{
+    std::array<int, 5> ints = {{0, 1, 2, 3, 4}};
+    iter const first(ints.data());
+    iter const last(ints.data() + ints.size());
+
+    EXPECT_EQ(last - first, 5);
+    EXPECT_EQ(*first, 0);
+    EXPECT_EQ(first[3], 3);
+    EXPECT_EQ(first.operator->(), ints.data());
+    EXPECT_EQ(first.base(), ints.data());
+    EXPECT_EQ(iter().base(), nullptr);
+
+    iter it = first;
+    EXPECT_EQ(*++it, 1);
+    EXPECT_EQ(*it++, 1);
+    EXPECT_EQ(*it, 2);
+    EXPECT_EQ(*--it, 1);
+    EXPECT_EQ(*it--, 1);
+    EXPECT_EQ(it, first);
+    it += 4;
+    EXPECT_EQ(*it, 4);
+    it -= 2;
+    EXPECT_EQ(*it, 2);
+    EXPECT_EQ(first + 2, it);
+    EXPECT_EQ(2 + first, it);
+    EXPECT_EQ(last - 3, it);
+
+    EXPECT_TRUE(first < it);
+    EXPECT_TRUE(first <= it);
+    EXPECT_TRUE(it > first);
+    EXPECT_TRUE(it >= first);
+    EXPECT_TRUE(it != first);
+    EXPECT_FALSE(it < first);
+    EXPECT_FALSE(first == it);
+
+    // Mixed iterator and const_iterator comparisons go through the
+    // conversion.
+    const_iter cit = it;
+    EXPECT_EQ(cit, it);
+    EXPECT_EQ(it, cit);
+    EXPECT_TRUE(first < cit);
+    EXPECT_EQ(cit - first, 2);
+}
+
+TEST(pointer_iterator_interface, algorithms)
+{
+    std::vector<int> ints = {4, 2, 0, 3, 1};
+    iter const first(ints.data());
+    iter const last(ints.data() + ints.size());
+
+    std::sort(first, last);
+    EXPECT_EQ(ints, (std::vector<int>{0, 1, 2, 3, 4}));
+    EXPECT_EQ(std::accumulate(first, last, 0), 10);
+    EXPECT_EQ(*std::lower_bound(first, last, 3), 3);
+
+    std::vector<int> reversed(ints.size());
+    std::reverse_copy(
+        const_iter(first), const_iter(last), iter(reversed.data()));
+    EXPECT_EQ(reversed, (std::vector<int>{4, 3, 2, 1, 0}));
+
+    std::list<int> list(
+        bidi_ptr_iter(ints.data()), bidi_ptr_iter(ints.data() + ints.size()));
+    EXPECT_TRUE(std::equal(list.begin(), list.end(), first, last));
+}
+
+TEST(pointer_iterator_interface, constexpr_)
+{
+    static constexpr int ints[] = {1, 2, 3};
+    constexpr const_iter first(ints);
+    constexpr const_iter last(ints + 3);
+    static_assert(*first == 1, "");
+    static_assert(first[2] == 3, "");
+#if !defined(BOOST_STL_INTERFACES_NO_HIDDEN_FRIEND_CONSTEXPR)
+    static_assert(last - first == 3, "");
+    static_assert(*(first + 1) == 2, "");
+    static_assert(first != last, "");
+#endif
+    EXPECT_EQ(last - first, 3);
+}
@@ -0,0 +1,245 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/stl_interfaces/pool_forward_list.hpp>
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <numeric>
+#include <string>
+#include <vector>
+
+
+using boost::stl_interfaces::pool_forward_list;
+
+
+// Instantiate all the members we can.
+template struct pool_forward_list<int, 4>;
+
+using list_type = pool_forward_list<int, 4>;
+
+static_assert(
+    std::is_same<
+        std::iterator_traits<list_type::iterator>::iterator_category,
+        std::forward_iterator_tag>::value,
+    "");
+static_assert(
+    std::is_convertible<list_type::iterator, list_type::const_iterator>::
+        value,
+    "");
+static_assert(
+    !std::is_convertible<list_type::const_iterator, list_type::iterator>::
+        value,
+    "");
+
+template<typename List>
+std::vector<typename List::value_type> to_vector(List const & l)
+{
+    return std::vector<typename List::value_type>(l.begin(), l.end());
+}
+
+
+TEST(pool_list, default_ctor)
+{
+    list_type l;
+    EXPECT_TRUE(l.empty());
+    EXPECT_EQ(l.size(), 0u);
+    EXPECT_EQ(l.begin(), l.end());
+    EXPECT_EQ(l.cbegin(), l.cend());
+    EXPECT_EQ(l.slab_count(), 0u);
+    EXPECT_EQ(l, l);
+}
+
+TEST(pool_list, other_ctors_assign)
+{
+    {
+        list_type l(3);
+        EXPECT_EQ(to_vector(l), std::vector<int>(3));
+    }
+    {
+        list_type l(5, 7);
+        EXPECT_EQ(to_vector(l), std::vector<int>(5, 7));
+        EXPECT_EQ(l.slab_count(), 2u);
+    }
+    {
+        std::vector<int> const v = {1, 2, 3};
+        list_type l(v.begin(), v.end());
+        EXPECT_EQ(to_vector(l), v);
+    }
+    {
+        list_type const l = {1, 2, 3};
+        list_type l2 = l;
+        EXPECT_EQ(l2, l);
+        list_type l3 = std::move(l2);
+        EXPECT_EQ(l3, l);
+        EXPECT_TRUE(l2.empty());
+
+        list_type l4(9, 9);
+        EXPECT_EQ(l4.slab_count(), 3u);
+        l4 = l;
+        EXPECT_EQ(l4, l);
+        EXPECT_EQ(l4.slab_count(), 3u);
+
+        l4 = list_type{4, 5};
+        EXPECT_EQ(to_vector(l4), std::vector<int>({4, 5}));
+    }
+}
+
+TEST(pool_list, front_back_insert_erase)
+{
+    list_type l;
+    l.push_front(2);
+    l.push_back(3);
+    l.emplace_front(1);
+    l.emplace_back(4);
+    EXPECT_EQ(to_vector(l), std::vector<int>({1, 2, 3, 4}));
+    EXPECT_EQ(l.front(), 1);
+    EXPECT_EQ(l.size(), 4u);
+
+    auto it = l.insert_after(l.begin(), 10);
+    EXPECT_EQ(*it, 10);
+    std::vector<int> const v = {20, 30};
+    it = l.insert_after(it, v.begin(), v.end());
+    EXPECT_EQ(*it, 30);
+    EXPECT_EQ(to_vector(l), std::vector<int>({1, 10, 20, 30, 2, 3, 4}));
+
+    it = l.erase_after(l.begin());
+    EXPECT_EQ(*it, 20);
+    it = l.erase_after(l.begin(), std::next(l.begin(), 3));
+    EXPECT_EQ(*it, 2);
+    EXPECT_EQ(to_vector(l), std::vector<int>({1, 2, 3, 4}));
+
+    // Erasing the tail keeps push_back() working.
+    l.erase_after(std::next(l.begin(), 2));
+    l.push_back(5);
+    EXPECT_EQ(to_vector(l), std::vector<int>({1, 2, 3, 5}));
+
+    l.pop_front();
+    l.pop_front();
+    l.pop_front();
+    l.pop_front();
+    EXPECT_TRUE(l.empty());
+    l.push_back(6);
+    EXPECT_EQ(to_vector(l), std::vector<int>({6}));
+}
+
+TEST(pool_list, node_reuse)
+{
+    list_type l;
+    for (int i = 0; i < 8; ++i) {
+        l.push_front(i);
+    }
+    EXPECT_EQ(l.slab_count(), 2u);
+
+    // Erased nodes are reused before new slabs are allocated.
+    l.pop_front();
+    l.pop_front();
+    l.push_front(42);
+    l.push_front(43);
+    EXPECT_EQ(l.slab_count(), 2u);
+
+    // clear() keeps the slabs for the next insertions.
+    for (int round = 0; round < 3; ++round) {
+        l.clear();
+        EXPECT_TRUE(l.empty());
+        for (int i = 0; i < 8; ++i) {
+            l.push_back(i);
+        }
+        EXPECT_EQ(l.slab_count(), 2u);
+        EXPECT_EQ(std::accumulate(l.begin(), l.end(), 0), 28);
+    }
+}
+
+TEST(pool_list, splice_after)
+{
+    {
+        list_type l = {1, 5};
+        list_type other = {2, 3, 4, 6, 7};
+        other.erase_after(std::next(other.begin(), 2), other.end());
+        EXPECT_EQ(l.slab_count(), 1u);
+        EXPECT_EQ(other.slab_count(), 2u);
+
+        l.splice_after(l.begin(), other);
+        EXPECT_TRUE(other.empty());
+        EXPECT_EQ(other.slab_count(), 0u);
+        EXPECT_EQ(l.slab_count(), 3u);
+        EXPECT_EQ(to_vector(l), std::vector<int>({1, 2, 3, 4, 5}));
+
+        // other's free nodes come along with its slabs.
+        l.push_back(6);
+        l.push_back(7);
+        EXPECT_EQ(l.slab_count(), 3u);
+        EXPECT_EQ(to_vector(l), std::vector<int>({1, 2, 3, 4, 5, 6, 7}));
+
+        other.push_back(8);
+        EXPECT_EQ(to_vector(other), std::vector<int>({8}));
+    }
+    {
+        // Splicing onto the end, and into an empty list.
+        list_type l;
+        l.splice_after(l.before_begin(), list_type{1, 2});
+        l.splice_after(std::next(l.begin()), list_type{3});
+        l.push_back(4);
+        EXPECT_EQ(to_vector(l), std::vector<int>({1, 2, 3, 4}));
+        list_type empty;
+        l.splice_after(l.before_begin(), empty);
+        EXPECT_EQ(l.size(), 4u);
+
+        // Nodes allocated after a splice into an empty list do not reuse
+        // the spliced-in slabs.
+        for (int i = 5; i < 10; ++i) {
+            l.push_back(i);
+        }
+        EXPECT_EQ(
+            to_vector(l), std::vector<int>({1, 2, 3, 4, 5, 6, 7, 8, 9}));
+
+        l.clear();
+        for (int i = 0; i < 12; ++i) {
+            l.push_back(i);
+        }
+        EXPECT_EQ(std::accumulate(l.begin(), l.end(), 0), 66);
+    }
+}
+
+TEST(pool_list, nontrivial_values)
+{
+    pool_forward_list<std::string, 2> l;
+    l.emplace_back(3, 'a');
+    l.push_back("bb");
+    l.push_front("c");
+    EXPECT_EQ(
+        to_vector(l), std::vector<std::string>({"c", "aaa", "bb"}));
+
+    pool_forward_list<std::string, 2> other = {"x", "y", "z"};
+    l.splice_after(l.before_begin(), std::move(other));
+    EXPECT_EQ(l.size(), 6u);
+    EXPECT_EQ(l.front(), "x");
+
+    auto l2 = l;
+    EXPECT_EQ(l2, l);
+    swap(l, other);
+    EXPECT_TRUE(l.empty());
+    EXPECT_EQ(other, l2);
+    l2.clear();
+    EXPECT_LT(l2, other);
+
+    pool_forward_list<std::shared_ptr<int>> ptrs;
+    auto const p = std::make_shared<int>(1);
+    ptrs.push_back(p);
+    ptrs.push_back(p);
+    EXPECT_EQ(p.use_count(), 3);
+    ptrs.pop_front();
+    EXPECT_EQ(p.use_count(), 2);
+    ptrs.clear();
+    EXPECT_EQ(p.use_count(), 1);
+    ptrs.push_back(p);
+    {
+        auto ptrs2 = std::move(ptrs);
+        EXPECT_EQ(p.use_count(), 2);
+    }
+    EXPECT_EQ(p.use_count(), 1);
+}
@@ -0,0 +1,126 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/prefetch_view.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <forward_list>
+#include <list>
+#include <numeric>
+#include <vector>
+
+
+namespace bsi = boost::stl_interfaces;
+
+using vec_iter = bsi::prefetching_iterator<std::vector<int>::iterator, 4>;
+using list_iter = bsi::prefetching_iterator<std::list<int>::iterator>;
+using flist_iter = bsi::prefetching_iterator<std::forward_list<int>::iterator>;
+
+static_assert(
+    std::is_same<
+        std::iterator_traits<vec_iter>::iterator_category,
+        std::random_access_iterator_tag>::value,
+    "");
+static_assert(
+    std::is_same<
+        std::iterator_traits<list_iter>::iterator_category,
+        std::bidirectional_iterator_tag>::value,
+    "");
+static_assert(
+    std::is_same<
+        std::iterator_traits<flist_iter>::iterator_category,
+        std::forward_iterator_tag>::value,
+    "");
+static_assert(std::is_same<vec_iter::reference, int &>::value, "");
+
+// Records the elements it is asked to prefetch.
+struct recording_peek
+{
+    void const * operator()(std::forward_list<int>::iterator it) const
+    {
+        seen->push_back(*it);
+        return &*it;
+    }
+    std::vector<int> * seen;
+};
+
+
+TEST(prefetch_view, forward)
+{
+    std::forward_list<int> l(20);
+    std::iota(l.begin(), l.end(), 0);
+
+    std::vector<int> seen;
+    auto const v = bsi::make_prefetch_view<3>(l, recording_peek{&seen});
+    std::vector<int> out;
+    for (int x : v) {
+        out.push_back(x);
+    }
+    EXPECT_TRUE(std::equal(out.begin(), out.end(), l.begin(), l.end()));
+
+    // Each element is prefetched once, before it is reached: the first
+    // four on construction, and then each one three ahead.
+    std::vector<int> expected(20);
+    std::iota(expected.begin(), expected.end(), 0);
+    EXPECT_EQ(seen, expected);
+    EXPECT_EQ(v.base_begin(), l.begin());
+}
+
+TEST(prefetch_view, bidirectional)
+{
+    std::list<int> l(10);
+    std::iota(l.begin(), l.end(), 0);
+    auto const v = bsi::make_prefetch_view<4>(l);
+
+    // Walk to the end and back; the lookahead stops at the end, and catches
+    // up again on the way back.
+    auto it = v.begin();
+    std::advance(it, 9);
+    EXPECT_EQ(*it, 9);
+    ++it;
+    EXPECT_EQ(it, v.end());
+    for (int i = 9; 0 <= i; --i) {
+        --it;
+        EXPECT_EQ(*it, i);
+    }
+    EXPECT_EQ(it, v.begin());
+    std::advance(it, 3);
+    EXPECT_EQ(*it, 3);
+    EXPECT_EQ(it.base(), std::next(l.begin(), 3));
+
+    std::list<int> reversed(
+        std::make_reverse_iterator(v.end()),
+        std::make_reverse_iterator(v.begin()));
+    EXPECT_EQ(reversed.front(), 9);
+    EXPECT_EQ(reversed.back(), 0);
+}
+
+TEST(prefetch_view, random_access)
+{
+    std::vector<int> vec(100);
+    std::iota(vec.begin(), vec.end(), 0);
+    bsi::prefetch_view<std::vector<int>::iterator, 4> const v(
+        vec.begin(), vec.end());
+    EXPECT_EQ(v.size(), 100u);
+    EXPECT_EQ(v[50], 50);
+    EXPECT_EQ(std::accumulate(v.begin(), v.end(), 0), 4950);
+
+    auto it = v.begin() + 98;
+    EXPECT_EQ(*it, 98);
+    it -= 90;
+    EXPECT_EQ(*it, 8);
+    EXPECT_EQ(v.end() - it, 92);
+    EXPECT_LT(it, v.end());
+
+    // Writes go through to the elements.
+    std::fill(v.begin(), v.begin() + 10, -1);
+    EXPECT_EQ(vec[9], -1);
+    EXPECT_EQ(vec[10], 10);
+
+    EXPECT_TRUE(std::is_sorted(v.begin() + 10, v.end()));
+    EXPECT_EQ(*std::lower_bound(v.begin() + 10, v.end(), 42), 42);
+}
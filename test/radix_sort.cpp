@@ -0,0 +1,182 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/packed_int_vector.hpp>
+#include <boost/stl_interfaces/radix_sort.hpp>
+
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <random>
+#include <vector>
+
+
+namespace bsi = boost::stl_interfaces;
+using bsi::packed_int_vector;
+
+namespace {
+    template<typename T>
+    std::vector<T> random_values(std::size_t n, T lo, T hi)
+    {
+        std::mt19937_64 gen(42);
+        std::uniform_int_distribution<T> dist(lo, hi);
+        std::vector<T> retval(n);
+        for (auto & x : retval) {
+            x = dist(gen);
+        }
+        return retval;
+    }
+
+    struct record
+    {
+        std::uint32_t id;
+        int order;
+    };
+
+    struct id_of
+    {
+        std::uint32_t operator()(record const & r) const { return r.id; }
+    };
+}
+
+
+TEST(radix_sort, integers)
+{
+    for (std::size_t n : {0, 1, 2, 100, 10000}) {
+        auto ints = random_values<int>(
+            n,
+            (std::numeric_limits<int>::min)(),
+            (std::numeric_limits<int>::max)());
+        auto expected = ints;
+        std::sort(expected.begin(), expected.end());
+        bsi::radix_sort(ints.begin(), ints.end());
+        EXPECT_EQ(ints, expected) << "n=" << n;
+    }
+
+    {
+        auto values = random_values<std::int64_t>(10000, -1000, 1000);
+        auto expected = values;
+        std::sort(expected.begin(), expected.end());
+        bsi::radix_sort(values.begin(), values.end());
+        EXPECT_EQ(values, expected);
+    }
+
+    {
+        auto values = random_values<std::uint64_t>(
+            10000, 0, (std::numeric_limits<std::uint64_t>::max)());
+        auto expected = values;
+        std::sort(expected.begin(), expected.end());
+        bsi::radix_sort(values.begin(), values.end());
+        EXPECT_EQ(values, expected);
+    }
+
+    {
+        auto const values = random_values<short>(10000, -300, 300);
+        std::deque<short> d(values.begin(), values.end());
+        auto expected = values;
+        std::sort(expected.begin(), expected.end());
+        bsi::radix_sort(d.begin(), d.end());
+        EXPECT_TRUE(std::equal(d.begin(), d.end(), expected.begin()));
+    }
+}
+
+TEST(radix_sort, projection)
+{
+    auto const ids = random_values<std::uint32_t>(20000, 0, 5000);
+    std::vector<record> records(ids.size());
+    for (std::size_t i = 0; i < ids.size(); ++i) {
+        records[i] = record{ids[i], int(i)};
+    }
+    auto expected = records;
+    std::stable_sort(
+        expected.begin(), expected.end(), [](record lhs, record rhs) {
+            return lhs.id < rhs.id;
+        });
+
+    auto sorted = records;
+    bsi::radix_sort(sorted.begin(), sorted.end(), id_of{});
+    for (std::size_t i = 0; i < sorted.size(); ++i) {
+        EXPECT_EQ(sorted[i].id, expected[i].id);
+        EXPECT_EQ(sorted[i].order, expected[i].order);
+    }
+
+    bsi::thread_pool pool(3);
+    sorted = records;
+    bsi::parallel_radix_sort(pool, sorted.begin(), sorted.end(), id_of{}, 64);
+    for (std::size_t i = 0; i < sorted.size(); ++i) {
+        EXPECT_EQ(sorted[i].id, expected[i].id);
+        EXPECT_EQ(sorted[i].order, expected[i].order);
+    }
+}
+
+TEST(radix_sort, parallel)
+{
+    bsi::thread_pool pool(3);
+    for (std::size_t n : {0, 1, 1000, 100000}) {
+        auto values = random_values<std::int64_t>(
+            n,
+            (std::numeric_limits<std::int64_t>::min)(),
+            (std::numeric_limits<std::int64_t>::max)());
+        auto expected = values;
+        std::sort(expected.begin(), expected.end());
+        bsi::parallel_radix_sort(pool, values.begin(), values.end());
+        EXPECT_EQ(values, expected) << "n=" << n;
+    }
+
+    auto values = random_values<unsigned int>(50000, 0, 1u << 20);
+    auto expected = values;
+    std::sort(expected.begin(), expected.end());
+    bsi::parallel_radix_sort(values.begin(), values.end());
+    EXPECT_EQ(values, expected);
+}
+
+TEST(radix_sort, proxy_iterators)
+{
+    auto const values = random_values<std::uint32_t>(5000, 0, 4095);
+    packed_int_vector<12> packed(values.begin(), values.end());
+    auto expected = values;
+    std::sort(expected.begin(), expected.end());
+
+    bsi::radix_sort(packed.begin(), packed.end());
+    EXPECT_TRUE(std::equal(packed.begin(), packed.end(), expected.begin()));
+
+    packed_int_vector<12> counted(values.begin(), values.end());
+    bsi::counting_sort(counted.begin(), counted.end(), 4096);
+    EXPECT_TRUE(std::equal(counted.begin(), counted.end(), expected.begin()));
+}
+
+TEST(counting_sort, counting_sort)
+{
+    {
+        auto const ints = random_values<unsigned int>(10000, 0, 255);
+        std::vector<unsigned char> values(ints.begin(), ints.end());
+        auto expected = values;
+        std::sort(expected.begin(), expected.end());
+        bsi::counting_sort(values.begin(), values.end(), 256);
+        EXPECT_EQ(values, expected);
+    }
+
+    {
+        auto const ids = random_values<std::uint32_t>(10000, 0, 99);
+        std::vector<record> records(ids.size());
+        for (std::size_t i = 0; i < ids.size(); ++i) {
+            records[i] = record{ids[i], int(i)};
+        }
+        auto expected = records;
+        std::stable_sort(
+            expected.begin(), expected.end(), [](record lhs, record rhs) {
+                return lhs.id < rhs.id;
+            });
+        bsi::counting_sort(records.begin(), records.end(), 100, id_of{});
+        for (std::size_t i = 0; i < records.size(); ++i) {
+            EXPECT_EQ(records[i].id, expected[i].id);
+            EXPECT_EQ(records[i].order, expected[i].order);
+        }
+    }
+}
@@ -823,6 +823,89 @@ TEST(random_access, zip)
     }
 }
 
+// A proxy reference that counts how many times it is copied or moved.
+struct counted_ref
+{
+    explicit counted_ref(int & value) : value_(value) {}
+    counted_ref(counted_ref const & other) : value_(other.value_)
+    {
+        ++copies_and_moves;
+    }
+    counted_ref(counted_ref && other) : value_(other.value_)
+    {
+        ++copies_and_moves;
+    }
+
+    int & value_;
+
+    static int copies_and_moves;
+};
+int counted_ref::copies_and_moves = 0;
+
+template<typename Pointer>
+struct counted_ref_iter : boost::stl_interfaces::iterator_interface<
+                              counted_ref_iter<Pointer>,
+                              std::random_access_iterator_tag,
+                              int,
+                              counted_ref,
+                              Pointer>
+{
+    counted_ref_iter() : it_(nullptr) {}
+    counted_ref_iter(int * it) : it_(it) {}
+
+    counted_ref operator*() const { return counted_ref(*it_); }
+    counted_ref_iter & operator+=(std::ptrdiff_t i)
+    {
+        it_ += i;
+        return *this;
+    }
+    friend std::ptrdiff_t
+    operator-(counted_ref_iter lhs, counted_ref_iter rhs) noexcept
+    {
+        return lhs.it_ - rhs.it_;
+    }
+
+private:
+    int * it_;
+};
+
+using moving_arrow_iter =
+    counted_ref_iter<boost::stl_interfaces::proxy_arrow_result<counted_ref>>;
+using in_place_arrow_iter = counted_ref_iter<
+    boost::stl_interfaces::in_place_proxy_arrow_result<counted_ref>>;
+
+static_assert(
+    std::is_same<
+        in_place_arrow_iter::pointer,
+        boost::stl_interfaces::in_place_proxy_arrow_result<counted_ref>>::
+        value,
+    "");
+
+TEST(random_access, in_place_proxy_arrow)
+{
+    std::array<int, 3> values = {{1, 2, 3}};
+
+    {
+        counted_ref::copies_and_moves = 0;
+        moving_arrow_iter it(values.data());
+        EXPECT_EQ(it->value_, 1);
+        EXPECT_EQ((it + 2)->value_, 3);
+        // Each arrow moves the counted_ref returned by *it into the
+        // proxy_arrow_result.
+        EXPECT_LE(2, counted_ref::copies_and_moves);
+    }
+
+    {
+        counted_ref::copies_and_moves = 0;
+        in_place_arrow_iter it(values.data());
+        EXPECT_EQ(it->value_, 1);
+        EXPECT_EQ((it + 2)->value_, 3);
+        it->value_ = 42;
+        EXPECT_EQ(values[0], 42);
+        EXPECT_EQ(counted_ref::copies_and_moves, 0);
+    }
+}
+
 
 ////////////////////
 // view_interface //
@@ -0,0 +1,376 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/range_adaptor_closure.hpp>
+
+#include <gtest/gtest.h>
+
+#include <list>
+#include <numeric>
+#include <string>
+#include <vector>
+
+
+namespace bsi = boost::stl_interfaces;
+
+// Function objects rather than lambdas, since lambdas cannot be default
+// constructed before C++20, and so neither can iterators that hold them,
+// which iterators of nested views must.
+struct even_fn
+{
+    bool operator()(int x) const { return x % 2 == 0; }
+};
+struct square_fn
+{
+    int operator()(int x) const { return x * x; }
+};
+struct over_ten_fn
+{
+    bool operator()(int x) const { return 10 < x; }
+};
+
+even_fn const even;
+square_fn const square;
+over_ten_fn const over_ten;
+
+struct plus_n
+{
+    int operator()(int x) const { return x + n; }
+    int n;
+};
+
+struct under_three
+{
+    bool operator()(int x) const { return x < 3; }
+};
+
+template<typename Range>
+std::vector<int> to_vector(Range && r)
+{
+    return std::vector<int>(r.begin(), r.end());
+}
+
+std::vector<int> iota_vector(int n)
+{
+    std::vector<int> retval(n);
+    std::iota(retval.begin(), retval.end(), 0);
+    return retval;
+}
+
+
+TEST(range_adaptor_closure, filter)
+{
+    std::vector<int> ints = iota_vector(10);
+    auto v = ints | bsi::filter(even);
+    EXPECT_EQ(to_vector(v), (std::vector<int>{0, 2, 4, 6, 8}));
+    static_assert(
+        std::is_same<decltype(v), bsi::filter_view<int *, even_fn>>::value,
+        "");
+}
+
+TEST(range_adaptor_closure, transform)
+{
+    std::list<int> ints = {1, 2, 3};
+    auto const v = ints | bsi::transform(square);
+    EXPECT_EQ(to_vector(v), (std::vector<int>{1, 4, 9}));
+}
+
+TEST(range_adaptor_closure, fused)
+{
+    std::vector<int> ints = iota_vector(10);
+
+    // filter | transform | filter is one filter_view of ints.
+    auto v = ints | bsi::filter(even) | bsi::transform(square) |
+             bsi::filter(over_ten);
+    EXPECT_EQ(to_vector(v), (std::vector<int>{16, 36, 64}));
+    static_assert(
+        std::is_same<decltype(v.base_begin()), int *>::value, "");
+    using evens_iterator = decltype((ints | bsi::filter(even)).begin());
+    static_assert(sizeof(decltype(v.begin())) == sizeof(evens_iterator), "");
+
+    // transform | filter, too.
+    auto v2 = ints | bsi::transform(square) | bsi::filter(over_ten);
+    EXPECT_EQ(to_vector(v2), (std::vector<int>{16, 25, 36, 49, 64, 81}));
+    static_assert(
+        std::is_same<
+            decltype(v2.base_begin()),
+            std::vector<int>::iterator>::value,
+        "");
+
+    // transform | transform is one transform_view.
+    std::list<int> l = {1, 2, 3};
+    auto const v3 = l | bsi::transform(square) | bsi::transform(plus_n{1});
+    EXPECT_EQ(to_vector(v3), (std::vector<int>{2, 5, 10}));
+    static_assert(
+        std::is_same<
+            decltype(v3.base_begin()),
+            std::list<int>::iterator>::value,
+        "");
+    EXPECT_EQ(v3.functor().q_.n, 1);
+
+    // A fused pipeline can be traversed backward.
+    auto it = v.end();
+    EXPECT_EQ(*--it, 64);
+    EXPECT_EQ(*--it, 36);
+}
+
+TEST(range_adaptor_closure, take)
+{
+    std::vector<int> ints = iota_vector(10);
+
+    auto v = ints | bsi::take(3);
+    EXPECT_EQ(to_vector(v), (std::vector<int>{0, 1, 2}));
+    EXPECT_EQ(v.size(), 3);
+    static_assert(
+        std::is_same<decltype(v.begin()), std::vector<int>::iterator>::value,
+        "");
+
+    EXPECT_EQ(to_vector(ints | bsi::take(20)), ints);
+    EXPECT_TRUE((ints | bsi::take(0)).empty());
+
+    // A take_view of a filter_view holds the filter_view.
+    auto v2 = ints | bsi::filter(even) | bsi::transform(square) | bsi::take(2);
+    EXPECT_EQ(to_vector(v2), (std::vector<int>{0, 4}));
+    EXPECT_EQ(v2.begin().count(), 2);
+    auto v3 = ints | bsi::filter(even) | bsi::take(20);
+    EXPECT_EQ(to_vector(v3), (std::vector<int>{0, 2, 4, 6, 8}));
+
+    std::list<int> l = {1, 2, 3};
+    EXPECT_EQ(to_vector(l | bsi::take(2)), (std::vector<int>{1, 2}));
+}
+
+TEST(range_adaptor_closure, drop)
+{
+    std::vector<int> ints = iota_vector(10);
+
+    auto v = ints | bsi::drop(7);
+    EXPECT_EQ(to_vector(v), (std::vector<int>{7, 8, 9}));
+    EXPECT_EQ(v.size(), 3);
+    static_assert(
+        std::is_same<decltype(v.begin()), std::vector<int>::iterator>::value,
+        "");
+
+    EXPECT_EQ(to_vector(ints | bsi::drop(0)), ints);
+    EXPECT_TRUE((ints | bsi::drop(20)).empty());
+
+    // Two drop()s in a row are one drop_view.
+    auto v2 = ints | bsi::drop(2) | bsi::drop(3);
+    EXPECT_EQ(v2.count(), 5);
+    EXPECT_EQ(to_vector(v2), (std::vector<int>{5, 6, 7, 8, 9}));
+    static_assert(
+        std::is_same<decltype(v2), decltype(ints | bsi::drop(5))>::value,
+        "");
+
+    // Without random access, begin() is found once and cached, so erasing
+    // the first element left does not move it.
+    std::list<int> l = {1, 2, 3, 4};
+    auto v3 = l | bsi::drop(2);
+    EXPECT_EQ(to_vector(v3), (std::vector<int>{3, 4}));
+    l.erase(std::next(l.begin()));
+    EXPECT_EQ(v3.front(), 3);
+    v3.reset_begin_cache();
+    EXPECT_EQ(v3.front(), 4);
+    EXPECT_EQ(to_vector(l | bsi::drop(5)), std::vector<int>{});
+
+    auto v4 = ints | bsi::filter(even) | bsi::drop(2) | bsi::take(2);
+    EXPECT_EQ(to_vector(v4), (std::vector<int>{4, 6}));
+}
+
+TEST(range_adaptor_closure, take_while)
+{
+    std::vector<int> ints = iota_vector(10);
+    auto const under_four = [](int x) { return x < 4; };
+
+    auto v = ints | bsi::take_while(under_four);
+    EXPECT_EQ(to_vector(v), (std::vector<int>{0, 1, 2, 3}));
+    EXPECT_EQ(v.front(), 0);
+    EXPECT_EQ(std::distance(v.begin(), v.end()), 4);
+    EXPECT_EQ(v.begin().base(), ints.begin());
+
+    EXPECT_EQ(to_vector(ints | bsi::take_while(even)), (std::vector<int>{0}));
+    EXPECT_TRUE((ints | bsi::take_while(over_ten)).empty());
+    auto everything = ints | bsi::take_while([](int) { return true; });
+    EXPECT_EQ(to_vector(everything), ints);
+
+    // The predicate is called once per element.
+    int calls = 0;
+    auto v2 = ints | bsi::take_while([&calls](int x) {
+                  ++calls;
+                  return x < 4;
+              });
+    for (auto it = v2.begin(); it != v2.end(); ++it) {
+    }
+    EXPECT_EQ(calls, 5);
+
+    std::list<int> l = {2, 4, 5, 6};
+    EXPECT_EQ(to_vector(l | bsi::take_while(even)), (std::vector<int>{2, 4}));
+}
+
+TEST(range_adaptor_closure, drop_while)
+{
+    std::vector<int> ints = iota_vector(10);
+    auto const under_four = [](int x) { return x < 4; };
+
+    auto v = ints | bsi::drop_while(under_four);
+    EXPECT_EQ(to_vector(v), (std::vector<int>{4, 5, 6, 7, 8, 9}));
+    EXPECT_EQ(v.size(), 6);
+    static_assert(
+        std::is_same<decltype(v.begin()), std::vector<int>::iterator>::value,
+        "");
+
+    EXPECT_EQ(to_vector(ints | bsi::drop_while(over_ten)), ints);
+    EXPECT_TRUE((ints | bsi::drop_while([](int) { return true; })).empty());
+
+    // begin() calls the predicate only the first time.
+    int calls = 0;
+    auto v2 = ints | bsi::drop_while([&calls](int x) {
+                  ++calls;
+                  return x < 4;
+              });
+    EXPECT_EQ(v2.front(), 4);
+    EXPECT_EQ(v2.size(), 6);
+    EXPECT_FALSE(v2.empty());
+    EXPECT_EQ(calls, 5);
+
+    std::list<int> l = {2, 4, 5, 6};
+    EXPECT_EQ(
+        to_vector(l | bsi::drop_while(even)), (std::vector<int>{5, 6}));
+    EXPECT_EQ(
+        to_vector(l | bsi::drop_while(even) | bsi::take_while(over_ten)),
+        std::vector<int>{});
+}
+
+TEST(range_adaptor_closure, contiguous_take_drop)
+{
+    int ints[] = {0, 1, 2, 3, 4, 5, 6, 7};
+
+    auto taken = ints | bsi::take(3);
+    EXPECT_EQ(taken.data(), ints);
+    EXPECT_EQ(taken.size(), 3);
+
+    auto dropped = ints | bsi::drop(5);
+    EXPECT_EQ(dropped.data(), ints + 5);
+    EXPECT_EQ(dropped.size(), 3);
+
+    auto dropped_while = ints | bsi::drop_while(under_three());
+    EXPECT_EQ(dropped_while.data(), ints + 3);
+    EXPECT_EQ(dropped_while.size(), 5);
+
+    auto middle = ints | bsi::drop(2) | bsi::take(3);
+    EXPECT_EQ(middle.data(), ints + 2);
+    EXPECT_EQ(to_vector(middle), (std::vector<int>{2, 3, 4}));
+}
+
+TEST(range_adaptor_closure, contiguous_take_drop_of_containers)
+{
+    std::vector<int> ints = iota_vector(8);
+
+    auto taken = ints | bsi::take(3);
+    EXPECT_EQ(taken.data(), ints.data());
+    EXPECT_EQ(taken.size(), 3);
+    EXPECT_EQ((ints | bsi::take(20)).size(), 8);
+
+    auto dropped = ints | bsi::drop(5);
+    EXPECT_EQ(dropped.data(), ints.data() + 5);
+    EXPECT_EQ(dropped.size(), 3);
+    EXPECT_EQ((ints | bsi::drop(20)).size(), 0);
+
+    auto middle = ints | bsi::drop(2) | bsi::take(3);
+    EXPECT_EQ(middle.data(), ints.data() + 2);
+    EXPECT_EQ(middle.size(), 3);
+    auto const & const_middle = middle;
+    EXPECT_EQ(const_middle.size(), 3);
+
+    std::vector<int> const & const_ints = ints;
+    EXPECT_EQ((const_ints | bsi::take(3)).data(), ints.data());
+
+    std::string const str = "contiguous";
+    auto const prefix = str | bsi::take(4);
+    EXPECT_EQ(prefix.size(), 4);
+
+    // Sized, but not random access.
+    std::list<int> l = {0, 1, 2, 3, 4};
+    auto const list_taken = l | bsi::take(3);
+    EXPECT_EQ(list_taken.size(), 3);
+    EXPECT_EQ((l | bsi::drop(2)).size(), 3);
+    EXPECT_EQ((l | bsi::drop(1) | bsi::take(10)).size(), 4);
+}
+
+TEST(range_adaptor_closure, composed_closures)
+{
+    std::vector<int> ints = iota_vector(10);
+    auto const evens_squared =
+        bsi::filter(even) | bsi::transform(square) | bsi::take(3);
+    EXPECT_EQ(to_vector(ints | evens_squared), (std::vector<int>{0, 4, 16}));
+    std::vector<int> more = iota_vector(3);
+    EXPECT_EQ(to_vector(more | evens_squared), (std::vector<int>{0, 4}));
+}
+
+TEST(range_adaptor_closure, take_fused)
+{
+    std::vector<int> ints = iota_vector(10);
+
+    auto const v = ints | bsi::transform(square) | bsi::take(4);
+    EXPECT_EQ(to_vector(v), (std::vector<int>{0, 1, 4, 9}));
+    static_assert(
+        std::is_same<
+            decltype(v.begin()),
+            decltype((ints | bsi::transform(square)).begin())>::value,
+        "");
+
+    auto v2 = ints | bsi::filter(even) | bsi::take(4) | bsi::take(2);
+    EXPECT_EQ(to_vector(v2), (std::vector<int>{0, 2}));
+    static_assert(
+        std::is_same<
+            decltype(v2),
+            decltype(ints | bsi::filter(even) | bsi::take(2))>::value,
+        "");
+}
+
+TEST(range_adaptor_closure, fuse)
+{
+    std::vector<int> ints = iota_vector(10);
+
+    auto evens = bsi::make_filter_view(ints, even);
+    auto squares = bsi::make_transform_view(evens, square);
+    auto big = bsi::make_filter_view(squares, over_ten);
+    auto const plus_one = bsi::make_transform_view(big, plus_n{1});
+    auto first_two = bsi::take_view<decltype(bsi::make_transform_view(
+        big, plus_n{1}))>(plus_one, 2);
+    EXPECT_EQ(to_vector(first_two), (std::vector<int>{17, 37}));
+
+    auto fused = bsi::fuse(first_two);
+    static_assert(
+        std::is_same<
+            decltype(fused),
+            decltype(
+                ints | bsi::filter(even) | bsi::transform(square) |
+                bsi::filter(over_ten) | bsi::transform(plus_n{1}) |
+                bsi::take(2))>::value,
+        "");
+    EXPECT_EQ(to_vector(fused), (std::vector<int>{17, 37}));
+    EXPECT_EQ(to_vector(bsi::fuse(plus_one)), (std::vector<int>{17, 37, 65}));
+
+    // A transform_view of a transform_view.
+    auto const squares2 = bsi::make_transform_view(ints, square);
+    auto const v = bsi::make_transform_view(squares2, plus_n{1});
+    auto const fused2 = bsi::fuse(v);
+    EXPECT_EQ(to_vector(fused2), to_vector(v));
+    static_assert(
+        std::is_same<
+            decltype(fused2.base_begin()),
+            std::vector<int>::iterator>::value,
+        "");
+
+    // Other views are kept as they are.
+    auto ref = bsi::fuse(ints | bsi::take(3));
+    EXPECT_EQ(to_vector(ref), (std::vector<int>{0, 1, 2}));
+
+    // A drop_view of a drop_view.
+    auto dropped = bsi::make_transform_view(ints, square) | bsi::drop(8);
+    auto fused3 = bsi::fuse(bsi::drop_view<decltype(dropped)>(dropped, 1));
+    EXPECT_EQ(fused3.count(), 9);
+    EXPECT_EQ(to_vector(fused3), (std::vector<int>{81}));
+}
@@ -0,0 +1,159 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/rcu_container.hpp>
+#include <boost/stl_interfaces/static_vector.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+namespace bsi = boost::stl_interfaces;
+
+TEST(rcu_container, read_and_update)
+{
+    using vec = bsi::static_vector<int, 8>;
+    bsi::rcu_container<vec> c(vec{1, 2, 3});
+    {
+        auto const v = c.read();
+        EXPECT_EQ(v.size(), 3u);
+        EXPECT_FALSE(v.empty());
+        EXPECT_EQ(v[1], 2);
+        EXPECT_EQ(v.front(), 1);
+        EXPECT_EQ(v.back(), 3);
+        EXPECT_TRUE(std::equal(v.begin(), v.end(), v.snapshot().begin()));
+    }
+
+    c.update([](vec & v) { v.push_back(4); });
+    {
+        auto const v = c.read();
+        EXPECT_EQ(v.size(), 4u);
+        EXPECT_EQ(v.back(), 4);
+    }
+
+    c.store(vec{7});
+    {
+        auto const v = c.read();
+        ASSERT_EQ(v.size(), 1u);
+        EXPECT_EQ(v[0], 7);
+    }
+}
+
+TEST(rcu_container, update_throws)
+{
+    bsi::rcu_container<std::vector<int>> c(std::vector<int>{1});
+    EXPECT_THROW(
+        c.update([](std::vector<int> & v) {
+            v.push_back(2);
+            throw 42;
+        }),
+        int);
+    auto const v = c.read();
+    EXPECT_EQ(v.size(), 1u);
+}
+
+TEST(rcu_container, move_view)
+{
+    bsi::rcu_container<std::vector<int>> c(std::vector<int>{1, 2});
+    auto v = c.read();
+    bsi::rcu_view<std::vector<int>> w(std::move(v));
+    EXPECT_EQ(w.size(), 2u);
+    v = std::move(w);
+    EXPECT_EQ(v.size(), 2u);
+    {
+        bsi::rcu_view<std::vector<int>> x;
+        x = std::move(v);
+    }
+    // All the views have been released, so this does not wait.
+    c.store(std::vector<int>{});
+    EXPECT_TRUE(c.read().empty());
+}
+
+TEST(rcu_container, view_pins_snapshot)
+{
+    bsi::rcu_container<std::vector<std::string>> c(
+        std::vector<std::string>(100, "old"));
+    auto view = std::make_unique<bsi::rcu_view<std::vector<std::string>>>(
+        c.read());
+
+    std::atomic<bool> updated(false);
+    std::thread writer([&] {
+        c.update([](std::vector<std::string> & v) {
+            std::fill(v.begin(), v.end(), "new");
+        });
+        updated = true;
+    });
+
+    // The update waits for the view; new readers see the new snapshot in
+    // the meantime.
+    for (;;) {
+        auto const v = c.read();
+        if (v[0] == "new")
+            break;
+        std::this_thread::yield();
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    EXPECT_FALSE(updated.load());
+    EXPECT_EQ(std::count(view->begin(), view->end(), "old"), 100);
+
+    view.reset();
+    writer.join();
+    EXPECT_TRUE(updated.load());
+}
+
+TEST(rcu_container, concurrent_reads_and_updates)
+{
+    // Each snapshot is a map in which every value is the version that
+    // published it; a reader that saw a torn or freed snapshot would see
+    // values that differ.
+    using table = std::map<int, int>;
+    table first;
+    for (int i = 0; i < 64; ++i) {
+        first[i] = 0;
+    }
+    bsi::rcu_container<table> c(first);
+
+    int const versions = 200;
+    std::atomic<bool> done(false);
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; ++t) {
+        readers.emplace_back([&] {
+            int last_version = 0;
+            while (!done.load()) {
+                auto const v = c.read();
+                ASSERT_EQ(v.snapshot().size(), 64u);
+                int const version = v.begin()->second;
+                ASSERT_LE(last_version, version);
+                for (auto const & kv : v) {
+                    ASSERT_EQ(kv.second, version);
+                }
+                last_version = version;
+            }
+        });
+    }
+
+    std::thread writer([&] {
+        for (int version = 1; version <= versions; ++version) {
+            c.update([version](table & t) {
+                for (auto & kv : t) {
+                    kv.second = version;
+                }
+            });
+        }
+    });
+    writer.join();
+    done = true;
+    for (auto & r : readers) {
+        r.join();
+    }
+    EXPECT_EQ(c.read().begin()->second, versions);
+}
@@ -0,0 +1,146 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/stl_interfaces/record_view.hpp>
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+
+using boost::stl_interfaces::indexed_record_iterator;
+using boost::stl_interfaces::record_iterator;
+using boost::stl_interfaces::record_view;
+
+
+template<typename Length>
+void append_record(std::vector<unsigned char> & buffer, std::string const & s)
+{
+    Length const length = Length(s.size());
+    auto const p = reinterpret_cast<unsigned char const *>(&length);
+    buffer.insert(buffer.end(), p, p + sizeof(length));
+    buffer.insert(buffer.end(), s.begin(), s.end());
+}
+
+template<typename Range>
+std::vector<std::string> strings(Range & r)
+{
+    std::vector<std::string> retval;
+    for (auto record : r) {
+        retval.push_back(record.str());
+    }
+    return retval;
+}
+
+static_assert(
+    std::is_same<
+        std::iterator_traits<record_iterator<std::uint32_t>>::
+            iterator_category,
+        std::forward_iterator_tag>::value,
+    "");
+static_assert(
+    std::is_same<
+        std::iterator_traits<indexed_record_iterator<std::uint32_t>>::
+            iterator_category,
+        std::random_access_iterator_tag>::value,
+    "");
+
+
+TEST(records, empty)
+{
+    record_view<> v;
+    EXPECT_TRUE(v.empty());
+    EXPECT_EQ(v.begin(), v.end());
+    EXPECT_TRUE(v.remainder().empty());
+    auto indexed = v.indexed();
+    EXPECT_TRUE(indexed.empty());
+    EXPECT_EQ(indexed.size(), 0);
+}
+
+TEST(records, parse)
+{
+    std::vector<std::string> const expected = {
+        "a", "", "bc", std::string(300, 'x'), "", "def"};
+    std::vector<unsigned char> buffer;
+    for (auto const & s : expected) {
+        append_record<std::uint32_t>(buffer, s);
+    }
+
+    record_view<> v(buffer.data(), buffer.size());
+    EXPECT_EQ(strings(v), expected);
+    EXPECT_TRUE(v.remainder().empty());
+    EXPECT_EQ(v.remainder().begin(), buffer.data() + buffer.size());
+
+    auto it = v.begin();
+    EXPECT_EQ(it->size(), 1u);
+    EXPECT_EQ((*it).data(), buffer.data() + 4);
+    EXPECT_EQ(it.position(), buffer.data());
+    auto const old = it++;
+    EXPECT_EQ(old.position(), buffer.data());
+    EXPECT_EQ(it.position(), buffer.data() + 5);
+    EXPECT_TRUE(it->empty());
+    EXPECT_NE(it, v.end());
+    EXPECT_EQ(std::distance(v.begin(), v.end()), 6);
+
+    auto indexed = v.indexed();
+    EXPECT_EQ(indexed.size(), 6);
+    EXPECT_EQ(strings(indexed), expected);
+    for (int i = 0; i < 6; ++i) {
+        EXPECT_EQ(indexed[i].str(), expected[i]);
+    }
+    EXPECT_EQ(indexed.back().str(), "def");
+    EXPECT_EQ(indexed.end() - indexed.begin(), 6);
+    EXPECT_EQ(
+        indexed.index(),
+        (std::vector<std::size_t>{0, 5, 9, 15, 319, 323}));
+}
+
+TEST(records, partial)
+{
+    std::vector<unsigned char> full;
+    append_record<std::uint16_t>(full, "abc");
+    append_record<std::uint16_t>(full, "defgh");
+
+    // Every truncation of the buffer parses the whole records before the
+    // cut, and leaves the rest as the remainder.
+    for (std::size_t n = 0; n <= full.size(); ++n) {
+        record_view<std::uint16_t> v(full.data(), n);
+        std::vector<std::string> expected;
+        std::size_t parsed = 0;
+        if (5 <= n) {
+            expected.push_back("abc");
+            parsed = 5;
+        }
+        if (12 <= n) {
+            expected.push_back("defgh");
+            parsed = 12;
+        }
+        EXPECT_EQ(strings(v), expected) << "n=" << n;
+        EXPECT_EQ(v.remainder().size(), n - parsed) << "n=" << n;
+        EXPECT_EQ(v.remainder().data(), full.data() + parsed) << "n=" << n;
+        auto indexed = v.indexed();
+        EXPECT_EQ(strings(indexed), expected) << "n=" << n;
+    }
+}
+
+TEST(records, random)
+{
+    std::mt19937 gen(1);
+    std::vector<std::string> expected;
+    std::vector<unsigned char> buffer;
+    for (int i = 0; i < 1000; ++i) {
+        expected.push_back(std::string(gen() % 40, char('a' + i % 26)));
+        append_record<std::uint8_t>(buffer, expected.back());
+    }
+    record_view<std::uint8_t> v(buffer.data(), buffer.size());
+    EXPECT_EQ(strings(v), expected);
+    auto indexed = v.indexed();
+    for (int i = 0; i < 1000; i += 37) {
+        EXPECT_EQ(indexed[i].str(), expected[i]);
+    }
+}
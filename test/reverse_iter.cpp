@@ -3,6 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0. (See
 // accompanying file LICENSE_1_0.txt or copy at
 // http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/filter_view.hpp>
 #include <boost/stl_interfaces/iterator_interface.hpp>
 #include <boost/stl_interfaces/reverse_iterator.hpp>
 
@@ -235,3 +236,81 @@ TEST(reverse_iter, zip_iterator)
         EXPECT_EQ(count, tuples.size());
     }
 }
+
+namespace {
+    int even_calls = 0;
+    struct counting_even
+    {
+        bool operator()(int x) const
+        {
+            ++even_calls;
+            return x % 2 == 0;
+        }
+    };
+}
+
+TEST(reverse_iter, cached_reverse_iterator)
+{
+    std::list<int> ints = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    using filter_iter = boost::stl_interfaces::
+        filter_iterator<std::list<int>::iterator, counting_even>;
+    filter_iter const evens_first(ints.begin(), ints.end(), counting_even{});
+    filter_iter const evens_last(ints.end(), ints.end(), counting_even{});
+
+    // A pass backward over the evens tests each of the 10 elements once,
+    // and reverse_iterator makes two passes: one to dereference and one to
+    // increment.
+    std::vector<int> const expected = {8, 6, 4, 2, 0};
+    {
+        auto first = boost::stl_interfaces::make_reverse_iterator(evens_last);
+        auto last = boost::stl_interfaces::make_reverse_iterator(evens_first);
+        even_calls = 0;
+        std::vector<int> result;
+        for (auto it = first; it != last; ++it) {
+            result.push_back(*it);
+        }
+        EXPECT_EQ(result, expected);
+        EXPECT_EQ(even_calls, 2 * 10);
+    }
+    {
+        auto first =
+            boost::stl_interfaces::make_cached_reverse_iterator(evens_last);
+        auto last =
+            boost::stl_interfaces::make_cached_reverse_iterator(evens_first);
+        even_calls = 0;
+        std::vector<int> result;
+        for (auto it = first; it != last; ++it) {
+            result.push_back(*it);
+            EXPECT_EQ(*it, result.back());
+        }
+        EXPECT_EQ(result, expected);
+        EXPECT_EQ(even_calls, 10);
+    }
+
+    // Without the dereferences, and backward.
+    {
+        auto first = boost::stl_interfaces::make_cached_reverse_iterator(
+            ints.end());
+        auto last = boost::stl_interfaces::make_cached_reverse_iterator(
+            ints.begin());
+        EXPECT_EQ(std::distance(first, last), 10);
+
+        auto it = last;
+        --it;
+        EXPECT_EQ(*it, 0);
+        it--;
+        EXPECT_EQ(*it, 1);
+        ++it;
+        EXPECT_EQ(*it, 0);
+
+        boost::stl_interfaces::cached_reverse_iterator<
+            std::list<int>::const_iterator> const cfirst(first);
+        EXPECT_EQ(cfirst, first);
+        EXPECT_TRUE(std::equal(
+            cfirst,
+            boost::stl_interfaces::cached_reverse_iterator<
+                std::list<int>::const_iterator>(last),
+            ints.rbegin(),
+            ints.rend()));
+    }
+}
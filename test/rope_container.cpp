@@ -0,0 +1,220 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/stl_interfaces/rope.hpp>
+
+#include <gtest/gtest.h>
+
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+
+using boost::stl_interfaces::rope;
+
+
+// Instantiate all the members we can.
+template struct rope<int>;
+template struct rope<int, 1>;
+template struct rope<std::string, 4>;
+
+using rope_t = rope<int, 4>;
+
+static_assert(
+    std::is_same<
+        std::iterator_traits<rope_t::iterator>::iterator_category,
+        std::random_access_iterator_tag>::value,
+    "");
+static_assert(
+    std::is_convertible<rope_t::iterator, rope_t::const_iterator>::value,
+    "");
+static_assert(
+    !std::is_convertible<rope_t::const_iterator, rope_t::iterator>::value,
+    "");
+static_assert(
+    boost::stl_interfaces::is_segmented_iterator<rope_t::iterator>::value,
+    "");
+static_assert(
+    std::is_same<
+        boost::stl_interfaces::segmented_iterator_traits<
+            rope_t::const_iterator>::local_iterator,
+        int const *>::value,
+    "");
+
+template<typename Rope>
+std::vector<typename Rope::value_type> to_vector(Rope const & r)
+{
+    return std::vector<typename Rope::value_type>(r.begin(), r.end());
+}
+
+
+TEST(rope, default_ctor)
+{
+    rope_t r;
+    EXPECT_TRUE(r.empty());
+    EXPECT_EQ(r.size(), 0u);
+    EXPECT_EQ(r.begin(), r.end());
+    EXPECT_EQ(r.leaf_count(), 0u);
+    EXPECT_EQ(
+        boost::stl_interfaces::segmented_find(r.begin(), r.end(), 0),
+        r.end());
+    EXPECT_EQ(r, r);
+}
+
+TEST(rope, append_and_index)
+{
+    rope_t r;
+    for (int i = 0; i < 1000; ++i) {
+        r.push_back(i);
+    }
+    EXPECT_EQ(r.size(), 1000u);
+    EXPECT_EQ(r.leaf_count(), 250u);
+    EXPECT_LT(r.height(), 40u);
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_EQ(r[i], i);
+    }
+    EXPECT_EQ(r.front(), 0);
+    EXPECT_EQ(r.back(), 999);
+    EXPECT_EQ(*(r.rbegin() + 4), 995);
+
+    // Jumps in both directions, near and far.
+    auto it = r.begin();
+    for (int step : {1, 3, 4, 5, 100, -50, -1, -4, 700, 190, -940, 991, 1}) {
+        auto const i = (it - r.begin()) + step;
+        it += step;
+        EXPECT_EQ(it - r.begin(), i);
+        if (it != r.end()) {
+            EXPECT_EQ(*it, i);
+        }
+    }
+    EXPECT_EQ(it, r.end());
+    EXPECT_EQ(r.end() - 1000, r.begin());
+}
+
+TEST(rope, insert_erase)
+{
+    rope_t r = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    std::vector<int> const ten = {10, 11, 12, 13, 14, 15, 16, 17, 18, 19};
+
+    r.insert(r.begin() + 5, ten.begin(), ten.end());
+    EXPECT_EQ(
+        to_vector(r),
+        (std::vector<int>{
+            0, 1, 2, 3, 4, 10, 11, 12, 13, 14,
+            15, 16, 17, 18, 19, 5, 6, 7, 8, 9}));
+    r.insert(r.begin(), -1);
+    r.insert(r.begin() + 4, ten.begin(), ten.begin() + 2);
+    r.insert(r.end(), 100);
+    EXPECT_EQ(r.front(), -1);
+    EXPECT_EQ(r[4], 10);
+    EXPECT_EQ(r[5], 11);
+    EXPECT_EQ(r[6], 3);
+    EXPECT_EQ(r.back(), 100);
+
+    r.erase(r.begin() + 1, r.end() - 1);
+    EXPECT_EQ(to_vector(r), (std::vector<int>{-1, 100}));
+    r.erase(r.begin(), r.end());
+    EXPECT_TRUE(r.empty());
+    EXPECT_EQ(r.leaf_count(), 0u);
+    r.insert(r.begin(), ten.begin(), ten.end());
+    EXPECT_EQ(to_vector(r), ten);
+}
+
+TEST(rope, random_edits)
+{
+    // Random inserts and erases, checked against std::vector.
+    std::mt19937 gen(42);
+    rope<int, 8> r;
+    std::vector<int> v;
+    int next = 0;
+    for (int step = 0; step < 3000; ++step) {
+        auto const where = std::uniform_int_distribution<std::size_t>(
+            0, v.size())(gen);
+        if (std::uniform_int_distribution<int>(0, 2)(gen) || v.empty()) {
+            auto const n = std::uniform_int_distribution<int>(1, 20)(gen);
+            std::vector<int> values(n);
+            std::iota(values.begin(), values.end(), next);
+            next += n;
+            r.insert(r.begin() + where, values.begin(), values.end());
+            v.insert(v.begin() + where, values.begin(), values.end());
+        } else {
+            auto const n = std::uniform_int_distribution<std::size_t>(
+                0, (std::min)(v.size() - where, std::size_t(20)))(gen);
+            r.erase(r.begin() + where, r.begin() + where + n);
+            v.erase(v.begin() + where, v.begin() + where + n);
+        }
+        ASSERT_EQ(r.size(), v.size());
+    }
+    EXPECT_EQ(to_vector(r), v);
+    for (std::size_t i = 0; i < v.size(); i += 7) {
+        EXPECT_EQ(r[i], v[i]);
+    }
+    // Small leaves get merged, so they stay more than a quarter full on
+    // average.
+    EXPECT_LT(r.leaf_count(), v.size() / 2);
+    EXPECT_LT(r.height(), 60u);
+
+    std::vector<int> reversed(r.rbegin(), r.rend());
+    EXPECT_TRUE(std::equal(reversed.rbegin(), reversed.rend(), v.begin()));
+}
+
+TEST(rope, segmented_algorithms)
+{
+    rope<int, 3> r;
+    for (int i = 0; i < 13; ++i) {
+        r.push_back(i);
+    }
+    // Uneven leaves.
+    r.erase(r.begin() + 4);
+    r.insert(r.begin() + 4, 4);
+    for (int first = 0; first <= 13; ++first) {
+        for (int last = first; last <= 13; ++last) {
+            auto const f = r.cbegin() + first;
+            auto const l = r.cbegin() + last;
+            std::vector<int> expected(last - first);
+            std::iota(expected.begin(), expected.end(), first);
+
+            std::vector<int> copied;
+            boost::stl_interfaces::segmented_copy(
+                f, l, std::back_inserter(copied));
+            EXPECT_EQ(copied, expected);
+            EXPECT_EQ(
+                boost::stl_interfaces::segmented_accumulate(f, l, 0),
+                std::accumulate(expected.begin(), expected.end(), 0));
+            for (int x = first - 1; x <= last; ++x) {
+                auto const it =
+                    boost::stl_interfaces::segmented_find(f, l, x);
+                EXPECT_EQ(it - r.cbegin(), first <= x && x < last ? x : last);
+            }
+        }
+    }
+}
+
+TEST(rope, non_trivial_elements)
+{
+    rope<std::string, 4> r;
+    for (int i = 0; i < 20; ++i) {
+        r.push_back(std::string(30, char('a' + i)));
+    }
+    r.insert(r.begin() + 5, std::string(30, 'z'));
+    r.emplace(r.begin() + 5, r[0]);
+    r.erase(r.begin() + 1, r.begin() + 3);
+    EXPECT_EQ(r.size(), 20u);
+    EXPECT_EQ(r[3], std::string(30, 'a'));
+    EXPECT_EQ(r[4], std::string(30, 'z'));
+    EXPECT_EQ(r[5], std::string(30, 'f'));
+
+    rope<std::string, 4> copy = r;
+    EXPECT_EQ(copy, r);
+    rope<std::string, 4> moved = std::move(copy);
+    EXPECT_TRUE(copy.empty());
+    EXPECT_EQ(moved, r);
+    moved.clear();
+    EXPECT_TRUE(moved.empty());
+    moved.swap(r);
+    EXPECT_EQ(moved.size(), 20u);
+}
@@ -0,0 +1,165 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/parallel_sort.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include <cstdint>
+
+#if 201703L <= __cplusplus && defined(__has_include)
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+#endif
+#endif
+
+
+namespace bsi = boost::stl_interfaces;
+
+// A bump arena with the allocate() and deallocate() members of
+// std::pmr::memory_resource, which counts its allocations and the bytes
+// still live in it.
+struct bump_arena
+{
+    explicit bump_arena(std::size_t capacity) : buf_(capacity), used_(0) {}
+
+    void * allocate(std::size_t bytes, std::size_t alignment)
+    {
+        std::size_t const first =
+            (used_ + alignment - 1) / alignment * alignment;
+        if (buf_.size() < first + bytes)
+            throw std::bad_alloc();
+        used_ = first + bytes;
+        ++allocations;
+        live += bytes;
+        return buf_.data() + first;
+    }
+    void deallocate(void * p, std::size_t bytes, std::size_t)
+    {
+        EXPECT_TRUE(buf_.data() <= p && p < buf_.data() + buf_.size());
+        live -= bytes;
+    }
+
+    int allocations = 0;
+    std::size_t live = 0;
+
+private:
+    std::vector<unsigned char> buf_;
+    std::size_t used_;
+};
+
+std::vector<int> shuffled(int n)
+{
+    std::vector<int> retval(n);
+    for (int i = 0; i < n; ++i) {
+        retval[i] = (i * 7919) % n - n / 2;
+    }
+    std::shuffle(retval.begin(), retval.end(), std::mt19937(42));
+    return retval;
+}
+
+
+TEST(scratch, allocator)
+{
+    bsi::scratch_allocator<int> plain;
+    int * p = plain.allocate(4);
+    plain.deallocate(p, 4);
+
+    bump_arena arena(1024);
+    bump_arena inner_arena(1024);
+    {
+        bsi::scratch_scope scope(arena);
+        bsi::scratch_allocator<int> a;
+        EXPECT_TRUE(a != plain);
+        {
+            bsi::scratch_scope inner(inner_arena);
+            bsi::scratch_allocator<double> b;
+            b.deallocate(b.allocate(2), 2);
+            EXPECT_EQ(inner_arena.allocations, 1);
+        }
+        // The inner scope is gone; a rebound copy uses a's arena.
+        bsi::scratch_allocator<double> c;
+        EXPECT_TRUE(c == bsi::scratch_allocator<double>(a));
+        double * d = c.allocate(3);
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(d) % alignof(double), 0u);
+        c.deallocate(d, 3);
+        EXPECT_EQ(arena.allocations, 1);
+        EXPECT_EQ(arena.live, 0u);
+    }
+    EXPECT_TRUE(bsi::scratch_allocator<int>() == plain);
+}
+
+TEST(scratch, algorithms)
+{
+    bsi::thread_pool pool(2);
+    int const n = 50000;
+    auto const input = shuffled(n);
+    auto expected = input;
+    std::stable_sort(expected.begin(), expected.end());
+
+    bump_arena arena(64 << 20);
+    bsi::scratch_scope scope(arena);
+
+    auto v = input;
+    bsi::parallel_sort(pool, v.begin(), v.end(), std::less<>{}, 1000);
+    EXPECT_EQ(v, expected);
+    EXPECT_LT(0, arena.allocations);
+    EXPECT_EQ(arena.live, 0u);
+
+    int allocations = arena.allocations;
+    v = input;
+    bsi::parallel_sort_by_key(
+        pool, v.begin(), v.end(), [](int x) { return x; }, 1000);
+    EXPECT_EQ(v, expected);
+    EXPECT_LT(allocations, arena.allocations);
+    EXPECT_EQ(arena.live, 0u);
+
+    allocations = arena.allocations;
+    v = input;
+    bsi::radix_sort(v.begin(), v.end());
+    EXPECT_EQ(v, expected);
+    bsi::parallel_radix_sort(pool, v.begin(), v.end(), bsi::identity{}, 1000);
+    EXPECT_EQ(v, expected);
+    EXPECT_LT(allocations, arena.allocations);
+    EXPECT_EQ(arena.live, 0u);
+
+    allocations = arena.allocations;
+    std::vector<int> out(n);
+    bsi::parallel_inclusive_scan(
+        pool, input.begin(), input.end(), out.begin(), std::plus<>{}, 1000);
+    std::vector<int> scanned(n);
+    std::partial_sum(input.begin(), input.end(), scanned.begin());
+    EXPECT_EQ(out, scanned);
+    EXPECT_EQ(
+        bsi::parallel_reduce(
+            pool, input.begin(), input.end(), 0, std::plus<>{}, 1000),
+        std::accumulate(input.begin(), input.end(), 0));
+    auto const positive = [](int x) { return 0 < x; };
+    auto const out_last = bsi::parallel_copy_if(
+        pool, input.begin(), input.end(), out.begin(), positive, 1000);
+    EXPECT_EQ(
+        out_last - out.begin(),
+        std::count_if(input.begin(), input.end(), positive));
+    EXPECT_LT(allocations, arena.allocations);
+    EXPECT_EQ(arena.live, 0u);
+}
+
+#if defined(__cpp_lib_memory_resource)
+TEST(scratch, pmr)
+{
+    std::pmr::monotonic_buffer_resource request_arena;
+    bsi::scratch_scope scope(request_arena);
+    auto v = shuffled(10000);
+    auto expected = v;
+    std::sort(expected.begin(), expected.end());
+    bsi::radix_sort(v.begin(), v.end());
+    EXPECT_EQ(v, expected);
+}
+#endif
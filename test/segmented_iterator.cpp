@@ -0,0 +1,289 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/segmented_iterator.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+
+// An iterator over a vector of chunks, like the iterators of a deque.  The
+// end iterator refers to the end of the last chunk.
+struct chunked_iterator : boost::stl_interfaces::iterator_interface<
+                              chunked_iterator,
+                              std::forward_iterator_tag,
+                              int>
+{
+    using chunk = std::vector<int>;
+
+    chunked_iterator() : seg_(nullptr), it_(nullptr), last_seg_(nullptr) {}
+    chunked_iterator(chunk * seg, int * it, chunk * last_seg) :
+        seg_(seg),
+        it_(it),
+        last_seg_(last_seg)
+    {
+        skip_empty();
+    }
+
+    int & operator*() const { return *it_; }
+    chunked_iterator & operator++()
+    {
+        ++it_;
+        skip_empty();
+        return *this;
+    }
+    friend bool operator==(chunked_iterator lhs, chunked_iterator rhs)
+    {
+        return lhs.seg_ == rhs.seg_ && lhs.it_ == rhs.it_;
+    }
+
+private:
+    friend boost::stl_interfaces::access;
+    chunk * segment() const { return seg_; }
+    int * local() const { return it_; }
+    int * local_begin(chunk * seg) const { return seg->data(); }
+    int * local_end(chunk * seg) const { return seg->data() + seg->size(); }
+    chunked_iterator compose(chunk * seg, int * it) const
+    {
+        return chunked_iterator(seg, it, last_seg_);
+    }
+
+    void skip_empty()
+    {
+        while (seg_ != last_seg_ && it_ == local_end(seg_)) {
+            ++seg_;
+            it_ = seg_->data();
+        }
+    }
+
+    chunk * seg_;
+    int * it_;
+    chunk * last_seg_;
+};
+
+struct chunked_buffer
+{
+    chunked_buffer(std::vector<std::vector<int>> chunks) :
+        chunks_(std::move(chunks))
+    {}
+
+    chunked_iterator begin()
+    {
+        return chunked_iterator(
+            &chunks_.front(), chunks_.front().data(), &chunks_.back());
+    }
+    chunked_iterator end()
+    {
+        return chunked_iterator(
+            &chunks_.back(),
+            chunks_.back().data() + chunks_.back().size(),
+            &chunks_.back());
+    }
+
+    std::vector<std::vector<int>> chunks_;
+};
+
+chunked_buffer make_buffer()
+{
+    return chunked_buffer({{0, 1, 2}, {}, {3}, {4, 5, 6, 7}, {}, {8, 9}});
+}
+
+// A chunked iterator whose chunks are themselves chunked, to check that the
+// algorithms recurse into segmented local iterators.
+struct nested_iterator : boost::stl_interfaces::iterator_interface<
+                             nested_iterator,
+                             std::forward_iterator_tag,
+                             int>
+{
+    using chunk = chunked_buffer;
+
+    nested_iterator() : seg_(nullptr), last_seg_(nullptr) {}
+    nested_iterator(chunk * seg, chunked_iterator it, chunk * last_seg) :
+        seg_(seg),
+        it_(it),
+        last_seg_(last_seg)
+    {
+        skip_empty();
+    }
+
+    int & operator*() const { return *it_; }
+    nested_iterator & operator++()
+    {
+        ++it_;
+        skip_empty();
+        return *this;
+    }
+    friend bool operator==(nested_iterator lhs, nested_iterator rhs)
+    {
+        return lhs.seg_ == rhs.seg_ && lhs.it_ == rhs.it_;
+    }
+
+private:
+    friend boost::stl_interfaces::access;
+    chunk * segment() const { return seg_; }
+    chunked_iterator local() const { return it_; }
+    chunked_iterator local_begin(chunk * seg) const { return seg->begin(); }
+    chunked_iterator local_end(chunk * seg) const { return seg->end(); }
+    nested_iterator compose(chunk * seg, chunked_iterator it) const
+    {
+        return nested_iterator(seg, it, last_seg_);
+    }
+
+    void skip_empty()
+    {
+        while (seg_ != last_seg_ && it_ == seg_->end()) {
+            ++seg_;
+            it_ = seg_->begin();
+        }
+    }
+
+    chunk * seg_;
+    chunked_iterator it_;
+    chunk * last_seg_;
+};
+
+static_assert(
+    boost::stl_interfaces::is_segmented_iterator<chunked_iterator>::value, "");
+static_assert(
+    boost::stl_interfaces::is_segmented_iterator<nested_iterator>::value, "");
+static_assert(!boost::stl_interfaces::is_segmented_iterator<int *>::value, "");
+static_assert(
+    !boost::stl_interfaces::is_segmented_iterator<
+        std::vector<int>::iterator>::value,
+    "");
+static_assert(
+    std::is_same<
+        boost::stl_interfaces::segmented_iterator_traits<
+            chunked_iterator>::segment_iterator,
+        std::vector<int> *>::value,
+    "");
+static_assert(
+    std::is_same<
+        boost::stl_interfaces::segmented_iterator_traits<
+            chunked_iterator>::local_iterator,
+        int *>::value,
+    "");
+
+
+TEST(segmented_iterator, copy)
+{
+    auto buf = make_buffer();
+    {
+        std::vector<int> result(10);
+        auto const out = boost::stl_interfaces::segmented_copy(
+            buf.begin(), buf.end(), result.begin());
+        EXPECT_EQ(out, result.end());
+        std::vector<int> const expected = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+        EXPECT_EQ(result, expected);
+    }
+    {
+        auto first = buf.begin();
+        std::advance(first, 4);
+        auto last = first;
+        std::advance(last, 2);
+        std::vector<int> result(2);
+        boost::stl_interfaces::segmented_copy(first, last, result.begin());
+        std::vector<int> const expected = {4, 5};
+        EXPECT_EQ(result, expected);
+    }
+    {
+        std::vector<int> result;
+        boost::stl_interfaces::segmented_copy(
+            buf.begin(), buf.begin(), std::back_inserter(result));
+        EXPECT_TRUE(result.empty());
+    }
+}
+
+TEST(segmented_iterator, fill)
+{
+    auto buf = make_buffer();
+    auto first = buf.begin();
+    std::advance(first, 2);
+    auto last = first;
+    std::advance(last, 5);
+    boost::stl_interfaces::segmented_fill(first, last, -1);
+    std::vector<int> result(10);
+    std::copy(buf.begin(), buf.end(), result.begin());
+    std::vector<int> const expected = {0, 1, -1, -1, -1, -1, -1, 7, 8, 9};
+    EXPECT_EQ(result, expected);
+}
+
+TEST(segmented_iterator, for_each)
+{
+    auto buf = make_buffer();
+    std::vector<int> result;
+    auto const f = boost::stl_interfaces::segmented_for_each(
+        buf.begin(), buf.end(), [&](int x) { result.push_back(x); });
+    (void)f;
+    std::vector<int> const expected = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    EXPECT_EQ(result, expected);
+}
+
+TEST(segmented_iterator, find)
+{
+    auto buf = make_buffer();
+    for (int i = 0; i < 10; ++i) {
+        auto const it =
+            boost::stl_interfaces::segmented_find(buf.begin(), buf.end(), i);
+        EXPECT_EQ(it, std::find(buf.begin(), buf.end(), i));
+        EXPECT_EQ(*it, i);
+    }
+    EXPECT_EQ(
+        boost::stl_interfaces::segmented_find(buf.begin(), buf.end(), 42),
+        buf.end());
+
+    auto first = buf.begin();
+    std::advance(first, 4);
+    EXPECT_EQ(
+        boost::stl_interfaces::segmented_find(first, buf.end(), 3), buf.end());
+}
+
+TEST(segmented_iterator, accumulate)
+{
+    auto buf = make_buffer();
+    EXPECT_EQ(
+        boost::stl_interfaces::segmented_accumulate(buf.begin(), buf.end(), 0),
+        45);
+    auto const times_next = [](int a, int b) { return a * (b + 1); };
+    EXPECT_EQ(
+        boost::stl_interfaces::segmented_accumulate(
+            buf.begin(), buf.end(), 1, times_next),
+        3628800);
+
+    std::vector<int> ints = {1, 2, 3};
+    EXPECT_EQ(
+        boost::stl_interfaces::segmented_accumulate(ints.begin(), ints.end(), 0),
+        6);
+}
+
+TEST(segmented_iterator, nested)
+{
+    std::vector<chunked_buffer> chunks = {
+        make_buffer(), chunked_buffer({{}, {10}}), make_buffer()};
+    nested_iterator const first(
+        &chunks.front(), chunks.front().begin(), &chunks.back());
+    nested_iterator const last(
+        &chunks.back(), chunks.back().end(), &chunks.back());
+
+    std::vector<int> result(21);
+    boost::stl_interfaces::segmented_copy(first, last, result.begin());
+    std::vector<int> expected(21);
+    std::copy(first, last, expected.begin());
+    EXPECT_EQ(result, expected);
+    EXPECT_EQ(result[10], 10);
+
+    EXPECT_EQ(
+        boost::stl_interfaces::segmented_accumulate(first, last, 0),
+        45 + 10 + 45);
+
+    auto const it = boost::stl_interfaces::segmented_find(first, last, 10);
+    EXPECT_EQ(it, std::find(first, last, 10));
+
+    boost::stl_interfaces::segmented_fill(first, last, 3);
+    EXPECT_EQ(std::count(first, last, 3), 21);
+}
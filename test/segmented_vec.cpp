@@ -0,0 +1,180 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/stl_interfaces/segmented_vector.hpp>
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <numeric>
+#include <string>
+#include <vector>
+
+
+using boost::stl_interfaces::segmented_vector;
+
+
+// Instantiate all the members we can.
+template struct segmented_vector<int>;
+template struct segmented_vector<int, 1>;
+template struct segmented_vector<std::string, 8>;
+
+using vec_t = segmented_vector<int, 4>;
+
+static_assert(
+    std::is_same<
+        std::iterator_traits<vec_t::iterator>::iterator_category,
+        std::random_access_iterator_tag>::value,
+    "");
+static_assert(
+    std::is_convertible<vec_t::iterator, vec_t::const_iterator>::value, "");
+static_assert(
+    !std::is_convertible<vec_t::const_iterator, vec_t::iterator>::value, "");
+static_assert(
+    boost::stl_interfaces::is_segmented_iterator<vec_t::iterator>::value, "");
+static_assert(
+    boost::stl_interfaces::is_segmented_iterator<
+        vec_t::const_iterator>::value,
+    "");
+static_assert(
+    std::is_same<
+        boost::stl_interfaces::segmented_iterator_traits<
+            vec_t::const_iterator>::local_iterator,
+        int const *>::value,
+    "");
+
+vec_t iota(int n)
+{
+    vec_t retval;
+    for (int i = 0; i < n; ++i) {
+        retval.push_back(i);
+    }
+    return retval;
+}
+
+
+TEST(segmented_vec, default_ctor)
+{
+    vec_t v;
+    EXPECT_TRUE(v.empty());
+    EXPECT_EQ(v.size(), 0u);
+    EXPECT_EQ(v.capacity(), 0u);
+    EXPECT_EQ(v.begin(), v.end());
+    EXPECT_EQ(
+        boost::stl_interfaces::segmented_find(v.begin(), v.end(), 0),
+        v.end());
+    EXPECT_EQ(
+        boost::stl_interfaces::segmented_accumulate(v.begin(), v.end(), 0),
+        0);
+    EXPECT_EQ(v, v);
+}
+
+TEST(segmented_vec, push_back_stable_addresses)
+{
+    vec_t v;
+    std::vector<int *> addresses;
+    for (int i = 0; i < 37; ++i) {
+        addresses.push_back(&v.emplace_back(i));
+    }
+    EXPECT_EQ(v.size(), 37u);
+    EXPECT_EQ(v.chunk_count(), 10u);
+    for (int i = 0; i < 37; ++i) {
+        EXPECT_EQ(&v[i], addresses[i]);
+        EXPECT_EQ(v[i], i);
+    }
+    EXPECT_EQ(v.front(), 0);
+    EXPECT_EQ(v.back(), 36);
+    EXPECT_EQ(*(v.rbegin() + 4), 32);
+
+    v.pop_back();
+    v.erase(v.begin() + 30, v.end());
+    EXPECT_EQ(v.size(), 30u);
+    EXPECT_EQ(v.back(), 29);
+    v.shrink_to_fit();
+    EXPECT_EQ(v.chunk_count(), 8u);
+    v.reserve(40);
+    EXPECT_EQ(v.capacity(), 40u);
+}
+
+TEST(segmented_vec, segmented_algorithms)
+{
+    // Every size, including those that fill the last chunk exactly, and
+    // every subrange.
+    for (int n = 0; n < 14; ++n) {
+        auto v = iota(n);
+        for (int first = 0; first <= n; ++first) {
+            for (int last = first; last <= n; ++last) {
+                auto const f = v.cbegin() + first;
+                auto const l = v.cbegin() + last;
+                std::vector<int> expected(last - first);
+                std::iota(expected.begin(), expected.end(), first);
+
+                std::vector<int> copied;
+                boost::stl_interfaces::segmented_copy(
+                    f, l, std::back_inserter(copied));
+                EXPECT_EQ(copied, expected);
+
+                EXPECT_EQ(
+                    boost::stl_interfaces::segmented_accumulate(f, l, 0),
+                    std::accumulate(expected.begin(), expected.end(), 0));
+                for (int x = first - 1; x <= last; ++x) {
+                    auto const it =
+                        boost::stl_interfaces::segmented_find(f, l, x);
+                    EXPECT_EQ(
+                        it - v.cbegin(), first <= x && x < last ? x : last);
+                }
+            }
+        }
+
+        boost::stl_interfaces::segmented_fill(v.begin(), v.end(), 7);
+        EXPECT_EQ(std::count(v.begin(), v.end(), 7), n);
+    }
+}
+
+TEST(segmented_vec, non_trivial_elements)
+{
+    segmented_vector<std::string, 2> s = {"a", std::string(40, 'b'), "c"};
+    s.emplace_back(5, 'd');
+    EXPECT_EQ(s[3], "ddddd");
+    auto s2 = s;
+    EXPECT_EQ(s2, s);
+    auto s3 = std::move(s2);
+    EXPECT_TRUE(s2.empty());
+    EXPECT_EQ(s3, s);
+    s2 = {"z"};
+    swap(s2, s3);
+    EXPECT_EQ(s2, s);
+    EXPECT_LT(s, s3);
+    s2.clear();
+    EXPECT_TRUE(s2.empty());
+
+    segmented_vector<std::unique_ptr<int>, 4> p;
+    for (int i = 0; i < 9; ++i) {
+        p.emplace_back(new int(i));
+    }
+    EXPECT_EQ(*p.back(), 8);
+    p.pop_back();
+    auto p2 = std::move(p);
+    EXPECT_EQ(p2.size(), 8u);
+}
+
+TEST(segmented_vec, erase_if)
+{
+    vec_t v;
+    for (int i = 0; i < 20; ++i) {
+        v.push_back(i);
+    }
+    auto const odd = [](int x) { return x % 2 == 1; };
+    EXPECT_EQ(v.erase_if(odd), 10u);
+    ASSERT_EQ(v.size(), 10u);
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_EQ(v[i], 2 * i);
+    }
+
+    std::vector<std::size_t> const indices = {0, 1, 5, 9};
+    EXPECT_EQ(v.erase_indices(indices), 4u);
+    EXPECT_EQ(v, vec_t({4, 6, 8, 12, 14, 16}));
+}
@@ -0,0 +1,146 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/sentinel_interface.hpp>
+#include <boost/stl_interfaces/view_interface.hpp>
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+
+namespace bsi = boost::stl_interfaces;
+
+// A C string, ending at its null terminator.
+struct c_str_view : bsi::view_interface<c_str_view>
+{
+    explicit c_str_view(char const * str) : str_(str) {}
+
+    char const * begin() const { return str_; }
+    bsi::null_sentinel_t end() const { return bsi::null_sentinel; }
+
+private:
+    char const * str_;
+};
+
+// The repeated_chars_iterator from the iterator tutorial, whose end is a
+// sentinel holding the number of characters, rather than another iterator.
+struct repeated_chars_iterator : bsi::iterator_interface<
+                                     repeated_chars_iterator,
+                                     std::forward_iterator_tag,
+                                     char,
+                                     char>
+{
+    repeated_chars_iterator() = default;
+    repeated_chars_iterator(char const * first, int size) :
+        first_(first),
+        size_(size)
+    {}
+
+    char operator*() const { return first_[n_ % size_]; }
+
+    int position() const { return n_; }
+
+private:
+    friend bsi::access;
+    int & base_reference() noexcept { return n_; }
+    int base_reference() const noexcept { return n_; }
+
+    char const * first_ = nullptr;
+    int size_ = 0;
+    int n_ = 0;
+};
+
+struct count_sentinel : bsi::sentinel_interface<count_sentinel>
+{
+    explicit count_sentinel(int n) : n(n) {}
+
+    friend bool
+    operator==(repeated_chars_iterator const & it, count_sentinel s)
+    {
+        return it.position() == s.n;
+    }
+    friend std::ptrdiff_t
+    operator-(count_sentinel s, repeated_chars_iterator const & it)
+    {
+        return s.n - it.position();
+    }
+
+    int n;
+};
+
+struct repeated_chars_view : bsi::view_interface<repeated_chars_view>
+{
+    repeated_chars_view(char const * chars, int size, int n) :
+        first_(chars, size),
+        n_(n)
+    {}
+
+    repeated_chars_iterator begin() const { return first_; }
+    count_sentinel end() const { return count_sentinel(n_); }
+
+private:
+    repeated_chars_iterator first_;
+    int n_;
+};
+
+
+TEST(sentinel_interface, null_sentinel)
+{
+    c_str_view const v("foo");
+    char const * const first = v.begin();
+    EXPECT_FALSE(first == v.end());
+    EXPECT_FALSE(v.end() == first);
+    EXPECT_TRUE(first != v.end());
+    EXPECT_TRUE(v.end() != first);
+    EXPECT_TRUE(first + 3 == v.end());
+    EXPECT_TRUE(v.end() == first + 3);
+
+    EXPECT_FALSE(v.empty());
+    EXPECT_TRUE(bool(v));
+    EXPECT_EQ(v.front(), 'f');
+    EXPECT_TRUE(c_str_view("").empty());
+    EXPECT_FALSE(c_str_view(""));
+
+    // A range-based for loop does this in C++17 and later.
+    std::string s;
+    for (auto it = v.begin(); it != v.end(); ++it) {
+        s += *it;
+    }
+    EXPECT_EQ(s, "foo");
+
+    int const ints[] = {3, 2, 1, 0, 4};
+    int sum = 0;
+    for (int const * it = ints; it != bsi::null_sentinel; ++it) {
+        sum += *it;
+    }
+    EXPECT_EQ(sum, 6);
+}
+
+TEST(sentinel_interface, sized_sentinel)
+{
+    repeated_chars_view const v("abc", 3, 7);
+    EXPECT_EQ(v.size(), 7);
+    EXPECT_EQ(v.begin() - v.end(), -7);
+    EXPECT_FALSE(v.empty());
+    EXPECT_EQ(v.front(), 'a');
+
+    // A range-based for loop does this in C++17 and later.
+    std::string s;
+    for (auto it = v.begin(); it != v.end(); ++it) {
+        s += *it;
+    }
+    EXPECT_EQ(s, "abcabca");
+
+    repeated_chars_view const empty("abc", 3, 0);
+    EXPECT_TRUE(empty.empty());
+    EXPECT_EQ(empty.size(), 0);
+
+    // Iterators still compare with each other.
+    auto it = v.begin();
+    EXPECT_TRUE(it == v.begin());
+    EXPECT_TRUE(++it != v.begin());
+}
@@ -0,0 +1,159 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/set_operation_view.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <forward_list>
+#include <iterator>
+#include <list>
+#include <vector>
+
+
+namespace bsi = boost::stl_interfaces;
+
+using vec_iter = std::vector<int>::const_iterator;
+using list_iter = std::list<int>::const_iterator;
+
+using merge_iter = bsi::merge_view<vec_iter, list_iter>::iterator;
+
+BOOST_STL_INTERFACES_STATIC_ASSERT_CONCEPT(merge_iter, std::forward_iterator)
+
+static_assert(std::is_same<merge_iter::reference, int const &>::value, "");
+static_assert(
+    std::is_same<
+        bsi::merge_view<int *, list_iter>::iterator::reference,
+        int>::value,
+    "");
+
+template<typename View>
+std::vector<int> to_vector(View const & v)
+{
+    return std::vector<int>(v.begin(), v.end());
+}
+
+// Compares each view with the standard algorithm it stands in for.
+template<typename Range1, typename Range2>
+void check_all(Range1 const & r1, Range2 const & r2)
+{
+    std::vector<int> expected;
+
+    std::merge(
+        r1.begin(), r1.end(), r2.begin(), r2.end(),
+        std::back_inserter(expected));
+    EXPECT_EQ(to_vector(bsi::make_merge_view(r1, r2)), expected);
+
+    expected.clear();
+    std::set_union(
+        r1.begin(), r1.end(), r2.begin(), r2.end(),
+        std::back_inserter(expected));
+    EXPECT_EQ(to_vector(bsi::make_set_union_view(r1, r2)), expected);
+
+    expected.clear();
+    std::set_intersection(
+        r1.begin(), r1.end(), r2.begin(), r2.end(),
+        std::back_inserter(expected));
+    EXPECT_EQ(to_vector(bsi::make_set_intersection_view(r1, r2)), expected);
+
+    expected.clear();
+    std::set_difference(
+        r1.begin(), r1.end(), r2.begin(), r2.end(),
+        std::back_inserter(expected));
+    EXPECT_EQ(to_vector(bsi::make_set_difference_view(r1, r2)), expected);
+}
+
+
+TEST(set_operation_view, basic)
+{
+    std::vector<int> const a = {1, 2, 2, 4, 6, 8, 8, 8};
+    std::vector<int> const b = {2, 3, 4, 4, 8, 9};
+
+    EXPECT_EQ(
+        to_vector(bsi::make_merge_view(a, b)),
+        (std::vector<int>{1, 2, 2, 2, 3, 4, 4, 4, 6, 8, 8, 8, 8, 9}));
+    EXPECT_EQ(
+        to_vector(bsi::make_set_union_view(a, b)),
+        (std::vector<int>{1, 2, 2, 3, 4, 4, 6, 8, 8, 8, 9}));
+    EXPECT_EQ(
+        to_vector(bsi::make_set_intersection_view(a, b)),
+        (std::vector<int>{2, 4, 8}));
+    EXPECT_EQ(
+        to_vector(bsi::make_set_difference_view(a, b)),
+        (std::vector<int>{1, 2, 6, 8, 8}));
+    EXPECT_EQ(
+        to_vector(bsi::make_set_difference_view(b, a)),
+        (std::vector<int>{3, 4, 9}));
+
+    check_all(a, b);
+    check_all(b, a);
+}
+
+TEST(set_operation_view, empty)
+{
+    std::vector<int> const a = {1, 2, 3};
+    std::vector<int> const none;
+
+    check_all(a, none);
+    check_all(none, a);
+    check_all(none, none);
+
+    EXPECT_TRUE(bsi::make_set_intersection_view(a, none).empty());
+    std::vector<int> const disjoint = {4, 5};
+    EXPECT_TRUE(bsi::make_set_intersection_view(a, disjoint).empty());
+    EXPECT_TRUE(bsi::make_set_difference_view(a, a).empty());
+    EXPECT_EQ(bsi::make_merge_view(a, disjoint).front(), 1);
+}
+
+TEST(set_operation_view, galloping)
+{
+    // A short list against a long one, as in a posting-list intersection.
+    std::vector<int> long_list(10000);
+    for (int i = 0; i < 10000; ++i) {
+        long_list[i] = 3 * i;
+    }
+    std::vector<int> const short_list = {-1, 0, 5, 300, 301, 9000, 29997};
+
+    check_all(short_list, long_list);
+    check_all(long_list, short_list);
+    EXPECT_EQ(
+        to_vector(bsi::make_set_intersection_view(short_list, long_list)),
+        (std::vector<int>{0, 300, 9000, 29997}));
+
+    // Galloping makes far fewer comparisons than a linear merge.
+    int comparisons = 0;
+    auto counting_less = [&comparisons](int x, int y) {
+        ++comparisons;
+        return x < y;
+    };
+    auto const v = bsi::make_set_intersection_view(
+        short_list, long_list, counting_less);
+    EXPECT_EQ(std::distance(v.begin(), v.end()), 4);
+    EXPECT_LT(comparisons, 300);
+}
+
+TEST(set_operation_view, forward_ranges)
+{
+    std::forward_list<int> const a = {1, 3, 5, 7, 9, 11};
+    std::list<int> const b = {3, 4, 5, 11, 12};
+
+    check_all(a, b);
+    check_all(b, a);
+    EXPECT_EQ(
+        to_vector(bsi::make_set_intersection_view(a, b)),
+        (std::vector<int>{3, 5, 11}));
+}
+
+TEST(set_operation_view, custom_comparison)
+{
+    std::vector<int> const a = {9, 7, 5, 3};
+    std::vector<int> const b = {8, 7, 3, 1};
+    auto const v = bsi::make_set_union_view(a, b, std::greater<>{});
+    EXPECT_EQ(to_vector(v), (std::vector<int>{9, 8, 7, 5, 3, 1}));
+    EXPECT_EQ(
+        to_vector(bsi::make_set_intersection_view(a, b, std::greater<>{})),
+        (std::vector<int>{7, 3}));
+}
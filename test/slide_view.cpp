@@ -0,0 +1,236 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/slide_view.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <list>
+#include <numeric>
+#include <vector>
+
+
+namespace bsi = boost::stl_interfaces;
+
+using ptr_slide_iter = bsi::slide_iterator<int *>;
+using vec_slide_iter = bsi::slide_iterator<std::vector<int>::iterator>;
+using list_slide_iter = bsi::slide_iterator<std::list<int>::iterator>;
+
+static_assert(
+    std::is_same<
+        ptr_slide_iter::value_type,
+        bsi::chunk_range<int *, bsi::contiguous>>::value,
+    "");
+static_assert(
+    std::is_same<
+        ptr_slide_iter::iterator_category,
+        std::random_access_iterator_tag>::value,
+    "");
+static_assert(
+    std::is_same<
+        vec_slide_iter::iterator_category,
+        std::random_access_iterator_tag>::value,
+    "");
+static_assert(
+    std::is_same<
+        list_slide_iter::iterator_category,
+        std::forward_iterator_tag>::value,
+    "");
+
+using ptr_adjacent_iter = bsi::adjacent_iterator<int *, 3>;
+using list_adjacent_iter = bsi::adjacent_iterator<std::list<int>::iterator, 3>;
+
+static_assert(
+    std::is_same<
+        ptr_adjacent_iter::value_type,
+        bsi::chunk_range<int *, bsi::contiguous>>::value,
+    "");
+static_assert(
+    std::is_same<
+        ptr_adjacent_iter::iterator_category,
+        std::random_access_iterator_tag>::value,
+    "");
+static_assert(
+    std::is_same<
+        list_adjacent_iter::value_type,
+        std::array<std::list<int>::iterator, 3>>::value,
+    "");
+static_assert(
+    std::is_same<
+        list_adjacent_iter::iterator_category,
+        std::forward_iterator_tag>::value,
+    "");
+
+template<typename View>
+std::vector<std::vector<int>> to_vectors(View const & windows)
+{
+    std::vector<std::vector<int>> retval;
+    for (auto window : windows) {
+        retval.push_back(std::vector<int>(window.begin(), window.end()));
+    }
+    return retval;
+}
+
+// For views whose windows are arrays of iterators.
+template<typename View>
+std::vector<std::vector<int>> deref_to_vectors(View const & windows)
+{
+    std::vector<std::vector<int>> retval;
+    for (auto window : windows) {
+        retval.push_back(std::vector<int>());
+        for (auto it : window) {
+            retval.back().push_back(*it);
+        }
+    }
+    return retval;
+}
+
+
+TEST(slide_view, contiguous)
+{
+    std::vector<int> ints = {0, 1, 2, 3, 4};
+
+    bsi::slide_view<int *> const windows(ints.data(), ints.data() + 5, 3);
+    EXPECT_EQ(windows.window_size(), 3);
+    EXPECT_EQ(windows.size(), 3);
+    EXPECT_EQ(
+        to_vectors(windows),
+        (std::vector<std::vector<int>>{{0, 1, 2}, {1, 2, 3}, {2, 3, 4}}));
+
+    // Each window is a span of the underlying elements.
+    EXPECT_EQ(windows[1].data(), ints.data() + 1);
+    EXPECT_EQ(windows.back().data(), ints.data() + 2);
+    EXPECT_EQ(windows.back().size(), 3);
+
+    auto it = windows.end();
+    --it;
+    EXPECT_EQ((*it).front(), 2);
+    EXPECT_EQ(windows.end() - windows.begin(), 3);
+    EXPECT_EQ(windows.begin() + 3, windows.end());
+}
+
+TEST(slide_view, random_access)
+{
+    std::vector<int> ints = {0, 1, 2, 3};
+    {
+        auto const windows = bsi::make_slide_view(ints, 1);
+        EXPECT_EQ(windows.size(), 4);
+        EXPECT_EQ(
+            to_vectors(windows),
+            (std::vector<std::vector<int>>{{0}, {1}, {2}, {3}}));
+    }
+    {
+        auto const windows = bsi::make_slide_view(ints, 4);
+        EXPECT_EQ(windows.size(), 1);
+        EXPECT_EQ(windows.front().size(), 4);
+    }
+    {
+        auto const windows = bsi::make_slide_view(ints, 5);
+        EXPECT_TRUE(windows.empty());
+        EXPECT_EQ(windows.size(), 0);
+    }
+    {
+        std::vector<int> empty;
+        auto const windows = bsi::make_slide_view(empty, 2);
+        EXPECT_TRUE(windows.empty());
+    }
+}
+
+TEST(slide_view, forward)
+{
+    std::list<int> ints = {0, 1, 2, 3, 4};
+    {
+        auto const windows = bsi::make_slide_view(ints, 2);
+        EXPECT_EQ(
+            to_vectors(windows),
+            (std::vector<std::vector<int>>{{0, 1}, {1, 2}, {2, 3}, {3, 4}}));
+        EXPECT_EQ(std::distance(windows.begin(), windows.end()), 4);
+        EXPECT_EQ(*windows.front().begin(), 0);
+    }
+    {
+        auto const windows = bsi::make_slide_view(ints, 5);
+        EXPECT_EQ(
+            to_vectors(windows),
+            (std::vector<std::vector<int>>{{0, 1, 2, 3, 4}}));
+    }
+    {
+        auto const windows = bsi::make_slide_view(ints, 6);
+        EXPECT_TRUE(windows.empty());
+    }
+    {
+        std::list<int> empty;
+        auto const windows = bsi::make_slide_view(empty, 1);
+        EXPECT_TRUE(windows.empty());
+    }
+}
+
+TEST(adjacent_view, contiguous)
+{
+    std::vector<int> ints = {0, 1, 2, 3, 4};
+
+    bsi::adjacent_view<int *, 2> const windows(
+        ints.data(), ints.data() + ints.size());
+    EXPECT_EQ(windows.size(), 4);
+    EXPECT_EQ(
+        to_vectors(windows),
+        (std::vector<std::vector<int>>{{0, 1}, {1, 2}, {2, 3}, {3, 4}}));
+    EXPECT_EQ(windows[3].data(), ints.data() + 3);
+
+    int a[] = {0, 1};
+    EXPECT_TRUE(bsi::make_adjacent_view<3>(a).empty());
+    EXPECT_EQ(bsi::make_adjacent_view<2>(a).size(), 1);
+}
+
+TEST(adjacent_view, forward)
+{
+    std::list<int> ints = {0, 1, 2, 3, 4};
+    {
+        auto const windows = bsi::make_adjacent_view<3>(ints);
+        EXPECT_EQ(
+            deref_to_vectors(windows),
+            (std::vector<std::vector<int>>{{0, 1, 2}, {1, 2, 3}, {2, 3, 4}}));
+        EXPECT_EQ(std::distance(windows.begin(), windows.end()), 3);
+    }
+    {
+        auto const windows = bsi::make_adjacent_view<1>(ints);
+        EXPECT_EQ(std::distance(windows.begin(), windows.end()), 5);
+    }
+    {
+        auto const windows = bsi::make_adjacent_view<6>(ints);
+        EXPECT_TRUE(windows.empty());
+    }
+    {
+        std::list<int> empty;
+        auto const windows = bsi::make_adjacent_view<2>(empty);
+        EXPECT_TRUE(windows.empty());
+    }
+}
+
+TEST(slide_view, algorithms)
+{
+    std::vector<double> prices = {1, 2, 3, 4, 5, 6};
+
+    // A moving average.
+    std::vector<double> averages;
+    auto const windows = bsi::make_slide_view(prices, 3);
+    std::transform(
+        windows.begin(),
+        windows.end(),
+        std::back_inserter(averages),
+        [](auto window) {
+            return std::accumulate(window.begin(), window.end(), 0.0) / 3;
+        });
+    EXPECT_EQ(averages, (std::vector<double>{2, 3, 4, 5}));
+
+    // Bigrams.
+    std::list<char> chars = {'a', 'b', 'a', 'b'};
+    auto const bigrams = bsi::make_adjacent_view<2>(chars);
+    auto const ab = std::count_if(
+        bigrams.begin(), bigrams.end(), [](auto window) {
+            return *window[0] == 'a' && *window[1] == 'b';
+        });
+    EXPECT_EQ(ab, 2);
+}
@@ -0,0 +1,330 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/stl_interfaces/small_vector.hpp>
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+using boost::stl_interfaces::small_vector;
+
+
+// Instantiate all the members we can.
+template struct small_vector<int, 8>;
+template struct small_vector<std::string, 2>;
+
+using vec_type = small_vector<int, 4>;
+
+static_assert(
+    !boost::stl_interfaces::is_trivially_relocatable<vec_type>::value, "");
+static_assert(std::is_nothrow_move_constructible<vec_type>::value, "");
+
+template<typename Vec>
+std::vector<typename Vec::value_type> to_vector(Vec const & v)
+{
+    return std::vector<typename Vec::value_type>(v.begin(), v.end());
+}
+
+// Counts the live objects, and throws from its copy constructor on the
+// copy_to_throw-th copy.
+struct counted
+{
+    counted(int x) : x_(x) { ++live; }
+    counted(counted const & other) : x_(other.x_)
+    {
+        if (copy_to_throw && !--copy_to_throw)
+            throw std::runtime_error("copy");
+        ++live;
+    }
+    counted & operator=(counted const &) = default;
+    ~counted() { --live; }
+
+    friend bool operator==(counted lhs, counted rhs)
+    {
+        return lhs.x_ == rhs.x_;
+    }
+
+    int x_;
+
+    static int live;
+    static int copy_to_throw;
+};
+int counted::live = 0;
+int counted::copy_to_throw = 0;
+
+
+TEST(small_vec, default_ctor)
+{
+    vec_type v;
+    EXPECT_TRUE(v.empty());
+    EXPECT_EQ(v.size(), 0u);
+    EXPECT_EQ(v.capacity(), 4u);
+    EXPECT_TRUE(v.is_inline());
+    EXPECT_EQ(v, v);
+    EXPECT_THROW(v.at(0), std::out_of_range);
+}
+
+TEST(small_vec, other_ctors_assign)
+{
+    {
+        vec_type v(3);
+        EXPECT_EQ(to_vector(v), std::vector<int>(3));
+        EXPECT_TRUE(v.is_inline());
+    }
+    {
+        vec_type v(6, 7);
+        EXPECT_EQ(to_vector(v), std::vector<int>(6, 7));
+        EXPECT_FALSE(v.is_inline());
+        EXPECT_EQ(v.capacity(), 6u);
+    }
+    {
+        std::vector<int> const src = {1, 2, 3, 4, 5};
+        vec_type v(src.begin(), src.end());
+        EXPECT_EQ(to_vector(v), src);
+        v.assign(2, 9);
+        EXPECT_EQ(to_vector(v), std::vector<int>({9, 9}));
+        v.assign({1, 2, 3, 4, 5, 6, 7, 8, 9});
+        EXPECT_EQ(v.size(), 9u);
+        v = {3, 2};
+        EXPECT_EQ(to_vector(v), std::vector<int>({3, 2}));
+    }
+}
+
+TEST(small_vec, copy_move)
+{
+    vec_type const small = {1, 2};
+    vec_type const big = {1, 2, 3, 4, 5, 6};
+
+    for (auto const & src : {small, big}) {
+        vec_type copy = src;
+        EXPECT_EQ(copy, src);
+        EXPECT_EQ(copy.is_inline(), src.is_inline());
+
+        vec_type moved = std::move(copy);
+        EXPECT_EQ(moved, src);
+        EXPECT_TRUE(copy.empty());
+        EXPECT_TRUE(copy.is_inline());
+
+        for (auto const & dst_init : {small, big}) {
+            vec_type dst = dst_init;
+            dst = src;
+            EXPECT_EQ(dst, src);
+
+            vec_type dst2 = dst_init;
+            vec_type src2 = src;
+            dst2 = std::move(src2);
+            EXPECT_EQ(dst2, src);
+            EXPECT_TRUE(src2.empty());
+
+            vec_type a = src;
+            vec_type b = dst_init;
+            swap(a, b);
+            EXPECT_EQ(a, dst_init);
+            EXPECT_EQ(b, src);
+        }
+    }
+}
+
+TEST(small_vec, spill_and_grow)
+{
+    vec_type v;
+    for (int i = 0; i < 4; ++i) {
+        v.push_back(i);
+    }
+    EXPECT_TRUE(v.is_inline());
+    int const * const inline_data = v.data();
+
+    v.push_back(4);
+    EXPECT_FALSE(v.is_inline());
+    EXPECT_EQ(v.capacity(), 8u);
+    EXPECT_NE(v.data(), inline_data);
+    for (int i = 5; i < 9; ++i) {
+        v.push_back(i);
+    }
+    EXPECT_EQ(v.capacity(), 16u);
+    EXPECT_EQ(to_vector(v), std::vector<int>({0, 1, 2, 3, 4, 5, 6, 7, 8}));
+
+    v.reserve(100);
+    EXPECT_EQ(v.capacity(), 100u);
+    v.shrink_to_fit();
+    EXPECT_EQ(v.capacity(), 9u);
+    v.resize(2);
+    v.shrink_to_fit();
+    EXPECT_TRUE(v.is_inline());
+    EXPECT_EQ(v.data(), inline_data);
+    EXPECT_EQ(to_vector(v), std::vector<int>({0, 1}));
+
+    v.resize(6, 5);
+    EXPECT_EQ(to_vector(v), std::vector<int>({0, 1, 5, 5, 5, 5}));
+    v.resize_for_overwrite(7);
+    EXPECT_EQ(v.size(), 7u);
+}
+
+TEST(small_vec, aliasing)
+{
+    // The argument refers to an element that moves during the spill.
+    {
+        small_vector<std::string, 2> v = {"a", "b"};
+        v.push_back(v[0]);
+        v.emplace(v.begin(), v[2]);
+        EXPECT_EQ(to_vector(v), std::vector<std::string>({"a", "a", "b", "a"}));
+    }
+    {
+        vec_type v = {1, 2, 3};
+        v.insert(v.begin() + 1, v.begin(), v.end());
+        EXPECT_EQ(to_vector(v), std::vector<int>({1, 1, 2, 3, 2, 3}));
+    }
+}
+
+struct copy_counted
+{
+    copy_counted(int x) : x_(x) {}
+    copy_counted(copy_counted const & other) : x_(other.x_) { ++copies; }
+    copy_counted & operator=(copy_counted const &) = default;
+
+    int x_;
+
+    static int copies;
+};
+int copy_counted::copies = 0;
+
+TEST(small_vec, assign_grows_in_place)
+{
+    // assign() erases the elements and then reserve()s, so the old
+    // elements are not copied to the new storage, and no temporary vector
+    // is swapped in.  The one extra copy is of x.
+    {
+        small_vector<copy_counted, 4> v = {1, 2, 3};
+        copy_counted const x(9);
+        copy_counted::copies = 0;
+        v.assign(10, x);
+        EXPECT_EQ(copy_counted::copies, 11);
+        EXPECT_EQ(v.size(), 10u);
+        EXPECT_EQ(v.capacity(), 10u);
+        EXPECT_EQ(v[9].x_, 9);
+
+        std::vector<copy_counted> const src(12, copy_counted(4));
+        copy_counted::copies = 0;
+        v.assign(src.begin(), src.end());
+        EXPECT_EQ(copy_counted::copies, 12);
+        EXPECT_EQ(v.capacity(), 12u);
+        EXPECT_EQ(v[11].x_, 4);
+    }
+    // x refers to an element that is erased before the growth.
+    {
+        small_vector<std::string, 2> v = {"abc", "d"};
+        v.assign(5, v[0]);
+        EXPECT_EQ(to_vector(v), std::vector<std::string>(5, "abc"));
+        v.assign(3, v[4]);
+        EXPECT_EQ(to_vector(v), std::vector<std::string>(3, "abc"));
+    }
+}
+
+TEST(small_vec, emplace_insert_erase)
+{
+    vec_type v = {1, 4};
+    v.insert(v.begin() + 1, 2);
+    v.emplace(v.begin() + 2, 3);
+    EXPECT_TRUE(v.is_inline());
+    v.insert(v.end(), {5, 6});
+    v.insert(v.begin(), 0);
+    EXPECT_EQ(to_vector(v), std::vector<int>({0, 1, 2, 3, 4, 5, 6}));
+
+    v.erase(v.begin());
+    v.erase(v.begin() + 2, v.begin() + 4);
+    EXPECT_EQ(to_vector(v), std::vector<int>({1, 2, 5, 6}));
+    v.pop_back();
+    EXPECT_EQ(v.back(), 5);
+    v.clear();
+    EXPECT_TRUE(v.empty());
+}
+
+TEST(small_vec, non_relocatable_elements)
+{
+    small_vector<std::string, 2> v;
+    v.push_back(std::string(30, 'a'));
+    v.push_back("b");
+    v.insert(v.begin() + 1, {"c", "d"});
+    v.emplace(v.begin(), "e");
+    EXPECT_EQ(
+        to_vector(v),
+        std::vector<std::string>({"e", std::string(30, 'a'), "c", "d", "b"}));
+    v.erase(v.begin() + 1, v.begin() + 1);
+    EXPECT_EQ(
+        to_vector(v),
+        std::vector<std::string>({"e", std::string(30, 'a'), "c", "d", "b"}));
+    v.erase(v.begin(), v.begin() + 3);
+    v.shrink_to_fit();
+    EXPECT_TRUE(v.is_inline());
+    EXPECT_EQ(to_vector(v), std::vector<std::string>({"d", "b"}));
+
+    small_vector<std::unique_ptr<int>, 1> ptrs;
+    ptrs.push_back(std::make_unique<int>(1));
+    ptrs.push_back(std::make_unique<int>(2));
+    ptrs.emplace(ptrs.begin(), std::make_unique<int>(0));
+    EXPECT_EQ(*ptrs[0], 0);
+    EXPECT_EQ(*ptrs[2], 2);
+    auto ptrs2 = std::move(ptrs);
+    EXPECT_EQ(*ptrs2[1], 1);
+}
+
+TEST(small_vec, strong_guarantee_on_spill)
+{
+    {
+        small_vector<counted, 2> v = {1, 2};
+        EXPECT_EQ(counted::live, 2);
+
+        // counted may throw when copied, and has no nothrow move, so the
+        // spill copies; the copy of the old elements throws.
+        counted::copy_to_throw = 2;
+        EXPECT_THROW(v.push_back(3), std::runtime_error);
+        EXPECT_TRUE(v.is_inline());
+        EXPECT_EQ(v.size(), 2u);
+        EXPECT_EQ(v[1], 2);
+        EXPECT_EQ(counted::live, 2);
+
+        counted::copy_to_throw = 0;
+        v.push_back(3);
+        EXPECT_FALSE(v.is_inline());
+        EXPECT_EQ(counted::live, 3);
+    }
+    EXPECT_EQ(counted::live, 0);
+}
+
+TEST(small_vec, relocating_conversions)
+{
+    namespace bsi = boost::stl_interfaces;
+
+    bsi::static_vector<std::unique_ptr<int>, 8> ptrs;
+    for (int i = 0; i < 6; ++i) {
+        ptrs.push_back(std::make_unique<int>(i));
+    }
+    small_vector<std::unique_ptr<int>, 4> v(std::move(ptrs));
+    EXPECT_TRUE(ptrs.empty());
+    EXPECT_FALSE(v.is_inline());
+    ASSERT_EQ(v.size(), 6u);
+    EXPECT_EQ(*v[5], 5);
+
+    bsi::static_vector<std::unique_ptr<int>, 6> back(std::move(v));
+    EXPECT_TRUE(v.empty());
+    ASSERT_EQ(back.size(), 6u);
+    EXPECT_EQ(*back[0], 0);
+    EXPECT_EQ(*back[5], 5);
+
+    bsi::static_vector<std::string, 4> strings = {"a", std::string(30, 'b')};
+    small_vector<std::string, 2> strings2(std::move(strings));
+    EXPECT_TRUE(strings.empty());
+    EXPECT_TRUE(strings2.is_inline());
+    EXPECT_EQ(
+        to_vector(strings2),
+        std::vector<std::string>({"a", std::string(30, 'b')}));
+}
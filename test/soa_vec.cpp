@@ -0,0 +1,258 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/stl_interfaces/soa_vector.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+using boost::stl_interfaces::soa_vector;
+
+
+// Instantiate all the members we can.
+template struct soa_vector<int, double>;
+
+using vec_type = soa_vector<int, std::string>;
+using value_type = vec_type::value_type;
+
+static_assert(
+    std::is_same<
+        std::iterator_traits<vec_type::iterator>::iterator_category,
+        std::random_access_iterator_tag>::value,
+    "");
+static_assert(
+    std::is_same<
+        std::iterator_traits<vec_type::iterator>::value_type,
+        std::tuple<int, std::string>>::value,
+    "");
+static_assert(
+    std::is_convertible<vec_type::iterator, vec_type::const_iterator>::value,
+    "");
+static_assert(
+    !std::is_convertible<vec_type::const_iterator, vec_type::iterator>::value,
+    "");
+static_assert(
+    boost::stl_interfaces::is_trivially_relocatable<vec_type>::value, "");
+
+
+TEST(soa_vec, default_ctor)
+{
+    vec_type v;
+    EXPECT_TRUE(v.empty());
+    EXPECT_EQ(v.size(), 0u);
+    EXPECT_EQ(v.capacity(), 0u);
+    EXPECT_EQ(v.begin(), v.end());
+    EXPECT_EQ(v, v);
+    EXPECT_THROW(v.at(0), std::out_of_range);
+}
+
+TEST(soa_vec, other_ctors_assign)
+{
+    {
+        vec_type v(3);
+        EXPECT_EQ(v.size(), 3u);
+        EXPECT_EQ(v[2], value_type());
+    }
+    {
+        vec_type v(2, value_type(7, "seven"));
+        EXPECT_EQ(v.size(), 2u);
+        EXPECT_EQ(v[0], value_type(7, "seven"));
+        EXPECT_EQ(v[1], value_type(7, "seven"));
+    }
+    {
+        vec_type v = {{1, "one"}, {2, "two"}, {3, "three"}};
+        EXPECT_EQ(v.size(), 3u);
+        EXPECT_EQ(v.front(), value_type(1, "one"));
+        EXPECT_EQ(v.back(), value_type(3, "three"));
+
+        vec_type v2(v);
+        EXPECT_EQ(v2, v);
+        vec_type v3(std::move(v2));
+        EXPECT_EQ(v3, v);
+        EXPECT_TRUE(v2.empty());
+
+        v2 = v3;
+        EXPECT_EQ(v2, v);
+        v3.clear();
+        EXPECT_TRUE(v3.empty());
+        v3 = std::move(v2);
+        EXPECT_EQ(v3, v);
+
+        v3.assign(4, value_type(0, "zero"));
+        EXPECT_EQ(v3, vec_type(4, value_type(0, "zero")));
+        v3 = {{5, "five"}};
+        EXPECT_EQ(v3, vec_type({{5, "five"}}));
+        EXPECT_LT(v, v3);
+    }
+}
+
+TEST(soa_vec, fields)
+{
+    soa_vector<int, double> v;
+    for (int i = 0; i < 100; ++i) {
+        v.emplace_back(i, i * 0.5);
+    }
+    EXPECT_EQ(v.size(), 100u);
+    EXPECT_LE(100u, v.capacity());
+
+    // Each field is contiguous.
+    int const * ints = v.data<0>();
+    double const * doubles = v.data<1>();
+    EXPECT_EQ(std::accumulate(ints, ints + v.size(), 0), 4950);
+    EXPECT_EQ(std::accumulate(doubles, doubles + v.size(), 0.0), 2475.0);
+    EXPECT_EQ(&std::get<0>(v[10]), ints + 10);
+    EXPECT_EQ(&std::get<1>(v[10]), doubles + 10);
+
+    // Writing through a reference writes to the fields.
+    v[3] = std::make_tuple(-1, -1.0);
+    EXPECT_EQ(ints[3], -1);
+    EXPECT_EQ(doubles[3], -1.0);
+    std::get<0>(v[4]) = 42;
+    EXPECT_EQ(ints[4], 42);
+
+    auto ref = v[5];
+    int & i = std::get<0>(ref);
+    i = 13;
+    EXPECT_EQ(ints[5], 13);
+
+    v.shrink_to_fit();
+    EXPECT_EQ(v.capacity(), 100u);
+    EXPECT_EQ(v[5], std::make_tuple(13, 2.5));
+}
+
+TEST(soa_vec, modifiers)
+{
+    vec_type v;
+    v.push_back(value_type(1, "one"));
+    v.emplace_back(3, "three");
+    v.emplace(v.begin() + 1, 2, "two");
+    v.insert(v.begin(), value_type(0, "zero"));
+    EXPECT_EQ(
+        v,
+        vec_type({{0, "zero"}, {1, "one"}, {2, "two"}, {3, "three"}}));
+
+    std::vector<value_type> more = {{4, "four"}, {5, "five"}};
+    auto it = v.insert(v.begin() + 2, more.begin(), more.end());
+    EXPECT_EQ(it, v.begin() + 2);
+    EXPECT_EQ(
+        v,
+        vec_type(
+            {{0, "zero"},
+             {1, "one"},
+             {4, "four"},
+             {5, "five"},
+             {2, "two"},
+             {3, "three"}}));
+
+    it = v.erase(v.begin() + 2, v.begin() + 4);
+    EXPECT_EQ(it, v.begin() + 2);
+    EXPECT_EQ(
+        v,
+        vec_type({{0, "zero"}, {1, "one"}, {2, "two"}, {3, "three"}}));
+
+    v.pop_back();
+    v.erase(v.begin());
+    EXPECT_EQ(v, vec_type({{1, "one"}, {2, "two"}}));
+
+    // The argument may refer to an element of the vector, even when the
+    // vector reallocates.
+    v.shrink_to_fit();
+    v.push_back(v[0]);
+    v.insert(v.begin(), v[1]);
+    EXPECT_EQ(
+        v, vec_type({{2, "two"}, {1, "one"}, {2, "two"}, {1, "one"}}));
+
+    v.resize(2);
+    EXPECT_EQ(v, vec_type({{2, "two"}, {1, "one"}}));
+    v.resize(3);
+    EXPECT_EQ(v.back(), value_type());
+
+    vec_type v2 = {{9, "nine"}};
+    swap(v, v2);
+    EXPECT_EQ(v, vec_type({{9, "nine"}}));
+    EXPECT_EQ(v2.size(), 3u);
+    v.swap(v2);
+    EXPECT_EQ(v.size(), 3u);
+}
+
+TEST(soa_vec, resize_for_overwrite)
+{
+    soa_vector<int, float> v(2);
+    v.resize_for_overwrite(10);
+    EXPECT_EQ(v.size(), 10u);
+    std::iota(v.data<0>(), v.data<0>() + v.size(), 0);
+    std::fill(v.data<1>(), v.data<1>() + v.size(), 1.0f);
+    EXPECT_EQ(v[9], std::make_tuple(9, 1.0f));
+}
+
+TEST(soa_vec, algorithms)
+{
+    vec_type v = {{3, "c"}, {1, "a"}, {2, "b"}, {0, "z"}};
+
+    std::sort(v.begin(), v.end());
+    EXPECT_EQ(v, vec_type({{0, "z"}, {1, "a"}, {2, "b"}, {3, "c"}}));
+
+    std::sort(v.begin(), v.end(), [](auto const & lhs, auto const & rhs) {
+        return std::get<1>(lhs) < std::get<1>(rhs);
+    });
+    EXPECT_EQ(v, vec_type({{1, "a"}, {2, "b"}, {3, "c"}, {0, "z"}}));
+
+    std::reverse(v.begin(), v.end());
+    EXPECT_EQ(v, vec_type({{0, "z"}, {3, "c"}, {2, "b"}, {1, "a"}}));
+
+    std::vector<int> ints;
+    std::transform(
+        v.rbegin(), v.rend(), std::back_inserter(ints), [](auto ref) {
+            return std::get<0>(ref);
+        });
+    EXPECT_EQ(ints, (std::vector<int>{1, 2, 3, 0}));
+
+    auto const & cv = v;
+    auto const found =
+        std::find(cv.begin(), cv.end(), std::make_tuple(3, std::string("c")));
+    EXPECT_EQ(found - cv.begin(), 1);
+}
+
+TEST(soa_vec, move_only_fields)
+{
+    soa_vector<std::unique_ptr<int>, int> v;
+    for (int i = 0; i < 10; ++i) {
+        v.emplace_back(std::make_unique<int>(i), i);
+    }
+    v.erase(v.begin() + 2);
+    EXPECT_EQ(v.size(), 9u);
+    EXPECT_EQ(*std::get<0>(v[2]), 3);
+    EXPECT_EQ(std::get<1>(v[2]), 3);
+
+    std::swap(v.data<0>()[0], v.data<0>()[1]);
+    EXPECT_EQ(*std::get<0>(v[0]), 1);
+}
+
+struct throws_on_copy
+{
+    throws_on_copy() = default;
+    throws_on_copy(throws_on_copy const &) { throw std::runtime_error("copy"); }
+    throws_on_copy & operator=(throws_on_copy const &) = default;
+};
+
+TEST(soa_vec, exceptions)
+{
+    // If the second field of an element throws, the first field of that
+    // element is destroyed, and the vector is unchanged.
+    soa_vector<std::string, throws_on_copy> v;
+    v.reserve(4);
+    std::string const s(100, 'x');
+    throws_on_copy const t;
+    EXPECT_THROW(v.emplace_back(s, t), std::runtime_error);
+    EXPECT_TRUE(v.empty());
+}
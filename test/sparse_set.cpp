@@ -0,0 +1,137 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/sparse_set.hpp>
+#include <boost/stl_interfaces/algorithm.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <set>
+#include <vector>
+
+
+namespace bsi = boost::stl_interfaces;
+
+// Instantiate all the members we can.
+template struct bsi::sparse_set<int>;
+template struct bsi::sparse_set<std::uint32_t>;
+
+static_assert(
+    std::is_same<bsi::sparse_set<int>::iterator, int const *>::value, "");
+
+template<typename Index>
+std::set<Index> to_set(bsi::sparse_set<Index> const & s)
+{
+    return std::set<Index>(s.begin(), s.end());
+}
+
+
+TEST(sparse_set, basics)
+{
+    bsi::sparse_set<int> s;
+    EXPECT_TRUE(s.empty());
+    EXPECT_EQ(s.begin(), s.end());
+    EXPECT_FALSE(s.contains(0));
+    EXPECT_FALSE(s.contains(-1));
+    EXPECT_EQ(s.find(3), s.end());
+    EXPECT_EQ(s.erase(3), 0u);
+
+    EXPECT_TRUE(s.insert(5).second);
+    EXPECT_TRUE(s.insert(2).second);
+    EXPECT_TRUE(s.emplace(9).second);
+    EXPECT_FALSE(s.insert(2).second);
+    EXPECT_EQ(*s.insert(2).first, 2);
+    EXPECT_EQ(s.size(), 3u);
+    EXPECT_GE(s.universe(), 10u);
+
+    // Insertion order, until something is erased.
+    EXPECT_EQ(
+        std::vector<int>(s.begin(), s.end()), (std::vector<int>{5, 2, 9}));
+    EXPECT_EQ(s.data(), &*s.begin());
+    EXPECT_EQ(s.front(), 5);
+    EXPECT_EQ(s[2], 9);
+    EXPECT_EQ(s.position(2), 1u);
+    EXPECT_EQ(s.find(9) - s.begin(), 2);
+    EXPECT_EQ(s.count(9), 1u);
+    EXPECT_EQ(s.count(8), 0u);
+
+    // The last element moves into the erased one's place.
+    EXPECT_EQ(s.erase(5), 1u);
+    EXPECT_EQ(std::vector<int>(s.begin(), s.end()), (std::vector<int>{9, 2}));
+    EXPECT_EQ(s.position(9), 0u);
+    EXPECT_FALSE(s.contains(5));
+    auto const it = s.erase(s.begin() + 1);
+    EXPECT_EQ(it, s.end());
+    EXPECT_EQ(std::vector<int>(s.begin(), s.end()), (std::vector<int>{9}));
+
+    s.clear();
+    EXPECT_TRUE(s.empty());
+    EXPECT_FALSE(s.contains(9));
+    EXPECT_TRUE(s.insert(9).second);
+}
+
+TEST(sparse_set, unsigned_indices)
+{
+    bsi::sparse_set<std::uint32_t> s(100);
+    EXPECT_EQ(s.universe(), 100u);
+    s.insert({0, 1, 2, 99});
+    EXPECT_EQ(s.universe(), 100u);
+    // 0 is an index here, not a null iterator.
+    EXPECT_EQ(s.erase(0), 1u);
+    EXPECT_EQ(to_set(s), (std::set<std::uint32_t>{1, 2, 99}));
+
+    s.erase(s.begin(), s.begin() + 2);
+    EXPECT_EQ(s.size(), 1u);
+    s.erase(s.begin(), s.end());
+    EXPECT_TRUE(s.empty());
+}
+
+TEST(sparse_set, equality)
+{
+    bsi::sparse_set<int> const a = {1, 2, 3};
+    bsi::sparse_set<int> const b = {3, 1, 2};
+    bsi::sparse_set<int> const c = {3, 1, 4};
+    EXPECT_EQ(a, b);
+    EXPECT_NE(a, c);
+    EXPECT_NE(a, (bsi::sparse_set<int>{1, 2}));
+
+    bsi::sparse_set<int> d = a;
+    bsi::sparse_set<int> e;
+    swap(d, e);
+    EXPECT_TRUE(d.empty());
+    EXPECT_EQ(e, a);
+}
+
+TEST(sparse_set, random_edits)
+{
+    std::mt19937 gen(42);
+    bsi::sparse_set<int> s;
+    std::set<int> expected;
+    for (int step = 0; step < 20000; ++step) {
+        int const i = std::uniform_int_distribution<int>(0, 3000)(gen);
+        if (std::uniform_int_distribution<int>(0, 2)(gen)) {
+            EXPECT_EQ(s.insert(i).second, expected.insert(i).second);
+        } else {
+            EXPECT_EQ(s.erase(i), expected.erase(i));
+        }
+        ASSERT_EQ(s.size(), expected.size());
+    }
+    EXPECT_EQ(to_set(s), expected);
+    for (int i = 0; i <= 3000; ++i) {
+        EXPECT_EQ(s.contains(i), expected.count(i) == 1u);
+        if (s.contains(i)) {
+            EXPECT_EQ(s[s.position(i)], i);
+        }
+    }
+
+    // The dense array is contiguous, so the vectorized algorithms apply.
+    EXPECT_EQ(*bsi::max_element(s.begin(), s.end()), *expected.rbegin());
+    EXPECT_EQ(
+        bsi::find(s.begin(), s.end(), *expected.begin()),
+        s.find(*expected.begin()));
+}
@@ -0,0 +1,127 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/stl_interfaces/split_view.hpp>
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+
+using boost::stl_interfaces::char_span;
+using boost::stl_interfaces::lines;
+using boost::stl_interfaces::split_iterator;
+using boost::stl_interfaces::split_mode;
+using boost::stl_interfaces::split_view;
+
+
+std::vector<std::string> pieces(split_view v)
+{
+    std::vector<std::string> retval;
+    for (auto piece : v) {
+        retval.push_back(piece.str());
+    }
+    return retval;
+}
+
+// The pieces, found one char at a time.
+std::vector<std::string>
+reference_split(std::string const & s, char delimiter, split_mode mode)
+{
+    std::vector<std::string> retval;
+    if (s.empty())
+        return retval;
+    std::string piece;
+    for (auto c : s) {
+        if (c == delimiter) {
+            retval.push_back(piece);
+            piece.clear();
+        } else {
+            piece += c;
+        }
+    }
+    if (s.back() != delimiter || mode == split_mode::separated)
+        retval.push_back(piece);
+    return retval;
+}
+
+split_view make_split(std::string const & s, char delimiter, split_mode mode)
+{
+    return split_view(s.data(), s.data() + s.size(), delimiter, mode);
+}
+
+static_assert(
+    std::is_same<
+        std::iterator_traits<split_iterator>::iterator_category,
+        std::forward_iterator_tag>::value,
+    "");
+
+
+TEST(split, examples)
+{
+    using v = std::vector<std::string>;
+    auto const sep = split_mode::separated;
+    auto const term = split_mode::terminated;
+
+    EXPECT_EQ(pieces(split_view()), v());
+    EXPECT_TRUE(split_view().empty());
+    EXPECT_EQ(pieces(make_split("", ',', sep)), v());
+    EXPECT_EQ(pieces(make_split("a", ',', sep)), v{"a"});
+    EXPECT_EQ(pieces(make_split(",", ',', sep)), (v{"", ""}));
+    EXPECT_EQ(pieces(make_split(",", ',', term)), v{""});
+    EXPECT_EQ(pieces(make_split("a,b", ',', sep)), (v{"a", "b"}));
+    EXPECT_EQ(pieces(make_split("a,b,", ',', sep)), (v{"a", "b", ""}));
+    EXPECT_EQ(pieces(make_split("a,b,", ',', term)), (v{"a", "b"}));
+    EXPECT_EQ(pieces(make_split(",,a,,", ',', sep)), (v{"", "", "a", "", ""}));
+    EXPECT_EQ(pieces(make_split(",,a,,", ',', term)), (v{"", "", "a", ""}));
+
+    EXPECT_EQ(pieces(lines("x\ny\n")), (v{"x", "y"}));
+    EXPECT_EQ(pieces(lines("x\ny")), (v{"x", "y"}));
+    EXPECT_EQ(pieces(lines("\n\n")), (v{"", ""}));
+    EXPECT_EQ(pieces(lines("\n")), v{""});
+    EXPECT_EQ(pieces(lines("")), v());
+}
+
+TEST(split, zero_copy)
+{
+    std::string const s = "ab cd";
+    auto const v = make_split(s, ' ', split_mode::separated);
+    auto it = v.begin();
+    EXPECT_EQ(it->data(), s.data());
+    EXPECT_EQ(it->size(), 2u);
+    auto const old = it++;
+    EXPECT_EQ(old->data(), s.data());
+    EXPECT_EQ((*it).data(), s.data() + 3);
+    EXPECT_EQ(*it, char_span(s.data() + 3, s.data() + 5));
+    EXPECT_NE(*it, *old);
+    EXPECT_EQ(++it, v.end());
+
+#if BOOST_STL_INTERFACES_SPLIT_VIEW_HAS_STRING_VIEW
+    std::string_view const sv = v.front();
+    EXPECT_EQ(sv, "ab");
+#endif
+}
+
+TEST(split, against_reference)
+{
+    std::mt19937 gen(4);
+    for (int i = 0; i < 500; ++i) {
+        std::string s;
+        auto const n = gen() % 100;
+        for (unsigned j = 0; j < n; ++j) {
+            // Mostly long runs, with the occasional delimiter.
+            s += gen() % 8 ? 'x' : '\n';
+        }
+        for (auto mode : {split_mode::separated, split_mode::terminated}) {
+            EXPECT_EQ(
+                pieces(make_split(s, '\n', mode)),
+                reference_split(s, '\n', mode))
+                << "\"" << s << "\"";
+        }
+    }
+}
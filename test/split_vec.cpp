@@ -0,0 +1,220 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/stl_interfaces/split_vector.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+using boost::stl_interfaces::split_value;
+using boost::stl_interfaces::split_vector;
+
+
+// Instantiate all the members we can.
+template struct split_vector<int, double>;
+
+using vec_type = split_vector<int, std::string>;
+using value_type = vec_type::value_type;
+
+static_assert(
+    std::is_same<
+        std::iterator_traits<vec_type::iterator>::iterator_category,
+        std::random_access_iterator_tag>::value,
+    "");
+static_assert(
+    std::is_same<
+        std::iterator_traits<vec_type::iterator>::value_type,
+        split_value<int, std::string>>::value,
+    "");
+static_assert(
+    std::is_convertible<vec_type::iterator, vec_type::const_iterator>::value,
+    "");
+static_assert(
+    !std::is_convertible<vec_type::const_iterator, vec_type::iterator>::value,
+    "");
+static_assert(
+    boost::stl_interfaces::is_trivially_relocatable<vec_type>::value, "");
+
+
+TEST(split_vec, ctors_assign)
+{
+    vec_type v;
+    EXPECT_TRUE(v.empty());
+    EXPECT_EQ(v.capacity(), 0u);
+    EXPECT_THROW(v.at(0), std::out_of_range);
+
+    vec_type v2(2, value_type{7, "seven"});
+    EXPECT_EQ(v2.size(), 2u);
+    EXPECT_EQ(v2[1], (value_type{7, "seven"}));
+
+    vec_type v3 = {{1, "one"}, {2, "two"}, {3, "three"}};
+    EXPECT_EQ(v3.front(), (value_type{1, "one"}));
+    EXPECT_EQ(v3.back(), (value_type{3, "three"}));
+
+    vec_type v4(v3);
+    EXPECT_EQ(v4, v3);
+    vec_type v5(std::move(v4));
+    EXPECT_EQ(v5, v3);
+    EXPECT_TRUE(v4.empty());
+    v4 = v5;
+    EXPECT_EQ(v4, v3);
+    v5.assign(4, value_type{0, "zero"});
+    EXPECT_EQ(v5, vec_type(4, value_type{0, "zero"}));
+    EXPECT_LT(v5, v3);
+    v5 = std::move(v4);
+    EXPECT_EQ(v5, v3);
+}
+
+struct order_hot
+{
+    double price;
+    int quantity;
+};
+
+struct order_cold
+{
+    char details[184];
+};
+
+TEST(split_vec, halves)
+{
+    split_vector<order_hot, order_cold> v;
+    for (int i = 0; i < 100; ++i) {
+        v.emplace_back(order_hot{i * 0.5, i}, order_cold{});
+    }
+    EXPECT_EQ(v.size(), 100u);
+
+    // Each half is contiguous, and the hot array holds only the hot halves.
+    order_hot const * hot = v.hot_data();
+    order_cold const * cold = v.cold_data();
+    EXPECT_EQ(&v[10].hot, hot + 10);
+    EXPECT_EQ(&v[10].cold, cold + 10);
+    int quantity = 0;
+    for (std::size_t i = 0; i < v.size(); ++i) {
+        quantity += hot[i].quantity;
+    }
+    EXPECT_EQ(quantity, 4950);
+
+    // Writing through a reference writes to the halves.
+    v[3].hot.quantity = -1;
+    v[3].cold.details[0] = 'x';
+    EXPECT_EQ(hot[3].quantity, -1);
+    EXPECT_EQ(cold[3].details[0], 'x');
+
+    v.shrink_to_fit();
+    EXPECT_EQ(v.capacity(), 100u);
+    EXPECT_EQ(v[3].hot.quantity, -1);
+    EXPECT_EQ(v[3].cold.details[0], 'x');
+}
+
+TEST(split_vec, modifiers)
+{
+    vec_type v;
+    v.push_back(value_type{1, "one"});
+    v.emplace_back(3, "three");
+    v.emplace(v.begin() + 1, 2, "two");
+    v.insert(v.begin(), value_type{0, "zero"});
+    EXPECT_EQ(
+        v, vec_type({{0, "zero"}, {1, "one"}, {2, "two"}, {3, "three"}}));
+
+    std::vector<value_type> more = {{4, "four"}, {5, "five"}};
+    auto it = v.insert(v.begin() + 2, more.begin(), more.end());
+    EXPECT_EQ(it, v.begin() + 2);
+    EXPECT_EQ(
+        v,
+        vec_type(
+            {{0, "zero"},
+             {1, "one"},
+             {4, "four"},
+             {5, "five"},
+             {2, "two"},
+             {3, "three"}}));
+
+    it = v.erase(v.begin() + 2, v.begin() + 4);
+    EXPECT_EQ(it, v.begin() + 2);
+    v.pop_back();
+    v.erase(v.begin());
+    EXPECT_EQ(v, vec_type({{1, "one"}, {2, "two"}}));
+
+    // The argument may refer to an element of the vector, even when the
+    // vector reallocates.
+    v.shrink_to_fit();
+    v.push_back(v[0]);
+    v.insert(v.begin(), v[1]);
+    EXPECT_EQ(
+        v, vec_type({{2, "two"}, {1, "one"}, {2, "two"}, {1, "one"}}));
+
+    v.resize(2);
+    EXPECT_EQ(v, vec_type({{2, "two"}, {1, "one"}}));
+    v.resize(3);
+    EXPECT_EQ(v.back(), value_type());
+
+    vec_type v2 = {{9, "nine"}};
+    swap(v, v2);
+    EXPECT_EQ(v, vec_type({{9, "nine"}}));
+    EXPECT_EQ(v2.size(), 3u);
+}
+
+TEST(split_vec, algorithms)
+{
+    vec_type v = {{3, "c"}, {1, "a"}, {2, "b"}, {0, "z"}};
+
+    std::sort(v.begin(), v.end());
+    EXPECT_EQ(v, vec_type({{0, "z"}, {1, "a"}, {2, "b"}, {3, "c"}}));
+
+    std::sort(v.begin(), v.end(), [](auto lhs, auto rhs) {
+        return lhs.cold < rhs.cold;
+    });
+    EXPECT_EQ(v, vec_type({{1, "a"}, {2, "b"}, {3, "c"}, {0, "z"}}));
+
+    std::reverse(v.begin(), v.end());
+    EXPECT_EQ(v, vec_type({{0, "z"}, {3, "c"}, {2, "b"}, {1, "a"}}));
+
+    auto const & cv = v;
+    auto const found = std::find_if(
+        cv.begin(), cv.end(), [](auto ref) { return ref.hot == 3; });
+    EXPECT_EQ(found - cv.begin(), 1);
+    EXPECT_EQ((*found).cold, "c");
+}
+
+TEST(split_vec, move_only_halves)
+{
+    split_vector<int, std::unique_ptr<int>> v;
+    for (int i = 0; i < 10; ++i) {
+        v.emplace_back(i, std::make_unique<int>(i));
+    }
+    v.erase(v.begin() + 2);
+    EXPECT_EQ(v.size(), 9u);
+    EXPECT_EQ(v[2].hot, 3);
+    EXPECT_EQ(*v[2].cold, 3);
+}
+
+struct throws_on_copy
+{
+    throws_on_copy() = default;
+    throws_on_copy(throws_on_copy const &) { throw std::runtime_error("copy"); }
+    throws_on_copy & operator=(throws_on_copy const &) = default;
+};
+
+TEST(split_vec, exceptions)
+{
+    // If the cold half of an element throws, its hot half is destroyed, and
+    // the vector is unchanged, whether or not it had to grow.
+    split_vector<std::string, throws_on_copy> v;
+    std::string const s(100, 'x');
+    throws_on_copy const t;
+    EXPECT_THROW(v.emplace_back(s, t), std::runtime_error);
+    EXPECT_TRUE(v.empty());
+    v.reserve(4);
+    EXPECT_THROW(v.emplace_back(s, t), std::runtime_error);
+    EXPECT_TRUE(v.empty());
+}
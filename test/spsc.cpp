@@ -0,0 +1,159 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/stl_interfaces/spsc_queue.hpp>
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+using boost::stl_interfaces::spsc_queue;
+
+
+using queue_type = spsc_queue<int, 8>;
+
+static_assert(
+    alignof(queue_type) == queue_type::cache_line,
+    "The indices must be on their own cache lines.");
+static_assert(2 * queue_type::cache_line < sizeof(queue_type), "");
+
+
+TEST(spsc, push_pop)
+{
+    queue_type q;
+    EXPECT_TRUE(q.empty());
+    EXPECT_EQ(q.capacity(), 8u);
+
+    int x = 0;
+    EXPECT_FALSE(q.pop(x));
+    for (int i = 0; i < 8; ++i) {
+        EXPECT_TRUE(q.push(i));
+    }
+    EXPECT_FALSE(q.push(8));
+    EXPECT_EQ(q.size(), 8u);
+
+    for (int i = 0; i < 8; ++i) {
+        EXPECT_TRUE(q.pop(x));
+        EXPECT_EQ(x, i);
+    }
+    EXPECT_FALSE(q.pop(x));
+    EXPECT_TRUE(q.empty());
+}
+
+TEST(spsc, spans_wrap)
+{
+    queue_type q;
+    int const in[] = {0, 1, 2, 3, 4, 5};
+    EXPECT_EQ(q.write(in, 6), 6u);
+    int out[8] = {};
+    EXPECT_EQ(q.read(out, 5), 5u);
+    EXPECT_EQ(out[4], 4);
+
+    // Slots 6 and 7 are free up to the end of the slots; 0 through 4 are
+    // free after that.
+    auto s = q.write_span();
+    EXPECT_EQ(s.size(), 2u);
+    s[0] = 6;
+    s[1] = 7;
+    q.commit_write(2);
+    s = q.write_span();
+    EXPECT_EQ(s.size(), 5u);
+    std::iota(s.begin(), s.end(), 8);
+    q.commit_write(3);
+    EXPECT_EQ(q.size(), 6u);
+
+    // The consumer's copy of the producer's index is stale; it only gets
+    // reread when it says there are too few elements ready.
+    auto r = q.read_span();
+    EXPECT_EQ(r.size(), 1u);
+    r = q.read_span(3);
+    EXPECT_EQ(r.size(), 3u);
+    EXPECT_EQ(r.front(), 5);
+    EXPECT_EQ(r.back(), 7);
+    q.commit_read(3);
+    r = q.read_span();
+    EXPECT_EQ(r.size(), 3u);
+    EXPECT_EQ(r.front(), 8);
+    q.commit_read(1);
+
+    // Bulk operations use both spans.
+    int const more[] = {11, 12, 13, 14, 15, 16, 17};
+    EXPECT_EQ(q.write(more, 7), 6u);
+    EXPECT_EQ(q.read(out, 8), 8u);
+    EXPECT_EQ(
+        std::vector<int>(out, out + 8),
+        (std::vector<int>{9, 10, 11, 12, 13, 14, 15, 16}));
+    EXPECT_TRUE(q.empty());
+}
+
+TEST(spsc, non_trivial_elements)
+{
+    spsc_queue<std::string, 4> q;
+    EXPECT_TRUE(q.push(std::string(40, 'a')));
+    EXPECT_TRUE(q.push("b"));
+    std::string s;
+    EXPECT_TRUE(q.pop(s));
+    EXPECT_EQ(s, std::string(40, 'a'));
+
+    spsc_queue<std::unique_ptr<int>, 2> p;
+    EXPECT_TRUE(p.push(std::unique_ptr<int>(new int(3))));
+    std::unique_ptr<int> x;
+    EXPECT_TRUE(p.pop(x));
+    EXPECT_EQ(*x, 3);
+}
+
+TEST(spsc, threads)
+{
+    spsc_queue<int, 64> q;
+    int const count = 200000;
+
+    std::thread producer([&] {
+        std::vector<int> batch(48);
+        int i = 0;
+        while (i < count) {
+            if (i % 3) {
+                // Alternate between bulk writes, spans, and single pushes.
+                auto const n = (std::min)(int(batch.size()), count - i);
+                std::iota(batch.begin(), batch.begin() + n, i);
+                i += int(q.write(batch.data(), n));
+            } else if (i % 2) {
+                auto const s = q.write_span();
+                auto const n = (std::min)(int(s.size()), count - i);
+                std::iota(s.begin(), s.begin() + n, i);
+                q.commit_write(n);
+                i += n;
+            } else if (q.push(i)) {
+                ++i;
+            }
+        }
+    });
+
+    std::vector<int> received;
+    received.reserve(count);
+    std::vector<int> batch(40);
+    while (int(received.size()) < count) {
+        if (received.size() % 2) {
+            auto const n = q.read(batch.data(), batch.size());
+            received.insert(received.end(), batch.begin(), batch.begin() + n);
+        } else {
+            auto const r = q.read_span();
+            received.insert(received.end(), r.begin(), r.end());
+            q.commit_read(r.size());
+        }
+    }
+    producer.join();
+
+    ASSERT_EQ(received.size(), std::size_t(count));
+    for (int i = 0; i < count; ++i) {
+        ASSERT_EQ(received[i], i);
+    }
+    EXPECT_TRUE(q.empty());
+}
@@ -0,0 +1,162 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/static_perfect_map.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+namespace bsi = boost::stl_interfaces;
+
+enum class field { id, name, price, quantity, side };
+
+constexpr bsi::static_perfect_map<char const *, field, 5> fields{
+    {"id", field::id},
+    {"name", field::name},
+    {"price", field::price},
+    {"quantity", field::quantity},
+    {"side", field::side}};
+
+static_assert(fields.size() == 5u, "");
+static_assert(fields.contains("price"), "");
+static_assert(!fields.contains("pric"), "");
+static_assert(!fields.contains("prices"), "");
+static_assert(fields.find("side")->second == field::side, "");
+static_assert(fields.find("size") == fields.end(), "");
+static_assert(fields.get("name", field::id) == field::name, "");
+static_assert(fields.count("quantity") == 1u, "");
+
+// Keys of 8 or more characters are hashed a word at a time.
+constexpr auto long_names = bsi::make_static_perfect_map<char const *, int>(
+    {{"client_order_id", 1},
+     {"client_order_ix", 2},
+     {"leaves_quantity", 3},
+     {"transact_time", 4},
+     {"", 5}});
+static_assert(long_names.get("client_order_ix", 0) == 2, "");
+static_assert(long_names.get("client_order_i", 0) == 0, "");
+static_assert(long_names.get("", 0) == 5, "");
+
+using code_entry = bsi::perfect_map_entry<int, int>;
+
+template<int N>
+struct code_table
+{
+    code_entry entries[N];
+};
+template<int N>
+constexpr code_table<N> make_codes()
+{
+    code_table<N> retval{};
+    for (int i = 0; i < N; ++i) {
+        retval.entries[i] = code_entry{-500 + 7919 * i, i};
+    }
+    return retval;
+}
+constexpr code_table<300> code_entries = make_codes<300>();
+constexpr bsi::static_perfect_map<int, int, 300> codes(code_entries.entries);
+
+static_assert(codes.get(-500, -1) == 0, "");
+static_assert(codes.get(-500 + 7919 * 299, -1) == 299, "");
+static_assert(codes.get(-499, -1) == -1, "");
+static_assert(
+    std::is_trivially_copyable<
+        bsi::static_perfect_map<int, int, 300>>::value,
+    "");
+
+TEST(static_perfect_map, iteration)
+{
+    std::map<std::string, field> const expected = {
+        {"id", field::id},
+        {"name", field::name},
+        {"price", field::price},
+        {"quantity", field::quantity},
+        {"side", field::side}};
+
+    // Each entry once, in slot order.
+    std::map<std::string, field> seen;
+    for (auto const & e : fields) {
+        EXPECT_TRUE(seen.emplace(e.first, e.second).second);
+        auto const i = &e - &*fields.begin();
+        EXPECT_EQ(fields.find(e.first), fields.begin() + i);
+    }
+    EXPECT_EQ(seen, expected);
+
+    EXPECT_EQ(fields.end() - fields.begin(), 5);
+    EXPECT_FALSE(fields.empty());
+    EXPECT_EQ(&fields[2], &*(fields.begin() + 2));
+    EXPECT_EQ(fields.begin()->first, fields.front().first);
+    std::vector<std::string> reversed;
+    for (auto it = fields.rbegin(); it != fields.rend(); ++it) {
+        reversed.push_back(it->first);
+    }
+    std::reverse(reversed.begin(), reversed.end());
+    EXPECT_EQ(reversed.front(), fields.begin()->first);
+}
+
+TEST(static_perfect_map, runtime_keys)
+{
+    // Keys that only exist at runtime still find their entries.
+    std::string const price = "price";
+    EXPECT_EQ(fields.find(price.c_str())->second, field::price);
+    std::string const pric = price.substr(0, 4);
+    EXPECT_EQ(fields.find(pric.c_str()), fields.end());
+}
+
+TEST(static_perfect_map, static_string_keys)
+{
+    using name_t = bsi::static_string<15>;
+    constexpr bsi::static_perfect_map<name_t, int, 3> m{
+        {"bid", 0}, {"ask", 1}, {"last_trade", 2}};
+    EXPECT_EQ(m.get(name_t("ask"), -1), 1);
+    EXPECT_EQ(m.get(name_t("last_trade"), -1), 2);
+    EXPECT_EQ(m.get(name_t("last"), -1), -1);
+}
+
+TEST(static_perfect_map, runtime_build)
+{
+    // Many key sets, each of which must get a perfect hash, built at
+    // runtime.
+    std::mt19937_64 gen(42);
+    for (int t = 0; t < 50; ++t) {
+        bsi::perfect_map_entry<std::uint64_t, int> entries[1000];
+        for (int i = 0; i < 1000; ++i) {
+            entries[i] = {gen(), i};
+        }
+        bsi::static_perfect_map<std::uint64_t, int, 1000> const m(entries);
+        std::vector<bool> seen(1000);
+        for (auto const & e : m) {
+            EXPECT_FALSE(seen[e.second]);
+            seen[e.second] = true;
+        }
+        for (int i = 0; i < 1000; ++i) {
+            EXPECT_EQ(m.get(entries[i].first, -1), i);
+            EXPECT_FALSE(m.contains(entries[i].first + 1));
+        }
+    }
+}
+
+TEST(static_perfect_map, errors)
+{
+    using map_t = bsi::static_perfect_map<int, int, 3>;
+    EXPECT_THROW(map_t({{1, 1}, {2, 2}, {1, 3}}), std::invalid_argument);
+    EXPECT_THROW(map_t({{1, 1}, {2, 2}}), std::invalid_argument);
+    EXPECT_NO_THROW(map_t({{1, 1}, {2, 2}, {3, 3}}));
+
+    // Equal strings at different addresses are duplicates.
+    std::string const a = "key";
+    std::string const b = "key";
+    using name_map_t = bsi::static_perfect_map<char const *, int, 2>;
+    EXPECT_THROW(
+        name_map_t({{a.c_str(), 1}, {b.c_str(), 2}}), std::invalid_argument);
+}
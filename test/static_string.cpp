@@ -0,0 +1,315 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/small_string.hpp>
+#include <boost/stl_interfaces/static_vector.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstring>
+#include <list>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+
+namespace bsi = boost::stl_interfaces;
+
+// Instantiate all the members we can.
+template struct bsi::static_string<22>;
+template struct bsi::static_string<40, 32>;
+template struct bsi::small_string<15>;
+
+static_assert(sizeof(bsi::static_string<22>) == 24, "");
+static_assert(std::is_trivially_copyable<bsi::static_string<22>>::value, "");
+static_assert(
+    std::is_same<bsi::v1_dtl::string_size_t<300>, std::uint16_t>::value, "");
+static_assert(
+    bsi::is_trivially_relocatable<bsi::static_string<22>>::value, "");
+static_assert(
+    !bsi::is_trivially_relocatable<bsi::small_string<15>>::value, "");
+
+using simd_string = bsi::static_string<40, 32>;
+static_assert(alignof(simd_string) == 32, "");
+static_assert(simd_string::capacity() == 40u, "");
+static_assert(simd_string::padded_capacity() == 64u, "");
+static_assert(sizeof(simd_string) == 96, "");
+static_assert(bsi::static_string<22>::padded_capacity() == 23u, "");
+static_assert(std::is_trivially_copyable<simd_string>::value, "");
+
+#ifdef BOOST_STL_INTERFACES_CONSTANT_EVALUATED
+using name_t = bsi::static_string<15>;
+
+constexpr name_t edited_name()
+{
+    name_t retval("order_id");
+    retval.insert(retval.begin() + 5, {'_', '_'});
+    retval.erase(retval.begin());
+    retval += "s";
+    retval.emplace(retval.begin(), 'b');
+    return retval;
+}
+
+constexpr name_t name = "symbol";
+constexpr name_t edited = edited_name();
+static_assert(name.size() == 6u && name[5] == 'l', "");
+static_assert(name == "symbol" && name != "symbols", "");
+static_assert(name.find('b') == 3u && name.find("bol") == 3u, "");
+static_assert(name.find('z') == name_t::npos, "");
+static_assert(name.compare("symbols") < 0 && name < name_t("t"), "");
+static_assert(edited == "brder___ids", "");
+static_assert(edited.c_str()[edited.size()] == '\0', "");
+static_assert(name_t(3, 'x') == name_t("xxx"), "");
+#endif
+
+template<typename String>
+std::string to_string(String const & s)
+{
+    EXPECT_EQ(std::strlen(s.c_str()), s.size());
+    return std::string(s.begin(), s.end());
+}
+
+// The members both types share.
+template<typename String>
+void check_basics()
+{
+    String s;
+    EXPECT_TRUE(s.empty());
+    EXPECT_STREQ(s.c_str(), "");
+
+    s = "tag";
+    EXPECT_EQ(to_string(s), "tag");
+    s += ':';
+    s += "value";
+    EXPECT_EQ(to_string(s), "tag:value");
+    EXPECT_EQ(s.length(), 9u);
+
+    s.insert(s.begin() + 3, '=');
+    EXPECT_EQ(to_string(s), "tag=:value");
+    s.erase(s.begin() + 4);
+    EXPECT_EQ(to_string(s), "tag=value");
+    s.pop_back();
+    EXPECT_EQ(to_string(s), "tag=valu");
+    s.resize(10, 'x');
+    EXPECT_EQ(to_string(s), "tag=valuxx");
+    s.resize(3);
+    EXPECT_EQ(to_string(s), "tag");
+
+    // Inserting a part of the string into itself.
+    s.insert(s.begin(), s.begin() + 1, s.end());
+    EXPECT_EQ(to_string(s), "agtag");
+
+    std::list<char> const chars = {'a', 'b'};
+    String const list_built(chars.begin(), chars.end());
+    EXPECT_EQ(list_built.size(), 2u);
+    EXPECT_EQ(String(3, 'z'), "zzz");
+    EXPECT_EQ(String("abcdef", 3), "abc");
+    EXPECT_NE(String({'a', 'b'}), "abc");
+
+    s.clear();
+    EXPECT_TRUE(s.empty());
+    EXPECT_STREQ(s.c_str(), "");
+}
+
+template<typename String>
+void check_find_compare()
+{
+    String const s = "the quick brown fox jumps";
+    EXPECT_EQ(s.find('q'), 4u);
+    EXPECT_EQ(s.find('o'), 12u);
+    EXPECT_EQ(s.find('o', 13), 17u);
+    EXPECT_EQ(s.find('z'), String::npos);
+    EXPECT_EQ(s.find('t', 100), String::npos);
+
+    EXPECT_EQ(s.find("fox"), 16u);
+    EXPECT_EQ(s.find("fo"), 16u);
+    EXPECT_EQ(s.find("ps"), 23u);
+    EXPECT_EQ(s.find("psx"), String::npos);
+    EXPECT_EQ(s.find("the"), 0u);
+    EXPECT_EQ(s.find("the", 1), String::npos);
+    EXPECT_EQ(s.find(""), 0u);
+    EXPECT_EQ(s.find("", 25), 25u);
+    EXPECT_EQ(s.find("", 26), String::npos);
+    EXPECT_EQ(s.find(String("brown")), 10u);
+
+    // Every answer agrees with std::string.
+    std::string const std_s(s.begin(), s.end());
+    for (char const * needle : {"u", "o", "ox", " j", "jumps", "x", "q b"}) {
+        for (std::size_t pos = 0; pos < 27; ++pos) {
+            EXPECT_EQ(s.find(needle, pos), std_s.find(needle, pos))
+                << needle << " " << pos;
+        }
+    }
+
+    EXPECT_EQ(String("abc").compare("abc"), 0);
+    EXPECT_LT(String("abc").compare("abd"), 0);
+    EXPECT_LT(String("ab").compare("abc"), 0);
+    EXPECT_GT(String("abc").compare("ab"), 0);
+    EXPECT_GT(String("b").compare(String("abc")), 0);
+
+    // Characters are ordered as unsigned, as std::string orders them.
+    String const high = "\xe9";
+    EXPECT_GT(high.compare("a"), 0);
+    EXPECT_LT(String("a"), high);
+    EXPECT_GT(high, String("a"));
+    EXPECT_LE(String("a"), String("a"));
+
+    EXPECT_EQ(String("abc"), String("abc"));
+    EXPECT_TRUE("abc" == String("abc"));
+    EXPECT_TRUE(String("abc") != "abd");
+
+    std::vector<String> v = {"pear", "apple", "fig"};
+    std::sort(v.begin(), v.end());
+    EXPECT_EQ(v, (std::vector<String>{"apple", "fig", "pear"}));
+
+    std::unordered_set<String> set = {"a", "b"};
+    EXPECT_EQ(set.count("a"), 1u);
+    EXPECT_EQ(set.count("c"), 0u);
+}
+
+
+TEST(static_string, basics)
+{
+    check_basics<bsi::static_string<22>>();
+
+    bsi::static_string<4> s = "abcd";
+    EXPECT_EQ(s.size(), s.capacity());
+    EXPECT_STREQ(s.c_str(), "abcd");
+
+    bsi::static_string<4> other = "x";
+    s.swap(other);
+    EXPECT_EQ(s, "x");
+    EXPECT_EQ(other, "abcd");
+}
+
+TEST(static_string, find_compare)
+{
+    check_find_compare<bsi::static_string<40>>();
+}
+
+TEST(small_string, basics)
+{
+    check_basics<bsi::small_string<4>>();
+    check_basics<bsi::small_string<15>>();
+}
+
+TEST(small_string, find_compare)
+{
+    check_find_compare<bsi::small_string<8>>();
+    check_find_compare<bsi::small_string<32>>();
+}
+
+TEST(small_string, spill)
+{
+    bsi::small_string<8> s = "12345678";
+    EXPECT_TRUE(s.is_inline());
+    s += '9';
+    EXPECT_FALSE(s.is_inline());
+    EXPECT_EQ(s, "123456789");
+    EXPECT_GE(s.capacity(), 16u);
+
+    // Appending the string to itself, across the spill.
+    s.append(s.c_str(), s.size());
+    EXPECT_EQ(s, "123456789123456789");
+    bsi::small_string<8> t = "abcdef";
+    t.insert(t.begin() + 1, t.begin(), t.end());
+    EXPECT_EQ(t, "aabcdefbcdef");
+
+    s.resize(4);
+    s.shrink_to_fit();
+    EXPECT_TRUE(s.is_inline());
+    EXPECT_EQ(s, "1234");
+
+    bsi::small_string<8> heap = "a long string on the heap";
+    bsi::small_string<8> copy = heap;
+    EXPECT_EQ(copy, heap);
+    EXPECT_NE(copy.c_str(), heap.c_str());
+    bsi::small_string<8> moved = std::move(heap);
+    EXPECT_EQ(moved, "a long string on the heap");
+    EXPECT_TRUE(heap.empty());
+    EXPECT_TRUE(heap.is_inline());
+
+    bsi::small_string<8> small = "tiny";
+    small.swap(moved);
+    EXPECT_EQ(small, "a long string on the heap");
+    EXPECT_EQ(moved, "tiny");
+    EXPECT_TRUE(moved.is_inline());
+
+    moved = small;
+    EXPECT_EQ(moved, small);
+    small = std::move(moved);
+    EXPECT_EQ(small, "a long string on the heap");
+}
+
+TEST(static_string, heterogeneous_comparisons)
+{
+    bsi::static_string<16> const s = "symbol";
+    bsi::static_string<8> const shorter = "symbol";
+    bsi::small_string<2> const small = "symbols";
+    std::string const str = "symbol";
+
+    EXPECT_TRUE(s == shorter);
+    EXPECT_TRUE(shorter == s);
+    EXPECT_TRUE(s == str);
+    EXPECT_TRUE(str == s);
+    EXPECT_TRUE(s != small);
+    EXPECT_TRUE(s < small);
+    EXPECT_TRUE(small > str);
+    EXPECT_TRUE(str <= shorter);
+
+    bsi::static_string<4> const high = "\xc3";
+    EXPECT_TRUE(s < high);
+    EXPECT_TRUE(str < high);
+}
+
+#if 201703L <= __cplusplus && defined(__cpp_lib_string_view)
+TEST(static_string, string_view)
+{
+    bsi::static_string<16> const s = "symbol";
+    std::string_view const sv = s;
+    EXPECT_EQ(sv, "symbol");
+    bsi::small_string<2> const t = "symbol";
+    EXPECT_EQ(std::string_view(t), sv);
+
+    EXPECT_TRUE(s == sv);
+    EXPECT_TRUE(sv == t);
+    EXPECT_TRUE(sv < bsi::static_string<8>("z"));
+    bsi::static_vector<char, 32> const chars(sv.begin(), sv.end());
+    EXPECT_TRUE(chars == sv);
+    EXPECT_TRUE(sv == chars);
+    EXPECT_FALSE(chars < sv);
+}
+#endif
+
+TEST(static_string, aligned)
+{
+    simd_string s("ticker:");
+    s.append("ABCD", 4);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(s.data()) % 32, 0u);
+    EXPECT_EQ(to_string(s), "ticker:ABCD");
+    EXPECT_EQ(s.c_str()[s.size()], '\0');
+
+    // A scan of whole 32-byte blocks, to padded_capacity(), stops at the
+    // null.
+    std::size_t n = 0;
+    for (std::size_t i = 0; i < simd_string::padded_capacity(); i += 32) {
+        char const * const block = s.data() + i;
+        auto const null = std::find(block, block + 32, '\0');
+        n += std::size_t(null - block);
+        if (null != block + 32)
+            break;
+    }
+    EXPECT_EQ(n, s.size());
+
+    // Strings of different alignments compare as any two contiguous
+    // ranges of chars do.
+    bsi::static_string<40> const unaligned("ticker:ABCD");
+    EXPECT_TRUE(s == unaligned);
+    EXPECT_FALSE(s < unaligned);
+    simd_string const copy = s;
+    EXPECT_EQ(copy, s);
+    EXPECT_EQ(std::hash<simd_string>{}(copy), std::hash<simd_string>{}(s));
+}
@@ -10,6 +10,13 @@
 #include <gtest/gtest.h>
 
 #include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <iterator>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
 
 // Instantiate all the members we can.
 template struct static_vector<int, 1024>;
@@ -120,6 +127,53 @@ TEST(static_vec, other_ctors_assign)
     }
 }
 
+TEST(static_vec, bulk_assign)
+{
+    // int is trivially copyable and the sources below are pointers, so these
+    // take container_interface's memmove() path.
+    std::array<int, 6> const a = {{1, 2, 3, 4, 5, 6}};
+
+    {
+        vec_type v = {9, 9};
+        v.assign(a.begin(), a.end());
+        EXPECT_EQ(v, vec_type(a.begin(), a.end()));
+    }
+    {
+        vec_type v = {9, 9, 9, 9, 9, 9, 9, 9};
+        v.assign(a.begin(), a.end());
+        EXPECT_EQ(v.size(), 6u);
+        EXPECT_EQ(v, vec_type(a.begin(), a.end()));
+    }
+    {
+        vec_type v = {9, 9, 9, 9, 9, 9};
+        v.assign(a.begin() + 1, a.begin() + 4);
+        EXPECT_EQ(v, vec_type({2, 3, 4}));
+    }
+    {
+        vec_type v = {9, 9, 9};
+        v.assign(a.begin(), a.begin());
+        EXPECT_TRUE(v.empty());
+    }
+    {
+        vec_type v;
+        v.assign(a.begin(), a.begin() + 3);
+        EXPECT_EQ(v, vec_type({1, 2, 3}));
+    }
+
+    // Elements that are not trivially copyable take the element-wise path.
+    {
+        std::array<std::string, 3> const strs = {{"a", "b", "c"}};
+        static_vector<std::string, 10> v = {"x"};
+        v.assign(strs.begin(), strs.end());
+        EXPECT_EQ(v.size(), 3u);
+        EXPECT_EQ(v[0], "a");
+        EXPECT_EQ(v[2], "c");
+        v.assign(strs.begin(), strs.begin() + 1);
+        EXPECT_EQ(v.size(), 1u);
+        EXPECT_EQ(v[0], "a");
+    }
+}
+
 TEST(static_vec, resize)
 {
     {
@@ -145,6 +199,45 @@ TEST(static_vec, resize)
     }
 }
 
+struct default_init_counter
+{
+    default_init_counter() { ++count; }
+    default_init_counter(int) {}
+    static int count;
+};
+
+int default_init_counter::count = 0;
+
+TEST(static_vec, resize_for_overwrite)
+{
+    {
+        vec_type v = {1, 2};
+
+        static_assert(
+            std::is_same<decltype(v.resize_for_overwrite(1)), void>::value,
+            "");
+
+        v.resize_for_overwrite(5);
+        EXPECT_EQ(v.size(), 5u);
+        EXPECT_EQ(v[0], 1);
+        EXPECT_EQ(v[1], 2);
+
+        std::fill(v.begin() + 2, v.end(), 7);
+        EXPECT_EQ(v, vec_type({1, 2, 7, 7, 7}));
+
+        v.resize_for_overwrite(1);
+        EXPECT_EQ(v, vec_type({1}));
+    }
+
+    {
+        // Class types still get their default constructors called.
+        static_vector<default_init_counter, 10> v;
+        default_init_counter::count = 0;
+        v.resize_for_overwrite(4);
+        EXPECT_EQ(default_init_counter::count, 4);
+    }
+}
+
 TEST(static_vec, assignment_copy_move_equality)
 {
     {
@@ -257,6 +350,72 @@ TEST(static_vec, comparisons)
     EXPECT_TRUE(lg >= lg);
 }
 
+TEST(static_vec, bytewise_comparisons)
+{
+    // Elements that are compared with memcmp(), with differences in the
+    // first cache line, in a later one, and in the tail.
+    for (int pos : {0, 5, 63, 64, 100, 150, 199}) {
+        for (int delta : {-1, 1}) {
+            std::vector<std::uint8_t> a(200, 7);
+            std::vector<std::uint8_t> b = a;
+            b[pos] = std::uint8_t(b[pos] + delta * 200);
+            static_vector<std::uint8_t, 200> va(a.begin(), a.end());
+            static_vector<std::uint8_t, 200> vb(b.begin(), b.end());
+            EXPECT_FALSE(va == vb);
+            EXPECT_EQ(va < vb, a < b) << pos;
+            EXPECT_EQ(vb < va, b < a) << pos;
+
+            std::vector<int> c(200, -3);
+            std::vector<int> d = c;
+            d[pos] += delta * 100000;
+            static_vector<int, 200> vc(c.begin(), c.end());
+            static_vector<int, 200> vd(d.begin(), d.end());
+            EXPECT_FALSE(vc == vd);
+            EXPECT_EQ(vc < vd, c < d) << pos;
+            EXPECT_EQ(vd < vc, d < c) << pos;
+
+            std::vector<signed char> e(200, 1);
+            std::vector<signed char> f = e;
+            f[pos] = static_cast<signed char>(-delta * 100);
+            static_vector<signed char, 200> ve(e.begin(), e.end());
+            static_vector<signed char, 200> vf(f.begin(), f.end());
+            EXPECT_EQ(ve < vf, e < f) << pos;
+            EXPECT_EQ(vf < ve, f < e) << pos;
+        }
+    }
+
+    static_vector<std::uint8_t, 200> const empty;
+    static_vector<std::uint8_t, 200> const prefix = {1, 2};
+    static_vector<std::uint8_t, 200> const whole = {1, 2, 3};
+    EXPECT_TRUE(empty == empty);
+    EXPECT_TRUE(empty < prefix);
+    EXPECT_TRUE(prefix < whole);
+    EXPECT_FALSE(whole < prefix);
+    EXPECT_TRUE(whole == whole);
+}
+
+// An enum with comparisons of its own, which must not be bypassed by
+// memcmp(): every value is equal to every other, and the order is the
+// reverse of the enumerators'.
+enum class odd_enum { a, b, c };
+bool operator==(odd_enum, odd_enum) { return true; }
+bool operator!=(odd_enum, odd_enum) { return false; }
+bool operator<(odd_enum x, odd_enum y) { return int(y) < int(x); }
+
+TEST(static_vec, enum_comparisons)
+{
+    static_vector<odd_enum, 4> const a = {odd_enum::a};
+    static_vector<odd_enum, 4> const b = {odd_enum::b};
+    static_vector<odd_enum, 4> const ab = {odd_enum::a, odd_enum::b};
+    EXPECT_TRUE(a == b);
+    EXPECT_FALSE(a != b);
+    EXPECT_TRUE(b < a);
+    EXPECT_FALSE(a < b);
+    EXPECT_TRUE(a < ab);
+    EXPECT_TRUE(b < ab);
+    EXPECT_TRUE(ab > b);
+}
+
 TEST(static_vec, swap)
 {
     {
@@ -333,6 +492,94 @@ static_assert(
         value,
     "");
 
+// The observers container_interface provides are noexcept whenever the
+// operations they are built from are.
+static_assert(noexcept(std::declval<vec_type &>().empty()), "");
+static_assert(noexcept(std::declval<vec_type const &>().empty()), "");
+static_assert(noexcept(std::declval<vec_type &>().size()), "");
+static_assert(noexcept(std::declval<vec_type const &>().size()), "");
+static_assert(noexcept(std::declval<vec_type &>().data()), "");
+static_assert(noexcept(std::declval<vec_type const &>().data()), "");
+static_assert(noexcept(std::declval<vec_type &>().front()), "");
+static_assert(noexcept(std::declval<vec_type const &>().front()), "");
+static_assert(noexcept(std::declval<vec_type &>()[0]), "");
+static_assert(noexcept(std::declval<vec_type const &>()[0]), "");
+static_assert(noexcept(std::declval<vec_type const &>().begin()), "");
+static_assert(noexcept(std::declval<vec_type const &>().cend()), "");
+
+static_assert(
+    std::is_same<decltype(std::declval<vec_type &>().front()), int &>::value,
+    "");
+static_assert(
+    std::is_same<
+        decltype(std::declval<vec_type const &>().back()),
+        int const &>::value,
+    "");
+static_assert(
+    std::is_same<decltype(std::declval<vec_type &>()[0]), int &>::value, "");
+static_assert(
+    std::is_same<
+        decltype(std::declval<vec_type const &>().data()),
+        int const *>::value,
+    "");
+static_assert(
+    std::is_same<
+        decltype(std::declval<vec_type const &>().size()),
+        vec_type::size_type>::value,
+    "");
+
+static_assert(
+    boost::stl_interfaces::is_trivially_relocatable<vec_type>::value, "");
+static_assert(
+    !boost::stl_interfaces::is_trivially_relocatable<
+        static_vector<std::string, 10>>::value,
+    "");
+
+// A trivially relocatable type whose elements are not stored inline.
+struct heap_ints
+{
+    heap_ints(int x) : size_(1), ptr_(new int[1]{x}) {}
+
+    std::size_t size_;
+    std::unique_ptr<int[]> ptr_;
+};
+
+namespace boost { namespace stl_interfaces {
+    template<>
+    struct is_trivially_relocatable<heap_ints> : std::true_type
+    {};
+}}
+
+TEST(static_vec, relocating_swap)
+{
+    {
+        vec_type v1 = {1, 2, 3, 4, 5, 6, 7};
+        vec_type v2 = {8};
+        swap(v1, v2);
+        EXPECT_EQ(v1, vec_type({8}));
+        EXPECT_EQ(v2, vec_type({1, 2, 3, 4, 5, 6, 7}));
+
+        boost::stl_interfaces::relocating_swap(v1, v2);
+        EXPECT_EQ(v1, vec_type({1, 2, 3, 4, 5, 6, 7}));
+        EXPECT_EQ(v2, vec_type({8}));
+
+        vec_type v3;
+        v3.swap(v1);
+        EXPECT_TRUE(v1.empty());
+        EXPECT_EQ(v3, vec_type({1, 2, 3, 4, 5, 6, 7}));
+    }
+
+    {
+        heap_ints h1(1);
+        heap_ints h2(2);
+        int * const p1 = h1.ptr_.get();
+        boost::stl_interfaces::relocating_swap(h1, h2);
+        EXPECT_EQ(h1.ptr_[0], 2);
+        EXPECT_EQ(h2.ptr_[0], 1);
+        EXPECT_EQ(h2.ptr_.get(), p1);
+    }
+}
+
 TEST(static_vec, iterators)
 {
     {
@@ -571,6 +818,139 @@ TEST(static_vec, emplace_insert)
     }
 }
 
+// Not default-constructible, not trivially relocatable, and able to throw
+// from its copy constructor on request.  Tracks the number of live objects.
+struct tracked
+{
+    explicit tracked(int x) : x_(x) { ++live; }
+    tracked(tracked const & other) : x_(other.x_)
+    {
+        if (copies_until_throw && !--copies_until_throw)
+            throw std::runtime_error("copy");
+        ++live;
+    }
+    tracked(tracked && other) noexcept : x_(other.x_) { ++live; }
+    tracked & operator=(tracked const & other)
+    {
+        x_ = other.x_;
+        return *this;
+    }
+    tracked & operator=(tracked && other) noexcept
+    {
+        x_ = other.x_;
+        return *this;
+    }
+    ~tracked() { --live; }
+
+    friend bool operator==(tracked lhs, tracked rhs)
+    {
+        return lhs.x_ == rhs.x_;
+    }
+    friend bool operator<(tracked lhs, tracked rhs) { return lhs.x_ < rhs.x_; }
+
+    int x_;
+
+    static int live;
+    static int copies_until_throw;
+};
+
+int tracked::live = 0;
+int tracked::copies_until_throw = 0;
+
+TEST(static_vec, gap_insert)
+{
+    using tracked_vec = static_vector<tracked, 10>;
+
+    auto make = [](std::initializer_list<int> il) {
+        tracked_vec retval;
+        for (int x : il) {
+            retval.emplace_back(x);
+        }
+        return retval;
+    };
+    std::array<tracked, 3> const more = {{tracked(7), tracked(8), tracked(9)}};
+
+    {
+        // Fewer insertions than elements after pos.
+        tracked_vec v = make({1, 2, 3, 4, 5});
+        v.insert(v.begin() + 1, more.begin(), more.end());
+        EXPECT_EQ(v, make({1, 7, 8, 9, 2, 3, 4, 5}));
+    }
+    {
+        // More insertions than elements after pos.
+        tracked_vec v = make({1, 2, 3});
+        v.insert(v.begin() + 2, more.begin(), more.end());
+        EXPECT_EQ(v, make({1, 2, 7, 8, 9, 3}));
+    }
+    {
+        // Insertion at the end.
+        tracked_vec v = make({1});
+        v.insert(v.end(), more.begin(), more.end());
+        EXPECT_EQ(v, make({1, 7, 8, 9}));
+    }
+    {
+        // Filling to capacity.
+        tracked_vec v = make({1, 2, 3, 4, 5, 6, 10});
+        v.insert(v.begin() + 6, more.begin(), more.end());
+        EXPECT_EQ(v, make({1, 2, 3, 4, 5, 6, 7, 8, 9, 10}));
+    }
+    EXPECT_EQ(tracked::live, 3);
+
+    {
+        // A throwing copy leaves no stray elements behind.
+        {
+            tracked_vec v = make({1, 2, 3});
+            tracked::copies_until_throw = 2;
+            EXPECT_THROW(
+                v.insert(v.begin() + 2, more.begin(), more.end()),
+                std::runtime_error);
+            tracked::copies_until_throw = 0;
+            EXPECT_EQ(v.size(), 3u);
+            EXPECT_EQ(tracked::live, 3 + 3);
+        }
+        EXPECT_EQ(tracked::live, 3);
+    }
+}
+
+TEST(static_vec, move_and_clear)
+{
+    using tracked_vec = static_vector<tracked, 10>;
+    {
+        tracked_vec v;
+        for (int i = 0; i < 6; ++i) {
+            v.emplace_back(i);
+        }
+        EXPECT_EQ(tracked::live, 6);
+
+        // Moving constructs the new elements in one pass and destroys the
+        // old ones, leaving the source empty.
+        tracked_vec v2(std::move(v));
+        EXPECT_TRUE(v.empty());
+        EXPECT_EQ(v2.size(), 6u);
+        EXPECT_EQ(v2[5].x_, 5);
+        EXPECT_EQ(tracked::live, 6);
+
+        tracked_vec v3;
+        v3.emplace_back(42);
+        v3 = std::move(v2);
+        EXPECT_TRUE(v2.empty());
+        EXPECT_EQ(v3.size(), 6u);
+        EXPECT_EQ(v3.front().x_, 0);
+        EXPECT_EQ(tracked::live, 6);
+
+        // clear() is destroy_all().
+        v3.clear();
+        EXPECT_TRUE(v3.empty());
+        EXPECT_EQ(tracked::live, 0);
+
+        v3.emplace_back(1);
+        v3.destroy_all();
+        EXPECT_TRUE(v3.empty());
+        EXPECT_EQ(tracked::live, 0);
+    }
+    EXPECT_EQ(tracked::live, 0);
+}
+
 TEST(static_vec, erase)
 {
     {
@@ -632,6 +1012,73 @@ TEST(static_vec, erase)
     }
 }
 
+// An input-only range over an istream, which static_vector's range insert
+// does not accept.
+struct int_reader
+{
+    std::istream_iterator<int> begin() const
+    {
+        return std::istream_iterator<int>(*in_);
+    }
+    std::istream_iterator<int> end() const
+    {
+        return std::istream_iterator<int>();
+    }
+
+    std::istream * in_;
+};
+
+TEST(static_vec, append_insert_range)
+{
+    {
+        vec_type v = {1, 2};
+        std::vector<int> const more = {3, 4, 5};
+        static_assert(
+            std::is_same<decltype(v.append_range(more)), void>::value, "");
+        v.append_range(more);
+        EXPECT_EQ(v, vec_type({1, 2, 3, 4, 5}));
+
+        int const array[] = {6, 7};
+        v.append_range(array);
+        EXPECT_EQ(v, vec_type({1, 2, 3, 4, 5, 6, 7}));
+
+        v.append_range(std::vector<int>());
+        EXPECT_EQ(v.size(), 7u);
+    }
+
+    {
+        vec_type v = {1};
+        std::istringstream is("2 3 4");
+        v.append_range(int_reader{&is});
+        EXPECT_EQ(v, vec_type({1, 2, 3, 4}));
+    }
+
+    {
+        vec_type v = {1, 5};
+        std::vector<int> const more = {2, 3, 4};
+        static_assert(
+            std::is_same<
+                decltype(v.insert_range(v.begin(), more)),
+                vec_type::iterator>::value,
+            "");
+        auto const it = v.insert_range(v.begin() + 1, more);
+        EXPECT_EQ(it, v.begin() + 1);
+        EXPECT_EQ(v, vec_type({1, 2, 3, 4, 5}));
+
+        v.insert_range(v.end(), std::vector<int>{6});
+        EXPECT_EQ(v, vec_type({1, 2, 3, 4, 5, 6}));
+    }
+
+    {
+        vec_type v;
+        int const x = 1;
+        v.unchecked_push_back(x);
+        v.unchecked_push_back(2);
+        EXPECT_EQ(v.unchecked_emplace_back(3), 3);
+        EXPECT_EQ(v, vec_type({1, 2, 3}));
+    }
+}
+
 template<
     typename Container,
     typename ValueType = typename Container::value_type>
@@ -734,3 +1181,266 @@ TEST(static_vec, data_index_at)
         static_assert(std::is_same<decltype(v.at(0)), int const &>::value, "");
     }
 }
+
+// A type with non-trivial special members that is nevertheless trivially
+// relocatable, so that static_vector should never call its move constructor.
+struct relocatable_handle
+{
+    relocatable_handle() : relocatable_handle(0) {}
+    relocatable_handle(int x) : p_(new int(x)) {}
+    relocatable_handle(relocatable_handle const & other) :
+        p_(new int(*other.p_))
+    {}
+    relocatable_handle(relocatable_handle && other) : p_(other.p_)
+    {
+        other.p_ = nullptr;
+        ++moves;
+    }
+    relocatable_handle & operator=(relocatable_handle const & other)
+    {
+        *p_ = *other.p_;
+        return *this;
+    }
+    relocatable_handle & operator=(relocatable_handle && other)
+    {
+        std::swap(p_, other.p_);
+        ++moves;
+        return *this;
+    }
+    ~relocatable_handle() { delete p_; }
+
+    int value() const { return *p_; }
+
+    static int moves;
+
+private:
+    int * p_;
+};
+
+int relocatable_handle::moves = 0;
+
+namespace boost { namespace stl_interfaces {
+    template<>
+    struct is_trivially_relocatable<relocatable_handle> : std::true_type
+    {};
+}}
+
+static_assert(
+    boost::stl_interfaces::is_trivially_relocatable<int>::value, "");
+static_assert(
+    boost::stl_interfaces::is_trivially_relocatable<
+        std::unique_ptr<int>>::value,
+    "");
+static_assert(
+    boost::stl_interfaces::is_trivially_relocatable<
+        relocatable_handle>::value,
+    "");
+static_assert(
+    !boost::stl_interfaces::is_trivially_relocatable<std::string>::value, "");
+
+template<typename Vec>
+std::vector<int> handle_values(Vec const & v)
+{
+    std::vector<int> retval;
+    for (auto const & x : v) {
+        retval.push_back(x.value());
+    }
+    return retval;
+}
+
+TEST(static_vec, trivially_relocatable)
+{
+    using handle_vec = static_vector<relocatable_handle, 10>;
+
+    relocatable_handle::moves = 0;
+    handle_vec v;
+    v.emplace_back(1);
+    v.emplace_back(3);
+    v.emplace(v.begin() + 1, 2);
+    v.emplace(v.begin(), 0);
+    EXPECT_EQ(handle_values(v), (std::vector<int>{0, 1, 2, 3}));
+
+    std::array<relocatable_handle, 2> const more = {{8, 9}};
+    v.insert(v.begin() + 2, more.begin(), more.end());
+    EXPECT_EQ(handle_values(v), (std::vector<int>{0, 1, 8, 9, 2, 3}));
+
+    v.erase(v.begin() + 1, v.begin() + 3);
+    EXPECT_EQ(handle_values(v), (std::vector<int>{0, 9, 2, 3}));
+
+    handle_vec v2(std::move(v));
+    EXPECT_TRUE(v.empty());
+    EXPECT_EQ(handle_values(v2), (std::vector<int>{0, 9, 2, 3}));
+
+    v.emplace_back(7);
+    v = std::move(v2);
+    EXPECT_TRUE(v2.empty());
+    EXPECT_EQ(handle_values(v), (std::vector<int>{0, 9, 2, 3}));
+
+    v2.emplace_back(5);
+    v.swap(v2);
+    EXPECT_EQ(handle_values(v), (std::vector<int>{5}));
+    EXPECT_EQ(handle_values(v2), (std::vector<int>{0, 9, 2, 3}));
+
+    EXPECT_EQ(relocatable_handle::moves, 0);
+
+    {
+        // An element of the container as the emplaced value.
+        handle_vec v3 = {1, 2, 3};
+        v3.emplace(v3.begin(), v3.back());
+        EXPECT_EQ(handle_values(v3), (std::vector<int>{3, 1, 2, 3}));
+    }
+}
+
+TEST(static_vec, unique_ptr_elements)
+{
+    using ptr_vec = static_vector<std::unique_ptr<int>, 10>;
+
+    ptr_vec v;
+    v.emplace_back(new int(1));
+    v.emplace_back(new int(3));
+    v.emplace(v.begin() + 1, new int(2));
+    v.erase(v.begin());
+    ASSERT_EQ(v.size(), 2u);
+    EXPECT_EQ(*v[0], 2);
+    EXPECT_EQ(*v[1], 3);
+
+    ptr_vec v2(std::move(v));
+    EXPECT_TRUE(v.empty());
+    ASSERT_EQ(v2.size(), 2u);
+    EXPECT_EQ(*v2[0], 2);
+}
+
+TEST(static_vec, non_relocatable_elements)
+{
+    using string_vec = static_vector<std::string, 10>;
+
+    string_vec v = {"a", "c"};
+    v.emplace(v.begin() + 1, "b");
+    std::array<std::string, 2> const more = {{"x", "y"}};
+    v.insert(v.begin(), more.begin(), more.end());
+    EXPECT_EQ(v, (string_vec{"x", "y", "a", "b", "c"}));
+    v.erase(v.begin(), v.begin() + 2);
+    EXPECT_EQ(v, (string_vec{"a", "b", "c"}));
+
+    string_vec v2 = {"z"};
+    v.swap(v2);
+    EXPECT_EQ(v, (string_vec{"z"}));
+    EXPECT_EQ(v2, (string_vec{"a", "b", "c"}));
+
+    string_vec v3(std::move(v2));
+    EXPECT_TRUE(v2.empty());
+    EXPECT_EQ(v3, (string_vec{"a", "b", "c"}));
+}
+
+TEST(static_vec, erase_if)
+{
+    {
+        vec_type v = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+        int calls = 0;
+        auto const n = v.erase_if([&calls](int x) {
+            ++calls;
+            return x % 3 == 0;
+        });
+        EXPECT_EQ(n, 4u);
+        EXPECT_EQ(calls, 10);
+        EXPECT_EQ(v, vec_type({1, 2, 4, 5, 7, 8}));
+
+        auto const none = [](int) { return false; };
+        EXPECT_EQ(v.erase_if(none), 0u);
+        EXPECT_EQ(v.size(), 6u);
+        auto const all = [](int) { return true; };
+        EXPECT_EQ(v.erase_if(all), 6u);
+        EXPECT_TRUE(v.empty());
+    }
+    {
+        static_vector<std::string, 8> v = {"a", "bb", "c", "dd", "ee", "f"};
+        auto const n =
+            v.erase_if([](std::string const & s) { return s.size() == 2; });
+        EXPECT_EQ(n, 3u);
+        EXPECT_EQ(v, (static_vector<std::string, 8>{"a", "c", "f"}));
+    }
+}
+
+TEST(static_vec, erase_indices)
+{
+    {
+        vec_type v = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+        std::vector<int> const none;
+        EXPECT_EQ(v.erase_indices(none), 0u);
+        EXPECT_EQ(v.size(), 10u);
+
+        std::size_t const indices[] = {0, 3, 4, 9};
+        EXPECT_EQ(v.erase_indices(indices), 4u);
+        EXPECT_EQ(v, vec_type({1, 2, 5, 6, 7, 8}));
+    }
+    {
+        static_vector<std::unique_ptr<int>, 8> v;
+        for (int i = 0; i < 6; ++i) {
+            v.push_back(std::make_unique<int>(i));
+        }
+        EXPECT_EQ(v.erase_indices(std::vector<int>{1, 2, 5}), 3u);
+        ASSERT_EQ(v.size(), 3u);
+        EXPECT_EQ(*v[0], 0);
+        EXPECT_EQ(*v[1], 3);
+        EXPECT_EQ(*v[2], 4);
+    }
+}
+
+TEST(static_vec, insert_sorted)
+{
+    vec_type v = {1, 4, 4, 8};
+    int const sorted[] = {0, 4, 5, 9};
+    v.insert_sorted(std::begin(sorted), std::end(sorted));
+    EXPECT_EQ(v, vec_type({0, 1, 4, 4, 4, 5, 8, 9}));
+
+    vec_type descending = {9, 5, 1};
+    std::vector<int> const more = {6, 2};
+    descending.insert_sorted(more.begin(), more.end(), std::greater<int>());
+    EXPECT_EQ(descending, vec_type({9, 6, 5, 2, 1}));
+
+    vec_type empty;
+    empty.insert_sorted(more.rbegin(), more.rend());
+    EXPECT_EQ(empty, vec_type({2, 6}));
+}
+
+TEST(static_vec, backward_scans)
+{
+    static_vector<int, 100> v;
+    for (int i = 0; i < 100; ++i) {
+        v.push_back(i % 10);
+    }
+    EXPECT_EQ(v.find_last(3) - v.begin(), 93);
+    EXPECT_EQ(v.find_last(0) - v.begin(), 90);
+    EXPECT_EQ(v.find_last(10), v.end());
+    EXPECT_EQ(v.find_last(std::int64_t(1) << 40), v.end());
+    EXPECT_EQ(v.find_last(3.0) - v.begin(), 93);
+    EXPECT_EQ(v.find_last(3.5), v.end());
+
+    auto const & cv = v;
+    EXPECT_EQ(cv.find_last(9) - cv.begin(), 99);
+    auto const less_than_2 = [](int x) { return x < 2; };
+    auto const negative = [](int x) { return x < 0; };
+    EXPECT_EQ(cv.rfind_if(less_than_2) - cv.begin(), 91);
+    EXPECT_EQ(v.rfind_if(negative), v.end());
+
+    std::array<int, 100> reversed;
+    EXPECT_EQ(v.copy_reversed_to(reversed.begin()), reversed.end());
+    EXPECT_TRUE(std::equal(v.rbegin(), v.rend(), reversed.begin()));
+
+    std::vector<int> pushed;
+    v.copy_reversed_to(std::back_inserter(pushed));
+    EXPECT_TRUE(
+        std::equal(v.rbegin(), v.rend(), pushed.begin(), pushed.end()));
+
+    static_vector<int, 4> empty;
+    EXPECT_EQ(empty.find_last(0), empty.end());
+    EXPECT_EQ(empty.rfind_if(less_than_2), empty.end());
+    EXPECT_EQ(empty.copy_reversed_to(reversed.begin()), reversed.begin());
+
+    static_vector<std::string, 4> strings = {"a", "b", "a", "c"};
+    EXPECT_EQ(strings.find_last("a") - strings.begin(), 2);
+    std::string out[4];
+    strings.copy_reversed_to(out);
+    EXPECT_EQ(out[0], "c");
+    EXPECT_EQ(out[3], "a");
+}
@@ -0,0 +1,107 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/strided_view.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+
+namespace bsi = boost::stl_interfaces;
+
+static_assert(
+    std::is_same<
+        std::iterator_traits<bsi::strided_iterator<int *>>::iterator_category,
+        std::random_access_iterator_tag>::value,
+    "");
+static_assert(
+    std::is_same<
+        std::iterator_traits<
+            bsi::strided_iterator<int const *, 4>>::value_type,
+        int>::value,
+    "");
+
+// A compile-time stride is not stored.
+static_assert(
+    sizeof(bsi::strided_iterator<int *, 4>) == 2 * sizeof(void *), "");
+static_assert(sizeof(bsi::strided_iterator<int *>) == 3 * sizeof(void *), "");
+
+// A 3x4 row-major matrix.
+std::vector<int> matrix()
+{
+    std::vector<int> retval(12);
+    std::iota(retval.begin(), retval.end(), 0);
+    return retval;
+}
+
+
+TEST(strided_view, column)
+{
+    std::vector<int> m = matrix();
+    auto const col = bsi::make_strided_view(m.data() + 1, 3, 4);
+    EXPECT_EQ(
+        std::vector<int>(col.begin(), col.end()), (std::vector<int>{1, 5, 9}));
+    EXPECT_EQ(col.size(), 3);
+    EXPECT_EQ(col[2], 9);
+    EXPECT_EQ(col.back(), 9);
+
+    auto it = col.begin();
+    EXPECT_EQ(it.stride(), 4);
+    ++it;
+    EXPECT_EQ(it.base(), m.data() + 5);
+    EXPECT_EQ(*it, 5);
+    EXPECT_EQ(it - col.begin(), 1);
+    EXPECT_TRUE(col.begin() < it);
+    EXPECT_EQ(*--it, 1);
+
+    // Writes go through to the matrix.
+    std::fill(col.begin(), col.end(), -1);
+    EXPECT_EQ(m[1], -1);
+    EXPECT_EQ(m[5], -1);
+    EXPECT_EQ(m[9], -1);
+    EXPECT_EQ(m[2], 2);
+}
+
+TEST(strided_view, compile_time_stride)
+{
+    std::vector<int> m = matrix();
+    auto const col = bsi::make_strided_view<4>(m.data() + 3, 3);
+    EXPECT_EQ(
+        std::vector<int>(col.begin(), col.end()),
+        (std::vector<int>{3, 7, 11}));
+    EXPECT_EQ(col.begin().stride(), 4);
+    EXPECT_EQ(std::accumulate(col.begin(), col.end(), 0), 21);
+}
+
+TEST(strided_view, copy)
+{
+    // Interleaved stereo samples.
+    std::vector<float> samples = {0, 10, 1, 11, 2, 12, 3, 13};
+    std::vector<float> left(4);
+    std::vector<float> right(4);
+
+    auto const l = bsi::make_strided_view<2>(samples.data(), 4);
+    auto const r = bsi::make_strided_view<2>(samples.data() + 1, 4);
+    using std::copy;
+    EXPECT_EQ(copy(l.begin(), l.end(), left.data()), left.data() + 4);
+    EXPECT_EQ(copy(r.begin(), r.end(), right.data()), right.data() + 4);
+    EXPECT_EQ(left, (std::vector<float>{0, 1, 2, 3}));
+    EXPECT_EQ(right, (std::vector<float>{10, 11, 12, 13}));
+
+    // And back.
+    std::vector<float> out(8);
+    auto const out_l = bsi::make_strided_view<2>(out.data(), 4);
+    auto const out_r = bsi::make_strided_view<2>(out.data() + 1, 4);
+    EXPECT_TRUE(
+        copy(left.data(), left.data() + 4, out_l.begin()) == out_l.end());
+    copy(right.data(), right.data() + 4, out_r.begin());
+    EXPECT_EQ(out, samples);
+
+    auto const empty = bsi::make_strided_view(samples.data(), 0, 2);
+    EXPECT_EQ(copy(empty.begin(), empty.end(), left.data()), left.data());
+}
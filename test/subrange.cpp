@@ -0,0 +1,83 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/view_interface.hpp>
+#include <boost/stl_interfaces/range_adaptor_closure.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <iterator>
+#include <list>
+#include <type_traits>
+#include <vector>
+
+
+namespace bsi = boost::stl_interfaces;
+
+TEST(subrange, subview_and_slice)
+{
+    int ints[] = {0, 1, 2, 3, 4, 5, 6, 7};
+    bsi::subrange<int *, int *, bsi::contiguous> const all(ints, ints + 8);
+
+    auto const mid = all.subview(2, 3);
+    static_assert(std::is_same<decltype(mid), decltype(all)>::value, "");
+    EXPECT_EQ(mid.data(), ints + 2);
+    EXPECT_EQ(mid.size(), 3);
+    EXPECT_EQ(mid[0], 2);
+    EXPECT_EQ(mid.back(), 4);
+
+    auto const tail = all.subview(5);
+    EXPECT_EQ(tail.data(), ints + 5);
+    EXPECT_EQ(tail.size(), 3);
+    EXPECT_TRUE(all.subview(8).empty());
+    EXPECT_TRUE(all.subview(3, 0).empty());
+
+    // A subview of a subview is the same type, over the same memory.
+    auto const inner = mid.subview(1, 1);
+    static_assert(std::is_same<decltype(inner), decltype(all)>::value, "");
+    EXPECT_EQ(inner.data(), ints + 3);
+    EXPECT_EQ(inner.size(), 1);
+
+    auto const sliced = all.slice(ints + 1, ints + 7);
+    EXPECT_EQ(sliced.data(), ints + 1);
+    EXPECT_EQ(sliced.size(), 6);
+    EXPECT_EQ(sliced.front(), 1);
+
+    bsi::subrange<int *> mutable_all(ints, ints + 8);
+    mutable_all.subview(6)[0] = 60;
+    EXPECT_EQ(ints[6], 60);
+}
+
+TEST(subrange, of_adapted_views)
+{
+    std::vector<int> ints = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+
+    // The contiguity of a take_view carries over to its slices.
+    auto taken = ints | bsi::take(6);
+    auto const sub = taken.subview(1, 4);
+    EXPECT_EQ(sub.data(), ints.data() + 1);
+    EXPECT_EQ(sub.size(), 4);
+    auto const sliced = taken.slice(taken.begin() + 2, taken.end());
+    EXPECT_EQ(sliced.data(), ints.data() + 2);
+    EXPECT_EQ(sliced.size(), 4);
+
+    // Over a filter_view, a subview is found by walking, and is neither
+    // sized nor contiguous.
+    auto evens = ints | bsi::filter([](int x) { return x % 2 == 0; });
+    auto const some_evens = evens.subview(1, 2);
+    std::vector<int> const expected = {2, 4};
+    EXPECT_TRUE(std::equal(
+        some_evens.begin(),
+        some_evens.end(),
+        expected.begin(),
+        expected.end()));
+
+    std::list<int> l = {0, 1, 2, 3};
+    auto dropped = l | bsi::drop(1);
+    auto const last_two = dropped.subview(1);
+    EXPECT_EQ(last_two.front(), 2);
+    EXPECT_EQ(std::distance(last_two.begin(), last_two.end()), 2);
+}
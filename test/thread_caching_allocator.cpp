@@ -0,0 +1,182 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/alloc_vector.hpp>
+#include <boost/stl_interfaces/thread_caching_allocator.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+namespace bsi = boost::stl_interfaces;
+using bsi::alloc_vector;
+
+static_assert(
+    std::allocator_traits<
+        bsi::thread_caching_allocator<int>>::is_always_equal::value,
+    "");
+
+TEST(thread_caching_allocator, allocate_deallocate)
+{
+    bsi::thread_caching_allocator<double> a;
+    bsi::thread_caching_allocator<int> b(a);
+    EXPECT_TRUE(a == b);
+    EXPECT_FALSE(a != b);
+
+    std::vector<double *> blocks;
+    for (int i = 0; i < 1000; ++i) {
+        double * const p = a.allocate(1);
+        EXPECT_EQ(std::uintptr_t(p) % alignof(double), 0u);
+        *p = i;
+        blocks.push_back(p);
+    }
+    std::sort(blocks.begin(), blocks.end());
+    EXPECT_EQ(
+        std::adjacent_find(blocks.begin(), blocks.end()), blocks.end());
+    for (auto p : blocks) {
+        a.deallocate(p, 1);
+    }
+
+    // The block freed last is reused first.
+    double * const p = a.allocate(1);
+    a.deallocate(p, 1);
+    EXPECT_EQ(a.allocate(1), p);
+    a.deallocate(p, 1);
+
+    // Arrays are not pooled.
+    double * const array = a.allocate(100);
+    std::fill(array, array + 100, 1.0);
+    a.deallocate(array, 100);
+}
+
+TEST(thread_caching_allocator, node_containers)
+{
+    std::list<std::string, bsi::thread_caching_allocator<std::string>> l;
+    std::map<
+        int,
+        std::string,
+        std::less<int>,
+        bsi::thread_caching_allocator<std::pair<int const, std::string>>>
+        m;
+    for (int i = 0; i < 1000; ++i) {
+        l.push_back(std::to_string(i));
+        m[i] = std::to_string(i);
+    }
+    EXPECT_EQ(l.size(), 1000u);
+    EXPECT_EQ(l.back(), "999");
+    EXPECT_EQ(m[500], "500");
+
+    auto l2 = l;
+    l.clear();
+    EXPECT_EQ(l2.front(), "0");
+    l = std::move(l2);
+    EXPECT_EQ(l.size(), 1000u);
+    m.erase(m.begin(), m.find(900));
+    EXPECT_EQ(m.size(), 100u);
+}
+
+TEST(thread_caching_allocator, allocator_aware_container)
+{
+    alloc_vector<int, bsi::thread_caching_allocator<int>> v(
+        {1, 2, 3}, bsi::thread_caching_allocator<int>());
+    v.push_back(4);
+    auto const w = v;
+    EXPECT_EQ(w.size(), 4u);
+    EXPECT_EQ(w[3], 4);
+}
+
+TEST(thread_caching_allocator, cross_thread_frees)
+{
+    // One thread allocates nodes and another frees them, as pipeline
+    // stages do.  The freed blocks go back to the pool in batches, and the
+    // allocating thread gets them back from it, so the number of distinct
+    // blocks stays small.
+    using alloc_type = bsi::thread_caching_allocator<std::uint64_t>;
+    int const rounds = 200;
+    int const per_round = 1000;
+
+    std::mutex mutex;
+    std::set<std::uint64_t *> seen;
+    for (int r = 0; r < rounds; ++r) {
+        std::vector<std::uint64_t *> nodes;
+        std::thread producer([&] {
+            alloc_type a;
+            for (int i = 0; i < per_round; ++i) {
+                nodes.push_back(a.allocate(1));
+                *nodes.back() = std::uint64_t(i);
+            }
+        });
+        producer.join();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            seen.insert(nodes.begin(), nodes.end());
+        }
+        std::thread consumer([&] {
+            alloc_type a;
+            for (int i = 0; i < per_round; ++i) {
+                EXPECT_EQ(*nodes[i], std::uint64_t(i));
+                a.deallocate(nodes[i], 1);
+            }
+        });
+        consumer.join();
+    }
+    EXPECT_LT(seen.size(), std::size_t(4 * per_round));
+}
+
+TEST(thread_caching_allocator, concurrent_pipeline)
+{
+    using alloc_type = bsi::thread_caching_allocator<std::string>;
+    using list_type = std::list<std::string, alloc_type>;
+    std::mutex mutex;
+    std::vector<list_type> handed_off;
+    bool done = false;
+
+    std::thread consumer([&] {
+        for (;;) {
+            list_type l;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (handed_off.empty()) {
+                    if (done)
+                        return;
+                    continue;
+                }
+                l = std::move(handed_off.back());
+                handed_off.pop_back();
+            }
+            EXPECT_EQ(l.size(), 100u);
+        }
+    });
+    std::vector<std::thread> producers;
+    for (int t = 0; t < 3; ++t) {
+        producers.emplace_back([&] {
+            for (int r = 0; r < 100; ++r) {
+                list_type l;
+                for (int i = 0; i < 100; ++i) {
+                    l.push_back(std::string(30, char('a' + i % 26)));
+                }
+                std::lock_guard<std::mutex> lock(mutex);
+                handed_off.push_back(std::move(l));
+            }
+        });
+    }
+    for (auto & p : producers) {
+        p.join();
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        done = true;
+    }
+    consumer.join();
+}
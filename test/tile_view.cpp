@@ -0,0 +1,134 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/tile_view.hpp>
+
+#include <gtest/gtest.h>
+
+#include <numeric>
+#include <vector>
+
+
+namespace bsi = boost::stl_interfaces;
+
+using dyn2 = bsi::extents<bsi::dynamic_extent, bsi::dynamic_extent>;
+
+// The rows of a tile of a row-major matrix are contiguous.
+static_assert(
+    std::is_same<
+        bsi::tile_iterator<bsi::md_view<int, dyn2>>::tile_type,
+        bsi::md_view<int, dyn2, bsi::layout_right_padded>>::value,
+    "");
+static_assert(
+    std::is_same<
+        bsi::md_view<int, dyn2, bsi::layout_right_padded>::iterator::
+            value_type::iterator,
+        int *>::value,
+    "");
+static_assert(
+    std::is_same<
+        std::iterator_traits<
+            bsi::tile_iterator<bsi::md_view<int, dyn2>>>::iterator_category,
+        std::random_access_iterator_tag>::value,
+    "");
+
+std::vector<int> iota(int n)
+{
+    std::vector<int> retval(n);
+    std::iota(retval.begin(), retval.end(), 0);
+    return retval;
+}
+
+
+TEST(tile_view, tiles)
+{
+    // A 5x7 matrix, in 2x3 tiles; those at the bottom and right are smaller.
+    std::vector<int> a = iota(35);
+    bsi::md_view<int, dyn2> m(a.data(), 5, 7);
+    auto const tiles = bsi::make_tile_view(m, 2, 3);
+    EXPECT_EQ(tiles.tiles_down(), 3);
+    EXPECT_EQ(tiles.tiles_across(), 3);
+    EXPECT_EQ(tiles.size(), 9);
+
+    auto const first = tiles[0];
+    EXPECT_EQ(first.extent(0), 2);
+    EXPECT_EQ(first.extent(1), 3);
+    EXPECT_EQ(first(1, 2), 9);
+
+    auto const right = tiles[2];
+    EXPECT_EQ(right.extent(0), 2);
+    EXPECT_EQ(right.extent(1), 1);
+    EXPECT_EQ(right(1, 0), 13);
+
+    auto const corner = tiles.back();
+    EXPECT_EQ(corner.extent(0), 1);
+    EXPECT_EQ(corner.extent(1), 1);
+    EXPECT_EQ(corner(0, 0), 34);
+
+    auto it = tiles.begin() + 4;
+    EXPECT_EQ(it.row(), 2);
+    EXPECT_EQ(it.column(), 3);
+    EXPECT_EQ((*it)(0, 0), 17);
+    EXPECT_EQ(tiles.end() - it, 5);
+}
+
+TEST(tile_view, visits_each_element_once)
+{
+    std::vector<int> a = iota(35);
+    bsi::md_view<int, dyn2> m(a.data(), 5, 7);
+    std::vector<int> counts(35);
+    for (auto it = bsi::make_tile_view(m, 2, 3).begin(),
+              last = bsi::make_tile_view(m, 2, 3).end();
+         it != last;
+         ++it) {
+        for (auto row : *it) {
+            for (int x : row) {
+                ++counts[x];
+            }
+        }
+    }
+    EXPECT_EQ(counts, std::vector<int>(35, 1));
+}
+
+TEST(tile_view, blocked_transpose)
+{
+    int const rows = 37;
+    int const cols = 53;
+    std::vector<int> a = iota(rows * cols);
+    std::vector<int> b(rows * cols);
+    bsi::md_view<int, dyn2> in(a.data(), rows, cols);
+    bsi::md_view<int, dyn2> out(b.data(), cols, rows);
+
+    auto const tiles = bsi::make_tile_view(in, 8, 8);
+    for (auto it = tiles.begin(); it != tiles.end(); ++it) {
+        auto const tile = *it;
+        for (std::ptrdiff_t i = 0; i < tile.extent(0); ++i) {
+            for (std::ptrdiff_t j = 0; j < tile.extent(1); ++j) {
+                out(it.column() + j, it.row() + i) = tile(i, j);
+            }
+        }
+    }
+
+    for (int i = 0; i < rows; ++i) {
+        for (int j = 0; j < cols; ++j) {
+            EXPECT_EQ(out(j, i), in(i, j));
+        }
+    }
+}
+
+TEST(tile_view, static_extents)
+{
+    std::vector<int> a = iota(16);
+    bsi::md_view<int, bsi::extents<4, 4>> m(a.data());
+    auto const tiles = bsi::make_tile_view(m, 2, 2);
+    static_assert(
+        std::is_same<
+            decltype(tiles)::iterator::tile_type,
+            bsi::md_view<int, dyn2, bsi::layout_right_padded>>::value,
+        "");
+    EXPECT_EQ(tiles.size(), 4);
+    EXPECT_EQ(tiles[3](0, 0), 10);
+    EXPECT_EQ(tiles[3].stride(0), 4);
+}
@@ -0,0 +1,208 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/to.hpp>
+#include <boost/stl_interfaces/parallel.hpp>
+#include <boost/stl_interfaces/static_vector.hpp>
+
+#include "view_tests.hpp"
+
+#include <gtest/gtest.h>
+
+#include <list>
+#include <numeric>
+#include <string>
+#include <vector>
+
+
+namespace bsi = boost::stl_interfaces;
+
+// A vector that counts its calls to reserve(), insert() and push_back().
+struct counting_vector
+{
+    using value_type = int;
+    using iterator = std::vector<int>::iterator;
+
+    std::size_t size() const { return elements.size(); }
+    void reserve(std::size_t n)
+    {
+        elements.reserve(n);
+        ++reserves;
+    }
+    iterator end() { return elements.end(); }
+    template<typename Iter>
+    iterator insert(iterator at, Iter first, Iter last)
+    {
+        ++inserts;
+        return elements.insert(at, first, last);
+    }
+    void push_back(int x)
+    {
+        elements.push_back(x);
+        ++push_backs;
+    }
+
+    std::vector<int> elements;
+    int reserves = 0;
+    int inserts = 0;
+    int push_backs = 0;
+};
+
+// A container with append_range(), that counts its calls.
+struct appendable
+{
+    using value_type = int;
+
+    void push_back(int x) { elements.push_back(x); }
+    template<typename R>
+    void append_range(R && r)
+    {
+        elements.insert(elements.end(), r.begin(), r.end());
+        ++appends;
+    }
+
+    std::vector<int> elements;
+    int appends = 0;
+};
+
+// A vector that counts its calls to resize_for_overwrite().
+struct overwritable
+{
+    using value_type = int;
+    using iterator = std::vector<int>::iterator;
+
+    std::size_t size() const { return elements.size(); }
+    iterator begin() { return elements.begin(); }
+    iterator end() { return elements.end(); }
+    void push_back(int x) { elements.push_back(x); }
+    void resize_for_overwrite(std::size_t n)
+    {
+        elements.resize(n);
+        ++resizes;
+    }
+
+    std::vector<int> elements;
+    int resizes = 0;
+};
+
+struct null_sentinel
+{
+    friend bool operator==(char const * it, null_sentinel)
+    {
+        return !*it;
+    }
+    friend bool operator!=(char const * it, null_sentinel)
+    {
+        return !!*it;
+    }
+};
+
+
+TEST(to, sized_sources_reserve_once)
+{
+    std::vector<int> const ints = {0, 1, 2, 3, 4};
+
+    auto const from_vector = bsi::to<counting_vector>(ints);
+    EXPECT_EQ(from_vector.elements, ints);
+    EXPECT_EQ(from_vector.reserves, 1);
+    EXPECT_EQ(from_vector.inserts, 1);
+    EXPECT_EQ(from_vector.push_backs, 0);
+
+    std::list<int> const list(ints.begin(), ints.end());
+    auto const from_list = bsi::to<counting_vector>(list);
+    EXPECT_EQ(from_list.elements, ints);
+    EXPECT_EQ(from_list.reserves, 1);
+    EXPECT_EQ(from_list.inserts, 1);
+}
+
+TEST(to, append_range)
+{
+    std::vector<int> const ints = {0, 1, 2, 3, 4};
+    auto const appended = bsi::to<appendable>(ints);
+    EXPECT_EQ(appended.elements, ints);
+    EXPECT_EQ(appended.appends, 1);
+
+    auto const vec = bsi::to<bsi::static_vector<int, 8>>(ints);
+    EXPECT_TRUE(std::equal(vec.begin(), vec.end(), ints.begin(), ints.end()));
+}
+
+TEST(to, sentinel_sources_push_back)
+{
+    char const * str = "text";
+    auto const r = range<false>(str, null_sentinel{});
+
+    auto const chars = bsi::to<std::string>(r);
+    EXPECT_EQ(chars, "text");
+
+    auto const counted = bsi::to<counting_vector>(r);
+    EXPECT_EQ(counted.elements, (std::vector<int>{'t', 'e', 'x', 't'}));
+    EXPECT_EQ(counted.reserves, 0);
+    EXPECT_EQ(counted.inserts, 0);
+    EXPECT_EQ(counted.push_backs, 4);
+}
+
+TEST(to, pipe)
+{
+    std::vector<int> const ints = {0, 1, 2, 3, 4, 5};
+
+    auto const copied = ints | bsi::to<std::vector<int>>();
+    EXPECT_EQ(copied, ints);
+
+    auto const evens =
+        ints | bsi::filter([](int x) { return x % 2 == 0; }) |
+        bsi::to<std::list<int>>();
+    EXPECT_EQ(evens, (std::list<int>{0, 2, 4}));
+}
+
+TEST(to, parallel)
+{
+    std::vector<int> ints(100000);
+    std::iota(ints.begin(), ints.end(), 0);
+
+    bsi::thread_pool pool(2);
+    auto const vec = bsi::parallel_to<std::vector<int>>(pool, ints, 1024);
+    EXPECT_EQ(vec, ints);
+
+    auto const overwritten = bsi::parallel_to<overwritable>(pool, ints, 1024);
+    EXPECT_EQ(overwritten.elements, ints);
+    EXPECT_EQ(overwritten.resizes, 1);
+
+    auto const list = bsi::parallel_to<std::list<int>>(pool, ints, 1024);
+    EXPECT_TRUE(std::equal(list.begin(), list.end(), ints.begin(), ints.end()));
+
+    auto const with_default_pool = bsi::parallel_to<overwritable>(ints);
+    EXPECT_EQ(with_default_pool.elements, ints);
+    EXPECT_EQ(with_default_pool.resizes, 1);
+}
+
+TEST(to, parallel_small_sources_are_serial)
+{
+    std::vector<int> const ints = {0, 1, 2, 3, 4};
+    bsi::thread_pool pool(2);
+    auto const overwritten = bsi::parallel_to<overwritable>(pool, ints, 1024);
+    EXPECT_EQ(overwritten.elements, ints);
+    EXPECT_EQ(overwritten.resizes, 0);
+}
+
+#if 201703L < __cplusplus && defined(__cpp_lib_concepts)
+
+TEST(to, v2)
+{
+    std::vector<int> const ints = {0, 1, 2, 3, 4};
+
+    auto const from_vector = bsi::v2::to<counting_vector>(ints);
+    EXPECT_EQ(from_vector.elements, ints);
+    EXPECT_EQ(from_vector.reserves, 1);
+    EXPECT_EQ(from_vector.inserts, 1);
+
+    auto const appended = bsi::v2::to<appendable>(ints);
+    EXPECT_EQ(appended.appends, 1);
+
+    auto const squares = bsi::v2::to<std::vector<int>>(
+        ints | std::views::transform([](int x) { return x * x; }));
+    EXPECT_EQ(squares, (std::vector<int>{0, 1, 4, 9, 16}));
+}
+
+#endif
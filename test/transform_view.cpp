@@ -0,0 +1,131 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/transform_view.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <list>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+namespace bsi = boost::stl_interfaces;
+
+auto const square = [](int x) { return x * x; };
+using square_t = decltype(square);
+
+auto const first_of = [](std::pair<int, std::string> & p) -> int & {
+    return p.first;
+};
+using first_of_t = decltype(first_of);
+
+struct times
+{
+    int operator()(int x) const { return x * n; }
+    int n;
+};
+
+using square_iter = bsi::transform_iterator<int *, square_t>;
+using first_iter = bsi::transform_iterator<
+    std::vector<std::pair<int, std::string>>::iterator,
+    first_of_t>;
+
+// Stateless functors take no space.
+static_assert(sizeof(square_iter) == sizeof(int *), "");
+static_assert(sizeof(first_iter) == sizeof(int *), "");
+static_assert(
+    sizeof(bsi::transform_view<int *, square_t>) == 2 * sizeof(int *), "");
+static_assert(
+    sizeof(bsi::transform_iterator<int *, times>) == 2 * sizeof(int *), "");
+
+// Contiguous bases give random access iterators.
+static_assert(
+    std::is_same<
+        std::iterator_traits<square_iter>::iterator_category,
+        std::random_access_iterator_tag>::value,
+    "");
+static_assert(
+    std::is_same<
+        square_iter::iterator_concept,
+        std::random_access_iterator_tag>::value,
+    "");
+static_assert(!bsi::is_contiguous_iterator<square_iter>::value, "");
+static_assert(
+    std::is_same<
+        std::iterator_traits<bsi::transform_iterator<
+            std::list<int>::iterator,
+            square_t>>::iterator_category,
+        std::bidirectional_iterator_tag>::value,
+    "");
+
+static_assert(std::is_same<square_iter::reference, int>::value, "");
+static_assert(std::is_same<square_iter::value_type, int>::value, "");
+static_assert(std::is_same<first_iter::reference, int &>::value, "");
+static_assert(std::is_same<first_iter::pointer, int *>::value, "");
+
+
+TEST(transform_view, by_value)
+{
+    std::vector<int> ints = {0, 1, 2, 3, 4};
+    auto const v = bsi::make_transform_view(ints, square);
+    EXPECT_EQ(
+        std::vector<int>(v.begin(), v.end()),
+        (std::vector<int>{0, 1, 4, 9, 16}));
+    EXPECT_EQ(v.size(), 5);
+    EXPECT_EQ(v[3], 9);
+    EXPECT_EQ(v.back(), 16);
+
+    auto it = v.begin();
+    it += 2;
+    EXPECT_EQ(*it, 4);
+    EXPECT_EQ(it[1], 9);
+    EXPECT_EQ(v.end() - it, 3);
+    EXPECT_EQ(it.base(), ints.begin() + 2);
+    EXPECT_TRUE(v.begin() < it);
+    EXPECT_EQ(*std::prev(it), 1);
+
+    // A binary search over the squares.
+    EXPECT_EQ(std::lower_bound(v.begin(), v.end(), 5) - v.begin(), 3);
+}
+
+TEST(transform_view, by_reference)
+{
+    std::vector<std::pair<int, std::string>> pairs = {
+        {3, "c"}, {1, "a"}, {2, "b"}};
+    auto v = bsi::make_transform_view(pairs, first_of);
+    auto it = v.begin();
+    EXPECT_EQ(&*it, &pairs[0].first);
+    EXPECT_EQ(it.operator->(), &pairs[0].first);
+    *it = 4;
+    EXPECT_EQ(pairs[0].first, 4);
+    std::fill(v.begin(), v.end(), 7);
+    for (auto const & p : pairs) {
+        EXPECT_EQ(p.first, 7);
+    }
+}
+
+TEST(transform_view, stateful)
+{
+    std::list<int> ints = {1, 2, 3};
+    auto const v = bsi::make_transform_view(ints, times{10});
+    EXPECT_EQ(
+        std::vector<int>(v.begin(), v.end()), (std::vector<int>{10, 20, 30}));
+    EXPECT_EQ(v.functor().n, 10);
+    EXPECT_EQ(v.begin().functor().n, 10);
+    auto it = v.end();
+    EXPECT_EQ(*--it, 30);
+}
+
+TEST(transform_view, proxy_arrow)
+{
+    std::vector<int> ints = {1, 2};
+    auto const v = bsi::make_transform_view(
+        ints, [](int x) { return std::to_string(x); });
+    EXPECT_EQ(v.begin()->size(), 1u);
+    EXPECT_EQ(*std::next(v.begin()), "2");
+}
@@ -0,0 +1,235 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/async_generator.hpp>
+
+#include <gtest/gtest.h>
+
+#include <deque>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+namespace bsi = boost::stl_interfaces::v2;
+
+static_assert(!std::copyable<bsi::async_generator<int>>);
+static_assert(std::movable<bsi::async_generator<int>>);
+static_assert(std::same_as<
+              decltype(*std::declval<bsi::async_generator<int>::iterator>()),
+              int &>);
+
+
+// A single-threaded event loop.  An operation on a socket completes on a
+// later turn of the loop, as it would when the data arrives.
+struct event_loop
+{
+    struct socket
+    {
+        event_loop & loop_;
+        std::deque<std::string> chunks_;
+
+        auto read()
+        {
+            struct awaiter
+            {
+                bool await_ready() noexcept { return false; }
+                void await_suspend(std::coroutine_handle<> h)
+                {
+                    s_.loop_.log_.push_back("read");
+                    s_.loop_.ready_.push_back(h);
+                }
+                std::string await_resume()
+                {
+                    if (s_.chunks_.empty())
+                        return std::string();
+                    auto retval = std::move(s_.chunks_.front());
+                    s_.chunks_.pop_front();
+                    return retval;
+                }
+                socket & s_;
+            };
+            return awaiter{*this};
+        }
+    };
+
+    void run()
+    {
+        while (!ready_.empty()) {
+            auto const h = ready_.front();
+            ready_.pop_front();
+            h.resume();
+        }
+    }
+
+    std::deque<std::coroutine_handle<>> ready_;
+    std::vector<std::string> log_;
+};
+
+// A coroutine that starts at once, and destroys itself when done.
+struct detached
+{
+    struct promise_type
+    {
+        detached get_return_object() noexcept { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
+bsi::async_generator<std::string> records(event_loop::socket & s)
+{
+    for (;;) {
+        auto chunk = co_await s.read();
+        if (chunk.empty())
+            co_return;
+        co_yield chunk;
+    }
+}
+
+detached consume(
+    bsi::async_generator<std::string> g,
+    std::vector<std::string> & out,
+    std::vector<std::string> & log)
+{
+    for (auto it = co_await g.begin(); it != g.end(); co_await ++it) {
+        log.push_back("process " + *it);
+        out.push_back(std::move(*it));
+    }
+    log.push_back("done");
+}
+
+TEST(async_generator, event_loop)
+{
+    event_loop loop;
+    event_loop::socket s{loop, {"a", "b", "c"}};
+    std::vector<std::string> out;
+    consume(records(s), out, loop.log_);
+
+    // Nothing happens until the loop runs.
+    EXPECT_EQ(loop.log_, std::vector<std::string>{"read"});
+    EXPECT_TRUE(out.empty());
+
+    loop.run();
+    EXPECT_EQ(out, (std::vector<std::string>{"a", "b", "c"}));
+    EXPECT_EQ(
+        loop.log_,
+        (std::vector<std::string>{
+            "read",
+            "process a",
+            "read",
+            "process b",
+            "read",
+            "process c",
+            "read",
+            "done"}));
+}
+
+TEST(async_generator, interleaved_connections)
+{
+    event_loop loop;
+    event_loop::socket s1{loop, {"1", "2"}};
+    event_loop::socket s2{loop, {"x", "y"}};
+    std::vector<std::string> out1;
+    std::vector<std::string> out2;
+    std::vector<std::string> log;
+    consume(records(s1), out1, log);
+    consume(records(s2), out2, log);
+    loop.run();
+    EXPECT_EQ(out1, (std::vector<std::string>{"1", "2"}));
+    EXPECT_EQ(out2, (std::vector<std::string>{"x", "y"}));
+    EXPECT_EQ(
+        log,
+        (std::vector<std::string>{
+            "process 1", "process x", "process 2", "process y", "done",
+            "done"}));
+}
+
+bsi::async_generator<int> ints(int n)
+{
+    for (int i = 0; i < n; ++i) {
+        co_yield i;
+    }
+    int const last = n;
+    co_yield last;
+}
+
+detached sum(bsi::async_generator<int> g, int & result)
+{
+    for (auto it = co_await g.begin(); it != g.end(); co_await ++it) {
+        result += *it;
+    }
+}
+
+TEST(async_generator, synchronous)
+{
+    int result = 0;
+    sum(ints(4), result);
+    EXPECT_EQ(result, 0 + 1 + 2 + 3 + 4);
+
+    result = 0;
+    sum(bsi::async_generator<int>(), result);
+    EXPECT_EQ(result, 0);
+}
+
+bsi::async_generator<int> throws_after(event_loop::socket & s, int n)
+{
+    for (int i = 0; i < n; ++i) {
+        co_await s.read();
+        co_yield i;
+    }
+    throw std::runtime_error("connection reset");
+}
+
+detached consume_ints(
+    bsi::async_generator<int> g, std::vector<int> & out, std::string & error)
+{
+    try {
+        for (auto it = co_await g.begin(); it != g.end(); co_await ++it) {
+            out.push_back(*it);
+        }
+    } catch (std::runtime_error const & e) {
+        error = e.what();
+    }
+}
+
+TEST(async_generator, exceptions)
+{
+    event_loop loop;
+    event_loop::socket s{loop, {}};
+    std::vector<int> out;
+    std::string error;
+    consume_ints(throws_after(s, 2), out, error);
+    loop.run();
+    EXPECT_EQ(out, (std::vector<int>{0, 1}));
+    EXPECT_EQ(error, "connection reset");
+
+    out.clear();
+    error.clear();
+    consume_ints(throws_after(s, 0), out, error);
+    EXPECT_TRUE(out.empty());
+    EXPECT_EQ(error, "connection reset");
+}
+
+TEST(async_generator, destroyed_early)
+{
+    event_loop loop;
+    event_loop::socket s{loop, {"a", "b"}};
+    {
+        auto g = records(s);
+        auto h = [](bsi::async_generator<std::string> & g,
+                    std::string & first) -> detached {
+            auto it = co_await g.begin();
+            first = *it;
+        };
+        std::string first;
+        h(g, first);
+        loop.run();
+        EXPECT_EQ(first, "a");
+    }
+    EXPECT_EQ(s.chunks_.size(), 1u);
+}
@@ -0,0 +1,294 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/generator.hpp>
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <new>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <cstdlib>
+
+
+namespace bsi = boost::stl_interfaces::v2;
+
+static_assert(std::ranges::input_range<bsi::generator<int>>);
+static_assert(std::ranges::view<bsi::generator<int>>);
+static_assert(!std::ranges::forward_range<bsi::generator<int>>);
+static_assert(!std::copyable<bsi::generator<int>>);
+static_assert(std::same_as<
+              std::ranges::range_reference_t<bsi::generator<std::string>>,
+              std::string &>);
+static_assert(std::same_as<
+              std::ranges::range_reference_t<bsi::generator<int const &>>,
+              int const &>);
+
+
+bsi::generator<int> iota(int first, int last)
+{
+    for (int i = first; i < last; ++i) {
+        co_yield i;
+    }
+}
+
+TEST(generator, basic)
+{
+    std::vector<int> v;
+    for (int x : iota(0, 5)) {
+        v.push_back(x);
+    }
+    EXPECT_EQ(v, (std::vector<int>{0, 1, 2, 3, 4}));
+
+    auto g = iota(0, 0);
+    EXPECT_TRUE(g.begin() == g.end());
+
+    bsi::generator<int> empty;
+    EXPECT_TRUE(empty.begin() == empty.end());
+
+    auto g2 = iota(1, 4);
+    auto it = g2.begin();
+    EXPECT_EQ(*it, 1);
+    it++;
+    EXPECT_EQ(*it, 2);
+    EXPECT_EQ(*++it, 3);
+    EXPECT_FALSE(it == g2.end());
+    ++it;
+    EXPECT_TRUE(it == g2.end());
+
+    bsi::generator<int> g3 = iota(0, 3);
+    g3 = iota(10, 13);
+    int sum = 0;
+    for (int x : g3) {
+        sum += x;
+    }
+    EXPECT_EQ(sum, 33);
+}
+
+bsi::generator<std::string> records()
+{
+    std::string const prefix = "record ";
+    co_yield prefix;
+    co_yield prefix + "1";
+    std::string local = "record 2";
+    co_yield local;
+}
+
+TEST(generator, elements_refer_to_yielded_objects)
+{
+    std::vector<std::string> v;
+    for (auto & s : records()) {
+        v.push_back(std::move(s));
+    }
+    EXPECT_EQ(
+        v, (std::vector<std::string>{"record ", "record 1", "record 2"}));
+
+    auto g = records();
+    auto it = g.begin();
+    EXPECT_EQ(it->size(), 7u);
+}
+
+bsi::generator<int const &> refs(std::vector<int> const & v)
+{
+    for (auto const & x : v) {
+        co_yield x;
+    }
+}
+
+TEST(generator, reference_type)
+{
+    std::vector<int> const v = {1, 2, 3};
+    auto g = refs(v);
+    auto it = g.begin();
+    EXPECT_EQ(&*it, &v[0]);
+    ++it;
+    EXPECT_EQ(&*it, &v[1]);
+}
+
+struct tree
+{
+    int value_;
+    std::unique_ptr<tree> left_;
+    std::unique_ptr<tree> right_;
+};
+
+bsi::generator<int> in_order(tree const * t)
+{
+    if (!t)
+        co_return;
+    co_yield bsi::elements_of(in_order(t->left_.get()));
+    co_yield t->value_;
+    co_yield bsi::elements_of(in_order(t->right_.get()));
+}
+
+std::unique_ptr<tree> make_tree(int first, int last)
+{
+    if (first == last)
+        return nullptr;
+    int const mid = first + (last - first) / 2;
+    return std::unique_ptr<tree>(new tree{
+        mid, make_tree(first, mid), make_tree(mid + 1, last)});
+}
+
+TEST(generator, nested)
+{
+    auto const t = make_tree(0, 100);
+    std::vector<int> v;
+    for (int x : in_order(t.get())) {
+        v.push_back(x);
+    }
+    std::vector<int> expected(100);
+    std::iota(expected.begin(), expected.end(), 0);
+    EXPECT_EQ(v, expected);
+}
+
+bsi::generator<int> countdown(int n)
+{
+    if (!n)
+        co_return;
+    co_yield n;
+    co_yield bsi::elements_of(countdown(n - 1));
+}
+
+TEST(generator, deeply_nested)
+{
+    int expected = 2000;
+    for (int x : countdown(2000)) {
+        EXPECT_EQ(x, expected);
+        --expected;
+    }
+    EXPECT_EQ(expected, 0);
+}
+
+TEST(generator, nested_range)
+{
+    auto g = []() -> bsi::generator<int> {
+        std::vector<int> const v = {1, 2};
+        co_yield 0;
+        co_yield bsi::elements_of(v);
+        co_yield bsi::elements_of(std::views::iota(3, 5));
+        co_yield 5;
+    }();
+    std::vector<int> v;
+    for (int x : g) {
+        v.push_back(x);
+    }
+    EXPECT_EQ(v, (std::vector<int>{0, 1, 2, 3, 4, 5}));
+}
+
+bsi::generator<int> throws_after(int n)
+{
+    for (int i = 0; i < n; ++i) {
+        co_yield i;
+    }
+    throw std::runtime_error("done");
+}
+
+TEST(generator, exceptions)
+{
+    {
+        auto g = throws_after(0);
+        EXPECT_THROW(g.begin(), std::runtime_error);
+    }
+    {
+        auto g = throws_after(2);
+        auto it = g.begin();
+        ++it;
+        EXPECT_THROW(++it, std::runtime_error);
+        EXPECT_TRUE(it == g.end());
+    }
+    {
+        auto g = []() -> bsi::generator<int> {
+            bool caught = false;
+            try {
+                co_yield bsi::elements_of(throws_after(1));
+            } catch (std::runtime_error const &) {
+                caught = true;
+            }
+            if (caught)
+                co_yield 42;
+        }();
+        std::vector<int> v;
+        for (int x : g) {
+            v.push_back(x);
+        }
+        EXPECT_EQ(v, (std::vector<int>{0, 42}));
+    }
+    {
+        auto g = []() -> bsi::generator<int> {
+            co_yield bsi::elements_of(throws_after(1));
+            co_yield 42;
+        }();
+        auto it = g.begin();
+        EXPECT_EQ(*it, 0);
+        EXPECT_THROW(++it, std::runtime_error);
+    }
+}
+
+struct counted
+{
+    counted(int & count) : count_(count) { ++count_; }
+    ~counted() { --count_; }
+    int & count_;
+};
+
+bsi::generator<int> holds(int & count, int depth)
+{
+    counted c(count);
+    co_yield depth;
+    if (depth)
+        co_yield bsi::elements_of(holds(count, depth - 1));
+}
+
+TEST(generator, destroyed_early)
+{
+    int count = 0;
+    {
+        auto g = holds(count, 10);
+        for (int x : g) {
+            if (x == 5)
+                break;
+        }
+        EXPECT_EQ(count, 6);
+    }
+    EXPECT_EQ(count, 0);
+}
+
+int allocations = 0;
+
+void * operator new(std::size_t n)
+{
+    ++allocations;
+    if (void * p = std::malloc(n))
+        return p;
+    throw std::bad_alloc();
+}
+void operator delete(void * p) noexcept { std::free(p); }
+void operator delete(void * p, std::size_t) noexcept { std::free(p); }
+
+TEST(generator, frames_reused)
+{
+    auto const t = make_tree(0, 100);
+    for (int x : in_order(t.get())) {
+        (void)x;
+    }
+
+    int const before = allocations;
+    int total = 0;
+    for (int i = 0; i < 1000; ++i) {
+        for (int x : iota(0, i % 8)) {
+            total += x;
+        }
+    }
+    for (int x : in_order(t.get())) {
+        total += x;
+    }
+    EXPECT_EQ(allocations, before);
+    EXPECT_EQ(total, 125 * (0 + 0 + 1 + 3 + 6 + 10 + 15 + 21) + 4950);
+}
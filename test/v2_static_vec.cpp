@@ -11,6 +11,12 @@
 #include <gtest/gtest.h>
 
 #include <array>
+#include <cmath>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
 
 
 // Instantiate all the members we can.
@@ -272,6 +278,93 @@ TEST(static_vec, comparisons)
     EXPECT_TRUE(lg >= lg);
 }
 
+// An enum with an operator==() of its own, which must not be bypassed by
+// memcmp().
+enum class all_equal_enum { a, b };
+bool operator==(all_equal_enum, all_equal_enum) { return true; }
+bool operator!=(all_equal_enum, all_equal_enum) { return false; }
+
+TEST(static_vec, enum_equality)
+{
+    static_vector<all_equal_enum, 4> const a = {all_equal_enum::a};
+    static_vector<all_equal_enum, 4> const b = {all_equal_enum::b};
+    EXPECT_TRUE(a == b);
+    EXPECT_FALSE(a != b);
+}
+
+TEST(static_vec, char_ordering)
+{
+    // chars are ordered as unsigned, as std::string orders them.
+    static_vector<char, 4> const a = {'a'};
+    static_vector<char, 4> const b = {char(0xe9)};
+    static_vector<char, 4> const aa = {'a', 'a'};
+    static_vector<char, 4> const ab = {'a', char(0xe9)};
+    EXPECT_TRUE(a < b);
+    EXPECT_FALSE(b < a);
+    EXPECT_TRUE(aa < ab);
+#if 201711L <= __cpp_lib_three_way_comparison
+    EXPECT_TRUE((a <=> b) < 0);
+#endif
+}
+
+TEST(static_vec, heterogeneous_comparisons)
+{
+    vec_type const v = {1, 2, 3};
+    static_vector<int, 3> const exact = {1, 2, 3};
+    static_vector<int, 16> const longer = {1, 2, 3, 0};
+    std::vector<int> const vec = {1, 2, 3};
+    std::array<int, 3> const arr = {{1, 2, 4}};
+
+    EXPECT_TRUE(v == exact);
+    EXPECT_TRUE(exact == v);
+    EXPECT_FALSE(v != exact);
+    EXPECT_TRUE(v != longer);
+    EXPECT_TRUE(v < longer);
+    EXPECT_TRUE(longer > v);
+    EXPECT_TRUE(v <= exact);
+#if 201711L <= __cpp_lib_three_way_comparison
+    EXPECT_TRUE((v <=> exact) == 0);
+#endif
+
+    EXPECT_TRUE(v == vec);
+    EXPECT_TRUE(vec == v);
+    EXPECT_TRUE(v < arr);
+    EXPECT_TRUE(arr > v);
+    EXPECT_FALSE(arr <= v);
+
+    static_vector<char, 4> const high = {char(0xe9), 'a'};
+    std::string_view const low = "za";
+    EXPECT_TRUE(low < high);
+    EXPECT_TRUE(high > low);
+    EXPECT_TRUE(high == std::string_view("\xe9" "a"));
+    static_vector<char, 8> const a = {'a'};
+    static_vector<char, 16> const b16 = {char(0xe9)};
+    EXPECT_TRUE(a < b16);
+    EXPECT_FALSE(b16 < a);
+
+    // Floating-point elements are only partially ordered.
+    static_vector<double, 4> const d = {1.0, 2.5};
+    static_vector<double, 8> const d8 = {1.0, 3.0};
+    std::vector<double> const nan = {1.0, std::nan("")};
+    static_vector<double, 4> const d_nan = {1.0, std::nan("")};
+    EXPECT_TRUE(d < d8);
+    EXPECT_TRUE(d8 >= d);
+    EXPECT_TRUE(d == std::vector<double>({1.0, 2.5}));
+    EXPECT_FALSE(d < nan);
+    EXPECT_FALSE(d > nan);
+    EXPECT_TRUE((d < static_vector<double, 4>{1.0, 3.0}));
+    EXPECT_FALSE(d < d_nan);
+#if 201711L <= __cpp_lib_three_way_comparison
+    static_assert(
+        std::is_same_v<decltype(d <=> d8), std::partial_ordering>);
+    static_assert(std::is_same_v<decltype(v <=> vec), std::strong_ordering>);
+    static_assert(std::is_same_v<decltype(d <=> d), std::partial_ordering>);
+    static_assert(std::is_same_v<decltype(v <=> v), std::strong_ordering>);
+    EXPECT_TRUE((d <=> nan) == std::partial_ordering::unordered);
+    EXPECT_TRUE((d <=> d_nan) == std::partial_ordering::unordered);
+#endif
+}
+
 TEST(static_vec, swap)
 {
     {
@@ -586,6 +679,100 @@ TEST(static_vec, emplace_insert)
     }
 }
 
+// Not default-constructible, not trivially relocatable, and able to throw
+// from its copy constructor on request.  Tracks the number of live objects.
+struct tracked
+{
+    explicit tracked(int x) : x_(x) { ++live; }
+    tracked(tracked const & other) : x_(other.x_)
+    {
+        if (copies_until_throw && !--copies_until_throw)
+            throw std::runtime_error("copy");
+        ++live;
+    }
+    tracked(tracked && other) noexcept : x_(other.x_) { ++live; }
+    tracked & operator=(tracked const & other)
+    {
+        x_ = other.x_;
+        return *this;
+    }
+    tracked & operator=(tracked && other) noexcept
+    {
+        x_ = other.x_;
+        return *this;
+    }
+    ~tracked() { --live; }
+
+    friend bool operator==(tracked lhs, tracked rhs)
+    {
+        return lhs.x_ == rhs.x_;
+    }
+    friend bool operator<(tracked lhs, tracked rhs) { return lhs.x_ < rhs.x_; }
+
+    int x_;
+
+    static int live;
+    static int copies_until_throw;
+};
+
+int tracked::live = 0;
+int tracked::copies_until_throw = 0;
+
+TEST(static_vec, gap_insert)
+{
+    using tracked_vec = static_vector<tracked, 10>;
+
+    auto make = [](std::initializer_list<int> il) {
+        tracked_vec retval;
+        for (int x : il) {
+            retval.emplace_back(x);
+        }
+        return retval;
+    };
+    std::array<tracked, 3> const more = {{tracked(7), tracked(8), tracked(9)}};
+
+    {
+        // Fewer insertions than elements after pos.
+        tracked_vec v = make({1, 2, 3, 4, 5});
+        v.insert(v.begin() + 1, more.begin(), more.end());
+        EXPECT_EQ(v, make({1, 7, 8, 9, 2, 3, 4, 5}));
+    }
+    {
+        // More insertions than elements after pos.
+        tracked_vec v = make({1, 2, 3});
+        v.insert(v.begin() + 2, more.begin(), more.end());
+        EXPECT_EQ(v, make({1, 2, 7, 8, 9, 3}));
+    }
+    {
+        // Insertion at the end.
+        tracked_vec v = make({1});
+        v.insert(v.end(), more.begin(), more.end());
+        EXPECT_EQ(v, make({1, 7, 8, 9}));
+    }
+    {
+        // Filling to capacity.
+        tracked_vec v = make({1, 2, 3, 4, 5, 6, 10});
+        v.insert(v.begin() + 6, more.begin(), more.end());
+        EXPECT_EQ(v, make({1, 2, 3, 4, 5, 6, 7, 8, 9, 10}));
+    }
+    EXPECT_EQ(tracked::live, 3);
+
+    {
+        // A throwing copy leaves no stray elements behind.
+        {
+            tracked_vec v = make({1, 2, 3});
+            tracked::copies_until_throw = 2;
+            EXPECT_THROW(
+                v.insert(v.begin() + 2, more.begin(), more.end()),
+                std::runtime_error);
+            tracked::copies_until_throw = 0;
+            EXPECT_EQ(v.size(), 3u);
+            EXPECT_EQ(tracked::live, 3 + 3);
+        }
+        EXPECT_EQ(tracked::live, 3);
+    }
+}
+
 TEST(static_vec, erase)
 {
     {
@@ -749,3 +936,141 @@ TEST(static_vec, data_index_at)
         static_assert(std::is_same<decltype(v.at(0)), int const &>::value, "");
     }
 }
+
+// The concepts TS version of v2::container_interface does not provide
+// these.
+#if !defined(BOOST_STL_INTERFACES_USE_CONCEPTS_TS)
+TEST(static_vec, resize_for_overwrite)
+{
+    vec_type v = {1, 2};
+    v.resize_for_overwrite(5);
+    EXPECT_EQ(v.size(), 5u);
+    EXPECT_EQ(v[0], 1);
+    EXPECT_EQ(v[1], 2);
+
+    std::fill(v.begin() + 2, v.end(), 7);
+    EXPECT_EQ(v, vec_type({1, 2, 7, 7, 7}));
+
+    v.resize_for_overwrite(1);
+    EXPECT_EQ(v, vec_type({1}));
+}
+
+TEST(static_vec, append_insert_range)
+{
+    {
+        vec_type v = {1, 2};
+        std::vector<int> const more = {3, 4, 5};
+        static_assert(
+            std::is_same<decltype(v.append_range(more)), void>::value, "");
+        v.append_range(more);
+        EXPECT_EQ(v, vec_type({1, 2, 3, 4, 5}));
+
+        int const array[] = {6, 7};
+        v.append_range(array);
+        EXPECT_EQ(v, vec_type({1, 2, 3, 4, 5, 6, 7}));
+
+        v.append_range(std::vector<int>());
+        EXPECT_EQ(v.size(), 7u);
+    }
+
+    {
+        vec_type v = {1, 5};
+        std::vector<int> const more = {2, 3, 4};
+        static_assert(
+            std::is_same<
+                decltype(v.insert_range(v.begin(), more)),
+                vec_type::iterator>::value,
+            "");
+        auto const it = v.insert_range(v.begin() + 1, more);
+        EXPECT_EQ(it, v.begin() + 1);
+        EXPECT_EQ(v, vec_type({1, 2, 3, 4, 5}));
+
+        v.insert_range(v.end(), std::vector<int>{6});
+        EXPECT_EQ(v, vec_type({1, 2, 3, 4, 5, 6}));
+    }
+
+    {
+        vec_type v;
+        int const x = 1;
+        v.unchecked_push_back(x);
+        v.unchecked_push_back(2);
+        EXPECT_EQ(v.unchecked_emplace_back(3), 3);
+        EXPECT_EQ(v, vec_type({1, 2, 3}));
+    }
+}
+
+TEST(static_vec, erase_if_indices)
+{
+    {
+        vec_type v = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+        auto const n = v.erase_if([](int x) { return x % 3 == 0; });
+        EXPECT_EQ(n, 4u);
+        EXPECT_EQ(v, vec_type({1, 2, 4, 5, 7, 8}));
+        EXPECT_EQ(v.erase_if([](int) { return false; }), 0u);
+        EXPECT_EQ(v.erase_if([](int) { return true; }), 6u);
+        EXPECT_TRUE(v.empty());
+    }
+    {
+        vec_type v = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+        EXPECT_EQ(v.erase_indices(std::vector<int>()), 0u);
+        std::size_t const indices[] = {0, 3, 4, 9};
+        EXPECT_EQ(v.erase_indices(indices), 4u);
+        EXPECT_EQ(v, vec_type({1, 2, 5, 6, 7, 8}));
+    }
+    {
+        static_vector<std::string, 8> v = {"a", "bb", "c", "dd", "ee", "f"};
+        auto const n =
+            v.erase_if([](std::string const & s) { return s.size() == 2; });
+        EXPECT_EQ(n, 3u);
+        EXPECT_EQ(v, (static_vector<std::string, 8>{"a", "c", "f"}));
+        EXPECT_EQ(v.erase_indices(std::vector<int>{1}), 1u);
+        EXPECT_EQ(v, (static_vector<std::string, 8>{"a", "f"}));
+    }
+}
+
+TEST(static_vec, insert_sorted)
+{
+    vec_type v = {1, 4, 4, 8};
+    int const sorted[] = {0, 4, 5, 9};
+    v.insert_sorted(std::begin(sorted), std::end(sorted));
+    EXPECT_EQ(v, vec_type({0, 1, 4, 4, 4, 5, 8, 9}));
+
+    vec_type descending = {9, 5, 1};
+    std::vector<int> const more = {6, 2};
+    descending.insert_sorted(more.begin(), more.end(), std::greater<int>());
+    EXPECT_EQ(descending, vec_type({9, 6, 5, 2, 1}));
+}
+
+TEST(static_vec, backward_scans)
+{
+    static_vector<int, 100> v;
+    for (int i = 0; i < 100; ++i) {
+        v.push_back(i % 10);
+    }
+    EXPECT_EQ(v.find_last(3) - v.begin(), 93);
+    EXPECT_EQ(v.find_last(10), v.end());
+    EXPECT_EQ(v.find_last(3.5), v.end());
+
+    auto const & cv = v;
+    EXPECT_EQ(cv.find_last(9) - cv.begin(), 99);
+    auto const less_than_2 = [](int x) { return x < 2; };
+    EXPECT_EQ(cv.rfind_if(less_than_2) - cv.begin(), 91);
+    EXPECT_EQ(v.rfind_if([](int x) { return x < 0; }), v.end());
+
+    std::array<int, 100> reversed;
+    EXPECT_EQ(v.copy_reversed_to(reversed.begin()), reversed.end());
+    EXPECT_TRUE(std::equal(v.rbegin(), v.rend(), reversed.begin()));
+
+    std::vector<int> pushed;
+    v.copy_reversed_to(std::back_inserter(pushed));
+    EXPECT_TRUE(
+        std::equal(v.rbegin(), v.rend(), pushed.begin(), pushed.end()));
+
+    static_vector<std::string, 4> strings = {"a", "b", "a", "c"};
+    EXPECT_EQ(strings.find_last("a") - strings.begin(), 2);
+    std::string out[4];
+    strings.copy_reversed_to(out);
+    EXPECT_EQ(out[0], "c");
+    EXPECT_EQ(out[3], "a");
+}
+#endif
@@ -0,0 +1,133 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/stl_interfaces/algorithm.hpp>
+#include <boost/stl_interfaces/varint_sequence.hpp>
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+
+namespace bsi = boost::stl_interfaces;
+using bsi::varint_iterator;
+using bsi::varint_sequence;
+
+static_assert(
+    std::is_same<
+        std::iterator_traits<varint_iterator>::iterator_category,
+        std::forward_iterator_tag>::value,
+    "");
+static_assert(
+    std::is_same<
+        std::iterator_traits<varint_iterator>::value_type,
+        std::uint32_t>::value,
+    "");
+
+// Sorted values whose differences have all four encoded lengths.
+std::vector<std::uint32_t> random_postings(std::size_t n)
+{
+    std::mt19937 gen(42);
+    std::vector<std::uint32_t> retval;
+    std::uint32_t x = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        auto const bits = std::uniform_int_distribution<int>(0, 27)(gen);
+        x += std::uniform_int_distribution<std::uint32_t>(
+            0, (std::uint32_t(1) << bits))(gen);
+        retval.push_back(x);
+    }
+    return retval;
+}
+
+
+TEST(varint_sequence, empty)
+{
+    varint_sequence s;
+    EXPECT_TRUE(s.empty());
+    EXPECT_EQ(s.encoded_size(), 0u);
+    EXPECT_EQ(s.begin(), s.end());
+    EXPECT_TRUE(s.view().empty());
+    s.view().decode(nullptr);
+}
+
+TEST(varint_sequence, encoding)
+{
+    varint_sequence s;
+    s.push_back(0);
+    s.push_back(0xff);
+    s.push_back(0x100ff);
+    s.push_back(0x10100ff);
+    s.push_back(0xffffffff);
+    // Differences of 0, 0xff, 0x10000, 0x1000000, and 0xfeefff00: 1, 1,
+    // 3, 4, and 4 bytes, and two control bytes.
+    EXPECT_EQ(s.encoded_size(), 15u);
+    EXPECT_EQ(
+        std::vector<std::uint32_t>(s.begin(), s.end()),
+        (std::vector<std::uint32_t>{
+            0, 0xff, 0x100ff, 0x10100ff, 0xffffffff}));
+
+    // Values that go down wrap around, and still round-trip.
+    std::vector<std::uint32_t> const v = {10, 5, 0, 0xffffffff, 1};
+    varint_sequence const down(v.begin(), v.end());
+    EXPECT_TRUE(std::equal(down.begin(), down.end(), v.begin(), v.end()));
+}
+
+TEST(varint_sequence, iteration)
+{
+    auto const v = random_postings(1000);
+    varint_sequence const s(v.begin(), v.end());
+    EXPECT_EQ(s.size(), v.size());
+    EXPECT_LT(s.encoded_size(), v.size() * sizeof(std::uint32_t));
+    EXPECT_TRUE(std::equal(s.begin(), s.end(), v.begin(), v.end()));
+    EXPECT_EQ(std::distance(s.begin(), s.end()), 1000);
+
+    auto it = s.begin();
+    auto const old = it++;
+    EXPECT_EQ(*old, v[0]);
+    EXPECT_EQ(*it, v[1]);
+    EXPECT_EQ(*std::find(s.begin(), s.end(), v[777]), v[777]);
+}
+
+TEST(varint_sequence, bulk_decode)
+{
+    // Every alignment of the start and the length against the groups of
+    // four.
+    auto const v = random_postings(64);
+    varint_sequence const s(v.begin(), v.end());
+    std::vector<std::uint32_t> all(v.size());
+    s.view().decode(all.data());
+    EXPECT_EQ(all, v);
+
+    auto first = s.begin();
+    for (std::size_t f = 0; f < v.size(); ++f, ++first) {
+        for (std::size_t n = 0; f + n <= v.size(); ++n) {
+            std::vector<std::uint32_t> out(n + 1, 12345u);
+            bsi::read_n(first, std::ptrdiff_t(n), out.data());
+            EXPECT_TRUE(std::equal(out.begin(), out.end() - 1, v.begin() + f));
+            EXPECT_EQ(out.back(), 12345u);
+        }
+    }
+
+    // The scalar and the dispatched group decoders agree.
+    auto const view = s.view();
+    std::vector<std::uint32_t> scalar(v.size());
+    std::vector<std::uint32_t> dispatched(v.size());
+    EXPECT_EQ(
+        bsi::stream_vbyte::decode_groups_scalar(
+            view.control_bytes(), view.data_bytes(), 16, 0, scalar.data()),
+        bsi::stream_vbyte::decode_groups()(
+            view.control_bytes(), view.data_bytes(), 16, 0, dispatched.data()));
+    EXPECT_EQ(scalar, v);
+    EXPECT_EQ(dispatched, v);
+
+    std::vector<std::uint32_t> transformed(v.size());
+    bsi::transform(
+        s.begin(), s.end(), transformed.data(), [](std::uint32_t x) {
+            return x / 2;
+        });
+    EXPECT_EQ(transformed[63], v[63] / 2);
+}
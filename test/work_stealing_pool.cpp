@@ -0,0 +1,150 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/work_stealing_pool.hpp>
+
+#include "view_tests.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <numeric>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+
+namespace bsi = boost::stl_interfaces;
+
+using int_view = subrange<int *, int *, bsi::contiguous>;
+
+
+TEST(work_stealing_pool, parallel_for_each)
+{
+    std::vector<int> ints(100000);
+    std::iota(ints.begin(), ints.end(), 0);
+    int_view const v(ints.data(), ints.data() + ints.size());
+
+    for (unsigned int threads : {0u, 1u, 2u, 4u}) {
+        bsi::work_stealing_pool pool(threads);
+        EXPECT_EQ(pool.size(), threads);
+        for (std::ptrdiff_t grain_size : {1, 100, 1000000}) {
+            std::atomic<long long> sum(0);
+            std::atomic<int> count(0);
+            bsi::parallel_for_each(
+                pool,
+                v,
+                [&](int x) {
+                    sum += x;
+                    ++count;
+                },
+                grain_size);
+            EXPECT_EQ(count, 100000);
+            EXPECT_EQ(sum, 100000LL * 99999 / 2);
+        }
+    }
+}
+
+TEST(work_stealing_pool, skewed)
+{
+    // Nearly all the work is in the first few elements.
+    std::vector<int> ints(4096);
+    std::iota(ints.begin(), ints.end(), 0);
+    int_view const v(ints.data(), ints.data() + ints.size());
+
+    bsi::work_stealing_pool pool(4);
+    std::mutex mutex;
+    std::set<std::thread::id> ids;
+    std::atomic<long long> sum(0);
+    bsi::parallel_for_each(
+        pool,
+        v,
+        [&](int x) {
+            long long s = 0;
+            int const n = x < 64 ? 20000 : 10;
+            for (int i = 0; i < n; ++i) {
+                s += i % 7;
+            }
+            sum += s;
+            std::lock_guard<std::mutex> lock(mutex);
+            ids.insert(std::this_thread::get_id());
+        },
+        8);
+    EXPECT_EQ(sum, 64 * 59997LL + (4096 - 64) * 24LL);
+    EXPECT_FALSE(ids.count(std::this_thread::get_id()));
+}
+
+TEST(work_stealing_pool, nested)
+{
+    std::vector<int> ints(256, 1);
+    int_view const v(ints.data(), ints.data() + ints.size());
+
+    bsi::work_stealing_pool pool(2);
+    std::atomic<int> sum(0);
+    bsi::parallel_for_each(
+        pool,
+        v,
+        [&](int) {
+            bsi::parallel_for_each(
+                pool, v, [&](int x) { sum += x; }, 16);
+        },
+        16);
+    EXPECT_EQ(sum, 256 * 256);
+}
+
+TEST(work_stealing_pool, throws)
+{
+    std::vector<int> ints(10000);
+    std::iota(ints.begin(), ints.end(), 0);
+    int_view const v(ints.data(), ints.data() + ints.size());
+
+    bsi::work_stealing_pool pool(3);
+    EXPECT_THROW(
+        bsi::parallel_for_each(
+            pool,
+            v,
+            [](int x) {
+                if (x == 7777)
+                    throw std::runtime_error("7777");
+            },
+            10),
+        std::runtime_error);
+
+    // The pool is still usable.
+    std::atomic<int> count(0);
+    bsi::parallel_for_each(pool, v, [&](int) { ++count; }, 10);
+    EXPECT_EQ(count, 10000);
+}
+
+TEST(work_stealing_pool, iterator_algorithms)
+{
+    std::vector<int> ints(100000);
+    std::iota(ints.begin(), ints.end(), 0);
+
+    bsi::work_stealing_pool pool(3);
+    std::atomic<int> count(0);
+    pool.submit([&] { ++count; });
+    EXPECT_EQ(
+        bsi::parallel_reduce(
+            pool, ints.begin(), ints.end(), 0LL, std::plus<long long>{}, 100),
+        100000LL * 99999 / 2);
+
+    std::vector<int> out(ints.size());
+    bsi::parallel_transform(
+        pool,
+        ints.data(),
+        ints.data() + ints.size(),
+        out.data(),
+        [](int x) { return -x; },
+        100);
+    for (std::size_t i = 0; i < ints.size(); ++i) {
+        EXPECT_EQ(out[i], -ints[i]);
+    }
+
+    while (count == 0) {
+        std::this_thread::yield();
+    }
+}
@@ -0,0 +1,178 @@
+// Copyright (C) 2019 T. Zachary Laine
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+#include <boost/stl_interfaces/zip_view.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <forward_list>
+#include <list>
+#include <string>
+#include <vector>
+
+
+namespace bsi = boost::stl_interfaces;
+
+using ra_zip = bsi::zip_iterator<int *, std::vector<std::string>::iterator>;
+using bidi_zip = bsi::zip_iterator<int *, std::list<int>::iterator>;
+using fwd_zip = bsi::zip_iterator<
+    std::forward_list<int>::iterator,
+    std::list<int>::iterator>;
+
+static_assert(
+    std::is_same<ra_zip::iterator_category, std::random_access_iterator_tag>::
+        value,
+    "");
+static_assert(
+    std::is_same<bidi_zip::iterator_category, std::bidirectional_iterator_tag>::
+        value,
+    "");
+static_assert(
+    std::is_same<fwd_zip::iterator_category, std::forward_iterator_tag>::value,
+    "");
+static_assert(
+    std::is_same<ra_zip::value_type, std::tuple<int, std::string>>::value, "");
+static_assert(
+    std::is_same<
+        ra_zip::reference,
+        bsi::zip_reference<int &, std::string &>>::value,
+    "");
+
+
+TEST(zip_view, random_access)
+{
+    std::array<int, 4> ints = {{2, 0, 3, 1}};
+    std::vector<std::string> strings = {"two", "zero", "three", "one", "four"};
+
+    // The view is as long as its shortest range.
+    auto const zip = bsi::make_zip_view(ints, strings);
+    EXPECT_EQ(zip.size(), 4);
+    EXPECT_EQ(zip[1], std::make_tuple(0, std::string("zero")));
+    EXPECT_EQ(zip.back(), std::make_tuple(1, std::string("one")));
+
+    auto it = zip.begin();
+    it += 3;
+    EXPECT_EQ(it - zip.begin(), 3);
+    EXPECT_EQ(it + 1, zip.end());
+    EXPECT_LT(zip.begin(), it);
+    --it;
+    EXPECT_EQ(std::get<1>(*it), "three");
+    EXPECT_EQ(std::get<0>(it.base()), ints.data() + 2);
+    EXPECT_EQ(std::get<1>(it.base()), strings.begin() + 2);
+
+    // Iterators made from the ends of the ranges are comparable with those
+    // made from their beginnings.
+    std::array<int, 4> more_ints = {{0, 0, 0, 0}};
+    bsi::zip_iterator<int *, int *> const first(ints.data(), more_ints.data());
+    bsi::zip_iterator<int *, int *> const last(
+        ints.data() + 4, more_ints.data() + 4);
+    EXPECT_EQ(last - first, 4);
+    EXPECT_EQ(first + 4, last);
+}
+
+TEST(zip_view, writes_and_sort)
+{
+    std::vector<int> ints = {2, 0, 3, 1};
+    std::vector<std::string> strings = {"two", "zero", "three", "one"};
+    auto const zip = bsi::make_zip_view(ints, strings);
+
+    zip[0] = std::make_tuple(4, std::string("four"));
+    EXPECT_EQ(ints[0], 4);
+    EXPECT_EQ(strings[0], "four");
+    std::get<1>(zip[0]) = "two";
+    std::get<0>(zip[0]) = 2;
+
+    std::sort(zip.begin(), zip.end());
+    EXPECT_EQ(ints, (std::vector<int>{0, 1, 2, 3}));
+    EXPECT_EQ(
+        strings, (std::vector<std::string>{"zero", "one", "two", "three"}));
+
+    std::reverse(zip.begin(), zip.end());
+    EXPECT_EQ(ints, (std::vector<int>{3, 2, 1, 0}));
+    EXPECT_EQ(strings.front(), "three");
+}
+
+TEST(zip_view, three_ranges)
+{
+    std::vector<int> a = {1, 2, 3};
+    std::vector<double> b = {0.5, 1.5, 2.5};
+    std::vector<char> c = {'a', 'b', 'c'};
+
+    std::string chars;
+    double sum = 0.0;
+    for (auto elem : bsi::make_zip_view(a, b, c)) {
+        sum += std::get<0>(elem) * std::get<1>(elem);
+        chars += std::get<2>(elem);
+    }
+    EXPECT_EQ(sum, 0.5 + 3.0 + 7.5);
+    EXPECT_EQ(chars, "abc");
+}
+
+TEST(zip_view, not_random_access)
+{
+    std::list<int> list = {1, 2, 3, 4};
+    std::vector<int> vec = {10, 20, 30};
+
+    // Iteration stops at the end of the shortest range.
+    auto const zip = bsi::make_zip_view(list, vec);
+    std::vector<int> sums;
+    for (auto elem : zip) {
+        sums.push_back(std::get<0>(elem) + std::get<1>(elem));
+    }
+    EXPECT_EQ(sums, (std::vector<int>{11, 22, 33}));
+    EXPECT_EQ(std::distance(zip.begin(), zip.end()), 3);
+
+    auto it = std::next(zip.begin(), 2);
+    --it;
+    EXPECT_EQ(*it, std::make_tuple(2, 20));
+
+    std::forward_list<int> flist = {5, 6};
+    auto const fzip = bsi::make_zip_view(flist, list);
+    EXPECT_EQ(std::distance(fzip.begin(), fzip.end()), 2);
+    EXPECT_EQ(fzip.front(), std::make_tuple(5, 1));
+}
+
+TEST(zip_view, copy)
+{
+    std::vector<int> ints = {0, 1, 2, 3, 4};
+    std::vector<double> doubles = {0.0, 0.5, 1.0, 1.5, 2.0};
+    std::vector<std::string> strings = {"a", "b", "c", "d", "e"};
+
+    {
+        // All the components are contiguous (or random access).
+        std::array<int, 5> ints_out = {};
+        std::array<double, 5> doubles_out = {};
+        std::array<std::string, 5> strings_out = {};
+        auto const in = bsi::make_zip_view(ints, doubles, strings);
+        bsi::zip_iterator<int *, double *, std::string *> out(
+            ints_out.data(), doubles_out.data(), strings_out.data());
+
+        using std::copy;
+        auto const out_last = copy(in.begin() + 1, in.end(), out);
+        EXPECT_EQ(out_last - out, 4);
+        EXPECT_EQ(ints_out, (std::array<int, 5>{{1, 2, 3, 4, 0}}));
+        EXPECT_EQ(
+            doubles_out, (std::array<double, 5>{{0.5, 1.0, 1.5, 2.0, 0.0}}));
+        EXPECT_EQ(strings_out[0], "b");
+        EXPECT_EQ(strings_out[3], "e");
+    }
+    {
+        // The output is not random access.
+        std::list<int> ints_out(5);
+        std::list<double> doubles_out(5);
+        auto const in = bsi::make_zip_view(ints, doubles);
+        bsi::copy(
+            in.begin(),
+            in.end(),
+            bsi::zip_iterator<
+                std::list<int>::iterator,
+                std::list<double>::iterator>(
+                ints_out.begin(), doubles_out.begin()));
+        EXPECT_EQ(ints_out, (std::list<int>{0, 1, 2, 3, 4}));
+        EXPECT_EQ(doubles_out.back(), 2.0);
+    }
+}